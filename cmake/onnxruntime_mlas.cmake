@@ -7,10 +7,17 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/platform.cpp
   ${MLAS_SRC_DIR}/threading.cpp
   ${MLAS_SRC_DIR}/sgemm.cpp
+  ${MLAS_SRC_DIR}/halfgemm.cpp
+  ${MLAS_SRC_DIR}/sbgemm.cpp
+  ${MLAS_SRC_DIR}/q4gemm.cpp
   ${MLAS_SRC_DIR}/qgemm.cpp
+  ${MLAS_SRC_DIR}/qgemm16.cpp
   ${MLAS_SRC_DIR}/qdwconv.cpp
   ${MLAS_SRC_DIR}/convolve.cpp
+  ${MLAS_SRC_DIR}/sdwconv.cpp
+  ${MLAS_SRC_DIR}/convwinograd.cpp
   ${MLAS_SRC_DIR}/convsym.cpp
+  ${MLAS_SRC_DIR}/dwconv.cpp
   ${MLAS_SRC_DIR}/pooling.cpp
   ${MLAS_SRC_DIR}/transpose.cpp
   ${MLAS_SRC_DIR}/reorder.cpp
@@ -19,13 +26,18 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/logistic.cpp
   ${MLAS_SRC_DIR}/tanh.cpp
   ${MLAS_SRC_DIR}/erf.cpp
+  ${MLAS_SRC_DIR}/cast.cpp
   ${MLAS_SRC_DIR}/compute.cpp
+  ${MLAS_SRC_DIR}/flashattn.cpp
+  ${MLAS_SRC_DIR}/layernorm.cpp
+  ${MLAS_SRC_DIR}/sparsegemm.cpp
   ${MLAS_SRC_DIR}/quantize.cpp
   ${MLAS_SRC_DIR}/qgemm_kernel_default.cpp
   ${MLAS_SRC_DIR}/qladd.cpp
   ${MLAS_SRC_DIR}/qlmul.cpp
   ${MLAS_SRC_DIR}/qpostprocessor.cpp
   ${MLAS_SRC_DIR}/qlgavgpool.cpp
+  ${MLAS_SRC_DIR}/qllookup.cpp
   ${MLAS_SRC_DIR}/qdwconv_kernelsize.cpp
 )
 
@@ -298,6 +310,27 @@ else()
           ${MLAS_SRC_DIR}/qgemm_kernel_udot.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_sdot.cpp
         )
+
+        check_cxx_compiler_flag("-march=armv8.2-a+fp16" HAS_ARM64_FP16)
+        if(HAS_ARM64_FP16)
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${MLAS_SRC_DIR}/halfgemm_kernel_neon.cpp
+          )
+          set_source_files_properties(${MLAS_SRC_DIR}/halfgemm_kernel_neon.cpp PROPERTIES COMPILE_FLAGS "-march=armv8.2-a+fp16")
+          target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_F16VEC_INTRINSICS_SUPPORTED)
+        endif()
+
+        check_cxx_compiler_flag("-march=armv8.2-a+bf16" HAS_ARM64_BF16)
+        if(HAS_ARM64_BF16)
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${MLAS_SRC_DIR}/sbgemm_kernel_neon.cpp
+          )
+          set_source_files_properties(${MLAS_SRC_DIR}/sbgemm_kernel_neon.cpp PROPERTIES COMPILE_FLAGS "-march=armv8.2-a+bf16")
+          target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_BF16VEC_INTRINSICS_SUPPORTED)
+        endif()
+
         if(ONNXRUNTIME_MLAS_MULTI_ARCH)
             onnxruntime_add_static_library(onnxruntime_mlas_arm64 ${mlas_platform_srcs})
             set_target_properties(onnxruntime_mlas_arm64 PROPERTIES OSX_ARCHITECTURES "arm64")
@@ -453,8 +486,12 @@ else()
           ${MLAS_SRC_DIR}/x86_64/ErfKernelFma3.S
           ${MLAS_SRC_DIR}/intrinsics/avx2/qladd_avx2.cpp
           ${MLAS_SRC_DIR}/intrinsics/avx2/qdwconv_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/qgemm16_kernel_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/q4gemm_kernel_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/cast_kernel_avx2.cpp
         )
         set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
+        set_source_files_properties(${MLAS_SRC_DIR}/intrinsics/avx2/cast_kernel_avx2.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mf16c")
 
         set(mlas_platform_srcs_avx512f
           ${MLAS_SRC_DIR}/x86_64/DgemmKernelAvx512F.S
@@ -484,6 +521,59 @@ else()
           ${mlas_platform_srcs_avx512core}
         )
 
+        check_cxx_compiler_flag("-mavx512fp16" HAS_AVX512FP16)
+        if(HAS_AVX512FP16)
+          set(mlas_platform_srcs_avx512fp16
+            ${MLAS_SRC_DIR}/intrinsics/avx512/halfgemm_kernel_avx512fp16.cpp
+          )
+          set_source_files_properties(${mlas_platform_srcs_avx512fp16} PROPERTIES COMPILE_FLAGS "-mavx512fp16")
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${mlas_platform_srcs_avx512fp16}
+          )
+          target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+        endif()
+
+        check_cxx_compiler_flag("-mavx512bf16" HAS_AVX512BF16)
+        if(HAS_AVX512BF16)
+          set(mlas_platform_srcs_avx512bf16
+            ${MLAS_SRC_DIR}/intrinsics/avx512/sbgemm_kernel_avx512bf16.cpp
+          )
+          set_source_files_properties(${mlas_platform_srcs_avx512bf16} PROPERTIES COMPILE_FLAGS "-mavx512bf16")
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${mlas_platform_srcs_avx512bf16}
+          )
+          target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_AVX512BF16_INTRINSICS_SUPPORTED)
+
+          # AMX needs the process to request the tile state, which is only done on Linux.
+          check_cxx_compiler_flag("-mamx-tile -mamx-bf16" HAS_AMX_BF16)
+          if(HAS_AMX_BF16 AND CMAKE_SYSTEM_NAME STREQUAL "Linux")
+            set(mlas_platform_srcs_amx
+              ${MLAS_SRC_DIR}/intrinsics/avx512/sbgemm_kernel_amx.cpp
+            )
+            set_source_files_properties(${mlas_platform_srcs_amx} PROPERTIES COMPILE_FLAGS "-mavx512bf16 -mamx-tile -mamx-bf16")
+            set(mlas_platform_srcs
+              ${mlas_platform_srcs}
+              ${mlas_platform_srcs_amx}
+            )
+            target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_AMX_INTRINSICS_SUPPORTED)
+          endif()
+        endif()
+
+        check_cxx_compiler_flag("-mamx-tile -mamx-int8" HAS_AMX_INT8)
+        if(HAS_AMX_INT8 AND CMAKE_SYSTEM_NAME STREQUAL "Linux")
+          set(mlas_platform_srcs_amx_int8
+            ${MLAS_SRC_DIR}/intrinsics/avx512/qgemm_kernel_amx.cpp
+          )
+          set_source_files_properties(${mlas_platform_srcs_amx_int8} PROPERTIES COMPILE_FLAGS "-mavx512f -mamx-tile -mamx-int8")
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${mlas_platform_srcs_amx_int8}
+          )
+          target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_AMX_INT8_INTRINSICS_SUPPORTED)
+        endif()
+
         if(ONNXRUNTIME_MLAS_MULTI_ARCH)
           onnxruntime_add_static_library(onnxruntime_mlas_x86_64 ${mlas_platform_srcs})
           set_target_properties(onnxruntime_mlas_x86_64 PROPERTIES OSX_ARCHITECTURES "x86_64")
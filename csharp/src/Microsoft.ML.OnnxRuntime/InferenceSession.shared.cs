@@ -41,6 +41,12 @@ namespace Microsoft.ML.OnnxRuntime
         /// </summary>
         private Dictionary<string, NodeMetadata> _overridableInitializerMetadata;
 
+        /// <summary>
+        /// Zero terminated utf8 copies of the input, output and overridable initializer names
+        /// in native memory, used by the allocation free Run overloads
+        /// </summary>
+        private Dictionary<string, IntPtr> _nativeNames = new Dictionary<string, IntPtr>();
+
         private SessionOptions _builtInSessionOptions = null;
         private RunOptions _builtInRunOptions = null;
         private ModelMetadata _modelMetadata = null;
@@ -356,6 +362,87 @@ namespace Microsoft.ML.OnnxRuntime
             }
         }
 
+        /// <summary>
+        /// Runs the loaded model for the given inputs and outputs.
+        /// 
+        /// Outputs need to be created with correct type and dimension to receive the fetched data,
+        /// e.g. with <see cref="OrtValue.CreateTensorValueFromMemory{T}(Memory{T}, long[])"/>.
+        /// This overload does not allocate on the managed heap, so the same inputs and outputs
+        /// can be refilled and run repeatedly.
+        /// </summary>
+        /// <param name="inputNames">Specify a list of input names. Should match <paramref name="inputValues"/>.</param>
+        /// <param name="inputValues">Specify a list of <see cref="OrtValue"/> that indicates the input values.</param>
+        /// <param name="outputNames">Specify a list of output names. Should match <paramref name="outputValues"/>.</param>
+        /// <param name="outputValues">Specify a list of pre-allocated <see cref="OrtValue"/> that receive the outputs.</param>
+        public void Run(
+            IReadOnlyList<string> inputNames,
+            IReadOnlyList<OrtValue> inputValues,
+            IReadOnlyList<string> outputNames,
+            IReadOnlyList<OrtValue> outputValues)
+        {
+            Run(inputNames, inputValues, outputNames, outputValues, _builtInRunOptions);
+        }
+
+        /// <summary>
+        /// Runs the loaded model for the given inputs and outputs. Uses the given RunOptions for this run.
+        /// 
+        /// Outputs need to be created with correct type and dimension to receive the fetched data,
+        /// e.g. with <see cref="OrtValue.CreateTensorValueFromMemory{T}(Memory{T}, long[])"/>.
+        /// The names are mapped to native strings cached by the session and the native
+        /// arguments are stack allocated, so this overload does not allocate on the managed heap.
+        /// </summary>
+        /// <param name="inputNames">Specify a list of input names. Should match <paramref name="inputValues"/>.</param>
+        /// <param name="inputValues">Specify a list of <see cref="OrtValue"/> that indicates the input values.</param>
+        /// <param name="outputNames">Specify a list of output names. Should match <paramref name="outputValues"/>.</param>
+        /// <param name="outputValues">Specify a list of pre-allocated <see cref="OrtValue"/> that receive the outputs.</param>
+        /// <param name="options">Run options, which can be reused across runs</param>
+        public void Run(
+            IReadOnlyList<string> inputNames,
+            IReadOnlyList<OrtValue> inputValues,
+            IReadOnlyList<string> outputNames,
+            IReadOnlyList<OrtValue> outputValues,
+            RunOptions options)
+        {
+            if (inputNames.Count != inputValues.Count)
+            {
+                throw new ArgumentException($"Length of {nameof(inputNames)} ({inputNames.Count}) must match that of {nameof(inputValues)} ({inputValues.Count}).");
+            }
+            if (outputNames.Count != outputValues.Count)
+            {
+                throw new ArgumentException($"Length of {nameof(outputNames)} ({outputNames.Count}) must match that of {nameof(outputValues)} ({outputValues.Count}).");
+            }
+
+            unsafe
+            {
+                IntPtr* inputNamesArray = stackalloc IntPtr[inputNames.Count];
+                IntPtr* inputValuesArray = stackalloc IntPtr[inputNames.Count];
+                for (int i = 0; i < inputNames.Count; ++i)
+                {
+                    inputNamesArray[i] = GetNativeName(inputNames[i]);
+                    inputValuesArray[i] = inputValues[i].Handle;
+                }
+
+                IntPtr* outputNamesArray = stackalloc IntPtr[outputNames.Count];
+                IntPtr* outputValuesArray = stackalloc IntPtr[outputNames.Count];
+                for (int i = 0; i < outputNames.Count; ++i)
+                {
+                    outputNamesArray[i] = GetNativeName(outputNames[i]);
+                    outputValuesArray[i] = outputValues[i].Handle;
+                }
+
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtRunWithPointers(
+                                                    _nativeHandle,
+                                                    options.Handle,
+                                                    (IntPtr)inputNamesArray,
+                                                    (IntPtr)inputValuesArray,
+                                                    (UIntPtr)inputNames.Count,
+                                                    (IntPtr)outputNamesArray,
+                                                    (UIntPtr)outputNames.Count,
+                                                    (IntPtr)outputValuesArray /* pointers to Pre-allocated OrtValue instances */
+                                                    ));
+            }
+        }
+
         /// <summary>
         /// Runs the loaded model for the given inputs and outputs.
         /// 
@@ -616,6 +703,33 @@ namespace Microsoft.ML.OnnxRuntime
             }
         }
 
+        /// <summary>
+        /// Returns the cached zero terminated utf8 copy of an input, output or overridable initializer name
+        /// </summary>
+        /// <param name="name">name of the node</param>
+        /// <returns>pointer to the native copy of the name</returns>
+        private IntPtr GetNativeName(string name)
+        {
+            IntPtr nativeName;
+            if (!_nativeNames.TryGetValue(name, out nativeName))
+            {
+                throw new OnnxRuntimeException(ErrorCode.InvalidArgument,
+                    $"Name: '{name}' is not an input, output or overridable initializer of the model");
+            }
+            return nativeName;
+        }
+
+        private void AddNativeName(string name)
+        {
+            if (!_nativeNames.ContainsKey(name))
+            {
+                var utf8Name = NativeOnnxValueHelper.StringToZeroTerminatedUtf8(name);
+                var nativeName = Marshal.AllocHGlobal(utf8Name.Length);
+                Marshal.Copy(utf8Name, 0, nativeName, utf8Name.Length);
+                _nativeNames.Add(name, nativeName);
+            }
+        }
+
         // Delegate for string extraction from an arbitrary input/output object
         private delegate string NameExtractor<in TInput>(TInput input);
 
@@ -855,6 +969,12 @@ namespace Microsoft.ML.OnnxRuntime
                 {
                     _overridableInitializerMetadata[GetOverridableInitializerName(i)] = GetOverridableInitializerMetadata(i);
                 }
+
+                foreach (var name in _inputMetadata.Keys.Concat(_outputMetadata.Keys).Concat(_overridableInitializerMetadata.Keys))
+                {
+                    AddNativeName(name);
+                }
+
                 // set profiling's start time
                 UIntPtr startTime = UIntPtr.Zero;
                 NativeApiStatus.VerifySuccess(NativeMethods.OrtSessionGetProfilingStartTimeNs(_nativeHandle,
@@ -1097,6 +1217,12 @@ namespace Microsoft.ML.OnnxRuntime
                 NativeMethods.OrtReleaseSession(_nativeHandle);
                 _nativeHandle = IntPtr.Zero;
             }
+
+            foreach (var nativeName in _nativeNames.Values)
+            {
+                Marshal.FreeHGlobal(nativeName);
+            }
+            _nativeNames.Clear();
             _disposed = true;
         }
 
@@ -272,6 +272,7 @@ namespace Microsoft.ML.OnnxRuntime
             OrtCreateSessionFromArrayWithPrepackedWeightsContainer =
                 (DOrtCreateSessionFromArrayWithPrepackedWeightsContainer)Marshal.GetDelegateForFunctionPointer(api_.CreateSessionFromArrayWithPrepackedWeightsContainer, typeof(DOrtCreateSessionFromArrayWithPrepackedWeightsContainer));
             OrtRun = (DOrtRun)Marshal.GetDelegateForFunctionPointer(api_.Run, typeof(DOrtRun));
+            OrtRunWithPointers = (DOrtRunWithPointers)Marshal.GetDelegateForFunctionPointer(api_.Run, typeof(DOrtRunWithPointers));
             OrtRunWithBinding = (DOrtRunWithBinding)Marshal.GetDelegateForFunctionPointer(api_.RunWithBinding, typeof(DOrtRunWithBinding));
             OrtSessionGetInputCount = (DOrtSessionGetInputCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetInputCount, typeof(DOrtSessionGetInputCount));
             OrtSessionGetOutputCount = (DOrtSessionGetOutputCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetOutputCount, typeof(DOrtSessionGetOutputCount));
@@ -617,6 +618,24 @@ namespace Microsoft.ML.OnnxRuntime
 
         public static DOrtRun OrtRun;
 
+        /// <summary>
+        /// Same native function as OrtRun, taking pointers to caller-owned (e.g. stack allocated) arrays
+        /// so that no managed arrays need to be allocated or marshalled per call.
+        /// </summary>
+        [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+        public delegate IntPtr /*(ONNStatus*)*/ DOrtRunWithPointers(
+                                                IntPtr /*(OrtSession*)*/ session,
+                                                IntPtr /*(OrtSessionRunOptions*)*/ runOptions,  // can be null to use the default options
+                                                IntPtr /*(const char* const*)*/ inputNames,
+                                                IntPtr /* (const OrtValue* const*)*/ inputValues,
+                                                UIntPtr inputCount,
+                                                IntPtr /*(const char* const*)*/ outputNames,
+                                                UIntPtr outputCount,
+                                                IntPtr /*(OrtValue**)*/ outputValues
+                                                );
+
+        public static DOrtRunWithPointers OrtRunWithPointers;
+
         [UnmanagedFunctionPointer(CallingConvention.Winapi)]
         public delegate IntPtr /*(ONNStatus*)*/ DOrtRunWithBinding(
                                                 IntPtr /*(OrtSession*)*/ session,
@@ -45,6 +45,11 @@ namespace Microsoft.ML.OnnxRuntime
 
         internal IntPtr Handle { get { return handle; } }
 
+        /// <summary>
+        /// Managed memory pinned by CreateTensorValueFromMemory, released together with the native instance
+        /// </summary>
+        private MemoryHandle? _memoryHandle;
+
         /// <summary>
         /// Overrides SafeHandle.IsInvalid
         /// </summary>
@@ -128,6 +133,109 @@ namespace Microsoft.ML.OnnxRuntime
             return new OrtValue(ortValueHandle);
         }
 
+        /// <summary>
+        /// Factory method to construct an OrtValue of Tensor type on top of managed memory.
+        /// The memory is pinned for the lifetime of the OrtValue and unpinned when it is disposed,
+        /// so the caller may refill the memory between runs without any further allocations.
+        /// </summary>
+        /// <typeparam name="T">Element type, must be one of the supported non-string tensor types</typeparam>
+        /// <param name="memory">Memory holding at least as many elements as the shape requires</param>
+        /// <param name="shape">Tensor shape</param>
+        /// <returns>A disposable instance of OrtValue</returns>
+        public static OrtValue CreateTensorValueFromMemory<T>(Memory<T> memory, long[] shape) where T : struct
+        {
+            var typeInfo = TensorBase.GetTypeInfo(typeof(T));
+            if (typeInfo == null || typeInfo.IsString)
+            {
+                throw new OnnxRuntimeException(ErrorCode.InvalidArgument,
+                    "Tensor element type: " + typeof(T).Name + " is not supported");
+            }
+
+            var shapeSize = ArrayUtilities.GetSizeForShape(shape);
+            if (shapeSize > memory.Length)
+            {
+                var message = String.Format("Shape of: {0} elements requires a buffer of at least {0} elements. Provided: {1} elements",
+                    shapeSize, memory.Length);
+                throw new OnnxRuntimeException(ErrorCode.InvalidArgument, message);
+            }
+
+            var memHandle = memory.Pin();
+            try
+            {
+                IntPtr dataBufferPointer = IntPtr.Zero;
+                unsafe
+                {
+                    dataBufferPointer = (IntPtr)memHandle.Pointer;
+                }
+
+                IntPtr nativeValue;
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtCreateTensorWithDataAsOrtValue(
+                    OrtMemoryInfo.DefaultInstance.Pointer,
+                    dataBufferPointer,
+                    (UIntPtr)(shapeSize * typeInfo.TypeSize),
+                    shape,
+                    (UIntPtr)shape.Length,
+                    typeInfo.ElementType,
+                    out nativeValue));
+
+                var ortValue = new OrtValue(nativeValue);
+                ortValue._memoryHandle = memHandle;
+                return ortValue;
+            }
+            catch (Exception)
+            {
+                memHandle.Dispose();
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Returns a Span over the data of a tensor residing in cpu memory, such as a tensor created
+        /// with CreateTensorValueFromMemory or an output produced by the session. No data is copied,
+        /// the span is only valid while this OrtValue is alive.
+        /// </summary>
+        /// <typeparam name="T">Element type, must match the element type of the tensor</typeparam>
+        /// <returns>Span over the tensor data</returns>
+        public Span<T> GetTensorMutableDataAsSpan<T>() where T : struct
+        {
+            var typeInfo = TensorBase.GetTypeInfo(typeof(T));
+            if (typeInfo == null || typeInfo.IsString)
+            {
+                throw new OnnxRuntimeException(ErrorCode.InvalidArgument,
+                    "Tensor element type: " + typeof(T).Name + " is not supported");
+            }
+
+            long count = 0;
+            IntPtr typeAndShape = IntPtr.Zero;
+            NativeApiStatus.VerifySuccess(NativeMethods.OrtGetTensorTypeAndShape(Handle, out typeAndShape));
+            try
+            {
+                IntPtr el_type;
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtGetTensorElementType(typeAndShape, out el_type));
+                if ((TensorElementType)el_type != typeInfo.ElementType)
+                {
+                    throw new OnnxRuntimeException(ErrorCode.InvalidArgument,
+                        "Tensor element type: " + ((TensorElementType)el_type).ToString() +
+                        " does not match the requested type: " + typeInfo.ElementType.ToString());
+                }
+
+                IntPtr el_count;
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtGetTensorShapeElementCount(typeAndShape, out el_count));
+                count = (long)el_count;
+            }
+            finally
+            {
+                NativeMethods.OrtReleaseTensorTypeAndShapeInfo(typeAndShape);
+            }
+
+            IntPtr dataBuffer;
+            NativeApiStatus.VerifySuccess(NativeMethods.OrtGetTensorMutableData(Handle, out dataBuffer));
+            unsafe
+            {
+                return new Span<T>(dataBuffer.ToPointer(), (int)count);
+            }
+        }
+
         /// <summary>
         /// This is a factory method creates a native Onnxruntime OrtValue containing a tensor.
         /// The method will attempt to pin managed memory so no copying occurs when data is passed down
@@ -381,6 +489,9 @@ namespace Microsoft.ML.OnnxRuntime
             {
                 NativeMethods.OrtReleaseValue(handle);
             }
+            // Unpin the managed memory the tensor was created on, if any
+            _memoryHandle?.Dispose();
+            _memoryHandle = null;
             // Prevent use after disposal
             handle = IntPtr.Zero;
             return true;
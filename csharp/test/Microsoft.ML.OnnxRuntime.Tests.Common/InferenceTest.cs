@@ -1005,6 +1005,49 @@ namespace Microsoft.ML.OnnxRuntime.Tests
             }
         }
 
+        [Fact(DisplayName = "TestOrtValueFromMemoryMultiInferences")]
+        private void TestOrtValueFromMemoryMultiInferences()
+        {
+            // model takes 1x5 input of fixed type, echoes back
+            var model = TestDataLoader.LoadModelFromEmbeddedResource("test_types_INT32.pb");
+            using (var session = new InferenceSession(model))
+            using (var runOptions = new RunOptions())
+            {
+                var bufferInput = new int[5];
+                var bufferOutput = new int[5];
+                var shape = new long[] { 1, 5 };
+
+                using (OrtValue valueInput = OrtValue.CreateTensorValueFromMemory(new Memory<int>(bufferInput), shape),
+                                valueOutput = OrtValue.CreateTensorValueFromMemory(new Memory<int>(bufferOutput), shape))
+                {
+                    var inputNames = new[] { "input" };
+                    var outputNames = new[] { "output" };
+                    var inputValues = new[] { valueInput };
+                    var outputValues = new[] { valueOutput };
+
+                    var rand = new Random();
+
+                    // run the model for multiple times, reusing the values and the run options
+                    for (var i = 0; i < 100; i++)
+                    {
+                        var inputSpan = valueInput.GetTensorMutableDataAsSpan<int>();
+                        for (int j = 0; j < inputSpan.Length; ++j)
+                        {
+                            inputSpan[j] = rand.Next();
+                        }
+
+                        session.Run(inputNames, inputValues, outputNames, outputValues, runOptions);
+
+                        Assert.Equal(bufferInput, bufferOutput);
+                        Assert.True(valueOutput.GetTensorMutableDataAsSpan<int>().SequenceEqual(bufferInput));
+                    }
+
+                    Assert.Throws<OnnxRuntimeException>(() => session.Run(new[] { "unknown" }, inputValues, outputNames, outputValues));
+                    Assert.Throws<OnnxRuntimeException>(() => { valueOutput.GetTensorMutableDataAsSpan<float>(); });
+                }
+            }
+        }
+
         [Fact(DisplayName = "TestModelInputINT32")]
         private void TestModelInputINT32()
         {
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <list>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/common/common.h"
@@ -14,6 +17,7 @@
 #include "core/session/environment.h"
 #include "core/graph/basic_types.h"
 #include "core/graph/model.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 #ifdef __GNUC__
@@ -35,6 +39,8 @@ class ORTInvoker {
     return *execution_provider_;
   }
 
+  // The kernel created for an op type, domain, version, attributes, input element types and number of outputs is
+  // kept in a cache of the most recently used ones, so that invoking the op again only costs its Compute().
   common::Status Invoke(const std::string& op_name,
                         //optional inputs / outputs?
                         const std::vector<OrtValue>& inputs,
@@ -43,12 +49,37 @@ class ORTInvoker {
                         const std::string& domain = kOnnxDomain,
                         const int version = -1);
 
+  // Sets the number of kernels kept in the cache, 0 disables it. The default is kDefaultKernelCacheCapacity.
+  void SetKernelCacheCapacity(size_t capacity);
+
+  size_t GetKernelCacheSize() const;
+
+  static constexpr size_t kDefaultKernelCacheCapacity = 256;
+
  private:
+  // a node in its own graph and its kernel
+  struct CachedKernel;
+
+  common::Status CreateKernel(const std::string& op_name,
+                              const std::vector<OrtValue>& inputs,
+                              size_t output_count,
+                              const NodeAttributes* attributes,
+                              const std::string& domain,
+                              const int version,
+                              std::shared_ptr<const CachedKernel>& cached_kernel);
+
   std::shared_ptr<IExecutionProvider> execution_provider_;
   const logging::Logger& logger_;
   // custom ops for current execution provider
   // we need the op schema to resolve the output type during invoke
   const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries_;
+
+  // the kernels are shared so that one evicted while it is computing stays alive
+  mutable OrtMutex kernel_cache_mutex_;
+  size_t kernel_cache_capacity_ = kDefaultKernelCacheCapacity;
+  // most recently used first
+  std::list<std::pair<std::string, std::shared_ptr<const CachedKernel>>> kernel_cache_lru_;
+  std::unordered_map<std::string, decltype(kernel_cache_lru_)::iterator> kernel_cache_;
 };
 
 #ifdef __GNUC__
@@ -16,10 +16,11 @@ namespace onnxruntime {
 //   - tensor values: The lifetimes of these tensor-values are statically
 //     determined, which is used for memory reuse/sharing optimizations. The
 //     runtime allocates/frees these values at the right time (as determined
-//     by the static allocation plan). Note that this is simplified since we
-//     do not try to optimize for "slice" like ops, where we may be able to
-//     conditionally reuse memory/data in some cases but not others.
-//     Generalizing this is future work.
+//     by the static allocation plan). A tensor-value may also be a contiguous
+//     slice of the buffer of another tensor-value (kSlice): the inputs of a
+//     Concat written in place by their producers, and the outputs of a Split
+//     which are views of its input. This is planned only when the shapes are
+//     statically known and the slices are contiguous.
 
 enum class AllocKind {
   kNotSet = -1,
@@ -29,7 +30,8 @@ enum class AllocKind {
   kAllocateStatically = 3,
   kAllocateOutput = 4,
   kShare = 5,
-  kAllocatedExternally = 6
+  kAllocatedExternally = 6,
+  kSlice = 7
 };
 
 std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind);
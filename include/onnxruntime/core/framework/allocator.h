@@ -17,20 +17,34 @@ struct OrtArenaCfg {
                   arena_extend_strategy(-1),
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
-                  initial_growth_chunk_size_bytes(-1) {}
+                  initial_growth_chunk_size_bytes(-1),
+                  max_thread_local_cache_bytes(-1),
+                  shrink_idle_time_ms(-1),
+                  shrink_watermark_percent(-1),
+                  use_huge_pages(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
-              int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes)
+              int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
+              int max_thread_local_cache_bytes = -1, int shrink_idle_time_ms = -1,
+              int shrink_watermark_percent = -1, int use_huge_pages = -1)
       : max_mem(max_mem),
         arena_extend_strategy(arena_extend_strategy),
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
-        initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes) {}
+        initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
+        max_thread_local_cache_bytes(max_thread_local_cache_bytes),
+        shrink_idle_time_ms(shrink_idle_time_ms),
+        shrink_watermark_percent(shrink_watermark_percent),
+        use_huge_pages(use_huge_pages) {}
 
   size_t max_mem;                       // use 0 to allow ORT to choose the default
   int arena_extend_strategy;            // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
   int initial_chunk_size_bytes;         // use -1 to allow ORT to choose the default
   int max_dead_bytes_per_chunk;         // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;  // use -1 to allow ORT to choose the default
+  int max_thread_local_cache_bytes;     // use -1 to allow ORT to choose the default, 0 disables thread-local caching
+  int shrink_idle_time_ms;              // use -1 to allow ORT to choose the default, 0 disables idle shrinking
+  int shrink_watermark_percent;         // use -1 to allow ORT to choose the default
+  int use_huge_pages;                   // use -1 to allow ORT to choose the default, 1 backs regions with huge pages
 };
 
 namespace onnxruntime {
@@ -41,6 +55,16 @@ constexpr const char* DML = "DML";
 constexpr const char* OpenVINO_CPU = "OpenVINO_CPU";
 constexpr const char* OpenVINO_GPU = "OpenVINO_GPU";
 
+// The data of a tensor with one of these memory infos is a platform buffer handle instead of a pointer to the tensor
+// elements, so that a graph input or output consumed or produced by the NNAPI or CoreML EP only is bound without
+// copies. The memory infos have a CPU device, so these tensors must not be accessed by other EPs.
+// NNAPI_MEMORY: an ANeuralNetworksMemory*. NNAPI_HARDWARE_BUFFER: an AHardwareBuffer* of AHARDWAREBUFFER_FORMAT_BLOB.
+// COREML_PIXEL_BUFFER: a CVPixelBufferRef of kCVPixelFormatType_OneComponent32Float for a float tensor, the last
+// dimension of the tensor is the width of the pixel buffer and the other dimensions make its height.
+constexpr const char* NNAPI_MEMORY = "NnapiMemory";
+constexpr const char* NNAPI_HARDWARE_BUFFER = "NnapiHardwareBuffer";
+constexpr const char* COREML_PIXEL_BUFFER = "CoreMLPixelBuffer";
+
 
 constexpr size_t kAllocAlignment = 256;
 
@@ -182,6 +182,14 @@ class IExecutionProvider {
    */
   virtual common::Status ReplayGraph() { return Status::OK(); }
 
+  /**
+     Select the graph that IsGraphCaptured() and ReplayGraph() refer to, and that
+     the next run captures if needed, for the calling thread. graph_key identifies
+     the shapes and addresses of the inputs and outputs the graph is captured
+     with. Currently only CUDA execution provider supports it.
+   */
+  virtual void SelectGraph(size_t /*graph_key*/) {}
+
   /**
      Called when session creation is complete
      This provides an opportunity for execution providers to optionally synchronize and
@@ -192,6 +200,25 @@ class IExecutionProvider {
   virtual common::Status SetComputeStream(void*) { return Status::OK(); }
   virtual void* GetComputeStream() const { return nullptr; }
 
+  /**
+     Get the async queue ids of the compute streams the planner may assign the nodes of this provider to.
+     The first id is the queue of GetComputeStream(). With several ids, the planner assigns the branches of the
+     graph to the streams and the fences of the values on cross-stream edges synchronize them.
+  */
+  virtual std::vector<int> GetComputeQueueIds() const { return {0}; }
+
+  /**
+     Called by the executor before computing a node assigned to the compute stream of queue_id on this thread,
+     so the kernels of the provider issue their work to that stream.
+  */
+  virtual common::Status SetCurrentComputeQueue(int /*queue_id*/) const { return Status::OK(); }
+
+  /**
+     Called by the executor after the nodes of a graph assigned to several compute streams have run on this
+     thread, so the work of the other streams is ordered before any later work of the default compute stream.
+  */
+  virtual common::Status JoinComputeQueues() const { return Status::OK(); }
+
   void InsertAllocator(AllocatorPtr allocator);
   void ReplaceAllocator(AllocatorPtr allocator);
   // TODO: temparary sulotion, need to unify the interface in EP and AllocatorManager
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -86,6 +87,11 @@ class KernelRegistry {
   static bool VerifyKernelDef(const Node& node,
                               const KernelDef& kernel_def,
                               std::string& error_str);
+
+  // Key of a node in kernel_lookup_cache_: the map key of the node, its since version, the number of actual
+  // arguments of its formal inputs, and the types of its inputs and outputs. These are all the properties of
+  // the node that VerifyKernelDef checks.
+  static std::string GetLookupCacheKey(const Node& node, const std::string& map_key);
 #endif
 
   static std::string GetMapKey(const std::string& op_name, const std::string& domain, const std::string& provider) {
@@ -104,5 +110,13 @@ class KernelRegistry {
 
   // map from kernel def hash to entry in kernel_creator_fn_map_
   std::unordered_map<HashValue, KernelCreateMap::iterator> kernel_def_hash_lookup_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // The kernels found by TryFindKernel for a node. The registries of the execution providers are shared by the
+  // sessions, so creating many sessions of similar models only verifies the kernel defs once per kind of node.
+  // Cleared when a kernel is registered.
+  mutable OrtMutex kernel_lookup_cache_mutex_;
+  mutable std::unordered_map<std::string, const KernelCreateInfo*> kernel_lookup_cache_;
+#endif
 };
 }  // namespace onnxruntime
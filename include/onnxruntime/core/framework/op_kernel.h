@@ -116,6 +116,22 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to use pre-packed weights loaded from a pre-packed weights cache file
+  // (see kOrtSessionOptionsConfigPrepackedWeightsCacheFile) instead of calling PrePack().
+  // Unlike UseSharedPrePackedBuffers(), PrePack() is not called on this kernel instance first, so any metadata
+  // PrePack() would have kept (e.g. the shape of the packed tensor) must be restored from the tensor.
+  // @param tensor: The initialized constant tensor the buffers were packed from
+  // @param prepacked_buffers: The buffers in the order PrePack() stored them in.
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param used_cached_buffers: Set it to true if the kernel uses the buffers. Otherwise PrePack() is called.
+  virtual Status UseCachedPrePackedBuffers(const Tensor& /*tensor*/,
+                                           std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                           int /*input_idx*/,
+                                           /*out*/ bool& used_cached_buffers) {
+    used_cached_buffers = false;
+    return Status::OK();
+  }
+
   const OrtMemoryInfo& Allocator(int id, OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
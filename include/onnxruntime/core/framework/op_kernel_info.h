@@ -15,6 +15,7 @@ namespace onnxruntime {
 class OrtValueNameIdxMap;
 class FuncManager;
 class DataTransferManager;
+struct ConfigOptions;
 
 // A very light-weight class, which works as an aggregated
 // view of all data needed for constructing a Kernel instance.
@@ -26,7 +27,8 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
                         const IExecutionProvider& execution_provider,
                         const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                         const OrtValueNameIdxMap& mlvalue_name_idx_map,
-                        const DataTransferManager& data_transfer_mgr);
+                        const DataTransferManager& data_transfer_mgr,
+                        const ConfigOptions* config_options = nullptr);
 
   OpKernelInfo(const OpKernelInfo& other);
 
@@ -44,6 +46,10 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
 
   bool TryGetConstantInput(int input_index, const Tensor** constant_input_value) const;
 
+  // Returns the configuration options of the session creating the kernel, which are empty
+  // if the kernel is not created by a session.
+  const ConfigOptions& GetConfigOptions() const noexcept;
+
  private:
   ORT_DISALLOW_MOVE(OpKernelInfo);
   ORT_DISALLOW_ASSIGNMENT(OpKernelInfo);
@@ -56,6 +62,7 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
   const std::unordered_map<int, OrtValue>& constant_initialized_tensors_;
   const OrtValueNameIdxMap& ort_value_name_idx_map_;
   const DataTransferManager& data_transfer_mgr_;
+  const ConfigOptions* config_options_;
   ProtoHelperNodeContext proto_helper_context_;
 };
 
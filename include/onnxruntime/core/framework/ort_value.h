@@ -10,9 +10,9 @@
 #include "core/framework/allocator.h"
 #include "core/framework/data_types.h"
 #include "core/framework/tensor.h"
-#include "core/framework/TensorSeq.h"
 
 namespace onnxruntime {
+class TensorSeq;
 #if !defined(DISABLE_SPARSE_TENSORS)
 class SparseTensor;
 #endif
@@ -134,3 +134,9 @@ inline onnxruntime::SparseTensor* OrtValue::GetMutable<onnxruntime::SparseTensor
   return static_cast<onnxruntime::SparseTensor*>(data_.get());
 }
 #endif
+
+#ifndef SHARED_PROVIDER
+// TensorSeq holds its elements in OrtValues, so it is defined once OrtValue is complete. Included here so OrtValue
+// users get the definition of TensorSeq they need for Get<TensorSeq>().
+#include "core/framework/TensorSeq.h"
+#endif
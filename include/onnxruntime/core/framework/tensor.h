@@ -228,6 +228,10 @@ class Tensor final {
     ORT_ENFORCE(shape_.Size() == new_shape.Size(),
                 "Tensor size (" + std::to_string(shape_.Size()) +
                     ") != new size (" + std::to_string(new_shape.Size()) + ")");
+#ifdef ENABLE_STRIDED_TENSORS
+    ORT_ENFORCE(IsContiguous(), "Cannot reshape a strided tensor without copying it.");
+    strides_.clear();
+#endif
     shape_ = new_shape;
   }
 
@@ -253,7 +257,7 @@ class Tensor final {
   */
   size_t SizeInBytes() const;
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
   /**
    * Get the strides of the tensor.
    */
@@ -281,7 +285,7 @@ class Tensor final {
 
   void ReleaseBuffer();
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
   bool CheckIsContiguous() const;
 #endif
 
@@ -294,7 +298,7 @@ class Tensor final {
   AllocatorPtr buffer_deleter_;
 
   TensorShape shape_;
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
   mutable TensorShapeVector strides_;
   bool is_contiguous_ = true;
 #endif
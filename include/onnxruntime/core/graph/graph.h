@@ -56,6 +56,7 @@ class Graph;
 struct IndexedSubGraph;
 class Model;
 class OpSignature;
+enum class TensorCompression : int8_t;
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 class RuntimeOptimizationRecordContainer;
@@ -460,8 +461,12 @@ class Node {
   */
   void ToProto(ONNX_NAMESPACE::NodeProto& proto, bool update_subgraphs = false) const;
 
+  /** Saves the Node in ORT format.
+  @param initializer_compression Compression of the initializers of any subgraphs.
+  */
   Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                         flatbuffers::Offset<onnxruntime::fbs::Node>& fbs_node) const;
+                         flatbuffers::Offset<onnxruntime::fbs::Node>& fbs_node,
+                         TensorCompression initializer_compression) const;
 
   flatbuffers::Offset<onnxruntime::fbs::NodeEdge>
   SaveEdgesToOrtFormat(flatbuffers::FlatBufferBuilder& builder) const;
@@ -685,6 +690,9 @@ class Graph {
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
   /** Add an initializer tensor to the Graph. */
   void AddInitializedTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
+  /** Add an initializer tensor to the Graph, moving its raw data rather than copying it. */
+  void AddInitializedTensor(ONNX_NAMESPACE::TensorProto&& tensor_proto);
 #endif
 
   /** Remove the initializer tensor with the provided name from the Graph. */
@@ -713,6 +721,13 @@ class Graph {
   /** Removes all initializer tensors from this Graph and releases the memory they were using. */
   void CleanAllInitializedTensors() noexcept;
 
+  /** Releases the memory of the data of the initializer tensor with the provided name, keeping its name, type and
+  shape. This is used to free the data once it has been copied to its final buffer, so that loading a model doesn't
+  hold two copies of all its initializers. The initializer must not be read afterwards.
+  Can be called concurrently for different initializers.
+  */
+  void ReleaseInitializedTensorData(const std::string& tensor_name) noexcept;
+
   /** Returns true if an initializer value can be overridden by a graph input with the same name. */
   bool CanOverrideInitializer() const noexcept { return ir_version_ >= 4; }
 
@@ -1262,8 +1277,12 @@ class Graph {
     return outer_scope_node_arg_names_;
   }
 
+  /** Saves the Graph, including any subgraphs, in ORT format.
+  @param initializer_compression Compression of the initializers, see TensorCompression.
+  */
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                 flatbuffers::Offset<onnxruntime::fbs::Graph>& fbs_graph) const;
+                                 flatbuffers::Offset<onnxruntime::fbs::Graph>& fbs_graph,
+                                 TensorCompression initializer_compression) const;
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
@@ -1305,7 +1324,8 @@ class Graph {
 #if !defined(ORT_MINIMAL_BUILD)
       IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
-      const logging::Logger& logger, std::unique_ptr<Graph>& graph);
+      const logging::Logger& logger, std::unique_ptr<Graph>& graph,
+      bool can_use_flatbuffer_for_initializers = false);
 
   // deserialize a subgraph
   static Status LoadFromOrtFormat(const onnxruntime::fbs::Graph& fbs_graph,
@@ -1665,6 +1685,9 @@ class Graph {
 
   // distinguishes between graph loaded from model file and graph created from scratch
   const bool is_loaded_from_model_file_;
+
+  // If true, the initializers of a graph loaded from ORT format refer to their data in place in the model bytes.
+  bool can_use_flatbuffer_for_initializers_ = false;
 };
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -9,6 +9,8 @@
 
 /* Modifications Copyright (c) Microsoft. */
 
+#include <algorithm>
+#include <chrono>
 #include <type_traits>
 
 #pragma once
@@ -44,6 +46,7 @@
 #include "core/common/spin_pause.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -69,6 +72,10 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   With ThreadOptions::adaptive_spinning, each worker instead spins
+//   for at most twice the moving average of its recent waits for
+//   work, and blocks right away once work arrives less often than
+//   kMaxAdaptiveSpinMicros.
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -221,8 +228,11 @@ class ThreadPoolProfiler {
   void LogStartAndCoreAndBlock(std::ptrdiff_t){};
   void LogCoreAndBlock(std::ptrdiff_t){};
   void LogThreadId(int){};
+  void LogRunStart(int){};
   void LogRun(int){};
+  void LogIdleWait(int, bool){};
   std::string DumpChildThreadStat() { return {}; }
+  std::vector<ThreadPoolSpan> TakeSpans() { return {}; }
 };
 #else
 class ThreadPoolProfiler {
@@ -247,8 +257,11 @@ class ThreadPoolProfiler {
   void LogStartAndCoreAndBlock(std::ptrdiff_t block_size);
   void LogCoreAndBlock(std::ptrdiff_t block_size);  //called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 //called in child thread to log its id
+  void LogRunStart(int thread_idx);                 //called in child thread before running a task
   void LogRun(int thread_idx);                      //called in child thread to log num of run
+  void LogIdleWait(int thread_idx, bool blocked);    //called in child thread to log whether it blocked to find work
   std::string DumpChildThreadStat();                //return all child statitics collected so far
+  std::vector<ThreadPoolSpan> TakeSpans();          //return the spans recorded so far and forget them
 
  private:
   static const char* GetEventName(ThreadPoolEvent);
@@ -257,6 +270,7 @@ class ThreadPoolProfiler {
     int32_t core_ = -1;
     std::vector<std::ptrdiff_t> blocks_;  //block size determined by cost model
     std::vector<onnxruntime::TimePoint> points_;
+    onnxruntime::TimePoint loop_start_;  //start of the current parallel loop
     void LogCore();
     void LogBlockSize(std::ptrdiff_t block_size);
     void LogStart();
@@ -270,12 +284,20 @@ class ThreadPoolProfiler {
   struct ChildThreadStat {
     std::thread::id thread_id_;
     uint64_t num_run_ = 0;
+    uint64_t num_spin_wakeups_ = 0;  //work found while spinning
+    uint64_t num_blocks_ = 0;        //work found after blocking
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  //core that the child thread is running on
+    unsigned os_thread_id_ = 0;  //logging::GetThreadId() of the child thread
+    onnxruntime::TimePoint run_start_;  //start of the task being run, if profiling was enabled when it started
     PaddingToAvoidFalseSharing padding_; //to prevent false sharing
   };
   std::vector<ChildThreadStat> child_thread_stats_;
   std::string thread_pool_name_;
+  //spans are only recorded between Start() and Stop(), so they don't accumulate once profiling is over
+  std::atomic<bool> spans_enabled_{false};
+  OrtMutex spans_mutex_;
+  std::vector<ThreadPoolSpan> spans_;
 };
 #endif
 
@@ -324,6 +346,8 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
                              unsigned n, std::ptrdiff_t block_size) = 0;
   virtual void StartProfiling()  = 0;
   virtual std::string StopProfiling() = 0;
+  virtual std::vector<ThreadPoolSpan> TakeProfilingSpans() = 0;
+  virtual void GetStats(ThreadPoolStats& stats) const = 0;
 };
 
 
@@ -686,6 +710,28 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return profiler_.Stop();
   }
 
+  std::vector<ThreadPoolSpan> TakeProfilingSpans() override {
+    return profiler_.TakeSpans();
+  }
+
+  void GetStats(ThreadPoolStats& stats) const override {
+    stats = ThreadPoolStats{};
+    stats.num_threads = static_cast<int>(num_threads_);
+    stats.uptime_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - created_).count());
+    for (unsigned i = 0; i < num_threads_; i++) {
+      const WorkerData& td = worker_data_[i];
+      stats.queue_depth += td.queue.Size();
+      stats.active_workers += td.GetStatus() == WorkerData::ThreadStatus::Active ? 1 : 0;
+      stats.tasks_local += td.tasks_local.load(std::memory_order_relaxed);
+      stats.tasks_stolen += td.tasks_stolen.load(std::memory_order_relaxed);
+      stats.spin_ns += td.spin_ns.load(std::memory_order_relaxed);
+      stats.busy_ns += td.busy_ns.load(std::memory_order_relaxed);
+    }
+    stats.parallel_sections = parallel_sections_.load(std::memory_order_relaxed);
+    stats.tasks_revoked = tasks_revoked_.load(std::memory_order_relaxed);
+  }
+
   struct Tag {
     constexpr Tag() : v_(0) {
     }
@@ -729,11 +775,13 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(allow_spinning && thread_options.adaptive_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
         blocked_(0),
-        done_(false) {
+        done_(false),
+        created_(std::chrono::steady_clock::now()) {
     // Calculate coprimes of all numbers [1, num_threads].
     // Coprimes are used for random walks over all threads in Steal
     // and NonEmptyQueueIndex. Iteration is based on the fact that if we take
@@ -893,6 +941,10 @@ void EndParallelSectionInternal(PerThread &pt,
     ps.tasks.pop_back();
   }
   profiler_.LogEnd(ThreadPoolProfiler::WAIT_REVOKE);
+  parallel_sections_.fetch_add(1, std::memory_order_relaxed);
+  if (ps.tasks_revoked) {
+    tasks_revoked_.fetch_add(ps.tasks_revoked, std::memory_order_relaxed);
+  }
 
   // Wait for the dispatch task's own work...
   if (ps.dispatch_q_idx > -1) {
@@ -1417,21 +1469,42 @@ int CurrentThreadId() const final {
       status = ThreadStatus::Spinning;
     }
 
+    // Live counters read by GetStats.  Only the worker itself updates
+    // them, so a relaxed load and store is enough (see AddToCounter).
+    std::atomic<uint64_t> tasks_local{0};
+    std::atomic<uint64_t> tasks_stolen{0};
+    std::atomic<uint64_t> spin_ns{0};
+    std::atomic<uint64_t> busy_ns{0};
+
   private:
     std::atomic<ThreadStatus> status{ThreadStatus::Spinning};
     OrtMutex mutex;
     OrtCondVar cv;
   };
 
+  // Upper bound of the spin window with adaptive spinning.  Workers
+  // whose average wait for work is longer block without spinning.
+  static constexpr int64_t kMaxAdaptiveSpinMicros = 500;
+
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
+  // Counters of GetStats that are not per worker
+  const std::chrono::steady_clock::time_point created_;
+  std::atomic<uint64_t> parallel_sections_{0};
+  std::atomic<uint64_t> tasks_revoked_{0};
+
+  static void AddToCounter(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
   // destructor has been called, (2) all threads blocked, and (3) no
@@ -1458,21 +1531,52 @@ int CurrentThreadId() const final {
     const int spin_count = allow_spinning_ ? (1ull<<log2_spin) : 0;
     const int steal_count = spin_count/100;
 
+    // Moving average of the time this worker waited for work, used to size the spin window with adaptive spinning
+    using Clock = std::chrono::steady_clock;
+    constexpr int64_t max_adaptive_spin_ns = kMaxAdaptiveSpinMicros * 1000;
+    int64_t avg_idle_ns = max_adaptive_spin_ns / 2;
+
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
 
     while (!should_exit) {
       Task t = q.PopFront();
+      bool stolen = false;
       if (!t) {
+        const Clock::time_point idle_start = Clock::now();
+        bool blocked = false;
+
+        int spin_limit = spin_count;
+        int64_t spin_window_ns = 0;
+        if (adaptive_spinning_) {
+          // spin through waits up to twice the recent average, but do not spin at all if work is not expected soon
+          spin_window_ns = avg_idle_ns > max_adaptive_spin_ns ? 0 : std::min(2 * avg_idle_ns, max_adaptive_spin_ns);
+          if (spin_window_ns == 0) {
+            spin_limit = 0;
+          }
+        }
+
         // Spin waiting for work.
-        for (int i = 0; i < spin_count && !t && !done_; i++) {
+        for (int i = 0; i < spin_limit && !t && !done_; i++) {
           if (((i+1)%steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
+            stolen = static_cast<bool>(t);
           } else {
             t = q.PopFront();
           }
+          // reading the clock is far more expensive than a pause, so only check it periodically
+          if (adaptive_spinning_ && (i & 63) == 63 &&
+              std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - idle_start).count() >=
+                  spin_window_ns) {
+            break;
+          }
           onnxruntime::concurrency::SpinPause();
         }
+        if (spin_limit > 0) {
+          AddToCounter(td.spin_ns, static_cast<uint64_t>(
+                                       std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - idle_start)
+                                           .count()));
+        }
 
         // Attempt to block
         if (!t) {
@@ -1531,17 +1635,36 @@ int CurrentThreadId() const final {
                         // Post-block update (executed only if we blocked)
                         [&]() {
                           blocked_--;
+                          blocked = true;
                         });
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
           if (!t) t = q.PopFront();
-          if (!t) t = Steal(StealAttemptKind::TRY_ALL);
+          if (!t) {
+            t = Steal(StealAttemptKind::TRY_ALL);
+            stolen = static_cast<bool>(t);
+          }
+        }
+
+        if (t) {
+          if (adaptive_spinning_) {
+            const int64_t idle_ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - idle_start).count();
+            avg_idle_ns += (idle_ns - avg_idle_ns) / 8;
+          }
+          profiler_.LogIdleWait(thread_id, blocked);
         }
       }
       if (t) {
         td.SetActive();
+        profiler_.LogRunStart(thread_id);
+        const Clock::time_point run_start = Clock::now();
         t();
+        AddToCounter(td.busy_ns, static_cast<uint64_t>(
+                                     std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - run_start)
+                                         .count()));
+        AddToCounter(stolen ? td.tasks_stolen : td.tasks_local, 1);
         profiler_.LogRun(thread_id);
         td.SetSpinning();
       }
@@ -16,6 +16,7 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
 #include <functional>
@@ -130,6 +131,44 @@ struct TensorOpCost {
 
 namespace concurrency {
 
+// A task run by a worker thread of the pool, or a parallel loop run by the thread that called it, recorded while
+// the pool is profiled so that the profiler can show the work of each thread next to the node events.
+struct ThreadPoolSpan {
+  // logging::GetThreadId() of the thread that ran it
+  unsigned thread_id;
+  // true for a parallel loop on the calling thread, false for a task run by a worker thread
+  bool is_parallel_loop;
+  TimePoint start;
+  TimePoint end;
+};
+
+// Live counters of a thread pool, e.g. to see how saturated the intra-op pool is. They are cumulative since the pool
+// was created, except queue_depth and active_workers which are a snapshot. Readers wanting rates should take the
+// difference of two reads.
+struct ThreadPoolStats {
+  // number of worker threads, the threads calling into the pool are not included
+  int num_threads;
+  // time since the pool was created
+  uint64_t uptime_ns;
+  // tasks waiting in the work queues of the workers
+  uint64_t queue_depth;
+  // workers running a task
+  uint64_t active_workers;
+  // tasks a worker took from its own queue
+  uint64_t tasks_local;
+  // tasks a worker stole from the queue of another worker
+  uint64_t tasks_stolen;
+  // parallel sections, including the ones of single parallel loops, run on the pool
+  uint64_t parallel_sections;
+  // tasks of parallel sections that no worker picked up and that the calling thread took back at the end
+  uint64_t tasks_revoked;
+  // time the workers spent spinning while waiting for work, summed over the workers
+  uint64_t spin_ns;
+  // time the workers spent running tasks, summed over the workers. busy_ns / (uptime_ns * num_threads) is the busy
+  // ratio of the pool
+  uint64_t busy_ns;
+};
+
 template <typename Environment>
 class ThreadPoolTempl;
 
@@ -160,10 +199,46 @@ class ThreadPool {
              bool low_latency_hint,
              bool force_hybrid = false);
 
+  // Constructs a view that runs work on the threads of "shared_pool", e.g. the
+  // global thread pool of the environment, on behalf of one session.  Parallel
+  // loops run through the view use at most "max_degree_of_parallelism" threads
+  // (including the caller) if it is positive.  If "share_weight" is positive,
+  // the threads of the shared pool are also divided between the views that are
+  // inside an ActiveScope in proportion to their weights.
+  //
+  // REQUIRES: shared_pool outlives the view
+  ThreadPool(ThreadPool* shared_pool, int max_degree_of_parallelism, int share_weight);
+
   // Waits until all scheduled work has finished and then destroy the
   // set of threads.
   ~ThreadPool();
 
+  // Marks the view "tp" as running work, e.g. for the duration of a session's
+  // Run() call, so that its share weight is counted when dividing the shared
+  // pool between views.  Has no effect if tp is not a view.  Scopes may be
+  // nested or concurrent, a view is counted once while any scope is active.
+  class ActiveScope {
+   public:
+    explicit ActiveScope(ThreadPool* tp);
+    ~ActiveScope();
+
+   private:
+    ThreadPool* tp_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ActiveScope);
+  };
+
+  // Utilization of the shared pool by the parallel loops run through a view.
+  struct UsageStats {
+    uint64_t num_parallel_loops = 0;
+    // sum of the threads (including the caller) each loop was allowed to use
+    uint64_t total_degree_of_parallelism = 0;
+    // wall clock time of each loop multiplied by the threads it was allowed to use
+    uint64_t thread_microseconds = 0;
+  };
+
+  // Returns the usage of the view "tp".  All counters are zero if tp is not a view.
+  static UsageStats GetUsageStats(const ThreadPool* tp);
+
   // Start and end a multi-loop parallel section.  Parallel loops can
   // be executed directly (without using this API), but entering a
   // parallel section allows the runtime system to amortize loop
@@ -365,6 +440,12 @@ class ThreadPool {
   // StartProfiling and StopProfiling are not to be consumed as public-facing API
   static void StartProfiling(concurrency::ThreadPool* tp);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
+  // Returns the spans recorded since the last call while profiling, and forgets them.
+  static std::vector<ThreadPoolSpan> TakeProfilingSpans(concurrency::ThreadPool* tp);
+
+  // Reads the live counters of the pool. All of them are 0 for a pool without worker threads, e.g. nullptr.
+  // A view of a pool reads the counters of the pool it shares.
+  static void GetStats(const concurrency::ThreadPool* tp, ThreadPoolStats& stats);
 
  private:
   friend class LoopCounter;
@@ -373,6 +454,10 @@ class ThreadPool {
   // value returned by DegreeOfParallelism to code using the pool.
   int NumThreads() const;
 
+  // Returns the number of threads (including the caller) a parallel loop may use, which
+  // is NumThreads() + 1 unless this is a view with a quota.
+  int MaxParallelism() const;
+
   // Returns current thread id between 0 and NumThreads() - 1, if called from a
   // thread in the pool. Returns -1 otherwise.
   int CurrentThreadId() const;
@@ -390,8 +475,10 @@ class ThreadPool {
   // the number of threads available in the pool.
   // When (i+1)*block_size > total, fn(i*block_size, total) is called instead.
   // Requires 0 < block_size <= total.
+  // At most max_parallelism threads (including the caller) are used if it is positive, else MaxParallelism().
   void ParallelForFixedBlockSizeScheduling(std::ptrdiff_t total, std::ptrdiff_t block_size,
-                                           const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn);
+                                           const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn,
+                                           int max_parallelism = 0);
 
   // Return whether or not the calling thread should run a loop of
   // num_iterations divided in chunks of block_size in parallel.  If not,
@@ -415,6 +502,10 @@ class ThreadPool {
 
   std::string StopProfiling();
 
+  std::vector<ThreadPoolSpan> TakeProfilingSpans();
+
+  void GetStats(ThreadPoolStats& stats) const;
+
   ThreadOptions thread_options_;
 
   // If a thread pool is created with degree_of_parallelism != 1 then an underlying
@@ -428,6 +519,19 @@ class ThreadPool {
 
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
+
+  // Set if this ThreadPool is a view of another pool's threads.
+  ThreadPool* shared_pool_ = nullptr;
+  int max_degree_of_parallelism_ = 0;
+  int share_weight_ = 0;
+  std::atomic<int> num_active_scopes_{0};
+
+  // Sum of the share weights of the views of this pool that are active.
+  std::atomic<int> active_share_weight_{0};
+
+  std::atomic<uint64_t> num_parallel_loops_{0};
+  std::atomic<uint64_t> total_degree_of_parallelism_{0};
+  std::atomic<uint64_t> thread_microseconds_{0};
 };
 
 }  // namespace concurrency
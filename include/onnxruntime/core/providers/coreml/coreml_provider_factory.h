@@ -29,6 +29,12 @@ enum COREMLFlags {
   COREML_FLAG_LAST = COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE,
 };
 
+// A graph input or output only consumed or produced by the CoreML EP can be bound to a CVPixelBuffer of
+// kCVPixelFormatType_OneComponent32Float without copying it to and from the CPU memory of an OrtValue.
+// Create the OrtValue using CreateTensorWithDataAsOrtValue with the CVPixelBufferRef as the data, and an
+// OrtMemoryInfo named "CoreMLPixelBuffer". The last dimension of the tensor is the width of the pixel buffer,
+// and the other dimensions make its height.
+
 #ifdef __cplusplus
 extern "C" {
 #endif
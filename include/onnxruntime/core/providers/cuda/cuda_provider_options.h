@@ -27,4 +27,10 @@ struct OrtCUDAProviderOptionsV2 {
   int cudnn_conv_use_max_workspace;                        // flag specifying if maximum workspace can be used in cudnn conv algo search.
   int enable_cuda_graph;                                   // flag specifying if the CUDA graph is to be captured for the model.
   int cudnn_conv1d_pad_to_nc1d;                            // flag specifying if pad Conv1D's input [N,C,D] to [N,C,1,D] or [N,C,D,1].
+  int num_compute_streams;                                 // number of compute streams the branches of the graph run on.
+  int max_cuda_graphs;                                     // maximum number of CUDA graphs captured per thread, one per input signature.
+  int use_cuda_mempool;                                    // flag specifying if the device memory is allocated from the CUDA memory pool of the device.
+  size_t cuda_mempool_release_threshold;                   // bytes of freed memory the CUDA memory pool holds on to.
+  const char* cudnn_conv_algo_cache_file;                  // file the cudnn conv algos found by EXHAUSTIVE search are persisted to.
+  const char* fused_elementwise_cache_dir;                 // directory the PTX of the FusedElementwise kernels compiled by NVRTC is persisted to.
 };
@@ -50,6 +50,11 @@ enum NNAPIFlags {
   NNAPI_FLAG_LAST = NNAPI_FLAG_CPU_ONLY,
 };
 
+// A graph input or output only consumed or produced by the NNAPI EP can be bound to an ANeuralNetworksMemory, or to
+// an AHardwareBuffer of AHARDWAREBUFFER_FORMAT_BLOB (Android API level 29+), without copying it to and from the CPU
+// memory of an OrtValue. Create the OrtValue using CreateTensorWithDataAsOrtValue with the ANeuralNetworksMemory* or
+// the AHardwareBuffer* as the data, and an OrtMemoryInfo named "NnapiMemory" or "NnapiHardwareBuffer" respectively.
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,4 +29,8 @@ struct OrtTensorRTProviderOptionsV2 {
   int trt_engine_decryption_enable;             // enable engine decryption. Default 0 = false, nonzero = true
   const char* trt_engine_decryption_lib_path;   // specify engine decryption library path
   int trt_force_sequential_engine_build;        // force building TensorRT engine sequentially. Default 0 = false, nonzero = true
+  int trt_engine_build_async;                   // build TensorRT engines in the background, running the subgraphs on CUDA meanwhile. Default 0 = false, nonzero = true
+  const char* trt_profile_min_shapes;           // minimum shapes of the explicit optimization profiles, e.g. "input_a:1x3,input_a:8x3"
+  const char* trt_profile_max_shapes;           // maximum shapes of the explicit optimization profiles
+  const char* trt_profile_opt_shapes;           // optimal shapes of the explicit optimization profiles
 };
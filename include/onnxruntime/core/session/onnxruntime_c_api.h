@@ -225,6 +225,7 @@ typedef enum OrtErrorCode {
   ORT_NOT_IMPLEMENTED,
   ORT_INVALID_GRAPH,
   ORT_EP_FAIL,
+  ORT_TIMEOUT,
 } OrtErrorCode;
 
 typedef enum OrtOpAttrType {
@@ -293,6 +294,16 @@ typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
 
+/** \brief Callback invoked by OrtApi::RunAsync once the run has completed
+*
+* \param[in] user_data The value passed to OrtApi::RunAsync
+* \param[in] outputs The `outputs` array passed to OrtApi::RunAsync, holding the output values
+* \param[in] num_outputs Number of elements in `outputs`
+* \param[in] status nullptr on success, otherwise the error. Must be freed with OrtApi::ReleaseStatus
+*/
+typedef void(ORT_API_CALL* RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs,
+                                               OrtStatusPtr status);
+
 /** \brief Graph optimization level
 *
 * Refer to https://www.onnxruntime.ai/docs/resources/graph-optimizations.html
@@ -515,7 +526,7 @@ typedef struct OrtMIGraphXProviderOptions {
 */
 typedef struct OrtOpenVINOProviderOptions {
 #ifdef __cplusplus
-  OrtOpenVINOProviderOptions() : device_type{}, enable_vpu_fast_compile{}, device_id{}, num_of_threads{}, use_compiled_network{}, blob_dump_path{}, context{}, enable_opencl_throttling{} {}
+  OrtOpenVINOProviderOptions() : device_type{}, enable_vpu_fast_compile{}, device_id{}, num_of_threads{}, use_compiled_network{}, blob_dump_path{}, context{}, enable_opencl_throttling{}, num_streams{} {}
 #endif
   /** \brief Device type string
   *
@@ -529,8 +540,49 @@ typedef struct OrtOpenVINOProviderOptions {
   const char* blob_dump_path;          // path is set to empty by default
   void* context;
   unsigned char enable_opencl_throttling; ///< 0 = disabled, nonzero = enabled
+  /** \brief Number of CPU or GPU throughput streams the subgraphs are compiled with
+  *
+  * Each stream runs its own inference request, so concurrent Run calls execute in parallel up to this number.
+  * The pool of inference requests of a subgraph has at least as many requests as streams.
+  * 0 = use the default of the device.
+  */
+  size_t num_streams;
 } OrtOpenVINOProviderOptions;
 
+/** \brief Live counters of a thread pool
+*
+* Returned by OrtApi::SessionGetIntraOpThreadPoolStats. The counters are cumulative since the pool was created, except
+* queue_depth and active_workers which are a snapshot; take the difference of two reads to get rates.
+*/
+typedef struct OrtThreadPoolStats {
+  int num_threads;            ///< Number of worker threads. 0 if the session runs without an intra-op thread pool.
+  uint64_t uptime_ns;         ///< Time since the pool was created
+  uint64_t queue_depth;       ///< Tasks waiting in the work queues of the workers
+  uint64_t active_workers;    ///< Workers running a task
+  uint64_t tasks_local;       ///< Tasks a worker took from its own queue
+  uint64_t tasks_stolen;      ///< Tasks a worker stole from the queue of another worker
+  uint64_t parallel_sections; ///< Parallel sections, including single parallel loops, run on the pool
+  uint64_t tasks_revoked;     ///< Tasks of parallel sections no worker picked up, taken back by the calling thread
+  uint64_t spin_ns;           ///< Time the workers spent spinning while waiting for work, summed over the workers
+  /** Time the workers spent running tasks, summed over the workers.
+  * busy_ns / (uptime_ns * num_threads) is the busy ratio of the pool.
+  */
+  uint64_t busy_ns;
+} OrtThreadPoolStats;
+
+/** \brief Direct view of a tensor input or output of a custom op kernel
+*
+* Filled by OrtApi::KernelContext_GetInputTensorViews and OrtApi::KernelContext_GetOutputTensorViews. The pointers
+* are owned by onnxruntime and are valid until the KernelCompute callback returns. String tensors are not supported.
+*/
+typedef struct OrtTensorView {
+  void* data;                      ///< Tensor data. nullptr for a missing optional input. Inputs must not be written.
+  const int64_t* dims;             ///< Array of num_dims dimensions
+  size_t num_dims;                 ///< Number of dimensions
+  size_t element_count;            ///< Number of elements
+  ONNXTensorElementDataType type;  ///< Element type. ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED for a missing input.
+} OrtTensorView;
+
 struct OrtApi;
 typedef struct OrtApi OrtApi;
 
@@ -2623,6 +2675,15 @@ struct OrtApi {
   *  Only relevant if arena strategy is `kNextPowerOfTwo`. Use -1 to allow ORT to choose the default.
   *  Ultimately, the allocation size is determined by the allocation memory request.
   *  Further allocation sizes are governed by the arena extend strategy.
+  * "max_thread_local_cache_bytes": Maximum number of bytes of freed chunks each thread may keep in a private
+  *  cache to serve its next allocations without taking the arena lock. Use 0 to disable the cache. Default is 0.
+  * "shrink_idle_time_ms": Length in milliseconds of the windows in which the arena tracks the high-water mark of the
+  *  memory in use. Once a window has passed, unused allocation regions are released until the arena holds at most
+  *  `shrink_watermark_percent` of that high-water mark. Use 0 to disable idle shrinking. Default is 0.
+  * "shrink_watermark_percent": Memory kept by idle shrinking, as a percentage (at least 100) of the high-water mark
+  *  of the last window. Default is 100.
+  * "use_huge_pages": 1 = back the memory of the allocator with huge pages where the platform supports them
+  *  (only used by allocators created with OrtApi::CreateAndRegisterAllocator), 0 = regular pages. Default is 0.
   *
   * \param[in] arena_config_keys Keys to configure the arena
   * \param[in] arena_config_values Values to configure the arena
@@ -3421,6 +3482,205 @@ struct OrtApi {
   * \since Version 1.12.
   */
   ORT_CLASS_RELEASE(Op);
+
+  /** \brief Run the model in an ::OrtSession without waiting for it to complete
+  *
+  * The run is scheduled on the inter-op thread pool of the session if it has one, on the intra-op thread pool
+  * otherwise, and `run_async_callback` is invoked on a thread of that pool once the run has completed.
+  * The arguments are the same as OrtApi::Run. `inputs` are referenced so the caller may release them once this
+  * function returns.
+  *
+  * \param[in] session Must stay valid until `run_async_callback` has been invoked
+  * \param[in] run_options If nullptr, will use a default ::OrtRunOptions. Otherwise it must stay valid until
+  *     `run_async_callback` has been invoked
+  * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+  * \param[in] inputs Array of ::OrtValue%s of the input values
+  * \param[in] input_len Number of elements in the input_names and inputs arrays
+  * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+  * \param[in] output_names_len Number of elements in the output_names and outputs array
+  * \param[out] outputs Array of ::OrtValue%s as in OrtApi::Run. Must stay valid until `run_async_callback` has
+  *     been invoked, and is passed to it.
+  * \param[in] run_async_callback Invoked with the outputs and the status of the run
+  * \param[in] user_data Passed as is to `run_async_callback`
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  * Returns an error without invoking `run_async_callback` if the run could not be scheduled, e.g. because the
+  * session has no thread pool with worker threads.
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(RunAsync, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** outputs,
+                  _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+  /** \brief Warm up an ::OrtSession by running it with representative input shapes
+  *
+  * The first run of a shape is much slower than the next ones, as it grows the arenas, creates the memory pattern
+  * and runs the algorithm searches of the kernels. This runs the model twice for each set of input shapes with
+  * zero-filled inputs, so that the first requests run at the steady state speed.
+  *
+  * \param[in] session
+  * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+  * \param[in] input_names Array of null terminated UTF8 encoded strings of the names of the inputs with a shape that
+  *     is not fixed. The inputs with a fixed shape may be omitted.
+  * \param[in] input_len Number of elements in the input_names array
+  * \param[in] input_shapes Array of `num_warmups * input_len` shapes. `input_shapes[i * input_len + j]` is the shape
+  *     of `input_names[j]` in the i-th warm-up.
+  * \param[in] input_shape_lens Array of `num_warmups * input_len` numbers of dimensions of the `input_shapes`
+  * \param[in] num_warmups Number of sets of input shapes
+  * \param[in] freeze_arenas If non-zero, the arenas of the session are then limited to the memory they have
+  *     allocated: later allocations that don't fit in it fail instead of growing the arenas.
+  *     Arenas shared with other sessions are frozen as well.
+  * \param[out] run_durations_us Optional array of `2 * num_warmups` elements. Filled with the duration of the two runs
+  *     of each warm-up, in microseconds.
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(WarmupSession, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                  _In_reads_(num_warmups* input_len) const int64_t* const* input_shapes,
+                  _In_reads_(num_warmups* input_len) const size_t* input_shape_lens, size_t num_warmups,
+                  int freeze_arenas, _Out_opt_ int64_t* run_durations_us);
+
+  /** \brief Run independent requests with the same inputs and outputs
+  *
+  * The requests may have inputs of different shapes. They are spread over the thread pools of the session, the
+  * inter-op one if the session has one, so several requests run at the same time. Requests with inputs of the same
+  * types, shapes and devices reuse the setup of the previous request run by the same thread.
+  *
+  * \param[in] session
+  * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+  * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+  * \param[in] inputs Array of `batch_size * input_len` ::OrtValue%s. `inputs[i * input_len + j]` is the input
+  *     `input_names[j]` of the i-th request.
+  * \param[in] input_len Number of elements in the input_names array
+  * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+  * \param[in] output_names_len Number of elements in the output_names array
+  * \param[in] batch_size Number of requests
+  * \param[out] outputs Array of `batch_size * output_names_len` ::OrtValue%s. `outputs[i * output_names_len + j]` is
+  *     the output `output_names[j]` of the i-th request. The ::OrtValue%s that are nullptr are allocated and must be
+  *     freed with OrtApi::ReleaseValue, the others are pre-allocated outputs written to.
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  * If any request fails the error of the first failed request is returned, and no outputs are allocated.
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(RunBatch, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(batch_size* input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  size_t batch_size, _Inout_updates_all_(batch_size* output_names_len) OrtValue** outputs);
+
+  /** \brief Get the sampled latency histograms of the op types of a session
+  *
+  * Requires the session config entry "session.profiling_sample_rate" to be set to N > 0, in which case one in N runs
+  * times the kernels of the main graph and adds their durations to the histogram of their op type. The histograms can
+  * be read at any time, including while the session runs.
+  *
+  * Bucket 0 of a histogram counts the kernels that took less than 1 microsecond, bucket i > 0 the ones that took from
+  * 2^(i-1) up to 2^i microseconds. The last bucket also counts all the longer ones.
+  *
+  * \param[in] session
+  * \param[in] allocator Allocator used to allocate the returned buffers
+  * \param[out] op_types Buffer holding the op types concatenated without null terminators, must be freed with
+  *     `allocator`. nullptr if there are no op types.
+  * \param[out] op_type_lengths Array of `num_op_types` lengths of the op types in the buffer, must be freed with
+  *     `allocator`. nullptr if there are no op types.
+  * \param[out] bucket_counts Array of `num_op_types * num_buckets` counts. `bucket_counts[i * num_buckets + j]` is
+  *     bucket j of the histogram of the i-th op type. Must be freed with `allocator`. nullptr if there are no op types.
+  * \param[out] num_op_types Number of op types
+  * \param[out] num_buckets Number of buckets per histogram
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  * An error is returned if the session does not collect the histograms.
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(SessionGetOpLatencyHistograms, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_result_maybenull_ char** op_types, _Outptr_result_maybenull_ size_t** op_type_lengths,
+                  _Outptr_result_maybenull_ uint64_t** bucket_counts, _Out_ size_t* num_op_types,
+                  _Out_ size_t* num_buckets);
+
+  /** \brief Get the live counters of the intra-op thread pool used by a session
+  *
+  * Can be called at any time, including while the session runs, e.g. to watch the saturation of the pool.
+  * With the global thread pools of the environment (see OrtApi::DisablePerSessionThreads), or a thread pool shared by
+  * several sessions, the counters cover the work of all the sessions using the pool.
+  *
+  * \param[in] session
+  * \param[out] stats The counters. All are 0 if the session runs without an intra-op thread pool (1 thread).
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(SessionGetIntraOpThreadPoolStats, _In_ const OrtSession* session, _Out_ OrtThreadPoolStats* stats);
+
+  /** \brief Get the sampled input and node output shapes of a session as JSON
+  *
+  * Requires the session config entry "session.shape_statistics_sample_rate" to be set to N > 0, in which case one in
+  * N runs records the shapes of its inputs and of the outputs of each node of the main graph. The statistics can be
+  * read at any time, including while the session runs.
+  *
+  * The JSON object has "sample_rate", "sampled_runs", "inputs", the most frequent input signatures, and "nodes",
+  * with the "name", "op_type" and most frequent "output_shapes" of each node. Each shape has a "count" and a
+  * "max_overcount": once more distinct shapes than are tracked have been seen, the count of a shape can include up
+  * to max_overcount occurrences of the shapes it replaced.
+  *
+  * \param[in] session
+  * \param[in] allocator Allocator used to allocate the returned string
+  * \param[out] out Null terminated JSON string, must be freed with `allocator`
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  * An error is returned if the session does not collect the shape statistics.
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(SessionGetShapeStatistics, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /// \name OrtKernelContext
+  /// @{
+
+  /** \brief Get the data, shape and element type of the first inputs of a custom op kernel in one call
+  *
+  * Replaces a KernelContext_GetInput, GetTensorTypeAndShape, GetDimensions, GetTensorMutableData and
+  * ReleaseTensorTypeAndShapeInfo sequence per input, and allocates nothing.
+  *
+  * \param[in] context ::OrtKernelContext instance passed to the KernelCompute callback
+  * \param[out] views Array of `count` views, `views[i]` is filled with input i. An input that is missing, or that
+  *     was pre-packed by OrtCustomOp::KernelPrePack, gets a nullptr `data`.
+  * \param[in] count Number of inputs to get, at most the input count of the kernel
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(KernelContext_GetInputTensorViews, _In_ const OrtKernelContext* context,
+                  _Out_writes_all_(count) OrtTensorView* views, size_t count);
+
+  /** \brief Allocate the first outputs of a custom op kernel in one call
+  *
+  * \param[in] context ::OrtKernelContext instance passed to the KernelCompute callback
+  * \param[in] dims Array of `count` shapes, `dims[i]` is the shape of output i
+  * \param[in] num_dims Array of `count` numbers of dimensions of the shapes
+  * \param[out] views Array of `count` views, `views[i]` is filled with output i
+  * \param[in] count Number of outputs to allocate, at most the output count of the kernel
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(KernelContext_GetOutputTensorViews, _Inout_ OrtKernelContext* context,
+                  _In_reads_(count) const int64_t* const* dims, _In_reads_(count) const size_t* num_dims,
+                  _Out_writes_all_(count) OrtTensorView* views, size_t count);
+  /// @}
 };
 
 /*
@@ -3471,6 +3731,33 @@ struct OrtCustomOp {
   // Returns the characteristics of the input & output tensors
   OrtCustomOpInputOutputCharacteristic(ORT_API_CALL* GetInputCharacteristic)(_In_ const struct OrtCustomOp* op, _In_ size_t index);
   OrtCustomOpInputOutputCharacteristic(ORT_API_CALL* GetOutputCharacteristic)(_In_ const struct OrtCustomOp* op, _In_ size_t index);
+
+  // The callbacks below are optional and may be nullptr. They are only read when version is 12 or later.
+
+  // Infers the shape of output `output_index` when the model is loaded, so that the memory planner knows the size of
+  // the output. `input_dims[i]` has `input_num_dims[i]` dimensions, -1 for an unknown dimension. `input_num_dims[i]`
+  // is -1 when the rank of input i is unknown, and `input_dims[i]` is then nullptr.
+  // Writes at most `max_num_dims` dimensions to `output_dims`, -1 for an unknown dimension, and returns the rank of
+  // the output, or -1 if it is unknown. A returned rank larger than `max_num_dims` is ignored.
+  int64_t(ORT_API_CALL* InferOutputShape)(_In_ const struct OrtCustomOp* op, _In_ size_t output_index,
+                                          _In_ const int64_t* const* input_dims, _In_ const int64_t* input_num_dims,
+                                          _In_ size_t input_count, _Out_writes_all_(max_num_dims) int64_t* output_dims,
+                                          _In_ size_t max_num_dims);
+
+  // Pre-packing of the constant initializer inputs, in the same way as the built-in kernels. The packed buffer is
+  // allocated and owned by onnxruntime, so it can be shared between sessions through the prepacked weights container
+  // (see OrtApi::CreateSessionWithPrepackedWeightsContainer).
+  //
+  // KernelGetPrePackSize returns the size in bytes of the packed form of the constant input `input_index`, or 0 to
+  // not pack it. KernelPrePack then writes the packed form into `packed_buffer`. The content must only depend on the
+  // input and the attributes of the node. Once packed, the input is released and is missing in KernelCompute.
+  // KernelUsePrePacked hands the kernel the packed buffer to use in KernelCompute, which is either the buffer it
+  // packed or an identical one packed by another kernel. The buffer is valid until KernelDestroy.
+  size_t(ORT_API_CALL* KernelGetPrePackSize)(_In_ void* op_kernel, _In_ const OrtValue* input, _In_ size_t input_index);
+  void(ORT_API_CALL* KernelPrePack)(_In_ void* op_kernel, _In_ const OrtValue* input, _In_ size_t input_index,
+                                    _Out_ void* packed_buffer);
+  void(ORT_API_CALL* KernelUsePrePacked)(_In_ void* op_kernel, _In_ size_t input_index,
+                                         _In_ const void* packed_buffer);
 };
 
 /*
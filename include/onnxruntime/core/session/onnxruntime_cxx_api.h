@@ -428,6 +428,58 @@ struct Session : Base<OrtSession> {
 
   void Run(const RunOptions& run_options, const struct IoBinding&);  ///< Wraps OrtApi::RunWithBinding
 
+  /** \brief Run the model without waiting for it to complete
+  *
+  * Wraps OrtApi::RunAsync
+  *
+  * \param[in] run_options Must stay valid until `callback` has been invoked
+  * \param[in] input_names Array of null terminated strings of length input_count that is the list of input names
+  * \param[in] input_values Array of Value objects of length input_count that is the list of input values
+  * \param[in] input_count Number of inputs (the size of the input_names & input_values arrays)
+  * \param[in] output_names Array of C style strings of length output_count that is the list of output names
+  * \param[out] output_values Array of Value objects of length output_count. Must stay valid until `callback` has
+  *     been invoked. Null values are filled with outputs allocated by ORT.
+  * \param[in] output_count Number of outputs (the size of the output_names & output_values arrays)
+  * \param[in] callback Invoked on a thread of the session's thread pool once the run has completed
+  * \param[in] user_data Passed as is to `callback`
+  */
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                size_t input_count, const char* const* output_names, Value* output_values, size_t output_count,
+                RunAsyncCallbackFn callback, void* user_data);
+
+  /** \brief Run independent requests with the same inputs and outputs, which may have different shapes
+  *
+  * Wraps OrtApi::RunBatch
+  *
+  * \param[in] run_options
+  * \param[in] input_names Array of null terminated strings of length input_count that is the list of input names
+  * \param[in] input_values Array of Value objects of length batch_size * input_count. `input_values[i * input_count + j]`
+  *     is the input `input_names[j]` of the i-th request
+  * \param[in] input_count Number of inputs (the size of the input_names array)
+  * \param[in] output_names Array of C style strings of length output_count that is the list of output names
+  * \param[in] output_count Number of outputs (the size of the output_names array)
+  * \param[in] batch_size Number of requests
+  * \return A std::vector of Value objects of length batch_size * output_count, in the order of input_values
+  */
+  std::vector<Value> RunBatch(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                              size_t input_count, const char* const* output_names, size_t output_count,
+                              size_t batch_size);
+
+  /** \brief Warm up the session by running it with representative input shapes
+  *
+  * Wraps OrtApi::WarmupSession
+  *
+  * \param[in] run_options
+  * \param[in] input_names Array of null terminated strings of length input_count that is the list of the input names
+  * \param[in] input_count Number of inputs (the size of the input_names array)
+  * \param[in] input_shapes Shapes of the inputs. `input_shapes[i * input_count + j]` is the shape of `input_names[j]`
+  *     in the i-th warm-up. If input_count is 0, a single warm-up runs with the fixed input shapes
+  * \param[in] freeze_arenas Limit the arenas of the session to the memory they have allocated once warmed up
+  * \return The durations of the two runs of each warm-up, in microseconds
+  */
+  std::vector<int64_t> Warmup(const RunOptions& run_options, const char* const* input_names, size_t input_count,
+                              const std::vector<std::vector<int64_t>>& input_shapes, bool freeze_arenas);
+
   size_t GetInputCount() const;                   ///< Returns the number of model inputs
   size_t GetOutputCount() const;                  ///< Returns the number of model outputs
   size_t GetOverridableInitializerCount() const;  ///< Returns the number of inputs that have defaults that can be overridden
@@ -436,6 +488,10 @@ struct Session : Base<OrtSession> {
   char* GetOutputName(size_t index, OrtAllocator* allocator) const;                  ///< Wraps OrtApi::SessionGetOutputName
   char* GetOverridableInitializerName(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
   char* EndProfiling(OrtAllocator* allocator) const;                                 ///< Wraps OrtApi::SessionEndProfiling
+  /// Wraps OrtApi::SessionGetOpLatencyHistograms. Returns the op types with their latency histograms
+  std::vector<std::pair<std::string, std::vector<uint64_t>>> GetOpLatencyHistograms(OrtAllocator* allocator) const;
+  OrtThreadPoolStats GetIntraOpThreadPoolStats() const;  ///< Wraps OrtApi::SessionGetIntraOpThreadPoolStats
+  std::string GetShapeStatistics(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetShapeStatistics
   uint64_t GetProfilingStartTimeNs() const;                                          ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
   ModelMetadata GetModelMetadata() const;                                            ///< Wraps OrtApi::SessionGetModelMetadata
 
@@ -970,6 +1026,12 @@ struct CustomOpApi {
   size_t KernelContext_GetOutputCount(const OrtKernelContext* context);
   OrtValue* KernelContext_GetOutput(OrtKernelContext* context, _In_ size_t index, _In_ const int64_t* dim_values, size_t dim_count);
   void* KernelContext_GetGPUComputeStream(const OrtKernelContext* context);
+  /// Wraps OrtApi::KernelContext_GetInputTensorViews
+  void KernelContext_GetInputTensorViews(const OrtKernelContext* context, _Out_writes_all_(count) OrtTensorView* views, size_t count);
+  /// Wraps OrtApi::KernelContext_GetOutputTensorViews
+  void KernelContext_GetOutputTensorViews(OrtKernelContext* context, _In_reads_(count) const int64_t* const* dims,
+                                          _In_reads_(count) const size_t* num_dims, _Out_writes_all_(count) OrtTensorView* views,
+                                          size_t count);
 
   void ThrowOnError(OrtStatus* result);
 
@@ -1031,6 +1093,12 @@ struct CustomOpBase : OrtCustomOp {
 #endif
     OrtCustomOp::GetInputCharacteristic = [](const OrtCustomOp* this_, size_t index) { return static_cast<const TOp*>(this_)->GetInputCharacteristic(index); };
     OrtCustomOp::GetOutputCharacteristic = [](const OrtCustomOp* this_, size_t index) { return static_cast<const TOp*>(this_)->GetOutputCharacteristic(index); };
+
+    // Optional callbacks, a derived op assigns the ones it implements in its constructor
+    OrtCustomOp::InferOutputShape = nullptr;
+    OrtCustomOp::KernelGetPrePackSize = nullptr;
+    OrtCustomOp::KernelPrePack = nullptr;
+    OrtCustomOp::KernelUsePrePacked = nullptr;
   }
 
   // Default implementation of GetExecutionProviderType that returns nullptr to default to the CPU provider
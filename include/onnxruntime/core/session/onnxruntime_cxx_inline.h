@@ -605,6 +605,54 @@ inline void Session::Run(const RunOptions& run_options, const IoBinding& io_bind
   ThrowOnError(GetApi().RunWithBinding(p_, run_options, io_binding));
 }
 
+inline void Session::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                              size_t input_count, const char* const* output_names, Value* output_values,
+                              size_t output_count, RunAsyncCallbackFn callback, void* user_data) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunAsync(p_, run_options, input_names, ort_input_values, input_count, output_names,
+                                 output_count, ort_output_values, callback, user_data));
+}
+
+inline std::vector<Value> Session::RunBatch(const RunOptions& run_options, const char* const* input_names,
+                                            const Value* input_values, size_t input_count,
+                                            const char* const* output_names, size_t output_count, size_t batch_size) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  std::vector<Value> output_values;
+  output_values.reserve(batch_size * output_count);
+  for (size_t i = 0; i < batch_size * output_count; i++)
+    output_values.emplace_back(nullptr);
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values.data());
+  ThrowOnError(GetApi().RunBatch(p_, run_options, input_names, ort_input_values, input_count, output_names,
+                                 output_count, batch_size, ort_output_values));
+  return output_values;
+}
+
+inline std::vector<int64_t> Session::Warmup(const RunOptions& run_options, const char* const* input_names,
+                                            size_t input_count, const std::vector<std::vector<int64_t>>& input_shapes,
+                                            bool freeze_arenas) {
+  const size_t num_warmups = input_count == 0 ? 1 : input_shapes.size() / input_count;
+  if (num_warmups * input_count != input_shapes.size()) {
+    ORT_CXX_API_THROW("input_shapes must have a shape per input per warm-up", ORT_INVALID_ARGUMENT);
+  }
+
+  std::vector<const int64_t*> shapes;
+  std::vector<size_t> shape_lens;
+  shapes.reserve(input_shapes.size());
+  shape_lens.reserve(input_shapes.size());
+  for (const auto& shape : input_shapes) {
+    shapes.push_back(shape.data());
+    shape_lens.push_back(shape.size());
+  }
+
+  std::vector<int64_t> run_durations_us(2 * num_warmups);
+  ThrowOnError(GetApi().WarmupSession(p_, run_options, input_names, input_count, shapes.data(), shape_lens.data(),
+                                      num_warmups, freeze_arenas ? 1 : 0, run_durations_us.data()));
+  return run_durations_us;
+}
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(GetApi().SessionGetInputCount(p_, &out));
@@ -647,6 +695,48 @@ inline char* Session::EndProfiling(OrtAllocator* allocator) const {
   return out;
 }
 
+inline std::vector<std::pair<std::string, std::vector<uint64_t>>> Session::GetOpLatencyHistograms(
+    OrtAllocator* allocator) const {
+  char* op_types = nullptr;
+  size_t* op_type_lengths = nullptr;
+  uint64_t* bucket_counts = nullptr;
+  size_t num_op_types = 0;
+  size_t num_buckets = 0;
+  ThrowOnError(GetApi().SessionGetOpLatencyHistograms(p_, allocator, &op_types, &op_type_lengths, &bucket_counts,
+                                                      &num_op_types, &num_buckets));
+
+  std::vector<std::pair<std::string, std::vector<uint64_t>>> histograms;
+  histograms.reserve(num_op_types);
+  const char* op_type = op_types;
+  for (size_t i = 0; i < num_op_types; ++i) {
+    histograms.emplace_back(std::string(op_type, op_type_lengths[i]),
+                            std::vector<uint64_t>(bucket_counts + i * num_buckets,
+                                                  bucket_counts + (i + 1) * num_buckets));
+    op_type += op_type_lengths[i];
+  }
+
+  if (num_op_types > 0) {
+    allocator->Free(allocator, op_types);
+    allocator->Free(allocator, op_type_lengths);
+    allocator->Free(allocator, bucket_counts);
+  }
+  return histograms;
+}
+
+inline OrtThreadPoolStats Session::GetIntraOpThreadPoolStats() const {
+  OrtThreadPoolStats stats;
+  ThrowOnError(GetApi().SessionGetIntraOpThreadPoolStats(p_, &stats));
+  return stats;
+}
+
+inline std::string Session::GetShapeStatistics(OrtAllocator* allocator) const {
+  char* out;
+  ThrowOnError(GetApi().SessionGetShapeStatistics(p_, allocator, &out));
+  std::string statistics(out);
+  allocator->Free(allocator, out);
+  return statistics;
+}
+
 inline uint64_t Session::GetProfilingStartTimeNs() const {
   uint64_t out;
   ThrowOnError(GetApi().SessionGetProfilingStartTimeNs(p_, &out));
@@ -1200,6 +1290,18 @@ inline OrtValue* CustomOpApi::KernelContext_GetOutput(OrtKernelContext* context,
   return out;
 }
 
+inline void CustomOpApi::KernelContext_GetInputTensorViews(const OrtKernelContext* context,
+                                                           _Out_writes_all_(count) OrtTensorView* views, size_t count) {
+  ThrowOnError(api_.KernelContext_GetInputTensorViews(context, views, count));
+}
+
+inline void CustomOpApi::KernelContext_GetOutputTensorViews(OrtKernelContext* context,
+                                                            _In_reads_(count) const int64_t* const* dims,
+                                                            _In_reads_(count) const size_t* num_dims,
+                                                            _Out_writes_all_(count) OrtTensorView* views, size_t count) {
+  ThrowOnError(api_.KernelContext_GetOutputTensorViews(context, dims, num_dims, views, count));
+}
+
 inline void* CustomOpApi::KernelContext_GetGPUComputeStream(const OrtKernelContext* context) {
   void* out;
   ThrowOnError(api_.KernelContext_GetGPUComputeStream(context, &out));
@@ -25,3 +25,27 @@
 // Example usage: "cpu:0;gpu:0" (or) "gpu:0"
 // By default, the value for this key is empty (i.e.) no memory arenas are shrunk
 static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memory.enable_memory_arena_shrinkage";
+
+// Key for the timeout of Run() calls, in milliseconds, starting when Run() is called.
+// Once it has passed the run stops before its next node, including the nodes of the subgraphs of the Loop, Scan and
+// If nodes and the steps of BeamSearch and GreedySearch, and fails with the ORT_TIMEOUT error code.
+// A node that is running is not interrupted.
+// Expects a positive integer, e.g. "50". By default, runs have no timeout.
+static const char* const kOrtRunOptionsConfigTimeoutMs = "run.timeout_ms";
+
+// Key for the priority class of Run() calls, among the concurrent runs of the same session.
+// While high priority runs are in flight, the low priority runs wait before their next node (their running node is
+// not interrupted), so that the nodes of the high priority runs get the intra-op thread pool, e.g. to protect the
+// latency of interactive requests from batch requests. The runs using the parallel executor don't wait. A waiting
+// run still stops once its terminate flag is set or its timeout has passed.
+// "low": the run yields to the high priority runs.
+// "normal": default, the run neither waits nor makes other runs wait.
+// "high": the low priority runs wait while the run is in flight.
+static const char* const kOrtRunOptionsConfigPriority = "run.priority";
+
+// Key for the Python binding to return copies of the outputs of InferenceSession.run().
+// By default the numpy arrays returned for the tensors on CPU wrap the buffers of the outputs without copying them,
+// and are read-only.
+// "0": default, the outputs are wrapped.
+// "1": the outputs are copied into writable numpy arrays.
+static const char* const kOrtRunOptionsConfigPythonCopyOutputs = "python.copy_outputs";
@@ -71,6 +71,13 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure how long the inter_op/intra_op threads spin when spinning is allowed
+// "0": default, thread will spin a fixed number of times before blocking
+// "1": thread will spin for up to twice the average time it recently waited for work, and block without spinning
+//      if work arrives less often than every 500 microseconds
+static const char* const kOrtSessionOptionsConfigInterOpAdaptiveSpinning = "session.inter_op.adaptive_spinning";
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveSpinning = "session.intra_op.adaptive_spinning";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -79,6 +86,33 @@ static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session
 // has to guarantee that the model bytes are valid until the ORT session using the model bytes is destroyed.
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "session.use_ort_model_bytes_directly";
 
+// Key for using the ORT format model bytes in place for the initializers of the model.
+// By default the initializers of an ORT format model are copied from the model bytes, which are freed once the
+// session is initialized.
+// Setting this option to "1" makes the initializers refer to their data in the model bytes instead, so they are not
+// copied and the model bytes are kept until the session is destroyed. A model loaded from a file is then memory
+// mapped, so that only the pages of the initializers that are used are read. If the model bytes are provided by the
+// caller and "session.use_ort_model_bytes_directly" is "1", the caller has to guarantee that the model bytes are
+// valid until the session is destroyed.
+// Initializers that are not aligned in the model bytes, e.g. in a model saved by an older version, are copied.
+// "0": default, copy the initializers from the model bytes.
+// "1": use the model bytes in place for the initializers.
+static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
+    "session.use_ort_model_bytes_for_initializers";
+
+// Key for compressing the initializers of a model saved in ORT format, to make the model file smaller.
+// Initializers are only compressed if that makes them smaller. Models with compressed initializers can't be loaded by
+// older versions.
+// When the model is loaded, compressed initializers are decompressed into the raw data of the initializers. If
+// "session.use_ort_model_bytes_for_initializers" is "1" they are instead decompressed when the session is initialized,
+// in parallel and directly into their planned buffers.
+// "none": default, do not compress the initializers.
+// "lz4": compress the initializers with LZ4.
+// "byte_shuffle_lz4": group the bytes of the elements by their position in the element before compressing with LZ4.
+//                     This usually compresses float weights better than "lz4".
+static const char* const kOrtSessionOptionsConfigOrtFormatInitializerCompression =
+    "session.ort_format_initializer_compression";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -104,6 +138,19 @@ static const char* const kOrtSessionOptionsConfigMinimalBuildOptimizations =
 // exclusion, set the value to "".
 static const char* const kOrtSessionOptionsConfigNnapiEpPartitioningStopOps = "ep.nnapi.partitioning_stop_ops";
 
+// Specifies a directory for the NNAPI EP to cache the compiled models in, so that a later session running the same
+// model loads the compiled models from the cache instead of compiling them again.
+// The compilation caching uses ANeuralNetworksCompilation_setCaching and is only available on Android API level 29+.
+// The directory should be private to the application, e.g. a subdirectory of its cache directory.
+// If not specified, the compiled models are not cached.
+static const char* const kOrtSessionOptionsConfigNnapiEpCompilationCacheDir = "ep.nnapi.compilation_cache_dir";
+
+// Specifies a directory for the CoreML EP to cache the compiled models in, so that a later session running the same
+// model reuses the compiled models from the cache instead of compiling them again.
+// A compiled model is identified by the hash of the converted CoreML model, so the cache can be shared by models.
+// If not specified, the compiled models are not cached.
+static const char* const kOrtSessionOptionsConfigCoreMLEpCompilationCacheDir = "ep.coreml.compilation_cache_dir";
+
 // Enabling dynamic block-sizing for multithreading.
 // With a positive value, thread pool will split a task of N iterations to blocks of size starting from:
 // N / (num_of_threads * dynamic_block_base)
@@ -119,3 +166,278 @@ static const char* const kOrtSessionOptionsConfigDynamicBlockBase = "session.dyn
 // "0": in some cases warnings will be logged but processing will continue. The default.
 // May be useful to expose bugs in models.
 static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "session.strict_shape_type_inference";
+
+// Round up every input dimension except the first one to a multiple of this value when looking up the memory
+// patterns cached for previously seen input shapes, so that one pattern serves a range of e.g. sequence lengths.
+// The pattern of a bucket is replaced by the one of larger inputs of the bucket when they are first run.
+// "0": default, patterns are cached per exact input shapes.
+static const char* const kOrtSessionOptionsConfigMemoryPatternShapeBucketSize = "session.memory_pattern_shape_bucket_size";
+
+// Maximum number of memory patterns cached per session state. The least recently used pattern is evicted first.
+// "0": default, no limit.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheMaxEntries = "session.memory_pattern_cache_max_entries";
+
+// "1": keep the buffers allocated for the memory patterns across runs instead of allocating and freeing them on every
+// run. With fixed input shapes and pre-allocated outputs (e.g. bound with IOBinding), a run then doesn't call the
+// allocators for the activations. The buffers are kept until the session is destroyed.
+// "0": default, the buffers are allocated on every run.
+static const char* const kOrtSessionOptionsConfigMemoryPatternReuseBuffers = "session.memory_pattern_reuse_buffers";
+
+// "1": with ExecutionMode::ORT_PARALLEL, run the graph with a work-stealing executor. Ready nodes are kept in
+// per-thread queues ordered by the length of their critical path, and idle threads steal from the others.
+// Has less scheduling overhead than the default parallel executor for graphs with many small nodes.
+// "0": default, use the parallel executor that schedules every node on the inter op thread pool.
+static const char* const kOrtSessionOptionsConfigUseWorkStealingExecutor = "session.use_work_stealing_executor";
+
+// "1": compile the sequential execution plan into a flat list of kernels and the values to release after each of
+// them, so the SequentialExecutor runs a minimal loop. Reduces the per node overhead for small models.
+// It is not used while profiling, or if any node requires fences.
+// "0": default.
+static const char* const kOrtSessionOptionsConfigUseFlatExecutionPlan = "session.use_flat_execution_plan";
+
+// Initializers with external data are memory mapped from the external data file where possible, so they are backed
+// by the page cache and shared between processes loading the same model. If mapping fails they are read into a
+// private buffer instead.
+// "1": fail session initialization if the external data of an initializer cannot be memory mapped.
+// "0": default, fall back to reading the data.
+static const char* const kOrtSessionOptionsConfigRequireMappedExternalInitializers =
+    "session.require_mapped_external_initializers";
+
+// "1": initializers with external data are not pre-packed by the kernels, so that they stay memory mapped and their
+// pages are only read in when a kernel uses them. Startup time and resident memory then scale with the part of the
+// model that actually runs, e.g. the selected experts of a mixture-of-experts model, and as the pages are backed by
+// the external data file the OS can evict the ones of cold weights under memory pressure. The kernels consuming
+// these initializers run without pre-packed weights.
+// "0": default, the initializers with external data are pre-packed like the other ones.
+static const char* const kOrtSessionOptionsConfigLazyLoadExternalInitializers =
+    "session.lazy_load_external_initializers";
+
+// Path of a file caching the weights pre-packed by CPU kernels (see OpKernel::PrePack).
+// Sessions using the same file (typically in different processes) memory map the pre-packed weights from it instead
+// of packing them again, and share their physical memory. Weights that are not in the file yet are added to it
+// once the session is initialized. The file is replaced if it was created by a different version of onnxruntime
+// or on a CPU with different features.
+// Initializers shared with a PrepackedWeightsContainer use the container instead.
+// "": default, no cache file.
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsCacheFile = "session.prepacked_weights_cache_file";
+
+// Directory of a cache of optimized models, for models loaded in ONNX format.
+// The first session saves its model in ORT format to the directory after graph optimization, keyed by a hash of the
+// model content, the execution provider types, the onnxruntime version, the CPU features and the session options
+// that affect optimization. Later sessions with the same key load the cached model and skip graph optimization.
+// Changing any of these selects a different file. The external data files of the model are not part of the key.
+// The session that saves the model runs as if session.save_model_format were "ORT", so compiling execution providers
+// compile their nodes when the cached model is loaded. The cache is not used if optimized_model_filepath is set or
+// the session has shared or external initializers.
+// Constant folding also saves the outputs of nodes with large constant inputs to the directory, keyed by a hash of
+// the op and its inputs, so models that miss the model cache still fold those nodes without evaluating them.
+// "": default, no cache.
+static const char* const kOrtSessionOptionsConfigOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
+// "1": back large allocations of the default CPU execution provider, which include the regions of its arena and
+// the weights pre-packed by CPU kernels, with huge pages to reduce TLB misses. Explicit huge pages are used if the
+// system reserved them, else transparent huge pages on Linux, or large pages on Windows if the process holds
+// SeLockMemoryPrivilege. Allocations fall back to regular pages if huge pages are not available.
+// "0": default.
+static const char* const kOrtSessionOptionsConfigUseHugePagesForCpuAllocator = "session.use_huge_pages_for_cpu_allocator";
+
+// Index of a NUMA node to pin the session to. The threads of the per session thread pools are bound to the logical
+// processors of the node, one thread per processor if the number of threads is not set, and large allocations of
+// the default CPU execution provider, which include its arena regions and the weights pre-packed by CPU kernels,
+// are placed in the memory of the node. Takes precedence over session.use_huge_pages_for_cpu_allocator.
+// "-1": default, the session is not pinned to a NUMA node.
+static const char* const kOrtSessionOptionsConfigNumaNode = "session.numa_node";
+
+// Quota of a session on the global intra op thread pool of the environment, used when the session does not use per
+// session threads. Limits the number of threads (including the calling thread) a parallel loop of the session uses.
+// "0": default, no limit.
+static const char* const kOrtSessionOptionsConfigGlobalIntraOpMaxDegreeOfParallelism =
+    "session.global_intra_op.max_degree_of_parallelism";
+
+// Weight of a session on the global intra op thread pool of the environment, used when the session does not use per
+// session threads. The threads of the pool are divided between the sessions with a weight that are running, in
+// proportion to their weights. Sessions without a weight are not limited and are not counted.
+// "0": default, no weight.
+static const char* const kOrtSessionOptionsConfigGlobalIntraOpShareWeight = "session.global_intra_op.share_weight";
+
+// Path of a file with the tuned block sizes and degrees of parallelism of the parallel loops run by CPU kernels.
+// If set, the session tunes each parallel loop online: it tries several scalings of the block size derived from the
+// cost model and of the degree of parallelism over the first runs, and keeps the fastest. Loops are identified by the
+// op type and the magnitude of the input sizes of the kernel. Choices in the file are loaded at session creation,
+// and the file is rewritten with all tuned choices when the session is destroyed.
+// "": default, no tuning.
+static const char* const kOrtSessionOptionsConfigParallelForTuningFile = "session.parallel_for_tuning_file";
+
+// Selects the Winograd F(4x4, 3x3) algorithm for float 3x3 convolutions with unit strides and dilations on CPU.
+// The filter is transformed to the Winograd domain when it is pre-packed, so the filter must be a constant initializer.
+// "0": never use Winograd.
+// "1": use Winograd for every supported convolution.
+// "": default, use Winograd for convolutions with enough channels to amortize the transforms.
+static const char* const kOrtSessionOptionsConfigConvWinograd = "session.conv_winograd";
+
+// Evaluates the CPU tree ensembles (TreeEnsembleRegressor and TreeEnsembleClassifier) on 12-byte nodes with the
+// thresholds of each feature quantized to 16-bit bins, and the input features binned once per batch. Predictions
+// are the same as with the full thresholds. Only trees with BRANCH_LEQ, BRANCH_LT, BRANCH_GTE or BRANCH_GT nodes
+// of a single mode are quantized.
+// "1": quantize every supported tree ensemble.
+// "0" or "": default, do not quantize.
+static const char* const kOrtSessionOptionsConfigTreeEnsembleQuantizeThresholds =
+    "session.tree_ensemble_quantize_thresholds";
+
+// Converts the float nodes of the main graph to a lower precision type after partitioning, for the nodes whose
+// execution provider has a kernel for that type. Cast nodes are inserted at the boundaries of the converted regions
+// and constant float initializers consumed by converted nodes are converted. Softmax, the normalizations and the
+// reductions are always kept in float.
+// "fp16": convert to float16.
+// "bf16": convert to bfloat16.
+// "": default, no conversion.
+static const char* const kOrtSessionOptionsConfigMixedPrecision = "session.mixed_precision";
+
+// Comma separated op types converted by session.mixed_precision. Replaces the default list, which contains compute
+// bound ops such as Conv, MatMul and Gemm, and the elementwise and data movement ops typically found between them.
+static const char* const kOrtSessionOptionsConfigMixedPrecisionAllowOps = "session.mixed_precision_allow_ops";
+
+// Comma separated op types never converted by session.mixed_precision, e.g. ops that overflow float16 in a model.
+static const char* const kOrtSessionOptionsConfigMixedPrecisionDenyOps = "session.mixed_precision_deny_ops";
+
+// Maximum number of sessions specialized for recurring values of the symbolic dimensions of the graph inputs.
+// Once a combination of values has been seen in session.shape_specialization_min_runs runs, a session with the
+// dimensions overridden to those values (as with free dimension overrides by name) is created on a background thread.
+// Its graph is optimized with static shapes, so fusions and constant folding that need them apply. Later runs with
+// the same values are dispatched to it. Only supported for ONNX format models run with the CPU execution provider
+// and without custom ops. The specialized sessions share the thread pools of the session.
+// "0": default, no specialization.
+static const char* const kOrtSessionOptionsConfigShapeSpecializationMaxSessions =
+    "session.shape_specialization_max_sessions";
+
+// Number of runs with the same values of the symbolic dimensions after which a specialized session is created.
+// "10": default.
+static const char* const kOrtSessionOptionsConfigShapeSpecializationMinRuns = "session.shape_specialization_min_runs";
+
+// Executes the nodes in the order computed by the allocation planner to keep the peak memory of the activations low,
+// as ExecutionOrder::MEMORY_EFFICIENT does. Of the nodes whose inputs are ready, the node adding the least memory runs
+// first, with the outputs its kernel writes in place or aliases over an input counted as free. The order is only
+// used when its estimated peak memory is lower than with the default order; both are logged at the INFO level.
+// "1": use the memory efficient order.
+// "0": default, use SessionOptions::execution_order.
+static const char* const kOrtSessionOptionsConfigMemoryEfficientExecutionOrder =
+    "session.memory_efficient_execution_order";
+
+// Logs the allocation plan of each graph at the INFO level once it is created: the buffer each value is allocated in
+// or reuses, the nodes in execution order with the values freed after them, and the number of values of each
+// allocation kind.
+// "1": dump the allocation plans.
+// "0": default, do not dump.
+static const char* const kOrtSessionOptionsConfigDumpAllocationPlan = "session.dump_allocation_plan";
+
+// Partitions ONNX format models with a cost model. The nodes an execution provider that is not CPU based can run are
+// grouped into islands of connected nodes, and an island is left to the CPU when the copies of its inputs and outputs
+// between the devices are estimated to take longer than its faster kernels save. The kernel times are estimated from
+// the number of multiply-adds or elements of the nodes, or taken from session.partitioning_profile. Islands with
+// symbolic dimensions keep the greedy assignment.
+// "1": cost aware partitioning.
+// "0": default, greedy partitioning in the order of the execution providers.
+static const char* const kOrtSessionOptionsConfigCostAwarePartitioning = "session.cost_aware_partitioning";
+
+// Paths, separated by ';', of profiles written by sessions with profiling enabled, whose mean kernel times by
+// execution provider and op type are used by session.cost_aware_partitioning. The times are used for the op types
+// measured with both the execution provider and the CPU execution provider, e.g. in the profiles of a session using
+// each of them.
+// "": default, estimate all the kernel times.
+static const char* const kOrtSessionOptionsConfigPartitioningProfile = "session.partitioning_profile";
+
+// Quantizes the float input of DynamicQuantizeMatMul on CPU with a scale per row (per token) instead of a single scale
+// for the whole tensor, which keeps the precision of the rows with small values. The rows are quantized symmetrically,
+// with the zero point 128 for uint8 and 0 for int8, and the range of each row is found right before it is quantized.
+// "1": quantize per row.
+// "0": default, quantize per tensor.
+static const char* const kOrtSessionOptionsConfigDynamicQuantizeMatMulPerRow =
+    "session.dynamic_quantize_matmul_per_row";
+
+// Quantizes the float input of DynamicQuantizeMatMul on CPU symmetrically to int8 and multiplies it with the symmetric
+// s8s8 GEMM of MLAS, which uses the dot product instructions of ARM64. Only used when the weight is a constant 2D int8
+// initializer with zero points that are all 0 and the platform has a symmetric GEMM; ignored otherwise.
+// "1": use the symmetric GEMM where supported.
+// "0": default, quantize to uint8 with a zero point.
+static const char* const kOrtSessionOptionsConfigDynamicQuantizeMatMulSymmetric =
+    "session.dynamic_quantize_matmul_symmetric";
+
+// Runs the iterations of a CPU Loop concurrently when they only depend on the iteration number, i.e. the Loop has no
+// loop carried dependencies and its body passes cond through unchanged, as in a loop mapping its body over a batch.
+// The first iteration runs on its own, the others run on the inter-op thread pool, or the intra-op thread pool if the
+// session has none, each with its own subgraph frame. Loops with string scan outputs run sequentially.
+// "1": run independent iterations concurrently.
+// "0": default, run the iterations sequentially.
+static const char* const kOrtSessionOptionsConfigParallelLoopIterations = "session.parallel_loop_iterations";
+
+// Defers the creation of the kernels of the then and else branches of the If nodes, and the pre-packing of their
+// weights, until the If first runs the branch. A branch that is never taken, e.g. an early exit, then costs no
+// kernel memory, at the price of a slower first run of each branch. Ignored for ORT format models.
+// "1": initialize the branches when they are first run.
+// "0": default, initialize all the branches with the session.
+static const char* const kOrtSessionOptionsConfigLazyIfBranches = "session.lazy_if_branches";
+
+// Times the kernels of one in N runs of the main graph and adds their durations to a latency histogram per op type,
+// which is read with OrtApi::SessionGetOpLatencyHistograms. Unlike enable_profiling, the other runs are not slowed
+// down and the memory used does not grow with the number of runs, so it can stay enabled in production.
+// "N" > 0: profile one in N runs, starting with the first one.
+// "0": default, disabled.
+static const char* const kOrtSessionOptionsConfigProfilingSampleRate = "session.profiling_sample_rate";
+
+// Adds hardware counters of the thread running each kernel to the node events of the profiler: "cycles",
+// "instructions", "llc_misses" and "llc_miss_bytes", the misses times the cache line size, which estimates the bytes
+// moved from memory. Read through perf_event, so only available on Linux and when perf_event_paranoid allows it.
+// The work done by the intra-op threads is not counted. Only used when profiling is enabled.
+// "1": record the hardware counters.
+// "0": default, don't record them.
+static const char* const kOrtSessionOptionsConfigProfilingHardwareCounters = "session.profiling_hardware_counters";
+
+// Records the allocation timeline of each run of the main graph: which node produced each tensor, when it was
+// allocated and released, its location and offset in the memory pattern buffer, and the tensors live at the peak
+// of each location. Each run writes "<prefix>_<run number>.json" in Chrome trace format (chrome://tracing, Perfetto).
+// Meant for investigating the peak memory of a model, as it slows down the runs.
+// "<prefix>": the path prefix of the files to write.
+// "": default, disabled.
+static const char* const kOrtSessionOptionsConfigMemoryTimelineFilePrefix = "session.memory_timeline_file_prefix";
+
+// Records the shapes of the inputs and of the outputs of each node of the main graph in one of N runs and keeps the
+// most frequent ones, e.g. to choose shape buckets or TensorRT profiles. Read as JSON with
+// OrtApi::SessionGetShapeStatistics, and added to the profile when profiling is enabled. The memory used is fixed.
+// "N" > 0: sample one in N runs, starting with the first one.
+// "0": default, disabled.
+static const char* const kOrtSessionOptionsConfigShapeStatisticsSampleRate = "session.shape_statistics_sample_rate";
+
+// Shares the initializers and the pre-packed weights of sessions created with the same PrepackedWeightsContainer
+// (see OrtApi::CreateSessionWithPrepackedWeightsContainer) when their contents are equal, without adding them to
+// the session options. Meant for rolling out a model update next to the running version: the weights that did not
+// change are only held once. Only the initializers placed on CPU are shared. The container holds the shared
+// initializers until it is released, including the ones a session no longer needs once they are pre-packed.
+// "1": share the initializers by content.
+// "0": default, only share the initializers added with AddInitializer.
+static const char* const kOrtSessionOptionsConfigShareInitializersByContent = "session.share_initializers_by_content";
+
+// Device memory budget, in bytes, of the activations of the main graph on the CUDA and ROCm execution providers. When
+// the peak memory of the activations, estimated from their static sizes in the execution order, is above it, the
+// largest activations idle across the peak are spilled to pinned host memory after they are produced and prefetched
+// back a few nodes before they are used again, until the estimate fits. Runs that would fail to allocate then complete
+// more slowly. Activations with symbolic dimensions are not counted; use free dimension overrides to size them. The
+// copies overlap the compute when the CUDA provider option do_copy_in_default_stream is 0.
+// "N" > 0: the budget in bytes.
+// "0": default, disabled.
+static const char* const kOrtSessionOptionsConfigActivationSpillBudget = "session.activation_spill_budget_bytes";
+
+// Byte budget of a cache of the outputs of the runs of the session by the values of their feeds. A run with the same
+// feeds and output names as a cached one returns copies of its outputs without executing the graph, which the caller
+// may modify. The least recently used entries are evicted to fit the budget, which counts the copies of the feeds kept
+// to compare them. Only runs whose feeds and outputs are tensors on CPU, without IO binding or pre-allocated outputs,
+// are cached. The cache is not used if the model has random ops, e.g. RandomNormal or
+// Dropout in training mode.
+// "N" > 0: the budget in bytes.
+// "0": default, disabled.
+static const char* const kOrtSessionOptionsConfigRunResultCacheBytes = "session.run_result_cache_bytes";
+
+// Time after which the outputs cached with session.run_result_cache_bytes expire, e.g. for models whose results are
+// only valid for a while.
+// "N" > 0: the time to live in milliseconds.
+// "0": default, the cached outputs do not expire.
+static const char* const kOrtSessionOptionsConfigRunResultCacheTtlMs = "session.run_result_cache_ttl_ms";
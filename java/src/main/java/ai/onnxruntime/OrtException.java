@@ -67,11 +67,12 @@ public class OrtException extends Exception {
     ORT_MODEL_LOADED(8),
     ORT_NOT_IMPLEMENTED(9),
     ORT_INVALID_GRAPH(10),
-    ORT_EP_FAIL(11);
+    ORT_EP_FAIL(11),
+    ORT_TIMEOUT(12);
 
     private final int value;
 
-    private static final OrtErrorCode[] values = new OrtErrorCode[12];
+    private static final OrtErrorCode[] values = new OrtErrorCode[13];
 
     static {
       for (OrtErrorCode ot : OrtErrorCode.values()) {
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ * Licensed under the MIT License.
+ */
+package ai.onnxruntime;
+
+import java.io.IOException;
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * Binds inputs and outputs of an {@link OrtSession} to {@link OnnxTensor}s ahead of the call to
+ * {@link OrtSession#run(OrtIoBinding)}.
+ *
+ * <p>An output bound to an {@link OnnxTensor} backed by a direct buffer is written in place into
+ * that buffer, so a loop which refills its direct input buffers, runs the session and reads its
+ * direct output buffers performs neither allocations nor copies. The bindings persist across
+ * runs.
+ *
+ * <p>The bound tensors must not be closed while they are bound. This binding holds a reference to
+ * them so their buffers are not collected.
+ *
+ * <p>Produced by {@link OrtSession#createIoBinding()}. Most methods throw {@link
+ * IllegalStateException} if the binding is closed.
+ */
+public class OrtIoBinding implements AutoCloseable {
+
+  static {
+    try {
+      OnnxRuntime.init();
+    } catch (IOException e) {
+      throw new RuntimeException("Failed to load onnx-runtime library", e);
+    }
+  }
+
+  final long nativeHandle;
+
+  private final OrtSession session;
+
+  private final long allocatorHandle;
+
+  private final Map<String, OnnxTensor> inputs = new HashMap<>();
+
+  private final Map<String, OnnxTensor> outputs = new HashMap<>();
+
+  private boolean closed = false;
+
+  /**
+   * Creates an io binding for the supplied session.
+   *
+   * @param session The session.
+   * @param sessionHandle The pointer to the native session.
+   * @param allocatorHandle The pointer to the allocator used to return the outputs.
+   * @throws OrtException If the native binding could not be created.
+   */
+  OrtIoBinding(OrtSession session, long sessionHandle, long allocatorHandle) throws OrtException {
+    this.nativeHandle = createIoBinding(OnnxRuntime.ortApiHandle, sessionHandle);
+    this.session = session;
+    this.allocatorHandle = allocatorHandle;
+  }
+
+  /**
+   * Returns the session this binding belongs to.
+   *
+   * @return The session.
+   */
+  OrtSession getSession() {
+    return session;
+  }
+
+  /**
+   * Binds the named input to the supplied tensor. The tensor is read by every following run, so
+   * refilling its direct buffer changes the input of the next run.
+   *
+   * @param name The input name.
+   * @param tensor The input tensor.
+   * @throws OrtException If the native call failed.
+   */
+  public void bindInput(String name, OnnxTensor tensor) throws OrtException {
+    checkClosed();
+    bindInput(OnnxRuntime.ortApiHandle, nativeHandle, name, tensor.getNativeHandle());
+    inputs.put(name, tensor);
+  }
+
+  /**
+   * Binds the named output to the supplied tensor, whose buffer the output is written into. The
+   * tensor must have the type and shape of the output.
+   *
+   * @param name The output name.
+   * @param tensor The output tensor.
+   * @throws OrtException If the native call failed.
+   */
+  public void bindOutput(String name, OnnxTensor tensor) throws OrtException {
+    checkClosed();
+    bindOutput(OnnxRuntime.ortApiHandle, nativeHandle, name, tensor.getNativeHandle());
+    outputs.put(name, tensor);
+  }
+
+  /**
+   * Binds the named output to the CPU. The output is allocated by each run and returned by {@link
+   * #getOutputs()}, which is useful when its shape is not known ahead of the run.
+   *
+   * @param name The output name.
+   * @throws OrtException If the native call failed.
+   */
+  public void bindOutput(String name) throws OrtException {
+    checkClosed();
+    bindOutputToCPU(OnnxRuntime.ortApiHandle, nativeHandle, name);
+    outputs.remove(name);
+  }
+
+  /**
+   * Returns the outputs of the last run, in the order they were bound.
+   *
+   * <p>The values of the outputs bound to a tensor share its buffer. The result must be closed.
+   *
+   * @return The outputs.
+   * @throws OrtException If the native call failed.
+   */
+  public OrtSession.Result getOutputs() throws OrtException {
+    checkClosed();
+    String[] names = getOutputNames(OnnxRuntime.ortApiHandle, nativeHandle, allocatorHandle);
+    OnnxValue[] values = getOutputValues(OnnxRuntime.ortApiHandle, nativeHandle, allocatorHandle);
+    return new OrtSession.Result(names, values);
+  }
+
+  /**
+   * Unbinds all the inputs.
+   *
+   * @throws IllegalStateException If the binding is closed.
+   */
+  public void clearBoundInputs() {
+    checkClosed();
+    clearBoundInputs(OnnxRuntime.ortApiHandle, nativeHandle);
+    inputs.clear();
+  }
+
+  /**
+   * Unbinds all the outputs.
+   *
+   * @throws IllegalStateException If the binding is closed.
+   */
+  public void clearBoundOutputs() {
+    checkClosed();
+    clearBoundOutputs(OnnxRuntime.ortApiHandle, nativeHandle);
+    outputs.clear();
+  }
+
+  /** Checks if the OrtIoBinding is closed, if so throws {@link IllegalStateException}. */
+  void checkClosed() {
+    if (closed) {
+      throw new IllegalStateException("Trying to use a closed OrtIoBinding");
+    }
+  }
+
+  /** Closes the binding, the bound tensors are not closed. */
+  @Override
+  public void close() {
+    if (!closed) {
+      close(OnnxRuntime.ortApiHandle, nativeHandle);
+      inputs.clear();
+      outputs.clear();
+      closed = true;
+    } else {
+      throw new IllegalStateException("Trying to close an already closed OrtIoBinding.");
+    }
+  }
+
+  private static native long createIoBinding(long apiHandle, long sessionHandle)
+      throws OrtException;
+
+  private static native void bindInput(
+      long apiHandle, long nativeHandle, String name, long valueHandle) throws OrtException;
+
+  private static native void bindOutput(
+      long apiHandle, long nativeHandle, String name, long valueHandle) throws OrtException;
+
+  private static native void bindOutputToCPU(long apiHandle, long nativeHandle, String name)
+      throws OrtException;
+
+  private static native String[] getOutputNames(
+      long apiHandle, long nativeHandle, long allocatorHandle) throws OrtException;
+
+  private static native OnnxValue[] getOutputValues(
+      long apiHandle, long nativeHandle, long allocatorHandle) throws OrtException;
+
+  private static native void clearBoundInputs(long apiHandle, long nativeHandle);
+
+  private static native void clearBoundOutputs(long apiHandle, long nativeHandle);
+
+  private static native void close(long apiHandle, long nativeHandle);
+}
@@ -308,6 +308,53 @@ public class OrtSession implements AutoCloseable {
     }
   }
 
+  /**
+   * Creates an {@link OrtIoBinding} to bind the inputs and outputs of this session ahead of calls
+   * to {@link #run(OrtIoBinding)}.
+   *
+   * @return A new io binding.
+   * @throws OrtException If the native binding could not be created.
+   */
+  public OrtIoBinding createIoBinding() throws OrtException {
+    if (!closed) {
+      return new OrtIoBinding(this, nativeHandle, allocator.handle);
+    } else {
+      throw new IllegalStateException("Trying to bind a closed OrtSession.");
+    }
+  }
+
+  /**
+   * Scores the inputs bound in the supplied {@link OrtIoBinding}, writing the outputs into the
+   * bound tensors, or making them available from {@link OrtIoBinding#getOutputs()}.
+   *
+   * @param binding The io binding created by this session.
+   * @throws OrtException If there was an error in native code.
+   */
+  public void run(OrtIoBinding binding) throws OrtException {
+    run(binding, null);
+  }
+
+  /**
+   * Scores the inputs bound in the supplied {@link OrtIoBinding}, writing the outputs into the
+   * bound tensors, or making them available from {@link OrtIoBinding#getOutputs()}.
+   *
+   * @param binding The io binding created by this session.
+   * @param runOptions The RunOptions to control this run.
+   * @throws OrtException If there was an error in native code.
+   */
+  public void run(OrtIoBinding binding, RunOptions runOptions) throws OrtException {
+    if (!closed) {
+      binding.checkClosed();
+      if (binding.getSession() != this) {
+        throw new IllegalArgumentException("The OrtIoBinding was created by another OrtSession.");
+      }
+      long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
+      runWithBinding(OnnxRuntime.ortApiHandle, nativeHandle, runOptionsHandle, binding.nativeHandle);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
   /**
    * Gets the metadata for the currently loaded model.
    *
@@ -430,6 +477,20 @@ public class OrtSession implements AutoCloseable {
       long runOptionsHandle)
       throws OrtException;
 
+  /**
+   * The native run call using an io binding. runOptionsHandle can be zero (i.e. the null pointer),
+   * but all other handles must be valid pointers.
+   *
+   * @param apiHandle The pointer to the api.
+   * @param nativeHandle The pointer to the session.
+   * @param runOptionsHandle The (possibly null) pointer to the run options.
+   * @param bindingHandle The pointer to the io binding.
+   * @throws OrtException If the native call failed in some way.
+   */
+  private native void runWithBinding(
+      long apiHandle, long nativeHandle, long runOptionsHandle, long bindingHandle)
+      throws OrtException;
+
   private native long getProfilingStartTimeInNs(long apiHandle, long nativeHandle)
       throws OrtException;
 
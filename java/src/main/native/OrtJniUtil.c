@@ -1024,6 +1024,8 @@ jint convertErrorCode(OrtErrorCode code) {
             return 10;
         case ORT_EP_FAIL:
             return 11;
+        case ORT_TIMEOUT:
+            return 12;
         default:
             return -1; // Unknown error code
     }
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ * Licensed under the MIT License.
+ */
+#include <jni.h>
+#include <stdlib.h>
+#include <string.h>
+#include "onnxruntime/core/session/onnxruntime_c_api.h"
+#include "OrtJniUtil.h"
+#include "ai_onnxruntime_OrtIoBinding.h"
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    createIoBinding
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_ai_onnxruntime_OrtIoBinding_createIoBinding
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong sessionHandle) {
+  (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtIoBinding* binding = NULL;
+  checkOrtStatus(jniEnv,api,api->CreateIoBinding((OrtSession*) sessionHandle, &binding));
+  return (jlong) binding;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    bindInput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_bindInput
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+  (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv,api,api->BindInput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    bindOutput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_bindOutput
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+  (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv,api,api->BindOutput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    bindOutputToCPU
+ * Signature: (JJLjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_bindOutputToCPU
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong nativeHandle, jstring name) {
+  (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtMemoryInfo* memoryInfo = NULL;
+  checkOrtStatus(jniEnv,api,api->CreateCpuMemoryInfo(OrtDeviceAllocator, OrtMemTypeDefault, &memoryInfo));
+  if (memoryInfo == NULL) {
+    return;
+  }
+  const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv,api,api->BindOutputToDevice((OrtIoBinding*) nativeHandle, nameStr, memoryInfo));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+  api->ReleaseMemoryInfo(memoryInfo);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    getOutputNames
+ * Signature: (JJJ)[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtIoBinding_getOutputNames
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong nativeHandle, jlong allocatorHandle) {
+  (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+  char* buffer = NULL;
+  size_t* lengths = NULL;
+  size_t count = 0;
+  checkOrtStatus(jniEnv,api,api->GetBoundOutputNames((const OrtIoBinding*) nativeHandle, allocator, &buffer, &lengths, &count));
+
+  char *stringClassName = "java/lang/String";
+  jclass stringClazz = (*jniEnv)->FindClass(jniEnv, stringClassName);
+  jobjectArray array = (*jniEnv)->NewObjectArray(jniEnv, safecast_size_t_to_jsize(count), stringClazz, NULL);
+
+  // The names are concatenated without null terminators
+  const char* name = buffer;
+  for (size_t i = 0; i < count; i++) {
+    char* copy = malloc(lengths[i] + 1);
+    if (copy == NULL) {
+      throwOrtException(jniEnv, 1, "Not enough memory");
+      break;
+    }
+    memcpy(copy, name, lengths[i]);
+    copy[lengths[i]] = '\0';
+    jstring nameStr = (*jniEnv)->NewStringUTF(jniEnv, copy);
+    (*jniEnv)->SetObjectArrayElement(jniEnv, array, safecast_size_t_to_jsize(i), nameStr);
+    free(copy);
+    name += lengths[i];
+  }
+
+  if (count > 0) {
+    checkOrtStatus(jniEnv,api,api->AllocatorFree(allocator, buffer));
+    checkOrtStatus(jniEnv,api,api->AllocatorFree(allocator, lengths));
+  }
+
+  return array;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    getOutputValues
+ * Signature: (JJJ)[Lai/onnxruntime/OnnxValue;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtIoBinding_getOutputValues
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong nativeHandle, jlong allocatorHandle) {
+  (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+  OrtValue** outputValues = NULL;
+  size_t count = 0;
+  checkOrtStatus(jniEnv,api,api->GetBoundOutputValues((const OrtIoBinding*) nativeHandle, allocator, &outputValues, &count));
+
+  char *onnxValueClassName = "ai/onnxruntime/OnnxValue";
+  jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, onnxValueClassName);
+  jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv, safecast_size_t_to_jsize(count), onnxValueClass, NULL);
+
+  // The Java values take ownership of the OrtValues, which share the buffers of the bound tensors
+  for (size_t i = 0; i < count; i++) {
+    jobject onnxValue = convertOrtValueToONNXValue(jniEnv, api, allocator, outputValues[i]);
+    (*jniEnv)->SetObjectArrayElement(jniEnv, outputArray, safecast_size_t_to_jsize(i), onnxValue);
+  }
+
+  if (count > 0) {
+    checkOrtStatus(jniEnv,api,api->AllocatorFree(allocator, outputValues));
+  }
+
+  return outputArray;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    clearBoundInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_clearBoundInputs
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong nativeHandle) {
+  (void) jniEnv; (void) jclazz; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ClearBoundInputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    clearBoundOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_clearBoundOutputs
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong nativeHandle) {
+  (void) jniEnv; (void) jclazz; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ClearBoundOutputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    close
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_close
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong nativeHandle) {
+  (void) jniEnv; (void) jclazz; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ReleaseIoBinding((OrtIoBinding*) nativeHandle);
+}
@@ -320,6 +320,18 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
 }
 
 
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    runWithBinding
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_runWithBinding
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong runOptionsHandle, jlong bindingHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  checkOrtStatus(jniEnv,api,api->RunWithBinding((OrtSession*) sessionHandle, (const OrtRunOptions*) runOptionsHandle, (const OrtIoBinding*) bindingHandle));
+}
+
 /*
  * Class:     ai_onnxruntime_OrtSession
  * Method:    getProfilingStartTimeInNs
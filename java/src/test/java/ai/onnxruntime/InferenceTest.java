@@ -432,6 +432,61 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void ioBindingTest() throws OrtException {
+    String modelPath = TestHelpers.getResourcePath("/squeezenet.onnx").toString();
+    float[] inputData = TestHelpers.loadTensorFromFile(TestHelpers.getResourcePath("/bench.in"));
+    float[] expectedOutput =
+        TestHelpers.loadTensorFromFile(TestHelpers.getResourcePath("/bench.expected_out"));
+
+    try (SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options);
+        OrtIoBinding binding = session.createIoBinding()) {
+      NodeInfo inputMeta = session.getInputInfo().values().iterator().next();
+      String outputName = session.getOutputNames().iterator().next();
+      long[] inputShape = ((TensorInfo) inputMeta.getInfo()).getShape();
+      long[] outputShape = new long[] {1, 1000, 1, 1};
+
+      FloatBuffer inputBuffer =
+          ByteBuffer.allocateDirect(inputData.length * 4)
+              .order(ByteOrder.nativeOrder())
+              .asFloatBuffer();
+      FloatBuffer outputBuffer =
+          ByteBuffer.allocateDirect(expectedOutput.length * 4)
+              .order(ByteOrder.nativeOrder())
+              .asFloatBuffer();
+
+      try (OnnxTensor inputTensor = OnnxTensor.createTensor(env, inputBuffer, inputShape);
+          OnnxTensor outputTensor = OnnxTensor.createTensor(env, outputBuffer, outputShape)) {
+        binding.bindInput(inputMeta.getName(), inputTensor);
+        binding.bindOutput(outputName, outputTensor);
+
+        // the bound buffers are reused by every run
+        for (int i = 0; i < 2; i++) {
+          inputBuffer.clear();
+          inputBuffer.put(inputData);
+          session.run(binding);
+
+          float[] resultArray = new float[expectedOutput.length];
+          outputBuffer.clear();
+          outputBuffer.get(resultArray);
+          assertArrayEquals(expectedOutput, resultArray, 1e-6f);
+        }
+
+        // an output bound to the CPU is allocated by the run
+        binding.bindOutput(outputName);
+        session.run(binding);
+        try (OrtSession.Result results = binding.getOutputs()) {
+          assertEquals(1, results.size());
+          OnnxTensor resultTensor = (OnnxTensor) results.get(0);
+          assertArrayEquals(outputShape, resultTensor.getInfo().getShape());
+          assertArrayEquals(
+              expectedOutput, TestHelpers.flattenFloat(resultTensor.getValue()), 1e-6f);
+        }
+      }
+    }
+  }
+
   @Test
   public void throwWrongInputName() throws OrtException {
     SqueezeNetTuple tuple = openSessionSqueezeNet();
@@ -8,6 +8,11 @@ import {Session} from './onnxjs/session';
 import {OnnxjsSessionHandler} from './onnxjs/session-handler';
 
 class OnnxjsBackend implements Backend {
+  /**
+   * @param backendHint the onnxjs backend to run the sessions on, if the session options do not specify one
+   */
+  constructor(private backendHint?: string) {}
+
   // eslint-disable-next-line @typescript-eslint/no-empty-function
   async init(): Promise<void> {}
 
@@ -17,7 +22,11 @@ class OnnxjsBackend implements Backend {
     // onnxruntime-common).
     //       In future we should remove Session.Config and use InferenceSession.SessionOptions.
     //       Currently we allow this to happen to make test runner work.
-    const session = new Session(options as unknown as Session.Config);
+    const config = {...options} as unknown as Session.Config;
+    if (!config.backendHint) {
+      config.backendHint = this.backendHint;
+    }
+    const session = new Session(config);
 
     // typescript cannot merge method override correctly (so far in 4.2.3). need if-else to call the method.
     if (typeof pathOrBuffer === 'string') {
@@ -31,3 +40,4 @@ class OnnxjsBackend implements Backend {
 }
 
 export const onnxjsBackend = new OnnxjsBackend();
+export const webgpuBackend = new OnnxjsBackend('webgpu');
@@ -29,8 +29,10 @@ export const initializeFlags = (): void => {
   }
 
   if (typeof env.wasm.numThreads !== 'number' || !Number.isInteger(env.wasm.numThreads) || env.wasm.numThreads <= 0) {
+    // use one thread per physical core, which is approximated by half of the logical cores. hyper-threads don't help
+    // the compute bound kernels, and every thread is backed by a web worker.
     const numCpuLogicalCores = typeof navigator === 'undefined' ? cpus().length : navigator.hardwareConcurrency;
-    env.wasm.numThreads = Math.min(4, Math.ceil((numCpuLogicalCores || 1) / 2));
+    env.wasm.numThreads = Math.min(16, Math.ceil((numCpuLogicalCores || 1) / 2));
   }
 };
 
@@ -14,6 +14,10 @@ interface BuildDefinitions {
    * defines whether to disable the whole WebGL backend in the build.
    */
   DISABLE_WEBGL: boolean;
+  /**
+   * defines whether to disable the whole WebGPU backend in the build.
+   */
+  DISABLE_WEBGPU: boolean;
   /**
    * defines whether to disable the whole WebAssembly backend in the build.
    */
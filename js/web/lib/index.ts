@@ -13,6 +13,11 @@ if (!BUILD_DEFS.DISABLE_WEBGL) {
   const onnxjsBackend = require('./backend-onnxjs').onnxjsBackend;
   registerBackend('webgl', onnxjsBackend, -1);
 }
+if (!BUILD_DEFS.DISABLE_WEBGPU) {
+  // the WebGPU backend is experimental, so it is only used when it is requested explicitly
+  const webgpuBackend = require('./backend-onnxjs').webgpuBackend;
+  registerBackend('webgpu', webgpuBackend, -10);
+}
 if (!BUILD_DEFS.DISABLE_WASM) {
   const wasmBackend = require('./backend-wasm').wasmBackend;
   registerBackend('wasm', wasmBackend, 0);
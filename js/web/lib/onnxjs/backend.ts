@@ -2,16 +2,24 @@
 // Licensed under the MIT License.
 
 import {WebGLBackend} from './backends/backend-webgl';
+import {WebGpuBackend} from './backends/backend-webgpu';
 import {Graph} from './graph';
 import {Operator} from './operators';
 import {OpSet} from './opset';
 import {Session} from './session';
+import {Tensor} from './tensor';
 
 export interface InferenceHandler {
   /**
    * dispose the inference handler. it will be called as the last step in Session.run()
    */
   dispose(): void;
+
+  /**
+   * keep the data of the outputs of Session.run() on the device after the inference handler is disposed. it will be
+   * called right before dispose(), once the data of the outputs is read
+   */
+  retain?(tensors: readonly Tensor[]): void;
 }
 
 export interface SessionHandler {
@@ -79,6 +87,7 @@ const backendsCache: Map<string, Backend> = new Map();
 
 export const backend: {[name: string]: Backend} = {
   webgl: new WebGLBackend(),
+  webgpu: new WebGpuBackend(),
 };
 
 /**
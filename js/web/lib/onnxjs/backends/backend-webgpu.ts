@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {env} from 'onnxruntime-common';
+
+import {Backend, SessionHandler} from '../backend';
+import {Logger} from '../instrument';
+import {Session} from '../session';
+
+import {GpuDataManager} from './webgpu/gpu-data-manager';
+import {WebGpuSessionHandler} from './webgpu/session-handler';
+
+/**
+ * the number of dispatches encoded before the commands are submitted, so that the GPU starts on the first kernels of
+ * a run while the following ones are being encoded
+ */
+const MAX_PENDING_DISPATCHES = 16;
+
+/**
+ * WebGpuBackend is the entry point for all WebGPU operations.
+ * When it starts it requests the GPUDevice, and creates the GpuDataManager that allocates the storage buffers of the
+ * tensors for all sessions. It also records the compute passes of the kernels, and submits them in batches.
+ */
+export class WebGpuBackend implements Backend {
+  device: GPUDevice;
+  gpuDataManager: GpuDataManager;
+
+  private commandEncoder: GPUCommandEncoder|null = null;
+  private computePassEncoder: GPUComputePassEncoder|null = null;
+  private pendingDispatches = 0;
+
+  async initialize(): Promise<boolean> {
+    try {
+      if (typeof navigator === 'undefined' || !navigator.gpu) {
+        Logger.warning('WebGpuBackend', 'WebGPU is not available in this environment.');
+        return false;
+      }
+      const adapter = await navigator.gpu.requestAdapter();
+      if (!adapter) {
+        Logger.warning('WebGpuBackend', 'Unable to find a WebGPU adapter.');
+        return false;
+      }
+
+      // the default limits of a device are lower than what most adapters support
+      this.device = await adapter.requestDevice({
+        requiredLimits: {
+          maxBufferSize: adapter.limits.maxBufferSize,
+          maxStorageBufferBindingSize: adapter.limits.maxStorageBufferBindingSize,
+          maxComputeWorkgroupsPerDimension: adapter.limits.maxComputeWorkgroupsPerDimension
+        }
+      });
+      this.gpuDataManager = new GpuDataManager(this);
+      // eslint-disable-next-line @typescript-eslint/no-floating-promises
+      this.device.lost.then(info => Logger.error('WebGpuBackend', `WebGPU device lost: ${info.message}`));
+
+      Logger.setWithEnv(env);
+
+      Logger.verbose(
+          'WebGpuBackend',
+          `Created GPUDevice with maxStorageBufferBindingSize: ${this.device.limits.maxStorageBufferBindingSize}.`);
+      return true;
+    } catch (e) {
+      Logger.warning('WebGpuBackend', `Unable to initialize WebGpuBackend. ${e}`);
+      return false;
+    }
+  }
+  createSessionHandler(context: Session.Context): SessionHandler {
+    return new WebGpuSessionHandler(this, context);
+  }
+  dispose(): void {
+    this.flush();
+    this.gpuDataManager.dispose();
+    this.device.destroy();
+  }
+
+  getCommandEncoder(): GPUCommandEncoder {
+    if (!this.commandEncoder) {
+      this.commandEncoder = this.device.createCommandEncoder();
+    }
+    return this.commandEncoder;
+  }
+
+  /**
+   * get the compute pass to record a dispatch in. the dispatches of a compute pass see the writes of the previous
+   * ones, so one pass is reused until a copy has to be recorded.
+   */
+  getComputePassEncoder(): GPUComputePassEncoder {
+    if (!this.computePassEncoder) {
+      this.computePassEncoder = this.getCommandEncoder().beginComputePass();
+    }
+    return this.computePassEncoder;
+  }
+
+  endComputePass(): void {
+    if (this.computePassEncoder) {
+      this.computePassEncoder.end();
+      this.computePassEncoder = null;
+    }
+  }
+
+  /**
+   * count a recorded dispatch, and submit the commands once enough of them are pending
+   */
+  onDispatch(): void {
+    this.pendingDispatches++;
+    if (this.pendingDispatches >= MAX_PENDING_DISPATCHES) {
+      this.flush();
+    }
+  }
+
+  /**
+   * submit the recorded commands
+   */
+  flush(): void {
+    if (!this.commandEncoder) {
+      return;
+    }
+    this.endComputePass();
+    this.device.queue.submit([this.commandEncoder.finish()]);
+    this.commandEncoder = null;
+    this.pendingDispatches = 0;
+  }
+}
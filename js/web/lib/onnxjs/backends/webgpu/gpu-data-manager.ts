@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Logger} from '../../instrument';
+import {Tensor} from '../../tensor';
+import {WebGpuBackend} from '../backend-webgpu';
+
+import {GpuData} from './types';
+
+/**
+ * storage buffers are allocated in multiples of 16 bytes, so that buffers of close sizes can be reused for each other
+ * and the size of any copy is a multiple of 4 bytes as WebGPU requires.
+ */
+const BUFFER_ALIGNMENT = 16;
+
+const calcBufferSize = (size: number): number => Math.max(Math.ceil(size / BUFFER_ALIGNMENT), 1) * BUFFER_ALIGNMENT;
+
+/**
+ * GpuDataManager owns the storage buffers of the tensors on the GPU.
+ *
+ * The buffers are looked up by the ID of the tensor whose data they hold. A tensor can share the buffer of another
+ * tensor, like the output of a Reshape and its input; a buffer is released when no tensor uses it anymore. Released
+ * buffers are kept by size and reused by later allocations of the same size, so that the runs of a session after the
+ * first one do not allocate any buffer.
+ *
+ * The manager belongs to the backend, and is shared by all the sessions that run on it.
+ */
+export class GpuDataManager {
+  // storage buffers of the tensors on the GPU, by tensor ID
+  private storageCache: Map<Tensor.Id, GpuData>;
+  // the number of tensors that use each buffer
+  private bufferRefCounts: Map<GPUBuffer, number>;
+  // released buffers to reuse, by buffer size
+  private freeBuffers: Map<number, GPUBuffer[]>;
+
+  constructor(private backend: WebGpuBackend) {
+    this.storageCache = new Map();
+    this.bufferRefCounts = new Map();
+    this.freeBuffers = new Map();
+  }
+
+  get(id: Tensor.Id): GpuData|undefined {
+    return this.storageCache.get(id);
+  }
+
+  /**
+   * allocate a storage buffer for the data of a tensor
+   * @param id the ID of the tensor
+   * @param size the size of the tensor data in bytes
+   */
+  create(id: Tensor.Id, size: number): GpuData {
+    if (this.storageCache.has(id)) {
+      throw new Error(`tensor ${id} already has data on the GPU`);
+    }
+
+    const bufferSize = calcBufferSize(size);
+    let buffer = this.freeBuffers.get(bufferSize)?.pop();
+    if (!buffer) {
+      Logger.verbose('GpuDataManager', `Allocating a storage buffer of ${bufferSize} bytes`);
+      buffer = this.backend.device.createBuffer(
+          // eslint-disable-next-line no-bitwise
+          {size: bufferSize, usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST});
+    }
+
+    const gpuData = {id, buffer, size};
+    this.storageCache.set(id, gpuData);
+    this.bufferRefCounts.set(buffer, 1);
+    return gpuData;
+  }
+
+  /**
+   * upload the data of a tensor to a new storage buffer
+   */
+  upload(id: Tensor.Id, data: Tensor.NumberType): GpuData {
+    const gpuData = this.create(id, data.byteLength);
+
+    // writeBuffer() runs before the commands that are not submitted yet, and the buffer may be a released one that
+    // they still read
+    this.backend.flush();
+
+    const bytes = new Uint8Array(data.buffer, data.byteOffset, data.byteLength);
+    if (data.byteLength % 4 === 0) {
+      this.backend.device.queue.writeBuffer(gpuData.buffer, 0, bytes);
+    } else {
+      const padded = new Uint8Array(Math.ceil(data.byteLength / 4) * 4);
+      padded.set(bytes);
+      this.backend.device.queue.writeBuffer(gpuData.buffer, 0, padded);
+    }
+    return gpuData;
+  }
+
+  /**
+   * let a tensor use the storage buffer of another tensor, e.g. a reshaped tensor and its source
+   */
+  share(id: Tensor.Id, sourceId: Tensor.Id): GpuData {
+    const source = this.storageCache.get(sourceId);
+    if (!source) {
+      throw new Error(`tensor ${sourceId} has no data on the GPU`);
+    }
+    if (this.storageCache.has(id)) {
+      throw new Error(`tensor ${id} already has data on the GPU`);
+    }
+
+    const gpuData = {id, buffer: source.buffer, size: source.size};
+    this.storageCache.set(id, gpuData);
+    this.bufferRefCounts.set(source.buffer, this.bufferRefCounts.get(source.buffer)! + 1);
+    return gpuData;
+  }
+
+  /**
+   * release the storage buffer of a tensor. the buffer is reused once no other tensor uses it.
+   */
+  release(id: Tensor.Id): void {
+    const gpuData = this.storageCache.get(id);
+    if (!gpuData) {
+      return;
+    }
+    this.storageCache.delete(id);
+
+    const refCount = this.bufferRefCounts.get(gpuData.buffer)! - 1;
+    if (refCount > 0) {
+      this.bufferRefCounts.set(gpuData.buffer, refCount);
+      return;
+    }
+    this.bufferRefCounts.delete(gpuData.buffer);
+    let freeBuffers = this.freeBuffers.get(gpuData.buffer.size);
+    if (!freeBuffers) {
+      freeBuffers = [];
+      this.freeBuffers.set(gpuData.buffer.size, freeBuffers);
+    }
+    freeBuffers.push(gpuData.buffer);
+  }
+
+  /**
+   * read the data of a tensor back from the GPU
+   */
+  async download(id: Tensor.Id): Promise<ArrayBuffer> {
+    const gpuData = this.storageCache.get(id);
+    if (!gpuData) {
+      throw new Error(`tensor ${id} has no data on the GPU`);
+    }
+
+    const bufferSize = calcBufferSize(gpuData.size);
+    const stagingBuffer = this.backend.device.createBuffer(
+        // eslint-disable-next-line no-bitwise
+        {size: bufferSize, usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST});
+    this.backend.endComputePass();
+    this.backend.getCommandEncoder().copyBufferToBuffer(gpuData.buffer, 0, stagingBuffer, 0, bufferSize);
+    this.backend.flush();
+
+    await stagingBuffer.mapAsync(GPUMapMode.READ);
+    const data = stagingBuffer.getMappedRange().slice(0, gpuData.size);
+    stagingBuffer.destroy();
+    return data;
+  }
+
+  dispose(): void {
+    this.storageCache.forEach(gpuData => gpuData.buffer.destroy());
+    this.freeBuffers.forEach(buffers => buffers.forEach(buffer => buffer.destroy()));
+    this.storageCache = new Map();
+    this.bufferRefCounts = new Map();
+    this.freeBuffers = new Map();
+  }
+}
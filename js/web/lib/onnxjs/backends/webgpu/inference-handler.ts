@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {InferenceHandler} from '../../backend';
+import {createView, sizeof, Tensor} from '../../tensor';
+import {ShapeUtil} from '../../util';
+
+import {GpuDataManager} from './gpu-data-manager';
+import {WebGpuSessionHandler} from './session-handler';
+import {GpuData, ProgramInfo, ProgramInfoLoader} from './types';
+
+const getProgramInfoUniqueKey = (programInfo: ProgramInfo|ProgramInfoLoader, inputs: readonly Tensor[]): string => {
+  let key = programInfo.name;
+  if (programInfo.cacheHint) {
+    key += '[' + programInfo.cacheHint + ']';
+  }
+  key += ':' + inputs.map(input => `${input.type};${input.dims.join(',')}`).join('_');
+  return key;
+};
+
+export class WebGpuInferenceHandler implements InferenceHandler {
+  // the tensors whose GPU data is created in this run, to release when the run ends
+  private dataIds: Tensor.Id[];
+
+  constructor(public session: WebGpuSessionHandler) {
+    this.dataIds = [];
+  }
+
+  private get dataManager(): GpuDataManager {
+    return this.session.backend.gpuDataManager;
+  }
+
+  run(program: ProgramInfoLoader|ProgramInfo, inputs: readonly Tensor[]): Tensor[] {
+    if (inputs.length < program.inputCount) {
+      throw new Error(`Input size mustn't be less than ${program.inputCount}.`);
+    }
+    const programInputs = inputs.slice(0, program.inputCount);
+
+    // upload the inputs that are not on the GPU yet
+    const inputDatas = programInputs.map(input => this.getOrCreateGpuData(input));
+
+    const key = getProgramInfoUniqueKey(program, programInputs);
+    let artifact = this.session.programManager.getArtifact(key);
+    const programInfo = artifact ?
+        artifact.programInfo :
+        (typeof (program as ProgramInfoLoader).get === 'function' ? (program as ProgramInfoLoader).get() :
+                                                                    (program as ProgramInfo));
+    if (!artifact) {
+      artifact = this.session.programManager.build(programInfo);
+      this.session.programManager.setArtifact(key, artifact);
+    }
+
+    const outputs = programInfo.outputs.map(info => this.createTensor(info.dims, info.type));
+    const outputDatas = outputs.map(
+        output => this.dataManager.create(output.dataId, ShapeUtil.size(output.dims) * sizeof(output.type)));
+    this.dataIds.push(...outputs.map(output => output.dataId));
+
+    this.session.programManager.run(artifact, inputDatas, outputDatas);
+    return outputs;
+  }
+
+  /**
+   * Create a tensor of the given dims that shares the data of the input tensor. Tensors on the GPU share the storage
+   * buffer; the others share the data on the CPU.
+   */
+  reshape(input: Tensor, dims: readonly number[]): Tensor {
+    if (!this.dataManager.get(input.dataId)) {
+      return new Tensor(dims, input.type, undefined, undefined, input.data);
+    }
+    const output = this.createTensor(dims, input.type);
+    this.dataManager.share(output.dataId, input.dataId);
+    this.dataIds.push(output.dataId);
+    return output;
+  }
+
+  /**
+   * keep the GPU data of the outputs of the run, so that they can be bound to the inputs of later runs of any session
+   * without being uploaded again. The session handler releases them when the session runs again or is disposed.
+   */
+  retain(tensors: readonly Tensor[]): void {
+    const retained = new Set(tensors.map(tensor => tensor.dataId));
+    this.session.retainOutputs(this.dataIds.filter(id => retained.has(id)));
+    this.dataIds = this.dataIds.filter(id => !retained.has(id));
+  }
+
+  dispose(): void {
+    this.dataIds.forEach(id => this.dataManager.release(id));
+    this.dataIds = [];
+  }
+
+  private getOrCreateGpuData(tensor: Tensor): GpuData {
+    const gpuData = this.dataManager.get(tensor.dataId);
+    if (gpuData) {
+      return gpuData;
+    }
+    if (tensor.type === 'string') {
+      throw new Error('string tensors are not supported by the WebGPU backend');
+    }
+
+    // initializers stay on the GPU for the lifetime of the session
+    const uploaded = this.dataManager.upload(tensor.dataId, tensor.numberData);
+    if (!this.session.isInitializer(tensor.dataId)) {
+      this.dataIds.push(tensor.dataId);
+    }
+    return uploaded;
+  }
+
+  private createTensor(dims: readonly number[], type: Tensor.DataType): Tensor {
+    return new Tensor(
+        dims, type,
+        () => {
+          throw new Error('the data of a tensor on the GPU can only be read asynchronously by Tensor.getData()');
+        },
+        async (id: Tensor.Id) => createView(await this.dataManager.download(id), type) as Tensor.NumberType);
+  }
+}
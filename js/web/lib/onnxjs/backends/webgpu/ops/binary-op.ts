@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Graph} from '../../../graph';
+import {OperatorImplementation} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {BroadcastUtil, ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramInfoLoader} from '../types';
+
+import {declareBindings, getBroadcastOffset, getElementwiseDispatchGroup, getElementwiseIndex, validateFloatInputs, WORKGROUP_SIZE} from './common';
+
+const createBinaryOpProgramInfoLoader = (inputs: readonly Tensor[], name: string, operator: string):
+    ProgramInfoLoader => ({
+      name,
+      inputCount: 2,
+      get: (): ProgramInfo => {
+        const outputDims = BroadcastUtil.calcShape(inputs[0].dims, inputs[1].dims, false);
+        if (!outputDims) {
+          throw new Error(`Can't perform ${name} on the given tensors`);
+        }
+        const size = ShapeUtil.size(outputDims);
+        const shaderSource = `
+${declareBindings(['a', 'b'], ['output'])}
+
+@compute @workgroup_size(${WORKGROUP_SIZE})
+fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
+  ${getElementwiseIndex(size)}
+  let x = a[${getBroadcastOffset('index', outputDims, inputs[0].dims)}];
+  let y = b[${getBroadcastOffset('index', outputDims, inputs[1].dims)}];
+  output[index] = x ${operator} y;
+}`;
+        return {
+          name,
+          inputCount: 2,
+          outputs: [{dims: outputDims, type: inputs[0].type}],
+          shaderSource,
+          dispatchGroup: getElementwiseDispatchGroup(size)
+        };
+      }
+    });
+
+const binaryOp = (name: string, operator: string): OperatorImplementation<Graph.Node> =>
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+      validateFloatInputs(name, inputs);
+      return inferenceHandler.run(createBinaryOpProgramInfoLoader(inputs, name, operator), inputs);
+    };
+
+export const add = binaryOp('Add', '+');
+export const div = binaryOp('Div', '/');
+export const mul = binaryOp('Mul', '*');
+export const sub = binaryOp('Sub', '-');
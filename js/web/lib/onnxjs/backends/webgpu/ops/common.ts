@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Tensor} from '../../../tensor';
+import {MAX_CLIP, MIN_CLIP, ShapeUtil} from '../../../util';
+import {DispatchGroup} from '../types';
+
+/**
+ * the number of invocations in the workgroups of the elementwise and reduction shaders
+ */
+export const WORKGROUP_SIZE = 64;
+
+/**
+ * the number of workgroups that can be dispatched on each dimension, with the default limits of WebGPU
+ */
+const MAX_WORKGROUPS_PER_DIMENSION = 65535;
+
+/**
+ * get the dispatch group of the given number of workgroups, which spills to the y dimension once the limit of the x
+ * dimension is reached. see getWorkgroupIndex().
+ */
+export const getDispatchGroup = (workgroupCount: number): DispatchGroup => {
+  if (workgroupCount <= MAX_WORKGROUPS_PER_DIMENSION) {
+    return {x: workgroupCount};
+  }
+  return {x: MAX_WORKGROUPS_PER_DIMENSION, y: Math.ceil(workgroupCount / MAX_WORKGROUPS_PER_DIMENSION)};
+};
+
+/**
+ * WGSL expression of the index of the workgroup in a dispatch group created by getDispatchGroup()
+ */
+export const getWorkgroupIndex = (workgroupId = 'workgroup_id'): string =>
+    `(${workgroupId}.y * ${MAX_WORKGROUPS_PER_DIMENSION}u + ${workgroupId}.x)`;
+
+/**
+ * get the dispatch group of an elementwise shader, which runs an invocation per output element
+ */
+export const getElementwiseDispatchGroup = (size: number): DispatchGroup =>
+    getDispatchGroup(Math.ceil(size / WORKGROUP_SIZE));
+
+/**
+ * WGSL statements that compute `index`, the index of the output element of the invocation of an elementwise shader,
+ * and return from the invocations past the last element
+ */
+export const getElementwiseIndex = (size: number, globalId = 'global_id'): string => `
+  let index = ${globalId}.y * ${MAX_WORKGROUPS_PER_DIMENSION * WORKGROUP_SIZE}u + ${globalId}.x;
+  if (index >= ${size}u) {
+    return;
+  }`;
+
+/**
+ * WGSL declarations of the storage buffers bound to a program: the inputs, read-only, then the outputs
+ */
+export const declareBindings = (inputs: readonly string[], outputs: readonly string[], type = 'f32'): string =>
+    inputs.map((name, i) => `@group(0) @binding(${i}) var<storage, read> ${name} : array<${type}>;`)
+        .concat(outputs.map(
+            (name, i) => `@group(0) @binding(${inputs.length + i}) var<storage, read_write> ${name} : array<${type}>;`))
+        .join('\n');
+
+/**
+ * WGSL expression of the offset in an input of the element that broadcasts to an offset in the output, following the
+ * multidirectional broadcasting of ONNX
+ * @param outputOffset WGSL expression of the offset in the output, of type u32
+ * @param outputDims the dims of the output
+ * @param inputDims the dims of the input, which broadcast to the output dims
+ */
+export const getBroadcastOffset =
+    (outputOffset: string, outputDims: readonly number[], inputDims: readonly number[]): string => {
+      if (ShapeUtil.areEqual(outputDims, inputDims)) {
+        return outputOffset;
+      }
+
+      const outputStrides = ShapeUtil.computeStrides(outputDims);
+      const inputStrides = ShapeUtil.computeStrides(inputDims);
+      const rankDiff = outputDims.length - inputDims.length;
+      const terms: string[] = [];
+      for (let i = 0; i < inputDims.length; i++) {
+        if (inputDims[i] !== 1) {
+          terms.push(`((${outputOffset} / ${outputStrides[i + rankDiff]}u) % ${outputDims[i + rankDiff]}u) * ${
+              inputStrides[i]}u`);
+        }
+      }
+      return terms.length === 0 ? '0u' : `(${terms.join(' + ')})`;
+    };
+
+/**
+ * WGSL statements that reduce `${value}`, a f32 of each invocation, over the workgroup into `${result}`, with the
+ * given WGSL binary function. Every invocation of the workgroup has to run them.
+ * The shader declares `workgroupData`, an array<f32, WORKGROUP_SIZE> in workgroup memory, and the `local_index`
+ * builtin.
+ */
+export const getWorkgroupReduction = (value: string, result: string, reduce: (a: string, b: string) => string):
+    string => `
+  workgroupData[local_index] = ${value};
+  workgroupBarrier();
+  for (var stride = ${WORKGROUP_SIZE / 2}u; stride > 0u; stride = stride >> 1u) {
+    if (local_index < stride) {
+      workgroupData[local_index] = ${reduce('workgroupData[local_index]', 'workgroupData[local_index + stride]')};
+    }
+    workgroupBarrier();
+  }
+  let ${result} = workgroupData[0];
+  workgroupBarrier();`;
+
+export const validateFloatInputs = (opType: string, inputs: readonly Tensor[]): void => {
+  if (inputs.some(input => input.type !== 'float32')) {
+    throw new Error(`${opType} of the WebGPU backend only supports float32 tensors`);
+  }
+};
+
+/**
+ * format a number as a WGSL f32 literal. infinities are clamped to the largest finite values.
+ */
+export const toWgslFloat = (value: number): string => {
+  const text = Math.min(Math.max(Math.fround(value), MIN_CLIP), MAX_CLIP).toExponential();
+  return value < 0 ? `(${text})` : text;
+};
@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {OperatorImplementation, OperatorInitialization} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {MAX_CLIP, MIN_CLIP, PoolConvUtil, ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramInfoLoader} from '../types';
+
+import {declareBindings, getElementwiseDispatchGroup, getElementwiseIndex, toWgslFloat, validateFloatInputs, WORKGROUP_SIZE} from './common';
+import {createMatMulShaderSource, getMatMulDispatchGroup} from './matmul';
+
+export interface ConvAttributes extends AttributeWithCacheKey {
+  readonly autoPad: string;
+  readonly dilations: readonly number[];
+  readonly group: number;
+  readonly kernelShape: readonly number[];
+  readonly pads: readonly number[];
+  readonly strides: readonly number[];
+  // the activation fused into FusedConv
+  readonly activation: string;
+  readonly clipMin: number;
+  readonly clipMax: number;
+}
+
+export const conv: OperatorImplementation<ConvAttributes> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[], attributes: ConvAttributes): Tensor[] => {
+      validateInputs(inputs, attributes);
+      const adjustedAttributes = getAdjustedConvAttributes(attributes, inputs);
+      const isPointwise = adjustedAttributes.group === 1 && adjustedAttributes.kernelShape.every(k => k === 1) &&
+          adjustedAttributes.strides.every(s => s === 1) && adjustedAttributes.pads.every(p => p === 0);
+      if (isPointwise) {
+        // the product takes W as A and X as B, so W is bound first
+        const programInfoLoader = createPointwiseConvProgramInfoLoader(inputs, adjustedAttributes);
+        return inferenceHandler.run(programInfoLoader, [inputs[1], inputs[0], ...inputs.slice(2)]);
+      }
+      return inferenceHandler.run(createConvProgramInfoLoader(inputs, adjustedAttributes), inputs);
+    };
+
+export const parseConvAttributes: OperatorInitialization<ConvAttributes> = (node: Graph.Node): ConvAttributes => {
+  const attributes = node.attributes;
+  const autoPad = attributes.getString('auto_pad', 'NOTSET');
+  const dilations = attributes.getInts('dilations', []);
+  const group = attributes.getInt('group', 1);
+  const kernelShape = attributes.getInts('kernel_shape', []);
+  const pads = attributes.getInts('pads', []);
+  const strides = attributes.getInts('strides', []);
+  const activation = attributes.getString('activation', '');
+  const [clipMin, clipMax] =
+      activation === 'Clip' ? attributes.getFloats('activation_params', [MIN_CLIP, MAX_CLIP]) : [MIN_CLIP, MAX_CLIP];
+
+  return createAttributeWithCacheKey(
+      {autoPad, dilations, group, kernelShape, pads, strides, activation, clipMin, clipMax});
+};
+
+/**
+ * fill in the defaults of the attributes that depend on the rank of the input, and apply auto_pad to the pads
+ */
+const getAdjustedConvAttributes = (attributes: ConvAttributes, inputs: Tensor[]): ConvAttributes => {
+  const spatialRank = inputs[0].dims.length - 2;
+  const kernelShape = attributes.kernelShape.length > 0 ? attributes.kernelShape.slice() : inputs[1].dims.slice(2);
+  const dilations = attributes.dilations.length > 0 ? attributes.dilations.slice() : new Array(spatialRank).fill(1);
+  const strides = attributes.strides.length > 0 ? attributes.strides.slice() : new Array(spatialRank).fill(1);
+  const pads = attributes.pads.length > 0 ? attributes.pads.slice() : new Array(spatialRank * 2).fill(0);
+  PoolConvUtil.adjustPadsBasedOnAutoPad(inputs[0].dims, strides, dilations, kernelShape, pads, attributes.autoPad);
+
+  // always return a new object so does not modify the original attributes
+  const newAttributes: ConvAttributes = Object.assign({}, attributes);
+  Object.assign(newAttributes, {kernelShape, dilations, strides, pads, cacheKey: attributes.cacheKey});
+  return newAttributes;
+};
+
+const getActivationSnippet = (attributes: ConvAttributes): string => {
+  switch (attributes.activation) {
+    case 'Relu':
+      return 'value = max(value, 0.0);';
+    case 'Sigmoid':
+      return 'value = 1.0 / (1.0 + exp(-value));';
+    case 'Clip':
+      return `value = clamp(value, ${toWgslFloat(attributes.clipMin)}, ${toWgslFloat(attributes.clipMax)});`;
+    default:
+      return '';
+  }
+};
+
+const getOutputDims = (inputs: readonly Tensor[], attributes: ConvAttributes): number[] => {
+  const outputDims = [inputs[0].dims[0], inputs[1].dims[0]];
+  for (let i = 0; i < inputs[0].dims.length - 2; i++) {
+    const dilatedKernel = attributes.dilations[i] * (attributes.kernelShape[i] - 1) + 1;
+    const paddedInput = inputs[0].dims[i + 2] + attributes.pads[i] + attributes.pads[i + inputs[0].dims.length - 2];
+    outputDims.push(Math.floor((paddedInput - dilatedKernel) / attributes.strides[i]) + 1);
+  }
+  return outputDims;
+};
+
+/**
+ * a 1x1 convolution of stride 1 is the product of W, as a [M, C] matrix, and of each image of X, as a [C, H * W]
+ * matrix
+ */
+const createPointwiseConvProgramInfoLoader =
+    (inputs: readonly Tensor[], attributes: ConvAttributes): ProgramInfoLoader => ({
+      name: 'PointwiseConv',
+      inputCount: inputs.length,
+      cacheHint: attributes.cacheKey,
+      get: (): ProgramInfo => {
+        const outputDims = getOutputDims(inputs, attributes);
+        const [batchSize, channels] = inputs[0].dims;
+        const M = inputs[1].dims[0];
+        const N = ShapeUtil.sizeFromDimension(inputs[0].dims, 2);
+        const bias = inputs.length === 3 ? 'value = value + bias[row];' : '';
+        const shaderSource = createMatMulShaderSource({
+          inputNames: inputs.length === 3 ? ['w', 'x', 'bias'] : ['w', 'x'],
+          m: M,
+          n: N,
+          k: channels,
+          transA: false,
+          transB: false,
+          aBatchOffset: '0u',
+          bBatchOffset: `batch * ${channels * N}u`,
+          epilogue: `${bias}\n    ${getActivationSnippet(attributes)}`
+        });
+        return {
+          name: 'PointwiseConv',
+          inputCount: inputs.length,
+          cacheHint: attributes.cacheKey,
+          outputs: [{dims: outputDims, type: inputs[0].type}],
+          shaderSource,
+          dispatchGroup: getMatMulDispatchGroup(M, N, batchSize)
+        };
+      }
+    });
+
+/**
+ * the direct convolution, which computes an output element per invocation. 1D convolutions run as 2D ones of height 1.
+ */
+const createConvProgramInfoLoader = (inputs: readonly Tensor[], attributes: ConvAttributes): ProgramInfoLoader => ({
+  name: 'Conv',
+  inputCount: inputs.length,
+  cacheHint: attributes.cacheKey,
+  get: (): ProgramInfo => {
+    const outputDims = getOutputDims(inputs, attributes);
+    const is1D = inputs[0].dims.length === 3;
+    const [batchSize, channels] = inputs[0].dims;
+    const [inputHeight, inputWidth] = is1D ? [1, inputs[0].dims[2]] : inputs[0].dims.slice(2);
+    const [outputHeight, outputWidth] = is1D ? [1, outputDims[2]] : outputDims.slice(2);
+    const [kernelHeight, kernelWidth] = is1D ? [1, attributes.kernelShape[0]] : attributes.kernelShape;
+    const [strideHeight, strideWidth] = is1D ? [1, attributes.strides[0]] : attributes.strides;
+    const [dilationHeight, dilationWidth] = is1D ? [1, attributes.dilations[0]] : attributes.dilations;
+    const [padTop, padLeft] = is1D ? [0, attributes.pads[0]] : attributes.pads;
+
+    const outputChannels = outputDims[1];
+    const outputChannelsPerGroup = outputChannels / attributes.group;
+    const channelsPerGroup = channels / attributes.group;
+    const size = batchSize * outputChannels * outputHeight * outputWidth;
+    const shaderSource = `
+${declareBindings(inputs.length === 3 ? ['x', 'w', 'bias'] : ['x', 'w'], ['output'])}
+
+@compute @workgroup_size(${WORKGROUP_SIZE})
+fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
+  ${getElementwiseIndex(size)}
+  let ow = index % ${outputWidth}u;
+  let oh = (index / ${outputWidth}u) % ${outputHeight}u;
+  let m = (index / ${outputWidth * outputHeight}u) % ${outputChannels}u;
+  let n = index / ${outputWidth * outputHeight * outputChannels}u;
+  let channelStart = (m / ${outputChannelsPerGroup}u) * ${channelsPerGroup}u;
+
+  var value = 0.0;
+  for (var c = 0u; c < ${channelsPerGroup}u; c = c + 1u) {
+    let xOffset = (n * ${channels}u + channelStart + c) * ${inputHeight * inputWidth}u;
+    let wOffset = (m * ${channelsPerGroup}u + c) * ${kernelHeight * kernelWidth}u;
+    for (var kh = 0u; kh < ${kernelHeight}u; kh = kh + 1u) {
+      let ih = i32(oh * ${strideHeight}u + kh * ${dilationHeight}u) - ${padTop};
+      if (ih < 0 || ih >= ${inputHeight}) {
+        continue;
+      }
+      for (var kw = 0u; kw < ${kernelWidth}u; kw = kw + 1u) {
+        let iw = i32(ow * ${strideWidth}u + kw * ${dilationWidth}u) - ${padLeft};
+        if (iw < 0 || iw >= ${inputWidth}) {
+          continue;
+        }
+        value = value + x[xOffset + u32(ih) * ${inputWidth}u + u32(iw)] * w[wOffset + kh * ${kernelWidth}u + kw];
+      }
+    }
+  }
+  ${inputs.length === 3 ? 'value = value + bias[m];' : ''}
+  ${getActivationSnippet(attributes)}
+  output[index] = value;
+}`;
+    return {
+      name: 'Conv',
+      inputCount: inputs.length,
+      cacheHint: attributes.cacheKey,
+      outputs: [{dims: outputDims, type: inputs[0].type}],
+      shaderSource,
+      dispatchGroup: getElementwiseDispatchGroup(size)
+    };
+  }
+});
+
+const validateInputs = (inputs: Tensor[], attributes: ConvAttributes): void => {
+  // Refer to the below link for all input checks
+  // https://github.com/onnx/onnx/blob/master/docs/Operators.md#Conv
+  if (!inputs || (inputs.length !== 2 && inputs.length !== 3)) {
+    throw new Error('Conv requires 2 or 3 inputs');
+  }
+
+  if ((inputs[0].dims.length !== 3 && inputs[0].dims.length !== 4) || inputs[1].dims.length !== inputs[0].dims.length) {
+    throw new Error('currently only support 1-dimensional and 2-dimensional conv');
+  }
+
+  // FILTER_IN_CHANNEL should be equal to DATA_CHANNEL
+  const dataChannel = inputs[0].dims[1];
+  const filterInChannel = inputs[1].dims[1] * attributes.group;
+  if (dataChannel !== filterInChannel) {
+    throw new Error('FILTER_IN_CHANNEL should be equal to DATA_CHANNEL');
+  }
+
+  // if bias is provided it should be 1D and the number of elements should be equal to the number of feature maps
+  if (inputs.length === 3 && (inputs[2].dims.length !== 1 || inputs[1].dims[0] !== inputs[2].dims[0])) {
+    throw new Error('invalid bias');
+  }
+
+  const spatialRank = inputs[0].dims.length - 2;
+  if (attributes.dilations.length !== 0 && attributes.dilations.length !== spatialRank) {
+    throw new Error(`dilations should be ${spatialRank}D`);
+  }
+  if (attributes.strides.length !== 0 && attributes.strides.length !== spatialRank) {
+    throw new Error(`strides should be ${spatialRank}D`);
+  }
+  if (attributes.pads.length !== 0 && attributes.pads.length !== spatialRank * 2) {
+    throw new Error(`pads should be ${spatialRank * 2}D`);
+  }
+  if (attributes.kernelShape.length !== 0 && attributes.kernelShape.length !== spatialRank) {
+    throw new Error('invalid kernel shape');
+  }
+
+  validateFloatInputs('Conv', inputs);
+};
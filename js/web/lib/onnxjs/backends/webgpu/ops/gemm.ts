@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {OperatorImplementation, OperatorInitialization} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {GemmUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramInfoLoader} from '../types';
+
+import {getBroadcastOffset, toWgslFloat, validateFloatInputs} from './common';
+import {createMatMulShaderSource, getMatMulDispatchGroup} from './matmul';
+
+export interface GemmAttributes extends AttributeWithCacheKey {
+  transA: boolean;
+  transB: boolean;
+  alpha: number;
+  beta: number;
+  isOptionalC: boolean;  // in opset 11, C becomes optional
+}
+
+export const gemm: OperatorImplementation<GemmAttributes> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[], attributes: GemmAttributes): Tensor[] => {
+      validateInputs(inputs, attributes);
+      return inferenceHandler.run(createGemmProgramInfoLoader(inputs, attributes), inputs);
+    };
+
+const parseGemmAttributes = (node: Graph.Node, isOptionalC: boolean): GemmAttributes => {
+  const transA = node.attributes.getInt('transA', 0) !== 0;
+  const transB = node.attributes.getInt('transB', 0) !== 0;
+  const alpha = node.attributes.getFloat('alpha', 1.0);
+  const beta = node.attributes.getFloat('beta', 1.0);
+  return createAttributeWithCacheKey({transA, transB, alpha, beta, isOptionalC});
+};
+
+export const parseGemmAttributesV7: OperatorInitialization<GemmAttributes> = (node: Graph.Node): GemmAttributes =>
+    parseGemmAttributes(node, false);
+
+export const parseGemmAttributesV11: OperatorInitialization<GemmAttributes> = (node: Graph.Node): GemmAttributes =>
+    parseGemmAttributes(node, true);
+
+// C is not bound when it is multiplied by 0
+const getInputCount = (inputs: readonly Tensor[], attributes: GemmAttributes): number =>
+    inputs.length === 3 && attributes.beta !== 0 ? 3 : 2;
+
+const createGemmProgramInfoLoader = (inputs: readonly Tensor[], attributes: GemmAttributes): ProgramInfoLoader => ({
+  name: 'Gemm',
+  inputCount: getInputCount(inputs, attributes),
+  cacheHint: attributes.cacheKey,
+  get: () => createGemmProgramInfo(inputs, attributes)
+});
+
+const createGemmProgramInfo = (inputs: readonly Tensor[], attributes: GemmAttributes): ProgramInfo => {
+  const inputCount = getInputCount(inputs, attributes);
+  const [M, N, K] = GemmUtil.getShapeOfGemmResult(
+      inputs[0].dims, attributes.transA, inputs[1].dims, attributes.transB,
+      inputs.length === 3 ? inputs[2].dims : undefined);
+
+  let epilogue = `value = value * ${toWgslFloat(attributes.alpha)};`;
+  if (inputCount === 3) {
+    // C broadcasts to [M, N]
+    const cOffset = getBroadcastOffset(`(row * ${N}u + col)`, [M, N], inputs[2].dims);
+    epilogue += `\n    value = value + ${toWgslFloat(attributes.beta)} * c[${cOffset}];`;
+  }
+
+  const shaderSource = createMatMulShaderSource({
+    inputNames: inputCount === 3 ? ['a', 'b', 'c'] : ['a', 'b'],
+    m: M,
+    n: N,
+    k: K,
+    transA: attributes.transA,
+    transB: attributes.transB,
+    aBatchOffset: '0u',
+    bBatchOffset: '0u',
+    epilogue
+  });
+  return {
+    name: 'Gemm',
+    inputCount,
+    cacheHint: attributes.cacheKey,
+    outputs: [{dims: [M, N], type: inputs[0].type}],
+    shaderSource,
+    dispatchGroup: getMatMulDispatchGroup(M, N, 1)
+  };
+};
+
+const validateInputs = (inputs: Tensor[], attributes: GemmAttributes): void => {
+  if (!inputs) {
+    throw new Error('Input is missing');
+  }
+  if (attributes.isOptionalC && (inputs.length < 2 || inputs.length > 3)) {
+    throw new Error('Invalid input shape.');
+  }
+  if (!attributes.isOptionalC && inputs.length !== 3) {
+    throw new Error('Gemm requires 3 inputs');
+  }
+
+  // 'C' can be of dimensionality 1 or 2 only
+  if (inputs.length === 3 && inputs[2].dims.length !== 1 && inputs[2].dims.length !== 2) {
+    throw new Error('Invalid input shape of C');
+  }
+
+  validateFloatInputs('Gemm', inputs);
+};
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {OperatorImplementation, OperatorInitialization} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramInfoLoader} from '../types';
+
+import {declareBindings, getDispatchGroup, getWorkgroupIndex, getWorkgroupReduction, toWgslFloat, validateFloatInputs, WORKGROUP_SIZE} from './common';
+
+export interface LayerNormalizationAttributes extends AttributeWithCacheKey {
+  readonly axis: number;
+  readonly epsilon: number;
+}
+
+export const layerNormalization: OperatorImplementation<LayerNormalizationAttributes> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[], attributes: LayerNormalizationAttributes):
+        Tensor[] => {
+          validateInputs(inputs, attributes);
+          return inferenceHandler.run(createLayerNormalizationProgramInfoLoader(inputs, attributes), inputs);
+        };
+
+export const parseLayerNormalizationAttributes: OperatorInitialization<LayerNormalizationAttributes> =
+    (node: Graph.Node): LayerNormalizationAttributes => {
+      if (node.outputs.length > 1) {
+        throw new Error('LayerNormalization of the WebGPU backend only supports the output Y');
+      }
+      return createAttributeWithCacheKey(
+          {axis: node.attributes.getInt('axis', -1), epsilon: node.attributes.getFloat('epsilon', 1e-5)});
+    };
+
+/**
+ * Each workgroup normalizes a row, the elements of the dims from the axis on. Its invocations reduce the mean, then the
+ * variance, over strided elements of the row.
+ */
+const createLayerNormalizationProgramInfoLoader =
+    (inputs: readonly Tensor[], attributes: LayerNormalizationAttributes): ProgramInfoLoader => ({
+      name: 'LayerNormalization',
+      inputCount: inputs.length,
+      cacheHint: attributes.cacheKey,
+      get: (): ProgramInfo => {
+        const dims = inputs[0].dims;
+        const axis = ShapeUtil.normalizeAxis(attributes.axis, dims.length);
+        const rowSize = ShapeUtil.sizeFromDimension(dims, axis);
+        const rowCount = ShapeUtil.sizeToDimension(dims, axis);
+        const bias = inputs.length === 3 ? ' + bias[i]' : '';
+
+        const shaderSource = `
+${declareBindings(inputs.length === 3 ? ['input', 'scale', 'bias'] : ['input', 'scale'], ['output'])}
+
+var<workgroup> workgroupData : array<f32, ${WORKGROUP_SIZE}>;
+
+@compute @workgroup_size(${WORKGROUP_SIZE})
+fn main(@builtin(workgroup_id) workgroup_id : vec3<u32>, @builtin(local_invocation_index) local_index : u32) {
+  // the invocations of the workgroups past the last row compute the last row again, without writing it
+  let row = min(${getWorkgroupIndex()}, ${Math.max(rowCount - 1, 0)}u);
+  let rowOffset = row * ${rowSize}u;
+
+  var localSum = 0.0;
+  for (var i = local_index; i < ${rowSize}u; i = i + ${WORKGROUP_SIZE}u) {
+    localSum = localSum + input[rowOffset + i];
+  }
+  ${getWorkgroupReduction('localSum', 'rowSum', (a, b) => `${a} + ${b}`)}
+  let mean = rowSum / ${rowSize}.0;
+
+  var localSquareSum = 0.0;
+  for (var i = local_index; i < ${rowSize}u; i = i + ${WORKGROUP_SIZE}u) {
+    let deviation = input[rowOffset + i] - mean;
+    localSquareSum = localSquareSum + deviation * deviation;
+  }
+  ${getWorkgroupReduction('localSquareSum', 'rowSquareSum', (a, b) => `${a} + ${b}`)}
+  let invStdDev = inverseSqrt(rowSquareSum / ${rowSize}.0 + ${toWgslFloat(attributes.epsilon)});
+
+  if (${getWorkgroupIndex()} < ${rowCount}u) {
+    for (var i = local_index; i < ${rowSize}u; i = i + ${WORKGROUP_SIZE}u) {
+      output[rowOffset + i] = (input[rowOffset + i] - mean) * invStdDev * scale[i]${bias};
+    }
+  }
+}`;
+        return {
+          name: 'LayerNormalization',
+          inputCount: inputs.length,
+          cacheHint: attributes.cacheKey,
+          outputs: [{dims, type: inputs[0].type}],
+          shaderSource,
+          dispatchGroup: getDispatchGroup(rowCount)
+        };
+      }
+    });
+
+const validateInputs = (inputs: Tensor[], attributes: LayerNormalizationAttributes): void => {
+  if (!inputs || (inputs.length !== 2 && inputs.length !== 3)) {
+    throw new Error('LayerNormalization requires 2 or 3 inputs');
+  }
+
+  const axis = ShapeUtil.normalizeAxis(attributes.axis, inputs[0].dims.length);
+  const rowSize = ShapeUtil.sizeFromDimension(inputs[0].dims, axis);
+  if (inputs.slice(1).some(input => ShapeUtil.size(input.dims) !== rowSize)) {
+    throw new Error('the size of Scale and B should be the size of the normalized dims');
+  }
+
+  validateFloatInputs('LayerNormalization', inputs);
+};
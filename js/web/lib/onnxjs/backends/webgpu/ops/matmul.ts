@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Graph} from '../../../graph';
+import {OperatorImplementation} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {BroadcastUtil, MatMulUtil, ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {DispatchGroup, ProgramInfo, ProgramInfoLoader} from '../types';
+
+import {declareBindings, getBroadcastOffset, validateFloatInputs} from './common';
+
+/**
+ * the size of the square tiles of the output, and of the slices of A and B, that a workgroup computes from its
+ * workgroup memory
+ */
+const TILE_SIZE = 16;
+
+export interface MatMulShaderParams {
+  inputNames: readonly string[];
+  // the dims of the product of A, a [m, k] matrix once transposed by transA, and of B, a [k, n] one
+  m: number;
+  n: number;
+  k: number;
+  transA: boolean;
+  transB: boolean;
+  /**
+   * WGSL expressions of the offsets of the matrices of the batch `batch` in A and B
+   */
+  aBatchOffset: string;
+  bBatchOffset: string;
+  /**
+   * WGSL statements that update `value`, the product at `row` and `col` of the matrix of the batch `batch`, before
+   * it is written
+   */
+  epilogue?: string;
+}
+
+/**
+ * get the WGSL shader of a batched matrix multiplication. Each workgroup computes a tile of the output: it loads the
+ * tiles of A and B along K into workgroup memory in turn, and accumulates their products.
+ */
+export const createMatMulShaderSource = (params: MatMulShaderParams): string => {
+  const {m: M, n: N, k: K} = params;
+  const aIndex = params.transA ? `aCol * ${M}u + row` : `row * ${K}u + aCol`;
+  const bIndex = params.transB ? `col * ${K}u + bRow` : `bRow * ${N}u + col`;
+  return `
+${declareBindings(params.inputNames, ['output'])}
+
+const TILE_SIZE = ${TILE_SIZE}u;
+var<workgroup> tileA : array<array<f32, ${TILE_SIZE}>, ${TILE_SIZE}>;
+var<workgroup> tileB : array<array<f32, ${TILE_SIZE}>, ${TILE_SIZE}>;
+
+@compute @workgroup_size(${TILE_SIZE}, ${TILE_SIZE}, 1)
+fn main(@builtin(workgroup_id) workgroup_id : vec3<u32>, @builtin(local_invocation_id) local_id : vec3<u32>) {
+  let batch = workgroup_id.z;
+  let row = workgroup_id.y * TILE_SIZE + local_id.y;
+  let col = workgroup_id.x * TILE_SIZE + local_id.x;
+  let aOffset = ${params.aBatchOffset};
+  let bOffset = ${params.bBatchOffset};
+
+  var value = 0.0;
+  for (var t = 0u; t < ${K}u; t = t + TILE_SIZE) {
+    let aCol = t + local_id.x;
+    var aValue = 0.0;
+    if (row < ${M}u && aCol < ${K}u) {
+      aValue = ${params.inputNames[0]}[aOffset + ${aIndex}];
+    }
+    tileA[local_id.y][local_id.x] = aValue;
+
+    let bRow = t + local_id.y;
+    var bValue = 0.0;
+    if (bRow < ${K}u && col < ${N}u) {
+      bValue = ${params.inputNames[1]}[bOffset + ${bIndex}];
+    }
+    tileB[local_id.y][local_id.x] = bValue;
+    workgroupBarrier();
+
+    for (var k = 0u; k < TILE_SIZE; k = k + 1u) {
+      value = value + tileA[local_id.y][k] * tileB[k][local_id.x];
+    }
+    workgroupBarrier();
+  }
+
+  if (row < ${M}u && col < ${N}u) {
+    ${params.epilogue ?? ''}
+    output[(batch * ${M}u + row) * ${N}u + col] = value;
+  }
+}`;
+};
+
+export const getMatMulDispatchGroup = (m: number, n: number, batchSize: number): DispatchGroup =>
+    ({x: Math.ceil(n / TILE_SIZE), y: Math.ceil(m / TILE_SIZE), z: batchSize});
+
+export const matMul: OperatorImplementation<Graph.Node> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+      validateInputs(inputs);
+      return inferenceHandler.run(createMatMulProgramInfoLoader(inputs), inputs);
+    };
+
+const createMatMulProgramInfoLoader = (inputs: readonly Tensor[]): ProgramInfoLoader =>
+    ({name: 'MatMul', inputCount: 2, get: () => createMatMulProgramInfo(inputs)});
+
+const createMatMulProgramInfo = (inputs: readonly Tensor[]): ProgramInfo => {
+  const [aDims, bDims] = MatMulUtil.preprocessInputShapes(inputs[0].dims, inputs[1].dims);
+  const outputShape = BroadcastUtil.calcShape(aDims, bDims, true);
+  if (!outputShape) {
+    throw new Error('Can\'t use matmul on the given tensors');
+  }
+  const M = aDims[aDims.length - 2];
+  const K = aDims[aDims.length - 1];
+  const N = bDims[bDims.length - 1];
+
+  // the batch dims of A and B broadcast to the batch dims of the output
+  const batchDims = outputShape.slice(0, -2);
+  const aBatchOffset = getBroadcastOffset('batch', batchDims, aDims.slice(0, -2));
+  const bBatchOffset = getBroadcastOffset('batch', batchDims, bDims.slice(0, -2));
+  const shaderSource = createMatMulShaderSource({
+    inputNames: ['a', 'b'],
+    m: M,
+    n: N,
+    k: K,
+    transA: false,
+    transB: false,
+    aBatchOffset: `${aBatchOffset} * ${M * K}u`,
+    bBatchOffset: `${bBatchOffset} * ${K * N}u`
+  });
+
+  const outputDims = outputShape.slice();
+  MatMulUtil.postprocessOutputShape(outputDims, inputs[0].dims.length, inputs[1].dims.length);
+  return {
+    name: 'MatMul',
+    inputCount: 2,
+    outputs: [{dims: outputDims, type: inputs[0].type}],
+    shaderSource,
+    dispatchGroup: getMatMulDispatchGroup(M, N, ShapeUtil.size(batchDims))
+  };
+};
+
+const validateInputs = (inputs: Tensor[]): void => {
+  if (!inputs || inputs.length !== 2) {
+    throw new Error('MatMul requires 2 inputs.');
+  }
+
+  if (inputs[0].dims[inputs[0].dims.length - 1] !== inputs[1].dims[inputs[1].dims.length - 2] &&
+      inputs[1].dims.length !== 1) {
+    throw new Error('shared dimension does not match.');
+  }
+
+  validateFloatInputs('MatMul', inputs);
+};
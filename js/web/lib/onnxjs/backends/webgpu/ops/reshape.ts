@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Graph} from '../../../graph';
+import {OperatorImplementation, OperatorInitialization} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+
+// The operators in this file only change the dims of their input, and share its data. Their shape inputs have to be on
+// the CPU, like the initializers of a model.
+
+export const reshape = (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+  if (!inputs || inputs.length !== 2) {
+    throw new Error('Reshape requires 2 inputs.');
+  }
+  const reshapedDims = ShapeUtil.calculateReshapedDims(inputs[0].dims, inputs[1].integerData);
+  return [inferenceHandler.reshape(inputs[0], reshapedDims)];
+};
+
+export const flatten: OperatorImplementation<number> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[], axis: number): Tensor[] => {
+      if (!inputs || inputs.length !== 1) {
+        throw new Error('Flatten requires 1 input.');
+      }
+      const r = inputs[0].dims.length;
+      if (r === 0) {
+        throw new Error('scalar tensor is not supported.');
+      }
+      if (axis < -r || axis > r) {
+        throw new Error('Invalid axis');
+      }
+      return [inferenceHandler.reshape(inputs[0], ShapeUtil.flattenShape(inputs[0].dims, axis))];
+    };
+
+export const parseFlattenAttributes: OperatorInitialization<number> = (node: Graph.Node): number =>
+    node.attributes.getInt('axis', 1);  // default axis is 1
+
+export const squeeze: OperatorImplementation<number[]> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[], axes: number[]): Tensor[] =>
+        [inferenceHandler.reshape(inputs[0], ShapeUtil.squeezeShape(inputs[0].dims, axes))];
+
+export const squeezeV13 = (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    squeeze(inferenceHandler, [inputs[0]], inputs.length > 1 ? Array.from(inputs[1].integerData) : []);
+
+export const unsqueeze: OperatorImplementation<number[]> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[], axes: number[]): Tensor[] =>
+        [inferenceHandler.reshape(inputs[0], ShapeUtil.unsqueezeShape(inputs[0].dims, axes))];
+
+export const unsqueezeV13 = (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    unsqueeze(inferenceHandler, [inputs[0]], Array.from(inputs[1].integerData));
+
+export const parseAxesAttributes: OperatorInitialization<number[]> = (node: Graph.Node): number[] =>
+    node.attributes.getInts('axes', []);
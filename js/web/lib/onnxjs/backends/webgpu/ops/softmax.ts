@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {OperatorImplementation, OperatorInitialization} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramInfoLoader} from '../types';
+
+import {declareBindings, getDispatchGroup, getWorkgroupIndex, getWorkgroupReduction, validateFloatInputs, WORKGROUP_SIZE} from './common';
+
+export interface SoftmaxAttributes extends AttributeWithCacheKey {
+  readonly axis: number;
+  // since opset 13, softmax is computed along the axis only, instead of the dims from the axis on
+  readonly isV13: boolean;
+}
+
+export const softmax: OperatorImplementation<SoftmaxAttributes> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[], attributes: SoftmaxAttributes): Tensor[] => {
+      validateInputs(inputs);
+      return inferenceHandler.run(createSoftmaxProgramInfoLoader(inputs[0], attributes), inputs);
+    };
+
+export const parseSoftmaxAttributes: OperatorInitialization<SoftmaxAttributes> =
+    (node: Graph.Node): SoftmaxAttributes =>
+        createAttributeWithCacheKey({axis: node.attributes.getInt('axis', 1), isV13: false});
+
+export const parseSoftmaxAttributesV13: OperatorInitialization<SoftmaxAttributes> =
+    (node: Graph.Node): SoftmaxAttributes =>
+        createAttributeWithCacheKey({axis: node.attributes.getInt('axis', -1), isV13: true});
+
+/**
+ * Each workgroup normalizes a row: the elements along the softmax dims of a given index of the other dims. Its
+ * invocations reduce the maximum, then the sum of the exponentials, over strided elements of the row.
+ */
+const createSoftmaxProgramInfoLoader = (input: Tensor, attributes: SoftmaxAttributes): ProgramInfoLoader => ({
+  name: 'Softmax',
+  inputCount: 1,
+  cacheHint: attributes.cacheKey,
+  get: (): ProgramInfo => {
+    const dims = input.dims;
+    const axis = ShapeUtil.normalizeAxis(attributes.axis, dims.length);
+    // the elements of a row are `rowSize` elements `stride` apart
+    const rowSize = attributes.isV13 ? dims[axis] : ShapeUtil.sizeFromDimension(dims, axis);
+    const stride = attributes.isV13 ? ShapeUtil.sizeFromDimension(dims, axis + 1) : 1;
+    const rowCount = ShapeUtil.size(dims) / rowSize;
+
+    const shaderSource = `
+${declareBindings(['input'], ['output'])}
+
+var<workgroup> workgroupData : array<f32, ${WORKGROUP_SIZE}>;
+
+@compute @workgroup_size(${WORKGROUP_SIZE})
+fn main(@builtin(workgroup_id) workgroup_id : vec3<u32>, @builtin(local_invocation_index) local_index : u32) {
+  // the invocations of the workgroups past the last row compute the last row again, without writing it
+  let row = min(${getWorkgroupIndex()}, ${Math.max(rowCount - 1, 0)}u);
+  let rowOffset = (row / ${stride}u) * ${rowSize * stride}u + row % ${stride}u;
+
+  var localMax = -3.402823e+38;
+  for (var i = local_index; i < ${rowSize}u; i = i + ${WORKGROUP_SIZE}u) {
+    localMax = max(localMax, input[rowOffset + i * ${stride}u]);
+  }
+  ${getWorkgroupReduction('localMax', 'rowMax', (a, b) => `max(${a}, ${b})`)}
+
+  var localSum = 0.0;
+  for (var i = local_index; i < ${rowSize}u; i = i + ${WORKGROUP_SIZE}u) {
+    localSum = localSum + exp(input[rowOffset + i * ${stride}u] - rowMax);
+  }
+  ${getWorkgroupReduction('localSum', 'rowSum', (a, b) => `${a} + ${b}`)}
+
+  if (${getWorkgroupIndex()} < ${rowCount}u) {
+    for (var i = local_index; i < ${rowSize}u; i = i + ${WORKGROUP_SIZE}u) {
+      let offset = rowOffset + i * ${stride}u;
+      output[offset] = exp(input[offset] - rowMax) / rowSum;
+    }
+  }
+}`;
+    return {
+      name: 'Softmax',
+      inputCount: 1,
+      cacheHint: attributes.cacheKey,
+      outputs: [{dims, type: input.type}],
+      shaderSource,
+      dispatchGroup: getDispatchGroup(rowCount)
+    };
+  }
+});
+
+const validateInputs = (inputs: Tensor[]): void => {
+  if (!inputs || inputs.length !== 1) {
+    throw new Error('Softmax requires 1 input.');
+  }
+
+  validateFloatInputs('Softmax', inputs);
+};
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {OperatorImplementation, OperatorInitialization} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {MAX_CLIP, MIN_CLIP, ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramInfoLoader} from '../types';
+
+import {declareBindings, getElementwiseDispatchGroup, getElementwiseIndex, toWgslFloat, validateFloatInputs, WORKGROUP_SIZE} from './common';
+
+/**
+ * a function that returns the WGSL expression of the operation on the f32 expression of an input element
+ */
+type ElementwiseExpression = (x: string) => string;
+
+const createElementwiseProgramInfoLoader =
+    (input: Tensor, name: string, expression: ElementwiseExpression, cacheHint?: string): ProgramInfoLoader => ({
+      name,
+      inputCount: 1,
+      cacheHint,
+      get: (): ProgramInfo => {
+        const size = ShapeUtil.size(input.dims);
+        const shaderSource = `
+${declareBindings(['input'], ['output'])}
+
+@compute @workgroup_size(${WORKGROUP_SIZE})
+fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
+  ${getElementwiseIndex(size)}
+  let x = input[index];
+  output[index] = ${expression('x')};
+}`;
+        return {
+          name,
+          inputCount: 1,
+          cacheHint,
+          outputs: [{dims: input.dims, type: input.type}],
+          shaderSource,
+          dispatchGroup: getElementwiseDispatchGroup(size)
+        };
+      }
+    });
+
+const elementwise = (name: string, expression: ElementwiseExpression): OperatorImplementation<Graph.Node> =>
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+      validateFloatInputs(name, inputs.slice(0, 1));
+      return inferenceHandler.run(createElementwiseProgramInfoLoader(inputs[0], name, expression), inputs);
+    };
+
+export const abs = elementwise('Abs', x => `abs(${x})`);
+export const ceil = elementwise('Ceil', x => `ceil(${x})`);
+export const cos = elementwise('Cos', x => `cos(${x})`);
+export const exp = elementwise('Exp', x => `exp(${x})`);
+export const floor = elementwise('Floor', x => `floor(${x})`);
+export const log = elementwise('Log', x => `log(${x})`);
+export const neg = elementwise('Neg', x => `-${x}`);
+export const relu = elementwise('Relu', x => `max(${x}, 0.0)`);
+export const sigmoid = elementwise('Sigmoid', x => `1.0 / (1.0 + exp(-${x}))`);
+export const sin = elementwise('Sin', x => `sin(${x})`);
+export const sqrt = elementwise('Sqrt', x => `sqrt(${x})`);
+// tanh() of some implementations returns NaN once exp() of the argument overflows
+export const tanh = elementwise('Tanh', x => `tanh(clamp(${x}, -10.0, 10.0))`);
+
+export const identity = (_inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => [inputs[0]];
+
+export interface ClipAttributes extends AttributeWithCacheKey {
+  readonly min: number;
+  readonly max: number;
+}
+
+export const clip: OperatorImplementation<ClipAttributes> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[], attributes: ClipAttributes): Tensor[] => {
+      validateFloatInputs('Clip', inputs.slice(0, 1));
+      return inferenceHandler.run(
+          createElementwiseProgramInfoLoader(
+              inputs[0], 'Clip', x => `clamp(${x}, ${toWgslFloat(attributes.min)}, ${toWgslFloat(attributes.max)})`,
+              attributes.cacheKey),
+          inputs);
+    };
+
+export const parseClipAttributes: OperatorInitialization<ClipAttributes> = (node: Graph.Node): ClipAttributes =>
+    createAttributeWithCacheKey(
+        {min: node.attributes.getFloat('min', MIN_CLIP), max: node.attributes.getFloat('max', MAX_CLIP)});
+
+// min and max are inputs since opset 11, and they have to be on the CPU
+export const clipV11 = (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+  const attributes = createAttributeWithCacheKey({
+    min: inputs.length >= 2 && inputs[1] ? inputs[1].floatData[0] : MIN_CLIP,
+    max: inputs.length >= 3 && inputs[2] ? inputs[2].floatData[0] : MAX_CLIP
+  });
+  return clip(inferenceHandler, [inputs[0]], attributes);
+};
+
+export interface LeakyReluAttributes extends AttributeWithCacheKey {
+  readonly alpha: number;
+}
+
+export const leakyRelu: OperatorImplementation<LeakyReluAttributes> =
+    (inferenceHandler: WebGpuInferenceHandler, inputs: Tensor[], attributes: LeakyReluAttributes): Tensor[] => {
+      validateFloatInputs('LeakyRelu', inputs);
+      return inferenceHandler.run(
+          createElementwiseProgramInfoLoader(
+              inputs[0], 'LeakyRelu', x => `select(${toWgslFloat(attributes.alpha)} * ${x}, ${x}, ${x} >= 0.0)`,
+              attributes.cacheKey),
+          inputs);
+    };
+
+export const parseLeakyReluAttributes: OperatorInitialization<LeakyReluAttributes> =
+    (node: Graph.Node): LeakyReluAttributes =>
+        createAttributeWithCacheKey({alpha: node.attributes.getFloat('alpha', 0.01)});
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Logger, Profiler} from '../../instrument';
+import {WebGpuBackend} from '../backend-webgpu';
+
+import {Artifact, GpuData, ProgramInfo} from './types';
+
+/**
+ * ProgramManager compiles the WGSL shaders of ProgramInfo's into compute pipelines (cached as Artifacts), and records
+ * the dispatches of the pipelines with their inputs and outputs bound.
+ */
+export class ProgramManager {
+  repo: Map<unknown, Artifact>;
+
+  constructor(private backend: WebGpuBackend, public profiler: Readonly<Profiler>) {
+    this.repo = new Map();
+  }
+  getArtifact(key: unknown): Artifact|undefined {
+    return this.repo.get(key);
+  }
+  setArtifact(key: unknown, artifact: Artifact): void {
+    this.repo.set(key, artifact);
+  }
+  run(buildArtifact: Artifact, inputs: readonly GpuData[], outputs: readonly GpuData[]): void {
+    this.profiler.event('op', `ProgramManager.run ${buildArtifact.programInfo.name}`, () => {
+      const device = this.backend.device;
+      // bound sizes are multiples of 4 bytes, the size of the WGSL scalar types
+      const entries = [...inputs, ...outputs].map((data, i) => {
+        const size = Math.max(Math.ceil(data.size / 4), 1) * 4;
+        return {binding: i, resource: {buffer: data.buffer, size}};
+      });
+      const bindGroup = device.createBindGroup({layout: buildArtifact.computePipeline.getBindGroupLayout(0), entries});
+
+      const {x, y, z} = buildArtifact.programInfo.dispatchGroup;
+      const computePassEncoder = this.backend.getComputePassEncoder();
+      computePassEncoder.setPipeline(buildArtifact.computePipeline);
+      computePassEncoder.setBindGroup(0, bindGroup);
+      computePassEncoder.dispatchWorkgroups(x, y ?? 1, z ?? 1);
+      this.backend.onDispatch();
+    });
+  }
+  build(programInfo: ProgramInfo): Artifact {
+    return this.profiler.event('backend', 'ProgramManager.build', () => {
+      Logger.verbose('ProgramManager', `Compiling the shader of ${programInfo.name}:\n${programInfo.shaderSource}`);
+      const shaderModule = this.backend.device.createShaderModule({code: programInfo.shaderSource});
+      const computePipeline = this.backend.device.createComputePipeline(
+          {layout: 'auto', compute: {module: shaderModule, entryPoint: 'main'}});
+      return {programInfo, computePipeline};
+    });
+  }
+}
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {SessionHandler} from '../../backend';
+import {Graph} from '../../graph';
+import {Operator} from '../../operators';
+import {OpSet, resolveOperator} from '../../opset';
+import {Session} from '../../session';
+import {Tensor} from '../../tensor';
+import {WebGpuBackend} from '../backend-webgpu';
+
+import {WebGpuInferenceHandler} from './inference-handler';
+import {WEBGPU_OP_RESOLVE_RULES} from './op-resolve-rules';
+import {ProgramManager} from './program-manager';
+
+export class WebGpuSessionHandler implements SessionHandler {
+  programManager: ProgramManager;
+  initializers: Set<Tensor.Id>;
+  // the outputs of the last run, kept on the GPU
+  retainedOutputs: Tensor.Id[];
+
+  constructor(public readonly backend: WebGpuBackend, public readonly context: Session.Context) {
+    this.programManager = new ProgramManager(backend, this.context.profiler);
+    this.initializers = new Set();
+    this.retainedOutputs = [];
+  }
+
+  createInferenceHandler() {
+    return new WebGpuInferenceHandler(this);
+  }
+  onGraphInitialized(graph: Graph): void {
+    const initializers = graph.getValues().filter(v => v.from === -1 && v.tensor).map(v => v.tensor!.dataId);
+    this.initializers = new Set(initializers);
+  }
+  isInitializer(tensorId: Tensor.Id): boolean {
+    return this.initializers.has(tensorId);
+  }
+  retainOutputs(tensorIds: Tensor.Id[]): void {
+    this.retainedOutputs.forEach(id => this.backend.gpuDataManager.release(id));
+    this.retainedOutputs = tensorIds;
+  }
+  dispose(): void {
+    this.initializers.forEach(id => this.backend.gpuDataManager.release(id));
+    this.retainOutputs([]);
+  }
+  resolve(node: Graph.Node, opsets: readonly OpSet[], graph: Graph): Operator {
+    const op = resolveOperator(node, opsets, WEBGPU_OP_RESOLVE_RULES);
+    return {impl: op.opImpl, context: op.opInit ? op.opInit(node, graph) : node};
+  }
+}
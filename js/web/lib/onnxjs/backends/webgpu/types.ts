@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Tensor} from '../../tensor';
+
+/**
+ * GpuData is the storage buffer that holds the data of a tensor on the GPU
+ */
+export interface GpuData {
+  /**
+   * the ID of the tensor whose data is in the buffer
+   */
+  id: Tensor.Id;
+  buffer: GPUBuffer;
+  /**
+   * the size of the tensor data in bytes. the buffer may be larger.
+   */
+  size: number;
+}
+
+export interface TensorInfo {
+  dims: readonly number[];
+  type: Tensor.DataType;
+}
+
+/**
+ * the number of workgroups to dispatch on each dimension
+ */
+export interface DispatchGroup {
+  x: number;
+  y?: number;
+  z?: number;
+}
+
+export interface ProgramMetadata {
+  /**
+   * the name of the program. used for debugging and profiling
+   */
+  name: string;
+  /**
+   * the number of inputs bound to the program, in the order of binding
+   */
+  inputCount: number;
+  /**
+   * a string to distinguish programs of the same name built from different attributes
+   */
+  cacheHint?: string;
+}
+
+/**
+ * ProgramInfo is the WGSL compute shader of a program, and the outputs it writes.
+ *
+ * The shader declares the inputs as read-only storage buffers at bindings 0 to inputCount - 1 of group 0, and the
+ * outputs as read-write storage buffers at the following bindings. Its entry point is `main`.
+ */
+export interface ProgramInfo extends ProgramMetadata {
+  outputs: readonly TensorInfo[];
+  shaderSource: string;
+  dispatchGroup: DispatchGroup;
+}
+
+export interface ProgramInfoLoader extends ProgramMetadata {
+  get(): ProgramInfo;
+}
+
+export interface Artifact {
+  programInfo: ProgramInfo;
+  computePipeline: GPUComputePipeline;
+}
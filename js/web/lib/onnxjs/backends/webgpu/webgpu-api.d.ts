@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+/* eslint-disable @typescript-eslint/naming-convention */
+
+/**
+ * Declarations of the subset of the WebGPU API used by the WebGPU backend.
+ *
+ * The DOM library of the TypeScript version in use does not include WebGPU yet.
+ * See https://www.w3.org/TR/webgpu/ for the complete API.
+ */
+
+interface GPU {
+  requestAdapter(options?: {powerPreference?: 'low-power'|'high-performance'}): Promise<GPUAdapter|null>;
+}
+
+interface GPUSupportedLimits {
+  readonly maxBufferSize: number;
+  readonly maxStorageBufferBindingSize: number;
+  readonly maxStorageBuffersPerShaderStage: number;
+  readonly maxComputeWorkgroupsPerDimension: number;
+}
+
+interface GPUAdapter {
+  readonly limits: GPUSupportedLimits;
+  requestDevice(descriptor?: {requiredLimits?: Record<string, number>}): Promise<GPUDevice>;
+}
+
+interface GPUDeviceLostInfo {
+  readonly message: string;
+}
+
+interface GPUDevice {
+  readonly limits: GPUSupportedLimits;
+  readonly queue: GPUQueue;
+  readonly lost: Promise<GPUDeviceLostInfo>;
+  createBuffer(descriptor: {size: number; usage: number; mappedAtCreation?: boolean}): GPUBuffer;
+  createShaderModule(descriptor: {code: string}): GPUShaderModule;
+  createComputePipeline(descriptor: {layout: 'auto'; compute: {module: GPUShaderModule; entryPoint: string}}):
+      GPUComputePipeline;
+  createBindGroup(descriptor: {
+    layout: GPUBindGroupLayout;
+    entries: Array<{binding: number; resource: {buffer: GPUBuffer; offset?: number; size?: number}}>;
+  }): GPUBindGroup;
+  createCommandEncoder(): GPUCommandEncoder;
+  destroy(): void;
+}
+
+interface GPUBuffer {
+  readonly size: number;
+  mapAsync(mode: number, offset?: number, size?: number): Promise<void>;
+  getMappedRange(offset?: number, size?: number): ArrayBuffer;
+  unmap(): void;
+  destroy(): void;
+}
+
+interface GPUQueue {
+  submit(commandBuffers: GPUCommandBuffer[]): void;
+  writeBuffer(buffer: GPUBuffer, bufferOffset: number, data: ArrayBufferView, dataOffset?: number, size?: number):
+      void;
+  onSubmittedWorkDone(): Promise<void>;
+}
+
+interface GPUCommandEncoder {
+  beginComputePass(): GPUComputePassEncoder;
+  copyBufferToBuffer(
+      source: GPUBuffer, sourceOffset: number, destination: GPUBuffer, destinationOffset: number, size: number): void;
+  finish(): GPUCommandBuffer;
+}
+
+interface GPUComputePassEncoder {
+  setPipeline(pipeline: GPUComputePipeline): void;
+  setBindGroup(index: number, bindGroup: GPUBindGroup): void;
+  dispatchWorkgroups(x: number, y?: number, z?: number): void;
+  end(): void;
+}
+
+interface GPUComputePipeline {
+  getBindGroupLayout(index: number): GPUBindGroupLayout;
+}
+
+// opaque handles
+interface GPUShaderModule {
+  readonly __brand: 'GPUShaderModule';
+}
+interface GPUBindGroupLayout {
+  readonly __brand: 'GPUBindGroupLayout';
+}
+interface GPUBindGroup {
+  readonly __brand: 'GPUBindGroup';
+}
+interface GPUCommandBuffer {
+  readonly __brand: 'GPUCommandBuffer';
+}
+
+declare const GPUBufferUsage: {
+  readonly MAP_READ: number;
+  readonly MAP_WRITE: number;
+  readonly COPY_SRC: number;
+  readonly COPY_DST: number;
+  readonly STORAGE: number;
+};
+
+declare const GPUMapMode: {
+  readonly READ: number;
+  readonly WRITE: number;
+};
+
+interface Navigator {
+  readonly gpu?: GPU;
+}
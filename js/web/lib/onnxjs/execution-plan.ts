@@ -140,14 +140,13 @@ export class ExecutionPlan {
         if (outputTensor === undefined) {
           throw new Error(`required output [${outputIndex}] does not have value`);
         }
-        if (outputIndex === 0) {
-          await outputTensor.getData();
-        } else {
-          // eslint-disable-next-line no-unused-expressions
-          outputTensor.data;
-        }
         output.push(outputTensor);
       }
+      // a backend may only be able to read its outputs asynchronously, so read all of them before the run ends
+      await Promise.all(output.map(outputTensor => outputTensor.getData()));
+      if (inferenceHandler.retain) {
+        inferenceHandler.retain(output);
+      }
       Logger.verbose('ExecPlan', 'disposing of inferenceHandler');
       inferenceHandler.dispose();
       return output;
@@ -6,13 +6,22 @@ import {InferenceSession, SessionHandler, Tensor} from 'onnxruntime-common';
 import {Session} from './session';
 import {Tensor as OnnxjsTensor} from './tensor';
 
+/**
+ * the onnxjs tensors of the outputs returned by the sessions. When such an output is fed to a session, its onnxjs
+ * tensor is reused, so that a backend which keeps the data of the outputs on the device (see InferenceHandler.retain)
+ * binds it without uploading it again. The data of those outputs must not be modified before they are fed.
+ */
+const boundOutputs = new WeakMap<Tensor, OnnxjsTensor>();
+
 export class OnnxjsSessionHandler implements SessionHandler {
   constructor(private session: Session) {
     this.inputNames = this.session.inputNames;
     this.outputNames = this.session.outputNames;
   }
 
-  async dispose(): Promise<void> {}
+  async dispose(): Promise<void> {
+    this.session.dispose();
+  }
   inputNames: readonly string[];
   outputNames: readonly string[];
   async run(
@@ -24,15 +33,17 @@ export class OnnxjsSessionHandler implements SessionHandler {
         const feed = feeds[name];
         inputMap.set(
             name,
-            new OnnxjsTensor(
-                feed.dims, feed.type as OnnxjsTensor.DataType, undefined, undefined,
-                feed.data as OnnxjsTensor.NumberType));
+            boundOutputs.get(feed) ??
+                new OnnxjsTensor(
+                    feed.dims, feed.type as OnnxjsTensor.DataType, undefined, undefined,
+                    feed.data as OnnxjsTensor.NumberType));
       }
     }
     const outputMap = await this.session.run(inputMap);
     const output: SessionHandler.ReturnType = {};
     outputMap.forEach((tensor, name) => {
       output[name] = new Tensor(tensor.type, tensor.data, tensor.dims);
+      boundOutputs.set(output[name], tensor);
     });
     return output;
   }
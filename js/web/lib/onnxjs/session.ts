@@ -120,6 +120,16 @@ export class Session {
     });
   }
 
+  /**
+   * release the resources the backend holds for this session, e.g. its initializers and the outputs kept on the device
+   */
+  dispose(): void {
+    if (this._initialized) {
+      this.sessionHandler.dispose();
+      this._initialized = false;
+    }
+  }
+
   private normalizeAndValidateInputs(inputs: Map<string, Tensor>|Tensor[]): Tensor[] {
     const modelInputNames = this._model.graph.getInputNames();
 
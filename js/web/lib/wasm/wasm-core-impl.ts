@@ -265,6 +265,10 @@ export const run =
               }
               wasm.HEAPU32[dataIndex++] = allocWasmString(data[i], inputAllocs);
             }
+          } else if (data.buffer === wasm.HEAPU8.buffer) {
+            // the data is already a view into the WebAssembly heap, e.g. filled in place by the caller. use it as is
+            dataByteLength = data.byteLength;
+            dataOffset = data.byteOffset;
           } else {
             dataByteLength = data.byteLength;
             dataOffset = wasm._malloc(dataByteLength);
@@ -409,7 +413,9 @@ export const extractTransferableBuffers = (tensors: readonly SerializableTensor[
   const buffers: ArrayBufferLike[] = [];
   for (const tensor of tensors) {
     const data = tensor[2];
-    if (!Array.isArray(data) && data.buffer) {
+    // a SharedArrayBuffer (e.g. the heap of the multi-threaded WebAssembly) is shared already and can't be transferred
+    if (!Array.isArray(data) && data.buffer &&
+        !(typeof SharedArrayBuffer !== 'undefined' && data.buffer instanceof SharedArrayBuffer)) {
       buffers.push(data.buffer);
     }
   }
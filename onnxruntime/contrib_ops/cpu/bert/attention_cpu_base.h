@@ -35,18 +35,34 @@ class AttentionCPUBase : public AttentionBase {
                         int v_head_size,             // head_size
                         int v_hidden_size,           // hidden_size
                         const Tensor* extra_add_qk,  // extra add in QK. Its size is BxNxSxS
-                        OpKernelContext* context) const {
+                        OpKernelContext* context,
+                        const Tensor* past_seq_len = nullptr) const {  // valid length of past when sharing buffer
     AllocatorPtr allocator;
     ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
     auto* tp = context->GetOperatorThreadPool();
 
     int past_sequence_length = 0;
-    Tensor* present = GetPresent(context, past, batch_size, v_head_size, sequence_length, past_sequence_length);
+    Tensor* present = GetPresent(context, past, batch_size, v_head_size, sequence_length, past_sequence_length,
+                                 past_seq_len);
 
     // Total sequence length including that of past state: S* = S' + S
     const int all_sequence_length = past_sequence_length + sequence_length;
 
+    // Sequence length of the buffers of past and present. When they share a buffer of the max sequence length M,
+    // the key and value of the current tokens are appended in place after the S' valid positions of past.
+    const int max_sequence_length = past_present_share_buffer_ ? static_cast<int>(past->Shape()[3])
+                                                               : all_sequence_length;
+
+    // For long sequences, compute the attention in tiles without storing the attention probs.
+    const bool has_matching_head_sizes = (qk_head_size == 0 || qk_head_size == v_head_size);
+    if (sequence_length >= kFlashAttentionMinimumSequenceLength && !past_present_share_buffer_ &&
+        (past == nullptr || present != nullptr) && (present == nullptr || has_matching_head_sizes)) {
+      return ApplyFlashAttention<T>(Q, K, V, mask_index, past, present, output, batch_size, sequence_length,
+                                    past_sequence_length, qk_head_size == 0 ? v_head_size : qk_head_size,
+                                    v_head_size, extra_add_qk, allocator, tp);
+    }
+
     // Compute the attention score. It does 2 things:
     //         I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
     //                                           1 x mask_data(B, N, S, S*)
@@ -57,8 +73,9 @@ class AttentionCPUBase : public AttentionBase {
 
     bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
 
+    // The unidirectional mask is applied with the softmax, so mask data is only needed for the mask index.
     void* mask_data = nullptr;
-    if (mask_index != nullptr || has_unidirectional) {
+    if (mask_index != nullptr) {
       size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * all_sequence_length * sizeof(T);
       mask_data = allocator->Alloc(mask_data_bytes);
       memset(mask_data, 0, mask_data_bytes);
@@ -77,7 +94,8 @@ class AttentionCPUBase : public AttentionBase {
 
     ComputeAttentionProbs<T>(static_cast<T*>(attention_probs), Q, K,
                              mask_index_data, mask_index_dims, static_cast<T*>(mask_data), has_unidirectional,
-                             batch_size, sequence_length, past_sequence_length, qk_head_size == 0 ? v_head_size : qk_head_size,
+                             batch_size, sequence_length, past_sequence_length, max_sequence_length,
+                             qk_head_size == 0 ? v_head_size : qk_head_size,
                              past_data, present_data, tp, extra_add_qk_data);
 
     // Compute the attentionScore * Value. It does: out_tmp(B, N, S, H) = attention_probs(B, N, S, S*) x V(B, N, S*, H)
@@ -86,13 +104,104 @@ class AttentionCPUBase : public AttentionBase {
     BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
 
     ComputeVxAttentionScore(output->template MutableData<T>(), static_cast<T*>(out_tmp_data), static_cast<T*>(attention_probs), V,
-                            batch_size, sequence_length, past_sequence_length, v_head_size, v_hidden_size,
-                            past_data, present_data, tp);
+                            batch_size, sequence_length, past_sequence_length, max_sequence_length,
+                            v_head_size, v_hidden_size, past_data, present_data, tp);
 
     return Status::OK();
   }
 
  private:
+  // The minimum sequence length of the queries for which the attention is computed in tiles by
+  // ApplyFlashAttention. Shorter sequences use the attention probs, which are small enough to stay in cache.
+  static constexpr int kFlashAttentionMinimumSequenceLength = 512;
+
+  template <typename T>
+  Status ApplyFlashAttention(const T* Q,                  // Q data. Its size is BxNxSxH
+                             const T* K,                  // K data. Its size is BxNxSxH
+                             const T* V,                  // V value with size BxNxSxH
+                             const Tensor* mask_index,    // mask index. nullptr if no mask or its size is B
+                             const Tensor* past,          // past state
+                             Tensor* present,             // present state
+                             Tensor* output,              // output tensor
+                             int batch_size,              // batch size
+                             int sequence_length,         // sequence length
+                             int past_sequence_length,    // sequence length of past state
+                             int qk_head_size,            // head size of Q and K
+                             int v_head_size,             // head size of V
+                             const Tensor* extra_add_qk,  // extra add in QK. Its size is BxNxSxS*
+                             AllocatorPtr allocator,
+                             ThreadPool* tp) const {
+    const int all_sequence_length = past_sequence_length + sequence_length;  // S* = S' + S
+    const int loop_len = batch_size * num_heads_;
+
+    const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
+    T* present_data = present != nullptr ? present->template MutableData<T>() : nullptr;
+
+    // Concatenate the past and current K and V into the present state: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
+    const T* k = K;
+    const T* v = V;
+    if (present_data != nullptr) {
+      const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * v_head_size;
+      const size_t present_chunk_length = static_cast<size_t>(all_sequence_length) * v_head_size;
+      const size_t input_chunk_length = static_cast<size_t>(sequence_length) * v_head_size;
+      const T* past_v = past_data != nullptr ? past_data + loop_len * past_chunk_length : nullptr;
+      T* present_v = present_data + loop_len * present_chunk_length;
+
+      ThreadPool::TryParallelFor(tp, loop_len, static_cast<double>(present_chunk_length) * 2,
+                                 [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                                   for (std::ptrdiff_t i = begin; i != end; ++i) {
+                                     ConcatStateChunk(past_data, K + input_chunk_length * i, present_data,
+                                                      past_chunk_length, present_chunk_length, i);
+                                     ConcatStateChunk(past_v, V + input_chunk_length * i, present_v,
+                                                      past_chunk_length, present_chunk_length, i);
+                                   }
+                                 });
+
+      k = present_data;
+      v = present_v;
+    }
+
+    // A 3D mask has a row per query. Other masks only depend on the key position, so a single row per
+    // batch is prepared and broadcast to the queries: (Bx)S* -> (Bx)SxS*.
+    const bool has_3d_mask = mask_index != nullptr && mask_index->Shape().NumDimensions() == 3;
+    const int mask_sequence_length = has_3d_mask ? sequence_length : 1;
+
+    void* mask_data = nullptr;
+    if (mask_index != nullptr) {
+      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * mask_sequence_length * all_sequence_length * sizeof(T);
+      mask_data = allocator->Alloc(mask_data_bytes);
+      memset(mask_data, 0, mask_data_bytes);
+      PrepareMask(mask_index->template Data<int32_t>(), mask_index->Shape().GetDims(), static_cast<T*>(mask_data),
+                  false, batch_size, mask_sequence_length, all_sequence_length - mask_sequence_length);
+    }
+    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
+
+    MLAS_FLASH_ATTENTION_PARAMS params;
+    params.BatchCount = static_cast<size_t>(batch_size);
+    params.HeadCount = static_cast<size_t>(num_heads_);
+    params.SequenceLength = static_cast<size_t>(sequence_length);
+    params.KvSequenceLength = static_cast<size_t>(all_sequence_length);
+    params.QkHeadSize = static_cast<size_t>(qk_head_size);
+    params.VHeadSize = static_cast<size_t>(v_head_size);
+    params.Scale = 1.0f / sqrt(static_cast<float>(qk_head_size));
+    params.Query = Q;
+    params.Key = k;
+    params.Value = v;
+    params.Mask = static_cast<const T*>(mask_data);
+    params.MaskBatchStride = static_cast<size_t>(mask_sequence_length) * all_sequence_length;
+    params.MaskRowStride = has_3d_mask ? static_cast<size_t>(all_sequence_length) : 0;
+    params.ExtraAdd = extra_add_qk != nullptr ? extra_add_qk->template Data<T>() : nullptr;
+    params.Causal = is_unidirectional_ && sequence_length > 1;
+    params.Output = output->template MutableData<T>();
+
+    auto working_data = allocator->Alloc(SafeInt<size_t>(MlasFlashAttentionWorkingBufferSize(&params, tp)) * sizeof(T));
+    BufferUniquePtr working_buffer(working_data, BufferDeleter(allocator));
+
+    MlasFlashAttention(&params, static_cast<T*>(working_data), tp);
+
+    return Status::OK();
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
   //                                    1 x mask_data(B, N, S, S*)
@@ -103,11 +212,12 @@ class AttentionCPUBase : public AttentionBase {
                              const T* K,                                   // k data. Its size is BxNxSxH
                              const int32_t* mask_index,                    // mask index. nullptr if no mask or its size is B
                              gsl::span<const int64_t> mask_index_dims,     // mask index shape
-                             T* mask_data,                                 // buffer for mask data. It is nullptr if mask_index is nullptr and not unidirectional, otherwise its shape is BxSxS*
+                             T* mask_data,                                 // buffer for mask data. It is nullptr if mask_index is nullptr, otherwise its shape is BxSxS*
                              bool has_unidirectional,                      // has unidirectional mask
                              int batch_size,                               // batch size of self-attention
                              int sequence_length,                          // sequence length of self-attention
                              int past_sequence_length,                     // sequence length of past state
+                             int max_sequence_length,                      // sequence length of the past and present buffers
                              int head_size,                                // head size of self-attention
                              const T* past,                                // past state
                              T* present,                                   // present state
@@ -117,20 +227,18 @@ class AttentionCPUBase : public AttentionBase {
     const int all_sequence_length = past_sequence_length + sequence_length;                  // S* = S' + S
     const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;  // S' x H
     const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;      // S x H
-    const size_t present_chunk_length = past_chunk_length + input_chunk_length;              // S* x H
+    const size_t present_chunk_length = static_cast<size_t>(max_sequence_length) * head_size;  // S* x H, or M x H
 
     {
       if (mask_data != nullptr) {
-        PrepareMask(mask_index, mask_index_dims, mask_data, has_unidirectional, batch_size, sequence_length, past_sequence_length);
-      } else {  // no any mask
-        memset(attention_probs, 0, static_cast<size_t>(batch_size) * num_heads_ * sequence_length * all_sequence_length * sizeof(T));
+        PrepareMask(mask_index, mask_index_dims, mask_data, false, batch_size, sequence_length, past_sequence_length);
       }
 
       const int loop_len = batch_size * num_heads_;
       const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
 
-      // The cost of Gemm
-      const double cost = static_cast<double>(head_size) * sequence_length * all_sequence_length;
+      // The cost of Gemm and Softmax
+      const double cost = static_cast<double>(head_size + 2) * sequence_length * all_sequence_length;
 
       ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
         for (std::ptrdiff_t i = begin; i != end; ++i) {
@@ -140,51 +248,40 @@ class AttentionCPUBase : public AttentionBase {
           const int mask_offset = batch_index * sequence_length * all_sequence_length;
           T* output = attention_probs + output_offset;
 
-          // Broadcast mask data: (Bx)SxS* -> (BxNx)SxS*
-          if (mask_data != nullptr) {
-            memcpy(output, mask_data + mask_offset, sequence_length * all_sequence_length * sizeof(T));
-          }
-
           const T* k = K + input_chunk_length * i;
           if (nullptr != present) {
-            // Concatenate past_K and K : (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
-            k = ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
+            if (past_present_share_buffer_) {
+              // Append K to the valid part of past_K in place: (BxNx)MxH
+              k = AppendStateChunk(past, k, present, past_chunk_length, input_chunk_length, present_chunk_length, i);
+            } else {
+              // Concatenate past_K and K : (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
+              k = ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
+            }
           }
 
-          // Compute Q*K' + AttentionMask
+          // Compute Q*K'
           //                     original                 transposed             each iteration
           // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
           // B: K'               (B x N x) S* x H         (B x N x) H x S*       H x S*
           // C: attention_probs  (B x N x) S x S*         (B x N x) S x S*       S x S*
-          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, all_sequence_length, head_size, alpha,
-                                    Q + input_chunk_length * i, k, 1.0,
+          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, all_sequence_length, head_size, 1.0,
+                                    Q + input_chunk_length * i, k, 0.0,
                                     output, nullptr);
 
-          // Fix unidirectional mask to be parity with huggingface implementation.
-          if (has_unidirectional && mask_data != nullptr) {
-            for (int s_i = 0; s_i < sequence_length - 1; s_i++) {
-              for (int m_i = past_sequence_length + s_i + 1; m_i < all_sequence_length; m_i++) {
-                int j = s_i * all_sequence_length + m_i;
-                output[j] = mask_data[mask_offset + j];
-              }
-            }
-          }
-
-          if (extra_add_qk_data != nullptr) {
-            for (int j = 0; j < sequence_length * all_sequence_length; j++) {
-              output[j] += extra_add_qk_data[output_offset + j];
-            }
-          }
+          // Scale, mask and normalize the scores of this head while they are still in the cache:
+          //   attention_probs = Softmax(1/sqrt(H) x Q*K' + mask_data + extra_add_qk)
+          // The mask data is broadcast from (Bx)SxS* -> (BxNx)SxS*. For parity with huggingface, the
+          // unidirectional mask replaces the scores of the future positions instead of adding to them.
+          MLAS_ATTENTION_SOFTMAX_PARAMS softmax_params;
+          softmax_params.Scale = alpha;
+          softmax_params.Mask = mask_data != nullptr ? mask_data + mask_offset : nullptr;
+          softmax_params.ExtraAdd = extra_add_qk_data != nullptr ? extra_add_qk_data + output_offset : nullptr;
+          softmax_params.Causal = has_unidirectional;
+          softmax_params.CausalOffset = static_cast<size_t>(past_sequence_length);
+          MlasComputeAttentionSoftmax(output, output, sequence_length, all_sequence_length, &softmax_params);
         }
       });
     }
-
-    //  attention_probs(B, N, S, S*) = Softmax(attention_probs)
-    {
-      const int N = batch_size * num_heads_ * sequence_length;
-      const int D = all_sequence_length;
-      ComputeAttentionSoftmaxInplace(attention_probs, N, D, tp);
-    }
   }
 
   template <typename T>
@@ -195,6 +292,7 @@ class AttentionCPUBase : public AttentionBase {
                                int batch_size,            // batch size
                                int sequence_length,       // sequence length
                                int past_sequence_length,  // sequence length in past state
+                               int max_sequence_length,   // sequence length of the past and present buffers
                                int head_size,             // head size
                                int hidden_size,           // hidden size
                                const T* past,             // past state
@@ -203,14 +301,14 @@ class AttentionCPUBase : public AttentionBase {
     const int all_sequence_length = past_sequence_length + sequence_length;                  // S* = S' + S
     const size_t past_chunk_length = static_cast<size_t>(past_sequence_length * head_size);  // S' x H
     const size_t input_chunk_length = static_cast<size_t>(sequence_length * head_size);      // S x H
-    const size_t present_chunk_length = past_chunk_length + input_chunk_length;              // S* x H
+    const size_t present_chunk_length = static_cast<size_t>(max_sequence_length * head_size);  // S* x H, or M x H
 
     // Move the pointer of past and present to start of v values.
     if (nullptr != past) {
-      past += batch_size * num_heads_ * past_sequence_length * head_size;
+      past += batch_size * num_heads_ * (past_present_share_buffer_ ? max_sequence_length : past_sequence_length) * head_size;
     }
     if (nullptr != present) {
-      present += batch_size * num_heads_ * all_sequence_length * head_size;
+      present += batch_size * num_heads_ * max_sequence_length * head_size;
     }
 
     const double cost =
@@ -220,8 +318,13 @@ class AttentionCPUBase : public AttentionBase {
       for (std::ptrdiff_t i = begin; i != end; ++i) {
         const T* v = V + input_chunk_length * i;
         if (nullptr != present) {
-          // concatenate past_V and V: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
-          v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
+          if (past_present_share_buffer_) {
+            // Append V to the valid part of past_V in place: (BxNx)MxH
+            v = AppendStateChunk(past, v, present, past_chunk_length, input_chunk_length, present_chunk_length, i);
+          } else {
+            // concatenate past_V and V: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
+            v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
+          }
         }
 
         T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + input_chunk_length * i;
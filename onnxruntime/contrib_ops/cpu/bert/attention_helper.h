@@ -164,5 +164,23 @@ T* ConcatStateChunk(const T* past, const T* chunk, T* present, size_t past_chunk
   return start;
 }
 
+// Append an input state chunk SxH after the S'xH valid part of a present state chunk with capacity MxH, where
+// past and present share the layout (and usually the buffer) of max sequence length M.
+// Returns a pointer to the start of present state chunk.
+template <typename T>
+T* AppendStateChunk(const T* past, const T* chunk, T* present, size_t past_chunk_length, size_t input_chunk_length,
+                    size_t max_chunk_length, std::ptrdiff_t i) {
+  T* start = present + i * max_chunk_length;
+
+  // The past state is only copied when it is not already in the present buffer, like when the output
+  // is not bound to the buffer of past. Then present is a full copy of past with the input chunk appended.
+  if (nullptr != past && past != present) {
+    memcpy(start, past + i * max_chunk_length, max_chunk_length * sizeof(T));
+  }
+
+  memcpy(start + past_chunk_length, chunk, input_chunk_length * sizeof(T));
+  return start;
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
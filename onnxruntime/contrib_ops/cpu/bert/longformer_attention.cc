@@ -0,0 +1,296 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bert/longformer_attention.h"
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    LongformerAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("G", DataTypeImpl::GetTensorType<int32_t>()),
+    LongformerAttention<float>);
+
+namespace {
+
+// Compute Q, K and V of all heads: qkv(3, B, N, S, H) = input(B, S, D) x weights(D, 3 x N x H) + bias(3 x N x H)
+void ComputeQkv(const float* input, const float* weights, const float* bias, float* qkv,
+                int batch_size, int sequence_length, int hidden_size, int num_heads, ThreadPool* tp) {
+  const int head_size = hidden_size / num_heads;
+  const int loop_len = 3 * batch_size * num_heads;
+  const double cost = static_cast<double>(sequence_length) * head_size * hidden_size;
+
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int qkv_index = static_cast<int>(i / (batch_size * num_heads));
+      const int batch_index = static_cast<int>((i / num_heads) % batch_size);
+      const int head_index = static_cast<int>(i % num_heads);
+
+      const int column_offset = qkv_index * hidden_size + head_index * head_size;
+      float* dest = qkv + static_cast<size_t>(i) * sequence_length * head_size;
+
+      // broadcast NH -> (S.H) for the head
+      for (int s = 0; s < sequence_length; s++) {
+        memcpy(dest + s * head_size, bias + column_offset, head_size * sizeof(float));
+      }
+
+      MlasGemm(CblasNoTrans, CblasNoTrans, sequence_length, head_size, hidden_size, 1.0f,
+               input + static_cast<size_t>(batch_index) * sequence_length * hidden_size, hidden_size,
+               weights + column_offset, 3 * hidden_size, 1.0f, dest, head_size, nullptr);
+    }
+  });
+}
+
+// Scratch buffers of a thread for LongformerAttentionHead.
+struct LongformerScratch {
+  std::vector<float> scores;          // W x 3W scores of the window of a chunk of W local rows
+  std::vector<float> global_scores;   // W x G scores of a chunk of W local rows for the global tokens
+  std::vector<float> row;             // the compacted scores of one row
+  std::vector<float> global_k;        // G x H local K of the global tokens
+  std::vector<float> global_v;        // G x H local V of the global tokens
+  std::vector<float> global_q;        // G x H global Q of the global tokens
+  std::vector<float> global_probs;    // G x S probs of the global tokens attending every token
+  std::vector<float> global_output;   // G x H output of the global tokens
+};
+
+// Compute the attention of one head. Local tokens attend to the tokens of the sliding window [i - W, i + W] and
+// to the global tokens, with the local projections. Global tokens attend to every token with the global projections.
+// Rows of masked tokens are zero to match huggingface transformers. Only O(S x W + S x G) scores are computed.
+void LongformerAttentionHead(const float* q, const float* k, const float* v,                 // (S, H) local projections
+                             const float* global_q, const float* global_k, const float* global_v,  // (S, H) or nullptr
+                             const float* mask,                                             // (S)
+                             const int* global_attention,                                   // (S)
+                             const int* global_index, int global_count,                     // (G) global token indices
+                             float* output, int ldo,                                        // (S, H) with row stride ldo
+                             int sequence_length, int head_size, int window, float scale,
+                             LongformerScratch& scratch) {
+  const int S = sequence_length;
+  const int H = head_size;
+  const int W = window;
+  const int G = global_count;
+
+  scratch.scores.resize(static_cast<size_t>(W) * 3 * W);
+  scratch.global_scores.resize(static_cast<size_t>(W) * G);
+  scratch.row.resize(static_cast<size_t>(3) * W + G);
+  scratch.global_k.resize(static_cast<size_t>(G) * H);
+  scratch.global_v.resize(static_cast<size_t>(G) * H);
+
+  float* scores = scratch.scores.data();
+  float* global_scores = scratch.global_scores.data();
+  float* row = scratch.row.data();
+
+  // Gather K and V of the global tokens, which every local token attends to.
+  for (int g = 0; g < G; g++) {
+    memcpy(scratch.global_k.data() + g * H, k + global_index[g] * H, H * sizeof(float));
+    memcpy(scratch.global_v.data() + g * H, v + global_index[g] * H, H * sizeof(float));
+  }
+
+  // The window of each chunk of W rows [c x W, (c + 1) x W) is covered by the keys [(c - 1) x W, (c + 2) x W).
+  for (int row_start = 0; row_start < S; row_start += W) {
+    const int row_count = std::min(W, S - row_start);
+    const int key_start = std::max(0, row_start - W);
+    const int key_count = std::min(S, row_start + 2 * W) - key_start;
+
+    MlasGemm(CblasNoTrans, CblasTrans, row_count, key_count, H, scale, q + row_start * H, H,
+             k + key_start * H, H, 0.0f, scores, key_count, nullptr);
+
+    if (G > 0) {
+      MlasGemm(CblasNoTrans, CblasTrans, row_count, G, H, scale, q + row_start * H, H,
+               scratch.global_k.data(), H, 0.0f, global_scores, G, nullptr);
+    }
+
+    for (int r = 0; r < row_count; r++) {
+      const int i = row_start + r;
+      float* probs = scores + r * key_count;
+      float* global_probs = global_scores + r * G;
+
+      // Masked rows are zero. Global rows are computed below.
+      if (mask[i] < 0.0f || global_attention[i] != 0) {
+        std::fill_n(probs, key_count, 0.0f);
+        std::fill_n(global_probs, G, 0.0f);
+        continue;
+      }
+
+      // Compact the scores of the window and of the global tokens outside the window into one row.
+      const int window_start = std::max(0, i - W);
+      const int window_end = std::min(S, i + W + 1);
+      int length = 0;
+      for (int j = window_start; j < window_end; j++) {
+        row[length++] = probs[j - key_start] + mask[j];
+      }
+      for (int g = 0; g < G; g++) {
+        const int j = global_index[g];
+        if (j < window_start || j >= window_end) {
+          row[length++] = global_probs[g] + mask[j];
+        }
+      }
+
+      MlasComputeSoftmax(row, row, 1, length, false, nullptr);
+
+      // Scatter the probs back. The probs outside the window are zero.
+      std::fill_n(probs, key_count, 0.0f);
+      length = 0;
+      for (int j = window_start; j < window_end; j++) {
+        probs[j - key_start] = row[length++];
+      }
+      for (int g = 0; g < G; g++) {
+        const int j = global_index[g];
+        global_probs[g] = (j < window_start || j >= window_end) ? row[length++] : 0.0f;
+      }
+    }
+
+    // output = probs x V + global_probs x global V
+    MlasGemm(CblasNoTrans, CblasNoTrans, row_count, H, key_count, 1.0f, scores, key_count,
+             v + key_start * H, H, 0.0f, output + row_start * ldo, ldo, nullptr);
+
+    if (G > 0) {
+      MlasGemm(CblasNoTrans, CblasNoTrans, row_count, H, G, 1.0f, global_scores, G,
+               scratch.global_v.data(), H, 1.0f, output + row_start * ldo, ldo, nullptr);
+    }
+  }
+
+  if (G == 0) {
+    return;
+  }
+
+  // Global tokens attend to every token: output = Softmax(global Q x global K' + mask) x global V
+  scratch.global_q.resize(static_cast<size_t>(G) * H);
+  scratch.global_probs.resize(static_cast<size_t>(G) * S);
+  scratch.global_output.resize(static_cast<size_t>(G) * H);
+
+  for (int g = 0; g < G; g++) {
+    memcpy(scratch.global_q.data() + g * H, global_q + global_index[g] * H, H * sizeof(float));
+  }
+
+  float* global_probs = scratch.global_probs.data();
+  MlasGemm(CblasNoTrans, CblasTrans, G, S, H, scale, scratch.global_q.data(), H,
+           global_k, H, 0.0f, global_probs, S, nullptr);
+
+  for (int g = 0; g < G; g++) {
+    float* probs = global_probs + g * S;
+    if (mask[global_index[g]] < 0.0f) {
+      std::fill_n(probs, S, 0.0f);
+      continue;
+    }
+
+    for (int j = 0; j < S; j++) {
+      probs[j] += mask[j];
+    }
+    MlasComputeSoftmax(probs, probs, 1, S, false, nullptr);
+  }
+
+  MlasGemm(CblasNoTrans, CblasNoTrans, G, H, S, 1.0f, global_probs, S,
+           global_v, H, 0.0f, scratch.global_output.data(), H, nullptr);
+
+  for (int g = 0; g < G; g++) {
+    memcpy(output + global_index[g] * ldo, scratch.global_output.data() + g * H, H * sizeof(float));
+  }
+}
+
+}  // namespace
+
+template <typename T>
+Status LongformerAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* mask = context->Input<Tensor>(3);
+  const Tensor* global_weights = context->Input<Tensor>(4);
+  const Tensor* global_bias = context->Input<Tensor>(5);
+  const Tensor* global_attention = context->Input<Tensor>(6);
+  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), mask->Shape(),
+                                  global_weights->Shape(), global_bias->Shape(), global_attention->Shape()));
+
+  // Input and output shapes:
+  //   Input 0 - input       : (batch_size, sequence_length, hidden_size)
+  //   Output 0 - output     : (batch_size, sequence_length, hidden_size)
+  const auto& shape = input->Shape();
+  const int batch_size = static_cast<int>(shape[0]);
+  const int sequence_length = static_cast<int>(shape[1]);
+  const int hidden_size = static_cast<int>(shape[2]);
+  const int head_size = hidden_size / num_heads_;
+
+  Tensor* output = context->Output(0, shape);
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto* tp = context->GetOperatorThreadPool();
+
+  // Build the indices of the global tokens of each batch.
+  const int* global_data = global_attention->template Data<int32_t>();
+  std::vector<int> global_index(static_cast<size_t>(batch_size) * sequence_length);
+  std::vector<int> global_count(batch_size, 0);
+  int max_global_count = 0;
+  for (int b = 0; b < batch_size; b++) {
+    for (int s = 0; s < sequence_length; s++) {
+      if (global_data[b * sequence_length + s] != 0) {
+        global_index[b * sequence_length + global_count[b]++] = s;
+      }
+    }
+    max_global_count = std::max(max_global_count, global_count[b]);
+  }
+
+  // Compute Q, K, V with shape (3, B, N, S, H), followed by the global Q, K, V when there are global tokens.
+  const size_t elements = SafeInt<size_t>(batch_size) * sequence_length * hidden_size;
+  const size_t qkv_count = max_global_count > 0 ? 2 : 1;
+  auto qkv_data = allocator->Alloc(SafeInt<size_t>(qkv_count) * 3 * elements * sizeof(T));
+  BufferUniquePtr qkv_buffer(qkv_data, BufferDeleter(allocator));
+
+  T* qkv = static_cast<T*>(qkv_data);
+  T* global_qkv = max_global_count > 0 ? qkv + 3 * elements : nullptr;
+
+  ComputeQkv(input->template Data<T>(), weights->template Data<T>(), bias->template Data<T>(), qkv,
+             batch_size, sequence_length, hidden_size, num_heads_, tp);
+
+  if (global_qkv != nullptr) {
+    ComputeQkv(input->template Data<T>(), global_weights->template Data<T>(), global_bias->template Data<T>(),
+               global_qkv, batch_size, sequence_length, hidden_size, num_heads_, tp);
+  }
+
+  // Compute the attention of each head. The output is (B, S, N, H).
+  const T* mask_data = mask->template Data<T>();
+  T* output_data = output->template MutableData<T>();
+  const float scale = 1.0f / sqrt(static_cast<float>(head_size));
+  const size_t head_elements = static_cast<size_t>(sequence_length) * head_size;
+
+  const int loop_len = batch_size * num_heads_;
+  const double cost = static_cast<double>(sequence_length) * head_size * (3 * window_ + max_global_count) * 2;
+
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    LongformerScratch scratch;
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i) / num_heads_;
+      const int head_index = static_cast<int>(i) % num_heads_;
+      const size_t head_offset = static_cast<size_t>(i) * head_elements;
+
+      LongformerAttentionHead(
+          qkv + head_offset, qkv + elements + head_offset, qkv + 2 * elements + head_offset,
+          global_qkv != nullptr ? global_qkv + head_offset : nullptr,
+          global_qkv != nullptr ? global_qkv + elements + head_offset : nullptr,
+          global_qkv != nullptr ? global_qkv + 2 * elements + head_offset : nullptr,
+          mask_data + batch_index * sequence_length,
+          global_data + batch_index * sequence_length,
+          global_index.data() + batch_index * sequence_length, global_count[batch_index],
+          output_data + static_cast<size_t>(batch_index) * sequence_length * hidden_size + head_index * head_size,
+          hidden_size, sequence_length, head_size, window_, scale, scratch);
+    }
+  });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
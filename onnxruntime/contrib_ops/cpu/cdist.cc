@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "cdist.h"
+
+#include <algorithm>
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math.h"
@@ -17,74 +21,57 @@ namespace contrib {
 DEFINE_KERNEL(float);
 DEFINE_KERNEL(double);
 
+namespace {
+// The distances are computed in kRowBlock x kColBlock tiles. Each tile of -2*A*B^T is finished (norms added and the
+// metric applied) while it is still in cache, the tiles are spread across the thread pool, and the top_k search only
+// ever needs one tile per thread instead of the whole M x K distance matrix.
+constexpr std::ptrdiff_t kRowBlock = 64;
+constexpr std::ptrdiff_t kColBlock = 256;
+}  // namespace
+
 template <typename T>
-static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, concurrency::ThreadPool* threadpool) {
-  // input shapes have already been validated
-  const auto& shape_a = a.Shape().GetDims();  // {m, k}
-  const auto& shape_b = b.Shape().GetDims();  // {n, k}
-  int64_t m = shape_a[0];
-  int64_t n = shape_b[0];
-  int64_t k = shape_a[1];
+static void CalculateSquaredNorms(const T* data, std::ptrdiff_t rows, std::ptrdiff_t k, T* norms,
+                                  concurrency::ThreadPool* threadpool) {
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, rows, TensorOpCost{static_cast<double>(k * sizeof(T)), static_cast<double>(sizeof(T)), 2.0 * k},
+      [data, k, norms](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          norms[i] = ConstEigenVectorMap<T>(data + i * k, k).squaredNorm();
+        }
+      });
+}
 
+// Calculates the distances between rows [row, row + rows) of A and rows [col, col + cols) of B into tile,
+// which is stored row major with a stride of cols.
+template <typename T>
+static void CalculateTile(const T* a_data, const T* b_data, const T* a_ss, const T* b_ss,
+                          std::ptrdiff_t row, std::ptrdiff_t rows, std::ptrdiff_t col, std::ptrdiff_t cols,
+                          std::ptrdiff_t k, bool euclidean, T* tile) {
   // https://github.com/droyed/eucl_dist/wiki/Main-Article
   // dist(Xi,Yj) = sum_k(Xik**2) + sum_k(Yjk**2) - 2*sum_k(Xik*Yjk)
-
-  const auto* a_data = a.Data<T>();
-  const auto* b_data = b.Data<T>();
-  auto* c_data = c.MutableData<T>();
-
-  // ReduceSumSquare for A
-  std::vector<T> a_ss;
-  a_ss.resize(m);
-  const auto* cur_a = a_data;
-  for (int64_t i = 0; i < m; ++i) {
-    a_ss[i] = ConstEigenVectorMap<T>(cur_a, k).squaredNorm();
-    cur_a += k;
-  }
-
-  // ReduceSumSquare for B
-  std::vector<T> b_ss;
-  b_ss.resize(n);
-  const auto* cur_b = b_data;
-  for (int64_t i = 0; i < n; ++i) {
-    b_ss[i] = ConstEigenVectorMap<T>(cur_b, k).squaredNorm();
-    cur_b += k;
-  }
-
+  //
   // NOTE: We want to avoid subtracting two numbers that are very close to each other as that can lead to
   // 'catastrophic cancellation'. (sum_k(Xik**2) + sum_k(Yjk**2)) would be close to 2*sum_k(Xik*Yjk) if the values
   // in Xij and Yjk are very similar, so subtracting can be problematic.
   // Due to that we calculate -2*sum_k(Xik*Yjk) using GEMM, add sum_k(Xik**2) next, and add sum_k(Yjk**2) last.
-
-// use MLAS on 64-bit (no 32-bit dgemm)
-#if defined(_M_AMD64) || defined(__x86_64__)
-  // Use GEMM of A and B^T with -2 as alpha to calculate -2*sum_k(Xik*Yjk)
+  //
+  // The tiles are already distributed across the thread pool so each GEMM is single threaded.
+  concurrency::ThreadPool* no_threadpool = nullptr;
   math::Gemm<T>(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                m, n, k,
-                static_cast<T>(-2.), a_data, b_data, static_cast<T>(0.),
-                c_data,
-                threadpool);
-#else
-  // the performance of this isn't great as the eigen matmul is single threaded by default
-  // if you're on x86 and care about performance try MKL first. if there's a good enough argument for optimising this
-  // we can look into it in the future.
-  ORT_UNUSED_PARAMETER(threadpool);
-
-  // https://eigen.tuxfamily.org/dox/TopicWritingEfficientProductExpression.html
-  auto out_map = EigenMatrixMapRowMajor<T>(c_data, m, n);
-  out_map.noalias() = static_cast<T>(-2.) *
-                      (ConstEigenMatrixMapRowMajor<T>(a_data, m, k) *
-                       ConstEigenMatrixMapRowMajor<T>(b_data, n, k).transpose());
-#endif
-
-  // add a_ss and b_ss, with broadcast
-  // output shape is {m, n}
-  auto* cur_out = c_data;
-  for (int64_t i = 0; i < m; ++i) {
-    T a_val = a_ss[i];
-    for (int64_t j = 0; j < n; ++j) {
-      *cur_out = (*cur_out + a_val) + b_ss[j];
-      ++cur_out;
+                rows, cols, k,
+                static_cast<T>(-2.), a_data + row * k, b_data + col * k, static_cast<T>(0.),
+                tile,
+                no_threadpool);
+
+  // because we use GEMM there's a slight chance a number extremely close to zero could be negative,
+  // so we need to run abs() to avoid NaN's in the results.
+  for (std::ptrdiff_t i = 0; i < rows; ++i) {
+    auto tile_row = EigenVectorArrayMap<T>(tile + i * cols, cols);
+    tile_row = (tile_row + a_ss[row + i]) + ConstEigenVectorArrayMap<T>(b_ss + col, cols);
+    if (euclidean) {
+      tile_row = tile_row.abs().sqrt();  // do both abs and sqrt in one call so Eigen has a chance to combine
+    } else {
+      tile_row = tile_row.abs();
     }
   }
 }
@@ -108,22 +95,114 @@ common::Status CDist<T>::Compute(OpKernelContext* context) const {
   if (shape_a[1] != shape_b[1]) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input shape dimensions mismatch:", shape_a, " and ", shape_b);
   }
+  if (top_k_ == 0 && context->OutputCount() > 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The indices output of CDist requires top_k to be set.");
+  }
 
-  TensorShape output_shape = {shape_a[0], shape_b[0]};
-  Tensor* C = context->Output(0, output_shape);
-  T* output = C->MutableData<T>();
+  const std::ptrdiff_t m = static_cast<std::ptrdiff_t>(shape_a[0]);
+  const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(shape_b[0]);
+  const std::ptrdiff_t k = static_cast<std::ptrdiff_t>(shape_a[1]);
+  const std::ptrdiff_t num_nearest = top_k_ > 0 ? std::min<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(top_k_), n) : n;
 
-  CalculateSqeuclidean<T>(*A, *B, *C, tp);
-  auto map_out = EigenVectorArrayMap<T>(output, output_shape.Size());
+  TensorShape output_shape = {shape_a[0], static_cast<int64_t>(num_nearest)};
+  Tensor* C = context->Output(0, output_shape);
+  Tensor* indices = top_k_ > 0 ? context->Output(1, output_shape) : nullptr;
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
 
-  // because we use GEMM in CalculateSqeuclidean there's a slight chance a number extremely close to zero
-  // could be negative, so we need to run abs() to avoid NaN's in the results.
-  if (mode_ == Mode::EUCLIDEAN) {
-    map_out = map_out.abs().sqrt();  // do both abs and sqrt in one call so Eigen has a chance to combine
-  } else if (mode_ == Mode::SQEUCLIDEAN) {
-    map_out = map_out.abs();
+  const auto* a_data = A->Data<T>();
+  const auto* b_data = B->Data<T>();
+  T* output = C->MutableData<T>();
+  int64_t* indices_data = indices != nullptr ? indices->MutableData<int64_t>() : nullptr;
+  const bool euclidean = mode_ == Mode::EUCLIDEAN;
+
+  std::vector<T> a_ss(m);
+  std::vector<T> b_ss(n);
+  CalculateSquaredNorms(a_data, m, k, a_ss.data(), tp);
+  CalculateSquaredNorms(b_data, n, k, b_ss.data(), tp);
+
+  const std::ptrdiff_t row_blocks = (m + kRowBlock - 1) / kRowBlock;
+  const std::ptrdiff_t col_blocks = (n + kColBlock - 1) / kColBlock;
+
+  if (top_k_ == 0) {
+    // output shape is {m, n}
+    const TensorOpCost cost{static_cast<double>((kRowBlock + kColBlock) * k * sizeof(T)),
+                            static_cast<double>(kRowBlock * kColBlock * sizeof(T)),
+                            2.0 * kRowBlock * kColBlock * k};
+    concurrency::ThreadPool::TryParallelFor(
+        tp, row_blocks * col_blocks, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          std::vector<T> tile(kRowBlock * kColBlock);
+          for (std::ptrdiff_t t = first; t < last; ++t) {
+            const std::ptrdiff_t row = (t / col_blocks) * kRowBlock;
+            const std::ptrdiff_t col = (t % col_blocks) * kColBlock;
+            const std::ptrdiff_t rows = std::min(kRowBlock, m - row);
+            const std::ptrdiff_t cols = std::min(kColBlock, n - col);
+            CalculateTile(a_data, b_data, a_ss.data(), b_ss.data(), row, rows, col, cols, k, euclidean, tile.data());
+            for (std::ptrdiff_t i = 0; i < rows; ++i) {
+              std::copy_n(tile.data() + i * cols, cols, output + (row + i) * n + col);
+            }
+          }
+        });
+    return Status::OK();
   }
 
+  // Keep a bounded max-heap of the num_nearest smallest (distance, index) pairs for each row while streaming the tiles
+  // of that row block. Ties are broken towards the lower index of B.
+  using Candidate = std::pair<T, int64_t>;
+  const TensorOpCost cost{static_cast<double>((kRowBlock + n) * k * sizeof(T)),
+                          static_cast<double>(kRowBlock * num_nearest * (sizeof(T) + sizeof(int64_t))),
+                          2.0 * kRowBlock * n * k};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, row_blocks, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<T> tile(kRowBlock * kColBlock);
+        std::vector<std::vector<Candidate>> heaps(kRowBlock);
+        for (auto& heap : heaps) {
+          heap.reserve(num_nearest);
+        }
+
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const std::ptrdiff_t row = block * kRowBlock;
+          const std::ptrdiff_t rows = std::min(kRowBlock, m - row);
+          for (std::ptrdiff_t i = 0; i < rows; ++i) {
+            heaps[i].clear();
+          }
+
+          for (std::ptrdiff_t col = 0; col < n; col += kColBlock) {
+            const std::ptrdiff_t cols = std::min(kColBlock, n - col);
+            CalculateTile(a_data, b_data, a_ss.data(), b_ss.data(), row, rows, col, cols, k, euclidean, tile.data());
+            for (std::ptrdiff_t i = 0; i < rows; ++i) {
+              auto& heap = heaps[i];
+              const T* distances = tile.data() + i * cols;
+              for (std::ptrdiff_t j = 0; j < cols; ++j) {
+                Candidate candidate{distances[j], static_cast<int64_t>(col + j)};
+                if (static_cast<std::ptrdiff_t>(heap.size()) < num_nearest) {
+                  heap.push_back(candidate);
+                  std::push_heap(heap.begin(), heap.end());
+                } else if (candidate < heap.front()) {
+                  std::pop_heap(heap.begin(), heap.end());
+                  heap.back() = candidate;
+                  std::push_heap(heap.begin(), heap.end());
+                }
+              }
+            }
+          }
+
+          for (std::ptrdiff_t i = 0; i < rows; ++i) {
+            auto& heap = heaps[i];
+            std::sort_heap(heap.begin(), heap.end());
+            T* row_output = output + (row + i) * num_nearest;
+            int64_t* row_indices = indices_data != nullptr ? indices_data + (row + i) * num_nearest : nullptr;
+            for (std::ptrdiff_t j = 0; j < num_nearest; ++j) {
+              row_output[j] = heap[j].first;
+              if (row_indices != nullptr) {
+                row_indices[j] = heap[j].second;
+              }
+            }
+          }
+        }
+      });
+
   return Status::OK();
 }
 
@@ -16,6 +16,8 @@ class CDist final : public OpKernel {
                            concurrency::ThreadPool* tp);
   enum class Mode { EUCLIDEAN,
                     SQEUCLIDEAN } mode_;
+  // when positive, only the top_k_ nearest rows of B are output for each row of A
+  int64_t top_k_;
 
  public:
   CDist(const OpKernelInfo& info) : OpKernel(info) {
@@ -27,6 +29,9 @@ class CDist final : public OpKernel {
       mode_ = Mode::EUCLIDEAN;
     } else
       ORT_NOT_IMPLEMENTED();
+
+    top_k_ = info.GetAttrOrDefault<int64_t>("top_k", 0);
+    ORT_ENFORCE(top_k_ >= 0, "top_k must be non-negative. Got: ", top_k_);
   }
 
   common::Status Compute(OpKernelContext* context) const override;
@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+namespace contrib {
+
+class EmbeddingBag final : public OpKernel {
+ public:
+  enum class Mode {
+    Sum,
+    Mean,
+    Max,
+  };
+
+  EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+    const std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+    if (mode == "sum") {
+      mode_ = Mode::Sum;
+    } else if (mode == "mean") {
+      mode_ = Mode::Mean;
+    } else if (mode == "max") {
+      mode_ = Mode::Max;
+    } else {
+      ORT_THROW("EmbeddingBag mode must be one of sum, mean or max, got ", mode);
+    }
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(OpKernelContext* context, const Tensor* weight, const Tensor* indices,
+                     const Tensor* offsets) const;
+
+  Mode mode_;
+};
+
+namespace {
+
+// The rows of a bag are scattered across the table, so the hardware prefetchers can't anticipate them. Each row is
+// requested this many indices ahead of its use, which keeps a few cache misses in flight while a row is pooled.
+constexpr size_t kPrefetchDistance = 4;
+constexpr size_t kCacheLineSize = 64;
+
+inline void PrefetchRow(const float* row, size_t row_bytes) {
+  const char* p = reinterpret_cast<const char*>(row);
+  for (size_t offset = 0; offset < row_bytes; offset += kCacheLineSize) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p + offset, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(p + offset, _MM_HINT_T0);
+#else
+    ORT_UNUSED_PARAMETER(p);
+#endif
+  }
+}
+
+}  // namespace
+
+template <typename Tind>
+Status EmbeddingBag::ComputeImpl(OpKernelContext* context, const Tensor* weight, const Tensor* indices,
+                                 const Tensor* offsets) const {
+  const int64_t rows = weight->Shape()[0];
+  const size_t row_size = static_cast<size_t>(weight->Shape()[1]);
+
+  const auto num_indices = static_cast<size_t>(indices->Shape().Size());
+  const Tind* indices_data = indices->Data<Tind>();
+
+  // Check the indices first in case there's a out of bound index.
+  for (size_t i = 0; i < num_indices; ++i) {
+    const Tind idx = indices_data[i];
+    if (idx < -rows || idx >= rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -rows, ",", rows - 1, "]");
+    }
+  }
+
+  // the bags are [bag_begin(b), bag_begin(b + 1)) of indices
+  size_t num_bags = 0;
+  size_t bag_size = 0;
+  const Tind* offsets_data = nullptr;
+  if (offsets != nullptr) {
+    num_bags = static_cast<size_t>(offsets->Shape()[0]);
+    offsets_data = offsets->Data<Tind>();
+    for (size_t b = 0; b < num_bags; ++b) {
+      const int64_t begin = static_cast<int64_t>(offsets_data[b]);
+      const int64_t end = b + 1 < num_bags ? static_cast<int64_t>(offsets_data[b + 1])
+                                           : static_cast<int64_t>(num_indices);
+      if (begin < 0 || begin > end || end > static_cast<int64_t>(num_indices)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "offsets must be non-decreasing and within [0, ", num_indices, "], got ", begin,
+                               " at position ", b);
+      }
+    }
+  } else {
+    num_bags = static_cast<size_t>(indices->Shape()[0]);
+    bag_size = static_cast<size_t>(indices->Shape()[1]);
+  }
+
+  const auto bag_begin = [&](size_t b) -> size_t {
+    if (offsets_data == nullptr) {
+      return b * bag_size;
+    }
+    return b < num_bags ? static_cast<size_t>(offsets_data[b]) : num_indices;
+  };
+
+  Tensor* output = context->Output(0, {static_cast<int64_t>(num_bags), static_cast<int64_t>(row_size)});
+  if (num_bags == 0 || row_size == 0) {
+    return Status::OK();
+  }
+
+  const float* weight_data = weight->Data<float>();
+  float* output_data = output->MutableData<float>();
+  const size_t row_bytes = row_size * sizeof(float);
+
+  const auto get_row = [&](size_t i) {
+    int64_t idx = static_cast<int64_t>(indices_data[i]);
+    idx = idx < 0 ? idx + rows : idx;
+    return weight_data + static_cast<size_t>(idx) * row_size;
+  };
+
+  // each index reads a row and accumulates it into the output row of its bag
+  const double average_bag_size = static_cast<double>(num_indices) / static_cast<double>(num_bags);
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_bags),
+      TensorOpCost{average_bag_size * static_cast<double>(row_bytes), static_cast<double>(row_bytes),
+                   average_bag_size * static_cast<double>(row_size)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // the prefetches run across the bags of the range, so the first rows of the next bag are in flight while
+        // the current bag finishes
+        const size_t first_index = bag_begin(static_cast<size_t>(first));
+        const size_t last_index = bag_begin(static_cast<size_t>(last));
+        for (size_t i = first_index; i < std::min(first_index + kPrefetchDistance, last_index); ++i) {
+          PrefetchRow(get_row(i), row_bytes);
+        }
+
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          const size_t begin = bag_begin(static_cast<size_t>(b));
+          const size_t end = bag_begin(static_cast<size_t>(b) + 1);
+          float* output_row = output_data + static_cast<size_t>(b) * row_size;
+
+          if (begin == end) {
+            std::fill_n(output_row, row_size, 0.0f);
+            continue;
+          }
+
+          if (begin + kPrefetchDistance < last_index) {
+            PrefetchRow(get_row(begin + kPrefetchDistance), row_bytes);
+          }
+          std::memcpy(output_row, get_row(begin), row_bytes);
+
+          for (size_t i = begin + 1; i < end; ++i) {
+            if (i + kPrefetchDistance < last_index) {
+              PrefetchRow(get_row(i + kPrefetchDistance), row_bytes);
+            }
+            const float* row = get_row(i);
+            if (mode_ == Mode::Max) {
+              for (size_t j = 0; j < row_size; ++j) {
+                output_row[j] = std::max(output_row[j], row[j]);
+              }
+            } else {
+              for (size_t j = 0; j < row_size; ++j) {
+                output_row[j] += row[j];
+              }
+            }
+          }
+
+          if (mode_ == Mode::Mean) {
+            const float scale = 1.0f / static_cast<float>(end - begin);
+            for (size_t j = 0; j < row_size; ++j) {
+              output_row[j] *= scale;
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+Status EmbeddingBag::Compute(OpKernelContext* ctx) const {
+  const Tensor* weight = ctx->Input<Tensor>(0);
+  const Tensor* indices = ctx->Input<Tensor>(1);
+  const Tensor* offsets = ctx->Input<Tensor>(2);
+
+  ORT_RETURN_IF_NOT(weight->Shape().NumDimensions() == 2,
+                    "Input weight of EmbeddingBag must be a 2-D tensor, got shape ", weight->Shape());
+  if (offsets != nullptr) {
+    ORT_RETURN_IF_NOT(indices->Shape().NumDimensions() == 1,
+                      "Input indices of EmbeddingBag must be a 1-D tensor with offsets, got shape ", indices->Shape());
+    ORT_RETURN_IF_NOT(offsets->Shape().NumDimensions() == 1,
+                      "Input offsets of EmbeddingBag must be a 1-D tensor, got shape ", offsets->Shape());
+  } else {
+    ORT_RETURN_IF_NOT(indices->Shape().NumDimensions() == 2,
+                      "Input indices of EmbeddingBag must be a 2-D tensor without offsets, got shape ",
+                      indices->Shape());
+  }
+
+  return indices->IsDataType<int64_t>() ? ComputeImpl<int64_t>(ctx, weight, indices, offsets)
+                                        : ComputeImpl<int32_t>(ctx, weight, indices, offsets);
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbeddingBag);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,316 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+enum class ElementwiseOp {
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Abs,
+  Erf,
+  Exp,
+  Neg,
+  Reciprocal,
+  Relu,
+  Sigmoid,
+  Sqrt,
+  Tanh,
+};
+
+bool IsBinary(ElementwiseOp op) {
+  return op == ElementwiseOp::Add || op == ElementwiseOp::Sub || op == ElementwiseOp::Mul || op == ElementwiseOp::Div;
+}
+
+ElementwiseOp GetElementwiseOp(const std::string& op_type) {
+  static const InlinedHashMap<std::string, ElementwiseOp> ops = {
+      {"Add", ElementwiseOp::Add},
+      {"Sub", ElementwiseOp::Sub},
+      {"Mul", ElementwiseOp::Mul},
+      {"Div", ElementwiseOp::Div},
+      {"Abs", ElementwiseOp::Abs},
+      {"Erf", ElementwiseOp::Erf},
+      {"Exp", ElementwiseOp::Exp},
+      {"Neg", ElementwiseOp::Neg},
+      {"Reciprocal", ElementwiseOp::Reciprocal},
+      {"Relu", ElementwiseOp::Relu},
+      {"Sigmoid", ElementwiseOp::Sigmoid},
+      {"Sqrt", ElementwiseOp::Sqrt},
+      {"Tanh", ElementwiseOp::Tanh},
+  };
+
+  auto op = ops.find(op_type);
+  ORT_ENFORCE(op != ops.end(), "FusedElementwise does not support operation ", op_type);
+  return op->second;
+}
+
+// The elements of an operand for the current block. A scalar operand has a single element.
+struct Operand {
+  const float* data;
+  bool is_scalar;
+};
+
+template <typename Fn>
+void ComputeBinary(Operand a, Operand b, float* output, size_t count, Fn fn) {
+  if (a.is_scalar && b.is_scalar) {
+    std::fill_n(output, count, fn(*a.data, *b.data));
+  } else if (a.is_scalar) {
+    const float a_value = *a.data;
+    for (size_t i = 0; i < count; i++) {
+      output[i] = fn(a_value, b.data[i]);
+    }
+  } else if (b.is_scalar) {
+    const float b_value = *b.data;
+    for (size_t i = 0; i < count; i++) {
+      output[i] = fn(a.data[i], b_value);
+    }
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      output[i] = fn(a.data[i], b.data[i]);
+    }
+  }
+}
+
+template <typename Fn>
+void ComputeUnary(const float* input, float* output, size_t count, Fn fn) {
+  for (size_t i = 0; i < count; i++) {
+    output[i] = fn(input[i]);
+  }
+}
+
+}  // namespace
+
+/**
+Evaluates a chain of elementwise operations block by block, so that the intermediate values of the chain stay in
+blocks of a few KB in cache rather than being written out as full tensors.
+*/
+class FusedElementwise final : public OpKernel {
+ public:
+  FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+    const auto op_types = info.GetAttrsOrDefault<std::string>("operations");
+    const auto operands = info.GetAttrsOrDefault<int64_t>("operands");
+    const int64_t num_inputs = static_cast<int64_t>(info.GetInputCount());
+    ORT_ENFORCE(!op_types.empty(), "FusedElementwise requires at least one operation.");
+    ORT_ENFORCE(operands.size() == 2 * op_types.size(),
+                "FusedElementwise requires two operands per operation. Got ", operands.size(), " operands for ",
+                op_types.size(), " operations.");
+
+    for (size_t i = 0; i < op_types.size(); i++) {
+      Operation operation{GetElementwiseOp(op_types[i]), operands[2 * i], operands[2 * i + 1]};
+      // an operand refers to an input or to the result of a previous operation
+      const int64_t limit = num_inputs + static_cast<int64_t>(i);
+      ORT_ENFORCE(operation.a >= 0 && operation.a < limit, "Invalid operand ", operation.a, " for operation ", i);
+      if (IsBinary(operation.op)) {
+        ORT_ENFORCE(operation.b >= 0 && operation.b < limit, "Invalid operand ", operation.b, " for operation ", i);
+      }
+
+      operations_.push_back(operation);
+    }
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Operation {
+    ElementwiseOp op;
+    int64_t a;
+    int64_t b;
+  };
+
+  // how an input is read relative to the output
+  enum class InputKind {
+    Full,         // same shape as the output
+    Scalar,       // a single element
+    InnerVector,  // the size of the innermost output dimension, all outer dimensions are 1
+  };
+
+  static constexpr size_t kBlockSize = 1024;
+
+  InlinedVector<Operation> operations_;
+};
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const int num_inputs = context->InputCount();
+
+  // the output shape is the multidirectional broadcast of the input shapes
+  size_t rank = 0;
+  for (int i = 0; i < num_inputs; i++) {
+    rank = std::max(rank, context->Input<Tensor>(i)->Shape().NumDimensions());
+  }
+
+  TensorShapeVector output_dims(rank, 1);
+  for (int i = 0; i < num_inputs; i++) {
+    const auto& shape = context->Input<Tensor>(i)->Shape();
+    const size_t offset = rank - shape.NumDimensions();
+    for (size_t axis = 0; axis < shape.NumDimensions(); axis++) {
+      const int64_t dim = shape[axis];
+      int64_t& output_dim = output_dims[offset + axis];
+      ORT_RETURN_IF_NOT(dim == 1 || output_dim == 1 || dim == output_dim,
+                        "FusedElementwise inputs are not broadcastable: input ", i, " has shape ", shape);
+      if (dim != 1) {
+        output_dim = dim;
+      }
+    }
+  }
+
+  const TensorShape output_shape(output_dims);
+  Tensor* output = context->Output(0, output_shape);
+  const size_t output_size = static_cast<size_t>(output_shape.Size());
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  const size_t inner_size = rank == 0 ? 1 : static_cast<size_t>(output_dims.back());
+  InlinedVector<const float*> input_data;
+  InlinedVector<InputKind> input_kinds;
+  for (int i = 0; i < num_inputs; i++) {
+    const Tensor* input = context->Input<Tensor>(i);
+    const size_t size = static_cast<size_t>(input->Shape().Size());
+    InputKind kind;
+    if (size == output_size) {
+      kind = InputKind::Full;
+    } else if (size == 1) {
+      kind = InputKind::Scalar;
+    } else if (size == inner_size && input->Shape()[input->Shape().NumDimensions() - 1] == static_cast<int64_t>(size)) {
+      kind = InputKind::InnerVector;
+    } else {
+      // produced by ElementwiseFusion only for the broadcasts above
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise does not support broadcasting input ",
+                             i, " with shape ", input->Shape(), " to ", output_shape);
+    }
+
+    input_data.push_back(input->Data<float>());
+    input_kinds.push_back(kind);
+  }
+
+  float* output_data = output->MutableData<float>();
+  const size_t num_operations = operations_.size();
+  const std::ptrdiff_t num_blocks = static_cast<std::ptrdiff_t>((output_size + kBlockSize - 1) / kBlockSize);
+  const double num_elements = static_cast<double>(std::min(output_size, kBlockSize));
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_blocks,
+      TensorOpCost{num_elements * sizeof(float) * num_inputs, num_elements * sizeof(float),
+                   num_elements * num_operations * 4},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // the result of each operation but the last, which is written to the output,
+        // followed by the current block of each inner vector input
+        std::vector<float> buffer((num_operations + num_inputs) * kBlockSize);
+
+        for (std::ptrdiff_t block = first; block < last; block++) {
+          const size_t start = static_cast<size_t>(block) * kBlockSize;
+          const size_t count = std::min(kBlockSize, output_size - start);
+
+          const auto get_operand = [&](int64_t index) -> Operand {
+            if (index >= num_inputs) {
+              return {buffer.data() + (index - num_inputs) * kBlockSize, false};
+            }
+
+            switch (input_kinds[index]) {
+              case InputKind::Full:
+                return {input_data[index] + start, false};
+              case InputKind::Scalar:
+                return {input_data[index], true};
+              default:
+                break;
+            }
+
+            float* vector_block = buffer.data() + (num_operations + index) * kBlockSize;
+            for (size_t i = 0, j = start % inner_size; i < count;) {
+              const size_t n = std::min(count - i, inner_size - j);
+              std::copy_n(input_data[index] + j, n, vector_block + i);
+              i += n;
+              j = 0;
+            }
+
+            return {vector_block, false};
+          };
+
+          for (size_t i = 0; i < num_operations; i++) {
+            const Operation& operation = operations_[i];
+            float* result = i + 1 == num_operations ? output_data + start : buffer.data() + i * kBlockSize;
+            Operand a = get_operand(operation.a);
+
+            if (IsBinary(operation.op)) {
+              Operand b = get_operand(operation.b);
+              switch (operation.op) {
+                case ElementwiseOp::Add:
+                  ComputeBinary(a, b, result, count, [](float x, float y) { return x + y; });
+                  break;
+                case ElementwiseOp::Sub:
+                  ComputeBinary(a, b, result, count, [](float x, float y) { return x - y; });
+                  break;
+                case ElementwiseOp::Mul:
+                  ComputeBinary(a, b, result, count, [](float x, float y) { return x * y; });
+                  break;
+                default:
+                  ComputeBinary(a, b, result, count, [](float x, float y) { return x / y; });
+                  break;
+              }
+
+              continue;
+            }
+
+            if (a.is_scalar) {
+              std::fill_n(result, count, *a.data);
+              a.data = result;
+            }
+
+            switch (operation.op) {
+              case ElementwiseOp::Abs:
+                ComputeUnary(a.data, result, count, [](float x) { return std::abs(x); });
+                break;
+              case ElementwiseOp::Erf:
+                MlasComputeErf(a.data, result, count);
+                break;
+              case ElementwiseOp::Exp:
+                MlasComputeExp(a.data, result, count);
+                break;
+              case ElementwiseOp::Neg:
+                ComputeUnary(a.data, result, count, [](float x) { return -x; });
+                break;
+              case ElementwiseOp::Reciprocal:
+                ComputeUnary(a.data, result, count, [](float x) { return 1.0f / x; });
+                break;
+              case ElementwiseOp::Relu:
+                ComputeUnary(a.data, result, count, [](float x) { return std::max(x, 0.0f); });
+                break;
+              case ElementwiseOp::Sigmoid:
+                MlasComputeLogistic(a.data, result, count);
+                break;
+              case ElementwiseOp::Sqrt:
+                ComputeUnary(a.data, result, count, [](float x) { return std::sqrt(x); });
+                break;
+              default:
+                MlasComputeTanh(a.data, result, count);
+                break;
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    FusedElementwise,
+    1,
+    float,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -9,11 +9,40 @@ namespace contrib {
 constexpr const char* ACTIVATION_NAME_PREFIX = "activation_";
 constexpr size_t ACTIVATION_NAME_PREFIX_LEN = 11;
 
+// Returns the MLAS activation equivalent to the fused activation, which the GEMM
+// kernels apply as the output is written, if there is one.
+static optional<MLAS_ACTIVATION> GetMlasActivation(const OpKernelInfo& info, const std::string& activation) {
+  MLAS_ACTIVATION mlas_activation;
+  if (activation == "Relu") {
+    mlas_activation.ActivationKind = MlasReluActivation;
+  } else if (activation == "Tanh") {
+    mlas_activation.ActivationKind = MlasTanhActivation;
+  } else if (activation == "Sigmoid") {
+    mlas_activation.ActivationKind = MlasLogisticActivation;
+  } else if (activation == "LeakyRelu") {
+    mlas_activation.ActivationKind = MlasLeakyReluActivation;
+    mlas_activation.Parameters.LeakyRelu.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.01f);
+  } else if (activation == "HardSigmoid") {
+    mlas_activation.ActivationKind = MlasHardSigmoidActivation;
+    mlas_activation.Parameters.HardSigmoid.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.2f);
+    mlas_activation.Parameters.HardSigmoid.beta = info.GetAttrOrDefault<float>("activation_beta", 0.5f);
+  } else {
+    return nullopt;
+  }
+  return mlas_activation;
+}
+
 template <typename T>
 class FusedGemm final : public Gemm<T> {
  public:
   FusedGemm(const OpKernelInfo& info) : Gemm<T>(info) {
     std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+    if constexpr (std::is_same<T, float>::value) {
+      this->mlas_activation_ = GetMlasActivation(info, activation);
+      if (this->mlas_activation_.has_value()) {
+        return;
+      }
+    }
     NodeAttributes attrs;
     for (const auto& p : info.node().GetAttributes()) {
       if (p.first.size() > ACTIVATION_NAME_PREFIX_LEN && p.first.compare(0, ACTIVATION_NAME_PREFIX_LEN, ACTIVATION_NAME_PREFIX) == 0) {
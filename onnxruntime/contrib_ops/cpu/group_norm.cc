@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class GroupNorm final : public OpKernel {
+ public:
+  GroupNorm(const OpKernelInfo& info) : OpKernel(info) {
+    epsilon_ = info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+    ORT_ENFORCE(info.GetAttr<int64_t>("groups", &groups_).IsOK());
+    ORT_ENFORCE(groups_ > 0, "GroupNorm groups must be positive, got ", groups_);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float epsilon_;
+  int64_t groups_;
+};
+
+Status GroupNorm::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* gamma = context->Input<Tensor>(1);
+  const Tensor* beta = context->Input<Tensor>(2);
+
+  const auto& x_shape = X->Shape();
+  ORT_RETURN_IF_NOT(x_shape.NumDimensions() >= 3,
+                    "Input X of GroupNorm must have at least 3 dimensions, got shape ", x_shape);
+  const int64_t N = x_shape[0];
+  const int64_t C = x_shape[1];
+  const int64_t spatial_size = x_shape.SizeFromDimension(2);
+  ORT_RETURN_IF_NOT(C % groups_ == 0, "GroupNorm groups ", groups_, " must divide the channel count ", C);
+  ORT_RETURN_IF_NOT(gamma->Shape().NumDimensions() == 1 && gamma->Shape()[0] == C,
+                    "Input gamma of GroupNorm must be a 1-D tensor of size C, got shape ", gamma->Shape());
+  ORT_RETURN_IF_NOT(beta->Shape().NumDimensions() == 1 && beta->Shape()[0] == C,
+                    "Input beta of GroupNorm must be a 1-D tensor of size C, got shape ", beta->Shape());
+
+  Tensor* Y = context->Output(0, x_shape);
+
+  const int64_t channels_per_group = C / groups_;
+  const int64_t group_size = channels_per_group * spatial_size;
+  if (group_size == 0) {
+    return Status::OK();
+  }
+
+  const float* X_data = X->Data<float>();
+  const float* gamma_data = gamma->Data<float>();
+  const float* beta_data = beta->Data<float>();
+  float* Y_data = Y->MutableData<float>();
+
+  // The channels of a group are consecutive in memory, so each group is normalized as one vector. The groups are
+  // independent, each reading its input twice.
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(N * groups_),
+      TensorOpCost{static_cast<double>(group_size * sizeof(float) * 2),
+                   static_cast<double>(group_size * sizeof(float)),
+                   static_cast<double>(group_size * 4)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          ConstEigenVectorArrayMap<float> Xi(X_data + group_size * i, group_size);
+          const float mean = Xi.mean();
+          const float squared_norm = (Xi - mean).matrix().squaredNorm();
+          const float inv_stdev = 1.0f / std::sqrt(squared_norm / group_size + epsilon_);
+
+          const int64_t first_channel = (i % groups_) * channels_per_group;
+          for (int64_t c = 0; c < channels_per_group; ++c) {
+            const int64_t offset = group_size * i + spatial_size * c;
+            ConstEigenVectorArrayMap<float> Xc(X_data + offset, spatial_size);
+            EigenVectorArrayMap<float> Yc(Y_data + offset, spatial_size);
+            const float channel_scale = inv_stdev * gamma_data[first_channel + c];
+            const float channel_shift = beta_data[first_channel + c] - mean * channel_scale;
+            Yc = Xc * channel_scale + channel_shift;
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    GroupNorm,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    GroupNorm);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -29,6 +30,51 @@ namespace contrib {
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
 
+namespace {
+
+template <typename T>
+void ComputeLayerNorm(const T* p_input, const T* scale_data, const T* bias_data, T* p_output, int64_t norm_size,
+                      float epsilon, bool simplified, T* p_mean, T* p_inv_std_dev) {
+  T mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    mean += p_input[h];
+    mean_square += p_input[h] * p_input[h];
+  }
+
+  mean = mean / norm_size;
+  if (simplified) {
+    mean_square = sqrt(mean_square / norm_size + epsilon);
+  } else {
+    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
+  }
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    if (simplified) {
+      p_output[h] = p_input[h] / mean_square * scale_data[h];
+    } else if (nullptr == bias_data) {
+      p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+    } else {
+      p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+    }
+  }
+
+  if (p_mean != nullptr) {
+    *p_mean = mean;
+  }
+  *p_inv_std_dev = 1 / mean_square;
+}
+
+// The statistics and the normalization of a float row are vectorized by MLAS.
+void ComputeLayerNorm(const float* p_input, const float* scale_data, const float* bias_data, float* p_output,
+                      int64_t norm_size, float epsilon, bool simplified, float* p_mean, float* p_inv_std_dev) {
+  MlasLayerNormalization(p_input, nullptr, nullptr, scale_data, bias_data, p_output, static_cast<size_t>(norm_size),
+                         epsilon, simplified, p_mean, p_inv_std_dev);
+}
+
+}  // namespace
+
 template <typename T, bool simplified>
 LayerNorm<T, simplified>::LayerNorm(const OpKernelInfo& op_kernel_info)
     : OpKernel(op_kernel_info) {
@@ -98,38 +144,9 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
       [&](ptrdiff_t task_idx) {
-        const T* p_input = X_data + task_idx * norm_size;
-        T* p_output = Y_data + task_idx * norm_size;
-
-        T mean = 0;
-        T mean_square = 0;
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          mean += p_input[h];
-          mean_square += p_input[h] * p_input[h];
-        }
-
-        mean = mean / norm_size;
-        if (simplified) {
-          mean_square = sqrt(mean_square / norm_size + epsilon_);
-        } else {
-          mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
-        }
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          if (simplified) {
-            p_output[h] = p_input[h] / mean_square * scale_data[h];
-          } else if (nullptr == bias) {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
-          } else {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
-          }
-        }
-
-        if (mean_data != nullptr) {
-          mean_data[task_idx] = mean;
-        }
-        inv_std_dev_data[task_idx] = 1 / mean_square;
+        ComputeLayerNorm(X_data + task_idx * norm_size, scale_data, bias_data, Y_data + task_idx * norm_size,
+                         norm_size, epsilon_, simplified, mean_data == nullptr ? nullptr : mean_data + task_idx,
+                         inv_std_dev_data + task_idx);
       },
       0);
 
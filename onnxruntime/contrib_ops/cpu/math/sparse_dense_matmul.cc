@@ -4,6 +4,7 @@
 #if !defined(DISABLE_SPARSE_TENSORS)
 
 #include "core/framework/sparse_tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/util/math.h"
@@ -44,6 +45,8 @@ struct ComputeCtx {
   bool trans_A;
   bool trans_B;
   float alpha;
+  AllocatorPtr allocator;
+  concurrency::ThreadPool* thread_pool;
 };
 
 #if !defined(__i386__) && !defined(_M_IX86) && !defined(__wasm__) && !defined(__ANDROID__)
@@ -96,6 +99,44 @@ struct SparseToDenseCsr {
   }
 };
 
+// The float CSR row major A is handled by the multithreaded MLAS kernel, the transposed A stays on Eigen.
+template <>
+struct SparseToDenseCsr<float> {
+  void operator()(const ComputeCtx& ctx, const SparseTensor& A, const Tensor& B, Tensor& output) const {
+    const auto& a_dims = A.DenseShape().GetDims();
+    const auto& b_dims = B.Shape().GetDims();
+    const auto& out_dims = output.Shape().GetDims();
+    auto csr_view = A.AsCsr();
+
+    if (ctx.trans_A) {
+      ConstSparseMatrixMap<float> map_A(a_dims[0], a_dims[1], A.NumValues(),
+                                        csr_view.Outer().Data<int64_t>(),
+                                        csr_view.Inner().Data<int64_t>(),
+                                        A.Values().Data<float>());
+      ConstEigenMatrixMapRowMajor<float> map_B(B.Data<float>(), b_dims[0], b_dims[1]);
+      EigenMatrixMapRowMajor<float> output_map(output.MutableData<float>(), out_dims[0], out_dims[1]);
+      SparseDenseMatMulImpl(ctx, map_A, map_B, output_map);
+      return;
+    }
+
+    const size_t M = static_cast<size_t>(out_dims[0]);
+    const size_t N = static_cast<size_t>(out_dims[1]);
+
+    // The kernel gathers rows of B, so a transposed B is materialized as K x N.
+    const float* b_data = B.Data<float>();
+    IAllocatorUniquePtr<float> b_transposed;
+    if (ctx.trans_B) {
+      b_transposed = IAllocator::MakeUniquePtr<float>(ctx.allocator, static_cast<size_t>(B.Shape().Size()));
+      MlasTranspose(b_data, b_transposed.get(), static_cast<size_t>(b_dims[0]), static_cast<size_t>(b_dims[1]));
+      b_data = b_transposed.get();
+    }
+
+    MlasSparseGemm(M, N, ctx.alpha, A.Values().Data<float>(),
+                   csr_view.Outer().Data<int64_t>(), csr_view.Inner().Data<int64_t>(),
+                   b_data, N, output.MutableData<float>(), N, ctx.thread_pool);
+  }
+};
+
 #endif  //!defined(__i386__) && !defined(_M_IX86) && !defined(__wasm__) && !defined(__ANDROID__)
 
 template<typename T> inline
@@ -179,7 +220,10 @@ Status SparseToDenseMatMul::Compute(OpKernelContext* ctx) const {
   utils::MLTypeCallDispatcher<float, double, int32_t, uint32_t, int64_t, uint64_t> t_disp(A->GetElementType());
   // I am not expecting to do the below in every kernel but this is a reference
   // implementation to show the expectations.
-  ComputeCtx compute_ctx{trans_a_attr_ != 0, trans_b_attr_ != 0, alpha_attr_};
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+  ComputeCtx compute_ctx{trans_a_attr_ != 0, trans_b_attr_ != 0, alpha_attr_, allocator,
+                         ctx->GetOperatorThreadPool()};
   if (A->Format() == SparseFormat::kCoo) {
     auto coo_view = A->AsCoo();
     const auto num_dims = coo_view.Indices().Shape().NumDimensions();
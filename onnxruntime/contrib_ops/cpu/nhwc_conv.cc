@@ -0,0 +1,358 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/util/math.h"
+#include "contrib_ops/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Channels last (NHWC) float convolution, which NhwcTransformer substitutes for Conv and FusedConv in the regions of
+// a graph that are already channels last, e.g. models exported from TensorFlow. The filter stays in the Conv layout.
+//
+// The output pixels are computed in tiles. An indirection buffer of the tile points at the input pixel of each
+// kernel position, or at a vector of zeros for the padding. A depthwise convolution reads the input through it
+// directly. Other convolutions gather the pixels of each group into a tile sized im2col buffer for a SGEMM with
+// the prepacked filter, except the pointwise ones, which read the input in place. The bias and the fused activation
+// are applied by the SGEMM epilogue.
+class NhwcConv final : public OpKernel {
+ public:
+  explicit NhwcConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Number of input values gathered for a tile of output pixels, which keeps the im2col tile in the L2 cache.
+  static constexpr int64_t kTileInputValues = 64 * 1024;
+
+  bool IsDepthwise(const TensorShape& W_shape) const {
+    return W_shape[1] == 1 && W_shape[0] == conv_attrs_.group;
+  }
+
+  // Returns the size of the packed filter, which is a [kernel_size][channels] filter for a depthwise convolution,
+  // and otherwise the SGEMM packed [kernel_size * group_input_channels][group_output_channels] B matrix of each
+  // group. The sizes of the packed B matrices are returned in group_packed_size.
+  size_t PackedFilterSize(const TensorShape& W_shape, size_t& group_packed_size) const;
+
+  // Packs the filter into a buffer of PackedFilterSize bytes.
+  void PackFilter(const float* W, const TensorShape& W_shape, void* packed_W) const;
+
+  ConvAttributes conv_attrs_;
+  MLAS_ACTIVATION activation_;
+
+  BufferUniquePtr packed_W_buffer_;
+  TensorShape W_shape_;
+};
+
+size_t NhwcConv::PackedFilterSize(const TensorShape& W_shape, size_t& group_packed_size) const {
+  const size_t kernel_size = static_cast<size_t>(W_shape.SizeFromDimension(2));
+  if (IsDepthwise(W_shape)) {
+    group_packed_size = 0;
+    return SafeInt<size_t>(sizeof(float)) * kernel_size * static_cast<size_t>(W_shape[0]);
+  }
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t group_output_channels = static_cast<size_t>(W_shape[0]) / group_count;
+  const size_t kernel_dim = static_cast<size_t>(W_shape[1]) * kernel_size;
+  group_packed_size = MlasGemmPackBSize(group_output_channels, kernel_dim);
+  return SafeInt<size_t>(group_packed_size) * group_count;
+}
+
+void NhwcConv::PackFilter(const float* W, const TensorShape& W_shape, void* packed_W) const {
+  const size_t output_channels = static_cast<size_t>(W_shape[0]);
+  const size_t group_input_channels = static_cast<size_t>(W_shape[1]);
+  const size_t kernel_size = static_cast<size_t>(W_shape.SizeFromDimension(2));
+
+  if (IsDepthwise(W_shape)) {
+    // [channels][1][kernel_size] to [kernel_size][channels]
+    MlasTranspose(W, static_cast<float*>(packed_W), output_channels, kernel_size);
+    return;
+  }
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t group_output_channels = output_channels / group_count;
+  const size_t kernel_dim = group_input_channels * kernel_size;
+
+  size_t group_packed_size;
+  PackedFilterSize(W_shape, group_packed_size);
+
+  // The rows of the B matrix follow the NHWC im2col order: kernel position, then input channel.
+  std::vector<float> group_B(kernel_dim * group_output_channels);
+  for (size_t group_id = 0; group_id < group_count; group_id++) {
+    const float* group_W = W + group_id * group_output_channels * kernel_dim;
+    for (size_t m = 0; m < group_output_channels; m++) {
+      for (size_t ci = 0; ci < group_input_channels; ci++) {
+        for (size_t k = 0; k < kernel_size; k++) {
+          group_B[(k * group_input_channels + ci) * group_output_channels + m] =
+              group_W[(m * group_input_channels + ci) * kernel_size + k];
+        }
+      }
+    }
+    MlasGemmPackB(CblasNoTrans, group_output_channels, kernel_dim, group_B.data(), group_output_channels,
+                  static_cast<uint8_t*>(packed_W) + group_id * group_packed_size);
+  }
+}
+
+Status NhwcConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                         /*out*/ bool& is_packed,
+                         /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack the filter
+  if (input_idx != 1 || tensor.Shape().NumDimensions() < 3) {
+    return Status::OK();
+  }
+
+  const TensorShape& W_shape = tensor.Shape();
+  if (W_shape[0] % conv_attrs_.group != 0) {
+    // left for Compute to report
+    return Status::OK();
+  }
+
+  size_t group_packed_size;
+  const size_t packed_W_size = PackedFilterSize(W_shape, group_packed_size);
+  if (packed_W_size == 0) {
+    return Status::OK();
+  }
+
+  auto* packed_W = alloc->Alloc(packed_W_size);
+  // Initialize the padding of the packed buffer, so that identical filters share the same prepacked buffer.
+  memset(packed_W, 0, packed_W_size);
+  packed_W_buffer_ = BufferUniquePtr(packed_W, BufferDeleter(alloc));
+  PackFilter(tensor.Data<float>(), W_shape, packed_W);
+  W_shape_ = W_shape;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+    prepacked_weights->buffer_sizes_.push_back(packed_W_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status NhwcConv::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                           int input_idx,
+                                           /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status NhwcConv::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = packed_W_buffer_ ? nullptr : context->Input<Tensor>(1);
+  const Tensor* B = context->Input<Tensor>(2);
+  const TensorShape& W_shape = W != nullptr ? W->Shape() : W_shape_;
+
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape, /*channels_last*/ true));
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+
+  const size_t kernel_rank = kernel_shape.size();
+
+  ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_rank * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1 + kernel_rank];
+  const int64_t M = W_shape[0];
+
+  TensorShapeVector Y_dims({N});
+  TensorShape input_shape = X->Shape().Slice(1, 1 + kernel_rank);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(1, 1 + kernel_rank);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  const bool is_depthwise = IsDepthwise(W_shape);
+  const int64_t group_count = is_depthwise ? 1 : conv_attrs_.group;
+  const int64_t group_input_channels = W_shape[1];
+  const int64_t group_output_channels = M / conv_attrs_.group;
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+  const bool is_pointwise = !is_depthwise && kernel_size == 1 && conv_attrs_.HasStridesOneAndNoPadding();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // Handle the case of a dynamic filter.
+  size_t group_packed_size;
+  const size_t packed_W_size = PackedFilterSize(W_shape, group_packed_size);
+  const void* packed_W = packed_W_buffer_.get();
+  BufferUniquePtr dynamic_packed_W_buffer;
+  if (W != nullptr) {
+    auto* dynamic_packed_W = alloc->Alloc(packed_W_size);
+    dynamic_packed_W_buffer = BufferUniquePtr(dynamic_packed_W, BufferDeleter(alloc));
+    PackFilter(W->Data<float>(), W_shape, dynamic_packed_W);
+    packed_W = dynamic_packed_W;
+  }
+
+  const auto* Xdata = X->Data<float>();
+  const auto* Bdata = B != nullptr ? B->Data<float>() : nullptr;
+  auto* Ydata = Y->MutableData<float>();
+
+  const MLAS_ACTIVATION* activation =
+      activation_.ActivationKind == MlasIdentityActivation ? nullptr : &activation_;
+
+  // The padding vector of the indirection buffer.
+  std::vector<float> padding_data(static_cast<size_t>(C), 0.0f);
+
+  const int64_t output_tile_size =
+      std::min(output_image_size, std::max<int64_t>(8, kTileInputValues / std::max<int64_t>(C * kernel_size, 1)));
+  const int64_t tiles_per_image = (output_image_size + output_tile_size - 1) / output_tile_size;
+
+  auto conv_tiles = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    std::vector<const float*> indirection_buffer;
+    std::vector<float> col_buffer;
+    if (!is_pointwise) {
+      indirection_buffer.resize(static_cast<size_t>(output_tile_size * kernel_size));
+      if (!is_depthwise) {
+        col_buffer.resize(static_cast<size_t>(output_tile_size * kernel_dim * group_count));
+      }
+    }
+
+    for (std::ptrdiff_t tile = first; tile < last; tile++) {
+      const int64_t image_id = tile / tiles_per_image;
+      const int64_t output_start = (tile % tiles_per_image) * output_tile_size;
+      const int64_t output_count = std::min(output_tile_size, output_image_size - output_start);
+
+      const float* input_data = Xdata + image_id * input_image_size * C;
+      float* output_data = Ydata + (image_id * output_image_size + output_start) * M;
+
+      if (!is_pointwise) {
+        math::Im2col<float, StorageOrder::NHWC>()(
+            input_data,
+            C,
+            input_shape.GetDims().data(),
+            output_shape.GetDims().data(),
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<ptrdiff_t>(kernel_rank),
+            output_start,
+            output_count,
+            indirection_buffer.data(),
+            padding_data.data());
+      }
+
+      if (is_depthwise) {
+        MlasConvDepthwise(
+            indirection_buffer.data(),
+            static_cast<const float*>(packed_W),
+            Bdata,
+            output_data,
+            static_cast<size_t>(C),
+            static_cast<size_t>(output_count),
+            static_cast<size_t>(kernel_size));
+        if (activation != nullptr) {
+          MlasActivation(activation, output_data, nullptr, static_cast<size_t>(output_count),
+                         static_cast<size_t>(M), static_cast<size_t>(M));
+        }
+        continue;
+      }
+
+      // The GEMMs of the groups have the same shape, so they are issued as a single batch.
+      InlinedVector<MLAS_SGEMM_EPILOGUE> epilogues(static_cast<size_t>(group_count));
+      InlinedVector<MLAS_SGEMM_DATA_PARAMS> gemm_params(static_cast<size_t>(group_count));
+
+      for (int64_t group_id = 0; group_id < group_count; group_id++) {
+        MLAS_SGEMM_DATA_PARAMS& gemm = gemm_params[group_id];
+        if (is_pointwise) {
+          gemm.A = input_data + output_start * C + group_id * group_input_channels;
+          gemm.lda = static_cast<size_t>(C);
+        } else {
+          // Gather the input channels of the group through the indirection buffer.
+          float* group_col = col_buffer.data() + group_id * output_tile_size * kernel_dim;
+          const int64_t indirection_count = output_count * kernel_size;
+          for (int64_t i = 0; i < indirection_count; i++) {
+            std::memcpy(group_col + i * group_input_channels,
+                        indirection_buffer[i] + group_id * group_input_channels,
+                        SafeInt<size_t>(sizeof(float)) * group_input_channels);
+          }
+          gemm.A = group_col;
+          gemm.lda = static_cast<size_t>(kernel_dim);
+        }
+        gemm.B = static_cast<const float*>(
+            static_cast<const void*>(static_cast<const uint8_t*>(packed_W) + group_id * group_packed_size));
+        gemm.BIsPacked = true;
+        gemm.C = output_data + group_id * group_output_channels;
+        gemm.ldc = static_cast<size_t>(M);
+
+        MLAS_SGEMM_EPILOGUE& epilogue = epilogues[group_id];
+        epilogue.Bias = Bdata != nullptr ? Bdata + group_id * group_output_channels : nullptr;
+        epilogue.Activation = activation;
+        if (epilogue.Bias != nullptr || epilogue.Activation != nullptr) {
+          gemm.Epilogue = &epilogue;
+        }
+      }
+
+      MlasGemmBatch(CblasNoTrans, CblasNoTrans, static_cast<size_t>(output_count),
+                    static_cast<size_t>(group_output_channels), static_cast<size_t>(kernel_dim),
+                    gemm_params.data(), gemm_params.size(), nullptr);
+    }
+  };
+
+  const double tile_flops = 2.0 * static_cast<double>(output_tile_size) * static_cast<double>(kernel_dim) *
+                            static_cast<double>(is_depthwise ? C : M);
+  const TensorOpCost cost{static_cast<double>(output_tile_size * kernel_dim * sizeof(float)),
+                          static_cast<double>(output_tile_size * M * sizeof(float)),
+                          tile_flops};
+  concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(),
+                                          static_cast<std::ptrdiff_t>(N * tiles_per_image), cost, conv_tiles);
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NhwcConv,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcConv);
+
+}  // namespace contrib
+}  // namespace onnxruntime
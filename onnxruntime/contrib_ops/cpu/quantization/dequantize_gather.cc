@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class DequantizeGather final : public OpKernel {
+ public:
+  DequantizeGather(const OpKernelInfo& info) : OpKernel(info) {
+    nbits_ = info.GetAttrOrDefault<int64_t>("bits", 8);
+    ORT_ENFORCE(nbits_ == 8 || nbits_ == 4, "Only 8b and 4b tables are supported for DequantizeGather op, got ",
+                nbits_);
+    int64_t axis = info.GetAttrOrDefault<int64_t>("axis", 0);
+    ORT_ENFORCE(axis == 0 || axis == -2, "DequantizeGather only gathers on axis 0, got ", axis);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename T, typename Tind>
+  Status ComputeImpl(OpKernelContext* context, const Tensor* data, const Tensor* indices, const Tensor* scales,
+                     const Tensor* zero_points, int32_t default_zero_point) const;
+
+  int64_t nbits_;
+};
+
+namespace {
+
+template <typename T>
+void DequantizeRow(const T* row, size_t count, float scale, int32_t zero_point, float* output) {
+  for (size_t j = 0; j < count; j++) {
+    output[j] = static_cast<float>(static_cast<int32_t>(row[j]) - zero_point) * scale;
+  }
+}
+
+// count is the number of packed bytes, each holding two elements
+void DequantizeRow4Bits(const uint8_t* row, size_t count, float scale, int32_t zero_point, float* output) {
+  for (size_t j = 0; j < count; j++) {
+    const uint8_t packed = row[j];
+    output[2 * j] = static_cast<float>(static_cast<int32_t>(packed & 0x0F) - zero_point) * scale;
+    output[2 * j + 1] = static_cast<float>(static_cast<int32_t>(packed >> 4) - zero_point) * scale;
+  }
+}
+
+}  // namespace
+
+template <typename T, typename Tind>
+Status DequantizeGather::ComputeImpl(OpKernelContext* context, const Tensor* data, const Tensor* indices,
+                                     const Tensor* scales, const Tensor* zero_points,
+                                     int32_t default_zero_point) const {
+  const int64_t rows = data->Shape()[0];
+  const size_t row_size = static_cast<size_t>(data->Shape()[1]);
+  const size_t output_row_size = nbits_ == 4 ? row_size * 2 : row_size;
+  const bool per_row = scales->Shape().Size() != 1;
+
+  const auto num_indices = static_cast<size_t>(indices->Shape().Size());
+  const Tind* indices_data = indices->Data<Tind>();
+
+  // Check the indices first in case there's a out of bound index.
+  for (size_t i = 0; i < num_indices; ++i) {
+    const Tind idx = indices_data[i];
+    if (idx < -rows || idx >= rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -rows, ",", rows - 1, "]");
+    }
+  }
+
+  auto output_dims = indices->Shape().AsShapeVector();
+  output_dims.push_back(static_cast<int64_t>(output_row_size));
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+
+  const T* data_data = data->Data<T>();
+  const float* scales_data = scales->Data<float>();
+  const T* zero_points_data = zero_points == nullptr ? nullptr : zero_points->Data<T>();
+  float* output_data = output->MutableData<float>();
+
+  // only the gathered rows are read and dequantized, so the cost is that of the output
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_indices),
+      TensorOpCost{static_cast<double>(row_size * sizeof(T)),
+                   static_cast<double>(output_row_size * sizeof(float)),
+                   static_cast<double>(output_row_size)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          int64_t idx = static_cast<int64_t>(indices_data[i]);
+          idx = idx < 0 ? idx + rows : idx;
+
+          const size_t param_index = per_row ? static_cast<size_t>(idx) : 0;
+          const float scale = scales_data[param_index];
+          const int32_t zero_point = zero_points_data == nullptr
+                                         ? default_zero_point
+                                         : static_cast<int32_t>(zero_points_data[param_index]);
+
+          const T* row = data_data + static_cast<size_t>(idx) * row_size;
+          float* output_row = output_data + static_cast<size_t>(i) * output_row_size;
+          if constexpr (std::is_same<T, uint8_t>::value) {
+            if (nbits_ == 4) {
+              DequantizeRow4Bits(row, row_size, scale, zero_point, output_row);
+              continue;
+            }
+          }
+          DequantizeRow(row, row_size, scale, zero_point, output_row);
+        }
+      });
+
+  return Status::OK();
+}
+
+Status DequantizeGather::Compute(OpKernelContext* ctx) const {
+  const Tensor* data = ctx->Input<Tensor>(0);
+  const Tensor* indices = ctx->Input<Tensor>(1);
+  const Tensor* scales = ctx->Input<Tensor>(2);
+  const Tensor* zero_points = ctx->Input<Tensor>(3);
+
+  ORT_RETURN_IF_NOT(data->Shape().NumDimensions() == 2,
+                    "Input data of DequantizeGather must be a 2-D tensor, got shape ", data->Shape());
+  ORT_RETURN_IF_NOT(nbits_ == 8 || data->IsDataType<uint8_t>(),
+                    "Input data of DequantizeGather must be uint8 for 4b tables");
+
+  const int64_t scale_count = scales->Shape().Size();
+  ORT_RETURN_IF_NOT(scales->Shape().NumDimensions() <= 1 && (scale_count == 1 || scale_count == data->Shape()[0]),
+                    "Input scales of DequantizeGather must hold 1 or rows elements, got shape ", scales->Shape());
+  ORT_RETURN_IF_NOT(zero_points == nullptr || zero_points->Shape().Size() == scale_count,
+                    "Input zero_points of DequantizeGather must hold as many elements as scales, got shape ",
+                    zero_points->Shape());
+
+  const int32_t default_zero_point = nbits_ == 4 ? 8 : 0;
+  const bool is_int64 = indices->IsDataType<int64_t>();
+  if (data->IsDataType<int8_t>()) {
+    return is_int64 ? ComputeImpl<int8_t, int64_t>(ctx, data, indices, scales, zero_points, default_zero_point)
+                    : ComputeImpl<int8_t, int32_t>(ctx, data, indices, scales, zero_points, default_zero_point);
+  }
+
+  return is_int64 ? ComputeImpl<uint8_t, int64_t>(ctx, data, indices, scales, zero_points, default_zero_point)
+                  : ComputeImpl<uint8_t, int32_t>(ctx, data, indices, scales, zero_points, default_zero_point);
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    DequantizeGather,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    DequantizeGather);
+
+}  // namespace contrib
+}  // namespace onnxruntime
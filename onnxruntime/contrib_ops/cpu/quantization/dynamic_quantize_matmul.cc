@@ -6,10 +6,12 @@
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/providers/cpu/quantization/matmul_integer_base.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math_cpuonly.h"
 #include "core/util/qmath.h"
 
 #include <algorithm>
+#include <type_traits>
 
 namespace onnxruntime {
 namespace contrib {
@@ -34,6 +36,68 @@ void ScaleOutput(const Tensor& scale, Tensor& output) {
 
   BroadcastLooper(broadcast_helper, funcs);
 }
+
+// Quantizes each row of K elements with its own symmetric scale. The range of a row is found right before it is
+// quantized, while it is still in cache. The zero point is the same for all the rows, 0 for int8 and 128 for uint8,
+// as the GEMM takes a single zero point for A.
+template <typename T>
+void QuantizeRows(const float* data, T* data_quant, float* row_scales, size_t rows, size_t K,
+                  concurrency::ThreadPool* thread_pool) {
+  constexpr T zero_point = std::is_signed<T>::value ? T(0) : T(128);
+  const TensorOpCost unit_cost{static_cast<double>(K * sizeof(float)), static_cast<double>(K * sizeof(T)),
+                               static_cast<double>(K) * 3.0};
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(rows), unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t row = begin; row < end; row++) {
+          const float* row_data = data + row * K;
+          float min;
+          float max;
+          MlasFindMinMaxElement(row_data, &min, &max, K);
+          const float max_value = std::max(max, -min);
+          const float scale = max_value > 0 ? max_value / 127.f : 1.f;
+          row_scales[row] = scale;
+          MlasQuantizeLinear(row_data, data_quant + row * K, K, scale, zero_point);
+        }
+      });
+}
+
+// Converts the int32 GEMM output to float with a scale per row of A and a scale per matrix or column of B, adding
+// the bias. The output may be the buffer of the int32 values.
+class RowScaleBiasOutputProcessor final : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+ public:
+  RowScaleBiasOutputProcessor(float* output, size_t ldo, const float* row_scales, const float* b_scales,
+                              bool is_b_scale_per_column, const float* bias)
+      : output_(output),
+        ldo_(ldo),
+        row_scales_(row_scales),
+        b_scales_(b_scales),
+        is_b_scale_per_column_(is_b_scale_per_column),
+        bias_(bias) {}
+
+  void Process(const int32_t* C, size_t StartM, size_t StartN, size_t CountM, size_t CountN,
+               size_t ldc) const override {
+    for (size_t m = StartM; m < StartM + CountM; m++) {
+      const int32_t* c_row = C + m * ldc;
+      float* output_row = output_ + m * ldo_;
+      const float row_scale = row_scales_[m];
+      for (size_t n = StartN; n < StartN + CountN; n++) {
+        float value = static_cast<float>(c_row[n]) * row_scale * b_scales_[is_b_scale_per_column_ ? n : 0];
+        if (bias_ != nullptr) {
+          value += bias_[n];
+        }
+        output_row[n] = value;
+      }
+    }
+  }
+
+ private:
+  float* output_;
+  size_t ldo_;
+  const float* row_scales_;
+  const float* b_scales_;
+  bool is_b_scale_per_column_;
+  const float* bias_;
+};
 }  // namespace
 
 class MatMulIntegerToFloatBase : public MatMulIntegerBase {
@@ -53,7 +117,8 @@ class MatMulIntegerToFloatBase : public MatMulIntegerBase {
                        const Tensor* b_tensor,
                        const Tensor* b_scale,
                        const Tensor* b_zp,
-                       const Tensor* bias_tensor) const;
+                       const Tensor* bias_tensor,
+                       const float* a_row_scales = nullptr) const;
 };
 
 Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
@@ -65,7 +130,8 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
                                                const Tensor* b_tensor,
                                                const Tensor* b_scale_tensor,
                                                const Tensor* b_zp_tensor,
-                                               const Tensor* bias_tensor) const {
+                                               const Tensor* bias_tensor,
+                                               const float* a_row_scales) const {
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a_shape,
                                      b_tensor ? b_tensor->Shape() : b_shape_,
@@ -125,18 +191,34 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
   const size_t num_gemms = helper.OutputOffsets().size();
   std::vector<MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR> gemm_scale_procs;
-  gemm_scale_procs.reserve(num_gemms);
+  std::vector<RowScaleBiasOutputProcessor> gemm_row_scale_procs;
+  if (a_row_scales != nullptr) {
+    gemm_row_scale_procs.reserve(num_gemms);
+  } else {
+    gemm_scale_procs.reserve(num_gemms);
+  }
   std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> gemm_data_vec(num_gemms);
 
   for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
-    gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
-                                  gemm_shape.N,
-                                  b_scale_data + helper.RightScaleOffsets()[gemm_idx],
-                                  bias_data,
-                                  MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
-                                  is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
     auto& params = gemm_data_vec[gemm_idx];
-    params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    if (a_row_scales != nullptr) {
+      // the rows of A of the gemm start at its offset in A
+      gemm_row_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                        gemm_shape.N,
+                                        a_row_scales + helper.LeftOffsets()[gemm_idx] / gemm_shape.K,
+                                        b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                        is_b_scale_per_column,
+                                        bias_data);
+      params.OutputProcessor = &(gemm_row_scale_procs[gemm_idx]);
+    } else {
+      gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                    gemm_shape.N,
+                                    b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                    bias_data,
+                                    MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
+                                    is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
+      params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    }
     params.A = a_data + helper.LeftOffsets()[gemm_idx];
     params.lda = gemm_shape.K;
     params.ZeroPointA = a_zp;
@@ -156,10 +238,14 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
 class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
  public:
-  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {}
+  DynamicQuantizeMatMul(const OpKernelInfo& info);
 
   Status Compute(OpKernelContext* context) const override;
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
   enum InputTensors : int {
     IN_A = 0,
     IN_B = 1,
@@ -170,6 +256,15 @@ class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+
+ private:
+  // Multiplies the input quantized symmetrically to int8 with the weight packed by MlasSymmQgemmPackB.
+  Status ComputeSymmetric(OpKernelContext* ctx, const Tensor& a, const Tensor& b_scale_tensor) const;
+
+  bool is_per_row_{false};
+
+  // set when the weight is packed for MlasSymmQgemmBatch rather than MlasGemmBatch
+  bool use_symmetric_gemm_{false};
 };
 
 class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
@@ -195,42 +290,194 @@ class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
   // a scale and b scale may be switched in fusion stage because of lack of shape information.
   // Fix them up before computation.
   static void FixupScaleTensor(const Tensor*& a_scale_tensor, const Tensor*& b_scale_tensor);
+
+  // Multiplies int16 A by int8 B with MlasGemmS16S8Batch. B is not prepacked for this GEMM.
+  Status ComputeS16S8(OpKernelContext* ctx, const Tensor& a, float a_scale, int16_t a_zero_point, const Tensor& b,
+                      const Tensor* b_scale_tensor, const Tensor* b_zp_tensor, const Tensor* bias_tensor) const;
 };
 
+DynamicQuantizeMatMul::DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {
+  const auto& config_options = info.GetConfigOptions();
+  is_per_row_ = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicQuantizeMatMulPerRow, "0") == "1";
+
+  // The symmetric GEMM needs a constant 2D int8 weight quantized symmetrically, with zero points that are all 0.
+  const Tensor* b = nullptr;
+  if (config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicQuantizeMatMulSymmetric, "0") == "1" &&
+      info.TryGetConstantInput(IN_B, &b) && b->IsDataType<int8_t>() && b->Shape().NumDimensions() == 2) {
+    const auto& input_defs = info.node().InputDefs();
+    const Tensor* b_zp = nullptr;
+    bool is_b_zp_zero = input_defs.size() <= IN_B_ZERO_POINT || !input_defs[IN_B_ZERO_POINT]->Exists();
+    if (!is_b_zp_zero && info.TryGetConstantInput(IN_B_ZERO_POINT, &b_zp) && b_zp->IsDataType<int8_t>()) {
+      const auto b_zp_data = b_zp->DataAsSpan<int8_t>();
+      is_b_zp_zero = std::all_of(b_zp_data.begin(), b_zp_data.end(), [](int8_t zp) { return zp == 0; });
+    }
+
+    const size_t K = static_cast<size_t>(b->Shape()[0]);
+    const size_t N = static_cast<size_t>(b->Shape()[1]);
+    use_symmetric_gemm_ = is_b_zp_zero && K > 0 && MlasSymmQgemmPackBSize(N, K, true) != 0;
+    if (use_symmetric_gemm_) {
+      // the shape is not known when the packed weight is shared with another session
+      b_shape_ = b->Shape();
+    }
+  }
+}
+
+Status DynamicQuantizeMatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                      /*out*/ bool& is_packed,
+                                      /*out*/ PrePackedWeights* prepacked_weights) {
+  if (input_idx != IN_B || !use_symmetric_gemm_) {
+    return MatMulIntegerToFloatBase::PrePack(tensor, input_idx, alloc, is_packed, prepacked_weights);
+  }
+
+  const size_t K = static_cast<size_t>(b_shape_[0]);
+  const size_t N = static_cast<size_t>(b_shape_[1]);
+  const size_t packed_b_size = MlasSymmQgemmPackBSize(N, K, true);
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+
+  // zero the padding so that the buffer hashes the same when shared between sessions
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasSymmQgemmPackB(N, K, tensor.Data<int8_t>(), N, true, 0, packed_b_data);
+  b_is_signed_ = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status DynamicQuantizeMatMul::ComputeSymmetric(OpKernelContext* ctx, const Tensor& a,
+                                               const Tensor& b_scale_tensor) const {
+  const bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor.Shape(), b_shape_);
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a.Shape(), b_shape_, is_b_scale_supported ? &b_scale_tensor.Shape() : nullptr,
+                                     nullptr));
+  Tensor* y = ctx->Output(OUT_Y, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  // as B is 2D, the rows of the output are the rows of A
+  const float* a_data = a.Data<float>();
+  const size_t rows = static_cast<size_t>(a.Shape().Size()) / K;
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+  auto* a_data_quant = static_cast<int8_t*>(allocator->Alloc(SafeInt<size_t>(rows) * K));
+  BufferUniquePtr a_buffer_quant_holder(a_data_quant, BufferDeleter(allocator));
+
+  std::vector<float> row_scales(rows);
+  if (is_per_row_) {
+    QuantizeRows(a_data, a_data_quant, row_scales.data(), rows, K, thread_pool);
+  } else {
+    float a_scale;
+    int8_t a_zero_point;
+    GetQuantizationParameter<int8_t, false, true>(a_data, a.Shape().Size(), a_scale, a_zero_point, thread_pool);
+    ParQuantizeLinear(a_data, a_data_quant, rows * K, a_scale, a_zero_point, thread_pool);
+    std::fill(row_scales.begin(), row_scales.end(), a_scale);
+  }
+
+  MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
+  gemm_shape.M = static_cast<size_t>(helper.M());
+  gemm_shape.N = N;
+  gemm_shape.K = K;
+  gemm_shape.AIsSigned = true;
+  gemm_shape.BIsSigned = true;
+
+  auto* y_data = y->MutableData<float>();
+  const size_t num_gemms = helper.OutputOffsets().size();
+  std::vector<MLAS_SYMM_QGEMM_DATA_PARAMS> gemm_data_vec(num_gemms);
+  for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
+    auto& params = gemm_data_vec[gemm_idx];
+    params.A = a_data_quant + helper.LeftOffsets()[gemm_idx];
+    params.lda = K;
+    params.B = packed_b_.get();
+    params.C = reinterpret_cast<int32_t*>(y_data + helper.OutputOffsets()[gemm_idx]);
+    params.ldc = N;
+  }
+
+  MlasSymmQgemmBatch(gemm_shape, gemm_data_vec.data(), num_gemms, thread_pool);
+
+  // the symmetric GEMM has no output processor, so scale the int32 output in place
+  const float unit_scale = 1.f;
+  const bool is_b_scale_per_column = is_b_scale_supported && !IsScalarOr1ElementVector(&b_scale_tensor);
+  const Tensor* bias_tensor = ctx->Input<Tensor>(IN_BIAS);
+  const RowScaleBiasOutputProcessor output_processor(y_data, N, row_scales.data(),
+                                                     is_b_scale_supported ? b_scale_tensor.Data<float>() : &unit_scale,
+                                                     is_b_scale_per_column,
+                                                     bias_tensor != nullptr ? bias_tensor->Data<float>() : nullptr);
+  const auto* c_data = reinterpret_cast<const int32_t*>(y_data);
+  const TensorOpCost unit_cost{static_cast<double>(N * sizeof(int32_t)), static_cast<double>(N * sizeof(float)),
+                               static_cast<double>(N) * 2.0};
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(rows), unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        output_processor.Process(c_data, static_cast<size_t>(begin), 0, static_cast<size_t>(end - begin), N, N);
+      });
+
+  if (!is_b_scale_supported) {
+    ScaleOutput(b_scale_tensor, *y);
+  }
+
+  return Status::OK();
+}
+
 Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   const Tensor* a = ctx->Input<Tensor>(IN_A);
-  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(IN_B);
-
   const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
+  if (use_symmetric_gemm_ && packed_b_) {
+    return ComputeSymmetric(ctx, *a, *b_scale_tensor);
+  }
+
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(IN_B);
   const Tensor* b_zp_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
 
   // calculate quantization parameter of a
   const float* a_data = a->template Data<float>();
   int64_t num_of_elements = a->Shape().Size();
 
-  float a_scale;
-  uint8_t a_zero_point;
-  GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
-
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
   uint8_t* a_data_quant = static_cast<uint8_t*>(allocator->Alloc(SafeInt<size_t>(num_of_elements) * sizeof(uint8_t)));
   BufferUniquePtr a_buffer_quant_holder(a_data_quant, BufferDeleter(allocator));
 
-  ParQuantizeLinear(a_data, a_data_quant, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  // per row quantization needs the rows to be non empty
+  const auto& a_shape = a->Shape();
+  const bool is_per_row = is_per_row_ && a_shape.NumDimensions() > 0 && a_shape[a_shape.NumDimensions() - 1] > 0;
+
+  float a_scale = 1.f;
+  uint8_t a_zero_point = 128;
+  std::vector<float> a_row_scales;
+  if (is_per_row) {
+    const size_t K = static_cast<size_t>(a_shape[a_shape.NumDimensions() - 1]);
+    a_row_scales.resize(static_cast<size_t>(num_of_elements) / K);
+    QuantizeRows(a_data, a_data_quant, a_row_scales.data(), a_row_scales.size(), K, ctx->GetOperatorThreadPool());
+  } else {
+    GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+    ParQuantizeLinear(a_data, a_data_quant, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  }
 
   bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor->Shape(), b ? b->Shape() : b_shape_);
   ORT_RETURN_IF_ERROR(ComputeCommon(
       ctx,
       a_data_quant,
-      a->Shape(),
+      a_shape,
       a_scale,
       a_zero_point,
       false /*a_is_signed*/,
       b,
       is_b_scale_supported ? b_scale_tensor : nullptr,
       b_zp_tensor,
-      ctx->Input<Tensor>(IN_BIAS)));
+      ctx->Input<Tensor>(IN_BIAS),
+      is_per_row ? a_row_scales.data() : nullptr));
 
   if (!is_b_scale_supported) {
     ScaleOutput(*b_scale_tensor, *ctx->Output<Tensor>(0));
@@ -266,26 +513,36 @@ Status MatMulIntegerToFloat::Compute(OpKernelContext* ctx) const {
   bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor->Shape(), nullptr != b ? b->Shape() : b_shape_);
 
   // validate zero point of a
-  uint8_t a_zero_point = 0;
   const Tensor* a_zero_point_tensor = ctx->Input<Tensor>(IN_A_ZERO_POINT);
   if (a_zero_point_tensor != nullptr) {
     ORT_ENFORCE(IsScalarOr1ElementVector(a_zero_point_tensor),
                 "MatMulIntegerToFloat : input a zero point must be a scalar or 1D tensor of size 1. Per-Channel is not supported yet.");
-    a_zero_point = *(static_cast<const uint8_t*>(a_zero_point_tensor->DataRaw()));
   }
 
   const Tensor* b_zp_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
-  ORT_RETURN_IF_ERROR(ComputeCommon(
-      ctx,
-      static_cast<const uint8_t*>(a->DataRaw()),
-      a->Shape(),
-      is_a_scale_scalar ? *a_scale_tensor->template Data<float>() : 1.f,
-      a_zero_point,
-      a->IsDataType<int8_t>(),
-      b,
-      is_b_scale_supported ? b_scale_tensor : nullptr,
-      b_zp_tensor,
-      ctx->Input<Tensor>(IN_BIAS)));
+  if (a->IsDataType<int16_t>()) {
+    ORT_RETURN_IF_ERROR(ComputeS16S8(
+        ctx,
+        *a,
+        is_a_scale_scalar ? *a_scale_tensor->template Data<float>() : 1.f,
+        a_zero_point_tensor != nullptr ? *a_zero_point_tensor->Data<int16_t>() : int16_t(0),
+        *b,
+        is_b_scale_supported ? b_scale_tensor : nullptr,
+        b_zp_tensor,
+        ctx->Input<Tensor>(IN_BIAS)));
+  } else {
+    ORT_RETURN_IF_ERROR(ComputeCommon(
+        ctx,
+        static_cast<const uint8_t*>(a->DataRaw()),
+        a->Shape(),
+        is_a_scale_scalar ? *a_scale_tensor->template Data<float>() : 1.f,
+        a_zero_point_tensor != nullptr ? *static_cast<const uint8_t*>(a_zero_point_tensor->DataRaw()) : uint8_t(0),
+        a->IsDataType<int8_t>(),
+        b,
+        is_b_scale_supported ? b_scale_tensor : nullptr,
+        b_zp_tensor,
+        ctx->Input<Tensor>(IN_BIAS)));
+  }
 
   if (!is_a_scale_scalar) {
     ScaleOutput(*a_scale_tensor, *ctx->Output<Tensor>(0));
@@ -297,6 +554,81 @@ Status MatMulIntegerToFloat::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+Status MatMulIntegerToFloat::ComputeS16S8(OpKernelContext* ctx, const Tensor& a, float a_scale, int16_t a_zero_point,
+                                          const Tensor& b, const Tensor* b_scale_tensor, const Tensor* b_zp_tensor,
+                                          const Tensor* bias_tensor) const {
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a.Shape(),
+                                     b.Shape(),
+                                     b_scale_tensor ? &b_scale_tensor->Shape() : nullptr,
+                                     b_zp_tensor ? &b_zp_tensor->Shape() : nullptr));
+  Tensor* y = ctx->Output(OUT_Y, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  bool is_b_zp_per_column = false;
+  const int8_t* b_zp_data = nullptr;
+  if (b_zp_tensor != nullptr) {
+    ORT_ENFORCE(IsBQuantParamSupported(b_zp_tensor->Shape(), b.Shape()),
+                "MatMulIntegerToFloat : b zero point is not valid");
+    is_b_zp_per_column = !IsScalarOr1ElementVector(b_zp_tensor);
+    b_zp_data = b_zp_tensor->Data<int8_t>();
+  }
+
+  bool is_b_scale_per_column = false;
+  float multiplier_per_tensor = a_scale;
+  const float* b_scale_data = &multiplier_per_tensor;
+  std::vector<float> multipliers_per_column;
+  if (b_scale_tensor != nullptr) {
+    is_b_scale_per_column = !IsScalarOr1ElementVector(b_scale_tensor);
+    const auto b_scales = b_scale_tensor->DataAsSpan<float>();
+    if (is_b_scale_per_column) {
+      multipliers_per_column.reserve(b_scales.size());
+      std::transform(b_scales.begin(), b_scales.end(), std::back_inserter(multipliers_per_column),
+                     [a_scale](float b_scale) { return a_scale * b_scale; });
+      b_scale_data = multipliers_per_column.data();
+    } else {
+      multiplier_per_tensor *= b_scales[0];
+    }
+  }
+
+  auto* y_data = y->MutableData<float>();
+  const auto* bias_data = bias_tensor != nullptr ? bias_tensor->Data<float>() : nullptr;
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t num_gemms = helper.OutputOffsets().size();
+
+  std::vector<MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR> gemm_scale_procs;
+  gemm_scale_procs.reserve(num_gemms);
+  std::vector<MLAS_GEMM_S16S8_DATA_PARAMS> gemm_data_vec(num_gemms);
+  for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
+    gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                  N,
+                                  b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                  bias_data,
+                                  MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
+                                  is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn
+                                                        : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
+    auto& params = gemm_data_vec[gemm_idx];
+    params.A = a.Data<int16_t>() + helper.LeftOffsets()[gemm_idx];
+    params.lda = static_cast<size_t>(helper.K());
+    params.ZeroPointA = a_zero_point;
+    params.B = b.Data<int8_t>() + helper.RightOffsets()[gemm_idx];
+    params.ldb = N;
+    params.ZeroPointB = b_zp_data != nullptr ? b_zp_data + helper.RightZeroPointOffsets()[gemm_idx] : nullptr;
+    params.PerColumnZeroPoints = is_b_zp_per_column;
+    params.C = reinterpret_cast<int32_t*>(y_data + helper.OutputOffsets()[gemm_idx]);
+    params.ldc = N;
+    params.OutputProcessor = &gemm_scale_procs[gemm_idx];
+  }
+
+  MlasGemmS16S8Batch(static_cast<size_t>(helper.M()), N, static_cast<size_t>(helper.K()), gemm_data_vec.data(),
+                     num_gemms, ctx->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
 ONNX_OPERATOR_TYPED_KERNEL_EX(
     DynamicQuantizeMatMul,
     kMSDomain,
@@ -332,5 +664,17 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<float>()),
     MatMulIntegerToFloat);
 
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MatMulIntegerToFloat,
+    kMSDomain,
+    1,
+    int16_t,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int16_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<float>()),
+    MatMulIntegerToFloat);
+
 }  // namespace contrib
 }  // namespace onnxruntime
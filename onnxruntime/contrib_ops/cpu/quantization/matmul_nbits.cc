@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class MatMulNBits final : public OpKernel {
+ public:
+  MatMulNBits(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("K", &K_));
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("N", &N_));
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("block_size", &block_size_));
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("bits", &nbits_));
+    ORT_ENFORCE(nbits_ == 4, "Only 4b quantization is supported for MatMulNBits op, got ", nbits_);
+    ORT_ENFORCE(K_ > 0 && N_ > 0, "K and N must be positive, got K=", K_, " N=", N_);
+    ORT_ENFORCE(MlasQ4GemmIsBlkLenSupported(static_cast<size_t>(block_size_)),
+                "Unsupported block_size for MatMulNBits op: ", block_size_);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t K_;
+  int64_t N_;
+  int64_t block_size_;
+  int64_t nbits_;
+};
+
+Status MatMulNBits::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+  const Tensor* scales = ctx->Input<Tensor>(2);
+  const Tensor* zero_points = ctx->Input<Tensor>(3);
+
+  const size_t K = static_cast<size_t>(K_);
+  const size_t N = static_cast<size_t>(N_);
+  const size_t block_size = static_cast<size_t>(block_size_);
+  const size_t blocks_per_col = (K + block_size - 1) / block_size;
+  const size_t blob_size = block_size / 8 * static_cast<size_t>(nbits_);
+
+  ORT_RETURN_IF_NOT(static_cast<size_t>(b->Shape().Size()) == N * blocks_per_col * blob_size,
+                    "Input B of MatMulNBits must hold N * n_blocks_per_col * blob_size bytes, got shape ",
+                    b->Shape());
+  ORT_RETURN_IF_NOT(static_cast<size_t>(scales->Shape().Size()) == N * blocks_per_col,
+                    "Input scales of MatMulNBits must hold N * n_blocks_per_col elements, got shape ",
+                    scales->Shape());
+  ORT_RETURN_IF_NOT(zero_points == nullptr ||
+                        static_cast<size_t>(zero_points->Shape().Size()) == N * ((blocks_per_col + 1) / 2),
+                    "Input zero_points of MatMulNBits must hold N * ((n_blocks_per_col + 1) / 2) bytes, got shape ",
+                    zero_points->Shape());
+
+  TensorShape b_shape({K_, N_});
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t lda = helper.Lda(false);
+
+  const float* a_data = a->Data<float>();
+  float* y_data = y->MutableData<float>();
+
+  std::vector<MLAS_Q4GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = lda;
+    data[i].QuantBData = b->Data<uint8_t>();
+    data[i].QuantBScale = scales->Data<float>();
+    data[i].QuantBZeroPoint = zero_points == nullptr ? nullptr : zero_points->Data<uint8_t>();
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+
+  MlasQ4GemmBatch(M, N, K, block_size, max_len, data.data(), thread_pool);
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulNBits,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    MatMulNBits);
+
+}  // namespace contrib
+}  // namespace onnxruntime
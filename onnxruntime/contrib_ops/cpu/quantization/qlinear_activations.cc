@@ -4,6 +4,10 @@
 #include "qlinear_activations.h"
 #include "qlinear_lookup_table.h"
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+
 #include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 
@@ -96,6 +100,86 @@ Status QLinearSigmoid<T>::Compute(OpKernelContext* context) const {
   });
 }
 
+namespace {
+float ComputeGelu(float v) {
+  constexpr float kSqrt1_2 = 0.70710678118654752f;
+  return 0.5f * v * (1.0f + std::erf(v * kSqrt1_2));
+}
+}  // namespace
+
+template <typename T>
+QLinearGelu<T>::QLinearGelu(const OpKernelInfo& info)
+    : QLinearLookupBase<T>(info) {
+  this->BuildLookupTableIfFixed(info, ComputeGelu);
+}
+
+template <typename T>
+Status QLinearGelu<T>::Compute(OpKernelContext* context) const {
+  return this->ComputeBase(context, ComputeGelu);
+}
+
+namespace {
+LookupTableArrayTransformer ToArrayTransformer(LookupTableScalarTransformer fn) {
+  return [fn](const float* input, float* output, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+      output[i] = fn(input[i]);
+    }
+  };
+}
+
+LookupTableArrayTransformer GetUnaryTransformer(const OpKernelInfo& info, const std::string& op_type) {
+  if (op_type == "Tanh") {
+    return [](const float* input, float* output, size_t length) { MlasComputeTanh(input, output, length); };
+  }
+  if (op_type == "Erf") {
+    return [](const float* input, float* output, size_t length) { MlasComputeErf(input, output, length); };
+  }
+  if (op_type == "Exp") {
+    return [](const float* input, float* output, size_t length) { MlasComputeExp(input, output, length); };
+  }
+  if (op_type == "Elu") {
+    const float alpha = info.GetAttrOrDefault("alpha", 1.0f);
+    return ToArrayTransformer([alpha](float v) { return v >= 0.0f ? v : alpha * (std::exp(v) - 1.0f); });
+  }
+  if (op_type == "HardSigmoid") {
+    const float alpha = info.GetAttrOrDefault("alpha", 0.2f);
+    const float beta = info.GetAttrOrDefault("beta", 0.5f);
+    return ToArrayTransformer([alpha, beta](float v) { return std::max(0.0f, std::min(1.0f, alpha * v + beta)); });
+  }
+  if (op_type == "HardSwish") {
+    return ToArrayTransformer([](float v) { return v * std::max(0.0f, std::min(1.0f, v / 6.0f + 0.5f)); });
+  }
+  if (op_type == "Selu") {
+    const float alpha = info.GetAttrOrDefault("alpha", 1.67326319217681884765625f);
+    const float gamma = info.GetAttrOrDefault("gamma", 1.05070102214813232421875f);
+    return ToArrayTransformer([alpha, gamma](float v) {
+      return gamma * (v > 0.0f ? v : alpha * (std::exp(v) - 1.0f));
+    });
+  }
+  if (op_type == "Softplus") {
+    // log(1 + exp(v)) without overflowing exp for the large v
+    return ToArrayTransformer([](float v) { return std::max(v, 0.0f) + std::log1p(std::exp(-std::abs(v))); });
+  }
+  if (op_type == "Softsign") {
+    return ToArrayTransformer([](float v) { return v / (1.0f + std::abs(v)); });
+  }
+
+  ORT_THROW("QLinearUnary : unsupported op_type ", op_type);
+}
+}  // namespace
+
+template <typename T>
+QLinearUnary<T>::QLinearUnary(const OpKernelInfo& info)
+    : QLinearLookupBase<T>(info),
+      transformer_(GetUnaryTransformer(info, info.GetAttrOrDefault<std::string>("op_type", ""))) {
+  this->BuildLookupTableIfFixed(info, transformer_);
+}
+
+template <typename T>
+Status QLinearUnary<T>::Compute(OpKernelContext* context) const {
+  return this->ComputeBase(context, transformer_);
+}
+
 #define REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(op_name, version, data_type, KERNEL_CLASS) \
   ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                                         \
       op_name, version, data_type,                                                           \
@@ -107,6 +191,10 @@ REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearLeakyRelu, 1, int8_t, QLinearLe
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearLeakyRelu, 1, uint8_t, QLinearLeakyRelu);
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearSigmoid, 1, int8_t, QLinearSigmoid);
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearSigmoid, 1, uint8_t, QLinearSigmoid);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearGelu, 1, int8_t, QLinearGelu);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearGelu, 1, uint8_t, QLinearGelu);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearUnary, 1, int8_t, QLinearUnary);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearUnary, 1, uint8_t, QLinearUnary);
 
 }  // namespace contrib
 }  // namespace onnxruntime
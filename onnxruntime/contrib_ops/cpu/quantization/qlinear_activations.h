@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core/framework/op_kernel.h"
+#include "qlinear_lookup_table.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -49,6 +50,26 @@ class QLinearSigmoid final : public QLinearLookupBase<T> {
   Status Compute(OpKernelContext* context) const override;
 };
 
+// Looks up the unary ONNX operator given by the op_type attribute.
+template <typename T>
+class QLinearUnary final : public QLinearLookupBase<T> {
+ public:
+  QLinearUnary(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  LookupTableArrayTransformer transformer_;
+};
+
+template <typename T>
+class QLinearGelu final : public QLinearLookupBase<T> {
+ public:
+  QLinearGelu(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
 }  // namespace contrib
 }  // namespace onnxruntime
 
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "qlinear_layer_norm.h"
+
+#include <cmath>
+#include <vector>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+QLinearLayerNormalization<T>::QLinearLayerNormalization(const OpKernelInfo& info)
+    : OpKernel(info),
+      axis_(info.GetAttrOrDefault<int64_t>("axis", -1)),
+      epsilon_(info.GetAttrOrDefault<float>("epsilon", 1e-5f)) {
+  ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("stash_type", 1) == 1, "Only float stash_type is supported.");
+}
+
+template <typename T>
+Status QLinearLayerNormalization<T>::Compute(OpKernelContext* context) const {
+  const auto& X = *context->Input<Tensor>(0);
+  const auto* tensor_x_scale = context->Input<Tensor>(1);
+  const auto* tensor_x_zero_point = context->Input<Tensor>(2);
+  const auto& scale = *context->Input<Tensor>(3);
+  const auto* tensor_y_scale = context->Input<Tensor>(4);
+  const auto* tensor_y_zero_point = context->Input<Tensor>(5);
+  const auto* bias = context->Input<Tensor>(6);
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(tensor_x_scale),
+                    "Input x_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(tensor_x_zero_point == nullptr || IsScalarOr1ElementVector(tensor_x_zero_point),
+                    "Input x_zero_point must be a scalar or 1D tensor of size 1 if given");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(tensor_y_scale),
+                    "Input y_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(tensor_y_zero_point == nullptr || IsScalarOr1ElementVector(tensor_y_zero_point),
+                    "Input y_zero_point must be a scalar or 1D tensor of size 1 if given");
+
+  const auto& x_shape = X.Shape();
+  const int64_t axis = HandleNegativeAxis(axis_, static_cast<int64_t>(x_shape.NumDimensions()));
+  const int64_t norm_count = x_shape.SizeToDimension(gsl::narrow<size_t>(axis));
+  const int64_t norm_size = x_shape.SizeFromDimension(gsl::narrow<size_t>(axis));
+
+  ORT_RETURN_IF_NOT(scale.Shape().Size() == norm_size,
+                    "Size of Scale must match the size of the normalized dimensions: ", scale.Shape().Size(),
+                    " != ", norm_size);
+  ORT_RETURN_IF_NOT(bias == nullptr || bias->Shape().Size() == norm_size,
+                    "Size of B must match the size of the normalized dimensions: ", bias ? bias->Shape().Size() : 0,
+                    " != ", norm_size);
+
+  auto& Y = *context->Output(0, x_shape);
+  if (norm_count == 0 || norm_size == 0) {
+    return Status::OK();
+  }
+
+  const float x_scale = *tensor_x_scale->Data<float>();
+  const int32_t x_zero_point = tensor_x_zero_point ? static_cast<int32_t>(*tensor_x_zero_point->Data<T>()) : 0;
+  const float y_scale = *tensor_y_scale->Data<float>();
+  const T y_zero_point = tensor_y_zero_point ? *tensor_y_zero_point->Data<T>() : T{0};
+  const float* scale_data = scale.Data<float>();
+  const float* bias_data = bias ? bias->Data<float>() : nullptr;
+  const T* x_data = X.Data<T>();
+  T* y_data = Y.MutableData<T>();
+
+  using onnxruntime::TensorOpCost;
+  using onnxruntime::concurrency::ThreadPool;
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(norm_count),
+      TensorOpCost{static_cast<double>(norm_size), static_cast<double>(norm_size), 8.0 * norm_size},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // only one row is dequantized at a time
+        std::vector<float> row(gsl::narrow<size_t>(norm_size));
+        for (std::ptrdiff_t task_idx = first; task_idx < last; task_idx++) {
+          const T* p_input = x_data + task_idx * norm_size;
+          T* p_output = y_data + task_idx * norm_size;
+
+          float mean = 0.0f;
+          float mean_square = 0.0f;
+          for (int64_t h = 0; h < norm_size; h++) {
+            const float value = static_cast<float>(static_cast<int32_t>(p_input[h]) - x_zero_point) * x_scale;
+            row[h] = value;
+            mean += value;
+            mean_square += value * value;
+          }
+
+          mean = mean / norm_size;
+          const float inv_std_dev = 1.0f / std::sqrt(mean_square / norm_size - mean * mean + epsilon_);
+          for (int64_t h = 0; h < norm_size; h++) {
+            row[h] = (row[h] - mean) * inv_std_dev * scale_data[h];
+            if (bias_data != nullptr) {
+              row[h] += bias_data[h];
+            }
+          }
+
+          MlasQuantizeLinear(row.data(), p_output, static_cast<size_t>(norm_size), y_scale, y_zero_point);
+        }
+      });
+
+  return Status::OK();
+}
+
+#define REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(data_type)                   \
+  ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                          \
+      QLinearLayerNormalization, 1, data_type,                                \
+      KernelDefBuilder()                                                      \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()),     \
+      QLinearLayerNormalization<data_type>);
+
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(int8_t);
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(uint8_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
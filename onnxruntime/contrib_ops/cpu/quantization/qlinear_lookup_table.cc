@@ -35,7 +35,11 @@ void QLinearLookupTableTransform(const uint8_t* x, const TOutput* table, TOutput
   }
 }
 
-template void QLinearLookupTableTransform(const uint8_t* x, const uint8_t* table, uint8_t* y, size_t n);
+template <>
+void QLinearLookupTableTransform(const uint8_t* x, const uint8_t* table, uint8_t* y, size_t n) {
+  MlasQLinearLookupTable(x, table, y, n);
+}
+
 template void QLinearLookupTableTransform(const uint8_t* x, const float* table, float* y, size_t n);
 
 template <typename T>
@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "qlinear_softmax.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/providers/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// The zero point cancels in x - max(x), so the exponentials only depend on the difference of the quantized values.
+void BuildExpTable(float* table, float x_scale) {
+  for (int32_t d = 0; d < 256; d++) {
+    table[d] = std::exp(-static_cast<float>(d) * x_scale);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+QLinearSoftmax<T>::QLinearSoftmax(const OpKernelInfo& info)
+    : OpKernel(info),
+      axis_(info.GetAttrOrDefault<int64_t>("axis", -1)),
+      opset_(info.GetAttrOrDefault<int64_t>("opset", 13)) {
+  const Tensor* tensor_x_scale = nullptr;
+  if (info.TryGetConstantInput(1, &tensor_x_scale)) {
+    ORT_ENFORCE(IsScalarOr1ElementVector(tensor_x_scale), "Input x_scale must be a scalar or 1D tensor of size 1");
+    fixed_exp_table_.resize(256);
+    BuildExpTable(fixed_exp_table_.data(), *tensor_x_scale->Data<float>());
+  }
+}
+
+template <typename T>
+Status QLinearSoftmax<T>::Compute(OpKernelContext* context) const {
+  const auto& X = *context->Input<Tensor>(0);
+  const auto* tensor_x_scale = context->Input<Tensor>(1);
+  const auto* tensor_y_scale = context->Input<Tensor>(3);
+  const auto* tensor_y_zero_point = context->Input<Tensor>(4);
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(tensor_x_scale),
+                    "Input x_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(tensor_y_scale),
+                    "Input y_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(tensor_y_zero_point == nullptr || IsScalarOr1ElementVector(tensor_y_zero_point),
+                    "Input y_zero_point must be a scalar or 1D tensor of size 1 if given");
+
+  const auto& input_shape = X.Shape();
+  auto& Y = *context->Output(0, input_shape);
+  if (input_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const size_t rank = input_shape.NumDimensions();
+  const size_t axis = gsl::narrow<size_t>(HandleNegativeAxis(axis_, static_cast<int64_t>(rank)));
+
+  // Softmax before opset 13 coerces the input into 2D at axis, later versions normalize along axis only.
+  const int64_t outer_size = input_shape.SizeToDimension(axis);
+  int64_t axis_size;
+  int64_t inner_size;
+  if (opset_ < 13) {
+    axis_size = input_shape.SizeFromDimension(axis);
+    inner_size = 1;
+  } else {
+    axis_size = input_shape[axis];
+    inner_size = input_shape.SizeFromDimension(axis + 1);
+  }
+
+  float table[256];
+  if (fixed_exp_table_.empty()) {
+    BuildExpTable(table, *tensor_x_scale->Data<float>());
+  }
+  const float* exp_table = fixed_exp_table_.empty() ? table : fixed_exp_table_.data();
+
+  const float y_scale = *tensor_y_scale->Data<float>();
+  const int32_t y_zero_point = tensor_y_zero_point ? static_cast<int32_t>(*tensor_y_zero_point->Data<T>()) : 0;
+  constexpr int32_t kMinValue = static_cast<int32_t>(std::numeric_limits<T>::lowest());
+  constexpr int32_t kMaxValue = static_cast<int32_t>(std::numeric_limits<T>::max());
+
+  const T* x_data = X.Data<T>();
+  T* y_data = Y.MutableData<T>();
+
+  using onnxruntime::TensorOpCost;
+  using onnxruntime::concurrency::ThreadPool;
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(outer_size * inner_size),
+      TensorOpCost{static_cast<double>(axis_size), static_cast<double>(axis_size), 4.0 * axis_size},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t slice = first; slice < last; slice++) {
+          const int64_t outer = slice / inner_size;
+          const int64_t inner = slice % inner_size;
+          const T* x = x_data + outer * axis_size * inner_size + inner;
+          T* y = y_data + outer * axis_size * inner_size + inner;
+
+          int32_t max_value = kMinValue;
+          for (int64_t i = 0; i < axis_size; i++) {
+            max_value = std::max(max_value, static_cast<int32_t>(x[i * inner_size]));
+          }
+
+          float sum = 0.0f;
+          for (int64_t i = 0; i < axis_size; i++) {
+            sum += exp_table[max_value - static_cast<int32_t>(x[i * inner_size])];
+          }
+
+          // the maximum contributes exp(0), so sum >= 1
+          const float inv_scale = 1.0f / (sum * y_scale);
+          for (int64_t i = 0; i < axis_size; i++) {
+            const float value = exp_table[max_value - static_cast<int32_t>(x[i * inner_size])] * inv_scale;
+            const int32_t quantized = static_cast<int32_t>(std::nearbyint(value)) + y_zero_point;
+            y[i * inner_size] = static_cast<T>(std::min(std::max(quantized, kMinValue), kMaxValue));
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+#define REGISTER_QLINEAR_SOFTMAX_TYPED_KERNEL(data_type)                      \
+  ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                          \
+      QLinearSoftmax, 1, data_type,                                           \
+      KernelDefBuilder()                                                      \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()),     \
+      QLinearSoftmax<data_type>);
+
+REGISTER_QLINEAR_SOFTMAX_TYPED_KERNEL(int8_t);
+REGISTER_QLINEAR_SOFTMAX_TYPED_KERNEL(uint8_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class QLinearSoftmax final : public OpKernel {
+ public:
+  QLinearSoftmax(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t axis_;
+  int64_t opset_;
+
+  // exp(-d * x_scale) for the 256 differences d between the maximum and an input value, when x_scale is const.
+  std::vector<float> fixed_exp_table_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
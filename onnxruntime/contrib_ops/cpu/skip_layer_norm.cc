@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -23,6 +24,60 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+namespace {
+
+template <typename T>
+void ComputeSkipLayerNorm(const T* p_input, const T* p_skip, const T* gamma_data, const T* beta_data,
+                          const T* bias_data, T* p_output, int64_t hidden_size, float epsilon, float* /*work_buffer*/) {
+  T mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    T value = p_input[h] + p_skip[h];
+    if (nullptr != bias_data) {
+      value += bias_data[h];
+    }
+    p_output[h] = value;
+    mean += value;
+    mean_square += value * value;
+  }
+
+  mean = mean / hidden_size;
+  mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon);
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    if (nullptr == beta_data) {
+      p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
+    } else {
+      p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
+    }
+  }
+}
+
+// The skip and bias additions, the statistics and the normalization of a float row are vectorized by MLAS.
+void ComputeSkipLayerNorm(const float* p_input, const float* p_skip, const float* gamma_data, const float* beta_data,
+                          const float* bias_data, float* p_output, int64_t hidden_size, float epsilon,
+                          float* /*work_buffer*/) {
+  MlasLayerNormalization(p_input, p_skip, bias_data, gamma_data, beta_data, p_output, static_cast<size_t>(hidden_size),
+                         epsilon, false, nullptr, nullptr);
+}
+
+// A half precision row is widened to the work buffer and normalized in single precision.
+void ComputeSkipLayerNorm(const MLFloat16* p_input, const MLFloat16* p_skip, const MLFloat16* gamma_data,
+                          const MLFloat16* beta_data, const MLFloat16* bias_data, MLFloat16* p_output,
+                          int64_t hidden_size, float epsilon, float* work_buffer) {
+  MlasLayerNormalizationHalf(reinterpret_cast<const unsigned short*>(p_input),
+                             reinterpret_cast<const unsigned short*>(p_skip),
+                             reinterpret_cast<const unsigned short*>(bias_data),
+                             reinterpret_cast<const unsigned short*>(gamma_data),
+                             reinterpret_cast<const unsigned short*>(beta_data),
+                             reinterpret_cast<unsigned short*>(p_output), static_cast<size_t>(hidden_size), epsilon,
+                             false, nullptr, nullptr, work_buffer);
+}
+
+}  // namespace
 
 template <typename T>
 SkipLayerNorm<T>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
@@ -98,38 +153,24 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
 
   T* output_data = output->MutableData<T>();
 
-  concurrency::ThreadPool::TryBatchParallelFor(
-      p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
-      [&](ptrdiff_t task_idx) {
-        const T* p_input = input_data + task_idx * hidden_size;
-        const T* p_skip = skip_data + task_idx * hidden_size;
-        T* p_output = output_data + task_idx * hidden_size;
-
-        T mean = 0;
-        T mean_square = 0;
-
-        for (int64_t h = 0; h < hidden_size; h++) {
-          T value = p_input[h] + p_skip[h];
-          if (nullptr != bias_data) {
-            value += bias_data[h];
-          }
-          p_output[h] = value;
-          mean += value;
-          mean_square += value * value;
-        }
+  // Rows are normalized in ranges, so that the work buffer of the half precision rows is allocated once per range.
+  const double bytes_per_row = static_cast<double>(hidden_size * sizeof(T));
+  const TensorOpCost cost{4 * bytes_per_row, bytes_per_row, static_cast<double>(hidden_size * 8)};
 
-        mean = mean / hidden_size;
-        mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
+  concurrency::ThreadPool::TryParallelFor(
+      p_ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(task_count), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> work_buffer;
+        if (std::is_same<T, MLFloat16>::value) {
+          work_buffer.resize(static_cast<size_t>(hidden_size));
+        }
 
-        for (int64_t h = 0; h < hidden_size; h++) {
-          if (nullptr == beta_data) {
-            p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
-          } else {
-            p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
-          }
+        for (std::ptrdiff_t task_idx = first; task_idx < last; task_idx++) {
+          ComputeSkipLayerNorm(input_data + task_idx * hidden_size, skip_data + task_idx * hidden_size, gamma_data,
+                               beta_data, bias_data, output_data + task_idx * hidden_size, hidden_size, epsilon_,
+                               work_buffer.data());
         }
-      },
-      0);
+      });
 
   return Status::OK();
 }
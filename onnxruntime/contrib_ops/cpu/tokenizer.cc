@@ -5,6 +5,7 @@
 #include "core/common/utf8_util.h"
 #include "core/framework/tensor.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "re2/re2.h"
 
 namespace onnxruntime {
@@ -30,11 +31,21 @@ class Tokenizer final : public OpKernel {
                          size_t N, size_t C,
                          gsl::span<const int64_t> input_dims) const;
 
+  Status SeparatorTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const;
+
+  Status ExpressionTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const;
+
+  Status OutputTokens(OpKernelContext* ctx, const std::vector<std::vector<re2::StringPiece>>& rows,
+                      size_t max_tokens, gsl::span<const int64_t> input_dims) const;
+
   bool mark_{false};
   std::string pad_value_;
   int64_t mincharnum_{0};
   bool char_tokenezation_{false};
   std::vector<std::unique_ptr<re2::RE2>> separators_;
+  // The separators without regular expression syntax, searched for with a plain substring
+  // search instead of the regex engine. Empty for the other separators.
+  std::vector<std::string> separator_literals_;
   std::unique_ptr<re2::RE2> regex_;
 };
 
@@ -51,6 +62,20 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 namespace tokenizer_details {
 constexpr char start_text = 0x2;
 constexpr char end_text = 0x3;
+
+bool IsLiteral(const std::string& pattern) {
+  return !pattern.empty() && pattern.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+}
+
+// The rows are tokenized in parallel, the cost of a row is proportional to its length.
+TensorOpCost RowCost(const std::string* input_data, size_t count) {
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < count; ++i) {
+    total_bytes += input_data[i].size();
+  }
+  const double average_bytes = static_cast<double>(total_bytes) / static_cast<double>(count) + 1.0;
+  return TensorOpCost{average_bytes, average_bytes * 2.0, average_bytes * 16.0};
+}
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
@@ -98,6 +123,7 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
           ORT_THROW("Can not digest separators: ", sep, " ", regex->error());
         }
         separators_.push_back(std::move(regex));
+        separator_literals_.push_back(IsLiteral(sep) ? sep : std::string());
       }
     } else {
       // Use tokenexp
@@ -154,252 +180,234 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   TensorShape output_shape(output_dims);
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->template MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      (void)result;
-      assert(token_idx + tlen <= str_len);
-      *(output_data + output_index) = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (static_cast<size_t>(mark_) * 2) <= max_tokens);
-    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-    ++curr_input;
-  }
+
+  // Every row owns max_tokens consecutive output strings
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(N * C), RowCost(input_data, N * C),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last_row) {
+        for (std::ptrdiff_t row_idx = first; row_idx < last_row; ++row_idx) {
+          const auto& s = input_data[row_idx];
+          size_t output_index = static_cast<size_t>(row_idx) * max_tokens;
+          if (mark_) {
+            (output_data + output_index)->assign(&start_text, 1);
+            ++output_index;
+          }
+          size_t tokens = 0;
+          const size_t str_len = s.size();
+          for (size_t token_idx = 0; token_idx < str_len;) {
+            size_t tlen = 0;
+            bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+            assert(result);
+            (void)result;
+            assert(token_idx + tlen <= str_len);
+            (output_data + output_index)->assign(s.data() + token_idx, tlen);
+            ++output_index;
+            token_idx += tlen;
+            ++tokens;
+          }
+          if (mark_) {
+            (output_data + output_index)->assign(&end_text, 1);
+            ++output_index;
+          }
+          // Padding strings
+          assert(tokens + (static_cast<size_t>(mark_) * 2) <= max_tokens);
+          const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - tokens;
+          for (size_t p = 0; p < pads; ++p) {
+            *(output_data + output_index) = pad_value_;
+            ++output_index;
+          }
+        }
+      });
   return Status::OK();
 }
 
-Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
-                                               size_t N, size_t C,
-                                               gsl::span<const int64_t> input_dims) const {
+Status Tokenizer::SeparatorTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const {
   using namespace re2;
-  std::vector<std::vector<StringPiece>> rows;
-  rows.reserve(N * C);
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  // Scan all strings and attempt to find separators in them
-  // collect all the output tokens here
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t utf8_chars = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-
-    std::vector<StringPiece> row{s};
-
-    for (const auto& sep : separators_) {
-      std::vector<StringPiece> tokens;
-      for (const auto& text : row) {
-        const auto end_pos = text.length();
-        size_t start_pos = 0;
-        StringPiece submatch;
+  size_t utf8_chars = 0;  // length in utf8 chars
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                     utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
+  }
 
-        bool match = true;
-        do {
-          match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+  row.assign(1, StringPiece(s));
+
+  std::vector<StringPiece> tokens;
+  for (size_t sep_idx = 0; sep_idx < separators_.size(); ++sep_idx) {
+    const auto& sep = separators_[sep_idx];
+    const auto& literal = separator_literals_[sep_idx];
+    tokens.clear();
+    for (const auto& text : row) {
+      const auto end_pos = text.length();
+      size_t start_pos = 0;
+      StringPiece submatch;
+
+      bool match = true;
+      do {
+        if (!literal.empty()) {
+          // The leftmost occurrence is the match of the regex as well,
+          // a UTF-8 sequence can not match in the middle of another one.
+          const auto found = text.find(StringPiece(literal), start_pos);
+          match = found != StringPiece::npos;
           if (match) {
-            // Record  pos/len
-            assert(submatch.data() != nullptr);
-            size_t match_pos = submatch.data() - text.data();
-            assert(match_pos >= start_pos);
-            auto token_len = match_pos - start_pos;
-            utf8_chars = 0;
-            bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                                  token_len, utf8_chars);
-            if (!valid) {
-              return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                            "Match contains invalid utf8 chars: " + submatch.as_string());
-            }
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, token_len);
-            }
-            // Update starting position
-            // Guard against empty string match
-            auto match_len = submatch.length();
-            if (match_len > 0) {
-              start_pos = match_pos + match_len;
-            } else {
-              size_t bytes = 0;
-              utf8_bytes(*submatch.data(), bytes);
-              start_pos = match_pos + bytes;
-            }
+            submatch = StringPiece(text.data() + found, literal.size());
+          }
+        } else {
+          match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+        }
+        if (match) {
+          // Record  pos/len
+          assert(submatch.data() != nullptr);
+          size_t match_pos = submatch.data() - text.data();
+          assert(match_pos >= start_pos);
+          auto token_len = match_pos - start_pos;
+          utf8_chars = 0;
+          bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                                token_len, utf8_chars);
+          if (!valid) {
+            return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                          "Match contains invalid utf8 chars: " + submatch.as_string());
+          }
+          if (utf8_chars >= size_t(mincharnum_)) {
+            tokens.emplace_back(text.data() + start_pos, token_len);
+          }
+          // Update starting position
+          // Guard against empty string match
+          auto match_len = submatch.length();
+          if (match_len > 0) {
+            start_pos = match_pos + match_len;
           } else {
-            // record trailing token
-            auto trailing_len = end_pos - start_pos;
-            utf8_chars = 0;
-            utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                     trailing_len, utf8_chars);
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, trailing_len);
-            }
+            size_t bytes = 0;
+            utf8_bytes(*submatch.data(), bytes);
+            start_pos = match_pos + bytes;
           }
-        } while (match);
-      }  // row
-      // Replace the row with the results of this tokenezation
-      row.swap(tokens);
-    }  // separators_
-    max_tokens = std::max(max_tokens, row.size());
-    rows.push_back(std::move(row));
-    ++curr_input;
-  }
-
-  std::vector<int64_t> output_dims(input_dims.begin(), input_dims.end());
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
-  }
+        } else {
+          // record trailing token
+          auto trailing_len = end_pos - start_pos;
+          utf8_chars = 0;
+          utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                   trailing_len, utf8_chars);
+          if (utf8_chars >= size_t(mincharnum_)) {
+            tokens.emplace_back(text.data() + start_pos, trailing_len);
+          }
+        }
+      } while (match);
+    }  // row
+    // Replace the row with the results of this tokenezation
+    row.swap(tokens);
+  }  // separators_
+  return Status::OK();
+}
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
+Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
+                                               size_t N, size_t C,
+                                               gsl::span<const int64_t> input_dims) const {
+  auto X = ctx->Input<Tensor>(0);
+  auto const input_data = X->template Data<std::string>();
+  const size_t row_count = N * C;
 
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
+  // Scan all strings and attempt to find separators in them
+  // collect all the output tokens here
+  std::vector<std::vector<re2::StringPiece>> rows(row_count);
+  std::vector<Status> row_status(row_count);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(row_count), RowCost(input_data, row_count),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row_idx = first; row_idx < last; ++row_idx) {
+          row_status[row_idx] = SeparatorTokenize(input_data[row_idx], rows[row_idx]);
+        }
+      });
 
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  size_t output_index = 0;
-  curr_input = input_data;
-  for (auto& row : rows) {
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.size());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
+  size_t max_tokens = 0;
+  for (size_t row_idx = 0; row_idx < row_count; ++row_idx) {
+    ORT_RETURN_IF_ERROR(row_status[row_idx]);
+    max_tokens = std::max(max_tokens, rows[row_idx].size());
   }
-  return Status::OK();
+
+  return OutputTokens(ctx, rows, max_tokens, input_dims);
 }
 
-Status Tokenizer::TokenExpression(OpKernelContext* ctx,
-                                  size_t N, size_t C,
-                                  gsl::span<const int64_t> input_dims) const {
+Status Tokenizer::ExpressionTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const {
   using namespace re2;
-  // Represents a token that will be output after
-  // first is the index, second is the size;
-  std::vector<std::vector<StringPiece>> tokens;
-  tokens.reserve(N * C);
-
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  while (curr_input != last) {
-    const auto& s = *curr_input;
+  size_t utf8_chars = 0;
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                     utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
+  }
 
-    size_t utf8_chars = 0;
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
+  StringPiece text(s);
+  const auto end_pos = s.length();
+  size_t start_pos = 0;
+  StringPiece submatch;
+
+  bool match = true;
+  do {
+    match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+    if (match) {
+      // Record  pos/len
+      assert(submatch.data() != nullptr);
+      size_t match_pos = submatch.data() - s.data();
+      assert(match_pos >= start_pos);
+      // Guard against empty match and make
+      // sure we make progress either way
+      auto token_len = submatch.length();
+      utf8_chars = 0;
+      if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
+        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                      "Match contains invalid utf8 chars: " + submatch.as_string());
+      }
+      if (utf8_chars >= size_t(mincharnum_)) {
+        row.push_back(submatch);
+        start_pos = match_pos + token_len;
+      } else {
+        size_t bytes = 0;
+        utf8_bytes(*submatch.data(), bytes);
+        start_pos = match_pos + bytes;
+      }
     }
+  } while (match);
+  return Status::OK();
+}
 
-    tokens.emplace_back();
-    auto& row = tokens.back();
-
-    StringPiece text(s);
-    const auto end_pos = s.length();
-    size_t start_pos = 0;
-    StringPiece submatch;
-
-    bool match = true;
-    do {
-      match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-      if (match) {
-        // Record  pos/len
-        assert(submatch.data() != nullptr);
-        size_t match_pos = submatch.data() - s.data();
-        assert(match_pos >= start_pos);
-        // Guard against empty match and make
-        // sure we make progress either way
-        auto token_len = submatch.length();
-        utf8_chars = 0;
-        if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Match contains invalid utf8 chars: " + submatch.as_string());
-        }
-        if (utf8_chars >= size_t(mincharnum_)) {
-          row.push_back(submatch);
-          start_pos = match_pos + token_len;
-        } else {
-          size_t bytes = 0;
-          utf8_bytes(*submatch.data(), bytes);
-          start_pos = match_pos + bytes;
+Status Tokenizer::TokenExpression(OpKernelContext* ctx,
+                                  size_t N, size_t C,
+                                  gsl::span<const int64_t> input_dims) const {
+  auto X = ctx->Input<Tensor>(0);
+  auto const input_data = X->template Data<std::string>();
+  const size_t row_count = N * C;
+
+  std::vector<std::vector<re2::StringPiece>> rows(row_count);
+  std::vector<Status> row_status(row_count);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(row_count), RowCost(input_data, row_count),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row_idx = first; row_idx < last; ++row_idx) {
+          row_status[row_idx] = ExpressionTokenize(input_data[row_idx], rows[row_idx]);
         }
-      }
-    } while (match);
-    max_tokens = std::max(max_tokens, row.size());
-    ++curr_input;
+      });
+
+  size_t max_tokens = 0;
+  for (size_t row_idx = 0; row_idx < row_count; ++row_idx) {
+    ORT_RETURN_IF_ERROR(row_status[row_idx]);
+    max_tokens = std::max(max_tokens, rows[row_idx].size());
   }
 
-  // Check for empty output
+  return OutputTokens(ctx, rows, max_tokens, input_dims);
+}
+
+Status Tokenizer::OutputTokens(OpKernelContext* ctx, const std::vector<std::vector<re2::StringPiece>>& rows,
+                               size_t max_tokens, gsl::span<const int64_t> input_dims) const {
   std::vector<int64_t> output_dims(input_dims.begin(), input_dims.end());
   // Check if we have no output due to either empty input
   // everything is a separator
@@ -420,41 +428,36 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->template MutableData<std::string>();
 
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  curr_input = input_data;
-  size_t output_index = 0;
-  for (const auto& row : tokens) {
-    assert(curr_input != last);
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.length());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
-  }
-
+  // Every row owns max_tokens consecutive output strings, the tokens are copied
+  // straight from the input strings they point into.
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(rows.size()),
+      TensorOpCost{0.0, static_cast<double>(max_tokens) * 16.0, static_cast<double>(max_tokens) * 8.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row_idx = first; row_idx < last; ++row_idx) {
+          const auto& row = rows[row_idx];
+          size_t output_index = static_cast<size_t>(row_idx) * max_tokens;
+          if (mark_) {
+            (output_data + output_index)->assign(&start_text, 1);
+            ++output_index;
+          }
+          // Output tokens for this row
+          for (const auto& token : row) {
+            (output_data + output_index)->assign(token.data(), token.size());
+            ++output_index;
+          }
+          if (mark_) {
+            (output_data + output_index)->assign(&end_text, 1);
+            ++output_index;
+          }
+          const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - row.size();
+          for (size_t p = 0; p < pads; ++p) {
+            *(output_data + output_index) = pad_value_;
+            ++output_index;
+          }
+          assert(output_index == static_cast<size_t>(row_idx + 1) * max_tokens);
+        }
+      });
   return Status::OK();
 }
 
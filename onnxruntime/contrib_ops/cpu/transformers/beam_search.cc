@@ -116,25 +116,13 @@ struct BeamSearchState : public IBeamSearchState<T> {
 struct BeamSearchCpuState : public IBeamSearchCpuState {
   Sequences sequences;
 
-  void Init(AllocatorPtr allocator, size_t batch_beam_size, int max_length, bool is_cuda) {
+  void Init(AllocatorPtr allocator, size_t batch_beam_size, int max_length) {
     this->sequence_lengths = AllocateBuffer<int32_t>(allocator, sequence_lengths_buffer_, batch_beam_size);
     this->sequences_space = AllocateBuffer<int32_t>(allocator, sequences_space_buffer_, SafeInt<size_t>(2) * batch_beam_size * max_length);
-
-    if (is_cuda) {
-      // buffers used by CUDA operator but not by CPU operator.
-      this->topk_scores = AllocateBuffer<float>(allocator, topk_scores_buffer_, 2 * batch_beam_size);
-      this->topk_tokens = AllocateBuffer<int32_t>(allocator, topk_tokens_buffer_, 2 * batch_beam_size);
-      this->topk_indices = AllocateBuffer<int32_t>(allocator, topk_indices_buffer_, 2 * batch_beam_size);
-      this->final_beam_scores = AllocateBuffer<float>(allocator, final_beam_scores_buffer_, batch_beam_size);
-    }
   }
 
  private:
-  BufferUniquePtr final_beam_scores_buffer_;
   BufferUniquePtr sequence_lengths_buffer_;
-  BufferUniquePtr topk_scores_buffer_;
-  BufferUniquePtr topk_tokens_buffer_;
-  BufferUniquePtr topk_indices_buffer_;
   BufferUniquePtr sequences_space_buffer_;
 };
 
@@ -151,6 +139,7 @@ class BeamSearchImpl {
                  const BeamSearchDeviceHelper::CreateInputsFunc& create_inputs_func,
                  const BeamSearchDeviceHelper::AddToFeedsFunc& add_to_feeds_func,
                  const BeamSearchDeviceHelper::TopkFunc& topk_func,
+                 const BeamSearchDeviceHelper::CreateBeamScorerFunc& create_beam_scorer_func,
                  const BeamSearchDeviceHelper::ProcessLogitsFunc<T>& process_logits_func,
                  const BeamSearchDeviceHelper::InitBeamStateFunc<T>& init_beam_state_func,
                  const BeamSearchDeviceHelper::DeviceCopyFunc<float>& device_copy_func,
@@ -168,6 +157,7 @@ class BeamSearchImpl {
         create_inputs_func_(create_inputs_func),
         add_to_feeds_func_(add_to_feeds_func),
         topk_func_(topk_func),
+        create_beam_scorer_func_(create_beam_scorer_func),
         process_logits_func_(process_logits_func),
         init_beam_state_func_(init_beam_state_func),
         device_copy_func_(device_copy_func),
@@ -219,6 +209,12 @@ class BeamSearchImpl {
                        AllocatorPtr& allocator,
                        int counter);
 
+  // Set fetches of present state to use one of the buffers reused across iterations.
+  void SetPresentFetches(const std::vector<OrtValue>& feeds,
+                         std::vector<OrtValue>& fetches,
+                         BufferUniquePtr& present_buffer,
+                         size_t present_elements_per_layer);
+
   const IConsoleDumper* GetConsoleDumper() const { return IsCuda() ? cuda_dumper_ : &(cpu_dumper_); }
 
   OpKernelContextInternal& context_;
@@ -240,7 +236,7 @@ class BeamSearchImpl {
 
   LogitsProcessorList logits_processors_;
 
-  std::unique_ptr<BeamSearchScorer> beam_scorer_;
+  std::unique_ptr<IBeamScorer> beam_scorer_;
 
   AllocatorPtr cpu_allocator_;
   AllocatorPtr temp_space_allocator_;
@@ -249,6 +245,7 @@ class BeamSearchImpl {
   BeamSearchDeviceHelper::CreateInputsFunc create_inputs_func_;
   BeamSearchDeviceHelper::AddToFeedsFunc add_to_feeds_func_;
   BeamSearchDeviceHelper::TopkFunc topk_func_;
+  BeamSearchDeviceHelper::CreateBeamScorerFunc create_beam_scorer_func_;
   BeamSearchDeviceHelper::ProcessLogitsFunc<T> process_logits_func_;
   BeamSearchDeviceHelper::InitBeamStateFunc<T> init_beam_state_func_;
   BeamSearchDeviceHelper::DeviceCopyFunc<float> device_copy_func_;
@@ -303,6 +300,7 @@ Status BeamSearch::Compute(OpKernelContext* ctx) const {
                                create_inputs_func_ ? create_inputs_func_ : BeamSearchCpuDeviceHelper::CreateInputs,
                                add_to_feeds_func_ ? add_to_feeds_func_ : BeamSearchCpuDeviceHelper::AddToFeeds,
                                topk_func_ ? topk_func_ : BeamSearchCpuDeviceHelper::TopK,
+                               create_beam_scorer_func_,
                                process_logits_func_ ? process_logits_func_ : BeamSearchCpuDeviceHelper::ProcessLogits<float>,
                                init_beam_state_func_ ? init_beam_state_func_ : BeamSearchCpuDeviceHelper::InitBeamState<float>,
                                device_copy_func_ ? device_copy_func_ : BeamSearchCpuDeviceHelper::DeviceCopy<float>,
@@ -315,6 +313,7 @@ Status BeamSearch::Compute(OpKernelContext* ctx) const {
                                    create_inputs_func_ ? create_inputs_func_ : BeamSearchCpuDeviceHelper::CreateInputs,
                                    add_to_feeds_func_ ? add_to_feeds_func_ : BeamSearchCpuDeviceHelper::AddToFeeds,
                                    topk_func_ ? topk_func_ : BeamSearchCpuDeviceHelper::TopK,
+                                   create_beam_scorer_func_,
                                    process_logits_fp16_func_,
                                    init_beam_state_fp16_func_,
                                    device_copy_func_,
@@ -456,26 +455,31 @@ Status BeamSearchImpl<T>::GenerateNextToken(
   // Process logits to get next token scores
   ORT_RETURN_IF_ERROR(ProcessLogits(logits, beam_state, cpu_state, temp_space_allocator_, counter));
 
+  // The beam scores of the scorer are in the memory of the device it runs on.
   gsl::span<float>& beam_scores = beam_scorer_->GetNextScores();
   // It is optional to clone beam_scores. Change it to use same buffer also works for CPU:
   //    beam_state.beam_scores = beam_scores
   // Here we make a copy to reduce the coupling with little cost (the buffer size is small).
-  ORT_RETURN_IF_ERROR(device_copy_func_(beam_state.beam_scores, beam_scores, cuda_stream_, DeviceCopyDirection::hostToDevice));
+  ORT_RETURN_IF_ERROR(device_copy_func_(beam_state.beam_scores, beam_scores, cuda_stream_,
+                                        IsCuda() ? DeviceCopyDirection::deviceToDevice : DeviceCopyDirection::hostToHost));
 
   beam_next_tokens = beam_scorer_->GetNextTokens();
   beam_indices = beam_scorer_->GetNextIndices();
 
 #ifdef DEBUG_BEAM_SEARCH
-  cpu_dumper_.Print("beam_scores after scorer", beam_scores.data(), parameters_->batch_size, parameters_->num_beams);
+  GetConsoleDumper()->Print("beam_scores after scorer", beam_scores.data(), parameters_->batch_size, parameters_->num_beams);
   cpu_dumper_.Print("beam_next_tokens after scorer", beam_next_tokens.data(), parameters_->batch_size, parameters_->num_beams);
   cpu_dumper_.Print("beam_indices after scorer", beam_indices.data(), parameters_->batch_size, parameters_->num_beams);
 #endif
 
-  cpu_state.sequences.AppendNextTokenToSequences(beam_indices, beam_next_tokens);
+  // The CUDA scorer keeps the sequences on device, and appends the next tokens to them in Process.
+  if (!IsCuda()) {
+    cpu_state.sequences.AppendNextTokenToSequences(beam_indices, beam_next_tokens);
 
 #ifdef DEBUG_BEAM_SEARCH
-  cpu_state.sequences.PrintSequences(&cpu_dumper_);
+    cpu_state.sequences.PrintSequences(&cpu_dumper_);
 #endif
+  }
   return Status::OK();
 }
 
@@ -491,6 +495,32 @@ Status BeamSearchImpl<T>::UpdateFeeds(
                             beam_next_tokens, beam_indices, parameters_->num_beams, GetConsoleDumper());
 }
 
+template <typename T>
+void BeamSearchImpl<T>::SetPresentFetches(const std::vector<OrtValue>& feeds,
+                                          std::vector<OrtValue>& fetches,
+                                          BufferUniquePtr& present_buffer,
+                                          size_t present_elements_per_layer) {
+  const int num_layers = gpt_subgraph_.num_subgraph_outputs - 1;
+  if (present_buffer == nullptr) {
+    size_t bytes = SafeInt<size_t>(sizeof(T)) * present_elements_per_layer * num_layers;
+    present_buffer = BufferUniquePtr(temp_space_allocator_->Alloc(bytes), BufferDeleter(temp_space_allocator_));
+  }
+
+  // Present state has one more token than past state: (2, batch_beam_size, num_heads, past_seq_len + 1, head_size).
+  // Logits are left unallocated in fetches, so they will be allocated by the subgraph.
+  TensorShape present_shape = feeds[3].Get<Tensor>().Shape();
+  present_shape[3] += 1;
+  ORT_ENFORCE(static_cast<size_t>(present_shape.Size()) <= present_elements_per_layer);
+
+  fetches.clear();
+  fetches.resize(static_cast<size_t>(gpt_subgraph_.num_subgraph_outputs));
+  T* data = reinterpret_cast<T*>(present_buffer.get());
+  for (int i = 0; i < num_layers; i++) {
+    Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), present_shape, data + i * present_elements_per_layer,
+                         temp_space_allocator_->Info(), fetches[static_cast<size_t>(i) + 1]);
+  }
+}
+
 template <typename T>
 Status BeamSearchImpl<T>::Execute(const FeedsFetchesManager& feeds_fetches_manager) {
   auto status = Status::OK();
@@ -512,26 +542,37 @@ Status BeamSearchImpl<T>::Execute(const FeedsFetchesManager& feeds_fetches_manag
   parameters_->output_scores = (output_scores != nullptr);
 
   std::vector<OrtValue> feeds;
-  // TODO: allocate fetches. use ping-pong buffers for past state.
   std::vector<OrtValue> fetches;
 
+  // After the first iteration, present state is fetched into ping-pong buffers: the present state of one iteration
+  // is fed as the past state of next iteration, so two buffers are used in turn. Each can hold max_length tokens.
+  BufferUniquePtr present_buffers[2];
+  const size_t present_elements_per_layer = SafeInt<size_t>(2) * parameters_->BatchBeamSize() *
+                                            parameters_->num_heads * parameters_->max_length * parameters_->head_size;
+
   // Initialize resources
   onnxruntime::OrtStlAllocator<HypothesisScore> hypothesis_score_allocator(cpu_allocator_);
   onnxruntime::OrtStlAllocator<BeamHypotheses> beam_hyps_allocator(cpu_allocator_);
-  beam_scorer_ = std::make_unique<BeamSearchScorer>(static_cast<size_t>(parameters_->batch_size),
-                                                    static_cast<size_t>(parameters_->num_beams),
-                                                    static_cast<size_t>(parameters_->max_length),
-                                                    parameters_->length_penalty,
-                                                    parameters_->early_stopping,
-                                                    static_cast<size_t>(parameters_->num_return_sequences),
-                                                    parameters_->pad_token_id,
-                                                    parameters_->eos_token_id,
-                                                    hypothesis_score_allocator,
-                                                    beam_hyps_allocator);
-  beam_scorer_->Initialize(cpu_allocator_, parameters_->sequence_length);
+  if (create_beam_scorer_func_) {
+    // The scorer runs on the device, so its buffers are allocated by the temp space allocator of the device.
+    beam_scorer_ = create_beam_scorer_func_(parameters_, cpu_allocator_, cuda_stream_);
+    beam_scorer_->Initialize(temp_space_allocator_, parameters_->sequence_length);
+  } else {
+    beam_scorer_ = std::make_unique<BeamSearchScorer>(static_cast<size_t>(parameters_->batch_size),
+                                                      static_cast<size_t>(parameters_->num_beams),
+                                                      static_cast<size_t>(parameters_->max_length),
+                                                      parameters_->length_penalty,
+                                                      parameters_->early_stopping,
+                                                      static_cast<size_t>(parameters_->num_return_sequences),
+                                                      parameters_->pad_token_id,
+                                                      parameters_->eos_token_id,
+                                                      hypothesis_score_allocator,
+                                                      beam_hyps_allocator);
+    beam_scorer_->Initialize(cpu_allocator_, parameters_->sequence_length);
+  }
 
   BeamSearchCpuState cpu_state;
-  cpu_state.Init(cpu_allocator_, static_cast<size_t>(parameters_->BatchBeamSize()), parameters_->max_length, IsCuda());
+  cpu_state.Init(cpu_allocator_, static_cast<size_t>(parameters_->BatchBeamSize()), parameters_->max_length);
 
   // buffer in GPU for input_ids, position_ids and attention_mask
   // size_t buffer_bytes = SafeInt<size_t>(sizeof(int32_t) + sizeof(int32_t) + sizeof(int32_t)) * parameters_->batch_size * parameters_->num_beams * parameters_->sequence_length;
@@ -587,8 +628,12 @@ Status BeamSearchImpl<T>::Execute(const FeedsFetchesManager& feeds_fetches_manag
     dumper->Print("***CurrentLength", cur_len, true);
 #endif
 
+    if (iteration_counter > 1) {
+      SetPresentFetches(feeds, fetches, present_buffers[iteration_counter % 2], present_elements_per_layer);
+    }
+
     status = utils::ExecuteSubgraph(session_state_, feeds_fetches_manager, feeds, fetches, {},
-                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetRunTermination(), context_.Logger());
 
     ORT_RETURN_IF_ERROR(status);
 
@@ -615,12 +660,8 @@ Status BeamSearchImpl<T>::Execute(const FeedsFetchesManager& feeds_fetches_manag
     fetches.clear();
   }
 
+  // The beam scores are in the memory of the device that the scorer runs on.
   gsl::span<const float> final_beam_scores(beam_state.beam_scores.data(), beam_state.beam_scores.size());
-  if (IsCuda()) {
-    ORT_RETURN_IF_ERROR(device_copy_func_(cpu_state.final_beam_scores, final_beam_scores, nullptr, DeviceCopyDirection::deviceToHost));
-    final_beam_scores = gsl::make_span<const float>(cpu_state.final_beam_scores.data(), cpu_state.final_beam_scores.size());
-  }
-
   beam_scorer_->Finalize(&(cpu_state.sequences),
                          final_beam_scores,
                          output_sequences,
@@ -39,10 +39,12 @@ class BeamSearch : public IControlFlowKernel {
   void SetDeviceHelpers(
       // const BeamSearchDeviceHelper::CreateInputsFunc& create_inputs_func,
       const BeamSearchDeviceHelper::AddToFeedsFunc& add_to_feeds_func,
-      const BeamSearchDeviceHelper::TopkFunc& topk_func) {
+      const BeamSearchDeviceHelper::TopkFunc& topk_func,
+      const BeamSearchDeviceHelper::CreateBeamScorerFunc& create_beam_scorer_func) {
     // create_inputs_func_ = create_inputs_func;
     add_to_feeds_func_ = add_to_feeds_func;
     topk_func_ = topk_func;
+    create_beam_scorer_func_ = create_beam_scorer_func;
   }
 
   // Type dependent helpers: float
@@ -72,6 +74,7 @@ class BeamSearch : public IControlFlowKernel {
   BeamSearchDeviceHelper::CreateInputsFunc create_inputs_func_;
   BeamSearchDeviceHelper::AddToFeedsFunc add_to_feeds_func_;
   BeamSearchDeviceHelper::TopkFunc topk_func_;
+  BeamSearchDeviceHelper::CreateBeamScorerFunc create_beam_scorer_func_;
   BeamSearchDeviceHelper::ProcessLogitsFunc<float> process_logits_func_;
   BeamSearchDeviceHelper::InitBeamStateFunc<float> init_beam_state_func_;
   BeamSearchDeviceHelper::DeviceCopyFunc<float> device_copy_func_;
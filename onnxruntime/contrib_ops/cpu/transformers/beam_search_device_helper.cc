@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "core/providers/cpu/math/top_k.h"
 #include "core/providers/cpu/math/softmax_shared.h"
 #include "core/common/safeint.h"
@@ -227,6 +228,64 @@ Status ProcessLogits(const OrtValue& logits,                                 //
   dumper->Print("next_token_logits", next_token_logits.data(), batch_size, num_beams, vocab_size);
 #endif
 
+  const unsigned top_k = static_cast<unsigned>(2 * num_beams);
+
+  // Without logits processors and scores output, the scores are only used by the top-k selection below. The beam
+  // score is the same for all the tokens of a beam, so the top-k candidates of a batch are among the top-k
+  // candidates of its beams, which are selected from the logits with a fused top-k and log softmax.
+  if (!output_scores && logits_processors->Empty()) {
+    int64_t next_token_logits_dims[] = {static_cast<int64_t>(batch_beam_size), static_cast<int64_t>(vocab_size)};
+    TensorShape next_token_logits_shape(&next_token_logits_dims[0], 2);
+    OrtValue next_token_logits_value;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), next_token_logits_shape,
+                         input_length > 1 ? next_token_logits.data() : const_cast<T*>(logits_data),
+                         allocator->Info(), next_token_logits_value);
+
+    std::unique_ptr<Tensor> beam_topk_scores;
+    std::unique_ptr<Tensor> beam_topk_tokens;
+    ORT_RETURN_IF_ERROR(GetTopKSoftmax<T>(&next_token_logits_value.Get<Tensor>(), top_k, true, allocator, thread_pool,
+                                          beam_topk_scores, beam_topk_tokens));
+    const T* beam_scores_data = beam_topk_scores->Data<T>();
+    const int64_t* beam_tokens_data = beam_topk_tokens->Data<int64_t>();
+
+    // Merge the candidates of the beams of each batch. Ties are broken by the index in the flattened
+    // (num_beams * vocab_size) scores, like the top-k selection over all the scores.
+    std::vector<T> next_scores_data(SafeInt<size_t>(batch_size) * top_k);
+    std::vector<std::pair<T, int64_t>> candidates(SafeInt<size_t>(num_beams) * top_k);
+    auto better = [](const std::pair<T, int64_t>& lhs, const std::pair<T, int64_t>& rhs) {
+      return lhs.first > rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+    };
+    for (int i = 0; i < batch_size; i++) {
+      for (int j = 0; j < num_beams; j++) {
+        const int batch_beam_index = i * num_beams + j;
+        for (unsigned int l = 0; l < top_k; l++) {
+          const size_t offset = static_cast<size_t>(batch_beam_index) * top_k + l;
+          candidates[static_cast<size_t>(j) * top_k + l] = {beam_scores_data[offset] + beam_state->beam_scores[batch_beam_index],
+                                                            static_cast<int64_t>(j) * vocab_size + beam_tokens_data[offset]};
+        }
+      }
+
+      std::partial_sort(candidates.begin(), candidates.begin() + top_k, candidates.end(), better);
+      for (unsigned int l = 0; l < top_k; l++) {
+        const size_t offset = static_cast<size_t>(i) * top_k + l;
+        next_scores_data[offset] = candidates[l].first;
+        beam_state->next_indices[offset] = gsl::narrow_cast<int32_t>(candidates[l].second / vocab_size);
+        beam_state->next_tokens[offset] = gsl::narrow_cast<int32_t>(candidates[l].second % vocab_size);
+      }
+    }
+
+    gsl::span<const T> next_scores(next_scores_data.data(), next_scores_data.size());
+    gsl::span<const int32_t> next_tokens(beam_state->next_tokens.data(), beam_state->next_tokens.size());
+    gsl::span<const int32_t> next_indices(beam_state->next_indices.data(), beam_state->next_indices.size());
+    beam_scorer->Process(
+        sequences,
+        next_scores,
+        next_tokens,
+        next_indices);
+
+    return Status::OK();
+  }
+
   // Get scores for candidates of next token: next_token_scores = log_softmax(next_token_logits, dim=-1)
   gsl::span<T>& next_token_scores = beam_state->next_token_scores;
   ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(batch_beam_size,  // rows
@@ -281,7 +340,6 @@ Status ProcessLogits(const OrtValue& logits,                                 //
   const Tensor& input = next_token_scores_value.Get<Tensor>();
 
   constexpr int axis = 1;
-  const unsigned top_k = static_cast<unsigned>(2 * num_beams);
   constexpr bool largest = true;
   constexpr bool sorted = true;  // results returned in sorted order.
 
@@ -337,34 +395,43 @@ void PickPastState(const std::vector<OrtValue>& last_outputs,
                    gsl::span<const int32_t>& beam_indices,
                    AllocatorPtr allocator,
                    void* /*stream*/) {
+  // The present state is not used after this step, so the beams are reordered in place and the present state
+  // is fed as the past state of next step. Only beams that do not keep their own state are copied.
+  std::vector<transformers::BeamCopyStep> steps;
+  transformers::GetBeamReorderSteps(beam_indices, steps);
+
+  BufferUniquePtr temp_buffer;
+  T* temp_beam = nullptr;
 
   for (size_t i = 1; i < last_outputs.size(); ++i) {
-    const OrtValue& present = last_outputs[i];  // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
+    OrtValue present = last_outputs[i];  // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
     const TensorShape& past_shape = present.Get<Tensor>().Shape();
 
-    // Create a tensor with same shape.
-    // TODO: allocate one buffer for all layers
-    OrtValue past;
-    auto past_type = DataTypeImpl::GetType<T>();
-    Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-
     auto block_size_per_beam = past_shape[2] * past_shape[3] * past_shape[4];
     auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
 
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), past_shape.Size());
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), past_shape.Size());
-    for (gsl::index j = 0; j < beam_indices.length(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * block_size_per_beam, block_size_per_beam);
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * block_size_per_beam, block_size_per_beam);
-
-      gsl::span<T> past_key = past_span.subspan(j * block_size_per_beam, block_size_per_beam);
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * block_size_per_beam, block_size_per_beam);
-      gsl::copy(present_key, past_key);
-      gsl::copy(present_value, past_value);
+    if (temp_beam == nullptr && !steps.empty()) {
+      // The temporary buffer holds key and value of one beam. All layers have the same shape.
+      size_t bytes = SafeInt<size_t>(2) * block_size_per_beam * sizeof(T);
+      temp_buffer = BufferUniquePtr(allocator->Alloc(bytes), BufferDeleter(allocator));
+      temp_beam = reinterpret_cast<T*>(temp_buffer.get());
+    }
+
+    T* present_data = present.GetMutable<Tensor>()->MutableData<T>();
+    auto beam_key = [&](int beam) {
+      return beam == transformers::BeamCopyStep::kTempBeam ? temp_beam : present_data + beam * block_size_per_beam;
+    };
+    auto beam_value = [&](int beam) {
+      return beam == transformers::BeamCopyStep::kTempBeam ? temp_beam + block_size_per_beam
+                                             : present_data + past_key_size + beam * block_size_per_beam;
+    };
+
+    for (const auto& step : steps) {
+      std::copy_n(beam_key(step.source), block_size_per_beam, beam_key(step.target));
+      std::copy_n(beam_value(step.source), block_size_per_beam, beam_value(step.target));
     }
 
-    next_inputs[i + 2] = past;
+    next_inputs[i + 2] = present;
   }
 }
 
@@ -55,6 +55,12 @@ using AddToFeedsFunc = std::function<Status(
     std::vector<OrtValue>& feeds,
     IAllocatorUniquePtr<char>& buffer)>;
 
+// Create the beam scorer. The CPU scorer is used when it is not set.
+using CreateBeamScorerFunc = std::function<std::unique_ptr<transformers::IBeamScorer>(
+    const transformers::IBeamSearchParameters* parameters,
+    AllocatorPtr& cpu_allocator,
+    void* stream)>;
+
 template <typename T>
 using InitBeamStateFunc = std::function<void(
     transformers::IBeamSearchState<T>* beam_state,
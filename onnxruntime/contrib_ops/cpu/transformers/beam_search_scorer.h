@@ -88,11 +88,11 @@ class BeamSearchScorer : public IBeamScorer {
                 Tensor* output_sequences,
                 Tensor* output_sequence_scores) override;
 
-  bool IsDone();
+  bool IsDone() override;
 
-  gsl::span<float>& GetNextScores() { return next_beam_scores_; }
-  gsl::span<int32_t>& GetNextTokens() { return next_beam_tokens_; }
-  gsl::span<int32_t>& GetNextIndices() { return next_beam_indices_; }
+  gsl::span<float>& GetNextScores() override { return next_beam_scores_; }
+  gsl::span<int32_t>& GetNextTokens() override { return next_beam_tokens_; }
+  gsl::span<int32_t>& GetNextIndices() override { return next_beam_indices_; }
 
  private:
   size_t batch_size_;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include "gsl/gsl"
 #include "core/framework/allocator.h"
 #include "core/framework/ort_value.h"
@@ -32,12 +33,6 @@ struct IBeamSearchState {
 struct IBeamSearchCpuState {
   gsl::span<int32_t> sequence_lengths;  // shape (batch_size, num_beams), initial sequence length
   gsl::span<int32_t> sequences_space;   // shape (2, batch_size, num_beams, max_seq_length)
-
-  // The following are used only by CUDA operator for data copied from device.
-  gsl::span<float> topk_scores;        // shape (batch_size, 2*num_beams), scores of topk candidates (K=2*num_beams).
-  gsl::span<int32_t> topk_tokens;      // shape (batch_size, 2*num_beams), tokens of topk candidates.
-  gsl::span<int32_t> topk_indices;     // shape (batch_size, 2*num_beams), beam indices of topk candidates.
-  gsl::span<float> final_beam_scores;  // shape (batch_size, num_beams)
 };
 
 class ISequences {
@@ -51,9 +46,12 @@ class ILogitsProcessorList {
  public:
   virtual ~ILogitsProcessorList() {}
   virtual void Process(const ISequences* sequences, gsl::span<float>& next_token_scores, int step) = 0;
+  virtual bool Empty() const = 0;
 };
 
 // Interface for all scorers for beam search or beam sample.
+// The spans of Process, Finalize and GetNextScores are in the memory of the device the scorer runs on, while
+// GetNextTokens and GetNextIndices are always in CPU memory since they are used to update the subgraph feeds.
 class IBeamScorer {
  public:
   virtual ~IBeamScorer() {}
@@ -69,6 +67,12 @@ class IBeamScorer {
                         gsl::span<const float>& final_beam_scores,
                         Tensor* output_sequences,
                         Tensor* output_sequence_scores) = 0;
+
+  virtual bool IsDone() = 0;
+
+  virtual gsl::span<float>& GetNextScores() = 0;
+  virtual gsl::span<int32_t>& GetNextTokens() = 0;
+  virtual gsl::span<int32_t>& GetNextIndices() = 0;
 };
 
 struct IBeamSearchParameters {
@@ -103,6 +107,67 @@ struct IBeamSearchParameters {
   int num_layers;
 };
 
+// Steps to reorder the states of beams in place: after the steps, beam j has the state of beam beam_indices[j].
+// A step copies the state of beam source to beam target. When source or target is kTempBeam, it refers to
+// a temporary buffer of one beam that saves a state before it is overwritten in a cycle.
+// Beams that keep their own state are not copied.
+struct BeamCopyStep {
+  static constexpr int kTempBeam = -1;
+  int target;
+  int source;
+};
+
+inline void GetBeamReorderSteps(gsl::span<const int32_t> beam_indices, std::vector<BeamCopyStep>& steps) {
+  const int beams = static_cast<int>(beam_indices.size());
+  steps.clear();
+
+  // A beam can be overwritten once no pending copy reads it.
+  std::vector<int> readers(beams, 0);
+  std::vector<bool> pending(beams, false);
+  for (int j = 0; j < beams; j++) {
+    if (beam_indices[j] != j) {
+      pending[j] = true;
+      readers[beam_indices[j]]++;
+    }
+  }
+
+  std::vector<int> ready;
+  for (int j = 0; j < beams; j++) {
+    if (pending[j] && readers[j] == 0) {
+      ready.push_back(j);
+    }
+  }
+
+  while (!ready.empty()) {
+    int j = ready.back();
+    ready.pop_back();
+    steps.push_back({j, beam_indices[j]});
+    pending[j] = false;
+
+    int source = beam_indices[j];
+    if (--readers[source] == 0 && pending[source]) {
+      ready.push_back(source);
+    }
+  }
+
+  // The remaining beams form cycles. Break each cycle by saving its first beam to the temporary buffer.
+  for (int j = 0; j < beams; j++) {
+    if (!pending[j]) {
+      continue;
+    }
+
+    steps.push_back({BeamCopyStep::kTempBeam, j});
+    int target = j;
+    while (beam_indices[target] != j) {
+      steps.push_back({target, beam_indices[target]});
+      pending[target] = false;
+      target = beam_indices[target];
+    }
+    steps.push_back({target, BeamCopyStep::kTempBeam});
+    pending[target] = false;
+  }
+}
+
 class IConsoleDumper {
  public:
   IConsoleDumper() : is_enabled_(true) {}
@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include "core/framework/tensor.h"
+#include "continuous_batching.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+ContinuousBatchingScheduler::ContinuousBatchingScheduler(AllocatorPtr allocator,
+                                                         int num_layers,
+                                                         int num_heads,
+                                                         int head_size,
+                                                         int vocab_size,
+                                                         int eos_token_id,
+                                                         int pad_token_id,
+                                                         int max_batch_size,
+                                                         int page_size,
+                                                         int num_pages)
+    : allocator_(allocator),
+      num_layers_(num_layers),
+      vocab_size_(vocab_size),
+      eos_token_id_(eos_token_id),
+      pad_token_id_(pad_token_id),
+      max_batch_size_(max_batch_size),
+      num_pages_(num_pages),
+      cache_(allocator, num_layers, num_heads, head_size, page_size, num_pages) {
+  ORT_ENFORCE(vocab_size > 0 && max_batch_size > 0);
+}
+
+int ContinuousBatchingScheduler::PagesNeeded(const GenerationRequest& request) const {
+  // The last generated token is not fed to the subgraph, so its key and value are never cached.
+  const int max_tokens = static_cast<int>(request.prompt.size()) + request.max_new_tokens - 1;
+  return (max_tokens + cache_.PageSize() - 1) / cache_.PageSize();
+}
+
+Status ContinuousBatchingScheduler::AddRequest(int request_id, std::vector<int32_t> prompt, int max_new_tokens) {
+  ORT_RETURN_IF(prompt.empty(), "The prompt of request ", request_id, " is empty");
+  ORT_RETURN_IF(max_new_tokens <= 0, "max_new_tokens shall be positive");
+
+  GenerationRequest request{request_id, std::move(prompt), max_new_tokens, {}};
+  const int pages = PagesNeeded(request);
+  ORT_RETURN_IF(pages > num_pages_, "Request ", request_id, " needs ", pages,
+                " pages of KV cache, but the cache has only ", num_pages_, " pages");
+
+  queue_.push_back(std::move(request));
+  return Status::OK();
+}
+
+Status ContinuousBatchingScheduler::Step(const RunSubgraphFunc& run_subgraph, const SelectTokenFunc& select_token) {
+  if (!running_.empty()) {
+    std::vector<size_t> batch(running_.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+      batch[i] = i;
+    }
+    ORT_RETURN_IF_ERROR(RunBatch(batch, run_subgraph, select_token));
+    RetireFinishedRequests();
+  }
+
+  std::vector<size_t> batch;
+  while (!queue_.empty() && running_.size() < static_cast<size_t>(max_batch_size_)) {
+    const int pages = PagesNeeded(queue_.front());
+    if (reserved_pages_ + pages > num_pages_) {
+      break;
+    }
+
+    RunningRequest running{std::move(queue_.front()), cache_.AddSequence(), pages, {}};
+    queue_.pop_front();
+    running.input_tokens = running.request.prompt;
+    reserved_pages_ += pages;
+
+    batch.push_back(running_.size());
+    running_.push_back(std::move(running));
+  }
+
+  if (!batch.empty()) {
+    ORT_RETURN_IF_ERROR(RunBatch(batch, run_subgraph, select_token));
+    RetireFinishedRequests();
+  }
+
+  return Status::OK();
+}
+
+Status ContinuousBatchingScheduler::RunBatch(gsl::span<const size_t> batch,
+                                             const RunSubgraphFunc& run_subgraph,
+                                             const SelectTokenFunc& select_token) {
+  const int batch_size = static_cast<int>(batch.size());
+  const int num_heads = cache_.NumHeads();
+  const int head_size = cache_.HeadSize();
+
+  std::vector<int> past_lengths(batch_size);
+  int past_length = 0;
+  int input_length = 0;
+  for (int b = 0; b < batch_size; b++) {
+    const RunningRequest& running = running_[batch[b]];
+    past_lengths[b] = cache_.SequenceLength(running.sequence_id);
+    past_length = std::max(past_length, past_lengths[b]);
+    input_length = std::max(input_length, static_cast<int>(running.input_tokens.size()));
+  }
+  const int total_length = past_length + input_length;
+
+  // Sequences are left padded in both the past and the input, and the padding is masked.
+  std::vector<OrtValue> feeds;
+  feeds.reserve(3 + static_cast<size_t>(num_layers_));
+
+  int64_t input_dims[] = {batch_size, input_length};
+  TensorShape input_shape(&input_dims[0], 2);
+  OrtValue input_ids;
+  OrtValue position_ids;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), input_shape, allocator_, input_ids);
+  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), input_shape, allocator_, position_ids);
+
+  int64_t mask_dims[] = {batch_size, total_length};
+  TensorShape mask_shape(&mask_dims[0], 2);
+  OrtValue attention_mask;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), mask_shape, allocator_, attention_mask);
+
+  int32_t* ids = input_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  int32_t* positions = position_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  int32_t* mask = attention_mask.GetMutable<Tensor>()->MutableData<int32_t>();
+  for (int b = 0; b < batch_size; b++) {
+    const std::vector<int32_t>& tokens = running_[batch[b]].input_tokens;
+    const int pad = input_length - static_cast<int>(tokens.size());
+
+    int32_t* ids_b = ids + static_cast<size_t>(b) * input_length;
+    int32_t* positions_b = positions + static_cast<size_t>(b) * input_length;
+    std::fill_n(ids_b, pad, pad_token_id_);
+    std::fill_n(positions_b, pad, 0);
+    for (size_t i = 0; i < tokens.size(); i++) {
+      ids_b[pad + i] = tokens[i];
+      positions_b[pad + i] = past_lengths[b] + static_cast<int32_t>(i);
+    }
+
+    int32_t* mask_b = mask + static_cast<size_t>(b) * total_length;
+    std::fill_n(mask_b, total_length, 0);
+    std::fill_n(mask_b + past_length - past_lengths[b], past_lengths[b], 1);
+    std::fill_n(mask_b + past_length + pad, tokens.size(), 1);
+  }
+
+  feeds.push_back(input_ids);
+  feeds.push_back(position_ids);
+  feeds.push_back(attention_mask);
+
+  // past: (2, batch_size, num_heads, past_length, head_size)
+  int64_t past_dims[] = {2, batch_size, num_heads, past_length, head_size};
+  TensorShape past_shape(&past_dims[0], 5);
+  const size_t past_stride = static_cast<size_t>(num_heads) * past_length * head_size;
+  for (int layer = 0; layer < num_layers_; layer++) {
+    OrtValue past;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), past_shape, allocator_, past);
+    float* past_data = past.GetMutable<Tensor>()->MutableData<float>();
+    std::fill_n(past_data, 2 * batch_size * past_stride, 0.0f);
+
+    for (int b = 0; b < batch_size; b++) {
+      float* key = past_data + b * past_stride + static_cast<size_t>(past_length - past_lengths[b]) * head_size;
+      float* value = key + batch_size * past_stride;
+      cache_.Read(layer, running_[batch[b]].sequence_id, key, value, past_length);
+    }
+
+    feeds.push_back(past);
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(run_subgraph(feeds, fetches));
+  ORT_RETURN_IF(fetches.size() != 1 + static_cast<size_t>(num_layers_),
+                "The subgraph shall have ", 1 + num_layers_, " outputs, got ", fetches.size());
+
+  const Tensor& logits = fetches[0].Get<Tensor>();
+  const TensorShape& logits_shape = logits.Shape();
+  ORT_RETURN_IF(logits_shape.NumDimensions() != 3 || logits_shape[0] != batch_size ||
+                    logits_shape[1] != input_length || logits_shape[2] != vocab_size_,
+                "Unexpected logits shape ", logits_shape);
+
+  // present: (2, batch_size, num_heads, total_length, head_size)
+  // Append the key and value of the input tokens, which are the last ones of each sequence.
+  for (int b = 0; b < batch_size; b++) {
+    const RunningRequest& running = running_[batch[b]];
+    ORT_RETURN_IF_ERROR(cache_.Extend(running.sequence_id, static_cast<int>(running.input_tokens.size())));
+  }
+
+  const size_t present_stride = static_cast<size_t>(num_heads) * total_length * head_size;
+  for (int layer = 0; layer < num_layers_; layer++) {
+    const Tensor& present = fetches[1 + static_cast<size_t>(layer)].Get<Tensor>();
+    const TensorShape& present_shape = present.Shape();
+    ORT_RETURN_IF(present_shape.NumDimensions() != 5 || present_shape[1] != batch_size ||
+                      present_shape[3] != total_length,
+                  "Unexpected present shape ", present_shape);
+
+    const float* present_data = present.Data<float>();
+    for (int b = 0; b < batch_size; b++) {
+      const RunningRequest& running = running_[batch[b]];
+      const int num_tokens = static_cast<int>(running.input_tokens.size());
+      const float* key = present_data + b * present_stride + static_cast<size_t>(total_length - num_tokens) * head_size;
+      const float* value = key + batch_size * present_stride;
+      cache_.Write(layer, running.sequence_id, past_lengths[b], num_tokens, key, value, total_length);
+    }
+  }
+
+  const float* logits_data = logits.Data<float>();
+  for (int b = 0; b < batch_size; b++) {
+    RunningRequest& running = running_[batch[b]];
+    const size_t offset = (static_cast<size_t>(b) * input_length + input_length - 1) * vocab_size_;
+    const int32_t token = select_token(running.request, gsl::make_span(logits_data + offset, vocab_size_));
+    running.request.tokens.push_back(token);
+    running.input_tokens.assign(1, token);
+  }
+
+  return Status::OK();
+}
+
+void ContinuousBatchingScheduler::RetireFinishedRequests() {
+  size_t kept = 0;
+  for (size_t i = 0; i < running_.size(); i++) {
+    RunningRequest& running = running_[i];
+    const std::vector<int32_t>& tokens = running.request.tokens;
+    if (tokens.back() == eos_token_id_ || static_cast<int>(tokens.size()) >= running.request.max_new_tokens) {
+      cache_.FreeSequence(running.sequence_id);
+      reserved_pages_ -= running.reserved_pages;
+      finished_.push_back(std::move(running.request));
+    } else {
+      if (kept != i) {
+        running_[kept] = std::move(running);
+      }
+      kept++;
+    }
+  }
+  running_.erase(running_.begin() + kept, running_.end());
+}
+
+std::vector<GenerationRequest> ContinuousBatchingScheduler::TakeFinishedRequests() {
+  std::vector<GenerationRequest> finished = std::move(finished_);
+  finished_.clear();
+  return finished;
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <vector>
+#include "gsl/gsl"
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "paged_kv_cache.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// A generation request served by ContinuousBatchingScheduler.
+struct GenerationRequest {
+  int request_id;
+  std::vector<int32_t> prompt;  // token ids of the prompt
+  int max_new_tokens;
+  std::vector<int32_t> tokens;  // generated tokens, which end with eos_token_id when it is generated
+};
+
+// Iteration-level scheduler for generation with a GPT-2 subgraph (see GptSubgraph for its inputs and outputs).
+// Requests do not wait for the whole batch: at each step boundary, finished requests leave the batch and queued
+// requests join it while there is room in the batch and in the KV cache.
+//
+// Each request has its own key and value states in a PagedKVCache, so a request only keeps the pages of its
+// tokens, and the states do not move when other requests join or leave. The past inputs of a step are gathered
+// from the cache with left padding to the longest sequence in the batch, and the padding is masked by
+// attention_mask. Position ids are counted per request, so the tokens of a request get the same positions as
+// when the request runs alone.
+//
+// A step has two subgraph runs: one generates a token for each running request, then one encodes the prompts
+// of the requests that joined and generates their first token.
+class ContinuousBatchingScheduler {
+ public:
+  // Runs the subgraph. feeds are input_ids, position_ids, attention_mask and past_0 ... past_{num_layers - 1},
+  // and fetches shall be logits and present_0 ... present_{num_layers - 1}. The caller adds implicit inputs.
+  using RunSubgraphFunc = std::function<Status(const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches)>;
+
+  // Selects the next token of a request from the logits of its last token.
+  using SelectTokenFunc = std::function<int32_t(const GenerationRequest& request, gsl::span<const float> logits)>;
+
+  ContinuousBatchingScheduler(AllocatorPtr allocator,
+                              int num_layers,
+                              int num_heads,
+                              int head_size,
+                              int vocab_size,
+                              int eos_token_id,
+                              int pad_token_id,
+                              int max_batch_size,
+                              int page_size,
+                              int num_pages);
+
+  // Queues a request. Returns an error when the request could never fit in the KV cache.
+  Status AddRequest(int request_id, std::vector<int32_t> prompt, int max_new_tokens);
+
+  // Runs one step: generates a token for each running request, retires the finished requests, and then admits
+  // queued requests in arrival order. A request is admitted only when the cache has pages for its prompt and
+  // max_new_tokens tokens besides the pages reserved by other running requests, so a step never runs out of pages.
+  Status Step(const RunSubgraphFunc& run_subgraph, const SelectTokenFunc& select_token);
+
+  bool HasUnfinishedRequests() const { return !running_.empty() || !queue_.empty(); }
+  size_t NumRunningRequests() const { return running_.size(); }
+  size_t NumQueuedRequests() const { return queue_.size(); }
+
+  // Moves out the requests finished so far, in the order they finished.
+  std::vector<GenerationRequest> TakeFinishedRequests();
+
+  const PagedKVCache& Cache() const { return cache_; }
+
+ private:
+  struct RunningRequest {
+    GenerationRequest request;
+    int sequence_id;                    // sequence of the request in the KV cache
+    int reserved_pages;                 // pages reserved for the request in the KV cache
+    std::vector<int32_t> input_tokens;  // tokens without key and value in the cache: the prompt or the last token
+  };
+
+  int PagesNeeded(const GenerationRequest& request) const;
+
+  // Runs the subgraph for running_[i] of each i in batch, appends the key and value of their input tokens to the
+  // cache, and selects the next tokens.
+  Status RunBatch(gsl::span<const size_t> batch, const RunSubgraphFunc& run_subgraph,
+                  const SelectTokenFunc& select_token);
+
+  void RetireFinishedRequests();
+
+  AllocatorPtr allocator_;
+  int num_layers_;
+  int vocab_size_;
+  int eos_token_id_;
+  int pad_token_id_;
+  int max_batch_size_;
+  int num_pages_;
+  int reserved_pages_ = 0;
+
+  PagedKVCache cache_;
+  std::deque<GenerationRequest> queue_;
+  std::vector<RunningRequest> running_;
+  std::vector<GenerationRequest> finished_;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
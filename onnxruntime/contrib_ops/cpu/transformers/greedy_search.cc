@@ -0,0 +1,427 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <random>
+#include "core/common/safeint.h"
+#include "core/framework/allocator.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/random_seed.h"
+#include "core/framework/session_state.h"
+#include "core/framework/utils.h"
+#include "core/framework/ort_value.h"
+#include "gsl/gsl"
+#include "greedy_search.h"
+#include "logits_processor.h"
+#include "sequences.h"
+#include "sampling.h"
+#include "dump_tensor.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+namespace contrib {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      GreedySearch,                                               \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCpuExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                               \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      transformers::GreedySearch);                                \
+                                                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      Sampling,                                                   \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCpuExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                               \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      transformers::Sampling);
+
+REGISTER_KERNEL_TYPED(float)
+
+namespace transformers {
+
+namespace {
+template <typename T>
+gsl::span<T> AllocateBuffer(AllocatorPtr allocator, BufferUniquePtr& buffer, size_t elements) {
+  void* data = allocator->Alloc(SafeInt<size_t>(sizeof(T)) * elements);
+  buffer = BufferUniquePtr(data, BufferDeleter(allocator));
+  return gsl::make_span(reinterpret_cast<T*>(data), elements);
+}
+}  // namespace
+
+class GreedySearchImpl {
+ public:
+  GreedySearchImpl(OpKernelContextInternal& context,
+                   const SessionState& session_state,
+                   GptSubgraph& gpt_subgraph,
+                   GreedySearchParameters& params)
+      : context_(context),
+        session_state_(session_state),
+        gpt_subgraph_(gpt_subgraph),
+        implicit_inputs_(context_.GetImplicitInputs()),
+        parameters_(&params),
+        cpu_allocator_(nullptr),
+        temp_space_allocator_(nullptr) {
+    parameters_->ParseFromInputs(&context);
+
+    cpu_allocator_ = session_state.GetExecutionProviders()
+                         .Get(onnxruntime::kCpuExecutionProvider)
+                         ->GetAllocator(0, OrtMemTypeDefault);
+  }
+
+  // Initialize by validating all the inputs.
+  Status Initialize();
+
+  // Execute greedy search or sampling in iterations util stopping criteria is reached.
+  // In each iteration, GPT subgraph is called, and next token for each sequence is generated.
+  Status Execute(const FeedsFetchesManager& feeds_fetches_manager);
+
+ private:
+  // Validate inputs.
+  Status CheckInputs(const OpKernelContextInternal& context);
+
+  // Apply logits processors to the logits of last token, then select next token for each sequence.
+  Status GenerateNextToken(const OrtValue& logits,
+                           gsl::span<float> next_token_scores,
+                           gsl::span<int32_t> next_tokens,
+                           std::vector<bool>& eos_meet,
+                           Sequences& sequences,
+                           int counter);
+
+  OpKernelContextInternal& context_;
+
+  const SessionState& session_state_;
+
+  GptSubgraph& gpt_subgraph_;
+
+  const std::vector<const OrtValue*>& implicit_inputs_;
+
+  CpuTensorConsoleDumper cpu_dumper_;
+
+  GreedySearchParameters* parameters_;
+
+  LogitsProcessorList logits_processors_;
+
+  AllocatorPtr cpu_allocator_;
+  AllocatorPtr temp_space_allocator_;
+
+  // Used in sampling only.
+  std::mt19937 generator_;
+  std::vector<std::pair<float, int32_t>> candidates_;
+};
+
+void GreedySearch::Init(const OpKernelInfo& info) {
+  // Make sure the decoder attribute was present even though we don't need it here.
+  ONNX_NAMESPACE::GraphProto proto;
+  ORT_ENFORCE(info.GetAttr<ONNX_NAMESPACE::GraphProto>("decoder", &proto).IsOK());
+  ORT_IGNORE_RETURN_VALUE(proto);
+
+  parameters_.ParseFromAttributes(info);
+}
+
+Status GreedySearch::SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                                const std::string& attribute_name,
+                                                const SessionState& subgraph_session_state) {
+  ORT_ENFORCE(gpt_subgraph_ == nullptr, "SetupSubgraphExecutionInfo should only be called once for each subgraph.");
+  if (attribute_name == "decoder") {
+    const auto& node = Node();
+    gpt_subgraph_ = std::make_unique<GptSubgraph>(node, attribute_name, subgraph_session_state.GetGraphViewer());
+    ORT_RETURN_IF_ERROR(gpt_subgraph_->Setup(session_state, subgraph_session_state));
+    feeds_fetches_manager_ = gpt_subgraph_->GetFeedsFetchesManager();
+    parameters_.SetSubgraphParameters(gpt_subgraph_->vocab_size,
+                                      gpt_subgraph_->num_heads,
+                                      gpt_subgraph_->head_size,
+                                      gpt_subgraph_->num_layers);
+  }
+  return Status::OK();
+}
+
+Status GreedySearch::Compute(OpKernelContext* ctx) const {
+  if (parameters_.model_type != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Support of 'model_type' != 0 is not implemented");
+  }
+
+  auto* ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
+  auto* session_state = ctx_internal->SubgraphSessionState("decoder");
+  ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'decoder' attribute.");
+  ORT_ENFORCE(feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
+  if (gpt_subgraph_->IsOutputFloat16()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "GPT-2 subgraph with float16 output is not supported in CPU");
+  }
+
+  GreedySearchParameters parameters = parameters_;  // make a copy since we will update the parameters based on inputs later
+
+  GreedySearchImpl impl{*ctx_internal, *session_state, *gpt_subgraph_, parameters};
+  ORT_RETURN_IF_ERROR(impl.Initialize());
+
+  return impl.Execute(*feeds_fetches_manager_);
+}
+
+Status GreedySearchImpl::CheckInputs(const OpKernelContextInternal& context) {
+  // Input shapes:
+  //   input_ids  : (batch_size, sequence_length)
+  //   vocab_mask : (vocab_size) or nullptr
+  //   prefix_vocab_mask : (batch_size, vocab_size) or nullptr
+
+  const Tensor* input_ids = context.Input<Tensor>(0);
+  const auto& dims = input_ids->Shape().GetDims();
+  if (dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'input_ids' is expected to have 2 dimensions, got ",
+                           dims.size());
+  }
+
+  const Tensor* vocab_mask = context.Input<Tensor>(4);
+  if (vocab_mask != nullptr) {  // vocab_mask is optional
+    const auto& vocab_mask_dims = vocab_mask->Shape().GetDims();
+    if (vocab_mask_dims.size() != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'vocab_mask' is expected to have 1 dimension, got ",
+                             vocab_mask_dims.size());
+    }
+
+    // There is dependency on vocab_size parameter, which shall be set before calling this function.
+    if (static_cast<int>(vocab_mask_dims[0]) != parameters_->vocab_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'vocab_mask' shape does not match with vocab_size, got ",
+                             vocab_mask_dims[0]);
+    }
+
+    // store vocab mask in parameters.
+    parameters_->vocab_mask = vocab_mask->DataAsSpan<int32_t>();
+  }
+
+  const Tensor* prefix_vocab_mask = context.Input<Tensor>(5);
+  if (prefix_vocab_mask != nullptr) {
+    // prefix_vocab_mask is optional
+    const auto& vocab_mask_dims = prefix_vocab_mask->Shape().GetDims();
+    if (vocab_mask_dims.size() != 2) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'prefix_vocab_mask' is expected to have 2 dimensions, got ",
+                             vocab_mask_dims.size());
+    }
+
+    // prefix_vocab_mask first dimension should be same as the first dimension of input_ids
+    if (static_cast<int>(vocab_mask_dims[0]) != static_cast<int>(dims[0])) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input_ids and prefix_vocab_mask must have the same batch_size");
+    }
+
+    // There is dependency on vocab_size parameter, which shall be set before calling this function.
+    if (static_cast<int>(vocab_mask_dims[1]) != parameters_->vocab_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'prefix_vocab_mask' shape does not match with vocab_size, got ",
+                             vocab_mask_dims[1]);
+    }
+
+    // store prefix vocab mask in parameters.
+    parameters_->prefix_vocab_mask = prefix_vocab_mask->DataAsSpan<int32_t>();
+  }
+
+  return Status::OK();
+}
+
+Status GreedySearchImpl::Initialize() {
+  ORT_RETURN_IF_ERROR(context_.GetTempSpaceAllocator(&temp_space_allocator_));
+
+#define CHECK_SCALAR_INPUT(name, index, required)                                                           \
+  auto* name##_tensor = context_.Input<Tensor>(index);                                                      \
+  if (name##_tensor) {                                                                                      \
+    if (!name##_tensor->Shape().IsScalar()) {                                                               \
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input " #name " should be a scalar. Got shape of ",        \
+                             name##_tensor->Shape());                                                       \
+    }                                                                                                       \
+  } else if (required) {                                                                                    \
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input " #name " is required");                               \
+  }
+
+  CHECK_SCALAR_INPUT(max_length, 1, true);
+
+  CHECK_SCALAR_INPUT(min_length, 2, false);
+
+  CHECK_SCALAR_INPUT(repetition_penalty, 3, false);
+
+  ORT_RETURN_IF_ERROR(CheckInputs(context_));
+
+  ORT_RETURN_IF_ERROR(parameters_->Validate());
+
+  parameters_->output_scores = false;
+
+  // Initialize processsors after CheckInputs so that parameters_->vocab_mask is ready.
+  logits_processors_.Init(*parameters_);
+
+  if (parameters_->do_sample) {
+    generator_.seed(static_cast<uint32_t>(parameters_->seed >= 0 ? parameters_->seed : utils::GetRandomSeed()));
+  }
+
+  return Status::OK();
+}
+
+Status GreedySearchImpl::GenerateNextToken(const OrtValue& logits,
+                                           gsl::span<float> next_token_scores,
+                                           gsl::span<int32_t> next_tokens,
+                                           std::vector<bool>& eos_meet,
+                                           Sequences& sequences,
+                                           int counter) {
+  const int batch_size = parameters_->batch_size;
+  const int vocab_size = parameters_->vocab_size;
+
+  // Logits has shape (batch_size, input_length, vocab_size), where input_length equals to
+  // parameters_->sequence_length for first subgraph call, and 1 for the remaining calls.
+  const TensorShape& logits_shape = logits.Get<Tensor>().Shape();
+  ORT_RETURN_IF_NOT(logits_shape.NumDimensions() == 3, "logits shall have 3 dimensions");
+  const int64_t input_length = logits_shape[1];
+
+  // Logits processors update the scores in place. The logits of last token are used directly when they are
+  // contiguous, since the logits are not used after this step. Unlike beam search, no softmax is needed:
+  // greedy search only needs the maximum, and sampling computes the probabilities of the kept tokens.
+  gsl::span<float> scores = next_token_scores;
+  if (input_length == 1) {
+    OrtValue logits_value = logits;
+    scores = logits_value.GetMutable<Tensor>()->MutableDataAsSpan<float>();
+  } else {
+    const float* current_logits = logits.Get<Tensor>().Data<float>() + (input_length - 1) * vocab_size;
+    for (int i = 0; i < batch_size; i++) {
+      std::copy_n(current_logits, vocab_size, scores.data() + SafeInt<size_t>(i) * vocab_size);
+      current_logits += input_length * vocab_size;
+    }
+  }
+
+  logits_processors_.Process(&sequences, scores, counter);
+
+#ifdef DEBUG_BEAM_SEARCH
+  cpu_dumper_.Print("next_token_scores after logits processor", scores.data(), batch_size, vocab_size);
+#endif
+
+  for (int i = 0; i < batch_size; i++) {
+    if (eos_meet[i]) {
+      next_tokens[i] = parameters_->pad_token_id;
+      continue;
+    }
+
+    gsl::span<const float> row(scores.data() + SafeInt<size_t>(i) * vocab_size, static_cast<size_t>(vocab_size));
+    if (parameters_->do_sample) {
+      next_tokens[i] = SampleTopKTopP(row, parameters_->temperature, parameters_->top_k, parameters_->top_p,
+                                      parameters_->min_tokens_to_keep, candidates_, generator_);
+    } else {
+      next_tokens[i] = ArgMaxToken(row);
+    }
+
+    if (next_tokens[i] == parameters_->eos_token_id) {
+      eos_meet[i] = true;
+    }
+  }
+
+#ifdef DEBUG_BEAM_SEARCH
+  cpu_dumper_.Print("next_tokens", next_tokens.data(), batch_size, 1);
+#endif
+
+  sequences.AppendNextTokenToSequences(next_tokens);
+
+#ifdef DEBUG_BEAM_SEARCH
+  sequences.PrintSequences(&cpu_dumper_);
+#endif
+  return Status::OK();
+}
+
+Status GreedySearchImpl::Execute(const FeedsFetchesManager& feeds_fetches_manager) {
+  auto status = Status::OK();
+  const int batch_size = parameters_->batch_size;
+  const int max_length = parameters_->max_length;
+
+  int64_t sequences_dims[] = {batch_size, max_length};
+  TensorShape sequences_shape(&sequences_dims[0], sizeof(sequences_dims) / sizeof(sequences_dims[0]));
+  Tensor* output_sequences = context_.Output(0, sequences_shape);
+
+  std::vector<OrtValue> feeds;
+  std::vector<OrtValue> fetches;
+
+  BufferUniquePtr sequence_lengths_buffer;
+  BufferUniquePtr sequences_space_buffer;
+  BufferUniquePtr next_positions_buffer;
+  BufferUniquePtr next_tokens_buffer;
+  BufferUniquePtr next_token_scores_buffer;
+  gsl::span<int32_t> sequence_lengths = AllocateBuffer<int32_t>(cpu_allocator_, sequence_lengths_buffer, batch_size);
+  gsl::span<int32_t> sequences_space = AllocateBuffer<int32_t>(cpu_allocator_, sequences_space_buffer,
+                                                               SafeInt<size_t>(2) * batch_size * max_length);
+  gsl::span<int32_t> next_positions = AllocateBuffer<int32_t>(temp_space_allocator_, next_positions_buffer, batch_size);
+  gsl::span<int32_t> next_tokens = AllocateBuffer<int32_t>(cpu_allocator_, next_tokens_buffer, batch_size);
+  gsl::span<float> next_token_scores = AllocateBuffer<float>(temp_space_allocator_, next_token_scores_buffer,
+                                                             SafeInt<size_t>(batch_size) * parameters_->vocab_size);
+
+  IAllocatorUniquePtr<char> buffer;
+  OrtValue expanded_input_ids;
+  const Tensor& input_ids = context_.GetInputOrtValue(0)->Get<Tensor>();
+  ORT_RETURN_IF_ERROR(gpt_subgraph_.CreateInitialFeeds(input_ids, implicit_inputs_, 1, parameters_->pad_token_id,
+                                                       sequence_lengths, expanded_input_ids, feeds,
+                                                       BeamSearchCpuDeviceHelper::CreateInputs,
+                                                       BeamSearchCpuDeviceHelper::AddToFeeds,
+                                                       buffer));
+
+  // Copy input_ids to sequences.
+  memset(sequences_space.data(), 0, sequences_space.size_bytes());
+  const int32_t* input_ids_data = input_ids.Data<int32_t>();
+  for (int i = 0; i < batch_size; i++) {
+    std::copy_n(input_ids_data + SafeInt<size_t>(i) * parameters_->sequence_length, parameters_->sequence_length,
+                sequences_space.data() + SafeInt<size_t>(i) * max_length);
+  }
+
+  Sequences sequences;
+  sequences.Init(sequences_space, batch_size, parameters_->sequence_length, max_length);
+
+  // position ids for all iterations except the first. It uses memory buffer owned by next_positions.
+  gsl::copy(sequence_lengths, next_positions);
+  OrtValue position_ids;
+  int64_t dims[] = {batch_size, 1};
+  TensorShape shape(&dims[0], 2);
+  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), shape, next_positions.data(), temp_space_allocator_->Info(), position_ids);
+
+  std::vector<bool> eos_meet(batch_size, false);
+
+  int current_length = parameters_->sequence_length;
+  int iteration_counter = 0;
+  while (current_length < max_length) {
+    iteration_counter++;
+
+    status = utils::ExecuteSubgraph(session_state_, feeds_fetches_manager, feeds, fetches, {},
+                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetRunTermination(), context_.Logger());
+    ORT_RETURN_IF_ERROR(status);
+
+    ORT_RETURN_IF_ERROR(GenerateNextToken(fetches[0], next_token_scores, next_tokens, eos_meet, sequences,
+                                          iteration_counter));
+
+    // Increase sequence length after a new token is generated.
+    ++current_length;
+
+    // When all sequences are finished, stop earlier to avoid wasting computation.
+    if (std::all_of(eos_meet.begin(), eos_meet.end(), [](bool eos) { return eos; })) {
+      break;
+    }
+
+    // Prepare inputs for next round of subgraph call. There is one beam, so present state is fed as past state.
+    if (current_length < max_length) {
+      ORT_RETURN_IF_ERROR(BeamSearchCpuDeviceHelper::UpdateFeeds<float>(
+          temp_space_allocator_, nullptr, fetches, feeds, current_length, position_ids,
+          next_tokens.as_span<const int32_t>(), gsl::span<const int32_t>(), 1, &cpu_dumper_));
+    }
+    fetches.clear();
+  }
+
+  // Output sequences, and pad the remaining tokens.
+  gsl::span<int32_t> output = output_sequences->MutableDataAsSpan<int32_t>();
+  std::fill(output.begin(), output.end(), parameters_->pad_token_id);
+  for (int i = 0; i < batch_size; i++) {
+    gsl::span<const int32_t> sequence = sequences.GetSequence(i);
+    std::copy(sequence.begin(), sequence.end(), output.begin() + SafeInt<size_t>(i) * max_length);
+  }
+
+  return status;
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/controlflow/utils.h"
+#include "greedy_search_parameters.h"
+#include "gpt_subgraph.h"
+#include "beam_search_device_helper.h"
+
+namespace onnxruntime {
+class FeedsFetchesManager;
+
+namespace contrib {
+namespace transformers {
+
+using namespace onnxruntime::controlflow;  // namespace of IControlFlowKernel
+
+// Greedy search for text generation with GPT-2 decoder. The token with maximum score is selected at each step.
+// Unlike BeamSearch with num_beams=1, there is no beam scorer, no top-k over the vocabulary and no beam reorder.
+class GreedySearch : public IControlFlowKernel {
+ public:
+  GreedySearch(const OpKernelInfo& info)
+      : IControlFlowKernel(info), feeds_fetches_manager_(nullptr) {
+    Init(info);
+  }
+
+  void Init(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+
+  Status SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                    const std::string& attribute_name,
+                                    const SessionState& subgraph_session_state) override;
+
+ protected:
+  GreedySearchParameters parameters_;
+
+ private:
+  // Subgraph and FeedsFetchesManager re-used for each subgraph execution.
+  std::unique_ptr<GptSubgraph> gpt_subgraph_;
+  FeedsFetchesManager* feeds_fetches_manager_;
+};
+
+// Sampling for text generation with GPT-2 decoder. Next token is sampled from the probabilities after
+// temperature, top-k and top-p filtering.
+class Sampling : public GreedySearch {
+ public:
+  Sampling(const OpKernelInfo& info) : GreedySearch(info) {
+    parameters_.do_sample = true;
+  }
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "greedy_search_parameters.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+constexpr int kMaxSequenceLength = 4096;
+
+Status GreedySearchParameters::Validate() const {
+  ORT_RETURN_IF(eos_token_id < 0, "eos_token_id is invalid");
+  ORT_RETURN_IF(pad_token_id < 0, "pad_token_id is invalid");
+  ORT_RETURN_IF(min_length >= max_length, "min_length shall be smaller than max_length");
+  ORT_RETURN_IF(top_k < 0, "top_k shall not be negative, got ", top_k);
+  ORT_RETURN_IF(top_p <= 0.0f || top_p > 1.0f, "top_p shall be in range (0, 1], got ", top_p);
+  ORT_RETURN_IF(min_tokens_to_keep < 1, "min_tokens_to_keep shall be a positive integer, got ", min_tokens_to_keep);
+  return Status::OK();
+}
+
+void GreedySearchParameters::ParseFromAttributes(const OpKernelInfo& info) {
+  model_type = static_cast<int>(info.GetAttrOrDefault<int64_t>("model_type", 0));
+  early_stopping = false;
+  eos_token_id = static_cast<int>(info.GetAttrOrDefault<int64_t>("eos_token_id", -1));
+  pad_token_id = static_cast<int>(info.GetAttrOrDefault<int64_t>("pad_token_id", -1));
+  no_repeat_ngram_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("no_repeat_ngram_size", 0));
+
+  temperature = info.GetAttrOrDefault<float>("temperature", 1.0f);
+  top_k = static_cast<int>(info.GetAttrOrDefault<int64_t>("top_k", 0));
+  top_p = info.GetAttrOrDefault<float>("top_p", 1.0f);
+  min_tokens_to_keep = static_cast<int>(info.GetAttrOrDefault<int64_t>("min_tokens_to_keep", 1));
+  seed = static_cast<int>(info.GetAttrOrDefault<int64_t>("seed", -1));
+  ORT_ENFORCE(temperature > 0.0f, "temperature shall be greater than 0, got ", temperature);
+}
+
+void GreedySearchParameters::ParseFromInputs(OpKernelContext* context) {
+  ORT_ENFORCE(context != nullptr);
+  const Tensor* input_ids = context->Input<Tensor>(0);
+  const auto& dims = input_ids->Shape().GetDims();
+  ORT_ENFORCE(dims.size() == 2, "input_ids shall have 2 dimensions. Got ", dims.size());
+  batch_size = static_cast<int>(dims[0]);
+  sequence_length = static_cast<int>(dims[1]);
+
+  auto* max_length_tensor = context->Input<Tensor>(1);
+  max_length = max_length_tensor ? static_cast<int>(*max_length_tensor->Data<int32_t>()) : kMaxSequenceLength;
+  ORT_ENFORCE(max_length > sequence_length, "max_length (", max_length, ") shall be greater than input sequence length (", sequence_length, ")");
+  ORT_ENFORCE(max_length <= kMaxSequenceLength, "max_length (", max_length, ") shall be no more than ", kMaxSequenceLength);
+
+  auto* min_length_tensor = context->Input<Tensor>(2);
+  min_length = min_length_tensor ? static_cast<int>(*min_length_tensor->Data<int32_t>()) : 0;
+
+  num_beams = 1;
+  num_return_sequences = 1;
+  length_penalty = 1.0f;
+
+  auto* repetition_penalty_tensor = context->Input<Tensor>(3);
+  repetition_penalty = repetition_penalty_tensor ? static_cast<float>(*repetition_penalty_tensor->Data<float>()) : 1.0f;
+  ORT_ENFORCE(repetition_penalty > 0.0f, "repetition_penalty shall be greater than 0, got ", repetition_penalty);
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "beam_search_parameters.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// Parameters of GreedySearch and Sampling. There is one beam per sequence, and the logits processors
+// of beam search are reused.
+struct GreedySearchParameters : public BeamSearchParameters {
+  // Whether next token is sampled (Sampling operator) instead of the one with maximum score (GreedySearch operator).
+  bool do_sample = false;
+
+  // Parameters of sampling from node attributes.
+  int top_k;               // number of tokens with highest scores to keep. 0 means no top-k filtering.
+  float top_p;             // minimum cumulative probability of tokens to keep. 1.0 means no top-p filtering.
+  int min_tokens_to_keep;  // minimum number of tokens to keep in top-p filtering.
+  int seed;                // seed of random number generator. Negative value means a random seed is used.
+
+  Status Validate() const;
+
+  void ParseFromAttributes(const OpKernelInfo& info);
+
+  void ParseFromInputs(OpKernelContext* context);
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
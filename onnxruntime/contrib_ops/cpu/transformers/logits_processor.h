@@ -96,7 +96,9 @@ class LogitsProcessorList : public ILogitsProcessorList {
  public:
   LogitsProcessorList() = default;
   void Init(const BeamSearchParameters& parameters);
-  void Process(const ISequences* sequences, gsl::span<float>& next_token_scores, int step);
+  void Process(const ISequences* sequences, gsl::span<float>& next_token_scores, int step) override;
+
+  bool Empty() const override { return processor_list_.empty(); }
 
  private:
   int batch_beam_size_;
@@ -0,0 +1,291 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "paged_kv_cache.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+PagedKVCache::PagedKVCache(AllocatorPtr allocator,
+                           int num_layers,
+                           int num_heads,
+                           int head_size,
+                           int page_size,
+                           int num_pages)
+    : num_layers_(num_layers),
+      num_heads_(num_heads),
+      head_size_(head_size),
+      page_size_(page_size) {
+  ORT_ENFORCE(num_layers > 0 && num_heads > 0 && head_size > 0 && page_size > 0 && num_pages > 0);
+
+  page_elements_ = SafeInt<size_t>(num_layers) * 2 * num_heads * page_size * head_size;
+  void* data = allocator->Alloc(SafeInt<size_t>(page_elements_) * num_pages * sizeof(float));
+  pages_buffer_ = BufferUniquePtr(data, BufferDeleter(allocator));
+  pages_ = static_cast<float*>(data);
+
+  ref_counts_.assign(num_pages, 0);
+
+  // Pages are taken from the back, so the pages with lower index are used first.
+  free_pages_.reserve(num_pages);
+  for (int i = num_pages - 1; i >= 0; i--) {
+    free_pages_.push_back(i);
+  }
+}
+
+float* PagedKVCache::PageData(int page, int layer, int kv, int head) const {
+  const size_t offset = ((static_cast<size_t>(layer) * 2 + kv) * num_heads_ + head) * page_size_ * head_size_;
+  return pages_ + page * page_elements_ + offset;
+}
+
+PagedKVCache::Sequence& PagedKVCache::GetSequence(int sequence_id) {
+  ORT_ENFORCE(sequence_id >= 0 && static_cast<size_t>(sequence_id) < sequences_.size() &&
+                  sequences_[sequence_id].is_active,
+              "Invalid sequence id ", sequence_id);
+  return sequences_[sequence_id];
+}
+
+const PagedKVCache::Sequence& PagedKVCache::GetSequence(int sequence_id) const {
+  ORT_ENFORCE(sequence_id >= 0 && static_cast<size_t>(sequence_id) < sequences_.size() &&
+                  sequences_[sequence_id].is_active,
+              "Invalid sequence id ", sequence_id);
+  return sequences_[sequence_id];
+}
+
+int PagedKVCache::NewSequence() {
+  int sequence_id;
+  if (!free_sequence_ids_.empty()) {
+    sequence_id = free_sequence_ids_.back();
+    free_sequence_ids_.pop_back();
+  } else {
+    sequence_id = static_cast<int>(sequences_.size());
+    sequences_.emplace_back();
+  }
+
+  Sequence& sequence = sequences_[sequence_id];
+  sequence.page_table.clear();
+  sequence.length = 0;
+  sequence.is_active = true;
+  return sequence_id;
+}
+
+int32_t PagedKVCache::AllocatePage() {
+  ORT_ENFORCE(!free_pages_.empty());
+  int32_t page = free_pages_.back();
+  free_pages_.pop_back();
+  ref_counts_[page] = 1;
+  return page;
+}
+
+void PagedKVCache::ReleasePage(int32_t page) {
+  if (--ref_counts_[page] == 0) {
+    free_pages_.push_back(page);
+  }
+}
+
+int PagedKVCache::AddSequence() {
+  return NewSequence();
+}
+
+int PagedKVCache::ForkSequence(int source_sequence_id) {
+  GetSequence(source_sequence_id);  // validate the source before adding a sequence
+
+  // Get the source after adding the sequence, since adding could reallocate the sequences.
+  int sequence_id = NewSequence();
+  const Sequence& source = sequences_[source_sequence_id];
+  Sequence& sequence = sequences_[sequence_id];
+
+  sequence.page_table = source.page_table;
+  sequence.length = source.length;
+  for (int32_t page : sequence.page_table) {
+    ref_counts_[page]++;
+  }
+
+  return sequence_id;
+}
+
+void PagedKVCache::FreeSequence(int sequence_id) {
+  Sequence& sequence = GetSequence(sequence_id);
+  for (int32_t page : sequence.page_table) {
+    ReleasePage(page);
+  }
+
+  sequence.page_table.clear();
+  sequence.length = 0;
+  sequence.is_active = false;
+  free_sequence_ids_.push_back(sequence_id);
+}
+
+Status PagedKVCache::Extend(int sequence_id, int num_tokens) {
+  Sequence& sequence = GetSequence(sequence_id);
+  ORT_RETURN_IF_NOT(num_tokens >= 0, "num_tokens shall not be negative");
+
+  const int new_length = sequence.length + num_tokens;
+  const size_t num_pages = static_cast<size_t>((new_length + page_size_ - 1) / page_size_);
+
+  // The last page is written when it is partially filled, so it needs a copy when it is shared.
+  const bool copy_last_page = num_tokens > 0 && sequence.length % page_size_ != 0 &&
+                              ref_counts_[sequence.page_table.back()] > 1;
+
+  const size_t required_pages = num_pages - sequence.page_table.size() + (copy_last_page ? 1 : 0);
+  if (required_pages > free_pages_.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The KV cache needs ", required_pages,
+                           " pages for the sequence, but only ", free_pages_.size(), " pages are free");
+  }
+
+  if (copy_last_page) {
+    int32_t shared_page = sequence.page_table.back();
+    int32_t page = AllocatePage();
+    memcpy(pages_ + page * page_elements_, pages_ + shared_page * page_elements_, page_elements_ * sizeof(float));
+    ReleasePage(shared_page);
+    sequence.page_table.back() = page;
+  }
+
+  while (sequence.page_table.size() < num_pages) {
+    sequence.page_table.push_back(AllocatePage());
+  }
+
+  sequence.length = new_length;
+  return Status::OK();
+}
+
+void PagedKVCache::Write(int layer, int sequence_id, int position, int num_tokens,
+                         const float* key, const float* value, int input_length) {
+  const Sequence& sequence = GetSequence(sequence_id);
+  ORT_ENFORCE(layer >= 0 && layer < num_layers_);
+  ORT_ENFORCE(position >= 0 && num_tokens >= 0 && position + num_tokens <= sequence.length);
+  if (input_length == 0) {
+    input_length = num_tokens;
+  }
+  ORT_ENFORCE(input_length >= num_tokens);
+
+  const size_t head_bytes = static_cast<size_t>(head_size_) * sizeof(float);
+
+  // Copy the tokens in runs that are contiguous within a page.
+  for (int token = 0; token < num_tokens;) {
+    const int page_index = (position + token) / page_size_;
+    const int page_offset = (position + token) % page_size_;
+    const int run = std::min(num_tokens - token, page_size_ - page_offset);
+    const int32_t page = sequence.page_table[page_index];
+
+    for (int head = 0; head < num_heads_; head++) {
+      const size_t input_offset = (static_cast<size_t>(head) * input_length + token) * head_size_;
+      const size_t page_offset_elements = static_cast<size_t>(page_offset) * head_size_;
+      memcpy(PageData(page, layer, 0, head) + page_offset_elements, key + input_offset, run * head_bytes);
+      memcpy(PageData(page, layer, 1, head) + page_offset_elements, value + input_offset, run * head_bytes);
+    }
+
+    token += run;
+  }
+}
+
+void PagedKVCache::Read(int layer, int sequence_id, float* key, float* value, int output_length) const {
+  const Sequence& sequence = GetSequence(sequence_id);
+  ORT_ENFORCE(layer >= 0 && layer < num_layers_);
+  ORT_ENFORCE(output_length >= sequence.length);
+
+  for (int start = 0, p = 0; start < sequence.length; start += page_size_, p++) {
+    const size_t run = static_cast<size_t>(std::min(page_size_, sequence.length - start));
+    const size_t run_bytes = run * head_size_ * sizeof(float);
+    const int32_t page = sequence.page_table[p];
+
+    for (int head = 0; head < num_heads_; head++) {
+      const size_t output_offset = (static_cast<size_t>(head) * output_length + start) * head_size_;
+      memcpy(key + output_offset, PageData(page, layer, 0, head), run_bytes);
+      memcpy(value + output_offset, PageData(page, layer, 1, head), run_bytes);
+    }
+  }
+}
+
+void PagedKVCache::ReorderSequences(gsl::span<const int> sequence_ids, gsl::span<const int32_t> beam_indices) {
+  ORT_ENFORCE(sequence_ids.size() == beam_indices.size());
+
+  std::vector<Sequence> selected;
+  selected.reserve(sequence_ids.size());
+  for (size_t i = 0; i < sequence_ids.size(); i++) {
+    ORT_ENFORCE(beam_indices[i] >= 0 && static_cast<size_t>(beam_indices[i]) < sequence_ids.size());
+    selected.push_back(GetSequence(sequence_ids[beam_indices[i]]));
+  }
+
+  // Add the references of the selected page tables before releasing the old ones, so pages kept by other
+  // beams are not freed.
+  for (const Sequence& sequence : selected) {
+    for (int32_t page : sequence.page_table) {
+      ref_counts_[page]++;
+    }
+  }
+
+  for (size_t i = 0; i < sequence_ids.size(); i++) {
+    Sequence& sequence = sequences_[sequence_ids[i]];
+    for (int32_t page : sequence.page_table) {
+      ReleasePage(page);
+    }
+    sequence = std::move(selected[i]);
+  }
+}
+
+int PagedKVCache::SequenceLength(int sequence_id) const {
+  return GetSequence(sequence_id).length;
+}
+
+gsl::span<const int32_t> PagedKVCache::PageTable(int sequence_id) const {
+  return GetSequence(sequence_id).page_table;
+}
+
+void PagedAttention(const PagedKVCache& cache,
+                    int layer,
+                    gsl::span<const int> sequence_ids,
+                    const float* query,
+                    float* output,
+                    float scale,
+                    concurrency::ThreadPool* thread_pool) {
+  const int num_heads = cache.NumHeads();
+  const int head_size = cache.HeadSize();
+  const int page_size = cache.PageSize();
+
+  const std::ptrdiff_t loop_len = static_cast<std::ptrdiff_t>(sequence_ids.size()) * num_heads;
+  const double cost = static_cast<double>(head_size) * page_size * 4;
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> scores;
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const int sequence_id = sequence_ids[i / num_heads];
+          const int head = static_cast<int>(i % num_heads);
+          const int length = cache.SequenceLength(sequence_id);
+          gsl::span<const int32_t> page_table = cache.PageTable(sequence_id);
+
+          const float* q = query + i * head_size;
+          float* out = output + i * head_size;
+          if (length == 0) {
+            std::fill_n(out, head_size, 0.0f);
+            continue;
+          }
+
+          // scores = scale x q x K', page by page
+          scores.resize(length);
+          for (int start = 0, p = 0; start < length; start += page_size, p++) {
+            const int rows = std::min(page_size, length - start);
+            MlasGemm(CblasNoTrans, CblasTrans, 1, rows, head_size, scale, q, head_size,
+                     cache.Key(page_table[p], layer, head), head_size, 0.0f, scores.data() + start, rows, nullptr);
+          }
+
+          MlasComputeSoftmax(scores.data(), scores.data(), 1, length, false, nullptr);
+
+          // out = scores x V, accumulated page by page
+          for (int start = 0, p = 0; start < length; start += page_size, p++) {
+            const int rows = std::min(page_size, length - start);
+            MlasGemm(CblasNoTrans, CblasNoTrans, 1, head_size, rows, 1.0f, scores.data() + start, rows,
+                     cache.Value(page_table[p], layer, head), head_size, p == 0 ? 0.0f : 1.0f, out, head_size,
+                     nullptr);
+          }
+        }
+      });
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+#include "gsl/gsl"
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+namespace concurrency {
+class ThreadPool;
+}
+
+namespace contrib {
+namespace transformers {
+
+// A pool of fixed-size pages for the key and value states of the sequences of concurrent generation requests.
+// The memory of the states scales with the number of tokens in the sequences instead of max_length x batch_size.
+//
+// A page holds the states of page_size consecutive tokens of one sequence for all layers and heads:
+//   page: (num_layers, 2, num_heads, page_size, head_size)
+// Each sequence has a page table that lists the pages holding its tokens in order. Pages are reference counted:
+// a sequence forked from another one (like the beams of a request) shares the pages of their common prefix, and
+// a shared page is copied before new tokens are written to it. Reordering beams only reorders the page tables.
+class PagedKVCache {
+ public:
+  PagedKVCache(AllocatorPtr allocator, int num_layers, int num_heads, int head_size, int page_size, int num_pages);
+
+  // Adds an empty sequence and returns its id.
+  int AddSequence();
+
+  // Adds a sequence that shares all tokens of the source sequence, and returns its id.
+  int ForkSequence(int source_sequence_id);
+
+  // Releases the pages of a sequence. The id could be reused by sequences added later.
+  void FreeSequence(int sequence_id);
+
+  // Makes room for num_tokens tokens at the end of a sequence, and increases the sequence length.
+  // A shared last page is copied first, so the new tokens are only visible to this sequence.
+  // Returns an error without changing the sequence when there are not enough free pages.
+  Status Extend(int sequence_id, int num_tokens);
+
+  // Writes the key and value of one layer for the tokens [position, position + num_tokens) of a sequence.
+  // The tokens shall be in the range added by the last Extend call.
+  //   key, value: (num_heads, input_length, head_size), where the tokens are the first num_tokens of each head.
+  //   input_length is num_tokens when it is 0.
+  void Write(int layer, int sequence_id, int position, int num_tokens, const float* key, const float* value,
+             int input_length = 0);
+
+  // Reads the key and value of one layer for all tokens of a sequence.
+  //   key, value: (num_heads, output_length, head_size), where the tokens are the first ones of each head.
+  void Read(int layer, int sequence_id, float* key, float* value, int output_length) const;
+
+  // Reorders the sequences after a beam search step: sequence_ids[i] will have the tokens of
+  // sequence_ids[beam_indices[i]]. Only the page tables are updated.
+  void ReorderSequences(gsl::span<const int> sequence_ids, gsl::span<const int32_t> beam_indices);
+
+  int SequenceLength(int sequence_id) const;
+  gsl::span<const int32_t> PageTable(int sequence_id) const;
+  int NumFreePages() const { return static_cast<int>(free_pages_.size()); }
+
+  // Keys or values of a layer and head in a page, with shape (page_size, head_size).
+  const float* Key(int page, int layer, int head) const { return PageData(page, layer, 0, head); }
+  const float* Value(int page, int layer, int head) const { return PageData(page, layer, 1, head); }
+
+  int NumLayers() const { return num_layers_; }
+  int NumHeads() const { return num_heads_; }
+  int HeadSize() const { return head_size_; }
+  int PageSize() const { return page_size_; }
+
+ private:
+  struct Sequence {
+    std::vector<int32_t> page_table;
+    int length = 0;
+    bool is_active = false;
+  };
+
+  float* PageData(int page, int layer, int kv, int head) const;
+  Sequence& GetSequence(int sequence_id);
+  const Sequence& GetSequence(int sequence_id) const;
+  int NewSequence();
+  int32_t AllocatePage();
+  void ReleasePage(int32_t page);
+
+  int num_layers_;
+  int num_heads_;
+  int head_size_;
+  int page_size_;
+  size_t page_elements_;  // num_layers x 2 x num_heads x page_size x head_size
+
+  BufferUniquePtr pages_buffer_;
+  float* pages_;
+  std::vector<int> ref_counts_;         // number of page tables that have the page
+  std::vector<int32_t> free_pages_;     // stack of unused pages
+  std::vector<Sequence> sequences_;
+  std::vector<int> free_sequence_ids_;  // stack of released sequence ids
+};
+
+// Computes the attention of the last token of each sequence with all tokens of the sequence in the cache:
+//   output(b, n) = Softmax(scale x query(b, n) x K(b, n)') x V(b, n)
+// where query and output have shape (batch_size, num_heads, head_size), and batch_size is the number of sequences.
+// The key and value of the last token shall be written to the cache before.
+void PagedAttention(const PagedKVCache& cache,
+                    int layer,
+                    gsl::span<const int> sequence_ids,
+                    const float* query,
+                    float* output,
+                    float scale,
+                    concurrency::ThreadPool* thread_pool);
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include "sampling.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// Number of candidates selected in the first chunk of top-p filtering. Most of the probability mass is covered
+// by a few tokens in text generation, so the following chunks are rarely needed.
+constexpr size_t kInitialTopPCandidates = 64;
+
+int32_t ArgMaxToken(gsl::span<const float> scores) {
+  return static_cast<int32_t>(std::max_element(scores.begin(), scores.end()) - scores.begin());
+}
+
+int32_t SampleTopKTopP(gsl::span<const float> scores,
+                       float temperature,
+                       int top_k,
+                       float top_p,
+                       int min_tokens_to_keep,
+                       std::vector<std::pair<float, int32_t>>& candidates,
+                       std::mt19937& generator) {
+  const size_t vocab_size = scores.size();
+  const float max_score = *std::max_element(scores.begin(), scores.end());
+  const float inverse_temperature = 1.0f / temperature;
+
+  // Candidates are pairs of (unnormalized probability, token), and the larger pair is the one with higher probability.
+  candidates.resize(vocab_size);
+  for (size_t i = 0; i < vocab_size; i++) {
+    candidates[i] = {std::exp((scores[i] - max_score) * inverse_temperature), static_cast<int32_t>(i)};
+  }
+  auto higher = std::greater<std::pair<float, int32_t>>();
+
+  size_t keep = vocab_size;
+  if (top_k > 0 && static_cast<size_t>(top_k) < vocab_size) {
+    keep = static_cast<size_t>(top_k);
+    std::nth_element(candidates.begin(), candidates.begin() + keep, candidates.end(), higher);
+    candidates.resize(keep);
+  }
+
+  float sum = 0.0f;
+  for (size_t i = 0; i < keep; i++) {
+    sum += candidates[i].first;
+  }
+
+  if (top_p < 1.0f) {
+    const float threshold = top_p * sum;
+    const size_t min_keep = std::min(static_cast<size_t>(std::max(min_tokens_to_keep, 1)), keep);
+
+    // Candidates in [0, sorted) are the highest ones in descending order.
+    size_t sorted = 0;
+    size_t chunk = kInitialTopPCandidates;
+    float cumulative = 0.0f;
+    size_t kept = 0;
+    while (kept == 0) {
+      size_t end = std::min(sorted + chunk, keep);
+      if (end < keep) {
+        std::nth_element(candidates.begin() + sorted, candidates.begin() + end, candidates.begin() + keep, higher);
+      }
+      std::sort(candidates.begin() + sorted, candidates.begin() + end, higher);
+
+      // A token is kept when the cumulative probability of the tokens before it is below top_p.
+      for (size_t i = sorted; i < end; i++) {
+        if (cumulative >= threshold && i >= min_keep) {
+          kept = i;
+          break;
+        }
+        cumulative += candidates[i].first;
+      }
+
+      if (kept == 0 && end == keep) {
+        kept = keep;
+      }
+
+      sorted = end;
+      chunk *= 2;
+    }
+
+    keep = kept;
+    sum = cumulative;
+  }
+
+  // Sample from the kept candidates. The last candidate is used when rounding errors make the draw pass the end.
+  std::uniform_real_distribution<float> distribution(0.0f, sum);
+  float draw = distribution(generator);
+  for (size_t i = 0; i < keep; i++) {
+    draw -= candidates[i].first;
+    if (draw < 0.0f) {
+      return candidates[i].second;
+    }
+  }
+  return candidates[keep - 1].second;
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
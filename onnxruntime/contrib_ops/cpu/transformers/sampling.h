@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <random>
+#include <utility>
+#include <vector>
+#include "gsl/gsl"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// Returns the token with maximum score. The first one is returned when there are ties.
+int32_t ArgMaxToken(gsl::span<const float> scores);
+
+// Samples a token from scores (logits or log probabilities) of one sequence after top-k and top-p filtering:
+//   probabilities = Softmax(scores / temperature)
+//   keep the top_k tokens with highest probabilities (top_k == 0 means all tokens),
+//   then keep the smallest set of tokens with highest probabilities whose cumulative probability is at least
+//   top_p (1.0 means no filtering), with at least min_tokens_to_keep tokens,
+//   and sample a token from the kept tokens with renormalized probabilities.
+// Top-p filtering is computed like the softmax over the tokens kept by top-k filtering.
+//
+// The filtering is fused with a partial selection, so the vocabulary is not sorted: candidates are selected
+// with nth_element in chunks of increasing size, and only the chunks needed to reach top_p are sorted.
+// candidates is a scratch buffer that could be reused across calls.
+int32_t SampleTopKTopP(gsl::span<const float> scores,
+                       float temperature,
+                       int top_k,
+                       float top_p,
+                       int min_tokens_to_keep,
+                       std::vector<std::pair<float, int32_t>>& candidates,
+                       std::mt19937& generator);
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -63,6 +63,16 @@ void Sequences::AppendNextTokenToSequences(
   current_sequences_buffer = 1 - current_sequences_buffer;
 }
 
+void Sequences::AppendNextTokenToSequences(gsl::span<int32_t>& next_tokens) {
+  gsl::span<int32_t> output = sequences[current_sequences_buffer];
+
+  for (int i = 0; i < batch_beam_size_; i++) {
+    output[SafeInt<size_t>(i) * max_length_ + current_length_] = next_tokens[i];
+  }
+
+  ++current_length_;
+}
+
 }  // namespace transformers
 }  // namespace contrib
 }  // namespace onnxruntime
\ No newline at end of file
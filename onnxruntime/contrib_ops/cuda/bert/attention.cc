@@ -22,7 +22,9 @@ namespace cuda {
       T,                                                          \
       kCudaExecutionProvider,                                     \
       (*KernelDefBuilder::Create())                               \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())  \
+          .MayInplace(4, 1)                                       \
+          .InputMemoryType(OrtMemTypeCPUInput, 6),                \
       Attention<T>);
 
 REGISTER_KERNEL_TYPED(float)
@@ -39,9 +41,11 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
   const Tensor* mask_index = context->Input<Tensor>(3);
   const Tensor* past = context->Input<Tensor>(4);
   const Tensor* extra_add_qk = context->Input<Tensor>(5);
+  const Tensor* past_seq_len = context->Input<Tensor>(6);
 
   auto& device_prop = GetDeviceProp();
-  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), mask_index, past, extra_add_qk, device_prop.maxThreadsPerBlock));
+  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), mask_index, past, extra_add_qk,
+                                  device_prop.maxThreadsPerBlock, past_seq_len));
 
   // input shape (batch_size, sequence_length, input_hidden_size)
   const auto& shape = input->Shape();
@@ -62,7 +66,8 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
   Tensor* output = context->Output(0, output_shape);
 
   int past_sequence_length = 0;
-  Tensor* present = GetPresent(context, past, batch_size, head_size, sequence_length, past_sequence_length);
+  Tensor* present = GetPresent(context, past, batch_size, head_size, sequence_length, past_sequence_length,
+                               past_seq_len);
 
   cublasHandle_t cublas = CublasHandle();
   constexpr size_t element_size = sizeof(T);
@@ -92,7 +97,11 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
       reinterpret_cast<const CudaT*>(input->template Data<T>()), k,
       &one, reinterpret_cast<CudaT*>(gemm_buffer.get()), n, device_prop));
 
-  size_t workSpaceSize = GetAttentionWorkspaceSize(element_size, batch_size, num_heads_, head_size, sequence_length, past_sequence_length);
+  const bool use_fused_attention = IsFusedAttentionSupported(
+      head_size, nullptr == mask_index ? gsl::span<const int64_t>() : mask_index->Shape().GetDims(),
+      nullptr != extra_add_qk);
+  size_t workSpaceSize = GetAttentionWorkspaceSize(element_size, batch_size, num_heads_, head_size, sequence_length,
+                                                   past_sequence_length, use_fused_attention);
   auto temp_buffer = GetScratchBuffer<void>(workSpaceSize);
   if (!LaunchAttentionKernel(
           device_prop,
@@ -112,7 +121,10 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
           past_sequence_length,
           nullptr == past ? nullptr : past->template Data<T>(),
           nullptr == extra_add_qk ? nullptr : extra_add_qk->template Data<T>(),
-          nullptr == present ? nullptr : present->template MutableData<T>())) {
+          nullptr == present ? nullptr : present->template MutableData<T>(),
+          past_present_share_buffer_,
+          past_present_share_buffer_ ? static_cast<int>(past->Shape()[3]) : 0,
+          use_fused_attention)) {
     // Get last error to reset it to cudaSuccess.
     CUDA_CALL(cudaGetLastError());
     return Status(common::ONNXRUNTIME, common::FAIL);
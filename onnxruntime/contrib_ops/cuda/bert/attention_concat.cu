@@ -217,6 +217,100 @@ bool LaunchConcatPastToPresent(cudaStream_t stream,
     present);
 }
 
+template <typename T>
+__global__ void AppendTensorToTensorInPlace(const int max_sequence_length,
+                                            const int past_sequence_length,
+                                            const int H,
+                                            const T* tensor_add,
+                                            T* tensor_out) {
+  int h = threadIdx.x;
+  const int n = threadIdx.y;
+  const int s = blockIdx.x;
+  const int b = blockIdx.y;
+  const int chunk_id = blockIdx.z;
+
+  const int sequence_length = gridDim.x;
+  const int batch_size = gridDim.y;
+  const int num_heads = blockDim.y;
+  const int stride = blockDim.x;
+
+  // K: number of identical tensors
+  // tensor_add:   K x BxNxSxH
+  // tensor_out:   K x BxNxMxH, where positions [S', S' + S) of M are written and the others are untouched.
+  const int bn = (chunk_id * batch_size + b) * num_heads + n;
+  const int out_offset = (bn * max_sequence_length + past_sequence_length + s) * H;
+  const int in_offset = (bn * sequence_length + s) * H;
+  while (h < H) {
+    tensor_out[out_offset + h] = tensor_add[in_offset + h];
+    h += stride;
+  }
+}
+
+template <typename T, typename VectorT, int VectorSize>
+bool LaunchAppendTensorToTensorInPlace(cudaStream_t stream,
+                                       const int max_sequence_length,
+                                       const int past_sequence_length,
+                                       const int sequence_length,
+                                       const int batch_size,
+                                       const int head_size,
+                                       const int num_heads,
+                                       const int max_threads_per_block,
+                                       const int matrix_num,
+                                       const T* tensor_add,
+                                       T* tensor_out) {
+  const dim3 grid(sequence_length, batch_size, matrix_num);
+  const int H = head_size / VectorSize;
+  const dim3 block(std::min(H, max_threads_per_block / num_heads), num_heads, 1);
+  AppendTensorToTensorInPlace<VectorT><<<grid, block, 0, stream>>>(max_sequence_length, past_sequence_length, H,
+                                                                   reinterpret_cast<const VectorT*>(tensor_add),
+                                                                   reinterpret_cast<VectorT*>(tensor_out));
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+bool LaunchAppendKVToPresent(cudaStream_t stream,
+                             const int max_sequence_length,
+                             const int past_sequence_length,
+                             const int sequence_length,
+                             const int batch_size,
+                             const int head_size,
+                             const int num_heads,
+                             const int max_threads_per_block,
+                             const float* k_v,
+                             float* present) {
+  if (0 == (head_size & 1)) {
+    return LaunchAppendTensorToTensorInPlace<float, float2, 2>(stream, max_sequence_length, past_sequence_length,
+                                                               sequence_length, batch_size, head_size, num_heads,
+                                                               max_threads_per_block, 2, k_v, present);
+  }
+  return LaunchAppendTensorToTensorInPlace<float, float, 1>(stream, max_sequence_length, past_sequence_length,
+                                                            sequence_length, batch_size, head_size, num_heads,
+                                                            max_threads_per_block, 2, k_v, present);
+}
+
+bool LaunchAppendKVToPresent(cudaStream_t stream,
+                             const int max_sequence_length,
+                             const int past_sequence_length,
+                             const int sequence_length,
+                             const int batch_size,
+                             const int head_size,
+                             const int num_heads,
+                             const int max_threads_per_block,
+                             const half* k_v,
+                             half* present) {
+  if (0 == (head_size % 4)) {
+    return LaunchAppendTensorToTensorInPlace<half, float2, 4>(stream, max_sequence_length, past_sequence_length,
+                                                              sequence_length, batch_size, head_size, num_heads,
+                                                              max_threads_per_block, 2, k_v, present);
+  } else if (0 == (head_size & 1)) {
+    return LaunchAppendTensorToTensorInPlace<half, half2, 2>(stream, max_sequence_length, past_sequence_length,
+                                                             sequence_length, batch_size, head_size, num_heads,
+                                                             max_threads_per_block, 2, k_v, present);
+  }
+  return LaunchAppendTensorToTensorInPlace<half, half, 1>(stream, max_sequence_length, past_sequence_length,
+                                                          sequence_length, batch_size, head_size, num_heads,
+                                                          max_threads_per_block, 2, k_v, present);
+}
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -60,8 +60,13 @@ size_t GetAttentionWorkspaceSize(
     int num_heads,
     int head_size,
     int sequence_length,
-    int past_sequence_length) {
+    int past_sequence_length,
+    bool use_fused_attention) {
   size_t qkv_size = 3 * batch_size * sequence_length * num_heads * head_size * element_size;
+  if (use_fused_attention) {
+    // The fused kernel does not need the buffers of the attention scores and probabilities.
+    return qkv_size;
+  }
   return qkv_size + 2 * GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, past_sequence_length + sequence_length);
 }
 
@@ -71,9 +76,10 @@ bool QkvToContext(
     const int batch_size, const int sequence_length, const int num_heads, const int head_size, const size_t element_size,
     const T* input, T* output, T* workspace,
     const int* mask_index, gsl::span<const int64_t> mask_index_dims,
-    bool is_unidirectional, int past_sequence_length, const T* past, const T* extra_add_qk, T* present, bool use_persistent_softmax) {
+    bool is_unidirectional, int past_sequence_length, const T* past, const T* extra_add_qk, T* present, bool use_persistent_softmax,
+    bool past_present_share_buffer, int max_sequence_length, bool use_fused_attention) {
   const int all_sequence_length = past_sequence_length + sequence_length;
-  const size_t bytes = GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, all_sequence_length);
+  const size_t bytes = use_fused_attention ? 0 : GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, all_sequence_length);
   T* scratch1 = workspace;
   T* scratch2 = scratch1 + (bytes / element_size);
   T* scratch3 = scratch2 + (bytes / element_size);
@@ -99,9 +105,20 @@ bool QkvToContext(
   // Concat past (2xBxNxS'xH) to present (2xBxNxS*xH):
   // past_k (BxNxS'xH) + k (BxNxSxH) => present_k (BxNxS*xH)
   // past_v (BxNxS'xH) + v (BxNxSxH) => present_v (BxNxS*xH)
-  const int present_size_per_batch = all_sequence_length * head_size;
+  // When past and present share a buffer (2xBxNxMxH), k and v are appended in place after the S' valid positions,
+  // and only the first S* positions of each batch are used below.
+  const int present_size_per_batch = (past_present_share_buffer ? max_sequence_length : all_sequence_length) * head_size;
   if (nullptr != present) {
-    if (!LaunchConcatPastToPresent(stream, all_sequence_length, sequence_length, batch_size, head_size, num_heads, max_threads_per_block, past, k, present)) {
+    if (past_present_share_buffer) {
+      if (past != present &&
+          !CUDA_CALL(cudaMemcpyAsync(present, past, 2 * batches * present_size_per_batch * element_size,
+                                     cudaMemcpyDeviceToDevice, stream))) {
+        return false;
+      }
+      if (!LaunchAppendKVToPresent(stream, max_sequence_length, past_sequence_length, sequence_length, batch_size, head_size, num_heads, max_threads_per_block, k, present)) {
+        return false;
+      }
+    } else if (!LaunchConcatPastToPresent(stream, all_sequence_length, sequence_length, batch_size, head_size, num_heads, max_threads_per_block, past, k, present)) {
       return false;
     }
 
@@ -110,6 +127,13 @@ bool QkvToContext(
     v = present + batches * present_size_per_batch;
   }
 
+  if (use_fused_attention) {
+    // mask_index has 1D shape: either (batch_size) or (2*batch_size). Only the later one has start postions.
+    const int* mask_start = (nullptr != mask_index && mask_index_dims.at(0) > batch_size) ? mask_index + batch_size : nullptr;
+    return LaunchFusedAttention(stream, batch_size, sequence_length, all_sequence_length, num_heads, head_size,
+                                present_size_per_batch, q, k, v, mask_index, mask_start, is_unidirectional, output);
+  }
+
   // Raw attention mask could be 2D (BxS) or 3D (BxSxS*) or 4D(Bx1xMxM), where M is the max sequence length.
   bool use_raw_attention_mask = (nullptr != mask_index && mask_index_dims.size() >= 2);
 
@@ -182,7 +206,10 @@ bool LaunchAttentionKernel(
     int past_sequence_length,
     const void* past,
     const void* extra_add_qk,
-    void* present) {
+    void* present,
+    bool past_present_share_buffer,
+    int max_sequence_length,
+    bool use_fused_attention) {
 
   // For testing, environment variable ORT_TRANSFORMER_OPTIONS=1 could enable persistent softmax
   const TransformerOptions* options = TransformerOptions::GetInstance();
@@ -194,14 +221,16 @@ bool LaunchAttentionKernel(
                         reinterpret_cast<const half*>(input), reinterpret_cast<half*>(output), reinterpret_cast<half*>(workspace),
                         mask_index, mask_index_dims, is_unidirectional,
                         past_sequence_length, reinterpret_cast<const half*>(past), reinterpret_cast<const half*>(extra_add_qk),
-                        reinterpret_cast<half*>(present), use_persistent_softmax);
+                        reinterpret_cast<half*>(present), use_persistent_softmax,
+                        past_present_share_buffer, max_sequence_length, use_fused_attention);
   } else {
     return QkvToContext(prop, cublas, stream,
                         batch_size, sequence_length, num_heads, head_size, element_size,
                         reinterpret_cast<const float*>(input), reinterpret_cast<float*>(output), reinterpret_cast<float*>(workspace),
                         mask_index, mask_index_dims, is_unidirectional,
                         past_sequence_length, reinterpret_cast<const float*>(past), reinterpret_cast<const float*>(extra_add_qk),
-                        reinterpret_cast<float*>(present), use_persistent_softmax);
+                        reinterpret_cast<float*>(present), use_persistent_softmax,
+                        past_present_share_buffer, max_sequence_length, use_fused_attention);
   }
 }
 
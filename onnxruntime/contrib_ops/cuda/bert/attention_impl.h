@@ -16,7 +16,8 @@ size_t GetAttentionWorkspaceSize(
     int num_heads,
     int head_size,
     int sequence_length,
-    int past_sequence_length);
+    int past_sequence_length,
+    bool use_fused_attention = false);
 
 bool LaunchAttentionKernel(
     const cudaDeviceProp& prop,                   // Device Properties
@@ -36,9 +37,34 @@ bool LaunchAttentionKernel(
     int past_sequence_length,                     // Sequence length in past state
     const void* past,                             // Past state input
     const void* extra_add_qk,                     // Additional Add
-    void* present                                 // Present state output
+    void* present,                                // Present state output
+    bool past_present_share_buffer = false,       // Whether present is appended in place to the buffer of past
+    int max_sequence_length = 0,                  // Sequence length of the past and present buffer when shared
+    bool use_fused_attention = false              // Whether to use the fused kernel, see IsFusedAttentionSupported
 );
 
+// Whether the fused attention kernel, which does not materialize the attention scores, supports the attention:
+// a head size of 32, 64 or 128, no mask or a 1D mask index, and no extra add.
+bool IsFusedAttentionSupported(int head_size, gsl::span<const int64_t> mask_index_dims, bool has_extra_add_qk);
+
+// Computes softmax(Q*K'/sqrt(H)) * V for Q (BxNxSxH), K and V (BxNxS*xH, kv_batch_stride elements apart for each
+// batch and head) into output (BxSxNxH).
+template <typename T>
+bool LaunchFusedAttention(cudaStream_t stream,
+                          const int batch_size,
+                          const int sequence_length,
+                          const int all_sequence_length,
+                          const int num_heads,
+                          const int head_size,
+                          const int kv_batch_stride,
+                          const T* q,
+                          const T* k,
+                          const T* v,
+                          const int* mask_end,    // End position of each sequence. NULL means no mask.
+                          const int* mask_start,  // Start position of each sequence. NULL means 0.
+                          const bool is_unidirectional,
+                          T* output);
+
 bool LaunchDecoderAttentionKernel(
     const cudaDeviceProp& prop,                   // Device Properties
     cudaStream_t stream,                          // Cuda stream
@@ -127,6 +153,29 @@ bool LaunchConcatPastToPresent(cudaStream_t stream,
                                const half* k_v,
                                half* present);
 
+// Append K and V (2xBxNxSxH) to present (2xBxNxMxH) in place after the first past_sequence_length positions.
+bool LaunchAppendKVToPresent(cudaStream_t stream,
+                             const int max_sequence_length,
+                             const int past_sequence_length,
+                             const int sequence_length,
+                             const int batch_size,
+                             const int head_size,
+                             const int num_heads,
+                             const int max_threads_per_block,
+                             const float* k_v,
+                             float* present);
+
+bool LaunchAppendKVToPresent(cudaStream_t stream,
+                             const int max_sequence_length,
+                             const int past_sequence_length,
+                             const int sequence_length,
+                             const int batch_size,
+                             const int head_size,
+                             const int num_heads,
+                             const int max_threads_per_block,
+                             const half* k_v,
+                             half* present);
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -0,0 +1,276 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Fused attention: softmax(Q*K'/sqrt(H)) * V is computed in one kernel, in the way of flash attention. The keys and
+// values are processed in tiles staged in shared memory, and the softmax is computed online with a running max and
+// sum, so that the BxNxSxS* score matrix is never materialized in global memory.
+
+#include <cuda_fp16.h>
+#include <math_constants.h>
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cuda_common.h"
+#include "attention_impl.h"
+#include "transformer_common.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+// Each warp computes one query row. The warps of a block share the key and value tiles.
+constexpr int kFusedAttentionWarps = 4;
+
+// Number of keys in a tile, one per lane when computing the scores.
+constexpr int kFusedAttentionTileSize = GPU_WARP_SIZE;
+
+__device__ __forceinline__ float WarpReduceMax(float value) {
+#pragma unroll
+  for (int offset = GPU_WARP_SIZE / 2; offset > 0; offset /= 2) {
+    value = fmaxf(value, WARP_SHFL_XOR(value, offset));
+  }
+  return value;
+}
+
+__device__ __forceinline__ float WarpReduceSum(float value) {
+#pragma unroll
+  for (int offset = GPU_WARP_SIZE / 2; offset > 0; offset /= 2) {
+    value += WARP_SHFL_XOR(value, offset);
+  }
+  return value;
+}
+
+// Q is BxNxSxH. K and V are BxNxS*xH, with kv_batch_stride elements between the (b, n) batches since they might be
+// in a present buffer of a larger max sequence length. The output is BxSxNxH.
+// The mask is the same as the one of MaskedSoftmaxKernelSmall: keys in [mask_start, mask_end) are attended to, and
+// the unidirectional mask is applied on top of it.
+template <typename T, int kHeadSize>
+__global__ void FusedAttentionKernel(const int sequence_length,
+                                     const int all_sequence_length,
+                                     const int num_heads,
+                                     const int kv_batch_stride,
+                                     const float scale,
+                                     const T* q,
+                                     const T* k,
+                                     const T* v,
+                                     const int* mask_end,
+                                     const int* mask_start,
+                                     const bool is_unidirectional,
+                                     T* output) {
+  constexpr int kElementsPerLane = kHeadSize / GPU_WARP_SIZE;
+
+  // Rows of the key tile are padded by one so that lanes reading different keys hit different banks.
+  __shared__ float k_tile[kFusedAttentionTileSize][kHeadSize + 1];
+  __shared__ float v_tile[kFusedAttentionTileSize][kHeadSize];
+  __shared__ float q_rows[kFusedAttentionWarps][kHeadSize];
+
+  const int warp = threadIdx.x / GPU_WARP_SIZE;
+  const int lane = threadIdx.x % GPU_WARP_SIZE;
+  const int batch_head = blockIdx.y;
+  const int batch = batch_head / num_heads;
+  const int head = batch_head % num_heads;
+  const int first_row = blockIdx.x * kFusedAttentionWarps;
+  const int row = first_row + warp;
+  const bool is_active = row < sequence_length;
+
+  int start_position = mask_start != nullptr ? max(0, mask_start[batch]) : 0;
+  int end_position = mask_end != nullptr ? min(all_sequence_length, mask_end[batch]) : all_sequence_length;
+  // Attend to no word has same effect as attend to all words. This is added to get parity with CPU result.
+  if (start_position >= end_position) {
+    start_position = 0;
+    end_position = all_sequence_length;
+  }
+
+  // Keys in [0, unidirectional_end) are visible to this row in the unidirectional case.
+  const int past_sequence_length = all_sequence_length - sequence_length;
+  const int unidirectional_end = past_sequence_length + row + 1;
+
+  // Keys past the last one visible to the rows of this block are skipped. The unidirectional end grows with the row,
+  // so when it is past the start position for the first row, it is for all the rows of the block.
+  int key_end = end_position;
+  if (is_unidirectional && past_sequence_length + first_row + 1 > start_position) {
+    const int last_row = min(sequence_length - 1, first_row + kFusedAttentionWarps - 1);
+    key_end = min(end_position, past_sequence_length + last_row + 1);
+  }
+
+  const T* q_row = q + (static_cast<int64_t>(batch_head) * sequence_length + row) * kHeadSize;
+  const T* k_batch = k + static_cast<int64_t>(batch_head) * kv_batch_stride;
+  const T* v_batch = v + static_cast<int64_t>(batch_head) * kv_batch_stride;
+
+  if (is_active) {
+#pragma unroll
+    for (int i = 0; i < kElementsPerLane; i++) {
+      q_rows[warp][lane + i * GPU_WARP_SIZE] = static_cast<float>(q_row[lane + i * GPU_WARP_SIZE]) * scale;
+    }
+  }
+
+  float accumulator[kElementsPerLane];
+#pragma unroll
+  for (int i = 0; i < kElementsPerLane; i++) {
+    accumulator[i] = 0.f;
+  }
+  float running_max = -CUDART_INF_F;
+  float running_sum = 0.f;
+
+  for (int tile_start = 0; tile_start < key_end; tile_start += kFusedAttentionTileSize) {
+    __syncthreads();
+    for (int i = threadIdx.x; i < kFusedAttentionTileSize * kHeadSize; i += blockDim.x) {
+      const int key = tile_start + i / kHeadSize;
+      const int d = i % kHeadSize;
+      const bool in_range = key < key_end;
+      k_tile[i / kHeadSize][d] = in_range ? static_cast<float>(k_batch[key * kHeadSize + d]) : 0.f;
+      v_tile[i / kHeadSize][d] = in_range ? static_cast<float>(v_batch[key * kHeadSize + d]) : 0.f;
+    }
+    __syncthreads();
+
+    if (!is_active) {
+      continue;
+    }
+
+    // Each lane computes the score of one key of the tile.
+    const int key = tile_start + lane;
+    bool is_valid = key < key_end && key >= start_position && key < end_position;
+    if (is_unidirectional) {
+      if (unidirectional_end <= start_position) {
+        // Same as SoftmaxSmall: [0, unidirectional_end) is also attended to in this situation.
+        is_valid = key < key_end && (is_valid || key < unidirectional_end);
+      } else {
+        is_valid = is_valid && key < unidirectional_end;
+      }
+    }
+
+    float score = -CUDART_INF_F;
+    if (is_valid) {
+      float dot = 0.f;
+#pragma unroll
+      for (int d = 0; d < kHeadSize; d++) {
+        dot += q_rows[warp][d] * k_tile[lane][d];
+      }
+      score = dot;
+    }
+
+    const float tile_max = WarpReduceMax(score);
+    const float new_max = fmaxf(running_max, tile_max);
+    if (new_max == -CUDART_INF_F) {
+      // No key of this tile (nor of the previous ones) is attended to.
+      continue;
+    }
+
+    const float p = is_valid ? expf(score - new_max) : 0.f;
+    const float correction = expf(running_max - new_max);
+    running_sum = running_sum * correction + WarpReduceSum(p);
+    running_max = new_max;
+
+#pragma unroll
+    for (int i = 0; i < kElementsPerLane; i++) {
+      accumulator[i] *= correction;
+    }
+
+#pragma unroll
+    for (int j = 0; j < kFusedAttentionTileSize; j++) {
+      const float p_j = WARP_SHFL(p, j);
+#pragma unroll
+      for (int i = 0; i < kElementsPerLane; i++) {
+        accumulator[i] += p_j * v_tile[j][lane + i * GPU_WARP_SIZE];
+      }
+    }
+  }
+
+  if (is_active) {
+    const float sum_reverse = running_sum > 0.f ? 1.f / running_sum : 0.f;
+    T* output_row = output + ((static_cast<int64_t>(batch) * sequence_length + row) * num_heads + head) * kHeadSize;
+#pragma unroll
+    for (int i = 0; i < kElementsPerLane; i++) {
+      output_row[lane + i * GPU_WARP_SIZE] = T(accumulator[i] * sum_reverse);
+    }
+  }
+}
+
+template <typename T, int kHeadSize>
+bool LaunchFusedAttentionKernel(cudaStream_t stream,
+                                const int batch_size,
+                                const int sequence_length,
+                                const int all_sequence_length,
+                                const int num_heads,
+                                const int kv_batch_stride,
+                                const T* q,
+                                const T* k,
+                                const T* v,
+                                const int* mask_end,
+                                const int* mask_start,
+                                const bool is_unidirectional,
+                                T* output) {
+  const dim3 grid(CeilDiv(sequence_length, kFusedAttentionWarps), batch_size * num_heads, 1);
+  const dim3 block(kFusedAttentionWarps * GPU_WARP_SIZE, 1, 1);
+  const float scale = 1.f / sqrt(static_cast<float>(kHeadSize));
+  FusedAttentionKernel<T, kHeadSize><<<grid, block, 0, stream>>>(
+      sequence_length, all_sequence_length, num_heads, kv_batch_stride, scale,
+      q, k, v, mask_end, mask_start, is_unidirectional, output);
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+}  // namespace
+
+bool IsFusedAttentionSupported(int head_size, gsl::span<const int64_t> mask_index_dims, bool has_extra_add_qk) {
+  if (TransformerOptions::GetInstance()->DisableFusedAttention()) {
+    return false;
+  }
+
+  // Raw attention masks and the extra add are applied by the softmax kernels of the unfused path.
+  return (head_size == 32 || head_size == 64 || head_size == 128) &&
+         mask_index_dims.size() <= 1 &&
+         !has_extra_add_qk;
+}
+
+template <typename T>
+bool LaunchFusedAttention(cudaStream_t stream,
+                          const int batch_size,
+                          const int sequence_length,
+                          const int all_sequence_length,
+                          const int num_heads,
+                          const int head_size,
+                          const int kv_batch_stride,
+                          const T* q,
+                          const T* k,
+                          const T* v,
+                          const int* mask_end,
+                          const int* mask_start,
+                          const bool is_unidirectional,
+                          T* output) {
+  if (sequence_length == 0) {
+    return true;
+  }
+
+  switch (head_size) {
+    case 32:
+      return LaunchFusedAttentionKernel<T, 32>(stream, batch_size, sequence_length, all_sequence_length, num_heads,
+                                               kv_batch_stride, q, k, v, mask_end, mask_start, is_unidirectional,
+                                               output);
+    case 64:
+      return LaunchFusedAttentionKernel<T, 64>(stream, batch_size, sequence_length, all_sequence_length, num_heads,
+                                               kv_batch_stride, q, k, v, mask_end, mask_start, is_unidirectional,
+                                               output);
+    case 128:
+      return LaunchFusedAttentionKernel<T, 128>(stream, batch_size, sequence_length, all_sequence_length, num_heads,
+                                                kv_batch_stride, q, k, v, mask_end, mask_start, is_unidirectional,
+                                                output);
+    default:
+      return false;
+  }
+}
+
+#define SPECIALIZED_LAUNCH_FUSED_ATTENTION(T)                                                                      \
+  template bool LaunchFusedAttention<T>(cudaStream_t stream, const int batch_size, const int sequence_length,     \
+                                        const int all_sequence_length, const int num_heads, const int head_size,  \
+                                        const int kv_batch_stride, const T* q, const T* k, const T* v,            \
+                                        const int* mask_end, const int* mask_start, const bool is_unidirectional, \
+                                        T* output);
+
+SPECIALIZED_LAUNCH_FUSED_ATTENTION(float)
+SPECIALIZED_LAUNCH_FUSED_ATTENTION(half)
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
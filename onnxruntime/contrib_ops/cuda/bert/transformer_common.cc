@@ -26,6 +26,7 @@ const TransformerOptions* TransformerOptions::GetInstance() {
       std::cout << "ORT_TRANSFORMER_OPTIONS: IsPrecisionMode=" << instance.IsPrecisionMode()
                 << ",DisablePersistentSoftmax=" << instance.DisablePersistentSoftmax()
                 << ",DisableHalf2=" << instance.DisableHalf2()
+                << ",DisableFusedAttention=" << instance.DisableFusedAttention()
                 << std::endl;
   }
 
@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/fused_elementwise.h"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace onnxruntime::cuda;
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    float,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+constexpr const char* kFunctionName = "fused_elementwise";
+constexpr int kThreadsPerBlock = 256;
+
+// how an input is read relative to the output, passed to the generated kernel
+enum InputKind : int {
+  kFull = 0,         // same shape as the output
+  kScalar = 1,       // a single element
+  kInnerVector = 2,  // the size of the innermost output dimension, all outer dimensions are 1
+};
+
+bool IsBinary(const std::string& op_type) {
+  return op_type == "Add" || op_type == "Sub" || op_type == "Mul" || op_type == "Div";
+}
+
+// Returns the CUDA expression of an operation, with the same semantics as the CPU kernel.
+std::string GetExpression(const std::string& op_type, const std::string& a, const std::string& b) {
+  if (op_type == "Add") return a + " + " + b;
+  if (op_type == "Sub") return a + " - " + b;
+  if (op_type == "Mul") return a + " * " + b;
+  if (op_type == "Div") return a + " / " + b;
+  if (op_type == "Abs") return "fabsf(" + a + ")";
+  if (op_type == "Erf") return "erff(" + a + ")";
+  if (op_type == "Exp") return "expf(" + a + ")";
+  if (op_type == "Neg") return "-" + a;
+  if (op_type == "Reciprocal") return "1.0f / " + a;
+  // NaN is propagated like std::max(x, 0.0f)
+  if (op_type == "Relu") return a + " < 0.0f ? 0.0f : " + a;
+  if (op_type == "Sigmoid") return "1.0f / (1.0f + expf(-" + a + "))";
+  if (op_type == "Sqrt") return "sqrtf(" + a + ")";
+  if (op_type == "Tanh") return "tanhf(" + a + ")";
+  ORT_THROW("FusedElementwise does not support operation ", op_type);
+}
+
+// Generates a kernel computing an element of the output per iteration of a grid-stride loop. Each input is passed
+// with its InputKind, and the value of each operand is held in a local variable: v<i> for operand i.
+std::string GenerateSource(const std::vector<std::string>& op_types, const std::vector<int64_t>& operands,
+                           int64_t num_inputs) {
+  std::ostringstream source;
+  source.imbue(std::locale::classic());
+  source << "extern \"C\" __global__ void " << kFunctionName
+         << "(float* __restrict__ output, long long count, long long inner_size";
+  for (int64_t i = 0; i < num_inputs; i++) {
+    source << ", const float* __restrict__ input" << i << ", int kind" << i;
+  }
+
+  source << ") {\n"
+         << "  const long long stride = (long long)blockDim.x * gridDim.x;\n"
+         << "  for (long long i = (long long)blockIdx.x * blockDim.x + threadIdx.x; i < count; i += stride) {\n";
+  for (int64_t i = 0; i < num_inputs; i++) {
+    source << "    const float v" << i << " = input" << i << "[kind" << i << " == " << kFull << " ? i : (kind" << i
+           << " == " << kScalar << " ? 0 : i % inner_size)];\n";
+  }
+
+  for (size_t i = 0; i < op_types.size(); i++) {
+    const std::string a = "v" + std::to_string(operands[2 * i]);
+    const std::string b = "v" + std::to_string(operands[2 * i + 1]);
+    source << "    const float v" << num_inputs + static_cast<int64_t>(i) << " = "
+           << GetExpression(op_types[i], a, b) << ";\n";
+  }
+
+  source << "    output[i] = v" << num_inputs + static_cast<int64_t>(op_types.size()) - 1 << ";\n"
+         << "  }\n"
+         << "}\n";
+  return source.str();
+}
+
+}  // namespace
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : CudaKernel(info) {
+  const auto op_types = info.GetAttrsOrDefault<std::string>("operations");
+  const auto operands = info.GetAttrsOrDefault<int64_t>("operands");
+  const int64_t num_inputs = static_cast<int64_t>(info.GetInputCount());
+  ORT_ENFORCE(!op_types.empty(), "FusedElementwise requires at least one operation.");
+  ORT_ENFORCE(operands.size() == 2 * op_types.size(),
+              "FusedElementwise requires two operands per operation. Got ", operands.size(), " operands for ",
+              op_types.size(), " operations.");
+
+  for (size_t i = 0; i < op_types.size(); i++) {
+    // an operand refers to an input or to the result of a previous operation
+    const int64_t limit = num_inputs + static_cast<int64_t>(i);
+    const int64_t a = operands[2 * i];
+    const int64_t b = operands[2 * i + 1];
+    ORT_ENFORCE(a >= 0 && a < limit, "Invalid operand ", a, " for operation ", i);
+    if (IsBinary(op_types[i])) {
+      ORT_ENFORCE(b >= 0 && b < limit, "Invalid operand ", b, " for operation ", i);
+    }
+  }
+
+  // The kernel is compiled when the session is initialized, or loaded from the cache directory of the provider.
+  const auto* cuda_ep = static_cast<const CUDAExecutionProvider*>(info.GetExecutionProvider());
+  ORT_THROW_IF_ERROR(FusedElementwiseCompiler::Instance().GetFunction(
+      GenerateSource(op_types, operands, num_inputs), kFunctionName, GetDeviceId(), GetDeviceProp(),
+      cuda_ep->GetFusedElementwiseCacheDir(), function_));
+}
+
+Status FusedElementwise::ComputeInternal(OpKernelContext* context) const {
+  const int num_inputs = context->InputCount();
+
+  // the output shape is the multidirectional broadcast of the input shapes
+  size_t rank = 0;
+  for (int i = 0; i < num_inputs; i++) {
+    rank = std::max(rank, context->Input<Tensor>(i)->Shape().NumDimensions());
+  }
+
+  TensorShapeVector output_dims(rank, 1);
+  for (int i = 0; i < num_inputs; i++) {
+    const auto& shape = context->Input<Tensor>(i)->Shape();
+    const size_t offset = rank - shape.NumDimensions();
+    for (size_t axis = 0; axis < shape.NumDimensions(); axis++) {
+      const int64_t dim = shape[axis];
+      int64_t& output_dim = output_dims[offset + axis];
+      ORT_RETURN_IF_NOT(dim == 1 || output_dim == 1 || dim == output_dim,
+                        "FusedElementwise inputs are not broadcastable: input ", i, " has shape ", shape);
+      if (dim != 1) {
+        output_dim = dim;
+      }
+    }
+  }
+
+  const TensorShape output_shape(output_dims);
+  Tensor* output = context->Output(0, output_shape);
+  long long output_size = static_cast<long long>(output_shape.Size());
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  long long inner_size = rank == 0 ? 1 : static_cast<long long>(output_dims.back());
+  InlinedVector<const float*> input_data(num_inputs);
+  InlinedVector<int> input_kinds(num_inputs);
+  for (int i = 0; i < num_inputs; i++) {
+    const Tensor* input = context->Input<Tensor>(i);
+    const long long size = static_cast<long long>(input->Shape().Size());
+    if (size == output_size) {
+      input_kinds[i] = kFull;
+    } else if (size == 1) {
+      input_kinds[i] = kScalar;
+    } else if (size == inner_size && input->Shape()[input->Shape().NumDimensions() - 1] == size) {
+      input_kinds[i] = kInnerVector;
+    } else {
+      // produced by ElementwiseFusion only for the broadcasts above
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise does not support broadcasting input ",
+                             i, " with shape ", input->Shape(), " to ", output_shape);
+    }
+
+    input_data[i] = input->Data<float>();
+  }
+
+  float* output_data = output->MutableData<float>();
+  InlinedVector<void*> args{&output_data, &output_size, &inner_size};
+  for (int i = 0; i < num_inputs; i++) {
+    args.push_back(&input_data[i]);
+    args.push_back(&input_kinds[i]);
+  }
+
+  const long long num_blocks = std::min<long long>((output_size + kThreadsPerBlock - 1) / kThreadsPerBlock,
+                                                   GetDeviceProp().maxGridSize[0]);
+
+  // The function is loaded in the primary context of the device, which the thread may not have made current yet.
+  ORT_RETURN_IF(cuCtxPushCurrent(function_.context) != CUDA_SUCCESS,
+                "FusedElementwise failed to make the context of the device current.");
+  const CUresult result = cuLaunchKernel(function_.function, static_cast<unsigned int>(num_blocks), 1, 1,
+                                         kThreadsPerBlock, 1, 1, 0, Stream(), args.data(), nullptr);
+  CUcontext popped;
+  cuCtxPopCurrent(&popped);
+  if (result != CUDA_SUCCESS) {
+    const char* error = nullptr;
+    cuGetErrorName(result, &error);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "FusedElementwise failed to launch its kernel: ",
+                           error == nullptr ? "unknown" : error);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
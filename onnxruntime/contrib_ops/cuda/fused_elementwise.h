@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/cuda/cuda_kernel.h"
+#include "contrib_ops/cuda/fused_elementwise_compiler.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+// Evaluates a chain of elementwise operations in a single kernel, generated from the operations of the node and
+// compiled by NVRTC when the kernel is created, so that the intermediate values stay in registers.
+class FusedElementwise final : public CudaKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  FusedElementwiseCompiler::Function function_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
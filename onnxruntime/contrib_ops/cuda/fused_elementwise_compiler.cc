@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/fused_elementwise_compiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+#include <nvrtc.h>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define NVRTC_RETURN_IF_ERROR(expr)                                                                       \
+  do {                                                                                                    \
+    const nvrtcResult nvrtc_result = (expr);                                                              \
+    ORT_RETURN_IF(nvrtc_result != NVRTC_SUCCESS, "NVRTC error executing ", #expr, ": ",                   \
+                  nvrtcGetErrorString(nvrtc_result));                                                     \
+  } while (0)
+
+#define CU_RETURN_IF_ERROR(expr)                                                                          \
+  do {                                                                                                    \
+    const CUresult cu_result = (expr);                                                                    \
+    if (cu_result != CUDA_SUCCESS) {                                                                      \
+      const char* cu_error = nullptr;                                                                     \
+      cuGetErrorName(cu_result, &cu_error);                                                               \
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CUDA driver error executing ", #expr, ": ",              \
+                             cu_error == nullptr ? "unknown" : cu_error);                                 \
+    }                                                                                                     \
+  } while (0)
+
+// A cache file holds the size of the key on the first line, the key, then the cubin. The key is checked when the
+// file is loaded, since the file name is only its hash. The files are written under a temporary name then renamed,
+// so the processes sharing the directory don't read partial files.
+namespace {
+std::string HashKey(const std::string& key) {
+  // 64-bit FNV-1a, stable across builds and processes
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : key) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+
+  char hex[17];
+  snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+  return hex;
+}
+
+bool LoadCubin(const std::string& path, const std::string& key, std::string& cubin) {
+  std::ifstream file(path, std::ios::binary);
+  size_t key_size = 0;
+  if (!(file >> key_size) || file.get() != '\n' || key_size != key.size()) {
+    return false;
+  }
+
+  std::string file_key(key_size, '\0');
+  if (!file.read(&file_key[0], static_cast<std::streamsize>(key_size)) || file_key != key) {
+    return false;
+  }
+
+  cubin.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return !cubin.empty();
+}
+
+void SaveCubin(const std::string& path, const std::string& key, const std::string& cubin) {
+  std::ostringstream suffix;
+  suffix << ".tmp" << std::this_thread::get_id() << '_' << std::chrono::steady_clock::now().time_since_epoch().count();
+  const std::string temp_path = path + suffix.str();
+  {
+    std::ofstream file(temp_path, std::ios::binary);
+    file << key.size() << '\n'
+         << key;
+    file.write(cubin.data(), static_cast<std::streamsize>(cubin.size()));
+    if (!file.flush()) {
+      LOGS_DEFAULT(WARNING) << "Failed to write a FusedElementwise kernel to " << temp_path;
+      return;
+    }
+  }
+
+  // another process may have written the file first, in which case the rename can fail on some platforms
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+  }
+}
+}  // namespace
+
+FusedElementwiseCompiler& FusedElementwiseCompiler::Instance() {
+  static FusedElementwiseCompiler compiler;
+  return compiler;
+}
+
+Status FusedElementwiseCompiler::Compile(const std::string& source, const cudaDeviceProp& device_prop,
+                                         std::string& cubin) {
+  nvrtcProgram program;
+  NVRTC_RETURN_IF_ERROR(nvrtcCreateProgram(&program, source.c_str(), "fused_elementwise.cu", 0, nullptr, nullptr));
+  auto program_guard = gsl::finally([&program]() { nvrtcDestroyProgram(&program); });
+
+  const std::string arch = "--gpu-architecture=sm_" + std::to_string(device_prop.major) +
+                           std::to_string(device_prop.minor);
+  const char* options[] = {arch.c_str()};
+  const nvrtcResult result = nvrtcCompileProgram(program, 1, options);
+  if (result != NVRTC_SUCCESS) {
+    size_t log_size = 0;
+    std::string log;
+    if (nvrtcGetProgramLogSize(program, &log_size) == NVRTC_SUCCESS && log_size > 1) {
+      log.resize(log_size);
+      nvrtcGetProgramLog(program, &log[0]);
+      log.resize(log_size - 1);
+    }
+
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to compile a FusedElementwise kernel: ",
+                           nvrtcGetErrorString(result), "\n", log);
+  }
+
+  size_t cubin_size = 0;
+  NVRTC_RETURN_IF_ERROR(nvrtcGetCUBINSize(program, &cubin_size));
+  cubin.resize(cubin_size);
+  NVRTC_RETURN_IF_ERROR(nvrtcGetCUBIN(program, &cubin[0]));
+  return Status::OK();
+}
+
+Status FusedElementwiseCompiler::GetFunction(const std::string& source, const char* name, int device_id,
+                                             const cudaDeviceProp& device_prop, const std::string& cache_dir,
+                                             Function& function) {
+  int nvrtc_major = 0;
+  int nvrtc_minor = 0;
+  NVRTC_RETURN_IF_ERROR(nvrtcVersion(&nvrtc_major, &nvrtc_minor));
+  std::ostringstream key_stream;
+  key_stream << "sm" << device_prop.major << device_prop.minor << ";nvrtc" << nvrtc_major << '.' << nvrtc_minor
+             << ';' << name << '\n'
+             << source;
+  const std::string key = key_stream.str();
+  const std::string function_key = std::to_string(device_id) + ';' + key;
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = functions_.find(function_key);
+  if (it != functions_.end()) {
+    function = it->second;
+    return Status::OK();
+  }
+
+  std::string cubin;
+  const std::string path = cache_dir.empty() ? "" : cache_dir + "/fused_elementwise_" + HashKey(key) + ".cubin";
+  if (path.empty() || !LoadCubin(path, key, cubin)) {
+    ORT_RETURN_IF_ERROR(Compile(source, device_prop, cubin));
+    if (!path.empty()) {
+      SaveCubin(path, key, cubin);
+    }
+  }
+
+  // The module is loaded in the primary context of the device, which the CUDA runtime uses.
+  CUdevice device;
+  CUcontext context;
+  CU_RETURN_IF_ERROR(cuInit(0));
+  CU_RETURN_IF_ERROR(cuDeviceGet(&device, device_id));
+  CU_RETURN_IF_ERROR(cuDevicePrimaryCtxRetain(&context, device));
+  CU_RETURN_IF_ERROR(cuCtxPushCurrent(context));
+  auto context_guard = gsl::finally([]() {
+    CUcontext popped;
+    cuCtxPopCurrent(&popped);
+  });
+
+  CUmodule module;
+  CU_RETURN_IF_ERROR(cuModuleLoadData(&module, cubin.data()));
+  function.context = context;
+  CU_RETURN_IF_ERROR(cuModuleGetFunction(&function.function, module, name));
+  functions_.emplace(function_key, function);
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Process-wide cache of the kernels generated for the FusedElementwise nodes and compiled by NVRTC, so that the
+// sessions of a process compile an expression once per device. The cubins can be persisted to a directory, a file
+// per kernel named after the hash of its key, so that the processes sharing the directory load them instead of
+// compiling them again.
+// The key is the source of the kernel, the compute capability of the device and the NVRTC version, so a directory
+// can be shared between devices and CUDA versions, each of them using its own files.
+class FusedElementwiseCompiler {
+ public:
+  // A compiled function and the primary context of the device it is loaded in, which must be current to launch it.
+  struct Function {
+    CUcontext context;
+    CUfunction function;
+  };
+
+  static FusedElementwiseCompiler& Instance();
+
+  // Returns the function named `name` in `source` compiled for the device `device_id`. If `cache_dir` is not empty,
+  // the cubin is loaded from it if found, else compiled and written to it.
+  Status GetFunction(const std::string& source, const char* name, int device_id, const cudaDeviceProp& device_prop,
+                     const std::string& cache_dir, Function& function);
+
+ private:
+  FusedElementwiseCompiler() = default;
+
+  static Status Compile(const std::string& source, const cudaDeviceProp& device_prop, std::string& cubin);
+
+  OrtMutex mutex_;
+  // The functions by key and device. The modules are never unloaded, they live as long as the primary contexts.
+  std::unordered_map<std::string, Function> functions_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -38,7 +38,8 @@ BeamSearch::BeamSearch(const OpKernelInfo& info)
   SetComputeStream(static_cast<void*>(info.GetExecutionProvider()->GetComputeStream()));
 
   SetDeviceHelpers(BeamSearchCudaDeviceHelper::AddToFeeds,
-                   BeamSearchCudaDeviceHelper::TopK);
+                   BeamSearchCudaDeviceHelper::TopK,
+                   BeamSearchCudaDeviceHelper::CreateBeamScorer);
 
   SetDeviceHelpers(BeamSearchCudaDeviceHelper::ProcessLogits<float>,
                    BeamSearchCudaDeviceHelper::InitBeamState<float>,
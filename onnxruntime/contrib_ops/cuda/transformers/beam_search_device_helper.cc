@@ -5,6 +5,7 @@
 #include "core/framework/ort_value.h"
 #include "contrib_ops/cuda/bert/transformer_cuda_common.h"
 #include "beam_search_impl.h"
+#include "beam_search_scorer.h"
 #include <cuda_runtime.h>
 #include "dump_cuda_tensor.h"
 
@@ -24,6 +25,10 @@ namespace onnxruntime {
 namespace contrib {
 namespace BeamSearchCudaDeviceHelper {
 
+// The two-stage top-k of ProcessLogits selects the candidates of a batch with one block, among the 2 * num_beams
+// candidates of each of its beams, so it is used up to this number of beams. TopK is used for more beams.
+constexpr int kMaxNumBeamsOfBeamTopK = 32;
+
 Status TopK(const Tensor* input, const int axis, const unsigned k, bool largest, bool sorted,
             AllocatorPtr allocator,
             void* stream,
@@ -140,6 +145,13 @@ Status AddToFeeds(const IExecutionProvider* execution_provider,
   return Status::OK();
 }
 
+std::unique_ptr<transformers::IBeamScorer> CreateBeamScorer(const transformers::IBeamSearchParameters* parameters,
+                                                             AllocatorPtr& cpu_allocator,
+                                                             void* stream) {
+  return std::make_unique<cuda::transformers::CudaBeamSearchScorer>(*parameters, cpu_allocator,
+                                                                    reinterpret_cast<cudaStream_t>(stream));
+}
+
 template <typename T>
 void InitBeamState(transformers::IBeamSearchState<T>* beam_state,
                    transformers::IBeamSearchCpuState* cpu_state,
@@ -192,6 +204,7 @@ Status ProcessLogits(const OrtValue& logits,                                 //
                      const transformers::IConsoleDumper* dumper) {           // tensor dumper
 
   ORT_UNUSED_PARAMETER(logits_processors);
+  ORT_UNUSED_PARAMETER(cpu_state);
 
 #ifndef DEBUG_BEAM_SEARCH
   ORT_UNUSED_PARAMETER(dumper);
@@ -249,17 +262,12 @@ Status ProcessLogits(const OrtValue& logits,                                 //
   dumper->Print("next_token_scores after softmax", next_token_scores.data(), batch_size, num_beams, vocab_size);
 #endif
 
-  // Sequences generated by beam scorer is currently stored in CPU.
-  // Copy sequences to device only when repetition penalty or no repeat ngram is used in kernel
-  BufferUniquePtr sequences_buffer;
-  int current_sequence_length = sequences->GetSequenceLength();
-  if (parameters->repetition_penalty != 1.0f || (parameters->no_repeat_ngram_size > 0 && current_sequence_length >= parameters->no_repeat_ngram_size)) {
-    size_t bytes = SafeInt<size_t>(sizeof(int32_t)) * batch_beam_size * parameters->max_length;
-    void* data = allocator->Alloc(bytes);
-    BufferUniquePtr temp_buffer(data, BufferDeleter(allocator));
-    sequences_buffer = std::move(temp_buffer);
-    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(sequences_buffer.get(), sequences->GetSequence(0).data(), bytes, cudaMemcpyHostToDevice, cuda_stream));
+  // The sequences are kept on device by the beam scorer, which is created by CreateBeamScorer.
+  auto* cuda_beam_scorer = static_cast<cuda::transformers::CudaBeamSearchScorer*>(beam_scorer);
+  if (step == 1) {
+    cuda_beam_scorer->InitSequences(*sequences);
   }
+  int current_sequence_length = cuda_beam_scorer->GetSequenceLength();
 
   cuda::LaunchLogitsProcessKernel<float>(
       next_token_scores.data(),
@@ -269,7 +277,7 @@ Status ProcessLogits(const OrtValue& logits,                                 //
       parameters->num_beams,
       parameters->vocab_size,
       (parameters->min_length > 0 && current_sequence_length < parameters->min_length) ? parameters->eos_token_id : -1,
-      reinterpret_cast<int32_t*>(sequences_buffer.get()),
+      cuda_beam_scorer->GetSequences(),
       parameters->max_length,
       current_sequence_length,
       parameters->repetition_penalty,
@@ -297,51 +305,70 @@ Status ProcessLogits(const OrtValue& logits,                                 //
   // Apply top-k selection like the following:
   //   next_token_scores = next_token_scores.view(batch_size, num_beams * vocab_size)
   //   next_token_scores, next_tokens = torch.topk(next_token_scores, 2 * num_beams, dim=1, largest=True, sorted=True)
-  int64_t next_token_scores_dims[] = {batch_size, num_beams * vocab_size};
-  TensorShape next_token_scores_shape(&next_token_scores_dims[0], 2);
-  auto element_type = DataTypeImpl::GetType<float>();
-  OrtValue next_token_scores_value;
-  Tensor::InitOrtValue(element_type, next_token_scores_shape, next_token_scores.data(), allocator->Info(), next_token_scores_value);
-  const Tensor& input = next_token_scores_value.Get<Tensor>();
-
-  constexpr int axis = 1;
   const unsigned top_k = static_cast<unsigned>(2 * num_beams);
-  constexpr bool largest = true;
-  constexpr bool sorted = true;  // results returned in sorted order.
-
+  gsl::span<const float> next_scores;
+  IAllocatorUniquePtr<float> beam_topk_scores;
+  IAllocatorUniquePtr<int32_t> beam_topk_tokens;
+  IAllocatorUniquePtr<float> next_scores_buffer;
   std::unique_ptr<Tensor> topk_scores;
-  std::unique_ptr<Tensor> topk_indices;
-  ORT_RETURN_IF_ERROR(TopK(&input, axis, top_k, largest, sorted, allocator, stream, thread_pool, topk_scores, topk_indices));
+  if (num_beams <= kMaxNumBeamsOfBeamTopK && top_k <= static_cast<unsigned>(vocab_size)) {
+    // The top-k candidates of a batch are among the top-k candidates of its beams, which are selected first.
+    const size_t candidates = SafeInt<size_t>(batch_beam_size) * top_k;
+    const size_t next_scores_size = SafeInt<size_t>(batch_size) * top_k;
+    beam_topk_scores = IAllocator::MakeUniquePtr<float>(allocator, candidates);
+    beam_topk_tokens = IAllocator::MakeUniquePtr<int32_t>(allocator, candidates);
+    next_scores_buffer = IAllocator::MakeUniquePtr<float>(allocator, next_scores_size);
+    cuda::LaunchBeamTopKKernel(next_token_scores.data(),
+                               beam_topk_scores.get(),
+                               beam_topk_tokens.get(),
+                               next_scores_buffer.get(),
+                               beam_state->next_tokens.data(),
+                               beam_state->next_indices.data(),
+                               batch_size,
+                               num_beams,
+                               vocab_size,
+                               static_cast<int>(top_k),
+                               cuda_stream);
+    next_scores = gsl::make_span<const float>(next_scores_buffer.get(), next_scores_size);
+  } else {
+    int64_t next_token_scores_dims[] = {batch_size, num_beams * vocab_size};
+    TensorShape next_token_scores_shape(&next_token_scores_dims[0], 2);
+    auto element_type = DataTypeImpl::GetType<float>();
+    OrtValue next_token_scores_value;
+    Tensor::InitOrtValue(element_type, next_token_scores_shape, next_token_scores.data(), allocator->Info(), next_token_scores_value);
+    const Tensor& input = next_token_scores_value.Get<Tensor>();
+
+    constexpr int axis = 1;
+    constexpr bool largest = true;
+    constexpr bool sorted = true;  // results returned in sorted order.
+
+    std::unique_ptr<Tensor> topk_indices;
+    ORT_RETURN_IF_ERROR(TopK(&input, axis, top_k, largest, sorted, allocator, stream, thread_pool, topk_scores, topk_indices));
 
 #ifdef DEBUG_BEAM_SEARCH
-  dumper->Print("topk_scores", *(topk_scores.get()));
-  dumper->Print("topk_indices", *(topk_indices.get()));
+    dumper->Print("topk_scores", *(topk_scores.get()));
+    dumper->Print("topk_indices", *(topk_indices.get()));
 #endif
 
-  // Convert indices in range [0, num_beams * vocab_size) to token ID of range [0, vocab_size) like the following:
-  //   next_indices = (next_tokens / vocab_size).long()
-  //   next_tokens = next_tokens % vocab_size
-  const int64_t* next_token_indices = topk_indices->Data<int64_t>();
-  cuda::LaunchNextTokenKernel(next_token_indices, beam_state->next_indices.data(), beam_state->next_tokens.data(), batch_size, top_k, vocab_size, cuda_stream);
+    // Convert indices in range [0, num_beams * vocab_size) to token ID of range [0, vocab_size) like the following:
+    //   next_indices = (next_tokens / vocab_size).long()
+    //   next_tokens = next_tokens % vocab_size
+    const int64_t* next_token_indices = topk_indices->Data<int64_t>();
+    cuda::LaunchNextTokenKernel(next_token_indices, beam_state->next_indices.data(), beam_state->next_tokens.data(), batch_size, top_k, vocab_size, cuda_stream);
 
-  const float* data = topk_scores->Data<float>();
+    next_scores = gsl::make_span(topk_scores->Data<float>(), static_cast<typename gsl::span<float>::index_type>(topk_scores->Shape().Size()));
+  }
 
 #ifdef DEBUG_BEAM_SEARCH
-  dumper->Print("next_scores before scorer", data, batch_size, top_k);
+  dumper->Print("next_scores before scorer", next_scores.data(), batch_size, top_k);
   dumper->Print("next_tokens before scorer", beam_state->next_tokens.data(), batch_size, top_k);
   dumper->Print("next_indices before scorer", beam_state->next_indices.data(), batch_size, top_k);
 #endif
 
-  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(cpu_state->topk_scores.data(), data, topk_scores->Shape().Size() * sizeof(float), cudaMemcpyDeviceToHost, cuda_stream));
-  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(cpu_state->topk_tokens.data(), beam_state->next_tokens.data(), beam_state->next_tokens.size_bytes(), cudaMemcpyDeviceToHost, cuda_stream));
-  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(cpu_state->topk_indices.data(), beam_state->next_indices.data(), beam_state->next_indices.size_bytes(), cudaMemcpyDeviceToHost, cuda_stream));
-  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(cuda_stream));
+  gsl::span<const int32_t> next_tokens(beam_state->next_tokens.data(), beam_state->next_tokens.size());
+  gsl::span<const int32_t> next_indices(beam_state->next_indices.data(), beam_state->next_indices.size());
 
-  gsl::span<const float> next_scores = gsl::make_span(cpu_state->topk_scores.data(), static_cast<typename gsl::span<float>::index_type>(topk_scores->Shape().Size()));
-  gsl::span<const int32_t> next_tokens(cpu_state->topk_tokens.data(), beam_state->next_tokens.size());
-  gsl::span<const int32_t> next_indices(cpu_state->topk_indices.data(), beam_state->next_indices.size());
-
-  // Limitation: beam scorer runs in CPU. It might be better to use CUDA kernel to replace it.
+  // The beam scorer runs on device, and only copies the next tokens and beam indices to CPU.
   beam_scorer->Process(
       sequences,
       next_scores,
@@ -369,33 +396,47 @@ Status PickPastState(const std::vector<OrtValue>& last_outputs,
                      gsl::span<const int32_t>& beam_indices,
                      AllocatorPtr allocator,
                      void* stream) {
+  // Reorder beams of the present state in place, and feed it as the past state of next step.
+  std::vector<transformers::BeamCopyStep> steps;
+  transformers::GetBeamReorderSteps(beam_indices, steps);
+
+  IAllocatorUniquePtr<T> temp_buffer;
+  T* temp_beam = nullptr;
+
   for (size_t i = 1; i < last_outputs.size(); ++i) {
-    const OrtValue& present = last_outputs[i];  // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
+    OrtValue present = last_outputs[i];  // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
     const TensorShape& past_shape = present.Get<Tensor>().Shape();
 
-    // Create a tensor with same shape.
-    // TODO: allocate one buffer for all layers, and use a CUDA kernel to copy key/value cache data.
-    OrtValue past;
-    auto past_type = DataTypeImpl::GetType<T>();
-    Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-
     auto block_size_per_beam = past_shape[2] * past_shape[3] * past_shape[4];
     auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
 
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), past_shape.Size());
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), past_shape.Size());
-    for (gsl::index j = 0; j < beam_indices.length(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * block_size_per_beam, block_size_per_beam);
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * block_size_per_beam, block_size_per_beam);
-
-      gsl::span<T> past_key = past_span.subspan(j * block_size_per_beam, block_size_per_beam);
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * block_size_per_beam, block_size_per_beam);
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(past_key.data(), present_key.data(), present_key.size_bytes(), cudaMemcpyDeviceToDevice, reinterpret_cast<cudaStream_t>(stream)));
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(past_value.data(), present_value.data(), present_value.size_bytes(), cudaMemcpyDeviceToDevice, reinterpret_cast<cudaStream_t>(stream)));
+    if (temp_beam == nullptr && !steps.empty()) {
+      // The temporary buffer holds key and value of one beam. All layers have the same shape.
+      temp_buffer = IAllocator::MakeUniquePtr<T>(allocator, SafeInt<size_t>(2) * block_size_per_beam);
+      temp_beam = temp_buffer.get();
     }
 
-    next_inputs[i + 2] = past;
+    T* present_data = present.GetMutable<Tensor>()->MutableData<T>();
+    auto beam_key = [&](int beam) {
+      return beam == transformers::BeamCopyStep::kTempBeam ? temp_beam : present_data + beam * block_size_per_beam;
+    };
+    auto beam_value = [&](int beam) {
+      return beam == transformers::BeamCopyStep::kTempBeam ? temp_beam + block_size_per_beam
+                                                           : present_data + past_key_size + beam * block_size_per_beam;
+    };
+
+    const size_t bytes = SafeInt<size_t>(block_size_per_beam) * sizeof(T);
+    for (const auto& step : steps) {
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(beam_key(step.target), beam_key(step.source), bytes, cudaMemcpyDeviceToDevice, reinterpret_cast<cudaStream_t>(stream)));
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(beam_value(step.target), beam_value(step.source), bytes, cudaMemcpyDeviceToDevice, reinterpret_cast<cudaStream_t>(stream)));
+    }
+
+    next_inputs[i + 2] = present;
+  }
+
+  // The temporary buffer is released after the copies are done.
+  if (temp_buffer) {
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(reinterpret_cast<cudaStream_t>(stream)));
   }
 
   return Status::OK();
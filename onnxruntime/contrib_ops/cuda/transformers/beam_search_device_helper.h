@@ -32,6 +32,10 @@ Status AddToFeeds(const IExecutionProvider* execution_provider,
                   std::vector<OrtValue>& feeds,
                   IAllocatorUniquePtr<char>& buffer);
 
+std::unique_ptr<transformers::IBeamScorer> CreateBeamScorer(const transformers::IBeamSearchParameters* parameters,
+                                                             AllocatorPtr& cpu_allocator,
+                                                             void* stream);
+
 template <typename T>
 void InitBeamState(transformers::IBeamSearchState<T>* beam_state,
                    transformers::IBeamSearchCpuState* cpu_state,
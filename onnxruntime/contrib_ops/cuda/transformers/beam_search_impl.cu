@@ -5,6 +5,9 @@
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/cu_inc/common.cuh"
 #include "cub/util_type.cuh"
+#include "cub/cub.cuh"
+#include <climits>
+#include <math_constants.h>
 
 namespace onnxruntime {
 namespace contrib {
@@ -253,6 +256,414 @@ void LaunchUpdateKernel(const int32_t* old_mask_data,
   UpdateInputsKernel<int32_t><<<gridSize, blockSize, 0, stream>>>(old_mask_data, mask_data, next_positions, batch_beam_size, current_length);
 }
 
+constexpr int kBeamTopKBlockSize = 256;
+
+// Selects the top_k of count candidates with a block, in descending order of value and ascending order of key.
+// Each round selects the best of the candidates after the last selected one in this order, so the candidates are
+// not modified. candidate(i) returns the key and value of candidate i, and store(k, item) stores the k-th result.
+template <int kBlockSize, typename Candidate, typename Store>
+__device__ __forceinline__ void BlockTopK(int count, int top_k, Candidate candidate, Store store) {
+  typedef cub::KeyValuePair<int, float> Item;
+  typedef cub::BlockReduce<Item, kBlockSize> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  __shared__ Item selected;
+
+  float last_value = CUDART_INF_F;
+  int last_key = -1;
+  for (int k = 0; k < top_k; k++) {
+    Item best(INT_MAX, -CUDART_INF_F);
+    for (int i = threadIdx.x; i < count; i += kBlockSize) {
+      Item item = candidate(i);
+      if (item.value < last_value || (item.value == last_value && item.key > last_key)) {
+        best = cub::ArgMax()(best, item);
+      }
+    }
+
+    best = BlockReduce(temp_storage).Reduce(best, cub::ArgMax());
+    if (threadIdx.x == 0) {
+      selected = best;
+      store(k, best);
+    }
+    __syncthreads();
+
+    last_value = selected.value;
+    last_key = selected.key;
+    __syncthreads();
+  }
+}
+
+// One block per beam: top_k tokens of the beam.
+__global__ void BeamTopKStage1Kernel(const float* next_token_scores,
+                                     float* beam_topk_scores,
+                                     int32_t* beam_topk_tokens,
+                                     int vocab_size,
+                                     int top_k) {
+  const int batch_beam_index = blockIdx.x;
+  const float* scores = next_token_scores + static_cast<int64_t>(batch_beam_index) * vocab_size;
+  float* topk_scores = beam_topk_scores + batch_beam_index * top_k;
+  int32_t* topk_tokens = beam_topk_tokens + batch_beam_index * top_k;
+
+  BlockTopK<kBeamTopKBlockSize>(
+      vocab_size, top_k,
+      [&](int i) { return cub::KeyValuePair<int, float>(i, scores[i]); },
+      [&](int k, const cub::KeyValuePair<int, float>& item) {
+        topk_scores[k] = item.value;
+        topk_tokens[k] = item.key;
+      });
+}
+
+// One block per batch: top_k candidates among the ones of its beams. The key of a candidate is its index in the
+// flattened (num_beams * vocab_size) scores, so that ties are broken like the top-k selection over all the scores.
+__global__ void BeamTopKStage2Kernel(const float* beam_topk_scores,
+                                     const int32_t* beam_topk_tokens,
+                                     float* next_scores,
+                                     int32_t* next_tokens,
+                                     int32_t* next_indices,
+                                     int num_beams,
+                                     int vocab_size,
+                                     int top_k) {
+  const int batch = blockIdx.x;
+  const int candidates = num_beams * top_k;
+  const float* scores = beam_topk_scores + batch * candidates;
+  const int32_t* tokens = beam_topk_tokens + batch * candidates;
+
+  BlockTopK<kBeamTopKBlockSize>(
+      candidates, top_k,
+      [&](int i) { return cub::KeyValuePair<int, float>((i / top_k) * vocab_size + tokens[i], scores[i]); },
+      [&](int k, const cub::KeyValuePair<int, float>& item) {
+        next_scores[batch * top_k + k] = item.value;
+        next_indices[batch * top_k + k] = item.key / vocab_size;
+        next_tokens[batch * top_k + k] = item.key % vocab_size;
+      });
+}
+
+void LaunchBeamTopKKernel(const float* next_token_scores,
+                          float* beam_topk_scores,
+                          int32_t* beam_topk_tokens,
+                          float* next_scores,
+                          int32_t* next_tokens,
+                          int32_t* next_indices,
+                          int batch_size,
+                          int num_beams,
+                          int vocab_size,
+                          int top_k,
+                          cudaStream_t stream) {
+  assert(top_k <= vocab_size);
+  BeamTopKStage1Kernel<<<batch_size * num_beams, kBeamTopKBlockSize, 0, stream>>>(
+      next_token_scores, beam_topk_scores, beam_topk_tokens, vocab_size, top_k);
+  BeamTopKStage2Kernel<<<batch_size, kBeamTopKBlockSize, 0, stream>>>(
+      beam_topk_scores, beam_topk_tokens, next_scores, next_tokens, next_indices, num_beams, vocab_size, top_k);
+}
+
+// Adds a hypothesis of the given score to the num_beams slots of a batch, like BeamHypotheses::Add: a free slot is
+// used when the hypotheses are not full, otherwise the worst hypothesis is replaced when the new one is better.
+// Returns the slot of the hypothesis, or -1 when it is not added.
+__device__ int AddHypothesis(float score, int num_beams, int& count, float* scores) {
+  if (count < num_beams) {
+    scores[count] = score;
+    return count++;
+  }
+
+  int worst = 0;
+  for (int i = 1; i < num_beams; i++) {
+    if (scores[i] < scores[worst]) {
+      worst = i;
+    }
+  }
+  if (score > scores[worst]) {
+    scores[worst] = score;
+    return worst;
+  }
+  return -1;
+}
+
+// Copies the sequences of the beams added as hypotheses of a batch to their slots. sources[slot] is the index of
+// the beam added to the slot, or -1 when no beam is added to it.
+__device__ void CopyHypotheses(const int* sources,
+                               const int32_t* sequences,
+                               int32_t* hypothesis_tokens,
+                               int num_beams,
+                               int max_length,
+                               int sequence_length) {
+  for (int i = threadIdx.x; i < num_beams * sequence_length; i += blockDim.x) {
+    const int slot = i / sequence_length;
+    const int position = i % sequence_length;
+    if (sources[slot] >= 0) {
+      hypothesis_tokens[slot * max_length + position] = sequences[sources[slot] * max_length + position];
+    }
+  }
+}
+
+__global__ void BeamScorerProcessKernel(const float* next_scores,
+                                        const int32_t* next_tokens,
+                                        const int32_t* next_indices,
+                                        const int32_t* sequences,
+                                        int32_t* hypothesis_tokens,
+                                        int32_t* hypothesis_lengths,
+                                        float* hypothesis_scores,
+                                        int32_t* hypothesis_counts,
+                                        bool* done,
+                                        float* next_beam_scores,
+                                        int32_t* next_beam_tokens,
+                                        int32_t* next_beam_indices,
+                                        int num_beams,
+                                        int max_length,
+                                        int sequence_length,
+                                        float length_penalty,
+                                        bool early_stopping,
+                                        int pad_token_id,
+                                        int eos_token_id) {
+  extern __shared__ int sources[];
+
+  const int batch = blockIdx.x;
+  const int offset = batch * num_beams;
+  const int top_k = 2 * num_beams;
+
+  // The flag is read by all threads before thread 0 updates it below.
+  const bool is_done = done[batch];
+  __syncthreads();
+
+  if (is_done) {
+    // Pad the batch.
+    for (int j = threadIdx.x; j < num_beams; j += blockDim.x) {
+      next_beam_scores[offset + j] = 0.0f;
+      next_beam_tokens[offset + j] = pad_token_id;
+      next_beam_indices[offset + j] = 0;
+    }
+    return;
+  }
+
+  if (threadIdx.x == 0) {
+    for (int j = 0; j < num_beams; j++) {
+      sources[j] = -1;
+    }
+
+    float* scores = hypothesis_scores + offset;
+    int count = hypothesis_counts[batch];
+    int beam_idx = 0;
+    for (int j = 0; j < top_k; j++) {
+      const int32_t next_token = next_tokens[batch * top_k + j];
+      const float next_score = next_scores[batch * top_k + j];
+      const int batch_beam_idx = offset + next_indices[batch * top_k + j];
+
+      // Add to generated hypotheses if end of sentence.
+      if (eos_token_id >= 0 && next_token == eos_token_id) {
+        if (j >= num_beams) {
+          continue;
+        }
+
+        const float score = next_score / powf(static_cast<float>(sequence_length), length_penalty);
+        const int slot = AddHypothesis(score, num_beams, count, scores);
+        if (slot >= 0) {
+          hypothesis_lengths[offset + slot] = sequence_length;
+          sources[slot] = batch_beam_idx;
+        }
+      } else {
+        // Add next predicted token since it is not eos_token.
+        next_beam_scores[offset + beam_idx] = next_score;
+        next_beam_tokens[offset + beam_idx] = next_token;
+        next_beam_indices[offset + beam_idx] = batch_beam_idx;
+        ++beam_idx;
+      }
+
+      // Once the beam for next step is full, don't add more tokens to it.
+      if (beam_idx == num_beams) {
+        break;
+      }
+    }
+    hypothesis_counts[batch] = count;
+
+    // Check if we are done so that we can save a pad step if all(done).
+    // The best score is taken from the same window of next_scores as BeamSearchScorer::Process.
+    if (count >= num_beams) {
+      bool is_batch_done = early_stopping;
+      if (!is_batch_done) {
+        float best_sum_logprobs = next_scores[offset];
+        for (int j = 1; j < top_k; j++) {
+          best_sum_logprobs = fmaxf(best_sum_logprobs, next_scores[offset + j]);
+        }
+
+        float worst_score = scores[0];
+        for (int j = 1; j < num_beams; j++) {
+          worst_score = fminf(worst_score, scores[j]);
+        }
+
+        const float current_score = best_sum_logprobs / powf(static_cast<float>(sequence_length), length_penalty);
+        is_batch_done = worst_score >= current_score;
+      }
+      done[batch] = is_batch_done;
+    }
+  }
+  __syncthreads();
+
+  CopyHypotheses(sources, sequences, hypothesis_tokens + static_cast<int64_t>(offset) * max_length,
+                 num_beams, max_length, sequence_length);
+}
+
+void LaunchBeamScorerProcessKernel(const float* next_scores,
+                                   const int32_t* next_tokens,
+                                   const int32_t* next_indices,
+                                   const int32_t* sequences,
+                                   int32_t* hypothesis_tokens,
+                                   int32_t* hypothesis_lengths,
+                                   float* hypothesis_scores,
+                                   int32_t* hypothesis_counts,
+                                   bool* done,
+                                   float* next_beam_scores,
+                                   int32_t* next_beam_tokens,
+                                   int32_t* next_beam_indices,
+                                   int batch_size,
+                                   int num_beams,
+                                   int max_length,
+                                   int sequence_length,
+                                   float length_penalty,
+                                   bool early_stopping,
+                                   int pad_token_id,
+                                   int eos_token_id,
+                                   cudaStream_t stream) {
+  constexpr int blockSize = 256;
+  BeamScorerProcessKernel<<<batch_size, blockSize, num_beams * sizeof(int), stream>>>(
+      next_scores, next_tokens, next_indices, sequences, hypothesis_tokens, hypothesis_lengths, hypothesis_scores,
+      hypothesis_counts, done, next_beam_scores, next_beam_tokens, next_beam_indices, num_beams, max_length,
+      sequence_length, length_penalty, early_stopping, pad_token_id, eos_token_id);
+}
+
+__global__ void UpdateSequencesKernel(const int32_t* sequences,
+                                      int32_t* next_sequences,
+                                      const int32_t* beam_indices,
+                                      const int32_t* beam_next_tokens,
+                                      int max_length,
+                                      int sequence_length,
+                                      int total_elements) {
+  int index = blockIdx.x * blockDim.x + threadIdx.x;
+  if (index < total_elements) {
+    int i = index / (sequence_length + 1);
+    int j = index % (sequence_length + 1);
+    next_sequences[i * max_length + j] = (j < sequence_length) ? sequences[beam_indices[i] * max_length + j]
+                                                               : beam_next_tokens[i];
+  }
+}
+
+void LaunchUpdateSequencesKernel(const int32_t* sequences,
+                                 int32_t* next_sequences,
+                                 const int32_t* beam_indices,
+                                 const int32_t* beam_next_tokens,
+                                 int batch_beam_size,
+                                 int max_length,
+                                 int sequence_length,
+                                 cudaStream_t stream) {
+  assert(sequence_length < max_length);
+  int total_elements = batch_beam_size * (sequence_length + 1);
+  constexpr int blockSize = 256;
+  const int gridSize = (total_elements + blockSize - 1) / blockSize;
+  UpdateSequencesKernel<<<gridSize, blockSize, 0, stream>>>(sequences, next_sequences, beam_indices, beam_next_tokens,
+                                                            max_length, sequence_length, total_elements);
+}
+
+__global__ void BeamScorerFinalizeKernel(const float* final_beam_scores,
+                                         const int32_t* sequences,
+                                         int32_t* hypothesis_tokens,
+                                         int32_t* hypothesis_lengths,
+                                         float* hypothesis_scores,
+                                         int32_t* hypothesis_counts,
+                                         const bool* done,
+                                         int32_t* output_sequences,
+                                         float* output_sequence_scores,
+                                         int num_beams,
+                                         int max_length,
+                                         int sequence_length,
+                                         float length_penalty,
+                                         int num_return_sequences,
+                                         int pad_token_id) {
+  // The sources of the slots, then the slots of the returned hypotheses.
+  extern __shared__ int sources[];
+  int* selected = sources + num_beams;
+
+  const int batch = blockIdx.x;
+  const int offset = batch * num_beams;
+  float* scores = hypothesis_scores + offset;
+  int32_t* batch_hypothesis_tokens = hypothesis_tokens + static_cast<int64_t>(offset) * max_length;
+
+  // Finalize all open beam hypotheses and add to generated hypotheses.
+  if (threadIdx.x == 0) {
+    for (int j = 0; j < num_beams; j++) {
+      sources[j] = -1;
+    }
+
+    if (!done[batch]) {
+      int count = hypothesis_counts[batch];
+      for (int j = 0; j < num_beams; j++) {
+        const float score = final_beam_scores[offset + j] / powf(static_cast<float>(sequence_length), length_penalty);
+        const int slot = AddHypothesis(score, num_beams, count, scores);
+        if (slot >= 0) {
+          hypothesis_lengths[offset + slot] = sequence_length;
+          sources[slot] = offset + j;
+        }
+      }
+      hypothesis_counts[batch] = count;
+    }
+  }
+  __syncthreads();
+
+  CopyHypotheses(sources, sequences, batch_hypothesis_tokens, num_beams, max_length, sequence_length);
+
+  // Select the best hypotheses according to number of sequences to return.
+  if (threadIdx.x == 0) {
+    const int count = hypothesis_counts[batch];
+    for (int r = 0; r < num_return_sequences; r++) {
+      int best = -1;
+      for (int j = 0; j < count; j++) {
+        bool is_selected = false;
+        for (int i = 0; i < r; i++) {
+          is_selected = is_selected || selected[i] == j;
+        }
+        if (!is_selected && (best < 0 || scores[j] > scores[best])) {
+          best = j;
+        }
+      }
+      selected[r] = best;
+      if (output_sequence_scores != nullptr) {
+        output_sequence_scores[batch * num_return_sequences + r] = scores[best];
+      }
+    }
+  }
+  __syncthreads();
+
+  // Word IDs of each sequence, padded with pad token ID.
+  int32_t* batch_output = output_sequences + static_cast<int64_t>(batch) * num_return_sequences * max_length;
+  for (int i = threadIdx.x; i < num_return_sequences * max_length; i += blockDim.x) {
+    const int slot = selected[i / max_length];
+    const int position = i % max_length;
+    batch_output[i] = position < hypothesis_lengths[offset + slot] ? batch_hypothesis_tokens[slot * max_length + position]
+                                                                   : pad_token_id;
+  }
+}
+
+void LaunchBeamScorerFinalizeKernel(const float* final_beam_scores,
+                                    const int32_t* sequences,
+                                    int32_t* hypothesis_tokens,
+                                    int32_t* hypothesis_lengths,
+                                    float* hypothesis_scores,
+                                    int32_t* hypothesis_counts,
+                                    const bool* done,
+                                    int32_t* output_sequences,
+                                    float* output_sequence_scores,
+                                    int batch_size,
+                                    int num_beams,
+                                    int max_length,
+                                    int sequence_length,
+                                    float length_penalty,
+                                    int num_return_sequences,
+                                    int pad_token_id,
+                                    cudaStream_t stream) {
+  constexpr int blockSize = 256;
+  const size_t shared_bytes = (num_beams + num_return_sequences) * sizeof(int);
+  BeamScorerFinalizeKernel<<<batch_size, blockSize, shared_bytes, stream>>>(
+      final_beam_scores, sequences, hypothesis_tokens, hypothesis_lengths, hypothesis_scores, hypothesis_counts, done,
+      output_sequences, output_sequence_scores, num_beams, max_length, sequence_length, length_penalty,
+      num_return_sequences, pad_token_id);
+}
+
 }  // namespace cuda
 }  // namespace contrib
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -53,6 +53,79 @@ void LaunchUpdateKernel(const int32_t* old_mask_data,
                         int current_length,
                         cudaStream_t stream);
 
+// Top-k selection over the scores of shape (batch_size, num_beams * vocab_size) in two stages: the top_k candidates
+// of each beam are selected first, then the top_k candidates of each batch are selected among the ones of its beams.
+// The results are sorted in descending order of score, and ties are broken by the index in the flattened scores.
+// beam_topk_scores and beam_topk_tokens are buffers of shape (batch_size * num_beams, top_k), and top_k shall be no
+// more than vocab_size. next_indices are the indices of beams in the batch like LaunchNextTokenKernel.
+void LaunchBeamTopKKernel(const float* next_token_scores,
+                          float* beam_topk_scores,
+                          int32_t* beam_topk_tokens,
+                          float* next_scores,
+                          int32_t* next_tokens,
+                          int32_t* next_indices,
+                          int batch_size,
+                          int num_beams,
+                          int vocab_size,
+                          int top_k,
+                          cudaStream_t stream);
+
+// Beam scorer step of one batch per block, like BeamSearchScorer::Process. The hypotheses of a batch are kept in
+// num_beams slots: hypothesis_tokens has shape (batch_size, num_beams, max_length), hypothesis_lengths and
+// hypothesis_scores have shape (batch_size, num_beams), and hypothesis_counts has shape (batch_size).
+// sequences has shape (batch_size * num_beams, max_length), with sequence_length tokens in each beam.
+void LaunchBeamScorerProcessKernel(const float* next_scores,
+                                   const int32_t* next_tokens,
+                                   const int32_t* next_indices,
+                                   const int32_t* sequences,
+                                   int32_t* hypothesis_tokens,
+                                   int32_t* hypothesis_lengths,
+                                   float* hypothesis_scores,
+                                   int32_t* hypothesis_counts,
+                                   bool* done,
+                                   float* next_beam_scores,
+                                   int32_t* next_beam_tokens,
+                                   int32_t* next_beam_indices,
+                                   int batch_size,
+                                   int num_beams,
+                                   int max_length,
+                                   int sequence_length,
+                                   float length_penalty,
+                                   bool early_stopping,
+                                   int pad_token_id,
+                                   int eos_token_id,
+                                   cudaStream_t stream);
+
+// Select sequences based on beam indices, then append next token to selected sequences.
+void LaunchUpdateSequencesKernel(const int32_t* sequences,
+                                 int32_t* next_sequences,
+                                 const int32_t* beam_indices,
+                                 const int32_t* beam_next_tokens,
+                                 int batch_beam_size,
+                                 int max_length,
+                                 int sequence_length,
+                                 cudaStream_t stream);
+
+// Adds the open beams of the batches not done to their hypotheses, then outputs the best num_return_sequences
+// hypotheses of each batch like BeamSearchScorer::Finalize. output_sequence_scores can be nullptr.
+void LaunchBeamScorerFinalizeKernel(const float* final_beam_scores,
+                                    const int32_t* sequences,
+                                    int32_t* hypothesis_tokens,
+                                    int32_t* hypothesis_lengths,
+                                    float* hypothesis_scores,
+                                    int32_t* hypothesis_counts,
+                                    const bool* done,
+                                    int32_t* output_sequences,
+                                    float* output_sequence_scores,
+                                    int batch_size,
+                                    int num_beams,
+                                    int max_length,
+                                    int sequence_length,
+                                    float length_penalty,
+                                    int num_return_sequences,
+                                    int pad_token_id,
+                                    cudaStream_t stream);
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
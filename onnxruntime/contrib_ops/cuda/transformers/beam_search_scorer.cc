@@ -0,0 +1,174 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/shared_library/provider_api.h"
+#include "beam_search_scorer.h"
+#include "beam_search_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+namespace transformers {
+
+CudaBeamSearchScorer::CudaBeamSearchScorer(const onnxruntime::contrib::transformers::IBeamSearchParameters& parameters,
+                                           AllocatorPtr& cpu_allocator,
+                                           cudaStream_t stream)
+    : batch_size_(parameters.batch_size),
+      num_beams_(parameters.num_beams),
+      max_length_(parameters.max_length),
+      num_return_sequences_(parameters.num_return_sequences),
+      length_penalty_(parameters.length_penalty),
+      early_stopping_(parameters.early_stopping),
+      pad_token_id_(parameters.pad_token_id),
+      eos_token_id_(parameters.eos_token_id),
+      cpu_allocator_(cpu_allocator),
+      stream_(stream),
+      current_sequences_(0),
+      sequence_length_(0) {
+}
+
+void CudaBeamSearchScorer::Initialize(AllocatorPtr& allocator, int sequence_length) {
+  ORT_ENFORCE(next_beam_scores_.empty());  // Make sure this is called only once.
+
+  allocator_ = allocator;
+  sequence_length_ = sequence_length;
+
+  const size_t batch_beam_size = SafeInt<size_t>(batch_size_) * num_beams_;
+  const size_t sequences_size = SafeInt<size_t>(batch_beam_size) * max_length_;
+  sequences_[0] = IAllocator::MakeUniquePtr<int32_t>(allocator, sequences_size);
+  sequences_[1] = IAllocator::MakeUniquePtr<int32_t>(allocator, sequences_size);
+
+  hypothesis_tokens_ = IAllocator::MakeUniquePtr<int32_t>(allocator, sequences_size);
+  hypothesis_lengths_ = IAllocator::MakeUniquePtr<int32_t>(allocator, batch_beam_size);
+  hypothesis_scores_ = IAllocator::MakeUniquePtr<float>(allocator, batch_beam_size);
+  hypothesis_counts_ = IAllocator::MakeUniquePtr<int32_t>(allocator, batch_size_);
+  done_ = IAllocator::MakeUniquePtr<bool>(allocator, batch_size_);
+  CUDA_CALL_THROW(cudaMemsetAsync(hypothesis_counts_.get(), 0, sizeof(int32_t) * batch_size_, stream_));
+  CUDA_CALL_THROW(cudaMemsetAsync(done_.get(), 0, sizeof(bool) * batch_size_, stream_));
+
+  next_beam_scores_ptr_ = IAllocator::MakeUniquePtr<float>(allocator, batch_beam_size);
+  next_beam_scores_ = gsl::make_span(next_beam_scores_ptr_.get(), batch_beam_size);
+  next_beam_tokens_ = IAllocator::MakeUniquePtr<int32_t>(allocator, batch_beam_size);
+  next_beam_indices_ = IAllocator::MakeUniquePtr<int32_t>(allocator, batch_beam_size);
+
+  next_beam_tokens_cpu_ptr_ = IAllocator::MakeUniquePtr<int32_t>(cpu_allocator_, batch_beam_size);
+  next_beam_tokens_cpu_ = gsl::make_span(next_beam_tokens_cpu_ptr_.get(), batch_beam_size);
+  next_beam_indices_cpu_ptr_ = IAllocator::MakeUniquePtr<int32_t>(cpu_allocator_, batch_beam_size);
+  next_beam_indices_cpu_ = gsl::make_span(next_beam_indices_cpu_ptr_.get(), batch_beam_size);
+  done_cpu_ptr_ = IAllocator::MakeUniquePtr<bool>(cpu_allocator_, batch_size_);
+  done_cpu_ = gsl::make_span(done_cpu_ptr_.get(), static_cast<size_t>(batch_size_));
+  std::fill_n(done_cpu_.data(), done_cpu_.size(), false);
+}
+
+void CudaBeamSearchScorer::InitSequences(const onnxruntime::contrib::transformers::ISequences& sequences) {
+  // The CPU sequences are not updated after the initial ones, so the copy need not be synchronized here.
+  const size_t bytes = SafeInt<size_t>(sizeof(int32_t)) * batch_size_ * num_beams_ * max_length_;
+  CUDA_CALL_THROW(cudaMemcpyAsync(GetSequences(), sequences.GetSequence(0).data(), bytes, cudaMemcpyHostToDevice,
+                                  stream_));
+}
+
+bool CudaBeamSearchScorer::IsDone() {
+  for (bool done : done_cpu_) {
+    if (!done)
+      return false;
+  }
+  return true;
+}
+
+void CudaBeamSearchScorer::Process(onnxruntime::contrib::transformers::ISequences* /*sequences*/,
+                                   gsl::span<const float>& next_scores,
+                                   gsl::span<const int32_t>& next_tokens,
+                                   gsl::span<const int32_t>& next_indices) {
+  ORT_ENFORCE(next_scores.size() == next_tokens.size());
+  ORT_ENFORCE(next_scores.size() == next_indices.size());
+  ORT_ENFORCE(sequence_length_ < max_length_);
+
+  cuda::LaunchBeamScorerProcessKernel(next_scores.data(),
+                                      next_tokens.data(),
+                                      next_indices.data(),
+                                      GetSequences(),
+                                      hypothesis_tokens_.get(),
+                                      hypothesis_lengths_.get(),
+                                      hypothesis_scores_.get(),
+                                      hypothesis_counts_.get(),
+                                      done_.get(),
+                                      next_beam_scores_.data(),
+                                      next_beam_tokens_.get(),
+                                      next_beam_indices_.get(),
+                                      batch_size_,
+                                      num_beams_,
+                                      max_length_,
+                                      sequence_length_,
+                                      length_penalty_,
+                                      early_stopping_,
+                                      pad_token_id_,
+                                      eos_token_id_,
+                                      stream_);
+
+  const int batch_beam_size = batch_size_ * num_beams_;
+  cuda::LaunchUpdateSequencesKernel(GetSequences(),
+                                    sequences_[1 - current_sequences_].get(),
+                                    next_beam_indices_.get(),
+                                    next_beam_tokens_.get(),
+                                    batch_beam_size,
+                                    max_length_,
+                                    sequence_length_,
+                                    stream_);
+  current_sequences_ = 1 - current_sequences_;
+  ++sequence_length_;
+
+  CUDA_CALL_THROW(cudaMemcpyAsync(next_beam_tokens_cpu_.data(), next_beam_tokens_.get(),
+                                  next_beam_tokens_cpu_.size_bytes(), cudaMemcpyDeviceToHost, stream_));
+  CUDA_CALL_THROW(cudaMemcpyAsync(next_beam_indices_cpu_.data(), next_beam_indices_.get(),
+                                  next_beam_indices_cpu_.size_bytes(), cudaMemcpyDeviceToHost, stream_));
+  CUDA_CALL_THROW(cudaMemcpyAsync(done_cpu_.data(), done_.get(), done_cpu_.size_bytes(), cudaMemcpyDeviceToHost,
+                                  stream_));
+  CUDA_CALL_THROW(cudaStreamSynchronize(stream_));
+}
+
+void CudaBeamSearchScorer::Finalize(onnxruntime::contrib::transformers::ISequences* /*sequences*/,
+                                    gsl::span<const float>& final_beam_scores,
+                                    Tensor* output_sequences,
+                                    Tensor* output_sequence_scores) {
+  ORT_ENFORCE(output_sequences != nullptr);
+
+  // The outputs are in CPU, so they are computed in device buffers then copied.
+  const size_t output_scores_size = SafeInt<size_t>(batch_size_) * num_return_sequences_;
+  const size_t output_size = SafeInt<size_t>(output_scores_size) * max_length_;
+  auto output_buffer = IAllocator::MakeUniquePtr<int32_t>(allocator_, output_size);
+  IAllocatorUniquePtr<float> output_scores_buffer;
+  if (output_sequence_scores != nullptr) {
+    output_scores_buffer = IAllocator::MakeUniquePtr<float>(allocator_, output_scores_size);
+  }
+
+  cuda::LaunchBeamScorerFinalizeKernel(final_beam_scores.data(),
+                                       GetSequences(),
+                                       hypothesis_tokens_.get(),
+                                       hypothesis_lengths_.get(),
+                                       hypothesis_scores_.get(),
+                                       hypothesis_counts_.get(),
+                                       done_.get(),
+                                       output_buffer.get(),
+                                       output_scores_buffer.get(),
+                                       batch_size_,
+                                       num_beams_,
+                                       max_length_,
+                                       sequence_length_,
+                                       length_penalty_,
+                                       num_return_sequences_,
+                                       pad_token_id_,
+                                       stream_);
+
+  CUDA_CALL_THROW(cudaMemcpyAsync(output_sequences->MutableData<int32_t>(), output_buffer.get(),
+                                  output_size * sizeof(int32_t), cudaMemcpyDeviceToHost, stream_));
+  if (output_sequence_scores != nullptr) {
+    CUDA_CALL_THROW(cudaMemcpyAsync(output_sequence_scores->MutableData<float>(), output_scores_buffer.get(),
+                                    output_scores_size * sizeof(float), cudaMemcpyDeviceToHost, stream_));
+  }
+  CUDA_CALL_THROW(cudaStreamSynchronize(stream_));
+}
+
+}  // namespace transformers
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
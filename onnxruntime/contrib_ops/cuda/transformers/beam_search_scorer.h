@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_common.h"
+#include "contrib_ops/cpu/transformers/beam_search_shared.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+namespace transformers {
+
+// Beam scorer running on device, like BeamSearchScorer. The sequences and the hypotheses are kept on device, and
+// only the next tokens, the beam indices and the done flags are copied to CPU after each step, since they are used
+// to update the subgraph feeds and to stop the search. The sequences are copied to CPU in Finalize.
+// The spans of Process and Finalize, and the next scores are in device memory.
+class CudaBeamSearchScorer : public onnxruntime::contrib::transformers::IBeamScorer {
+ public:
+  CudaBeamSearchScorer(const onnxruntime::contrib::transformers::IBeamSearchParameters& parameters,
+                       AllocatorPtr& cpu_allocator,
+                       cudaStream_t stream);
+
+  void Initialize(AllocatorPtr& allocator, int sequence_length) override;
+
+  void Process(onnxruntime::contrib::transformers::ISequences* sequences,
+               gsl::span<const float>& next_scores,
+               gsl::span<const int32_t>& next_tokens,
+               gsl::span<const int32_t>& next_indices) override;
+
+  void Finalize(onnxruntime::contrib::transformers::ISequences* sequences,
+                gsl::span<const float>& final_beam_scores,
+                Tensor* output_sequences,
+                Tensor* output_sequence_scores) override;
+
+  bool IsDone() override;
+
+  gsl::span<float>& GetNextScores() override { return next_beam_scores_; }
+  gsl::span<int32_t>& GetNextTokens() override { return next_beam_tokens_cpu_; }
+  gsl::span<int32_t>& GetNextIndices() override { return next_beam_indices_cpu_; }
+
+  // Copies the initial sequences in CPU to device. It shall be called before the first step.
+  void InitSequences(const onnxruntime::contrib::transformers::ISequences& sequences);
+
+  // Sequences on device with shape (batch_size * num_beams, max_length), and their current length.
+  int32_t* GetSequences() { return sequences_[current_sequences_].get(); }
+  int GetSequenceLength() const { return sequence_length_; }
+
+ private:
+  int batch_size_;
+  int num_beams_;
+  int max_length_;
+  int num_return_sequences_;
+  float length_penalty_;
+  bool early_stopping_;
+  int pad_token_id_;
+  int eos_token_id_;
+
+  AllocatorPtr allocator_;
+  AllocatorPtr cpu_allocator_;
+  cudaStream_t stream_;
+
+  // Two buffers of sequences used in turn: the next tokens are appended to the selected beams of one buffer
+  // into the other one.
+  IAllocatorUniquePtr<int32_t> sequences_[2];
+  int current_sequences_;
+  int sequence_length_;
+
+  // num_beams hypotheses of each batch. See LaunchBeamScorerProcessKernel.
+  IAllocatorUniquePtr<int32_t> hypothesis_tokens_;
+  IAllocatorUniquePtr<int32_t> hypothesis_lengths_;
+  IAllocatorUniquePtr<float> hypothesis_scores_;
+  IAllocatorUniquePtr<int32_t> hypothesis_counts_;
+  IAllocatorUniquePtr<bool> done_;
+
+  IAllocatorUniquePtr<float> next_beam_scores_ptr_;
+  gsl::span<float> next_beam_scores_;
+  IAllocatorUniquePtr<int32_t> next_beam_tokens_;
+  IAllocatorUniquePtr<int32_t> next_beam_indices_;
+
+  // Copies in CPU.
+  IAllocatorUniquePtr<int32_t> next_beam_tokens_cpu_ptr_;
+  gsl::span<int32_t> next_beam_tokens_cpu_;
+  IAllocatorUniquePtr<int32_t> next_beam_indices_cpu_ptr_;
+  gsl::span<int32_t> next_beam_indices_cpu_;
+  IAllocatorUniquePtr<bool> done_cpu_ptr_;
+  gsl::span<bool> done_cpu_;
+};
+
+}  // namespace transformers
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
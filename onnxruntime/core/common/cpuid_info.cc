@@ -21,6 +21,12 @@
 #ifndef HWCAP_ASIMDDP
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
+#ifndef HWCAP_ASIMDHP
+#define HWCAP_ASIMDHP (1 << 10)
+#endif
+#ifndef HWCAP2_BF16
+#define HWCAP2_BF16 (1 << 14)
+#endif
 
 #endif // ARM
 
@@ -86,6 +92,7 @@ void CPUIDInfo::X86Init() {
     if (data[2] & (1 << 27)) {
       constexpr int AVX_MASK = 0x6;
       constexpr int AVX512_MASK = 0xE6;
+      constexpr int AMX_MASK = 0x60000;
       int value = XGETBV();
       bool has_sse2 = (data[3] & (1 << 26));
       has_sse3_ = (data[2] & 0x1);
@@ -103,6 +110,8 @@ void CPUIDInfo::X86Init() {
         // avx512_skylake = avx512f | avx512vl | avx512cd | avx512bw | avx512dq
         has_avx512_skylake_ = has_avx512 && (data[1] & ((1 << 16) | (1 << 17) | (1 << 28) | (1 << 30) | (1 << 31)));
         is_hybrid_ = (data[3] & (1 << 15));
+        // amx_int8 = amx_tile | amx_int8, with the tile state enabled by the OS
+        has_amx_int8_ = ((value & AMX_MASK) == AMX_MASK) && ((data[3] & ((1 << 24) | (1 << 25))) == ((1 << 24) | (1 << 25)));
       }
     }
   }
@@ -129,6 +138,7 @@ void CPUIDInfo::ArmLinuxInit() {
   if (pytorch_cpuinfo_init_) {
     is_hybrid_ = cpuinfo_get_uarchs_count() > 1;
     has_arm_neon_dot_ = cpuinfo_has_arm_neon_dot();
+    has_fp16_ = cpuinfo_has_arm_neon_fp16_arith();
     const uint32_t core_cnt = cpuinfo_get_cores_count();
     core_uarchs_.resize(core_cnt, cpuinfo_uarch_unknown);
     is_armv8_narrow_ld_.resize(core_cnt, false);
@@ -151,7 +161,11 @@ void CPUIDInfo::ArmLinuxInit() {
     }
   } else {
     has_arm_neon_dot_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0);
+    has_fp16_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDHP) != 0);
   }
+
+  // Not every cpuinfo version reports the BF16 extension, the kernel always does.
+  has_arm_bf16_ = ((getauxval(AT_HWCAP2) & HWCAP2_BF16) != 0);
 }
 
 #elif defined(_WIN32)
@@ -209,6 +223,10 @@ void CPUIDInfo::ArmWindowsInit() {
 #endif /* Application Family or OneCore Family */
 
   has_arm_neon_dot_ = (IsProcessorFeaturePresent(PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE) != 0);
+
+  // Windows does not report the FP16 extension. Every ARMv8.2 processor with
+  // the dot product extension that Windows runs on also has it.
+  has_fp16_ = has_arm_neon_dot_;
 }
 
 #endif /* (arm or arm64) and windows */
@@ -26,6 +26,7 @@ class CPUIDInfo {
   bool HasAVX2() const { return has_avx2_; }
   bool HasAVX512f() const { return has_avx512f_; }
   bool HasAVX512Skylake() const { return has_avx512_skylake_; }
+  bool HasAMX_INT8() const { return has_amx_int8_; }
   bool HasF16C() const { return has_f16c_; }
   bool HasSSE3() const { return has_sse3_; }
   bool HasSSE4_1() const { return has_sse4_1_; }
@@ -33,6 +34,8 @@ class CPUIDInfo {
 
   // ARM 
   bool HasArmNeonDot() const { return has_arm_neon_dot_; }
+  bool HasFp16VectorAcceleration() const { return has_fp16_; }
+  bool HasArmBf16() const { return has_arm_bf16_; }
 
   uint32_t GetCurrentCoreIdx() const;
 
@@ -108,6 +111,7 @@ class CPUIDInfo {
   bool has_avx2_{false};
   bool has_avx512f_{false};
   bool has_avx512_skylake_{false};
+  bool has_amx_int8_{false};
   bool has_f16c_{false};
   bool has_sse3_{false};
   bool has_sse4_1_{false};
@@ -121,6 +125,8 @@ class CPUIDInfo {
   std::vector<bool> is_armv8_narrow_ld_;
 
   bool has_arm_neon_dot_{false};
+  bool has_fp16_{false};
+  bool has_arm_bf16_{false};
 
 #ifdef CPUIDINFO_ARCH_X86
 
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+#if defined(__linux__)
+namespace {
+
+int OpenCounter(uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  // user space only, which is allowed by the default perf_event_paranoid
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // the calling thread on any cpu
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+}  // namespace
+
+HardwareCounters::HardwareCounters() {
+  group_fd_ = OpenCounter(PERF_COUNT_HW_CPU_CYCLES, -1);
+  if (group_fd_ < 0) {
+    return;
+  }
+
+  instructions_fd_ = OpenCounter(PERF_COUNT_HW_INSTRUCTIONS, group_fd_);
+  llc_misses_fd_ = OpenCounter(PERF_COUNT_HW_CACHE_MISSES, group_fd_);
+  if (instructions_fd_ < 0 || llc_misses_fd_ < 0) {
+    if (instructions_fd_ >= 0) close(instructions_fd_);
+    if (llc_misses_fd_ >= 0) close(llc_misses_fd_);
+    close(group_fd_);
+    group_fd_ = instructions_fd_ = llc_misses_fd_ = -1;
+  }
+}
+
+HardwareCounters::~HardwareCounters() {
+  if (group_fd_ >= 0) {
+    close(llc_misses_fd_);
+    close(instructions_fd_);
+    close(group_fd_);
+  }
+}
+
+bool HardwareCounters::Read(HardwareCounterValues& values) const noexcept {
+  if (group_fd_ < 0) {
+    return false;
+  }
+
+  // PERF_FORMAT_GROUP: the number of counters followed by their values, in the order they were opened
+  uint64_t buffer[4];
+  if (read(group_fd_, buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer)) || buffer[0] != 3) {
+    return false;
+  }
+
+  values.cycles = buffer[1];
+  values.instructions = buffer[2];
+  values.llc_misses = buffer[3];
+  return true;
+}
+
+#else
+
+HardwareCounters::HardwareCounters() = default;
+
+HardwareCounters::~HardwareCounters() = default;
+
+bool HardwareCounters::Read(HardwareCounterValues& /*values*/) const noexcept {
+  return false;
+}
+
+#endif
+
+const HardwareCounters& HardwareCounters::ForCurrentThread() {
+  thread_local HardwareCounters counters;
+  return counters;
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+struct HardwareCounterValues {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;
+};
+
+/**
+ * Hardware counters of the calling thread, read through perf_event on Linux. Work done by other threads, e.g. the
+ * intra-op thread pool, is not counted.
+ * Not available on other platforms, or when the kernel doesn't allow perf_event (see perf_event_paranoid).
+ */
+class HardwareCounters {
+ public:
+  // the size of the cache line the bytes moved from memory are estimated with
+  static constexpr uint64_t kCacheLineSize = 64;
+
+  HardwareCounters();
+  ~HardwareCounters();
+
+  bool IsAvailable() const noexcept {
+#if defined(__linux__)
+    return group_fd_ >= 0;
+#else
+    return false;
+#endif
+  }
+
+  /*
+  Reads the values counted by this thread since the counters were created. Returns false if they are not available.
+  */
+  bool Read(HardwareCounterValues& values) const noexcept;
+
+  /*
+  The counters of the calling thread, created on first use.
+  */
+  static const HardwareCounters& ForCurrentThread();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HardwareCounters);
+
+#if defined(__linux__)
+  int group_fd_ = -1;
+  int instructions_fd_ = -1;
+  int llc_misses_fd_ = -1;
+#endif
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
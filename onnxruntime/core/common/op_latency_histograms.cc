@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/op_latency_histograms.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+OpLatencyHistograms::OpLatencyHistograms(uint64_t sample_rate, const std::vector<std::string>& op_types)
+    : sample_rate_(sample_rate) {
+  ORT_ENFORCE(sample_rate_ > 0, "The sample rate of the op latency histograms must be positive");
+  for (const auto& op_type : op_types) {
+    if (op_type_indices_.emplace(op_type, op_types_.size()).second) {
+      op_types_.push_back(op_type);
+    }
+  }
+
+  const size_t num_counts = op_types_.size() * kNumBuckets;
+  counts_ = std::make_unique<std::atomic<uint64_t>[]>(num_counts);
+  for (size_t i = 0; i < num_counts; ++i) {
+    counts_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t OpLatencyHistograms::GetBucket(long long duration_us) noexcept {
+  size_t bucket = 0;
+  while (duration_us > 0 && bucket < kNumBuckets - 1) {
+    duration_us >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void OpLatencyHistograms::Record(const std::string& op_type, long long duration_us) noexcept {
+  auto it = op_type_indices_.find(op_type);
+  if (it == op_type_indices_.end()) {
+    return;
+  }
+
+  counts_[it->second * kNumBuckets + GetBucket(duration_us)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void OpLatencyHistograms::GetBucketCounts(uint64_t* counts) const noexcept {
+  const size_t num_counts = op_types_.size() * kNumBuckets;
+  for (size_t i = 0; i < num_counts; ++i) {
+    counts[i] = counts_[i].load(std::memory_order_relaxed);
+  }
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+/**
+ * Always-on, low overhead alternative to the Profiler. One in sample_rate runs times its kernels and adds the
+ * durations to a latency histogram per op type; the other runs only increment the run counter.
+ * The memory is fixed when the histograms are created and recording uses relaxed atomics, so the histograms
+ * can be read at any time while the session runs, e.g. by a metrics exporter.
+ */
+class OpLatencyHistograms {
+ public:
+  /// Bucket 0 counts the kernels that took less than 1us, bucket i > 0 the ones that took [2^(i-1), 2^i) us.
+  /// The last bucket also counts all the longer ones.
+  static constexpr size_t kNumBuckets = 32;
+
+  OpLatencyHistograms(uint64_t sample_rate, const std::vector<std::string>& op_types);
+
+  /*
+  Returns true for one in sample_rate calls, starting with the first one. Called once per run.
+  */
+  bool ShouldSampleRun() noexcept {
+    return run_count_.fetch_add(1, std::memory_order_relaxed) % sample_rate_ == 0;
+  }
+
+  /*
+  Adds the duration of a kernel to the histogram of its op type. Op types not given to the constructor are ignored.
+  */
+  void Record(const std::string& op_type, long long duration_us) noexcept;
+
+  /*
+  The op types, in the order of their histograms.
+  */
+  const std::vector<std::string>& OpTypes() const noexcept { return op_types_; }
+
+  /*
+  Copies the kNumBuckets counts of the histogram of each op type to counts, one histogram after the other.
+  */
+  void GetBucketCounts(uint64_t* counts) const noexcept;
+
+  uint64_t SampleRate() const noexcept { return sample_rate_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OpLatencyHistograms);
+
+  static size_t GetBucket(long long duration_us) noexcept;
+
+  const uint64_t sample_rate_;
+  std::atomic<uint64_t> run_count_{0};
+  std::vector<std::string> op_types_;
+  // not modified after construction, so it's read without a lock
+  std::unordered_map<std::string, size_t> op_type_indices_;
+  std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
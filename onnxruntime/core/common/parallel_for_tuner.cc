@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/parallel_for_tuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace onnxruntime {
+namespace concurrency {
+
+namespace {
+constexpr const char* kFileHeader = "ort_parallel_for_tuning_v1";
+
+// The innermost scope of the calling thread. A raw pointer, as per-thread state should be trivially destructible.
+thread_local ParallelForTuner::KernelScope* current_kernel_scope = nullptr;
+
+uint64_t NowNanoseconds() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+// loops whose number of iterations has the same magnitude share their tuning
+int IterationsClass(std::ptrdiff_t num_iterations) {
+  int iterations_class = 0;
+  while (num_iterations > 1) {
+    num_iterations >>= 1;
+    ++iterations_class;
+  }
+  return iterations_class;
+}
+}  // namespace
+
+ParallelForTuner::KernelScope::KernelScope(ParallelForTuner* tuner, std::string kernel_key)
+    : tuner_(tuner), kernel_key_(std::move(kernel_key)), prev_scope_(current_kernel_scope) {
+  current_kernel_scope = this;
+}
+
+ParallelForTuner::KernelScope::~KernelScope() {
+  current_kernel_scope = prev_scope_;
+}
+
+void ParallelForTuner::Trial::End() {
+  if (tuner_) {
+    tuner_->EndTrial(*this, NowNanoseconds());
+    tuner_ = nullptr;
+  }
+}
+
+ParallelForTuner::Trial ParallelForTuner::StartTrial(std::ptrdiff_t num_iterations, std::ptrdiff_t block_size,
+                                                     int degree_of_parallelism) {
+  Trial trial;
+  trial.num_iterations_ = num_iterations;
+  trial.block_size_ = block_size;
+  trial.degree_of_parallelism_ = degree_of_parallelism;
+
+  KernelScope* scope = current_kernel_scope;
+  if (scope == nullptr || scope->tuner_ == nullptr || num_iterations <= 0) {
+    return trial;
+  }
+
+  ParallelForTuner& tuner = *scope->tuner_;
+  std::string loop_key = scope->kernel_key_ + "#" + std::to_string(scope->next_loop_index_++) + "#" +
+                         std::to_string(IterationsClass(num_iterations));
+
+  int candidate = kDefaultCandidate;
+  bool measure = false;
+  {
+    std::lock_guard<OrtMutex> lock(tuner.mutex_);
+    LoopStats& stats = tuner.loops_[loop_key];
+    if (stats.chosen_candidate >= 0) {
+      candidate = stats.chosen_candidate;
+    } else if (stats.num_started_samples < kNumCandidates * kSamplesPerCandidate) {
+      // explore the candidates round robin, so that noise is spread over all of them
+      candidate = stats.num_started_samples++ % kNumCandidates;
+      measure = true;
+    }
+  }
+
+  const int block_size_percent = kBlockSizePercents[candidate / kParallelismPercents.size()];
+  const int parallelism_percent = kParallelismPercents[candidate % kParallelismPercents.size()];
+  trial.block_size_ = std::clamp<std::ptrdiff_t>(block_size * block_size_percent / 100, 1, num_iterations);
+  trial.degree_of_parallelism_ = std::max(1, degree_of_parallelism * parallelism_percent / 100);
+
+  if (measure) {
+    trial.tuner_ = &tuner;
+    trial.loop_key_ = std::move(loop_key);
+    trial.candidate_ = candidate;
+    trial.start_ns_ = NowNanoseconds();
+  }
+
+  return trial;
+}
+
+void ParallelForTuner::EndTrial(const Trial& trial, uint64_t end_ns) {
+  const double ns_per_iteration = static_cast<double>(end_ns - trial.start_ns_) /
+                                  static_cast<double>(trial.num_iterations_);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  LoopStats& stats = loops_[trial.loop_key_];
+  if (stats.chosen_candidate >= 0) {
+    return;
+  }
+
+  double& best = stats.best_ns_per_iteration[trial.candidate_];
+  if (best == 0.0 || ns_per_iteration < best) {
+    best = ns_per_iteration;
+  }
+
+  if (++stats.num_completed_samples == kNumCandidates * kSamplesPerCandidate) {
+    stats.chosen_candidate = static_cast<int>(
+        std::min_element(stats.best_ns_per_iteration.cbegin(), stats.best_ns_per_iteration.cend()) -
+        stats.best_ns_per_iteration.cbegin());
+  }
+}
+
+size_t ParallelForTuner::GetNumberOfTunedLoops() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return static_cast<size_t>(std::count_if(loops_.cbegin(), loops_.cend(), [](const auto& loop) {
+    return loop.second.chosen_candidate >= 0;
+  }));
+}
+
+Status ParallelForTuner::Load(const PathString& file_path) {
+  std::ifstream file(file_path);
+  if (!file) {
+    return Status::OK();
+  }
+
+  std::string line;
+  ORT_RETURN_IF_NOT(std::getline(file, line) && line == kFileHeader,
+                    "Unexpected header in the parallel for tuning file: ", line);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    std::string loop_key;
+    int block_size_percent = 0;
+    int parallelism_percent = 0;
+    ORT_RETURN_IF_NOT(std::getline(fields, loop_key, '\t') && fields >> block_size_percent >> parallelism_percent,
+                      "Invalid line in the parallel for tuning file: ", line);
+
+    const auto block_size_it = std::find(kBlockSizePercents.cbegin(), kBlockSizePercents.cend(), block_size_percent);
+    const auto parallelism_it =
+        std::find(kParallelismPercents.cbegin(), kParallelismPercents.cend(), parallelism_percent);
+    if (block_size_it == kBlockSizePercents.cend() || parallelism_it == kParallelismPercents.cend()) {
+      // written with other candidates, tune the loop again
+      continue;
+    }
+
+    loops_[loop_key].chosen_candidate =
+        static_cast<int>((block_size_it - kBlockSizePercents.cbegin()) * kParallelismPercents.size() +
+                         (parallelism_it - kParallelismPercents.cbegin()));
+  }
+
+  return Status::OK();
+}
+
+Status ParallelForTuner::Save(const PathString& file_path) const {
+  std::ofstream file(file_path, std::ios::trunc);
+  ORT_RETURN_IF_NOT(file, "Failed to open the parallel for tuning file for writing.");
+
+  file << kFileHeader << "\n";
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (const auto& loop : loops_) {
+    const int candidate = loop.second.chosen_candidate;
+    if (candidate >= 0) {
+      file << loop.first << "\t" << kBlockSizePercents[candidate / kParallelismPercents.size()] << "\t"
+           << kParallelismPercents[candidate % kParallelismPercents.size()] << "\n";
+    }
+  }
+
+  file.flush();
+  ORT_RETURN_IF_NOT(file, "Failed to write the parallel for tuning file.");
+  return Status::OK();
+}
+
+}  // namespace concurrency
+}  // namespace onnxruntime
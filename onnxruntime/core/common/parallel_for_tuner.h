@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace concurrency {
+
+/**
+ * Online tuner of the block size and degree of parallelism used by ThreadPool::TryParallelFor.
+ *
+ * The cost passed to TryParallelFor is often a rough estimate, so the block size derived from it can be far from
+ * optimal. While a KernelScope is active on a thread, each of its parallel loops is identified by the kernel key of
+ * the scope, the index of the loop within the scope, and the magnitude of its number of iterations. For each such
+ * loop the tuner tries a fixed set of scalings of the block size and the degree of parallelism over consecutive
+ * runs, measures the time per iteration, and then keeps the fastest one.
+ *
+ * Tuned choices can be saved to a file and loaded again, so later sessions skip the exploration.
+ */
+class ParallelForTuner final {
+ public:
+  ParallelForTuner() = default;
+
+  // Makes the parallel loops run by the calling thread use tuner (if not nullptr) while the scope is alive.
+  // kernel_key identifies the kernel and the class of its input shapes.
+  class KernelScope {
+   public:
+    KernelScope(ParallelForTuner* tuner, std::string kernel_key);
+    ~KernelScope();
+
+   private:
+    friend class ParallelForTuner;
+
+    ParallelForTuner* tuner_;
+    std::string kernel_key_;
+    int next_loop_index_ = 0;
+    KernelScope* prev_scope_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelScope);
+  };
+
+  // A tuned or explored choice for one run of a parallel loop. Call End() once the loop completed.
+  class Trial {
+   public:
+    Trial() = default;
+
+    bool IsActive() const noexcept { return tuner_ != nullptr; }
+    std::ptrdiff_t BlockSize() const noexcept { return block_size_; }
+    int DegreeOfParallelism() const noexcept { return degree_of_parallelism_; }
+
+    void End();
+
+   private:
+    friend class ParallelForTuner;
+
+    ParallelForTuner* tuner_ = nullptr;
+    std::string loop_key_;
+    int candidate_ = -1;
+    std::ptrdiff_t num_iterations_ = 0;
+    std::ptrdiff_t block_size_ = 0;
+    int degree_of_parallelism_ = 0;
+    uint64_t start_ns_ = 0;
+  };
+
+  // Starts a trial for a parallel loop run by the calling thread if it is inside a KernelScope with a tuner.
+  // block_size and degree_of_parallelism are the values the thread pool would use without tuning.
+  static Trial StartTrial(std::ptrdiff_t num_iterations, std::ptrdiff_t block_size, int degree_of_parallelism);
+
+  /**
+   * Loads tuned choices saved by Save(). A missing file is not an error.
+   */
+  Status Load(const PathString& file_path);
+
+  /**
+   * Saves the choices of the loops whose tuning completed.
+   */
+  Status Save(const PathString& file_path) const;
+
+  size_t GetNumberOfTunedLoops() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelForTuner);
+
+ private:
+  static constexpr std::array<int, 5> kBlockSizePercents{25, 50, 100, 200, 400};
+  static constexpr std::array<int, 2> kParallelismPercents{100, 50};
+  static constexpr int kNumCandidates = static_cast<int>(kBlockSizePercents.size() * kParallelismPercents.size());
+  // runs measured per candidate before choosing
+  static constexpr int kSamplesPerCandidate = 3;
+
+  // the candidate that keeps the values of the thread pool
+  static constexpr int kDefaultCandidate = 2 * static_cast<int>(kParallelismPercents.size());
+
+  struct LoopStats {
+    // -1 until tuning completes
+    int chosen_candidate = -1;
+    int num_started_samples = 0;
+    int num_completed_samples = 0;
+    std::array<double, kNumCandidates> best_ns_per_iteration{};
+  };
+
+  void EndTrial(const Trial& trial, uint64_t end_ns);
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, LoopStats> loops_;
+};
+
+}  // namespace concurrency
+}  // namespace onnxruntime
@@ -75,19 +75,47 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
                                      const std::string& event_name,
                                      const TimePoint& start_time,
                                      const std::initializer_list<std::pair<std::string, std::string>>& event_args,
-                                     bool /*sync_gpu*/) {
+                                     bool sync_gpu) {
+  EndTimeAndRecordEventWithArgs(category, event_name, start_time, {event_args.begin(), event_args.end()}, sync_gpu);
+}
+
+void Profiler::EndTimeAndRecordEventWithArgs(EventCategory category,
+                                             const std::string& event_name,
+                                             const TimePoint& start_time,
+                                             std::unordered_map<std::string, std::string>&& event_args,
+                                             bool /*sync_gpu*/) {
   long long dur = TimeDiffMicroSeconds(start_time);
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
-  EventRecord event(category, logging::GetProcessId(),
-                    logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+  AddEvent(EventRecord(category, logging::GetProcessId(),
+                       logging::GetThreadId(), event_name, ts, dur, std::move(event_args)));
+
+  for (const auto& ep_profiler : ep_profilers_) {
+    ep_profiler->Stop(ts);
+  }
+}
+
+void Profiler::RecordEvent(EventCategory category,
+                           const std::string& event_name,
+                           unsigned thread_id,
+                           const TimePoint& start_time,
+                           const TimePoint& end_time,
+                           std::unordered_map<std::string, std::string>&& event_args) {
+  long long dur = TimeDiffMicroSeconds(start_time, end_time);
+  long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
+
+  AddEvent(EventRecord(category, logging::GetProcessId(),
+                       static_cast<int>(thread_id), event_name, ts, dur, std::move(event_args)));
+}
+
+void Profiler::AddEvent(EventRecord&& event) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
   } else {
     //TODO: sync_gpu if needed.
     std::lock_guard<OrtMutex> lock(mutex_);
     if (events_.size() < max_num_events_) {
-      events_.emplace_back(event);
+      events_.emplace_back(std::move(event));
     } else {
       if (session_logger_ && !max_events_reached) {
         LOGS(*session_logger_, ERROR)
@@ -96,10 +124,6 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
       }
     }
   }
-
-  for (const auto& ep_profiler : ep_profilers_) {
-    ep_profiler->Stop(ts);
-  }
 }
 
 std::string Profiler::EndProfiling() {
@@ -60,6 +60,18 @@ class Profiler {
   bool IsEnabled() const {
     return enabled_;
   }
+
+  /*
+  Whether the node events also record the hardware counters of the thread running the kernel.
+  */
+  bool HardwareCountersEnabled() const {
+    return hardware_counters_enabled_;
+  }
+
+  void EnableHardwareCounters(bool enable) {
+    hardware_counters_enabled_ = enable;
+  }
+
   /*
   Return the stored start time of profiler.
   On some platforms, this timer may not be as precise as nanoseconds
@@ -79,6 +91,26 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Same as EndTimeAndRecordEvent, with arguments built at runtime.
+  */
+  void EndTimeAndRecordEventWithArgs(EventCategory category,
+                                     const std::string& event_name,
+                                     const TimePoint& start_time,
+                                     std::unordered_map<std::string, std::string>&& event_args,
+                                     bool sync_gpu = false);
+
+  /*
+  Record an event that ran on another thread between start_time and end_time, e.g. a task of the thread pool.
+  thread_id is the logging::GetThreadId() of that thread.
+  */
+  void RecordEvent(EventCategory category,
+                   const std::string& event_name,
+                   unsigned thread_id,
+                   const TimePoint& start_time,
+                   const TimePoint& end_time,
+                   std::unordered_map<std::string, std::string>&& event_args);
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -121,6 +153,8 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  void AddEvent(EventRecord&& event);
+
   /**
    * The maximum number of profiler records to collect.
    * This value is used to initialize the per-profiler maximum.
@@ -131,6 +165,7 @@ class Profiler {
   // Mutex controlling access to profiler data
   OrtMutex mutex_;
   bool enabled_{false};
+  bool hardware_counters_enabled_{false};
 #if defined(__wasm__)
   /*
    * The simplest way to emit profiling data in WebAssembly is to print out to console,
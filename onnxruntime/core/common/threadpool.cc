@@ -18,6 +18,8 @@ limitations under the License.
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
+#include "core/common/logging/logging.h"
+#include "core/common/parallel_for_tuner.h"
 #include "core/common/eigen_common_wrapper.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
@@ -64,6 +66,7 @@ ThreadPoolProfiler::~ThreadPoolProfiler() {
 
 void ThreadPoolProfiler::Start() {
   enabled_ = true;
+  spans_enabled_ = true;
 }
 
 ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
@@ -76,6 +79,7 @@ ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
 
 std::string ThreadPoolProfiler::Stop() {
   ORT_ENFORCE(enabled_, "Profiler not started yet");
+  spans_enabled_ = false;
   std::ostringstream ss;
   ss << "{\"main_thread\": {"
      << "\"thread_pool_name\": \""
@@ -93,6 +97,9 @@ void ThreadPoolProfiler::LogStartAndCoreAndBlock(std::ptrdiff_t block_size) {
     stat.LogCore();
     stat.LogBlockSize(block_size);
     stat.LogStart();
+    if (spans_enabled_) {
+      stat.loop_start_ = Clock::now();
+    }
   }
 }
 
@@ -112,7 +119,14 @@ void ThreadPoolProfiler::LogStart() {
 
 void ThreadPoolProfiler::LogEnd(ThreadPoolEvent evt) {
   if (enabled_) {
-    GetMainThreadStat().LogEnd(evt);
+    MainThreadStat& stat = GetMainThreadStat();
+    stat.LogEnd(evt);
+    // waiting for the workers is the last step of a parallel loop
+    if (evt == WAIT && stat.loop_start_ != onnxruntime::TimePoint{}) {
+      std::lock_guard<OrtMutex> lock(spans_mutex_);
+      spans_.push_back({logging::GetThreadId(), true, stat.loop_start_, Clock::now()});
+      stat.loop_start_ = {};
+    }
   }
 }
 
@@ -197,12 +211,25 @@ const char* ThreadPoolProfiler::GetEventName(ThreadPoolEvent event) {
 
 void ThreadPoolProfiler::LogThreadId(int thread_idx) {
   child_thread_stats_[thread_idx].thread_id_ = std::this_thread::get_id();
+  child_thread_stats_[thread_idx].os_thread_id_ = logging::GetThreadId();
+}
+
+void ThreadPoolProfiler::LogRunStart(int thread_idx) {
+  if (spans_enabled_) {
+    child_thread_stats_[thread_idx].run_start_ = Clock::now();
+  }
 }
 
 void ThreadPoolProfiler::LogRun(int thread_idx) {
   if (enabled_) {
     child_thread_stats_[thread_idx].num_run_++;
     auto now = Clock::now();
+    auto& run_start = child_thread_stats_[thread_idx].run_start_;
+    if (run_start != onnxruntime::TimePoint{}) {
+      std::lock_guard<OrtMutex> lock(spans_mutex_);
+      spans_.push_back({child_thread_stats_[thread_idx].os_thread_id_, false, run_start, now});
+      run_start = {};
+    }
     if (child_thread_stats_[thread_idx].core_ < 0 ||
         TimeDiffMicroSeconds(child_thread_stats_[thread_idx].last_logged_point_, now) > 10000) {
 #ifdef _WIN32
@@ -225,11 +252,30 @@ void ThreadPoolProfiler::LogRun(int thread_idx) {
   }
 }
 
+void ThreadPoolProfiler::LogIdleWait(int thread_idx, bool blocked) {
+  if (enabled_) {
+    if (blocked) {
+      child_thread_stats_[thread_idx].num_blocks_++;
+    } else {
+      child_thread_stats_[thread_idx].num_spin_wakeups_++;
+    }
+  }
+}
+
+std::vector<ThreadPoolSpan> ThreadPoolProfiler::TakeSpans() {
+  std::lock_guard<OrtMutex> lock(spans_mutex_);
+  std::vector<ThreadPoolSpan> spans;
+  spans.swap(spans_);
+  return spans;
+}
+
 std::string ThreadPoolProfiler::DumpChildThreadStat() {
   std::stringstream ss;
   for (int i = 0; i < num_threads_; ++i) {
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
+       << "\"num_spin_wakeups\": " << child_thread_stats_[i].num_spin_wakeups_ << ", "
+       << "\"num_blocks\": " << child_thread_stats_[i].num_blocks_ << ", "
        << "\"core\": " << child_thread_stats_[i].core_ << "}"
        << (i == num_threads_ - 1 ? "" : ",");
   }
@@ -387,17 +433,60 @@ ThreadPool::ThreadPool(Env* env,
   }
 }
 
+ThreadPool::ThreadPool(ThreadPool* shared_pool, int max_degree_of_parallelism, int share_weight)
+    : thread_options_(shared_pool->thread_options_),
+      underlying_threadpool_(shared_pool->underlying_threadpool_),
+      force_hybrid_(shared_pool->force_hybrid_),
+      shared_pool_(shared_pool),
+      max_degree_of_parallelism_(max_degree_of_parallelism),
+      share_weight_(share_weight) {
+  ORT_ENFORCE(shared_pool->shared_pool_ == nullptr, "Cannot create a view of a view of a thread pool");
+}
+
 ThreadPool::~ThreadPool() = default;
 
+ThreadPool::ActiveScope::ActiveScope(ThreadPool* tp) : tp_(tp) {
+  if (tp_ && tp_->shared_pool_ && tp_->share_weight_ > 0) {
+    if (tp_->num_active_scopes_.fetch_add(1, std::memory_order_relaxed) == 0) {
+      tp_->shared_pool_->active_share_weight_.fetch_add(tp_->share_weight_, std::memory_order_relaxed);
+    }
+  } else {
+    tp_ = nullptr;
+  }
+}
+
+ThreadPool::ActiveScope::~ActiveScope() {
+  if (tp_) {
+    if (tp_->num_active_scopes_.fetch_sub(1, std::memory_order_relaxed) == 1) {
+      tp_->shared_pool_->active_share_weight_.fetch_sub(tp_->share_weight_, std::memory_order_relaxed);
+    }
+  }
+}
+
+ThreadPool::UsageStats ThreadPool::GetUsageStats(const ThreadPool* tp) {
+  UsageStats stats;
+  if (tp && tp->shared_pool_) {
+    stats.num_parallel_loops = tp->num_parallel_loops_.load(std::memory_order_relaxed);
+    stats.total_degree_of_parallelism = tp->total_degree_of_parallelism_.load(std::memory_order_relaxed);
+    stats.thread_microseconds = tp->thread_microseconds_.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
 // Base case for parallel loops, running iterations 0..total, divided into blocks
 // of block_size iterations, and calling into a function that takes a start..end
 // range of indices to run.
 void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
                                                      const std::ptrdiff_t block_size,
-                                                     const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+                                                     const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn,
+                                                     int max_parallelism) {
   if (total <= 0)
     return;
 
+  if (max_parallelism <= 0) {
+    max_parallelism = MaxParallelism();
+  }
+
   if (total <= block_size) {
     fn(0, total);
     return;
@@ -408,7 +497,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     // Split the work across threads in the pool.  Each work item will run a loop claiming iterations,
     // hence we need at most one for each thread, even if the number of blocks of iterations is larger.
     auto num_blocks = total / block_size;
-    auto num_threads_inc_main = NumThreads() + 1;
+    auto num_threads_inc_main = max_parallelism;
     int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(num_threads_inc_main), num_blocks));
     assert(num_work_items > 0);
 
@@ -447,7 +536,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     };
     // Distribute task among all threads in the pool, reduce number of work items if 
     // num_of_blocks is smaller than number of threads.
-    RunInParallel(run_work, std::min(NumThreads() + 1, num_of_blocks), base_block_size);
+    RunInParallel(run_work, std::min(max_parallelism, num_of_blocks), base_block_size);
   }
 }
 
@@ -481,6 +570,22 @@ std::string ThreadPool::StopProfiling() {
   }
 }
 
+std::vector<ThreadPoolSpan> ThreadPool::TakeProfilingSpans() {
+  if (underlying_threadpool_) {
+    return underlying_threadpool_->TakeProfilingSpans();
+  } else {
+    return {};
+  }
+}
+
+void ThreadPool::GetStats(ThreadPoolStats& stats) const {
+  if (underlying_threadpool_) {
+    underlying_threadpool_->GetStats(stats);
+  } else {
+    stats = ThreadPoolStats{};
+  }
+}
+
 thread_local ThreadPool::ParallelSection* ThreadPool::ParallelSection::current_parallel_section{nullptr};
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
@@ -503,7 +608,22 @@ ThreadPool::ParallelSection::~ParallelSection() {
 }
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
-  if (underlying_threadpool_) {
+  if (underlying_threadpool_ && shared_pool_) {
+    // record the utilization of the shared pool by the session using this view
+    const auto start = std::chrono::steady_clock::now();
+    if (ThreadPool::ParallelSection::current_parallel_section) {
+      underlying_threadpool_->RunInParallelSection(*(ThreadPool::ParallelSection::current_parallel_section->ps_.get()),
+                                                   std::move(fn),
+                                                   n, block_size);
+    } else {
+      underlying_threadpool_->RunInParallel(std::move(fn),
+                                            n, block_size);
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    num_parallel_loops_.fetch_add(1, std::memory_order_relaxed);
+    total_degree_of_parallelism_.fetch_add(n, std::memory_order_relaxed);
+    thread_microseconds_.fetch_add(static_cast<uint64_t>(elapsed.count()) * n, std::memory_order_relaxed);
+  } else if (underlying_threadpool_) {
     if (ThreadPool::ParallelSection::current_parallel_section) {
       underlying_threadpool_->RunInParallelSection(*(ThreadPool::ParallelSection::current_parallel_section->ps_.get()),
                                                    std::move(fn),
@@ -533,6 +653,11 @@ bool ThreadPool::ShouldParallelizeLoop(const std::ptrdiff_t num_iterations,
     return false;
   }
 
+  // Do not parallelize loops if the quota of a view only allows the caller to run them.
+  if (MaxParallelism() <= 1) {
+    return false;
+  }
+
   return true;
 }
 
@@ -610,7 +735,10 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
   }
 
   ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
-  ParallelForFixedBlockSizeScheduling(n, block, f);
+  // the tuner only changes the values while the caller is inside a ParallelForTuner::KernelScope
+  auto trial = ParallelForTuner::StartTrial(n, block, MaxParallelism());
+  ParallelForFixedBlockSizeScheduling(n, trial.BlockSize(), f, trial.DegreeOfParallelism());
+  trial.End();
 }
 
 void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
@@ -627,9 +755,9 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   // tp, plus 1 for the thread entering a loop.
   if (tp) {
     if (tp->force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
-      return ((tp->NumThreads() + 1)) * TaskGranularityFactor;
+      return tp->MaxParallelism() * TaskGranularityFactor;
     } else {
-      return ((tp->NumThreads() + 1));
+      return tp->MaxParallelism();
     }
   } else {
     return 1;
@@ -650,6 +778,22 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
   }
 }
 
+std::vector<ThreadPoolSpan> ThreadPool::TakeProfilingSpans(concurrency::ThreadPool* tp) {
+  if (tp) {
+    return tp->TakeProfilingSpans();
+  } else {
+    return {};
+  }
+}
+
+void ThreadPool::GetStats(const concurrency::ThreadPool* tp, ThreadPoolStats& stats) {
+  if (tp) {
+    tp->GetStats(stats);
+  } else {
+    stats = ThreadPoolStats{};
+  }
+}
+
 // Return the number of threads created by the pool.
 int ThreadPool::NumThreads() const {
   if (underlying_threadpool_) {
@@ -659,6 +803,24 @@ int ThreadPool::NumThreads() const {
   }
 }
 
+int ThreadPool::MaxParallelism() const {
+  int max_parallelism = NumThreads() + 1;
+  if (shared_pool_) {
+    if (max_degree_of_parallelism_ > 0) {
+      max_parallelism = std::min(max_parallelism, max_degree_of_parallelism_);
+    }
+    if (share_weight_ > 0) {
+      // divide the threads between the active views, rounding down but leaving every view at least the caller
+      const int active_share_weight = shared_pool_->active_share_weight_.load(std::memory_order_relaxed);
+      if (active_share_weight > share_weight_) {
+        const int share = static_cast<int>(static_cast<int64_t>(NumThreads() + 1) * share_weight_ / active_share_weight);
+        max_parallelism = std::min(max_parallelism, std::max(share, 1));
+      }
+    }
+  }
+  return max_parallelism;
+}
+
 // Return ID of the current thread within this pool.  Returns -1 for a thread outside the
 // current pool.
 int ThreadPool::CurrentThreadId() const {
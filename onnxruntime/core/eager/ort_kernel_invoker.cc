@@ -9,50 +9,91 @@
 #include "core/session/ort_env.h"
 #include "core/graph/constants.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 
 #define ORT_EAGER_ONNX_OPSET_VERSION 14
 
-common::Status ORTInvoker::Invoke(const std::string& op_name,
-                                  //optional inputs / outputs?
-                                  const std::vector<OrtValue>& inputs,
-                                  std::vector<OrtValue>& outputs,
-                                  const NodeAttributes* attributes,
-                                  const std::string& domain,
-                                  const int version) {
+struct ORTInvoker::CachedKernel {
+  std::unique_ptr<Model> model;
+  // referenced by info
+  std::function<bool(const std::string&)> is_sparse_initializer_func;
+  std::unique_ptr<OptimizerExecutionFrame::Info> info;
+  const KernelCreateInfo* kernel_create_info = nullptr;
+  std::unique_ptr<const OpKernel> kernel;
+  std::vector<int> feed_mlvalue_idxs;
+  std::vector<int> fetch_mlvalue_idxs;
+};
+
+// The kernel depends on the op, its attributes and the element types of its inputs, not on their shapes.
+static std::string GetKernelCacheKey(const std::string& op_name,
+                                     const std::vector<OrtValue>& inputs,
+                                     size_t output_count,
+                                     const NodeAttributes* attributes,
+                                     const std::string& domain,
+                                     const int version) {
+  std::string key = domain + ":" + op_name + ":" + std::to_string(version) + ":" + std::to_string(output_count);
+  for (const auto& input : inputs) {
+    key += ":" + std::to_string(input.Get<Tensor>().GetElementType());
+  }
+
+  if (attributes != nullptr) {
+    std::vector<const std::string*> attribute_names;
+    attribute_names.reserve(attributes->size());
+    for (const auto& attribute : *attributes) {
+      attribute_names.push_back(&attribute.first);
+    }
+    std::sort(attribute_names.begin(), attribute_names.end(),
+              [](const std::string* lhs, const std::string* rhs) { return *lhs < *rhs; });
+    for (const auto* name : attribute_names) {
+      key += "|" + *name + "=" + attributes->at(*name).SerializeAsString();
+    }
+  }
+
+  return key;
+}
+
+common::Status ORTInvoker::CreateKernel(const std::string& op_name,
+                                        const std::vector<OrtValue>& inputs,
+                                        size_t output_count,
+                                        const NodeAttributes* attributes,
+                                        const std::string& domain,
+                                        const int version,
+                                        std::shared_ptr<const CachedKernel>& cached_kernel) {
   std::unordered_map<std::string, int> domain_version_map = {{kOnnxDomain, ORT_EAGER_ONNX_OPSET_VERSION},
                                                              {kMSDomain, 1}};
+  auto entry = std::make_shared<CachedKernel>();
+
   //create a graph
-  Model model("test", 
-              false, 
-              ModelMetaData(),
-              ORT_TSTR(""),
-              custom_op_registries_,
-              domain_version_map,
-              {},
-              logger_);
+  entry->model = std::make_unique<Model>("test",
+                                         false,
+                                         ModelMetaData(),
+                                         ORT_TSTR(""),
+                                         custom_op_registries_,
+                                         domain_version_map,
+                                         std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                         logger_);
 
   std::vector<onnxruntime::NodeArg*> input_args;
   std::vector<onnxruntime::NodeArg*> output_args;
 
   input_args.reserve(inputs.size());
-  output_args.reserve(outputs.size());
+  output_args.reserve(output_count);
 
-  Graph& graph = model.MainGraph();
-  std::unordered_map<std::string, OrtValue> initializer_map;
+  Graph& graph = entry->model->MainGraph();
   size_t i = 0;
 
-  for (auto input : inputs) {
+  for (const auto& input : inputs) {
     std::string name = "I" + std::to_string(i++);
     const Tensor& input_tensor = input.Get<Tensor>();
     ONNX_NAMESPACE::TypeProto input_tensor_type;
     input_tensor_type.mutable_tensor_type()->set_elem_type(input_tensor.GetElementType());
     auto& arg = graph.GetOrCreateNodeArg(name, &input_tensor_type);
     input_args.push_back(&arg);
-    initializer_map[name] = input;
   }
 
-  for (i = 0; i < outputs.size(); ++i) {
+  for (i = 0; i < output_count; ++i) {
     auto& arg = graph.GetOrCreateNodeArg("O" + std::to_string(i), nullptr);
     output_args.push_back(&arg);
   }
@@ -61,36 +102,93 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
   ORT_RETURN_IF_ERROR(graph.Resolve());
 
   node.SetExecutionProviderType(execution_provider_->Type());
-  std::vector<const Node*> frame_nodes{&node};
 
-  OptimizerExecutionFrame::Info info({&node}, initializer_map, graph.ModelPath(), *execution_provider_, [](std::string const& ) { return false; });
-  const KernelCreateInfo* kernel_create_info = nullptr;
-  ORT_RETURN_IF_ERROR(info.TryFindKernel(&node, &kernel_create_info));
-  if (!kernel_create_info) {
+  // the inputs are fed to each invocation rather than being initializers, so that the kernel doesn't depend on them
+  entry->is_sparse_initializer_func = [](std::string const&) { return false; };
+  entry->info = std::make_unique<OptimizerExecutionFrame::Info>(
+      std::vector<const Node*>{&node}, std::unordered_map<std::string, OrtValue>(), graph.ModelPath(),
+      *execution_provider_, entry->is_sparse_initializer_func);
+  ORT_RETURN_IF_ERROR(entry->info->TryFindKernel(&node, &entry->kernel_create_info));
+  if (!entry->kernel_create_info) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
-  // check whether the inputs are contiguous tensor
-  const auto& may_strided_inputs = kernel_create_info->kernel_def->MayStridedInput();
-  for (i = 0; i < inputs.size(); ++i) {
-    const Tensor& input_tensor = inputs[i].Get<Tensor>();
-    if (!input_tensor.IsContiguous() && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
-                                                  static_cast<int>(i)) == may_strided_inputs.end())
-      ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
-  }
 
-  auto kernel = info.CreateKernel(&node);
-  if (!kernel) {
+  entry->kernel = entry->info->CreateKernel(&node);
+  if (!entry->kernel) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
 
-  std::vector<int> fetch_mlvalue_idxs;
+  for (const auto* node_in : node.InputDefs()) {
+    entry->feed_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_in->Name()));
+  }
   for (const auto* node_out : node.OutputDefs()) {
-    fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+    entry->fetch_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_out->Name()));
+  }
+
+  cached_kernel = std::move(entry);
+  return Status::OK();
+}
+
+void ORTInvoker::SetKernelCacheCapacity(size_t capacity) {
+  std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+  kernel_cache_capacity_ = capacity;
+  while (kernel_cache_lru_.size() > kernel_cache_capacity_) {
+    kernel_cache_.erase(kernel_cache_lru_.back().first);
+    kernel_cache_lru_.pop_back();
+  }
+}
+
+size_t ORTInvoker::GetKernelCacheSize() const {
+  std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+  return kernel_cache_lru_.size();
+}
+
+common::Status ORTInvoker::Invoke(const std::string& op_name,
+                                  //optional inputs / outputs?
+                                  const std::vector<OrtValue>& inputs,
+                                  std::vector<OrtValue>& outputs,
+                                  const NodeAttributes* attributes,
+                                  const std::string& domain,
+                                  const int version) {
+  const std::string key = GetKernelCacheKey(op_name, inputs, outputs.size(), attributes, domain, version);
+
+  std::shared_ptr<const CachedKernel> cached_kernel;
+  {
+    std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+    auto it = kernel_cache_.find(key);
+    if (it != kernel_cache_.end()) {
+      kernel_cache_lru_.splice(kernel_cache_lru_.begin(), kernel_cache_lru_, it->second);
+      cached_kernel = it->second->second;
+    }
+  }
+
+  if (!cached_kernel) {
+    ORT_RETURN_IF_ERROR(CreateKernel(op_name, inputs, outputs.size(), attributes, domain, version, cached_kernel));
+
+    std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+    if (kernel_cache_capacity_ > 0 && kernel_cache_.find(key) == kernel_cache_.end()) {
+      kernel_cache_lru_.emplace_front(key, cached_kernel);
+      kernel_cache_[key] = kernel_cache_lru_.begin();
+      if (kernel_cache_lru_.size() > kernel_cache_capacity_) {
+        kernel_cache_.erase(kernel_cache_lru_.back().first);
+        kernel_cache_lru_.pop_back();
+      }
+    }
+  }
+
+  // check whether the inputs are contiguous tensor
+  const auto& may_strided_inputs = cached_kernel->kernel_create_info->kernel_def->MayStridedInput();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const Tensor& input_tensor = inputs[i].Get<Tensor>();
+    if (!input_tensor.IsContiguous() && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
+                                                  static_cast<int>(i)) == may_strided_inputs.end())
+      ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
   }
 
-  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs, outputs);
-  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger_);
-  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+  OptimizerExecutionFrame frame(*cached_kernel->info, cached_kernel->feed_mlvalue_idxs, inputs,
+                                cached_kernel->fetch_mlvalue_idxs, outputs);
+  OpKernelContext op_kernel_context(&frame, cached_kernel->kernel.get(), nullptr, logger_);
+  ORT_RETURN_IF_ERROR(cached_kernel->kernel->Compute(&op_kernel_context));
 
   return frame.GetOutputs(outputs);
 }
@@ -260,6 +260,39 @@ inline const char *EnumNameTensorDataType(TensorDataType e) {
   return EnumNamesTensorDataType()[index];
 }
 
+enum class TensorCompression : int8_t {
+  NONE = 0,
+  LZ4 = 1,
+  BYTE_SHUFFLE_LZ4 = 2,
+  MIN = NONE,
+  MAX = BYTE_SHUFFLE_LZ4
+};
+
+inline const TensorCompression (&EnumValuesTensorCompression())[3] {
+  static const TensorCompression values[] = {
+    TensorCompression::NONE,
+    TensorCompression::LZ4,
+    TensorCompression::BYTE_SHUFFLE_LZ4
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesTensorCompression() {
+  static const char * const names[4] = {
+    "NONE",
+    "LZ4",
+    "BYTE_SHUFFLE_LZ4",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameTensorCompression(TensorCompression e) {
+  if (flatbuffers::IsOutRange(e, TensorCompression::NONE, TensorCompression::BYTE_SHUFFLE_LZ4)) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesTensorCompression()[index];
+}
+
 enum class NodeType : int32_t {
   Primitive = 0,
   Fused = 1,
@@ -1261,7 +1294,9 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_DIMS = 8,
     VT_DATA_TYPE = 10,
     VT_RAW_DATA = 12,
-    VT_STRING_DATA = 14
+    VT_STRING_DATA = 14,
+    VT_COMPRESSION = 16,
+    VT_COMPRESSED_RAW_DATA = 18
   };
   const flatbuffers::String *name() const {
     return GetPointer<const flatbuffers::String *>(VT_NAME);
@@ -1281,6 +1316,12 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *string_data() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_STRING_DATA);
   }
+  onnxruntime::fbs::TensorCompression compression() const {
+    return static_cast<onnxruntime::fbs::TensorCompression>(GetField<int8_t>(VT_COMPRESSION, 0));
+  }
+  const flatbuffers::Vector<uint8_t> *compressed_raw_data() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_COMPRESSED_RAW_DATA);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_NAME) &&
@@ -1295,6 +1336,9 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_STRING_DATA) &&
            verifier.VerifyVector(string_data()) &&
            verifier.VerifyVectorOfStrings(string_data()) &&
+           VerifyField<int8_t>(verifier, VT_COMPRESSION) &&
+           VerifyOffset(verifier, VT_COMPRESSED_RAW_DATA) &&
+           verifier.VerifyVector(compressed_raw_data()) &&
            verifier.EndTable();
   }
 };
@@ -1321,6 +1365,12 @@ struct TensorBuilder {
   void add_string_data(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data) {
     fbb_.AddOffset(Tensor::VT_STRING_DATA, string_data);
   }
+  void add_compression(onnxruntime::fbs::TensorCompression compression) {
+    fbb_.AddElement<int8_t>(Tensor::VT_COMPRESSION, static_cast<int8_t>(compression), 0);
+  }
+  void add_compressed_raw_data(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> compressed_raw_data) {
+    fbb_.AddOffset(Tensor::VT_COMPRESSED_RAW_DATA, compressed_raw_data);
+  }
   explicit TensorBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1340,14 +1390,18 @@ inline flatbuffers::Offset<Tensor> CreateTensor(
     flatbuffers::Offset<flatbuffers::Vector<int64_t>> dims = 0,
     onnxruntime::fbs::TensorDataType data_type = onnxruntime::fbs::TensorDataType::UNDEFINED,
     flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data = 0,
+    onnxruntime::fbs::TensorCompression compression = onnxruntime::fbs::TensorCompression::NONE,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> compressed_raw_data = 0) {
   TensorBuilder builder_(_fbb);
+  builder_.add_compressed_raw_data(compressed_raw_data);
   builder_.add_string_data(string_data);
   builder_.add_raw_data(raw_data);
   builder_.add_data_type(data_type);
   builder_.add_dims(dims);
   builder_.add_doc_string(doc_string);
   builder_.add_name(name);
+  builder_.add_compression(compression);
   return builder_.Finish();
 }
 
@@ -1358,12 +1412,15 @@ inline flatbuffers::Offset<Tensor> CreateTensorDirect(
     const std::vector<int64_t> *dims = nullptr,
     onnxruntime::fbs::TensorDataType data_type = onnxruntime::fbs::TensorDataType::UNDEFINED,
     const std::vector<uint8_t> *raw_data = nullptr,
-    const std::vector<flatbuffers::Offset<flatbuffers::String>> *string_data = nullptr) {
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *string_data = nullptr,
+    onnxruntime::fbs::TensorCompression compression = onnxruntime::fbs::TensorCompression::NONE,
+    const std::vector<uint8_t> *compressed_raw_data = nullptr) {
   auto name__ = name ? _fbb.CreateString(name) : 0;
   auto doc_string__ = doc_string ? _fbb.CreateString(doc_string) : 0;
   auto dims__ = dims ? _fbb.CreateVector<int64_t>(*dims) : 0;
   auto raw_data__ = raw_data ? _fbb.CreateVector<uint8_t>(*raw_data) : 0;
   auto string_data__ = string_data ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*string_data) : 0;
+  auto compressed_raw_data__ = compressed_raw_data ? _fbb.CreateVector<uint8_t>(*compressed_raw_data) : 0;
   return onnxruntime::fbs::CreateTensor(
       _fbb,
       name__,
@@ -1371,7 +1428,9 @@ inline flatbuffers::Offset<Tensor> CreateTensorDirect(
       dims__,
       data_type,
       raw_data__,
-      string_data__);
+      string_data__,
+      compression,
+      compressed_raw_data__);
 }
 
 struct SparseTensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -3,13 +3,17 @@
 
 #pragma once
 
+#include "core/framework/ort_value.h"
 #include "core/framework/tensor.h"
+#include <iterator>
 #include <vector>
 #include <utility>
 
 namespace onnxruntime {
 // Put this in a separate file to avoid circular dependency between tensor.h and data_types.h
 // Data type to represent a sequence of tensors of the same type
+// The tensors are held in OrtValues, so a tensor can be shared by several sequences (e.g. the input and the output
+// of SequenceInsert) instead of being copied. A shared tensor must not be modified.
 class TensorSeq {
  public:
   TensorSeq() = default;
@@ -17,7 +21,37 @@ class TensorSeq {
     SetType(elem_type);
   }
 
-  using const_iterator = std::vector<Tensor>::const_iterator;
+  // Iterates over the tensors of the sequence.
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Tensor;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Tensor*;
+    using reference = const Tensor&;
+
+    explicit const_iterator(std::vector<OrtValue>::const_iterator it) noexcept : it_(it) {}
+
+    reference operator*() const { return it_->Get<Tensor>(); }
+    pointer operator->() const { return &it_->Get<Tensor>(); }
+
+    const_iterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator prev = *this;
+      ++it_;
+      return prev;
+    }
+
+    bool operator==(const const_iterator& o) const noexcept { return it_ == o.it_; }
+    bool operator!=(const const_iterator& o) const noexcept { return it_ != o.it_; }
+
+   private:
+    std::vector<OrtValue>::const_iterator it_;
+  };
 
   // Sets the element type after construction.
   // Expects sequence to be empty at the time.
@@ -31,6 +65,15 @@ class TensorSeq {
     // The caller of this method ensures that :
     // (1) `elem_type` is set before invoking this method
     // (2) All tensors contain elements of the same primitive data type
+    assert(tensors_.empty());
+    tensors_.reserve(tensors.size());
+    for (auto& tensor : tensors) {
+      tensors_.push_back(CreateValue(std::move(tensor)));
+    }
+  }
+
+  // Same as above with tensors held in OrtValues, which are shared with the sequence.
+  void SetElements(std::vector<OrtValue>&& tensors) {
     assert(tensors_.empty());
     tensors_ = std::move(tensors);
   }
@@ -49,15 +92,20 @@ class TensorSeq {
 
   // Suitable for for range loop
   const_iterator begin() const noexcept {
-    return tensors_.cbegin();
+    return const_iterator(tensors_.cbegin());
   }
 
   const_iterator end() const noexcept {
-    return tensors_.cend();
+    return const_iterator(tensors_.cend());
   }
 
   // Get by index
   const Tensor& Get(size_t i) const {
+    return GetAt(i).Get<Tensor>();
+  }
+
+  // Get the OrtValue holding the tensor at index i, e.g. to add the tensor to another sequence without copying it.
+  const OrtValue& GetAt(size_t i) const {
     ORT_ENFORCE(i < tensors_.size());
     return tensors_[i];
   }
@@ -65,7 +113,15 @@ class TensorSeq {
   void Add(Tensor&& tensor) {
     ORT_ENFORCE(IsSameDataType(tensor),
                 "TensorSeq: tensor to be added has a different data type.");
-    tensors_.push_back(std::move(tensor));
+    tensors_.push_back(CreateValue(std::move(tensor)));
+  }
+
+  // Add the tensor held by an OrtValue. The tensor is shared with the OrtValue, not copied.
+  void Add(const OrtValue& tensor) {
+    ORT_ENFORCE(tensor.IsTensor(), "TensorSeq: value to be added is not a tensor.");
+    ORT_ENFORCE(IsSameDataType(tensor.Get<Tensor>()),
+                "TensorSeq: tensor to be added has a different data type.");
+    tensors_.push_back(tensor);
   }
 
   void Reserve(size_t capacity) {
@@ -80,9 +136,14 @@ class TensorSeq {
   // and the SequenceInsert op expects validation of tensors to be added to the seq against this type.
   const PrimitiveDataTypeBase* elem_type_{};
 
+  static OrtValue CreateValue(Tensor&& tensor) {
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    return OrtValue(new Tensor(std::move(tensor)), ml_tensor, ml_tensor->GetDeleteFunc());
+  }
+
   // TODO: optimization opportunity - if all tensors in the seq are scalars, we can potentially represent them
   // as vector<primitive type>
-  std::vector<Tensor> tensors_;
+  std::vector<OrtValue> tensors_;
 };
 
 }  // namespace onnxruntime
@@ -3,11 +3,14 @@
 
 #include "core/framework/allocation_planner.h"
 #include <list>
+#include <map>
 #include <unordered_map>
 #include <algorithm>
+#include <limits>
 #include <sstream>
 #include "core/common/exceptions.h"
 #include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
 #include "core/platform/env.h"
 #include "core/framework/data_types.h"
 #include "core/framework/kernel_def_builder.h"
@@ -65,6 +68,9 @@ std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind) {
     case AllocKind::kAllocatedExternally:
       out << "AllocatedExternally";
       break;
+    case AllocKind::kSlice:
+      out << "Slice";
+      break;
     case AllocKind::kNotSet:
       out << "NotSet";
       break;
@@ -91,6 +97,8 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
       if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.alloc_kind == AllocKind::kSlice)
+        out << " " << elt_plan.reused_buffer << "+" << elt_plan.slice_offset;
 
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
@@ -104,6 +112,16 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
     out << std::endl;
   }
 
+  std::map<AllocKind, size_t> alloc_kind_counts;
+  for (const auto& elt_plan : plan.allocation_plan) {
+    alloc_kind_counts[elt_plan.alloc_kind]++;
+  }
+  out << "Values by allocation kind:";
+  for (const auto& [alloc_kind, count] : alloc_kind_counts) {
+    out << " " << alloc_kind << "=" << count;
+  }
+  out << std::endl;
+
   out << "\nExecution Plan:\n";
   for (size_t i = 0; i < plan.execution_plan.size(); ++i) {
     auto& step = plan.execution_plan[i];
@@ -138,6 +156,31 @@ static const KernelCreateInfo& GetKernelCreateInfo(
   return *entry->second;
 }
 
+// Get the inputs whose buffer the output of a node may be written over, for the ONNX elementwise ops the CPU kernels
+// of which do not declare MayInplace. Each element of their output is only computed from the same element of the inputs
+// of the output size, which is read before the element is written.
+static InlinedVector<int> GetInferredInplaceInputs(const Node& node) {
+  static const InlinedHashSet<std::string_view> unary_ops{
+      "Abs", "Ceil", "Cos", "Erf", "Exp", "Floor", "Log", "Neg", "Reciprocal", "Round", "Sign", "Sin", "Sqrt"};
+  static const InlinedHashSet<std::string_view> binary_ops{"Add", "Div", "Mul", "Sub"};
+
+  if (node.Domain() != kOnnxDomain || node.GetExecutionProviderType() != kCpuExecutionProvider ||
+      node.OutputDefs().size() != 1) {
+    return {};
+  }
+
+  const size_t num_inputs = node.InputDefs().size();
+  if (num_inputs == 1 && unary_ops.count(node.OpType()) > 0) {
+    return {0};
+  }
+
+  if (num_inputs == 2 && binary_ops.count(node.OpType()) > 0) {
+    return {0, 1};
+  }
+
+  return {};
+}
+
 class PlannerImpl {
  public:
   PlannerImpl(const Node* parent_node, const onnxruntime::GraphViewer& graph_viewer,
@@ -176,6 +219,15 @@ class PlannerImpl {
 
   const OrtValueNameIdxMap& ort_value_name_idx_map_;
 
+  // number of outputs written over an input by the elementwise kernels of GetInferredInplaceInputs
+  size_t num_inferred_inplace_reuses_ = 0;
+
+  // value_queue_ids_ : the queue of the nodes using each value, kMixedQueues if it is used on several queues.
+  // Indexed by OrtValueIndex, and only set when the nodes are assigned to several compute streams.
+  static constexpr int kNoQueue = -1;
+  static constexpr int kMixedQueues = -2;
+  std::vector<int> value_queue_ids_;
+
   // OrtValueInfo: Auxiliary information about an OrtValue used only during plan-generation:
   struct OrtValueInfo {
     const onnxruntime::NodeArg* p_def_site;  // the (unique) NodeArg corresponding to the MLValue
@@ -209,6 +261,14 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // SliceInfo: the buffer a value is a contiguous slice of (see AllocKind::kSlice).
+  struct SliceInfo {
+    OrtValueIndex buffer;  // value whose buffer holds the slice, which may itself be a slice
+    size_t offset;         // offset of the slice in bytes
+  };
+  // concat_slices_ : the inputs of Concat nodes that their producers write in place into the Concat output.
+  InlinedHashMap<OrtValueIndex, SliceInfo> concat_slices_;
+
   OrtValueIndex Index(const OrtValueName& name) {
     OrtValueIndex result;
     auto status = ort_value_name_idx_map_.GetIdx(name, result);
@@ -274,6 +334,37 @@ class PlannerImpl {
     auto& symplan = AllocPlan(reused_for);
     symplan.alloc_kind = alloc_kind;
     symplan.reused_buffer = original;
+
+    // reusing a slice reuses the same bytes of the original buffer
+    const auto& reused_plan = AllocPlan(reused);
+    if (alloc_kind == AllocKind::kReuse && reused_plan.alloc_kind == AllocKind::kSlice) {
+      symplan.alloc_kind = AllocKind::kSlice;
+      symplan.slice_offset = reused_plan.slice_offset;
+      symplan.reused_buffer_shape = reused_plan.reused_buffer_shape;
+    }
+  }
+
+  // Plan a value as a slice of a buffer. The buffer of the slices of a Concat output is allocated when the first
+  // slice is, and lives from there.
+  void ReuseSlice(const SliceInfo& slice, OrtValueIndex reused_for, size_t program_counter) {
+    Reuse(slice.buffer, reused_for, AllocKind::kSlice);
+
+    const auto& buffer_plan = AllocPlan(slice.buffer);
+    auto& symplan = AllocPlan(reused_for);
+    symplan.slice_offset = slice.offset + (buffer_plan.alloc_kind == AllocKind::kSlice ? buffer_plan.slice_offset : 0);
+
+    OrtValueIndex original = symplan.reused_buffer;
+    auto& original_plan = AllocPlan(original);
+    if (original_plan.alloc_kind == AllocKind::kNotSet) {
+      original_plan.alloc_kind = AllocKind::kAllocate;
+      original_plan.value_type = utils::GetMLDataType(*ort_value_info_[original].p_def_site);
+      original_plan.program_counter.AddStart(program_counter);
+    }
+
+    TensorShapeVector original_dims;
+    if (GetStaticShape(*ort_value_info_[original].p_def_site, original_dims)) {
+      symplan.reused_buffer_shape.assign(original_dims.begin(), original_dims.end());
+    }
   }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -286,7 +377,10 @@ class PlannerImpl {
 #endif
 
   // Find if there exists some input tensor that we can use in-place for output_arg_num-th input in the node.
-  bool FindReusableInput(const onnxruntime::Node& node, int output_arg_num, OrtValueIndex* reusable_input) {
+  // Sets is_strided_tensor if the output is a strided view of the input.
+  bool FindReusableInput(const onnxruntime::Node& node, int output_arg_num, OrtValueIndex* reusable_input,
+                         bool* is_strided_tensor) {
+    *is_strided_tensor = false;
 #ifdef ENABLE_TRAINING
     // Inputs of Yields are essentially the outputs for FW partial subgraph
     // Thses tensors will be pass back to pytorch, thus cannot share the buffer with other tensors
@@ -338,6 +432,12 @@ class PlannerImpl {
       }
     }
 
+    // with several compute streams, the input may still be read on another stream after its last use in the plan
+    const int queue_id = NodeQueueId(node);
+    auto is_used_only_on_queue = [this, queue_id](OrtValueIndex value) {
+      return IsUsedOnlyOnQueue(value, queue_id) && IsUsedOnlyOnQueue(Buffer(value), queue_id);
+    };
+
     const auto& inplace_map = ci.kernel_def->MayInplace();
     for (auto& pair : inplace_map) {
       if (pair.second == output_arg_num) {
@@ -346,7 +446,7 @@ class PlannerImpl {
           if (p_input_arg->Exists()) {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
-            if (1 == UseCount(original)) {
+            if (1 == UseCount(original) && is_used_only_on_queue(input_arg_index)) {
               if (SameSize(*p_input_arg, *p_output_arg)) {
                 // we can reuse this input since it is its last use and permitted for in-place update
                 *reusable_input = input_arg_index;  // or original; both should be okay
@@ -358,7 +458,23 @@ class PlannerImpl {
       }
     }
 
-#ifdef ENABLE_TRAINING
+    if (output_arg_num == 0 && inplace_map.empty()) {
+      for (int input_arg_num : GetInferredInplaceInputs(node)) {
+        auto p_input_arg = input_args[input_arg_num];
+        if (p_input_arg->Exists()) {
+          auto input_arg_index = Index(p_input_arg->Name());
+          // the buffer is not read after the node, including through another input of it
+          if (1 == UseCount(Buffer(input_arg_index)) && is_used_only_on_queue(input_arg_index) &&
+              SameSize(*p_input_arg, *p_output_arg)) {
+            *reusable_input = input_arg_index;
+            ++num_inferred_inplace_reuses_;
+            return true;
+          }
+        }
+      }
+    }
+
+#ifdef ENABLE_STRIDED_TENSORS
     // If any output of the kernel can support strided tensor, and all its consumers' inputs also support
     // strided tensors at the corresponding position, this output will generate a strided tensor
     // and share the data from the corresponding input specified in MayStridedOutputsMap.
@@ -381,12 +497,18 @@ class PlannerImpl {
               break;
             }
           }
+          // a subgraph may read the value with any kernel
+          const auto& implicit_inputs = it->ImplicitInputDefs();
+          if (std::find(implicit_inputs.begin(), implicit_inputs.end(), p_output_arg) != implicit_inputs.end()) {
+            can_strided = false;
+          }
           if (!can_strided) {
             break;
           }
         }
         if (can_strided) {
           *reusable_input = Index(input_args[pair.first]->Name());
+          *is_strided_tensor = true;
           return true;
         }
       }
@@ -468,7 +590,8 @@ class PlannerImpl {
   }
 
   // Find if freelist contains a buffer of the same size as output_arg
-  bool FindReusableTensor(const onnxruntime::NodeArg& output_arg, OrtValueIndex* reusable_tensor) {
+  // queue_id is the queue of the node producing output_arg, whose stream must be the only one using the buffer.
+  bool FindReusableTensor(const onnxruntime::NodeArg& output_arg, int queue_id, OrtValueIndex* reusable_tensor) {
     if (!context_.GetEnableMemoryReuse()) {
       return false;
     }
@@ -496,6 +619,7 @@ class PlannerImpl {
 
       auto& available_memory_info = AllocPlan(p_node_arg->Name()).location;
       if (!(available_memory_info == required_memory_info)) continue;
+      if (!IsUsedOnlyOnQueue(it->ml_value, queue_id)) continue;
       auto p_available_buffer_shape = context_.GetShape(*p_node_arg);
       if (nullptr != p_available_buffer_shape) {
         if (SameSize(*p_available_buffer_shape, *p_node_arg,
@@ -509,6 +633,163 @@ class PlannerImpl {
     return false;
   }
 
+  // Get the dimensions of a tensor of a fixed size type if they are all known.
+  bool GetStaticShape(const onnxruntime::NodeArg& arg, TensorShapeVector& dims) const {
+    if (!arg.Exists() || IsNonTensor(arg) ||
+        arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return false;
+    }
+
+    const auto* shape = context_.GetShape(arg);
+    if (shape == nullptr) return false;
+
+    dims.clear();
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) return false;
+      dims.push_back(dim.dim_value());
+    }
+    return true;
+  }
+
+  static bool IsCpuOnnxNode(const Node& node, const char* op_type) {
+    return node.OpType() == op_type && node.Domain() == kOnnxDomain &&
+           node.GetExecutionProviderType() == kCpuExecutionProvider;
+  }
+
+  // Get the offsets in bytes of the parts that whole is concatenated from, or split into, along the axis of node,
+  // if the shapes are static and each part is a contiguous slice of whole: the dimensions before the axis are 1.
+  bool GetSliceOffsets(const Node& node, const onnxruntime::NodeArg& whole,
+                       const ConstPointerContainer<std::vector<NodeArg*>>& parts, std::vector<size_t>& offsets) const {
+    TensorShapeVector whole_dims;
+    if (!GetStaticShape(whole, whole_dims) || whole_dims.empty()) return false;
+
+    const auto& attributes = node.GetAttributes();
+    const auto axis_attribute = attributes.find("axis");
+    int64_t axis = axis_attribute == attributes.end() ? 0 : axis_attribute->second.i();
+    const int64_t rank = static_cast<int64_t>(whole_dims.size());
+    if (axis < 0) axis += rank;
+    if (axis < 0 || axis >= rank) return false;
+
+    for (int64_t i = 0; i < axis; ++i) {
+      if (whole_dims[i] != 1) return false;
+    }
+
+    const size_t element_size = GetElementSize(whole.Type());
+    int64_t axis_dim = 0;
+    size_t offset = 0;
+    offsets.clear();
+    for (const auto* part : parts) {
+      TensorShapeVector part_dims;
+      if (part == nullptr || !GetStaticShape(*part, part_dims) || part_dims.size() != whole_dims.size() ||
+          GetElementSize(part->Type()) != element_size) {
+        return false;
+      }
+
+      for (int64_t i = 0; i < rank; ++i) {
+        if (i != axis && part_dims[i] != whole_dims[i]) return false;
+      }
+
+      offsets.push_back(offset);
+      axis_dim += part_dims[axis];
+      offset += static_cast<size_t>(TensorShape(part_dims).Size()) * element_size;
+    }
+
+    return axis_dim == whole_dims[axis];
+  }
+
+  // Whether an output of a node must share the buffer of one of its inputs, as the output of Reshape.
+  bool MustReuseInput(const Node& node, int output_arg_num) const {
+    const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node.Index());
+    if (ci.kernel_def == nullptr) return true;
+
+    for (const auto& pair : ci.kernel_def->Alias()) {
+      if (pair.second == output_arg_num) return true;
+    }
+    return ci.kernel_def->VariadicAlias().has_value();
+  }
+
+  // Plan the inputs of Concat nodes on CPU to be written in place into the Concat output by their producers, when
+  // they are contiguous slices of the output. The Concat kernel then skips them.
+  void ComputeConcatSlices() {
+    if (context_.IsParallelExecutionEnabled() || !context_.GetEnableMemoryReuse()) return;
+
+    const auto& graph_outputs = graph_viewer_.GetOutputs();
+    std::vector<size_t> offsets;
+    for (const auto& step : plan_.execution_plan) {
+      const auto* pnode = graph_viewer_.GetNode(step.node_index);
+      if (!IsCpuOnnxNode(*pnode, "Concat")) continue;
+
+      const auto* output = pnode->OutputDefs()[0];
+      if (std::find(graph_outputs.begin(), graph_outputs.end(), output) != graph_outputs.end() ||
+          !GetSliceOffsets(*pnode, *output, pnode->InputDefs(), offsets)) {
+        continue;
+      }
+
+      const OrtValueIndex output_index = Index(output->Name());
+      const auto input_defs = pnode->InputDefs();
+      for (size_t i = 0; i < input_defs.size(); ++i) {
+        const auto* input = input_defs[i];
+        const OrtValueIndex input_index = Index(input->Name());
+
+        // The input shall be used by this Concat only, which excludes graph outputs and inputs used twice,
+        // and shall be produced on CPU by a node that can write its output anywhere. A producing Concat or Split
+        // keeps its output, which may hold slices of its own.
+        const Node* producer = graph_viewer_.GetProducerNode(input->Name());
+        if (producer == nullptr || UseCount(input_index) != 2 ||
+            producer->GetExecutionProviderType() != kCpuExecutionProvider ||
+            IsCpuOnnxNode(*producer, "Concat") || IsCpuOnnxNode(*producer, "Split") ||
+            AllocPlan(input_index).create_fence_if_async ||
+            !(AllocPlan(input_index).location == AllocPlan(output_index).location)) {
+          continue;
+        }
+
+        const auto producer_outputs = producer->OutputDefs();
+        size_t producer_output = 0;
+        while (producer_outputs[producer_output] != input) ++producer_output;
+        if (MustReuseInput(*producer, static_cast<int>(producer_output))) continue;
+
+        concat_slices_[input_index] = SliceInfo{output_index, offsets[i]};
+      }
+    }
+  }
+
+  // Find the slice of a buffer an output of a node is planned as: an input of a Concat written in place, or an
+  // output of a Split on CPU, which is a view of the input when it is a contiguous slice of it.
+  bool FindSlice(const Node& node, OrtValueIndex output_index, SliceInfo& slice) {
+    const auto concat_slice = concat_slices_.find(output_index);
+    if (concat_slice != concat_slices_.end()) {
+      slice = concat_slice->second;
+      return true;
+    }
+
+    if (context_.IsParallelExecutionEnabled() || !context_.GetEnableMemoryReuse() || !IsCpuOnnxNode(node, "Split")) {
+      return false;
+    }
+
+    // Views are planned only into the activation buffers of this graph.
+    const auto* input = node.InputDefs()[0];
+    const OrtValueIndex input_index = Index(input->Name());
+    const auto& input_plan = AllocPlan(input_index);
+    const OrtValueIndex original = Buffer(input_index);
+    if (original < 0 || AllocPlan(original).alloc_kind != AllocKind::kAllocate ||
+        input_plan.create_fence_if_async || AllocPlan(output_index).create_fence_if_async ||
+        !(input_plan.location == AllocPlan(output_index).location)) {
+      return false;
+    }
+
+    std::vector<size_t> offsets;
+    const auto output_defs = node.OutputDefs();
+    if (!GetSliceOffsets(node, *input, output_defs, offsets)) return false;
+
+    for (size_t i = 0; i < output_defs.size(); ++i) {
+      if (Index(output_defs[i]->Name()) == output_index) {
+        slice = SliceInfo{input_index, offsets[i]};
+        return true;
+      }
+    }
+    return false;
+  }
+
   void Initialize(size_t num_graph_nodes, size_t num_ml_values) {
     // All ml-value indices must be in range 0 .. num_ml_values-1
     ort_value_info_.resize(num_ml_values);
@@ -730,7 +1011,7 @@ class PlannerImpl {
       // if sync is needed, mark allocation plan as create_fence_if_async=true
       // note that the input arg may come from an execution provider (i.e. CPU) that does not support async,
       // in which case create_fence_if_async would be ignored when creating MLValue
-      if (p_kernel_def->ExecQueueId() != 0) {
+      if (plan_.NodeQueueId(pnode->Index(), p_kernel_def->ExecQueueId()) != 0) {
         pnode->ForEachDef([this](const onnxruntime::NodeArg& arg, bool /*is_input*/) {
           OrtValueIndex index = Index(arg.Name());
           AllocPlan(index).create_fence_if_async = true;
@@ -960,6 +1241,8 @@ class PlannerImpl {
         // Declare OrtValue index of the reused buffer.
         // The the OrtValue indexed by current may reuse the memory in the OrtValue indexed by reused.
         OrtValueIndex reused;
+        SliceInfo slice;
+        bool is_strided_tensor = false;
         if (has_external_outputs) {
           ORT_ENFORCE(!IsNonTensor(*node_output), "Only tensors are supported for external outputs for now.");
           AllocPlan(current).alloc_kind = AllocKind::kAllocatedExternally;
@@ -1005,12 +1288,19 @@ class PlannerImpl {
               }
             }
           }
+        } else if (AllocPlan(current).alloc_kind == AllocKind::kAllocate) {
+          // a Concat output already allocated for the inputs written in place by their producers
+        } else if (FindSlice(*pnode, current, slice)) {
+          ReuseSlice(slice, current, program_counter);
         } else if (!context_.IsParallelExecutionEnabled() &&
-                   FindReusableInput(*pnode, static_cast<int>(output_arg_def_index), &reused)) {
+                   FindReusableInput(*pnode, static_cast<int>(output_arg_def_index), &reused, &is_strided_tensor)) {
           // Re-using inputs is applicable for tensors, sequence tensors,
           // and optional types if the kernel has marked certain inputs as
           // possible candidates for re-use
           Reuse(reused, current, AllocKind::kReuse);
+#ifdef ENABLE_STRIDED_TENSORS
+          AllocPlan(current).is_strided_tensor = is_strided_tensor;
+#endif
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
           InplaceReuse(reused, current);
 #endif
@@ -1018,7 +1308,7 @@ class PlannerImpl {
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
           AllocPlan(current).program_counter.AddStart(program_counter);
         } else if (!context_.IsParallelExecutionEnabled() &&
-                   FindReusableTensor(*node_output, &reused)) {
+                   FindReusableTensor(*node_output, NodeQueueId(*pnode), &reused)) {
           // Reuse an available (dead) buffer for this output, this is only for sequential execution.
           Reuse(reused, current, AllocKind::kReuse);
           OrtValueIndex original = Buffer(reused);
@@ -1261,6 +1551,380 @@ class PlannerImpl {
   }
 #endif
 
+  // The activations of a node for the estimation of the memory of an execution order: the values it consumes and
+  // produces, and for each output the input whose buffer it may reuse.
+  struct OrderNodeInfo {
+    struct OutputReuse {
+      OrtValueIndex input = -1;  // -1 when the output needs a buffer of its own
+      bool must_reuse = false;   // the output aliases the input, e.g. for Reshape
+    };
+    InlinedVector<OrtValueIndex> inputs;  // distinct values produced by the nodes of the graph
+    InlinedVector<OrtValueIndex> outputs;
+    InlinedVector<OutputReuse> output_reuses;
+  };
+
+  // The buffers live at some point of an execution order. A buffer is freed when the last value in it is consumed
+  // for the last time, except for the buffers of the graph outputs.
+  struct OrderMemoryState {
+    std::vector<int> remaining_uses;  // the nodes yet to consume each value
+    std::vector<int> buffers;         // the buffer of each value, -1 if none
+    std::vector<size_t> buffer_sizes;
+    std::vector<int> buffer_values;  // the number of live values in each buffer
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+  };
+
+  // Estimated size of a tensor. Symbolic dimensions count as 1, so that values sharing them, such as a batch
+  // dimension, keep their relative sizes. Values of unknown shape count as empty.
+  size_t EstimateSizeInBytes(const onnxruntime::NodeArg& arg) const {
+    if (!arg.Exists() || IsNonTensor(arg) ||
+        arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return 0;
+    }
+
+    const auto* shape = context_.GetShape(arg);
+    if (shape == nullptr) return 0;
+
+    size_t size = GetElementSize(arg.Type());
+    for (const auto& dim : shape->dim()) {
+      if (utils::HasDimValue(dim) && dim.dim_value() >= 0) size *= static_cast<size_t>(dim.dim_value());
+    }
+    return size;
+  }
+
+  OrderNodeInfo GetOrderNodeInfo(const Node& node, std::vector<size_t>& value_sizes) {
+    OrderNodeInfo info;
+    auto add_input = [&](const NodeArg* arg) {
+      if (arg->Exists() && graph_viewer_.GetProducerNode(arg->Name()) != nullptr) {
+        const OrtValueIndex index = Index(arg->Name());
+        if (std::find(info.inputs.begin(), info.inputs.end(), index) == info.inputs.end()) {
+          info.inputs.push_back(index);
+        }
+      }
+    };
+    for (const NodeArg* arg : node.InputDefs()) add_input(arg);
+    for (const NodeArg* arg : node.ImplicitInputDefs()) add_input(arg);
+
+    const auto& input_args = node.InputDefs();
+    auto input_index = [&](int arg_num) -> OrtValueIndex {
+      if (arg_num < 0 || static_cast<size_t>(arg_num) >= input_args.size() || !input_args[arg_num]->Exists() ||
+          graph_viewer_.GetProducerNode(input_args[arg_num]->Name()) == nullptr) {
+        return -1;
+      }
+      return Index(input_args[arg_num]->Name());
+    };
+
+    const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node.Index());
+    const auto& output_args = node.OutputDefs();
+    for (int output_arg_num = 0; static_cast<size_t>(output_arg_num) < output_args.size(); output_arg_num++) {
+      if (!output_args[output_arg_num]->Exists()) continue;
+
+      OrderNodeInfo::OutputReuse reuse;
+      if (ci.kernel_def != nullptr) {
+        for (const auto& pair : ci.kernel_def->Alias()) {
+          if (pair.second == output_arg_num) {
+            reuse = {input_index(pair.first), true};
+          }
+        }
+
+        const auto& variadic_alias_offsets = ci.kernel_def->VariadicAlias();
+        if (!reuse.must_reuse && variadic_alias_offsets.has_value() &&
+            output_arg_num >= variadic_alias_offsets->second) {
+          reuse = {input_index(output_arg_num - variadic_alias_offsets->second + variadic_alias_offsets->first), true};
+        }
+
+        for (const auto& pair : ci.kernel_def->MayInplace()) {
+          if (!reuse.must_reuse && reuse.input < 0 && pair.second == output_arg_num) {
+            reuse.input = input_index(pair.first);
+          }
+        }
+      }
+
+      const OrtValueIndex output = Index(output_args[output_arg_num]->Name());
+      value_sizes[output] = EstimateSizeInBytes(*output_args[output_arg_num]);
+      info.outputs.push_back(output);
+      info.output_reuses.push_back(reuse);
+    }
+
+    return info;
+  }
+
+  // Estimates the memory allocated for the outputs of the node and the memory freed once it ran. The memory is only
+  // updated when `commit` is true, in which case the returned amount freed is not meaningful.
+  std::pair<size_t, size_t> ExecuteInOrder(const OrderNodeInfo& node, const std::vector<size_t>& value_sizes,
+                                           const std::vector<int>& use_counts,
+                                           const std::vector<bool>& is_graph_output, OrderMemoryState& state,
+                                           bool commit) const {
+    auto dies_here = [&](OrtValueIndex value) {
+      return !is_graph_output[value] && state.remaining_uses[value] == 1;
+    };
+
+    // the buffer taken over by each output, which an in-place output only does with the last value in it
+    InlinedVector<int> output_buffers(node.outputs.size(), -1);
+    size_t allocated = 0;
+    for (size_t i = 0; i < node.outputs.size(); i++) {
+      const auto& reuse = node.output_reuses[i];
+      int buffer = reuse.input >= 0 ? state.buffers[reuse.input] : -1;
+      if (buffer >= 0 && !reuse.must_reuse &&
+          (!dies_here(reuse.input) || state.buffer_values[buffer] != 1 ||
+           state.buffer_sizes[buffer] != value_sizes[node.outputs[i]] ||
+           std::find(output_buffers.begin(), output_buffers.end(), buffer) != output_buffers.end())) {
+        buffer = -1;
+      }
+
+      output_buffers[i] = buffer;
+      // an alias of a value that is not planned here, e.g. a graph input, takes no memory
+      if (buffer < 0 && !reuse.must_reuse) {
+        allocated += value_sizes[node.outputs[i]];
+      }
+    }
+
+    if (!commit) {
+      InlinedHashMap<int, int> dying_values;
+      for (OrtValueIndex input : node.inputs) {
+        if (dies_here(input) && state.buffers[input] >= 0) {
+          dying_values[state.buffers[input]]++;
+        }
+      }
+
+      for (int buffer : output_buffers) {
+        if (buffer >= 0) {
+          dying_values[buffer]--;
+        }
+      }
+
+      size_t freed = 0;
+      for (const auto& [buffer, count] : dying_values) {
+        if (count == state.buffer_values[buffer]) {
+          freed += state.buffer_sizes[buffer];
+        }
+      }
+
+      for (size_t i = 0; i < node.outputs.size(); i++) {
+        if (output_buffers[i] < 0 && use_counts[node.outputs[i]] == 0 && !is_graph_output[node.outputs[i]]) {
+          freed += value_sizes[node.outputs[i]];
+        }
+      }
+
+      return {allocated, freed};
+    }
+
+    state.live_bytes += allocated;
+    state.peak_bytes = std::max(state.peak_bytes, state.live_bytes);
+
+    for (size_t i = 0; i < node.outputs.size(); i++) {
+      const OrtValueIndex output = node.outputs[i];
+      int buffer = output_buffers[i];
+      if (buffer < 0 && !node.output_reuses[i].must_reuse) {
+        buffer = static_cast<int>(state.buffer_sizes.size());
+        state.buffer_sizes.push_back(value_sizes[output]);
+        state.buffer_values.push_back(0);
+      }
+
+      state.buffers[output] = buffer;
+      state.remaining_uses[output] = use_counts[output];
+      if (buffer >= 0) {
+        state.buffer_values[buffer]++;
+      }
+    }
+
+    auto release = [&state](OrtValueIndex value) {
+      const int buffer = state.buffers[value];
+      if (buffer >= 0 && --state.buffer_values[buffer] == 0) {
+        state.live_bytes -= state.buffer_sizes[buffer];
+      }
+    };
+
+    for (OrtValueIndex input : node.inputs) {
+      if (--state.remaining_uses[input] == 0 && !is_graph_output[input]) {
+        release(input);
+      }
+    }
+
+    for (OrtValueIndex output : node.outputs) {
+      if (state.remaining_uses[output] == 0 && !is_graph_output[output]) {
+        release(output);
+      }
+    }
+
+    return {allocated, 0};
+  }
+
+  // Assigns the nodes of the execution providers with several compute streams to the streams, in execution order:
+  // a node continues the stream of an input producer that is the last node of its stream, else it starts on the
+  // stream used least recently, so the branches of the graph run concurrently. Nodes with subgraphs and nodes
+  // whose kernels run on another queue, like the copies, stay on their kernel queue. Only the main graph of a
+  // sequential execution is assigned, as the values of the subgraphs are shared with the nodes running them.
+  void ComputeStreamAssignment() {
+    if (parent_node_ != nullptr || context_.IsParallelExecutionEnabled()) return;
+
+    struct StreamState {
+      NodeIndex tail;   // last node assigned to the stream
+      size_t last_use;  // step of the execution plan after which the stream was last assigned a node
+    };
+    InlinedHashMap<const IExecutionProvider*, std::vector<int>> provider_queue_ids;
+    InlinedHashMap<int, StreamState> streams;
+    std::vector<int> node_queue_ids(graph_viewer_.MaxNodeIndex(), 0);
+    bool is_multi_stream = false;
+
+    for (size_t step = 0; step < plan_.execution_plan.size(); ++step) {
+      const NodeIndex node_index = plan_.execution_plan[step].node_index;
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      const auto& kernel_def = GetKernelCreateInfo(kernel_create_info_map_, node_index).kernel_def;
+      const int kernel_queue_id = kernel_def ? kernel_def->ExecQueueId() : 0;
+      node_queue_ids[node_index] = kernel_queue_id;
+
+      const auto* provider = execution_providers_.Get(*pnode);
+      if (provider == nullptr || kernel_queue_id != 0 || pnode->ContainsSubgraph()) continue;
+      auto queue_ids = provider_queue_ids.find(provider);
+      if (queue_ids == provider_queue_ids.end()) {
+        queue_ids = provider_queue_ids.emplace(provider, provider->GetComputeQueueIds()).first;
+        for (int queue_id : queue_ids->second) {
+          streams.emplace(queue_id, StreamState{NodeIndex(-1), 0});
+        }
+      }
+      if (queue_ids->second.size() < 2) continue;
+      is_multi_stream = true;
+
+      int queue_id = -1;
+      for (auto it = pnode->InputNodesBegin(), end = pnode->InputNodesEnd(); it != end && queue_id < 0; ++it) {
+        const int producer_queue_id = node_queue_ids[it->Index()];
+        const auto stream = streams.find(producer_queue_id);
+        if (stream != streams.end() && stream->second.tail == it->Index() &&
+            std::find(queue_ids->second.begin(), queue_ids->second.end(), producer_queue_id) !=
+                queue_ids->second.end()) {
+          queue_id = producer_queue_id;
+        }
+      }
+      if (queue_id < 0) {
+        queue_id = queue_ids->second[0];
+        for (int candidate : queue_ids->second) {
+          if (streams[candidate].last_use < streams[queue_id].last_use) queue_id = candidate;
+        }
+      }
+
+      node_queue_ids[node_index] = queue_id;
+      streams[queue_id] = StreamState{node_index, step + 1};
+    }
+
+    if (!is_multi_stream) return;
+    plan_.node_queue_ids = std::move(node_queue_ids);
+
+    // the queues each value is used on, a buffer being reused only by a node of the single queue using it
+    value_queue_ids_.assign(ort_value_info_.size(), kNoQueue);
+    for (const auto& step : plan_.execution_plan) {
+      const Node& node = *graph_viewer_.GetNode(step.node_index);
+      const int queue_id = plan_.node_queue_ids[step.node_index];
+      node.ForEachDef([this, queue_id](const onnxruntime::NodeArg& arg, bool /*is_input*/) {
+        int& value_queue_id = value_queue_ids_[Index(arg.Name())];
+        value_queue_id = (value_queue_id == kNoQueue || value_queue_id == queue_id) ? queue_id : kMixedQueues;
+      });
+    }
+  }
+
+  int NodeQueueId(const Node& node) const {
+    const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node.Index());
+    return plan_.NodeQueueId(node.Index(), ci.kernel_def->ExecQueueId());
+  }
+
+  // Whether a value is used only by the nodes running on queue_id, so that its buffer can be reused by them.
+  bool IsUsedOnlyOnQueue(OrtValueIndex value, int queue_id) const {
+    return value_queue_ids_.empty() || value_queue_ids_[value] == queue_id;
+  }
+
+  // Orders the nodes to keep the memory of the activations low: of the nodes whose inputs are ready, run the one that
+  // adds the least memory once it ran, counting the outputs written in place or aliasing an input as free, and prefer
+  // the earlier node in the default order on ties. The greedy order replaces the default one only if its estimated
+  // peak memory is lower.
+  std::vector<NodeIndex> ComputeMemoryEfficientOrder(const std::vector<NodeIndex>& default_order) {
+    const size_t num_values = static_cast<size_t>(ort_value_name_idx_map_.MaxIdx()) + 1;
+    std::vector<size_t> value_sizes(num_values, 0);
+    std::vector<int> use_counts(num_values, 0);
+    std::vector<bool> is_graph_output(num_values, false);
+    for (const NodeArg* output : graph_viewer_.GetOutputs()) {
+      is_graph_output[Index(output->Name())] = true;
+    }
+
+    InlinedHashMap<NodeIndex, size_t> positions;
+    InlinedHashMap<NodeIndex, OrderNodeInfo> node_infos;
+    for (size_t i = 0; i < default_order.size(); i++) {
+      const Node& node = *graph_viewer_.GetNode(default_order[i]);
+      positions[node.Index()] = i;
+      auto& info = node_infos[node.Index()] = GetOrderNodeInfo(node, value_sizes);
+      for (OrtValueIndex input : info.inputs) {
+        use_counts[input]++;
+      }
+    }
+
+    auto new_state = [num_values]() {
+      OrderMemoryState state;
+      state.remaining_uses.assign(num_values, 0);
+      state.buffers.assign(num_values, -1);
+      return state;
+    };
+
+    OrderMemoryState default_state = new_state();
+    for (NodeIndex index : default_order) {
+      ExecuteInOrder(node_infos[index], value_sizes, use_counts, is_graph_output, default_state, true);
+    }
+
+    // Kahn's algorithm over the edges between the nodes of the graph, including the control edges
+    InlinedHashMap<NodeIndex, size_t> pending_inputs;
+    std::vector<NodeIndex> ready;
+    for (NodeIndex index : default_order) {
+      const Node& node = *graph_viewer_.GetNode(index);
+      size_t count = 0;
+      for (auto edge = node.InputEdgesBegin(), end = node.InputEdgesEnd(); edge != end; ++edge) {
+        count += positions.count(edge->GetNode().Index());
+      }
+      pending_inputs[index] = count;
+      if (count == 0) {
+        ready.push_back(index);
+      }
+    }
+
+    std::vector<NodeIndex> order;
+    order.reserve(default_order.size());
+    OrderMemoryState state = new_state();
+    while (!ready.empty()) {
+      auto best = ready.begin();
+      int64_t best_delta = std::numeric_limits<int64_t>::max();
+      for (auto it = ready.begin(); it != ready.end(); ++it) {
+        const auto [allocated, freed] =
+            ExecuteInOrder(node_infos[*it], value_sizes, use_counts, is_graph_output, state, false);
+        const int64_t delta = static_cast<int64_t>(allocated) - static_cast<int64_t>(freed);
+        if (delta < best_delta || (delta == best_delta && positions[*it] < positions[*best])) {
+          best = it;
+          best_delta = delta;
+        }
+      }
+
+      const NodeIndex index = *best;
+      ready.erase(best);
+      ExecuteInOrder(node_infos[index], value_sizes, use_counts, is_graph_output, state, true);
+      order.push_back(index);
+
+      const Node& node = *graph_viewer_.GetNode(index);
+      for (auto edge = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); edge != end; ++edge) {
+        auto pending = pending_inputs.find(edge->GetNode().Index());
+        if (pending != pending_inputs.end() && --pending->second == 0) {
+          ready.push_back(pending->first);
+        }
+      }
+    }
+
+    ORT_ENFORCE(order.size() == default_order.size(), "The memory efficient order misses nodes of graph ",
+                graph_viewer_.Name());
+
+    const bool use_order = state.peak_bytes < default_state.peak_bytes;
+    plan_.estimated_peak_activation_bytes = use_order ? state.peak_bytes : default_state.peak_bytes;
+    LOGS_DEFAULT(INFO) << "Memory efficient execution order of graph " << graph_viewer_.Name()
+                       << ": estimated peak memory of the activations " << plan_.estimated_peak_activation_bytes
+                       << " bytes, " << default_state.peak_bytes << " bytes in the default order.";
+
+    return use_order ? order : default_order;
+  }
+
   //For in-place reuse tensors, the lifetime is the union of all the tensors that tensors that use that buffer
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   void AdjustInplaceLifeIntervals() {
@@ -1287,21 +1951,33 @@ class PlannerImpl {
 };
 
 Status PlannerImpl::CreatePlan() {
-  auto& p_graph_nodes = graph_viewer_.GetNodesInTopologicalOrder(context_.GetExecutionOrder());
+  const ExecutionOrder execution_order = context_.GetExecutionOrder();
+  const bool is_memory_efficient = execution_order == ExecutionOrder::MEMORY_EFFICIENT;
+  const auto& topological_order =
+      graph_viewer_.GetNodesInTopologicalOrder(is_memory_efficient ? ExecutionOrder::DEFAULT : execution_order);
 
   int num_ml_values = ort_value_name_idx_map_.MaxIdx() + 1;
 
-  Initialize(p_graph_nodes.size(), static_cast<size_t>(num_ml_values));
+  Initialize(topological_order.size(), static_cast<size_t>(num_ml_values));
 
-  // Determine execution order: we use the default topological sort order for now. We can later
-  // explore more efficient orderings (from a memory usage perspective).
+  // Determine execution order: the topological order of the graph viewer, or the order keeping the memory of the
+  // activations low, which needs the kernel definitions to account for the outputs written in place.
+  const std::vector<NodeIndex> p_graph_nodes =
+      is_memory_efficient ? ComputeMemoryEfficientOrder(topological_order) : topological_order;
   for (auto n : p_graph_nodes) {
     plan_.execution_plan.emplace_back(n);
   }
 
+  // assign the nodes to the compute streams. This needs to be done before ComputeUseCounts, which marks the values
+  // used on the streams other than the default one to be fenced.
+  ComputeStreamAssignment();
+
   // compute use counts for all ml-values
   ORT_RETURN_IF_ERROR(ComputeUseCounts());
 
+  // determine the Concat inputs written in place by their producers. This needs to be done after ComputeUseCounts.
+  ComputeConcatSlices();
+
   // determine sharing/reuse among ml-values
   ORT_RETURN_IF_ERROR(ComputeReusePlan());
 
@@ -1325,6 +2001,16 @@ Status PlannerImpl::CreatePlan() {
   // are updated until GenerateDeallocationPlan is finished.
   VerifyMemoryTimeSchedule();
 
+  size_t num_allocated = 0;
+  size_t num_reused = 0;
+  for (const auto& value_plan : plan_.allocation_plan) {
+    num_allocated += value_plan.alloc_kind == AllocKind::kAllocate ? 1 : 0;
+    num_reused += value_plan.alloc_kind == AllocKind::kReuse ? 1 : 0;
+  }
+  LOGS_DEFAULT(VERBOSE) << "Allocation plan of graph " << graph_viewer_.Name() << ": " << num_allocated
+                        << " buffers allocated, " << num_reused << " values reusing a buffer, of which "
+                        << num_inferred_inplace_reuses_ << " written over an input by elementwise kernels.";
+
   return Status::OK();
 }
 
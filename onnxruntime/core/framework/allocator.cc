@@ -136,6 +136,13 @@ ORT_API_STATUS_IMPL(OrtApis::CreateMemoryInfo, _In_ const char* name1, enum OrtA
     *out = new OrtMemoryInfo(
         onnxruntime::DML, type, OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, static_cast<OrtDevice::DeviceId>(id1)),
         id1, mem_type1);
+  } else if (strcmp(name1, onnxruntime::NNAPI_MEMORY) == 0) {
+    // the platform buffers are bound to the NNAPI and CoreML EPs, which are CPU based, without copies
+    *out = new OrtMemoryInfo(onnxruntime::NNAPI_MEMORY, type, OrtDevice(), id1, mem_type1);
+  } else if (strcmp(name1, onnxruntime::NNAPI_HARDWARE_BUFFER) == 0) {
+    *out = new OrtMemoryInfo(onnxruntime::NNAPI_HARDWARE_BUFFER, type, OrtDevice(), id1, mem_type1);
+  } else if (strcmp(name1, onnxruntime::COREML_PIXEL_BUFFER) == 0) {
+    *out = new OrtMemoryInfo(onnxruntime::COREML_PIXEL_BUFFER, type, OrtDevice(), id1, mem_type1);
   } else {
     return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Specified device is not supported.");
   }
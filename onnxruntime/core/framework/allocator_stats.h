@@ -22,6 +22,12 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_thread_cache_hits;    // Number of allocations served by a thread-local cache (Relevant only for arena
+                                    // based allocators with thread-local caching enabled)
+  int64_t num_thread_cache_misses;  // Number of allocations that could not be served by a thread-local cache
+  int64_t num_idle_shrinkages;      // Number of times idle shrinking freed memory (Relevant only for arena based
+                                    // allocators with idle shrinking enabled)
+  int64_t total_idle_shrunk_bytes;  // Number of bytes freed by idle shrinking
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +41,10 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->num_thread_cache_misses = 0;
+    this->num_idle_shrinkages = 0;
+    this->total_idle_shrunk_bytes = 0;
   }
 
   std::string DebugString() const {
@@ -47,7 +57,11 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumThreadCacheHits:       " << this->num_thread_cache_hits << "\n"
+       << "NumThreadCacheMisses:     " << this->num_thread_cache_misses << "\n"
+       << "NumIdleShrinkages:        " << this->num_idle_shrinkages << "\n"
+       << "TotalIdleShrunkBytes:     " << this->total_idle_shrunk_bytes << "\n";
     return ss.str();
   }
 };
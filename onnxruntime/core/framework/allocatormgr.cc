@@ -33,6 +33,20 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
     int initial_growth_chunk_size_bytes = info.arena_cfg.initial_growth_chunk_size_bytes == -1
                                               ? BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES
                                               : info.arena_cfg.initial_growth_chunk_size_bytes;
+    int max_thread_local_cache_bytes = info.arena_cfg.max_thread_local_cache_bytes == -1
+                                           ? BFCArena::DEFAULT_MAX_THREAD_LOCAL_CACHE_BYTES
+                                           : info.arena_cfg.max_thread_local_cache_bytes;
+    int shrink_idle_time_ms = info.arena_cfg.shrink_idle_time_ms == -1
+                                  ? BFCArena::DEFAULT_SHRINK_IDLE_TIME_MS
+                                  : info.arena_cfg.shrink_idle_time_ms;
+    int shrink_watermark_percent = info.arena_cfg.shrink_watermark_percent == -1
+                                       ? BFCArena::DEFAULT_SHRINK_WATERMARK_PERCENT
+                                       : info.arena_cfg.shrink_watermark_percent;
+    if (shrink_idle_time_ms < 0 || shrink_watermark_percent < 100) {
+      LOGS_DEFAULT(ERROR) << "Received invalid value of shrink_idle_time_ms " << shrink_idle_time_ms
+                          << " or shrink_watermark_percent " << shrink_watermark_percent;
+      return nullptr;
+    }
     ArenaExtendStrategy arena_extend_str;
     switch (info.arena_cfg.arena_extend_strategy) {
       case static_cast<int>(ArenaExtendStrategy::kSameAsRequested):
@@ -53,7 +67,10 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                    arena_extend_str,
                                    initial_chunk_size_bytes,
                                    max_dead_bytes_per_chunk,
-                                   initial_growth_chunk_size_bytes));
+                                   initial_growth_chunk_size_bytes,
+                                   max_thread_local_cache_bytes,
+                                   shrink_idle_time_ms,
+                                   shrink_watermark_percent));
   } else {
     return device_allocator;
   }
@@ -3,15 +3,128 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
+#include <atomic>
+#include <tuple>
 #include <type_traits>
 
 namespace onnxruntime {
+
+// Chunks freed by a thread while thread-local caching is enabled. Only the owning thread reads or writes 'bins' and
+// 'cached_bytes'. The counters are written by the owning thread only, but read by GetStats() from any thread.
+struct BFCArena::ThreadCache {
+  struct CachedChunk {
+    void* ptr;
+    size_t size;
+  };
+
+  std::array<std::vector<CachedChunk>, kNumBins> bins;
+  size_t cached_bytes = 0;
+  std::atomic<int64_t> num_hits{0};
+  std::atomic<int64_t> num_misses{0};
+};
+
+// Maps the pointers handed out while thread-local caching is enabled to the size of their chunk.
+struct BFCArena::ChunkSizeStripe {
+  OrtMutex mutex;
+  std::unordered_map<const void*, size_t> chunk_sizes;
+};
+
+// Keeps track of the thread caches of the calling thread and of the arenas that are alive, so that the caches
+// of an exiting thread can be handed back to any arena that outlives it.
+class BFCArena::ThreadCacheRegistry {
+ public:
+  static int64_t NextArenaId() {
+    static std::atomic<int64_t> next_arena_id{0};
+    return next_arena_id++;
+  }
+
+  static void AddArena(BFCArena* arena) {
+    std::lock_guard<OrtMutex> lock(Mutex());
+    LiveArenas()[arena->arena_id_] = arena;
+  }
+
+  static void RemoveArena(const BFCArena* arena) {
+    std::lock_guard<OrtMutex> lock(Mutex());
+    LiveArenas().erase(arena->arena_id_);
+  }
+
+  static ThreadCache* Find(int64_t arena_id) {
+    PerThreadCaches& caches = Caches();
+    if (caches.last_arena_id == arena_id) {
+      return caches.last_cache;
+    }
+
+    auto entry = caches.by_arena.find(arena_id);
+    if (entry == caches.by_arena.end()) {
+      return nullptr;
+    }
+
+    caches.last_arena_id = arena_id;
+    caches.last_cache = entry->second;
+    return entry->second;
+  }
+
+  static void Add(int64_t arena_id, ThreadCache* cache) {
+    PerThreadCaches& caches = Caches();
+    {
+      // drop the entries of arenas that no longer exist
+      std::lock_guard<OrtMutex> lock(Mutex());
+      const auto& live_arenas = LiveArenas();
+      for (auto it = caches.by_arena.begin(); it != caches.by_arena.end();) {
+        it = live_arenas.count(it->first) == 0 ? caches.by_arena.erase(it) : std::next(it);
+      }
+    }
+
+    caches.by_arena[arena_id] = cache;
+    caches.last_arena_id = arena_id;
+    caches.last_cache = cache;
+  }
+
+ private:
+  struct PerThreadCaches {
+    ~PerThreadCaches() {
+      std::lock_guard<OrtMutex> lock(Mutex());
+      const auto& live_arenas = LiveArenas();
+      for (const auto& entry : by_arena) {
+        auto arena = live_arenas.find(entry.first);
+        if (arena != live_arenas.end()) {
+          arena->second->ReleaseThreadCache(entry.second);
+        }
+      }
+    }
+
+    std::unordered_map<int64_t, ThreadCache*> by_arena;
+    int64_t last_arena_id = -1;
+    ThreadCache* last_cache = nullptr;
+  };
+
+  static PerThreadCaches& Caches() {
+    thread_local PerThreadCaches caches;
+    return caches;
+  }
+
+  // Intentionally leaked so that they outlive the thread caches of the main thread at process exit.
+  static OrtMutex& Mutex() {
+    static OrtMutex* mutex = new OrtMutex();
+    return *mutex;
+  }
+
+  static std::unordered_map<int64_t, BFCArena*>& LiveArenas() {
+    static auto* live_arenas = new std::unordered_map<int64_t, BFCArena*>();
+    return *live_arenas;
+  }
+};
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
-                   int initial_growth_chunk_size_bytes)
+                   int initial_growth_chunk_size_bytes,
+                   int max_thread_local_cache_bytes,
+                   int shrink_idle_time_ms,
+                   int shrink_watermark_percent)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -22,11 +135,19 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       next_allocation_id_(1),
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
-      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes) {
+      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
+      max_thread_local_cache_bytes_(max_thread_local_cache_bytes),
+      shrink_idle_time_(std::max(shrink_idle_time_ms, 0)),
+      shrink_watermark_percent_(shrink_watermark_percent),
+      shrink_window_start_(std::chrono::steady_clock::now()),
+      arena_id_(ThreadCacheRegistry::NextArenaId()) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
+                     << " max_thread_local_cache_bytes: " << max_thread_local_cache_bytes_
+                     << " shrink_idle_time_ms: " << shrink_idle_time_.count()
+                     << " shrink_watermark_percent: " << shrink_watermark_percent_
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
@@ -39,6 +160,9 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
 
   arena_extend_strategy_ = arena_extend_strategy;
 
+  ORT_ENFORCE(shrink_watermark_percent_ >= 100, "shrink_watermark_percent must be at least 100. Got ",
+              shrink_watermark_percent_);
+
   // We never want to shrink the initial allocation if the arena extend strategy is kNextPowerOfTwo.
   // This could seem confusingly arbitrary but the rationale is as follows:
   // The user selected initial allocation chunk is only valid for the arena extend strategy kNextPowerOfTwo
@@ -71,9 +195,19 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       ORT_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+
+  if (ThreadCacheEnabled()) {
+    chunk_size_stripes_ = std::make_unique<ChunkSizeStripe[]>(kNumChunkSizeStripes);
+    ThreadCacheRegistry::AddArena(this);
+  }
 }
 
 BFCArena::~BFCArena() {
+  if (ThreadCacheEnabled()) {
+    // the chunks parked in thread caches belong to the regions freed below
+    ThreadCacheRegistry::RemoveArena(this);
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -255,6 +389,10 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (ThreadCacheEnabled()) {
+    return AllocateFromThreadCache(size);
+  }
+
   return AllocateRawInternal(size, false);
 }
 
@@ -274,6 +412,7 @@ void* BFCArena::Reserve(size_t size) {
   stats_.num_allocs += 1;
   stats_.max_alloc_size = std::max<size_t>(static_cast<size_t>(stats_.max_alloc_size), size);
   stats_.max_bytes_in_use = std::max<int64_t>(static_cast<int64_t>(stats_.max_bytes_in_use), stats_.bytes_in_use);
+  shrink_window_max_bytes_in_use_ = std::max(shrink_window_max_bytes_in_use_, stats_.bytes_in_use);
   stats_.total_allocated_bytes += size;
   return ptr;
 }
@@ -295,7 +434,8 @@ size_t BFCArena::AllocatedSize(const void* ptr) {
 }
 
 void* BFCArena::AllocateRawInternal(size_t num_bytes,
-                                    bool dump_log_on_failure) {
+                                    bool dump_log_on_failure,
+                                    size_t* chunk_size) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(VERBOSE) << "tried to allocate 0 bytes";
     return nullptr;
@@ -309,8 +449,13 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
   std::lock_guard<OrtMutex> lock(lock_);
+  MaybeShrinkIdleRegions();
+
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
   if (ptr != nullptr) {
+    if (chunk_size != nullptr) {
+      *chunk_size = ChunkFromHandle(region_manager_.get_handle(ptr))->size;
+    }
     return ptr;
   }
 
@@ -322,6 +467,9 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   if (status.IsOK()) {
     ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
     if (ptr != nullptr) {
+      if (chunk_size != nullptr) {
+        *chunk_size = ChunkFromHandle(region_manager_.get_handle(ptr))->size;
+      }
       return ptr;
     } else {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -345,6 +493,129 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+
+  stats->num_thread_cache_hits = released_thread_cache_hits_;
+  stats->num_thread_cache_misses = released_thread_cache_misses_;
+  for (const auto& cache : thread_caches_) {
+    stats->num_thread_cache_hits += cache->num_hits.load(std::memory_order_relaxed);
+    stats->num_thread_cache_misses += cache->num_misses.load(std::memory_order_relaxed);
+  }
+}
+
+BFCArena::ThreadCache* BFCArena::GetThreadCache(bool create) {
+  ThreadCache* cache = ThreadCacheRegistry::Find(arena_id_);
+  if (cache == nullptr && create) {
+    auto new_cache = std::make_unique<ThreadCache>();
+    cache = new_cache.get();
+    {
+      std::lock_guard<OrtMutex> lock(lock_);
+      thread_caches_.push_back(std::move(new_cache));
+    }
+
+    ThreadCacheRegistry::Add(arena_id_, cache);
+  }
+
+  return cache;
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t num_bytes) {
+  if (num_bytes == 0) {
+    return AllocateRawInternal(num_bytes, false);
+  }
+
+  size_t rounded_bytes = RoundedBytes(num_bytes);
+  ThreadCache& cache = *GetThreadCache(true);
+
+  // Most recently freed chunks come last and are the most likely to still be in the CPU cache.
+  // Apply the same limit on wasted bytes as FindChunkPtr does before it splits a chunk.
+  auto& cached_chunks = cache.bins[BinNumForSize(rounded_bytes)];
+  for (auto it = cached_chunks.rbegin(); it != cached_chunks.rend(); ++it) {
+    if (it->size >= rounded_bytes &&
+        static_cast<int64_t>(it->size) - static_cast<int64_t>(rounded_bytes) < max_dead_bytes_per_chunk_) {
+      ThreadCache::CachedChunk chunk = *it;
+      cached_chunks.erase(std::next(it).base());
+      cache.cached_bytes -= chunk.size;
+      cache.num_hits.store(cache.num_hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+      RecordChunkSize(chunk.ptr, chunk.size);
+      return chunk.ptr;
+    }
+  }
+
+  cache.num_misses.store(cache.num_misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  size_t chunk_size = 0;
+  void* ptr = AllocateRawInternal(num_bytes, false, &chunk_size);
+  RecordChunkSize(ptr, chunk_size);
+  return ptr;
+}
+
+void BFCArena::FreeToThreadCache(void* p, size_t chunk_size) {
+  if (chunk_size > static_cast<size_t>(max_thread_local_cache_bytes_)) {
+    std::lock_guard<OrtMutex> lock(lock_);
+    DeallocateRawInternal(p);
+    return;
+  }
+
+  ThreadCache& cache = *GetThreadCache(true);
+  cache.bins[BinNumForSize(chunk_size)].push_back({p, chunk_size});
+  cache.cached_bytes += chunk_size;
+
+  if (cache.cached_bytes > static_cast<size_t>(max_thread_local_cache_bytes_)) {
+    FlushThreadCache(cache, static_cast<size_t>(max_thread_local_cache_bytes_) / 2);
+  }
+}
+
+void BFCArena::FlushThreadCache(ThreadCache& cache, size_t target_bytes) {
+  std::lock_guard<OrtMutex> lock(lock_);
+
+  // Start with the largest bins as they free up the most bytes per chunk.
+  for (BinNum b = kNumBins - 1; b >= 0 && cache.cached_bytes > target_bytes; b--) {
+    auto& cached_chunks = cache.bins[b];
+    auto end = cached_chunks.begin();
+    while (end != cached_chunks.end() && cache.cached_bytes > target_bytes) {
+      DeallocateRawInternal(end->ptr);
+      cache.cached_bytes -= end->size;
+      ++end;
+    }
+
+    cached_chunks.erase(cached_chunks.begin(), end);
+  }
+}
+
+void BFCArena::ReleaseThreadCache(ThreadCache* cache) {
+  FlushThreadCache(*cache, 0);
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  released_thread_cache_hits_ += cache->num_hits.load(std::memory_order_relaxed);
+  released_thread_cache_misses_ += cache->num_misses.load(std::memory_order_relaxed);
+  thread_caches_.erase(std::remove_if(thread_caches_.begin(), thread_caches_.end(),
+                                      [cache](const std::unique_ptr<ThreadCache>& c) { return c.get() == cache; }),
+                       thread_caches_.end());
+}
+
+BFCArena::ChunkSizeStripe& BFCArena::ChunkSizeStripeFor(const void* p) {
+  auto index = (reinterpret_cast<std::uintptr_t>(p) >> kMinAllocationBits) % kNumChunkSizeStripes;
+  return chunk_size_stripes_[index];
+}
+
+void BFCArena::RecordChunkSize(void* p, size_t chunk_size) {
+  ChunkSizeStripe& stripe = ChunkSizeStripeFor(p);
+  std::lock_guard<OrtMutex> lock(stripe.mutex);
+  stripe.chunk_sizes[p] = chunk_size;
+}
+
+bool BFCArena::TakeChunkSize(void* p, size_t& chunk_size) {
+  ChunkSizeStripe& stripe = ChunkSizeStripeFor(p);
+  std::lock_guard<OrtMutex> lock(stripe.mutex);
+  auto entry = stripe.chunk_sizes.find(p);
+  if (entry == stripe.chunk_sizes.end()) {
+    return false;
+  }
+
+  chunk_size = entry->second;
+  stripe.chunk_sizes.erase(entry);
+  return true;
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -384,6 +655,7 @@ void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
         stats_.bytes_in_use += chunk->size;
         stats_.max_bytes_in_use =
             std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+        shrink_window_max_bytes_in_use_ = std::max(shrink_window_max_bytes_in_use_, stats_.bytes_in_use);
         stats_.max_alloc_size =
             std::max<int64_t>(stats_.max_alloc_size, static_cast<int64_t>(chunk->size));
         return chunk->ptr;
@@ -432,6 +704,16 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  if (ThreadCacheEnabled()) {
+    // reserved chunks are not tracked and take the regular path
+    size_t chunk_size = 0;
+    if (TakeChunkSize(p, chunk_size)) {
+      FreeToThreadCache(p, chunk_size);
+      return;
+    }
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -442,25 +724,55 @@ void BFCArena::Free(void* p) {
   } else {
     DeallocateRawInternal(p);
   }
+
+  MaybeShrinkIdleRegions();
 }
 
 Status BFCArena::Shrink() {
+  if (ThreadCacheEnabled()) {
+    ThreadCache* cache = GetThreadCache(false);
+    if (cache != nullptr) {
+      FlushThreadCache(*cache, 0);
+    }
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  FreeUnusedRegions(0);
+
+  // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
+  // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
+  curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+
+  return Status::OK();
+}
+
+void BFCArena::Freeze() {
   std::lock_guard<OrtMutex> lock(lock_);
-  auto num_regions = region_manager_.regions().size();
-  std::vector<void*> region_ptrs;
-  std::vector<size_t> region_sizes;
-  region_ptrs.reserve(num_regions);
-  region_sizes.reserve(num_regions);
+  memory_limit_ = static_cast<size_t>(stats_.total_allocated_bytes);
+  stats_.bytes_limit = stats_.total_allocated_bytes;
+}
 
+size_t BFCArena::FreeUnusedRegions(size_t target_total_allocated_bytes) {
+  // (id, ptr, size) of the regions to consider. regions() is sorted by address.
+  std::vector<std::tuple<int64_t, void*, size_t>> candidate_regions;
+  candidate_regions.reserve(region_manager_.regions().size());
   for (const auto& region : region_manager_.regions()) {
     if (consider_first_allocation_region_for_shrinkage_ || region.id() != 0) {
-      region_ptrs.push_back(region.ptr());
-      region_sizes.push_back(region.memory_size());
+      candidate_regions.emplace_back(region.id(), region.ptr(), region.memory_size());
     }
   }
 
-  size_t i = 0;
-  for (void* region_ptr : region_ptrs) {
+  // newest first, as these were added to serve the peak
+  std::sort(candidate_regions.begin(), candidate_regions.end(),
+            [](const auto& a, const auto& b) { return std::get<0>(a) > std::get<0>(b); });
+
+  size_t freed_bytes = 0;
+  for (const auto& candidate_region : candidate_regions) {
+    void* region_ptr = std::get<1>(candidate_region);
+    if (static_cast<size_t>(stats_.total_allocated_bytes) <= target_total_allocated_bytes) {
+      break;
+    }
+
     bool deallocate_region = true;
     ChunkHandle region_begin_chunk = region_manager_.get_handle(region_ptr);
     ChunkHandle h = region_begin_chunk;
@@ -476,9 +788,10 @@ Status BFCArena::Shrink() {
     }
 
     if (deallocate_region) {
-      auto shrink_size = region_sizes[i];
+      auto shrink_size = std::get<2>(candidate_region);
       stats_.num_arena_shrinkages += 1;
       stats_.total_allocated_bytes -= shrink_size;
+      freed_bytes += shrink_size;
 
       LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
                             << shrink_size << " bytes. "
@@ -497,15 +810,41 @@ Status BFCArena::Shrink() {
       device_allocator_->Free(region_ptr);
       region_manager_.RemoveAllocationRegion(region_ptr);
     }
+  }
 
-    ++i;
+  return freed_bytes;
+}
+
+void BFCArena::MaybeShrinkIdleRegions() {
+  if (shrink_idle_time_.count() == 0) {
+    return;
   }
 
-  // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
-  // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
-  curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+  const auto now = std::chrono::steady_clock::now();
+  if (now - shrink_window_start_ < shrink_idle_time_) {
+    return;
+  }
 
-  return Status::OK();
+  const int64_t window_max_bytes_in_use = std::max(shrink_window_max_bytes_in_use_, stats_.bytes_in_use);
+  shrink_window_start_ = now;
+  shrink_window_max_bytes_in_use_ = stats_.bytes_in_use;
+
+  const size_t target_bytes = SafeInt<size_t>(window_max_bytes_in_use) * shrink_watermark_percent_ / 100;
+  if (static_cast<size_t>(stats_.total_allocated_bytes) <= target_bytes) {
+    return;
+  }
+
+  const size_t freed_bytes = FreeUnusedRegions(target_bytes);
+  if (freed_bytes > 0) {
+    stats_.num_idle_shrinkages += 1;
+    stats_.total_idle_shrunk_bytes += static_cast<int64_t>(freed_bytes);
+    curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+
+    LOGS_DEFAULT(INFO) << device_allocator_->Info().name << " BFC Arena released " << freed_bytes
+                       << " bytes after being idle. High-water mark of the last " << shrink_idle_time_.count()
+                       << "ms: " << window_max_bytes_in_use
+                       << " bytes. Total allocated bytes: " << stats_.total_allocated_bytes;
+  }
 }
 
 void BFCArena::DeallocateRawInternal(void* ptr) {
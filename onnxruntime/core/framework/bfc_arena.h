@@ -16,6 +16,7 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -57,13 +58,26 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
-
+  static const int DEFAULT_MAX_THREAD_LOCAL_CACHE_BYTES = 0;  // thread-local caching is disabled by default
+  static const int DEFAULT_SHRINK_IDLE_TIME_MS = 0;           // idle shrinking is disabled by default
+  static const int DEFAULT_SHRINK_WATERMARK_PERCENT = 100;
+
+  // Idle shrinking:
+  // When shrink_idle_time_ms > 0 the arena tracks the high-water mark of the bytes in use in consecutive windows of
+  // shrink_idle_time_ms. Once a window has passed, allocation regions in which no chunk is in use are freed until the
+  // total allocated bytes fall to shrink_watermark_percent of the high-water mark of that window, so memory taken
+  // during a burst is returned once the load drops. The same regions as in Shrink() are considered.
+  // The policy is evaluated on Alloc and Free, so an arena that is not used at all keeps its memory until it is
+  // used again.
   BFCArena(std::unique_ptr<IAllocator> resource_allocator,
            size_t total_memory,
            ArenaExtendStrategy arena_extend_strategy = DEFAULT_ARENA_EXTEND_STRATEGY,
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
-           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES);
+           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+           int max_thread_local_cache_bytes = DEFAULT_MAX_THREAD_LOCAL_CACHE_BYTES,
+           int shrink_idle_time_ms = DEFAULT_SHRINK_IDLE_TIME_MS,
+           int shrink_watermark_percent = DEFAULT_SHRINK_WATERMARK_PERCENT);
 
   ~BFCArena() override;
 
@@ -77,12 +91,19 @@ class BFCArena : public IAllocator {
 
   // Frees all allocation regions in which no chunk is in use.
   // Does not free any reserved chunks.
+  // Chunks parked in the thread-local cache of the calling thread are returned to the arena first.
+  // Chunks parked in the caches of other threads are considered in use.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
   // future allocation sizes are determined by the arena growth strategy
   // and the allocation request.
   Status Shrink();
 
+  // Limits the arena to the memory it has allocated so far, e.g. once the representative inputs of a session have
+  // been run: the allocations that don't fit in the existing regions fail instead of extending it.
+  // Regions freed by shrinking can be allocated again up to the same total.
+  void Freeze();
+
   void* Reserve(size_t size) override;
 
   FencePtr CreateFence(const SessionState* session_state) override {
@@ -97,9 +118,42 @@ class BFCArena : public IAllocator {
   size_t AllocatedSize(const void* ptr);
 
  private:
-  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
+  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure, size_t* chunk_size = nullptr);
   void DeallocateRawInternal(void* ptr);
 
+  // Frees the allocation regions in which no chunk is in use, newest first, until the total allocated bytes are at
+  // most target_total_allocated_bytes. Returns the number of bytes freed. Requires lock_.
+  size_t FreeUnusedRegions(size_t target_total_allocated_bytes);
+  // Starts a new idle shrinking window and shrinks the arena if the current one has passed. Requires lock_.
+  void MaybeShrinkIdleRegions();
+
+  // Thread-local front-end cache.
+  //
+  // When max_thread_local_cache_bytes_ > 0 every thread that uses the arena gets a private cache of recently freed
+  // chunks, grouped by bin. Alloc is first served from the cache of the calling thread without taking lock_, and Free
+  // parks the chunk in the cache of the calling thread. Chunks in a cache are still in use from the point of view of
+  // the shared bins, so they are never coalesced. Once a cache holds more than max_thread_local_cache_bytes_ it
+  // returns its oldest chunks to the shared bins in a single batch.
+  //
+  // As Free only receives a pointer, the size of each chunk handed out while caching is enabled is tracked in a
+  // striped map so that the common path never touches lock_.
+  struct ThreadCache;
+  struct ChunkSizeStripe;
+  class ThreadCacheRegistry;
+  static const size_t kNumChunkSizeStripes = 64;
+
+  bool ThreadCacheEnabled() const { return max_thread_local_cache_bytes_ > 0; }
+  ThreadCache* GetThreadCache(bool create);
+  void* AllocateFromThreadCache(size_t num_bytes);
+  void FreeToThreadCache(void* p, size_t chunk_size);
+  // Returns the oldest chunks of 'cache' to the shared bins until at most 'target_bytes' remain cached.
+  void FlushThreadCache(ThreadCache& cache, size_t target_bytes);
+  // Returns all the chunks of 'cache' to the shared bins and drops it. Called when the owning thread exits.
+  void ReleaseThreadCache(ThreadCache* cache);
+  ChunkSizeStripe& ChunkSizeStripeFor(const void* p);
+  void RecordChunkSize(void* p, size_t chunk_size);
+  bool TakeChunkSize(void* p, size_t& chunk_size);
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -468,6 +522,25 @@ class BFCArena : public IAllocator {
   const int initial_chunk_size_bytes_;
   const int max_dead_bytes_per_chunk_;
   const int initial_growth_chunk_size_bytes_;
+  const int max_thread_local_cache_bytes_;
+
+  // Idle shrinking. The window state is guarded by lock_.
+  const std::chrono::milliseconds shrink_idle_time_;
+  const int shrink_watermark_percent_;
+  std::chrono::steady_clock::time_point shrink_window_start_;
+  int64_t shrink_window_max_bytes_in_use_ = 0;
+
+  // Unique among all arenas created by the process. Used to key the per-thread caches so that an arena created
+  // at the address of a destroyed one never sees the caches of its predecessor.
+  const int64_t arena_id_;
+
+  // Caches of all the threads that have used this arena. Guarded by lock_.
+  std::vector<std::unique_ptr<ThreadCache>> thread_caches_;
+  // Cache hits and misses of the thread caches that have already been released. Guarded by lock_.
+  int64_t released_thread_cache_hits_ = 0;
+  int64_t released_thread_cache_misses_ = 0;
+
+  std::unique_ptr<ChunkSizeStripe[]> chunk_size_stripes_;
 
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
@@ -38,6 +38,19 @@ IExecutionFrame::IExecutionFrame(const OrtValueNameIdxMap& ort_value_idx_map,
 
 IExecutionFrame::~IExecutionFrame() = default;
 
+void IExecutionFrame::SetAllValuesStorage(std::vector<OrtValue>&& values) {
+  ORT_ENFORCE(all_values_.empty(), "SetAllValuesStorage must be called before Init");
+  all_values_ = std::move(values);
+}
+
+std::vector<OrtValue> IExecutionFrame::ReleaseAllValues() {
+  for (auto& value : all_values_) {
+    value = OrtValue();
+  }
+
+  return std::move(all_values_);
+}
+
 #ifdef ENABLE_TRAINING
 Status IExecutionFrame::SetOutputMLValue(int index, const OrtValue& ort_value) {
   int ort_value_idx = GetNodeIdxToMLValueIdx(index);
@@ -334,6 +347,13 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
       session_state_(session_state),
       mem_patterns_(nullptr),
       planner_(nullptr) {
+  if (!session_state.MemoryTimelineFilePrefix().empty()) {
+    memory_timeline_ = std::make_unique<MemoryTimeline>();
+  }
+
+  // reuse the storage of the values of a previous run's frame
+  SetAllValuesStorage(session_state.TakeExecutionFrameValues());
+
   Init(
       feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -389,12 +409,20 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
       } else {
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
+        const bool reuse_buffers = session_state.GetMemoryPatternCacheOptions().reuse_buffers;
         for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
           const auto& location = mem_patterns_->locations[i];
           ORT_ENFORCE(buffers_.find(location) == buffers_.end());
           if (mem_patterns_->patterns[i].PeakSize() > 0) {
             AllocatorPtr alloc = GetAllocator(location);
             void* buffer = nullptr;
+            size_t buffer_size = 0;
+            // with fixed input shapes, the buffer returned by the previous run is reused so that the run doesn't
+            // call the allocator for the activations.
+            BufferUniquePtr reused_buffer = reuse_buffers
+                                                ? session_state.TakeMemoryPatternBuffer(
+                                                      location, mem_patterns_->patterns[i].PeakSize(), buffer_size)
+                                                : nullptr;
             // it's possible we can't allocate the large block. if we have memory patterns we know we have successfully
             // executed once before, so if there's an arena involved it probably has smaller blocks available.
             // due to that we can still run and use those blocks (inside the arena logic) instead of one large one.
@@ -414,7 +442,13 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
               // Memory dynamically allocated when executing kernels is not recorded using this field.
               static_activation_memory_sizes_in_byte_[location.name] = peak_size;
 #endif
-              buffer = alloc->Alloc(peak_size);
+              if (reused_buffer) {
+                buffer = reused_buffer.release();
+              } else {
+                buffer = alloc->Alloc(peak_size);
+                buffer_size = peak_size;
+                ++num_allocations_;
+              }
               // handle allocator that doesn't throw
               if (buffer == nullptr) {
                 // INFO level as this may fire on every run and there may not be much a user can do
@@ -431,6 +465,12 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
 
             if (buffer != nullptr) {
               buffers_[location] = BufferUniquePtr(buffer, alloc);
+              if (memory_timeline_) {
+                memory_timeline_->RecordPatternBuffer(location.name, mem_patterns_->patterns[i].PeakSize());
+              }
+              if (reuse_buffers) {
+                reused_buffer_sizes_[location] = buffer_size;
+              }
             }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
             //Record activation memory pattern
@@ -450,7 +490,18 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
   }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+ExecutionFrame::~ExecutionFrame() {
+  // release the values before handing their storage and the memory pattern buffers back to the session state
+  // for the next run.
+  session_state_.ReturnExecutionFrameValues(ReleaseAllValues());
+
+  for (const auto& entry : reused_buffer_sizes_) {
+    auto it = buffers_.find(entry.first);
+    if (it != buffers_.end()) {
+      session_state_.ReturnMemoryPatternBuffer(entry.first, std::move(it->second), entry.second);
+    }
+  }
+}
 
 Status ExecutionFrame::CopyTensor(const Tensor& src, Tensor& dest) const {
   return session_state_.GetDataTransferMgr().CopyTensor(src, dest);
@@ -513,12 +564,19 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // if the block is not correct, log message then fall back to default behavior.
+          // with shape bucketing the pattern was planned for another shape in the same bucket, so any block that
+          // is large enough can be used.
+          const bool bucketed = session_state_.GetMemoryPatternCacheOptions().shape_bucket_size > 0;
+          if (block->size_ == size || (bucketed && block->size_ >= size)) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
                 shape);
+            if (memory_timeline_ && status.IsOK()) {
+              memory_timeline_->RecordAllocation(ort_value_index, location.name, size,
+                                                 static_cast<int64_t>(block->offset_));
+            }
             return status;
           } else {
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
@@ -539,6 +597,7 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   //no memory pattern, or the pattern is not correct.
   if (!alloc) alloc = GetAllocator(location);
   Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
+  ++num_allocations_;
 
   // trace the memory allocation.
   // don't trace the memory allocation on string tensors, as it need
@@ -547,6 +606,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
     TraceAllocate(ort_value_index, size);
   }
 
+  if (memory_timeline_) {
+    memory_timeline_->RecordAllocation(ort_value_index, location.name, size, -1);
+  }
+
   {
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // This code block is not thread-safe.
@@ -563,7 +626,8 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
 
 Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_value, int ort_value_index_reuse,
                                                               MLDataType element_type, const OrtMemoryInfo& location,
-                                                              const TensorShape& shape, bool create_fence) {
+                                                              const TensorShape& shape, bool create_fence,
+                                                              bool is_strided_tensor) {
   OrtValue& ort_value_reuse = GetMutableMLValue(ort_value_index_reuse);
 
   auto* reuse_tensor = ort_value_reuse.GetMutable<Tensor>();
@@ -571,7 +635,7 @@ Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_valu
   auto required_num_elements = shape.Size();
 
   // check number of elements matches. shape may not be an exact match (e.g. Reshape op)
-  if (buffer_num_elements != required_num_elements) {
+  if (!is_strided_tensor && buffer_num_elements != required_num_elements) {
     // could be an allocation planner bug (less likely) or the model incorrectly uses something like 'None'
     // as a dim_param, or -1 in dim_value in multiple places making the planner think those shapes are equal.
     auto message = onnxruntime::MakeString(
@@ -614,6 +678,27 @@ Status ExecutionFrame::AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_v
   return Status::OK();
 }
 
+Status ExecutionFrame::AllocateMLValueTensorSliceOfBuffer(OrtValue& ort_value, int ort_value_index_buffer,
+                                                          size_t offset, MLDataType element_type,
+                                                          const OrtMemoryInfo& location, const TensorShape& shape,
+                                                          bool is_strided_tensor) {
+  OrtValue& ort_value_buffer = GetMutableMLValue(ort_value_index_buffer);
+  auto* buffer_tensor = ort_value_buffer.GetMutable<Tensor>();
+
+  size_t size = 0;
+  if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(shape.Size()), element_type->Size(), &size) ||
+      offset > buffer_tensor->SizeInBytes() || (!is_strided_tensor && offset + size > buffer_tensor->SizeInBytes())) {
+    // the static shapes the slice was planned with do not match the shapes at run time
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Slice of ", size, " bytes at offset ", offset,
+                           " does not fit in the buffer of shape ", buffer_tensor->Shape(),
+                           ". Validate the shapes in the model.");
+  }
+
+  ort_value.ShareFenceWith(ort_value_buffer);
+  return AllocateTensorWithPreAllocateBufferHelper(
+      ort_value, static_cast<char*>(buffer_tensor->MutableDataRaw()) + offset, element_type, location, shape);
+}
+
 static Status AllocateTraditionalMLValue(OrtValue& ort_value, const NonTensorTypeBase& type) {
   auto creator = type.GetCreateFunc();
   ort_value.Init(creator(), &type, type.GetDeleteFunc());
@@ -701,6 +786,12 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
 #endif
 
     AllocKind alloc_kind = per_alloc_plan.alloc_kind;
+#ifdef ENABLE_STRIDED_TENSORS
+    // the kernel sets the strides of the view after it is allocated
+    const bool is_strided_tensor = per_alloc_plan.is_strided_tensor;
+#else
+    const bool is_strided_tensor = false;
+#endif
     switch (alloc_kind) {
       // Right now for kAllocate and kAllocateOutput we are using same approach.
       // In the future we may want to have different way to handle it.
@@ -716,7 +807,20 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
         ORT_RETURN_IF_ERROR(AllocateReusedOrtValueIfNotAllocatedHelper(reuse_mlvalue_index, shape));
 
         ORT_RETURN_IF_ERROR(AllocateMLValueTensorPreAllocateBuffer(
-            ort_value, reuse_mlvalue_index, ml_data_type, alloc_info, *shape, per_alloc_plan.create_fence_if_async));
+            ort_value, reuse_mlvalue_index, ml_data_type, alloc_info, *shape, per_alloc_plan.create_fence_if_async,
+            is_strided_tensor));
+        break;
+      }
+      case AllocKind::kSlice: {
+        int reuse_mlvalue_index = per_alloc_plan.reused_buffer;
+
+        // the inputs of a Concat written in place are allocated before the Concat output they are slices of
+        const TensorShape buffer_shape(gsl::make_span(per_alloc_plan.reused_buffer_shape));
+        ORT_RETURN_IF_ERROR(AllocateReusedOrtValueIfNotAllocatedHelper(reuse_mlvalue_index, &buffer_shape));
+
+        ORT_RETURN_IF_ERROR(AllocateMLValueTensorSliceOfBuffer(ort_value, reuse_mlvalue_index,
+                                                               per_alloc_plan.slice_offset, ml_data_type, alloc_info,
+                                                               *shape, is_strided_tensor));
         break;
       }
       case AllocKind::kShare: {
@@ -812,6 +916,9 @@ void ExecutionFrame::VerifyOutputSizes(int output_index, const Node& node, const
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
+  if (memory_timeline_) {
+    memory_timeline_->RecordFree(ort_value_idx);
+  }
   return Status::OK();
 }
 
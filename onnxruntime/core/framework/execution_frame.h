@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 #include <unordered_map>
@@ -11,6 +12,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/status.h"
 #include "core/framework/iexecutor.h"
+#include "core/framework/memory_timeline.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/sequential_execution_plan.h"
@@ -39,6 +41,13 @@ class IExecutionFrame {
             const std::function<bool(const std::string& name)>& is_initializer_sparse_func,
             const std::vector<OrtValue>& fetches);
 
+  // Use the storage of `values`, e.g. released by a previous frame with ReleaseAllValues, for the values of the frame.
+  // Must be called before Init.
+  void SetAllValuesStorage(std::vector<OrtValue>&& values);
+
+  // Release the values of the frame and return their storage. The frame must not be used afterwards.
+  std::vector<OrtValue> ReleaseAllValues();
+
  public:
   virtual ~IExecutionFrame();
 
@@ -143,9 +152,10 @@ class ExecutionFrame final : public IExecutionFrame {
                                             const OrtMemoryInfo& location, const TensorShape& shape,
                                             bool create_fence = false);
 
+  // A strided tensor is a view of the buffer, so its number of elements is not checked against the buffer.
   Status AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_value, int ort_value_index_reuse, MLDataType element_type,
                                                 const OrtMemoryInfo& location, const TensorShape& shape,
-                                                bool create_fence = false);
+                                                bool create_fence = false, bool is_strided_tensor = false);
 
   // thread-safe
   Status GeneratePatterns(MemoryPatternGroup* out) const;
@@ -154,6 +164,13 @@ class ExecutionFrame final : public IExecutionFrame {
     return planner_ != nullptr;
   }
 
+  // Number of allocator calls made by the frame for the OrtValues it allocated, including the memory pattern buffers.
+  // Allocations made by the kernels themselves (e.g. scratch buffers) are not included.
+  size_t GetNumAllocations() const noexcept { return num_allocations_; }
+
+  // The allocation timeline of the run, or nullptr if it is not recorded.
+  const MemoryTimeline* GetMemoryTimeline() const noexcept { return memory_timeline_.get(); }
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrival is sucessful, this function returns true and false otherwise.
   bool TryGetInferredShape(int index, TensorShape& shape) const override;
@@ -201,6 +218,10 @@ class ExecutionFrame final : public IExecutionFrame {
   Status AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_value, void* pBuffer, MLDataType element_type,
                                                    const OrtMemoryInfo& location, const TensorShape& shape);
 
+  Status AllocateMLValueTensorSliceOfBuffer(OrtValue& ort_value, int ort_value_index_buffer, size_t offset,
+                                            MLDataType element_type, const OrtMemoryInfo& location,
+                                            const TensorShape& shape, bool is_strided_tensor = false);
+
   void TraceAllocate(int ort_value_idx, size_t size);
   void TraceFree(int ort_value_idx);
 
@@ -214,7 +235,8 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  // Shared with the session state cache so the pattern outlives a concurrent eviction.
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -223,6 +245,15 @@ class ExecutionFrame final : public IExecutionFrame {
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtMemoryInfo, BufferUniquePtr> buffers_;
 
+  // Size of the buffers_ to hand back to the session state when the frame is destroyed,
+  // if MemoryPatternCacheOptions::reuse_buffers is set.
+  std::map<OrtMemoryInfo, size_t> reused_buffer_sizes_;
+
+  std::atomic<size_t> num_allocations_{0};
+
+  // allocation timeline of the run, if session.memory_timeline_file_prefix is set
+  std::unique_ptr<MemoryTimeline> memory_timeline_;
+
   // Given the input shapes of the executed graph, ExecutionFrame tries inferring
   // all symbolic shapes. inferred_shapes_[i] is the shape of OrtValue indexed
   // by i, if the key i exists.
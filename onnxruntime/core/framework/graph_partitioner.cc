@@ -12,6 +12,13 @@
 #include "core/framework/execution_providers.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/func_kernel.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/framework/utils.h"
+#include "core/graph/graph_utils.h"
+
+#include <map>
+#include <numeric>
+#include <unordered_set>
 
 // uncomment this line to count non-CUDA ops in ONNX domain
 //#define COUNT_NON_CUDA_OPS
@@ -256,6 +263,246 @@ static Node* PlaceNode(Graph& graph, const IndexedSubGraph& capability,
   return result;
 }
 
+// Gets the size of a tensor value with a static shape. Returns false for other values and string tensors.
+static bool GetStaticTensorSize(const NodeArg& node_arg, int64_t& num_elements, size_t& num_bytes) {
+  const auto* type = node_arg.TypeAsProto();
+  const auto* shape = node_arg.Shape();
+  if (type == nullptr || shape == nullptr || !utils::HasTensorType(*type) ||
+      type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return false;
+  }
+
+  const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type());
+  if (tensor_type == nullptr) {
+    return false;
+  }
+
+  num_elements = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return false;
+    }
+    num_elements *= dim.dim_value();
+  }
+
+  num_bytes = static_cast<size_t>(num_elements) * tensor_type->GetElementType()->Size();
+  return true;
+}
+
+// Estimates the work of a node, in multiply-adds for the ops dominated by them and in the number of elements of its
+// inputs and outputs for the others. Returns false if the shapes of its values are not static.
+static bool EstimateNodeOps(const Node& node, double& ops) {
+  const auto& inputs = node.InputDefs();
+  const auto& outputs = node.OutputDefs();
+  std::vector<int64_t> input_elements(inputs.size(), 0);
+  int64_t output_elements = 0;
+  size_t num_bytes = 0;
+  ops = 0.0;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i]->Exists() && !GetStaticTensorSize(*inputs[i], input_elements[i], num_bytes)) {
+      return false;
+    }
+    ops += static_cast<double>(input_elements[i]);
+  }
+
+  for (const auto* output : outputs) {
+    int64_t num_elements = 0;
+    if (output->Exists() && !GetStaticTensorSize(*output, num_elements, num_bytes)) {
+      return false;
+    }
+    output_elements += num_elements;
+  }
+  ops += static_cast<double>(output_elements);
+
+  const auto& op_type = node.OpType();
+  if (node.Domain() != kOnnxDomain || inputs.size() < 2 || outputs.empty()) {
+    return true;
+  }
+
+  // inner dimension of the multiply-adds of each output element
+  const auto& a_shape = *inputs[0]->Shape();
+  const auto& b_shape = *inputs[1]->Shape();
+  int64_t inner_size = 0;
+  if (op_type == "MatMul" && a_shape.dim_size() > 0) {
+    inner_size = a_shape.dim(a_shape.dim_size() - 1).dim_value();
+  } else if (op_type == "Gemm" && a_shape.dim_size() == 2) {
+    const auto* trans_a = graph_utils::GetNodeAttribute(node, "transA");
+    inner_size = a_shape.dim(trans_a != nullptr && trans_a->i() != 0 ? 0 : 1).dim_value();
+  } else if (op_type == "Conv" || op_type == "ConvTranspose") {
+    inner_size = 1;
+    for (int i = 1; i < b_shape.dim_size(); ++i) {
+      inner_size *= b_shape.dim(i).dim_value();
+    }
+  }
+
+  // each input element of ConvTranspose is multiplied with the weights of a channel
+  const int64_t macs_elements = op_type == "ConvTranspose" ? input_elements[0] : output_elements;
+  ops = std::max(ops, static_cast<double>(macs_elements) * static_cast<double>(inner_size));
+  return true;
+}
+
+// Estimates the kernel time of a node in microseconds with and without the device.
+static bool EstimateKernelTimes(const Node& node, const std::string& provider_type,
+                                const PartitioningCostModel& cost_model, double& device_time, double& cpu_time) {
+  auto device_times = cost_model.kernel_time_us.find(provider_type);
+  auto cpu_times = cost_model.kernel_time_us.find(kCpuExecutionProvider);
+  if (device_times != cost_model.kernel_time_us.end() && cpu_times != cost_model.kernel_time_us.end()) {
+    auto device_entry = device_times->second.find(node.OpType());
+    auto cpu_entry = cpu_times->second.find(node.OpType());
+    if (device_entry != device_times->second.end() && cpu_entry != cpu_times->second.end()) {
+      device_time = device_entry->second;
+      cpu_time = cpu_entry->second;
+      return true;
+    }
+  }
+
+  double ops = 0.0;
+  if (!EstimateNodeOps(node, ops)) {
+    return false;
+  }
+
+  device_time = cost_model.device_kernel_overhead_us + ops / cost_model.device_ops_per_us;
+  cpu_time = ops / cost_model.cpu_ops_per_us;
+  return true;
+}
+
+/**
+ * Drops the capabilities of an execution provider that is not CPU based where running their nodes on the CPU is
+ * estimated to be faster, as the copies of the values crossing between the devices outweigh the faster kernels.
+ * The capabilities are grouped into islands of connected nodes, and an island is kept or dropped as a whole.
+ * The nodes the provider does not take are assumed to run on the CPU. Islands whose costs cannot be estimated,
+ * e.g. due to symbolic dimensions, that contain control flow nodes, or that have nodes without a CPU kernel keep
+ * their greedy assignment.
+ */
+static void DropCapabilitiesByCost(const Graph& graph, const KernelRegistryManager& kernel_registry_mgr,
+                                   const std::string& provider_type, const PartitioningCostModel& cost_model,
+                                   std::vector<std::unique_ptr<ComputeCapability>>& capabilities) {
+  // the index of the capability of each node the provider can take
+  std::unordered_map<NodeIndex, size_t> node_to_capability;
+  for (size_t i = 0; i < capabilities.size(); ++i) {
+    if (!capabilities[i] || !capabilities[i]->sub_graph) {
+      continue;
+    }
+
+    const auto& nodes = capabilities[i]->sub_graph->nodes;
+    const bool is_available = std::all_of(nodes.begin(), nodes.end(), [&](NodeIndex node_index) {
+      const auto* node = graph.GetNode(node_index);
+      return node != nullptr && node->GetExecutionProviderType().empty() && node_to_capability.count(node_index) == 0;
+    });
+    if (is_available) {
+      for (auto node_index : nodes) {
+        node_to_capability[node_index] = i;
+      }
+    }
+  }
+
+  // union-find of the capabilities connected by an edge
+  std::vector<size_t> island_of(capabilities.size());
+  std::iota(island_of.begin(), island_of.end(), size_t{0});
+  auto find_island = [&island_of](size_t i) {
+    while (island_of[i] != i) {
+      island_of[i] = island_of[island_of[i]];
+      i = island_of[i];
+    }
+    return i;
+  };
+
+  for (const auto& entry : node_to_capability) {
+    const auto* node = graph.GetNode(entry.first);
+    for (auto edge = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); edge != end; ++edge) {
+      auto consumer = node_to_capability.find(edge->GetNode().Index());
+      if (consumer != node_to_capability.end()) {
+        island_of[find_island(consumer->second)] = find_island(entry.second);
+      }
+    }
+  }
+
+  std::map<size_t, std::vector<const Node*>> islands;
+  for (const auto& entry : node_to_capability) {
+    islands[find_island(entry.second)].push_back(graph.GetNode(entry.first));
+  }
+
+  auto is_in_island = [&](const Node& node, size_t island) {
+    auto entry = node_to_capability.find(node.Index());
+    return entry != node_to_capability.end() && find_island(entry->second) == island;
+  };
+
+  for (const auto& island : islands) {
+    double device_time = 0.0;
+    double cpu_time = 0.0;
+    bool can_estimate = true;
+    std::unordered_set<const NodeArg*> copied_values;
+    for (const Node* node : island.second) {
+      double node_device_time = 0.0;
+      double node_cpu_time = 0.0;
+      if (node->ContainsSubgraph() ||
+          !KernelRegistryManager::HasImplementationOf(kernel_registry_mgr, *node, kCpuExecutionProvider) ||
+          !EstimateKernelTimes(*node, provider_type, cost_model, node_device_time, node_cpu_time)) {
+        can_estimate = false;
+        break;
+      }
+
+      device_time += node_device_time;
+      cpu_time += node_cpu_time;
+
+      // inputs from the CPU, other than initializers, which are copied to the device once
+      std::vector<const Node*> producers(node->InputDefs().size(), nullptr);
+      for (auto edge = node->InputEdgesBegin(), end = node->InputEdgesEnd(); edge != end; ++edge) {
+        producers[edge->GetDstArgIndex()] = &edge->GetNode();
+      }
+
+      for (size_t i = 0; i < producers.size(); ++i) {
+        const NodeArg* input = node->InputDefs()[i];
+        const bool is_copied = producers[i] == nullptr
+                                   ? input->Exists() && !graph.IsInitializedTensor(input->Name())
+                                   : !is_in_island(*producers[i], island.first) &&
+                                         producers[i]->GetExecutionProviderType() != provider_type;
+        if (is_copied) {
+          copied_values.insert(input);
+        }
+      }
+
+      // outputs to the CPU
+      for (auto edge = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); edge != end; ++edge) {
+        if (!is_in_island(edge->GetNode(), island.first) &&
+            edge->GetNode().GetExecutionProviderType() != provider_type) {
+          copied_values.insert(node->OutputDefs()[edge->GetSrcArgIndex()]);
+        }
+      }
+
+      for (const NodeArg* output : node->OutputDefs()) {
+        if (graph.IsOutput(output)) {
+          copied_values.insert(output);
+        }
+      }
+    }
+
+    double copy_time = 0.0;
+    for (const NodeArg* value : copied_values) {
+      int64_t num_elements = 0;
+      size_t num_bytes = 0;
+      if (!GetStaticTensorSize(*value, num_elements, num_bytes)) {
+        can_estimate = false;
+        break;
+      }
+
+      copy_time += cost_model.copy_overhead_us + static_cast<double>(num_bytes) / cost_model.copy_bytes_per_us;
+    }
+
+    if (!can_estimate || device_time + copy_time <= cpu_time) {
+      continue;
+    }
+
+    LOGS_DEFAULT(VERBOSE) << "Leaving " << island.second.size() << " node(s) including '" << island.second[0]->Name()
+                          << "' to the CPU instead of " << provider_type << ". Estimated time: " << cpu_time
+                          << "us on the CPU, " << device_time << "us on the device and " << copy_time
+                          << "us for the copies.";
+    for (const Node* node : island.second) {
+      capabilities[node_to_capability[node->Index()]].reset();
+    }
+  }
+}
+
 // for the current EP, recursively iterate through the Graph and any nested subgraphs (recursion is bottom-up).
 // assign any nodes to the EP that are currently unassigned, and that the EP can handle.
 static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
@@ -264,7 +511,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
                                            IExecutionProvider& current_ep,
                                            GraphPartitioner::Mode mode,
                                            int& fused_node_unique_id,
-                                           TransformLayoutFunction transform_layout_function) {
+                                           TransformLayoutFunction transform_layout_function,
+                                           const PartitioningCostModel* cost_model) {
   // handle testing edge case where optimizers or constant lifting results in graph with no nodes.
   // doing it here saves all providers checking for this in GetCapability
   if (graph.NumberOfNodes() == 0) {
@@ -278,7 +526,7 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       // we pass through the export_dll value and FuncManager from the top level graph
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(*subgraph, func_mgr, kernel_registry_mgr,
                                                        fused_kernel_registry, current_ep, mode, fused_node_unique_id,
-                                                       transform_layout_function));
+                                                       transform_layout_function, cost_model));
     }
   }
 
@@ -301,6 +549,10 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
   }
 
   const std::string& type = current_ep.Type();
+  if (cost_model != nullptr && mode == GraphPartitioner::Mode::kNormal && !utils::ProviderIsCpuBased(type)) {
+    DropCapabilitiesByCost(graph, kernel_registry_mgr, type, *cost_model, capabilities);
+  }
+
   auto fusion_style = current_ep.GetFusionStyle();
   std::vector<Node*> nodes_to_compile;
 
@@ -502,7 +754,7 @@ Status GraphPartitioner::PartitionOnnxFormatModel(Graph& graph, FuncManager& fun
     for (const auto& ep : providers_) {
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(graph, func_mgr, kernel_registry_mgr_,
                                                        fused_kernel_registry, *ep, mode, fused_node_unique_id,
-                                                       transform_layout_function));
+                                                       transform_layout_function, cost_model_));
     }
 
     // expand any nodes that have an ONNX function definition but no matching ORT kernel.
@@ -654,6 +906,8 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
   //          but are completely separate Graph instances and not a subset of nodes within a single Graph instance.
   // 3. CPU execution provider is expected to be able to run any node and is the last one in execution provider
   //    preference.
+  // With a cost model, the sub-graphs of an execution provider that is not CPU based are only assigned to it if that
+  // is estimated to be faster than leaving them to the CPU, see DropCapabilitiesByCost.
   if (providers_.Empty()) {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "No provider specified.");
   }
@@ -17,6 +17,26 @@ class KernelRegistry;
 class KernelRegistryManager;
 using TransformLayoutFunction = std::function<Status(Graph& graph, bool& modified, IExecutionProvider& current_ep)>;
 
+// Estimates used by cost aware partitioning, where the nodes an execution provider that is not CPU based can run
+// are only assigned to it if that is estimated to be faster than running them on the CPU, including the copies
+// of their inputs and outputs between the devices.
+struct PartitioningCostModel {
+  // Mean kernel time in microseconds by execution provider type and op type, e.g. from a profiled run.
+  // Used instead of the estimates for the op types measured with both the execution provider and the CPU provider.
+  std::unordered_map<std::string, std::unordered_map<std::string, double>> kernel_time_us;
+
+  // Throughput in multiply-adds, or elements for the other ops, per microsecond.
+  double cpu_ops_per_us = 1e4;
+  double device_ops_per_us = 2e5;
+
+  // Fixed cost in microseconds of launching a kernel on the device.
+  double device_kernel_overhead_us = 10.0;
+
+  // Fixed cost in microseconds, and bandwidth, of copying a value between the CPU and the device.
+  double copy_overhead_us = 10.0;
+  double copy_bytes_per_us = 1e4;
+};
+
 class GraphPartitioner {
  public:
   enum class Mode {
@@ -26,9 +46,12 @@ class GraphPartitioner {
   };
 
   //The order of providers represents the user preference.
-  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers)
+  //If cost_model is provided, it is used to partition ONNX format models in kNormal mode and must outlive this.
+  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers,
+                   const PartitioningCostModel* cost_model = nullptr)
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {
+        providers_(providers),
+        cost_model_(cost_model) {
   }
 
   // Run partitioning. Provide compiled_kernel_hashes if mode is kOrtFormatLoad.
@@ -52,6 +75,7 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  const PartitioningCostModel* cost_model_;
 };
 }  // namespace onnxruntime
 
@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include "core/mlas/inc/mlas.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace onnxruntime {
+
+namespace {
+constexpr size_t RoundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+#if defined(__linux__)
+constexpr size_t kHugePageSize2MB = size_t{2} * 1024 * 1024;
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_1GB)
+constexpr size_t kHugePageSize1GB = size_t{1024} * 1024 * 1024;
+#endif
+
+// maps explicit huge pages with the given flags, which only succeeds if the system reserved enough of them
+void* MapHugeTlbPages(size_t size, size_t page_size, int flags, size_t& mapped_size) {
+  const size_t length = RoundUp(size, page_size);
+  void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+  if (p == MAP_FAILED) {
+    return nullptr;
+  }
+
+  mapped_size = length;
+  return p;
+}
+#endif
+}  // namespace
+
+HugePageCPUAllocator::~HugePageCPUAllocator() {
+  for (const auto& mapping : mapped_sizes_) {
+    UnmapHugePages(mapping.first, mapping.second);
+  }
+}
+
+size_t HugePageCPUAllocator::GetHugePageSize() {
+#if defined(_WIN32)
+  static const size_t large_page_minimum = GetLargePageMinimum();
+  return large_page_minimum;
+#elif defined(__linux__)
+  return kHugePageSize2MB;
+#else
+  return 0;
+#endif
+}
+
+void* HugePageCPUAllocator::MapHugePages(size_t size, size_t& mapped_size) {
+#if defined(_WIN32)
+  const size_t large_page_size = GetHugePageSize();
+  if (large_page_size == 0) {
+    return nullptr;
+  }
+
+  // fails unless the process token has SeLockMemoryPrivilege enabled
+  const size_t length = RoundUp(size, large_page_size);
+  void* p = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+  if (p != nullptr) {
+    mapped_size = length;
+  }
+  return p;
+#elif defined(__linux__)
+  void* p = nullptr;
+#if defined(MAP_HUGETLB)
+#if defined(MAP_HUGE_1GB)
+  if (size >= kHugePageSize1GB) {
+    p = MapHugeTlbPages(size, kHugePageSize1GB, MAP_HUGETLB | MAP_HUGE_1GB, mapped_size);
+    if (p != nullptr) {
+      return p;
+    }
+  }
+#endif
+#if defined(MAP_HUGE_2MB)
+  p = MapHugeTlbPages(size, kHugePageSize2MB, MAP_HUGETLB | MAP_HUGE_2MB, mapped_size);
+  if (p != nullptr) {
+    return p;
+  }
+#endif
+#endif
+
+  // Fall back to transparent huge pages. The kernel only backs 2MB aligned ranges with huge pages, so map an extra
+  // huge page and trim the unaligned head and tail.
+  const size_t length = RoundUp(size, kHugePageSize2MB);
+  const size_t reserved_length = length + kHugePageSize2MB;
+  void* reserved = mmap(nullptr, reserved_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (reserved == MAP_FAILED) {
+    return nullptr;
+  }
+
+  char* base = static_cast<char*>(reserved);
+  char* aligned = reinterpret_cast<char*>(RoundUp(reinterpret_cast<uintptr_t>(base), kHugePageSize2MB));
+  const size_t head = static_cast<size_t>(aligned - base);
+  const size_t tail = reserved_length - head - length;
+  if (head > 0) {
+    munmap(base, head);
+  }
+  if (tail > 0) {
+    munmap(aligned + length, tail);
+  }
+
+#if defined(MADV_HUGEPAGE)
+  // failure only means transparent huge pages are disabled, in which case the memory is still usable
+  madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+
+  mapped_size = length;
+  return aligned;
+#else
+  ORT_UNUSED_PARAMETER(size);
+  ORT_UNUSED_PARAMETER(mapped_size);
+  return nullptr;
+#endif
+}
+
+void HugePageCPUAllocator::UnmapHugePages(void* p, size_t mapped_size) {
+#if defined(_WIN32)
+  ORT_UNUSED_PARAMETER(mapped_size);
+  VirtualFree(p, 0, MEM_RELEASE);
+#elif defined(__linux__)
+  munmap(p, mapped_size);
+#else
+  ORT_UNUSED_PARAMETER(p);
+  ORT_UNUSED_PARAMETER(mapped_size);
+#endif
+}
+
+void* HugePageCPUAllocator::Alloc(size_t size) {
+  const size_t huge_page_size = GetHugePageSize();
+  if (huge_page_size == 0 || size < huge_page_size) {
+    return AllocatorDefaultAlloc(size);
+  }
+
+  size_t mapped_size = 0;
+  void* p = MapHugePages(size + MLAS_SYMM_QGEMM_BUF_OVERRUN, mapped_size);
+  if (p == nullptr) {
+    return AllocatorDefaultAlloc(size);
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  mapped_sizes_.emplace(p, mapped_size);
+  return p;
+}
+
+void HugePageCPUAllocator::Free(void* p) {
+  size_t mapped_size = 0;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = mapped_sizes_.find(p);
+    if (it != mapped_sizes_.end()) {
+      mapped_size = it->second;
+      mapped_sizes_.erase(it);
+    }
+  }
+
+  if (mapped_size == 0) {
+    AllocatorDefaultFree(p);
+  } else {
+    UnmapHugePages(p, mapped_size);
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * CPU allocator that backs large allocations with huge pages to reduce TLB misses when streaming over big buffers
+ * such as arena regions and pre-packed weights.
+ *
+ * On Linux, explicit huge pages (1GB for allocations of at least 1GB, otherwise 2MB) are used if the system has
+ * reserved any, else the mapping is 2MB aligned and transparent huge pages are requested with madvise.
+ * On Windows, large pages are used if the process holds SeLockMemoryPrivilege.
+ * Allocations smaller than a huge page, and all allocations on other platforms, fall back to the CPUAllocator.
+ */
+class HugePageCPUAllocator : public IAllocator {
+ public:
+  explicit HugePageCPUAllocator(const OrtMemoryInfo& memory_info) : IAllocator(memory_info) {}
+
+  HugePageCPUAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
+
+  ~HugePageCPUAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+  // Size of the smallest huge page, or 0 if huge pages are not supported on this platform.
+  static size_t GetHugePageSize();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HugePageCPUAllocator);
+
+  // returns nullptr if the allocation could not be backed by huge pages
+  static void* MapHugePages(size_t size, size_t& mapped_size);
+  static void UnmapHugePages(void* p, size_t mapped_size);
+
+  OrtMutex mutex_;
+  // size of each live mapping, as the page mapping functions need it to release the memory
+  std::unordered_map<void*, size_t> mapped_sizes_;
+};
+
+}  // namespace onnxruntime
@@ -282,20 +282,62 @@ static std::string ToString(const std::vector<std::string>& error_strs) {
 // if this function is called before graph partition, then node.provider is not set.
 // In this case, the kernel's provider must equal to exec_provider
 // otherwise, kernel_def.provider must equal to node.provider. exec_provider is ignored.
+std::string KernelRegistry::GetLookupCacheKey(const Node& node, const std::string& map_key) {
+  std::string key(map_key);
+  key.append(1, ' ').append(std::to_string(node.SinceVersion()));
+
+  // the types are interned by ONNX, so their address identifies them
+  auto append_arg = [&key](const NodeArg* arg) {
+    const std::string* type = arg->Exists() ? arg->Type() : nullptr;
+    key.append(reinterpret_cast<const char*>(&type), sizeof(type));
+  };
+
+  key.append(1, ' ');
+  for (int count : node.InputArgCount()) {
+    key.append(reinterpret_cast<const char*>(&count), sizeof(count));
+  }
+  key.append(1, ' ');
+  for (const auto* arg : node.InputDefs()) {
+    append_arg(arg);
+  }
+  key.append(1, ' ');
+  for (const auto* arg : node.OutputDefs()) {
+    append_arg(arg);
+  }
+  return key;
+}
+
 Status KernelRegistry::TryFindKernel(const Node& node,
                                      ProviderType exec_provider,
                                      const KernelCreateInfo** out) const {
   const auto& node_provider = node.GetExecutionProviderType();
   const auto& expected_provider = (node_provider.empty() ? exec_provider : node_provider);
 
-  auto range = kernel_creator_fn_map_.equal_range(GetMapKey(node.OpType(), node.Domain(), expected_provider));
+  const std::string map_key = GetMapKey(node.OpType(), node.Domain(), expected_provider);
+  auto range = kernel_creator_fn_map_.equal_range(map_key);
   if (out) *out = nullptr;
 
+  // the lookups that fail are not cached, as their error messages are node specific
+  std::string cache_key;
+  if (range.first != range.second && node.Op() != nullptr) {
+    cache_key = GetLookupCacheKey(node, map_key);
+    std::lock_guard<OrtMutex> lock(kernel_lookup_cache_mutex_);
+    auto entry = kernel_lookup_cache_.find(cache_key);
+    if (entry != kernel_lookup_cache_.end()) {
+      if (out) *out = entry->second;
+      return Status::OK();
+    }
+  }
+
   std::vector<std::string> verify_kernel_def_error_strs;
 
   for (auto i = range.first; i != range.second; ++i) {
     std::string error_str;
     if (VerifyKernelDef(node, *i->second.kernel_def, error_str)) {
+      if (!cache_key.empty()) {
+        std::lock_guard<OrtMutex> lock(kernel_lookup_cache_mutex_);
+        kernel_lookup_cache_.emplace(std::move(cache_key), &i->second);
+      }
       if (out) *out = &i->second;
       return Status::OK();
     }
@@ -387,6 +429,12 @@ Status KernelRegistry::Register(KernelCreateInfo&& create_info) {
   // Ownership of the KernelDef is transferred to kernel_creator_fn_map_.
   auto it = kernel_creator_fn_map_.emplace(key, std::move(create_info));
   kernel_def_hash_lookup_.emplace(kernel_def_hash, it);
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // the new kernel may be a better match for the nodes of a cached lookup
+  std::lock_guard<OrtMutex> lock(kernel_lookup_cache_mutex_);
+  kernel_lookup_cache_.clear();
+#endif
   return Status::OK();
 }
 
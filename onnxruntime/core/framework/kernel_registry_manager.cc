@@ -21,7 +21,8 @@ Status KernelRegistryManager::CreateKernel(const onnxruntime::Node& node,
   OpKernelInfo kernel_info(node, *kernel_create_info.kernel_def, execution_provider,
                            session_state.GetConstantInitializedTensors(),
                            session_state.GetOrtValueNameIdxMap(),
-                           session_state.GetDataTransferMgr());
+                           session_state.GetDataTransferMgr(),
+                           &session_state.GetConfigOptions());
 
   return kernel_create_info.kernel_create_func(session_state.GetMutableFuncMgr(), kernel_info, out);
 }
@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/memory_timeline.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <map>
+
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+
+namespace {
+constexpr size_t kNotFreed = std::numeric_limits<size_t>::max();
+}  // namespace
+
+MemoryTimeline::MemoryTimeline() : start_time_(std::chrono::high_resolution_clock::now()) {}
+
+long long MemoryTimeline::NowMicroSeconds() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
+                                                               start_time_)
+      .count();
+}
+
+void MemoryTimeline::RecordAllocation(int ort_value_idx, const std::string& location, size_t size, int64_t offset) {
+  const long long now = NowMicroSeconds();
+  std::lock_guard<OrtMutex> lock(mutex_);
+  live_allocations_[ort_value_idx] = allocations_.size();
+  allocations_.push_back({ort_value_idx, location, size, offset, now, -1, next_seq_++, kNotFreed});
+}
+
+void MemoryTimeline::RecordFree(int ort_value_idx) {
+  const long long now = NowMicroSeconds();
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = live_allocations_.find(ort_value_idx);
+  if (it == live_allocations_.end()) {
+    return;
+  }
+
+  auto& allocation = allocations_[it->second];
+  allocation.free_us = now;
+  allocation.free_seq = next_seq_++;
+  live_allocations_.erase(it);
+}
+
+void MemoryTimeline::RecordPatternBuffer(const std::string& location, size_t size) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  pattern_buffer_sizes_[location] = size;
+}
+
+Status MemoryTimeline::WriteChromeTrace(const std::string& file_path, const SessionState& session_state) const {
+  const long long end_us = NowMicroSeconds();
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  std::ofstream out(file_path, std::ios::out | std::ios::trunc);
+  ORT_RETURN_IF_NOT(out.good(), "Failed to open memory timeline file ", file_path);
+
+  const auto& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  std::vector<std::string> names(allocations_.size());
+  for (size_t i = 0; i < allocations_.size(); ++i) {
+    if (!name_idx_map.GetName(allocations_[i].ort_value_idx, names[i]).IsOK()) {
+      names[i] = std::to_string(allocations_[i].ort_value_idx);
+    }
+  }
+
+  // one process per location, in the order they were first used
+  std::map<std::string, int> pids;
+  for (const auto& allocation : allocations_) {
+    pids.emplace(allocation.location, static_cast<int>(pids.size()));
+  }
+
+  out << "[\n";
+  bool first_event = true;
+  auto begin_event = [&]() -> std::ofstream& {
+    if (!first_event) out << ",\n";
+    first_event = false;
+    return out;
+  };
+
+  for (const auto& pid : pids) {
+    begin_event() << R"({"name" : "process_name", "ph" : "M", "pid" : )" << pid.second
+                  << R"(, "args" : {"name" : ")" << pid.first << "\"}}";
+  }
+
+  for (size_t i = 0; i < allocations_.size(); ++i) {
+    const auto& allocation = allocations_[i];
+    const Node* producer = graph_viewer.GetProducerNode(names[i]);
+    const long long free_us = allocation.free_seq == kNotFreed ? end_us : allocation.free_us;
+    auto& event = begin_event();
+    event << R"({"cat" : "buffer", "ph" : "X", "pid" : )" << pids[allocation.location] << R"(, "tid" : 0)"
+          << R"(, "ts" : )" << allocation.alloc_us << R"(, "dur" : )" << free_us - allocation.alloc_us
+          << R"(, "name" : ")" << names[i] << R"(", "args" : {"bytes" : )" << allocation.size;
+    if (producer != nullptr) {
+      event << R"(, "node" : ")" << producer->Name() << R"(", "op_type" : ")" << producer->OpType() << "\"";
+    }
+    if (allocation.offset >= 0) {
+      event << R"(, "pattern_buffer_offset" : )" << allocation.offset;
+    }
+    event << "}}";
+  }
+
+  // replay the allocations and releases in order to get the live bytes and the peak of each location
+  std::vector<std::pair<size_t, size_t>> events;  // (seq, allocation index)
+  for (size_t i = 0; i < allocations_.size(); ++i) {
+    events.emplace_back(allocations_[i].alloc_seq, i);
+    if (allocations_[i].free_seq != kNotFreed) {
+      events.emplace_back(allocations_[i].free_seq, i);
+    }
+  }
+  std::sort(events.begin(), events.end());
+
+  std::map<std::string, size_t> live_bytes;
+  std::map<std::string, std::pair<size_t, size_t>> peaks;  // location -> (peak bytes, seq of the peak)
+  for (const auto& seq_and_index : events) {
+    const auto& allocation = allocations_[seq_and_index.second];
+    const bool is_alloc = seq_and_index.first == allocation.alloc_seq;
+    size_t& bytes = live_bytes[allocation.location];
+    bytes = is_alloc ? bytes + allocation.size : bytes - allocation.size;
+
+    const long long ts = is_alloc ? allocation.alloc_us : allocation.free_us;
+    begin_event() << R"({"name" : "live_bytes", "ph" : "C", "pid" : )" << pids[allocation.location]
+                  << R"(, "ts" : )" << ts << R"(, "args" : {"bytes" : )" << bytes << "}}";
+
+    auto& peak = peaks[allocation.location];
+    if (bytes > peak.first) {
+      peak = {bytes, seq_and_index.first};
+    }
+  }
+
+  for (const auto& location_and_peak : peaks) {
+    const auto& location = location_and_peak.first;
+    const size_t peak_seq = location_and_peak.second.second;
+
+    std::vector<size_t> contributors;
+    for (size_t i = 0; i < allocations_.size(); ++i) {
+      const auto& allocation = allocations_[i];
+      if (allocation.location == location && allocation.alloc_seq <= peak_seq &&
+          (allocation.free_seq == kNotFreed || allocation.free_seq > peak_seq)) {
+        contributors.push_back(i);
+      }
+    }
+    std::sort(contributors.begin(), contributors.end(), [this](size_t a, size_t b) {
+      return allocations_[a].size > allocations_[b].size;
+    });
+
+    long long peak_us = 0;
+    for (size_t i : contributors) {
+      peak_us = std::max(peak_us, allocations_[i].alloc_us);
+    }
+
+    auto& event = begin_event();
+    event << R"({"name" : "peak", "ph" : "i", "s" : "p", "pid" : )" << pids[location] << R"(, "ts" : )" << peak_us
+          << R"(, "args" : {"bytes" : )" << location_and_peak.second.first;
+    auto pattern_buffer = pattern_buffer_sizes_.find(location);
+    if (pattern_buffer != pattern_buffer_sizes_.end()) {
+      event << R"(, "pattern_buffer_bytes" : )" << pattern_buffer->second;
+    }
+    event << R"(, "contributors" : [)";
+    for (size_t i = 0; i < contributors.size(); ++i) {
+      const Node* producer = graph_viewer.GetProducerNode(names[contributors[i]]);
+      event << (i == 0 ? "" : ", ") << R"({"name" : ")" << names[contributors[i]] << R"(", "bytes" : )"
+            << allocations_[contributors[i]].size << R"(, "node" : ")" << (producer ? producer->Name() : "")
+            << "\"}";
+    }
+    event << "]}}";
+  }
+
+  out << "\n]\n";
+  ORT_RETURN_IF_NOT(out.good(), "Failed to write memory timeline file ", file_path);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
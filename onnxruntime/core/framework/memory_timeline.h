@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class SessionState;
+
+/**
+ * Allocation timeline of the OrtValues of one run, enabled with the session.memory_timeline_file_prefix config
+ * entry. Records when the execution frame allocates and releases each tensor, where it lives (the location and,
+ * for tensors placed in the memory pattern buffer, the offset in it) and computes the peak of the live bytes per
+ * location with the tensors that make it up.
+ * Memory a kernel allocates internally, e.g. from the temp space allocator, is not seen by the frame and is not
+ * recorded.
+ */
+class MemoryTimeline {
+ public:
+  MemoryTimeline();
+
+  /*
+  Records the allocation of the tensor of ort_value_idx. offset is its offset in the memory pattern buffer of the
+  location, or -1 if the tensor has its own buffer.
+  */
+  void RecordAllocation(int ort_value_idx, const std::string& location, size_t size, int64_t offset);
+
+  /*
+  Records the release of the tensor of ort_value_idx. Values that weren't recorded as allocated are ignored.
+  */
+  void RecordFree(int ort_value_idx);
+
+  /*
+  Records the size of the memory pattern buffer allocated for a location at the start of the run.
+  */
+  void RecordPatternBuffer(const std::string& location, size_t size);
+
+  /*
+  Writes the timeline as a Chrome trace (chrome://tracing, Perfetto) to file_path: one complete event per tensor
+  spanning its lifetime, a counter of the live bytes per location and an instant event at the peak of each location
+  whose args list the tensors live at the peak, largest first. Tensors that are never released, e.g. the graph
+  outputs, live until the end of the run.
+  */
+  Status WriteChromeTrace(const std::string& file_path, const SessionState& session_state) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryTimeline);
+
+  struct Allocation {
+    int ort_value_idx;
+    std::string location;
+    size_t size;
+    int64_t offset;
+    long long alloc_us;
+    long long free_us;
+    // order of the allocation and release among all the events, as several can happen in the same microsecond
+    size_t alloc_seq;
+    size_t free_seq;
+  };
+
+  long long NowMicroSeconds() const;
+
+  const std::chrono::high_resolution_clock::time_point start_time_;
+  mutable OrtMutex mutex_;
+  std::vector<Allocation> allocations_;
+  // index in allocations_ of the live tensor of each ort_value_idx
+  std::unordered_map<int, size_t> live_allocations_;
+  std::unordered_map<std::string, size_t> pattern_buffer_sizes_;
+  size_t next_seq_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/numa_allocator.h"
+
+#include <climits>
+#include <vector>
+
+#include "core/mlas/inc/mlas.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace onnxruntime {
+
+namespace {
+constexpr size_t RoundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+#if defined(__linux__) && defined(SYS_mbind)
+// from linux/mempolicy.h, which is not always installed
+constexpr int kMemPolicyPreferred = 1;
+
+void PreferNumaNode(void* p, size_t length, int numa_node) {
+  constexpr size_t kBitsPerWord = sizeof(unsigned long) * CHAR_BIT;
+  std::vector<unsigned long> node_mask(static_cast<size_t>(numa_node) / kBitsPerWord + 1, 0);
+  node_mask.back() = 1UL << (static_cast<size_t>(numa_node) % kBitsPerWord);
+
+  // failure only means the pages are placed by the default policy, so the memory is still usable
+  syscall(SYS_mbind, p, length, kMemPolicyPreferred, node_mask.data(), node_mask.size() * kBitsPerWord + 1, 0);
+}
+#endif
+}  // namespace
+
+NumaCPUAllocator::~NumaCPUAllocator() {
+  for (const auto& mapping : mapped_sizes_) {
+    UnmapNodePages(mapping.first, mapping.second);
+  }
+}
+
+void* NumaCPUAllocator::MapNodePages(size_t size, size_t& mapped_size) const {
+#if defined(_WIN32)
+  void* p = VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE,
+                               static_cast<DWORD>(numa_node_));
+  if (p != nullptr) {
+    mapped_size = size;
+  }
+  return p;
+#elif defined(__linux__) && defined(SYS_mbind)
+  const size_t length = RoundUp(size, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+  void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) {
+    return nullptr;
+  }
+
+  // the policy applies to the pages faulted in from now on, so it has to be set before the memory is touched
+  PreferNumaNode(p, length, numa_node_);
+  mapped_size = length;
+  return p;
+#else
+  ORT_UNUSED_PARAMETER(size);
+  ORT_UNUSED_PARAMETER(mapped_size);
+  return nullptr;
+#endif
+}
+
+void NumaCPUAllocator::UnmapNodePages(void* p, size_t mapped_size) {
+#if defined(_WIN32)
+  ORT_UNUSED_PARAMETER(mapped_size);
+  VirtualFree(p, 0, MEM_RELEASE);
+#elif defined(__linux__) && defined(SYS_mbind)
+  munmap(p, mapped_size);
+#else
+  ORT_UNUSED_PARAMETER(p);
+  ORT_UNUSED_PARAMETER(mapped_size);
+#endif
+}
+
+void* NumaCPUAllocator::Alloc(size_t size) {
+  if (numa_node_ < 0 || size < kMinMappedSize) {
+    return AllocatorDefaultAlloc(size);
+  }
+
+  size_t mapped_size = 0;
+  void* p = MapNodePages(size + MLAS_SYMM_QGEMM_BUF_OVERRUN, mapped_size);
+  if (p == nullptr) {
+    return AllocatorDefaultAlloc(size);
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  mapped_sizes_.emplace(p, mapped_size);
+  return p;
+}
+
+void NumaCPUAllocator::Free(void* p) {
+  size_t mapped_size = 0;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = mapped_sizes_.find(p);
+    if (it != mapped_sizes_.end()) {
+      mapped_size = it->second;
+      mapped_sizes_.erase(it);
+    }
+  }
+
+  if (mapped_size == 0) {
+    AllocatorDefaultFree(p);
+  } else {
+    UnmapNodePages(p, mapped_size);
+  }
+}
+
+}  // namespace onnxruntime
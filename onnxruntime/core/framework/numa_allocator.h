@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * CPU allocator that places large allocations, such as arena regions and pre-packed weights, in the memory of a
+ * NUMA node so that threads bound to that node do not read them from a remote node.
+ *
+ * The memory is mapped with mbind(MPOL_PREFERRED) on Linux and VirtualAllocExNuma on Windows, so it is taken from
+ * other nodes if the preferred node runs out of memory.
+ * Allocations smaller than kMinMappedSize, and all allocations on other platforms, fall back to the CPUAllocator
+ * and are placed by the operating system.
+ */
+class NumaCPUAllocator : public IAllocator {
+ public:
+  static constexpr size_t kMinMappedSize = 64 * 1024;
+
+  NumaCPUAllocator(const OrtMemoryInfo& memory_info, int numa_node)
+      : IAllocator(memory_info), numa_node_(numa_node) {}
+
+  explicit NumaCPUAllocator(int numa_node)
+      : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)), numa_node_(numa_node) {}
+
+  ~NumaCPUAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+  int GetNumaNode() const noexcept { return numa_node_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NumaCPUAllocator);
+
+  // returns nullptr if the memory could not be mapped
+  void* MapNodePages(size_t size, size_t& mapped_size) const;
+  static void UnmapNodePages(void* p, size_t mapped_size);
+
+  const int numa_node_;
+
+  OrtMutex mutex_;
+  // size of each live mapping, as the page mapping functions need it to release the memory
+  std::unordered_map<void*, size_t> mapped_sizes_;
+};
+
+}  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include <functional>
 #include "core/framework/op_kernel.h"
+#include "core/framework/run_termination.h"
 #include "core/framework/session_state.h"
 #include "core/session/onnxruntime_c_api.h"
 
@@ -21,10 +22,10 @@ class OpKernelContextInternal : public OpKernelContext {
                                    IExecutionFrame& frame,
                                    const OpKernel& kernel,
                                    const logging::Logger& logger,
-                                   const bool& terminate_flag)
+                                   const RunTermination& termination)
       : OpKernelContext(&frame, &kernel, session_state.GetThreadPool(), logger),
         session_state_(session_state),
-        terminate_flag_(terminate_flag) {
+        termination_(termination) {
     const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
     int num_implicit_inputs = static_cast<int>(implicit_inputs.size());
     implicit_input_values_.reserve(num_implicit_inputs);
@@ -68,11 +69,11 @@ class OpKernelContextInternal : public OpKernelContext {
     return implicit_input_values_;
   }
 
-  const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
+  const RunTermination& GetRunTermination() const noexcept { return termination_; }
 
  private:
   const SessionState& session_state_;
-  const bool& terminate_flag_;
+  const RunTermination termination_;
   std::vector<const OrtValue*> implicit_input_values_;
 };
 
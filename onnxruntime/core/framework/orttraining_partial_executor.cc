@@ -237,7 +237,7 @@ Status PartialExecutor::Execute(const SessionState& session_state, const std::ve
 #endif
     // construct OpKernelContext
     // TODO: log kernel inputs?
-    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, false);
+    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, RunTermination());
 
     // Cache lookup. Currently we only cache single-output nodes,
     // to keep memory overhead impact in check. Hence we only look in cache
@@ -260,7 +260,10 @@ Status PartialExecutor::Execute(const SessionState& session_state, const std::ve
     }
 
     // sync before compute
-    int queue_id = p_op_kernel->KernelDef().ExecQueueId();
+    int queue_id = seq_exec_plan.NodeQueueId(node_index, p_op_kernel->KernelDef().ExecQueueId());
+    if (seq_exec_plan.IsMultiStream()) {
+      ORT_RETURN_IF_ERROR(p_op_kernel->Info().GetExecutionProvider()->SetCurrentComputeQueue(queue_id));
+    }
     if (seq_exec_plan.NodeHasFence(node_index)) {
       for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
         Fence_t fence = op_kernel_context.InputFence(input_index);
@@ -328,6 +331,8 @@ Status PartialExecutor::Execute(const SessionState& session_state, const std::ve
           MakeString(node.OpType(), ".", node.Index(), "(", node.Name(), ")"), profile::Color::Yellow);
       node_compute_range.Begin();
 #endif
+      concurrency::ParallelForTuner::KernelScope tuning_scope(
+          session_state.GetParallelForTuner(), utils::GetParallelForTuningKey(session_state, op_kernel_context));
       ORT_TRY {
 #ifdef ENABLE_TRAINING
         if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
@@ -399,6 +404,13 @@ Status PartialExecutor::Execute(const SessionState& session_state, const std::ve
                                                           concurrency::ThreadPool::StopProfiling(
                                                               session_state.GetThreadPool())},
                                                      });
+
+      for (const auto& span : concurrency::ThreadPool::TakeProfilingSpans(session_state.GetThreadPool())) {
+        session_state.Profiler().RecordEvent(profiling::THREAD_POOL_EVENT,
+                                             node_name_for_profiling + (span.is_parallel_loop ? "_parallel_loop" : "_task"),
+                                             span.thread_id, span.start, span.end,
+                                             {{"op_name", p_op_kernel->KernelDef().OpName()}});
+      }
       sync_time_begin = session_state.Profiler().Start();
     }
 
@@ -454,6 +466,13 @@ Status PartialExecutor::Execute(const SessionState& session_state, const std::ve
     ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
   }
 
+  // the outputs are returned to the caller on the default compute stream of each provider
+  if (seq_exec_plan.IsMultiStream()) {
+    for (const auto& execution_provider : session_state.GetExecutionProviders()) {
+      ORT_RETURN_IF_ERROR(execution_provider->JoinComputeQueues());
+    }
+  }
+
 #ifdef ENABLE_NVTX_PROFILE
   // Make sure forward Range object call Begin and End.
   if (!forward_range.IsBeginCalled()) {
@@ -18,8 +18,8 @@
 
 namespace onnxruntime {
 
-ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
+ParallelExecutor::ParallelExecutor(const SessionState& session_state, const RunTermination& termination)
+    : out_standings_(0), termination_(termination), executor_pool_(session_state.GetInterOpThreadPool()) {
   const auto& graph_viewer = session_state.GetGraphViewer();
   node_refs_.resize(graph_viewer.MaxNodeIndex());
   for (auto& node : graph_viewer.Nodes()) {
@@ -98,7 +98,9 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
   }
 
   if (is_profiler_enabled) {
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "ParallelExecutor::Execute", tp);
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "ParallelExecutor::Execute", tp,
+                                                   {{"num_allocations",
+                                                     std::to_string(root_frame_->GetNumAllocations())}});
   }
 
   return Status::OK();
@@ -123,9 +125,10 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
   while (keep_running) {
     // TODO: Convert RunNodeAsync return Status.
     // to also handle exception propagation
-    if (terminate_flag_) {
-      LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
-      ORT_THROW("Exiting due to terminate flag being set to true.");
+    if (termination_.IsTerminated()) {
+      const Status termination_status = termination_.Check();
+      LOGS(logger, WARNING) << termination_status.ErrorMessage();
+      return termination_status;
     }
 
     const auto* p_op_kernel = session_state.GetKernel(node_index);
@@ -136,7 +139,7 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       ORT_THROW("Got nullptr from GetKernel for node: ", node.Name());
     }
 
-    OpKernelContextInternal op_kernel_context(session_state, *root_frame_, *p_op_kernel, logger, terminate_flag_);
+    OpKernelContextInternal op_kernel_context(session_state, *root_frame_, *p_op_kernel, logger, termination_);
 
     if (f_profiler_enabled) {
       sync_time_begin = session_state.Profiler().Start();
@@ -187,6 +190,8 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     VLOGS(logger, 1) << "Computing kernel: " << node.Name();
 
     // Execute the kernel.
+    concurrency::ParallelForTuner::KernelScope tuning_scope(
+        session_state.GetParallelForTuner(), utils::GetParallelForTuningKey(session_state, op_kernel_context));
     ORT_TRY {
 #ifdef ENABLE_TRAINING
       if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
@@ -220,6 +225,13 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
                                                       {"provider", p_op_kernel->KernelDef().Provider()},
                                                       {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())}});
 
+      for (const auto& span : concurrency::ThreadPool::TakeProfilingSpans(session_state.GetThreadPool())) {
+        session_state.Profiler().RecordEvent(profiling::THREAD_POOL_EVENT,
+                                             node.Name() + (span.is_parallel_loop ? "_parallel_loop" : "_task"),
+                                             span.thread_id, span.start, span.end,
+                                             {{"op_name", p_op_kernel->KernelDef().OpName()}});
+      }
+
       sync_time_begin = session_state.Profiler().Start();
     }
     // sync after compute for outputs
@@ -10,6 +10,7 @@
 #include "core/framework/iexecutor.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/ort_value.h"
+#include "core/framework/run_termination.h"
 #include "core/framework/session_state.h"
 #include "core/graph/graph_viewer.h"
 #include "core/platform/ort_mutex.h"
@@ -20,7 +21,7 @@ class ExecutionFrame;
 
 class ParallelExecutor : public IExecutor {
  public:
-  ParallelExecutor(const SessionState& session_state, const bool& terminate_flag = false);
+  ParallelExecutor(const SessionState& session_state, const RunTermination& termination = {});
 
   common::Status Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
                          const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
@@ -59,7 +60,7 @@ class ParallelExecutor : public IExecutor {
   OrtCondVar complete_cv_;
   std::vector<Status> errors_;
 
-  const bool& terminate_flag_;
+  const RunTermination termination_;
   // TODO: Temporary threadpool for the executor.  This is a costly way to handle the problem.
   onnxruntime::concurrency::ThreadPool* const executor_pool_{};
 };
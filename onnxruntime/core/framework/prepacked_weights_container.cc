@@ -3,6 +3,11 @@
 
 #include "core/framework/prepacked_weights_container.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace onnxruntime {
 
@@ -49,4 +54,45 @@ size_t PrepackedWeightsContainer::GetNumberOfElements() const {
   return prepacked_weights_map_.size();
 }
 
+const OrtValue& PrepackedWeightsContainer::GetOrWriteInitializer(const OrtValue& initializer) {
+  const Tensor& tensor = initializer.Get<Tensor>();
+  ORT_ENFORCE(!tensor.IsDataTypeString() && strcmp(tensor.Location().name, CPU) == 0,
+              "Only tensors of fixed size elements in CPU memory can be shared by content");
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  auto hash_buffer = [&hash](const void* data, size_t len) {
+    // hash in chunks as the length taken by MurmurHash3 is an int
+    constexpr size_t kMaxChunk = size_t{1} << 30;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    do {
+      const size_t chunk = std::min(len, kMaxChunk);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk), hash[0], &hash);
+      bytes += chunk;
+      len -= chunk;
+    } while (len > 0);
+  };
+
+  const int32_t element_type = tensor.GetElementType();
+  const auto dims = tensor.Shape().GetDims();
+  hash_buffer(&element_type, sizeof(element_type));
+  hash_buffer(dims.data(), dims.size() * sizeof(int64_t));
+  hash_buffer(tensor.DataRaw(), tensor.SizeInBytes());
+  const HashValue key = hash[0] | (uint64_t(hash[1]) << 32);
+
+  auto range = initializers_map_.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    const Tensor& shared_tensor = it->second.Get<Tensor>();
+    if (shared_tensor.GetElementType() == element_type && shared_tensor.Shape() == tensor.Shape() &&
+        memcmp(shared_tensor.DataRaw(), tensor.DataRaw(), tensor.SizeInBytes()) == 0) {
+      return it->second;
+    }
+  }
+
+  return initializers_map_.emplace(key, initializer)->second;
+}
+
+size_t PrepackedWeightsContainer::GetNumberOfInitializers() const {
+  return initializers_map_.size();
+}
+
 }  // namespace onnxruntime
@@ -11,6 +11,7 @@
 #include "core/framework/buffer_deleter.h"
 
 #include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
 #include "core/platform/ort_mutex.h"
 #include "prepacked_weights.h"
 
@@ -47,6 +48,14 @@ class PrepackedWeightsContainer final {
   // Returns the number of elements in the container
   size_t GetNumberOfElements() const;
 
+  // Returns the initializer held by the container that has the same element type, shape and data as the
+  // provided one. If there is none, the provided initializer is written into the container and returned.
+  // Only tensors of fixed size elements in CPU memory are supported.
+  const OrtValue& GetOrWriteInitializer(const OrtValue& initializer);
+
+  // Returns the number of initializers in the container
+  size_t GetNumberOfInitializers() const;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsContainer);
 
   // Resource to be acquired by the method that is going to invoke calls to the kernels'
@@ -64,6 +73,10 @@ class PrepackedWeightsContainer final {
   // to PrePackedWeights instances.
   // The key is : op_type + "+" + hash_of_prepacked_buffers_in_the_PrepackedWeights_instance.
   std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map_;
+
+  // Initializers shared by content between the sessions using the container, keyed by a hash of their
+  // element type, shape and data. Initializers with colliding hashes are told apart by their data.
+  std::unordered_multimap<HashValue, OrtValue> initializers_map_;
 };
 
 }  // namespace onnxruntime
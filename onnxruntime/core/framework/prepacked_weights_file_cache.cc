@@ -0,0 +1,335 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_file_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// File layout, in host byte order:
+//   FileHeader
+//   for each entry: uint32 key length, key, uint32 number of buffers, {uint64 offset, uint64 size} per buffer
+//   buffer data, each buffer aligned to kBufferAlignment from the start of the file
+constexpr char kMagic[8] = {'O', 'R', 'T', 'P', 'P', 'W', 'C', '\0'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr size_t kBufferAlignment = 64;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t format_version;
+  uint32_t pointer_size;
+  char ort_version[16];
+  uint64_t cpu_features;
+  uint64_t num_entries;
+};
+
+uint64_t GetCpuFeatures() {
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  const bool features[] = {cpu_info.HasAVX(), cpu_info.HasAVX2(), cpu_info.HasAVX512f(),
+                           cpu_info.HasAVX512Skylake(), cpu_info.HasF16C(), cpu_info.HasSSE3(),
+                           cpu_info.HasSSE4_1(), cpu_info.HasArmNeonDot()};
+  uint64_t mask = 0;
+  for (size_t i = 0; i < sizeof(features) / sizeof(features[0]); ++i) {
+    mask |= static_cast<uint64_t>(features[i]) << i;
+  }
+
+  return mask;
+}
+
+FileHeader MakeHeader(uint64_t num_entries) {
+  FileHeader header{};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.format_version = kFormatVersion;
+  header.pointer_size = static_cast<uint32_t>(sizeof(void*));
+  strncpy(header.ort_version, ORT_VERSION, sizeof(header.ort_version) - 1);
+  header.cpu_features = GetCpuFeatures();
+  header.num_entries = num_entries;
+  return header;
+}
+
+void HashBuffer(const void* data, size_t len, uint32_t (&hash)[4]) {
+  // MurmurHash3 takes an int length
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  constexpr size_t kMaxChunk = static_cast<size_t>(std::numeric_limits<int>::max());
+  do {
+    const size_t chunk = std::min(len, kMaxChunk);
+    MurmurHash3::x86_128(bytes, static_cast<int>(chunk), hash[0], &hash);
+    bytes += chunk;
+    len -= chunk;
+  } while (len > 0);
+}
+
+// Reads values out of the mapped file, failing instead of reading past its end.
+class Reader {
+ public:
+  Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  bool Read(T& value) {
+    if (size_ - offset_ < sizeof(T)) {
+      return false;
+    }
+
+    memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool Read(std::string& value, size_t length) {
+    if (size_ - offset_ < length) {
+      return false;
+    }
+
+    value.assign(data_ + offset_, length);
+    offset_ += length;
+    return true;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+int RenameFile(const PathString& from, const PathString& to) {
+#ifdef _WIN32
+  return _wrename(from.c_str(), to.c_str());
+#else
+  return std::rename(from.c_str(), to.c_str());
+#endif
+}
+
+void RemoveFile(const PathString& path) {
+#ifdef _WIN32
+  _wremove(path.c_str());
+#else
+  std::remove(path.c_str());
+#endif
+}
+
+}  // namespace
+
+std::string PrepackedWeightsFileCache::GenerateKey(const Node& node, const OpKernel& kernel, int input_idx,
+                                                   const Tensor& tensor) {
+  if (tensor.IsDataTypeString()) {
+    return {};
+  }
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  // attributes such as transB change the pre-packed layout. sort them as NodeAttributes is unordered.
+  const auto& attributes = node.GetAttributes();
+  std::vector<std::string> attribute_names;
+  attribute_names.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    attribute_names.push_back(attribute.first);
+  }
+  std::sort(attribute_names.begin(), attribute_names.end());
+  for (const auto& name : attribute_names) {
+    const std::string serialized = attributes.at(name).SerializeAsString();
+    HashBuffer(serialized.data(), serialized.size(), hash);
+  }
+
+  const auto dims = tensor.Shape().GetDims();
+  HashBuffer(dims.data(), dims.size_bytes(), hash);
+  const int32_t data_type = tensor.GetElementType();
+  HashBuffer(&data_type, sizeof(data_type), hash);
+  HashBuffer(tensor.DataRaw(), tensor.SizeInBytes(), hash);
+
+  std::ostringstream ss;
+  ss << node.OpType() << "+" << kernel.KernelDef().GetHash() << "+" << input_idx << "+" << std::hex
+     << std::setfill('0');
+  for (uint32_t h : hash) {
+    ss << std::setw(8) << h;
+  }
+
+  return ss.str();
+}
+
+Status PrepackedWeightsFileCache::Load(const Env& env, const logging::Logger& logger) {
+  size_t file_size = 0;
+  if (!env.GetFileLength(file_path_.c_str(), file_size).IsOK() || file_size == 0) {
+    LOGS(logger, INFO) << "Pre-packed weights cache " << ToUTF8String(file_path_)
+                       << " does not exist yet. It will be created.";
+    return Status::OK();
+  }
+
+  Env::MappedMemoryPtr mapped_file;
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path_.c_str(), 0, file_size, mapped_file));
+
+  const char* data = mapped_file.get();
+  const FileHeader expected_header = MakeHeader(0);
+  FileHeader header{};
+  Reader reader(data, file_size);
+  if (!reader.Read(header) || memcmp(header.magic, expected_header.magic, sizeof(header.magic)) != 0 ||
+      header.format_version != expected_header.format_version ||
+      header.pointer_size != expected_header.pointer_size ||
+      memcmp(header.ort_version, expected_header.ort_version, sizeof(header.ort_version)) != 0 ||
+      header.cpu_features != expected_header.cpu_features) {
+    LOGS(logger, WARNING) << "Ignoring pre-packed weights cache " << ToUTF8String(file_path_)
+                          << " as it was created by a different version of onnxruntime or on a different CPU."
+                          << " It will be replaced.";
+    return Status::OK();
+  }
+
+  std::unordered_map<std::string, PrePackedWeights> weights_map;
+  for (uint64_t i = 0; i < header.num_entries; ++i) {
+    uint32_t key_length = 0;
+    std::string key;
+    uint32_t num_buffers = 0;
+    ORT_RETURN_IF_NOT(reader.Read(key_length) && reader.Read(key, key_length) && reader.Read(num_buffers),
+                      "Pre-packed weights cache ", ToUTF8String(file_path_), " is truncated.");
+
+    PrePackedWeights weights;
+    for (uint32_t j = 0; j < num_buffers; ++j) {
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      ORT_RETURN_IF_NOT(reader.Read(offset) && reader.Read(size) && offset <= file_size &&
+                            size <= file_size - offset,
+                        "Pre-packed weights cache ", ToUTF8String(file_path_), " is truncated.");
+
+      // the buffers are owned by the mapping
+      void* buffer = size == 0 ? nullptr : const_cast<char*>(data + offset);
+      weights.buffers_.emplace_back(buffer, BufferDeleter(nullptr));
+      weights.buffer_sizes_.push_back(static_cast<size_t>(size));
+    }
+
+    weights_map.emplace(std::move(key), std::move(weights));
+  }
+
+  mapped_file_ = std::move(mapped_file);
+  loaded_weights_ = std::move(weights_map);
+
+  LOGS(logger, INFO) << "Loaded " << loaded_weights_.size() << " pre-packed weights from "
+                     << ToUTF8String(file_path_);
+  return Status::OK();
+}
+
+Status PrepackedWeightsFileCache::Save(const Env& env, const logging::Logger& logger) const {
+  if (new_weights_.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<std::pair<const std::string*, const PrePackedWeights*>> entries;
+  entries.reserve(loaded_weights_.size() + new_weights_.size());
+  for (const auto* weights_map : {&loaded_weights_, &new_weights_}) {
+    for (const auto& entry : *weights_map) {
+      entries.emplace_back(&entry.first, &entry.second);
+    }
+  }
+
+  // work out where the data of each buffer goes
+  uint64_t offset = sizeof(FileHeader);
+  for (const auto& entry : entries) {
+    offset += sizeof(uint32_t) + entry.first->size() + sizeof(uint32_t) +
+              entry.second->buffers_.size() * 2 * sizeof(uint64_t);
+  }
+
+  auto align = [](uint64_t value) { return (value + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment; };
+
+  std::vector<uint64_t> buffer_offsets;
+  for (const auto& entry : entries) {
+    for (size_t size : entry.second->buffer_sizes_) {
+      offset = align(offset);
+      buffer_offsets.push_back(size == 0 ? 0 : offset);
+      offset += size;
+    }
+  }
+
+  // write to a temporary file first so concurrent readers never see a partial file
+  const PathString temp_file_path = file_path_ + ToPathString("." + std::to_string(env.GetSelfPid()) + ".tmp");
+  {
+    std::ofstream file(temp_file_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(file.good(), "Failed to open ", ToUTF8String(temp_file_path), " for writing.");
+
+    auto write = [&file](const void* data, size_t size) {
+      file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    };
+
+    const FileHeader header = MakeHeader(entries.size());
+    write(&header, sizeof(header));
+
+    size_t buffer_idx = 0;
+    for (const auto& entry : entries) {
+      const uint32_t key_length = static_cast<uint32_t>(entry.first->size());
+      const uint32_t num_buffers = static_cast<uint32_t>(entry.second->buffers_.size());
+      write(&key_length, sizeof(key_length));
+      write(entry.first->data(), key_length);
+      write(&num_buffers, sizeof(num_buffers));
+      for (size_t size : entry.second->buffer_sizes_) {
+        const uint64_t buffer_size = size;
+        write(&buffer_offsets[buffer_idx++], sizeof(uint64_t));
+        write(&buffer_size, sizeof(buffer_size));
+      }
+    }
+
+    const char padding[kBufferAlignment] = {};
+    buffer_idx = 0;
+    for (const auto& entry : entries) {
+      for (size_t i = 0; i < entry.second->buffers_.size(); ++i) {
+        const uint64_t buffer_offset = buffer_offsets[buffer_idx++];
+        const size_t size = entry.second->buffer_sizes_[i];
+        if (size == 0) {
+          continue;
+        }
+
+        const auto position = static_cast<uint64_t>(file.tellp());
+        write(padding, static_cast<size_t>(buffer_offset - position));
+        write(entry.second->buffers_[i].get(), size);
+      }
+    }
+
+    file.close();
+    if (file.fail()) {
+      RemoveFile(temp_file_path);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write ", ToUTF8String(temp_file_path));
+    }
+  }
+
+  if (RenameFile(temp_file_path, file_path_) != 0) {
+    // e.g. the file is mapped by another process on Windows. The other process keeps using its version.
+    RemoveFile(temp_file_path);
+    LOGS(logger, WARNING) << "Failed to replace pre-packed weights cache " << ToUTF8String(file_path_);
+    return Status::OK();
+  }
+
+  LOGS(logger, INFO) << "Saved " << entries.size() << " pre-packed weights to " << ToUTF8String(file_path_);
+  return Status::OK();
+}
+
+const PrePackedWeights* PrepackedWeightsFileCache::GetWeight(const std::string& key) const {
+  auto entry = loaded_weights_.find(key);
+  if (entry != loaded_weights_.end()) {
+    return &entry->second;
+  }
+
+  entry = new_weights_.find(key);
+  return entry != new_weights_.end() ? &entry->second : nullptr;
+}
+
+const PrePackedWeights& PrepackedWeightsFileCache::AddWeight(const std::string& key, PrePackedWeights&& weights) {
+  if (loaded_weights_.count(key) != 0 || new_weights_.count(key) != 0) {
+    unsaved_weights_.push_back(std::move(weights));
+    return unsaved_weights_.back();
+  }
+
+  return new_weights_.emplace(key, std::move(weights)).first->second;
+}
+
+}  // namespace onnxruntime
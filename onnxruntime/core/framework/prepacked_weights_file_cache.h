@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/common/path_string.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+class Node;
+class OpKernel;
+class Tensor;
+
+/**
+ * On-disk cache of the buffers produced by OpKernel::PrePack, so that other sessions (typically in other processes)
+ * loading the same model can skip pre-packing.
+ *
+ * The cache file is memory mapped, so processes using it share the physical pages of the pre-packed weights.
+ * A file written by a different version of onnxruntime or on a CPU with different features is ignored and
+ * replaced, as the layout of pre-packed buffers depends on both.
+ *
+ * Entries are keyed by the kernel, the input index, the node attributes and a hash of the constant initializer,
+ * so a single cache file can be shared between models.
+ */
+class PrepackedWeightsFileCache final {
+ public:
+  explicit PrepackedWeightsFileCache(PathString file_path) : file_path_(std::move(file_path)) {}
+
+  /**
+   * Maps the cache file into memory. A missing or incompatible file leaves the cache empty.
+   */
+  Status Load(const Env& env, const logging::Logger& logger);
+
+  /**
+   * Writes the loaded and the newly added weights to the cache file if any weight was added.
+   * The file is replaced by renaming a temporary file, so concurrent readers never see a partial file.
+   */
+  Status Save(const Env& env, const logging::Logger& logger) const;
+
+  // Returns an empty string if the initializer cannot be cached.
+  static std::string GenerateKey(const Node& node, const OpKernel& kernel, int input_idx, const Tensor& tensor);
+
+  // Returns nullptr if there is no cached weight for key.
+  const PrePackedWeights* GetWeight(const std::string& key) const;
+
+  // Takes ownership of weights packed in this session so they can be saved.
+  // The returned instance stays valid for the lifetime of the cache.
+  const PrePackedWeights& AddWeight(const std::string& key, PrePackedWeights&& weights);
+
+  size_t GetNumberOfLoadedWeights() const noexcept { return loaded_weights_.size(); }
+
+  bool HasNewWeights() const noexcept { return !new_weights_.empty(); }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsFileCache);
+
+ private:
+  const PathString file_path_;
+
+  // the loaded buffers point into mapped_file_
+  Env::MappedMemoryPtr mapped_file_;
+  std::unordered_map<std::string, PrePackedWeights> loaded_weights_;
+  std::unordered_map<std::string, PrePackedWeights> new_weights_;
+
+  // weights packed again because the kernel did not accept the loaded buffers. owned, but not saved.
+  std::list<PrePackedWeights> unsaved_weights_;
+};
+
+}  // namespace onnxruntime
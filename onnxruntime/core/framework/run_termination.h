@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class RunTermination;
+
+/**
+ * Counts the high priority Run() calls in flight in a session (see kOrtRunOptionsConfigPriority). The low priority
+ * runs wait before their next node while there are any, so that the nodes of the high priority runs get the intra-op
+ * thread pool. A waiting low priority run still stops once its terminate flag is set or its deadline has passed.
+ */
+class RunPriorityGate {
+ public:
+  RunPriorityGate() = default;
+
+  // Counts a high priority run while in scope. Does nothing if gate is nullptr.
+  class HighPriorityScope {
+   public:
+    explicit HighPriorityScope(RunPriorityGate* gate) : gate_(gate) {
+      if (gate_ != nullptr) {
+        gate_->num_high_priority_runs_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    ~HighPriorityScope() {
+      if (gate_ != nullptr && gate_->num_high_priority_runs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<OrtMutex> lock(gate_->mutex_);
+        gate_->cv_.notify_all();
+      }
+    }
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HighPriorityScope);
+
+   private:
+    RunPriorityGate* const gate_;
+  };
+
+  bool HasHighPriorityRuns() const noexcept {
+    return num_high_priority_runs_.load(std::memory_order_relaxed) > 0;
+  }
+
+  // Waits until there are no high priority runs, or until the run of termination must stop.
+  void Wait(const RunTermination& termination);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunPriorityGate);
+
+ private:
+  std::atomic<int> num_high_priority_runs_{0};
+  OrtMutex mutex_;
+  OrtCondVar cv_;
+};
+
+/**
+ * When a Run() must stop: once the terminate flag of its RunOptions is set, or once its deadline has passed.
+ * The executors check it before each node. The subgraphs of the control flow nodes (Loop, Scan, If) and of the
+ * BeamSearch and GreedySearch steps are run with the RunTermination of the node, so they stop within an iteration.
+ * It is small and copied by value into the executors and the kernel contexts.
+ * The sequential executor also uses it to make low priority runs yield to the high priority ones before each node.
+ */
+class RunTermination {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Never terminates.
+  RunTermination() = default;
+
+  // @param terminate_flag must outlive the run, and is read while it is running, e.g. RunOptions::terminate.
+  explicit RunTermination(const bool& terminate_flag, Clock::time_point deadline = Clock::time_point::max())
+      : terminate_flag_(&terminate_flag), deadline_(deadline) {}
+
+  bool HasDeadline() const noexcept { return deadline_ != Clock::time_point::max(); }
+
+  // Makes the run a low priority one, which yields to the high priority runs counted by gate at node boundaries.
+  // @param gate must outlive the run.
+  void SetPriorityGate(RunPriorityGate& gate) noexcept { priority_gate_ = &gate; }
+
+  // Called by the executors before each node. Waits while the run is a low priority one and there are high priority
+  // runs in flight.
+  void YieldToHighPriorityRuns() const {
+    if (priority_gate_ != nullptr && priority_gate_->HasHighPriorityRuns()) {
+      priority_gate_->Wait(*this);
+    }
+  }
+
+  bool IsTerminated() const noexcept {
+    return (terminate_flag_ != nullptr && *terminate_flag_) || (HasDeadline() && Clock::now() >= deadline_);
+  }
+
+  // FAIL if the terminate flag is set, TIMEOUT if the deadline has passed, OK otherwise.
+  common::Status Check() const {
+    if (terminate_flag_ != nullptr && *terminate_flag_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    }
+
+    if (HasDeadline() && Clock::now() >= deadline_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, TIMEOUT, "Exiting due to the deadline of the run having passed.");
+    }
+
+    return common::Status::OK();
+  }
+
+ private:
+  const bool* terminate_flag_ = nullptr;
+  Clock::time_point deadline_ = Clock::time_point::max();
+  RunPriorityGate* priority_gate_ = nullptr;
+};
+
+inline void RunPriorityGate::Wait(const RunTermination& termination) {
+  std::unique_lock<OrtMutex> lock(mutex_);
+  while (HasHighPriorityRuns() && !termination.IsTerminated()) {
+    // wake up periodically as the terminate flag and the deadline are not signaled
+    cv_.wait_for(lock, std::chrono::milliseconds(1));
+  }
+}
+
+}  // namespace onnxruntime
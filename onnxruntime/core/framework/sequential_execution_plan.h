@@ -29,12 +29,23 @@ struct AllocPlanPerValue {
   AllocKind alloc_kind{AllocKind::kNotSet};
   MLDataType value_type{nullptr};
   OrtMemoryInfo location;
-  // reused_buffer is valid only if alloc_kind == kReuse. It indicates
+  // reused_buffer is valid only if alloc_kind == kReuse or kSlice. It indicates
   // which OrtValue's buffer must be reused for this OrtValue.
   OrtValueIndex reused_buffer{0};
+  // slice_offset and reused_buffer_shape are valid only if alloc_kind == kSlice.
+  // The OrtValue starts slice_offset bytes into the buffer of reused_buffer, which
+  // is allocated with reused_buffer_shape if the OrtValue is allocated first, as the
+  // inputs of a Concat are allocated before its output.
+  size_t slice_offset{0};
+  std::vector<int64_t> reused_buffer_shape;
   // if the value is used in async kernel, a fence object would be created
   // note the fence object would be shared between MLValues reusing the same buffer
   bool create_fence_if_async{false};
+#ifdef ENABLE_STRIDED_TENSORS
+  // is_strided_tensor is valid only if alloc_kind == kReuse or kSlice. The OrtValue is a strided view of the
+  // buffer it reuses, so it may have more elements than the buffer, e.g. the output of Expand.
+  bool is_strided_tensor{false};
+#endif
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE) 
   IntervalT life_interval{0, 0};
   IntervalT allocate_interval{0, 0};
@@ -115,9 +126,18 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // Records whether a given node has fence on its input or output, key is node index.
   std::vector<bool> node_has_fence;
 
+  // The async queue each node runs on, key is node index. Only set when the planner assigned nodes to the
+  // compute streams of an execution provider with several of them, see IExecutionProvider::GetComputeQueueIds.
+  // Empty otherwise, and the nodes run on the queue of their kernel definition.
+  std::vector<int> node_queue_ids;
+
   // to_be_freed: vector elements represent indices of ml-values to be freed (as described above)
   std::vector<OrtValueIndex> to_be_freed;
 
+  // Peak memory of the activations in the execution order, estimated by the planner for the memory efficient
+  // execution order. Symbolic dimensions count as 1. 0 when not estimated.
+  size_t estimated_peak_activation_bytes = 0;
+
   const OrtMemoryInfo& GetLocation(size_t ort_value_index) const override {
     return allocation_plan[ort_value_index].location;
   }
@@ -138,6 +158,16 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   bool NodeHasFence(onnxruntime::NodeIndex node_index) const {
     return node_has_fence[node_index];
   }
+
+  // Whether the nodes are assigned to several compute streams.
+  bool IsMultiStream() const {
+    return !node_queue_ids.empty();
+  }
+
+  // The async queue a given node runs on, kernel_queue_id being the queue of its kernel definition.
+  int NodeQueueId(onnxruntime::NodeIndex node_index, int kernel_queue_id) const {
+    return node_queue_ids.empty() ? kernel_queue_id : node_queue_ids[node_index];
+  }
 };
 
 // Output details of an execution plan:
@@ -8,10 +8,12 @@
 #include <vector>
 #include <sstream>
 #include "core/common/common.h"
+#include "core/common/hardware_counters.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shape_statistics.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
 
@@ -136,11 +138,179 @@ static void CalculateTotalInputSizes(const OpKernelContextInternal* op_kernel_co
   input_type_shape = ss.str();
 }
 
+// Estimates the floating point operations of a kernel from the shapes of its inputs and outputs: 2 per multiply-add
+// for the matrix multiplications and convolutions, 1 per output element for the other ops.
+static int64_t EstimateFlops(OpKernelContextInternal* op_kernel_context, const onnxruntime::OpKernel* p_op_kernel) {
+  int64_t output_elements = 0;
+  for (int i = 0; i < op_kernel_context->OutputCount(); i++) {
+    const OrtValue* p_output = op_kernel_context->GetOutputMLValue(i);
+    if (p_output != nullptr && p_output->IsTensor()) {
+      output_elements += p_output->Get<Tensor>().Shape().Size();
+    }
+  }
+
+  auto input_shape = [op_kernel_context](int index) -> const TensorShape* {
+    if (index >= op_kernel_context->InputCount()) {
+      return nullptr;
+    }
+    const OrtValue* p_input = op_kernel_context->GetInputMLValue(index);
+    return p_input != nullptr && p_input->IsTensor() ? &p_input->Get<Tensor>().Shape() : nullptr;
+  };
+
+  // elements of a filter per output channel, i.e. the multiply-adds per element of a convolution output
+  auto filter_size = [](const TensorShape* weight_shape) -> int64_t {
+    return weight_shape != nullptr && weight_shape->NumDimensions() > 0 && (*weight_shape)[0] > 0
+               ? weight_shape->Size() / (*weight_shape)[0]
+               : 0;
+  };
+
+  const auto& op_type = p_op_kernel->Node().OpType();
+  if (op_type == "MatMul" || op_type == "FusedMatMul" || op_type == "MatMulInteger" ||
+      op_type == "MatMulIntegerToFloat" || op_type == "DynamicQuantizeMatMul" || op_type == "QLinearMatMul") {
+    const auto* a_shape = input_shape(0);
+    if (a_shape != nullptr && a_shape->NumDimensions() > 0) {
+      return 2 * output_elements * (*a_shape)[a_shape->NumDimensions() - 1];
+    }
+  } else if (op_type == "Gemm" || op_type == "FusedGemm") {
+    const auto* a_shape = input_shape(0);
+    if (a_shape != nullptr && a_shape->NumDimensions() == 2) {
+      const bool trans_a = p_op_kernel->Info().GetAttrOrDefault<int64_t>("transA", 0) != 0;
+      return 2 * output_elements * (*a_shape)[trans_a ? 0 : 1];
+    }
+  } else if (op_type == "Conv" || op_type == "FusedConv" || op_type == "ConvInteger" || op_type == "NhwcConv") {
+    return 2 * output_elements * filter_size(input_shape(1));
+  } else if (op_type == "QLinearConv") {
+    return 2 * output_elements * filter_size(input_shape(3));
+  } else if (op_type == "ConvTranspose") {
+    // every input element is multiplied with the filters of its group
+    const auto* x_shape = input_shape(0);
+    if (x_shape != nullptr) {
+      return 2 * x_shape->Size() * filter_size(input_shape(1));
+    }
+  }
+
+  return output_elements;
+}
+
 static Status ReleaseNodeMLValues(ExecutionFrame& frame,
                                   const SequentialExecutionPlan& seq_exec_plan,
                                   const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
                                   const logging::Logger& logger);
 
+// The flat execution plan skips the instrumentation hooks of the regular loop.
+#if defined(CONCURRENCY_VISUALIZER) || defined(ENABLE_NVTX_PROFILE) || defined(DEBUG_NODE_INPUTS_OUTPUTS) || \
+    defined(ONNXRUNTIME_ENABLE_INSTRUMENT)
+static constexpr bool kFlatExecutionPlanSupported = false;
+#else
+static constexpr bool kFlatExecutionPlanSupported = true;
+#endif
+
+// Run the kernels of a flat execution plan. Equivalent to the regular loop in Execute when there are no fences
+// and profiling is disabled.
+static Status ExecuteFlatExecutionPlan(const SessionState& session_state,
+                                       const std::vector<FlatExecutionStep>& flat_execution_plan,
+                                       ExecutionFrame& frame, const RunTermination& termination,
+                                       const logging::Logger& logger) {
+  for (const auto& step : flat_execution_plan) {
+    termination.YieldToHighPriorityRuns();
+    if (termination.IsTerminated()) {
+      Status termination_status = termination.Check();
+      LOGS(logger, WARNING) << termination_status.ErrorMessage();
+      return termination_status;
+    }
+
+    const OpKernel& op_kernel = *step.kernel;
+    OpKernelContextInternal op_kernel_context(session_state, frame, op_kernel, logger, termination);
+
+    Status compute_status;
+    concurrency::ParallelForTuner::KernelScope tuning_scope(
+        session_state.GetParallelForTuner(), utils::GetParallelForTuningKey(session_state, op_kernel_context));
+    ORT_TRY {
+#ifdef ENABLE_TRAINING
+      if (op_kernel.KernelDef().AllocateInputsContiguously()) {
+        ORT_RETURN_IF_ERROR(utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context));
+      }
+#endif
+
+      compute_status = op_kernel.Compute(&op_kernel_context);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        compute_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    if (!compute_status.IsOK()) {
+      const auto& node = op_kernel.Node();
+      std::ostringstream ss;
+      ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
+         << "' Status Message: " << compute_status.ErrorMessage();
+      const auto msg_string = ss.str();
+      LOGS(logger, ERROR) << msg_string;
+      return Status(compute_status.Category(), compute_status.Code(), msg_string);
+    }
+
+    for (size_t i = 0; i < step.num_values_to_free; ++i) {
+      ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(step.values_to_free[i]));
+    }
+  }
+
+  return Status::OK();
+}
+
+// Fetches the outputs of a run and caches the memory patterns it generated.
+static Status FinishExecution(const SessionState& session_state, const std::vector<OrtValue>& feeds,
+                              ExecutionFrame& frame, std::vector<OrtValue>& fetches, const logging::Logger& logger) {
+  VLOGS(logger, 1) << "Fetching output.";
+  // ExecutionFrame::Finalize will update 'fetches' with the final output
+  ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
+  VLOGS(logger, 1) << "Done with execution.";
+
+  if (const auto* memory_timeline = frame.GetMemoryTimeline()) {
+    const auto memory_timeline_file = session_state.NextMemoryTimelineFile();
+    auto status = memory_timeline->WriteChromeTrace(memory_timeline_file, session_state);
+    if (!status.IsOK()) {
+      LOGS(logger, WARNING) << "Failed to write the memory timeline: " << status.ErrorMessage();
+    }
+  }
+
+#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
+  MemoryInfo::MemoryInfoProfile::CreateEvents("dynamic activations_" + std::to_string(MemoryInfo::GetIteration()),
+                                              MemoryInfo::MemoryInfoProfile::GetAndIncreasePid(), MemoryInfo::MapType::DynamicActivation, "", 0);
+  MemoryInfo::MemoryInfoProfile::Clear();
+#endif
+
+  if (frame.HasMemoryPatternPlanner()) {
+    bool all_tensors = true;
+    for (const auto& feed : feeds) {
+      if (!(feed.IsTensor())) {
+        all_tensors = false;
+        break;
+      }
+    }
+
+    if (all_tensors) {
+      auto mem_patterns = std::make_unique<MemoryPatternGroup>();
+      ORT_RETURN_IF_ERROR(frame.GeneratePatterns(mem_patterns.get()));
+      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+    }
+  }
+
+#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
+  for (auto i : frame.GetStaticMemorySizeInfo()) {
+    LOGS(logger, INFO) << "[Memory] ExecutionFrame statically allocates "
+                       << i.second << " bytes for " << i.first << std::endl;
+  }
+
+  for (auto i : frame.GetDynamicMemorySizeInfo()) {
+    LOGS(logger, INFO) << "[Memory] ExecutionFrame dynamically allocates "
+                       << i.second << " bytes for " << i.first << std::endl;
+  }
+#endif
+
+  return Status::OK();
+}
+
 Status SequentialExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
                                    const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
                                    std::vector<OrtValue>& fetches,
@@ -160,6 +330,19 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     tp = session_state.Profiler().Start();
   }
 
+  // one in sample rate runs times its kernels for the op latency histograms
+  auto* const op_latency_histograms = session_state.OpLatencyHistograms();
+  const bool sample_op_latencies = op_latency_histograms != nullptr && op_latency_histograms->ShouldSampleRun();
+  TimePoint sampled_kernel_begin_time;
+  profiling::HardwareCounterValues counters_begin;
+
+  // and one in its own sample rate records the shapes
+  auto* const shape_statistics = session_state.GetShapeStatistics();
+  const bool sample_shapes = shape_statistics != nullptr && shape_statistics->ShouldSampleRun();
+  if (sample_shapes) {
+    shape_statistics->RecordInputs(feed_mlvalue_idxs, feeds, session_state.GetOrtValueNameIdxMap());
+  }
+
   ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -176,6 +359,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   LOGS(logger, INFO) << "Begin execution";
   const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
   const auto& exec_plan_vec = seq_exec_plan.execution_plan;
+  const auto* flat_execution_plan = session_state.GetFlatExecutionPlan();
   VLOGS(logger, 1) << "Size of execution plan vector: " << exec_plan_vec.size();
 
 // Enable TRACE_EXECUTION compile flag to dump execution plan
@@ -213,10 +397,26 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 #endif
 
 
+#if !defined(ORT_MINIMAL_BUILD)
+  const bool use_flat_execution_plan = kFlatExecutionPlanSupported && flat_execution_plan != nullptr &&
+                                       !is_profiler_enabled && !sample_op_latencies && !sample_shapes &&
+                                       !only_execute_path_to_fetches;
+#else
+  const bool use_flat_execution_plan = kFlatExecutionPlanSupported && flat_execution_plan != nullptr &&
+                                       !is_profiler_enabled && !sample_op_latencies && !sample_shapes;
+#endif
+
+  if (use_flat_execution_plan) {
+    ORT_RETURN_IF_ERROR(ExecuteFlatExecutionPlan(session_state, *flat_execution_plan, frame, termination_, logger));
+    return FinishExecution(session_state, feeds, frame, fetches, logger);
+  }
+
   for (const auto& node_exec_plan : exec_plan_vec) {
-    if (terminate_flag_) {
-      LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    termination_.YieldToHighPriorityRuns();
+    if (termination_.IsTerminated()) {
+      Status termination_status = termination_.Check();
+      LOGS(logger, WARNING) << termination_status.ErrorMessage();
+      return termination_status;
     }
 
     auto node_index = node_exec_plan.node_index;
@@ -259,14 +459,17 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 #endif
     // construct OpKernelContext
     // TODO: log kernel inputs?
-    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, terminate_flag_);
+    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, termination_);
     // TODO: log kernel outputs?
     if (is_profiler_enabled) {
       sync_time_begin = session_state.Profiler().Start();
     }
 
     // sync before compute
-    int queue_id = p_op_kernel->KernelDef().ExecQueueId();
+    int queue_id = seq_exec_plan.NodeQueueId(node_index, p_op_kernel->KernelDef().ExecQueueId());
+    if (seq_exec_plan.IsMultiStream()) {
+      ORT_RETURN_IF_ERROR(p_op_kernel->Info().GetExecutionProvider()->SetCurrentComputeQueue(queue_id));
+    }
     if (seq_exec_plan.NodeHasFence(node_index)) {
       for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
         Fence_t fence = op_kernel_context.InputFence(input_index);
@@ -325,6 +528,13 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                node_name_for_profiling, input_type_shape);
     }
 
+    if (sample_op_latencies) {
+      sampled_kernel_begin_time = std::chrono::high_resolution_clock::now();
+    }
+
+    const bool read_hardware_counters = is_profiler_enabled && session_state.Profiler().HardwareCountersEnabled() &&
+                                        profiling::HardwareCounters::ForCurrentThread().Read(counters_begin);
+
     Status compute_status;
     {
 #ifdef CONCURRENCY_VISUALIZER
@@ -335,6 +545,8 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
           MakeString(node.OpType(), ".", node.Index(), "(", node.Name(), ")"), profile::Color::Yellow);
       node_compute_range.Begin();
 #endif
+      concurrency::ParallelForTuner::KernelScope tuning_scope(
+          session_state.GetParallelForTuner(), utils::GetParallelForTuningKey(session_state, op_kernel_context));
       ORT_TRY {
 #ifdef ENABLE_TRAINING
         if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
@@ -369,7 +581,20 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       return Status(compute_status.Category(), compute_status.Code(), msg_string);
     }
 
+    if (sample_op_latencies) {
+      op_latency_histograms->Record(node.OpType(), TimeDiffMicroSeconds(sampled_kernel_begin_time));
+    }
+
+    if (sample_shapes) {
+      shape_statistics->RecordNodeOutputs(node.Index(), op_kernel_context);
+    }
+
     if (is_profiler_enabled) {
+      profiling::HardwareCounterValues counters_end;
+      const bool has_hardware_counters =
+          read_hardware_counters && profiling::HardwareCounters::ForCurrentThread().Read(counters_end);
+      const long long kernel_duration_us = TimeDiffMicroSeconds(kernel_begin_time);
+
       // Calculate total output sizes for this operation.
       CalculateTotalOutputSizes(&op_kernel_context, total_output_sizes, node_name_for_profiling, output_type_shape);
 
@@ -386,22 +611,50 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                 << "\n";
 #endif
 
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     node_name_for_profiling + "_kernel_time",
-                                                     kernel_begin_time,
-                                                     // Log additional operation args / info.
-                                                     {
-                                                         {"op_name", p_op_kernel->KernelDef().OpName()},
-                                                         {"provider", p_op_kernel->KernelDef().Provider()},
-                                                         {"graph_index", std::to_string(p_op_kernel->Node().Index())},
-                                                         {"exec_plan_index", std::to_string(node_index)},
-                                                         {"activation_size", std::to_string(input_activation_sizes)},
-                                                         {"parameter_size", std::to_string(input_parameter_sizes)},
-                                                         {"output_size", std::to_string(total_output_sizes)},
-                                                         {"input_type_shape", input_type_shape},
-                                                         {"output_type_shape", output_type_shape},
-                                                         {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())},
-                                                     });
+      // Log additional operation args / info.
+      std::unordered_map<std::string, std::string> event_args{
+          {"op_name", p_op_kernel->KernelDef().OpName()},
+          {"provider", p_op_kernel->KernelDef().Provider()},
+          {"graph_index", std::to_string(p_op_kernel->Node().Index())},
+          {"exec_plan_index", std::to_string(node_index)},
+          {"activation_size", std::to_string(input_activation_sizes)},
+          {"parameter_size", std::to_string(input_parameter_sizes)},
+          {"output_size", std::to_string(total_output_sizes)},
+          {"input_type_shape", input_type_shape},
+          {"output_type_shape", output_type_shape},
+          {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())},
+      };
+
+      // achieved throughput, with the bytes moved estimated by the sizes of the inputs and outputs
+      const int64_t flops = EstimateFlops(&op_kernel_context, p_op_kernel);
+      event_args.emplace("flops", std::to_string(flops));
+      if (kernel_duration_us > 0) {
+        const size_t bytes = input_activation_sizes + input_parameter_sizes + total_output_sizes;
+        event_args.emplace("gflops_per_s", std::to_string(flops / (kernel_duration_us * 1e3)));
+        event_args.emplace("gb_per_s", std::to_string(bytes / (kernel_duration_us * 1e3)));
+      }
+
+      if (has_hardware_counters) {
+        const uint64_t llc_misses = counters_end.llc_misses - counters_begin.llc_misses;
+        event_args.emplace("cycles", std::to_string(counters_end.cycles - counters_begin.cycles));
+        event_args.emplace("instructions", std::to_string(counters_end.instructions - counters_begin.instructions));
+        event_args.emplace("llc_misses", std::to_string(llc_misses));
+        event_args.emplace("llc_miss_bytes", std::to_string(llc_misses * profiling::HardwareCounters::kCacheLineSize));
+      }
+
+      session_state.Profiler().EndTimeAndRecordEventWithArgs(profiling::NODE_EVENT,
+                                                             node_name_for_profiling + "_kernel_time",
+                                                             kernel_begin_time,
+                                                             std::move(event_args));
+
+      // the work of the intra-op threads, shown on their own tracks to expose the idle gaps of the pool
+      for (const auto& span : concurrency::ThreadPool::TakeProfilingSpans(session_state.GetThreadPool())) {
+        session_state.Profiler().RecordEvent(
+            profiling::THREAD_POOL_EVENT,
+            node_name_for_profiling + (span.is_parallel_loop ? "_parallel_loop" : "_task"),
+            span.thread_id, span.start, span.end,
+            {{"op_name", p_op_kernel->KernelDef().OpName()}});
+      }
       sync_time_begin = session_state.Profiler().Start();
     }
 
@@ -457,6 +710,13 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
   }
 
+  // the outputs are copied to the caller on the default compute stream of each provider
+  if (seq_exec_plan.IsMultiStream()) {
+    for (const auto& execution_provider : session_state.GetExecutionProviders()) {
+      ORT_RETURN_IF_ERROR(execution_provider->JoinComputeQueues());
+    }
+  }
+
 #ifdef ENABLE_NVTX_PROFILE
   // Make sure forward Range object call Begin and End.
   if (!forward_range.IsBeginCalled()) {
@@ -474,49 +734,22 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   }
 #endif
 
-  VLOGS(logger, 1) << "Fetching output.";
-  // ExecutionFrame::Finalize will update 'fetches' with the final output
-  ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
-  VLOGS(logger, 1) << "Done with execution.";
-
-#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
-  MemoryInfo::MemoryInfoProfile::CreateEvents("dynamic activations_" + std::to_string(MemoryInfo::GetIteration()),
-                                              MemoryInfo::MemoryInfoProfile::GetAndIncreasePid(), MemoryInfo::MapType::DynamicActivation, "", 0);
-  MemoryInfo::MemoryInfoProfile::Clear();
-#endif
-
-  if (frame.HasMemoryPatternPlanner()) {
-    bool all_tensors = true;
-    for (const auto& feed : feeds) {
-      if (!(feed.IsTensor())) {
-        all_tensors = false;
-        break;
-      }
-    }
-
-    if (all_tensors) {
-      auto mem_patterns = std::make_unique<MemoryPatternGroup>();
-      ORT_RETURN_IF_ERROR(frame.GeneratePatterns(mem_patterns.get()));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
-    }
-  }
+  ORT_RETURN_IF_ERROR(FinishExecution(session_state, feeds, frame, fetches, logger));
 
   if (is_profiler_enabled) {
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp);
-  }
-
-#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
-  for (auto i : frame.GetStaticMemorySizeInfo()) {
-    LOGS(logger, INFO) << "[Memory] ExecutionFrame statically allocates "
-                       << i.second << " bytes for " << i.first << std::endl;
+    const auto mem_pattern_cache_stats = session_state.GetMemoryPatternCacheStats();
+    const auto frame_pool_stats = session_state.GetExecutionFramePoolStats();
+    session_state.Profiler().EndTimeAndRecordEvent(
+        profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp,
+        {{"mem_pattern_cache_hits", std::to_string(mem_pattern_cache_stats.num_hits)},
+         {"mem_pattern_cache_misses", std::to_string(mem_pattern_cache_stats.num_misses)},
+         {"mem_pattern_cache_evictions", std::to_string(mem_pattern_cache_stats.num_evictions)},
+         {"mem_pattern_cache_entries", std::to_string(mem_pattern_cache_stats.num_entries)},
+         {"num_allocations", std::to_string(frame.GetNumAllocations())},
+         {"frame_pool_hits", std::to_string(frame_pool_stats.num_hits)},
+         {"frame_pool_misses", std::to_string(frame_pool_stats.num_misses)}});
   }
 
-  for (auto i : frame.GetDynamicMemorySizeInfo()) {
-    LOGS(logger, INFO) << "[Memory] ExecutionFrame dynamically allocates "
-                       << i.second << " bytes for " << i.first << std::endl;
-  }
-#endif
-
   return Status::OK();
 }
 
@@ -15,8 +15,9 @@
 namespace onnxruntime {
 
 enum class ExecutionOrder {
-  DEFAULT = 0,        // default topological sort
-  PRIORITY_BASED = 1  // priority-based topological sort
+  DEFAULT = 0,           // default topological sort
+  PRIORITY_BASED = 1,    // priority-based topological sort
+  MEMORY_EFFICIENT = 2,  // greedy order of the allocation planner keeping the memory of the activations low
 };
 
 enum class FreeDimensionOverrideType {
@@ -3,6 +3,7 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
@@ -16,6 +17,7 @@
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/session_state_flatbuffers_utils.h"
 #include "core/framework/session_state_utils.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -296,118 +298,193 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
+PrepackedWeightsFileCache* SessionState::GetPrepackedWeightsFileCache() const {
+  const SessionState* root = this;
+  while (root->parent_ != nullptr) {
+    root = root->parent_;
+  }
+
+  return root->prepacked_weights_file_cache_.get();
+}
+
+Status SessionState::PrepackUsingFileCache(PrepackedWeightsFileCache& cache, OpKernel& kernel, const Node& node,
+                                           int input_idx, const Tensor& tensor, bool& is_packed) {
+  is_packed = false;
+  const std::string key = PrepackedWeightsFileCache::GenerateKey(node, kernel, input_idx, tensor);
+
+  if (!key.empty()) {
+    if (const PrePackedWeights* cached_weights = cache.GetWeight(key)) {
+      std::vector<BufferUniquePtr> cached_buffers;
+      cached_buffers.reserve(cached_weights->buffers_.size());
+      for (const auto& buffer : cached_weights->buffers_) {
+        // the buffers are owned by the cache
+        cached_buffers.emplace_back(buffer.get(), BufferDeleter(nullptr));
+      }
+
+      bool used_cached_buffers = false;
+      ORT_RETURN_IF_ERROR(kernel.UseCachedPrePackedBuffers(tensor, cached_buffers, input_idx, used_cached_buffers));
+      if (used_cached_buffers) {
+        LOGS(logger_, VERBOSE) << "Using pre-packed weight from the cache file for constant initializer "
+                               << node.InputDefs()[input_idx]->Name() << " used in the node: " << node.Name();
+        is_packed = true;
+        ++used_cached_pre_packed_weights_counter_;
+        return Status::OK();
+      }
+    }
+  }
+
+  AllocatorPtr session_cpu_alloc = kernel.Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
+  PrePackedWeights weights_to_be_filled_in;
+  ORT_RETURN_IF_ERROR(kernel.PrePack(tensor, input_idx, session_cpu_alloc, is_packed,
+                                     key.empty() ? nullptr : &weights_to_be_filled_in));
+
+  // kernels that can't hand out their pre-packed buffers keep them
+  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(kernel, input_idx,
+                                                        cache.AddWeight(key, std::move(weights_to_be_filled_in)),
+                                                        node.Name()));
+  }
+
+  return Status::OK();
+}
+
 Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count,
-                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
-                  // weight with the pre-packed weight generated by this instance of the same op_type because other static
-                  // properties of the node like node attributes could play a role in the pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
-                                                                                                           weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
-
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
-
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-                    } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
-
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
-                      }
-
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
-                    }
-                  }
-
-                } else {  // caching of pre-packed weights' turned OFF
-                  AllocatorPtr session_cpu_alloc = kernel->Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
-                                                      session_cpu_alloc,  // use allocator tied to this session
-                                                      is_packed,
-                                                      nullptr  // no caching required
-                                                      ));
-                }
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
-
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
-                  }
-                }
-              }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
-              }
+                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                                       bool skip_external_initializers,
+                                                       bool share_initializers_by_content) {
+  PrepackedWeightsFileCache* file_cache = GetPrepackedWeightsFileCache();
+
+  // a constant initialized tensor consumed by a kernel
+  struct ConstantInput {
+    const Node* node;
+    OpKernel* kernel;
+    int input_idx;
+    const Tensor* tensor;
+    SessionState* st;
+    int ort_value_idx;
+    bool is_packed;
+    Status status;
+  };
+
+  std::vector<ConstantInput> constant_inputs;
+  for (auto& node : GetGraphViewer().Nodes()) {
+    auto kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        // subgraph can use the value from outer scope,
+        // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            auto constant = st->constant_initialized_tensors_.find(ort_value_idx);
+            const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+            if (skip_external_initializers && constant != st->constant_initialized_tensors_.end() &&
+                st->graph_.GetInitializedTensor(input_name, tensor_proto) && utils::HasExternalData(*tensor_proto)) {
+              // packing would page in the whole tensor and copy it to memory that can't be evicted
+              constant = st->constant_initialized_tensors_.end();
+            }
+            if (constant != st->constant_initialized_tensors_.end()) {
+              constant_inputs.push_back(ConstantInput{&node, kernel, input_idx, &constant->second.Get<Tensor>(), st,
+                                                      ort_value_idx, false, Status::OK()});
             }
-            st = st->Parent();
-          } while (st);
+            // stop searching in 2 cases:
+            // 1. value is not from OuterScope
+            // 2. value is from OuterScope and the current OuterScope has the value
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+        } while (st);
+      }
+      input_idx++;
+    }
+  }
+
+  auto prepack_constant_weight = [this, &initializers_to_share_map, file_cache, share_initializers_by_content](
+                                     ConstantInput& constant_input,
+                                     bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    const Node& node = *constant_input.node;
+    OpKernel* kernel = constant_input.kernel;
+    const int input_idx = constant_input.input_idx;
+    const std::string& input_name = node.InputDefs()[input_idx]->Name();
+    bool& is_packed = constant_input.is_packed;
+    const Tensor& const_initialized_tensor = *constant_input.tensor;
+
+    // initializers shared by content are held by the container, so their pre-packed weights are cached too
+    auto iter = initializers_to_share_map.find(input_name);
+    bool is_shared_initializer = (iter != initializers_to_share_map.end()) || share_initializers_by_content;
+
+    // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+    if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+        node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
+
+      AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+      ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+      PrePackedWeights weights_to_be_filled_in;
+      // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+      // cached by another instance of the same op_type (for the same constant initializer) is because
+      // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
+      // weight with the pre-packed weight generated by this instance of the same op_type because other static
+      // properties of the node like node attributes could play a role in the pre-packed weights' contents.
+      ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                          is_packed,
+                                          &weights_to_be_filled_in));
+
+      if (is_packed) {
+        // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
+        ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
+                    " doesn't have an implementation that can cache computed pre-packed weights");
+
+        const auto& op_type = node.OpType();
+
+        // Sanity check
+        // TODO: Check if some version of the ONNX IR allows op_type to be empty
+        ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+
+        // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+        // that we just got by invoking PrePack() on this kernel.
+
+        const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
+                                                                                               weights_to_be_filled_in);
+
+        bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
+
+        if (container_contains_packed_weight) {
+          LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
+                              << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
+
+          ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                              prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                              node.Name()));
+
+          ++used_shared_pre_packed_weights_counter_;
+        } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
+
+          if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
+            return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
+          }
+
+          ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                              prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                              node.Name()));
         }
-        input_idx++;
       }
+
+    } else if (file_cache != nullptr && node.GetExecutionProviderType() == kCpuExecutionProvider) {
+      ORT_RETURN_IF_ERROR(PrepackUsingFileCache(*file_cache, *kernel, node, input_idx,
+                                                const_initialized_tensor, is_packed));
+    } else {  // caching of pre-packed weights' turned OFF
+      AllocatorPtr session_cpu_alloc = kernel->Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
+      ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
+                                          session_cpu_alloc,  // use allocator tied to this session
+                                          is_packed,
+                                          nullptr  // no caching required
+                                          ));
     }
 
     return Status::OK();
@@ -419,18 +496,281 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<onnxruntime::OrtMutex> l(prepacked_weights_container_->mutex_);
-    return prepacked_constant_weights(true);
+    for (auto& constant_input : constant_inputs) {
+      ORT_RETURN_IF_ERROR(prepack_constant_weight(constant_input, true));
+    }
   } else {
-    return prepacked_constant_weights(false);
+    // without a cache, the kernels of the CPU EP only touch their own state and the thread safe session allocator
+    // when pre-packing, so different kernels pre-pack in parallel. the inputs of a kernel are pre-packed in order.
+    std::vector<std::pair<size_t, size_t>> parallel_kernels;
+    if (file_cache == nullptr) {
+      for (size_t begin = 0, end = 0; begin < constant_inputs.size(); begin = end) {
+        end = begin + 1;
+        while (end < constant_inputs.size() && constant_inputs[end].kernel == constant_inputs[begin].kernel) {
+          ++end;
+        }
+        if (constant_inputs[begin].node->GetExecutionProviderType() == kCpuExecutionProvider) {
+          parallel_kernels.emplace_back(begin, end);
+        }
+      }
+    }
+
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool_, static_cast<std::ptrdiff_t>(parallel_kernels.size()),
+        [&](std::ptrdiff_t i) {
+          for (size_t j = parallel_kernels[i].first; j < parallel_kernels[i].second; ++j) {
+            constant_inputs[j].status = prepack_constant_weight(constant_inputs[j], false);
+            if (!constant_inputs[j].status.IsOK()) {
+              break;
+            }
+          }
+        });
+
+    size_t next_parallel_kernel = 0;
+    for (size_t j = 0; j < constant_inputs.size(); ++j) {
+      if (next_parallel_kernel < parallel_kernels.size() && parallel_kernels[next_parallel_kernel].first == j) {
+        j = parallel_kernels[next_parallel_kernel++].second - 1;
+        continue;
+      }
+      constant_inputs[j].status = prepack_constant_weight(constant_inputs[j], false);
+      ORT_RETURN_IF_ERROR(constant_inputs[j].status);
+    }
+  }
+
+  for (auto& constant_input : constant_inputs) {
+    ORT_RETURN_IF_ERROR(constant_input.status);
+    if (constant_input.is_packed) {
+      ++number_of_prepacks_counter_;
+
+      const std::string& input_name = constant_input.node->InputDefs()[constant_input.input_idx]->Name();
+      if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+        // release the constant initialized tensor
+        constant_input.st->initialized_tensors_.erase(constant_input.ort_value_idx);
+        constant_input.st->constant_initialized_tensors_.erase(constant_input.ort_value_idx);
+      }
+    }
   }
+
+  return Status::OK();
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
+int64_t SessionState::CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) const {
+  const int64_t bucket_size = mem_pattern_cache_options_.shape_bucket_size;
+
+  // combine as in boost::hash_combine so that permuted shapes don't collide
+  uint64_t key = 0;
   for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    key ^= dims.size() + 0x9e3779b9 + (key << 6) + (key >> 2);
+    for (size_t i = 0; i < dims.size(); ++i) {
+      int64_t dim = dims[i];
+      if (bucket_size > 0 && i > 0 && dim > 0) {
+        dim = (dim + bucket_size - 1) / bucket_size * bucket_size;
+      }
+      key ^= static_cast<uint64_t>(dim) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    }
   }
-  return key;
+
+  return static_cast<int64_t>(key);
+}
+
+void SessionState::SetMemoryPatternCacheOptions(const MemoryPatternCacheOptions& options) {
+  mem_pattern_cache_options_ = options;
+#ifdef ENABLE_TRAINING
+  // the shapes inferred along with the patterns must match the actual input shapes
+  if (mem_pattern_cache_options_.shape_bucket_size > 0) {
+    LOGS(logger_, WARNING) << "Memory pattern shape bucketing is not supported in training builds and is ignored.";
+    mem_pattern_cache_options_.shape_bucket_size = 0;
+  }
+#endif
+}
+
+void SessionState::ComputeNodePriorities() {
+  node_priorities_.assign(graph_viewer_->MaxNodeIndex(), 0);
+
+  // every node costs the same as there is no cost model, so the priority is the number of nodes on the longest
+  // path from the node to a graph output
+  const auto& topological_order = graph_viewer_->GetNodesInTopologicalOrder();
+  for (auto it = topological_order.rbegin(); it != topological_order.rend(); ++it) {
+    const Node* node = graph_viewer_->GetNode(*it);
+    int64_t longest_path = 0;
+    for (auto edge = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); edge != end; ++edge) {
+      longest_path = std::max(longest_path, node_priorities_[edge->GetNode().Index()]);
+    }
+
+    node_priorities_[*it] = longest_path + 1;
+  }
+}
+
+void SessionState::CreateFlatExecutionPlan() {
+  const SequentialExecutionPlan& plan = *p_seq_exec_plan_;
+  flat_execution_plan_.clear();
+  flat_execution_plan_.reserve(plan.execution_plan.size());
+
+  // the switching between compute streams is left to the regular execution loop, as the fence handling below
+  if (plan.IsMultiStream()) {
+    LOGS(logger_, INFO) << "Not using a flat execution plan as the nodes run on several compute streams.";
+    return;
+  }
+
+  for (const auto& node_plan : plan.execution_plan) {
+    // the fence handling is left to the regular execution loop
+    if (plan.NodeHasFence(node_plan.node_index)) {
+      LOGS(logger_, INFO) << "Not using a flat execution plan as node " << node_plan.node_index << " has fences.";
+      flat_execution_plan_.clear();
+      return;
+    }
+
+    FlatExecutionStep step;
+    step.kernel = GetKernel(node_plan.node_index);
+    ORT_ENFORCE(step.kernel != nullptr, "Missing kernel for node ", node_plan.node_index);
+    if (node_plan.free_to_index >= node_plan.free_from_index) {
+      step.values_to_free = plan.to_be_freed.data() + node_plan.free_from_index;
+      step.num_values_to_free = static_cast<size_t>(node_plan.free_to_index - node_plan.free_from_index + 1);
+    }
+
+    flat_execution_plan_.push_back(step);
+  }
+
+  has_flat_execution_plan_ = true;
+}
+
+MemoryPatternCacheStats SessionState::GetMemoryPatternCacheStats() const {
+  MemoryPatternCacheStats stats;
+  stats.num_hits = mem_pattern_cache_hits_.load(std::memory_order_relaxed);
+  stats.num_misses = mem_pattern_cache_misses_.load(std::memory_order_relaxed);
+  stats.num_evictions = mem_pattern_cache_evictions_.load(std::memory_order_relaxed);
+  stats.num_entries = std::atomic_load(&mem_patterns_)->size();
+  return stats;
+}
+
+BufferUniquePtr SessionState::TakeMemoryPatternBuffer(const OrtMemoryInfo& location, size_t size,
+                                                      size_t& buffer_size) const {
+  std::lock_guard<OrtMutex> lock(mem_pattern_buffers_lock_);
+  auto it = mem_pattern_buffers_.find(location);
+  if (it == mem_pattern_buffers_.end()) {
+    return nullptr;
+  }
+
+  // take the smallest buffer that is large enough, so the larger ones stay available for the larger patterns
+  auto& buffers = it->second;
+  auto best = buffers.end();
+  for (auto b = buffers.begin(); b != buffers.end(); ++b) {
+    if (b->size >= size && (best == buffers.end() || b->size < best->size)) {
+      best = b;
+    }
+  }
+
+  if (best == buffers.end()) {
+    // none is large enough. free the smallest one so the number of buffers stays bounded by the concurrent runs,
+    // the caller allocates a larger one that is returned in its place.
+    auto smallest = std::min_element(buffers.begin(), buffers.end(),
+                                     [](const MemoryPatternBuffer& a, const MemoryPatternBuffer& b) {
+                                       return a.size < b.size;
+                                     });
+    if (smallest != buffers.end()) {
+      buffers.erase(smallest);
+    }
+    return nullptr;
+  }
+
+  BufferUniquePtr buffer = std::move(best->buffer);
+  buffer_size = best->size;
+  buffers.erase(best);
+  return buffer;
+}
+
+void SessionState::ReturnMemoryPatternBuffer(const OrtMemoryInfo& location, BufferUniquePtr buffer,
+                                             size_t buffer_size) const {
+  if (buffer == nullptr) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mem_pattern_buffers_lock_);
+  mem_pattern_buffers_[location].push_back(MemoryPatternBuffer{std::move(buffer), buffer_size});
+}
+
+std::vector<OrtValue> SessionState::TakeExecutionFrameValues() const {
+  std::lock_guard<OrtMutex> lock(execution_frame_values_lock_);
+  if (execution_frame_values_.empty()) {
+    ++execution_frame_pool_stats_.num_misses;
+    return {};
+  }
+
+  ++execution_frame_pool_stats_.num_hits;
+  std::vector<OrtValue> values = std::move(execution_frame_values_.back());
+  execution_frame_values_.pop_back();
+  return values;
+}
+
+void SessionState::ReturnExecutionFrameValues(std::vector<OrtValue> values) const {
+  // the frames of a session state all have the same number of values
+  if (values.empty()) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(execution_frame_values_lock_);
+  execution_frame_values_.push_back(std::move(values));
+}
+
+ExecutionFramePoolStats SessionState::GetExecutionFramePoolStats() const {
+  std::lock_guard<OrtMutex> lock(execution_frame_values_lock_);
+  return execution_frame_pool_stats_;
+}
+
+static std::vector<int64_t> GetMemoryPatternInputDims(const gsl::span<const OrtValue>& tensor_inputs) {
+  std::vector<int64_t> input_dims;
+  for (const auto& input : tensor_inputs) {
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    input_dims.push_back(static_cast<int64_t>(dims.size()));
+    input_dims.insert(input_dims.end(), dims.begin(), dims.end());
+  }
+  return input_dims;
+}
+
+bool SessionState::MemoryPatternFitsInputs(const MemoryPatternCacheEntry& entry,
+                                           const gsl::span<const OrtValue>& tensor_inputs) const {
+  if (mem_pattern_cache_options_.shape_bucket_size <= 0) {
+    return true;
+  }
+
+  const auto input_dims = GetMemoryPatternInputDims(tensor_inputs);
+  if (input_dims.size() != entry.input_dims.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    if (input_dims[i] > entry.input_dims[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SessionState::InsertMemoryPatternGroup(int64_t key, std::shared_ptr<const MemoryPatternGroup> mem_patterns,
+                                            std::unordered_map<int, TensorShape> inferred_shapes,
+                                            const gsl::span<const OrtValue>& tensor_inputs) const {
+  auto entry = std::make_shared<MemoryPatternCacheEntry>();
+  entry->patterns = std::move(mem_patterns);
+  entry->inferred_shapes = std::move(inferred_shapes);
+  entry->input_dims = GetMemoryPatternInputDims(tensor_inputs);
+  entry->last_use = mem_patterns_tick_.fetch_add(1, std::memory_order_relaxed);
+
+  // the runs may be reading the current cache, so update a copy of it
+  auto cache = std::make_shared<MemoryPatternCache>(*std::atomic_load(&mem_patterns_));
+  (*cache)[key] = std::move(entry);
+
+  const size_t max_num_entries = mem_pattern_cache_options_.max_num_entries;
+  while (max_num_entries > 0 && cache->size() > max_num_entries) {
+    auto evicted = std::min_element(cache->begin(), cache->end(),
+                                    [](const auto& a, const auto& b) {
+                                      return a.second->last_use.load(std::memory_order_relaxed) <
+                                             b.second->last_use.load(std::memory_order_relaxed);
+                                    });
+    cache->erase(evicted);
+    mem_pattern_cache_evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::atomic_store(&mem_patterns_, std::shared_ptr<const MemoryPatternCache>(std::move(cache)));
 }
 
 #ifdef ENABLE_TRAINING
@@ -652,22 +992,26 @@ Status SessionState::GeneratePatternGroupCache(const gsl::span<const OrtValue>&
 }
 #endif
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const gsl::span<const OrtValue>& tensor_inputs,
-                                                              const std::vector<int>& feed_mlvalue_idxs,
-                                                              std::unordered_map<int, TensorShape>& inferred_shapes) const {
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
+    const gsl::span<const OrtValue>& tensor_inputs,
+    const std::vector<int>& feed_mlvalue_idxs,
+    std::unordered_map<int, TensorShape>& inferred_shapes) const {
   int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
 
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+  // the concurrent runs look up the same snapshot of the cache without taking mem_patterns_lock_
+  const auto cache = std::atomic_load(&mem_patterns_);
+  auto it = cache->find(key);
+  // a pattern generated for smaller inputs of the bucket is a miss, so that the run of these inputs generates the
+  // pattern that replaces it
+  if (it == cache->end() || !MemoryPatternFitsInputs(*it->second, tensor_inputs)) {
+    mem_pattern_cache_misses_.fetch_add(1, std::memory_order_relaxed);
 #ifdef ENABLE_TRAINING
-    auto mem_patterns = std::make_unique<MemoryPatternGroup>();
+    auto mem_patterns = std::make_shared<MemoryPatternGroup>();
+    std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
     if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns.get(), inferred_shapes).IsOK()) {
       key = CalculateMemoryPatternsKey(tensor_inputs);
-      auto ptr = mem_patterns.get();
-      mem_patterns_[key] = std::move(mem_patterns);
-      shape_patterns_[key] = inferred_shapes;
-      return ptr;
+      InsertMemoryPatternGroup(key, mem_patterns, inferred_shapes, tensor_inputs);
+      return mem_patterns;
     }
     return nullptr;
 #else
@@ -676,8 +1020,14 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const gsl::span<co
 #endif
   }
 
-  inferred_shapes = shape_patterns_[key];
-  return it->second.get();
+  mem_pattern_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+  // the recency is only needed to pick the entry to evict
+  if (mem_pattern_cache_options_.max_num_entries > 0) {
+    it->second->last_use.store(mem_patterns_tick_.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  inferred_shapes = it->second->inferred_shapes;
+  return it->second->patterns;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -709,9 +1059,10 @@ Status SessionState::UpdateMemoryPatternGroupCache(const gsl::span<const OrtValu
   int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
+  const auto cache = std::atomic_load(&mem_patterns_);
+  auto it = cache->find(key);
+  if (it == cache->end() || !MemoryPatternFitsInputs(*it->second, tensor_inputs)) {
+    InsertMemoryPatternGroup(key, std::move(mem_patterns), {}, tensor_inputs);
   }
 
   return Status::OK();
@@ -952,6 +1303,8 @@ Status SessionState::CreateSubgraphSessionState() {
                                          thread_pool_, inter_op_thread_pool_, data_transfer_mgr_,
                                          logger_, profiler_);
 
+      subgraph_session_state->SetMemoryPatternCacheOptions(mem_pattern_cache_options_);
+
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
 
@@ -1201,12 +1554,27 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
 #endif
   }
 
+  // the initializers of ORT format models may be loaded from the bytes of the model, which are only kept for the
+  // initialization of the session
+  defer_if_branch_finalization_ =
+      serialized_session_state == nullptr && !saving_ort_format &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazyIfBranches, "0") == "1";
+
   std::unordered_map<std::string, size_t> constant_initializers_use_count;
   ComputeConstantInitializerUseCount(graph_, constant_initializers_use_count);
   return FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, session_options,
                                   remove_initializers, constant_initializers_use_count);
 }
 
+Status SessionState::EnsureFinalized() const {
+  if (!deferred_finalization_) {
+    return Status::OK();
+  }
+
+  std::call_once(deferred_finalization_once_, [this]() { deferred_finalization_status_ = deferred_finalization_(); });
+  return deferred_finalization_status_;
+}
+
 static Status Index(const OrtValueNameIdxMap& ort_value_name_idx_map,
                     const OrtValueName& name,
                     /*out*/ OrtValueIndex& value) {
@@ -1382,16 +1750,34 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
-  SequentialPlannerContext context(session_options.execution_mode, session_options.execution_order, session_options.enable_mem_reuse);
+  const bool use_memory_efficient_order =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryEfficientExecutionOrder,
+                                                        "0") == "1";
+  const ExecutionOrder execution_order =
+      use_memory_efficient_order ? ExecutionOrder::MEMORY_EFFICIENT : session_options.execution_order;
+  SequentialPlannerContext context(session_options.execution_mode, execution_order, session_options.enable_mem_reuse);
   ORT_RETURN_IF_ERROR(SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
                                                     execution_providers_, kernel_create_info_map_,
                                                     subgraphs_kernel_create_info_maps,
                                                     outer_scope_node_arg_to_location_map,
                                                     ort_value_name_idx_map_, context, p_seq_exec_plan_));
+  // The memory patterns place the values in one block by their lifetime in the execution plan, which does not
+  // order the uses of the values on different compute streams, so they are disabled as in parallel execution.
+  if (p_seq_exec_plan_->IsMultiStream() && enable_mem_pattern_) {
+    LOGS(logger_, INFO) << "Memory pattern is disabled as the nodes run on several compute streams.";
+    enable_mem_pattern_ = false;
+  }
   // Record the allocation plan
 
-  // Uncomment the below to dump the allocation plan to std::cout
-  // LOGS(logger_, VERBOSE) << std::make_pair(p_seq_exec_plan_.get(), this);
+  if (session_options.execution_mode == ExecutionMode::ORT_PARALLEL &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseWorkStealingExecutor, "0") == "1") {
+    use_work_stealing_executor_ = true;
+    ComputeNodePriorities();
+  }
+
+  if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDumpAllocationPlan, "0") == "1") {
+    LOGS(logger_, INFO) << "Graph " << graph_viewer_->Name() << "\n" << std::make_pair(p_seq_exec_plan_.get(), this);
+  }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryInfo::GenerateTensorMap(GetExecutionPlan(), GetOrtValueNameIdxMap());
 #endif
@@ -1421,6 +1807,11 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   const auto& initializer_allocation_order = p_seq_exec_plan_->initializer_allocation_order;
 
   // move initializers from TensorProto instances in Graph to OrtValue instances in SessionState
+  TimePoint tp;
+  if (profiler_.IsEnabled()) {
+    tp = profiler_.Start();
+  }
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
           Env::Default(), graph_location, *graph_viewer_,
@@ -1429,7 +1820,17 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
           [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant, bool sparse) -> Status {
             return AddInitializedTensor(idx, value, &d, constant, sparse);
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options, thread_pool_,
+          prepacked_weights_container_,
+          // the initializers are removed from the graph below, so the data of each one is released as soon as it
+          // is in its tensor rather than when all of them are.
+          remove_initializers ? session_state_utils::ReleaseTensorDataFunction(
+                                    [this](const std::string& name) { graph_.ReleaseInitializedTensorData(name); })
+                              : session_state_utils::ReleaseTensorDataFunction()));
+
+  if (profiler_.IsEnabled()) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "initializers_deserialization", tp);
+  }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
   MemoryInfo::RecordInitializerAllocInfo(GetInitializedTensors());
@@ -1442,18 +1843,62 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
+  config_options_ = session_options.config_options;
+
+  if (profiler_.IsEnabled()) {
+    tp = profiler_.Start();
+  }
+
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
+  if (profiler_.IsEnabled()) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "kernels_creation", tp);
+  }
+
 #ifndef ENABLE_TRAINING
   const auto disable_prepacking =
       session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0");
 
   if (disable_prepacking != "1") {
+    const std::string prepacked_weights_cache_file =
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrepackedWeightsCacheFile, "");
+    if (parent_ == nullptr && !prepacked_weights_cache_file.empty()) {
+      prepacked_weights_file_cache_ =
+          std::make_unique<PrepackedWeightsFileCache>(ToPathString(prepacked_weights_cache_file));
+      auto status = prepacked_weights_file_cache_->Load(Env::Default(), logger_);
+      if (!status.IsOK()) {
+        LOGS(logger_, WARNING) << "Ignoring pre-packed weights cache file: " << status.ErrorMessage();
+        prepacked_weights_file_cache_ =
+            std::make_unique<PrepackedWeightsFileCache>(ToPathString(prepacked_weights_cache_file));
+      }
+    }
+
+    if (profiler_.IsEnabled()) {
+      tp = profiler_.Start();
+    }
+
+    const bool lazy_load_external_initializers =
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazyLoadExternalInitializers,
+                                                          "0") == "1";
+    const bool share_initializers_by_content =
+        prepacked_weights_container_ != nullptr &&
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareInitializersByContent,
+                                                          "0") == "1";
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+                                                          session_options.initializers_to_share_map,
+                                                          lazy_load_external_initializers,
+                                                          share_initializers_by_content));
+
+    if (profiler_.IsEnabled()) {
+      profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "initializers_prepacking", tp);
+    }
   }
 #endif
 
+  if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseFlatExecutionPlan, "0") == "1") {
+    CreateFlatExecutionPlan();
+  }
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInputOutputNamesToNodeMapping(*graph_viewer_, *this, valid_outer_scope_node_args));
 
@@ -1488,9 +1933,6 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                                                node,
                                                                subgraph_session_state.GetGraphViewer(),
                                                                subgraph_outer_scope_node_arg_to_location_map));
-      ORT_RETURN_IF_ERROR(subgraph_session_state.FinalizeSessionStateImpl(
-          graph_location, kernel_registry_manager, &node, subgraph_session_options, remove_initializers,
-          constant_initializers_use_count, subgraph_outer_scope_node_arg_to_location_map, true));
 
       // setup all the info for handling the feeds and fetches used in subgraph execution
       auto* p_op_kernel = GetMutableKernel(node.Index());
@@ -1499,6 +1941,30 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
       // Downcast is safe, since only control flow nodes have subgraphs
       // (node.GetAttributeNameToMutableSubgraphMap() is non-empty)
       auto& control_flow_kernel = static_cast<controlflow::IControlFlowKernel&>(*p_op_kernel);
+
+      subgraph_session_state.defer_if_branch_finalization_ = defer_if_branch_finalization_;
+
+      if (defer_if_branch_finalization_ && node.OpType() == "If" && node.Domain() == kOnnxDomain) {
+        // the kernels of a branch are created, and its weights pre-packed, when the If first runs it, so a branch
+        // that is never taken costs no memory. the use counts of the constant initializers are not tracked for it,
+        // so the initializers it pre-packs are kept.
+        subgraph_session_state.deferred_finalization_ =
+            [this, graph_location, &kernel_registry_manager, &node, subgraph_session_options, remove_initializers,
+             outer_scope_node_arg_to_location_map = std::move(subgraph_outer_scope_node_arg_to_location_map),
+             &control_flow_kernel, attr_name, &subgraph_session_state]() -> Status {
+          std::unordered_map<std::string, size_t> no_constant_initializers_use_count;
+          ORT_RETURN_IF_ERROR(subgraph_session_state.FinalizeSessionStateImpl(
+              graph_location, kernel_registry_manager, &node, subgraph_session_options, remove_initializers,
+              no_constant_initializers_use_count, outer_scope_node_arg_to_location_map, true));
+          return control_flow_kernel.SetupSubgraphExecutionInfo(*this, attr_name, subgraph_session_state);
+        };
+        continue;
+      }
+
+      ORT_RETURN_IF_ERROR(subgraph_session_state.FinalizeSessionStateImpl(
+          graph_location, kernel_registry_manager, &node, subgraph_session_options, remove_initializers,
+          constant_initializers_use_count, subgraph_outer_scope_node_arg_to_location_map, true));
+
       ORT_RETURN_IF_ERROR(control_flow_kernel.SetupSubgraphExecutionInfo(*this, attr_name, subgraph_session_state));
     }
 
@@ -1507,6 +1973,14 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     // locations for these would be the locations they are explicitly consumed on in nested subgraphs.
   }
 
+  // all the subgraphs have been pre-packed as well now
+  if (prepacked_weights_file_cache_ != nullptr && prepacked_weights_file_cache_->HasNewWeights()) {
+    auto status = prepacked_weights_file_cache_->Save(Env::Default(), logger_);
+    if (!status.IsOK()) {
+      LOGS(logger_, WARNING) << "Failed to save the pre-packed weights cache file: " << status.ErrorMessage();
+    }
+  }
+
   return Status::OK();
 }
 
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -13,14 +16,18 @@
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parallel_for_tuner.h"
+#include "core/common/op_latency_histograms.h"
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/callback.h"
+#include "core/framework/config_options.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_file_cache.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
@@ -57,8 +64,48 @@ struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
+class ShapeStatistics;
 #endif
 
+// Controls how the memory patterns generated for previously seen input shapes are cached.
+struct MemoryPatternCacheOptions {
+  // If > 0, every dimension of the inputs except the first (batch) one is rounded up to a multiple of this value
+  // before looking up the cache, so that a single pattern serves a whole range of e.g. sequence lengths.
+  // The pattern of a bucket is generated for the largest inputs seen in it, so larger inputs than the ones of the
+  // cached pattern miss the cache once and the pattern generated by their run replaces it.
+  int64_t shape_bucket_size = 0;
+
+  // Maximum number of cached patterns. The least recently used one is evicted first. 0 means unlimited.
+  size_t max_num_entries = 0;
+
+  // If true, the buffers allocated for the patterns are handed back to the session state at the end of a run
+  // and reused by the next runs instead of being allocated and freed on every run. A buffer is only reused if it is
+  // large enough for the pattern, and the session keeps at most one buffer per location per concurrent run.
+  bool reuse_buffers = false;
+};
+
+struct MemoryPatternCacheStats {
+  int64_t num_hits = 0;
+  int64_t num_misses = 0;
+  int64_t num_evictions = 0;
+  size_t num_entries = 0;
+};
+
+struct ExecutionFramePoolStats {
+  int64_t num_hits = 0;
+  int64_t num_misses = 0;
+};
+
+/**
+ * One node of the execution plan with everything the SequentialExecutor needs to run it resolved up front.
+ */
+struct FlatExecutionStep {
+  const OpKernel* kernel = nullptr;
+  // OrtValues to release once the kernel has run. Points into SequentialExecutionPlan::to_be_freed.
+  const OrtValueIndex* values_to_free = nullptr;
+  size_t num_values_to_free = 0;
+};
+
 /**
  * SessionState should be modified by the inference session class only.
  * It is supposed to be passed by const-ref only to all the executors.
@@ -203,11 +250,44 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
+  /**
+  Get the sampled op latency histograms of this graph, or nullptr if they are disabled.
+  Only set for the main graph, the kernels of subgraphs are accounted for in their control flow node.
+  */
+  profiling::OpLatencyHistograms* OpLatencyHistograms() const noexcept { return op_latency_histograms_; }
+
+  void SetOpLatencyHistograms(profiling::OpLatencyHistograms* op_latency_histograms) noexcept {
+    op_latency_histograms_ = op_latency_histograms;
+  }
+
+  /**
+  Get the sampled shape statistics of this graph, or nullptr if they are disabled. Only set for the main graph.
+  */
+  ShapeStatistics* GetShapeStatistics() const noexcept { return shape_statistics_; }
+
+  void SetShapeStatistics(ShapeStatistics* shape_statistics) noexcept { shape_statistics_ = shape_statistics; }
+
+  /**
+  Get the path prefix of the memory timeline files of the runs of this graph, or an empty string if the memory
+  timeline is disabled. Only set for the main graph.
+  */
+  const std::string& MemoryTimelineFilePrefix() const noexcept { return memory_timeline_file_prefix_; }
+
+  void SetMemoryTimelineFilePrefix(const std::string& prefix) { memory_timeline_file_prefix_ = prefix; }
+
+  /**
+  Get the path of the memory timeline file of the next run.
+  */
+  std::string NextMemoryTimelineFile() const {
+    return memory_timeline_file_prefix_ + "_" + std::to_string(num_memory_timelines_.fetch_add(1)) + ".json";
+  }
+
   /**
   Get cached memory pattern based on input shapes
   Must be called only when all values contain tensors
+  The returned pattern stays valid even if it's evicted from the cache while in use.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       const gsl::span<const OrtValue>& tensor_inputs,
       const std::vector<int>& feed_mlvalue_idxs,
       std::unordered_map<int, TensorShape>& inferred_shapes) const;
@@ -220,6 +300,54 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(const gsl::span<const OrtValue>& tensor_inputs,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
 
+  /**
+  Set how memory patterns are cached. Applies to the subgraph session states created afterwards as well.
+  */
+  void SetMemoryPatternCacheOptions(const MemoryPatternCacheOptions& options);
+
+  const MemoryPatternCacheOptions& GetMemoryPatternCacheOptions() const noexcept { return mem_pattern_cache_options_; }
+
+  /**
+  Get the hit/miss/eviction counters of the memory pattern cache.
+  */
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const;
+
+  /**
+  Take a buffer of at least `size` bytes for the memory patterns of `location` from the ones returned by the
+  previous runs. Returns nullptr if there's none. `buffer_size` is set to the actual size of the buffer.
+  Only used if MemoryPatternCacheOptions::reuse_buffers is set.
+  */
+  BufferUniquePtr TakeMemoryPatternBuffer(const OrtMemoryInfo& location, size_t size, size_t& buffer_size) const;
+
+  /**
+  Return a memory pattern buffer of `buffer_size` bytes so that the next runs can reuse it.
+  */
+  void ReturnMemoryPatternBuffer(const OrtMemoryInfo& location, BufferUniquePtr buffer, size_t buffer_size) const;
+
+  /**
+  Take the storage of the OrtValues of an ExecutionFrame released by a previous run, so that the runs don't
+  allocate it every time. Returns an empty vector if there's none.
+  */
+  std::vector<OrtValue> TakeExecutionFrameValues() const;
+
+  /**
+  Return the storage of the OrtValues of an ExecutionFrame so that the next runs can reuse it.
+  The values must have been released.
+  */
+  void ReturnExecutionFrameValues(std::vector<OrtValue> values) const;
+
+  ExecutionFramePoolStats GetExecutionFramePoolStats() const;
+
+  /**
+  Set the tuner of the parallel loops run by the kernels of the session. The tuner is not owned.
+  Subgraphs use the tuner of the main graph.
+  */
+  void SetParallelForTuner(concurrency::ParallelForTuner* tuner) noexcept { parallel_for_tuner_ = tuner; }
+
+  concurrency::ParallelForTuner* GetParallelForTuner() const noexcept {
+    return parent_ ? parent_->GetParallelForTuner() : parallel_for_tuner_;
+  }
+
   bool GetUseDeterministicCompute() const { return use_deterministic_compute_; }
 
   /**
@@ -276,11 +404,33 @@ class SessionState {
   concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
   concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
 
+  /**
+  Whether ORT_PARALLEL execution uses the WorkStealingExecutor. Set during finalization from the session options.
+  */
+  bool UseWorkStealingExecutor() const noexcept { return use_work_stealing_executor_; }
+
+  /**
+  Length of the longest path from each node to a graph output, indexed by NodeIndex.
+  Only populated if UseWorkStealingExecutor() is true.
+  */
+  const std::vector<int64_t>& GetNodePriorities() const noexcept { return node_priorities_; }
+
+  /**
+  The execution plan compiled into a flat list of steps, or nullptr if it was not requested in the session options
+  or the plan needs fences.
+  */
+  const std::vector<FlatExecutionStep>* GetFlatExecutionPlan() const noexcept {
+    return has_flat_execution_plan_ ? &flat_execution_plan_ : nullptr;
+  }
+
   const FuncManager& GetFuncMgr() const noexcept { return fused_funcs_mgr_; }
   FuncManager& GetMutableFuncMgr() noexcept { return fused_funcs_mgr_; }
 
   const DataTransferManager& GetDataTransferMgr() const noexcept { return data_transfer_mgr_; }
 
+  // The configuration options of the session. Kernels read them through OpKernelInfo::GetConfigOptions().
+  const ConfigOptions& GetConfigOptions() const noexcept { return config_options_; }
+
   std::vector<BufferUniquePtr>& GetMutableWeightsBuffers() noexcept { return weights_buffers_; }
 
   const NodeIndexInfo& GetNodeIndexInfo() const;
@@ -306,6 +456,12 @@ class SessionState {
                               bool remove_initializers = true,
                               bool saving_ort_format = false);
 
+  /**
+  Finalize a subgraph session state whose finalization was deferred until its first execution, i.e. a branch of an
+  If node when kOrtSessionOptionsConfigLazyIfBranches is set. A no-op for the other session states. Thread-safe.
+  */
+  Status EnsureFinalized() const;
+
   SessionState* Parent() {
     return parent_;
   }
@@ -318,6 +474,10 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetUsedCachedPrePackedWeightCounter() const {
+    return used_cached_pre_packed_weights_counter_;
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -354,9 +514,15 @@ class SessionState {
   /**
    * Prepack the constant initialized tensors for better performance.
    * The original constant initialized tensors will be removed to save memory.
+   * If skip_external_initializers is true, the initializers with external data are left as is so that they stay
+   * memory mapped and are only paged in when a kernel reads them.
+   * If share_initializers_by_content is true, the pre-packed weights of all the constant initializers on CPU are
+   * cached in the pre-packed weights' container, like the ones of the shared initializers.
    */
   Status PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           bool skip_external_initializers,
+                                           bool share_initializers_by_content);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -465,16 +631,76 @@ class SessionState {
 
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
+  profiling::OpLatencyHistograms* op_latency_histograms_ = nullptr;
+  ShapeStatistics* shape_statistics_ = nullptr;
+  std::string memory_timeline_file_prefix_;
+  mutable std::atomic<size_t> num_memory_timelines_{0};
 
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
-  // lock for the mem_patterns_
+  // serializes the updates of mem_patterns_. lookups read a snapshot without taking it.
   mutable OrtMutex mem_patterns_lock_;
 
+  struct MemoryPatternCacheEntry {
+    std::shared_ptr<const MemoryPatternGroup> patterns;
+    std::unordered_map<int, TensorShape> inferred_shapes;
+    // ranks and dims of the inputs the patterns were generated for
+    std::vector<int64_t> input_dims;
+    // tick of the last lookup of the entry, the entry with the lowest one is evicted first
+    mutable std::atomic<uint64_t> last_use{0};
+  };
+
+  using MemoryPatternCache = std::map<int64_t, std::shared_ptr<const MemoryPatternCacheEntry>>;
+
+  int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) const;
+  // Must be called while holding mem_patterns_lock_
+  void InsertMemoryPatternGroup(int64_t key, std::shared_ptr<const MemoryPatternGroup> mem_patterns,
+                                std::unordered_map<int, TensorShape> inferred_shapes,
+                                const gsl::span<const OrtValue>& tensor_inputs) const;
+  // Whether the patterns of an entry were generated for inputs at least as large as tensor_inputs, so that every
+  // block is large enough. Always true without shape bucketing as the inputs of an entry have the same shapes.
+  bool MemoryPatternFitsInputs(const MemoryPatternCacheEntry& entry,
+                               const gsl::span<const OrtValue>& tensor_inputs) const;
+
+  // Populate node_priorities_ with the critical path length of each node.
+  void ComputeNodePriorities();
+
+  // Populate flat_execution_plan_ from the execution plan and the kernels.
+  void CreateFlatExecutionPlan();
+
+  // Pre-pack a constant initializer of a CPU kernel, reusing the buffers from the pre-packed weights cache file
+  // if possible, and keep the buffers in the cache so they can be saved.
+  Status PrepackUsingFileCache(PrepackedWeightsFileCache& cache, OpKernel& kernel, const Node& node, int input_idx,
+                               const Tensor& tensor, bool& is_packed);
+
+  // The pre-packed weights cache file is owned by the main graph's session state and shared with the subgraphs.
+  PrepackedWeightsFileCache* GetPrepackedWeightsFileCache() const;
+
+  MemoryPatternCacheOptions mem_pattern_cache_options_;
+
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
-  mutable std::map<int64_t, std::unordered_map<int, TensorShape>> shape_patterns_;
+  // the cache is read-mostly, so it's replaced by an updated copy on insertion and the runs look up a snapshot of it.
+  // only access it with std::atomic_load/std::atomic_store.
+  mutable std::shared_ptr<const MemoryPatternCache> mem_patterns_ = std::make_shared<const MemoryPatternCache>();
+  mutable std::atomic<uint64_t> mem_patterns_tick_{0};
+  mutable std::atomic<int64_t> mem_pattern_cache_hits_{0};
+  mutable std::atomic<int64_t> mem_pattern_cache_misses_{0};
+  mutable std::atomic<int64_t> mem_pattern_cache_evictions_{0};
+
+  struct MemoryPatternBuffer {
+    BufferUniquePtr buffer;
+    size_t size;
+  };
+
+  // the memory pattern buffers not in use by a run, if MemoryPatternCacheOptions::reuse_buffers is set
+  mutable OrtMutex mem_pattern_buffers_lock_;
+  mutable std::map<OrtMemoryInfo, std::vector<MemoryPatternBuffer>> mem_pattern_buffers_;
+
+  // the storage of the OrtValues of the ExecutionFrames not in use by a run
+  mutable OrtMutex execution_frame_values_lock_;
+  mutable std::vector<std::vector<OrtValue>> execution_frame_values_;
+  mutable ExecutionFramePoolStats execution_frame_pool_stats_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -487,8 +713,15 @@ class SessionState {
 
   const DataTransferManager& data_transfer_mgr_;
 
+  // copied from the session options when the session state is finalized, before the kernels are created.
+  ConfigOptions config_options_;
+
   bool use_deterministic_compute_;
   bool enable_mem_reuse_;
+  bool use_work_stealing_executor_ = false;
+  std::vector<int64_t> node_priorities_;
+  bool has_flat_execution_plan_ = false;
+  std::vector<FlatExecutionStep> flat_execution_plan_;
   std::unique_ptr<NodeIndexInfo> node_index_info_;
   std::multimap<int, std::unique_ptr<FeedsFetchesManager>> cached_feeds_fetches_managers_;
 
@@ -498,6 +731,9 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // Set on the main graph's session state if kOrtSessionOptionsConfigPrepackedWeightsCacheFile is set.
+  std::unique_ptr<PrepackedWeightsFileCache> prepacked_weights_file_cache_;
+
 #if !defined(ORT_MINIMAL_BUILD)
 #ifndef DISABLE_ABSEIL
   InlinedHashMap<InlinedVector<int>, InlinedHashSet<NodeIndex>> to_be_executed_nodes_;
@@ -507,6 +743,16 @@ class SessionState {
 #endif
 
   SessionState* parent_ = nullptr;
+
+  // defer the finalization of the If branches in this graph. see kOrtSessionOptionsConfigLazyIfBranches
+  bool defer_if_branch_finalization_ = false;
+
+  // set if the finalization of this subgraph session state is deferred until its first execution
+  std::function<Status()> deferred_finalization_;
+  mutable std::once_flag deferred_finalization_once_;
+  mutable Status deferred_finalization_status_;
+
+  concurrency::ParallelForTuner* parallel_for_tuner_ = nullptr;
   //Assign each graph in each session an unique id.
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   int graph_id_ = 0;
@@ -527,6 +773,10 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times a pre-packed weight loaded from the pre-packed weights cache file
+  // was used by the session state
+  size_t used_cached_pre_packed_weights_counter_ = 0;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
@@ -17,6 +17,7 @@
 #include "core/framework/ort_value.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/prepacked_weights_container.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
@@ -25,6 +26,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -72,7 +74,10 @@ struct ExtDataValueDeleter {
   OrtCallback ext_delete_cb;
   Tensor* p_tensor;
   void operator()(void*) noexcept {
-    this->ext_delete_cb.f(this->ext_delete_cb.param);
+    // data used in place has no callback
+    if (this->ext_delete_cb.f != nullptr) {
+      this->ext_delete_cb.f(this->ext_delete_cb.param);
+    }
     delete this->p_tensor;
   }
 };
@@ -82,15 +87,16 @@ struct ExtDataValueDeleter {
 // by the OrtValue's deleter
 static inline common::Status ExtDataTensorProtoToTensor(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
                                                         const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                                        OrtValue& ort_value) {
+                                                        OrtValue& ort_value, bool require_mapping) {
   ORT_ENFORCE(utils::HasExternalData(tensor_proto));
-  ORT_ENFORCE(!proto_path.empty());
+  ORT_ENFORCE(!proto_path.empty() || utils::HasExternalDataInMemory(tensor_proto));
 
   void* ext_data_buf = nullptr;
   size_t ext_data_len = 0;
   OrtCallback ext_data_deleter;
   ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(env, proto_path.c_str(), tensor_proto,
-                                                       ext_data_buf, ext_data_len, ext_data_deleter));
+                                                       ext_data_buf, ext_data_len, ext_data_deleter,
+                                                       require_mapping));
 
   // NB: creating a do-nothing allocator per tensor is wasteful; can perhaps be
   // avoided if the Tensor class implements the do-nothing behavior when given a
@@ -191,7 +197,10 @@ common::Status SaveInitializedTensors(
     const SaveTensorFunction& save_tensor_func,
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
-    const SessionOptions& session_options) {
+    const SessionOptions& session_options,
+    concurrency::ThreadPool* thread_pool,
+    PrepackedWeightsContainer* prepacked_weights_container,
+    const ReleaseTensorDataFunction& release_tensor_data_func) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -224,6 +233,33 @@ common::Status SaveInitializedTensors(
     return retval;
   };
 
+  // Determine if an initializer wraps its external data rather than being deserialized into a planned buffer.
+  // External data in memory, e.g. the initializers of an ORT format model used in place, can only be wrapped if the
+  // initializer is planned on CPU. Compressed external data is decompressed directly into the planned buffer.
+  auto use_external_data_in_place =
+      [&exec_plan](int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) -> bool {
+    if (!utils::HasExternalData(tensor_proto) || utils::HasCompressedExternalData(tensor_proto)) {
+      return false;
+    }
+
+    return !utils::HasExternalDataInMemory(tensor_proto) ||
+           strcmp(exec_plan.GetLocation(ort_value_index).name, CPU) == 0;
+  };
+
+  // Determine if an initializer is shared by content with the other sessions using the pre-packed weights'
+  // container. These are deserialized with the allocator of the container rather than into a planned buffer, so that
+  // the copy of the session can be released when the container already holds the same initializer.
+  const bool share_initializers_by_content =
+      prepacked_weights_container != nullptr &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareInitializersByContent,
+                                                        "0") == "1";
+  auto share_by_content = [&](int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) -> bool {
+    return share_initializers_by_content &&
+           tensor_proto.data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING &&
+           !use_external_data_in_place(ort_value_index, tensor_proto) &&
+           strcmp(exec_plan.GetLocation(ort_value_index).name, CPU) == 0;
+  };
+
   //1. first plan the memory
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   std::unordered_map<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
@@ -242,8 +278,9 @@ common::Status SaveInitializedTensors(
   auto initialized_tensors_to_allocate = id_to_initialized_tensor;
   for (int ort_value_index : initializer_allocation_order) {
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
-    if (utils::HasExternalData(*entry->second)) {
-      // exernal data will be memory mapped, no need to plan for its allocation
+    if (use_external_data_in_place(entry->first, *entry->second) || share_by_content(entry->first, *entry->second)) {
+      // exernal data will be memory mapped and initializers shared by content are allocated by the container,
+      // no need to plan for their allocation
       continue;
     } else {
       // can not trace string tensor
@@ -258,10 +295,14 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       continue;
     }
-    if (utils::HasExternalData(*entry.second)) {
+    if (use_external_data_in_place(entry.first, *entry.second)) {
       // exernal data will be memory mapped, no need to plan for its allocation
       continue;
     }
+    if (share_by_content(entry.first, *entry.second)) {
+      // allocated by the pre-packed weights' container
+      continue;
+    }
     if (entry.second->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
       // do not trace string tensor
       continue;
@@ -287,39 +328,112 @@ common::Status SaveInitializedTensors(
 
   OrtCallback deleter{nullptr, nullptr};
 
-  //3. create weight tensors based on weights buffer
+  // external data that can't be memory mapped is read into a private buffer unless mapping is required
+  const bool require_mapped_external_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigRequireMappedExternalInitializers,
+                                                        "0") == "1";
+
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  //3. create weight tensors based on weights buffer.
+  // the buffers are handed out in order as the planner is not thread safe. tensors created on CPU are then
+  // deserialized in parallel, while tensors copied to another device are deserialized in order as the data
+  // transfers may not be thread safe.
+  struct InitializerToSave {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::unique_ptr<MemBuffer> m;
+    AllocatorPtr alloc;
+    bool external_data_in_place;
+    bool shared_by_content;
+    OrtValue ort_value;
+    Status status;
+  };
+
+  std::vector<InitializerToSave> initializers;
+  initializers.reserve(id_to_initialized_tensor.size());
+  std::vector<size_t> parallel_initializers;
   for (const auto& entry : id_to_initialized_tensor) {
-    int ort_value_index = entry.first;
+    initializers.push_back(InitializerToSave{entry.first, entry.second, nullptr, nullptr,
+                                             use_external_data_in_place(entry.first, *entry.second), false,
+                                             OrtValue(), Status::OK()});
+    auto& initializer = initializers.back();
     const char* name = (entry.second->name().empty()) ? "" : entry.second->name().c_str();
-    OrtValue ort_value;
 
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
-      ort_value = *(session_options.initializers_to_share_map.at(name));
+      initializer.ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
-    } else if (utils::HasExternalData(*entry.second)) {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-      Status st = ExtDataTensorProtoToTensor(env, graph_loc, tensor_proto, ort_value);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Load of external data tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
+    } else if (initializer.external_data_in_place) {
+      parallel_initializers.push_back(initializers.size() - 1);
+    } else if (share_by_content(entry.first, *entry.second)) {
+      initializer.shared_by_content = true;
+      {
+        std::lock_guard<OrtMutex> l(prepacked_weights_container->mutex_);
+        initializer.alloc = prepacked_weights_container->GetOrCreateAllocator(CPU);
       }
+      parallel_initializers.push_back(initializers.size() - 1);
     } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-
-      std::unique_ptr<MemBuffer> m;
-      AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
-
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, m.get(), alloc, default_cpu_alloc, ort_value,
-                                         data_transfer_mgr, use_device_allocator_for_initializers);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(entry.first, name, initializer.m, initializer.alloc));
+      const OrtMemoryInfo* location = initializer.m ? &initializer.m->GetAllocInfo()
+                                      : initializer.alloc ? &initializer.alloc->Info()
+                                                          : nullptr;
+      if (location != nullptr && strcmp(location->name, CPU) == 0) {
+        parallel_initializers.push_back(initializers.size() - 1);
+      }
+    }
+  }
+
+  auto deserialize = [&](InitializerToSave& initializer) {
+    const ONNX_NAMESPACE::TensorProto& tensor_proto = *initializer.tensor_proto;
+    const char* name = (tensor_proto.name().empty()) ? "" : tensor_proto.name().c_str();
+    Status st;
+    std::ostringstream oss;
+    if (initializer.external_data_in_place) {
+      st = ExtDataTensorProtoToTensor(env, graph_loc, tensor_proto, initializer.ort_value,
+                                      require_mapped_external_initializers);
+      oss << "Load of external data tensor " << name << " failed.";
+    } else {
+      st = DeserializeTensorProto(env, graph_loc, tensor_proto, initializer.m.get(), initializer.alloc,
+                                  default_cpu_alloc, initializer.ort_value, data_transfer_mgr,
+                                  use_device_allocator_for_initializers);
+      oss << "Deserialize tensor " << name << " failed.";
+    }
+
+    if (!st.IsOK()) {
+      oss << st.ErrorMessage();
+      initializer.status = Status(st.Category(), st.Code(), oss.str());
+    } else if (release_tensor_data_func && !initializer.external_data_in_place) {
+      release_tensor_data_func(tensor_proto.name());
+    }
+  };
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(parallel_initializers.size()),
+      [&](std::ptrdiff_t i) { deserialize(initializers[parallel_initializers[i]]); });
+
+  size_t next_parallel_initializer = 0;
+  for (size_t i = 0; i < initializers.size(); ++i) {
+    auto& initializer = initializers[i];
+    if (next_parallel_initializer < parallel_initializers.size() &&
+        parallel_initializers[next_parallel_initializer] == i) {
+      ++next_parallel_initializer;
+    } else if (user_supplied_initializer_ids.find(initializer.ort_value_index) == user_supplied_initializer_ids.end()) {
+      deserialize(initializer);
+    }
+    ORT_RETURN_IF_ERROR(initializer.status);
+
+    const int ort_value_index = initializer.ort_value_index;
+    const char* name = (initializer.tensor_proto->name().empty()) ? "" : initializer.tensor_proto->name().c_str();
+
+    if (initializer.shared_by_content) {
+      // the copy deserialized by this session is released if the container already holds the same initializer
+      std::lock_guard<OrtMutex> l(prepacked_weights_container->mutex_);
+      const size_t num_shared_initializers = prepacked_weights_container->GetNumberOfInitializers();
+      initializer.ort_value = prepacked_weights_container->GetOrWriteInitializer(initializer.ort_value);
+      if (prepacked_weights_container->GetNumberOfInitializers() == num_shared_initializers) {
+        LOGS(logger, INFO) << "Using initializer with the same content shared by another session for (" << name << ").";
       }
     }
 
@@ -328,9 +442,9 @@ common::Status SaveInitializedTensors(
     const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
 #if !defined(DISABLE_SPARSE_TENSORS)
     const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant, sparse));
+    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, initializer.ort_value, deleter, constant, sparse));
 #else
-    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant, false));
+    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, initializer.ort_value, deleter, constant, false));
 #endif
 
     VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << ort_value_index;
@@ -21,6 +21,10 @@ class GraphViewer;
 class OrtValueNameIdxMap;
 class DataTransferManager;
 class NodeArg;
+class PrepackedWeightsContainer;
+namespace concurrency {
+class ThreadPool;
+}
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
 #endif
@@ -32,6 +36,15 @@ class Logger;
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(int idx, const OrtValue& value, const OrtCallback& d,
                                                 bool constant, bool sparse)>;
+using ReleaseTensorDataFunction = std::function<void(const std::string& name)>;
+
+// Initializers are deserialized in parallel on thread_pool when the tensors are created on CPU.
+// save_tensor_func is called in the same order as without a thread pool.
+// If kOrtSessionOptionsConfigShareInitializersByContent is enabled, the initializers on CPU are shared with the other
+// sessions using prepacked_weights_container.
+// If release_tensor_data_func is set, it is called with the name of each initializer deserialized from the data of
+// its TensorProto once the data has been copied to the tensor, possibly concurrently for different initializers.
+// Releasing the data then bounds the memory held during loading to about one copy of the initializers.
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_memory_info,
@@ -41,7 +54,10 @@ common::Status SaveInitializedTensors(
     const logging::Logger& logger,
     const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
-    const SessionOptions& session_options);
+    const SessionOptions& session_options,
+    concurrency::ThreadPool* thread_pool = nullptr,
+    PrepackedWeightsContainer* prepacked_weights_container = nullptr,
+    const ReleaseTensorDataFunction& release_tensor_data_func = {});
 common::Status SaveInputOutputNamesToNodeMapping(const GraphViewer& graph,
                                                  SessionState& session_state,
                                                  const std::vector<const NodeArg*>& implicit_inputs);
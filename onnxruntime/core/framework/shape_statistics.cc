@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shape_statistics.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+void AppendShape(std::string& signature, const OrtValue* value) {
+  if (value == nullptr || !value->IsAllocated()) {
+    signature += "none";
+  } else if (value->IsTensor()) {
+    signature += value->Get<Tensor>().Shape().ToString();
+  } else {
+    signature += "non_tensor";
+  }
+}
+}  // namespace
+
+ShapeStatistics::ShapeStatistics(uint64_t sample_rate, size_t num_nodes)
+    : sample_rate_(sample_rate), slots_((num_nodes + 1) * kMaxShapesPerKey) {
+  ORT_ENFORCE(sample_rate_ > 0, "The sample rate of the shape statistics must be positive");
+}
+
+void ShapeStatistics::RecordInputs(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+                                   const OrtValueNameIdxMap& name_idx_map) {
+  std::vector<std::pair<int, const OrtValue*>> sorted_feeds;
+  sorted_feeds.reserve(feeds.size());
+  for (size_t i = 0; i < feeds.size() && i < feed_mlvalue_idxs.size(); ++i) {
+    sorted_feeds.emplace_back(feed_mlvalue_idxs[i], &feeds[i]);
+  }
+  std::sort(sorted_feeds.begin(), sorted_feeds.end(),
+            [](const std::pair<int, const OrtValue*>& a, const std::pair<int, const OrtValue*>& b) {
+              return a.first < b.first;
+            });
+
+  std::string signature;
+  std::string name;
+  for (const auto& feed : sorted_feeds) {
+    if (!signature.empty()) signature += ' ';
+    if (name_idx_map.GetName(feed.first, name).IsOK()) {
+      signature += name;
+      signature += ':';
+    }
+    AppendShape(signature, feed.second);
+  }
+  Record(0, std::move(signature));
+}
+
+void ShapeStatistics::RecordNodeOutputs(NodeIndex node_index, OpKernelContextInternal& context) {
+  std::string signature;
+  for (int i = 0, end = context.OutputCount(); i < end; ++i) {
+    if (i > 0) signature += ' ';
+    AppendShape(signature, context.GetOutputMLValue(i));
+  }
+  Record(node_index + 1, std::move(signature));
+}
+
+void ShapeStatistics::Record(size_t key, std::string&& shape) {
+  if ((key + 1) * kMaxShapesPerKey > slots_.size()) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  Slot* const begin = &slots_[key * kMaxShapesPerKey];
+  Slot* const end = begin + kMaxShapesPerKey;
+  Slot* least_frequent = begin;
+  for (Slot* slot = begin; slot != end; ++slot) {
+    if (slot->count == 0) {
+      // the slots are filled in order, so the shape isn't tracked yet
+      least_frequent = slot;
+      break;
+    }
+    if (slot->shape == shape) {
+      ++slot->count;
+      return;
+    }
+    if (slot->count < least_frequent->count) {
+      least_frequent = slot;
+    }
+  }
+
+  least_frequent->max_overcount = least_frequent->count;
+  least_frequent->count += 1;
+  least_frequent->shape = std::move(shape);
+}
+
+void ShapeStatistics::WriteSlots(std::ostream& out, size_t key) const {
+  std::vector<const Slot*> slots;
+  for (size_t i = 0; i < kMaxShapesPerKey; ++i) {
+    const Slot& slot = slots_[key * kMaxShapesPerKey + i];
+    if (slot.count > 0) slots.push_back(&slot);
+  }
+  std::sort(slots.begin(), slots.end(), [](const Slot* a, const Slot* b) { return a->count > b->count; });
+
+  out << "[";
+  for (size_t i = 0; i < slots.size(); ++i) {
+    out << (i == 0 ? "" : ", ") << R"({"shape" : ")" << slots[i]->shape << R"(", "count" : )" << slots[i]->count
+        << R"(, "max_overcount" : )" << slots[i]->max_overcount << "}";
+  }
+  out << "]";
+}
+
+std::string ShapeStatistics::ToJson(const GraphViewer& graph_viewer) const {
+  const uint64_t num_runs = run_count_.load(std::memory_order_relaxed);
+  std::ostringstream out;
+  std::lock_guard<OrtMutex> lock(mutex_);
+  out << R"({"sample_rate" : )" << sample_rate_ << R"(, "sampled_runs" : )"
+      << (num_runs + sample_rate_ - 1) / sample_rate_ << R"(, "inputs" : )";
+  WriteSlots(out, 0);
+
+  out << R"(, "nodes" : [)";
+  bool first_node = true;
+  for (const auto& node : graph_viewer.Nodes()) {
+    const size_t key = node.Index() + 1;
+    if ((key + 1) * kMaxShapesPerKey > slots_.size() || slots_[key * kMaxShapesPerKey].count == 0) {
+      continue;
+    }
+    out << (first_node ? "" : ", ") << R"({"name" : ")" << node.Name() << R"(", "op_type" : ")" << node.OpType()
+        << R"(", "output_shapes" : )";
+    WriteSlots(out, key);
+    out << "}";
+    first_node = false;
+  }
+  out << "]}";
+  return out.str();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/basic_types.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class OpKernelContextInternal;
+class OrtValueNameIdxMap;
+
+/**
+ * Which shapes a session sees, enabled with the session.shape_statistics_sample_rate config entry: one in
+ * sample_rate runs records the shapes of its inputs and of the outputs of each node of the main graph, e.g. to choose
+ * shape buckets, CUDA graph capture shapes or TensorRT profiles.
+ * Each input signature and each node keeps the kMaxShapesPerKey most frequent shapes, counted with the space-saving
+ * algorithm: a shape seen when all the slots are taken replaces the least frequent one and inherits its count, which
+ * is then an over-estimate by at most max_overcount. The memory is fixed when the statistics are created.
+ */
+class ShapeStatistics {
+ public:
+  static constexpr size_t kMaxShapesPerKey = 8;
+
+  ShapeStatistics(uint64_t sample_rate, size_t num_nodes);
+
+  /*
+  Returns true for one in sample_rate calls, starting with the first one. Called once per run.
+  */
+  bool ShouldSampleRun() noexcept {
+    return run_count_.fetch_add(1, std::memory_order_relaxed) % sample_rate_ == 0;
+  }
+
+  /*
+  Records the shapes of the feeds of a run, sorted by OrtValue index so that the order the caller gave them in does
+  not matter.
+  */
+  void RecordInputs(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+                    const OrtValueNameIdxMap& name_idx_map);
+
+  /*
+  Records the shapes of the outputs of a node after it ran.
+  */
+  void RecordNodeOutputs(NodeIndex node_index, OpKernelContextInternal& context);
+
+  /*
+  The statistics as JSON: the sample rate, the number of sampled runs, the input signatures and, for the nodes that
+  ran in a sampled run, the node name, op type and output shapes. The shapes of each key are sorted by count.
+  */
+  std::string ToJson(const GraphViewer& graph_viewer) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ShapeStatistics);
+
+  struct Slot {
+    std::string shape;
+    uint64_t count = 0;
+    uint64_t max_overcount = 0;
+  };
+
+  // key 0 is the input signature, key i + 1 the outputs of node i
+  void Record(size_t key, std::string&& shape);
+  void WriteSlots(std::ostream& out, size_t key) const;
+
+  const uint64_t sample_rate_;
+  std::atomic<uint64_t> run_count_{0};
+  mutable OrtMutex mutex_;
+  std::vector<Slot> slots_;
+};
+
+}  // namespace onnxruntime
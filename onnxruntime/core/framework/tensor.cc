@@ -3,6 +3,7 @@
 
 #include "core/framework/tensor.h"
 
+#include <cstdlib>
 #include <utility>
 #include "core/common/safeint.h"
 #include "core/framework/allocatormgr.h"
@@ -12,7 +13,7 @@
 
 namespace onnxruntime {
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
 namespace {
 int64_t GetSizeFromStrides(const TensorShape& shape, gsl::span<const int64_t> strides) {
   SafeInt<int64_t> size = 1;
@@ -21,7 +22,8 @@ int64_t GetSizeFromStrides(const TensorShape& shape, gsl::span<const int64_t> st
       size = 0;
       break;
     }
-    size += strides[dim] * (shape[dim] - 1);
+    // a Slice with negative steps outputs negative strides
+    size += std::abs(strides[dim]) * (shape[dim] - 1);
   }
   return size;
 }
@@ -39,7 +41,7 @@ Tensor::Tensor(MLDataType p_type, const TensorShape& shape, std::shared_ptr<IAll
                gsl::span<const int64_t> strides)
     : alloc_info_(allocator->Info()) {
   ORT_ENFORCE(p_type != nullptr);
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
   int64_t shape_size = 1;
   if (shape.NumDimensions() > 0 && !strides.empty()) {
     ORT_ENFORCE(shape.NumDimensions() == strides.size(), "Length of strides doesn't match with tensor dimension size.");
@@ -48,7 +50,7 @@ Tensor::Tensor(MLDataType p_type, const TensorShape& shape, std::shared_ptr<IAll
     shape_size = shape.Size();
   }
 #else
-  ORT_ENFORCE(strides.empty(), "Strided tensor is supported for training only for now.");
+  ORT_ENFORCE(strides.empty(), "Strided tensors require onnxruntime_ENABLE_STRIDED_TENSORS.");
   int64_t shape_size = shape.Size();
 #endif
   if (shape_size < 0) ORT_THROW("shape.Size() must >=0");
@@ -87,7 +89,7 @@ void Tensor::InitOrtValue(MLDataType p_type, const TensorShape& shape, void* p_d
 }
 
 size_t Tensor::SizeInBytes() const {
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
   int64_t size = IsContiguous() ? shape_.Size() : GetSizeFromStrides(shape_, strides_);
 #else
   int64_t size = shape_.Size();
@@ -117,7 +119,7 @@ void Tensor::Init(MLDataType p_type, const TensorShape& shape, void* p_raw_data,
     utils::ConstructStrings(p_data_, shape_size);
   }
   byte_offset_ = offset;
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
   if (shape.NumDimensions() > 0 && !strides.empty()) {
     ORT_ENFORCE(shape.NumDimensions() == strides.size(), "Length of strides doesn't match with tensor dimension size.");
     strides_.assign(strides.begin(), strides.end());
@@ -135,6 +137,12 @@ Tensor::Tensor(Tensor&& other) noexcept
       dtype_(other.dtype_),
       alloc_info_(other.alloc_info_),
       byte_offset_(other.byte_offset_) {
+#ifdef ENABLE_STRIDED_TENSORS
+  strides_ = std::move(other.strides_);
+  is_contiguous_ = other.is_contiguous_;
+  other.strides_.clear();
+  other.is_contiguous_ = true;
+#endif
   other.dtype_ = DataTypeImpl::GetType<float>()->AsPrimitiveDataType();
   other.shape_ = TensorShape(std::vector<int64_t>(1, 0));
   other.p_data_ = nullptr;
@@ -152,6 +160,12 @@ Tensor& Tensor::operator=(Tensor&& other) noexcept {
     byte_offset_ = other.byte_offset_;
     p_data_ = other.p_data_;
     buffer_deleter_ = other.buffer_deleter_;
+#ifdef ENABLE_STRIDED_TENSORS
+    strides_ = std::move(other.strides_);
+    is_contiguous_ = other.is_contiguous_;
+    other.strides_.clear();
+    other.is_contiguous_ = true;
+#endif
 
     other.dtype_ = DataTypeImpl::GetType<float>()->AsPrimitiveDataType();
     other.shape_ = TensorShape(std::vector<int64_t>(1, 0));
@@ -175,7 +189,7 @@ void Tensor::ReleaseBuffer() {
   }
 }
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
 bool Tensor::CheckIsContiguous() const {
   if (strides_.empty()) {
     return true;
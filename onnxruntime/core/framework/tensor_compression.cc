@@ -0,0 +1,285 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tensor_compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace onnxruntime {
+namespace utils {
+
+namespace {
+
+// The LZ4 block format, see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md.
+// A block is a sequence of (literals, match) pairs. Each pair starts with a token which holds the literals length in
+// its high 4 bits and the match length minus kMinMatch in its low 4 bits, a value of 15 meaning more length bytes
+// follow. The match is a 2 byte little endian offset back into the decompressed data. The last pair has no match.
+constexpr size_t kMinMatch = 4;
+// The last 5 bytes are always literals, and a match can't start in the last 12 bytes.
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMatchSearchLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashLog = 16;
+
+inline uint32_t Read32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+inline uint32_t Hash(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - kHashLog);
+}
+
+void WriteLength(std::vector<uint8_t>& out, size_t length) {
+  length -= 15;
+  for (; length >= 255; length -= 255) {
+    out.push_back(255);
+  }
+  out.push_back(static_cast<uint8_t>(length));
+}
+
+void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literals_length,
+                   size_t offset, size_t match_length) {
+  const size_t match_code = match_length - kMinMatch;
+  out.push_back(static_cast<uint8_t>((std::min<size_t>(literals_length, 15) << 4) |
+                                     std::min<size_t>(match_code, 15)));
+  if (literals_length >= 15) {
+    WriteLength(out, literals_length);
+  }
+  out.insert(out.end(), literals, literals + literals_length);
+  out.push_back(static_cast<uint8_t>(offset & 0xff));
+  out.push_back(static_cast<uint8_t>(offset >> 8));
+  if (match_code >= 15) {
+    WriteLength(out, match_code);
+  }
+}
+
+// Greedy compression with a single candidate per hash of 4 bytes, which is fast and good enough for weights.
+void Lz4Compress(gsl::span<const uint8_t> source, std::vector<uint8_t>& out) {
+  const uint8_t* src = source.data();
+  const size_t size = source.size();
+
+  out.clear();
+  out.reserve(size + size / 255 + 16);
+
+  size_t anchor = 0;
+  if (size > kMatchSearchLimit) {
+    // positions + 1 of the last sequence with each hash, 0 meaning none
+    std::vector<size_t> table(size_t{1} << kHashLog, 0);
+    const size_t match_start_limit = size - kMatchSearchLimit;
+    const size_t match_end_limit = size - kLastLiterals;
+
+    size_t ip = 0;
+    while (ip < match_start_limit) {
+      const uint32_t sequence = Read32(src + ip);
+      size_t& entry = table[Hash(sequence)];
+      const size_t candidate = entry;
+      entry = ip + 1;
+
+      if (candidate != 0) {
+        const size_t ref = candidate - 1;
+        if (ip - ref <= kMaxOffset && Read32(src + ref) == sequence) {
+          size_t match_length = kMinMatch;
+          while (ip + match_length < match_end_limit && src[ref + match_length] == src[ip + match_length]) {
+            ++match_length;
+          }
+
+          WriteSequence(out, src + anchor, ip - anchor, ip - ref, match_length);
+          ip += match_length;
+          anchor = ip;
+          continue;
+        }
+      }
+
+      ++ip;
+    }
+  }
+
+  const size_t literals_length = size - anchor;
+  out.push_back(static_cast<uint8_t>(std::min<size_t>(literals_length, 15) << 4));
+  if (literals_length >= 15) {
+    WriteLength(out, literals_length);
+  }
+  if (literals_length > 0) {
+    out.insert(out.end(), src + anchor, src + size);
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status Lz4Decompress(gsl::span<const uint8_t> source, gsl::span<uint8_t> destination) {
+  const uint8_t* src = source.data();
+  const size_t src_size = source.size();
+  uint8_t* dst = destination.data();
+  const size_t dst_size = destination.size();
+
+  size_t ip = 0;
+  size_t op = 0;
+  auto read_length = [&](size_t& length) {
+    uint8_t byte;
+    do {
+      if (ip >= src_size) {
+        return false;
+      }
+      byte = src[ip++];
+      length += byte;
+    } while (byte == 255);
+    return true;
+  };
+
+  for (;;) {
+    ORT_RETURN_IF(ip >= src_size, "Compressed tensor data is truncated.");
+    const uint8_t token = src[ip++];
+
+    size_t literals_length = token >> 4;
+    ORT_RETURN_IF(literals_length == 15 && !read_length(literals_length), "Compressed tensor data is truncated.");
+    ORT_RETURN_IF(literals_length > src_size - ip || literals_length > dst_size - op,
+                  "Compressed tensor data is corrupt: literals are out of bounds.");
+    if (literals_length > 0) {
+      memcpy(dst + op, src + ip, literals_length);
+    }
+    ip += literals_length;
+    op += literals_length;
+
+    // the last sequence has no match
+    if (ip == src_size) {
+      break;
+    }
+
+    ORT_RETURN_IF(src_size - ip < 2, "Compressed tensor data is truncated.");
+    const size_t offset = static_cast<size_t>(src[ip]) | (static_cast<size_t>(src[ip + 1]) << 8);
+    ip += 2;
+    ORT_RETURN_IF(offset == 0 || offset > op, "Compressed tensor data is corrupt: match offset is out of bounds.");
+
+    size_t match_length = token & 15;
+    ORT_RETURN_IF(match_length == 15 && !read_length(match_length), "Compressed tensor data is truncated.");
+    match_length += kMinMatch;
+    ORT_RETURN_IF(match_length > dst_size - op, "Compressed tensor data is corrupt: match is out of bounds.");
+
+    const uint8_t* match = dst + op - offset;
+    if (offset >= match_length) {
+      memcpy(dst + op, match, match_length);
+    } else {
+      // the match overlaps the bytes it produces, e.g. a run of a repeated value
+      for (size_t i = 0; i < match_length; ++i) {
+        dst[op + i] = match[i];
+      }
+    }
+    op += match_length;
+  }
+
+  ORT_RETURN_IF(op != dst_size, "Compressed tensor data is corrupt: decompressed ", op, " bytes, expected ",
+                dst_size, ".");
+  return Status::OK();
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+void ByteShuffle(size_t element_size, gsl::span<const uint8_t> source, gsl::span<uint8_t> destination) {
+  const size_t num_elements = source.size() / element_size;
+  for (size_t b = 0; b < element_size; ++b) {
+    uint8_t* out = destination.data() + b * num_elements;
+    const uint8_t* in = source.data() + b;
+    for (size_t i = 0; i < num_elements; ++i) {
+      out[i] = in[i * element_size];
+    }
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+void ByteUnshuffle(size_t element_size, gsl::span<const uint8_t> source, gsl::span<uint8_t> destination) {
+  const size_t num_elements = source.size() / element_size;
+  for (size_t b = 0; b < element_size; ++b) {
+    const uint8_t* in = source.data() + b * num_elements;
+    uint8_t* out = destination.data() + b;
+    for (size_t i = 0; i < num_elements; ++i) {
+      out[i * element_size] = in[i];
+    }
+  }
+}
+
+}  // namespace
+
+Status ParseTensorCompression(const std::string& name, TensorCompression& compression) {
+  if (name.empty() || name == "none") {
+    compression = TensorCompression::kNone;
+  } else if (name == "lz4") {
+    compression = TensorCompression::kLz4;
+  } else if (name == "byte_shuffle_lz4") {
+    compression = TensorCompression::kByteShuffleLz4;
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported tensor compression: '", name,
+                           "'. Supported values are 'none', 'lz4' and 'byte_shuffle_lz4'.");
+  }
+
+  return Status::OK();
+}
+
+const char* TensorCompressionName(TensorCompression compression) {
+  switch (compression) {
+    case TensorCompression::kLz4:
+      return "lz4";
+    case TensorCompression::kByteShuffleLz4:
+      return "byte_shuffle_lz4";
+    default:
+      return "none";
+  }
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status CompressTensorData(TensorCompression compression, size_t element_size_in_bytes,
+                          gsl::span<const uint8_t> source_bytes,
+                          std::vector<uint8_t>& compressed_bytes) {
+  switch (compression) {
+    case TensorCompression::kLz4:
+      Lz4Compress(source_bytes, compressed_bytes);
+      return Status::OK();
+    case TensorCompression::kByteShuffleLz4: {
+      ORT_RETURN_IF(element_size_in_bytes == 0 || source_bytes.size() % element_size_in_bytes != 0,
+                    "Tensor data size ", source_bytes.size(), " is not a multiple of the element size ",
+                    element_size_in_bytes, ".");
+      if (element_size_in_bytes == 1) {
+        Lz4Compress(source_bytes, compressed_bytes);
+        return Status::OK();
+      }
+
+      std::vector<uint8_t> shuffled(source_bytes.size());
+      ByteShuffle(element_size_in_bytes, source_bytes, gsl::make_span(shuffled));
+      Lz4Compress(gsl::make_span(shuffled), compressed_bytes);
+      return Status::OK();
+    }
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid tensor compression ",
+                             static_cast<int>(compression), ".");
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status DecompressTensorData(TensorCompression compression, size_t element_size_in_bytes,
+                            gsl::span<const uint8_t> compressed_bytes,
+                            gsl::span<uint8_t> destination_bytes) {
+  switch (compression) {
+    case TensorCompression::kLz4:
+      return Lz4Decompress(compressed_bytes, destination_bytes);
+    case TensorCompression::kByteShuffleLz4: {
+      ORT_RETURN_IF(element_size_in_bytes == 0 || destination_bytes.size() % element_size_in_bytes != 0,
+                    "Tensor data size ", destination_bytes.size(), " is not a multiple of the element size ",
+                    element_size_in_bytes, ".");
+      if (element_size_in_bytes == 1) {
+        return Lz4Decompress(compressed_bytes, destination_bytes);
+      }
+
+      std::vector<uint8_t> shuffled(destination_bytes.size());
+      ORT_RETURN_IF_ERROR(Lz4Decompress(compressed_bytes, gsl::make_span(shuffled)));
+      ByteUnshuffle(element_size_in_bytes, gsl::make_span(shuffled), destination_bytes);
+      return Status::OK();
+    }
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid tensor compression ",
+                             static_cast<int>(compression), ".");
+  }
+}
+
+}  // namespace utils
+}  // namespace onnxruntime
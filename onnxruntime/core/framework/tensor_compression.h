@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "gsl/gsl"
+
+#include "core/common/status.h"
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+/**
+ * Codecs for the raw data of initializers saved in the ORT format.
+ * The values match the fbs::TensorCompression enum of the ORT format schema.
+ */
+enum class TensorCompression : int8_t {
+  // The raw data is not compressed.
+  kNone = 0,
+  // The raw data is compressed in the LZ4 block format.
+  kLz4 = 1,
+  // The bytes of the elements are grouped by their position in the element, e.g. all the exponent bytes of floats
+  // are grouped together, before being compressed in the LZ4 block format. This compresses numeric data better.
+  kByteShuffleLz4 = 2,
+};
+
+namespace utils {
+
+/**
+ * Gets the codec named `name`, which is one of "none", "lz4" and "byte_shuffle_lz4".
+ * An empty name is "none".
+ */
+Status ParseTensorCompression(const std::string& name, TensorCompression& compression);
+
+/**
+ * Gets the name of the codec, see ParseTensorCompression.
+ */
+const char* TensorCompressionName(TensorCompression compression);
+
+#if !defined(ORT_MINIMAL_BUILD)
+/**
+ * Compresses the raw data of a tensor.
+ *
+ * @param compression The codec. Must not be kNone.
+ * @param element_size_in_bytes The size of the tensor elements, used with kByteShuffleLz4.
+ * @param source_bytes The raw data. Its size must be a multiple of element_size_in_bytes.
+ * @param compressed_bytes The compressed data.
+ */
+Status CompressTensorData(TensorCompression compression, size_t element_size_in_bytes,
+                          gsl::span<const uint8_t> source_bytes,
+                          std::vector<uint8_t>& compressed_bytes);
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+/**
+ * Decompresses the raw data of a tensor. The compressed data is validated, so a corrupt model fails to load.
+ *
+ * @param compression The codec the data was compressed with. Must not be kNone.
+ * @param element_size_in_bytes The size of the tensor elements.
+ * @param compressed_bytes The compressed data.
+ * @param destination_bytes The raw data, which must be exactly the size of the decompressed data.
+ */
+Status DecompressTensorData(TensorCompression compression, size_t element_size_in_bytes,
+                            gsl::span<const uint8_t> compressed_bytes,
+                            gsl::span<uint8_t> destination_bytes);
+
+}  // namespace utils
+}  // namespace onnxruntime
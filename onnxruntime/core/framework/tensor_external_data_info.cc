@@ -40,6 +40,13 @@ Status ExternalDataInfo::Create(const RepeatedPtrField<StringStringEntryProto>&
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "parsing ", stringmap.value(), " failed");
     } else if (stringmap.key() == "checksum" && !stringmap.value().empty()) {
       out->checksum_ = stringmap.value();
+    } else if (stringmap.key() == "compression") {
+      ORT_RETURN_IF_ERROR(utils::ParseTensorCompression(stringmap.value(), out->compression_));
+    } else if (stringmap.key() == "compressed_length" && !stringmap.value().empty()) {
+      char* end;
+      out->compressed_length_ = static_cast<size_t>(OrtStrToPtrDiff(stringmap.value().c_str(), &end));
+      if (end != stringmap.value().c_str() + stringmap.value().length())
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "parsing ", stringmap.value(), " failed");
     } else {
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error!");
     }
@@ -4,6 +4,7 @@
 
 #include <string>
 #include "core/common/status.h"
+#include "core/framework/tensor_compression.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/onnxruntime_c_api.h"
 
@@ -22,6 +23,10 @@ class ExternalDataInfo {
   size_t length_ = 0;
   std::string checksum_;
 
+  // compression of data that is in memory, see kTensorProtoMemoryAddressTag
+  TensorCompression compression_ = TensorCompression::kNone;
+  size_t compressed_length_ = 0;
+
  public:
   const std::basic_string<ORTCHAR_T>& GetRelPath() const { return rel_path_; }
 
@@ -30,6 +35,9 @@ class ExternalDataInfo {
 
   const std::string& GetChecksum() const { return checksum_; }
 
+  TensorCompression GetCompression() const { return compression_; }
+  size_t GetCompressedLength() const { return compressed_length_; }
+
   // If the value of 'offset' or 'length' field is larger the max value of ssize_t, this function will treat it as a
   // wrong value and return FAIL.
   static common::Status Create(const ::google::protobuf::RepeatedPtrField<::ONNX_NAMESPACE::StringStringEntryProto>& input,
@@ -17,6 +17,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/callback.h"
 #include "core/framework/data_types.h"
+#include "core/framework/tensor_compression.h"
 #include "core/platform/path_lib.h"
 #include "core/session/ort_apis.h"
 #include "onnx/defs/tensor_proto_util.h"
@@ -121,7 +122,9 @@ static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_prot
                                   const ORTCHAR_T* tensor_proto_dir,
                                   std::basic_string<ORTCHAR_T>& external_file_path,
                                   onnxruntime::FileOffsetType& file_offset,
-                                  SafeInt<size_t>& tensor_byte_size) {
+                                  SafeInt<size_t>& tensor_byte_size,
+                                  onnxruntime::TensorCompression& compression,
+                                  size_t& compressed_length) {
   ORT_RETURN_IF_NOT(onnxruntime::utils::HasExternalData(tensor_proto),
                     "Tensor does not have external data to read from.");
 
@@ -131,13 +134,19 @@ static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_prot
   std::unique_ptr<onnxruntime::ExternalDataInfo> external_data_info;
   ORT_RETURN_IF_ERROR(onnxruntime::ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info));
 
-  if (tensor_proto_dir != nullptr) {
+  if (tensor_proto_dir != nullptr &&
+      external_data_info->GetRelPath() != onnxruntime::utils::kTensorProtoMemoryAddressTag) {
     external_file_path = onnxruntime::ConcatPathComponent<ORTCHAR_T>(tensor_proto_dir, external_data_info->GetRelPath());
   } else {
     external_file_path = external_data_info->GetRelPath();
   }
 
   file_offset = external_data_info->GetOffset();
+  compression = external_data_info->GetCompression();
+  compressed_length = external_data_info->GetCompressedLength();
+  ORT_RETURN_IF(compression != onnxruntime::TensorCompression::kNone &&
+                    external_data_info->GetRelPath() != onnxruntime::utils::kTensorProtoMemoryAddressTag,
+                "TensorProto: ", tensor_proto.name(), " only external data in memory can be compressed.");
 
   ORT_RETURN_IF_ERROR(onnxruntime::utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &tensor_byte_size));
   const size_t external_data_length = external_data_info->GetLength();
@@ -149,6 +158,25 @@ static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_prot
   return Status::OK();
 }
 
+// Copy external data that is already in memory at address into the destination, which is the size of the tensor
+// data, decompressing it if needed.
+static Status ReadExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                       onnxruntime::FileOffsetType address,
+                                       onnxruntime::TensorCompression compression,
+                                       size_t compressed_length,
+                                       gsl::span<uint8_t> destination) {
+  const auto* data = reinterpret_cast<const uint8_t*>(static_cast<uintptr_t>(address));
+  if (compression == onnxruntime::TensorCompression::kNone) {
+    std::copy_n(data, destination.size(), destination.data());
+    return Status::OK();
+  }
+
+  const size_t element_size =
+      onnxruntime::DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType()->Size();
+  return onnxruntime::utils::DecompressTensorData(compression, element_size, gsl::make_span(data, compressed_length),
+                                                  destination);
+}
+
 // Read external data for tensor in unint8_t* form and return Status::OK() if the data is read successfully.
 // Uses the tensor_proto_dir to construct the full path for external data. If tensor_proto_dir == nullptr
 // then uses the current directory instead.
@@ -159,14 +187,24 @@ static Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tenso
   std::basic_string<ORTCHAR_T> external_file_path;
   onnxruntime::FileOffsetType file_offset;
   SafeInt<size_t> tensor_byte_size;
+  onnxruntime::TensorCompression compression;
+  size_t compressed_length;
   ORT_RETURN_IF_ERROR(GetExternalDataInfo(
       tensor_proto,
       tensor_proto_dir,
       external_file_path,
       file_offset,
-      tensor_byte_size));
+      tensor_byte_size,
+      compression,
+      compressed_length));
 
   unpacked_tensor.resize(tensor_byte_size);
+  if (external_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag) {
+    // the data is already in memory, the offset is its address
+    return ReadExternalDataInMemory(tensor_proto, file_offset, compression, compressed_length,
+                                    gsl::make_span(unpacked_tensor));
+  }
+
   ORT_RETURN_IF_ERROR(onnxruntime::Env::Default().ReadFileIntoBuffer(
       external_file_path.c_str(),
       file_offset,
@@ -555,7 +593,7 @@ static void DeleteCharArray(void* param) noexcept {
 
 static Status GetFileContent(
     const Env& env, const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
-    void*& raw_buffer, OrtCallback& deleter) {
+    void*& raw_buffer, OrtCallback& deleter, bool require_mapping = false) {
   // query length if it is 0
   if (length == 0) {
     ORT_RETURN_IF_ERROR(env.GetFileLength(file_path, length));
@@ -570,6 +608,10 @@ static Status GetFileContent(
       raw_buffer = mapped_memory.release();
       return Status::OK();
     }
+
+    if (require_mapping) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to map external data into memory. ", status.ErrorMessage());
+    }
   }
 
   // if that fails, try to copy
@@ -582,8 +624,37 @@ static Status GetFileContent(
   return Status::OK();
 }
 
+bool HasExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  if (!utils::HasExternalData(tensor_proto)) {
+    return false;
+  }
+
+  for (const auto& entry : tensor_proto.external_data()) {
+    if (entry.key() == "location") {
+      return ToWideString(entry.value()) == kTensorProtoMemoryAddressTag;
+    }
+  }
+
+  return false;
+}
+
+bool HasCompressedExternalData(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  if (!utils::HasExternalData(tensor_proto)) {
+    return false;
+  }
+
+  for (const auto& entry : tensor_proto.external_data()) {
+    if (entry.key() == "compression") {
+      return !entry.value().empty() && entry.value() != TensorCompressionName(TensorCompression::kNone);
+    }
+  }
+
+  return false;
+}
+
 Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_path, const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                 void*& ext_data_buf, size_t& ext_data_len, OrtCallback& ext_data_deleter)
+                                 void*& ext_data_buf, size_t& ext_data_len, OrtCallback& ext_data_deleter,
+                                 bool require_mapping)
 {
   ORT_ENFORCE(utils::HasExternalData(tensor_proto));
   ORT_ENFORCE(model_path);
@@ -593,8 +664,31 @@ Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_path, co
   std::basic_string<ORTCHAR_T> external_data_file_path;
   FileOffsetType file_offset;
   SafeInt<size_t> raw_data_safe_len;
-  ORT_RETURN_IF_ERROR(GetExternalDataInfo(tensor_proto, t_prot_dir_s, external_data_file_path, file_offset, raw_data_safe_len));
-  ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path.c_str(), file_offset, raw_data_safe_len, ext_data_buf, ext_data_deleter));
+  TensorCompression compression;
+  size_t compressed_length;
+  ORT_RETURN_IF_ERROR(GetExternalDataInfo(tensor_proto, t_prot_dir_s, external_data_file_path, file_offset,
+                                          raw_data_safe_len, compression, compressed_length));
+  if (external_data_file_path == kTensorProtoMemoryAddressTag) {
+    ext_data_len = raw_data_safe_len;
+    if (compression != TensorCompression::kNone) {
+      // the data is decompressed into a buffer owned by the tensor
+      auto buffer = std::make_unique<char[]>(ext_data_len);
+      ORT_RETURN_IF_ERROR(ReadExternalDataInMemory(
+          tensor_proto, file_offset, compression, compressed_length,
+          gsl::make_span(reinterpret_cast<uint8_t*>(buffer.get()), ext_data_len)));
+      ext_data_deleter = OrtCallback{DeleteCharArray, buffer.get()};
+      ext_data_buf = buffer.release();
+      return Status::OK();
+    }
+
+    // the data is used in place, its owner outlives the tensor
+    ext_data_buf = reinterpret_cast<void*>(static_cast<uintptr_t>(file_offset));
+    ext_data_deleter = OrtCallback{nullptr, nullptr};
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path.c_str(), file_offset, raw_data_safe_len, ext_data_buf,
+                                     ext_data_deleter, require_mapping));
   ext_data_len = raw_data_safe_len;
   return Status::OK();
 }
@@ -637,6 +731,8 @@ Status TensorProtoToTensor(const Env& env, const ORTCHAR_T* model_path,
     // Get the external data info
     std::basic_string<ORTCHAR_T> external_data_file_path;
     FileOffsetType file_offset;
+    TensorCompression compression;
+    size_t compressed_length;
     std::basic_string<ORTCHAR_T> tensor_proto_dir;
     if (model_path != nullptr) {
       ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(model_path, tensor_proto_dir));
@@ -644,22 +740,45 @@ Status TensorProtoToTensor(const Env& env, const ORTCHAR_T* model_path,
     ORT_RETURN_IF_ERROR(GetExternalDataInfo(
         tensor_proto,
         tensor_proto_dir.size() == 0 ? nullptr : tensor_proto_dir.c_str(),
-        external_data_file_path, file_offset, raw_data_len));
-
-    size_t file_length;
-    ORT_RETURN_IF_ERROR(env.GetFileLength(external_data_file_path.c_str(), file_length));
-
-    SafeInt<FileOffsetType> end_of_read(file_offset);
-    end_of_read += raw_data_len;
-    ORT_RETURN_IF(file_offset < 0 || end_of_read > gsl::narrow<FileOffsetType>(file_length),
-                  "External initializer: ", tensor_proto.name(),
-                  " offset: ", file_offset, " size to read: ", static_cast<size_t>(raw_data_len), " given file_length: ", file_length,
-                  " are out of bounds or can not be read in full.");
-
-    // load the file
-    ORT_RETURN_IF_ERROR(GetFileContent(
-        env, external_data_file_path.c_str(), file_offset, raw_data_len,
-        raw_data, deleter_for_file_data.d));
+        external_data_file_path, file_offset, raw_data_len, compression, compressed_length));
+
+    if (external_data_file_path == kTensorProtoMemoryAddressTag && compression != TensorCompression::kNone) {
+      ORT_IF_CONSTEXPR(endian::native == endian::little) {
+        if (source_type == tensor.DataType()) {
+          // decompress directly into the tensor, the raw data needs no conversion
+          ORT_RETURN_IF_NOT(static_cast<size_t>(raw_data_len) == tensor.SizeInBytes(),
+                            "TensorProtoToTensor() tensor size mismatch!");
+          return ReadExternalDataInMemory(
+              tensor_proto, file_offset, compression, compressed_length,
+              gsl::make_span(static_cast<uint8_t*>(tensor.MutableDataRaw()), tensor.SizeInBytes()));
+        }
+      }
+
+      auto buffer = std::make_unique<char[]>(raw_data_len);
+      ORT_RETURN_IF_ERROR(ReadExternalDataInMemory(
+          tensor_proto, file_offset, compression, compressed_length,
+          gsl::make_span(reinterpret_cast<uint8_t*>(buffer.get()), static_cast<size_t>(raw_data_len))));
+      deleter_for_file_data.d = OrtCallback{DeleteCharArray, buffer.get()};
+      raw_data = buffer.release();
+    } else if (external_data_file_path == kTensorProtoMemoryAddressTag) {
+      // the data is already in memory, the offset is its address
+      raw_data = reinterpret_cast<void*>(static_cast<uintptr_t>(file_offset));
+    } else {
+      size_t file_length;
+      ORT_RETURN_IF_ERROR(env.GetFileLength(external_data_file_path.c_str(), file_length));
+
+      SafeInt<FileOffsetType> end_of_read(file_offset);
+      end_of_read += raw_data_len;
+      ORT_RETURN_IF(file_offset < 0 || end_of_read > gsl::narrow<FileOffsetType>(file_length),
+                    "External initializer: ", tensor_proto.name(),
+                    " offset: ", file_offset, " size to read: ", static_cast<size_t>(raw_data_len), " given file_length: ", file_length,
+                    " are out of bounds or can not be read in full.");
+
+      // load the file
+      ORT_RETURN_IF_ERROR(GetFileContent(
+          env, external_data_file_path.c_str(), file_offset, raw_data_len,
+          raw_data, deleter_for_file_data.d));
+    }
   } else if (utils::HasRawData(tensor_proto)) {
     raw_data = const_cast<char*>(tensor_proto.raw_data().data());
     // TODO The line above has const-correctness issues. Below is a possible fix which copies the tensor_proto data
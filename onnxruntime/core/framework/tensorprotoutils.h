@@ -75,10 +75,25 @@ ONNXTensorElementDataType GetTensorElementType(const ONNX_NAMESPACE::TensorProto
 template <size_t alignment>
 common::Status GetSizeInBytesFromTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_proto, size_t* out);
 
+// The location of external data that is already in memory, e.g. the initializers of an ORT format model which are
+// used in place in the model bytes. The offset of the external data is the address of the data.
+static constexpr const ORTCHAR_T* kTensorProtoMemoryAddressTag = ORT_TSTR("*/_ORT_MEM_ADDR_/*");
+
+// Returns true if the external data of the tensor proto is located at kTensorProtoMemoryAddressTag.
+bool HasExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
+// Returns true if the external data of the tensor proto is compressed, see TensorCompression. Only external data at
+// kTensorProtoMemoryAddressTag can be compressed. It is decompressed when it is read.
+bool HasCompressedExternalData(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
 // Given a tensor proto with external data obtain a pointer to the data and its length.
 // The ext_data_deleter argument is updated with a callback that owns/releases the data.
+// The data is memory mapped if possible, and read into a buffer otherwise unless require_mapping is true.
+// Data located at kTensorProtoMemoryAddressTag is returned in place, and ext_data_deleter is set to a null callback,
+// unless it is compressed in which case it is decompressed into a buffer.
 Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_path, const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                 void*& ext_data_buf, size_t& ext_data_len, OrtCallback& ext_data_deleter);
+                                 void*& ext_data_buf, size_t& ext_data_len, OrtCallback& ext_data_deleter,
+                                 bool require_mapping = false);
 
 // Convert the AttributeProto from a Constant node into a TensorProto that can be used as an initializer
 // If AttributeProto contains a TensorProto, this tensor proto is converted as is including the case when the
@@ -3,7 +3,9 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/utils.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <sstream>
 
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
@@ -14,6 +16,7 @@
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/parallel_executor.h"
+#include "core/framework/work_stealing_executor.h"
 #include "core/framework/session_state.h"
 #include "core/framework/sequential_executor.h"
 #include "core/framework/tensorprotoutils.h"
@@ -552,18 +555,20 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
                                        const FeedsFetchesManager& feeds_fetches_manager,
                                        const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                        const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
-                                       ExecutionMode execution_mode, const bool& terminate_flag,
+                                       ExecutionMode execution_mode, const RunTermination& termination,
                                        const logging::Logger& logger, const bool only_execute_path_to_fetches = false) {
   std::unique_ptr<IExecutor> p_exec;
   if (execution_mode == ExecutionMode::ORT_SEQUENTIAL) {
-    p_exec = std::make_unique<SequentialExecutor>(terminate_flag, only_execute_path_to_fetches);
+    p_exec = std::make_unique<SequentialExecutor>(termination, only_execute_path_to_fetches);
   } else if (execution_mode == ExecutionMode::ORT_PARALLEL) {
     auto* p_inter_op_thread_pool = session_state.GetInterOpThreadPool();
     if (!p_inter_op_thread_pool) {
       LOGS(logger, WARNING) << "Only one thread was configured for parallel execution. Hence will use sequential execution.";
-      p_exec = std::make_unique<SequentialExecutor>(terminate_flag, only_execute_path_to_fetches);
+      p_exec = std::make_unique<SequentialExecutor>(termination, only_execute_path_to_fetches);
+    } else if (session_state.UseWorkStealingExecutor()) {
+      p_exec = std::make_unique<WorkStealingExecutor>(session_state, termination);
     } else {
-      p_exec = std::make_unique<ParallelExecutor>(session_state, terminate_flag);
+      p_exec = std::make_unique<ParallelExecutor>(session_state, termination);
     }
   }
 
@@ -624,7 +629,7 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
 common::Status ExecuteGraph(const SessionState& session_state,
                             FeedsFetchesManager& feeds_fetches_manager,
                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
-                            ExecutionMode execution_mode, const bool& terminate_flag,
+                            ExecutionMode execution_mode, const RunTermination& termination,
                             const logging::Logger& logger, bool only_execute_path_to_fetches) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
@@ -632,11 +637,20 @@ common::Status ExecuteGraph(const SessionState& session_state,
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
 
   auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
-                                 execution_mode, terminate_flag, logger, only_execute_path_to_fetches);
+                                 execution_mode, termination, logger, only_execute_path_to_fetches);
 
   return status;
 }
 
+common::Status ExecutePreparedGraph(const SessionState& session_state,
+                                    const FeedsFetchesManager& feeds_fetches_manager,
+                                    const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                                    ExecutionMode execution_mode, const RunTermination& termination,
+                                    const logging::Logger& logger, bool only_execute_path_to_fetches) {
+  return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+                          execution_mode, termination, logger, only_execute_path_to_fetches);
+}
+
 #ifdef ENABLE_TRAINING
 common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                                    const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
@@ -703,9 +717,10 @@ common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetch
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
                                const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
-                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger) {
+                               ExecutionMode execution_mode, const RunTermination& termination,
+                               const logging::Logger& logger) {
   auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
-                                 execution_mode, terminate_flag, logger);
+                                 execution_mode, termination, logger);
   return status;
 }
 
@@ -780,6 +795,29 @@ common::Status VerifyInputTensorsAllocatedContiguously(OpKernelContext* context)
 }
 #endif
 
+std::string GetParallelForTuningKey(const SessionState& session_state, const OpKernelContext& context) {
+  if (session_state.GetParallelForTuner() == nullptr) {
+    return {};
+  }
+
+  // kernels whose inputs have sizes of the same magnitudes share their tuning
+  constexpr int max_inputs_in_key = 3;
+  std::ostringstream key;
+  key << context.GetOpDomain() << ":" << context.GetOpType();
+  for (int i = 0, end = std::min(context.InputCount(), max_inputs_in_key); i < end; ++i) {
+    const OrtValue* input = context.GetInputOrtValue(i);
+    int size_class = -1;
+    if (input != nullptr && input->IsTensor()) {
+      size_class = 0;
+      for (int64_t size = input->Get<Tensor>().Shape().Size(); size > 1; size >>= 1) {
+        ++size_class;
+      }
+    }
+    key << (i == 0 ? "|" : ",") << size_class;
+  }
+  return key.str();
+}
+
 bool IsInputOnCpu(const Node& node, const KernelCreateInfo* p_kci, size_t index) {
   if (p_kci && p_kci->kernel_def->IsInputOnCpu(index)) {
     return true;
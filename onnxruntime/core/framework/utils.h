@@ -8,6 +8,7 @@
 #include "core/framework/data_types.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/iexecutor.h"
+#include "core/framework/run_termination.h"
 #include "core/framework/session_state.h"
 #include "core/framework/session_options.h"
 #ifdef ENABLE_TRAINING
@@ -88,8 +89,16 @@ void FinalizeFeedFetchCopyInfo(FeedsFetchesManager& feeds_fetches_manager,
 // Execute the main graph. The feed_fetches_manager will be finalized based on the provided feeds and fetches.
 common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
-                            ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
-                            bool only_execute_path_to_fetches = false);
+                            ExecutionMode execution_mode, const RunTermination& termination,
+                            const logging::Logger& logger, bool only_execute_path_to_fetches = false);
+
+// Execute the main graph with a feeds_fetches_manager finalized by a previous ExecuteGraph call with feeds and fetches
+// on the same devices, e.g. by the previous Run() of an IOBinding.
+common::Status ExecutePreparedGraph(const SessionState& session_state,
+                                    const FeedsFetchesManager& feeds_fetches_manager,
+                                    const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                                    ExecutionMode execution_mode, const RunTermination& termination,
+                                    const logging::Logger& logger, bool only_execute_path_to_fetches = false);
 
 #ifdef ENABLE_TRAINING
 common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
@@ -103,7 +112,8 @@ common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetch
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
                                const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
-                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger);
+                               ExecutionMode execution_mode, const RunTermination& termination,
+                               const logging::Logger& logger);
 
 bool IsInputOnCpu(const Node& node, const KernelCreateInfo* p_kci, size_t index);
 
@@ -188,5 +198,9 @@ int32_t ONNXTensorElementDataTypeToProtoTensorType(ONNXTensorElementDataType);
 common::Status VerifyInputTensorsAllocatedContiguously(OpKernelContext* context);
 #endif
 
+// Returns the key identifying the kernel run with context and the class of its input shapes for the
+// ParallelForTuner of session_state, or an empty string if the session does not tune its parallel loops.
+std::string GetParallelForTuningKey(const SessionState& session_state, const OpKernelContext& context);
+
 }  // namespace utils
 }  // namespace onnxruntime
@@ -0,0 +1,431 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/work_stealing_executor.h"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/allocation_planner.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/session_state.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// number of times an idle worker polls the queues before blocking
+static constexpr int kIdleSpinCount = 64;
+
+WorkStealingExecutor::WorkStealingExecutor(const SessionState& session_state, const RunTermination& termination)
+    : node_priorities_(session_state.GetNodePriorities()),
+      termination_(termination),
+      executor_pool_(session_state.GetInterOpThreadPool()) {
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  ORT_ENFORCE(node_priorities_.size() == static_cast<size_t>(graph_viewer.MaxNodeIndex()),
+              "Node priorities have not been computed for the WorkStealingExecutor.");
+
+  node_refs_ = std::vector<std::atomic<size_t>>(graph_viewer.MaxNodeIndex());
+  for (auto& node : graph_viewer.Nodes()) {
+    node_refs_[node.Index()].store(node.GetInputEdgesCount(), std::memory_order_relaxed);
+  }
+
+  const int num_workers = concurrency::ThreadPool::DegreeOfParallelism(executor_pool_);
+  queues_.reserve(num_workers);
+  for (int i = 0; i < num_workers; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+}
+
+Status WorkStealingExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
+                                     const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                                     std::vector<OrtValue>& fetches,
+                                     const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
+                                     const logging::Logger& logger) {
+  TimePoint tp;
+  const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  if (is_profiler_enabled) {
+    tp = session_state.Profiler().Start();
+  }
+
+  root_frame_ = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
+                                                 fetch_allocators, session_state);
+
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  num_pending_nodes_ = static_cast<size_t>(graph_viewer.NumberOfNodes());
+
+  // hand out the root nodes round robin, highest priority first. the owner of a queue pops from the back.
+  std::vector<NodeIndex> root_nodes = graph_viewer.GetRootNodes();
+  std::stable_sort(root_nodes.begin(), root_nodes.end(), [this](NodeIndex a, NodeIndex b) {
+    return node_priorities_[a] > node_priorities_[b];
+  });
+  for (size_t i = 0; i < root_nodes.size(); ++i) {
+    queues_[i % queues_.size()]->nodes.push_front(root_nodes[i]);
+  }
+  num_queued_nodes_ = root_nodes.size();
+
+  if (num_pending_nodes_ > 0) {
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        executor_pool_, static_cast<std::ptrdiff_t>(queues_.size()),
+        [this, &session_state, &logger](std::ptrdiff_t worker) {
+          RunWorker(static_cast<size_t>(worker), session_state, logger);
+        });
+  }
+
+  Status status = Status::OK();
+
+  if (!errors_.empty()) {
+    if (errors_.size() == 1)
+      status = errors_.front();
+    else {
+      std::stringstream ss;
+      ss << "Multiple errors were found.";
+      for (const auto& s : errors_) {
+        ss << '\n'
+           << s;
+      }
+
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ss.str());
+    }
+
+    LOGS(logger, ERROR) << status;
+    return status;
+  }
+
+  VLOGS(logger, 1) << "Fetching output.";
+  // ExecutionFrame::Finalize will update 'fetches' with the final output
+  ORT_RETURN_IF_ERROR(root_frame_->GetOutputs(fetches));
+  VLOGS(logger, 1) << "Done execution.";
+
+  if (root_frame_->HasMemoryPatternPlanner()) {
+    bool all_tensors = true;
+    for (const auto& feed : feeds) {
+      if (!(feed.IsTensor())) {
+        all_tensors = false;
+        break;
+      }
+    }
+
+    if (all_tensors) {
+      auto mem_patterns = std::make_unique<MemoryPatternGroup>();
+      ORT_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
+      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+    }
+  }
+
+  if (is_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "WorkStealingExecutor::Execute", tp);
+  }
+
+  return Status::OK();
+}
+
+void WorkStealingExecutor::RunWorker(size_t worker, const SessionState& session_state,
+                                     const logging::Logger& logger) {
+  NodeIndex node_index;
+  while (num_pending_nodes_ > 0 && !failed_) {
+    if (!TryPopNode(worker, node_index)) {
+      WaitForWork();
+      continue;
+    }
+
+    auto create_exception_message = [node_index, &session_state](const std::exception* ex) {
+      const auto* node = session_state.GetGraphViewer().GetNode(node_index);
+
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
+                             " node '", node->Name(), "'. ",
+                             ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
+    };
+
+    Status status;
+    ORT_TRY {
+      status = RunNodes(worker, node_index, session_state, logger);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = create_exception_message(&ex);
+      });
+    }
+    ORT_CATCH(...) {
+      // catch node processing failure exceptions here to prevent app crash.
+      status = create_exception_message(nullptr);
+    }
+
+    if (!status.IsOK()) {
+      {
+        std::lock_guard<OrtMutex> lock(errors_mutex_);
+        errors_.push_back(status);
+      }
+
+      // the remaining nodes are abandoned
+      failed_ = true;
+      NotifyAll();
+    }
+  }
+}
+
+Status WorkStealingExecutor::RunNodes(size_t worker, NodeIndex node_index, const SessionState& session_state,
+                                      const logging::Logger& logger) {
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  std::vector<NodeIndex> ready_nodes;
+
+  // Avoid going through the queue for the most important node made ready by the previous one.
+  while (true) {
+    if (termination_.IsTerminated()) {
+      Status termination_status = termination_.Check();
+      LOGS(logger, WARNING) << termination_status.ErrorMessage();
+      return termination_status;
+    }
+
+    if (failed_) {
+      return Status::OK();
+    }
+
+    ORT_RETURN_IF_ERROR(RunNode(node_index, session_state, logger));
+
+    const auto& node = *graph_viewer.GetNode(node_index);
+    ready_nodes.clear();
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      auto idx = (*it).GetNode().Index();
+      if (node_refs_[idx].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        ready_nodes.push_back(idx);
+      }
+    }
+
+    const bool has_next = !ready_nodes.empty();
+    if (has_next) {
+      std::stable_sort(ready_nodes.begin(), ready_nodes.end(), [this](NodeIndex a, NodeIndex b) {
+        return node_priorities_[a] < node_priorities_[b];
+      });
+
+      // keep the node with the longest critical path, and push the others so the next most important one ends up
+      // at the back of the queue
+      node_index = ready_nodes.back();
+      for (size_t i = 0; i + 1 < ready_nodes.size(); ++i) {
+        PushNode(worker, ready_nodes[i]);
+      }
+    }
+
+    if (--num_pending_nodes_ == 0) {
+      NotifyAll();
+    }
+
+    if (!has_next) {
+      return Status::OK();
+    }
+  }
+}
+
+Status WorkStealingExecutor::RunNode(NodeIndex node_index, const SessionState& session_state,
+                                     const logging::Logger& logger) {
+  Status status = Status::OK();
+
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  TimePoint sync_time_begin;
+  TimePoint kernel_begin_time;
+  const bool f_profiler_enabled = session_state.Profiler().IsEnabled();
+  const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
+
+  const auto* p_op_kernel = session_state.GetKernel(node_index);
+  const auto& node = *graph_viewer.GetNode(node_index);
+
+  // if a kernel has been added in the session state, it better be NON-null.
+  if (p_op_kernel == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ", node.Name());
+  }
+
+  OpKernelContextInternal op_kernel_context(session_state, *root_frame_, *p_op_kernel, logger, termination_);
+
+  if (f_profiler_enabled) {
+    sync_time_begin = session_state.Profiler().Start();
+  }
+  // sync before compute
+  int queue_id = p_op_kernel->KernelDef().ExecQueueId();
+  if (exec_plan.NodeHasFence(node_index)) {
+    for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.InputFence(input_index);
+      if (fence) {
+        auto execution_provider_type = node.GetExecutionProviderType();
+        if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+          execution_provider_type = kCpuExecutionProvider;
+        }
+        fence->BeforeUsingAsInput(execution_provider_type, queue_id);
+      }
+    }
+
+    for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+      if (fence) {
+        auto execution_provider_type = node.GetExecutionProviderType();
+        if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+          execution_provider_type = kCpuExecutionProvider;
+        }
+        fence->BeforeUsingAsInput(execution_provider_type, queue_id);
+      }
+    }
+
+    for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+      Fence_t fence = op_kernel_context.OutputFence(output_index);
+      if (fence) {
+        fence->BeforeUsingAsOutput(node.GetExecutionProviderType(), queue_id);
+      }
+    }
+  }
+
+  if (f_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                   node.Name() + "_fence_before",
+                                                   sync_time_begin,
+                                                   {{"op_name", p_op_kernel->KernelDef().OpName()}});
+    concurrency::ThreadPool::StartProfiling(session_state.GetThreadPool());
+    kernel_begin_time = session_state.Profiler().Start();
+  }
+
+  // call compute on the kernel
+  VLOGS(logger, 1) << "Computing kernel: " << node.Name();
+
+  // Execute the kernel.
+  concurrency::ParallelForTuner::KernelScope tuning_scope(
+      session_state.GetParallelForTuner(), utils::GetParallelForTuningKey(session_state, op_kernel_context));
+  ORT_TRY {
+#ifdef ENABLE_TRAINING
+    if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
+      ORT_RETURN_IF_ERROR(utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context));
+    }
+#endif
+
+    status = p_op_kernel->Compute(&op_kernel_context);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+
+  if (!status.IsOK()) {
+    std::ostringstream ss;
+    ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
+       << "' Status Message: " << status.ErrorMessage();
+    const auto msg_string = ss.str();
+    LOGS(logger, ERROR) << msg_string;
+    return Status(status.Category(), status.Code(), msg_string);
+  }
+
+  if (f_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                   node.Name() + "_kernel_time",
+                                                   kernel_begin_time,
+                                                   {{"op_name", p_op_kernel->KernelDef().OpName()},
+                                                    {"provider", p_op_kernel->KernelDef().Provider()},
+                                                    {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())}});
+
+    for (const auto& span : concurrency::ThreadPool::TakeProfilingSpans(session_state.GetThreadPool())) {
+      session_state.Profiler().RecordEvent(profiling::THREAD_POOL_EVENT,
+                                           node.Name() + (span.is_parallel_loop ? "_parallel_loop" : "_task"),
+                                           span.thread_id, span.start, span.end,
+                                           {{"op_name", p_op_kernel->KernelDef().OpName()}});
+    }
+
+    sync_time_begin = session_state.Profiler().Start();
+  }
+  // sync after compute for outputs
+  if (exec_plan.NodeHasFence(node_index)) {
+    for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.InputFence(input_index);
+      if (fence) {
+        fence->AfterUsedAsInput(queue_id);
+      }
+    }
+
+    for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+      if (fence) {
+        fence->AfterUsedAsInput(queue_id);
+      }
+    }
+
+    for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+      Fence_t fence = op_kernel_context.OutputFence(output_index);
+      if (fence) {
+        fence->AfterUsedAsOutput(queue_id);
+      }
+    }
+  }
+  if (f_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                   node.Name() + "_fence_after",
+                                                   sync_time_begin,
+                                                   {{"op_name", p_op_kernel->KernelDef().OpName()}});
+  }
+
+  return status;
+}
+
+void WorkStealingExecutor::PushNode(size_t worker, NodeIndex node_index) {
+  {
+    auto& queue = *queues_[worker];
+    std::lock_guard<OrtMutex> lock(queue.mutex);
+    queue.nodes.push_back(node_index);
+  }
+
+  ++num_queued_nodes_;
+  if (num_idle_workers_ > 0) {
+    std::lock_guard<OrtMutex> lock(idle_mutex_);
+    idle_cv_.notify_one();
+  }
+}
+
+bool WorkStealingExecutor::TryPopNode(size_t worker, NodeIndex& node_index) {
+  {
+    auto& queue = *queues_[worker];
+    std::lock_guard<OrtMutex> lock(queue.mutex);
+    if (!queue.nodes.empty()) {
+      node_index = queue.nodes.back();
+      queue.nodes.pop_back();
+      --num_queued_nodes_;
+      return true;
+    }
+  }
+
+  // steal the oldest node of another worker
+  for (size_t i = 1; i < queues_.size(); ++i) {
+    auto& queue = *queues_[(worker + i) % queues_.size()];
+    std::lock_guard<OrtMutex> lock(queue.mutex);
+    if (!queue.nodes.empty()) {
+      node_index = queue.nodes.front();
+      queue.nodes.pop_front();
+      --num_queued_nodes_;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void WorkStealingExecutor::WaitForWork() {
+  for (int i = 0; i < kIdleSpinCount; ++i) {
+    if (num_queued_nodes_ > 0 || num_pending_nodes_ == 0 || failed_) {
+      return;
+    }
+
+    std::this_thread::yield();
+  }
+
+  std::unique_lock<OrtMutex> lock(idle_mutex_);
+  // incremented before the predicate is checked, so PushNode either sees an idle worker or the worker sees the node
+  ++num_idle_workers_;
+  idle_cv_.wait(lock, [this]() { return num_queued_nodes_ > 0 || num_pending_nodes_ == 0 || failed_; });
+  --num_idle_workers_;
+}
+
+void WorkStealingExecutor::NotifyAll() {
+  std::lock_guard<OrtMutex> lock(idle_mutex_);
+  idle_cv_.notify_all();
+}
+
+}  // namespace onnxruntime
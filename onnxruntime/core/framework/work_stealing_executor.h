@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/iexecutor.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_termination.h"
+#include "core/framework/session_state.h"
+#include "core/graph/graph_viewer.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class ExecutionFrame;
+
+/**
+ * Executes the graph on the inter op thread pool with one worker per thread.
+ *
+ * Unlike ParallelExecutor, nodes are not scheduled on the thread pool individually. Each worker keeps the nodes it
+ * made ready in its own queue, runs the one with the longest critical path (SessionState::GetNodePriorities) next,
+ * and steals the oldest node from another worker's queue once its own is empty.
+ */
+class WorkStealingExecutor : public IExecutor {
+ public:
+  WorkStealingExecutor(const SessionState& session_state, const RunTermination& termination = {});
+
+  common::Status Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
+                         const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                         std::vector<OrtValue>& fetches,
+                         const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
+                         const logging::Logger& logger) override;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WorkStealingExecutor);
+
+  struct WorkerQueue {
+    OrtMutex mutex;
+    std::deque<NodeIndex> nodes;
+  };
+
+  void RunWorker(size_t worker, const SessionState& session_state, const logging::Logger& logger);
+
+  // Run node_index and then, while possible, the highest priority node it made ready.
+  Status RunNodes(size_t worker, NodeIndex node_index, const SessionState& session_state,
+                  const logging::Logger& logger);
+
+  Status RunNode(NodeIndex node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  void PushNode(size_t worker, NodeIndex node_index);
+  bool TryPopNode(size_t worker, NodeIndex& node_index);
+  void WaitForWork();
+  void NotifyAll();
+
+  std::unique_ptr<ExecutionFrame> root_frame_;
+  std::vector<std::atomic<size_t>> node_refs_;
+  const std::vector<int64_t>& node_priorities_;
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::atomic<size_t> num_queued_nodes_{0};
+  std::atomic<size_t> num_pending_nodes_{0};
+  std::atomic<bool> failed_{false};
+
+  OrtMutex idle_mutex_;
+  OrtCondVar idle_cv_;
+  std::atomic<int> num_idle_workers_{0};
+
+  OrtMutex errors_mutex_;
+  std::vector<Status> errors_;
+
+  const RunTermination termination_;
+  onnxruntime::concurrency::ThreadPool* const executor_pool_{};
+};
+}  // namespace onnxruntime
@@ -58,6 +58,10 @@ where value of each element is the end position, or valid length of actual seque
 left-side padding, mask_index has shape (2 * batch_size), where the values are the exclusive end positions followed by
 the inclusive start positions. When unidirectional is 1, and each token only attend to previous tokens. For GPT-2, both past
 and present state are optional. Present state could appear in output even when past state is not in input.
+When past_present_share_buffer is 1, past and present share a buffer with shape
+(2, batch_size, num_heads, max_sequence_length, head_size). The past_sequence_length input gives the valid length of
+past, and the key and value of the current tokens are written in place after it, so the buffer can be bound once
+(like with IOBinding) and reused across the decoding steps.
 )DOC";
 
 ONNX_MS_OPERATOR_SET_SCHEMA(Attention, 1,
@@ -72,6 +76,10 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Attention, 1,
                                       "Hidden layer sizes of Q, K, V paths in Attention",
                                       AttributeProto::INTS,
                                       OPTIONAL_VALUE)
+                                .Attr("past_present_share_buffer",
+                                      "Whether past and present share the same buffer of max sequence length. Default value is 0.",
+                                      AttributeProto::INT,
+                                      static_cast<int64_t>(0))
                                 .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, input_hidden_size)", "T")
                                 .Input(1, "weight", "2D input tensor with shape (input_hidden_size, 3 * hidden_size), where hidden_size = num_heads * head_size", "T")
                                 .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
@@ -81,8 +89,10 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Attention, 1,
                                        "M", OpSchema::Optional)
                                 .Input(4, "past", "past state for key and value with shape (2, batch_size, num_heads, past_sequence_length, head_size).", "T", OpSchema::Optional)
                                 .Input(5, "extra_add", "additional add to QxK' with shape (batch_size, num_heads, sequence_length, sequence_length).", "T", OpSchema::Optional)
+                                .Input(6, "past_sequence_length", "Scalar with the valid sequence length of past when past_present_share_buffer is 1.", "M", OpSchema::Optional)
                                 .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
-                                .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)", "T", OpSchema::Optional)
+                                .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size), "
+                                        "or the shape of past when past_present_share_buffer is 1", "T", OpSchema::Optional)
                                 .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
                                 .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask index to integer types")
                                 .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
@@ -463,6 +463,41 @@ void BeamSearchShapeInference(ONNX_NAMESPACE::InferenceContext& ctx) {
   }
 }
 
+void GreedySearchShapeInference(ONNX_NAMESPACE::InferenceContext& ctx) {
+  // Type inference
+  ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+  // Shape inference
+  // input 0 (input_ids) shape: (batch_size, sequence_length)
+  // output 0 (sequences) shape: (batch_size, max_length)
+  if (!hasInputShape(ctx, 0)) {
+    return;
+  }
+  auto& input_ids_shape = getInputShape(ctx, 0);
+  auto& input_ids_dims = input_ids_shape.dim();
+  if (input_ids_dims.size() != 2) {
+    fail_shape_inference("Inputs 0 shall be 2 dimensions");
+  }
+  if (!input_ids_dims[0].has_dim_value()) {
+    return;
+  }
+
+  const auto max_length = ctx.getInputData(1);
+  if (max_length == nullptr) {  // not initializer
+    return;
+  }
+
+  int max_length_value = 0;
+  if (!ParseScalar(max_length, max_length_value) || max_length_value <= 0) {
+    fail_shape_inference("Failed to parse max_length or it is not positive integer scalar");
+  }
+
+  ONNX_NAMESPACE::TensorShapeProto sequences_shape;
+  sequences_shape.add_dim()->set_dim_value(input_ids_dims[0].dim_value());
+  sequences_shape.add_dim()->set_dim_value(max_length_value);
+  updateOutputShape(ctx, 0, sequences_shape);
+}
+
 constexpr const char* Gelu_ver1_doc =
     R"DOC(Gaussian Error Linear Unit.
 A high-performing neural network activation function.The GELU nonlinearity is
@@ -652,6 +687,92 @@ ONNX_MS_OPERATOR_SET_SCHEMA(TorchEmbedding, 1,
                                   updateOutputShape(ctx, 0, outputs_shape);
                                 }));
 
+constexpr const char* EmbeddingBag_ver1_doc = R"DOC(
+EmbeddingBag pools the rows of a 2-D embedding table selected by each bag of indices, like the Gather of the rows
+followed by a ReduceSum, ReduceMean or ReduceMax over the bag, without materializing the gathered rows:
+  output[b, j] = pool(weight[indices[i], j] for the indices i of bag b)
+
+The bags are either the rows of a 2-D indices tensor of shape [num_bags, bag_size], or, with a 1-D indices tensor,
+the ranges of indices starting at each element of offsets (the last bag ends with indices), as in torch.nn.EmbeddingBag.
+Negative indices count from the end of the table. The output of an empty bag is 0.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(EmbeddingBag, 1,
+                            OpSchema()
+                                .SetDoc(EmbeddingBag_ver1_doc)
+                                .Attr("mode", "Pooling of the rows of a bag: 'sum' (default), 'mean' or 'max'.",
+                                      AttributeProto::STRING, std::string("sum"))
+                                .Input(0, "weight", "2-D embedding table of shape [num_embeddings, embedding_dim].", "T")
+                                .Input(1, "indices",
+                                       "2-D tensor of shape [num_bags, bag_size], or 1-D tensor of the indices of all "
+                                       "the bags when offsets is given.",
+                                       "Tind")
+                                .Input(2, "offsets",
+                                       "1-D tensor of shape [num_bags] with the position in indices of the start of "
+                                       "each bag. Required if and only if indices is 1-D.",
+                                       "Tind", OpSchema::Optional)
+                                .Output(0, "output", "Pooled rows, of shape [num_bags, embedding_dim].", "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain the table to float tensors.")
+                                .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"},
+                                                "Constrain indices and offsets to integer types.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+                                  if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+                                    return;
+                                  }
+
+                                  const auto& weight_shape = getInputShape(ctx, 0);
+                                  if (weight_shape.dim_size() != 2) {
+                                    fail_shape_inference("weight must be a 2-D tensor");
+                                  }
+
+                                  const bool has_offsets = ctx.getNumInputs() > 2 && ctx.getInputType(2) != nullptr;
+                                  const auto& indices_shape = getInputShape(ctx, 1);
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  if (has_offsets) {
+                                    if (indices_shape.dim_size() != 1) {
+                                      fail_shape_inference("indices must be a 1-D tensor when offsets is given");
+                                    }
+                                    if (!hasInputShape(ctx, 2)) {
+                                      return;
+                                    }
+                                    const auto& offsets_shape = getInputShape(ctx, 2);
+                                    if (offsets_shape.dim_size() != 1) {
+                                      fail_shape_inference("offsets must be a 1-D tensor");
+                                    }
+                                    *output_shape.add_dim() = offsets_shape.dim(0);
+                                  } else {
+                                    if (indices_shape.dim_size() != 2) {
+                                      fail_shape_inference("indices must be a 2-D tensor when offsets is not given");
+                                    }
+                                    *output_shape.add_dim() = indices_shape.dim(0);
+                                  }
+                                  *output_shape.add_dim() = weight_shape.dim(1);
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
+constexpr const char* GroupNorm_ver1_doc = R"DOC(
+Applies Group Normalization over an input of shape (N, C, D1, D2, ...), as in https://arxiv.org/abs/1803.08494:
+the C channels are split into `groups` groups of consecutive channels, each normalized over its channels and
+spatial dimensions, followed by a per-channel affine transform:
+  y = (x - mean) / sqrt(variance + epsilon) * gamma + beta
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(GroupNorm, 1,
+                            OpSchema()
+                                .SetDoc(GroupNorm_ver1_doc)
+                                .Attr("epsilon", "The epsilon value to use to avoid division by zero.",
+                                      AttributeProto::FLOAT, 1e-5f)
+                                .Attr("groups", "The number of groups of channels. It should divide C.",
+                                      AttributeProto::INT)
+                                .Input(0, "X", "Input data tensor of shape (N, C, D1, D2, ...).", "T")
+                                .Input(1, "gamma", "1-D scale tensor of shape (C).", "T")
+                                .Input(2, "beta", "1-D bias tensor of shape (C).", "T")
+                                .Output(0, "Y", "The output tensor of the same shape as X.", "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 constexpr const char* Trilu_ver1_doc = R"DOC(
       Returns the upper or lower triangular part of a 2-D matrix, or batches of 2-D matrices. If the attribute "upper" is set to true,
       the upper triangular matrix is retained. Lower triangular matrix is retained otherwise. Default value for upper is true.
@@ -950,6 +1071,56 @@ ONNX_MS_OPERATOR_SET_SCHEMA(BeamSearch, 1,
                                   BeamSearchShapeInference(ctx);
                                 }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(GreedySearch, 1,
+                            OpSchema()
+                                .SetDoc("Greedy Search for text generation. Supports GPT-2 decoder.")
+                                .Attr("eos_token_id", "The id of the end-of-sequence token", AttributeProto::INT)
+                                .Attr("pad_token_id", "The id of the padding token", AttributeProto::INT)
+                                .Attr("no_repeat_ngram_size", "no repeat ngrams size", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("model_type", "model type: 0 for GPT-2; 1 for encoder decoder like T5", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("decoder", "Decoder subgraph to execute in a loop.", AttributeProto::GRAPH)
+                                .Input(0, "input_ids", "The sequence used as a prompt for the generation. Shape is (batch_size, sequence_length)", "I")
+                                .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
+                                .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
+                                .Input(3, "repetition_penalty", "The parameter for repetition penalty. Default value 1.0 means no penalty. Accepts value > 0.0. Shape is (1)", "T", OpSchema::Optional)
+                                .Input(4, "vocab_mask", "Mask of vocabulary. Words that masked with 0 are not allowed to be generated, and 1 is allowed. Shape is (vacab_size)", "I", OpSchema::Optional)
+                                .Input(5, "prefix_vocab_mask", "Mask of vocabulary for first step. Words that masked with 0 are not allowed to be generated, and 1 is allowed. Shape is (batch_size, vocab_size)", "I", OpSchema::Optional)
+                                .Output(0, "sequences", "Word IDs of generated sequences. Shape is (batch_size, max_sequence_length)", "I")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .TypeConstraint("I", {"tensor(int32)"}, "Constrain to integer types")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  GreedySearchShapeInference(ctx);
+                                }));
+
+ONNX_MS_OPERATOR_SET_SCHEMA(Sampling, 1,
+                            OpSchema()
+                                .SetDoc("Sampling for text generation with temperature, top-k and top-p filtering. Supports GPT-2 decoder.")
+                                .Attr("eos_token_id", "The id of the end-of-sequence token", AttributeProto::INT)
+                                .Attr("pad_token_id", "The id of the padding token", AttributeProto::INT)
+                                .Attr("no_repeat_ngram_size", "no repeat ngrams size", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("model_type", "model type: 0 for GPT-2; 1 for encoder decoder like T5", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("temperature", "The value used to module the next token probabilities. Accepts value > 0.0", AttributeProto::FLOAT, 1.0f)
+                                .Attr("top_k", "The number of highest probability tokens to keep. 0 means no top-k filtering", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("top_p",
+                                      "The smallest set of most probable tokens with probabilities that add up to top_p or higher are kept. "
+                                      "1.0 means no top-p filtering",
+                                      AttributeProto::FLOAT, 1.0f)
+                                .Attr("min_tokens_to_keep", "Minimum number of tokens kept by top-p filtering", AttributeProto::INT, static_cast<int64_t>(1))
+                                .Attr("seed", "Seed of the random number generator. Negative value means a random seed is used", AttributeProto::INT, static_cast<int64_t>(-1))
+                                .Attr("decoder", "Decoder subgraph to execute in a loop.", AttributeProto::GRAPH)
+                                .Input(0, "input_ids", "The sequence used as a prompt for the generation. Shape is (batch_size, sequence_length)", "I")
+                                .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
+                                .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
+                                .Input(3, "repetition_penalty", "The parameter for repetition penalty. Default value 1.0 means no penalty. Accepts value > 0.0. Shape is (1)", "T", OpSchema::Optional)
+                                .Input(4, "vocab_mask", "Mask of vocabulary. Words that masked with 0 are not allowed to be generated, and 1 is allowed. Shape is (vacab_size)", "I", OpSchema::Optional)
+                                .Input(5, "prefix_vocab_mask", "Mask of vocabulary for first step. Words that masked with 0 are not allowed to be generated, and 1 is allowed. Shape is (batch_size, vocab_size)", "I", OpSchema::Optional)
+                                .Output(0, "sequences", "Word IDs of generated sequences. Shape is (batch_size, max_sequence_length)", "I")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .TypeConstraint("I", {"tensor(int32)"}, "Constrain to integer types")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  GreedySearchShapeInference(ctx);
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(SampleOp, 1,
                             OpSchema()
                                 .Input(0, "X", "input", "T")
@@ -1267,6 +1438,44 @@ activation and leaky_relu_alpha.)DOC")
                                   }
                                 }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Evaluates a chain of elementwise operations in a single pass over the output, without materializing the
+intermediate results. The operations are applied in order, the result of the last one being the output Y.
+Each operation has two operands in the operands attribute, the second one being ignored for unary operations.
+An operand i refers to input i if i is less than the number of inputs, otherwise to the result of operation
+(i - number of inputs). The inputs are broadcast to the output shape with multidirectional (Numpy-style) broadcasting.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(FusedElementwise, 1,
+                            OpSchema()
+                                .SetDoc(FusedElementwise_ver1_doc)
+                                .Attr("operations",
+                                      "The op types of the operations: Add, Sub, Mul, Div, Abs, Erf, Exp, Neg, "
+                                      "Reciprocal, Relu, Sigmoid, Sqrt or Tanh.",
+                                      AttributeProto::STRINGS)
+                                .Attr("operands",
+                                      "Two operand indices per operation.",
+                                      AttributeProto::INTS)
+                                .Input(0, "inputs", "The inputs of the operations.", "T",
+                                       OpSchema::Variadic)
+                                .Output(0, "Y", "The result of the last operation.", "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  const size_t num_inputs = ctx.getNumInputs();
+                                  if (!hasNInputShapes(ctx, static_cast<int>(num_inputs))) {
+                                    return;
+                                  }
+
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape = getInputShape(ctx, 0);
+                                  for (size_t i = 1; i < num_inputs; i++) {
+                                    ONNX_NAMESPACE::TensorShapeProto shape;
+                                    bidirectionalBroadcastShapeInference(output_shape, getInputShape(ctx, i), shape);
+                                    output_shape = std::move(shape);
+                                  }
+
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(ExpandDims, 1,
                             OpSchema()
                                 .Input(0, "X", "input", "T")
@@ -1865,11 +2074,18 @@ ONNX_MS_OPERATOR_SET_SCHEMA(CDist, 1,
                                       "\"jensenshannon\", \"kulsinski\", \"mahalanobis\", \"matching\", \"minkowski\", \"rogerstanimoto\", \"russellrao\", "
                                       "\"seuclidean\", \"sokalmichener\", \"sokalsneath\", \"sqeuclidean\", \"wminkowski\", \"yule\".",
                                       AttributeProto::STRING, std::string("sqeuclidean"))
+                                .Attr("top_k",
+                                      "If positive, only the top_k smallest distances of each row of A are returned, in ascending "
+                                      "order, and C has shape (M,min(top_k,K)). The full distance matrix is not materialized.",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
                                 .Input(0, "A", "2D matrix with shape (M,N)", "T")
                                 .Input(1, "B", "2D matrix with shape (K,N)", "T")
                                 .Output(0, "C",
                                         "A 2D Matrix that represents the distance between each pair of the two collections of inputs.",
                                         "T")
+                                .Output(1, "indices",
+                                        "Row indices into B of the distances in C. Only valid when top_k is positive.",
+                                        "tensor(int64)", OpSchema::Optional)
                                 .TypeConstraint("T", {"tensor(float)", "tensor(double)"}, "Constrains input to only numeric types."));
 
 ONNX_MS_OPERATOR_SET_SCHEMA(CropAndResize, 1,
@@ -112,7 +112,7 @@ ONNX_MS_OPERATOR_SET_SCHEMA(NhwcMaxPool, 1,
                             OpSchema()
                                 .Input(0, "x", "", "T")
                                 .Output(0, "y", "", "T")
-                                .TypeConstraint("T", {"tensor(int8)", "tensor(uint8)"}, "")
+                                .TypeConstraint("T", {"tensor(int8)", "tensor(uint8)", "tensor(float)"}, "")
                                 .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
                                 .Attr("kernel_shape", "", AttributeProto::INTS)
                                 .Attr("dilations", "", AttributeProto::INTS, OPTIONAL_VALUE)
@@ -313,6 +313,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(QLinearConv, 1,
                                 .Input(6, "y_scale", "", "tensor(float)")
                                 .Input(7, "y_zero_point", "", "T3")
                                 .Input(8, "B", "", "T4", OpSchema::Optional)
+                                .Input(9, "sum", "Optional quantized tensor with the shape of y, added to the "
+                                       "convolution result before it is requantized to y.",
+                                       "T3", OpSchema::Optional)
+                                .Input(10, "sum_scale", "Scale of sum, required if sum is present.",
+                                       "tensor(float)", OpSchema::Optional)
+                                .Input(11, "sum_zero_point", "Zero point of sum. Default value is 0.", "T3",
+                                       OpSchema::Optional)
                                 .Output(0, "y", "", "T3")
                                 .TypeConstraint("T1", {"tensor(int8)", "tensor(uint8)"}, "")
                                 .TypeConstraint("T2", {"tensor(int8)", "tensor(uint8)"}, "")
@@ -449,6 +456,16 @@ std::function<void(OpSchema&)> ConvOpSchemaGenerator() {
         "number of groups input channels and output channels are divided into.",
         AttributeProto::INT,
         static_cast<int64_t>(1));
+    schema.Attr(
+        "activation",
+        "Optional activation fused into the output, as for FusedConv.",
+        AttributeProto::STRING,
+        OPTIONAL_VALUE);
+    schema.Attr(
+        "activation_params",
+        "Parameters of the fused activation.",
+        AttributeProto::FLOATS,
+        OPTIONAL_VALUE);
     schema.TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
       propagateElemTypeFromInputToOutput(ctx, 0, 0);
       NhwcInferenceContext nhwc_ctx(ctx);
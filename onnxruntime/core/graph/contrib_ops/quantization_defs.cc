@@ -141,7 +141,7 @@ Performs element-wise binary {name} on 8 bit data types (with Numpy-style broadc
 
   static const char* QuantizeLinear_ver1_doc = R"DOC(
 The linear quantization operator. It consumes a full precision data, a scale, a zero point to compute the low precision / quantized tensor.
-The quantization formula is y = saturate ((x / y_scale) + y_zero_point).For saturation, it saturates to [0, 255] if it's uint8, or [-128, 127] if it's int8.
+The quantization formula is y = saturate ((x / y_scale) + y_zero_point).For saturation, it saturates to [0, 255] if it's uint8, [-128, 127] if it's int8, or [-32768, 32767] if it's int16.
 For (x / y_scale), it's rounding to nearest ties to even. Refer to https://en.wikipedia.org/wiki/Rounding for details.
 Scale and zero point must have same shape. They must be either scalar (per tensor) or 1-D tensor (per 'axis').)DOC";
 
@@ -182,8 +182,8 @@ Scale and zero point must have same shape. They must be either scalar (per tenso
           "Constrain 'x', 'y_scale' to float tensors.")
       .TypeConstraint(
           "T2",
-          {"tensor(int8)", "tensor(uint8)"},
-          "Constrain 'y_zero_point' and 'y' to 8-bit integer tensors.")
+          {"tensor(int8)", "tensor(uint8)", "tensor(int16)"},
+          "Constrain 'y_zero_point' and 'y' to 8-bit or 16-bit integer tensors.")
       .SetDoc(QuantizeLinear_ver1_doc)
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
         propagateElemTypeFromInputToOutput(ctx, 2, 0);
@@ -231,8 +231,8 @@ Scale and zero point must have same shape. They must be either scalar (per tenso
           "T2")
       .TypeConstraint(
           "T1",
-          {"tensor(int8)", "tensor(uint8)"},
-          "Constrain 'x' and 'x_zero_point' to 8-bit integer tensors.")
+          {"tensor(int8)", "tensor(uint8)", "tensor(int16)"},
+          "Constrain 'x' and 'x_zero_point' to 8-bit or 16-bit integer tensors.")
       .TypeConstraint(
           "T2",
           {"tensor(float16)", "tensor(float)"},
@@ -402,8 +402,8 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
       .Output(0, "Y", "Matrix multiply results from A * B", "T3")
       .TypeConstraint(
           "T1",
-          {"tensor(int8)", "tensor(uint8)"},
-          "Constrain input A data type to 8-bit integer tensor.")
+          {"tensor(int8)", "tensor(uint8)", "tensor(int16)"},
+          "Constrain input A data type to 8-bit or 16-bit integer tensor.")
       .TypeConstraint(
           "T2",
           {"tensor(int8)", "tensor(uint8)"},
@@ -585,6 +585,135 @@ Wwhere the function `Sigmoid(x) = 1 / (1 + exp(-x))` )DOC";
           "Constrain input and output types to 8 bit tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+  const char* QLinearGeluDoc_ver1 = R"DOC(
+QLinearGelu takes quantized input data (Tensor), and quantize parameter for output, and produces one output data
+(Tensor<T>) where the function `f(x) = quantize(Gelu(dequantize(x)))`, is applied to the data tensor elementwise.
+Where the function `Gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))` )DOC";
+
+  ONNX_MS_OPERATOR_SET_SCHEMA(QLinearGelu, 1, OpSchema()
+      .SetDoc(QLinearGeluDoc_ver1)
+      .Input(0, "X", "Input tensor", "T")
+      .Input(1, "X_scale",
+             "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(2, "X_zero_point",
+             "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Input(3, "Y_scale",
+             "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(4, "Y_zero_point",
+             "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Output(0, "Y", "Output tensor", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(uint8)", "tensor(int8)"},
+          "Constrain input and output types to 8 bit tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+  const char* QLinearUnaryDoc_ver1 = R"DOC(
+QLinearUnary takes quantized input data (Tensor), and quantize parameter for output, and produces one output data
+(Tensor<T>) where the function `f(x) = quantize(op_type(dequantize(x)))`, is applied to the data tensor elementwise.
+The function is looked up from a table of its values for the 256 input values.
+The supported op types are Elu, Erf, Exp, HardSigmoid, HardSwish, Selu, Softplus, Softsign and Tanh, with the
+semantics and attribute defaults of the ONNX operators.)DOC";
+
+  ONNX_MS_OPERATOR_SET_SCHEMA(QLinearUnary, 1, OpSchema()
+      .SetDoc(QLinearUnaryDoc_ver1)
+      .Attr("op_type", "The ONNX operator applied to the dequantized values.", AttributeProto::STRING)
+      .Attr("alpha", "The alpha attribute of Elu, HardSigmoid or Selu.", AttributeProto::FLOAT, OPTIONAL_VALUE)
+      .Attr("beta", "The beta attribute of HardSigmoid.", AttributeProto::FLOAT, OPTIONAL_VALUE)
+      .Attr("gamma", "The gamma attribute of Selu.", AttributeProto::FLOAT, OPTIONAL_VALUE)
+      .Input(0, "X", "Input tensor", "T")
+      .Input(1, "X_scale",
+             "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(2, "X_zero_point",
+             "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Input(3, "Y_scale",
+             "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(4, "Y_zero_point",
+             "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Output(0, "Y", "Output tensor", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(uint8)", "tensor(int8)"},
+          "Constrain input and output types to 8 bit tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+  const char* QLinearSoftmaxDoc_ver1 = R"DOC(
+QLinearSoftmax computes the normalized exponential values of the quantized input data (Tensor) along the given axis,
+`f(x) = quantize(Softmax(dequantize(x)))`, with the semantics of the axis of the given opset of Softmax.
+The exponentials are looked up from a table of the 256 differences between an input value and the maximum value.
+)DOC";
+
+  ONNX_MS_OPERATOR_SET_SCHEMA(QLinearSoftmax, 1, OpSchema()
+      .SetDoc(QLinearSoftmaxDoc_ver1)
+      .Attr("axis",
+            "The axis of Softmax. For opset < 13, the axis from which the input is coerced into 2D, "
+            "otherwise the single axis the values are normalized along.",
+            AttributeProto::INT, static_cast<int64_t>(-1))
+      .Attr("opset", "The opset of the Softmax the node replaces, which sets the semantics of axis.",
+            AttributeProto::INT)
+      .Input(0, "X", "Input tensor", "T")
+      .Input(1, "X_scale",
+             "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(2, "X_zero_point",
+             "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Input(3, "Y_scale",
+             "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(4, "Y_zero_point",
+             "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Output(0, "Y", "Output tensor", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(uint8)", "tensor(int8)"},
+          "Constrain input and output types to 8 bit tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+  const char* QLinearLayerNormalizationDoc_ver1 = R"DOC(
+QLinearLayerNormalization normalizes the quantized input data (Tensor) over the dimensions from the given axis,
+`f(x) = quantize(LayerNormalization(dequantize(x), Scale, B))`. Each row of the input is dequantized, normalized
+and quantized in turn, so the float values of the whole tensor are never materialized.
+)DOC";
+
+  ONNX_MS_OPERATOR_SET_SCHEMA(QLinearLayerNormalization, 1, OpSchema()
+      .SetDoc(QLinearLayerNormalizationDoc_ver1)
+      .Attr("axis", "The first normalization dimension.", AttributeProto::INT, static_cast<int64_t>(-1))
+      .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, 1e-5f)
+      .Attr("stash_type", "Type of the computation. Only float (1) is supported.", AttributeProto::INT,
+            static_cast<int64_t>(1))
+      .Input(0, "X", "Input tensor", "T")
+      .Input(1, "X_scale",
+             "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(2, "X_zero_point",
+             "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Input(3, "Scale", "Scale tensor, with the shape of the normalized dimensions.", "tensor(float)")
+      .Input(4, "Y_scale",
+             "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(5, "Y_zero_point",
+             "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Input(6, "B", "Bias tensor, with the shape of the normalized dimensions.", "tensor(float)",
+             OpSchema::Optional)
+      .Output(0, "Y", "Output tensor", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(uint8)", "tensor(int8)"},
+          "Constrain input and output types to 8 bit tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
   ONNX_MS_OPERATOR_SET_SCHEMA(DynamicQuantizeLSTM, 1, OpSchema()
       .Attr(
           "direction",
@@ -959,6 +1088,130 @@ Wwhere the function `Sigmoid(x) = 1 / (1 + exp(-x))` )DOC";
                second_input_shape.dim(transB ? 0 : 1)});
         }
       }));
+  constexpr const char* MatMulNBits_ver1_doc = R"DOC(
+MatMulNBits performs a matrix multiplication where the right-hand-side matrix (weights) is quantized to N bits.
+
+It is a fusion of two operations:
+1. Linear dequantization of the quantized weights using scale and (optionally) zero-point with formula:
+  dequantized_weight = (quantized_weight - zero_point) * scale
+2. Matrix multiplication between the input matrix A and the dequantized weight matrix.
+
+The weight matrix is a 2D constant matrix with the input feature count and output feature count specified by attributes 'K' and 'N'.
+It is quantized block-wise along the K dimension with a block size specified by the 'block_size' attribute.
+The block size must be 32, 64, 128 or 256.
+Each block has its own scale and zero-point. The quantization is performed using a bit-width specified by the 'bits' attribute.
+Only 4 bits are supported.
+
+Input B is stored as uint8_t with shape: [N][n_blocks_per_col][blob_size] where
+  n_blocks_per_col = (K + block_size - 1) / block_size
+  blob_size = block_size / 8 * bits
+Element 2 * i of a block is stored in the low 4 bits of byte i of the blob and element 2 * i + 1 in the high 4 bits.
+The last block of a column is padded.
+
+Input scales is stored in the same type as A with shape [N * n_blocks_per_col].
+
+Input zero_points is stored as uint8_t with shape [N * ((n_blocks_per_col + 1) / 2)]. The zero point of block 2 * i of
+a column is stored in the low 4 bits of byte i and the zero point of block 2 * i + 1 in the high 4 bits. If zero_points
+is not provided, the zero point of every block is 8.
+)DOC";
+
+  ONNX_MS_OPERATOR_SET_SCHEMA(MatMulNBits, 1, OpSchema()
+      .SetDoc(MatMulNBits_ver1_doc)
+      .Attr("K", "size of each input feature", AttributeProto::INT)
+      .Attr("N", "size of each output feature", AttributeProto::INT)
+      .Attr("bits", "number of bits used for weight quantization (default 4)", AttributeProto::INT, static_cast<int64_t>(4))
+      .Attr("block_size", "number of rows of B sharing a scale and a zero point (default 128). It must be 32, 64, 128 or 256.",
+            AttributeProto::INT, static_cast<int64_t>(128))
+      .Input(0, "A", "The input tensor, not quantized", "T1")
+      .Input(1, "B", "1-dimensional data blob", "T2")
+      .Input(2, "scales", "quantization scale", "T1")
+      .Input(3, "zero_points", "quantization zero points", "T2", OpSchema::Optional)
+      .Output(0, "Y", "tensor. The output tensor has the same rank as the input. ", "T1")
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized weight types to uint8.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        // Type inference
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+        // Shape inference
+        const int64_t in_features = getAttribute(ctx, "K", int64_t(-1));
+        const int64_t out_features = getAttribute(ctx, "N", int64_t(-1));
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+
+        const auto& a_shape = getInputShape(ctx, 0);
+        if (a_shape.dim_size() == 0) {
+          fail_shape_inference("Input tensor A must have at least 1 dimension");
+        }
+
+        const auto& a_last_dim = a_shape.dim(a_shape.dim_size() - 1);
+        if (a_last_dim.has_dim_value() && in_features >= 0 && a_last_dim.dim_value() != in_features) {
+          fail_shape_inference("Last dimension of input A must match attribute K");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto resultShape;
+        for (int i = 0; i < a_shape.dim_size() - 1; ++i) {
+          *resultShape.add_dim() = a_shape.dim(i);
+        }
+        resultShape.add_dim()->set_dim_value(out_features);
+        updateOutputShape(ctx, 0, resultShape);
+      }));
+
+  constexpr const char* DequantizeGather_ver1_doc = R"DOC(
+DequantizeGather gathers rows of a quantized 2-D table, e.g. an embedding table, and dequantizes only the gathered rows.
+It is the fusion of a row-wise DequantizeLinear of the table followed by Gather on axis 0:
+  output[i, j] = (data[indices[i], j] - zero_points[indices[i]]) * scales[indices[i]]
+
+Input scales holds either one value for the whole table or one value per row, and zero_points holds as many values.
+
+With bits=8, data is int8 or uint8 with shape [rows, cols], and zero_points is of the same type. The default zero point is 0.
+
+With bits=4, data is uint8 with shape [rows, cols / 2]. Element 2 * j of a row is stored in the low 4 bits of byte j and
+element 2 * j + 1 in the high 4 bits, so a table with an odd number of columns must be padded by one column.
+zero_points is uint8 with one value in [0, 15] per entry of scales. The default zero point is 8.
+)DOC";
+
+  ONNX_MS_OPERATOR_SET_SCHEMA(DequantizeGather, 1, OpSchema()
+      .SetDoc(DequantizeGather_ver1_doc)
+      .Attr("axis", "Which axis to gather on. Only 0 is supported.", AttributeProto::INT, static_cast<int64_t>(0))
+      .Attr("bits", "number of bits of the elements of the table, 8 or 4 (default 8)", AttributeProto::INT,
+            static_cast<int64_t>(8))
+      .Input(0, "data", "2-D quantized table", "T1")
+      .Input(1, "indices", "Tensor of row indices of any rank q. Negative values count from the end of the table.",
+             "Tind")
+      .Input(2, "scales", "Scale of the table, a scalar or a 1-D tensor with one value per row.", "tensor(float)")
+      .Input(3, "zero_points", "Zero point of the table, with the same number of values as scales.", "T1",
+             OpSchema::Optional)
+      .Output(0, "output", "Dequantized rows, a tensor of rank q + 1.", "tensor(float)")
+      .TypeConstraint("T1", {"tensor(int8)", "tensor(uint8)"}, "Constrain the table to 8-bit integer tensors.")
+      .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::FLOAT);
+
+        if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+          return;
+        }
+
+        const auto& data_shape = getInputShape(ctx, 0);
+        if (data_shape.dim_size() != 2) {
+          fail_shape_inference("data must be a 2-D tensor");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        const auto& indices_shape = getInputShape(ctx, 1);
+        for (int i = 0; i < indices_shape.dim_size(); ++i) {
+          *output_shape.add_dim() = indices_shape.dim(i);
+        }
+
+        const int64_t bits = getAttribute(ctx, "bits", int64_t(8));
+        auto* cols = output_shape.add_dim();
+        if (data_shape.dim(1).has_dim_value()) {
+          cols->set_dim_value(data_shape.dim(1).dim_value() * (bits == 4 ? 2 : 1));
+        }
+        updateOutputShape(ctx, 0, output_shape);
+      }));
+
   ONNX_MS_OPERATOR_SET_SCHEMA(QAttention, 1,
                               OpSchema()
                                   .SetDoc("Quantization of Multi-Head Self Attention.")
@@ -158,7 +158,10 @@ void AttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int p
           fail_shape_inference("Inputs 4 shall be 5 dimensions");
         }
 
-        if (past_dims[3].has_dim_value() && input_dims[1].has_dim_value()) {
+        if (getAttribute(ctx, "past_present_share_buffer", int64_t(0)) == 1) {
+          // present is appended in place to the buffer of past, so it has the same shape.
+          updateOutputShape(ctx, 1, past_shape);
+        } else if (past_dims[3].has_dim_value() && input_dims[1].has_dim_value()) {
           auto all_sequence_length = past_shape.dim(3).dim_value() + input_shape.dim(1).dim_value();
 
           ONNX_NAMESPACE::TensorShapeProto present_shape;
@@ -646,7 +646,8 @@ void Node::ToProto(NodeProto& proto, bool update_subgraphs) const {
 }
 
 Status Node::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                             flatbuffers::Offset<fbs::Node>& fbs_node) const {
+                             flatbuffers::Offset<fbs::Node>& fbs_node,
+                             TensorCompression initializer_compression) const {
   // if type is Primitive it's an ONNX function and currently we have kernel implementations for all those
   if (func_body_ != nullptr && node_type_ != Type::Primitive) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Serialization of fused function body is not currently supported, ",
@@ -688,7 +689,8 @@ Status Node::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       subgraph = it->second;
     }
     ORT_RETURN_IF_ERROR(
-        fbs::utils::SaveAttributeOrtFormat(builder, attr_proto, fbs_attr, ModelPath(), subgraph));
+        fbs::utils::SaveAttributeOrtFormat(builder, attr_proto, fbs_attr, ModelPath(), subgraph,
+                                           initializer_compression));
     attributes_vec.push_back(fbs_attr);
   }
   auto attributes = builder.CreateVector(attributes_vec);
@@ -1836,9 +1838,13 @@ void Graph::KahnsTopologicalSort(const std::function<void(const Node*)>& enter,
 GSL_SUPPRESS(es .84)  // noisy warning about ignoring return value from insert(...)
 Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
   nodes_in_topological_order_.clear();
-  std::unordered_set<NodeIndex> downstream_nodes;  // nodes downstream of the node we're currently checking
-  std::unordered_set<NodeIndex> nodes_seen;        // nodes we have seen but may not have been added to nodes_added yet
-  std::unordered_set<NodeIndex> nodes_added;       // nodes added to topo order
+  nodes_in_topological_order_.reserve(static_cast<size_t>(NumberOfNodes()));
+
+  // the node states are indexed by NodeIndex, which is cheaper than hashing with graphs of many nodes
+  const auto max_node_index = static_cast<size_t>(MaxNodeIndex());
+  std::vector<bool> downstream_nodes(max_node_index);  // nodes downstream of the node we're currently checking
+  std::vector<bool> nodes_seen(max_node_index);        // nodes we have seen but may not have been added to topo order yet
+  std::vector<bool> nodes_added(max_node_index);       // nodes added to topo order
   std::stack<NodeIndex> stack;
 
   // push the root nodes into nodes_in_topological_order in the order they were defined in the model
@@ -1860,8 +1866,8 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
                   if (!has_inputs) {
                     // add to the topological list, and ensure we skip these nodes when walking the graph
                     nodes_in_topological_order_.push_back(index);
-                    nodes_added.insert(index);
-                    nodes_seen.insert(index);
+                    nodes_added[index] = true;
+                    nodes_seen[index] = true;
                   }
                 });
 
@@ -1877,16 +1883,16 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
     const NodeIndex current = stack.top();
     stack.pop();
 
-    if (nodes_added.find(current) != nodes_added.end()) {
+    if (nodes_added[current]) {
       continue;
     }
 
-    if (nodes_seen.find(current) != nodes_seen.end()) {
+    if (nodes_seen[current]) {
       // we popped the stack and are back to a node that was seen previously,
       // so we know all the upstream nodes from it have been added.
       nodes_in_topological_order_.push_back(current);
-      nodes_added.insert(current);
-      downstream_nodes.erase(current);
+      nodes_added[current] = true;
+      downstream_nodes[current] = false;
       continue;
     }
 
@@ -1897,21 +1903,21 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
 
     // node hasn't been seen before, so mark it as seen and re-add it along with its inputs
     // also mark it as downstream of anything new that is added to the stack to detect acyclic graphs
-    nodes_seen.insert(current);
-    downstream_nodes.insert(current);
+    nodes_seen[current] = true;
+    downstream_nodes[current] = true;
 
     stack.push(current);
 
     for (auto iter = node->InputNodesBegin(), end = node->InputNodesEnd(); iter != end; ++iter) {
       const NodeIndex idx = iter->Index();
       // the input to this node is also downstream of this node
-      if (downstream_nodes.find(idx) != downstream_nodes.end()) {
+      if (downstream_nodes[idx]) {
         Status status(ONNXRUNTIME, onnxruntime::common::StatusCode::FAIL, "This is an invalid model. Error: the graph is not acyclic.");
         return status;
       }
 
       // avoid re-processing nodes
-      if (nodes_seen.find(idx) == nodes_seen.end()) {
+      if (!nodes_seen[idx]) {
         stack.push(idx);
       }
     }
@@ -2511,13 +2517,15 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
-
-    NodeProto node_proto;
-    node.ToProto(node_proto);
     const auto& node_name = node.Name();
 
     if (!node.Op()) {
       {
+        // the NodeProto is only needed by the checker. serializing it for every node on every Resolve is costly
+        // with large graphs as it copies the attributes, including the tensors of the Constant nodes.
+        NodeProto node_proto;
+        node.ToProto(node_proto);
+
         auto status = Status::OK();
         ORT_TRY {
           checker::check_node(node_proto, ctx, lsc);
@@ -2590,8 +2598,8 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
 
     // Accumulate output names of the iterated Node
-    for (auto& output_name : node_proto.output()) {
-      lsc.output_names.insert(output_name);
+    for (const auto* output_def : node.OutputDefs()) {
+      lsc.output_names.insert(output_def->Name());
     }
   }
 
@@ -2791,6 +2799,21 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
     ORT_IGNORE_RETURN_VALUE(GetOrCreateNodeArg(tensor.name(), &t));
   }
 }
+
+void Graph::AddInitializedTensor(TensorProto&& tensor) {
+  if (!tensor.has_raw_data()) {
+    AddInitializedTensor(static_cast<const TensorProto&>(tensor));
+    return;
+  }
+
+  std::string raw_data;
+  raw_data.swap(*tensor.mutable_raw_data());
+  const int index = graph_proto_->initializer_size();
+  AddInitializedTensor(static_cast<const TensorProto&>(tensor));
+  ORT_ENFORCE(graph_proto_->initializer_size() == index + 1,
+              "AddInitializedTensor already has tensor with name ", tensor.name(), " but different TensorProto.");
+  graph_proto_->mutable_initializer(index)->mutable_raw_data()->swap(raw_data);
+}
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
 const std::string& Graph::Name() const noexcept {
@@ -2943,6 +2966,27 @@ void Graph::CleanAllInitializedTensors() noexcept {
   }
 }
 
+void Graph::ReleaseInitializedTensorData(const std::string& tensor_name) noexcept {
+  auto iter = name_to_initial_tensor_.find(tensor_name);
+  if (iter == name_to_initial_tensor_.end()) {
+    return;
+  }
+
+  // the TensorProto is owned by graph_proto_ or deserialized_proto_data_, which are mutable.
+  // clearing a field of a protobuf message keeps its memory, so the data is swapped into a temporary message which
+  // frees it when it goes out of scope.
+  auto& tensor_proto = *const_cast<TensorProto*>(iter->second);
+  TensorProto data;
+  data.mutable_raw_data()->swap(*tensor_proto.mutable_raw_data());
+  data.mutable_float_data()->Swap(tensor_proto.mutable_float_data());
+  data.mutable_int32_data()->Swap(tensor_proto.mutable_int32_data());
+  data.mutable_string_data()->Swap(tensor_proto.mutable_string_data());
+  data.mutable_int64_data()->Swap(tensor_proto.mutable_int64_data());
+  data.mutable_double_data()->Swap(tensor_proto.mutable_double_data());
+  data.mutable_uint64_data()->Swap(tensor_proto.mutable_uint64_data());
+  tensor_proto.clear_raw_data();
+}
+
 const ONNX_NAMESPACE::TensorProto* Graph::GetConstantInitializer(const std::string& initializer_name,
                                                                  bool check_outer_scope) const {
   const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
@@ -3059,7 +3103,8 @@ SaveInputsOutputsToOrtFormat(flatbuffers::FlatBufferBuilder& builder, const std:
 }
 
 common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                      flatbuffers::Offset<fbs::Graph>& fbs_graph) const {
+                                      flatbuffers::Offset<fbs::Graph>& fbs_graph,
+                                      TensorCompression initializer_compression) const {
   auto inputs = SaveInputsOutputsToOrtFormat(builder, graph_inputs_including_initializers_);
   auto outputs = SaveInputsOutputsToOrtFormat(builder, graph_outputs_);
 
@@ -3082,7 +3127,8 @@ common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     if (sparse_tensor_names_.find(pair.first) == sparse_end) {
       flatbuffers::Offset<fbs::Tensor> fbs_tensor;
       ORT_RETURN_IF_ERROR(
-          fbs::utils::SaveInitializerOrtFormat(builder, *pair.second, model_path, fbs_tensor));
+          fbs::utils::SaveInitializerOrtFormat(builder, *pair.second, model_path, fbs_tensor,
+                                               initializer_compression));
       initializers_data.push_back(fbs_tensor);
     }
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -3117,7 +3163,7 @@ common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   for (const auto& node : nodes_) {
     if (node != nullptr) {
       flatbuffers::Offset<fbs::Node> fbs_node;
-      ORT_RETURN_IF_ERROR(node->SaveToOrtFormat(builder, fbs_node));
+      ORT_RETURN_IF_ERROR(node->SaveToOrtFormat(builder, fbs_node, initializer_compression));
       nodes_vec.push_back(fbs_node);
       node_edges_vec.push_back(node->SaveEdgesToOrtFormat(builder));
     }
@@ -4211,7 +4257,8 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::fbs::Graph& fbs_graph,
 #if !defined(ORT_MINIMAL_BUILD)
                                 IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
-                                const logging::Logger& logger, std::unique_ptr<Graph>& graph) {
+                                const logging::Logger& logger, std::unique_ptr<Graph>& graph,
+                                bool can_use_flatbuffer_for_initializers) {
   graph = std::make_unique<Graph>(owning_model, domain_to_version,
 #if !defined(ORT_MINIMAL_BUILD)
                                   schema_registry,
@@ -4220,6 +4267,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::fbs::Graph& fbs_graph,
                                   // Assume anything in ORT format has already been validated.
                                   false);
 
+  graph->can_use_flatbuffer_for_initializers_ = can_use_flatbuffer_for_initializers;
   ORT_RETURN_IF_ERROR(graph->LoadFromOrtFormat(fbs_graph));
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -4247,6 +4295,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::fbs::Graph& fbs_graph,
                                   // Assume anything in ORT format has already been validated.
                                   false);
 
+  graph->can_use_flatbuffer_for_initializers_ = parent_graph.can_use_flatbuffer_for_initializers_;
   return graph->LoadFromOrtFormat(fbs_graph);
 }
 
@@ -4306,7 +4355,8 @@ common::Status Graph::LoadFromOrtFormat(const onnxruntime::fbs::Graph& fbs_graph
     for (const auto* fbs_tensor : *fbs_initializers) {
       ORT_RETURN_IF(nullptr == fbs_tensor, "Initializer tensor is missing. Invalid ORT format model.");
       TensorProto* initializer = deserialized_proto_data_.add_initializer();
-      ORT_RETURN_IF_ERROR(fbs::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer));
+      ORT_RETURN_IF_ERROR(fbs::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer,
+                                                               can_use_flatbuffer_for_initializers_));
       auto p = name_to_initial_tensor_.emplace(initializer->name(), initializer);
       if (!p.second) {
         LOGS(logger_, WARNING) << "Duplicate initializer (dense or ConstantNode): '" << initializer->name()
@@ -13,6 +13,16 @@ using namespace ::onnxruntime::common;
 
 namespace onnxruntime::fbs::utils {
 
+// Gets the size of the elements of a tensor with non-string data of raw_data_size bytes.
+static size_t GetElementSize(const TensorProto& initializer, size_t raw_data_size) {
+  size_t num_elements = 1;
+  for (auto dim : initializer.dims()) {
+    num_elements *= static_cast<size_t>(dim);
+  }
+
+  return num_elements == 0 ? 0 : raw_data_size / num_elements;
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 
 template <typename DimsFieldType>
@@ -26,13 +36,15 @@ SaveDims(flatbuffers::FlatBufferBuilder& builder, const DimsFieldType& dims) {
 Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                 const TensorProto& initializer,
                                 const Path& model_path,
-                                flatbuffers::Offset<fbs::Tensor>& fbs_tensor) {
+                                flatbuffers::Offset<fbs::Tensor>& fbs_tensor,
+                                TensorCompression compression) {
   auto name = SaveStringToOrtFormat(builder, initializer.has_name(), initializer.name());
   auto doc_string = SaveStringToOrtFormat(builder, initializer.has_doc_string(), initializer.doc_string());
   auto dims = SaveDims(builder, initializer.dims());
 
   flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data;
   flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data;
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> compressed_raw_data;
 
   auto src_type = initializer.data_type();
   const bool has_string_data = src_type == ONNX_NAMESPACE::TensorProto_DataType_STRING;
@@ -44,7 +56,26 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     std::vector<uint8_t> unpacked_tensor;
     ORT_RETURN_IF_ERROR(
         onnxruntime::utils::UnpackInitializerData(initializer, model_path, unpacked_tensor));
-    raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
+
+    if (compression != TensorCompression::kNone && unpacked_tensor.size() >= kMinCompressedInitializerSize) {
+      std::vector<uint8_t> compressed_tensor;
+      ORT_RETURN_IF_ERROR(onnxruntime::utils::CompressTensorData(
+          compression, GetElementSize(initializer, unpacked_tensor.size()), unpacked_tensor, compressed_tensor));
+      if (compressed_tensor.size() < unpacked_tensor.size()) {
+        compressed_raw_data = builder.CreateVector(compressed_tensor.data(), compressed_tensor.size());
+      } else {
+        // incompressible, e.g. random weights
+        compression = TensorCompression::kNone;
+      }
+    } else {
+      compression = TensorCompression::kNone;
+    }
+
+    if (compression == TensorCompression::kNone) {
+      // align the raw data so it can be used in place when loading the model
+      builder.ForceVectorAlignment(unpacked_tensor.size(), sizeof(uint8_t), kInitializerRawDataAlignment);
+      raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
+    }
   }
 
   fbs::TensorBuilder tb(builder);
@@ -52,10 +83,14 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   tb.add_doc_string(doc_string);
   tb.add_dims(dims);
   tb.add_data_type(static_cast<fbs::TensorDataType>(src_type));
-  if (has_string_data)
+  if (has_string_data) {
     tb.add_string_data(string_data);
-  else
+  } else if (compression != TensorCompression::kNone) {
+    tb.add_compression(static_cast<fbs::TensorCompression>(compression));
+    tb.add_compressed_raw_data(compressed_raw_data);
+  } else {
     tb.add_raw_data(raw_data);
+  }
   fbs_tensor = tb.Finish();
   return Status::OK();
 }
@@ -103,7 +138,8 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                               const AttributeProto& attr_proto,
                               flatbuffers::Offset<fbs::Attribute>& fbs_attr,
                               const Path& model_path,
-                              const onnxruntime::Graph* subgraph) {
+                              const onnxruntime::Graph* subgraph,
+                              TensorCompression initializer_compression) {
   auto name = SaveStringToOrtFormat(builder, attr_proto.has_name(), attr_proto.name());
   auto doc_string = SaveStringToOrtFormat(builder, attr_proto.has_doc_string(), attr_proto.doc_string());
   auto type = static_cast<fbs::AttributeType>(attr_proto.type());
@@ -127,7 +163,7 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     case fbs::AttributeType::GRAPH: {
       ORT_RETURN_IF(nullptr == subgraph, "Graph attribute value was null. Invalid ORT format model.");
       flatbuffers::Offset<fbs::Graph> fbs_graph;
-      ORT_RETURN_IF_ERROR(subgraph->SaveToOrtFormat(builder, fbs_graph));
+      ORT_RETURN_IF_ERROR(subgraph->SaveToOrtFormat(builder, fbs_graph, initializer_compression));
       GET_FBS_ATTR(builder, type, g, fbs_graph);
     } break;
     case fbs::AttributeType::FLOATS: {
@@ -172,7 +208,8 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
 #endif
 
 Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor,
-                                TensorProto& initializer) {
+                                TensorProto& initializer,
+                                bool can_use_flatbuffer_for_initializers) {
   initializer.Clear();
 
   LOAD_STR_FROM_ORT_FORMAT(initializer, name, fbs_tensor.name());
@@ -192,12 +229,66 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor,
     for (const auto* fbs_str : *fbs_str_data) {
       mutable_str_data->Add(fbs_str->str());
     }
+  } else if (fbs_tensor.compression() != fbs::TensorCompression::NONE) {
+    const auto compression = static_cast<TensorCompression>(fbs_tensor.compression());
+    ORT_RETURN_IF(compression != TensorCompression::kLz4 && compression != TensorCompression::kByteShuffleLz4,
+                  "Unsupported compression of initializer: ", static_cast<int>(compression),
+                  ". Invalid ORT format model.");
+    const auto* fbs_compressed_raw_data = fbs_tensor.compressed_raw_data();
+    ORT_RETURN_IF(nullptr == fbs_compressed_raw_data,
+                  "Missing compressed raw data for initializer. Invalid ORT format model.");
+
+    if (can_use_flatbuffer_for_initializers) {
+      // refer to the compressed data in place, it is decompressed when the tensor is created
+      initializer.set_data_location(TensorProto_DataLocation_EXTERNAL);
+
+      auto* location = initializer.add_external_data();
+      location->set_key("location");
+      location->set_value(ToUTF8String(onnxruntime::utils::kTensorProtoMemoryAddressTag));
+      auto* offset = initializer.add_external_data();
+      offset->set_key("offset");
+      offset->set_value(std::to_string(static_cast<ptrdiff_t>(
+          reinterpret_cast<uintptr_t>(fbs_compressed_raw_data->Data()))));
+      auto* compression_entry = initializer.add_external_data();
+      compression_entry->set_key("compression");
+      compression_entry->set_value(onnxruntime::utils::TensorCompressionName(compression));
+      auto* compressed_length = initializer.add_external_data();
+      compressed_length->set_key("compressed_length");
+      compressed_length->set_value(std::to_string(fbs_compressed_raw_data->size()));
+    } else {
+      size_t raw_data_size = 0;
+      ORT_RETURN_IF_ERROR(onnxruntime::utils::GetSizeInBytesFromTensorProto<0>(initializer, &raw_data_size));
+      std::string* raw_data = initializer.mutable_raw_data();
+      raw_data->resize(raw_data_size);
+      ORT_RETURN_IF_ERROR(onnxruntime::utils::DecompressTensorData(
+          compression, GetElementSize(initializer, raw_data_size),
+          gsl::make_span(fbs_compressed_raw_data->Data(), fbs_compressed_raw_data->size()),
+          gsl::make_span(reinterpret_cast<uint8_t*>(&(*raw_data)[0]), raw_data_size)));
+    }
   } else {
     const auto* fbs_raw_data = fbs_tensor.raw_data();
     ORT_RETURN_IF(nullptr == fbs_raw_data, "Missing raw data for initializer. Invalid ORT format model.");
 
-    // fbs_raw_data is uint8_t vector, so the size is byte size
-    initializer.set_raw_data(fbs_raw_data->Data(), fbs_raw_data->size());
+    const auto raw_data_address = reinterpret_cast<uintptr_t>(fbs_raw_data->Data());
+    if (can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 0 &&
+        raw_data_address % kInitializerRawDataAlignment == 0) {
+      // refer to the raw data in place as external data at its address
+      initializer.set_data_location(TensorProto_DataLocation_EXTERNAL);
+
+      auto* location = initializer.add_external_data();
+      location->set_key("location");
+      location->set_value(ToUTF8String(onnxruntime::utils::kTensorProtoMemoryAddressTag));
+      auto* offset = initializer.add_external_data();
+      offset->set_key("offset");
+      // the offset is parsed as a ptrdiff_t
+      offset->set_value(std::to_string(static_cast<ptrdiff_t>(raw_data_address)));
+      auto* length = initializer.add_external_data();
+      length->set_key("length");
+      length->set_value(std::to_string(fbs_raw_data->size()));
+    } else {
+      // fbs_raw_data is uint8_t vector, so the size is byte size
+      initializer.set_raw_data(fbs_raw_data->Data(), fbs_raw_data->size());
+    }
   }
 
   return Status::OK();
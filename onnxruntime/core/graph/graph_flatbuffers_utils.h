@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "core/framework/tensor_compression.h"
+
 namespace ONNX_NAMESPACE {
 class TensorProto;
 class SparseTensorProto;
@@ -31,10 +33,20 @@ struct Tensor;
 
 namespace utils {
 
+// Alignment of the raw data of the initializers saved in ORT format, so that the initializers can be used in place
+// in the model bytes. An initializer whose raw data is not aligned, e.g. in a model saved by an older version,
+// is copied when loaded.
+constexpr size_t kInitializerRawDataAlignment = 16;
+
+// Initializers smaller than this are not compressed, as the saving would be negligible.
+constexpr size_t kMinCompressedInitializerSize = 1024;
+
 // TODO, add ORT_MUST_USE_RESULT when it is moved to a different header
+// If compression is not kNone, the raw data of the initializer is saved compressed if that makes it smaller.
 onnxruntime::common::Status SaveInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::TensorProto& initializer,
-    const Path& model_path, flatbuffers::Offset<fbs::Tensor>& fbs_tensor);
+    const Path& model_path, flatbuffers::Offset<fbs::Tensor>& fbs_tensor,
+    TensorCompression compression = TensorCompression::kNone);
 
 onnxruntime::common::Status SaveSparseInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::SparseTensorProto& initializer,
@@ -44,13 +56,22 @@ onnxruntime::common::Status SaveSparseInitializerOrtFormat(
 // Note, we current do not support graphs, and sparse_tensor(s)
 //       If the attribute type is a graph, we need to use the supplied Graph instance,
 //       instead of the GraphProto in attr_proto
+//       The initializers of a subgraph are compressed with initializer_compression. Tensor attributes are not.
 onnxruntime::common::Status SaveAttributeOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::AttributeProto& attr_proto,
     flatbuffers::Offset<fbs::Attribute>& fbs_attr, const Path& model_path,
-    const onnxruntime::Graph* subgraph);
+    const onnxruntime::Graph* subgraph,
+    TensorCompression initializer_compression = TensorCompression::kNone);
 
+// Load a given fbs::Tensor into TensorProto
+// If can_use_flatbuffer_for_initializers is true, the aligned raw data of the tensor is not copied, the TensorProto
+// refers to it as external data at kTensorProtoMemoryAddressTag instead. The model bytes must then outlive the
+// TensorProto and the tensors created from it.
+// Compressed raw data is likewise referred to in place, and decompressed when the tensor is created. Otherwise it is
+// decompressed into the raw data of the TensorProto.
 onnxruntime::common::Status LoadInitializerOrtFormat(
-    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer);
+    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer,
+    bool can_use_flatbuffer_for_initializers = false);
 
 onnxruntime::common::Status LoadSparseInitializerOrtFormat(const fbs::SparseTensor& fbs_sparse_tensor,
                                                            ONNX_NAMESPACE::SparseTensorProto& initializer);
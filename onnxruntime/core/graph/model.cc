@@ -703,7 +703,8 @@ Status Model::SaveWithExternalInitializers(Model& model,
 }
 
 common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                      flatbuffers::Offset<fbs::Model>& fbs_model) const {
+                                      flatbuffers::Offset<fbs::Model>& fbs_model,
+                                      TensorCompression initializer_compression) const {
   auto producer_name = fbs::utils::SaveStringToOrtFormat(
       builder, model_proto_.has_producer_name(), model_proto_.producer_name());
   auto producer_version = fbs::utils::SaveStringToOrtFormat(
@@ -741,7 +742,7 @@ common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   }
 
   flatbuffers::Offset<fbs::Graph> fbs_graph;
-  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, fbs_graph));
+  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, fbs_graph, initializer_compression));
 
   fbs::ModelBuilder mb(builder);
   mb.add_ir_version(IrVersion());
@@ -771,7 +772,8 @@ common::Status Model::LoadFromOrtFormat(const fbs::Model& fbs_model,
                                         const IOnnxRuntimeOpSchemaRegistryList* local_registries,
 #endif
                                         const logging::Logger& logger,
-                                        std::unique_ptr<Model>& model) {
+                                        std::unique_ptr<Model>& model,
+                                        bool can_use_flatbuffer_for_initializers) {
   model = std::make_unique<Model>();
 
   // Load the model metadata
@@ -828,9 +830,10 @@ common::Status Model::LoadFromOrtFormat(const fbs::Model& fbs_model,
 
 #if !defined(ORT_MINIMAL_BUILD)
   ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version, schema_registry, logger,
-                                               model->graph_));
+                                               model->graph_, can_use_flatbuffer_for_initializers));
 #else
-  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version, logger, model->graph_));
+  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version, logger, model->graph_,
+                                               can_use_flatbuffer_for_initializers));
 #endif
   return Status::OK();
 }
@@ -8,6 +8,7 @@
 #include <climits>
 #include <string>
 #include "core/common/path.h"
+#include "core/framework/tensor_compression.h"
 #include "core/graph/graph_viewer.h"
 #include "core/session/onnxruntime_c_api.h"
 #if !defined(ORT_MINIMAL_BUILD)
@@ -288,8 +289,10 @@ class Model {
                              const logging::Logger& logger,
                              const ModelOptions& options = {});
 
+  // initializer_compression is the compression of the initializers, see TensorCompression.
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                 flatbuffers::Offset<onnxruntime::fbs::Model>& model) const;
+                                 flatbuffers::Offset<onnxruntime::fbs::Model>& model,
+                                 TensorCompression initializer_compression = TensorCompression::kNone) const;
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
@@ -298,7 +301,8 @@ class Model {
                                           const IOnnxRuntimeOpSchemaRegistryList* local_registries,
 #endif
                                           const logging::Logger& logger,
-                                          std::unique_ptr<Model>& model);
+                                          std::unique_ptr<Model>& model,
+                                          bool can_use_flatbuffer_for_initializers = false);
 
   Model();
 
@@ -77,6 +77,15 @@ Abstract:
 #define MLAS_SUPPORTS_GEMM_DOUBLE
 #endif
 
+//
+// Depthwise direct convolution of single precision CHW images, for the
+// targets that do not use the NCHWc convolution path.
+//
+
+#if defined(MLAS_TARGET_WASM) || defined(MLAS_TARGET_ARM_ANY)
+#define MLAS_SUPPORTS_CONV_DEPTHWISE_FLOAT
+#endif
+
 //
 // Basic Linear Algebra Subprograms (BLAS) types.
 //
@@ -126,6 +135,8 @@ enum MLAS_ACTIVATION_KIND {
     MlasLogisticActivation,
     MlasClipActivation,
     MlasHardSigmoidActivation,
+    MlasGeluActivation,
+    MlasFastGeluActivation,
 };
 
 struct MLAS_ACTIVATION {
@@ -163,6 +174,22 @@ MlasActivation(
 // op(X) = X or op(X) = transpose(X) or op(X) = conjg(transpose(X))
 //
 
+/**
+ * @brief Supply the operations fused into the output of single precision gemm
+ *        functions. The operations are applied to each block of matrix C as
+ *        soon as its final value is computed, while it is still in cache:
+ *
+ *            C := Activation(C + Bias) + Residual
+ *
+ *        Each operation is skipped when its pointer is nullptr.
+ */
+struct MLAS_SGEMM_EPILOGUE {
+    const float* Bias = nullptr;                /**< Supplies the optional bias vector of N elements added to each row of C */
+    const MLAS_ACTIVATION* Activation = nullptr;/**< Supplies the optional activation */
+    const float* Residual = nullptr;            /**< Supplies the optional matrix of M rows and N columns added to C */
+    size_t ldr = 0;                             /**< Supplies the first dimension of the residual matrix. */
+};
+
 /**
  * @brief Supply matrices data information to single precision gemm functions
  */
@@ -176,6 +203,7 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr; /**< Supplies the optional operations fused into the output */
 };
 
 /**
@@ -637,6 +665,45 @@ MlasSymmQgemmBatch(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Supply data parameters for the GEMM of 16-bit activations with
+ *        8-bit weights.
+*/
+struct MLAS_GEMM_S16S8_DATA_PARAMS {
+    const int16_t* A = nullptr;
+    size_t lda = 0;
+    int16_t ZeroPointA = 0;
+    const int8_t* B = nullptr;
+    size_t ldb = 0;
+    const int8_t* ZeroPointB = nullptr; /**< optional, per matrix or per column of B */
+    bool PerColumnZeroPoints = false;
+    int32_t* C = nullptr;
+    size_t ldc = 0;
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr;
+};
+
+/**
+ * @brief   Batched GEMM of int16 matrices A by int8 matrices B, accumulating
+ *          to int32 matrices C. All the multiplications have the same shape.
+ *
+ * @param [IN] M            Number of rows of A and C
+ * @param [IN] N            Number of columns of B and C
+ * @param [IN] K            Number of columns of A and rows of B
+ * @param [IN] DataParams   Array of data descriptors, one for each mutliplication
+ * @param [IN] BatchN       Number of multiplications
+ * @param [IN] ThreadPool   optional thread pool for parallel processing
+*/
+void
+MLASCALL
+MlasGemmS16S8Batch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_GEMM_S16S8_DATA_PARAMS* DataParams,
+    size_t BatchN,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 
 //
 // Buffer packing routines.
@@ -718,11 +785,25 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_SUPPORTS_CONV_DEPTHWISE_FLOAT)
     MlasConvAlgorithmDepthwise,
 #endif
 };
 
+struct MLAS_CONV_PARAMETERS;
+
+typedef
+void
+(MLAS_CONV_EXPAND_ROUTINE)(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    float* ColumnBuffer,
+    size_t k,
+    size_t CountK,
+    size_t n,
+    size_t CountN
+    );
+
 struct MLAS_CONV_PARAMETERS {
     const MLAS_ACTIVATION* Activation;
     size_t Dimensions;
@@ -741,6 +822,7 @@ struct MLAS_CONV_PARAMETERS {
     size_t K;
     float Beta;
     MLAS_CONV_ALGORITHM Algorithm;
+    MLAS_CONV_EXPAND_ROUTINE* ExpandRoutine;
     ptrdiff_t ThreadCount;
     union {
         struct {
@@ -783,6 +865,53 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(4x4, 3x3) convolution routines. The filter is transformed once
+// with MlasConvWinogradPackFilter and the convolution is then prepared with
+// MlasConvPrepare as for MlasConv.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    void* PackedFilter
+    );
+
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    const MLAS_CONV_PARAMETERS* Parameters
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradWorkingBufferSize(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -798,6 +927,23 @@ MlasConvDepthwise(
     size_t KernelSize
     );
 
+//
+// Single precision depthwise convolution of a channels last input supplied as
+// an indirection buffer. The filter is laid out as [KernelSize][Channels].
+//
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Symmetric quantized integer convolution routines.
 //
@@ -892,6 +1038,16 @@ MlasMaximumPool(
     size_t KernelSize
     );
 
+void
+MLASCALL
+MlasMaximumPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -931,6 +1087,82 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Supply the operations applied to the rows of attention scores before
+ *        the softmax computed by MlasComputeAttentionSoftmax:
+ *
+ *            X[r][c] := Scale * X[r][c] + Mask[r][c] + ExtraAdd[r][c]
+ *
+ *        With a causal mask, the scaled score of each column c greater than
+ *        CausalOffset + r is replaced by CausalMaskValue. Each of Mask and
+ *        ExtraAdd is skipped when its pointer is nullptr.
+ */
+struct MLAS_ATTENTION_SOFTMAX_PARAMS {
+    float Scale = 1.0f;                 /**< Supplies the scale applied to the input scores */
+    const float* Mask = nullptr;        /**< Supplies the optional additive mask of N rows and D columns */
+    const float* ExtraAdd = nullptr;    /**< Supplies the optional additive matrix of N rows and D columns */
+    bool Causal = false;                /**< Supplies true to apply a causal mask */
+    size_t CausalOffset = 0;            /**< Supplies the last unmasked column of the first row */
+    float CausalMaskValue = -10000.0f;  /**< Supplies the value of the causally masked scores */
+};
+
+void
+MLASCALL
+MlasComputeAttentionSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    const MLAS_ATTENTION_SOFTMAX_PARAMS* Params
+    );
+
+/**
+ * @brief Supply the parameters of a tiled attention operation computed by
+ *        MlasFlashAttention:
+ *
+ *            Output = Softmax(Scale * Query x Key' + Mask + ExtraAdd) x Value
+ *
+ *        The scores are computed for blocks of queries and keys and a streaming
+ *        softmax accumulates the output, so the full matrix of attention
+ *        probabilities is never stored. The masks have the semantics of
+ *        MLAS_ATTENTION_SOFTMAX_PARAMS with the causal offset of each row
+ *        being KvSequenceLength - SequenceLength.
+ */
+struct MLAS_FLASH_ATTENTION_PARAMS {
+    size_t BatchCount = 0;              /**< Supplies the batch size */
+    size_t HeadCount = 0;               /**< Supplies the number of heads */
+    size_t SequenceLength = 0;          /**< Supplies the number of queries per head */
+    size_t KvSequenceLength = 0;        /**< Supplies the number of keys and values per head */
+    size_t QkHeadSize = 0;              /**< Supplies the head size of the queries and keys */
+    size_t VHeadSize = 0;               /**< Supplies the head size of the values */
+    float Scale = 1.0f;                 /**< Supplies the scale applied to the scores */
+    const float* Query = nullptr;       /**< Supplies the queries with shape (BatchCount, HeadCount, SequenceLength, QkHeadSize) */
+    const float* Key = nullptr;         /**< Supplies the keys with shape (BatchCount, HeadCount, KvSequenceLength, QkHeadSize) */
+    const float* Value = nullptr;       /**< Supplies the values with shape (BatchCount, HeadCount, KvSequenceLength, VHeadSize) */
+    const float* Mask = nullptr;        /**< Supplies the optional additive mask shared by the heads of a batch */
+    size_t MaskBatchStride = 0;         /**< Supplies the distance between the masks of two batches */
+    size_t MaskRowStride = 0;           /**< Supplies the distance between the mask rows of two queries, or 0 to broadcast a single row */
+    const float* ExtraAdd = nullptr;    /**< Supplies the optional additive scores with shape (BatchCount, HeadCount, SequenceLength, KvSequenceLength) */
+    bool Causal = false;                /**< Supplies true to apply a causal mask */
+    float CausalMaskValue = -10000.0f;  /**< Supplies the value of the causally masked scores */
+    float* Output = nullptr;            /**< Supplies the output with shape (BatchCount, SequenceLength, HeadCount, VHeadSize) */
+};
+
+size_t
+MLASCALL
+MlasFlashAttentionWorkingBufferSize(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    float* WorkingBuffer,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -952,10 +1184,414 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+//
+// Bfloat16 floating-point routines. Rounding is to nearest even.
+//
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+//
+// Layer normalization routines, normalizing a row of N values:
+//     Value[i] = Input[i] + Skip[i] + Bias[i]
+//     Output[i] = (Value[i] - Mean) * InvStdDev * Gamma[i] + Beta[i]
+// Skip, Bias and Beta are optional. The simplified variant (RMS normalization)
+// uses no mean and no beta. Mean and InvStdDev optionally receive the
+// statistics of the row. The statistics are accumulated in single precision
+// in the same pass as the skip and bias additions, and the values are then
+// normalized from the cache. The half precision variant widens the row to
+// WorkBuffer, which holds N floats, and accumulates in single precision.
+//
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
+void
+MLASCALL
+MlasLayerNormalizationHalf(
+    const unsigned short* Input,
+    const unsigned short* Skip,
+    const unsigned short* Bias,
+    const unsigned short* Gamma,
+    const unsigned short* Beta,
+    unsigned short* Output,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev,
+    float* WorkBuffer
+    );
+
+//
+// Single precision sparse matrix/dense matrix multiply routine.
+// C := alpha * A * B, where A is in compressed sparse row (CSR) format.
+//
+
+void
+MLASCALL
+MlasSparseGemm(
+    size_t M,
+    size_t N,
+    float alpha,
+    const float* AValues,
+    const int64_t* ARowOffsets,
+    const int64_t* AColumnIndices,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Half precision floating-point matrix/matrix multiply routines.
+// C := A * B + Bias
+//
+
+/**
+ * @brief Bits of an IEEE 754 binary16 value, layout compatible with
+ *        onnxruntime::MLFloat16
+ */
+typedef uint16_t MLAS_FP16;
+
+/**
+ * @brief Supply matrices data information to half precision gemm functions
+ */
+struct MLAS_HALF_GEMM_DATA_PARAMS {
+    const MLAS_FP16* A = nullptr;    /**< Supplies the address of matrix A */
+    size_t lda = 0;                  /**< Supplies the first dimension of matrix A. */
+    const void* B = nullptr;         /**< Supplies the address of matrix B, packed by MlasHalfGemmPackB if BIsPacked */
+    size_t ldb = 0;                  /**< Supplies the first dimension of matrix B, ignored if BIsPacked. */
+    MLAS_FP16* C = nullptr;          /**< Supplies the address of matrix C */
+    size_t ldc = 0;                  /**< Supplies the first dimension of matrix C. */
+    const MLAS_FP16* Bias = nullptr; /**< Supplies the optional bias vector of N elements added to each row of C */
+    bool BIsPacked = false;          /**< Whether B is pre-packed */
+};
+
+/**
+ * @brief  Check whether the processor supports half precision vector arithmetic,
+ *         i.e. whether MlasHalfGemmBatch is faster than converting to single
+ *         precision and calling MlasGemm.
+ */
+bool
+MLASCALL
+MlasFp16AccelerationSupported(
+    void
+    );
+
+/**
+ * @brief  Batched half precision matrix/matrix multiply operation (HGEMM)
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param BatchN     Supplies number of multiplications in this batch
+ * @param DataParams A array of matrices data parameters
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasHalfGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    const MLAS_HALF_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Returns the size in bytes of the buffer needed by MlasHalfGemmPackB.
+ *
+ * @param N  Supplies the number of columns of matrix B.
+ * @param K  Supplies the number of rows of matrix B.
+ */
+size_t
+MLASCALL
+MlasHalfGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief  Packs matrix B for use with MlasHalfGemmBatch.
+ *
+ * @param TransB   Supplies the transpose operation for matrix B.
+ * @param N        Supplies the number of columns of matrix B.
+ * @param K        Supplies the number of rows of matrix B.
+ * @param B        Supplies the address of matrix B.
+ * @param ldb      Supplies the first dimension of matrix B.
+ * @param PackedB  Supplies the address of the packed buffer, of
+ *                 MlasHalfGemmPackBSize bytes.
+ */
+void
+MLASCALL
+MlasHalfGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_FP16* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+//
+// Brain floating-point matrix/matrix multiply routines. The inputs are
+// bfloat16, the products are accumulated and stored in single precision.
+// C := A * B + Bias
+//
+
+/**
+ * @brief Bits of a bfloat16 value, layout compatible with onnxruntime::BFloat16
+ */
+typedef uint16_t MLAS_BF16;
+
+/**
+ * @brief Supply matrices data information to bfloat16 gemm functions
+ */
+struct MLAS_SBGEMM_DATA_PARAMS {
+    const MLAS_BF16* A = nullptr;    /**< Supplies the address of matrix A */
+    size_t lda = 0;                  /**< Supplies the first dimension of matrix A. */
+    const void* B = nullptr;         /**< Supplies the address of matrix B, packed by MlasSBGemmPackB if BIsPacked */
+    size_t ldb = 0;                  /**< Supplies the first dimension of matrix B, ignored if BIsPacked. */
+    float* C = nullptr;              /**< Supplies the address of matrix C */
+    size_t ldc = 0;                  /**< Supplies the first dimension of matrix C. */
+    const float* Bias = nullptr;     /**< Supplies the optional bias vector of N elements added to each row of C */
+    bool BIsPacked = false;          /**< Whether B is pre-packed */
+};
+
+/**
+ * @brief  Check whether the processor has bfloat16 dot product or matrix
+ *         instructions, i.e. whether MlasSBGemmBatch is faster than converting
+ *         to single precision and calling MlasGemm.
+ */
+bool
+MLASCALL
+MlasBf16AccelerationSupported(
+    void
+    );
+
+/**
+ * @brief  Batched bfloat16 matrix/matrix multiply operation (SBGEMM)
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param BatchN     Supplies number of multiplications in this batch
+ * @param DataParams A array of matrices data parameters
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSBGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    const MLAS_SBGEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Returns the size in bytes of the buffer needed by MlasSBGemmPackB.
+ *
+ * @param N  Supplies the number of columns of matrix B.
+ * @param K  Supplies the number of rows of matrix B.
+ */
+size_t
+MLASCALL
+MlasSBGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief  Packs matrix B for use with MlasSBGemmBatch.
+ *
+ * @param TransB   Supplies the transpose operation for matrix B.
+ * @param N        Supplies the number of columns of matrix B.
+ * @param K        Supplies the number of rows of matrix B.
+ * @param B        Supplies the address of matrix B.
+ * @param ldb      Supplies the first dimension of matrix B.
+ * @param PackedB  Supplies the address of the packed buffer, of
+ *                 MlasSBGemmPackBSize bytes.
+ */
+void
+MLASCALL
+MlasSBGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+//
+// Matrix/matrix multiply with block-wise 4-bit quantized weights (Q4GEMM).
+// Each column of matrix B is quantized in blocks of BlkLen consecutive rows,
+// each block having its own scale and optional zero point:
+//     B(k, n) = (Q(k, n) - ZeroPoint(n, k / BlkLen)) * Scale(n, k / BlkLen)
+// C := A * B + Bias
+//
+// With BlockCountK = (K + BlkLen - 1) / BlkLen, the quantized data is laid out
+// column after column:
+//
+//  QuantBData      - [N][BlockCountK][BlkLen / 2] bytes. Element 2 * i of a
+//                    block is in the low nibble of byte i, element 2 * i + 1
+//                    in the high nibble. The last block is padded.
+//  QuantBScale     - [N][BlockCountK] floats.
+//  QuantBZeroPoint - optional [N][(BlockCountK + 1) / 2] bytes, the zero point
+//                    of block 2 * i in the low nibble of byte i. The zero point
+//                    is 8 when not supplied.
+//
+// This is the layout of the com.microsoft.MatMulNBits operator, so the
+// quantized weights of a model are used in place without repacking.
+//
+
+/**
+ * @brief Supply matrices data information to 4-bit quantized gemm functions
+ */
+struct MLAS_Q4GEMM_DATA_PARAMS {
+    const float* A = nullptr;                  /**< Supplies the address of matrix A */
+    size_t lda = 0;                            /**< Supplies the first dimension of matrix A. */
+    const uint8_t* QuantBData = nullptr;       /**< Supplies the quantized data of matrix B */
+    const float* QuantBScale = nullptr;        /**< Supplies the block scales of matrix B */
+    const uint8_t* QuantBZeroPoint = nullptr;  /**< Supplies the optional block zero points of matrix B */
+    const float* Bias = nullptr;               /**< Supplies the optional bias vector of N elements added to each row of C */
+    float* C = nullptr;                        /**< Supplies the address of matrix C */
+    size_t ldc = 0;                            /**< Supplies the first dimension of matrix C. */
+};
+
+/**
+ * @brief  Check whether a block length is supported by MlasQ4GemmBatch. The
+ *         supported block lengths are 32, 64, 128 and 256.
+ */
+bool
+MLASCALL
+MlasQ4GemmIsBlkLenSupported(
+    size_t BlkLen
+    );
+
+/**
+ * @brief  Batched matrix/matrix multiply with block-wise 4-bit quantized
+ *         matrix B (Q4GEMM). The quantized blocks are dequantized inside the
+ *         kernel, so matrix B is streamed from memory at 4 bits per element.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param BlkLen     Supplies the number of rows of matrix B in a block.
+ * @param BatchN     Supplies number of multiplications in this batch
+ * @param DataParams A array of matrices data parameters
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasQ4GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    size_t BatchN,
+    const MLAS_Q4GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Quantizes matrix B to the block-wise 4-bit layout of
+ *         MlasQ4GemmBatch, rounding to the nearest quantized value.
+ *
+ * @param BlkLen          Supplies the number of rows of matrix B in a block.
+ * @param N               Supplies the number of columns of matrix B.
+ * @param K               Supplies the number of rows of matrix B.
+ * @param B               Supplies the address of matrix B.
+ * @param ldb             Supplies the first dimension of matrix B.
+ * @param QuantBData      Supplies the address of the quantized data.
+ * @param QuantBScale     Supplies the address of the block scales.
+ * @param QuantBZeroPoint Supplies the address of the block zero points, else
+ *                        nullptr for a symmetric quantization around 8.
+ */
+void
+MLASCALL
+MlasQ4GemmQuantizeB(
+    size_t BlkLen,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    uint8_t* QuantBData,
+    float* QuantBScale,
+    uint8_t* QuantBZeroPoint
+    );
+
 //
 // Transpose routines.
 //
 
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    size_t ldInput,
+    uint8_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    size_t ldInput,
+    uint32_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
 void
 MLASCALL
 MlasTranspose(
@@ -1164,6 +1800,53 @@ MlasRequantizeOutput(
     size_t CountN
     );
 
+/**
+ * @brief Requantize a block of the intermediate buffer to the output buffer
+ *        after adding a quantized addend, optionally adding the supplied bias.
+ *        Used to fuse a quantized residual add into the producing operator
+ *        without requantizing the intermediate buffer first.
+ *
+ * @param Input                     Input matrix
+ * @param InputLeadingDimension     Input matrix leading dimension
+ * @param Addend                    Quantized addend matrix, same shape as the output
+ * @param AddendLeadingDimension    Addend matrix leading dimension
+ * @param Output                    Output matrix
+ * @param OutputLeadingDimension    Output matrix leading dimension
+ * @param Bias                      Optional bias vector, to be added
+                                    to the input before quantization
+ * @param Scale                     Quantization scale of the input
+ * @param PerColumnScale            true if scale is per-column
+ * @param AddendScale               Quantization scale of the addend
+ * @param AddendZeroPoint           Quantization zero point of the addend
+ * @param ZeroPoint                 quantization zero point value
+ * @param StartM
+ * @param StartN
+ * @param CountM
+ * @param CountN
+ * @return
+*/
+template<typename OutputType>
+void
+MLASCALL
+MlasRequantizeOutputAdd(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    const OutputType* Addend,
+    size_t AddendLeadingDimension,
+    OutputType* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerColumnScale,
+    float AddendScale,
+    OutputType AddendZeroPoint,
+    OutputType ZeroPoint,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    );
+
 class MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR
 {
    public:
@@ -1301,3 +1984,16 @@ MlasQLinearMul(
     size_t N,
     bool IsScalarB
     );
+
+//
+// Output[i] = Table[Input[i]] for the 256 entry table of a unary function of 8 bit quantized values.
+//
+
+void
+MLASCALL
+MlasQLinearLookupTable(
+    const uint8_t* Input,
+    const uint8_t* Table,
+    uint8_t* Output,
+    size_t N
+    );
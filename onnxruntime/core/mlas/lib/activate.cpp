@@ -358,6 +358,71 @@ Return Value:
     MLAS_UNREFERENCED_PARAMETER(ldc);
 }
 
+void
+MlasGeluActivationKernel(
+    bool Fast,
+    float* Buffer,
+    size_t M,
+    size_t N,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the Gelu activation function to the output matrix,
+    computed either with the error function or with the tanh approximation.
+
+Arguments:
+
+    Fast - Supplies true to use the tanh approximation, else false.
+
+    Buffer - Supplies the output matrix.
+
+    M - Supplies the number of rows in the output matrix.
+
+    N - Supplies the number of columns of the output matrix.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t ChunkSize = 256;
+
+    float Temp[ChunkSize];
+
+    while (M-- > 0) {
+
+        for (size_t n = 0; n < N; n += ChunkSize) {
+
+            float* x = Buffer + n;
+            const size_t CountN = std::min(N - n, ChunkSize);
+
+            if (Fast) {
+                for (size_t i = 0; i < CountN; i++) {
+                    Temp[i] = 0.7978845608028654f * (x[i] + 0.044715f * x[i] * x[i] * x[i]);
+                }
+                MlasComputeTanh(Temp, Temp, CountN);
+            } else {
+                for (size_t i = 0; i < CountN; i++) {
+                    Temp[i] = x[i] * 0.7071067811865475f;
+                }
+                MlasComputeErf(Temp, Temp, CountN);
+            }
+
+            for (size_t i = 0; i < CountN; i++) {
+                x[i] = 0.5f * x[i] * (1.0f + Temp[i]);
+            }
+        }
+
+        Buffer += ldc;
+    }
+}
+
 template<MLAS_ACTIVATION_KIND ActivationKind>
 inline
 void
@@ -509,5 +574,16 @@ Return Value:
             MlasActivationKernel<MlasHardSigmoidActivation>(Activation, Buffer, Bias, M, N, ldc);
             break;
         }
+
+        case MlasGeluActivation:
+        case MlasFastGeluActivation:
+        {
+            if (Bias != nullptr) {
+                MlasActivationKernel<MlasIdentityActivation, true>(Activation, Buffer, Bias, M, N, ldc);
+            }
+
+            MlasGeluActivationKernel(Activation->ActivationKind == MlasFastGeluActivation, Buffer, M, N, ldc);
+            break;
+        }
     }
 }
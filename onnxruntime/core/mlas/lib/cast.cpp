@@ -0,0 +1,148 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast.cpp
+
+Abstract:
+
+    This module implements routines to convert buffers between single
+    precision and the half precision and bfloat16 formats.
+
+    The half precision conversions use the F16C instructions on x64 and the
+    NEON conversion instructions on ARM64, and otherwise fall back to the
+    scalar conversions of the half and bfloat16 GEMM kernels. The bfloat16
+    conversions are branch free integer operations that compilers vectorize.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+#include "sbgemm.h"
+
+#if defined(MLAS_NEON64_INTRINSICS) && !defined(_MSC_VER)
+#define MLAS_CAST_NEON64_INTRINSICS
+#endif
+
+//
+// The Windows x64 build implements MlasConvertHalfToFloatBuffer in assembly.
+//
+
+#if !defined(_M_AMD64) || defined(_M_ARM64EC)
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    MLAS_CAST_F16_TO_F32_KERNEL* CastKernel = GetMlasPlatform().CastF16ToF32Kernel;
+
+    if (CastKernel != nullptr) {
+        CastKernel(Source, Destination, Count);
+        return;
+    }
+
+#elif defined(MLAS_CAST_NEON64_INTRINSICS)
+
+    while (Count >= 4) {
+
+        float16x4_t HalfVector = vreinterpret_f16_u16(vld1_u16(Source));
+        vst1q_f32(Destination, vcvt_f32_f16(HalfVector));
+
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+
+#endif
+
+    while (Count > 0) {
+        *Destination++ = MlasFp16ToFloat(*Source++);
+        Count -= 1;
+    }
+}
+
+#endif
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    MLAS_CAST_F32_TO_F16_KERNEL* CastKernel = GetMlasPlatform().CastF32ToF16Kernel;
+
+    if (CastKernel != nullptr) {
+        CastKernel(Source, Destination, Count);
+        return;
+    }
+
+#elif defined(MLAS_CAST_NEON64_INTRINSICS)
+
+    while (Count >= 4) {
+
+        float16x4_t HalfVector = vcvt_f16_f32(vld1q_f32(Source));
+        vst1_u16(Destination, vreinterpret_u16_f16(HalfVector));
+
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+
+#endif
+
+    while (Count > 0) {
+        *Destination++ = MlasFloatToFp16(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasBf16ToFloat(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    for (size_t i = 0; i < Count; i++) {
+
+        const uint32_t Bits = MlasBitsOfFp32(Source[i]);
+        const uint32_t RoundingBias = 0x7FFFu + ((Bits >> 16) & 1u);
+        const uint32_t Rounded = (Bits + RoundingBias) >> 16;
+        const uint32_t QuietNaN = (Bits >> 16) | 0x40u;
+
+        //
+        // Select instead of branching on NaN, so that the loop vectorizes.
+        //
+
+        const bool IsNaN = (Bits & 0x7FFFFFFFu) > 0x7F800000u;
+        Destination[i] = static_cast<unsigned short>(IsNaN ? QuietNaN : Rounded);
+    }
+}
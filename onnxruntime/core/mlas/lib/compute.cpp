@@ -989,3 +989,205 @@ Return Value:
 
     MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
 }
+
+MLAS_FORCEINLINE
+float
+MlasComputeAttentionScores(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    const float* Mask,
+    const float* ExtraAdd
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output = Scale * Input + Mask + ExtraAdd for a
+    segment of a row of attention scores. If Input is nullptr, then Scale
+    is used in place of the scaled input.
+
+Arguments:
+
+    Input - Supplies the input buffer, else nullptr to use Scale for each
+        element.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the scale applied to the input buffer.
+
+    Mask - Optionally supplies the additive mask buffer.
+
+    ExtraAdd - Optionally supplies the additive extra buffer.
+
+Return Value:
+
+    Returns the maximum value of the output buffer.
+
+--*/
+{
+    float Maximum = MlasMinimumF32Value;
+
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    MLAS_FLOAT32X4 MaximumVector = MlasBroadcastFloat32x4(Maximum);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = (Input != nullptr) ?
+            MlasMultiplyFloat32x4(MlasLoadFloat32x4(Input), ScaleVector) : ScaleVector;
+
+        if (Mask != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Mask));
+            Mask += 4;
+        }
+
+        if (ExtraAdd != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(ExtraAdd));
+            ExtraAdd += 4;
+        }
+
+        MlasStoreFloat32x4(Output, Vector);
+        MaximumVector = MlasMaximumFloat32x4(MaximumVector, Vector);
+
+        if (Input != nullptr) {
+            Input += 4;
+        }
+
+        Output += 4;
+        N -= 4;
+    }
+
+    Maximum = MlasReduceMaximumFloat32x4(MaximumVector);
+
+    while (N > 0) {
+
+        float Value = (Input != nullptr) ? *Input++ * Scale : Scale;
+
+        if (Mask != nullptr) {
+            Value += *Mask++;
+        }
+
+        if (ExtraAdd != nullptr) {
+            Value += *ExtraAdd++;
+        }
+
+        *Output++ = Value;
+        Maximum = std::max(Maximum, Value);
+
+        N -= 1;
+    }
+
+    return Maximum;
+}
+
+void
+MLASCALL
+MlasComputeAttentionSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    const MLAS_ATTENTION_SOFTMAX_PARAMS* Params
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax function of rows of attention scores
+    after scaling the scores and applying the additive and causal masks. Each
+    row is passed over while it remains in the cache, so the masks do not
+    require separate passes over the attention scores.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+    N.B. This routine executes on the calling thread. Attention operators
+    invoke it for the rows of one head after computing the scores of the head.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    Params - Supplies the scale and masks to apply to the input buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* Mask = Params->Mask;
+    const float* ExtraAdd = Params->ExtraAdd;
+
+    for (size_t n = 0; n < N; n++) {
+
+        //
+        // Compute the number of columns that are not causally masked.
+        //
+
+        size_t CountD = D;
+
+        if (Params->Causal && Params->CausalOffset + n + 1 < D) {
+            CountD = Params->CausalOffset + n + 1;
+        }
+
+        //
+        // Apply the scale and masks to the row and find its maximum value.
+        //
+
+        float Maximum = MlasComputeAttentionScores(Input, Output, CountD, Params->Scale, Mask, ExtraAdd);
+
+        if (CountD < D) {
+
+            float MaskedMaximum = MlasComputeAttentionScores(nullptr, Output + CountD, D - CountD,
+                Params->CausalMaskValue, (Mask != nullptr) ? Mask + CountD : nullptr,
+                (ExtraAdd != nullptr) ? ExtraAdd + CountD : nullptr);
+
+            Maximum = std::max(Maximum, MaskedMaximum);
+        }
+
+        float NegativeMaximum = -Maximum;
+
+        //
+        // Compute the exponential function for each element of the row and
+        // compute the sum of these exponential functions.
+        //
+
+#if defined(MLAS_TARGET_AMD64)
+        float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(Output, Output, D, &NegativeMaximum);
+#else
+        float Accumulation = MlasComputeSumExpF32Kernel(Output, Output, D, &NegativeMaximum);
+#endif
+
+        //
+        // Normalize the softmax output.
+        //
+
+        float Parameters[] = { 1.0f / Accumulation };
+
+#if defined(MLAS_TARGET_AMD64)
+        GetMlasPlatform().ComputeSoftmaxOutputF32Kernel(Output, D, Parameters);
+#else
+        MlasComputeSoftmaxOutputF32Kernel(Output, D, Parameters);
+#endif
+
+        Input += D;
+        Output += D;
+
+        if (Mask != nullptr) {
+            Mask += D;
+        }
+
+        if (ExtraAdd != nullptr) {
+            ExtraAdd += D;
+        }
+    }
+}
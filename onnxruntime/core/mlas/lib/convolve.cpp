@@ -42,6 +42,7 @@ struct MLAS_CONV_WORK_BLOCK {
     ptrdiff_t TargetThreadCount;
 };
 
+template<size_t FixedKernelHeight, size_t FixedKernelWidth, size_t FixedStrideHeight, size_t FixedStrideWidth>
 void
 MlasConvIm2Col(
     const MLAS_CONV_PARAMETERS* Parameters,
@@ -65,6 +66,12 @@ Routine Description:
     implementation will already break up the operation into panels. Multiple
     threads can also be used to process different portions of the image.
 
+    The template parameters optionally fix the kernel and stride shapes at
+    compile time, so that the index arithmetic and the padding checks are
+    specialized for the shape. A value of zero reads the shape from the
+    convolution parameters. A specialized kernel shape implies a dilation
+    of one.
+
 Arguments:
 
     Parameters - Supplies the structure that contains the convolution
@@ -93,8 +100,12 @@ Return Value:
 
     const size_t OutputWidth = Parameters->OutputShape[WidthShapeIndex];
 
-    const size_t StrideHeight = Parameters->StrideShape[HeightShapeIndex];
-    const size_t StrideWidth = Parameters->StrideShape[WidthShapeIndex];
+    constexpr bool IsKernelFixed = (FixedKernelHeight != 0 && FixedKernelWidth != 0);
+
+    const size_t StrideHeight = (FixedStrideHeight != 0) ? FixedStrideHeight :
+        Parameters->StrideShape[HeightShapeIndex];
+    const size_t StrideWidth = (FixedStrideWidth != 0) ? FixedStrideWidth :
+        Parameters->StrideShape[WidthShapeIndex];
 
     const size_t nx = (n % OutputWidth);
     const size_t ny = (n / OutputWidth);
@@ -108,16 +119,18 @@ Return Value:
     const size_t InputWidth = Parameters->InputShape[WidthShapeIndex];
     const size_t InputSize = Parameters->InputSize;
 
-    const size_t KernelHeight = Parameters->KernelShape[HeightShapeIndex];
-    const size_t KernelWidth = Parameters->KernelShape[WidthShapeIndex];
+    const size_t KernelHeight = (FixedKernelHeight != 0) ? FixedKernelHeight :
+        Parameters->KernelShape[HeightShapeIndex];
+    const size_t KernelWidth = (FixedKernelWidth != 0) ? FixedKernelWidth :
+        Parameters->KernelShape[WidthShapeIndex];
 
     size_t kx = (k % KernelWidth);
     size_t ky = (k / KernelWidth) % KernelHeight;
 
     Input = Input + (k / (KernelHeight * KernelWidth)) * InputSize;
 
-    const size_t DilationHeight = Parameters->DilationShape[HeightShapeIndex];
-    const size_t DilationWidth = Parameters->DilationShape[WidthShapeIndex];
+    const size_t DilationHeight = IsKernelFixed ? 1 : Parameters->DilationShape[HeightShapeIndex];
+    const size_t DilationWidth = IsKernelFixed ? 1 : Parameters->DilationShape[WidthShapeIndex];
 
     const size_t PaddingLeftY = Parameters->Padding[HeightShapeIndex];
     const size_t PaddingLeftX = Parameters->Padding[WidthShapeIndex];
@@ -248,6 +261,69 @@ Return Value:
     }
 }
 
+//
+// Define the table of convolution patch routines specialized for common
+// kernel and stride shapes. The table is searched by MlasConvPrepare.
+//
+
+struct MLAS_CONV_IM2COL_SPECIALIZATION {
+    size_t KernelHeight;
+    size_t KernelWidth;
+    size_t StrideHeight;
+    size_t StrideWidth;
+    MLAS_CONV_EXPAND_ROUTINE* ExpandRoutine;
+};
+
+static const MLAS_CONV_IM2COL_SPECIALIZATION MlasConvIm2ColSpecializations[] = {
+    { 1, 1, 2, 2, MlasConvIm2Col<1, 1, 2, 2> },
+    { 1, 3, 1, 1, MlasConvIm2Col<1, 3, 1, 1> },
+    { 3, 1, 1, 1, MlasConvIm2Col<3, 1, 1, 1> },
+    { 3, 3, 1, 1, MlasConvIm2Col<3, 3, 1, 1> },
+    { 3, 3, 2, 2, MlasConvIm2Col<3, 3, 2, 2> },
+    { 5, 5, 1, 1, MlasConvIm2Col<5, 5, 1, 1> },
+    { 5, 5, 2, 2, MlasConvIm2Col<5, 5, 2, 2> },
+    { 7, 7, 2, 2, MlasConvIm2Col<7, 7, 2, 2> },
+};
+
+MLAS_CONV_EXPAND_ROUTINE*
+MlasConvSelectIm2Col(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the routine to convert the input image of a two
+    dimensional convolution to convolution patches.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+Return Value:
+
+    Returns the convolution patch routine specialized for the kernel and
+    stride shapes if one exists, else the general routine.
+
+--*/
+{
+    if (Parameters->DilationShape[0] == 1 && Parameters->DilationShape[1] == 1) {
+
+        for (const auto& Specialization : MlasConvIm2ColSpecializations) {
+
+            if (Specialization.KernelHeight == Parameters->KernelShape[0] &&
+                Specialization.KernelWidth == Parameters->KernelShape[1] &&
+                Specialization.StrideHeight == Parameters->StrideShape[0] &&
+                Specialization.StrideWidth == Parameters->StrideShape[1]) {
+                return Specialization.ExpandRoutine;
+            }
+        }
+    }
+
+    return MlasConvIm2Col<0, 0, 0, 0>;
+}
+
 void
 MlasConvVol2Col(
     const MLAS_CONV_PARAMETERS* Parameters,
@@ -582,17 +658,12 @@ Return Value:
                 CountK = StrideK;
             }
 
-            if (Parameters->Dimensions == 2) {
-                MlasConvIm2Col(Parameters, Input, ColumnBuffer, k, CountK,
-                    SegmentStartN + n, CountN);
-            } else {
-                MlasConvVol2Col(Parameters, Input, ColumnBuffer, k, CountK,
-                    SegmentStartN + n, CountN);
-            }
+            Parameters->ExpandRoutine(Parameters, Input, ColumnBuffer, k, CountK,
+                SegmentStartN + n, CountN);
 
             MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountN,
                 CountK, 1.0f, Filter + k, K, ColumnBuffer, CountN, beta,
-                SegmentOutput, OutputSize);
+                SegmentOutput, OutputSize, nullptr);
 
             beta = 1.0f;
         }
@@ -711,7 +782,7 @@ Return Value:
 
         MlasSgemmOperation(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
             OutputSize, K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb, 0.0f,
-            output, OutputSize);
+            output, OutputSize, nullptr);
 
         //
         // Apply the activation with optional bias.
@@ -728,6 +799,86 @@ Return Value:
     }
 }
 
+#if defined(MLAS_SUPPORTS_CONV_DEPTHWISE_FLOAT)
+
+void
+MlasConvDepthwiseThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    depthwise convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Compute the range of indices to use for this thread.
+    //
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t BatchGroupCount = Parameters->BatchCount * GroupCount;
+
+    size_t BatchGroupStart;
+    size_t BatchGroupRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, BatchGroupCount,
+        &BatchGroupStart, &BatchGroupRemaining);
+
+    size_t BatchGroupEnd = BatchGroupStart + BatchGroupRemaining;
+
+    //
+    // Iterate over the batch and groups allocated to this thread. The working
+    // buffer holds the zero row shared by all the threads.
+    //
+
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t K = Parameters->K;
+
+    for (size_t bg = BatchGroupStart; bg < BatchGroupEnd; bg++) {
+
+        size_t group = bg % GroupCount;
+
+        const float* input = WorkBlock->Input + bg * InputSize;
+        const float* filter = WorkBlock->Filter + group * K;
+        float* output = WorkBlock->Output + bg * OutputSize;
+
+        MlasConvDepthwiseFloat_CHW(Parameters, input, filter, output, WorkBlock->WorkingBuffer);
+
+        //
+        // Apply the activation with optional bias.
+        //
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group;
+        }
+
+        MlasActivation(Parameters->Activation, output, bias, 1, OutputSize, OutputSize);
+    }
+}
+
+#endif
+
 inline
 bool
 MlasConvTryMultithread(
@@ -902,12 +1053,41 @@ Return Value:
         return;
     }
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_SUPPORTS_CONV_DEPTHWISE_FLOAT)
 
     if (Algorithm == MlasConvAlgorithmDepthwise) {
         // Fill the Working Buffer with Zero for use by the depthwise kernel.
         // The length for the zeros are input image wide + 2 currently.
         std::fill_n(WorkingBuffer, Parameters->InputShape[1] + 2, 0.0f);
+
+        //
+        // Schedule the channels across multiple threads.
+        //
+
+        const size_t BatchGroupCount = BatchCount * GroupCount;
+
+        ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (size_t(TargetThreadCount) >= BatchGroupCount) {
+            TargetThreadCount = ptrdiff_t(BatchGroupCount);
+        }
+
+        if (TargetThreadCount > 1) {
+
+            MLAS_CONV_WORK_BLOCK WorkBlock;
+
+            WorkBlock.Parameters = Parameters;
+            WorkBlock.Input = Input;
+            WorkBlock.Filter = Filter;
+            WorkBlock.Bias = Bias;
+            WorkBlock.WorkingBuffer = WorkingBuffer;
+            WorkBlock.Output = Output;
+            WorkBlock.TargetThreadCount = TargetThreadCount;
+
+            MlasExecuteThreaded(MlasConvDepthwiseThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+
+            return;
+        }
     }
 
 #endif
@@ -955,11 +1135,7 @@ Return Value:
                     // threaded GEMM.
                     //
 
-                    if (Parameters->Dimensions == 2) {
-                        MlasConvIm2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
-                    } else {
-                        MlasConvVol2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
-                    }
+                    Parameters->ExpandRoutine(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
 
                     MlasGemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
                              K, WorkingBuffer, OutputSize, Parameters->Beta, Output, OutputSize,
@@ -975,7 +1151,7 @@ Return Value:
                     break;
                 }
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_SUPPORTS_CONV_DEPTHWISE_FLOAT)
 
                 case MlasConvAlgorithmDepthwise:
                 {
@@ -1161,6 +1337,17 @@ Return Value:
 
     Parameters->Dimensions = Dimensions;
 
+    //
+    // Select the routine to expand the input tensor to convolution patches.
+    // The routine is specialized for common kernel and stride shapes.
+    //
+
+    if (Dimensions == 2) {
+        Parameters->ExpandRoutine = MlasConvSelectIm2Col(Parameters);
+    } else {
+        Parameters->ExpandRoutine = MlasConvVol2Col;
+    }
+
     //
     // Evaluate how the convolution will be performed.
     //
@@ -1223,10 +1410,13 @@ Return Value:
 
     } else {
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_SUPPORTS_CONV_DEPTHWISE_FLOAT)
 
-        // Scalar direct conv for depthwise convolution.
+        // Direct conv for depthwise convolution, which avoids the im2col
+        // expansion and the GEMM of a single filter row.
         // Currently only support 3x3 kernel with padding <=1 and dilations = 1.
+        // The kernel stores the output, so accumulating into it (Beta != 0)
+        // keeps the GEMM path.
         // TODO: support more general depthwise convolution.
 
         if (Dimensions == 2
@@ -1234,7 +1424,8 @@ Return Value:
                 && Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3
                 && Parameters->Padding[0] <= 1 && Parameters->Padding[1] <= 1
                 && Parameters->Padding[2] <= 1 && Parameters->Padding[3] <= 1
-                && Parameters->DilationShape[0] == 1 && Parameters->DilationShape[1] == 1) {
+                && Parameters->DilationShape[0] == 1 && Parameters->DilationShape[1] == 1
+                && Parameters->Beta == 0.0f) {
 
             *WorkingBufferSize = Parameters->InputShape[1] + 2;
             Parameters->Algorithm = MlasConvAlgorithmDepthwise;
@@ -0,0 +1,804 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convwinograd.cpp
+
+Abstract:
+
+    This module implements the Winograd F(4x4, 3x3) convolution operation.
+
+    Each 6x6 tile of the input image is transformed to the Winograd domain,
+    where the convolution becomes 36 independent matrix multiplications of
+    the transformed filter by the transformed input tiles. The products are
+    then transformed back to 4x4 tiles of the output image. This reduces the
+    multiplications of a 3x3 convolution by a factor of four.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of output tiles processed by a thread as a unit. The
+// transformed input and the products of the tiles of a block are stored in
+// the thread local slice of the working buffer.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_BLOCK               32
+
+//
+// Define the shapes of the Winograd F(4x4, 3x3) transform.
+//
+
+constexpr size_t MlasWinogradOutputTile = 4;
+constexpr size_t MlasWinogradInputTile = 6;
+constexpr size_t MlasWinogradTileElements = MlasWinogradInputTile * MlasWinogradInputTile;
+
+//
+// Define the parameters to execute segments of a Winograd convolution on
+// worker threads.
+//
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* PackedFilter;
+    float* WorkingBuffer;
+    float* Output;
+    size_t TilesHeight;
+    size_t TilesWidth;
+    size_t TileBlockCount;
+    ptrdiff_t ThreadCount;
+};
+
+MLAS_FORCEINLINE
+void
+MlasWinogradFilterTransform1D(
+    const float* g,
+    size_t Stride,
+    float* u
+    )
+/*++
+
+Routine Description:
+
+    This routine computes G * g for one column of a 3x3 filter, where G is
+    the 6x3 filter transform matrix.
+
+Arguments:
+
+    g - Supplies the three elements of the filter column.
+
+    Stride - Supplies the distance between the elements of the filter column.
+
+    u - Receives the six elements of the transformed column.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float g0 = g[0];
+    const float g1 = g[Stride];
+    const float g2 = g[2 * Stride];
+
+    u[0] = g0 * (1.0f / 4.0f);
+    u[1] = (g0 + g1 + g2) * (-1.0f / 6.0f);
+    u[2] = (g0 - g1 + g2) * (-1.0f / 6.0f);
+    u[3] = g0 * (1.0f / 24.0f) + g1 * (1.0f / 12.0f) + g2 * (1.0f / 6.0f);
+    u[4] = g0 * (1.0f / 24.0f) - g1 * (1.0f / 12.0f) + g2 * (1.0f / 6.0f);
+    u[5] = g2;
+}
+
+MLAS_FORCEINLINE
+void
+MlasWinogradInputTransform1D(
+    const MLAS_FLOAT32X4* d,
+    size_t Stride,
+    MLAS_FLOAT32X4* v,
+    size_t StrideV
+    )
+/*++
+
+Routine Description:
+
+    This routine computes B^T * d for one column of four 6x6 input tiles,
+    where B^T is the 6x6 input transform matrix.
+
+Arguments:
+
+    d - Supplies the six elements of the input column.
+
+    Stride - Supplies the distance between the elements of the input column.
+
+    v - Receives the six elements of the transformed column.
+
+    StrideV - Supplies the distance between the elements of the transformed
+        column.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 d0 = d[0];
+    const MLAS_FLOAT32X4 d1 = d[Stride];
+    const MLAS_FLOAT32X4 d2 = d[2 * Stride];
+    const MLAS_FLOAT32X4 d3 = d[3 * Stride];
+    const MLAS_FLOAT32X4 d4 = d[4 * Stride];
+    const MLAS_FLOAT32X4 d5 = d[5 * Stride];
+
+    const MLAS_FLOAT32X4 s12 = MlasAddFloat32x4(d1, d2);
+    const MLAS_FLOAT32X4 d12 = MlasSubtractFloat32x4(d1, d2);
+    const MLAS_FLOAT32X4 s34 = MlasAddFloat32x4(d3, d4);
+    const MLAS_FLOAT32X4 d43 = MlasSubtractFloat32x4(d4, d3);
+    const MLAS_FLOAT32X4 d31 = MlasSubtractFloat32x4(d3, d1);
+    const MLAS_FLOAT32X4 d42 = MlasSubtractFloat32x4(d4, d2);
+
+    v[0] = MlasAddFloat32x4(MlasMultiplyAddFloat32x4(d0, 4.0f, d4), MlasMultiplyFloat32x4(d2, MlasBroadcastFloat32x4(-5.0f)));
+    v[StrideV] = MlasMultiplyAddFloat32x4(s12, -4.0f, s34);
+    v[2 * StrideV] = MlasMultiplyAddFloat32x4(d12, 4.0f, d43);
+    v[3 * StrideV] = MlasMultiplyAddFloat32x4(d31, 2.0f, d42);
+    v[4 * StrideV] = MlasMultiplyAddFloat32x4(d31, -2.0f, d42);
+    v[5 * StrideV] = MlasAddFloat32x4(MlasMultiplyAddFloat32x4(d1, 4.0f, d5), MlasMultiplyFloat32x4(d3, MlasBroadcastFloat32x4(-5.0f)));
+}
+
+MLAS_FORCEINLINE
+void
+MlasWinogradOutputTransform1D(
+    const MLAS_FLOAT32X4* m,
+    size_t Stride,
+    MLAS_FLOAT32X4* y,
+    size_t StrideY
+    )
+/*++
+
+Routine Description:
+
+    This routine computes A^T * m for one column of four 6x6 product tiles,
+    where A^T is the 4x6 output transform matrix.
+
+Arguments:
+
+    m - Supplies the six elements of the product column.
+
+    Stride - Supplies the distance between the elements of the product column.
+
+    y - Receives the four elements of the transformed column.
+
+    StrideY - Supplies the distance between the elements of the transformed
+        column.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 m0 = m[0];
+    const MLAS_FLOAT32X4 m1 = m[Stride];
+    const MLAS_FLOAT32X4 m2 = m[2 * Stride];
+    const MLAS_FLOAT32X4 m3 = m[3 * Stride];
+    const MLAS_FLOAT32X4 m4 = m[4 * Stride];
+    const MLAS_FLOAT32X4 m5 = m[5 * Stride];
+
+    const MLAS_FLOAT32X4 s12 = MlasAddFloat32x4(m1, m2);
+    const MLAS_FLOAT32X4 d12 = MlasSubtractFloat32x4(m1, m2);
+    const MLAS_FLOAT32X4 s34 = MlasAddFloat32x4(m3, m4);
+    const MLAS_FLOAT32X4 d34 = MlasSubtractFloat32x4(m3, m4);
+
+    y[0] = MlasAddFloat32x4(MlasAddFloat32x4(m0, s12), s34);
+    y[StrideY] = MlasMultiplyAddFloat32x4(d34, 2.0f, d12);
+    y[2 * StrideY] = MlasMultiplyAddFloat32x4(s34, 4.0f, s12);
+    y[3 * StrideY] = MlasAddFloat32x4(MlasMultiplyAddFloat32x4(d34, 8.0f, d12), m5);
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack a 3x3 filter
+    tensor to the Winograd domain.
+
+Arguments:
+
+    FilterCount - Supplies the number of filters.
+
+    InputChannels - Supplies the number of input channels.
+
+Return Value:
+
+    Returns the number of bytes required to pack the filter tensor.
+
+--*/
+{
+    return MlasWinogradTileElements * FilterCount * InputChannels * sizeof(float);
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 3x3 filter tensor to the Winograd domain by
+    computing G * g * G^T for each filter and input channel.
+
+    The packed filter is stored as 36 matrices of FilterCount rows and
+    InputChannels columns, one per element of the transformed tile.
+
+Arguments:
+
+    FilterCount - Supplies the number of filters.
+
+    InputChannels - Supplies the number of input channels.
+
+    Filter - Supplies the filter tensor with shape [FilterCount,
+        InputChannels, 3, 3].
+
+    PackedFilter - Supplies the buffer to receive the packed filter. The size
+        of the buffer is returned by MlasConvWinogradPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* packed = (float*)PackedFilter;
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* g = Filter + (f * InputChannels + c) * 9;
+
+            //
+            // Transform the columns and then the rows of the filter.
+            //
+
+            float Temp[MlasWinogradInputTile * 3];
+            float u[MlasWinogradInputTile];
+
+            for (size_t j = 0; j < 3; j++) {
+
+                MlasWinogradFilterTransform1D(g + j, 3, u);
+
+                for (size_t i = 0; i < MlasWinogradInputTile; i++) {
+                    Temp[i * 3 + j] = u[i];
+                }
+            }
+
+            for (size_t i = 0; i < MlasWinogradInputTile; i++) {
+
+                MlasWinogradFilterTransform1D(Temp + i * 3, 1, u);
+
+                for (size_t j = 0; j < MlasWinogradInputTile; j++) {
+                    packed[(i * MlasWinogradInputTile + j) * MatrixSize + f * InputChannels + c] = u[j];
+                }
+            }
+        }
+    }
+}
+
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the Winograd F(4x4, 3x3) algorithm can
+    execute the prepared convolution.
+
+Arguments:
+
+    Parameters - Supplies the structure returned by MlasConvPrepare.
+
+Return Value:
+
+    Returns true if the convolution is a two dimensional 3x3 convolution with
+    unit strides and dilations and a single group.
+
+--*/
+{
+    return Parameters->Dimensions == 2 &&
+        Parameters->GroupCount == 1 &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        Parameters->StrideShape[0] == 1 && Parameters->StrideShape[1] == 1 &&
+        Parameters->DilationShape[0] == 1 && Parameters->DilationShape[1] == 1;
+}
+
+ptrdiff_t
+MlasConvWinogradThreadCount(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of threads to execute a Winograd
+    convolution.
+
+Arguments:
+
+    Parameters - Supplies the structure returned by MlasConvPrepare.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns the number of threads.
+
+--*/
+{
+    const size_t TilesHeight = (Parameters->OutputShape[0] + MlasWinogradOutputTile - 1) / MlasWinogradOutputTile;
+    const size_t TilesWidth = (Parameters->OutputShape[1] + MlasWinogradOutputTile - 1) / MlasWinogradOutputTile;
+    const size_t TileBlocks = (TilesHeight * TilesWidth + MLAS_CONV_WINOGRAD_TILE_BLOCK - 1) /
+        MLAS_CONV_WINOGRAD_TILE_BLOCK;
+    const size_t WorkCount = Parameters->BatchCount * TileBlocks;
+
+    const double Complexity = double(WorkCount) * double(MLAS_CONV_WINOGRAD_TILE_BLOCK) *
+        double(MlasWinogradTileElements) * double(Parameters->FilterCount) * double(Parameters->InputChannels);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= WorkCount) {
+        TargetThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    return TargetThreadCount;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradWorkingBufferSize(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements of the working buffer for a
+    Winograd convolution.
+
+Arguments:
+
+    Parameters - Supplies the structure returned by MlasConvPrepare.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns the number of elements to allocate for the working buffer.
+
+--*/
+{
+    const size_t PerThreadSize = MlasWinogradTileElements * MLAS_CONV_WINOGRAD_TILE_BLOCK *
+        (Parameters->InputChannels + Parameters->FilterCount);
+
+    return size_t(MlasConvWinogradThreadCount(Parameters, ThreadPool)) * PerThreadSize;
+}
+
+void
+MlasConvWinogradTileBlock(
+    const MLAS_CONV_WINOGRAD_WORK_BLOCK* WorkBlock,
+    const float* Input,
+    float* Output,
+    size_t TileStart,
+    size_t TileCount,
+    float* TransformedInput,
+    float* Products
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output tiles of one image.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that contains the Winograd convolution
+        parameters.
+
+    Input - Supplies the input image.
+
+    Output - Supplies the output image.
+
+    TileStart - Supplies the index of the first output tile of the block.
+
+    TileCount - Supplies the number of output tiles of the block.
+
+    TransformedInput - Supplies the buffer to receive the transformed input
+        tiles of the block.
+
+    Products - Supplies the buffer to receive the products of the transformed
+        filter and input tiles of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const float Beta = Parameters->Beta;
+    const size_t TilesWidth = WorkBlock->TilesWidth;
+
+    //
+    // Transform the input tiles of the block. The transformed tiles are
+    // stored as 36 matrices of InputChannels rows and TileStride columns.
+    // Four tiles are transformed at a time, so the tile stride is rounded up
+    // to a multiple of four and the padding tiles are ignored.
+    //
+
+    const size_t TileStride = (TileCount + 3) & ~size_t(3);
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+
+        for (size_t t = 0; t < TileStride; t += 4) {
+
+            //
+            // Gather the input tiles with zero padding. Indices that are
+            // before the start of the image wrap around to large values.
+            //
+
+            MLAS_DECLSPEC_ALIGN(float d[MlasWinogradTileElements * 4], 16);
+
+            for (size_t l = 0; l < 4; l++) {
+
+                if (t + l >= TileCount) {
+                    for (size_t e = 0; e < MlasWinogradTileElements; e++) {
+                        d[e * 4 + l] = 0.0f;
+                    }
+                    continue;
+                }
+
+                const size_t TileY = (TileStart + t + l) / TilesWidth;
+                const size_t TileX = (TileStart + t + l) % TilesWidth;
+
+                const size_t OriginY = TileY * MlasWinogradOutputTile - PaddingTop;
+                const size_t OriginX = TileX * MlasWinogradOutputTile - PaddingLeft;
+
+                if (OriginY < InputHeight && InputHeight - OriginY >= MlasWinogradInputTile &&
+                    OriginX < InputWidth && InputWidth - OriginX >= MlasWinogradInputTile) {
+
+                    const float* row = input + OriginY * InputWidth + OriginX;
+
+                    for (size_t i = 0; i < MlasWinogradInputTile; i++) {
+                        for (size_t j = 0; j < MlasWinogradInputTile; j++) {
+                            d[(i * MlasWinogradInputTile + j) * 4 + l] = row[j];
+                        }
+                        row += InputWidth;
+                    }
+
+                } else {
+
+                    for (size_t i = 0; i < MlasWinogradInputTile; i++) {
+
+                        const size_t InputY = OriginY + i;
+
+                        for (size_t j = 0; j < MlasWinogradInputTile; j++) {
+
+                            const size_t InputX = OriginX + j;
+
+                            d[(i * MlasWinogradInputTile + j) * 4 + l] =
+                                (InputY < InputHeight && InputX < InputWidth) ?
+                                input[InputY * InputWidth + InputX] : 0.0f;
+                        }
+                    }
+                }
+            }
+
+            //
+            // Compute B^T * d * B.
+            //
+
+            MLAS_FLOAT32X4 Tiles[MlasWinogradTileElements];
+            MLAS_FLOAT32X4 Temp[MlasWinogradTileElements];
+            MLAS_FLOAT32X4 v[MlasWinogradTileElements];
+
+            for (size_t e = 0; e < MlasWinogradTileElements; e++) {
+                Tiles[e] = MlasLoadFloat32x4(d + e * 4);
+            }
+
+            for (size_t j = 0; j < MlasWinogradInputTile; j++) {
+                MlasWinogradInputTransform1D(Tiles + j, MlasWinogradInputTile, Temp + j, MlasWinogradInputTile);
+            }
+
+            for (size_t i = 0; i < MlasWinogradInputTile; i++) {
+                MlasWinogradInputTransform1D(Temp + i * MlasWinogradInputTile, 1, v + i * MlasWinogradInputTile, 1);
+            }
+
+            float* transformed = TransformedInput + c * TileStride + t;
+
+            for (size_t e = 0; e < MlasWinogradTileElements; e++) {
+                MlasStoreFloat32x4(transformed + e * InputChannels * TileStride, v[e]);
+            }
+        }
+    }
+
+    //
+    // Multiply the transformed filter by the transformed input tiles for
+    // each element of the transformed tile.
+    //
+
+    for (size_t e = 0; e < MlasWinogradTileElements; e++) {
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileCount,
+            InputChannels, 1.0f, WorkBlock->PackedFilter + e * FilterCount * InputChannels,
+            InputChannels, TransformedInput + e * InputChannels * TileStride, TileStride,
+            0.0f, Products + e * FilterCount * TileStride, TileStride, nullptr);
+    }
+
+    //
+    // Transform the products to the output tiles.
+    //
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        float* output = Output + f * OutputSize;
+
+        for (size_t t = 0; t < TileCount; t += 4) {
+
+            //
+            // Compute A^T * m * A.
+            //
+
+            const float* product = Products + f * TileStride + t;
+
+            MLAS_FLOAT32X4 m[MlasWinogradTileElements];
+            MLAS_FLOAT32X4 Temp[MlasWinogradOutputTile * MlasWinogradInputTile];
+            MLAS_FLOAT32X4 Tiles[MlasWinogradOutputTile * MlasWinogradOutputTile];
+
+            for (size_t e = 0; e < MlasWinogradTileElements; e++) {
+                m[e] = MlasLoadFloat32x4(product + e * FilterCount * TileStride);
+            }
+
+            for (size_t j = 0; j < MlasWinogradInputTile; j++) {
+                MlasWinogradOutputTransform1D(m + j, MlasWinogradInputTile, Temp + j, MlasWinogradInputTile);
+            }
+
+            for (size_t i = 0; i < MlasWinogradOutputTile; i++) {
+                MlasWinogradOutputTransform1D(Temp + i * MlasWinogradInputTile, 1,
+                    Tiles + i * MlasWinogradOutputTile, 1);
+            }
+
+            MLAS_DECLSPEC_ALIGN(float y[MlasWinogradOutputTile * MlasWinogradOutputTile * 4], 16);
+
+            for (size_t e = 0; e < MlasWinogradOutputTile * MlasWinogradOutputTile; e++) {
+                MlasStoreFloat32x4(y + e * 4, Tiles[e]);
+            }
+
+            //
+            // Store the output tiles, clipped to the output image.
+            //
+
+            const size_t CountTiles = std::min(size_t(4), TileCount - t);
+
+            for (size_t l = 0; l < CountTiles; l++) {
+
+                const size_t TileY = (TileStart + t + l) / TilesWidth;
+                const size_t TileX = (TileStart + t + l) % TilesWidth;
+
+                const size_t OutputY = TileY * MlasWinogradOutputTile;
+                const size_t OutputX = TileX * MlasWinogradOutputTile;
+                const size_t CountY = std::min(MlasWinogradOutputTile, OutputHeight - OutputY);
+                const size_t CountX = std::min(MlasWinogradOutputTile, OutputWidth - OutputX);
+
+                for (size_t i = 0; i < CountY; i++) {
+
+                    float* row = output + (OutputY + i) * OutputWidth + OutputX;
+                    const float* tile = y + i * MlasWinogradOutputTile * 4 + l;
+
+                    if (Beta == 0.0f) {
+                        for (size_t j = 0; j < CountX; j++) {
+                            row[j] = tile[j * 4];
+                        }
+                    } else {
+                        for (size_t j = 0; j < CountX; j++) {
+                            row[j] = tile[j * 4] + Beta * row[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_CONV_WINOGRAD_WORK_BLOCK* WorkBlock = (MLAS_CONV_WINOGRAD_WORK_BLOCK*)Context;
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t TileBlockCount = WorkBlock->TileBlockCount;
+    const size_t TileCount = WorkBlock->TilesHeight * WorkBlock->TilesWidth;
+
+    float* TransformedInput = WorkBlock->WorkingBuffer + size_t(Index) * MlasWinogradTileElements *
+        MLAS_CONV_WINOGRAD_TILE_BLOCK * (InputChannels + FilterCount);
+    float* Products = TransformedInput + MlasWinogradTileElements * MLAS_CONV_WINOGRAD_TILE_BLOCK * InputChannels;
+
+    //
+    // Partition the tile blocks of all images across the threads.
+    //
+
+    size_t WorkStart;
+    size_t WorkCount;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, Parameters->BatchCount * TileBlockCount,
+        &WorkStart, &WorkCount);
+
+    for (size_t w = WorkStart; w < WorkStart + WorkCount; w++) {
+
+        const size_t batch = w / TileBlockCount;
+        const size_t TileStart = (w % TileBlockCount) * MLAS_CONV_WINOGRAD_TILE_BLOCK;
+        const size_t CountTiles = std::min(size_t(MLAS_CONV_WINOGRAD_TILE_BLOCK), TileCount - TileStart);
+
+        MlasConvWinogradTileBlock(WorkBlock,
+            WorkBlock->Input + batch * InputChannels * Parameters->InputSize,
+            WorkBlock->Output + batch * FilterCount * Parameters->OutputSize,
+            TileStart, CountTiles, TransformedInput, Products);
+    }
+}
+
+void
+MLASCALL
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a 3x3 convolution with the Winograd F(4x4, 3x3)
+    algorithm.
+
+Arguments:
+
+    Parameters - Supplies the structure returned by MlasConvPrepare. The
+        convolution must be supported by MlasConvWinogradIsSupported.
+
+    Input - Supplies the input tensor.
+
+    PackedFilter - Supplies the filter tensor packed by
+        MlasConvWinogradPackFilter.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvWinogradWorkingBufferSize.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.PackedFilter = (const float*)PackedFilter;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.TilesHeight = (Parameters->OutputShape[0] + MlasWinogradOutputTile - 1) / MlasWinogradOutputTile;
+    WorkBlock.TilesWidth = (Parameters->OutputShape[1] + MlasWinogradOutputTile - 1) / MlasWinogradOutputTile;
+    WorkBlock.TileBlockCount = (WorkBlock.TilesHeight * WorkBlock.TilesWidth + MLAS_CONV_WINOGRAD_TILE_BLOCK - 1) /
+        MLAS_CONV_WINOGRAD_TILE_BLOCK;
+    WorkBlock.ThreadCount = MlasConvWinogradThreadCount(Parameters, ThreadPool);
+
+    MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+
+    //
+    // Apply the activation with optional bias.
+    //
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t BatchFilterCount = Parameters->BatchCount * FilterCount;
+
+    MlasTrySimpleParallel(ThreadPool, WorkBlock.ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t RowStart;
+        size_t RowCount;
+
+        MlasPartitionWork(tid, WorkBlock.ThreadCount, BatchFilterCount, &RowStart, &RowCount);
+
+        while (RowCount > 0) {
+
+            const size_t f = RowStart % FilterCount;
+            const size_t CountF = std::min(RowCount, FilterCount - f);
+
+            MlasActivation(Parameters->Activation, Output + RowStart * OutputSize,
+                (Bias != nullptr) ? Bias + f : nullptr, CountF, OutputSize, OutputSize);
+
+            RowStart += CountF;
+            RowCount -= CountF;
+        }
+    });
+}
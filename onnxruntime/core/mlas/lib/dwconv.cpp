@@ -0,0 +1,152 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    dwconv.cpp
+
+Abstract:
+
+    This module implements the single precision depthwise convolution of a
+    channels last (NHWC) input supplied as an indirection buffer, in the same
+    way as the quantized depthwise convolution.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision depthwise convolution.
+
+    Every pointer in the indirection buffer points at a Channels length vector
+    (either from the input tensor or a vector of zeros for the padding). These
+    are grouped in batches of length KernelSize that are processed to produce
+    a single output of length Channels. These batches are then repeated
+    OutputCount times.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    Filter - Supplies the filter tensor in [KernelSize][Channels] format.
+
+    Bias - Supplies the optional bias vector of Channels elements.
+
+    Output - Supplies the output tensor in channels last format.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (OutputCount > 0) {
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 8) {
+
+            MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+
+            if (Bias != nullptr) {
+                Accumulator0 = MlasLoadFloat32x4(&Bias[ChannelOffset]);
+                Accumulator1 = MlasLoadFloat32x4(&Bias[ChannelOffset + 4]);
+            }
+
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+                MLAS_FLOAT32X4 InputVector1 = MlasLoadFloat32x4(&Input[k][ChannelOffset + 4]);
+                MLAS_FLOAT32X4 FilterVector0 = MlasLoadFloat32x4(&Filter[ChannelKernelOffset]);
+                MLAS_FLOAT32X4 FilterVector1 = MlasLoadFloat32x4(&Filter[ChannelKernelOffset + 4]);
+
+                Accumulator0 = MlasMultiplyAddFloat32x4(InputVector0, FilterVector0, Accumulator0);
+                Accumulator1 = MlasMultiplyAddFloat32x4(InputVector1, FilterVector1, Accumulator1);
+
+                ChannelKernelOffset += Channels;
+            }
+
+            MlasStoreFloat32x4(&Output[0], Accumulator0);
+            MlasStoreFloat32x4(&Output[4], Accumulator1);
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
+        if (c >= 4) {
+
+            MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+
+            if (Bias != nullptr) {
+                Accumulator0 = MlasLoadFloat32x4(&Bias[ChannelOffset]);
+            }
+
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+                MLAS_FLOAT32X4 FilterVector0 = MlasLoadFloat32x4(&Filter[ChannelKernelOffset]);
+
+                Accumulator0 = MlasMultiplyAddFloat32x4(InputVector0, FilterVector0, Accumulator0);
+
+                ChannelKernelOffset += Channels;
+            }
+
+            MlasStoreFloat32x4(&Output[0], Accumulator0);
+            Output += 4;
+
+            ChannelOffset += 4;
+            c -= 4;
+        }
+
+        while (c > 0) {
+
+            float Accumulator = (Bias != nullptr) ? Bias[ChannelOffset] : 0.0f;
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                Accumulator += Input[k][ChannelOffset] * Filter[ChannelKernelOffset];
+                ChannelKernelOffset += Channels;
+            }
+
+            *Output++ = Accumulator;
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
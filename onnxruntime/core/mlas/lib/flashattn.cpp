@@ -0,0 +1,382 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    flashattn.cpp
+
+Abstract:
+
+    This module implements a tiled attention operation that streams blocks of
+    keys and values through an online softmax, so that the matrix of attention
+    probabilities is never materialized.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of queries and keys processed by each block. The scores
+// of a block and the keys and values of a block for typical head sizes fit in
+// the L2 cache.
+//
+
+#define MLAS_FLASH_ATTENTION_QUERY_BLOCK 32
+#define MLAS_FLASH_ATTENTION_KV_BLOCK 128
+
+//
+// Define the number of elements of the working buffer used by each thread:
+// the scores of a block followed by the running maximum and sum of each row.
+//
+
+constexpr size_t MlasFlashAttentionThreadBufferSize =
+    MLAS_FLASH_ATTENTION_QUERY_BLOCK * MLAS_FLASH_ATTENTION_KV_BLOCK + 2 * MLAS_FLASH_ATTENTION_QUERY_BLOCK;
+
+struct MLAS_FLASH_ATTENTION_WORK_BLOCK {
+    const MLAS_FLASH_ATTENTION_PARAMS* Params;
+    float* WorkingBuffer;
+    ptrdiff_t ThreadCount;
+    size_t QueryBlockCount;
+};
+
+ptrdiff_t
+MlasFlashAttentionThreadCount(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of threads to execute a tiled attention
+    operation.
+
+Arguments:
+
+    Params - Supplies the parameters of the attention operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns the number of threads.
+
+--*/
+{
+    const size_t QueryBlockCount =
+        (Params->SequenceLength + MLAS_FLASH_ATTENTION_QUERY_BLOCK - 1) / MLAS_FLASH_ATTENTION_QUERY_BLOCK;
+    const size_t WorkCount = Params->BatchCount * Params->HeadCount * QueryBlockCount;
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > WorkCount) {
+        ThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    return (ThreadCount > 0) ? ThreadCount : 1;
+}
+
+size_t
+MLASCALL
+MlasFlashAttentionWorkingBufferSize(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of elements of the working buffer
+    required by MlasFlashAttention.
+
+Arguments:
+
+    Params - Supplies the parameters of the attention operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns the number of elements of the working buffer.
+
+--*/
+{
+    return size_t(MlasFlashAttentionThreadCount(Params, ThreadPool)) * MlasFlashAttentionThreadBufferSize;
+}
+
+void
+MlasFlashAttentionQueryBlock(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    size_t BatchHead,
+    size_t QueryStart,
+    size_t QueryCount,
+    float* Scores,
+    float* RowMaximum,
+    float* RowSum
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the attention output for a block of queries of one
+    head by streaming the keys and values of the head in blocks.
+
+Arguments:
+
+    Params - Supplies the parameters of the attention operation.
+
+    BatchHead - Supplies the index of the batch and head.
+
+    QueryStart - Supplies the index of the first query of the block.
+
+    QueryCount - Supplies the number of queries of the block.
+
+    Scores - Supplies the buffer for the scores of a block.
+
+    RowMaximum - Supplies the buffer for the running maximum of each row.
+
+    RowSum - Supplies the buffer for the running sum of each row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t HeadCount = Params->HeadCount;
+    const size_t SequenceLength = Params->SequenceLength;
+    const size_t KvSequenceLength = Params->KvSequenceLength;
+    const size_t QkHeadSize = Params->QkHeadSize;
+    const size_t VHeadSize = Params->VHeadSize;
+    const size_t CausalOffset = KvSequenceLength - SequenceLength;
+    const size_t Batch = BatchHead / HeadCount;
+    const size_t Head = BatchHead % HeadCount;
+
+    const float* Query = Params->Query + (BatchHead * SequenceLength + QueryStart) * QkHeadSize;
+    const float* Key = Params->Key + BatchHead * KvSequenceLength * QkHeadSize;
+    const float* Value = Params->Value + BatchHead * KvSequenceLength * VHeadSize;
+
+    const size_t ldo = HeadCount * VHeadSize;
+    float* Output = Params->Output + ((Batch * SequenceLength + QueryStart) * HeadCount + Head) * VHeadSize;
+
+    //
+    // The causally masked scores are replaced by the mask value, whose
+    // exponential underflows to zero next to the unmasked scores. Without other
+    // masks, the blocks of keys that are causally masked for every query of the
+    // block can be skipped.
+    //
+
+    size_t KvEnd = KvSequenceLength;
+
+    if (Params->Causal && Params->Mask == nullptr && Params->ExtraAdd == nullptr) {
+        KvEnd = std::min(KvEnd, CausalOffset + QueryStart + QueryCount);
+    }
+
+    for (size_t q = 0; q < QueryCount; q++) {
+        RowMaximum[q] = std::numeric_limits<float>::lowest();
+        RowSum[q] = 0.0f;
+        std::fill_n(Output + q * ldo, VHeadSize, 0.0f);
+    }
+
+    for (size_t KvStart = 0; KvStart < KvEnd; KvStart += MLAS_FLASH_ATTENTION_KV_BLOCK) {
+
+        const size_t KvCount = std::min(size_t(MLAS_FLASH_ATTENTION_KV_BLOCK), KvEnd - KvStart);
+
+        //
+        // Compute the scaled scores of the block: Scores = Scale * Query x Key'.
+        //
+
+        MlasGemm(CblasNoTrans, CblasTrans, QueryCount, KvCount, QkHeadSize, Params->Scale,
+            Query, QkHeadSize, Key + KvStart * QkHeadSize, QkHeadSize, 0.0f, Scores, KvCount, nullptr);
+
+        for (size_t q = 0; q < QueryCount; q++) {
+
+            float* Row = Scores + q * KvCount;
+            const size_t QueryIndex = QueryStart + q;
+
+            //
+            // Apply the masks to the row of scores.
+            //
+
+            if (Params->Causal && CausalOffset + QueryIndex + 1 < KvStart + KvCount) {
+                size_t k = (CausalOffset + QueryIndex + 1 > KvStart) ? CausalOffset + QueryIndex + 1 - KvStart : 0;
+                std::fill(Row + k, Row + KvCount, Params->CausalMaskValue);
+            }
+
+            if (Params->Mask != nullptr) {
+                const float* Mask = Params->Mask + Batch * Params->MaskBatchStride +
+                    QueryIndex * Params->MaskRowStride + KvStart;
+                for (size_t k = 0; k < KvCount; k++) {
+                    Row[k] += Mask[k];
+                }
+            }
+
+            if (Params->ExtraAdd != nullptr) {
+                const float* ExtraAdd = Params->ExtraAdd +
+                    (BatchHead * SequenceLength + QueryIndex) * KvSequenceLength + KvStart;
+                for (size_t k = 0; k < KvCount; k++) {
+                    Row[k] += ExtraAdd[k];
+                }
+            }
+
+            //
+            // Update the running maximum and sum of the row and rescale the
+            // output accumulated from the previous blocks.
+            //
+
+#if defined(MLAS_TARGET_AMD64)
+            float Maximum = GetMlasPlatform().ReduceMaximumF32Kernel(Row, KvCount);
+#else
+            float Maximum = MlasReduceMaximumF32Kernel(Row, KvCount);
+#endif
+
+            Maximum = std::max(Maximum, RowMaximum[q]);
+            float NegativeMaximum = -Maximum;
+
+#if defined(MLAS_TARGET_AMD64)
+            float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(Row, Row, KvCount, &NegativeMaximum);
+#else
+            float Accumulation = MlasComputeSumExpF32Kernel(Row, Row, KvCount, &NegativeMaximum);
+#endif
+
+            if (Maximum != RowMaximum[q]) {
+
+                const float Correction = std::exp(RowMaximum[q] - Maximum);
+                float* OutputRow = Output + q * ldo;
+
+                for (size_t h = 0; h < VHeadSize; h++) {
+                    OutputRow[h] *= Correction;
+                }
+
+                RowSum[q] *= Correction;
+                RowMaximum[q] = Maximum;
+            }
+
+            RowSum[q] += Accumulation;
+        }
+
+        //
+        // Accumulate the output of the block: Output += Scores x Value.
+        //
+
+        MlasGemm(CblasNoTrans, CblasNoTrans, QueryCount, VHeadSize, KvCount, 1.0f,
+            Scores, KvCount, Value + KvStart * VHeadSize, VHeadSize, 1.0f, Output, ldo, nullptr);
+    }
+
+    //
+    // Normalize the output by the sum of each row.
+    //
+
+    for (size_t q = 0; q < QueryCount; q++) {
+
+        const float Scale = 1.0f / RowSum[q];
+        float* OutputRow = Output + q * ldo;
+
+        for (size_t h = 0; h < VHeadSize; h++) {
+            OutputRow[h] *= Scale;
+        }
+    }
+}
+
+void
+MlasFlashAttentionThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    tiled attention operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_FLASH_ATTENTION_WORK_BLOCK*)Context;
+    const MLAS_FLASH_ATTENTION_PARAMS* Params = WorkBlock->Params;
+
+    const size_t QueryBlockCount = WorkBlock->QueryBlockCount;
+    const size_t WorkCount = Params->BatchCount * Params->HeadCount * QueryBlockCount;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+    float* Scores = WorkBlock->WorkingBuffer + Index * MlasFlashAttentionThreadBufferSize;
+    float* RowMaximum = Scores + MLAS_FLASH_ATTENTION_QUERY_BLOCK * MLAS_FLASH_ATTENTION_KV_BLOCK;
+    float* RowSum = RowMaximum + MLAS_FLASH_ATTENTION_QUERY_BLOCK;
+
+    while (WorkRemaining > 0) {
+
+        const size_t BatchHead = WorkIndex / QueryBlockCount;
+        const size_t QueryStart = (WorkIndex % QueryBlockCount) * MLAS_FLASH_ATTENTION_QUERY_BLOCK;
+        const size_t QueryCount =
+            std::min(size_t(MLAS_FLASH_ATTENTION_QUERY_BLOCK), Params->SequenceLength - QueryStart);
+
+        MlasFlashAttentionQueryBlock(Params, BatchHead, QueryStart, QueryCount, Scores, RowMaximum, RowSum);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    float* WorkingBuffer,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the tiled attention operation described by
+    MLAS_FLASH_ATTENTION_PARAMS.
+
+Arguments:
+
+    Params - Supplies the parameters of the attention operation.
+
+    WorkingBuffer - Supplies a working buffer of the number of elements
+        returned by MlasFlashAttentionWorkingBufferSize.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Params->SequenceLength == 0 || Params->KvSequenceLength == 0) {
+        return;
+    }
+
+    MLAS_FLASH_ATTENTION_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Params = Params;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.ThreadCount = MlasFlashAttentionThreadCount(Params, ThreadPool);
+    WorkBlock.QueryBlockCount =
+        (Params->SequenceLength + MLAS_FLASH_ATTENTION_QUERY_BLOCK - 1) / MLAS_FLASH_ATTENTION_QUERY_BLOCK;
+
+    MlasExecuteThreaded(MlasFlashAttentionThreaded, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+}
@@ -0,0 +1,188 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm.h
+
+Abstract:
+
+    This module defines the kernel interface and the dispatch structure of the
+    half precision matrix/matrix multiply operation (HGEMM).
+
+    Matrix B is packed into panels of MLAS_HGEMM_PACKED_N columns. Each panel
+    stores its rows contiguously, and columns past the end of the matrix are
+    zero filled, so kernels can always load full panel rows.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+//
+// Define the number of columns in a panel of packed matrix B.
+//
+
+#define MLAS_HGEMM_PACKED_N                         32
+
+//
+// Define the default striding parameters used for the half precision
+// matrix/matrix multiply operation when matrix B is packed on the fly.
+//
+
+#define MLAS_HGEMM_STRIDEN                          128
+#define MLAS_HGEMM_STRIDEK                          128
+
+//
+// Define the target number of per-thread multiplies before using another
+// thread to perform additional work.
+//
+
+#define MLAS_HGEMM_THREAD_COMPLEXITY                (64 * 1024)
+
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    PackedB - Supplies the address of the first panel of packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns of matrix A and the number of rows
+        of the packed panels.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix C.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    PanelStride - Supplies the number of elements between consecutive panels
+        of packed matrix B.
+
+    Bias - Supplies the optional bias vector of CountN elements, only used in
+        zero mode.
+
+    ZeroMode - Supplies true if the output matrix must be overwritten, else
+        the result is accumulated into matrix C.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+
+typedef
+size_t
+(MLASCALL MLAS_HGEMM_KERNEL)(
+    const MLAS_FP16* A,
+    const MLAS_FP16* PackedB,
+    MLAS_FP16* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    size_t PanelStride,
+    const MLAS_FP16* Bias,
+    bool ZeroMode
+    );
+
+struct MLAS_HGEMM_DISPATCH {
+    MLAS_HGEMM_KERNEL* Kernel;
+};
+
+extern const MLAS_HGEMM_DISPATCH MlasHalfGemmDispatchDefault;
+extern const MLAS_HGEMM_DISPATCH MlasHalfGemmDispatchNeon;
+extern const MLAS_HGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16;
+
+//
+// Conversions between half and single precision for kernels without native
+// half precision arithmetic. Rounding is to nearest even.
+//
+
+MLAS_FORCEINLINE
+float
+MlasFp16ToFloat(
+    MLAS_FP16 Value
+    )
+{
+    constexpr uint32_t ShiftedExponent = 0x7C00u << 13;
+
+    uint32_t Bits = (uint32_t(Value) & 0x7FFFu) << 13;
+    const uint32_t Exponent = Bits & ShiftedExponent;
+    Bits += (127u - 15u) << 23;
+
+    if (Exponent == ShiftedExponent) {
+        // Inf or NaN.
+        Bits += (128u - 16u) << 23;
+    } else if (Exponent == 0) {
+        // Zero or subnormal, renormalize.
+        Bits += 1u << 23;
+        Bits = MlasBitsOfFp32(MlasFp32FromBits(Bits) - MlasFp32FromBits(113u << 23));
+    }
+
+    return MlasFp32FromBits(Bits | ((uint32_t(Value) & 0x8000u) << 16));
+}
+
+MLAS_FORCEINLINE
+MLAS_FP16
+MlasFloatToFp16(
+    float Value
+    )
+{
+    constexpr uint32_t Fp32Infinity = 255u << 23;
+    constexpr uint32_t Fp16Maximum = (127u + 16u) << 23;
+    constexpr uint32_t DenormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    uint32_t Bits = MlasBitsOfFp32(Value);
+    const uint32_t Sign = Bits & 0x80000000u;
+    Bits ^= Sign;
+
+    uint32_t Result;
+
+    if (Bits >= Fp16Maximum) {
+        // Overflow to Inf, or NaN.
+        Result = (Bits > Fp32Infinity) ? 0x7E00u : 0x7C00u;
+    } else if (Bits < (113u << 23)) {
+        // Subnormal or zero, let the floating point addition do the rounding.
+        Result = MlasBitsOfFp32(MlasFp32FromBits(Bits) + MlasFp32FromBits(DenormalMagic)) - DenormalMagic;
+    } else {
+        const uint32_t MantissaOdd = (Bits >> 13) & 1u;
+        Bits += ((15u - 127u) << 23) + 0xFFFu;
+        Bits += MantissaOdd;
+        Result = Bits >> 13;
+    }
+
+    return MLAS_FP16(Result | (Sign >> 16));
+}
+
+//
+// Packs CountK rows of CountN columns of matrix B into panels of
+// MLAS_HGEMM_PACKED_N columns, each panel being CountK rows long.
+//
+
+void
+MlasHalfGemmCopyPackB(
+    MLAS_FP16* D,
+    const MLAS_FP16* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    bool TransB
+    );
@@ -0,0 +1,214 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_neon.cpp
+
+Abstract:
+
+    This module implements the half precision matrix/matrix multiply kernel
+    for ARM64 processors with the half precision vector arithmetic extension
+    (ARMv8.2-A FP16).
+
+    This file must be compiled with the FP16 extension enabled, for example
+    -march=armv8.2-a+fp16.
+
+--*/
+
+#include "halfgemm.h"
+
+#include <arm_neon.h>
+
+#include <cstring>
+
+//
+// Define the number of 128-bit vectors in a row of a packed panel.
+//
+
+constexpr size_t MlasHalfGemmVectorsPerPanelNeon = MLAS_HGEMM_PACKED_N / 8;
+
+MLAS_FORCEINLINE
+void
+MlasHalfGemmLoadPanelRowNeon(
+    const MLAS_FP16* Source,
+    size_t CountN,
+    float16x8_t Row[MlasHalfGemmVectorsPerPanelNeon]
+    )
+{
+    MLAS_FP16 Buffer[MLAS_HGEMM_PACKED_N];
+
+    if (CountN < MLAS_HGEMM_PACKED_N) {
+        std::memcpy(Buffer, Source, CountN * sizeof(MLAS_FP16));
+        std::memset(Buffer + CountN, 0, (MLAS_HGEMM_PACKED_N - CountN) * sizeof(MLAS_FP16));
+        Source = Buffer;
+    }
+
+    const float16_t* s = reinterpret_cast<const float16_t*>(Source);
+
+    for (size_t i = 0; i < MlasHalfGemmVectorsPerPanelNeon; i++) {
+        Row[i] = vld1q_f16(s + i * 8);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasHalfGemmStorePanelRowNeon(
+    MLAS_FP16* Destination,
+    size_t CountN,
+    const float16x8_t Row[MlasHalfGemmVectorsPerPanelNeon]
+    )
+{
+    if (CountN == MLAS_HGEMM_PACKED_N) {
+        float16_t* d = reinterpret_cast<float16_t*>(Destination);
+        for (size_t i = 0; i < MlasHalfGemmVectorsPerPanelNeon; i++) {
+            vst1q_f16(d + i * 8, Row[i]);
+        }
+        return;
+    }
+
+    MLAS_FP16 Buffer[MLAS_HGEMM_PACKED_N];
+    float16_t* b = reinterpret_cast<float16_t*>(Buffer);
+
+    for (size_t i = 0; i < MlasHalfGemmVectorsPerPanelNeon; i++) {
+        vst1q_f16(b + i * 8, Row[i]);
+    }
+
+    std::memcpy(Destination, Buffer, CountN * sizeof(MLAS_FP16));
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmPanelNeon(
+    const MLAS_FP16* A,
+    const MLAS_FP16* PanelB,
+    MLAS_FP16* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    const MLAS_FP16* Bias,
+    bool ZeroMode
+    )
+{
+    float16x8_t Accumulators[RowCount][MlasHalfGemmVectorsPerPanelNeon];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t i = 0; i < MlasHalfGemmVectorsPerPanelNeon; i++) {
+            Accumulators[r][i] = vdupq_n_f16(0);
+        }
+    }
+
+    const float16_t* a = reinterpret_cast<const float16_t*>(A);
+    const float16_t* b = reinterpret_cast<const float16_t*>(PanelB);
+
+    for (size_t k = 0; k < CountK; k++) {
+
+        float16x8_t RowB[MlasHalfGemmVectorsPerPanelNeon];
+
+        for (size_t i = 0; i < MlasHalfGemmVectorsPerPanelNeon; i++) {
+            RowB[i] = vld1q_f16(b + i * 8);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const float16x8_t ElementA = vld1q_dup_f16(a + r * lda + k);
+            for (size_t i = 0; i < MlasHalfGemmVectorsPerPanelNeon; i++) {
+                Accumulators[r][i] = vfmaq_f16(Accumulators[r][i], RowB[i], ElementA);
+            }
+        }
+
+        b += MLAS_HGEMM_PACKED_N;
+    }
+
+    float16x8_t RowBias[MlasHalfGemmVectorsPerPanelNeon];
+
+    if (ZeroMode && Bias != nullptr) {
+        MlasHalfGemmLoadPanelRowNeon(Bias, CountN, RowBias);
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        MLAS_FP16* c = C + r * ldc;
+
+        if (!ZeroMode) {
+            float16x8_t RowC[MlasHalfGemmVectorsPerPanelNeon];
+            MlasHalfGemmLoadPanelRowNeon(c, CountN, RowC);
+            for (size_t i = 0; i < MlasHalfGemmVectorsPerPanelNeon; i++) {
+                Accumulators[r][i] = vaddq_f16(Accumulators[r][i], RowC[i]);
+            }
+        } else if (Bias != nullptr) {
+            for (size_t i = 0; i < MlasHalfGemmVectorsPerPanelNeon; i++) {
+                Accumulators[r][i] = vaddq_f16(Accumulators[r][i], RowBias[i]);
+            }
+        }
+
+        MlasHalfGemmStorePanelRowNeon(c, CountN, Accumulators[r]);
+    }
+}
+
+size_t
+MLASCALL
+MlasHalfGemmKernelNeon(
+    const MLAS_FP16* A,
+    const MLAS_FP16* PackedB,
+    MLAS_FP16* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    size_t PanelStride,
+    const MLAS_FP16* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 4 rows of matrix C, accumulating in half
+    precision with four 128-bit vectors per row of a panel.
+
+Arguments:
+
+    See MLAS_HGEMM_KERNEL.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t RowCount = std::min(CountM, size_t(4));
+
+    for (size_t n = 0; n < CountN; n += MLAS_HGEMM_PACKED_N) {
+
+        const size_t CountNPanel = std::min(CountN - n, size_t(MLAS_HGEMM_PACKED_N));
+        const MLAS_FP16* PanelB = PackedB + (n / MLAS_HGEMM_PACKED_N) * PanelStride;
+        const MLAS_FP16* PanelBias = (Bias != nullptr) ? Bias + n : nullptr;
+
+        switch (RowCount) {
+            case 4:
+                MlasHalfGemmPanelNeon<4>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 3:
+                MlasHalfGemmPanelNeon<3>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 2:
+                MlasHalfGemmPanelNeon<2>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            default:
+                MlasHalfGemmPanelNeon<1>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+        }
+    }
+
+    return RowCount;
+}
+
+const MLAS_HGEMM_DISPATCH MlasHalfGemmDispatchNeon = {
+    MlasHalfGemmKernelNeon,
+};
@@ -0,0 +1,95 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernels to convert buffers between half and
+    single precision with the F16C instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasCastF16ToF32KernelAvx2(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m128i HalfVector0 = _mm_loadu_si128((const __m128i*)Source);
+        __m128i HalfVector1 = _mm_loadu_si128((const __m128i*)(Source + 8));
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(HalfVector0));
+        _mm256_storeu_ps(Destination + 8, _mm256_cvtph_ps(HalfVector1));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    while (Count >= 8) {
+
+        __m128i HalfVector = _mm_loadu_si128((const __m128i*)Source);
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(HalfVector));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(*Source++)));
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16KernelAvx2(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m256 FloatVector0 = _mm256_loadu_ps(Source);
+        __m256 FloatVector1 = _mm256_loadu_ps(Source + 8);
+
+        _mm_storeu_si128((__m128i*)Destination, _mm256_cvtps_ph(FloatVector0, _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128((__m128i*)(Destination + 8), _mm256_cvtps_ph(FloatVector1, _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    while (Count >= 8) {
+
+        __m256 FloatVector = _mm256_loadu_ps(Source);
+        _mm_storeu_si128((__m128i*)Destination, _mm256_cvtps_ph(FloatVector, _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+
+        __m128i HalfVector = _mm_cvtps_ph(_mm_set_ss(*Source++), _MM_FROUND_TO_NEAREST_INT);
+        *Destination++ = static_cast<unsigned short>(_mm_cvtsi128_si32(HalfVector));
+        Count -= 1;
+    }
+}
@@ -0,0 +1,299 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernels for the matrix/matrix multiply
+    operation with block-wise 4-bit quantized matrix B (Q4GEMM) using AVX2
+    and FMA3 intrinsics.
+
+    The quantized elements of a chunk are expanded to 32-bit integers,
+    converted and scaled in registers, so matrix B is read from memory in its
+    4-bit form only.
+
+--*/
+
+#include "../../q4gemm.h"
+
+//
+// Dequantizes a chunk of MLAS_Q4GEMM_CHUNK_K elements of a column of matrix B
+// to four vectors: (q - ZeroPoint) * Scale = q * Scale + Offset.
+//
+
+MLAS_FORCEINLINE
+void
+MlasQ4GemmDequantizeChunkAvx2(
+    const uint8_t* Data,
+    __m256 Scale,
+    __m256 Offset,
+    __m256 ElementsB[4]
+    )
+{
+    const __m128i LowMask = _mm_set1_epi8(0x0F);
+    const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data));
+
+    const __m128i Low = _mm_and_si128(Bytes, LowMask);
+    const __m128i High = _mm_and_si128(_mm_srli_epi16(Bytes, 4), LowMask);
+
+    const __m128i Elements0 = _mm_unpacklo_epi8(Low, High);
+    const __m128i Elements1 = _mm_unpackhi_epi8(Low, High);
+
+    ElementsB[0] = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(Elements0));
+    ElementsB[1] = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(Elements0, 8)));
+    ElementsB[2] = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(Elements1));
+    ElementsB[3] = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(Elements1, 8)));
+
+    for (size_t i = 0; i < 4; i++) {
+        ElementsB[i] = _mm256_fmadd_ps(ElementsB[i], Scale, Offset);
+    }
+}
+
+//
+// Loads a vector of matrix A, zero filling the elements beyond the end of the
+// row so that garbage never reaches the accumulators.
+//
+
+MLAS_FORCEINLINE
+__m256
+MlasQ4GemmLoadAAvx2(
+    const float* A,
+    ptrdiff_t Remaining
+    )
+{
+    if (Remaining >= 8) {
+        return _mm256_loadu_ps(A);
+    }
+
+    if (Remaining <= 0) {
+        return _mm256_setzero_ps();
+    }
+
+    const __m256i Mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(int(Remaining)),
+                                            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+    return _mm256_maskload_ps(A, Mask);
+}
+
+MLAS_FORCEINLINE
+float
+MlasQ4GemmReduceAddAvx2(
+    __m256 Vector
+    )
+{
+    __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+    Sum = _mm_add_ss(Sum, _mm_movehdup_ps(Sum));
+
+    return _mm_cvtss_f32(Sum);
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmRowsAvx2(
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    const size_t BlockCountK = MlasQ4GemmBlockCountK(CountK, BlkLen);
+    const size_t ZeroPointBytes = MlasQ4GemmZeroPointBytesPerColumn(BlockCountK);
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        const uint8_t* Data = QuantBData + n * BlockCountK * (BlkLen / 2);
+        const float* Scale = QuantBScale + n * BlockCountK;
+        const uint8_t* ZeroPoint = (QuantBZeroPoint != nullptr) ? QuantBZeroPoint + n * ZeroPointBytes : nullptr;
+
+        //
+        // Use two accumulators per row to hide the latency of the FMA chain.
+        //
+
+        __m256 Accumulators[RowCount][2];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][0] = _mm256_setzero_ps();
+            Accumulators[r][1] = _mm256_setzero_ps();
+        }
+
+        for (size_t b = 0; b < BlockCountK; b++) {
+
+            const __m256 BlockScale = _mm256_broadcast_ss(Scale + b);
+            const __m256 BlockOffset = _mm256_mul_ps(BlockScale,
+                _mm256_set1_ps(-float(MlasQ4GemmZeroPoint(ZeroPoint, b))));
+
+            const size_t k = b * BlkLen;
+            const size_t CountKBlock = std::min(CountK - k, BlkLen);
+
+            for (size_t kk = 0; kk < CountKBlock; kk += MLAS_Q4GEMM_CHUNK_K) {
+
+                __m256 ElementsB[4];
+
+                MlasQ4GemmDequantizeChunkAvx2(Data + kk / 2, BlockScale, BlockOffset, ElementsB);
+
+                const float* a = A + k + kk;
+                const ptrdiff_t Remaining = ptrdiff_t(CountK - (k + kk));
+
+                if (Remaining >= ptrdiff_t(MLAS_Q4GEMM_CHUNK_K)) {
+                    for (size_t r = 0; r < RowCount; r++) {
+                        for (size_t i = 0; i < 4; i++) {
+                            Accumulators[r][i & 1] = _mm256_fmadd_ps(_mm256_loadu_ps(a + r * lda + i * 8),
+                                                                     ElementsB[i], Accumulators[r][i & 1]);
+                        }
+                    }
+                } else {
+                    for (size_t r = 0; r < RowCount; r++) {
+                        for (size_t i = 0; i < 4; i++) {
+                            const __m256 ElementsA = MlasQ4GemmLoadAAvx2(a + r * lda + i * 8, Remaining - ptrdiff_t(i * 8));
+                            Accumulators[r][i & 1] = _mm256_fmadd_ps(ElementsA, ElementsB[i], Accumulators[r][i & 1]);
+                        }
+                    }
+                }
+            }
+
+            Data += BlkLen / 2;
+        }
+
+        const float BiasValue = (Bias != nullptr) ? Bias[n] : 0.0f;
+
+        for (size_t r = 0; r < RowCount; r++) {
+            C[r * ldc + n] = MlasQ4GemmReduceAddAvx2(_mm256_add_ps(Accumulators[r][0], Accumulators[r][1])) + BiasValue;
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasQ4GemmKernelAvx2(
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 4 rows of matrix C, decoding each chunk of
+    matrix B once for all of the rows.
+
+Arguments:
+
+    See MLAS_Q4GEMM_KERNEL.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t RowCount = std::min(CountM, size_t(4));
+
+    switch (RowCount) {
+        case 4:
+            MlasQ4GemmRowsAvx2<4>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, lda, ldc, Bias);
+            break;
+        case 3:
+            MlasQ4GemmRowsAvx2<3>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, lda, ldc, Bias);
+            break;
+        case 2:
+            MlasQ4GemmRowsAvx2<2>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, lda, ldc, Bias);
+            break;
+        default:
+            MlasQ4GemmRowsAvx2<1>(BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, lda, ldc, Bias);
+            break;
+    }
+
+    return RowCount;
+}
+
+void
+MLASCALL
+MlasQ4GemmDequantizeKernelAvx2(
+    size_t BlkLen,
+    float* D,
+    size_t ldd,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t StartBlock,
+    size_t CountN,
+    size_t CountBlocks,
+    size_t BlockCountK
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes whole blocks of a set of columns of matrix B.
+
+Arguments:
+
+    See MLAS_Q4GEMM_DEQUANTIZE_KERNEL.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t ZeroPointBytes = MlasQ4GemmZeroPointBytesPerColumn(BlockCountK);
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        const uint8_t* Data = QuantBData + (n * BlockCountK + StartBlock) * (BlkLen / 2);
+        const float* Scale = QuantBScale + n * BlockCountK;
+        const uint8_t* ZeroPoint = (QuantBZeroPoint != nullptr) ? QuantBZeroPoint + n * ZeroPointBytes : nullptr;
+
+        float* d = D + n * ldd;
+
+        for (size_t b = StartBlock; b < StartBlock + CountBlocks; b++) {
+
+            const __m256 BlockScale = _mm256_broadcast_ss(Scale + b);
+            const __m256 BlockOffset = _mm256_mul_ps(BlockScale,
+                _mm256_set1_ps(-float(MlasQ4GemmZeroPoint(ZeroPoint, b))));
+
+            for (size_t kk = 0; kk < BlkLen; kk += MLAS_Q4GEMM_CHUNK_K) {
+
+                __m256 ElementsB[4];
+
+                MlasQ4GemmDequantizeChunkAvx2(Data + kk / 2, BlockScale, BlockOffset, ElementsB);
+
+                for (size_t i = 0; i < 4; i++) {
+                    _mm256_storeu_ps(d + kk + i * 8, ElementsB[i]);
+                }
+            }
+
+            Data += BlkLen / 2;
+            d += BlkLen;
+        }
+    }
+}
+
+const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchAvx2 = {
+    MlasQ4GemmKernelAvx2,
+    MlasQ4GemmDequantizeKernelAvx2,
+};
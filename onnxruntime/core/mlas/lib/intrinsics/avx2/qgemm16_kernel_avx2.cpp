@@ -0,0 +1,140 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm16_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel of the matrix/matrix multiply operation
+    of 16-bit quantized activations by 8-bit quantized weights.
+
+    This implementation uses AVX2 instructions.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+void
+MlasGemmS16S8StoreVectorAvx2(
+    __m256i Accumulator,
+    int32_t* C,
+    size_t CountN,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    )
+{
+    if (CountN >= 8) {
+        const __m256i Addend = ZeroMode ? _mm256_loadu_si256((const __m256i*)ColumnSumBuffer) :
+                                          _mm256_loadu_si256((const __m256i*)C);
+        _mm256_storeu_si256((__m256i*)C, _mm256_add_epi32(Accumulator, Addend));
+        return;
+    }
+
+    MLAS_DECLSPEC_ALIGN(int32_t Row[8], 32);
+    _mm256_store_si256((__m256i*)Row, Accumulator);
+
+    for (size_t n = 0; n < CountN; n++) {
+        C[n] = Row[n] + (ZeroMode ? ColumnSumBuffer[n] : C[n]);
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasGemmS16S8ComputeBlockAvx2(
+    const int16_t* A,
+    size_t lda,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    )
+{
+    __m256i Accumulators[RowCount][2];
+
+    for (size_t m = 0; m < RowCount; m++) {
+        Accumulators[m][0] = _mm256_setzero_si256();
+        Accumulators[m][1] = _mm256_setzero_si256();
+    }
+
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        //
+        // Each 32-bit lane of B holds a pair of rows of a column, which
+        // vpmaddwd multiplies by the pair of elements of the row of A.
+        //
+
+        const __m256i BElements0 = _mm256_load_si256((const __m256i*)&PackedB[0]);
+        const __m256i BElements1 = _mm256_load_si256((const __m256i*)&PackedB[16]);
+
+        for (size_t m = 0; m < RowCount; m++) {
+            const __m256i APair = _mm256_set1_epi32(MlasGemmS16S8LoadPairA(&A[m * lda + k], CountK - k));
+            Accumulators[m][0] = _mm256_add_epi32(Accumulators[m][0], _mm256_madd_epi16(APair, BElements0));
+            Accumulators[m][1] = _mm256_add_epi32(Accumulators[m][1], _mm256_madd_epi16(APair, BElements1));
+        }
+
+        PackedB += MLAS_GEMM_S16S8_STRIDEN * 2;
+    }
+
+    for (size_t m = 0; m < RowCount; m++) {
+        int32_t* c = C + m * ldc;
+        MlasGemmS16S8StoreVectorAvx2(Accumulators[m][0], c, CountN, ColumnSumBuffer, ZeroMode);
+        if (CountN > 8) {
+            MlasGemmS16S8StoreVectorAvx2(Accumulators[m][1], c + 8, CountN - 8, ColumnSumBuffer + 8, ZeroMode);
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasGemmS16S8KernelAvx2(
+    const int16_t* A,
+    size_t lda,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the AVX2 kernel of the int16 by int8 matrix/matrix
+    multiply operation, which processes up to four rows of A.
+
+Arguments:
+
+    See MlasGemmS16S8Kernel.
+
+Return Value:
+
+    Returns the number of rows processed.
+
+--*/
+{
+    if (CountM >= 4) {
+        MlasGemmS16S8ComputeBlockAvx2<4>(A, lda, PackedB, C, ldc, CountN, CountK, ColumnSumBuffer, ZeroMode);
+        return 4;
+    }
+
+    if (CountM >= 2) {
+        MlasGemmS16S8ComputeBlockAvx2<2>(A, lda, PackedB, C, ldc, CountN, CountK, ColumnSumBuffer, ZeroMode);
+        return 2;
+    }
+
+    MlasGemmS16S8ComputeBlockAvx2<1>(A, lda, PackedB, C, ldc, CountN, CountK, ColumnSumBuffer, ZeroMode);
+    return 1;
+}
@@ -0,0 +1,152 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements the half precision matrix/matrix multiply kernel
+    with AVX512-FP16 instructions.
+
+    This file must be compiled with -mavx512fp16.
+
+--*/
+
+#include "halfgemm.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmPanelAvx512Fp16(
+    const MLAS_FP16* A,
+    const MLAS_FP16* PanelB,
+    MLAS_FP16* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    const MLAS_FP16* Bias,
+    bool ZeroMode
+    )
+{
+    __m512h Accumulators[RowCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r] = _mm512_setzero_ph();
+    }
+
+    for (size_t k = 0; k < CountK; k++) {
+
+        const __m512h RowB = _mm512_loadu_ph(PanelB);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512h ElementA = _mm512_castsi512_ph(_mm512_set1_epi16(short(A[r * lda + k])));
+            Accumulators[r] = _mm512_fmadd_ph(ElementA, RowB, Accumulators[r]);
+        }
+
+        PanelB += MLAS_HGEMM_PACKED_N;
+    }
+
+    const __mmask32 Mask = (CountN == MLAS_HGEMM_PACKED_N) ? __mmask32(0xFFFFFFFF) :
+                                                             __mmask32((uint32_t(1) << CountN) - 1);
+
+    __m512h RowBias = _mm512_setzero_ph();
+
+    if (ZeroMode && Bias != nullptr) {
+        RowBias = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, Bias));
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        MLAS_FP16* c = C + r * ldc;
+
+        if (!ZeroMode) {
+            Accumulators[r] = _mm512_add_ph(Accumulators[r],
+                                            _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, c)));
+        } else if (Bias != nullptr) {
+            Accumulators[r] = _mm512_add_ph(Accumulators[r], RowBias);
+        }
+
+        _mm512_mask_storeu_epi16(c, Mask, _mm512_castph_si512(Accumulators[r]));
+    }
+}
+
+size_t
+MLASCALL
+MlasHalfGemmKernelAvx512Fp16(
+    const MLAS_FP16* A,
+    const MLAS_FP16* PackedB,
+    MLAS_FP16* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    size_t PanelStride,
+    const MLAS_FP16* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 8 rows of matrix C, accumulating in half
+    precision with one 512-bit vector per row of a panel.
+
+Arguments:
+
+    See MLAS_HGEMM_KERNEL.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t RowCount = std::min(CountM, size_t(8));
+
+    for (size_t n = 0; n < CountN; n += MLAS_HGEMM_PACKED_N) {
+
+        const size_t CountNPanel = std::min(CountN - n, size_t(MLAS_HGEMM_PACKED_N));
+        const MLAS_FP16* PanelB = PackedB + (n / MLAS_HGEMM_PACKED_N) * PanelStride;
+        const MLAS_FP16* PanelBias = (Bias != nullptr) ? Bias + n : nullptr;
+
+        switch (RowCount) {
+            case 8:
+                MlasHalfGemmPanelAvx512Fp16<8>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 7:
+                MlasHalfGemmPanelAvx512Fp16<7>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 6:
+                MlasHalfGemmPanelAvx512Fp16<6>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 5:
+                MlasHalfGemmPanelAvx512Fp16<5>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 4:
+                MlasHalfGemmPanelAvx512Fp16<4>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 3:
+                MlasHalfGemmPanelAvx512Fp16<3>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 2:
+                MlasHalfGemmPanelAvx512Fp16<2>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            default:
+                MlasHalfGemmPanelAvx512Fp16<1>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+        }
+    }
+
+    return RowCount;
+}
+
+const MLAS_HGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16 = {
+    MlasHalfGemmKernelAvx512Fp16,
+};
@@ -0,0 +1,471 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements QGEMM kernels for AMX-INT8.
+
+    Matrix A and matrix B are packed with the AVX2 U8S8 routines. A packed
+    row of matrix A holds the columns in groups of four bytes and a panel of
+    16 columns of packed matrix B holds the rows in groups of four bytes per
+    column, which is the operand layout of the tdpbusd instruction. Packed
+    buffers are shared with the AVX2 and AVX512VNNI kernels, so a matrix B
+    packed by MlasGemmPackB can be consumed by any of them.
+
+    The kernel multiplies blocks of 32 or 16 rows of matrix A with AMX tiles.
+    Partial blocks of rows are handed to the AVX512VNNI kernel.
+
+    This file must be compiled with -mavx512f -mamx-tile -mamx-int8.
+
+--*/
+
+#include "mlasi.h"
+#include "qgemm.h"
+
+#include <cstring>
+
+//
+// Define the prototypes of the AVX2 routines written in assembly.
+//
+
+extern "C" {
+
+    void
+    MLASCALL
+    MlasGemmU8S8CopyPackAAvx2(
+        uint8_t* D,
+        const uint8_t* A,
+        size_t lda,
+        size_t CountM,
+        size_t CountK,
+        int32_t* RowSumBuffer
+        );
+
+    void
+    MLASCALL
+    MlasGemmU8S8CopyPackBAvx2(
+        uint8_t* D,
+        const uint8_t* B,
+        size_t ldb,
+        size_t CountN,
+        size_t CountK,
+        int32_t* ColumnSumBuffer,
+        bool BIsSigned
+        );
+}
+
+struct MLAS_GEMM_U8S8_KERNEL_AMX
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef uint8_t OffsetAType;
+    typedef int8_t OffsetBType;
+
+    static constexpr size_t PackedK = 4;
+    static constexpr MLAS_GEMM_QUANT_STRIDES Strides{ 64, 256, 256 };
+    static constexpr MLAS_GEMM_QUANT_STRIDES PackedStrides{ 64, 256, 384 };
+};
+
+constexpr size_t MLAS_GEMM_U8S8_KERNEL_AMX::PackedK;
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_U8S8_KERNEL_AMX::Strides;
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_U8S8_KERNEL_AMX::PackedStrides;
+
+//
+// Define the shape of a tile. A tile row is 64 bytes, which is 16 groups of
+// four bytes of matrix A or the four bytes of 16 columns of matrix B.
+//
+
+constexpr size_t MlasQgemmAmxRows = 16;
+constexpr size_t MlasQgemmAmxStrideBytes = 64;
+constexpr size_t MlasQgemmAmxTileBytes = MlasQgemmAmxRows * MlasQgemmAmxStrideBytes;
+constexpr size_t MlasQgemmAmxPackedCountK = MlasQgemmAmxStrideBytes / MLAS_GEMM_U8S8_KERNEL_AMX::PackedK;
+
+//
+// Define the tile registers used by the kernel. A block of up to 32 rows and
+// 32 columns of matrix C is accumulated in four tiles, so that each tile of
+// matrix A and matrix B is used by two tile multiplies.
+//
+
+#define MLAS_QGEMM_AMX_TILE_C00                     0
+#define MLAS_QGEMM_AMX_TILE_C01                     1
+#define MLAS_QGEMM_AMX_TILE_C10                     2
+#define MLAS_QGEMM_AMX_TILE_C11                     3
+#define MLAS_QGEMM_AMX_TILE_A0                      4
+#define MLAS_QGEMM_AMX_TILE_A1                      5
+#define MLAS_QGEMM_AMX_TILE_B0                      6
+#define MLAS_QGEMM_AMX_TILE_B1                      7
+
+struct MLAS_QGEMM_AMX_TILE_CONFIG {
+    uint8_t PaletteId;
+    uint8_t StartRow;
+    uint8_t Reserved[14];
+    uint16_t ColumnBytes[16];
+    uint8_t Rows[16];
+};
+
+static_assert(sizeof(MLAS_QGEMM_AMX_TILE_CONFIG) == 64, "AMX tile configuration must be 64 bytes");
+
+MLAS_FORCEINLINE
+void
+MlasQgemmLoadTileConfigAmx(
+    void
+    )
+{
+    MLAS_QGEMM_AMX_TILE_CONFIG Config = {};
+
+    Config.PaletteId = 1;
+
+    for (size_t t = 0; t < 8; t++) {
+        Config.ColumnBytes[t] = MlasQgemmAmxStrideBytes;
+        Config.Rows[t] = uint8_t(MlasQgemmAmxRows);
+    }
+
+    _tile_loadconfig(&Config);
+}
+
+MLAS_FORCEINLINE
+void
+MlasQgemmStorePanelAmx(
+    const int32_t* BufferC,
+    int32_t* C,
+    size_t ldc,
+    size_t CountN,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the row and column sums to a panel of 16 columns of
+    accumulators, optionally scaling the row sums by the zero point of each
+    column of matrix B, and stores the panel to matrix C.
+
+--*/
+{
+    const __mmask16 Mask = __mmask16((uint32_t(1) << CountN) - 1);
+    const __m512i ColumnSums = _mm512_maskz_loadu_epi32(Mask, ColumnSumBuffer);
+    __m512i ZeroPoints = _mm512_setzero_si512();
+
+    if (ZeroPointB != nullptr) {
+        ZeroPoints = _mm512_maskz_loadu_epi32(Mask, ZeroPointB);
+    }
+
+    for (size_t r = 0; r < MlasQgemmAmxRows; r++) {
+
+        int32_t* c = C + r * ldc;
+        __m512i RowSums = _mm512_set1_epi32(RowSumBuffer[r]);
+
+        if (ZeroPointB != nullptr) {
+            RowSums = _mm512_mullo_epi32(RowSums, ZeroPoints);
+        }
+
+        __m512i Accumulator = _mm512_load_si512(BufferC + r * 16);
+        Accumulator = _mm512_add_epi32(Accumulator, _mm512_add_epi32(RowSums, ColumnSums));
+
+        if (!ZeroMode) {
+            Accumulator = _mm512_add_epi32(Accumulator, _mm512_maskz_loadu_epi32(Mask, c));
+        }
+
+        _mm512_mask_storeu_epi32(c, Mask, Accumulator);
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+bool
+MlasGemmQuantTryGemvKernel<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    const uint8_t* A,
+    const uint8_t* B,
+    size_t ldb,
+    int32_t* C,
+    size_t CountK,
+    size_t CountN,
+    bool AIsSigned,
+    bool BIsSigned
+    )
+{
+    if (!AIsSigned && BIsSigned) {
+        GetMlasPlatform().GemvU8S8Kernel(A, B, C, CountK, CountN, ldb);
+        return true;
+    }
+
+    return false;
+}
+
+template<>
+MLAS_FORCEINLINE constexpr
+int32_t
+MlasGemmQuantFixupZeroPointB<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    if (!BIsSigned) {
+        ZeroPointB = MLAS_GEMM_U8S8_KERNEL_AMX::OffsetBType(ZeroPointB ^ 0x80);
+    }
+
+    return ZeroPointB;
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmQuantCopyPackA<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer,
+    bool AIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(AIsSigned);
+    MlasGemmU8S8CopyPackAAvx2(D, A, lda, CountM, CountK, RowSumBuffer);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmQuantCopyPackB<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    MlasGemmU8S8CopyPackBAvx2(D, B, ldb, CountN, CountK, ColumnSumBuffer, BIsSigned);
+}
+
+template<size_t RowTiles>
+void
+MlasQgemmKernelAmx(
+    const uint8_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowTiles blocks of 16 rows of matrix C.
+
+    The packed depth is processed in steps of a full tile. When it is not a
+    multiple of the tile depth, the last step of matrix A and of each panel
+    of matrix B is copied to a zero padded buffer.
+
+Arguments:
+
+    See MlasGemmQuantKernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(int32_t BufferC[MlasQgemmAmxRows * 16], 64);
+    MLAS_DECLSPEC_ALIGN(uint8_t BufferA[RowTiles * MlasQgemmAmxTileBytes], 64);
+    MLAS_DECLSPEC_ALIGN(uint8_t BufferB[2 * MlasQgemmAmxTileBytes], 64);
+
+    const size_t PackedCountKFull = PackedCountK & ~(MlasQgemmAmxPackedCountK - 1);
+    const size_t PackedCountKRemaining = PackedCountK - PackedCountKFull;
+    const size_t StrideA = PackedCountK * MLAS_GEMM_U8S8_KERNEL_AMX::PackedK;
+    const size_t StridePanelB = 16 * StrideA;
+    const size_t OffsetATail = PackedCountKFull * MLAS_GEMM_U8S8_KERNEL_AMX::PackedK;
+    const size_t OffsetBTail = PackedCountKFull * MlasQgemmAmxStrideBytes;
+    const size_t BytesBTail = PackedCountKRemaining * MlasQgemmAmxStrideBytes;
+
+    if (PackedCountKRemaining != 0) {
+
+        std::memset(BufferA, 0, sizeof(BufferA));
+        std::memset(BufferB, 0, sizeof(BufferB));
+
+        for (size_t r = 0; r < RowTiles * MlasQgemmAmxRows; r++) {
+            std::memcpy(BufferA + r * MlasQgemmAmxStrideBytes, A + r * StrideA + OffsetATail,
+                        PackedCountKRemaining * MLAS_GEMM_U8S8_KERNEL_AMX::PackedK);
+        }
+    }
+
+    for (size_t n = 0; n < CountN; n += 32) {
+
+        const uint8_t* PanelB[2] = { B + n * StrideA, B + n * StrideA + StridePanelB };
+        const bool ProcessTwoPanels = (CountN - n) > 16;
+
+        _tile_zero(MLAS_QGEMM_AMX_TILE_C00);
+        _tile_zero(MLAS_QGEMM_AMX_TILE_C01);
+        if (RowTiles > 1) {
+            _tile_zero(MLAS_QGEMM_AMX_TILE_C10);
+            _tile_zero(MLAS_QGEMM_AMX_TILE_C11);
+        }
+
+        for (size_t k = 0; k < PackedCountKFull; k += MlasQgemmAmxPackedCountK) {
+
+            const uint8_t* a = A + k * MLAS_GEMM_U8S8_KERNEL_AMX::PackedK;
+            const size_t OffsetB = k * MlasQgemmAmxStrideBytes;
+
+            _tile_loadd(MLAS_QGEMM_AMX_TILE_A0, a, StrideA);
+            _tile_loadd(MLAS_QGEMM_AMX_TILE_B0, PanelB[0] + OffsetB, MlasQgemmAmxStrideBytes);
+            _tile_dpbusd(MLAS_QGEMM_AMX_TILE_C00, MLAS_QGEMM_AMX_TILE_A0, MLAS_QGEMM_AMX_TILE_B0);
+
+            if (RowTiles > 1) {
+                _tile_loadd(MLAS_QGEMM_AMX_TILE_A1, a + MlasQgemmAmxRows * StrideA, StrideA);
+                _tile_dpbusd(MLAS_QGEMM_AMX_TILE_C10, MLAS_QGEMM_AMX_TILE_A1, MLAS_QGEMM_AMX_TILE_B0);
+            }
+
+            if (ProcessTwoPanels) {
+                _tile_loadd(MLAS_QGEMM_AMX_TILE_B1, PanelB[1] + OffsetB, MlasQgemmAmxStrideBytes);
+                _tile_dpbusd(MLAS_QGEMM_AMX_TILE_C01, MLAS_QGEMM_AMX_TILE_A0, MLAS_QGEMM_AMX_TILE_B1);
+                if (RowTiles > 1) {
+                    _tile_dpbusd(MLAS_QGEMM_AMX_TILE_C11, MLAS_QGEMM_AMX_TILE_A1, MLAS_QGEMM_AMX_TILE_B1);
+                }
+            }
+        }
+
+        if (PackedCountKRemaining != 0) {
+
+            std::memcpy(BufferB, PanelB[0] + OffsetBTail, BytesBTail);
+
+            _tile_loadd(MLAS_QGEMM_AMX_TILE_A0, BufferA, MlasQgemmAmxStrideBytes);
+            _tile_loadd(MLAS_QGEMM_AMX_TILE_B0, BufferB, MlasQgemmAmxStrideBytes);
+            _tile_dpbusd(MLAS_QGEMM_AMX_TILE_C00, MLAS_QGEMM_AMX_TILE_A0, MLAS_QGEMM_AMX_TILE_B0);
+
+            if (RowTiles > 1) {
+                _tile_loadd(MLAS_QGEMM_AMX_TILE_A1, BufferA + MlasQgemmAmxTileBytes, MlasQgemmAmxStrideBytes);
+                _tile_dpbusd(MLAS_QGEMM_AMX_TILE_C10, MLAS_QGEMM_AMX_TILE_A1, MLAS_QGEMM_AMX_TILE_B0);
+            }
+
+            if (ProcessTwoPanels) {
+                std::memcpy(BufferB + MlasQgemmAmxTileBytes, PanelB[1] + OffsetBTail, BytesBTail);
+                _tile_loadd(MLAS_QGEMM_AMX_TILE_B1, BufferB + MlasQgemmAmxTileBytes, MlasQgemmAmxStrideBytes);
+                _tile_dpbusd(MLAS_QGEMM_AMX_TILE_C01, MLAS_QGEMM_AMX_TILE_A0, MLAS_QGEMM_AMX_TILE_B1);
+                if (RowTiles > 1) {
+                    _tile_dpbusd(MLAS_QGEMM_AMX_TILE_C11, MLAS_QGEMM_AMX_TILE_A1, MLAS_QGEMM_AMX_TILE_B1);
+                }
+            }
+        }
+
+        //
+        // Store the accumulators of each block of 16 rows and 16 columns.
+        //
+
+        for (size_t c = 0; c < (ProcessTwoPanels ? 2 : 1); c++) {
+
+            const size_t nc = n + c * 16;
+            const size_t CountNPanel = std::min(CountN - nc, size_t(16));
+            const int32_t* ZeroPointBPanel = (ZeroPointB != nullptr) ? ZeroPointB + nc : nullptr;
+
+            for (size_t r = 0; r < RowTiles; r++) {
+
+                //
+                // The tile register of a tile instruction must be a constant.
+                //
+
+                if (r == 0) {
+                    if (c == 0) {
+                        _tile_stored(MLAS_QGEMM_AMX_TILE_C00, BufferC, MlasQgemmAmxStrideBytes);
+                    } else {
+                        _tile_stored(MLAS_QGEMM_AMX_TILE_C01, BufferC, MlasQgemmAmxStrideBytes);
+                    }
+                } else {
+                    if (c == 0) {
+                        _tile_stored(MLAS_QGEMM_AMX_TILE_C10, BufferC, MlasQgemmAmxStrideBytes);
+                    } else {
+                        _tile_stored(MLAS_QGEMM_AMX_TILE_C11, BufferC, MlasQgemmAmxStrideBytes);
+                    }
+                }
+
+                MlasQgemmStorePanelAmx(BufferC, C + r * MlasQgemmAmxRows * ldc + nc, ldc, CountNPanel,
+                                       RowSumBuffer + r * MlasQgemmAmxRows, ColumnSumBuffer + nc,
+                                       ZeroPointBPanel, ZeroMode);
+            }
+        }
+    }
+}
+
+template<>
+size_t
+MlasGemmQuantKernel<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    const MLAS_GEMM_U8S8_KERNEL_AMX::PackedAType* A,
+    const MLAS_GEMM_U8S8_KERNEL_AMX::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes 32 or 16 rows of matrix C with AMX tiles, or defers
+    to the AVX512VNNI kernel when fewer rows remain.
+
+    The dot products are accumulated in tiles, then the row and column sums
+    supplied by the packing routines are added while storing matrix C.
+
+Arguments:
+
+    See MlasGemmQuantKernel.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM < MlasQgemmAmxRows) {
+        return MlasGemmU8S8KernelAvx512Vnni(A, B, C, PackedCountK, CountM, CountN, ldc,
+                                            RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+    }
+
+    MlasQgemmLoadTileConfigAmx();
+
+    size_t RowsHandled;
+
+    if (CountM >= 2 * MlasQgemmAmxRows) {
+        MlasQgemmKernelAmx<2>(A, B, C, PackedCountK, CountN, ldc, RowSumBuffer, ColumnSumBuffer,
+                              ZeroPointB, ZeroMode);
+        RowsHandled = 2 * MlasQgemmAmxRows;
+    } else {
+        MlasQgemmKernelAmx<1>(A, B, C, PackedCountK, CountN, ldc, RowSumBuffer, ColumnSumBuffer,
+                              ZeroPointB, ZeroMode);
+        RowsHandled = MlasQgemmAmxRows;
+    }
+
+    _tile_release();
+
+    return RowsHandled;
+}
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchAmx = {
+    MlasGemmQuantOperation<MLAS_GEMM_U8S8_KERNEL_AMX>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_U8S8_KERNEL_AMX>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_U8S8_KERNEL_AMX>,
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedK,
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedStrides.K,
+};
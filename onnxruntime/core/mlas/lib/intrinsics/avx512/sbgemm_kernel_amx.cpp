@@ -0,0 +1,189 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply kernel with
+    AMX tile instructions.
+
+    The kernel multiplies blocks of 16 rows of matrix A by the panels of
+    packed matrix B, which already have the row pair interleaved layout of a
+    tdpbf16ps operand. Partial blocks of rows are handed to the AVX512-BF16
+    kernel.
+
+    This file must be compiled with -mamx-tile -mamx-bf16 -mavx512bf16.
+
+--*/
+
+#include "sbgemm.h"
+
+#include <cstring>
+
+//
+// Define the tile registers used by the kernel.
+//
+
+#define MLAS_SBGEMM_AMX_TILE_C                      0
+#define MLAS_SBGEMM_AMX_TILE_A                      1
+#define MLAS_SBGEMM_AMX_TILE_B                      2
+
+//
+// Define the shape of a block of matrix C computed by one tile.
+//
+
+constexpr size_t MlasSBGemmAmxRows = 16;
+constexpr size_t MlasSBGemmAmxStrideBytes = 64;
+
+struct MLAS_SBGEMM_AMX_TILE_CONFIG {
+    uint8_t PaletteId;
+    uint8_t StartRow;
+    uint8_t Reserved[14];
+    uint16_t ColumnBytes[16];
+    uint8_t Rows[16];
+};
+
+static_assert(sizeof(MLAS_SBGEMM_AMX_TILE_CONFIG) == 64, "AMX tile configuration must be 64 bytes");
+
+MLAS_FORCEINLINE
+void
+MlasSBGemmLoadTileConfigAmx(
+    void
+    )
+{
+    MLAS_SBGEMM_AMX_TILE_CONFIG Config = {};
+
+    Config.PaletteId = 1;
+
+    for (int t : {MLAS_SBGEMM_AMX_TILE_C, MLAS_SBGEMM_AMX_TILE_A, MLAS_SBGEMM_AMX_TILE_B}) {
+        Config.ColumnBytes[t] = MlasSBGemmAmxStrideBytes;
+        Config.Rows[t] = uint8_t(MlasSBGemmAmxRows);
+    }
+
+    _tile_loadconfig(&Config);
+}
+
+size_t
+MLASCALL
+MlasSBGemmKernelAmx(
+    const MLAS_BF16* A,
+    const MLAS_BF16* PackedB,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    size_t PanelStride,
+    const float* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes 16 rows of matrix C with AMX tiles, or defers to
+    the AVX512-BF16 kernel when fewer rows remain.
+
+Arguments:
+
+    See MLAS_SBGEMM_KERNEL.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM < MlasSBGemmAmxRows) {
+        return MlasSBGemmKernelAvx512Bf16(A, PackedB, C, CountK, CountM, CountN, lda, ldc,
+                                          PanelStride, Bias, ZeroMode);
+    }
+
+    MLAS_DECLSPEC_ALIGN(float BufferC[MlasSBGemmAmxRows * MLAS_SBGEMM_PACKED_N], 64);
+    MLAS_DECLSPEC_ALIGN(MLAS_BF16 BufferA[MlasSBGemmAmxRows * MLAS_SBGEMM_PACKED_K], 64);
+
+    //
+    // The last block of columns of matrix A is copied to a zero padded buffer
+    // when the number of columns is not a multiple of the tile depth.
+    //
+
+    const size_t CountKFull = CountK & ~size_t(MLAS_SBGEMM_PACKED_K - 1);
+    const size_t CountKRemaining = CountK - CountKFull;
+
+    if (CountKRemaining != 0) {
+        for (size_t r = 0; r < MlasSBGemmAmxRows; r++) {
+            MLAS_BF16* a = BufferA + r * MLAS_SBGEMM_PACKED_K;
+            std::memcpy(a, A + r * lda + CountKFull, CountKRemaining * sizeof(MLAS_BF16));
+            std::memset(a + CountKRemaining, 0, (MLAS_SBGEMM_PACKED_K - CountKRemaining) * sizeof(MLAS_BF16));
+        }
+    }
+
+    MlasSBGemmLoadTileConfigAmx();
+
+    for (size_t n = 0; n < CountN; n += MLAS_SBGEMM_PACKED_N) {
+
+        const size_t CountNPanel = std::min(CountN - n, size_t(MLAS_SBGEMM_PACKED_N));
+        const MLAS_BF16* PanelB = PackedB + (n / MLAS_SBGEMM_PACKED_N) * PanelStride;
+        float* c = C + n;
+
+        //
+        // Initialize the accumulator tile from matrix C, the bias vector or
+        // zero. Partial panels go through a buffer to stay inside matrix C.
+        //
+
+        if (!ZeroMode) {
+            if (CountNPanel == MLAS_SBGEMM_PACKED_N) {
+                _tile_loadd(MLAS_SBGEMM_AMX_TILE_C, c, ldc * sizeof(float));
+            } else {
+                for (size_t r = 0; r < MlasSBGemmAmxRows; r++) {
+                    std::memcpy(BufferC + r * MLAS_SBGEMM_PACKED_N, c + r * ldc, CountNPanel * sizeof(float));
+                }
+                _tile_loadd(MLAS_SBGEMM_AMX_TILE_C, BufferC, MlasSBGemmAmxStrideBytes);
+            }
+        } else if (Bias != nullptr) {
+            const __m512 RowBias = _mm512_maskz_loadu_ps(__mmask16((uint32_t(1) << CountNPanel) - 1), Bias + n);
+            for (size_t r = 0; r < MlasSBGemmAmxRows; r++) {
+                _mm512_store_ps(BufferC + r * MLAS_SBGEMM_PACKED_N, RowBias);
+            }
+            _tile_loadd(MLAS_SBGEMM_AMX_TILE_C, BufferC, MlasSBGemmAmxStrideBytes);
+        } else {
+            _tile_zero(MLAS_SBGEMM_AMX_TILE_C);
+        }
+
+        for (size_t k = 0; k < CountKFull; k += MLAS_SBGEMM_PACKED_K) {
+            _tile_loadd(MLAS_SBGEMM_AMX_TILE_A, A + k, lda * sizeof(MLAS_BF16));
+            _tile_loadd(MLAS_SBGEMM_AMX_TILE_B, PanelB + k * MLAS_SBGEMM_PACKED_N, MlasSBGemmAmxStrideBytes);
+            _tile_dpbf16ps(MLAS_SBGEMM_AMX_TILE_C, MLAS_SBGEMM_AMX_TILE_A, MLAS_SBGEMM_AMX_TILE_B);
+        }
+
+        if (CountKRemaining != 0) {
+            _tile_loadd(MLAS_SBGEMM_AMX_TILE_A, BufferA, MlasSBGemmAmxStrideBytes);
+            _tile_loadd(MLAS_SBGEMM_AMX_TILE_B, PanelB + CountKFull * MLAS_SBGEMM_PACKED_N, MlasSBGemmAmxStrideBytes);
+            _tile_dpbf16ps(MLAS_SBGEMM_AMX_TILE_C, MLAS_SBGEMM_AMX_TILE_A, MLAS_SBGEMM_AMX_TILE_B);
+        }
+
+        if (CountNPanel == MLAS_SBGEMM_PACKED_N) {
+            _tile_stored(MLAS_SBGEMM_AMX_TILE_C, c, ldc * sizeof(float));
+        } else {
+            _tile_stored(MLAS_SBGEMM_AMX_TILE_C, BufferC, MlasSBGemmAmxStrideBytes);
+            for (size_t r = 0; r < MlasSBGemmAmxRows; r++) {
+                std::memcpy(c + r * ldc, BufferC + r * MLAS_SBGEMM_PACKED_N, CountNPanel * sizeof(float));
+            }
+        }
+    }
+
+    _tile_release();
+
+    return MlasSBGemmAmxRows;
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx = {
+    MlasSBGemmKernelAmx,
+};
@@ -0,0 +1,179 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply kernel with
+    AVX512-BF16 instructions.
+
+    This file must be compiled with -mavx512bf16.
+
+--*/
+
+#include "sbgemm.h"
+
+#include <cstring>
+
+MLAS_FORCEINLINE
+__m512bh
+MlasSBGemmBroadcastPairAvx512Bf16(
+    const MLAS_BF16* A,
+    size_t k,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine broadcasts elements k and k + 1 of a row of matrix A, or
+    element k and zero if k is the last column.
+
+--*/
+{
+    uint32_t Pair;
+
+    if (k + 1 < CountK) {
+        std::memcpy(&Pair, A + k, sizeof(Pair));
+    } else {
+        Pair = A[k];
+    }
+
+    return (__m512bh)_mm512_set1_epi32(int(Pair));
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmPanelAvx512Bf16(
+    const MLAS_BF16* A,
+    const MLAS_BF16* PanelB,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+    )
+{
+    __m512 Accumulators[RowCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r] = _mm512_setzero_ps();
+    }
+
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        const __m512bh PairsB = (__m512bh)_mm512_loadu_si512(PanelB);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512bh PairA = MlasSBGemmBroadcastPairAvx512Bf16(A + r * lda, k, CountK);
+            Accumulators[r] = _mm512_dpbf16_ps(Accumulators[r], PairA, PairsB);
+        }
+
+        PanelB += MLAS_SBGEMM_PACKED_N * 2;
+    }
+
+    const __mmask16 Mask = __mmask16((uint32_t(1) << CountN) - 1);
+
+    __m512 RowBias = _mm512_setzero_ps();
+
+    if (ZeroMode && Bias != nullptr) {
+        RowBias = _mm512_maskz_loadu_ps(Mask, Bias);
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        float* c = C + r * ldc;
+
+        if (!ZeroMode) {
+            Accumulators[r] = _mm512_add_ps(Accumulators[r], _mm512_maskz_loadu_ps(Mask, c));
+        } else if (Bias != nullptr) {
+            Accumulators[r] = _mm512_add_ps(Accumulators[r], RowBias);
+        }
+
+        _mm512_mask_storeu_ps(c, Mask, Accumulators[r]);
+    }
+}
+
+size_t
+MLASCALL
+MlasSBGemmKernelAvx512Bf16(
+    const MLAS_BF16* A,
+    const MLAS_BF16* PackedB,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    size_t PanelStride,
+    const float* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 8 rows of matrix C with one 512-bit
+    accumulator per row of a panel.
+
+Arguments:
+
+    See MLAS_SBGEMM_KERNEL.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t RowCount = std::min(CountM, size_t(8));
+
+    for (size_t n = 0; n < CountN; n += MLAS_SBGEMM_PACKED_N) {
+
+        const size_t CountNPanel = std::min(CountN - n, size_t(MLAS_SBGEMM_PACKED_N));
+        const MLAS_BF16* PanelB = PackedB + (n / MLAS_SBGEMM_PACKED_N) * PanelStride;
+        const float* PanelBias = (Bias != nullptr) ? Bias + n : nullptr;
+
+        switch (RowCount) {
+            case 8:
+                MlasSBGemmPanelAvx512Bf16<8>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 7:
+                MlasSBGemmPanelAvx512Bf16<7>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 6:
+                MlasSBGemmPanelAvx512Bf16<6>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 5:
+                MlasSBGemmPanelAvx512Bf16<5>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 4:
+                MlasSBGemmPanelAvx512Bf16<4>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 3:
+                MlasSBGemmPanelAvx512Bf16<3>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 2:
+                MlasSBGemmPanelAvx512Bf16<2>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            default:
+                MlasSBGemmPanelAvx512Bf16<1>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+        }
+    }
+
+    return RowCount;
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmKernelAvx512Bf16,
+};
@@ -0,0 +1,476 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute the layer normalization of a
+    row, with the optional skip and bias additions of SkipLayerNormalization.
+
+    The skip and bias additions, the sum and the sum of squares of the row are
+    computed in a single vectorized pass that stores the added values to the
+    output. The sums are accumulated per lane in several vectors and reduced
+    at the end of the row, which keeps the rounding error of long rows close
+    to that of a pairwise summation. The row is then normalized from the cache
+    in a second pass.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of floats converted at a time by the half precision variant.
+//
+
+constexpr size_t MLAS_LAYER_NORM_HALF_BLOCK_SIZE = 256;
+
+static
+void
+MlasLayerNormAddAndSum(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float& Sum,
+    float& SumSquares
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the optional skip and bias to the input row, stores the
+    result to the output row and accumulates its sum and sum of squares.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Supplies the optional skip row.
+
+    Bias - Supplies the optional bias row.
+
+    Output - Supplies the output row. The output may alias the input.
+
+    N - Supplies the number of elements of the row.
+
+    Sum - Returns the sum of the row.
+
+    SumSquares - Returns the sum of squares of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 Sum0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Sum1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquares0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquares1 = MlasZeroFloat32x4();
+
+    size_t i = 0;
+
+    for (; i + 8 <= N; i += 8) {
+
+        MLAS_FLOAT32X4 Value0 = MlasLoadFloat32x4(Input + i);
+        MLAS_FLOAT32X4 Value1 = MlasLoadFloat32x4(Input + i + 4);
+
+        if (Skip != nullptr) {
+            Value0 = MlasAddFloat32x4(Value0, MlasLoadFloat32x4(Skip + i));
+            Value1 = MlasAddFloat32x4(Value1, MlasLoadFloat32x4(Skip + i + 4));
+        }
+
+        if (Bias != nullptr) {
+            Value0 = MlasAddFloat32x4(Value0, MlasLoadFloat32x4(Bias + i));
+            Value1 = MlasAddFloat32x4(Value1, MlasLoadFloat32x4(Bias + i + 4));
+        }
+
+        MlasStoreFloat32x4(Output + i, Value0);
+        MlasStoreFloat32x4(Output + i + 4, Value1);
+
+        Sum0 = MlasAddFloat32x4(Sum0, Value0);
+        Sum1 = MlasAddFloat32x4(Sum1, Value1);
+        SumSquares0 = MlasMultiplyAddFloat32x4(Value0, Value0, SumSquares0);
+        SumSquares1 = MlasMultiplyAddFloat32x4(Value1, Value1, SumSquares1);
+    }
+
+    if (i + 4 <= N) {
+
+        MLAS_FLOAT32X4 Value0 = MlasLoadFloat32x4(Input + i);
+
+        if (Skip != nullptr) {
+            Value0 = MlasAddFloat32x4(Value0, MlasLoadFloat32x4(Skip + i));
+        }
+
+        if (Bias != nullptr) {
+            Value0 = MlasAddFloat32x4(Value0, MlasLoadFloat32x4(Bias + i));
+        }
+
+        MlasStoreFloat32x4(Output + i, Value0);
+
+        Sum0 = MlasAddFloat32x4(Sum0, Value0);
+        SumSquares0 = MlasMultiplyAddFloat32x4(Value0, Value0, SumSquares0);
+
+        i += 4;
+    }
+
+    Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(Sum0, Sum1));
+    SumSquares = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquares0, SumSquares1));
+
+    for (; i < N; i++) {
+
+        float Value = Input[i];
+
+        if (Skip != nullptr) {
+            Value += Skip[i];
+        }
+
+        if (Bias != nullptr) {
+            Value += Bias[i];
+        }
+
+        Output[i] = Value;
+
+        Sum += Value;
+        SumSquares += Value * Value;
+    }
+}
+
+static
+void
+MlasLayerNormNormalize(
+    const float* Values,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine computes (Values[i] - Mean) * InvStdDev * Gamma[i] + Beta[i]
+    for a row.
+
+Arguments:
+
+    Values - Supplies the row to normalize.
+
+    Gamma - Supplies the scale row.
+
+    Beta - Supplies the optional shift row.
+
+    Output - Supplies the output row. The output may alias the values.
+
+    N - Supplies the number of elements of the row.
+
+    Mean - Supplies the mean of the row.
+
+    InvStdDev - Supplies the inverse of the standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    const MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDev);
+
+    size_t i = 0;
+
+    for (; i + 4 <= N; i += 4) {
+
+        MLAS_FLOAT32X4 Value = MlasSubtractFloat32x4(MlasLoadFloat32x4(Values + i), MeanVector);
+        Value = MlasMultiplyFloat32x4(Value, InvStdDevVector);
+
+        if (Beta != nullptr) {
+            Value = MlasMultiplyAddFloat32x4(Value, MlasLoadFloat32x4(Gamma + i), MlasLoadFloat32x4(Beta + i));
+        } else {
+            Value = MlasMultiplyFloat32x4(Value, MlasLoadFloat32x4(Gamma + i));
+        }
+
+        MlasStoreFloat32x4(Output + i, Value);
+    }
+
+    for (; i < N; i++) {
+
+        float Value = (Values[i] - Mean) * InvStdDev * Gamma[i];
+
+        if (Beta != nullptr) {
+            Value += Beta[i];
+        }
+
+        Output[i] = Value;
+    }
+}
+
+static
+void
+MlasLayerNormStatistics(
+    float Sum,
+    float SumSquares,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float& Mean,
+    float& InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the mean and the inverse of the standard deviation
+    of a row from its sum and sum of squares.
+
+Arguments:
+
+    Sum - Supplies the sum of the row.
+
+    SumSquares - Supplies the sum of squares of the row.
+
+    N - Supplies the number of elements of the row.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Simplified - Supplies true to compute the root mean square instead of the
+        standard deviation, with a mean of 0.
+
+    Mean - Returns the mean of the row.
+
+    InvStdDev - Returns the inverse of the standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Simplified) {
+        Mean = 0.0f;
+        InvStdDev = 1.0f / std::sqrt(SumSquares / N + Epsilon);
+    } else {
+        Mean = Sum / N;
+        //
+        // Rounding may make the variance slightly negative for a row of
+        // (nearly) equal values.
+        //
+        const float Variance = std::max(SumSquares / N - Mean * Mean, 0.0f);
+        InvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+    }
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the layer normalization of a row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Supplies the optional skip row added to the input.
+
+    Bias - Supplies the optional bias row added to the input.
+
+    Gamma - Supplies the scale row.
+
+    Beta - Supplies the optional shift row. Ignored when Simplified is true.
+
+    Output - Supplies the output row. The output may alias the input.
+
+    N - Supplies the number of elements of the row.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Simplified - Supplies true to compute the root mean square normalization.
+
+    Mean - Optionally returns the mean of the row, 0 when Simplified is true.
+
+    InvStdDev - Optionally returns the inverse of the standard deviation (or
+        of the root mean square) of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Sum;
+    float SumSquares;
+
+    MlasLayerNormAddAndSum(Input, Skip, Bias, Output, N, Sum, SumSquares);
+
+    float RowMean;
+    float RowInvStdDev;
+
+    MlasLayerNormStatistics(Sum, SumSquares, N, Epsilon, Simplified, RowMean, RowInvStdDev);
+
+    MlasLayerNormNormalize(Output, Gamma, Simplified ? nullptr : Beta, Output, N, RowMean, RowInvStdDev);
+
+    if (Mean != nullptr) {
+        *Mean = RowMean;
+    }
+
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+}
+
+void
+MLASCALL
+MlasLayerNormalizationHalf(
+    const unsigned short* Input,
+    const unsigned short* Skip,
+    const unsigned short* Bias,
+    const unsigned short* Gamma,
+    const unsigned short* Beta,
+    unsigned short* Output,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev,
+    float* WorkBuffer
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the layer normalization of a half precision row in
+    single precision.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Supplies the optional skip row added to the input.
+
+    Bias - Supplies the optional bias row added to the input.
+
+    Gamma - Supplies the scale row.
+
+    Beta - Supplies the optional shift row. Ignored when Simplified is true.
+
+    Output - Supplies the output row. The output may alias the input.
+
+    N - Supplies the number of elements of the row.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Simplified - Supplies true to compute the root mean square normalization.
+
+    Mean - Optionally returns the mean of the row, 0 when Simplified is true.
+
+    InvStdDev - Optionally returns the inverse of the standard deviation (or
+        of the root mean square) of the row.
+
+    WorkBuffer - Supplies a buffer of N floats that holds the row in single
+        precision.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float SkipBlock[MLAS_LAYER_NORM_HALF_BLOCK_SIZE];
+    float BiasBlock[MLAS_LAYER_NORM_HALF_BLOCK_SIZE];
+
+    //
+    // Widen the row block by block and add the skip and bias to it.
+    //
+
+    float Sum = 0.0f;
+    float SumSquares = 0.0f;
+
+    for (size_t i = 0; i < N; i += MLAS_LAYER_NORM_HALF_BLOCK_SIZE) {
+
+        const size_t n = std::min(N - i, MLAS_LAYER_NORM_HALF_BLOCK_SIZE);
+
+        MlasConvertHalfToFloatBuffer(Input + i, WorkBuffer + i, n);
+
+        if (Skip != nullptr) {
+            MlasConvertHalfToFloatBuffer(Skip + i, SkipBlock, n);
+        }
+
+        if (Bias != nullptr) {
+            MlasConvertHalfToFloatBuffer(Bias + i, BiasBlock, n);
+        }
+
+        float BlockSum;
+        float BlockSumSquares;
+
+        MlasLayerNormAddAndSum(WorkBuffer + i, Skip != nullptr ? SkipBlock : nullptr,
+                               Bias != nullptr ? BiasBlock : nullptr, WorkBuffer + i, n,
+                               BlockSum, BlockSumSquares);
+
+        Sum += BlockSum;
+        SumSquares += BlockSumSquares;
+    }
+
+    float RowMean;
+    float RowInvStdDev;
+
+    MlasLayerNormStatistics(Sum, SumSquares, N, Epsilon, Simplified, RowMean, RowInvStdDev);
+
+    //
+    // Normalize the row block by block and narrow it to the output.
+    //
+
+    float* GammaBlock = SkipBlock;
+    float* BetaBlock = BiasBlock;
+
+    if (Simplified) {
+        Beta = nullptr;
+    }
+
+    for (size_t i = 0; i < N; i += MLAS_LAYER_NORM_HALF_BLOCK_SIZE) {
+
+        const size_t n = std::min(N - i, MLAS_LAYER_NORM_HALF_BLOCK_SIZE);
+
+        MlasConvertHalfToFloatBuffer(Gamma + i, GammaBlock, n);
+
+        if (Beta != nullptr) {
+            MlasConvertHalfToFloatBuffer(Beta + i, BetaBlock, n);
+        }
+
+        MlasLayerNormNormalize(WorkBuffer + i, GammaBlock, Beta != nullptr ? BetaBlock : nullptr,
+                               WorkBuffer + i, n, RowMean, RowInvStdDev);
+
+        MlasConvertFloatToHalfBuffer(WorkBuffer + i, Output + i, n);
+    }
+
+    if (Mean != nullptr) {
+        *Mean = RowMean;
+    }
+
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+}
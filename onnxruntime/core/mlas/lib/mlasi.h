@@ -121,6 +121,10 @@ class MLASCPUIDInfo
     // ARM
     bool HasArmNeonDot() const { return has_arm_neon_dot_; }
 
+    bool HasFp16VectorAcceleration() const { return has_fp16_; }
+
+    bool HasArmBf16() const { return has_arm_bf16_; }
+
     uint32_t GetCurrentCoreIdx() const { return 0xFFFFFFFF; }
 
     int32_t GetCurrentUarch() const { return -1; }
@@ -135,6 +139,8 @@ class MLASCPUIDInfo
     MLASCPUIDInfo();
 
     bool has_arm_neon_dot_{false};
+    bool has_fp16_{false};
+    bool has_arm_bf16_{false};
 };
 using MLAS_CPUIDINFO = MLASCPUIDInfo;
 
@@ -537,6 +543,22 @@ void
     int8_t ZeroPoint
     );
 
+typedef
+void
+(MLASCALL MLAS_CAST_F16_TO_F32_KERNEL)(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_F16_KERNEL)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
 template<typename InputType, typename FilterType>
 struct MLAS_QUANT_KERNEL
 {
@@ -554,6 +576,52 @@ struct MLAS_QUANT_KERNEL
         );
 };
 
+//
+// The int16 by int8 GEMM kernel multiplies rows of A by a panel of B packed
+// by the driver to MLAS_GEMM_S16S8_STRIDEN int16 columns, interleaved by
+// pairs of rows, and returns the number of rows processed. The column sums
+// are added in ZeroMode, which stores rather than accumulates to C.
+//
+
+#define MLAS_GEMM_S16S8_STRIDEN                     16
+#define MLAS_GEMM_S16S8_STRIDEK                     256
+
+typedef
+size_t
+(MLASCALL MLAS_GEMM_S16S8_KERNEL)(
+    const int16_t* A,
+    size_t lda,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    );
+
+MLAS_FORCEINLINE
+int32_t
+MlasGemmS16S8LoadPairA(
+    const int16_t* A,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine loads the next two elements of a row of A as a 32-bit value,
+    with the second element zero if only one remains.
+
+--*/
+{
+    const uint32_t a0 = uint16_t(A[0]);
+    const uint32_t a1 = (CountK > 1) ? uint16_t(A[1]) : 0;
+
+    return int32_t(a0 | (a1 << 16));
+}
+
 extern "C" {
 
 #if defined(MLAS_TARGET_AMD64_IX86)
@@ -674,6 +742,8 @@ extern "C" {
 #if defined(MLAS_TARGET_AMD64)
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32KernelAvx;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
+    MLAS_CAST_F16_TO_F32_KERNEL MlasCastF16ToF32KernelAvx2;
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16KernelAvx2;
 #endif
 
 }
@@ -722,7 +792,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     );
 
 //
@@ -734,6 +805,7 @@ struct MLAS_GEMM_QUANT_DISPATCH;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchSse;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchSse41;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchAvx2;
+extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchAmx;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8U8DispatchAvx2;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchNeon;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmX8S8DispatchNeon;
@@ -744,6 +816,36 @@ extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchWasmSimd;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmQuantDispatchDefault;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemm8X8DispatchPOWER10;
 
+//
+// Half precision matrix/matrix dispatch structure.
+//
+
+struct MLAS_HGEMM_DISPATCH;
+
+extern const MLAS_HGEMM_DISPATCH MlasHalfGemmDispatchDefault;
+extern const MLAS_HGEMM_DISPATCH MlasHalfGemmDispatchNeon;
+extern const MLAS_HGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16;
+
+//
+// Bfloat16 matrix/matrix dispatch structure.
+//
+
+struct MLAS_SBGEMM_DISPATCH;
+
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchDefault;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchNeon;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx;
+
+//
+// Block-wise 4-bit quantized matrix/matrix dispatch structure.
+//
+
+struct MLAS_Q4GEMM_DISPATCH;
+
+extern const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchDefault;
+extern const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchAvx2;
+
 //
 // Symmetric quantized qgemm dispatch structure
 //
@@ -798,6 +900,18 @@ MlasConvDepthwiseKernelAvx2(
     size_t KernelSize
     );
 
+//
+// Quantized int16 by int8 matrix/matrix multiply kernels.
+//
+
+MLAS_GEMM_S16S8_KERNEL MlasGemmS16S8Kernel;
+#if defined(MLAS_TARGET_ARM64)
+MLAS_GEMM_S16S8_KERNEL MlasGemmS16S8KernelNeon;
+#endif
+#if defined(MLAS_TARGET_AMD64)
+MLAS_GEMM_S16S8_KERNEL MlasGemmS16S8KernelAvx2;
+#endif
+
 //
 // Define the kernel flags for conv sym
 //
@@ -843,10 +957,15 @@ struct MLAS_PLATFORM {
     const MLAS_CONV_SYM_DISPATCH* ConvSymU8S8Dispatch{nullptr};
     const MLAS_CONV_SYM_DISPATCH* ConvSymS8S8Dispatch{nullptr};
 
+    const MLAS_HGEMM_DISPATCH* HalfGemmDispatch{&MlasHalfGemmDispatchDefault};
+    const MLAS_SBGEMM_DISPATCH* SBGemmDispatch{&MlasSBGemmDispatchDefault};
+    const MLAS_Q4GEMM_DISPATCH* Q4GemmDispatch{&MlasQ4GemmDispatchDefault};
+
     MLAS_QUANT_KERNEL<uint8_t, int8_t>::DepthwiseKernel* ConvDepthwiseU8S8Kernel;
     MLAS_QUANT_KERNEL<uint8_t, uint8_t>::DepthwiseKernel* ConvDepthwiseU8U8Kernel;
     MLAS_QUANT_KERNEL<int8_t, int8_t>::DepthwiseKernel* ConvDepthwiseS8S8Kernel;
     MLAS_QUANT_KERNEL<int8_t, uint8_t>::DepthwiseKernel* ConvDepthwiseS8U8Kernel;
+    MLAS_GEMM_S16S8_KERNEL* GemmS16S8Kernel;
 
 #if defined(MLAS_TARGET_POWER)
     MLAS_GEMM_DOUBLE_KERNEL* GemmDoubleKernel;
@@ -880,6 +999,8 @@ struct MLAS_PLATFORM {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
+    MLAS_CAST_F16_TO_F32_KERNEL* CastF16ToF32Kernel{nullptr};
+    MLAS_CAST_F32_TO_F16_KERNEL* CastF32ToF16Kernel{nullptr};
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
     int32_t MaximumThreadCount;
@@ -1022,7 +1143,7 @@ MlasFp32FromBits(
 #pragma warning(pop)
 #endif
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_SUPPORTS_CONV_DEPTHWISE_FLOAT)
 
 void
 MLASCALL
@@ -36,6 +36,10 @@ Abstract:
 MLASCPUIDInfo::MLASCPUIDInfo()
 {
     has_arm_neon_dot_ = (IsProcessorFeaturePresent(PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE) != 0);
+
+    // Windows does not report the FP16 extension. Every ARMv8.2 processor
+    // with the dot product extension that Windows runs on also has it.
+    has_fp16_ = has_arm_neon_dot_;
 }
 #endif
 
@@ -48,9 +52,20 @@ MLASCPUIDInfo::MLASCPUIDInfo()
 #ifndef HWCAP_ASIMDDP
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
+#ifndef HWCAP_ASIMDHP
+#define HWCAP_ASIMDHP (1 << 10)
+#endif
+#ifndef HWCAP2_BF16
+#define HWCAP2_BF16 (1 << 14)
+#endif
 
 #if defined(BUILD_MLAS_NO_ONNXRUNTIME)
-MLASCPUIDInfo::MLASCPUIDInfo() { has_arm_neon_dot_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0); }
+MLASCPUIDInfo::MLASCPUIDInfo()
+{
+    has_arm_neon_dot_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0);
+    has_fp16_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDHP) != 0);
+    has_arm_bf16_ = ((getauxval(AT_HWCAP2) & HWCAP2_BF16) != 0);
+}
 #endif
 
 #else
@@ -125,6 +140,33 @@ MlasReadExtendedControlRegister(
 #endif
 }
 
+#if defined(MLAS_AMX_INTRINSICS_SUPPORTED) || defined(MLAS_AMX_INT8_INTRINSICS_SUPPORTED)
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+//
+// Linux only grants the AMX tile data state to processes that request it.
+//
+
+#ifndef ARCH_REQ_XCOMP_PERM
+#define ARCH_REQ_XCOMP_PERM 0x1023
+#endif
+#ifndef XFEATURE_XTILEDATA
+#define XFEATURE_XTILEDATA 18
+#endif
+
+inline
+bool
+MlasRequestAmxPermission(
+    void
+)
+{
+    return syscall(SYS_arch_prctl, ARCH_REQ_XCOMP_PERM, XFEATURE_XTILEDATA) == 0;
+}
+
+#endif
+
 #endif
 
 MLAS_PLATFORM::MLAS_PLATFORM(
@@ -151,6 +193,7 @@ Return Value:
     this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernel<uint8_t, uint8_t>;
     this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernel<int8_t, int8_t>;
     this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernel<int8_t, uint8_t>;
+    this->GemmS16S8Kernel = MlasGemmS16S8Kernel;
 
 #if defined(MLAS_TARGET_AMD64_IX86)
 
@@ -266,6 +309,7 @@ Return Value:
                 this->GemmU8U8Dispatch = &MlasGemmU8U8DispatchAvx2;
                 this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx2;
                 this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx2;
+                this->Q4GemmDispatch = &MlasQ4GemmDispatchAvx2;
 
                 this->GemmFloatKernel = MlasGemmFloatKernelFma3;
                 this->GemmDoubleKernel = MlasGemmDoubleKernelFma3;
@@ -283,8 +327,19 @@ Return Value:
                 this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t, uint8_t>;
                 this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
+                this->GemmS16S8Kernel = MlasGemmS16S8KernelAvx2;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
 
+                //
+                // Check if the processor supports the F16C half precision
+                // conversion instructions.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->CastF16ToF32Kernel = MlasCastF16ToF32KernelAvx2;
+                    this->CastF32ToF16Kernel = MlasCastF32ToF16KernelAvx2;
+                }
+
                 //
                 // Check if the processor supports Hybrid core architecture.
                 //
@@ -359,7 +414,68 @@ Return Value:
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
+
+#if defined(MLAS_AMX_INT8_INTRINSICS_SUPPORTED)
+
+                            //
+                            // Check if the processor supports AMX-TILE and
+                            // AMX-INT8, the operating system supports saving
+                            // the tile state and this process may use it.
+                            //
+
+                            if (((Cpuid7[3] & 0x3000000) == 0x3000000) &&
+                                ((xcr0 & 0x60000) == 0x60000) &&
+                                MlasRequestAmxPermission()) {
+
+                                this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                                this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
+                            }
+
+#endif // MLAS_AMX_INT8_INTRINSICS_SUPPORTED
                         }
+
+#if defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+
+                        //
+                        // Check if the processor supports AVX512-FP16.
+                        //
+
+                        if ((Cpuid7[3] & 0x800000) != 0) {
+
+                            this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx512Fp16;
+                        }
+
+#endif // MLAS_AVX512FP16_INTRINSICS_SUPPORTED
+
+#if defined(MLAS_AVX512BF16_INTRINSICS_SUPPORTED)
+
+                        //
+                        // Check if the processor supports AVX512-BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAvx512Bf16;
+
+#if defined(MLAS_AMX_INTRINSICS_SUPPORTED)
+
+                            //
+                            // Check if the processor supports AMX-TILE and
+                            // AMX-BF16, the operating system supports saving
+                            // the tile state and this process may use it.
+                            //
+
+                            if (((Cpuid7[3] & 0x1400000) == 0x1400000) &&
+                                ((xcr0 & 0x60000) == 0x60000) &&
+                                MlasRequestAmxPermission()) {
+
+                                this->SBGemmDispatch = &MlasSBGemmDispatchAmx;
+                            }
+
+#endif // MLAS_AMX_INTRINSICS_SUPPORTED
+                        }
+
+#endif // MLAS_AVX512BF16_INTRINSICS_SUPPORTED
                     }
                 }
 
@@ -380,6 +496,7 @@ Return Value:
     this->SymmQgemmDispatch = &MlasSymmQgemmS8DispatchNeon;
     this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchNeon;
     this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchNeon;
+    this->GemmS16S8Kernel = MlasGemmS16S8KernelNeon;
 
     //
     // Check if the processor supports ASIMD dot product instructions.
@@ -402,6 +519,30 @@ Return Value:
         this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchDot;
     }
 
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED)
+
+    //
+    // Check if the processor supports half precision vector arithmetic.
+    //
+
+    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasFp16VectorAcceleration()) {
+        this->HalfGemmDispatch = &MlasHalfGemmDispatchNeon;
+    }
+
+#endif // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
+#if defined(MLAS_BF16VEC_INTRINSICS_SUPPORTED)
+
+    //
+    // Check if the processor supports the bfloat16 dot product instructions.
+    //
+
+    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmBf16()) {
+        this->SBGemmDispatch = &MlasSBGemmDispatchNeon;
+    }
+
+#endif // MLAS_BF16VEC_INTRINSICS_SUPPORTED
+
 #endif // MLAS_TARGET_ARM64
 #if defined(MLAS_TARGET_POWER)
     this->GemmFloatKernel = MlasSgemmKernel;
@@ -1616,3 +1616,105 @@ MlasMaximumPool<uint8_t>(
     size_t OutputCount,
     size_t KernelSize
     );
+
+void
+MLASCALL
+MlasMaximumPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision maximum pooling operation.
+
+    The input is supplied as an indirection buffer as for the 8-bit variant.
+    The padding vector should hold the lowest float value, so that it never
+    wins over an input element.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    Output - Supplies the output tensor in channels last format.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (OutputCount > 0) {
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 8) {
+
+            MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+            MLAS_FLOAT32X4 MaximumVector1 = MaximumVector0;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+                MLAS_FLOAT32X4 InputVector1 = MlasLoadFloat32x4(&Input[k][ChannelOffset + 4]);
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, InputVector0);
+                MaximumVector1 = MlasMaximumFloat32x4(MaximumVector1, InputVector1);
+            }
+
+            MlasStoreFloat32x4(&Output[0], MaximumVector0);
+            MlasStoreFloat32x4(&Output[4], MaximumVector1);
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
+        if (c >= 4) {
+
+            MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, InputVector0);
+            }
+
+            MlasStoreFloat32x4(&Output[0], MaximumVector0);
+            Output += 4;
+
+            ChannelOffset += 4;
+            c -= 4;
+        }
+
+        while (c > 0) {
+
+            float MaximumValue = std::numeric_limits<float>::lowest();
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                MaximumValue = std::max(MaximumValue, Input[k][ChannelOffset]);
+            }
+
+            *Output++ = MaximumValue;
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
@@ -0,0 +1,530 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.cpp
+
+Abstract:
+
+    This module implements the matrix/matrix multiply operation with block-wise
+    4-bit quantized matrix B (Q4GEMM), the quantization of matrix B and the
+    portable kernels.
+
+    Skinny multiplications, which are bound by the memory bandwidth, use a
+    fused kernel that decodes the quantized blocks as it computes the dot
+    products. Larger multiplications dequantize panels of matrix B and reuse
+    the SGEMM kernels.
+
+--*/
+
+#include "q4gemm.h"
+
+#include <algorithm>
+#include <cmath>
+
+size_t
+MLASCALL
+MlasQ4GemmKernelDefault(
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 4 rows of matrix C, decoding each block of
+    matrix B once for all of the rows.
+
+Arguments:
+
+    See MLAS_Q4GEMM_KERNEL.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t RowCount = std::min(CountM, size_t(4));
+    const size_t BlockCountK = MlasQ4GemmBlockCountK(CountK, BlkLen);
+    const size_t ZeroPointBytes = MlasQ4GemmZeroPointBytesPerColumn(BlockCountK);
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        const uint8_t* Data = QuantBData + n * BlockCountK * (BlkLen / 2);
+        const float* Scale = QuantBScale + n * BlockCountK;
+        const uint8_t* ZeroPoint = (QuantBZeroPoint != nullptr) ? QuantBZeroPoint + n * ZeroPointBytes : nullptr;
+
+        float Accumulators[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+        for (size_t b = 0; b < BlockCountK; b++) {
+
+            const size_t k = b * BlkLen;
+            const size_t CountKBlock = std::min(CountK - k, BlkLen);
+            const int Offset = MlasQ4GemmZeroPoint(ZeroPoint, b);
+
+            for (size_t kk = 0; kk < CountKBlock; kk++) {
+
+                const uint8_t Packed = Data[kk / 2];
+                const int Value = (kk & 1) ? (Packed >> 4) : (Packed & 0x0F);
+                const float ElementB = float(Value - Offset) * Scale[b];
+
+                for (size_t r = 0; r < RowCount; r++) {
+                    Accumulators[r] += A[r * lda + k + kk] * ElementB;
+                }
+            }
+
+            Data += BlkLen / 2;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            C[r * ldc + n] = Accumulators[r] + ((Bias != nullptr) ? Bias[n] : 0.0f);
+        }
+    }
+
+    return RowCount;
+}
+
+void
+MLASCALL
+MlasQ4GemmDequantizeKernelDefault(
+    size_t BlkLen,
+    float* D,
+    size_t ldd,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t StartBlock,
+    size_t CountN,
+    size_t CountBlocks,
+    size_t BlockCountK
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes whole blocks of a set of columns of matrix B.
+
+Arguments:
+
+    See MLAS_Q4GEMM_DEQUANTIZE_KERNEL.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t ZeroPointBytes = MlasQ4GemmZeroPointBytesPerColumn(BlockCountK);
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        const uint8_t* Data = QuantBData + (n * BlockCountK + StartBlock) * (BlkLen / 2);
+        const float* Scale = QuantBScale + n * BlockCountK;
+        const uint8_t* ZeroPoint = (QuantBZeroPoint != nullptr) ? QuantBZeroPoint + n * ZeroPointBytes : nullptr;
+
+        float* d = D + n * ldd;
+
+        for (size_t b = StartBlock; b < StartBlock + CountBlocks; b++) {
+
+            const int Offset = MlasQ4GemmZeroPoint(ZeroPoint, b);
+
+            for (size_t i = 0; i < BlkLen / 2; i++) {
+                d[i * 2] = float(int(Data[i] & 0x0F) - Offset) * Scale[b];
+                d[i * 2 + 1] = float(int(Data[i] >> 4) - Offset) * Scale[b];
+            }
+
+            Data += BlkLen / 2;
+            d += BlkLen;
+        }
+    }
+}
+
+const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchDefault = {
+    MlasQ4GemmKernelDefault,
+    MlasQ4GemmDequantizeKernelDefault,
+};
+
+void
+MlasQ4GemmOperation(
+    const size_t M,
+    const size_t RangeStartN,
+    const size_t RangeCountN,
+    const size_t K,
+    const size_t BlkLen,
+    const MLAS_Q4GEMM_DATA_PARAMS* DataParams,
+    const size_t RangeStartM
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a rectangle of matrix C.
+
+Arguments:
+
+    M - Supplies the number of rows of the rectangle.
+
+    RangeStartN - Supplies the first column of the rectangle.
+
+    RangeCountN - Supplies the number of columns of the rectangle.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    BlkLen - Supplies the number of rows of matrix B in a block.
+
+    DataParams - Supplies the data position and layout of the matrices.
+
+    RangeStartM - Supplies the first row of the rectangle.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_Q4GEMM_DISPATCH* Dispatch = GetMlasPlatform().Q4GemmDispatch;
+
+    const size_t lda = DataParams->lda;
+    const size_t ldc = DataParams->ldc;
+
+    const size_t BlockCountK = MlasQ4GemmBlockCountK(K, BlkLen);
+    const size_t ZeroPointBytes = MlasQ4GemmZeroPointBytesPerColumn(BlockCountK);
+
+    const float* A = DataParams->A + RangeStartM * lda;
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+    const float* Bias = (DataParams->Bias != nullptr) ? DataParams->Bias + RangeStartN : nullptr;
+
+    const uint8_t* QuantBData = DataParams->QuantBData + RangeStartN * BlockCountK * (BlkLen / 2);
+    const float* QuantBScale = DataParams->QuantBScale + RangeStartN * BlockCountK;
+    const uint8_t* QuantBZeroPoint = (DataParams->QuantBZeroPoint != nullptr) ?
+        DataParams->QuantBZeroPoint + RangeStartN * ZeroPointBytes : nullptr;
+
+    if (K == 0) {
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < RangeCountN; n++) {
+                C[m * ldc + n] = (Bias != nullptr) ? Bias[n] : 0.0f;
+            }
+        }
+        return;
+    }
+
+    if (M < MLAS_Q4GEMM_DEQUANTIZE_MIN_M) {
+
+        for (size_t m = 0; m < M;) {
+            m += Dispatch->Kernel(BlkLen, A + m * lda, QuantBData, QuantBScale, QuantBZeroPoint,
+                                  C + m * ldc, M - m, RangeCountN, K, lda, ldc, Bias);
+        }
+
+        return;
+    }
+
+    //
+    // Dequantize a panel of transposed matrix B at a time and multiply it with
+    // the SGEMM kernels. The panel depth is a multiple of the block length, so
+    // only whole blocks are dequantized.
+    //
+
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_Q4GEMM_STRIDEN * MLAS_Q4GEMM_STRIDEK], 64);
+
+    for (size_t n = 0; n < RangeCountN; n += MLAS_Q4GEMM_STRIDEN) {
+
+        const size_t CountN = std::min(RangeCountN - n, size_t(MLAS_Q4GEMM_STRIDEN));
+
+        float Beta = 0.0f;
+
+        if (Bias != nullptr) {
+            for (size_t m = 0; m < M; m++) {
+                std::copy_n(Bias + n, CountN, C + m * ldc + n);
+            }
+            Beta = 1.0f;
+        }
+
+        for (size_t k = 0; k < K; k += MLAS_Q4GEMM_STRIDEK) {
+
+            const size_t CountK = std::min(K - k, size_t(MLAS_Q4GEMM_STRIDEK));
+
+            Dispatch->DequantizeKernel(BlkLen, PanelB, MLAS_Q4GEMM_STRIDEK,
+                                       QuantBData + n * BlockCountK * (BlkLen / 2),
+                                       QuantBScale + n * BlockCountK,
+                                       (QuantBZeroPoint != nullptr) ? QuantBZeroPoint + n * ZeroPointBytes : nullptr,
+                                       k / BlkLen, CountN, MlasQ4GemmBlockCountK(CountK, BlkLen), BlockCountK);
+
+            MlasGemm(CblasNoTrans, CblasTrans, M, CountN, CountK, 1.0f, A + k, lda,
+                     PanelB, MLAS_Q4GEMM_STRIDEK, Beta, C + n, ldc, nullptr);
+
+            Beta = 1.0f;
+        }
+    }
+}
+
+void
+MlasQ4GemmThreaded(
+    const ptrdiff_t ThreadCountM,
+    const ptrdiff_t ThreadCountN,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BlkLen,
+    const MLAS_Q4GEMM_DATA_PARAMS* DataParams,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Q4GEMM operation.
+
+Arguments:
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    M, N, K - Supplies the shape of the multiplication.
+
+    BlkLen - Supplies the number of rows of matrix B in a block.
+
+    DataParams - Supplies the data position and layout of the matrices.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdM = ThreadId / ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    MlasPartitionWork(ThreadIdN, ThreadCountN, N, &RangeStartN, &RangeCountN);
+
+    if (RangeCountM == 0 || RangeCountN == 0) {
+        return;
+    }
+
+    MlasQ4GemmOperation(RangeCountM, RangeStartN, RangeCountN, K, BlkLen, DataParams, RangeStartM);
+}
+
+bool
+MLASCALL
+MlasQ4GemmIsBlkLenSupported(
+    size_t BlkLen
+    )
+{
+    return BlkLen == 32 || BlkLen == 64 || BlkLen == 128 || BlkLen == 256;
+}
+
+void
+MLASCALL
+MlasQ4GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    size_t BatchN,
+    const MLAS_Q4GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    //
+    // Compute the number of target threads given the complexity of the Q4GEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_Q4GEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_Q4GEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads.
+    //
+    // N.B. The fused kernel is bound by the bandwidth of matrix B, so skinny
+    // multiplications are partitioned along N so that each thread streams a
+    // distinct part of matrix B.
+    //
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchN - 1) / BatchN;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (M < MLAS_Q4GEMM_DEQUANTIZE_MIN_M || N > M) {
+
+        const size_t BlockedN = (N + MLAS_Q4GEMM_STRIDEN - 1) / MLAS_Q4GEMM_STRIDEN;
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    if (ThreadsPerGemm == 0) {
+        ThreadsPerGemm = 1;
+        ThreadCountM = 1;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchN),
+        [=](ptrdiff_t tid)
+    {
+        ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        MlasQ4GemmThreaded(ThreadCountM, ThreadCountN, M, N, K, BlkLen, &(DataParams[GemmIdx]), ThreadIdx);
+    });
+}
+
+void
+MLASCALL
+MlasQ4GemmQuantizeB(
+    size_t BlkLen,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    uint8_t* QuantBData,
+    float* QuantBScale,
+    uint8_t* QuantBZeroPoint
+    )
+{
+    const size_t BlockCountK = MlasQ4GemmBlockCountK(K, BlkLen);
+    const size_t ZeroPointBytes = MlasQ4GemmZeroPointBytesPerColumn(BlockCountK);
+
+    if (QuantBZeroPoint != nullptr) {
+        std::fill_n(QuantBZeroPoint, N * ZeroPointBytes, uint8_t(0));
+    }
+
+    for (size_t n = 0; n < N; n++) {
+
+        uint8_t* Data = QuantBData + n * BlockCountK * (BlkLen / 2);
+
+        for (size_t b = 0; b < BlockCountK; b++) {
+
+            const size_t k = b * BlkLen;
+            const size_t CountKBlock = std::min(K - k, BlkLen);
+
+            float Scale;
+            int ZeroPoint;
+
+            if (QuantBZeroPoint != nullptr) {
+
+                //
+                // Asymmetric quantization of the block range, which is
+                // extended to include zero so that zero is exact.
+                //
+
+                float Minimum = 0.0f;
+                float Maximum = 0.0f;
+
+                for (size_t kk = 0; kk < CountKBlock; kk++) {
+                    Minimum = std::min(Minimum, B[(k + kk) * ldb + n]);
+                    Maximum = std::max(Maximum, B[(k + kk) * ldb + n]);
+                }
+
+                Scale = (Maximum - Minimum) / 15.0f;
+                ZeroPoint = (Scale != 0.0f) ? int(std::nearbyintf(-Minimum / Scale)) : 0;
+                ZeroPoint = std::min(std::max(ZeroPoint, 0), 15);
+
+                uint8_t& Packed = QuantBZeroPoint[n * ZeroPointBytes + b / 2];
+                Packed |= uint8_t(ZeroPoint << ((b & 1) * 4));
+
+            } else {
+
+                //
+                // Symmetric quantization, the element of largest magnitude
+                // maps to -8.
+                //
+
+                float Extreme = 0.0f;
+
+                for (size_t kk = 0; kk < CountKBlock; kk++) {
+                    const float Value = B[(k + kk) * ldb + n];
+                    if (std::fabs(Value) > std::fabs(Extreme)) {
+                        Extreme = Value;
+                    }
+                }
+
+                Scale = Extreme / -8.0f;
+                ZeroPoint = MLAS_Q4GEMM_DEFAULT_ZERO_POINT;
+            }
+
+            QuantBScale[n * BlockCountK + b] = Scale;
+
+            const float ReciprocalScale = (Scale != 0.0f) ? 1.0f / Scale : 0.0f;
+
+            for (size_t kk = 0; kk < BlkLen; kk += 2) {
+
+                int Values[2];
+
+                for (size_t i = 0; i < 2; i++) {
+                    if (kk + i < CountKBlock) {
+                        const int q = int(std::nearbyintf(B[(k + kk + i) * ldb + n] * ReciprocalScale)) + ZeroPoint;
+                        Values[i] = std::min(std::max(q, 0), 15);
+                    } else {
+                        Values[i] = ZeroPoint;
+                    }
+                }
+
+                Data[kk / 2] = uint8_t(Values[0] | (Values[1] << 4));
+            }
+
+            Data += BlkLen / 2;
+        }
+    }
+}
@@ -0,0 +1,229 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.h
+
+Abstract:
+
+    This module defines the kernel interface and the dispatch structure of the
+    matrix/matrix multiply operation with block-wise 4-bit quantized matrix B
+    (Q4GEMM).
+
+    See MLAS_Q4GEMM_DATA_PARAMS for the layout of the quantized data. Kernels
+    process blocks in chunks of MLAS_Q4GEMM_CHUNK_K rows: the 16 bytes of a
+    chunk hold elements 2 * i and 2 * i + 1 in byte i, so splitting the low
+    and high nibbles and interleaving them restores the row order.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+//
+// Define the number of rows of matrix B decoded by a kernel step. All the
+// supported block lengths are multiples of this number.
+//
+
+#define MLAS_Q4GEMM_CHUNK_K                         32
+
+//
+// Define the zero point used when the quantized data has none.
+//
+
+#define MLAS_Q4GEMM_DEFAULT_ZERO_POINT              8
+
+//
+// Define the minimum number of rows of matrix A for which a block of matrix B
+// is dequantized to single precision and multiplied by the SGEMM kernels.
+// Below this number, the dequantization cost is not amortized and the fused
+// kernel, which streams the quantized data once, is faster.
+//
+
+#define MLAS_Q4GEMM_DEQUANTIZE_MIN_M                32
+
+//
+// Define the block of matrix B dequantized at a time by the SGEMM path. The
+// number of rows is a multiple of all the supported block lengths.
+//
+
+#define MLAS_Q4GEMM_STRIDEN                         64
+#define MLAS_Q4GEMM_STRIDEK                         256
+
+//
+// Define the target number of per-thread multiplies before using another
+// thread to perform additional work.
+//
+
+#define MLAS_Q4GEMM_THREAD_COMPLEXITY               (64 * 1024)
+
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows and all of the K dimension.
+
+Arguments:
+
+    BlkLen - Supplies the number of rows of matrix B in a block.
+
+    A - Supplies the address of matrix A.
+
+    QuantBData - Supplies the quantized data of the first column of matrix B.
+
+    QuantBScale - Supplies the block scales of the first column of matrix B.
+
+    QuantBZeroPoint - Supplies the block zero points of the first column of
+        matrix B, else nullptr.
+
+    C - Supplies the address of matrix C.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix C.
+
+    CountK - Supplies the number of columns of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Supplies the optional bias vector of CountN elements.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+
+typedef
+size_t
+(MLASCALL MLAS_Q4GEMM_KERNEL)(
+    size_t BlkLen,
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    );
+
+/*++
+
+Routine Description:
+
+    This routine dequantizes whole blocks of a set of columns of matrix B. The
+    columns are stored contiguously, i.e. the output is the transposed block of
+    matrix B.
+
+Arguments:
+
+    BlkLen - Supplies the number of rows of matrix B in a block.
+
+    D - Supplies the address of the dequantized columns.
+
+    ldd - Supplies the number of elements between two dequantized columns.
+
+    QuantBData - Supplies the quantized data of the first column.
+
+    QuantBScale - Supplies the block scales of the first column.
+
+    QuantBZeroPoint - Supplies the block zero points of the first column,
+        else nullptr.
+
+    StartBlock - Supplies the index of the first block to convert in a column.
+
+    CountN - Supplies the number of columns to convert.
+
+    CountBlocks - Supplies the number of blocks to convert in each column.
+
+    BlockCountK - Supplies the number of blocks of a column.
+
+Return Value:
+
+    None.
+
+--*/
+
+typedef
+void
+(MLASCALL MLAS_Q4GEMM_DEQUANTIZE_KERNEL)(
+    size_t BlkLen,
+    float* D,
+    size_t ldd,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t StartBlock,
+    size_t CountN,
+    size_t CountBlocks,
+    size_t BlockCountK
+    );
+
+struct MLAS_Q4GEMM_DISPATCH {
+    MLAS_Q4GEMM_KERNEL* Kernel;
+    MLAS_Q4GEMM_DEQUANTIZE_KERNEL* DequantizeKernel;
+};
+
+extern const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchDefault;
+extern const MLAS_Q4GEMM_DISPATCH MlasQ4GemmDispatchAvx2;
+
+//
+// Returns the number of blocks of a column of matrix B.
+//
+
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmBlockCountK(
+    size_t K,
+    size_t BlkLen
+    )
+{
+    return (K + BlkLen - 1) / BlkLen;
+}
+
+//
+// Returns the number of bytes of zero points of a column of matrix B.
+//
+
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmZeroPointBytesPerColumn(
+    size_t BlockCountK
+    )
+{
+    return (BlockCountK + 1) / 2;
+}
+
+//
+// Returns the zero point of a block of a column of matrix B.
+//
+
+MLAS_FORCEINLINE
+int
+MlasQ4GemmZeroPoint(
+    const uint8_t* QuantBZeroPoint,
+    size_t Block
+    )
+{
+    if (QuantBZeroPoint == nullptr) {
+        return MLAS_Q4GEMM_DEFAULT_ZERO_POINT;
+    }
+
+    const uint8_t Packed = QuantBZeroPoint[Block / 2];
+
+    return (Block & 1) ? (Packed >> 4) : (Packed & 0x0F);
+}
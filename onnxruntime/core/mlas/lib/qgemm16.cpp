@@ -0,0 +1,503 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm16.cpp
+
+Abstract:
+
+    This module implements the matrix/matrix multiply operation of 16-bit
+    quantized activations by 8-bit quantized weights.
+
+    The weights are widened to int16 with their zero point subtracted, so
+    that pairs of products accumulate to int32 with a single multiply-add
+    instruction (vpmaddwd on AVX2, smlal on ARM64). The zero point of the
+    activations is applied through the column sums of the weights.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of the operation on worker
+// threads.
+//
+
+struct MLAS_GEMM_S16S8_WORK_BLOCK {
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+    size_t M;
+    size_t N;
+    size_t K;
+};
+
+size_t
+MLASCALL
+MlasGemmS16S8Kernel(
+    const int16_t* A,
+    size_t lda,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the portable kernel of the int16 by int8 matrix/matrix
+    multiply operation, which processes a single row of A.
+
+Arguments:
+
+    A - Supplies the address of the row of matrix A.
+
+    lda - Supplies the leading dimension of matrix A.
+
+    PackedB - Supplies the address of the panel of matrix B packed by pairs
+        of rows to MLAS_GEMM_S16S8_STRIDEN columns.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the leading dimension of matrix C.
+
+    CountM - Supplies the maximum number of rows to process.
+
+    CountN - Supplies the number of columns to process.
+
+    CountK - Supplies the number of columns of A in the panel.
+
+    ColumnSumBuffer - Supplies the column sums added in ZeroMode.
+
+    ZeroMode - Supplies true if the output is stored rather than accumulated.
+
+Return Value:
+
+    Returns the number of rows processed.
+
+--*/
+{
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+    MLAS_UNREFERENCED_PARAMETER(CountM);
+
+    int32_t Accumulators[MLAS_GEMM_S16S8_STRIDEN] = {};
+
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        const int32_t a0 = A[k];
+        const int32_t a1 = (k + 1 < CountK) ? A[k + 1] : 0;
+
+        for (size_t n = 0; n < MLAS_GEMM_S16S8_STRIDEN; n++) {
+            Accumulators[n] += a0 * PackedB[n * 2] + a1 * PackedB[n * 2 + 1];
+        }
+
+        PackedB += MLAS_GEMM_S16S8_STRIDEN * 2;
+    }
+
+    for (size_t n = 0; n < CountN; n++) {
+        C[n] = Accumulators[n] + (ZeroMode ? ColumnSumBuffer[n] : C[n]);
+    }
+
+    return 1;
+}
+
+#if defined(MLAS_TARGET_ARM64)
+
+MLAS_FORCEINLINE
+void
+MlasGemmS16S8StoreRowNeon(
+    const int32x4_t Accumulators[8],
+    int32_t* C,
+    size_t CountN,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    )
+{
+    //
+    // Each pair of accumulators holds the sums of the even and odd rows of B
+    // of four columns.
+    //
+
+    MLAS_DECLSPEC_ALIGN(int32_t Row[MLAS_GEMM_S16S8_STRIDEN], 16);
+
+    for (size_t j = 0; j < 4; j++) {
+        vst1q_s32(&Row[j * 4], vpaddq_s32(Accumulators[j * 2], Accumulators[j * 2 + 1]));
+    }
+
+    for (size_t n = 0; n < CountN; n++) {
+        C[n] = Row[n] + (ZeroMode ? ColumnSumBuffer[n] : C[n]);
+    }
+}
+
+size_t
+MLASCALL
+MlasGemmS16S8KernelNeon(
+    const int16_t* A,
+    size_t lda,
+    const int16_t* PackedB,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the NEON kernel of the int16 by int8 matrix/matrix
+    multiply operation, which processes up to two rows of A.
+
+Arguments:
+
+    See MlasGemmS16S8Kernel.
+
+Return Value:
+
+    Returns the number of rows processed.
+
+--*/
+{
+    const bool ProcessTwoRows = CountM >= 2;
+
+    int32x4_t Accumulators0[8];
+    int32x4_t Accumulators1[8];
+
+    for (size_t j = 0; j < 8; j++) {
+        Accumulators0[j] = vdupq_n_s32(0);
+        Accumulators1[j] = vdupq_n_s32(0);
+    }
+
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        //
+        // Multiply the pair of elements of each row of A, duplicated across
+        // the vector, by the interleaved pairs of rows of B.
+        //
+
+        const int16x8_t APair0 = vreinterpretq_s16_s32(vdupq_n_s32(MlasGemmS16S8LoadPairA(&A[k], CountK - k)));
+        const int16x8_t APair1 = ProcessTwoRows ?
+            vreinterpretq_s16_s32(vdupq_n_s32(MlasGemmS16S8LoadPairA(&A[lda + k], CountK - k))) : APair0;
+
+        for (size_t j = 0; j < 4; j++) {
+
+            const int16x8_t BElements = vld1q_s16(&PackedB[j * 8]);
+
+            Accumulators0[j * 2] = vmlal_s16(Accumulators0[j * 2], vget_low_s16(BElements), vget_low_s16(APair0));
+            Accumulators0[j * 2 + 1] = vmlal_high_s16(Accumulators0[j * 2 + 1], BElements, APair0);
+            Accumulators1[j * 2] = vmlal_s16(Accumulators1[j * 2], vget_low_s16(BElements), vget_low_s16(APair1));
+            Accumulators1[j * 2 + 1] = vmlal_high_s16(Accumulators1[j * 2 + 1], BElements, APair1);
+        }
+
+        PackedB += MLAS_GEMM_S16S8_STRIDEN * 2;
+    }
+
+    MlasGemmS16S8StoreRowNeon(Accumulators0, C, CountN, ColumnSumBuffer, ZeroMode);
+
+    if (ProcessTwoRows) {
+        MlasGemmS16S8StoreRowNeon(Accumulators1, C + ldc, CountN, ColumnSumBuffer, ZeroMode);
+        return 2;
+    }
+
+    return 1;
+}
+
+#endif
+
+void
+MlasGemmS16S8PackB(
+    const int8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    const int32_t* ZeroPointB,
+    int16_t* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs a panel of matrix B to MLAS_GEMM_S16S8_STRIDEN int16
+    columns with the zero points subtracted, interleaving the elements of the
+    pairs of rows. The padding columns and the padding row are zero.
+
+--*/
+{
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        const int8_t* b0 = B + k * ldb;
+        const int8_t* b1 = b0 + ldb;
+        const bool HasSecondRow = k + 1 < CountK;
+
+        for (size_t n = 0; n < MLAS_GEMM_S16S8_STRIDEN; n++) {
+            int16_t Element0 = 0;
+            int16_t Element1 = 0;
+            if (n < CountN) {
+                Element0 = int16_t(b0[n] - ZeroPointB[n]);
+                Element1 = HasSecondRow ? int16_t(b1[n] - ZeroPointB[n]) : 0;
+            }
+            PackedB[n * 2] = Element0;
+            PackedB[n * 2 + 1] = Element1;
+        }
+
+        PackedB += MLAS_GEMM_S16S8_STRIDEN * 2;
+    }
+}
+
+void
+MlasGemmS16S8Operation(
+    const MLAS_GEMM_S16S8_DATA_PARAMS* Data,
+    size_t K,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the int16 by int8 matrix/matrix multiply operation
+    for a segment of the output matrix.
+
+Arguments:
+
+    Data - Supplies the structure containing the GEMM input and output data.
+
+    K - Supplies the number of columns of A and rows of B.
+
+    RangeStartM - Supplies the starting row index of the output matrix.
+
+    RangeCountM - Supplies the number of rows of the output matrix.
+
+    RangeStartN - Supplies the starting column index of the output matrix.
+
+    RangeCountN - Supplies the number of columns of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(int16_t PanelB[MLAS_GEMM_S16S8_STRIDEK * MLAS_GEMM_S16S8_STRIDEN], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t ColumnSumBuffer[MLAS_GEMM_S16S8_STRIDEN], 64);
+    int32_t ZeroPointB[MLAS_GEMM_S16S8_STRIDEN];
+
+    MLAS_GEMM_S16S8_KERNEL* Kernel = GetMlasPlatform().GemmS16S8Kernel;
+
+    const size_t lda = Data->lda;
+    const size_t ldb = Data->ldb;
+    const size_t ldc = Data->ldc;
+
+    for (size_t n = 0; n < RangeCountN; n += MLAS_GEMM_S16S8_STRIDEN) {
+
+        const size_t StartN = RangeStartN + n;
+        const size_t CountN = std::min(RangeCountN - n, size_t(MLAS_GEMM_S16S8_STRIDEN));
+
+        for (size_t nn = 0; nn < MLAS_GEMM_S16S8_STRIDEN; nn++) {
+            int32_t ZeroPoint = 0;
+            if (Data->ZeroPointB != nullptr && nn < CountN) {
+                ZeroPoint = Data->PerColumnZeroPoints ? Data->ZeroPointB[StartN + nn] : Data->ZeroPointB[0];
+            }
+            ZeroPointB[nn] = ZeroPoint;
+            ColumnSumBuffer[nn] = 0;
+        }
+
+        //
+        // The zero point of A is applied by adding the column sums of B,
+        // scaled by the negated zero point, to the output.
+        //
+
+        if (Data->ZeroPointA != 0) {
+
+            const int8_t* b = Data->B + StartN;
+
+            for (size_t k = 0; k < K; k++) {
+                for (size_t nn = 0; nn < CountN; nn++) {
+                    ColumnSumBuffer[nn] += b[nn] - ZeroPointB[nn];
+                }
+                b += ldb;
+            }
+
+            for (size_t nn = 0; nn < CountN; nn++) {
+                ColumnSumBuffer[nn] *= -int32_t(Data->ZeroPointA);
+            }
+        }
+
+        size_t k = 0;
+
+        do {
+
+            const size_t CountK = std::min(K - k, size_t(MLAS_GEMM_S16S8_STRIDEK));
+
+            MlasGemmS16S8PackB(Data->B + k * ldb + StartN, ldb, CountN, CountK, ZeroPointB, PanelB);
+
+            const int16_t* a = Data->A + RangeStartM * lda + k;
+            int32_t* c = Data->C + RangeStartM * ldc + StartN;
+            size_t RowsRemaining = RangeCountM;
+
+            while (RowsRemaining > 0) {
+
+                const size_t RowsHandled = Kernel(a, lda, PanelB, c, ldc, RowsRemaining, CountN, CountK,
+                    ColumnSumBuffer, k == 0);
+
+                a += RowsHandled * lda;
+                c += RowsHandled * ldc;
+                RowsRemaining -= RowsHandled;
+            }
+
+            k += CountK;
+
+        } while (k < K);
+
+        if (Data->OutputProcessor != nullptr) {
+            Data->OutputProcessor->Process(Data->C, RangeStartM, StartN, RangeCountM, CountN, ldc);
+        }
+    }
+}
+
+void
+MlasGemmS16S8Threaded(
+    const MLAS_GEMM_S16S8_WORK_BLOCK* WorkBlock,
+    const MLAS_GEMM_S16S8_DATA_PARAMS* Data,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of an
+    int16 by int8 matrix/matrix multiply operation.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the thread task partition
+        info and the shape of the operation.
+
+    Data - Supplies the structure containing the GEMM input and output data.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdM = ThreadId / WorkBlock->ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % WorkBlock->ThreadCountN;
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, WorkBlock->ThreadCountM, WorkBlock->M, &RangeStartM, &RangeCountM);
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t N = WorkBlock->N;
+    const size_t BlockedN = (N + MLAS_GEMM_S16S8_STRIDEN - 1) / MLAS_GEMM_S16S8_STRIDEN;
+
+    MlasPartitionWork(ThreadIdN, WorkBlock->ThreadCountN, BlockedN, &RangeStartN, &RangeCountN);
+
+    RangeStartN *= MLAS_GEMM_S16S8_STRIDEN;
+    RangeCountN *= MLAS_GEMM_S16S8_STRIDEN;
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    if (RangeCountM > 0 && RangeCountN > 0) {
+        MlasGemmS16S8Operation(Data, WorkBlock->K, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+    }
+}
+
+void
+MLASCALL
+MlasGemmS16S8Batch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_GEMM_S16S8_DATA_PARAMS* DataParams,
+    size_t BatchN,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    ptrdiff_t ThreadsPerGemm = TargetThreadCount / ptrdiff_t(BatchN);
+    if (ThreadsPerGemm < 1) {
+        ThreadsPerGemm = 1;
+    }
+
+    //
+    // Segment the operation across multiple threads as a 1D partition.
+    //
+
+    MLAS_GEMM_S16S8_WORK_BLOCK WorkBlock;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+
+    if (N > M) {
+
+        const size_t BlockedN = (N + MLAS_GEMM_S16S8_STRIDEN - 1) / MLAS_GEMM_S16S8_STRIDEN;
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        WorkBlock.ThreadCountM = 1;
+        WorkBlock.ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        WorkBlock.ThreadCountM = ThreadsPerGemm;
+        WorkBlock.ThreadCountN = 1;
+    }
+
+    if (ThreadsPerGemm < 1) {
+        return;
+    }
+
+    TargetThreadCount = ThreadsPerGemm * ptrdiff_t(BatchN);
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        const auto gemm_i = tid / ThreadsPerGemm;
+        const auto blk_i = tid % ThreadsPerGemm;
+        MlasGemmS16S8Threaded(&WorkBlock, &DataParams[gemm_i], blk_i);
+    });
+}
@@ -0,0 +1,113 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qllookup.cpp
+
+Abstract:
+
+    This module implements the table lookup of 8 bit quantized values used to
+    compute unary functions of quantized tensors.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasQLinearLookupTable(
+    const uint8_t* Input,
+    const uint8_t* Table,
+    uint8_t* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine maps each value of the input through a 256 entry table.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Table - Supplies the 256 entry table.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+
+    //
+    // The table is held in 16 vector registers, one TBL/TBX instruction looking
+    // up 16 values in a quarter of it. TBX leaves the values whose index is out
+    // of the range of its quarter unchanged, which the index wraps to for the
+    // quarters below the value.
+    //
+
+    uint8x16x4_t Table0, Table1, Table2, Table3;
+
+    for (size_t i = 0; i < 4; i++) {
+        Table0.val[i] = vld1q_u8(Table + 16 * i);
+        Table1.val[i] = vld1q_u8(Table + 64 + 16 * i);
+        Table2.val[i] = vld1q_u8(Table + 128 + 16 * i);
+        Table3.val[i] = vld1q_u8(Table + 192 + 16 * i);
+    }
+
+    const uint8x16_t QuarterSize = vdupq_n_u8(64);
+
+    while (N >= 16) {
+
+        uint8x16_t Index = vld1q_u8(Input);
+        uint8x16_t Value = vqtbl4q_u8(Table0, Index);
+        Index = vsubq_u8(Index, QuarterSize);
+        Value = vqtbx4q_u8(Value, Table1, Index);
+        Index = vsubq_u8(Index, QuarterSize);
+        Value = vqtbx4q_u8(Value, Table2, Index);
+        Index = vsubq_u8(Index, QuarterSize);
+        Value = vqtbx4q_u8(Value, Table3, Index);
+        vst1q_u8(Output, Value);
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+#endif
+
+    //
+    // x86 has no byte shuffle over more than 16 entries, and looking up the
+    // table with 16 shuffles per vector is not faster than the loads below.
+    //
+
+    for (; N >= 4; N -= 4) {
+
+        const uint8_t Value0 = Table[Input[0]];
+        const uint8_t Value1 = Table[Input[1]];
+        const uint8_t Value2 = Table[Input[2]];
+        const uint8_t Value3 = Table[Input[3]];
+
+        Output[0] = Value0;
+        Output[1] = Value1;
+        Output[2] = Value2;
+        Output[3] = Value3;
+
+        Input += 4;
+        Output += 4;
+    }
+
+    for (; N > 0; N--) {
+        *Output++ = Table[*Input++];
+    }
+}
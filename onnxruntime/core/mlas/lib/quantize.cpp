@@ -20,6 +20,8 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <cstring>
+
 #if defined(MLAS_NEON64_INTRINSICS) || defined(MLAS_SSE2_INTRINSICS)
 
 //
@@ -274,6 +276,65 @@ MlasQuantizeLinear<uint8_t>(
         Input, Output, N, Scale, ZeroPoint);
 }
 
+template<>
+void
+MLASCALL
+MlasQuantizeLinear<int16_t>(
+    const float* Input,
+    int16_t* Output,
+    size_t N,
+    float Scale,
+    int16_t ZeroPoint
+    )
+{
+    constexpr int32_t MinimumValue = std::numeric_limits<int16_t>::lowest();
+    constexpr int32_t MaximumValue = std::numeric_limits<int16_t>::max();
+
+    auto ScaleVector = MlasBroadcastFloat32x4(Scale);
+    auto MinimumValueVector = MlasBroadcastFloat32x4(float(MinimumValue - ZeroPoint));
+    auto MaximumValueVector = MlasBroadcastFloat32x4(float(MaximumValue - ZeroPoint));
+    auto ZeroPointVector = MlasBroadcastInt32x4(ZeroPoint);
+
+    while (N >= 4) {
+
+        auto FloatVector = MlasLoadFloat32x4(Input);
+        auto IntegerVector = MlasQuantizeLinearVector(FloatVector, ScaleVector,
+            MinimumValueVector, MaximumValueVector, ZeroPointVector);
+
+        //
+        // The values are clamped to the int16 range, so narrowing each int32_t
+        // element is exact.
+        //
+
+#if defined(MLAS_NEON64_INTRINSICS)
+        vst1_s16(Output, vmovn_s32(IntegerVector));
+#else
+        _mm_storel_epi64((__m128i*)Output, _mm_packs_epi32(IntegerVector, IntegerVector));
+#endif
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    for (size_t n = 0; n < N; n++) {
+
+#if defined(MLAS_NEON64_INTRINSICS)
+        auto FloatVector = vld1q_dup_f32(Input + n);
+#else
+        auto FloatVector = _mm_load_ss(Input + n);
+#endif
+        auto IntegerVector = MlasQuantizeLinearVector(FloatVector, ScaleVector,
+            MinimumValueVector, MaximumValueVector, ZeroPointVector);
+
+#if defined(MLAS_NEON64_INTRINSICS)
+        Output[n] = int16_t(vgetq_lane_s32(IntegerVector, 0));
+#else
+        Output[n] = int16_t(_mm_cvtsi128_si32(IntegerVector));
+#endif
+    }
+}
+
 #else
 
 #if defined(MLAS_TARGET_POWER)
@@ -383,6 +444,17 @@ MlasQuantizeLinear<uint8_t>(
     );
 #endif
 
+template
+void
+MLASCALL
+MlasQuantizeLinear<int16_t>(
+    const float* Input,
+    int16_t* Output,
+    size_t N,
+    float Scale,
+    int16_t ZeroPoint
+    );
+
 #endif
 
 #if defined(MLAS_SSE2_INTRINSICS)
@@ -993,6 +1065,322 @@ MlasRequantizeOutput<uint8_t>(
     size_t CountN
     );
 
+template<typename OutputType>
+void
+MLASCALL
+MlasRequantizeOutputAdd(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    const OutputType* Addend,
+    size_t AddendLeadingDimension,
+    OutputType* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerColumnScale,
+    float AddendScale,
+    OutputType AddendZeroPoint,
+    OutputType ZeroPoint,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine requantizes a block of the intermediate buffer to the output
+    buffer after adding a quantized addend matrix, so that a quantized
+    residual add can be applied without first requantizing the intermediate
+    buffer to its own output type:
+
+        Output = Saturate(Round((Input + Bias) * Scale +
+                                (Addend - AddendZeroPoint) * AddendScale) +
+                          ZeroPoint)
+
+Arguments:
+
+    Input - Supplies the intermediate int32 matrix.
+
+    InputLeadingDimension - Supplies the leading dimension of the input.
+
+    Addend - Supplies the quantized matrix to add, with the same shape as the
+        output.
+
+    AddendLeadingDimension - Supplies the leading dimension of the addend.
+
+    Output - Supplies the output matrix.
+
+    OutputLeadingDimension - Supplies the leading dimension of the output.
+
+    Bias - Optionally supplies the per-column bias vector.
+
+    Scale - Supplies the per-matrix or per-column scale of the input, relative
+        to the output scale.
+
+    PerColumnScale - Supplies true if Scale holds one value per column.
+
+    AddendScale - Supplies the scale of the addend, relative to the output
+        scale.
+
+    AddendZeroPoint - Supplies the zero point of the addend.
+
+    ZeroPoint - Supplies the zero point of the output.
+
+    StartM, StartN, CountM, CountN - Supply the block of the matrices to
+        process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float PerMatrixScaleValue = PerColumnScale ? 0.0f : *Scale;
+    const float MinimumValue = float(std::numeric_limits<OutputType>::lowest() - ZeroPoint);
+    const float MaximumValue = float(std::numeric_limits<OutputType>::max() - ZeroPoint);
+
+#if defined(MLAS_SSE2_INTRINSICS)
+    const __m128 PerMatrixScaleVector = _mm_set1_ps(PerMatrixScaleValue);
+    const __m128 AddendScaleVector = _mm_set1_ps(AddendScale);
+    const __m128 MinimumValueVector = _mm_set1_ps(MinimumValue);
+    const __m128 MaximumValueVector = _mm_set1_ps(MaximumValue);
+    const __m128i AddendZeroPointVector = _mm_set1_epi32(AddendZeroPoint);
+    const __m128i ZeroPointVector = _mm_set1_epi32(ZeroPoint);
+#elif defined(MLAS_NEON64_INTRINSICS)
+    const float32x4_t PerMatrixScaleVector = vdupq_n_f32(PerMatrixScaleValue);
+    const float32x4_t AddendScaleVector = vdupq_n_f32(AddendScale);
+    const float32x4_t MinimumValueVector = vdupq_n_f32(MinimumValue);
+    const float32x4_t MaximumValueVector = vdupq_n_f32(MaximumValue);
+    const int32x4_t AddendZeroPointVector = vdupq_n_s32(AddendZeroPoint);
+    const int32x4_t ZeroPointVector = vdupq_n_s32(ZeroPoint);
+#endif
+
+    if (nullptr != Bias) {
+        Bias += StartN;
+    }
+    if (PerColumnScale) {
+        Scale += StartN;
+    }
+
+    Input += StartM * InputLeadingDimension + StartN;
+    Addend += StartM * AddendLeadingDimension + StartN;
+    Output += StartM * OutputLeadingDimension + StartN;
+
+    //
+    // Step through each row of the output matrix.
+    //
+
+    while (CountM-- > 0) {
+
+        const int32_t* bias = Bias;
+        const float* scale = Scale;
+        size_t n = CountN;
+
+        auto* RowInput = Input;
+        auto* RowAddend = Addend;
+        auto* RowOutput = Output;
+
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON64_INTRINSICS)
+
+        //
+        // Process 4 columns of the matrices at a time.
+        //
+
+        while (n >= 4) {
+
+            uint32_t AddendBytes;
+            std::memcpy(&AddendBytes, RowAddend, sizeof(AddendBytes));
+            RowAddend += 4;
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+            __m128i IntegerVector = _mm_loadu_si128((const __m128i*)RowInput);
+            RowInput += 4;
+
+            if (bias != nullptr) {
+                IntegerVector = _mm_add_epi32(IntegerVector, _mm_loadu_si128((const __m128i*)bias));
+                bias += 4;
+            }
+
+            __m128 FloatVector = _mm_cvtepi32_ps(IntegerVector);
+
+            if (PerColumnScale) {
+                FloatVector = _mm_mul_ps(FloatVector, _mm_loadu_ps(scale));
+                scale += 4;
+            } else {
+                FloatVector = _mm_mul_ps(FloatVector, PerMatrixScaleVector);
+            }
+
+            //
+            // Widen the addend bytes to 32 bits by replicating each byte
+            // across its lane and shifting it back down.
+            //
+
+            __m128i AddendVector = _mm_cvtsi32_si128(int32_t(AddendBytes));
+            AddendVector = _mm_unpacklo_epi8(AddendVector, AddendVector);
+            AddendVector = _mm_unpacklo_epi16(AddendVector, AddendVector);
+            if (std::is_signed<OutputType>::value) {
+                AddendVector = _mm_srai_epi32(AddendVector, 24);
+            } else {
+                AddendVector = _mm_srli_epi32(AddendVector, 24);
+            }
+            AddendVector = _mm_sub_epi32(AddendVector, AddendZeroPointVector);
+
+            FloatVector = _mm_add_ps(FloatVector, _mm_mul_ps(_mm_cvtepi32_ps(AddendVector), AddendScaleVector));
+
+            FloatVector = _mm_max_ps(FloatVector, MinimumValueVector);
+            FloatVector = _mm_min_ps(FloatVector, MaximumValueVector);
+
+            IntegerVector = _mm_add_epi32(_mm_cvtps_epi32(FloatVector), ZeroPointVector);
+
+            __m128i ByteVector;
+
+            if (std::is_signed<OutputType>::value) {
+                ByteVector = _mm_packs_epi32(IntegerVector, IntegerVector);
+                ByteVector = _mm_packs_epi16(ByteVector, ByteVector);
+            } else {
+                ByteVector = _mm_packus_epi16(IntegerVector, IntegerVector);
+                ByteVector = _mm_packus_epi16(ByteVector, ByteVector);
+            }
+
+            const uint32_t OutputBytes = uint32_t(_mm_cvtsi128_si32(ByteVector));
+
+#else
+
+            int32x4_t IntegerVector = vld1q_s32(RowInput);
+            RowInput += 4;
+
+            if (bias != nullptr) {
+                IntegerVector = vaddq_s32(IntegerVector, vld1q_s32(bias));
+                bias += 4;
+            }
+
+            float32x4_t FloatVector = vcvtq_f32_s32(IntegerVector);
+
+            if (PerColumnScale) {
+                FloatVector = vmulq_f32(FloatVector, vld1q_f32(scale));
+                scale += 4;
+            } else {
+                FloatVector = vmulq_f32(FloatVector, PerMatrixScaleVector);
+            }
+
+            int32x4_t AddendVector;
+
+            if (std::is_signed<OutputType>::value) {
+                const int16x8_t WordVector = vmovl_s8(vreinterpret_s8_u32(vdup_n_u32(AddendBytes)));
+                AddendVector = vmovl_s16(vget_low_s16(WordVector));
+            } else {
+                const uint16x8_t WordVector = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(AddendBytes)));
+                AddendVector = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(WordVector)));
+            }
+            AddendVector = vsubq_s32(AddendVector, AddendZeroPointVector);
+
+            FloatVector = vmlaq_f32(FloatVector, vcvtq_f32_s32(AddendVector), AddendScaleVector);
+
+            FloatVector = vmaxq_f32(FloatVector, MinimumValueVector);
+            FloatVector = vminq_f32(FloatVector, MaximumValueVector);
+
+            IntegerVector = vaddq_s32(vcvtnq_s32_f32(FloatVector), ZeroPointVector);
+
+            uint32_t OutputBytes;
+
+            if (std::is_signed<OutputType>::value) {
+                const int16x4_t WordVector = vqmovn_s32(IntegerVector);
+                const int8x8_t ByteVector = vqmovn_s16(vcombine_s16(WordVector, WordVector));
+                OutputBytes = vget_lane_u32(vreinterpret_u32_s8(ByteVector), 0);
+            } else {
+                const uint16x4_t WordVector = vqmovun_s32(IntegerVector);
+                const uint8x8_t ByteVector = vqmovn_u16(vcombine_u16(WordVector, WordVector));
+                OutputBytes = vget_lane_u32(vreinterpret_u32_u8(ByteVector), 0);
+            }
+
+#endif
+
+            std::memcpy(RowOutput, &OutputBytes, sizeof(OutputBytes));
+            RowOutput += 4;
+
+            n -= 4;
+        }
+
+#endif
+
+        while (n > 0) {
+
+            int32_t IntegerValue = *RowInput++;
+
+            if (bias != nullptr) {
+                IntegerValue += *bias++;
+            }
+
+            float FloatValue = float(IntegerValue);
+            float ScaleValue = PerColumnScale ? *scale++ : PerMatrixScaleValue;
+
+            FloatValue *= ScaleValue;
+            FloatValue += float(int32_t(*RowAddend++) - int32_t(AddendZeroPoint)) * AddendScale;
+            FloatValue = std::max(FloatValue, MinimumValue);
+            FloatValue = std::min(FloatValue, MaximumValue);
+
+            IntegerValue = int32_t(MlasBitsOfFp32(FloatValue + MLAS_ROUNDING_BIAS_MAGIC)) -
+                MLAS_ROUNDING_BIAS_MAGIC_BITS;
+
+            *RowOutput++ = OutputType(IntegerValue + ZeroPoint);
+
+            n -= 1;
+        }
+
+        // Next Row
+        Input += InputLeadingDimension;
+        Addend += AddendLeadingDimension;
+        Output += OutputLeadingDimension;
+    }
+}
+
+template
+void
+MLASCALL
+MlasRequantizeOutputAdd<int8_t>(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    const int8_t* Addend,
+    size_t AddendLeadingDimension,
+    int8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerColumnScale,
+    float AddendScale,
+    int8_t AddendZeroPoint,
+    int8_t ZeroPoint,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    );
+
+template
+void
+MLASCALL
+MlasRequantizeOutputAdd<uint8_t>(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    const uint8_t* Addend,
+    size_t AddendLeadingDimension,
+    uint8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerColumnScale,
+    float AddendScale,
+    uint8_t AddendZeroPoint,
+    uint8_t ZeroPoint,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    );
+
 void
 MLASCALL
 MlasFindMinMaxElement(
@@ -0,0 +1,472 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply operation
+    (SBGEMM) and the portable kernel used when the processor has no bfloat16
+    instructions.
+
+--*/
+
+#include "sbgemm.h"
+
+#include <algorithm>
+
+void
+MlasSBGemmCopyPackB(
+    MLAS_BF16* D,
+    const MLAS_BF16* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    bool TransB
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer, one panel of MLAS_SBGEMM_PACKED_N columns after the other,
+    with the rows interleaved in pairs.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the first dimension of the source matrix.
+
+    CountN - Supplies the number of columns of the source matrix to copy.
+
+    CountK - Supplies the number of rows of the source matrix to copy.
+
+    TransB - Supplies true if the source matrix is stored transposed, i.e.
+        element (k, n) is at B[n * ldb + k].
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t PackedK = MlasSBGemmPackedK(CountK);
+
+    for (size_t n = 0; n < CountN; n += MLAS_SBGEMM_PACKED_N) {
+
+        const size_t CountNPanel = std::min(CountN - n, size_t(MLAS_SBGEMM_PACKED_N));
+
+        for (size_t k = 0; k < PackedK; k += 2) {
+
+            for (size_t j = 0; j < MLAS_SBGEMM_PACKED_N; j++) {
+
+                MLAS_BF16 Element0 = 0;
+                MLAS_BF16 Element1 = 0;
+
+                if (j < CountNPanel) {
+                    if (TransB) {
+                        const MLAS_BF16* b = B + (n + j) * ldb;
+                        Element0 = (k < CountK) ? b[k] : MLAS_BF16(0);
+                        Element1 = (k + 1 < CountK) ? b[k + 1] : MLAS_BF16(0);
+                    } else {
+                        const MLAS_BF16* b = B + n + j;
+                        Element0 = (k < CountK) ? b[k * ldb] : MLAS_BF16(0);
+                        Element1 = (k + 1 < CountK) ? b[(k + 1) * ldb] : MLAS_BF16(0);
+                    }
+                }
+
+                D[j * 2] = Element0;
+                D[j * 2 + 1] = Element1;
+            }
+
+            D += MLAS_SBGEMM_PACKED_N * 2;
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasSBGemmKernelDefault(
+    const MLAS_BF16* A,
+    const MLAS_BF16* PackedB,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    size_t PanelStride,
+    const float* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the portable kernel, which converts the inputs to single
+    precision.
+
+Arguments:
+
+    See MLAS_SBGEMM_KERNEL.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    constexpr size_t RowCountMax = 4;
+
+    const size_t RowCount = std::min(CountM, RowCountMax);
+
+    for (size_t n = 0; n < CountN; n += MLAS_SBGEMM_PACKED_N) {
+
+        const size_t CountNPanel = std::min(CountN - n, size_t(MLAS_SBGEMM_PACKED_N));
+        const MLAS_BF16* b = PackedB + (n / MLAS_SBGEMM_PACKED_N) * PanelStride;
+
+        float Accumulators[RowCountMax][MLAS_SBGEMM_PACKED_N] = {};
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            //
+            // Row k of the panel is interleaved with its partner row of the
+            // same pair.
+            //
+
+            const MLAS_BF16* RowB = b + (k / 2) * (MLAS_SBGEMM_PACKED_N * 2) + (k & 1);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                const float ElementA = MlasBf16ToFloat(A[r * lda + k]);
+                for (size_t j = 0; j < MLAS_SBGEMM_PACKED_N; j++) {
+                    Accumulators[r][j] += ElementA * MlasBf16ToFloat(RowB[j * 2]);
+                }
+            }
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c = C + r * ldc + n;
+
+            for (size_t j = 0; j < CountNPanel; j++) {
+
+                float Value = Accumulators[r][j];
+
+                if (!ZeroMode) {
+                    Value += c[j];
+                } else if (Bias != nullptr) {
+                    Value += Bias[n + j];
+                }
+
+                c[j] = Value;
+            }
+        }
+    }
+
+    return RowCount;
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchDefault = {
+    MlasSBGemmKernelDefault,
+};
+
+void
+MlasSBGemmOperation(
+    const size_t M,
+    const size_t RangeStartN,
+    const size_t RangeCountN,
+    const size_t K,
+    const MLAS_SBGEMM_DATA_PARAMS* DataParams,
+    const size_t RangeStartM
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a rectangle of matrix C.
+
+Arguments:
+
+    M - Supplies the number of rows of the rectangle.
+
+    RangeStartN - Supplies the first column of the rectangle.
+
+    RangeCountN - Supplies the number of columns of the rectangle.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    DataParams - Supplies the data position and layout of the matrices.
+
+    RangeStartM - Supplies the first row of the rectangle.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SBGEMM_KERNEL* Kernel = GetMlasPlatform().SBGemmDispatch->Kernel;
+
+    const size_t lda = DataParams->lda;
+    const size_t ldc = DataParams->ldc;
+
+    const MLAS_BF16* A = DataParams->A + RangeStartM * lda;
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+    const float* Bias = (DataParams->Bias != nullptr) ? DataParams->Bias + RangeStartN : nullptr;
+
+    if (K == 0) {
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < RangeCountN; n++) {
+                C[m * ldc + n] = (Bias != nullptr) ? Bias[n] : 0.0f;
+            }
+        }
+        return;
+    }
+
+    if (DataParams->BIsPacked) {
+
+        //
+        // The panels of packed matrix B span all of K, so each row of A is
+        // streamed once per panel without blocking K.
+        //
+
+        const size_t PanelStride = MlasSBGemmPackedK(K) * MLAS_SBGEMM_PACKED_N;
+        const MLAS_BF16* PackedB = static_cast<const MLAS_BF16*>(DataParams->B) +
+            (RangeStartN / MLAS_SBGEMM_PACKED_N) * PanelStride;
+
+        for (size_t m = 0; m < M;) {
+            m += Kernel(A + m * lda, PackedB, C + m * ldc, K, M - m, RangeCountN,
+                        lda, ldc, PanelStride, Bias, true);
+        }
+
+        return;
+    }
+
+    MLAS_DECLSPEC_ALIGN(MLAS_BF16 PanelB[MLAS_SBGEMM_STRIDEN * MLAS_SBGEMM_STRIDEK], 64);
+
+    const size_t ldb = DataParams->ldb;
+    const MLAS_BF16* B = static_cast<const MLAS_BF16*>(DataParams->B) + RangeStartN;
+
+    for (size_t n = 0; n < RangeCountN; n += MLAS_SBGEMM_STRIDEN) {
+
+        const size_t CountN = std::min(RangeCountN - n, size_t(MLAS_SBGEMM_STRIDEN));
+
+        for (size_t k = 0; k < K; k += MLAS_SBGEMM_STRIDEK) {
+
+            const size_t CountK = std::min(K - k, size_t(MLAS_SBGEMM_STRIDEK));
+            const bool ZeroMode = (k == 0);
+
+            MlasSBGemmCopyPackB(PanelB, B + k * ldb + n, ldb, CountN, CountK, false);
+
+            for (size_t m = 0; m < M;) {
+                m += Kernel(A + m * lda + k, PanelB, C + m * ldc + n, CountK, M - m, CountN,
+                            lda, ldc, MlasSBGemmPackedK(CountK) * MLAS_SBGEMM_PACKED_N,
+                            (Bias != nullptr) ? Bias + n : nullptr, ZeroMode);
+            }
+        }
+    }
+}
+
+void
+MlasSBGemmThreaded(
+    const ptrdiff_t ThreadCountM,
+    const ptrdiff_t ThreadCountN,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const MLAS_SBGEMM_DATA_PARAMS* DataParams,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    SBGEMM operation.
+
+Arguments:
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    M, N, K - Supplies the shape of the multiplication.
+
+    DataParams - Supplies the data position and layout of the matrices.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdM = ThreadId / ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension, in whole panels of
+    // packed matrix B.
+    //
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t BlockedN = (N + MLAS_SBGEMM_PACKED_N - 1) / MLAS_SBGEMM_PACKED_N;
+
+    MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &RangeStartN, &RangeCountN);
+
+    RangeStartN *= MLAS_SBGEMM_PACKED_N;
+    RangeCountN *= MLAS_SBGEMM_PACKED_N;
+
+    if (RangeCountM == 0 || RangeStartN >= N) {
+        return;
+    }
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    MlasSBGemmOperation(RangeCountM, RangeStartN, RangeCountN, K, DataParams, RangeStartM);
+}
+
+bool
+MLASCALL
+MlasBf16AccelerationSupported(
+    void
+    )
+{
+    return GetMlasPlatform().SBGemmDispatch != &MlasSBGemmDispatchDefault;
+}
+
+void
+MLASCALL
+MlasSBGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    const MLAS_SBGEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    //
+    // Compute the number of target threads given the complexity of the SBGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SBGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SBGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads.
+    //
+    // N.B. Currently, the operation is segmented as a 1D partition, which
+    // works okay for operations involving skinny matrices.
+    //
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchN - 1) / BatchN;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (N > M) {
+
+        const size_t BlockedN = (N + MLAS_SBGEMM_PACKED_N - 1) / MLAS_SBGEMM_PACKED_N;
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    if (ThreadsPerGemm == 0) {
+        ThreadsPerGemm = 1;
+        ThreadCountM = 1;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchN),
+        [=](ptrdiff_t tid)
+    {
+        ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        MlasSBGemmThreaded(ThreadCountM, ThreadCountN, M, N, K, &(DataParams[GemmIdx]), ThreadIdx);
+    });
+}
+
+size_t
+MLASCALL
+MlasSBGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+{
+    //
+    // Compute the number of bytes required to hold the packed buffer.
+    //
+
+    const size_t AlignedN = (N + MLAS_SBGEMM_PACKED_N - 1) & ~size_t(MLAS_SBGEMM_PACKED_N - 1);
+
+    const size_t BytesRequired = AlignedN * MlasSBGemmPackedK(K) * sizeof(MLAS_BF16);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    const size_t AlignedBytesRequired = (BytesRequired + BufferAlignment - 1) &
+        ~(BufferAlignment - 1);
+
+    return AlignedBytesRequired;
+}
+
+void
+MLASCALL
+MlasSBGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    )
+{
+    MlasSBGemmCopyPackB(static_cast<MLAS_BF16*>(PackedB), B, ldb, N, K, TransB != CblasNoTrans);
+}
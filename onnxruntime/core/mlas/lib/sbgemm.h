@@ -0,0 +1,193 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm.h
+
+Abstract:
+
+    This module defines the kernel interface and the dispatch structure of the
+    bfloat16 matrix/matrix multiply operation (SBGEMM).
+
+    Matrix B is packed into panels of MLAS_SBGEMM_PACKED_N columns. Inside a
+    panel, the rows of matrix B are stored in pairs with the elements of a
+    pair interleaved:
+
+        B(0,0) B(1,0) B(0,1) B(1,1) ... B(0,15) B(1,15)
+        B(2,0) B(3,0) B(2,1) B(3,1) ... B(2,15) B(3,15)
+        ...
+
+    This is the operand layout of the dot product instructions (vdpbf16ps,
+    bfdot) and of the AMX tile multiply (tdpbf16ps). The rows of a panel are
+    zero padded to a multiple of MLAS_SBGEMM_PACKED_K and the columns past
+    the end of the matrix are zero filled, so kernels can always load full
+    panel rows and full tiles.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+//
+// Define the number of columns in a panel of packed matrix B and the
+// granularity of the number of packed rows.
+//
+
+#define MLAS_SBGEMM_PACKED_N                        16
+#define MLAS_SBGEMM_PACKED_K                        32
+
+//
+// Define the default striding parameters used for the bfloat16 matrix/matrix
+// multiply operation when matrix B is packed on the fly.
+//
+
+#define MLAS_SBGEMM_STRIDEN                         128
+#define MLAS_SBGEMM_STRIDEK                         128
+
+//
+// Define the target number of per-thread multiplies before using another
+// thread to perform additional work.
+//
+
+#define MLAS_SBGEMM_THREAD_COMPLEXITY               (64 * 1024)
+
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    PackedB - Supplies the address of the first panel of packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns of matrix A. The packed panels
+        hold this number of rows rounded up to MLAS_SBGEMM_PACKED_K.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix C.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    PanelStride - Supplies the number of elements between consecutive panels
+        of packed matrix B.
+
+    Bias - Supplies the optional bias vector of CountN elements, only used in
+        zero mode.
+
+    ZeroMode - Supplies true if the output matrix must be overwritten, else
+        the result is accumulated into matrix C.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+
+typedef
+size_t
+(MLASCALL MLAS_SBGEMM_KERNEL)(
+    const MLAS_BF16* A,
+    const MLAS_BF16* PackedB,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    size_t PanelStride,
+    const float* Bias,
+    bool ZeroMode
+    );
+
+struct MLAS_SBGEMM_DISPATCH {
+    MLAS_SBGEMM_KERNEL* Kernel;
+};
+
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchDefault;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchNeon;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx;
+
+//
+// The AMX kernel handles blocks of 16 rows and defers the remaining rows to
+// the AVX512-BF16 kernel.
+//
+
+MLAS_SBGEMM_KERNEL MlasSBGemmKernelAvx512Bf16;
+
+//
+// Conversions between bfloat16 and single precision. Rounding is to nearest
+// even, NaN stays NaN.
+//
+
+MLAS_FORCEINLINE
+float
+MlasBf16ToFloat(
+    MLAS_BF16 Value
+    )
+{
+    return MlasFp32FromBits(uint32_t(Value) << 16);
+}
+
+MLAS_FORCEINLINE
+MLAS_BF16
+MlasFloatToBf16(
+    float Value
+    )
+{
+    const uint32_t Bits = MlasBitsOfFp32(Value);
+
+    if ((Bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        return MLAS_BF16((Bits >> 16) | 0x40);
+    }
+
+    const uint32_t RoundingBias = 0x7FFFu + ((Bits >> 16) & 1u);
+
+    return MLAS_BF16((Bits + RoundingBias) >> 16);
+}
+
+//
+// Returns the number of packed rows of a panel holding CountK rows of
+// matrix B.
+//
+
+MLAS_FORCEINLINE
+size_t
+MlasSBGemmPackedK(
+    size_t CountK
+    )
+{
+    return (CountK + MLAS_SBGEMM_PACKED_K - 1) & ~size_t(MLAS_SBGEMM_PACKED_K - 1);
+}
+
+//
+// Packs CountK rows of CountN columns of matrix B into panels of
+// MLAS_SBGEMM_PACKED_N columns, each panel being MlasSBGemmPackedK(CountK)
+// rows long.
+//
+
+void
+MlasSBGemmCopyPackB(
+    MLAS_BF16* D,
+    const MLAS_BF16* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    bool TransB
+    );
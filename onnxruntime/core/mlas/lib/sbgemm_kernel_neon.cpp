@@ -0,0 +1,179 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_neon.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply kernel for
+    ARM64 processors with the BF16 extension (ARMv8.6-A), using the bfdot
+    instruction.
+
+    This file must be compiled with the BF16 extension enabled, for example
+    -march=armv8.2-a+bf16.
+
+--*/
+
+#include "sbgemm.h"
+
+#include <arm_neon.h>
+
+#include <cstring>
+
+//
+// Define the number of 128-bit vectors in a row pair of a packed panel, each
+// vector holding the row pairs of four columns.
+//
+
+constexpr size_t MlasSBGemmVectorsPerPanelNeon = MLAS_SBGEMM_PACKED_N / 4;
+
+MLAS_FORCEINLINE
+bfloat16x8_t
+MlasSBGemmBroadcastPairNeon(
+    const MLAS_BF16* A,
+    size_t k,
+    size_t CountK
+    )
+{
+    uint32_t Pair;
+
+    if (k + 1 < CountK) {
+        std::memcpy(&Pair, A + k, sizeof(Pair));
+    } else {
+        Pair = A[k];
+    }
+
+    return vreinterpretq_bf16_u32(vdupq_n_u32(Pair));
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmPanelNeon(
+    const MLAS_BF16* A,
+    const MLAS_BF16* PanelB,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+    )
+{
+    float32x4_t Accumulators[RowCount][MlasSBGemmVectorsPerPanelNeon];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t i = 0; i < MlasSBGemmVectorsPerPanelNeon; i++) {
+            Accumulators[r][i] = vdupq_n_f32(0.0f);
+        }
+    }
+
+    const bfloat16_t* b = reinterpret_cast<const bfloat16_t*>(PanelB);
+
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        bfloat16x8_t PairsB[MlasSBGemmVectorsPerPanelNeon];
+
+        for (size_t i = 0; i < MlasSBGemmVectorsPerPanelNeon; i++) {
+            PairsB[i] = vld1q_bf16(b + i * 8);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const bfloat16x8_t PairA = MlasSBGemmBroadcastPairNeon(A + r * lda, k, CountK);
+            for (size_t i = 0; i < MlasSBGemmVectorsPerPanelNeon; i++) {
+                Accumulators[r][i] = vbfdotq_f32(Accumulators[r][i], PairsB[i], PairA);
+            }
+        }
+
+        b += MLAS_SBGEMM_PACKED_N * 2;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        float* c = C + r * ldc;
+        float Buffer[MLAS_SBGEMM_PACKED_N];
+
+        for (size_t i = 0; i < MlasSBGemmVectorsPerPanelNeon; i++) {
+            vst1q_f32(Buffer + i * 4, Accumulators[r][i]);
+        }
+
+        for (size_t j = 0; j < CountN; j++) {
+            if (!ZeroMode) {
+                Buffer[j] += c[j];
+            } else if (Bias != nullptr) {
+                Buffer[j] += Bias[j];
+            }
+        }
+
+        std::memcpy(c, Buffer, CountN * sizeof(float));
+    }
+}
+
+size_t
+MLASCALL
+MlasSBGemmKernelNeon(
+    const MLAS_BF16* A,
+    const MLAS_BF16* PackedB,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    size_t PanelStride,
+    const float* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 4 rows of matrix C with four 128-bit
+    accumulators per row of a panel.
+
+Arguments:
+
+    See MLAS_SBGEMM_KERNEL.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t RowCount = std::min(CountM, size_t(4));
+
+    for (size_t n = 0; n < CountN; n += MLAS_SBGEMM_PACKED_N) {
+
+        const size_t CountNPanel = std::min(CountN - n, size_t(MLAS_SBGEMM_PACKED_N));
+        const MLAS_BF16* PanelB = PackedB + (n / MLAS_SBGEMM_PACKED_N) * PanelStride;
+        const float* PanelBias = (Bias != nullptr) ? Bias + n : nullptr;
+
+        switch (RowCount) {
+            case 4:
+                MlasSBGemmPanelNeon<4>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 3:
+                MlasSBGemmPanelNeon<3>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            case 2:
+                MlasSBGemmPanelNeon<2>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+            default:
+                MlasSBGemmPanelNeon<1>(A, PanelB, C + n, CountK, CountNPanel, lda, ldc, PanelBias, ZeroMode);
+                break;
+        }
+    }
+
+    return RowCount;
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchNeon = {
+    MlasSBGemmKernelNeon,
+};
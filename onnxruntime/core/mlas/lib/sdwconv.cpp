@@ -0,0 +1,199 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sdwconv.cpp
+
+Abstract:
+
+    This module implements the single precision depthwise direct convolution
+    kernels for targets with 128-bit vector intrinsics that do not use the
+    NCHWc convolution path (ARM NEON and WebAssembly SIMD).
+
+    The WebAssembly scalar target uses the kernel in the scalar directory.
+
+--*/
+
+#include "mlasi.h"
+
+#if defined(MLAS_TARGET_ARM_ANY) || defined(MLAS_TARGET_WASM_SIMD)
+
+static
+void
+MlasConv2dSingleChannel_CHW_Kernel3x3_Pad01_Dilation1(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float* Output,
+    const float* Zeros
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute convolution on one channel input with one filter channel.
+
+    The output columns whose receptive field is fully inside the input row are
+    computed four at a time when the horizontal stride is one. The output
+    columns touching the left or right padding are computed one at a time.
+
+Arguments:
+
+    Parameters - conv parameters calculated based on conv parameters like padding, strides, dilations, etc.
+
+    Input - input channel data start. Input is NCHW, so this pointer point to single H x W image data.
+
+    Filter - Whole filters are of F x CpG x FH x FW, this filter point to single FH x FW filter data.
+
+    Output - whole output are of N x F x OH x OW. This pointer point to single OH x OW output image data.
+
+    Zeroes - Point to working buffer where all 0.0f are filled, used as the input row of the top and bottom padding.
+
+--*/
+{
+    const size_t H = Parameters->InputShape[0];
+    const size_t W = Parameters->InputShape[1];
+    const size_t OH = Parameters->OutputShape[0];
+    const size_t OW = Parameters->OutputShape[1];
+    const size_t pad_top = Parameters->Padding[0];
+    const size_t pad_left = Parameters->Padding[1];
+    const size_t stride_h = Parameters->StrideShape[0];
+    const size_t stride_w = Parameters->StrideShape[1];
+
+    //
+    // Compute the range [ow_begin, ow_end) of the output columns that only
+    // read input columns, i.e. ow * stride_w - pad_left >= 0 and
+    // ow * stride_w - pad_left + 2 < W.
+    //
+
+    const size_t ow_begin = std::min(pad_left, OW);
+    size_t ow_end = (W + pad_left >= 3) ? (W + pad_left - 3) / stride_w + 1 : 0;
+    ow_end = std::max(std::min(ow_end, OW), ow_begin);
+
+    const MLAS_FLOAT32X4 w00 = MlasBroadcastFloat32x4(Filter[0]);
+    const MLAS_FLOAT32X4 w01 = MlasBroadcastFloat32x4(Filter[1]);
+    const MLAS_FLOAT32X4 w02 = MlasBroadcastFloat32x4(Filter[2]);
+    const MLAS_FLOAT32X4 w10 = MlasBroadcastFloat32x4(Filter[3]);
+    const MLAS_FLOAT32X4 w11 = MlasBroadcastFloat32x4(Filter[4]);
+    const MLAS_FLOAT32X4 w12 = MlasBroadcastFloat32x4(Filter[5]);
+    const MLAS_FLOAT32X4 w20 = MlasBroadcastFloat32x4(Filter[6]);
+    const MLAS_FLOAT32X4 w21 = MlasBroadcastFloat32x4(Filter[7]);
+    const MLAS_FLOAT32X4 w22 = MlasBroadcastFloat32x4(Filter[8]);
+
+    for (size_t oh = 0; oh < OH; oh++) {
+
+        //
+        // Select the three input rows of this output row, substituting the
+        // zero row for the top and bottom padding.
+        //
+
+        const float* rows[3];
+
+        for (size_t r = 0; r < 3; r++) {
+            const size_t ih = oh * stride_h + r - pad_top;
+            rows[r] = (ih < H) ? (Input + ih * W) : Zeros;
+        }
+
+        const float* row0 = rows[0];
+        const float* row1 = rows[1];
+        const float* row2 = rows[2];
+
+        auto ComputeEdge = [&](size_t ow) {
+            float dotsum = 0.0f;
+            for (size_t r = 0; r < 3; r++) {
+                for (size_t c = 0; c < 3; c++) {
+                    const size_t iw = ow * stride_w + c - pad_left;
+                    if (iw < W) {
+                        dotsum += Filter[r * 3 + c] * rows[r][iw];
+                    }
+                }
+            }
+            return dotsum;
+        };
+
+        size_t ow = 0;
+
+        for (; ow < ow_begin; ow++) {
+            *Output++ = ComputeEdge(ow);
+        }
+
+        if (stride_w == 1) {
+
+            for (; ow + 4 <= ow_end; ow += 4) {
+
+                const size_t iw = ow - pad_left;
+
+                MLAS_FLOAT32X4 dotsum = MlasMultiplyFloat32x4(w00, MlasLoadFloat32x4(row0 + iw));
+                dotsum = MlasMultiplyAddFloat32x4(w01, MlasLoadFloat32x4(row0 + iw + 1), dotsum);
+                dotsum = MlasMultiplyAddFloat32x4(w02, MlasLoadFloat32x4(row0 + iw + 2), dotsum);
+                dotsum = MlasMultiplyAddFloat32x4(w10, MlasLoadFloat32x4(row1 + iw), dotsum);
+                dotsum = MlasMultiplyAddFloat32x4(w11, MlasLoadFloat32x4(row1 + iw + 1), dotsum);
+                dotsum = MlasMultiplyAddFloat32x4(w12, MlasLoadFloat32x4(row1 + iw + 2), dotsum);
+                dotsum = MlasMultiplyAddFloat32x4(w20, MlasLoadFloat32x4(row2 + iw), dotsum);
+                dotsum = MlasMultiplyAddFloat32x4(w21, MlasLoadFloat32x4(row2 + iw + 1), dotsum);
+                dotsum = MlasMultiplyAddFloat32x4(w22, MlasLoadFloat32x4(row2 + iw + 2), dotsum);
+
+                MlasStoreFloat32x4(Output, dotsum);
+                Output += 4;
+            }
+        }
+
+        for (; ow < ow_end; ow++) {
+
+            const size_t iw = ow * stride_w - pad_left;
+
+            float dotsum =
+                Filter[0] * row0[iw] + Filter[1] * row0[iw + 1] + Filter[2] * row0[iw + 2] +
+                Filter[3] * row1[iw] + Filter[4] * row1[iw + 1] + Filter[5] * row1[iw + 2] +
+                Filter[6] * row2[iw] + Filter[7] * row2[iw + 1] + Filter[8] * row2[iw + 2];
+            *Output++ = dotsum;
+        }
+
+        for (; ow < OW; ow++) {
+            *Output++ = ComputeEdge(ow);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasConvDepthwiseFloat_CHW(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float* Output,
+    const float* Zeros
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute depthwise convolution for one filter channel on one input channel.
+
+Arguments:
+
+    Parameters - conv parameters calculated based on conv parameters like padding, strides, dilations, etc.
+
+    Input - input channel data start. Input is NCHW, so this pointer point to single H x W image data.
+
+    Filter - Whole filters are of F x CpG x FH x FW, this filter point to single FH x FW filter data.
+
+    Output - whole output are of N x F x OH x OW. This pointer point to single OH x OW output image data.
+
+    Zeroes - Point to working buffer where all 0.0f are filled.
+
+Note:
+    No checking here as it is inner loop. Logic in generating Parameters controls the check.
+
+    Currently only support 2d kernel 3x3.
+
+--*/
+{
+    MlasConv2dSingleChannel_CHW_Kernel3x3_Pad01_Dilation1(Parameters, Input, Filter, Output, Zeros);
+}
+
+#endif
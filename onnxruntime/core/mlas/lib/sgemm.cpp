@@ -26,6 +26,23 @@ Abstract:
 
 #define MLAS_SGEMM_TRANSA_ROWS              12
 
+//
+// Define the maximum depth handled by the direct kernel, which multiplies the
+// unpacked matrix B. Below this depth, the cost of packing matrix B is not
+// amortized by the packed kernels.
+//
+
+#define MLAS_SGEMM_SMALL_K                  4
+
+//
+// Define the maximum number of multiplies of a batched SGEMM entry for which
+// whole entries are assigned to the worker threads instead of partitioning
+// each entry across threads. Partitioning such small operations costs more in
+// dispatch and repeated packing than it saves in compute.
+//
+
+#define MLAS_SGEMM_SMALL_BATCH_COMPLEXITY   (128 * 128 * 128)
+
 //
 // Define the parameters to execute segments of a SGEMM operation on worker
 // threads.
@@ -91,6 +108,108 @@ Return Value:
     }
 }
 
+void
+MlasSgemmSmallKOperation(
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) for non-transposed matrices of a small depth, reading
+    matrix B in place rather than from a packed buffer.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B. This is at most MLAS_SGEMM_SMALL_K.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float ScaledA[MLAS_SGEMM_SMALL_K];
+
+    for (size_t m = 0; m < M; m++) {
+
+        for (size_t k = 0; k < K; k++) {
+            ScaledA[k] = A[k] * alpha;
+        }
+
+        float* c = C;
+        const float* b = B;
+        size_t n = N;
+
+        while (n >= 4) {
+
+            MLAS_FLOAT32X4 Accumulator = (beta == 0.0f) ? MlasZeroFloat32x4() :
+                MlasMultiplyFloat32x4(MlasLoadFloat32x4(c), MlasBroadcastFloat32x4(beta));
+
+            for (size_t k = 0; k < K; k++) {
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(b + k * ldb),
+                    MlasBroadcastFloat32x4(ScaledA[k]), Accumulator);
+            }
+
+            MlasStoreFloat32x4(c, Accumulator);
+
+            b += 4;
+            c += 4;
+            n -= 4;
+        }
+
+        while (n > 0) {
+
+            float Accumulator = (beta == 0.0f) ? 0.0f : *c * beta;
+
+            for (size_t k = 0; k < K; k++) {
+                Accumulator += b[k * ldb] * ScaledA[k];
+            }
+
+            *c = Accumulator;
+
+            b += 1;
+            c += 1;
+            n -= 1;
+        }
+
+        A += lda;
+        C += ldc;
+    }
+}
+
 void
 MlasSgemmTransposeA(
     float* D,
@@ -1003,6 +1122,152 @@ Return Value:
 
 #endif
 
+MLAS_FORCEINLINE
+MLAS_SGEMM_EPILOGUE
+MlasSgemmOffsetEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    size_t StartM,
+    size_t StartN
+    )
+/*++
+
+Routine Description:
+
+    This routine returns a copy of the epilogue that applies to the block of
+    the output matrix starting at the supplied row and column.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue of the output matrix.
+
+    StartM - Supplies the first row of the block.
+
+    StartN - Supplies the first column of the block.
+
+Return Value:
+
+    Returns the epilogue of the block.
+
+--*/
+{
+    MLAS_SGEMM_EPILOGUE BlockEpilogue = *Epilogue;
+
+    if (BlockEpilogue.Bias != nullptr) {
+        BlockEpilogue.Bias += StartN;
+    }
+
+    if (BlockEpilogue.Residual != nullptr) {
+        BlockEpilogue.Residual += StartM * BlockEpilogue.ldr + StartN;
+    }
+
+    return BlockEpilogue;
+}
+
+void
+MlasSgemmAddRows(
+    float* C,
+    const float* Addend,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    size_t lda
+    )
+/*++
+
+Routine Description:
+
+    This routine adds a matrix to the output matrix. A leading dimension of
+    zero broadcasts a single row.
+
+Arguments:
+
+    C - Supplies the address of matrix C.
+
+    Addend - Supplies the address of the matrix to add.
+
+    CountM - Supplies the number of rows from matrix C.
+
+    CountN - Supplies the number of columns from matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    lda - Supplies the first dimension of the matrix to add.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountM-- > 0) {
+
+        float* c = C;
+        const float* a = Addend;
+        size_t n = CountN;
+
+        while (n >= 4) {
+            MlasStoreFloat32x4(c, MlasAddFloat32x4(MlasLoadFloat32x4(c), MlasLoadFloat32x4(a)));
+            a += 4;
+            c += 4;
+            n -= 4;
+        }
+
+        while (n > 0) {
+            *c++ += *a++;
+            n -= 1;
+        }
+
+        C += ldc;
+        Addend += lda;
+    }
+}
+
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the epilogue to a block of the output matrix whose
+    final value has been computed.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue of the block, see MlasSgemmOffsetEpilogue.
+
+    C - Supplies the address of the block of matrix C.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Epilogue->Bias != nullptr) {
+        MlasSgemmAddRows(C, Epilogue->Bias, CountM, CountN, ldc, 0);
+    }
+
+    if (Epilogue->Activation != nullptr && Epilogue->Activation->ActivationKind != MlasIdentityActivation) {
+        MlasActivation(Epilogue->Activation, C, nullptr, CountM, CountN, ldc);
+    }
+
+    if (Epilogue->Residual != nullptr) {
+        MlasSgemmAddRows(C, Epilogue->Residual, CountM, CountN, ldc, Epilogue->ldr);
+    }
+}
+
 MLAS_FORCEINLINE
 float*
 MlasSgemmKernelLoop(
@@ -1015,7 +1280,8 @@ MlasSgemmKernelLoop(
     size_t lda,
     size_t ldc,
     float alpha,
-    bool ZeroMode
+    bool ZeroMode,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1051,12 +1317,21 @@ Arguments:
     ZeroMode - Supplies true if the output matrix must be zero initialized,
         else false if the output matrix is accumulated into.
 
+    Epilogue - Supplies the epilogue to apply to the rows of matrix C as they
+        are computed, else nullptr if the output matrix is not final.
+
 Return Value:
 
     Returns the next address of matrix C.
 
 --*/
 {
+    MLAS_SGEMM_EPILOGUE RowsEpilogue;
+
+    if (Epilogue != nullptr) {
+        RowsEpilogue = *Epilogue;
+    }
+
     while (CountM > 0) {
 
         size_t RowsHandled;
@@ -1071,6 +1346,15 @@ Return Value:
         }
 #endif
 
+        if (Epilogue != nullptr) {
+
+            MlasSgemmApplyEpilogue(&RowsEpilogue, C, RowsHandled, CountN, ldc);
+
+            if (RowsEpilogue.Residual != nullptr) {
+                RowsEpilogue.Residual += RowsEpilogue.ldr * RowsHandled;
+            }
+        }
+
         C += ldc * RowsHandled;
         A += lda * RowsHandled;
         CountM -= RowsHandled;
@@ -1093,7 +1377,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1131,6 +1416,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Supplies the optional operations fused into the output.
+
 Return Value:
 
     None.
@@ -1147,6 +1434,9 @@ Return Value:
 
     if (K == 0) {
         MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+        }
         return;
     }
 
@@ -1170,6 +1460,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+            }
             return;
         }
 
@@ -1177,6 +1470,9 @@ Return Value:
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+            }
             return;
         }
 
@@ -1205,6 +1501,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+            }
             return;
         }
 
@@ -1212,6 +1511,19 @@ Return Value:
 
     }
 
+    //
+    // Handle the case of a tiny K. Packing matrix B would copy as many elements
+    // as the kernel reads from it, so multiply directly from matrix B.
+    //
+
+    if (K <= MLAS_SGEMM_SMALL_K && TransA == CblasNoTrans && TransB == CblasNoTrans) {
+        MlasSgemmSmallKOperation(M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+        }
+        return;
+    }
+
     //
     // Compute the strides to step through slices of the input matrices.
     //
@@ -1283,9 +1595,23 @@ Return Value:
 
             float* c = C + n;
 
+            //
+            // Apply the epilogue to the rows of the output matrix as the last
+            // slice along the K dimension completes them.
+            //
+
+            const bool ApplyEpilogue = (Epilogue != nullptr && k + CountK == K);
+
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MLAS_SGEMM_EPILOGUE SliceEpilogue;
+
+                if (ApplyEpilogue) {
+                    SliceEpilogue = MlasSgemmOffsetEpilogue(Epilogue, 0, n);
+                }
+
+                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    ApplyEpilogue ? &SliceEpilogue : nullptr);
 
             } else {
 
@@ -1302,6 +1628,12 @@ Return Value:
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
+                    MLAS_SGEMM_EPILOGUE SliceEpilogue;
+
+                    if (ApplyEpilogue) {
+                        SliceEpilogue = MlasSgemmOffsetEpilogue(Epilogue, M - RowsRemaining, n);
+                    }
+
                     RowsRemaining -= RowsTransposed;
                     a += RowsTransposed;
 
@@ -1309,7 +1641,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        ApplyEpilogue ? &SliceEpilogue : nullptr);
                 }
             }
 
@@ -1332,7 +1665,8 @@ MlasSgemmPackedOperation(
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1372,6 +1706,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Supplies the optional operations fused into the output.
+
 Return Value:
 
     None.
@@ -1380,6 +1716,14 @@ Return Value:
 {
     float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
 
+    if (K == 0) {
+        MlasSgemmMultiplyBeta(C, M, RangeCountN, ldc, beta);
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, M, RangeCountN, ldc);
+        }
+        return;
+    }
+
     //
     // Step through each slice of matrix B along the N dimension.
     //
@@ -1418,9 +1762,23 @@ Return Value:
             const float* pb = (const float*)PackedB + AlignedN * k + CountK * SliceStartN;
             float* c = C + n;
 
+            //
+            // Apply the epilogue to the rows of the output matrix as the last
+            // slice along the K dimension completes them.
+            //
+
+            const bool ApplyEpilogue = (Epilogue != nullptr && k + CountK == K);
+
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MLAS_SGEMM_EPILOGUE SliceEpilogue;
+
+                if (ApplyEpilogue) {
+                    SliceEpilogue = MlasSgemmOffsetEpilogue(Epilogue, 0, n);
+                }
+
+                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    ApplyEpilogue ? &SliceEpilogue : nullptr);
 
             } else {
 
@@ -1437,6 +1795,12 @@ Return Value:
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
+                    MLAS_SGEMM_EPILOGUE SliceEpilogue;
+
+                    if (ApplyEpilogue) {
+                        SliceEpilogue = MlasSgemmOffsetEpilogue(Epilogue, M - RowsRemaining, n);
+                    }
+
                     RowsRemaining -= RowsTransposed;
                     a += RowsTransposed;
 
@@ -1444,7 +1808,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        ApplyEpilogue ? &SliceEpilogue : nullptr);
                 }
             }
 
@@ -1536,11 +1901,19 @@ Return Value:
     const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
     float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
 
+    MLAS_SGEMM_EPILOGUE RangeEpilogue;
+
+    if (DataParams->Epilogue != nullptr) {
+        RangeEpilogue = MlasSgemmOffsetEpilogue(DataParams->Epilogue, RangeStartM, RangeStartN);
+    }
+
+    const MLAS_SGEMM_EPILOGUE* Epilogue = (DataParams->Epilogue != nullptr) ? &RangeEpilogue : nullptr;
+
     if (DataParams->BIsPacked) {
 
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
             K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc, Epilogue);
 
     } else {
 
@@ -1549,7 +1922,7 @@ Return Value:
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc, Epilogue);
     }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -1592,6 +1965,43 @@ MlasGemmBatch(
         TargetThreadCount = MaximumThreadCount;
     }
 
+    //
+    // Handle a batch of small operations. Each thread computes a range of
+    // whole batch entries, so an entry is packed once and the number of tasks
+    // is bounded by the thread count rather than the batch size.
+    //
+
+    if (BatchSize > 1 && Complexity <= double(MLAS_SGEMM_SMALL_BATCH_COMPLEXITY)) {
+
+        const double BatchComplexity = Complexity * double(BatchSize);
+
+        ptrdiff_t TaskCount;
+
+        if (BatchComplexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MaximumThreadCount)) {
+            TaskCount = ptrdiff_t(BatchComplexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        } else {
+            TaskCount = MaximumThreadCount;
+        }
+
+        if (size_t(TaskCount) > BatchSize) {
+            TaskCount = ptrdiff_t(BatchSize);
+        }
+
+        MlasTrySimpleParallel(ThreadPool, TaskCount, [=](ptrdiff_t tid)
+        {
+            size_t GemmStart;
+            size_t GemmCount;
+
+            MlasPartitionWork(tid, TaskCount, BatchSize, &GemmStart, &GemmCount);
+
+            for (size_t GemmIdx = GemmStart; GemmIdx < GemmStart + GemmCount; GemmIdx++) {
+                MlasSgemmThreaded(1, 1, TransA, TransB, M, N, K, &(Data[GemmIdx]), 0);
+            }
+        });
+
+        return;
+    }
+
     //
     // Segment the operation across multiple threads.
     //
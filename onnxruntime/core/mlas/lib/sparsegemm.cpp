@@ -0,0 +1,242 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation of a sparse matrix A in compressed sparse row (CSR) format by a
+    dense matrix B.
+
+    Each row of the output is the sum of the rows of B selected by the column
+    indices of the non-zero values of the row of A. The output row is produced
+    in blocks of columns held in registers for all the non-zero values of the
+    row, so that the output is written once. The rows are partitioned across
+    threads by their number of non-zero values.
+
+--*/
+
+#include "mlasi.h"
+
+#include <algorithm>
+
+static
+void
+MlasSparseGemmRow(
+    size_t N,
+    float alpha,
+    const float* AValues,
+    const int64_t* AColumnIndices,
+    size_t NonZeroCount,
+    const float* B,
+    size_t ldb,
+    float* C
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a single row of the output.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    alpha - Supplies the scalar multiplier.
+
+    AValues - Supplies the non-zero values of the row of matrix A.
+
+    AColumnIndices - Supplies the column indices of the non-zero values.
+
+    NonZeroCount - Supplies the number of non-zero values of the row.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of the row of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = 0;
+
+    while (n + 16 <= N) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator2 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator3 = MlasZeroFloat32x4();
+
+        for (size_t i = 0; i < NonZeroCount; i++) {
+
+            MLAS_FLOAT32X4 AValue = MlasBroadcastFloat32x4(AValues[i] * alpha);
+            const float* b = B + size_t(AColumnIndices[i]) * ldb + n;
+
+            Accumulator0 = MlasMultiplyAddFloat32x4(AValue, MlasLoadFloat32x4(b), Accumulator0);
+            Accumulator1 = MlasMultiplyAddFloat32x4(AValue, MlasLoadFloat32x4(b + 4), Accumulator1);
+            Accumulator2 = MlasMultiplyAddFloat32x4(AValue, MlasLoadFloat32x4(b + 8), Accumulator2);
+            Accumulator3 = MlasMultiplyAddFloat32x4(AValue, MlasLoadFloat32x4(b + 12), Accumulator3);
+        }
+
+        MlasStoreFloat32x4(C + n, Accumulator0);
+        MlasStoreFloat32x4(C + n + 4, Accumulator1);
+        MlasStoreFloat32x4(C + n + 8, Accumulator2);
+        MlasStoreFloat32x4(C + n + 12, Accumulator3);
+
+        n += 16;
+    }
+
+    while (n + 4 <= N) {
+
+        MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+        for (size_t i = 0; i < NonZeroCount; i++) {
+
+            MLAS_FLOAT32X4 AValue = MlasBroadcastFloat32x4(AValues[i] * alpha);
+            const float* b = B + size_t(AColumnIndices[i]) * ldb + n;
+
+            Accumulator = MlasMultiplyAddFloat32x4(AValue, MlasLoadFloat32x4(b), Accumulator);
+        }
+
+        MlasStoreFloat32x4(C + n, Accumulator);
+
+        n += 4;
+    }
+
+    while (n < N) {
+
+        float Accumulator = 0.0f;
+
+        for (size_t i = 0; i < NonZeroCount; i++) {
+            Accumulator += AValues[i] * alpha * B[size_t(AColumnIndices[i]) * ldb + n];
+        }
+
+        C[n] = Accumulator;
+
+        n += 1;
+    }
+}
+
+void
+MLASCALL
+MlasSparseGemm(
+    size_t M,
+    size_t N,
+    float alpha,
+    const float* AValues,
+    const int64_t* ARowOffsets,
+    const int64_t* AColumnIndices,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation C = alpha * A * B, where A is a sparse matrix in compressed
+    sparse row (CSR) format.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    alpha - Supplies the scalar multiplier.
+
+    AValues - Supplies the non-zero values of matrix A in row order.
+
+    ARowOffsets - Supplies the offset of the first non-zero value of each row
+        of matrix A, followed by the end offset of the last row (M + 1
+        values).
+
+    AColumnIndices - Supplies the column index of each non-zero value of
+        matrix A. The column indices must be less than the number of rows of
+        matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    const size_t NonZeroCount = size_t(ARowOffsets[M] - ARowOffsets[0]);
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Each non-zero value contributes N multiply-adds.
+    //
+
+    const double Complexity = double(NonZeroCount) * double(N) + double(M) * double(N);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > M) {
+        TargetThreadCount = ptrdiff_t(M);
+    }
+
+    //
+    // Partition the rows so that each thread has about the same number of
+    // non-zero values, which balances the work of unevenly pruned rows.
+    //
+
+    const auto RowBegin = [&](ptrdiff_t ThreadId) -> size_t {
+        if (ThreadId == 0) {
+            return 0;
+        }
+        if (ThreadId == TargetThreadCount) {
+            return M;
+        }
+        const int64_t Target = ARowOffsets[0] +
+            int64_t(NonZeroCount * size_t(ThreadId) / size_t(TargetThreadCount));
+        return size_t(std::lower_bound(ARowOffsets, ARowOffsets + M, Target) - ARowOffsets);
+    };
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t ThreadId) {
+
+        const size_t RowEnd = RowBegin(ThreadId + 1);
+
+        for (size_t m = RowBegin(ThreadId); m < RowEnd; m++) {
+
+            const size_t RowOffset = size_t(ARowOffsets[m] - ARowOffsets[0]);
+            const size_t RowNonZeroCount = size_t(ARowOffsets[m + 1] - ARowOffsets[m]);
+
+            MlasSparseGemmRow(N, alpha, AValues + RowOffset, AColumnIndices + RowOffset,
+                RowNonZeroCount, B, ldb, C + m * ldc);
+        }
+    });
+}
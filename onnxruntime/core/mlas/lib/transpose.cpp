@@ -378,7 +378,9 @@ void
 MLASCALL
 MlasTranspose(
     const uint32_t* Input,
+    size_t ldInput,
     uint32_t* Output,
+    size_t ldOutput,
     size_t M,
     size_t N
     )
@@ -387,14 +389,19 @@ MlasTranspose(
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns). The rows of both matrices may be
+    padded, which allows to transpose a tile of a larger matrix.
 
 Arguments:
 
     Input - Supplies the input buffer.
 
+    ldInput - Supplies the first dimension of the input matrix.
+
     Output - Supplies the output buffer.
 
+    ldOutput - Supplies the first dimension of the output matrix.
+
     M - Supplies the number of rows for the input matrix and the number of
         columns for the output matrix.
 
@@ -424,9 +431,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4x4Block(s, N, d, M);
+            MlasTranspose4x4Block(s, ldInput, d, ldOutput);
 
-            s += N * 4;
+            s += ldInput * 4;
             d += 4;
             m -= 4;
         }
@@ -435,15 +442,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose4xNVector(s, 1, d, M);
+            MlasTranspose4xNVector(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 4;
-        Output += M * 4;
+        Output += ldOutput * 4;
         n -= 4;
     }
 
@@ -460,9 +467,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4xNVector(s, N, d, 1);
+            MlasTranspose4xNVector(s, ldInput, d, 1);
 
-            s += N * 4;
+            s += ldInput * 4;
             d += 4;
             m -= 4;
         }
@@ -471,17 +478,29 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += ldOutput;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTranspose(Input, N, Output, M, M, N);
+}
+
 void
 MLASCALL
 MlasTranspose(
@@ -502,7 +521,9 @@ void
 MLASCALL
 MlasTranspose(
     const uint8_t* Input,
+    size_t ldInput,
     uint8_t* Output,
+    size_t ldOutput,
     size_t M,
     size_t N
     )
@@ -511,14 +532,19 @@ MlasTranspose(
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns). The rows of both matrices may be
+    padded, which allows to transpose a tile of a larger matrix.
 
 Arguments:
 
     Input - Supplies the input buffer.
 
+    ldInput - Supplies the first dimension of the input matrix.
+
     Output - Supplies the output buffer.
 
+    ldOutput - Supplies the first dimension of the output matrix.
+
     M - Supplies the number of rows for the input matrix and the number of
         columns for the output matrix.
 
@@ -545,24 +571,24 @@ Return Value:
         size_t m = M;
         while (m >= 16) {
 
-            MlasTranspose16x16Block(s, N, d, M);
+            MlasTranspose16x16Block(s, ldInput, d, ldOutput);
 
-            s += N * 16;
+            s += ldInput * 16;
             d += 16;
             m -= 16;
         }
 
         while (m > 0) {
 
-            MlasTranspose16xNVector(s, 1, d, M);
+            MlasTranspose16xNVector(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 16;
-        Output += M * 16;
+        Output += ldOutput * 16;
         n -= 16;
     }
 #endif
@@ -576,9 +602,9 @@ Return Value:
 
         while (m >= 8) {
 
-            MlasTranspose8x8Block(s, N, d, M);
+            MlasTranspose8x8Block(s, ldInput, d, ldOutput);
 
-            s += N * 8;
+            s += ldInput * 8;
             d += 8;
             m -= 8;
         }
@@ -587,15 +613,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose8xNVector(s, 1, d, M);
+            MlasTranspose8xNVector(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 8;
-        Output += M * 8;
+        Output += ldOutput * 8;
         n -= 8;
     }
 
@@ -612,9 +638,9 @@ Return Value:
 
         while (m >= 8) {
 
-            MlasTranspose8xNVector(s, N, d, 1);
+            MlasTranspose8xNVector(s, ldInput, d, 1);
 
-            s += N * 8;
+            s += ldInput * 8;
             d += 8;
             m -= 8;
         }
@@ -623,17 +649,29 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += ldOutput;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTranspose(Input, N, Output, M, M, N);
+}
+
 void
 MLASCALL
 MlasTranspose(
@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/activation_spill.h"
+
+#include <algorithm>
+
+#include "core/framework/data_types.h"
+#include "core/framework/session_options.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+// Size of a tensor with a static shape, or -1 if it isn't known before running.
+int64_t StaticSizeInBytes(const NodeArg& arg) {
+  const TypeProto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type() || arg.Shape() == nullptr) {
+    return -1;
+  }
+
+  int64_t size = static_cast<int64_t>(
+      DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType()->Size());
+  for (const auto& dim : arg.Shape()->dim()) {
+    if (!dim.has_dim_value()) {
+      return -1;
+    }
+    size *= dim.dim_value();
+  }
+  return size;
+}
+
+// An activation and its uses, by position in the execution order.
+struct Activation {
+  Node* producer;
+  int output_index;
+  int64_t size;
+  size_t position;
+  size_t last_use;
+  // the longest idle gap of the activation, between two consecutive uses
+  size_t gap_begin;
+  size_t gap_end;
+  bool can_spill;
+  bool spilled;
+};
+
+}  // namespace
+
+Status ActivationSpill::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                  const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_ids = graph_viewer.GetNodesInTopologicalOrder();
+  InlinedHashMap<NodeIndex, size_t> positions;
+  for (size_t i = 0; i < node_ids.size(); ++i) {
+    positions[node_ids[i]] = i;
+  }
+
+  const auto& compatible_providers = GetCompatibleExecutionProviders();
+  const auto& graph_outputs = graph.GetOutputs();
+  const size_t prefetch_distance = static_cast<size_t>(prefetch_distance_);
+
+  std::vector<Activation> activations;
+  for (size_t position = 0; position < node_ids.size(); ++position) {
+    Node& node = *graph.GetNode(node_ids[position]);
+    if (!graph_utils::IsSupportedProvider(node, compatible_providers)) {
+      continue;
+    }
+
+    for (size_t output_idx = 0; output_idx < node.OutputDefs().size(); ++output_idx) {
+      const NodeArg* output = node.OutputDefs()[output_idx];
+      const int64_t size = StaticSizeInBytes(*output);
+      if (!output->Exists() || size <= 0 ||
+          std::find(graph_outputs.begin(), graph_outputs.end(), output) != graph_outputs.end()) {
+        continue;
+      }
+
+      // Consumers on other providers read a copy, and the implicit inputs of subgraphs are left as they are.
+      bool can_spill = true;
+      InlinedVector<size_t> uses{position};
+      for (const auto& edge : graph_utils::GraphEdge::GetNodeOutputEdges(node, output_idx)) {
+        const Node& consumer = *graph.GetNode(edge.dst_node);
+        can_spill = can_spill && consumer.GetExecutionProviderType() == node.GetExecutionProviderType() &&
+                    static_cast<size_t>(edge.dst_arg_index) < consumer.InputDefs().size();
+        uses.push_back(positions[edge.dst_node]);
+      }
+
+      if (uses.size() == 1) {
+        continue;
+      }
+
+      std::sort(uses.begin(), uses.end());
+      Activation activation{&node, static_cast<int>(output_idx), size, position, uses.back(), 0, 0, false, false};
+      for (size_t i = 1; i < uses.size(); ++i) {
+        if (uses[i] - uses[i - 1] > activation.gap_end - activation.gap_begin) {
+          activation.gap_begin = uses[i - 1];
+          activation.gap_end = uses[i];
+        }
+      }
+
+      // the activation leaves the device after the last use before the gap, and is back once the prefetch is
+      // triggered, which has to leave at least a node in between
+      activation.can_spill = can_spill && activation.gap_end >= activation.gap_begin + prefetch_distance + 2;
+      activations.push_back(activation);
+    }
+  }
+
+  // Spill the largest activation that is idle across the peak, until the peak fits the budget.
+  size_t num_spilled = 0;
+  while (true) {
+    std::vector<int64_t> deltas(node_ids.size() + 1, 0);
+    for (const Activation& activation : activations) {
+      deltas[activation.position] += activation.size;
+      deltas[activation.last_use + 1] -= activation.size;
+      if (activation.spilled) {
+        deltas[activation.gap_begin + 1] -= activation.size;
+        deltas[activation.gap_end - prefetch_distance] += activation.size;
+      }
+    }
+
+    int64_t usage = 0;
+    int64_t peak = 0;
+    size_t peak_position = 0;
+    for (size_t i = 0; i < node_ids.size(); ++i) {
+      usage += deltas[i];
+      if (usage > peak) {
+        peak = usage;
+        peak_position = i;
+      }
+    }
+
+    if (peak <= budget_bytes_) {
+      LOGS(logger, INFO) << "Estimated peak activation memory of " << peak << " bytes after spilling " << num_spilled
+                         << " activations.";
+      break;
+    }
+
+    Activation* spill = nullptr;
+    for (Activation& activation : activations) {
+      if (activation.can_spill && !activation.spilled && activation.gap_begin < peak_position &&
+          peak_position < activation.gap_end - prefetch_distance &&
+          (spill == nullptr || activation.size > spill->size)) {
+        spill = &activation;
+      }
+    }
+
+    if (spill == nullptr) {
+      LOGS(logger, WARNING) << "The estimated peak activation memory of " << peak << " bytes at node "
+                            << graph.GetNode(node_ids[peak_position])->Name() << " exceeds the budget of "
+                            << budget_bytes_ << " bytes after spilling " << num_spilled
+                            << " activations, and no activation idle across it can be spilled.";
+      break;
+    }
+
+    spill->spilled = true;
+    ++num_spilled;
+  }
+
+  for (const Activation& activation : activations) {
+    if (!activation.spilled) {
+      continue;
+    }
+
+    Node& node = *activation.producer;
+    NodeArg* output = node.MutableOutputDefs()[activation.output_index];
+    const auto consumer_edges = graph_utils::GraphEdge::GetNodeOutputEdges(node, activation.output_index);
+
+    auto& host_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("spill_" + output->Name()),
+                                                 output->TypeAsProto());
+    Node& spill_node = graph.AddNode(graph.GenerateNodeName("spill_" + output->Name()),
+                                     "MemcpyToHost",
+                                     "Spill of " + output->Name(),
+                                     {output},
+                                     {&host_output});
+    spill_node.SetExecutionProviderType(node.GetExecutionProviderType());
+    // spills run eagerly, so that the device memory of the activation is released as soon as possible
+    spill_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_HIGH));
+
+    auto& prefetched_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("prefetch_" + output->Name()),
+                                                       output->TypeAsProto());
+    Node& prefetch_node = graph.AddNode(graph.GenerateNodeName("prefetch_" + output->Name()),
+                                        "MemcpyFromHost",
+                                        "Prefetch of " + output->Name(),
+                                        {&host_output},
+                                        {&prefetched_output});
+    prefetch_node.SetExecutionProviderType(node.GetExecutionProviderType());
+    prefetch_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_HIGH));
+    graph.AddControlEdge(node_ids[activation.gap_end - prefetch_distance], prefetch_node.Index());
+
+    // the consumers after the gap read the prefetched copy
+    for (const auto& edge : consumer_edges) {
+      if (positions[edge.dst_node] >= activation.gap_end) {
+        graph.RemoveEdge(edge.src_node, edge.dst_node, edge.src_arg_index, edge.dst_arg_index);
+        graph.AddEdge(prefetch_node.Index(), edge.dst_node, 0, edge.dst_arg_index);
+      }
+    }
+
+    LOGS(logger, INFO) << "Spill activation " << output->Name() << " of " << activation.size
+                       << " bytes to host memory between nodes " << activation.gap_begin << " and "
+                       << activation.gap_end;
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ActivationSpill
+
+Fits the activations of an inference graph into a device memory budget, so that inputs too large for the device
+still run, more slowly, instead of failing to allocate. It estimates the device memory held by the activations at
+each node of the execution order, from their static sizes and the positions of their producers and consumers, as the
+allocation planner frees them. While the peak is above budget_bytes, it spills the largest activation that is idle
+across the peak: a MemcpyToHost right after its producer moves it to pinned host memory on the copy-out stream, and a
+MemcpyFromHost prefetches it on the copy-in stream prefetch_distance nodes before the first consumer after the idle
+gap, which reads the prefetched copy. The device buffer is then released after the last consumer before the gap.
+
+The prefetch is held back with a control edge from the node prefetch_distance nodes before the consumer. Only the
+activations produced and consumed by nodes of the compatible execution providers, and of static size, are spilled;
+use free dimension overrides to size the activations of models with symbolic dimensions. The copies only overlap the
+compute when the CUDA EP runs them on its own copy streams, i.e. do_copy_in_default_stream is 0.
+*/
+class ActivationSpill : public GraphTransformer {
+ public:
+  ActivationSpill(int64_t budget_bytes, int prefetch_distance,
+                  const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ActivationSpill", compatible_execution_providers),
+        budget_bytes_(budget_bytes),
+        prefetch_distance_(prefetch_distance) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  const int64_t budget_bytes_;
+  const int prefetch_distance_;
+};
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include <limits>
 
 #include "core/optimizer/constant_folding.h"
+#include "core/optimizer/constant_folding_cache.h"
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/optimizer_execution_frame.h"
@@ -17,11 +18,13 @@ namespace onnxruntime {
 ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
                                  bool skip_dequantize_linear,
                                  const InlinedHashSet<std::string_view>& compatible_execution_providers,
-                                 const InlinedHashSet<std::string>& excluded_initializers) noexcept
+                                 const InlinedHashSet<std::string>& excluded_initializers,
+                                 const PathString& cache_dir) noexcept
     : GraphTransformer("ConstantFolding", compatible_execution_providers),
       skip_dequantize_linear_(skip_dequantize_linear),
       excluded_initializers_(excluded_initializers),
-      execution_provider_(execution_provider) {
+      execution_provider_(execution_provider),
+      cache_dir_(cache_dir) {
 }
 
 // We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
@@ -93,6 +96,7 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
   bool have_updated_nodes = false;
   GraphViewer graph_viewer(graph);
   auto& order = graph_viewer.GetNodesInTopologicalOrder();
+  const ConstantFoldingCache cache(cache_dir_);
 
 #if !defined(DISABLE_SPARSE_TENSORS)
   std::function<bool(const std::string&)> is_sparse_initializer_check = [&graph](const std::string& name) -> bool {
@@ -148,79 +152,103 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         continue;
       }
 
+      // the outputs of the nodes with large inputs are looked up in the cache before evaluating the node
+      PathString cache_file_path;
+      const bool use_cache =
+          !cache_dir_.empty() && cache.GetCacheFilePath(*node, constant_inputs, graph.ModelPath(), cache_file_path);
+      std::vector<ONNX_NAMESPACE::TensorProto> cached_outputs;
+      if (use_cache && cache.Load(cache_file_path, *node, cached_outputs, logger)) {
+        for (size_t output_idx = 0; output_idx < cached_outputs.size(); ++output_idx) {
+          ONNX_NAMESPACE::TensorShapeProto result_shape;
+          for (int64_t dim : cached_outputs[output_idx].dims()) {
+            result_shape.add_dim()->set_dim_value(dim);
+          }
+
+          node->MutableOutputDefs()[output_idx]->SetShape(result_shape);
+          graph.AddInitializedTensor(std::move(cached_outputs[output_idx]));
+        }
+
+        converted_to_constant = true;
+      } else {
 #if !defined(DISABLE_SPARSE_TENSORS)
-      // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
-                                         is_sparse_initializer_check);
+        // Create execution frame for executing constant nodes.
+        OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
+                                           is_sparse_initializer_check);
 #else
-      // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
-                                         [](std::string const&) { return false; });
+        // Create execution frame for executing constant nodes.
+        OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
+                                           [](std::string const&) { return false; });
 #endif
 
-      std::vector<int> fetch_mlvalue_idxs;
-      for (const auto* node_out : node->OutputDefs()) {
-        fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
-      }
-
-      // override the EP assigned to the node so that it will use the CPU kernel for Compute.
-      if (!cpu_ep) {
-        node->SetExecutionProviderType(kCpuExecutionProvider);
-      }
+        std::vector<int> fetch_mlvalue_idxs;
+        for (const auto* node_out : node->OutputDefs()) {
+          fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+        }
 
-      auto kernel = info.CreateKernel(node);
+        // override the EP assigned to the node so that it will use the CPU kernel for Compute.
+        if (!cpu_ep) {
+          node->SetExecutionProviderType(kCpuExecutionProvider);
+        }
 
-      // undo the EP change to the value that was assigned at graph partitioning time
-      if (!cpu_ep) {
-        node->SetExecutionProviderType(ep_type);
-      }
+        auto kernel = info.CreateKernel(node);
 
-      if (kernel == nullptr) {
-        LOGS(logger, WARNING) << "Could not find a CPU kernel and hence "
-                              << "can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
+        // undo the EP change to the value that was assigned at graph partitioning time
+        if (!cpu_ep) {
+          node->SetExecutionProviderType(ep_type);
+        }
 
-        // Move on to the next candidate node
-        continue;
-      }
+        if (kernel == nullptr) {
+          LOGS(logger, WARNING) << "Could not find a CPU kernel and hence "
+                                << "can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
 
-      OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
-
-      OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger);
-      ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
-
-      std::vector<OrtValue> fetches;
-      ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
-
-      // Go over all output node args and substitute them with the newly computed tensors, which will be
-      // added to the graph as initializers.
-      ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
-      converted_to_constant = true;
-      for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-        OrtValue& ort_value = fetches[fetch_idx];
-        // XXX: Add support for SparseTensors outputs when we have sparse outputs
-        if (!ort_value.IsTensor()) {
-          LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
-                                << ". Can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
-          converted_to_constant = false;
-          break;
+          // Move on to the next candidate node
+          continue;
         }
-      }
 
-      if (converted_to_constant) {
+        OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
+
+        OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger);
+        ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+
+        std::vector<OrtValue> fetches;
+        ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
+
+        // Go over all output node args and substitute them with the newly computed tensors, which will be
+        // added to the graph as initializers.
+        ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
+        converted_to_constant = true;
         for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
           OrtValue& ort_value = fetches[fetch_idx];
-          // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
-          auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
-          const Tensor& out_tensor = ort_value.Get<Tensor>();
-          ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
+          // XXX: Add support for SparseTensors outputs when we have sparse outputs
+          if (!ort_value.IsTensor()) {
+            LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
+                                  << ". Can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
+            converted_to_constant = false;
+            break;
+          }
+        }
 
-          ONNX_NAMESPACE::TensorShapeProto result_shape;
-          for (auto& dim : out_tensor.Shape().GetDims()) {
-            result_shape.add_dim()->set_dim_value(dim);
+        if (converted_to_constant) {
+          for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
+            OrtValue& ort_value = fetches[fetch_idx];
+            // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
+            auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
+            const Tensor& out_tensor = ort_value.Get<Tensor>();
+            ONNX_NAMESPACE::TensorProto out_tensorproto =
+                utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
+
+            ONNX_NAMESPACE::TensorShapeProto result_shape;
+            for (auto& dim : out_tensor.Shape().GetDims()) {
+              result_shape.add_dim()->set_dim_value(dim);
+            }
+
+            constant_arg_out->SetShape(result_shape);
+            graph.AddInitializedTensor(std::move(out_tensorproto));
           }
 
-          constant_arg_out->SetShape(result_shape);
-          graph.AddInitializedTensor(out_tensorproto);
+          if (use_cache) {
+            cache.Save(cache_file_path, fetches, logger);
+          }
         }
       }
     }
@@ -7,6 +7,7 @@
 #include "core/framework/ort_value.h"
 #include <memory>
 #include "core/framework/execution_provider.h"
+#include "core/common/path_string.h"
 
 namespace onnxruntime {
 
@@ -21,11 +22,13 @@ class ConstantFolding : public GraphTransformer {
   /*! Constant folding will not be applied to nodes that have one of initializers from excluded_initializers as input.
       For pre-training, the trainable weights are those initializers to be excluded.
       \param execution_provider Execution provider instance to execute constant folding.
+      \param cache_dir Directory of a ConstantFoldingCache of the outputs of the nodes with large inputs, or empty.
   */
   ConstantFolding(const IExecutionProvider& execution_provider,
                   bool skip_dequantize_linear,
                   const InlinedHashSet<std::string_view>& compatible_execution_providers = {},
-                  const InlinedHashSet<std::string>& excluded_initializers = {}) noexcept;
+                  const InlinedHashSet<std::string>& excluded_initializers = {},
+                  const PathString& cache_dir = {}) noexcept;
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
@@ -33,6 +36,7 @@ class ConstantFolding : public GraphTransformer {
   bool skip_dequantize_linear_;
   const InlinedHashSet<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
+  const PathString cache_dir_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,274 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/constant_folding_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph.h"
+#include "core/platform/env.h"
+#include "core/platform/path_lib.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Bumped when the information hashed into the key or the file format changes.
+constexpr uint32_t kKeyVersion = 1;
+
+// Nodes with smaller constant inputs are cheaper to fold than to look up.
+constexpr size_t kMinCachedInputBytes = 64 * 1024;
+
+// Bounds the header of an output in a cache file, which holds its type and dims.
+constexpr uint64_t kMaxHeaderBytes = 64 * 1024;
+
+class Hasher {
+ public:
+  void Add(const void* data, size_t len) {
+    // MurmurHash3 takes an int length
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    constexpr size_t kMaxChunk = static_cast<size_t>(std::numeric_limits<int>::max());
+    do {
+      const size_t chunk = std::min(len, kMaxChunk);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk), hash_[0], &hash_);
+      bytes += chunk;
+      len -= chunk;
+    } while (len > 0);
+  }
+
+  // strings are length prefixed so that consecutive strings cannot alias each other
+  void Add(const std::string& value) {
+    AddValue(static_cast<uint64_t>(value.size()));
+    Add(value.data(), value.size());
+  }
+
+  template <typename T>
+  void AddValue(const T& value) {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "AddValue requires a scalar");
+    Add(&value, sizeof(value));
+  }
+
+  std::string ToHexString() const {
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (uint32_t h : hash_) {
+      ss << std::setw(8) << h;
+    }
+    return ss.str();
+  }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+// the CPU kernels may take different code paths, with different rounding, depending on the CPU features
+void HashCpuFeatures(Hasher& hasher) {
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  const bool features[] = {cpu_info.HasAVX(), cpu_info.HasAVX2(), cpu_info.HasAVX512f(),
+                           cpu_info.HasAVX512Skylake(), cpu_info.HasF16C(), cpu_info.HasSSE3(),
+                           cpu_info.HasSSE4_1(), cpu_info.HasArmNeonDot()};
+  for (bool feature : features) {
+    hasher.AddValue(feature);
+  }
+}
+
+void WriteSize(std::ofstream& file, uint64_t size) {
+  file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+}
+
+bool ReadSize(std::ifstream& file, uint64_t& size) {
+  return static_cast<bool>(file.read(reinterpret_cast<char*>(&size), sizeof(size)));
+}
+
+int RenameFile(const PathString& from, const PathString& to) {
+#ifdef _WIN32
+  return _wrename(from.c_str(), to.c_str());
+#else
+  return std::rename(from.c_str(), to.c_str());
+#endif
+}
+
+void RemoveFile(const PathString& path) {
+#ifdef _WIN32
+  _wremove(path.c_str());
+#else
+  std::remove(path.c_str());
+#endif
+}
+
+}  // namespace
+
+bool ConstantFoldingCache::GetCacheFilePath(const Node& node, const InitializedTensorSet& constant_inputs,
+                                            const Path& model_path, PathString& cache_file_path) const {
+  Hasher hasher;
+  hasher.AddValue(kKeyVersion);
+  hasher.Add(ORT_VERSION);
+  HashCpuFeatures(hasher);
+
+  hasher.Add(node.Domain());
+  hasher.Add(node.OpType());
+  hasher.AddValue(node.SinceVersion());
+  hasher.AddValue(node.OutputDefs().size());
+
+  // the attributes are in an unordered map
+  const auto& attributes = node.GetAttributes();
+  std::vector<std::string> attribute_names;
+  for (const auto& attribute : attributes) {
+    attribute_names.push_back(attribute.first);
+  }
+  std::sort(attribute_names.begin(), attribute_names.end());
+  hasher.AddValue(attribute_names.size());
+  for (const auto& name : attribute_names) {
+    hasher.Add(attributes.at(name).SerializeAsString());
+  }
+
+  size_t input_bytes = 0;
+  std::vector<uint8_t> unpacked_data;
+  for (const NodeArg* input : node.InputDefs()) {
+    hasher.AddValue(input->Exists());
+    if (!input->Exists()) {
+      continue;
+    }
+
+    auto entry = constant_inputs.find(input->Name());
+    if (entry == constant_inputs.end() || utils::HasString(*entry->second)) {
+      return false;
+    }
+
+    const ONNX_NAMESPACE::TensorProto& tensor_proto = *entry->second;
+    hasher.AddValue(tensor_proto.data_type());
+    hasher.AddValue(tensor_proto.dims_size());
+    for (int64_t dim : tensor_proto.dims()) {
+      hasher.AddValue(dim);
+    }
+
+    // hash the data rather than its location, e.g. in an external data file
+    if (utils::HasRawData(tensor_proto) && !utils::HasExternalData(tensor_proto)) {
+      hasher.Add(tensor_proto.raw_data());
+      input_bytes += tensor_proto.raw_data().size();
+    } else {
+      if (!utils::UnpackInitializerData(tensor_proto, model_path, unpacked_data).IsOK()) {
+        return false;
+      }
+      hasher.AddValue(static_cast<uint64_t>(unpacked_data.size()));
+      hasher.Add(unpacked_data.data(), unpacked_data.size());
+      input_bytes += unpacked_data.size();
+    }
+  }
+
+  if (input_bytes < kMinCachedInputBytes) {
+    return false;
+  }
+
+  cache_file_path = ConcatPathComponent<ORTCHAR_T>(cache_dir_, ToPathString(hasher.ToHexString() + ".folded"));
+  return true;
+}
+
+bool ConstantFoldingCache::Load(const PathString& cache_file_path, const Node& node,
+                                std::vector<ONNX_NAMESPACE::TensorProto>& outputs,
+                                const logging::Logger& logger) const {
+  std::ifstream file(cache_file_path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  const auto& output_defs = node.OutputDefs();
+  uint64_t num_outputs = 0;
+  bool is_valid = ReadSize(file, num_outputs) && num_outputs == output_defs.size();
+  outputs.clear();
+  for (size_t i = 0; is_valid && i < output_defs.size(); ++i) {
+    uint64_t header_size = 0;
+    is_valid = ReadSize(file, header_size) && header_size <= kMaxHeaderBytes;
+    if (!is_valid) {
+      break;
+    }
+
+    std::string header(static_cast<size_t>(header_size), '\0');
+    ONNX_NAMESPACE::TensorProto& tensor_proto = outputs.emplace_back();
+    size_t data_size = 0;
+    uint64_t stored_data_size = 0;
+    is_valid = file.read(&header[0], static_cast<std::streamsize>(header.size())) &&
+               tensor_proto.ParseFromString(header) &&
+               utils::HasDataType(tensor_proto) && !utils::HasString(tensor_proto) &&
+               utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &data_size).IsOK() &&
+               ReadSize(file, stored_data_size) && stored_data_size == data_size;
+    if (!is_valid) {
+      break;
+    }
+
+    // read the data straight into the initializer
+    tensor_proto.set_name(output_defs[i]->Name());
+    std::string& raw_data = *tensor_proto.mutable_raw_data();
+    raw_data.resize(data_size);
+    is_valid = raw_data.empty() ||
+               static_cast<bool>(file.read(&raw_data[0], static_cast<std::streamsize>(raw_data.size())));
+  }
+
+  if (!is_valid) {
+    LOGS(logger, WARNING) << "Ignoring constant folding cache file " << ToUTF8String(cache_file_path)
+                          << " of node '" << node.Name() << "' as it is invalid. It will be replaced.";
+    outputs.clear();
+  }
+
+  return is_valid;
+}
+
+void ConstantFoldingCache::Save(const PathString& cache_file_path, const std::vector<OrtValue>& outputs,
+                                const logging::Logger& logger) const {
+  if (std::any_of(outputs.begin(), outputs.end(), [](const OrtValue& output) {
+        return !output.IsTensor() || output.Get<Tensor>().IsDataTypeString();
+      })) {
+    return;
+  }
+
+  const Env& env = Env::Default();
+  // another process may create the directory concurrently
+  if (!env.FolderExists(cache_dir_) && !env.CreateFolder(cache_dir_).IsOK() && !env.FolderExists(cache_dir_)) {
+    LOGS(logger, WARNING) << "Failed to create constant folding cache directory " << ToUTF8String(cache_dir_);
+    return;
+  }
+
+  const PathString temp_file_path = cache_file_path + ToPathString("." + std::to_string(env.GetSelfPid()) + ".tmp");
+  bool saved = false;
+  {
+    std::ofstream file(temp_file_path, std::ios::binary);
+    WriteSize(file, outputs.size());
+    for (const OrtValue& output : outputs) {
+      const Tensor& tensor = output.Get<Tensor>();
+      ONNX_NAMESPACE::TensorProto header;
+      header.set_data_type(tensor.GetElementType());
+      for (int64_t dim : tensor.Shape().GetDims()) {
+        header.add_dims(dim);
+      }
+
+      const std::string serialized_header = header.SerializeAsString();
+      WriteSize(file, serialized_header.size());
+      file.write(serialized_header.data(), static_cast<std::streamsize>(serialized_header.size()));
+      // the data is written from the kernel output without an intermediate copy
+      WriteSize(file, tensor.SizeInBytes());
+      file.write(static_cast<const char*>(tensor.DataRaw()), static_cast<std::streamsize>(tensor.SizeInBytes()));
+    }
+
+    file.close();
+    saved = !file.fail();
+  }
+
+  // a failed rename means another process has the file open on Windows, which saved the same outputs
+  if (!saved || RenameFile(temp_file_path, cache_file_path) != 0) {
+    RemoveFile(temp_file_path);
+    LOGS(logger, WARNING) << "Failed to save constant folding cache file " << ToUTF8String(cache_file_path);
+  }
+}
+
+}  // namespace onnxruntime
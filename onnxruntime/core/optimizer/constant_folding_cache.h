@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/common/path_string.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/basic_types.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+class Node;
+class Path;
+
+/**
+@class ConstantFoldingCache
+
+Directory of the outputs of nodes folded by ConstantFolding, so that later sessions (typically in other processes)
+do not evaluate them again. The outputs are stored in a file named after a hash of the op, its attributes and the
+content of its constant inputs, so the file is found for the same computation in any model, under any session
+configuration. Only nodes with large inputs are cached, such as weight transposes or the dequantization of
+initializers.
+
+A cached output is read from the file straight into the raw data of the initializer replacing it, without the
+inputs or a kernel output being materialized.
+*/
+class ConstantFoldingCache {
+ public:
+  explicit ConstantFoldingCache(const PathString& cache_dir) : cache_dir_(cache_dir) {}
+
+  /** Gets the path of the cache file of the outputs of node, or returns false if they are not cached. */
+  bool GetCacheFilePath(const Node& node, const InitializedTensorSet& constant_inputs, const Path& model_path,
+                        PathString& cache_file_path) const;
+
+  /** Loads the outputs of node from the cache file, named after the node outputs. Returns false if there is
+      no valid cache file. */
+  bool Load(const PathString& cache_file_path, const Node& node, std::vector<ONNX_NAMESPACE::TensorProto>& outputs,
+            const logging::Logger& logger) const;
+
+  /** Saves the outputs of a node to the cache file, creating the cache directory if needed. The file is written to
+      a temporary file that is renamed into place, so concurrent readers never see a partial file. Failures are
+      logged as the session does not need the cache. */
+  void Save(const PathString& cache_file_path, const std::vector<OrtValue>& outputs,
+            const logging::Logger& logger) const;
+
+ private:
+  PathString cache_dir_;
+};
+
+}  // namespace onnxruntime
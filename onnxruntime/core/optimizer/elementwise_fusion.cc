@@ -0,0 +1,255 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// bounds the size of the operand buffers of the FusedElementwise kernel
+constexpr size_t kMaxFusedNodes = 16;
+
+bool IsFusableNode(const Node& node, const InlinedHashSet<std::string_view>& compatible_providers) {
+  if (!graph_utils::IsSupportedProvider(node, compatible_providers)) {
+    return false;
+  }
+
+  const bool is_binary = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+                         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+                         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+                         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14});
+  const bool is_unary = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13});
+  if (!(is_binary && node.InputDefs().size() == 2) && !(is_unary && node.InputDefs().size() == 1)) {
+    return false;
+  }
+
+  const TypeProto* type = node.OutputDefs()[0]->TypeAsProto();
+  return type != nullptr && type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+bool HasSameDim(const TensorShapeProto_Dimension& dim, const TensorShapeProto_Dimension& other) {
+  if (utils::HasDimValue(dim) && utils::HasDimValue(other)) {
+    return dim.dim_value() == other.dim_value();
+  }
+
+  return utils::HasDimParam(dim) && utils::HasDimParam(other) && dim.dim_param() == other.dim_param();
+}
+
+// the broadcasts of an input to the output that the FusedElementwise kernel supports
+enum class InputBroadcast {
+  None,
+  Full,
+  Scalar,
+  InnerVector,
+};
+
+InputBroadcast GetInputBroadcast(const TensorShapeProto* shape, const TensorShapeProto& output_shape) {
+  if (shape == nullptr || shape->dim_size() > output_shape.dim_size()) {
+    return InputBroadcast::None;
+  }
+
+  const int rank = shape->dim_size();
+  if (rank == output_shape.dim_size()) {
+    bool is_full = true;
+    for (int i = 0; i < rank && is_full; i++) {
+      is_full = HasSameDim(shape->dim(i), output_shape.dim(i));
+    }
+
+    if (is_full) {
+      return InputBroadcast::Full;
+    }
+  }
+
+  for (int i = 0; i < rank - 1; i++) {
+    if (!utils::HasDimValue(shape->dim(i)) || shape->dim(i).dim_value() != 1) {
+      return InputBroadcast::None;
+    }
+  }
+
+  if (rank == 0 || (utils::HasDimValue(shape->dim(rank - 1)) && shape->dim(rank - 1).dim_value() == 1)) {
+    return InputBroadcast::Scalar;
+  }
+
+  const auto& inner_dim = output_shape.dim(output_shape.dim_size() - 1);
+  if (utils::HasDimValue(shape->dim(rank - 1)) && utils::HasDimValue(inner_dim) &&
+      shape->dim(rank - 1).dim_value() == inner_dim.dim_value()) {
+    return InputBroadcast::InnerVector;
+  }
+
+  return InputBroadcast::None;
+}
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  const auto& compatible_providers = GetCompatibleExecutionProviders();
+
+  InlinedHashMap<NodeIndex, size_t> topological_positions;
+  for (size_t i = 0; i < node_topology_list.size(); i++) {
+    auto* node = graph.GetNode(node_topology_list[i]);
+    if (node != nullptr) {
+      ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+      topological_positions[node->Index()] = i;
+    }
+  }
+
+  // Each group grows backwards from its last node, so walk the nodes from the graph outputs up.
+  for (auto it = node_topology_list.rbegin(); it != node_topology_list.rend(); ++it) {
+    Node* root = graph.GetNode(*it);
+    if (root == nullptr || !IsFusableNode(*root, compatible_providers)) {
+      continue;
+    }
+
+    const TensorShapeProto* output_shape = root->OutputDefs()[0]->Shape();
+    if (output_shape == nullptr) {
+      continue;
+    }
+
+    // Add the producers of the inputs of the group while all the consumers of their outputs are in the group,
+    // which keeps the group free of paths leaving and reentering it.
+    InlinedHashSet<NodeIndex> group{root->Index()};
+    InlinedVector<Node*> group_nodes{root};
+    for (bool grown = true; grown && group_nodes.size() < kMaxFusedNodes;) {
+      grown = false;
+      for (size_t i = 0; i < group_nodes.size() && group_nodes.size() < kMaxFusedNodes; i++) {
+        const Node* node = group_nodes[i];
+        for (const NodeArg* input : node->InputDefs()) {
+          Node* producer = graph.GetMutableProducerNode(input->Name());
+          if (producer == nullptr ||
+              group.count(producer->Index()) > 0 ||
+              !IsFusableNode(*producer, compatible_providers) ||
+              producer->GetExecutionProviderType() != root->GetExecutionProviderType() ||
+              graph.NodeProducesGraphOutput(*producer)) {
+            continue;
+          }
+
+          const auto consumers = graph.GetConsumerNodes(input->Name());
+          if (!std::all_of(consumers.begin(), consumers.end(), [&group](const Node* consumer) {
+                return consumer != nullptr && group.count(consumer->Index()) > 0;
+              })) {
+            continue;
+          }
+
+          group.insert(producer->Index());
+          group_nodes.push_back(producer);
+          grown = true;
+          if (group_nodes.size() >= kMaxFusedNodes) {
+            break;
+          }
+        }
+      }
+    }
+
+    if (group_nodes.size() < 2) {
+      continue;
+    }
+
+    std::sort(group_nodes.begin(), group_nodes.end(), [&topological_positions](const Node* a, const Node* b) {
+      return topological_positions[a->Index()] < topological_positions[b->Index()];
+    });
+
+    // the values consumed by the group that are produced outside of it
+    InlinedVector<NodeArg*> inputs;
+    bool has_full_input = false;
+    bool can_broadcast = true;
+    for (Node* node : group_nodes) {
+      for (NodeArg* input : node->MutableInputDefs()) {
+        const Node* producer = graph.GetProducerNode(input->Name());
+        if ((producer != nullptr && group.count(producer->Index()) > 0) ||
+            std::find(inputs.begin(), inputs.end(), input) != inputs.end()) {
+          continue;
+        }
+
+        const InputBroadcast broadcast = GetInputBroadcast(input->Shape(), *output_shape);
+        can_broadcast = can_broadcast && broadcast != InputBroadcast::None;
+        has_full_input = has_full_input || broadcast == InputBroadcast::Full;
+        inputs.push_back(input);
+      }
+    }
+
+    // the output must not be larger than the inputs broadcast together
+    if (!can_broadcast || !has_full_input) {
+      continue;
+    }
+
+    const int64_t num_inputs = static_cast<int64_t>(inputs.size());
+    InlinedHashMap<const NodeArg*, int64_t> operand_indices;
+    for (int64_t i = 0; i < num_inputs; i++) {
+      operand_indices[inputs[i]] = i;
+    }
+
+    std::vector<std::string> operations;
+    std::vector<int64_t> operands;
+    for (const Node* node : group_nodes) {
+      const auto& input_defs = node->InputDefs();
+      operations.push_back(node->OpType());
+      operands.push_back(operand_indices[input_defs[0]]);
+      operands.push_back(input_defs.size() > 1 ? operand_indices[input_defs[1]] : -1);
+      operand_indices[node->OutputDefs()[0]] = num_inputs + static_cast<int64_t>(operations.size()) - 1;
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused elementwise operations",
+                                     inputs,
+                                     {},
+                                     {},
+                                     kMSDomain);
+    fused_node.AddAttribute("operations", operations);
+    fused_node.AddAttribute("operands", operands);
+    fused_node.SetExecutionProviderType(root->GetExecutionProviderType());
+
+    // the input edges of the first node are moved by FinalizeNodeFusion
+    for (auto node = group_nodes.begin() + 1; node != group_nodes.end(); ++node) {
+      for (auto edge = (*node)->InputEdgesBegin(), end = (*node)->InputEdgesEnd(); edge != end; ++edge) {
+        if (group.count(edge->GetNode().Index()) == 0) {
+          const NodeArg* input = (*node)->InputDefs()[edge->GetDstArgIndex()];
+          graph.AddEdge(edge->GetNode().Index(), fused_node.Index(), edge->GetSrcArgIndex(),
+                        static_cast<int>(operand_indices[input]));
+        }
+      }
+    }
+
+    for (NodeArg* input : inputs) {
+      for (Node* node : group_nodes) {
+        graph.RemoveConsumerNode(input->Name(), node);
+      }
+
+      graph.AddConsumerNode(input->Name(), &fused_node);
+    }
+
+    graph.UpdateProducerNode(root->OutputDefs()[0]->Name(), fused_node.Index());
+
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse;
+    for (Node* node : group_nodes) {
+      nodes_to_fuse.push_back(*node);
+    }
+
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, fused_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
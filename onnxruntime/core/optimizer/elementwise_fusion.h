@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseFusion
+
+Fuses the maximal groups of connected float elementwise nodes (Add, Sub, Mul, Div and unary activations) into a
+FusedElementwise node, which evaluates the whole expression in one pass instead of writing a tensor per node. It
+runs after the pattern fusions such as GeluFusion and FastGeluFusion, so these keep the nodes they match. On CUDA
+the kernel of the FusedElementwise node is generated for its expression and compiled by NVRTC.
+
+The values produced within a group are consumed only within the group, and every input of the group has the
+shape of the output, a single element or the size of the innermost output dimension.
+*/
+class ElementwiseFusion : public GraphTransformer {
+ public:
+  ElementwiseFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
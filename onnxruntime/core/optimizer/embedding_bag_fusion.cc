@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+bool HasRank(const NodeArg& arg, int rank) {
+  const auto* shape = arg.Shape();
+  return shape != nullptr && shape->dim_size() == rank;
+}
+
+// Returns the EmbeddingBag mode of a reduction of axis 1 of a rank-3 tensor which drops the axis, or nullptr.
+const char* GetEmbeddingBagMode(const Graph& graph, const Node& reduce_node) {
+  const char* mode = nullptr;
+  bool axes_from_input = false;
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceSum", {1, 11})) {
+    mode = "sum";
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceSum", {13})) {
+    mode = "sum";
+    axes_from_input = true;
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMean", {1, 11, 13})) {
+    mode = "mean";
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMax", {1, 11, 12, 13})) {
+    mode = "max";
+  } else {
+    return nullptr;
+  }
+
+  if (!optimizer_utils::IsAttributeWithExpectedValue(reduce_node, "keepdims", static_cast<int64_t>(0))) {
+    return nullptr;
+  }
+
+  InlinedVector<int64_t> axes;
+  if (axes_from_input) {
+    const auto& input_defs = reduce_node.InputDefs();
+    if (input_defs.size() < 2 || !input_defs[1]->Exists() ||
+        !optimizer_utils::AppendTensorFromInitializer(graph, *input_defs[1], axes)) {
+      return nullptr;
+    }
+  } else {
+    const auto& attributes = reduce_node.GetAttributes();
+    auto it = attributes.find("axes");
+    if (it == attributes.end()) {
+      return nullptr;
+    }
+    axes.assign(it->second.ints().begin(), it->second.ints().end());
+  }
+
+  if (axes.size() != 1 || (axes[0] != 1 && axes[0] != -2)) {
+    return nullptr;
+  }
+  return mode;
+}
+
+}  // namespace
+
+/**
+EmbeddingBagFusion will fuse subgraph like below into EmbeddingBag:
+  W [rows, dim]   indices [bags, bag_size]
+        |            |
+        v            v
+      Gather (axis 0)                                       W       indices
+             |                                              |          |
+             v  [bags, bag_size, dim]           ---->       v          v
+  ReduceSum/ReduceMean/ReduceMax (axes 1, keepdims 0)      EmbeddingBag (mode sum/mean/max)
+             |                                                    |
+             v  [bags, dim]                                       v
+ */
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& gather_node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(gather_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(gather_node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(gather_node, GetCompatibleExecutionProviders()) ||
+        gather_node.GetOutputEdgesCount() != 1 ||
+        graph.NodeProducesGraphOutput(gather_node)) {
+      continue;
+    }
+
+    const auto* axis_attr = graph_utils::GetNodeAttribute(gather_node, "axis");
+    if (axis_attr != nullptr && axis_attr->i() != 0 && axis_attr->i() != -2) {
+      continue;
+    }
+
+    // the kernel pools float rows of a 2-D table selected by 2-D indices
+    const auto& gather_inputs = gather_node.InputDefs();
+    const auto* data_type = gather_inputs[0]->Type();
+    if (data_type == nullptr || *data_type != "tensor(float)" ||
+        !HasRank(*gather_inputs[0], 2) || !HasRank(*gather_inputs[1], 2)) {
+      continue;
+    }
+
+    Node& reduce_node = *graph.GetNode(gather_node.OutputNodesBegin()->Index());
+    if (reduce_node.GetExecutionProviderType() != gather_node.GetExecutionProviderType() ||
+        reduce_node.InputDefs()[0] != gather_node.OutputDefs()[0]) {
+      continue;
+    }
+
+    const char* mode = GetEmbeddingBagMode(graph, reduce_node);
+    if (mode == nullptr) {
+      continue;
+    }
+
+    Node& embedding_bag_node = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"),
+                                             "EmbeddingBag",
+                                             "fused " + gather_node.Name() + " and " + reduce_node.Name(),
+                                             {gather_node.MutableInputDefs()[0], gather_node.MutableInputDefs()[1]},
+                                             {},
+                                             nullptr,
+                                             kMSDomain);
+    embedding_bag_node.AddAttribute("mode", std::string(mode));
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    embedding_bag_node.SetExecutionProviderType(gather_node.GetExecutionProviderType());
+
+    // move output definitions and edges from reduce_node to embedding_bag_node. delete gather_node and reduce_node.
+    graph_utils::FinalizeNodeFusion(graph, {gather_node, reduce_node}, embedding_bag_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <variant>
 
+#include "core/common/parse_string.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/nhwc_transformer.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
@@ -17,6 +18,7 @@
 #if !defined(ORT_MINIMAL_BUILD)
 
 #include "core/mlas/inc/mlas.h"
+#include "core/optimizer/activation_spill.h"
 #include "core/optimizer/attention_fusion.h"
 #include "core/optimizer/bias_dropout_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
@@ -30,7 +32,9 @@
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/free_dim_override_transformer.h"
@@ -39,6 +43,7 @@
 #include "core/optimizer/gemm_activation_fusion.h"
 #include "core/optimizer/gemm_sum_fusion.h"
 #include "core/optimizer/gemm_transpose_fusion.h"
+#include "core/optimizer/group_norm_fusion.h"
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/layer_norm_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
@@ -52,6 +57,7 @@
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/qdq_s8_to_u8.h"
 #include "core/optimizer/qdq_transformer/relu_quantizelinear.h"
+#include "core/optimizer/qlinear_conv_add_fusion.h"
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
@@ -177,7 +183,13 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
       // no filtering on execution provider for L1 optimizations as they only use official ONNX operators
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
-      transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq));
+      // the outputs of expensive folds are kept with the optimized models, for the sessions that miss that cache
+      const PathString constant_folding_cache_dir = ToPathString(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOptimizedModelCacheDir, ""));
+      transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq,
+                                                                  InlinedHashSet<std::string_view>{},
+                                                                  InlinedHashSet<std::string>{},
+                                                                  constant_folding_cache_dir));
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
@@ -220,11 +232,14 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
           transformers.emplace_back(std::make_unique<QDQS8ToU8Transformer>(cpu_ep));
         }
         transformers.emplace_back(std::make_unique<QDQSelectorActionTransformer>(qdq_is_int8_allowed));
+        transformers.emplace_back(std::make_unique<QDQCudaSelectorActionTransformer>());
       }
 
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<MatMulIntegerToFloatFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<DynamicQuantizeMatMulFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<EmbeddingBagFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<GroupNormFusion>(cpu_ep));
 
       transformers.emplace_back(std::make_unique<ConvActivationFusion>(cpu_cuda_rocm_acl_armnn_eps));
 
@@ -265,13 +280,31 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       }
       auto cpu_allocator = cpu_execution_provider.GetAllocator(0, OrtMemTypeDefault);
       transformers.emplace_back(std::make_unique<NhwcTransformer>(std::move(cpu_allocator)));
+      // after NhwcTransformer, which only transposes the activation input and output of a QLinearConv
+      transformers.emplace_back(std::make_unique<QLinearConvAddFusion>(cpu_ep));
       // NCHWCtransformer should have a higher priority versus this. Because NCHWCtransformer also do the similiar things
       // of fusion patterns and target on CPU. However, NCHWCtransformer will reorder the layout to nchwc which is only available for
       // x86-64 cpu, not edge cpu like arm. But This tranformer could be used by opencl-ep/cpu-ep. So
       // we will prefer NhwcTransformer once ort runs on x86-64 CPU, otherwise ConvAddActivationFusion is enabled.
       // this PR #6351 implemented similiar fusion-pattern but only for CUDA, and can only fuse conv-add-relu, while we can fuse more activation.
       transformers.emplace_back(std::make_unique<ConvAddActivationFusion>(cpu_ep));
+      // after the fusions above and in Level2, which map part of the elementwise nodes to dedicated kernels
+      const InlinedHashSet<std::string_view> cpu_cuda_eps = {onnxruntime::kCpuExecutionProvider,
+                                                             onnxruntime::kCudaExecutionProvider};
+      transformers.emplace_back(std::make_unique<ElementwiseFusion>(cpu_cuda_eps));
 #endif
+      // last, as it estimates the activation memory of the final nodes
+      const std::string spill_budget =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigActivationSpillBudget, "0");
+      int64_t spill_budget_bytes = 0;
+      ORT_ENFORCE(TryParseStringWithClassicLocale(spill_budget, spill_budget_bytes) && spill_budget_bytes >= 0,
+                  "Invalid ", kOrtSessionOptionsConfigActivationSpillBudget, ": ", spill_budget);
+      if (spill_budget_bytes > 0) {
+        // a prefetch issued two nodes ahead hides its copy behind the compute of these nodes
+        const InlinedHashSet<std::string_view> cuda_rocm_eps = {onnxruntime::kCudaExecutionProvider,
+                                                                onnxruntime::kRocmExecutionProvider};
+        transformers.emplace_back(std::make_unique<ActivationSpill>(spill_budget_bytes, 2, cuda_rocm_eps));
+      }
     } break;
 
     default:
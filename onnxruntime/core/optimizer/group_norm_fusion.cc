@@ -0,0 +1,244 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/group_norm_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Gets the values of a constant float initializer of shape `dims`, after dropping its leading dimensions of 1.
+bool GetFloatConstantValues(const Graph& graph, const NodeArg& arg, const InlinedVector<int64_t>& dims,
+                            std::vector<float>& values) {
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (tensor_proto == nullptr || tensor_proto->data_type() != TensorProto_DataType_FLOAT ||
+      tensor_proto->dims_size() < static_cast<int>(dims.size())) {
+    return false;
+  }
+
+  const int leading_dims = tensor_proto->dims_size() - static_cast<int>(dims.size());
+  for (int i = 0; i < tensor_proto->dims_size(); ++i) {
+    if (tensor_proto->dims(i) != (i < leading_dims ? 1 : dims[i - leading_dims])) {
+      return false;
+    }
+  }
+
+  Initializer initializer{*tensor_proto, graph.ModelPath()};
+  values.assign(initializer.data<float>(), initializer.data<float>() + initializer.size());
+  return true;
+}
+
+// Returns true if the Reshape node restores the shape of x, taken either from Shape(x) or from the static shape of x.
+// shape_node is set to the Shape node if there's one.
+bool IsReshapeToShapeOf(const Graph& graph, const Node& reshape_node, const NodeArg& x, const Node*& shape_node) {
+  shape_node = graph_utils::GetInputNode(reshape_node, 1);
+  if (shape_node != nullptr) {
+    return graph_utils::IsSupportedOptypeVersionAndDomain(*shape_node, "Shape", {1, 13}) &&
+           shape_node->InputDefs()[0] == &x;
+  }
+
+  InlinedVector<int64_t> shape;
+  if (!optimizer_utils::AppendTensorFromInitializer(graph, *reshape_node.InputDefs()[1], shape)) {
+    return false;
+  }
+
+  const auto* x_shape = x.Shape();
+  if (static_cast<int>(shape.size()) != x_shape->dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < x_shape->dim_size(); ++i) {
+    if (!x_shape->dim(i).has_dim_value() || x_shape->dim(i).dim_value() != shape[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the Mul or Add consumer of node with a constant per channel operand of the given shape, or nullptr.
+Node* GetPerChannelConsumer(Graph& graph, const Node& node, const std::string& op_type,
+                            const InlinedVector<int64_t>& channel_dims, std::vector<float>& values) {
+  if (!optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+    return nullptr;
+  }
+
+  Node& next_node = *graph.GetNode(node.OutputNodesBegin()->Index());
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(next_node, op_type, {7, 13, 14}) ||
+      next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return nullptr;
+  }
+
+  const auto& inputs = next_node.InputDefs();
+  const NodeArg* operand = inputs[0] == node.OutputDefs()[0] ? inputs[1] : inputs[0];
+  // the operand must not broadcast the output to a higher rank than X
+  const auto* operand_shape = operand->Shape();
+  if (operand_shape == nullptr || operand_shape->dim_size() > static_cast<int>(channel_dims.size()) + 1 ||
+      !GetFloatConstantValues(graph, *operand, channel_dims, values)) {
+    return nullptr;
+  }
+  return &next_node;
+}
+
+NodeArg& AddChannelInitializer(Graph& graph, const std::string& name, const std::vector<float>& values) {
+  ONNX_NAMESPACE::TensorProto initializer;
+  initializer.set_name(graph.GenerateNodeArgName(name));
+  initializer.add_dims(static_cast<int64_t>(values.size()));
+  initializer.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  initializer.set_raw_data(values.data(), values.size() * sizeof(float));
+  return graph_utils::AddInitializer(graph, initializer);
+}
+
+}  // namespace
+
+/**
+GroupNormFusion will fuse subgraph like below into GroupNorm, where the affine transform of InstanceNormalization
+applies per group and the optional Mul and Add apply per channel:
+          X (N, C, H, W)
+            |
+            v
+  Reshape (0, groups, -1)
+            |
+            v
+  InstanceNormalization (scale, B of size groups)                       X      gamma (C)   beta (C)
+            |                                                            |         |          |
+            v                                                 ---->      v         v          v
+  Reshape (Shape(X))                                                    GroupNorm (epsilon, groups)
+            |                                                                       |
+            v                                                                       v
+  Mul (C, 1, 1)  [optional]
+            |
+            v
+  Add (C, 1, 1)  [optional]
+            |
+            v
+ */
+Status GroupNormFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  InlinedVector<std::reference_wrapper<Node>> nodes_to_remove;
+
+  for (auto node_index : node_topology_list) {
+    nodes_to_remove.clear();
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& instance_norm_node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(instance_norm_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(instance_norm_node, "InstanceNormalization", {6}) ||
+        !graph_utils::IsSupportedProvider(instance_norm_node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, instance_norm_node, 1)) {
+      continue;
+    }
+
+    // the first Reshape splits the channels of X in groups
+    const Node* p_reshape1 = graph_utils::GetInputNode(instance_norm_node, 0);
+    if (p_reshape1 == nullptr ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(*p_reshape1, "Reshape", {5, 13, 14}) ||
+        p_reshape1->GetExecutionProviderType() != instance_norm_node.GetExecutionProviderType() ||
+        !optimizer_utils::CheckOutputEdges(graph, *p_reshape1, 1) ||
+        optimizer_utils::IsAttributeWithExpectedValue(*p_reshape1, "allowzero", static_cast<int64_t>(1))) {
+      continue;
+    }
+    Node& reshape1 = *graph.GetNode(p_reshape1->Index());
+
+    NodeArg* x = reshape1.MutableInputDefs()[0];
+    const auto* x_shape = x->Shape();
+    if (x_shape == nullptr || x_shape->dim_size() < 3 || !x_shape->dim(1).has_dim_value()) {
+      continue;
+    }
+    const int64_t channels = x_shape->dim(1).dim_value();
+
+    InlinedVector<int64_t> group_shape;
+    if (graph_utils::GetInputNode(reshape1, 1) != nullptr ||
+        !optimizer_utils::AppendTensorFromInitializer(graph, *reshape1.InputDefs()[1], group_shape) ||
+        group_shape.size() != 3 || group_shape[2] != -1) {
+      continue;
+    }
+    const int64_t groups = group_shape[1];
+    if (groups <= 0 || channels % groups != 0 ||
+        (group_shape[0] != 0 &&
+         !(x_shape->dim(0).has_dim_value() && x_shape->dim(0).dim_value() == group_shape[0]))) {
+      continue;
+    }
+
+    std::vector<float> group_scale;
+    std::vector<float> group_bias;
+    if (!GetFloatConstantValues(graph, *instance_norm_node.InputDefs()[1], {groups}, group_scale) ||
+        !GetFloatConstantValues(graph, *instance_norm_node.InputDefs()[2], {groups}, group_bias)) {
+      continue;
+    }
+
+    // the second Reshape restores the shape of X
+    Node& reshape2 = *graph.GetNode(instance_norm_node.OutputNodesBegin()->Index());
+    const Node* shape_node = nullptr;
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(reshape2, "Reshape", {5, 13, 14}) ||
+        reshape2.GetExecutionProviderType() != instance_norm_node.GetExecutionProviderType() ||
+        !IsReshapeToShapeOf(graph, reshape2, *x, shape_node)) {
+      continue;
+    }
+
+    nodes_to_remove.push_back(reshape1);
+    // the Shape node is removed with the Reshape if it has no other consumer
+    if (shape_node != nullptr && optimizer_utils::CheckOutputEdges(graph, *shape_node, 1)) {
+      nodes_to_remove.push_back(*graph.GetNode(shape_node->Index()));
+    }
+    nodes_to_remove.push_back(instance_norm_node);
+    nodes_to_remove.push_back(reshape2);
+
+    // a per channel operand broadcasts to X as (C, 1, ..., 1)
+    InlinedVector<int64_t> channel_dims(static_cast<size_t>(x_shape->dim_size() - 1), 1);
+    channel_dims[0] = channels;
+
+    std::vector<float> channel_scale(static_cast<size_t>(channels), 1.0f);
+    std::vector<float> channel_bias(static_cast<size_t>(channels), 0.0f);
+    if (Node* mul_node = GetPerChannelConsumer(graph, nodes_to_remove.back(), "Mul", channel_dims, channel_scale)) {
+      nodes_to_remove.push_back(*mul_node);
+    }
+    if (Node* add_node = GetPerChannelConsumer(graph, nodes_to_remove.back(), "Add", channel_dims, channel_bias)) {
+      nodes_to_remove.push_back(*add_node);
+    }
+
+    // fold the per group affine transform of InstanceNormalization into the per channel one
+    const int64_t channels_per_group = channels / groups;
+    std::vector<float> gamma(static_cast<size_t>(channels));
+    std::vector<float> beta(static_cast<size_t>(channels));
+    for (int64_t c = 0; c < channels; ++c) {
+      const int64_t g = c / channels_per_group;
+      gamma[c] = group_scale[g] * channel_scale[c];
+      beta[c] = group_bias[g] * channel_scale[c] + channel_bias[c];
+    }
+
+    const auto* epsilon_attr = graph_utils::GetNodeAttribute(instance_norm_node, "epsilon");
+    const float epsilon = epsilon_attr != nullptr ? epsilon_attr->f() : 1e-5f;
+
+    Node& group_norm_node = graph.AddNode(graph.GenerateNodeName("GroupNorm"),
+                                          "GroupNorm",
+                                          "fused GroupNorm subgraph of " + instance_norm_node.Name(),
+                                          {x,
+                                           &AddChannelInitializer(graph, "GroupNorm_gamma", gamma),
+                                           &AddChannelInitializer(graph, "GroupNorm_beta", beta)},
+                                          {},
+                                          nullptr,
+                                          kMSDomain);
+    group_norm_node.AddAttribute("epsilon", epsilon);
+    group_norm_node.AddAttribute("groups", groups);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    group_norm_node.SetExecutionProviderType(instance_norm_node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_remove, group_norm_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,279 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/mixed_precision_transformer.h"
+
+#include <algorithm>
+#include <map>
+
+#include "core/framework/data_types.h"
+#include "core/framework/kernel_registry.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsFloatTensor(const NodeArg& arg) {
+  if (!arg.Exists()) {
+    return false;
+  }
+
+  const TypeProto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Returns the type string of the formal parameter of the schema that the input or output at index binds to.
+const std::string* GetFormalTypeStr(const OpSchema& schema, bool is_input, size_t index) {
+  const auto& formals = is_input ? schema.inputs() : schema.outputs();
+  if (formals.empty()) {
+    return nullptr;
+  }
+
+  if (index >= formals.size()) {
+    if (formals.back().GetOption() != OpSchema::FormalParameterOption::Variadic) {
+      return nullptr;
+    }
+
+    index = formals.size() - 1;
+  }
+
+  return &formals[index].GetTypeStr();
+}
+
+// Adds the type constraints bound by defs to type_constraints, with float replaced by target_type.
+// Returns false if a float def is not bound to a type constraint, e.g. a float only scale input.
+bool AddTypeConstraints(const OpSchema& schema, const ConstPointerContainer<std::vector<NodeArg*>>& defs,
+                        bool is_input, MLDataType target_type,
+                        std::unordered_map<std::string, MLDataType>& type_constraints) {
+  const auto& constraint_map = schema.typeConstraintMap();
+  size_t index = 0;
+  for (const NodeArg* def : defs) {
+    const size_t def_index = index++;
+    if (!def->Exists() || def->TypeAsProto() == nullptr) {
+      continue;
+    }
+
+    const std::string* type_str = GetFormalTypeStr(schema, is_input, def_index);
+    const bool is_float = IsFloatTensor(*def);
+    if (type_str == nullptr || constraint_map.find(*type_str) == constraint_map.end()) {
+      if (is_float) {
+        return false;
+      }
+
+      continue;
+    }
+
+    type_constraints[*type_str] = is_float ? target_type : DataTypeImpl::TypeFromProto(*def->TypeAsProto());
+  }
+
+  return true;
+}
+
+NodeArg& CreateTypedNodeArg(Graph& graph, const NodeArg& base_arg, const std::string& base_name,
+                            TensorProto_DataType elem_type) {
+  TypeProto type = *base_arg.TypeAsProto();
+  type.mutable_tensor_type()->set_elem_type(elem_type);
+  return graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(base_name), &type);
+}
+
+}  // namespace
+
+MixedPrecisionTransformer::MixedPrecisionTransformer(TensorProto_DataType target_type,
+                                                     const KernelRegistryManager& kernel_registry_manager,
+                                                     InlinedHashSet<std::string> allow_ops,
+                                                     const InlinedHashSet<std::string>& deny_ops)
+    : GraphTransformer("MixedPrecisionTransformer"),
+      target_type_(target_type),
+      target_tensor_type_(target_type == TensorProto_DataType_BFLOAT16 ? DataTypeImpl::GetTensorType<BFloat16>()
+                                                                       : DataTypeImpl::GetTensorType<MLFloat16>()),
+      kernel_registry_manager_(kernel_registry_manager),
+      allow_ops_(allow_ops.empty() ? DefaultAllowOps() : std::move(allow_ops)) {
+  ORT_ENFORCE(target_type == TensorProto_DataType_FLOAT16 || target_type == TensorProto_DataType_BFLOAT16,
+              "Mixed precision requires float16 or bfloat16. Got ", target_type);
+
+  for (const auto& op_type : deny_ops) {
+    allow_ops_.erase(op_type);
+  }
+
+  for (const auto& op_type : Fp32AccumulationOps()) {
+    allow_ops_.erase(op_type);
+  }
+}
+
+const InlinedHashSet<std::string>& MixedPrecisionTransformer::DefaultAllowOps() {
+  // compute bound ops, plus the elementwise and data movement ops typically found between them
+  static const InlinedHashSet<std::string> allow_ops = {
+      "Add", "AveragePool", "BiasGelu", "Concat", "Conv", "ConvTranspose",
+      "Div", "FastGelu", "Flatten", "FusedConv", "FusedGemm", "FusedMatMul",
+      "Gather", "Gelu", "Gemm", "GlobalAveragePool", "GlobalMaxPool", "Identity",
+      "LeakyRelu", "MatMul", "MaxPool", "Mul", "Pad", "Relu",
+      "Reshape", "Resize", "Sigmoid", "Slice", "Split", "Squeeze",
+      "Sub", "Tanh", "Transpose", "Unsqueeze", "Where"};
+  return allow_ops;
+}
+
+const InlinedHashSet<std::string>& MixedPrecisionTransformer::Fp32AccumulationOps() {
+  // the range of float16 and the mantissa of bfloat16 are not enough to accumulate over an axis
+  static const InlinedHashSet<std::string> fp32_ops = {
+      "Attention", "BatchNormalization", "BiasSoftmax", "CumSum",
+      "EmbedLayerNormalization", "GroupNorm", "InstanceNormalization", "LayerNormalization",
+      "LogSoftmax", "LpNormalization", "MeanVarianceNormalization", "MultiHeadAttention",
+      "ReduceL1", "ReduceL2", "ReduceLogSum", "ReduceLogSumExp",
+      "ReduceMean", "ReduceProd", "ReduceSum", "ReduceSumSquare",
+      "SimplifiedLayerNormalization", "SkipLayerNormalization", "SkipSimplifiedLayerNormalization", "Softmax"};
+  return fp32_ops;
+}
+
+bool MixedPrecisionTransformer::HasKernel(const std::string& op_type, const std::string& domain, int version,
+                                          const std::unordered_map<std::string, MLDataType>& type_constraints,
+                                          const std::string& provider_type) const {
+  for (const KernelRegistry* registry : kernel_registry_manager_.GetKernelRegistriesByProviderType(provider_type)) {
+    const KernelCreateInfo* kernel_create_info = nullptr;
+    if (registry->TryFindKernel(op_type, domain, version, type_constraints, provider_type,
+                                &kernel_create_info)
+            .IsOK()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool MixedPrecisionTransformer::CanConvert(const Node& node) const {
+  if (allow_ops_.find(node.OpType()) == allow_ops_.end() ||
+      node.GetExecutionProviderType().empty() ||
+      node.ContainsSubgraph() ||
+      node.Op() == nullptr) {
+    return false;
+  }
+
+  const auto has_float_def = [](const NodeArg* def) { return IsFloatTensor(*def); };
+  if (std::none_of(node.InputDefs().begin(), node.InputDefs().end(), has_float_def) &&
+      std::none_of(node.OutputDefs().begin(), node.OutputDefs().end(), has_float_def)) {
+    return false;
+  }
+
+  std::unordered_map<std::string, MLDataType> type_constraints;
+  if (!AddTypeConstraints(*node.Op(), node.InputDefs(), /*is_input*/ true, target_tensor_type_, type_constraints) ||
+      !AddTypeConstraints(*node.Op(), node.OutputDefs(), /*is_input*/ false, target_tensor_type_, type_constraints)) {
+    return false;
+  }
+
+  return HasKernel(node.OpType(), node.Domain(), node.SinceVersion(), type_constraints,
+                   node.GetExecutionProviderType());
+}
+
+Status MixedPrecisionTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                            const logging::Logger& logger) const {
+  // nodes with subgraphs are not converted, so the values of the main graph flowing into subgraphs stay float
+  if (graph_level > 0) {
+    return Status::OK();
+  }
+
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  InlinedHashSet<NodeIndex> converted_nodes;
+  for (NodeIndex index : order) {
+    const Node* node = graph.GetNode(index);
+    if (node != nullptr && CanConvert(*node)) {
+      converted_nodes.insert(index);
+    }
+  }
+
+  if (converted_nodes.empty()) {
+    return Status::OK();
+  }
+
+  const int onnx_opset = graph.DomainToVersionMap().at(kOnnxDomain);
+  const auto add_cast = [&](NodeArg& input, NodeArg& output, TensorProto_DataType to,
+                            const std::string& provider_type) {
+    const MLDataType from_type = DataTypeImpl::TypeFromProto(*input.TypeAsProto());
+    const MLDataType to_type = DataTypeImpl::TypeFromProto(*output.TypeAsProto());
+    Node& cast = graph.AddNode(graph.GenerateNodeName("MixedPrecisionCast"), "Cast",
+                               "Cast inserted by MixedPrecisionTransformer", {&input}, {&output});
+    cast.AddAttribute("to", static_cast<int64_t>(to));
+    // every CPU Cast kernel handles float16 and bfloat16
+    cast.SetExecutionProviderType(
+        HasKernel("Cast", kOnnxDomain, onnx_opset, {{"T1", from_type}, {"T2", to_type}}, provider_type)
+            ? provider_type
+            : kCpuExecutionProvider);
+  };
+
+  // float values of the graph to their lower precision copies, shared by all converted consumers
+  InlinedHashMap<const NodeArg*, NodeArg*> converted_values;
+
+  for (NodeIndex index : order) {
+    if (converted_nodes.find(index) == converted_nodes.end()) {
+      continue;
+    }
+
+    Node& node = *graph.GetNode(index);
+    const std::string& provider_type = node.GetExecutionProviderType();
+    std::map<const NodeArg*, NodeArg*> replacement_defs;
+
+    for (NodeArg* input : node.MutableInputDefs()) {
+      if (!IsFloatTensor(*input) || replacement_defs.count(input) > 0) {
+        continue;
+      }
+
+      auto converted = converted_values.find(input);
+      if (converted == converted_values.end()) {
+        NodeArg* new_input = nullptr;
+        const TensorProto* initializer = graph_utils::GetConstantInitializer(graph, input->Name(),
+                                                                             /*check_outer_scope*/ false);
+        if (initializer != nullptr) {
+          Initializer float_initializer{*initializer, graph.ModelPath()};
+          const std::string name = graph.GenerateNodeArgName(input->Name());
+          new_input = &graph_utils::AddInitializer(graph, target_type_ == TensorProto_DataType_BFLOAT16
+                                                              ? float_initializer.ToBFloat16(name)
+                                                              : float_initializer.ToFP16(name));
+        } else {
+          // a graph input or the output of an unconverted node
+          new_input = &CreateTypedNodeArg(graph, *input, input->Name(), target_type_);
+          add_cast(*input, *new_input, target_type_, provider_type);
+        }
+
+        converted = converted_values.emplace(input, new_input).first;
+      }
+
+      replacement_defs[input] = converted->second;
+    }
+
+    for (NodeArg* output : node.MutableOutputDefs()) {
+      if (!IsFloatTensor(*output)) {
+        continue;
+      }
+
+      NodeArg& new_output = CreateTypedNodeArg(graph, *output, output->Name(), target_type_);
+      replacement_defs[output] = &new_output;
+      converted_values.emplace(output, &new_output);
+
+      // keep the float value for the graph output and the unconverted consumers
+      const auto consumers = graph.GetConsumerNodes(output->Name());
+      const bool needs_float_value =
+          graph.IsOutput(output) ||
+          std::any_of(consumers.begin(), consumers.end(), [&converted_nodes](const Node* consumer) {
+            return converted_nodes.find(consumer->Index()) == converted_nodes.end();
+          });
+      if (needs_float_value) {
+        add_cast(new_output, *output, TensorProto_DataType_FLOAT, provider_type);
+      }
+    }
+
+    node.ReplaceDefs(replacement_defs);
+  }
+
+  LOGS(logger, INFO) << "Converted " << converted_nodes.size() << " nodes to "
+                     << (target_type_ == TensorProto_DataType_BFLOAT16 ? "bfloat16" : "float16");
+  modified = true;
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
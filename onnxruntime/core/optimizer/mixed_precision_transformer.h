@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MixedPrecisionTransformer
+
+Converts float nodes to float16 or bfloat16 in the main graph, so that vision and transformer models run in the lower
+precision type without offline conversion. It runs after partitioning, and a node is converted only if the kernel
+registry of its execution provider has a kernel for the lower precision type.
+
+The op types converted are given by an allow list, less the op types of a deny list. Ops that accumulate over an
+axis, such as Softmax, the normalizations and the reductions, are kept in float regardless of the lists.
+
+Values produced and consumed by converted nodes are stored in the lower precision type. A Cast node is inserted
+where a value crosses between a converted node and an unconverted node or a graph input or output, and constant
+float initializers consumed by converted nodes are converted.
+*/
+class MixedPrecisionTransformer : public GraphTransformer {
+ public:
+  MixedPrecisionTransformer(ONNX_NAMESPACE::TensorProto_DataType target_type,
+                            const KernelRegistryManager& kernel_registry_manager,
+                            InlinedHashSet<std::string> allow_ops = {},
+                            const InlinedHashSet<std::string>& deny_ops = {});
+
+  // The op types converted if the allow list is empty.
+  static const InlinedHashSet<std::string>& DefaultAllowOps();
+
+  // The op types always kept in float.
+  static const InlinedHashSet<std::string>& Fp32AccumulationOps();
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool CanConvert(const Node& node) const;
+
+  bool HasKernel(const std::string& op_type, const std::string& domain, int version,
+                 const std::unordered_map<std::string, MLDataType>& type_constraints,
+                 const std::string& provider_type) const;
+
+  ONNX_NAMESPACE::TensorProto_DataType target_type_;
+  MLDataType target_tensor_type_;
+  const KernelRegistryManager& kernel_registry_manager_;
+  InlinedHashSet<std::string> allow_ops_;
+};
+
+}  // namespace onnxruntime
@@ -14,6 +14,90 @@ using namespace onnx_layout_transformation;
 
 namespace onnxruntime {
 
+namespace {
+
+using IsSupportedFn = bool (*)(const api::GraphRef& graph, const api::NodeRef& node);
+
+// A CPU kernel with a channels last variant.
+struct NhwcConversion {
+  std::string_view domain;
+  std::string_view op_type;
+
+  // Op type of the channels last kernel in the MS domain. Empty if the op itself takes a channels_last attribute.
+  std::string_view nhwc_op_type;
+
+  // Whether channels last is the native layout of the kernel, in which case the channels first kernel transposes
+  // internally and converting is always worth the transposes around the node. Otherwise the node is only converted
+  // if its input is already channels last, so that the transpose on the input cancels.
+  bool always_convert;
+
+  // Optional check of the node's types and attributes against the constraints of the channels last kernel.
+  IsSupportedFn is_supported;
+};
+
+bool IsNhwcMaxPoolSupported(const api::GraphRef& graph, const api::NodeRef& node) {
+  // the optional "indices" output is not produced by NhwcMaxPool
+  auto outputs = node.Outputs();
+  if (outputs.size() == 2 && !outputs[1].empty()) {
+    return false;
+  }
+
+  api::DataType dtype = graph.GetValueInfo(outputs[0])->DType();
+  return dtype == api::DataType::UINT8 || dtype == api::DataType::INT8 || dtype == api::DataType::FLOAT;
+}
+
+bool IsNhwcConvSupported(const api::GraphRef& graph, const api::NodeRef& node) {
+  // the optional "Z" input of FusedConv is not supported by NhwcConv
+  auto inputs = node.Inputs();
+  if (inputs.size() > 3 && !inputs[3].empty()) {
+    return false;
+  }
+
+  // the CPU kernel of NhwcConv is float only
+  return graph.GetValueInfo(inputs[0])->DType() == api::DataType::FLOAT;
+}
+
+// Add kernels here as channels last variants are implemented. Layout insensitive ops (elementwise, Resize, Pad,
+// Concat, etc.) do not need an entry: transpose optimization pushes the transposes through them.
+constexpr NhwcConversion nhwc_conversions[] = {
+    {kOnnxDomain, "QLinearConv", "QLinearConv", true, nullptr},
+    {kMSDomain, "QLinearConv", "", true, nullptr},
+    {kMSDomain, "QLinearAveragePool", "", false, nullptr},
+    {kMSDomain, "QLinearGlobalAveragePool", "", false, nullptr},
+    {kOnnxDomain, "MaxPool", "NhwcMaxPool", false, &IsNhwcMaxPoolSupported},
+    {kOnnxDomain, "Conv", "NhwcConv", false, &IsNhwcConvSupported},
+    {kMSDomain, "FusedConv", "NhwcConv", false, &IsNhwcConvSupported},
+};
+
+const NhwcConversion* GetNhwcConversion(const api::NodeRef& node) {
+  auto domain = node.Domain();
+  if (domain == "ai.onnx") {
+    domain = kOnnxDomain;
+  }
+
+  for (const auto& conversion : nhwc_conversions) {
+    if (conversion.op_type == node.OpType() && conversion.domain == domain) {
+      return &conversion;
+    }
+  }
+
+  return nullptr;
+}
+
+// Returns true if the input is the output of a transpose from channels last, which is the case for the output of a
+// node that has already been converted.
+bool IsChannelsLastInput(const api::GraphRef& graph, std::string_view input, size_t rank) {
+  auto producer = graph.GetNodeProducingOutput(input);
+  if (producer == nullptr || !producer->IsOp("Transpose")) {
+    return false;
+  }
+
+  auto perm = producer->GetAttributeInts("perm");
+  return perm.has_value() && *perm == ChannelLastToFirstPerm(rank);
+}
+
+}  // namespace
+
 Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
 #if defined(ORT_MINIMAL_BUILD)
   // update the producer/consumer info as previous optimizations may have invalidated it.
@@ -30,42 +114,55 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
   auto api_graph = MakeApiGraph(graph, cpu_allocator_, kCpuExecutionProvider);
 
   modified = false;
+
+  // Nodes are visited in topological order, so a node following a converted node sees the transpose back to
+  // channels first on its input and is converted too. Transpose optimization then cancels the transposes between
+  // the converted nodes, leaving the region channels last.
   for (std::unique_ptr<api::NodeRef>& node : api_graph->Nodes()) {
-    // Only QLinearConv needs to be handled explicitly. The rest will be transformed if needed during transpose
-    // optimization.
-    if (node->OpType() == "QLinearConv") {
-      auto domain = node->Domain();
-
-      // Skip if domain is incorrect
-      if (domain != kOnnxDomain && domain != kMSDomain) {
-        continue;
-      }
+    const NhwcConversion* conversion = GetNhwcConversion(*node);
+    if (conversion == nullptr || node->GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
 
-      // Skip if already transformed
-      if (node->GetAttributeIntDefault("channels_last", 0) == 1) {
-        continue;
-      }
+    // Skip if already transformed
+    if (node->GetAttributeIntDefault("channels_last", 0) == 1) {
+      continue;
+    }
 
-      // Skip if unknown rank
-      auto shape = NodeFromApiNode(*node).InputDefs()[0]->Shape();
-      if (shape == nullptr) {
-        continue;
-      }
+    // Skip if unknown rank
+    auto inputs = node->Inputs();
+    auto shape = api_graph->GetValueInfo(inputs[0])->Shape();
+    if (!shape.has_value() || shape->size() < 3) {
+      continue;
+    }
 
-      // Convert to channels last
-      size_t rank = shape->dim_size();
-      node->SetAttributeInt("channels_last", 1);
+    size_t rank = shape->size();
+    if (!conversion->always_convert && !IsChannelsLastInput(*api_graph, inputs[0], rank)) {
+      continue;
+    }
 
-      std::vector<int64_t> input_perm = ChannelFirstToLastPerm(rank);
-      std::vector<int64_t> output_perm = ChannelLastToFirstPerm(rank);
-      WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
+    if (conversion->is_supported != nullptr && !conversion->is_supported(*api_graph, *node)) {
+      continue;
+    }
 
-      if (domain != kMSDomain) {
-        SwapNodeOpTypeAndDomain(*api_graph, *node, "QLinearConv", kMSDomain);
-      }
+    // Convert to channels last
+    std::vector<int64_t> input_perm = ChannelFirstToLastPerm(rank);
+    std::vector<int64_t> output_perm = ChannelLastToFirstPerm(rank);
+    WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
 
-      modified = true;
+    if (conversion->nhwc_op_type.empty()) {
+      node->SetAttributeInt("channels_last", 1);
+    } else {
+      auto new_node = SwapNodeOpTypeAndDomain(*api_graph, *node, conversion->nhwc_op_type, kMSDomain);
+      if (conversion->nhwc_op_type == "NhwcMaxPool") {
+        // Only relevant for the indices output. Prohibited for NhwcMaxPool.
+        new_node->ClearAttribute("storage_order");
+      } else if (conversion->nhwc_op_type == "QLinearConv") {
+        new_node->SetAttributeInt("channels_last", 1);
+      }
     }
+
+    modified = true;
   }
 
   if (modified) {
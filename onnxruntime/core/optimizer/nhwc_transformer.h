@@ -14,6 +14,10 @@ namespace onnxruntime {
 
 Transformer that optimizes the graph by using NHWC nodes instead of NCHW nodes
 and inserts nodes to transpose tensors as needed.
+
+Ops whose kernel is natively NHWC (e.g. QLinearConv) are always converted. Other ops with an NHWC kernel
+(e.g. the pools and the float NhwcConv) are only converted if their input is already NHWC, so that the regions between
+the converted nodes stay NHWC once transpose optimization removes the transposes between them.
 */
 class NhwcTransformer : public GraphTransformer {
  private:
@@ -95,6 +95,13 @@ class OptimizerExecutionFrame final : public IExecutionFrame {
                           const std::vector<int>& fetch_mlvalue_idxs,
                           const std::vector<OrtValue>& fetches = {});
 
+  // Frame whose inputs are fed rather than being initializers of info, so that info can be reused with other inputs.
+  OptimizerExecutionFrame(const Info& info,
+                          const std::vector<int>& feed_mlvalue_idxs,
+                          const std::vector<OrtValue>& feeds,
+                          const std::vector<int>& fetch_mlvalue_idxs,
+                          const std::vector<OrtValue>& fetches);
+
   ~OptimizerExecutionFrame() override = default;
 
  private:
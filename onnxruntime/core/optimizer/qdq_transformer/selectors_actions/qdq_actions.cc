@@ -3,6 +3,7 @@
 
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_actions.h"
 
+#include "core/graph/node_attr_utils.h"
 #include "core/optimizer/qdq_transformer/qdq_util.h"
 
 namespace onnxruntime {
@@ -73,6 +74,41 @@ std::vector<NodeAndMoveInfo> ConvMoves() {
   return moves;
 }
 
+// moves for replacing a LayerNormalization node with a DQ input with the qlinear version
+std::vector<NodeAndMoveInfo> LayerNormMoves(bool has_bias) {
+  NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+  NTO::NodeLocation q{NTO::NodeType::kOutput, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAll(dq, ArgType::kInput),                                // append all inputs from dq
+      MoveAndAppend(target, ArgType::kInput, 1, ArgType::kInput),  // append scale (input 1) from target
+      MoveAndAppend(q, ArgType::kInput, 1, ArgType::kInput),       // append scale (input 1) from q
+      MoveAndAppend(q, ArgType::kInput, 2, ArgType::kInput)};      // append zp (input 2) from q
+
+  if (has_bias) {
+    moves.push_back(MoveAndAppend(target, ArgType::kInput, 2, ArgType::kInput));  // append bias (input 2) from target
+  }
+  moves.push_back(MoveAll(q, ArgType::kOutput));  // and use the outputs from q
+
+  return moves;
+}
+
+// moves for replacing a DQ of a table -> Gather with DequantizeGather
+std::vector<NodeAndMoveInfo> DequantizeGatherMoves() {
+  NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAndAppend(dq, ArgType::kInput, 0, ArgType::kInput),      // append table (input 0) from dq
+      MoveAndAppend(target, ArgType::kInput, 1, ArgType::kInput),  // append indices (input 1) from target
+      MoveAndAppend(dq, ArgType::kInput, 1, ArgType::kInput),      // append scale (input 1) from dq
+      MoveAndAppend(dq, ArgType::kInput, 2, ArgType::kInput),      // append zp (input 2) from dq
+      MoveAll(target, ArgType::kOutput)};
+
+  return moves;
+}
+
 QDQReplaceWithNew MatMulIntToFloatReplacer() {
   NTO::NodeLocation dq1{NTO::NodeType::kInput, 0};
   NTO::NodeLocation dq2{NTO::NodeType::kInput, 1};
@@ -119,6 +155,18 @@ struct SetOptionalZeroPoint {
 
     return tensor_proto;
   };
+  // We assume this function won't fail
+  static const ONNX_NAMESPACE::TensorProto init_optional_zero_point_int16() {
+    // guid as arbitrary name to provide a unique value
+    const char* const name = "init_optional_zero_point_int16_5c0f8b0e-6f6e-4d59-9b21-3c5a8e4d7a12";
+    std::array<int16_t, 1> a{0};
+    ONNX_NAMESPACE::TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT16);
+    tensor_proto.set_raw_data(a.data(), sizeof(int16_t));
+
+    return tensor_proto;
+  };
   static ONNX_NAMESPACE::TensorProto GetOptionalZeroPointInt8() {
     static ONNX_NAMESPACE::TensorProto proto = init_optional_zero_point_int8();
     return proto;
@@ -127,6 +175,10 @@ struct SetOptionalZeroPoint {
     static ONNX_NAMESPACE::TensorProto proto = init_optional_zero_point_uint8();
     return proto;
   }
+  static ONNX_NAMESPACE::TensorProto GetOptionalZeroPointInt16() {
+    static ONNX_NAMESPACE::TensorProto proto = init_optional_zero_point_int16();
+    return proto;
+  }
 };
 
 void SetOptionalZeroPoint::UpdateNodes(Graph& graph, const NodesToOptimize& selected_nodes) {
@@ -151,14 +203,16 @@ void SetOptionalZeroPoint::UpdateNodes(Graph& graph, const NodesToOptimize& sele
     }
 
     bool is_default_zp_signed = false;
+    bool is_default_zp_int16 = false;
     if (is_dq) {
       auto input_type = input_defs[0]->TypeAsProto()->tensor_type().elem_type();
       is_default_zp_signed = ONNX_NAMESPACE::TensorProto_DataType_INT8 == input_type;
+      is_default_zp_int16 = ONNX_NAMESPACE::TensorProto_DataType_INT16 == input_type;
     }
 
-    const ONNX_NAMESPACE::TensorProto& zp_tensor_proto = is_default_zp_signed
-                                                             ? GetOptionalZeroPointInt8()
-                                                             : GetOptionalZeroPointUint8();
+    const ONNX_NAMESPACE::TensorProto& zp_tensor_proto = is_default_zp_int16    ? GetOptionalZeroPointInt16()
+                                                         : is_default_zp_signed ? GetOptionalZeroPointInt8()
+                                                                                : GetOptionalZeroPointUint8();
 
     const ONNX_NAMESPACE::TensorProto* dummy_zp_tensor_proto;
     if (!graph.GetInitializedTensor(zp_tensor_proto.name(), dummy_zp_tensor_proto)) {
@@ -207,6 +261,72 @@ ConvReplaceWithQLinear::ConvReplaceWithQLinear()
     : ReplaceWithQLinear(kOnnxDomain, ConvMoves()) {
 }
 
+SoftmaxReplaceWithQLinear::SoftmaxReplaceWithQLinear()
+    : UnaryReplaceWithQLinear(kMSDomain) {
+}
+
+NodeAttributes SoftmaxReplaceWithQLinear::ExtraAttributes(const RuntimeState& state) const {
+  const Node& target = state.selected_nodes.Target();
+  const int64_t opset = target.SinceVersion();
+
+  // the default axis changed in opset 13 too, so make it explicit
+  NodeAttributes extra_attributes;
+  if (target.GetAttributes().count("axis") == 0) {
+    utils::SetNodeAttribute(utils::MakeAttribute("axis", static_cast<int64_t>(opset < 13 ? 1 : -1)),
+                            extra_attributes);
+  }
+  utils::SetNodeAttribute(utils::MakeAttribute("opset", opset), extra_attributes);
+
+  return extra_attributes;
+}
+
+LookupTableReplaceWithQLinear::LookupTableReplaceWithQLinear()
+    : QDQReplaceWithNew(kMSDomain, "QLinearUnary", UnaryMoves()) {
+}
+
+NodeAttributes LookupTableReplaceWithQLinear::ExtraAttributes(const RuntimeState& state) const {
+  // the attributes of the node, e.g. alpha of Elu, are copied with it
+  NodeAttributes extra_attributes;
+  utils::SetNodeAttribute(utils::MakeAttribute("op_type", state.selected_nodes.Target().OpType()), extra_attributes);
+  return extra_attributes;
+}
+
+GatherReplaceWithDequantizeGather::GatherReplaceWithDequantizeGather()
+    : QDQReplaceWithNew(kMSDomain, "DequantizeGather", DequantizeGatherMoves()) {
+}
+
+LayerNormReplaceWithQLinear::LayerNormReplaceWithQLinear()
+    : qlinear_layer_norm_replacer_(kMSDomain, "QLinearLayerNormalization", LayerNormMoves(false)),
+      qlinear_layer_norm_with_bias_replacer_(kMSDomain, "QLinearLayerNormalization", LayerNormMoves(true)) {
+}
+
+Status LayerNormReplaceWithQLinear::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
+  if (HasBias(selected_nodes)) {
+    return qlinear_layer_norm_with_bias_replacer_.Run(graph, selected_nodes);
+  }
+
+  return qlinear_layer_norm_replacer_.Run(graph, selected_nodes);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status LayerNormReplaceWithQLinear::RunForSave(Graph& graph,
+                                               const NodesToOptimize& selected_nodes,
+                                               const SatRuntimeOptimizationSaveContext& save_context,
+                                               SavedState& saved_state,
+                                               bool& graph_modified) const {
+  if (HasBias(selected_nodes)) {
+    return qlinear_layer_norm_with_bias_replacer_.RunForSave(graph, selected_nodes, save_context, saved_state,
+                                                             graph_modified);
+  }
+
+  return qlinear_layer_norm_replacer_.RunForSave(graph, selected_nodes, save_context, saved_state, graph_modified);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+MatMulS16S8ReplaceWithIntegerToFloat::MatMulS16S8ReplaceWithIntegerToFloat()
+    : QDQReplaceWithNew{MatMulIntToFloatReplacer()} {
+}
+
 MatMulReplaceWithQLinear::MatMulReplaceWithQLinear()
     : matmul_int_to_float_replacer_{MatMulIntToFloatReplacer()},
       qlinear_matmul_replacer_{kOnnxDomain} {
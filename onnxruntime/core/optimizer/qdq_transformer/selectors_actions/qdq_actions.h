@@ -57,6 +57,48 @@ struct ConvReplaceWithQLinear : ReplaceWithQLinear {
   ConvReplaceWithQLinear();
 };
 
+// replace Softmax with QLinearSoftmax, which is told the opset of the Softmax as the semantics of axis change in 13
+struct SoftmaxReplaceWithQLinear : UnaryReplaceWithQLinear {
+  SoftmaxReplaceWithQLinear();
+
+ private:
+  NodeAttributes ExtraAttributes(const RuntimeState& state) const override;
+};
+
+// replace a unary node with QLinearUnary, which looks up the node given by its op_type from a table
+struct LookupTableReplaceWithQLinear : QDQReplaceWithNew {
+  LookupTableReplaceWithQLinear();
+
+ private:
+  NodeAttributes ExtraAttributes(const RuntimeState& state) const override;
+};
+
+// replace DQ of a table -> Gather with DequantizeGather, which dequantizes only the gathered rows
+struct GatherReplaceWithDequantizeGather : QDQReplaceWithNew {
+  GatherReplaceWithDequantizeGather();
+};
+
+// replace LayerNormalization with QLinearLayerNormalization, keeping its float Scale and optional B
+struct LayerNormReplaceWithQLinear : public Action {
+  LayerNormReplaceWithQLinear();
+
+  Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  Status RunForSave(Graph& graph, const NodesToOptimize& selected_nodes,
+                    const SatRuntimeOptimizationSaveContext& save_context,
+                    SavedState& saved_state, bool& graph_modified) const override;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+ private:
+  static bool HasBias(const NodesToOptimize& selected_nodes) {
+    return selected_nodes.Target().InputDefs().size() > 2;
+  }
+
+  QDQReplaceWithNew qlinear_layer_norm_replacer_;
+  QDQReplaceWithNew qlinear_layer_norm_with_bias_replacer_;
+};
+
 struct MatMulReplaceWithQLinear : public Action {
   MatMulReplaceWithQLinear();
 
@@ -67,6 +109,11 @@ struct MatMulReplaceWithQLinear : public Action {
   BinaryReplaceWithQLinear qlinear_matmul_replacer_;
 };
 
+// replace a MatMul of int16 activations by int8 weights with MatMulIntegerToFloat, as there is no int16 QLinearMatMul
+struct MatMulS16S8ReplaceWithIntegerToFloat : QDQReplaceWithNew {
+  MatMulS16S8ReplaceWithIntegerToFloat();
+};
+
 struct GemmReplaceWithQuant : public Action {
   GemmReplaceWithQuant();
 
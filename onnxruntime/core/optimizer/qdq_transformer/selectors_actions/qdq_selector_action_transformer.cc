@@ -70,6 +70,23 @@ void DropDQNodesRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+void DequantizeGatherQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 2 nodes. DQ of the table, Gather, with no Q of the output.
+  // Replace with DequantizeGather, which dequantizes only the gathered rows. Delete the original nodes.
+  const std::string action_name{"DequantizeGather"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::GatherReplaceWithDequantizeGather>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::DequantizeGatherSelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Gather", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 void UnaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
   // 3 nodes. DQ, target, Q
   // Replace with internal QLinear version of operator. Delete all original nodes.
@@ -82,7 +99,67 @@ void UnaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
                                                          {{"AveragePool", {}},
                                                           {"LeakyRelu", {}},
                                                           {"GlobalAveragePool", {}},
-                                                          {"Sigmoid", {}}},
+                                                          {"Sigmoid", {}},
+                                                          {SelectorActionRegistry::OpVersionsMapKey("Gelu", kMSDomain), {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
+void LookupTableQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ, target, Q
+  // Replace with QLinearUnary, which looks up the target from a table. Delete all original nodes.
+  const std::string action_name{"LookupTable"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::LookupTableReplaceWithQLinear>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::LookupTableSelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Elu", {}},
+                                                          {"Erf", {}},
+                                                          {"Exp", {}},
+                                                          {"HardSigmoid", {}},
+                                                          {"HardSwish", {}},
+                                                          {"Selu", {}},
+                                                          {"Softplus", {}},
+                                                          {"Softsign", {}},
+                                                          {"Tanh", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
+void SoftmaxQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ, target, Q
+  // Replace with QLinearSoftmax. Delete all original nodes.
+  const std::string action_name{"Softmax"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::SoftmaxReplaceWithQLinear>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::UnarySelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Softmax", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
+void LayerNormQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ for X, target, Q
+  // Replace with QLinearLayerNormalization. Delete all original nodes.
+  const std::string action_name{"LayerNorm"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::LayerNormReplaceWithQLinear>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::LayerNormSelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"LayerNormalization", {}}},
                                                          std::move(selector),
                                                          std::move(action));
 #else
@@ -171,6 +248,46 @@ void MatMulQDQRules(SelectorActionRegistry& qdq_selector_action_registry, bool i
 #endif
 }
 
+void MatMulS8S8QDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 4 nodes. 2 x DQ int8 for inputs, target, Q int8
+  // Replace with QLinearMatMul.
+  // Delete all original nodes.
+  const std::string action_name{"MatMulS8S8"};
+
+  std::unique_ptr<Action> action = std::make_unique<QDQ::MatMulReplaceWithQLinear>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::MatMulS8S8Selector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"MatMul", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
+void MatMulS16S8QDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ int16 A, DQ int8 B, target. A Q of the output, if any, is kept.
+  // Replace with MatMulIntegerToFloat, as there is no int16 QLinearMatMul.
+  // Delete the original nodes.
+  const std::string action_name{"MatMulS16S8"};
+
+  std::unique_ptr<Action> action = std::make_unique<QDQ::MatMulS16S8ReplaceWithIntegerToFloat>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::MatMulS16S8Selector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"MatMul", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 void GemmQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
   // 3 to 5 nodes. 0=DQ A, 1=DQ B, 2=DQ C(optional), 3=Gemm, 4=Q Y(optional)
   // Replace with QGemm
@@ -196,16 +313,29 @@ SelectorActionRegistry CreateSelectorActionRegistry(bool is_int8_allowed) {
 
   DropQDQNodesRules(qdq_selector_action_registry);
   DropDQNodesRules(qdq_selector_action_registry);
+  DequantizeGatherQDQRules(qdq_selector_action_registry);
   UnaryOpQDQRules(qdq_selector_action_registry);
+  LookupTableQDQRules(qdq_selector_action_registry);
+  SoftmaxQDQRules(qdq_selector_action_registry);
+  LayerNormQDQRules(qdq_selector_action_registry);
   BinaryOpQDQRules(qdq_selector_action_registry);
   VariadicOpQDQRules(qdq_selector_action_registry);
   ConvQDQRules(qdq_selector_action_registry, is_int8_allowed);
   MatMulQDQRules(qdq_selector_action_registry, is_int8_allowed);
+  MatMulS16S8QDQRules(qdq_selector_action_registry);
   GemmQDQRules(qdq_selector_action_registry);
 
   return qdq_selector_action_registry;
 }
 
+SelectorActionRegistry CreateCudaSelectorActionRegistry() {
+  SelectorActionRegistry qdq_selector_action_registry;
+
+  MatMulS8S8QDQRules(qdq_selector_action_registry);
+
+  return qdq_selector_action_registry;
+}
+
 }  // namespace
 
 QDQSelectorActionTransformer::QDQSelectorActionTransformer(
@@ -218,4 +348,12 @@ QDQSelectorActionTransformer::QDQSelectorActionTransformer(
           {kCpuExecutionProvider}} {
 }
 
+QDQCudaSelectorActionTransformer::QDQCudaSelectorActionTransformer(const SatApplyContextVariant& apply_context)
+    : SelectorActionTransformer{
+          "QDQCudaSelectorActionTransformer",
+          CreateCudaSelectorActionRegistry(),
+          apply_context,
+          {kCudaExecutionProvider}} {
+}
+
 }  // namespace onnxruntime
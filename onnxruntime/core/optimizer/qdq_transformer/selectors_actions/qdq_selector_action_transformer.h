@@ -25,4 +25,13 @@ class QDQSelectorActionTransformer : public SelectorActionTransformer {
   QDQSelectorActionTransformer(bool is_int8_allowed, const SatApplyContextVariant& apply_context = {});
 };
 
+/**
+Transformer that fuses the int8 QDQ MatMul node groups assigned to the CUDA EP into QLinearMatMul, which runs on
+int8 tensor cores instead of dequantizing to float. The other QDQ node groups keep running as float ops on CUDA.
+*/
+class QDQCudaSelectorActionTransformer : public SelectorActionTransformer {
+ public:
+  QDQCudaSelectorActionTransformer(const SatApplyContextVariant& apply_context = {});
+};
+
 }  // namespace onnxruntime
@@ -148,6 +148,93 @@ bool UnaryNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node&
   return dt_input == dt_output;
 }
 
+bool LookupTableNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
+                                         const std::vector<const Node*>& dq_nodes,
+                                         const std::vector<const Node*>& q_nodes) const {
+  if (!CheckQDQNodes(graph_viewer, node, dq_nodes, q_nodes, 1)) {
+    return false;
+  }
+
+  int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_output = q_nodes[0]->OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  if (dt_input != dt_output) {
+    return false;
+  }
+
+  auto get_const_initializer = [&graph_viewer](const std::string& initializer_name) {
+    return graph_viewer.GetConstantInitializer(initializer_name, true);
+  };
+
+  bool zero_point_exists = false;
+  return QOrDQNodeHasConstantScalarScaleAndZeroPoint(*dq_nodes[0], get_const_initializer, zero_point_exists) &&
+         QOrDQNodeHasConstantScalarScaleAndZeroPoint(*q_nodes[0], get_const_initializer, zero_point_exists);
+}
+
+bool DequantizeGatherNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
+                                              const std::vector<const Node*>& dq_nodes,
+                                              const std::vector<const Node*>& q_nodes) const {
+  // Gather with a Q of the output is handled by dropping the DQ and Q, which keeps the gathered rows quantized.
+  // The DQ must provide the table, not the indices.
+  if (!q_nodes.empty() ||
+      !CheckQDQNodes(graph_viewer, node, dq_nodes, q_nodes, 1, true /*is_empty_q_nodes_allowed*/) ||
+      dq_nodes[0]->OutputDefs()[0] != node.InputDefs()[0]) {
+    return false;
+  }
+
+  const auto& dq_inputs = dq_nodes[0]->InputDefs();
+  int32_t dt_input = dq_inputs[0]->TypeAsProto()->tensor_type().elem_type();
+  if (dt_input != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT8 &&
+      dt_input != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8) {
+    return false;
+  }
+
+  const auto* data_shape = dq_inputs[0]->Shape();
+  if (data_shape == nullptr || data_shape->dim_size() != 2) {
+    return false;
+  }
+
+  const auto& attributes = node.GetAttributes();
+  if (const auto axis = attributes.find("axis");
+      axis != attributes.end() && axis->second.i() != 0 && axis->second.i() != -2) {
+    return false;
+  }
+
+  // a 1-D scale must be along the rows of the table. DequantizeLinear defaults to axis 1.
+  const auto* scale_shape = dq_inputs[1]->Shape();
+  if (scale_shape == nullptr || scale_shape->dim_size() > 1) {
+    return false;
+  }
+
+  if (!optimizer_utils::IsScalar(*dq_inputs[1])) {
+    const auto& dq_attributes = dq_nodes[0]->GetAttributes();
+    const auto dq_axis = dq_attributes.find("axis");
+    return dq_axis != dq_attributes.end() && (dq_axis->second.i() == 0 || dq_axis->second.i() == -2);
+  }
+
+  return true;
+}
+
+bool LayerNormNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
+                                       const std::vector<const Node*>& dq_nodes,
+                                       const std::vector<const Node*>& q_nodes) const {
+  // the DQ must provide X, and neither Mean nor InvStdDev can be produced
+  if (!CheckQDQNodes(graph_viewer, node, dq_nodes, q_nodes, 1) ||
+      dq_nodes[0]->OutputDefs()[0] != node.InputDefs()[0]) {
+    return false;
+  }
+
+  const auto& attributes = node.GetAttributes();
+  if (const auto stash_type = attributes.find("stash_type");
+      stash_type != attributes.end() && stash_type->second.i() != 1) {
+    return false;
+  }
+
+  int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_output = q_nodes[0]->OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+
+  return dt_input == dt_output;
+}
+
 bool BinaryNodeGroupSelector::Check(const GraphViewer& graph_viewer,
                                     const Node& node,
                                     const std::vector<const Node*>& dq_nodes,
@@ -238,6 +325,12 @@ bool MatMulNodeGroupSelector::Check(const GraphViewer& graph_viewer,
     }
   }
 
+  // int16 inputs are handled by MatMulS16S8NodeGroupSelector
+  if (dt_input == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT16 ||
+      dt_weight == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT16) {
+    return false;
+  }
+
   // potential match for QLinearMatMul or MatMulIntegerToFloat
   bool qlinear = !q_nodes.empty();
 
@@ -255,6 +348,59 @@ bool MatMulNodeGroupSelector::Check(const GraphViewer& graph_viewer,
   }
 }
 
+bool MatMulS8S8NodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                        const Node& node,
+                                        const std::vector<const Node*>& dq_nodes,
+                                        const std::vector<const Node*>& q_nodes) const {
+  if (q_nodes.empty() || !CheckQDQNodes(graph_viewer, node, dq_nodes, q_nodes, 2)) {
+    return false;
+  }
+
+  const auto is_int8 = [](const NodeArg* arg) {
+    return arg->TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT8;
+  };
+  if (!is_int8(dq_nodes[0]->InputDefs()[0]) || !is_int8(dq_nodes[1]->InputDefs()[0]) ||
+      !is_int8(q_nodes[0]->OutputDefs()[0])) {
+    return false;
+  }
+
+  // The scale of B is per tensor, or per axis along the last axis of a 2-D B, i.e. per column.
+  const NodeArg* b_scale = dq_nodes[1]->InputDefs()[1];
+  if (b_scale->Shape() == nullptr) {
+    return false;
+  }
+  if (b_scale->Shape()->dim_size() == 0) {
+    return true;
+  }
+
+  const auto* b_shape = dq_nodes[1]->InputDefs()[0]->Shape();
+  if (b_shape == nullptr || b_shape->dim_size() != 2 || b_scale->Shape()->dim_size() != 1) {
+    return false;
+  }
+  const auto& attributes = dq_nodes[1]->GetAttributes();
+  const auto axis = attributes.find("axis");
+  return axis == attributes.end() || axis->second.i() == 1 || axis->second.i() == -1;
+}
+
+bool MatMulS16S8NodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                         const Node& node,
+                                         const std::vector<const Node*>& dq_nodes,
+                                         const std::vector<const Node*>& /*q_nodes*/) const {
+  // the Q nodes are not replaced, so only the DQ nodes are checked
+  if (!CheckQDQNodes(graph_viewer, node, dq_nodes, {}, 2, true /*is_empty_q_nodes_allowed*/)) {
+    return false;
+  }
+
+  int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_weight = dq_nodes[1]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  return dt_input == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT16 &&
+         dt_weight == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT8;
+}
+
+void MatMulS16S8Selector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
+  builder.output_nodes.clear();
+}
+
 bool GemmNodeGroupSelector::Check(const GraphViewer& graph_viewer,
                                   const Node& node,
                                   const std::vector<const Node*>& dq_nodes,
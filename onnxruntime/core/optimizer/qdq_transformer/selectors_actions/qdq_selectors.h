@@ -74,6 +74,28 @@ class UnaryNodeGroupSelector : public NodeGroupSelector {
              const std::vector<const Node*>& q_nodes) const override;
 };
 
+// Single DQ -> unary node -> Q, with constant scalar scales and zero points so that the node can be looked up from a
+// table of its 256 output values built once.
+class LookupTableNodeGroupSelector : public NodeGroupSelector {
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
+// DQ node of a 2-D 8-bit table -> Gather of its rows, with float output. The scale is per tensor or per row.
+class DequantizeGatherNodeGroupSelector : public NodeGroupSelector {
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
+// DQ node for X -> LayerNormalization -> Q. Scale and B stay float.
+class LayerNormNodeGroupSelector : public NodeGroupSelector {
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // 2 DQ nodes providing input -> node -> Q
 class BinaryNodeGroupSelector : public NodeGroupSelector {
   bool Check(const GraphViewer& graph_viewer, const Node& node,
@@ -121,6 +143,23 @@ class MatMulNodeGroupSelector : public NodeGroupSelector {
   bool matmulintegertofloat_allowed_;
 };
 
+// 2 DQ nodes for int8 A and int8 B -> node -> Q to int8, for QLinearMatMul. The scales and zero points of B must be
+// per tensor or per column.
+class MatMulS8S8NodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
+// 2 DQ nodes for int16 A and int8 B -> node. A Q of the output is not part of the group.
+class MatMulS16S8NodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // Input: DQ nodes for A, B and optional C
 // Output: optional Q node for Y
 class GemmNodeGroupSelector : public NodeGroupSelector {
@@ -172,6 +211,21 @@ class UnarySelector : public BaseSelector {
   UnarySelector() : BaseSelector(std::make_unique<UnaryNodeGroupSelector>()) {}
 };
 
+class LookupTableSelector : public BaseSelector {
+ public:
+  LookupTableSelector() : BaseSelector(std::make_unique<LookupTableNodeGroupSelector>()) {}
+};
+
+class DequantizeGatherSelector : public BaseSelector {
+ public:
+  DequantizeGatherSelector() : BaseSelector(std::make_unique<DequantizeGatherNodeGroupSelector>()) {}
+};
+
+class LayerNormSelector : public BaseSelector {
+ public:
+  LayerNormSelector() : BaseSelector(std::make_unique<LayerNormNodeGroupSelector>()) {}
+};
+
 class BinarySelector : public BaseSelector {
  public:
   BinarySelector() : BaseSelector(std::make_unique<BinaryNodeGroupSelector>()) {}
@@ -200,6 +254,20 @@ class MatMulSelector : public BaseSelector {
       : BaseSelector(std::make_unique<MatMulNodeGroupSelector>(int8_allowed, /*matmulintegertofloat_allowed*/ true)) {}
 };
 
+// 2 DQ nodes for int8 A and int8 B -> node -> Q, replaced by QLinearMatMul.
+class MatMulS8S8Selector : public BaseSelector {
+ public:
+  MatMulS8S8Selector() : BaseSelector(std::make_unique<MatMulS8S8NodeGroupSelector>()) {}
+};
+
+// 2 DQ nodes for int16 A and int8 B -> node, replaced by MatMulIntegerToFloat. A Q of the output stays in place.
+class MatMulS16S8Selector : public BaseSelector {
+ public:
+  MatMulS16S8Selector() : BaseSelector(std::make_unique<MatMulS16S8NodeGroupSelector>()) {}
+
+  void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
+};
+
 // Input: DQ nodes for A, B and optional C
 // Output: optional Q node for Y
 class GemmSelector : public BaseSelector {
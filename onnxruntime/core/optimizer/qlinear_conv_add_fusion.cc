@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/qlinear_conv_add_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Input indices of QLinearAdd.
+constexpr int kAddInputA = 0;
+constexpr int kAddInputB = 3;
+constexpr int kAddInputCScale = 6;
+constexpr int kAddInputCZeroPoint = 7;
+
+// The optional sum inputs of the com.microsoft QLinearConv follow its bias.
+constexpr size_t kConvInputBias = 8;
+constexpr size_t kConvInputCount = 12;
+
+bool IsQLinearConv(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearConv", {10}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearConv", {1}, kMSDomain);
+}
+
+bool HasInput(const Node& node, size_t index) {
+  const auto& input_defs = node.InputDefs();
+  return input_defs.size() > index && input_defs[index]->Exists();
+}
+
+}  // namespace
+
+/**
+QLinearConvAddFusion fuses the residual connections of quantized models, such as the ones of MobileNetV2:
+
+    X  W  (B)                                     X  W  (B)  S
+     \ | /                                         \ |  |   /
+  QLinearConv    S                 ---->          QLinearConv
+         \      /                            (com.microsoft, sum = S)
+        QLinearAdd                                     |
+            |                                          v
+            v                                       (output)
+        (output)
+
+The convolution requantizes its int32 result straight to the scale and zero point of the add, which saves the
+intermediate tensor and its rounding. S must have the shape of the convolution output, as the sum is not broadcast.
+*/
+Status QLinearConvAddFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                       const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  InlinedVector<std::reference_wrapper<Node>> nodes_to_remove;
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& add_node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(add_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(add_node, "QLinearAdd", {1}, kMSDomain) ||
+        !graph_utils::IsSupportedProvider(add_node, GetCompatibleExecutionProviders()) ||
+        !HasInput(add_node, kAddInputCZeroPoint)) {
+      continue;
+    }
+
+    // Either operand of the add may be the convolution.
+    const Node* p_conv_node = nullptr;
+    int sum_input = 0;
+    for (int conv_input : {kAddInputA, kAddInputB}) {
+      const Node* input_node = graph_utils::GetInputNode(add_node, conv_input);
+      if (input_node != nullptr && IsQLinearConv(*input_node) &&
+          input_node->GetExecutionProviderType() == add_node.GetExecutionProviderType() &&
+          !HasInput(*input_node, kConvInputBias + 1) &&
+          optimizer_utils::CheckOutputEdges(graph, *input_node, 1)) {
+        const auto* conv_shape = input_node->OutputDefs()[0]->Shape();
+        const auto* sum_shape = add_node.InputDefs()[conv_input == kAddInputA ? kAddInputB : kAddInputA]->Shape();
+        if (conv_shape != nullptr && sum_shape != nullptr && optimizer_utils::CompareShape(*conv_shape, *sum_shape)) {
+          p_conv_node = input_node;
+          sum_input = conv_input == kAddInputA ? kAddInputB : kAddInputA;
+          break;
+        }
+      }
+    }
+    if (p_conv_node == nullptr) {
+      continue;
+    }
+
+    Node& conv_node = *graph.GetNode(p_conv_node->Index());
+    const auto& conv_inputs = conv_node.MutableInputDefs();
+    const auto& add_inputs = add_node.MutableInputDefs();
+
+    NodeArg optional_node_arg("", nullptr);
+    InlinedVector<NodeArg*> input_defs(kConvInputCount, &optional_node_arg);
+    for (size_t i = 0; i < conv_inputs.size() && i <= kConvInputBias; i++) {
+      input_defs[i] = conv_inputs[i];
+    }
+    // The convolution requantizes straight to the output of the add.
+    input_defs[6] = add_inputs[kAddInputCScale];
+    input_defs[7] = add_inputs[kAddInputCZeroPoint];
+    input_defs[9] = add_inputs[sum_input];
+    input_defs[10] = add_inputs[sum_input + 1];
+    if (HasInput(add_node, static_cast<size_t>(sum_input) + 2)) {
+      input_defs[11] = add_inputs[sum_input + 2];
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(conv_node.Name() + "_sum"),
+                                     "QLinearConv",
+                                     "QLinearConv with fused QLinearAdd",
+                                     input_defs,
+                                     add_node.MutableOutputDefs(),
+                                     &conv_node.GetAttributes(),
+                                     kMSDomain);
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(add_node.GetExecutionProviderType());
+
+    nodes_to_remove.push_back(conv_node);
+    nodes_to_remove.push_back(add_node);
+  }
+
+  modified = modified || !nodes_to_remove.empty();
+
+  for (const auto& node : nodes_to_remove) {
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.get().Index());
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class QLinearConvAddFusion
+Fuse QLinearConv and a following QLinearAdd of a tensor with the same shape into a com.microsoft QLinearConv
+with a sum input, so the convolution result is requantized once to the output of the add.
+*/
+class QLinearConvAddFusion : public GraphTransformer {
+ public:
+  QLinearConvAddFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QLinearConvAddFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
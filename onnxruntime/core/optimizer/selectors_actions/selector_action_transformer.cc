@@ -92,19 +92,16 @@ static Status MatchAndProcess(
   Status status = Status::OK();
 
   do {
-    // TODO: for now this just needs to support ONNX ops. If we ever had a transformer that was going to
-    // target non-ONNX ops we'd need to rework a few things to include the op domain in the matches
-    if (node.Domain() != kOnnxDomain) {
-      break;
-    }
+    // ops of domains other than ONNX are registered with the domain in their key
+    const std::string op_key = SelectorActionRegistry::OpVersionsMapKey(node.OpType(), node.Domain());
 
     std::optional<NodesToOptimizeIndices> node_selection_opt{};
     const SelectorActionRegistry::Entry* selector_action_entry_ptr = nullptr;
 
-    const auto selector_action_entries = selector_action_registry.LookUpByOpType(node.OpType());
+    const auto selector_action_entries = selector_action_registry.LookUpByOpType(op_key);
     for (const auto& entry : selector_action_entries) {
       // check the supported versions if specified
-      const auto& versions = entry->ops_and_versions.find(node.OpType())->second;
+      const auto& versions = entry->ops_and_versions.find(op_key)->second;
       if (!versions.empty()) {
         if (std::find(versions.cbegin(), versions.cend(), node.SinceVersion()) == versions.cend()) {
           continue;
@@ -40,6 +40,11 @@ class SelectorActionRegistry {
  public:
   using OpVersionsMap = std::unordered_map<std::string, std::vector<ONNX_NAMESPACE::OperatorSetVersion>>;
 
+  // key of an op in an OpVersionsMap. ONNX ops are keyed by op type and ops of other domains by "domain:op_type".
+  static std::string OpVersionsMapKey(const std::string& op_type, const std::string& domain = kOnnxDomain) {
+    return domain == kOnnxDomain ? op_type : domain + ":" + op_type;
+  }
+
   struct Entry {
     Entry(const std::string& name_in,
 #if !defined(ORT_MINIMAL_BUILD)
@@ -94,7 +99,7 @@ class SelectorActionRegistry {
   const Entry* LookUp(const std::string& name) const;
 
 #if !defined(ORT_MINIMAL_BUILD)
-  // return registered Entry or nullptr if not found
+  // return the registered Entries for the OpVersionsMapKey of an op
   auto LookUpByOpType(const std::string& op_type) const -> std::vector<gsl::not_null<const Entry*>>;
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
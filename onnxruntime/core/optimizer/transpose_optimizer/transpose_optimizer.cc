@@ -1585,7 +1585,7 @@ static bool HandleQLinearPoolOp(HandlerArgs& args) {
 constexpr HandlerInfo q_linear_pool_op_handler = {&FirstInput, &HandleQLinearPoolOp};
 
 static bool HandleMaxPool(HandlerArgs& args) {
-  // For CPU EP replace with NhwcMaxPool if possible. Only int8 and uint8 dtypes are supported by NhwcMaxPool.
+  // For CPU EP replace with NhwcMaxPool if possible. Only int8, uint8 and float dtypes are supported by NhwcMaxPool.
   if (args.node.GetExecutionProviderType() != "CPUExecutionProvider") {
     return false;
   }
@@ -1598,7 +1598,7 @@ static bool HandleMaxPool(HandlerArgs& args) {
 
   auto info = args.ctx.graph.GetValueInfo(outputs[0]);
   api::DataType dtype = info->DType();
-  if (dtype != api::DataType::UINT8 && dtype != api::DataType::INT8) {
+  if (dtype != api::DataType::UINT8 && dtype != api::DataType::INT8 && dtype != api::DataType::FLOAT) {
     return false;
   }
 
@@ -79,6 +79,10 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // If spinning is allowed, size the spin window of each thread from the time it recently waited for work instead of
+  // spinning for a fixed number of iterations.
+  bool adaptive_spinning = false;
 };
 /// \brief An interface used by the onnxruntime implementation to
 /// access operating system functionality like the filesystem etc.
@@ -122,6 +126,10 @@ class Env {
   // This function doesn't support systems with more than 64 logical processors
   virtual std::vector<size_t> GetThreadAffinityMasks() const = 0;
 
+  // Returns the logical processors of a NUMA node, in the same format as GetThreadAffinityMasks().
+  // Returns an empty vector if the node does not exist or the NUMA topology is not available.
+  virtual std::vector<size_t> GetNumaNodeThreadAffinityMasks(int numa_node) const = 0;
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
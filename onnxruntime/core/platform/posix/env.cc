@@ -27,6 +27,8 @@ limitations under the License.
 #include <dlfcn.h>
 #include <ftw.h>
 #include <string.h>
+#include <fstream>
+#include <string>
 #include <thread>
 #include <utility>  // for std::forward
 #include <vector>
@@ -246,6 +248,36 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  std::vector<size_t> GetNumaNodeThreadAffinityMasks(int numa_node) const override {
+    std::vector<size_t> ret;
+#if defined(__linux__)
+    if (numa_node < 0) {
+      return ret;
+    }
+
+    // the list has the format "0-3,8,10-11"
+    std::ifstream cpu_list_file("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+    std::string range;
+    while (std::getline(cpu_list_file, range, ',')) {
+      size_t first = 0;
+      size_t last = 0;
+      const int num_fields = sscanf(range.c_str(), "%zu-%zu", &first, &last);
+      if (num_fields < 1) {
+        break;
+      }
+      if (num_fields == 1) {
+        last = first;
+      }
+      for (size_t cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+        ret.push_back(cpu);
+      }
+    }
+#else
+    ORT_UNUSED_PARAMETER(numa_node);
+#endif
+    return ret;
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
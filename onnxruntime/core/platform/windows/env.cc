@@ -45,6 +45,14 @@ std::wstring Basename(const std::wstring& path) {
   return path.substr(basename_index);
 }
 
+void UnmapFile(void* param) noexcept {
+  if (!UnmapViewOfFile(param)) {
+    const auto error_code = GetLastError();
+    LOGS_DEFAULT(ERROR) << "UnmapViewOfFile failed. error code: " << error_code
+                        << " error msg: " << std::system_category().message(error_code);
+  }
+}
+
 class WindowsThread : public EnvThread {
  private:
   struct Param {
@@ -211,6 +219,24 @@ class WindowsEnv : public Env {
     return ret;
   }
 
+  std::vector<size_t> GetNumaNodeThreadAffinityMasks(int numa_node) const override {
+    std::vector<size_t> ret;
+    ULONGLONG processor_mask = 0;
+    if (numa_node < 0 || numa_node > MAXUCHAR ||
+        GetNumaNodeProcessorMask(static_cast<UCHAR>(numa_node), &processor_mask) == FALSE) {
+      return ret;
+    }
+
+    // only the processors in the processor group of the calling thread are reported
+    for (size_t i = 0; i < sizeof(processor_mask) * 8; ++i) {
+      const ULONGLONG processor_bit = ULONGLONG{1} << i;
+      if (processor_mask & processor_bit) {
+        ret.push_back(static_cast<size_t>(processor_bit));
+      }
+    }
+    return ret;
+  }
+
   static WindowsEnv& Instance() {
     static WindowsEnv default_env;
     return default_env;
@@ -319,8 +345,58 @@ class WindowsEnv : public Env {
     return Status::OK();
   }
 
-  Status MapFileIntoMemory(_In_z_ const ORTCHAR_T*, FileOffsetType, size_t, MappedMemoryPtr&) const override {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "MapFileIntoMemory is not implemented on Windows.");
+  Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
+                           MappedMemoryPtr& mapped_memory) const override {
+    ORT_RETURN_IF_NOT(file_path, "file_path == nullptr");
+    ORT_RETURN_IF_NOT(offset >= 0, "offset < 0");
+#if WINVER >= _WIN32_WINNT_WIN8
+    wil::unique_hfile file_handle{
+        CreateFile2(file_path, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, NULL)};
+#else
+    wil::unique_hfile file_handle{
+        CreateFileW(file_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL)};
+#endif
+    if (file_handle.get() == INVALID_HANDLE_VALUE) {
+      const auto error_code = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "open file ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+    }
+
+    if (length == 0) {
+      mapped_memory = MappedMemoryPtr{};
+      return Status::OK();
+    }
+
+    // copy-on-write, like the posix implementation. pages that are never written stay shared with the page cache.
+    wil::unique_handle file_mapping_handle{
+        CreateFileMappingW(file_handle.get(), nullptr, PAGE_WRITECOPY, 0, 0, nullptr)};
+    if (!file_mapping_handle) {
+      const auto error_code = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CreateFileMapping ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+    }
+
+    // the offset of a view must be a multiple of the allocation granularity
+    static const DWORD allocation_granularity = []() {
+      SYSTEM_INFO system_info;
+      GetSystemInfo(&system_info);
+      return system_info.dwAllocationGranularity;
+    }();
+    const FileOffsetType offset_to_granularity = offset % static_cast<FileOffsetType>(allocation_granularity);
+    const size_t mapped_length = length + static_cast<size_t>(offset_to_granularity);
+    const uint64_t mapped_offset = static_cast<uint64_t>(offset - offset_to_granularity);
+    void* const mapped_base = MapViewOfFile(file_mapping_handle.get(), FILE_MAP_COPY,
+                                            static_cast<DWORD>(mapped_offset >> 32),
+                                            static_cast<DWORD>(mapped_offset & 0xFFFFFFFF), mapped_length);
+    if (mapped_base == nullptr) {
+      const auto error_code = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "MapViewOfFile ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+    }
+
+    // the view keeps the file mapping object alive after its handle is closed
+    mapped_memory =
+        MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + offset_to_granularity,
+                        OrtCallbackInvoker{OrtCallback{UnmapFile, mapped_base}}};
+
+    return Status::OK();
   }
 
   bool FolderExists(const std::wstring& path) const override {
@@ -29,6 +29,10 @@ typedef struct {
   std::shared_ptr<arm_compute::IFunction> layer;
   std::shared_ptr<arm_compute::Tensor> a, b, c, d;
   std::shared_ptr<arm_compute::MemoryManagerOnDemand> mm_layer;
+  // The memory manager is populated once when the layer is configured, see ACLNEConv.
+  std::shared_ptr<arm_compute::Allocator> mm_allocator;
+  // The shape of A the layer is configured for.
+  TensorShape a_shape;
 } ACLNEGEMM;
 
 typedef std::map<OpKernel*, ACLNEGEMM>::iterator GEMMLayersIterator;
@@ -106,6 +110,11 @@ class Gemm : public onnxruntime::Gemm<T> {
 
     ACLNEGEMM* pGEMM;
     GEMMLayersIterator it = gemmLayers.find((OpKernel*)this);
+    if (it != gemmLayers.end() && it->second.a_shape != A->Shape()) {
+      // the layer is configured for another input shape
+      gemmLayers.erase(it);
+      it = gemmLayers.end();
+    }
     if (it == gemmLayers.end()) {
       ACLNEGEMM tGEMM;
       tGEMM.a = std::make_shared<arm_compute::Tensor>();
@@ -120,6 +129,8 @@ class Gemm : public onnxruntime::Gemm<T> {
       tGEMM.d->allocator()->init(arm_compute::TensorInfo(arm_compute::TensorShape(N, M), arm_compute::Format::F32));
       
       tGEMM.mm_layer = ACLCreateMemoryManager();
+      tGEMM.mm_allocator = std::make_shared<arm_compute::Allocator>();
+      tGEMM.a_shape = A->Shape();
 
       if(FC) {
         auto layer = std::make_shared<arm_compute::NEFullyConnectedLayer>(tGEMM.mm_layer);
@@ -134,8 +145,9 @@ class Gemm : public onnxruntime::Gemm<T> {
       std::pair<GEMMLayersIterator, bool> ret;
       ret = gemmLayers.insert(std::pair<OpKernel*, ACLNEGEMM>((OpKernel*)this, tGEMM));
       pGEMM = &ret.first->second;
+
+      pGEMM->mm_layer->populate(*pGEMM->mm_allocator, 1);
     } else {
-      //TODO: valildate shapes
       pGEMM = &it->second;
     }
 
@@ -150,8 +162,11 @@ class Gemm : public onnxruntime::Gemm<T> {
       ACLImportMemory(pGEMM->c->allocator(), (void*)c_data, C->Shape().Size() * 4);
     }
 
-    if(D->Shape().Size() != 0 && pGEMM->d->info()->has_padding() ){
-      pGEMM->d.get()->allocator()->allocate();
+    // The padded output is allocated on the first run and kept for the next ones.
+    const bool d_padded = D->Shape().Size() != 0 && pGEMM->d->info()->has_padding();
+    if (d_padded) {
+      if (pGEMM->d->buffer() == nullptr)
+        pGEMM->d->allocator()->allocate();
     } else {
       ACLImportMemory(pGEMM->d->allocator(), (void*)d_data, D->Shape().Size() * 4);
     }
@@ -161,19 +176,17 @@ class Gemm : public onnxruntime::Gemm<T> {
     ACLPrintTensorShape("c", *pGEMM->c);
     ACLPrintTensorShape("d", *pGEMM->d);
 
-    arm_compute::Allocator alloc_mm{};
-    pGEMM->mm_layer->populate(alloc_mm, 1);
     pGEMM->layer->run();
-    pGEMM->mm_layer->clear();
 
-    if(D->Shape().Size() != 0 && pGEMM->d->info()->has_padding() ){
+    if (d_padded) {
       importDataFromTensor<T>(pGEMM->d.get(), d_data);
     }
 
     pGEMM->a->allocator()->free();
     pGEMM->b->allocator()->free();
     pGEMM->c->allocator()->free();
-    pGEMM->d->allocator()->free();
+    if (!d_padded)
+      pGEMM->d->allocator()->free();
 
     return Status::OK();
   }
@@ -56,8 +56,15 @@ template <typename T>
 Status Conv<T>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
 
+  const Tensor* X = context->Input<Tensor>(0);
+
   ACLNEConv* pConv;
   ConvLayersIterator it = Conv::convLayers.find((OpKernel*)this);
+  if (it != Conv::convLayers.end() && it->second.input_shape != X->Shape()) {
+    // the layer is configured for another input shape
+    Conv::convLayers.erase(it);
+    it = Conv::convLayers.end();
+  }
   if (it != Conv::convLayers.end()) {
     pConv = &it->second;
     if (pConv->isDepthwiseCPU == true) {
@@ -66,7 +73,6 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
     }
   }
 
-  const Tensor* X = context->Input<Tensor>(0);
   const Tensor* W = context->Input<Tensor>(1);
   const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
 
@@ -112,14 +118,25 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   arm_compute::ActivationLayerInfo::ActivationFunction acl_activ_func;
   bool acl_activ_enabled = false;
 
+  float acl_activ_a = 0.0f;
+  float acl_activ_b = 0.0f;
+
   if (activation_type == "Relu") {
     acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::RELU;
     acl_activ_enabled = true;
     LOGS_DEFAULT(VERBOSE) << "ACL Conv-Relu fused implementation";
   } else if (activation_type == "LeakyRelu") {
     acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::LEAKY_RELU;
+    acl_activ_a = this->activation_.Parameters.LeakyRelu.alpha;
     acl_activ_enabled = true;
     LOGS_DEFAULT(VERBOSE) << "ACL Conv-LeakyRelu fused implementation";
+  } else if (activation_type == "Clip") {
+    // min(a, max(b, x))
+    acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::LU_BOUNDED_RELU;
+    acl_activ_a = this->activation_.Parameters.Clip.maximum;
+    acl_activ_b = this->activation_.Parameters.Clip.minimum;
+    acl_activ_enabled = true;
+    LOGS_DEFAULT(VERBOSE) << "ACL Conv-Clip fused implementation";
   } else if (activation_type == "Tanh") {
     acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::TANH;
     acl_activ_enabled = true;
@@ -134,10 +151,10 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 
   if (it == Conv::convLayers.end()) {
 
-    auto mm_layer = ACLCreateMemoryManager();
-
     ACLNEConv tconv;
-    tconv.mm_layer = std::move(mm_layer);
+    tconv.mm_layer = ACLCreateMemoryManager();
+    tconv.mm_allocator = std::make_shared<arm_compute::Allocator>();
+    tconv.input_shape = X->Shape();
 
     tconv.in = std::make_shared<arm_compute::Tensor>();
     tconv.k = std::make_shared<arm_compute::Tensor>();
@@ -223,7 +240,7 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
                                                                            aclPadStride,
                                                                            1 /* depth multiplier */,
                                                                            acl_activ_enabled ?
-                                                                              arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) :
+                                                                              arm_compute::ActivationLayerInfo(acl_activ_func, acl_activ_a, acl_activ_b) :
                                                                               arm_compute::ActivationLayerInfo(),
                                                                            arm_compute::Size2D(aclDilation0, dilations[0])));
 #endif
@@ -241,11 +258,11 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 #ifdef ACL_1902
         layer->configure(tconv.in.get(), tconv.k.get(), (B != nullptr) ? tconv.b.get() : nullptr, tconv.out.get(),
                          aclPadStride, 1 /* depth multiplier */,
-                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) : arm_compute::ActivationLayerInfo());
+                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, acl_activ_a, acl_activ_b) : arm_compute::ActivationLayerInfo());
 #elif defined(ACL_1905) || defined(ACL_1908) || defined(ACL_2002)
         layer->configure(tconv.in.get(), tconv.k.get(), (B != nullptr) ? tconv.b.get() : nullptr, tconv.out.get(),
                          aclPadStride, 1 /* depth multiplier */,
-                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) : arm_compute::ActivationLayerInfo(),
+                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, acl_activ_a, acl_activ_b) : arm_compute::ActivationLayerInfo(),
                          arm_compute::Size2D(aclDilation0, dilations[0]));
 #endif
         tconv.layer = std::move(layer);
@@ -270,11 +287,11 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
           return s;
         }
         LOGS_DEFAULT(VERBOSE) << "ACL 2D convolution";
-        auto layer = std::make_shared<arm_compute::NEConvolutionLayer>(mm_layer);
+        auto layer = std::make_shared<arm_compute::NEConvolutionLayer>(tconv.mm_layer);
         layer->configure(tconv.in.get(), tconv.k.get(), (B != nullptr) ? tconv.b.get() : nullptr, tconv.out.get(),
                          aclPadStride,
                          arm_compute::WeightsInfo(), arm_compute::Size2D(aclDilation0, dilations[0]),
-                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) : arm_compute::ActivationLayerInfo(),
+                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, acl_activ_a, acl_activ_b) : arm_compute::ActivationLayerInfo(),
                          false, conv_attrs_.group);
         tconv.layer = std::move(layer);
       }
@@ -286,17 +303,24 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
     ret = Conv::convLayers.insert(std::pair<OpKernel*, ACLNEConv>((OpKernel*)this, tconv));
     pConv = &ret.first->second;
 
+    pConv->mm_layer->populate(*pConv->mm_allocator, 1);
+
     ACLPrintTensorShape("X", *tconv.in.get());
     ACLPrintTensorShape("Y", *tconv.out.get());
 
   } else {
-    //TODO: valildate shapes
     pConv = &it->second;
   }
 
+  // The padded input and output tensors are allocated on the first run and kept for the next ones,
+  // the other ones import the memory of the ORT tensors.
+  const bool in_padded = X->Shape().Size() != 0 && pConv->in->info()->has_padding();
+  const bool out_padded = Y->Shape().Size() != 0 && pConv->out->info()->has_padding();
+
   const T* x_data = X->template Data<T>();
-  if(X->Shape().Size() != 0 && pConv->in->info()->has_padding() ){
-    pConv->in->allocator()->allocate();
+  if (in_padded) {
+    if (pConv->in->buffer() == nullptr)
+      pConv->in->allocator()->allocate();
     importDataToTensor<T>(pConv->in.get(), x_data);
   }else{
     ACLImportMemory(pConv->in->allocator(), (void*)x_data, X->Shape().Size() * 4);
@@ -311,26 +335,26 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   }
 
   T* y_data = Y->template MutableData<T>();
-  if(Y->Shape().Size() != 0 && pConv->out->info()->has_padding() ){
-    pConv->out->allocator()->allocate();
+  if (out_padded) {
+    if (pConv->out->buffer() == nullptr)
+      pConv->out->allocator()->allocate();
   } else {
     ACLImportMemory(pConv->out->allocator(), (void*)y_data, Y->Shape().Size() * 4);
   }
 
-  arm_compute::Allocator alloc_mm{};
-  pConv->mm_layer->populate(alloc_mm, 1);
   pConv->layer->run();
-  pConv->mm_layer->clear();
 
-  if(Y->Shape().Size() != 0 && pConv->out->info()->has_padding() ){
+  if (out_padded) {
     importDataFromTensor<T>(pConv->out.get(), y_data);
   }
 
-  pConv->in->allocator()->free();
+  if (!in_padded)
+    pConv->in->allocator()->free();
   pConv->k->allocator()->free();
   if (B != nullptr)
     pConv->b->allocator()->free();
-  pConv->out->allocator()->free();
+  if (!out_padded)
+    pConv->out->allocator()->free();
 
   LOGS_DEFAULT(VERBOSE) << std::endl;
 
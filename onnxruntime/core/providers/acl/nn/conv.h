@@ -26,6 +26,11 @@ typedef struct
 {
   std::shared_ptr<arm_compute::IFunction> layer;
   std::shared_ptr<arm_compute::MemoryManagerOnDemand> mm_layer;
+  // The memory manager is populated once when the layer is configured, so that the working memory of the layer is
+  // kept across runs. The pool keeps a pointer to the allocator.
+  std::shared_ptr<arm_compute::Allocator> mm_allocator;
+  // The input shape the layer is configured for.
+  TensorShape input_shape;
   std::shared_ptr<arm_compute::Tensor> in;
   std::shared_ptr<arm_compute::Tensor> k;
   std::shared_ptr<arm_compute::Tensor> b;
@@ -47,6 +52,14 @@ class Conv : public onnxruntime::Conv<T> {
     Conv::convLayers.erase(this);
   }
 
+  // ACL imports the filter from the input tensor, so it must not be packed by the CPU kernel.
+  Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, AllocatorPtr /*alloc*/,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* /*prepacked_weights*/) override {
+    is_packed = false;
+    return Status::OK();
+  }
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
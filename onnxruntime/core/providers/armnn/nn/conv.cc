@@ -21,7 +21,7 @@ namespace onnxruntime {
 namespace armnn_ep {
 
 template <typename T>
-thread_local std::map<OpKernel*, armnn::NetworkId> Conv<T>::convLayers;
+thread_local std::map<OpKernel*, ArmNNConv> Conv<T>::convLayers;
 
 template <typename T>
 armnn::IRuntimePtr Conv<T>::run = armnn::IRuntimePtr(nullptr, nullptr);
@@ -154,6 +154,12 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 
   armnn::NetworkId* pNetworkId;
   ConvLayersIterator it = Conv::convLayers.find((OpKernel*)this);
+  if (it != Conv::convLayers.end() && it->second.input_shape != X->Shape()) {
+    // the network is loaded for another input shape
+    Conv::run->UnloadNetwork(it->second.networkId);
+    Conv::convLayers.erase(it);
+    it = Conv::convLayers.end();
+  }
   if (it == Conv::convLayers.end()) {
     armnn::NetworkId networkId;
     armnn::INetworkPtr myNetwork = armnn::INetwork::Create();
@@ -220,7 +226,6 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 
     bool armnn_activ_enabled = false;
     armnn::ActivationDescriptor desc;
-    desc.m_A = conv_attrs_.alpha;
 
     if (activation_type == "Relu") {
       desc.m_Function = armnn::ActivationFunction::ReLu;
@@ -228,8 +233,16 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
       armnn_activ_enabled = true;
     } else if (activation_type == "LeakyRelu") {
       desc.m_Function = armnn::ActivationFunction::LeakyReLu;
+      desc.m_A = this->activation_.Parameters.LeakyRelu.alpha;
       LOGS_DEFAULT(VERBOSE) << "ArmNN Conv-LeakyRelu fused implementation";
       armnn_activ_enabled = true;
+    } else if (activation_type == "Clip") {
+      // min(a, max(b, x))
+      desc.m_Function = armnn::ActivationFunction::BoundedReLu;
+      desc.m_A = this->activation_.Parameters.Clip.maximum;
+      desc.m_B = this->activation_.Parameters.Clip.minimum;
+      LOGS_DEFAULT(VERBOSE) << "ArmNN Conv-Clip fused implementation";
+      armnn_activ_enabled = true;
     } else if (activation_type == "Tanh") {
       desc.m_Function = armnn::ActivationFunction::TanH;
       LOGS_DEFAULT(VERBOSE) << "ArmNN Conv-Tanh fused implementation";
@@ -278,11 +291,11 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
     Conv::run->LoadNetwork(networkId, std::move(optNet));
 
     std::pair<ConvLayersIterator, bool> ret;
-    ret = Conv::convLayers.insert(std::pair<OpKernel*, armnn::NetworkId>((OpKernel*)this, networkId));
-    pNetworkId = &ret.first->second;
+    ret = Conv::convLayers.insert(std::pair<OpKernel*, ArmNNConv>((OpKernel*)this, ArmNNConv{networkId, X->Shape()}));
+    pNetworkId = &ret.first->second.networkId;
 
   } else {
-    pNetworkId = &it->second;
+    pNetworkId = &it->second.networkId;
   }
 
   armnn::InputTensors inputTensors{{0, armnn::ConstTensor(Conv::run->GetInputTensorInfo(*pNetworkId, 0),
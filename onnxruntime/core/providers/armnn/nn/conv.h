@@ -15,7 +15,13 @@
 namespace onnxruntime {
 namespace armnn_ep{
 
-typedef std::map<OpKernel*, armnn::NetworkId>::iterator ConvLayersIterator;
+typedef struct {
+  armnn::NetworkId networkId;
+  // The input shape the network is loaded for.
+  TensorShape input_shape;
+} ArmNNConv;
+
+typedef std::map<OpKernel*, ArmNNConv>::iterator ConvLayersIterator;
 
 template <typename T>
 class Conv : public onnxruntime::Conv<T> {
@@ -27,7 +33,19 @@ class Conv : public onnxruntime::Conv<T> {
   }
 
   ~Conv() {
-  	Conv::convLayers.erase(this);
+    ConvLayersIterator it = Conv::convLayers.find(this);
+    if (it != Conv::convLayers.end()) {
+      Conv::run->UnloadNetwork(it->second.networkId);
+      Conv::convLayers.erase(it);
+    }
+  }
+
+  // ArmNN copies the filter from the input tensor, so it must not be packed by the CPU kernel.
+  Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, AllocatorPtr /*alloc*/,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* /*prepacked_weights*/) override {
+    is_packed = false;
+    return Status::OK();
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -40,7 +58,7 @@ class Conv : public onnxruntime::Conv<T> {
   }
 
  protected:
-  static thread_local std::map<OpKernel*, armnn::NetworkId> convLayers;
+  static thread_local std::map<OpKernel*, ArmNNConv> convLayers;
   ConvAttributes conv_attrs_;
   ArmNNExecutionProvider* provider_;
   static armnn::IRuntimePtr run;
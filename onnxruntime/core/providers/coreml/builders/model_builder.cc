@@ -2,12 +2,15 @@
 // Licensed under the MIT License.
 
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <core/common/safeint.h>
 
 #include "model_builder.h"
 #include "helper.h"
 #include "op_builder_factory.h"
 
+#include "core/framework/murmurhash3.h"
 #include "core/providers/common.h"
 #include "core/providers/coreml/model/model.h"
 #include "core/providers/coreml/model/host_utils.h"
@@ -210,7 +213,7 @@ Status ModelBuilder::RegisterModelOutputs() {
 
 Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& path) {
   ORT_RETURN_IF_ERROR(SaveCoreMLModel(path));
-  model.reset(new Model(path, logger_, coreml_flags_));
+  model.reset(new Model(path, compiled_model_cache_path_, logger_, coreml_flags_));
   model->SetScalarOutputs(std::move(scalar_outputs_));
   model->SetInt64Outputs(std::move(int64_outputs_));
   model->SetInputOutputInfo(std::move(input_output_info_));
@@ -219,8 +222,22 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& p
 
 Status ModelBuilder::SaveCoreMLModel(const std::string& path) {
   ORT_RETURN_IF_ERROR(Initialize());
+  std::string serialized_model;
+  ORT_RETURN_IF_NOT(coreml_model_->SerializeToString(&serialized_model), "Serialize the CoreML model failed");
   std::ofstream stream(path, std::ofstream::out | std::ofstream::binary);
-  ORT_RETURN_IF_NOT(coreml_model_->SerializeToOstream(&stream), "Save the CoreML model failed");
+  ORT_RETURN_IF_NOT(stream.write(serialized_model.data(), serialized_model.size()), "Save the CoreML model failed");
+
+  if (!compilation_cache_dir_.empty()) {
+    // The same CoreML model compiles to the same compiled model, so the model hash identifies the compiled model
+    uint32_t model_hash[4];
+    MurmurHash3::x86_128(serialized_model.data(), SafeInt<int>(serialized_model.size()), 0, model_hash);
+    std::ostringstream cache_path;
+    cache_path << compilation_cache_dir_ << "/" << std::hex << std::setfill('0');
+    for (const auto value : model_hash) {
+      cache_path << std::setw(8) << value;
+    }
+    compiled_model_cache_path_ = cache_path.str();
+  }
 
   // TODO, Delete, debug only
   if (const char* path = std::getenv("ORT_COREML_EP_CONVERTED_MODEL_PATH")) {
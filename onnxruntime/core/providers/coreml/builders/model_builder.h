@@ -23,6 +23,9 @@ class ModelBuilder {
   Status Compile(std::unique_ptr<Model>& model, const std::string& path) ORT_MUST_USE_RESULT;
   Status SaveCoreMLModel(const std::string& path) ORT_MUST_USE_RESULT;
 
+  // Set the directory to cache the compiled CoreML model in, the compiled model is not cached if it is empty
+  void SetCompilationCacheDir(const std::string& cache_dir) { compilation_cache_dir_ = cache_dir; }
+
   // Accessors for members
   const GraphViewer& GetGraphViewer() const { return graph_viewer_; }
   const InitializedTensorSet& GetInitializerTensors() const { return graph_viewer_.GetAllInitializedTensors(); }
@@ -42,6 +45,11 @@ class ModelBuilder {
   const GraphViewer& graph_viewer_;
   const logging::Logger& logger_;
   uint32_t coreml_flags_;
+  std::string compilation_cache_dir_;
+
+  // The path of the compiled model in the compilation cache, keyed by the hash of the CoreML model,
+  // set by SaveCoreMLModel if the compilation cache is used
+  std::string compiled_model_cache_path_;
 
   std::unique_ptr<CoreML::Specification::Model> coreml_model_;
   std::unordered_set<std::string> scalar_outputs_;
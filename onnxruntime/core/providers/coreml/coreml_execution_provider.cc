@@ -20,9 +20,11 @@ namespace onnxruntime {
 
 constexpr const char* COREML = "CoreML";
 
-CoreMLExecutionProvider::CoreMLExecutionProvider(uint32_t coreml_flags)
+CoreMLExecutionProvider::CoreMLExecutionProvider(uint32_t coreml_flags,
+                                                 const optional<std::string>& compilation_cache_dir)
     : IExecutionProvider{onnxruntime::kCoreMLExecutionProvider, true},
-      coreml_flags_(coreml_flags) {
+      coreml_flags_(coreml_flags),
+      compilation_cache_dir_(compilation_cache_dir.value_or("")) {
   AllocatorCreationInfo device_info(
       [](int) {
         return std::make_unique<CPUAllocator>(OrtMemoryInfo(COREML, OrtAllocatorType::OrtDeviceAllocator));
@@ -97,6 +99,11 @@ CoreMLExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph_vie
 }
 
 #ifdef __APPLE__
+// The data of a tensor bound to a CVPixelBuffer is the CVPixelBufferRef, see COREML_PIXEL_BUFFER
+static bool IsPixelBuffer(Ort::CustomOpApi& ort, const OrtValue* tensor) {
+  return strcmp(ort.GetTensorMemoryInfo(tensor)->name, COREML_PIXEL_BUFFER) == 0;
+}
+
 common::Status CoreMLExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
                                                 std::vector<NodeComputeInfo>& node_compute_funcs) {
   for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
@@ -104,6 +111,7 @@ common::Status CoreMLExecutionProvider::Compile(const std::vector<FusedNodeAndGr
     const onnxruntime::GraphViewer& graph_viewer(fused_node_and_graph.filtered_graph);
 
     coreml::ModelBuilder builder(graph_viewer, *GetLogger(), coreml_flags_);
+    builder.SetCompilationCacheDir(compilation_cache_dir_);
     std::unique_ptr<coreml::Model> coreml_model;
     const std::string coreml_model_file_path = coreml::util::GetTemporaryFilePath();
     ORT_RETURN_IF_ERROR(builder.Compile(coreml_model, coreml_model_file_path));
@@ -171,6 +179,7 @@ common::Status CoreMLExecutionProvider::Compile(const std::vector<FusedNodeAndGr
                 // CoreML MLMultiArray API expect input to be non-const
                 // https://developer.apple.com/documentation/coreml/mlmultiarray/2881219-initwithdatapointer?language=objc
                 const_cast<void*>(inputBuffer),
+                IsPixelBuffer(ort, input_tensor),
             });
 
         ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
@@ -223,6 +232,7 @@ common::Status CoreMLExecutionProvider::Compile(const std::vector<FusedNodeAndGr
                           coreml::OnnxTensorData{
                               coreml::OnnxTensorInfo{output_type, output_shape},
                               output_buffer,
+                              IsPixelBuffer(ort, output_tensor),
                           });
         }
 
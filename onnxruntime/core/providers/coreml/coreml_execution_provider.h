@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/common/optional.h"
 #include "core/framework/execution_provider.h"
 #include "core/providers/coreml/coreml_provider_factory.h"
 
@@ -13,7 +14,7 @@ class Model;
 
 class CoreMLExecutionProvider : public IExecutionProvider {
  public:
-  CoreMLExecutionProvider(uint32_t coreml_flags);
+  CoreMLExecutionProvider(uint32_t coreml_flags, const optional<std::string>& compilation_cache_dir = {});
   virtual ~CoreMLExecutionProvider();
 
   std::vector<std::unique_ptr<ComputeCapability>>
@@ -29,6 +30,9 @@ class CoreMLExecutionProvider : public IExecutionProvider {
   // COREMLFlags in include/onnxruntime/core/providers/coreml/coreml_provider_factory.h
   const uint32_t coreml_flags_;
 
+  // The directory to cache the compiled CoreML models in, empty if the compilation caching is disabled
+  const std::string compilation_cache_dir_;
+
  private:
   // <fused_node_name, <coreml_model_file_path, compiled_coreml_model>>
   #ifdef __APPLE__
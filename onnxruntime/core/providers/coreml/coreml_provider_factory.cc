@@ -2,32 +2,39 @@
 // Licensed under the MIT License.
 
 #include "core/providers/coreml/coreml_provider_factory.h"
+#include "core/common/optional.h"
 #include "core/session/abi_session_options_impl.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "coreml_execution_provider.h"
 
 using namespace onnxruntime;
 
 namespace onnxruntime {
 struct CoreMLProviderFactory : IExecutionProviderFactory {
-  CoreMLProviderFactory(uint32_t coreml_flags)
-      : coreml_flags_(coreml_flags) {}
+  CoreMLProviderFactory(uint32_t coreml_flags, const optional<std::string>& compilation_cache_dir)
+      : coreml_flags_(coreml_flags), compilation_cache_dir_(compilation_cache_dir) {}
   ~CoreMLProviderFactory() override {}
 
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
   uint32_t coreml_flags_;
+  optional<std::string> compilation_cache_dir_;
 };
 
 std::unique_ptr<IExecutionProvider> CoreMLProviderFactory::CreateProvider() {
-  return std::make_unique<CoreMLExecutionProvider>(coreml_flags_);
+  return std::make_unique<CoreMLExecutionProvider>(coreml_flags_, compilation_cache_dir_);
 }
 
-std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CoreML(uint32_t coreml_flags) {
-  return std::make_shared<onnxruntime::CoreMLProviderFactory>(coreml_flags);
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CoreML(
+    uint32_t coreml_flags, const optional<std::string>& compilation_cache_dir) {
+  return std::make_shared<onnxruntime::CoreMLProviderFactory>(coreml_flags, compilation_cache_dir);
 }
 }  // namespace onnxruntime
 
 ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_CoreML,
                     _In_ OrtSessionOptions* options, uint32_t coreml_flags) {
-  options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_CoreML(coreml_flags));
+  const auto compilation_cache_dir = options->value.config_options.GetConfigEntry(
+      kOrtSessionOptionsConfigCoreMLEpCompilationCacheDir);
+  options->provider_factories.push_back(
+      onnxruntime::CreateExecutionProviderFactory_CoreML(coreml_flags, compilation_cache_dir));
   return nullptr;
 }
@@ -19,6 +19,8 @@ struct OnnxTensorInfo {
 struct OnnxTensorData {
   OnnxTensorInfo tensor_info;
   void* buffer{nullptr};
+  // If the buffer is a CVPixelBufferRef, see COREML_PIXEL_BUFFER in core/framework/allocator.h
+  bool is_pixel_buffer{false};
 };
 
 class Model {
@@ -59,7 +61,10 @@ class Model {
 
   OrtMutex mutex_;
 
-  Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  // If compiled_model_cache_path is not empty, the compiled model is loaded from the compilation cache if it is
+  // there, otherwise it is compiled and saved in the cache
+  Model(const std::string& path, const std::string& compiled_model_cache_path,
+        const logging::Logger& logger, uint32_t coreml_flags);
   onnxruntime::common::Status LoadModel();
 
   void SetInputOutputInfo(std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info) {
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <cstdint>
+#include <numeric>
 #include <unordered_map>
 #include <vector>
 
@@ -15,8 +16,43 @@
 #include "model.h"
 
 #import <CoreML/CoreML.h>
+#import <CoreVideo/CoreVideo.h>
 #import <Foundation/Foundation.h>
 
+namespace {
+// A tensor bound to a CVPixelBuffer has the rows of the pixel buffer as its rows, with the last dimension as the
+// width of the pixel buffer and the other dimensions making the height, see COREML_PIXEL_BUFFER
+onnxruntime::common::Status CheckPixelBuffer(CVPixelBufferRef pixel_buffer, const std::vector<int64_t>& shape) {
+  ORT_RETURN_IF_NOT(CVPixelBufferGetPixelFormatType(pixel_buffer) == kCVPixelFormatType_OneComponent32Float,
+                    "The pixel buffer must be of kCVPixelFormatType_OneComponent32Float");
+  ORT_RETURN_IF(shape.empty(), "A scalar cannot be bound to a pixel buffer");
+  const int64_t width = shape.back();
+  const int64_t height = std::accumulate(shape.begin(), shape.end() - 1, int64_t{1}, std::multiplies<int64_t>());
+  ORT_RETURN_IF_NOT(static_cast<int64_t>(CVPixelBufferGetWidth(pixel_buffer)) == width &&
+                        static_cast<int64_t>(CVPixelBufferGetHeight(pixel_buffer)) == height,
+                    "The pixel buffer size ", CVPixelBufferGetWidth(pixel_buffer), "x",
+                    CVPixelBufferGetHeight(pixel_buffer), " does not match the tensor size ", width, "x", height);
+  return onnxruntime::common::Status::OK();
+}
+
+// Copy the rows of a CoreML output to the pixel buffer, the rows of the pixel buffer may be padded
+onnxruntime::common::Status CopyToPixelBuffer(const float* data, CVPixelBufferRef pixel_buffer,
+                                              const std::vector<int64_t>& shape) {
+  ORT_RETURN_IF_ERROR(CheckPixelBuffer(pixel_buffer, shape));
+  ORT_RETURN_IF_NOT(CVPixelBufferLockBaseAddress(pixel_buffer, 0) == kCVReturnSuccess,
+                    "Failed to lock the pixel buffer");
+  auto* dest = static_cast<uint8_t*>(CVPixelBufferGetBaseAddress(pixel_buffer));
+  const size_t bytes_per_row = CVPixelBufferGetBytesPerRow(pixel_buffer);
+  const size_t width = CVPixelBufferGetWidth(pixel_buffer);
+  const size_t height = CVPixelBufferGetHeight(pixel_buffer);
+  for (size_t row = 0; row < height; row++) {
+    memcpy(dest + row * bytes_per_row, data + row * width, width * sizeof(float));
+  }
+  CVPixelBufferUnlockBaseAddress(pixel_buffer, 0);
+  return onnxruntime::common::Status::OK();
+}
+}  // namespace
+
 // Model input for a CoreML model
 // All the input onnx tensors values will be converted to MLMultiArray(s)
 @interface OnnxTensorFeatureProvider : NSObject <MLFeatureProvider> {
@@ -33,19 +69,22 @@
 @end
 
 // Execution for a CoreML model, it performs
-// 1. Compile the model by given path for execution
+// 1. Compile the model by given path for execution, or load the compiled model from the compilation cache
 // 2. Predict using given OnnxTensorFeatureProvider input and copy the output data back ORT
-// 3. The compiled model will be removed in dealloc or removed using cleanup function
+// 3. The compiled model will be removed in dealloc or removed using cleanup function,
+//    unless it is saved in the compilation cache
 @interface CoreMLExecution : NSObject {
   NSString* coreml_model_path_;
   NSString* compiled_model_path_;
+  NSString* compiled_model_cache_path_;
   const onnxruntime::logging::Logger* logger_;
   uint32_t coreml_flags_;
 }
 
 - (instancetype)initWithPath:(const std::string&)path
-                      logger:(const onnxruntime::logging::Logger&)logger
-                coreml_flags:(uint32_t)coreml_flags;
+    compiled_model_cache_path:(const std::string&)compiled_model_cache_path
+                       logger:(const onnxruntime::logging::Logger&)logger
+                 coreml_flags:(uint32_t)coreml_flags;
 - (void)cleanup;
 - (void)dealloc;
 - (onnxruntime::common::Status)loadModel API_AVAILABLE_OS_VERSIONS;
@@ -94,29 +133,59 @@
       [shape addObject:[NSNumber numberWithLongLong:dim]];
     }
 
-    NSMutableArray* strides = [[NSMutableArray alloc] init];
+    MLMultiArrayDataType data_type = MLMultiArrayDataTypeFloat32;
+    if (input.tensor_info.data_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      LOGS(*logger_, ERROR) << "Input data type is not float, actual type: "
+                            << input.tensor_info.data_type;
+      return nil;
+    }
+
+    void* data = input.buffer;
     int64_t stride = 1;
+    // The MLMultiArray uses the pixel buffer memory, which is locked until the MLMultiArray is released
+    CVPixelBufferRef pixel_buffer = nullptr;
+    if (input.is_pixel_buffer) {
+      pixel_buffer = static_cast<CVPixelBufferRef>(input.buffer);
+      const auto status = CheckPixelBuffer(pixel_buffer, input.tensor_info.shape);
+      if (!status.IsOK()) {
+        LOGS(*logger_, ERROR) << "Failed to bind the pixel buffer to feature: " << [featureName UTF8String]
+                              << ", error: " << status.ErrorMessage();
+        return nil;
+      }
+
+      if (CVPixelBufferLockBaseAddress(pixel_buffer, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess) {
+        LOGS(*logger_, ERROR) << "Failed to lock the pixel buffer of feature: " << [featureName UTF8String];
+        return nil;
+      }
+
+      CVPixelBufferRetain(pixel_buffer);
+      data = CVPixelBufferGetBaseAddress(pixel_buffer);
+    }
+
+    NSMutableArray* strides = [[NSMutableArray alloc] init];
     for (int i = static_cast<int>(input.tensor_info.shape.size()) - 1; i >= 0; i--) {
       [strides insertObject:[NSNumber numberWithLongLong:stride]
                     atIndex:0];
 
       stride *= input.tensor_info.shape[i];
-    }
-
-    MLMultiArrayDataType data_type = MLMultiArrayDataTypeFloat32;
-    if (input.tensor_info.data_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
-      LOGS(*logger_, ERROR) << "Input data type is not float, actual type: "
-                            << input.tensor_info.data_type;
-      return nil;
+      // the rows of a pixel buffer may be padded
+      if (pixel_buffer != nullptr && i == static_cast<int>(input.tensor_info.shape.size()) - 1) {
+        stride = CVPixelBufferGetBytesPerRow(pixel_buffer) / sizeof(float);
+      }
     }
 
     NSError* error = nil;
-    MLMultiArray* mlArray = [[MLMultiArray alloc] initWithDataPointer:input.buffer
+    MLMultiArray* mlArray = [[MLMultiArray alloc] initWithDataPointer:data
                                                                 shape:shape
                                                              dataType:data_type
                                                               strides:strides
-                                                          deallocator:(^(void* /* bytes */){
-                                                                      })error:&error];
+                                                          deallocator:(^(void* /* bytes */) {
+                                                            if (pixel_buffer != nullptr) {
+                                                              CVPixelBufferUnlockBaseAddress(
+                                                                  pixel_buffer, kCVPixelBufferLock_ReadOnly);
+                                                              CVPixelBufferRelease(pixel_buffer);
+                                                            }
+                                                          })error:&error];
     if (error != nil) {
       LOGS(*logger_, ERROR) << "Failed to create MLMultiArray for feature: " << [featureName UTF8String]
                             << ", error: " << [[error localizedDescription] UTF8String];
@@ -136,10 +205,20 @@
 @implementation CoreMLExecution
 
 - (instancetype)initWithPath:(const std::string&)path
-                      logger:(const onnxruntime::logging::Logger&)logger
-                coreml_flags:(uint32_t)coreml_flags {
+    compiled_model_cache_path:(const std::string&)compiled_model_cache_path
+                       logger:(const onnxruntime::logging::Logger&)logger
+                 coreml_flags:(uint32_t)coreml_flags {
   if (self = [super init]) {
     coreml_model_path_ = [NSString stringWithUTF8String:path.c_str()];
+    if (!compiled_model_cache_path.empty()) {
+      // A compiled model is not guaranteed to be loadable by another version of CoreML,
+      // so the OS version is a part of the cache key as well
+      NSOperatingSystemVersion os_version = [[NSProcessInfo processInfo] operatingSystemVersion];
+      compiled_model_cache_path_ =
+          [NSString stringWithFormat:@"%s_os%ld.%ld.%ld.mlmodelc", compiled_model_cache_path.c_str(),
+                                     (long)os_version.majorVersion, (long)os_version.minorVersion,
+                                     (long)os_version.patchVersion];
+    }
     logger_ = &logger;
     coreml_flags_ = coreml_flags;
   }
@@ -174,6 +253,27 @@
 
 - (onnxruntime::common::Status)loadModel {
   NSError* error = nil;
+  NSFileManager* file_manager = [NSFileManager defaultManager];
+  MLModelConfiguration* config = [MLModelConfiguration alloc];
+  config.computeUnits = MLComputeUnitsAll;
+
+  if (compiled_model_cache_path_ != nil && [file_manager fileExistsAtPath:compiled_model_cache_path_]) {
+    NSURL* cacheUrl = [NSURL fileURLWithPath:compiled_model_cache_path_];
+    _model = [MLModel modelWithContentsOfURL:cacheUrl configuration:config error:&error];
+    if (error == nil) {
+      LOGS(*logger_, VERBOSE) << "Loaded the compiled model from the cache: "
+                              << [compiled_model_cache_path_ UTF8String];
+      return onnxruntime::common::Status::OK();
+    }
+
+    // The cached compiled model is unusable, e.g. it was partially written, replace it with a new one
+    LOGS(*logger_, WARNING) << "Failed loading the compiled model from the cache: "
+                            << [compiled_model_cache_path_ UTF8String]
+                            << ", error message: " << [[error localizedDescription] UTF8String];
+    error = nil;
+    [file_manager removeItemAtPath:compiled_model_cache_path_ error:nil];
+  }
+
   NSURL* modelUrl = [NSURL URLWithString:coreml_model_path_];
   NSAssert(modelUrl != nil, @"modelUrl must not be nil");
   NSURL* compileUrl = [MLModel compileModelAtURL:modelUrl error:&error];
@@ -185,8 +285,26 @@
 
   compiled_model_path_ = [compileUrl path];
 
-  MLModelConfiguration* config = [MLModelConfiguration alloc];
-  config.computeUnits = MLComputeUnitsAll;
+  if (compiled_model_cache_path_ != nil) {
+    // The compiled model is moved to the cache in a single step, so a concurrent session sees either no cached
+    // model or a complete one. If the move fails, e.g. another session cached the model first, the compiled
+    // model is used from its temporary location and removed in cleanup
+    NSURL* cacheUrl = [NSURL fileURLWithPath:compiled_model_cache_path_];
+    [file_manager createDirectoryAtURL:[cacheUrl URLByDeletingLastPathComponent]
+           withIntermediateDirectories:YES
+                            attributes:nil
+                                 error:nil];
+    if ([file_manager moveItemAtURL:compileUrl toURL:cacheUrl error:&error]) {
+      compileUrl = cacheUrl;
+      compiled_model_path_ = nil;
+    } else {
+      LOGS(*logger_, WARNING) << "Failed saving the compiled model to the cache: "
+                              << [compiled_model_cache_path_ UTF8String]
+                              << ", error message: " << [[error localizedDescription] UTF8String];
+      error = nil;
+    }
+  }
+
   _model = [MLModel modelWithContentsOfURL:compileUrl configuration:config error:&error];
 
   if (error != NULL) {
@@ -252,8 +370,17 @@
                    std::multiplies<int64_t>());
 
     const auto type = output_tensor.tensor_info.data_type;
+    ORT_RETURN_IF(output_tensor.is_pixel_buffer && type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT,
+                  "Only a float output can be bound to a pixel buffer, actual type: ", type);
     switch (type) {
       case ONNX_NAMESPACE::TensorProto_DataType_FLOAT: {
+        if (output_tensor.is_pixel_buffer) {
+          ORT_RETURN_IF_ERROR(CopyToPixelBuffer(static_cast<const float*>(model_output_data),
+                                                static_cast<CVPixelBufferRef>(output_tensor.buffer),
+                                                output_tensor.tensor_info.shape));
+          break;
+        }
+
         const auto output_data_byte_size = num_elements * sizeof(float);
         memcpy(output_tensor.buffer, model_output_data, output_data_byte_size);
         break;
@@ -296,7 +423,8 @@ namespace coreml {
 // This class will bridge Model (c++) with CoreMLExecution (objective c++)
 class Execution {
  public:
-  Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  Execution(const std::string& path, const std::string& compiled_model_cache_path,
+            const logging::Logger& logger, uint32_t coreml_flags);
   ~Execution(){};
 
   Status LoadModel();
@@ -308,8 +436,10 @@ class Execution {
   CoreMLExecution* execution_;
 };
 
-Execution::Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags) {
+Execution::Execution(const std::string& path, const std::string& compiled_model_cache_path,
+                     const logging::Logger& logger, uint32_t coreml_flags) {
   execution_ = [[CoreMLExecution alloc] initWithPath:path
+                           compiled_model_cache_path:compiled_model_cache_path
                                               logger:logger
                                         coreml_flags:coreml_flags];
 }
@@ -339,8 +469,9 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
   return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Execution::LoadModel requires macos 10.15+ or ios 13+ ");
 }
 
-Model::Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags)
-    : execution_(std::make_unique<Execution>(path, logger, coreml_flags)) {
+Model::Model(const std::string& path, const std::string& compiled_model_cache_path,
+             const logging::Logger& logger, uint32_t coreml_flags)
+    : execution_(std::make_unique<Execution>(path, compiled_model_cache_path, logger, coreml_flags)) {
 }
 
 Model::~Model() {}
@@ -235,9 +235,6 @@ common::Status If::SetupSubgraphExecutionInfo(const SessionState& session_state,
 }
 
 Status If::Compute(OpKernelContext* ctx) const {
-  ORT_ENFORCE(then_feeds_fetches_manager_ && else_feeds_fetches_manager_,
-              "CreateFeedsFetchesManager must be called prior to execution of graph.");
-
   auto ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
 
   auto condition = *ctx->Input<Tensor>(0)->Data<bool>();
@@ -246,17 +243,20 @@ Status If::Compute(OpKernelContext* ctx) const {
   auto* session_state = ctx_internal->SubgraphSessionState(attribute);
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for '", attribute, "' attribute.");
 
+  // with kOrtSessionOptionsConfigLazyIfBranches the branch is initialized, and SetupSubgraphExecutionInfo called,
+  // the first time it is taken
+  ORT_RETURN_IF_ERROR(session_state->EnsureFinalized());
+
   const auto& info = condition ? then_info_ : else_info_;
+  const auto& ffm = condition ? then_feeds_fetches_manager_ : else_feeds_fetches_manager_;
+  ORT_ENFORCE(info && ffm, "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
   IfImpl impl{*ctx_internal, *session_state, *info};
 
   auto status = impl.Initialize();
   ORT_RETURN_IF_ERROR(status);
 
-  if (condition) {
-    status = impl.Execute(*then_feeds_fetches_manager_);
-  } else {
-    status = impl.Execute(*else_feeds_fetches_manager_);
-  }
+  status = impl.Execute(*ffm);
 
   return status;
 }
@@ -412,7 +412,7 @@ Status IfImpl::Execute(const FeedsFetchesManager& ffm) {
   }
 
   status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
-                                  ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(),
+                                  ExecutionMode::ORT_SEQUENTIAL, context_.GetRunTermination(),
                                   context_.Logger());
 
   ORT_RETURN_IF_ERROR(status);
@@ -12,8 +12,12 @@
 #include "core/providers/cpu/controlflow/loop.h"
 #include "core/providers/cpu/controlflow/utils.h"
 
+#include <atomic>
+
 #include "core/framework/allocator.h"
+#include "core/framework/data_types_internal.h"
 #include "core/framework/framework_common.h"
+#include "core/framework/mldata_type_utils.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
@@ -21,7 +25,9 @@
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/session_options.h"
 #include "core/framework/TensorSeq.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/utils.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 #include "gsl/gsl"
 
@@ -173,6 +179,17 @@ Loop::Info::Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
     auto& output = subgraph_outputs[i];
     subgraph_output_names.push_back(output->Name());
   }
+
+  const auto* cond_in = subgraph_inputs[1];
+  const auto* cond_out = subgraph_outputs[0];
+  bool cond_passed_through = cond_out == cond_in;
+  if (!cond_passed_through) {
+    const auto* producer = subgraph.GetProducerNode(cond_out->Name());
+    cond_passed_through = producer != nullptr && producer->OpType() == "Identity" &&
+                          producer->InputDefs()[0] == cond_in;
+  }
+
+  independent_iterations = num_loop_carried_vars == 0 && cond_passed_through;
 }
 
 class LoopImpl {
@@ -181,7 +198,8 @@ class LoopImpl {
            const SessionState& session_state,
            const Loop::Info& info,
            const Loop::ConcatOutput& concat_output_func,
-           void* stream);
+           void* stream,
+           bool parallel_iterations);
 
   // Initialize by validating all the inputs, and allocating the output tensors
   Status Initialize();
@@ -191,12 +209,52 @@ class LoopImpl {
   Status Execute(const FeedsFetchesManager& cached_ffm);
 
  private:
+  // A scan output which the iterations write into a buffer holding the values of all the iterations, instead of
+  // each iteration allocating its value and concatenating them all once the loop completes. The buffer grows
+  // geometrically as the number of iterations isn't known up front.
+  struct StagedLoopOutput {
+    MLDataType element_type = nullptr;  // nullptr if the per-iteration values are collected and concatenated
+    OrtDevice device;
+    TensorShape per_iteration_shape;
+    size_t bytes_per_iteration = 0;
+    int64_t capacity = 0;  // number of iterations the buffer holds
+    OrtValue buffer;
+    bool in_place = false;  // the iterations write their values directly in the buffer
+  };
+
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
   void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
 
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
 
+  // setup the scan outputs that can be staged
+  void SetupStagedOutputs(const FeedsFetchesManager& ffm);
+
+  // add the fetch allocators writing the staged outputs of @param iteration in place
+  void AddStagedOutputAllocators(const int64_t& iteration,
+                                 std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // grow the buffer to hold @param capacity iterations, keeping the values of the first num_filled iterations
+  Status ReserveStagedRows(StagedLoopOutput& staged, int64_t capacity, int64_t num_filled);
+
+  // get the location of the value of @param iteration in the buffer, growing it if needed.
+  // row is nullptr if shape doesn't match the shape of the previous iterations.
+  Status GetStagedRow(StagedLoopOutput& staged, const TensorShape& shape, int64_t iteration, void*& row);
+
+  // copy the staged outputs of the iteration that were not written in place to the buffers
+  Status StageOutputs(const std::vector<OrtValue>& fetches, int64_t iteration);
+
+  // the values of the first num_iterations iterations in the buffer
+  OrtValue StagedRows(const StagedLoopOutput& staged, int64_t first_iteration, int64_t num_iterations) const;
+
+  // true if the iterations after the first can run concurrently
+  bool CanRunIterationsInParallel() const;
+
+  // run the iterations after the first concurrently, each with its own iter_num and subgraph frame.
+  // @param first_feeds the feeds of the first iteration.
+  Status ExecuteIterationsInParallel(const FeedsFetchesManager& ffm, const std::vector<OrtValue>& first_feeds);
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const Loop::Info& info_;
@@ -212,9 +270,11 @@ class LoopImpl {
   // collection of OrtValue outputs from each loop iteration for the loop outputs.
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
+  std::vector<StagedLoopOutput> staged_outputs_;
 
   const Loop::ConcatOutput& concat_output_func_;
   void* stream_;
+  const bool parallel_iterations_;
 };
 
 static Status ConcatenateCpuOutput(void* /*stream*/,
@@ -259,6 +319,8 @@ void Loop::Init(const OpKernelInfo& info) {
 
   concat_output_func_ = ConcatenateCpuOutput;
   stream_ = nullptr;
+  parallel_iterations_ =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigParallelLoopIterations, "0") == "1";
 }
 
 std::unique_ptr<OpKernel> Loop::Create(const OpKernelInfo& info, const ConcatOutput& concat_output_func, void* stream) {
@@ -355,7 +417,7 @@ Status Loop::Compute(OpKernelContext* ctx) const {
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
   ORT_ENFORCE(feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
 
-  LoopImpl loop_impl{*ctx_internal, *session_state, *info_, concat_output_func_, stream_};
+  LoopImpl loop_impl{*ctx_internal, *session_state, *info_, concat_output_func_, stream_, parallel_iterations_};
 
   auto status = loop_impl.Initialize();
   ORT_RETURN_IF_ERROR(status);
@@ -369,13 +431,15 @@ LoopImpl::LoopImpl(OpKernelContextInternal& context,
                    const SessionState& session_state,
                    const Loop::Info& subgraph_info,
                    const Loop::ConcatOutput& concat_output_func,
-                   void* stream)
+                   void* stream,
+                   bool parallel_iterations)
     : context_(context),
       session_state_(session_state),
       info_(subgraph_info),
       implicit_inputs_(context_.GetImplicitInputs()),
       concat_output_func_(concat_output_func),
-      stream_(stream) {
+      stream_(stream),
+      parallel_iterations_(parallel_iterations) {
   auto* max_trip_count_tensor = context.Input<Tensor>(0);
   max_trip_count_ = max_trip_count_tensor ? *max_trip_count_tensor->Data<int64_t>() : INT64_MAX;
 
@@ -422,6 +486,7 @@ Status LoopImpl::Initialize() {
   condition_mlvalue_ = MakeScalarMLValue<bool>(cpu_allocator, condition_, condition_rank != 0);
 
   loop_output_tensors_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
+  staged_outputs_.resize(loop_output_tensors_.size());
 
   return status;
 }
@@ -456,6 +521,10 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
 
   // save loop outputs as we have to concatenate at the end
   for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
+    if (staged_outputs_[j - info_.num_loop_carried_vars].element_type != nullptr) {
+      continue;  // already in the buffer
+    }
+
     ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
     loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
   }
@@ -480,6 +549,245 @@ Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_outp
   return Status::OK();
 }
 
+void LoopImpl::SetupStagedOutputs(const FeedsFetchesManager& ffm) {
+  const auto& subgraph_outputs = info_.subgraph.GetOutputs();
+  const auto& fetch_copy_info = ffm.GetFetchesDeviceCopyInfo();
+
+  for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    const size_t fetch_idx = static_cast<size_t>(i) + 1;  // skip cond
+    const auto* subgraph_output = subgraph_outputs[fetch_idx];
+
+    // the element type is needed to create the buffer before the first iteration produces its value.
+    // string tensors need to be constructed so the values are collected.
+    const auto* type = utils::GetMLDataType(*subgraph_output);
+    if (type == nullptr || !type->IsTensorType()) {
+      continue;
+    }
+
+    const auto* element_type = type->AsTensorType()->GetElementType();
+    if (utils::IsDataTypeString(element_type)) {
+      continue;
+    }
+
+    auto& staged = staged_outputs_[static_cast<size_t>(i) - info_.num_loop_carried_vars];
+    staged.element_type = element_type;
+    staged.device = fetch_copy_info[fetch_idx].target_device;
+
+    // a value that is also a loop carried var, or another scan output, must not alias the buffer as the
+    // buffer is reallocated when it grows. it is copied to the buffer after the iteration instead.
+    staged.in_place = std::count(subgraph_outputs.cbegin(), subgraph_outputs.cend(), subgraph_output) == 1;
+  }
+}
+
+void LoopImpl::AddStagedOutputAllocators(const int64_t& iteration,
+                                         std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    auto& staged = staged_outputs_[static_cast<size_t>(i) - info_.num_loop_carried_vars];
+    if (!staged.in_place) {
+      continue;
+    }
+
+    const size_t fetch_idx = static_cast<size_t>(i) + 1;  // skip cond
+    fetch_allocators[fetch_idx] = [this, &staged, &iteration](const TensorShape& shape, const OrtMemoryInfo& location,
+                                                              OrtValue& ort_value, bool& allocated) -> Status {
+      // a value produced on another device is copied to the buffer after the iteration
+      if (location.device != staged.device) {
+        return Status::OK();
+      }
+
+      void* row = nullptr;
+      ORT_RETURN_IF_ERROR(GetStagedRow(staged, shape, iteration, row));
+      if (row != nullptr) {
+        Tensor::InitOrtValue(staged.element_type, shape, row, staged.buffer.Get<Tensor>().Location(), ort_value);
+        allocated = true;
+      }
+
+      return Status::OK();
+    };
+  }
+}
+
+Status LoopImpl::GetStagedRow(StagedLoopOutput& staged, const TensorShape& shape, int64_t iteration, void*& row) {
+  row = nullptr;
+
+  if (staged.capacity == 0) {
+    staged.per_iteration_shape = shape;
+    staged.bytes_per_iteration = SafeInt<size_t>(shape.Size()) * staged.element_type->Size();
+  } else if (shape != staged.per_iteration_shape) {
+    return Status::OK();
+  }
+
+  if (iteration >= staged.capacity) {
+    // start small as the loop may exit early on cond, and double the capacity so an iteration copies
+    // the values of the previous iterations once on average.
+    constexpr int64_t kInitialCapacity = 16;
+    int64_t capacity = staged.capacity == 0 ? kInitialCapacity : staged.capacity * 2;
+    capacity = std::max(std::min(capacity, max_trip_count_), iteration + 1);
+    ORT_RETURN_IF_ERROR(ReserveStagedRows(staged, capacity, iteration));
+  }
+
+  row = static_cast<gsl::byte*>(staged.buffer.GetMutable<Tensor>()->MutableDataRaw()) +
+        SafeInt<size_t>(iteration) * staged.bytes_per_iteration;
+
+  return Status::OK();
+}
+
+Status LoopImpl::ReserveStagedRows(StagedLoopOutput& staged, int64_t capacity, int64_t num_filled) {
+  if (capacity > staged.capacity) {
+    auto allocator = session_state_.GetAllocator(staged.device);
+    ORT_RETURN_IF(allocator == nullptr, "Loop failed to find an allocator for device ", staged.device.ToString());
+
+    std::vector<int64_t> dims{capacity};
+    const auto& per_iteration_dims = staged.per_iteration_shape.GetDims();
+    std::copy(per_iteration_dims.cbegin(), per_iteration_dims.cend(), std::back_inserter(dims));
+
+    OrtValue buffer;
+    Tensor::InitOrtValue(staged.element_type, TensorShape(dims), std::move(allocator), buffer);
+
+    if (num_filled > 0) {
+      // Safely use the IDataTransfer abstraction as we only allow using
+      // Loop on CUDA if the copy stream is the same as the compute stream.
+      auto previous_rows = StagedRows(staged, 0, num_filled);
+      staged.buffer = std::move(buffer);
+      auto new_rows = StagedRows(staged, 0, num_filled);
+      ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(previous_rows.Get<Tensor>(),
+                                                                          *new_rows.GetMutable<Tensor>()));
+    } else {
+      staged.buffer = std::move(buffer);
+    }
+
+    staged.capacity = capacity;
+  }
+
+  return Status::OK();
+}
+
+Status LoopImpl::StageOutputs(const std::vector<OrtValue>& fetches, int64_t iteration) {
+  for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    auto& staged = staged_outputs_[static_cast<size_t>(i) - info_.num_loop_carried_vars];
+    if (staged.element_type == nullptr) {
+      continue;
+    }
+
+    const auto& fetch = fetches[static_cast<size_t>(i) + 1];  // skip cond
+    ORT_RETURN_IF_NOT(fetch.IsTensor(), "All scan outputs MUST be tensors");
+    const auto& value = fetch.Get<Tensor>();
+    ORT_RETURN_IF_NOT(value.DataType() == staged.element_type, "Loop output ", i, " has type ",
+                      DataTypeImpl::ToString(value.DataType()), " but the subgraph output type is ",
+                      DataTypeImpl::ToString(staged.element_type));
+
+    void* row = nullptr;
+    ORT_RETURN_IF_ERROR(GetStagedRow(staged, value.Shape(), iteration, row));
+    if (row == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output. ",
+                             " Expected:", staged.per_iteration_shape, " Got:", value.Shape());
+    }
+
+    if (value.DataRaw() != row) {
+      auto destination = StagedRows(staged, iteration, 1);
+      Tensor& destination_tensor = *destination.GetMutable<Tensor>();
+      // copy through a tensor of the shape of the row as the data transfer requires the sizes match
+      Tensor source(value.DataType(), destination_tensor.Shape(), const_cast<void*>(value.DataRaw()),
+                    value.Location());
+      ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(source, destination_tensor));
+    }
+  }
+
+  return Status::OK();
+}
+
+OrtValue LoopImpl::StagedRows(const StagedLoopOutput& staged, int64_t first_iteration, int64_t num_iterations) const {
+  const auto& buffer = staged.buffer.Get<Tensor>();
+
+  std::vector<int64_t> dims{num_iterations};
+  const auto& per_iteration_dims = staged.per_iteration_shape.GetDims();
+  std::copy(per_iteration_dims.cbegin(), per_iteration_dims.cend(), std::back_inserter(dims));
+
+  auto* data = static_cast<gsl::byte*>(const_cast<void*>(buffer.DataRaw())) +
+               SafeInt<size_t>(first_iteration) * staged.bytes_per_iteration;
+
+  OrtValue rows;
+  Tensor::InitOrtValue(staged.element_type, TensorShape(dims), data, buffer.Location(), rows);
+  return rows;
+}
+
+bool LoopImpl::CanRunIterationsInParallel() const {
+  // on other devices the iterations are queued on the same stream, so there is nothing to gain
+  if (!parallel_iterations_ || !info_.independent_iterations || stream_ != nullptr || max_trip_count_ < 3) {
+    return false;
+  }
+
+  // the iterations write to disjoint rows of the buffers. collecting the values isn't thread-safe
+  return std::all_of(staged_outputs_.cbegin(), staged_outputs_.cend(),
+                     [](const StagedLoopOutput& staged) { return staged.element_type != nullptr; });
+}
+
+Status LoopImpl::ExecuteIterationsInParallel(const FeedsFetchesManager& ffm, const std::vector<OrtValue>& first_feeds) {
+  // the buffers must not grow while the iterations write to them
+  for (auto& staged : staged_outputs_) {
+    ORT_RETURN_IF_ERROR(ReserveStagedRows(staged, max_trip_count_, 1));
+  }
+
+  auto* tp = session_state_.GetInterOpThreadPool();
+  if (concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    tp = context_.GetOperatorThreadPool();
+  }
+
+  auto cpu_allocator = session_state_.GetExecutionProviders()
+                           .Get(onnxruntime::kCpuExecutionProvider)
+                           ->GetAllocator(0, OrtMemTypeDefault);
+  const auto& iter_num_shape = iter_num_mlvalue_.Get<Tensor>().Shape();
+
+  // each worker takes the next iteration until there are none left, so iterations of different costs balance out
+  const int64_t num_workers =
+      std::min<int64_t>(max_trip_count_ - 1, concurrency::ThreadPool::DegreeOfParallelism(tp));
+  std::atomic<int64_t> next_iteration{1};
+  std::atomic<bool> failed{false};
+  std::vector<Status> statuses(static_cast<size_t>(num_workers));
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_workers), [&](std::ptrdiff_t worker) {
+        auto& status = statuses[static_cast<size_t>(worker)];
+        ORT_TRY {
+          // cond and the implicit inputs are shared by the iterations
+          std::vector<OrtValue> feeds = first_feeds;
+          Tensor::InitOrtValue(DataTypeImpl::GetType<int64_t>(), iter_num_shape, cpu_allocator, feeds[0]);
+          auto& iteration = *feeds[0].GetMutable<Tensor>()->MutableData<int64_t>();
+
+          std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+          AddStagedOutputAllocators(iteration, fetch_allocators);
+
+          std::vector<OrtValue> fetches;
+          for (int64_t i = next_iteration++; i < max_trip_count_ && !failed; i = next_iteration++) {
+            iteration = i;
+            fetches.clear();
+            status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
+                                            ExecutionMode::ORT_SEQUENTIAL, context_.GetRunTermination(),
+                                            context_.Logger());
+            if (status.IsOK()) {
+              status = StageOutputs(fetches, i);
+            }
+
+            if (!status.IsOK()) {
+              failed = true;
+            }
+          }
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+            failed = true;
+          });
+        }
+      });
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
 Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   auto status = Status::OK();
 
@@ -490,20 +798,31 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  SetupStagedOutputs(ffm);
+  AddStagedOutputAllocators(iter_num_value, fetch_allocators);
+
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
       SaveOutputsAndUpdateFeeds(fetches, feeds);
       fetches.clear();
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
-                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
+                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetRunTermination(), context_.Logger());
 
     ORT_RETURN_IF_ERROR(status);
+    ORT_RETURN_IF_ERROR(StageOutputs(fetches, iter_num_value));
 
     condition_mlvalue_ = fetches[0];
 
     ++iter_num_value;
+
+    // the first iteration ran on its own to create the buffers from the shapes of its outputs
+    if (iter_num_value == 1 && CanRunIterationsInParallel()) {
+      ORT_RETURN_IF_ERROR(ExecuteIterationsInParallel(ffm, feeds));
+      iter_num_value = max_trip_count_;
+    }
   }
 
   // As the loop carried variables may change shape across iterations there's no way to avoid a copy
@@ -574,6 +893,15 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
     }
 
     for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+      const auto& staged = staged_outputs_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
+      if (staged.element_type != nullptr) {
+        // single copy of the values of all the iterations as the number of iterations wasn't known up front
+        auto rows = StagedRows(staged, 0, iter_num_value);
+        Tensor* output = context_.Output(i, rows.Get<Tensor>().Shape());
+        ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(rows.Get<Tensor>(), *output));
+        continue;
+      }
+
       // add last output
       auto& per_iteration_outputs = loop_output_tensors_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
       per_iteration_outputs.push_back(fetches[static_cast<ptrdiff_t>(i) + 1]);  // skip cond
@@ -39,6 +39,10 @@ class Loop : public controlflow::IControlFlowKernel {
     std::vector<std::string> subgraph_output_names;
 
     std::vector<const ONNX_NAMESPACE::TypeProto*> loop_carried_vars_types;
+
+    // true if an iteration only depends on iter_num, i.e. there are no loop carried vars and cond is passed through
+    // unchanged, so the iterations can run in any order.
+    bool independent_iterations;
   };
 
   // function to concatenate the OrtValue instances from each Loop iteration into a single output buffer.
@@ -60,5 +64,8 @@ class Loop : public controlflow::IControlFlowKernel {
   std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
   ConcatOutput concat_output_func_;
   void* stream_;
+
+  // run independent iterations concurrently. see kOrtSessionOptionsConfigParallelLoopIterations
+  bool parallel_iterations_ = false;
 };
 }  // namespace onnxruntime
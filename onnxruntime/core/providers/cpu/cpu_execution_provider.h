@@ -5,6 +5,8 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/huge_page_allocator.h"
+#include "core/framework/numa_allocator.h"
 #include "core/graph/constants.h"
 
 namespace onnxruntime {
@@ -12,9 +14,13 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // back large allocations, e.g. the arena regions and pre-packed weights, with huge pages
+  bool use_huge_pages{false};
+  // if non-negative, place large allocations in the memory of this NUMA node. takes precedence over use_huge_pages.
+  int numa_node{-1};
 
-  explicit CPUExecutionProviderInfo(bool use_arena)
-      : create_arena(use_arena) {}
+  explicit CPUExecutionProviderInfo(bool use_arena, bool use_huge_pages = false)
+      : create_arena(use_arena), use_huge_pages(use_huge_pages) {}
 
   CPUExecutionProviderInfo() = default;
 };
@@ -39,6 +45,13 @@ class CPUExecutionProvider : public IExecutionProvider {
 
     AllocatorCreationInfo device_info{[](int) { return std::make_unique<CPUAllocator>(); },
                                       0, create_arena};
+    if (info.numa_node >= 0) {
+      device_info.device_alloc_factory = [numa_node = info.numa_node](int) {
+        return std::make_unique<NumaCPUAllocator>(numa_node);
+      };
+    } else if (info.use_huge_pages) {
+      device_info.device_alloc_factory = [](int) { return std::make_unique<HugePageCPUAllocator>(); };
+    }
 
     InsertAllocator(CreateAllocator(device_info));
   }
@@ -3,6 +3,8 @@
 
 #include "einsum_typed_compute_processor.h"
 
+#include <numeric>
+
 namespace onnxruntime {
 
 template <typename T>
@@ -324,6 +326,115 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   return output;
 }
 
+// The operands are contracted one after the other into a running result, so with 3 or more operands
+// the order decides how large the intermediate results and their MatMuls get (e.g. for 'ij,jk,k->i'
+// contracting 'jk,k' first avoids materializing the [i, k] product).
+// The order is picked greedily: first the cheapest pair, then the operand whose contraction with the running
+// result is the cheapest. The cost of a contraction is the product of the dims of all the subscript labels
+// involved, which is the number of multiply-adds of its MatMul. Ties keep the order of the equation.
+// Returns the order of the operands, and for each subscript label, the step after which it can be reduced
+// (-1 if it appears in the output).
+static InlinedVector<size_t> ChooseContractionOrder(const std::vector<TensorShape>& homogenized_input_dims,
+                                                    const std::vector<int64_t>& subscript_indices_to_last_input,
+                                                    size_t num_inputs, int64_t num_subscript_labels,
+                                                    InlinedVector<int64_t>& subscript_indices_to_last_step) {
+  InlinedVector<size_t> order(num_inputs);
+  std::iota(order.begin(), order.end(), size_t{0});
+
+  // A label is part of an operand if the operand has a non-trivial dim for it. Broadcasted (1) dims
+  // contribute nothing, except for the last operand with the label in the equation, which keeps the
+  // original reduction point when the label has a trivial dim everywhere.
+  auto has_label = [&](size_t input, int64_t label) {
+    return homogenized_input_dims[input][static_cast<size_t>(label)] > 1 ||
+           subscript_indices_to_last_input[label] == static_cast<int64_t>(input);
+  };
+
+  if (num_inputs >= 3) {
+    InlinedVector<double> label_dims(num_subscript_labels, 1.);
+    for (size_t input = 0; input < num_inputs; ++input) {
+      for (int64_t label = 0; label < num_subscript_labels; ++label) {
+        label_dims[label] = std::max(label_dims[label],
+                                     static_cast<double>(homogenized_input_dims[input][static_cast<size_t>(label)]));
+      }
+    }
+
+    InlinedVector<bool> used(num_inputs, false);
+    InlinedVector<bool> live(num_subscript_labels, false);
+
+    // multiply-adds of contracting the labels in live (if with_live) with those of the given inputs
+    auto cost = [&](bool with_live, size_t a, size_t b) {
+      double product = 1.;
+      for (int64_t label = 0; label < num_subscript_labels; ++label) {
+        if ((with_live && live[label]) || has_label(a, label) || has_label(b, label)) {
+          product *= label_dims[label];
+        }
+      }
+      return product;
+    };
+
+    // keep the labels of the running result that are in the output or in one of the unused operands
+    auto update_live = [&](size_t added) {
+      for (int64_t label = 0; label < num_subscript_labels; ++label) {
+        live[label] = live[label] || has_label(added, label);
+        if (live[label] && subscript_indices_to_last_input[label] != -1) {
+          bool needed = false;
+          for (size_t input = 0; input < num_inputs && !needed; ++input) {
+            needed = !used[input] && has_label(input, label);
+          }
+          live[label] = needed;
+        }
+      }
+    };
+
+    size_t first = 0;
+    size_t second = 1;
+    double best_cost = cost(false, first, second);
+    for (size_t a = 0; a < num_inputs; ++a) {
+      for (size_t b = a + 1; b < num_inputs; ++b) {
+        double pair_cost = cost(false, a, b);
+        if (pair_cost < best_cost) {
+          best_cost = pair_cost;
+          first = a;
+          second = b;
+        }
+      }
+    }
+
+    order[0] = first;
+    order[1] = second;
+    used[first] = used[second] = true;
+    update_live(first);
+    update_live(second);
+
+    for (size_t step = 2; step < num_inputs; ++step) {
+      size_t next = num_inputs;
+      for (size_t input = 0; input < num_inputs; ++input) {
+        if (!used[input] && (next == num_inputs || cost(true, input, input) < best_cost)) {
+          best_cost = cost(true, input, input);
+          next = input;
+        }
+      }
+      order[step] = next;
+      used[next] = true;
+      update_live(next);
+    }
+  }
+
+  subscript_indices_to_last_step.assign(num_subscript_labels, -1);
+  for (int64_t label = 0; label < num_subscript_labels; ++label) {
+    if (subscript_indices_to_last_input[label] == -1) {
+      continue;
+    }
+    for (size_t step = 0; step < num_inputs; ++step) {
+      if (has_label(order[step], label)) {
+        subscript_indices_to_last_step[label] = static_cast<int64_t>(step);
+      }
+    }
+  }
+
+  return order;
+}
+
 template <typename T>
 void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelpers::Transpose& device_transpose_func,
                                                       const EinsumOp::DeviceHelpers::MatMul<T>& device_matmul_func,
@@ -349,6 +460,13 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
+  // The order in which the operands are contracted, and the step after which each dim can be reduced
+  InlinedVector<int64_t> mapped_indices_to_last_step;
+  const auto order = ChooseContractionOrder(homogenized_input_dims, mapped_indices_to_last_input_index,
+                                            static_cast<size_t>(num_inputs), num_subscript_labels,
+                                            mapped_indices_to_last_step);
+  const size_t first_input = order[0];
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
 
@@ -360,7 +478,7 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     preserved_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving.
 
     for (int64_t i = 0; i < num_subscript_labels; ++i) {
-      if (mapped_indices_to_last_input_index[i] == 0) {
+      if (mapped_indices_to_last_step[i] == 0) {
         reduced_dims.push_back(i);
       } else {
         preserved_dims.push_back(i);
@@ -369,14 +487,15 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
     // Reduce the dims that are last seen in the first input alone
     if (reduced_dims.size() != 0) {
-      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
-                                      homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
+      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[first_input] ? *preprocessed_inputs[first_input]
+                                                                        : *raw_inputs[first_input],
+                                      homogenized_input_dims[first_input].GetDims(), reduced_dims, allocator_, tp_,
                                       einsum_ep_assets_, device_reduce_sum_func_);
     } else {
       // Check if there is a pre-processed version of this input
       // If so assign it to result
-      if (preprocessed_inputs[0]) {
-        result = std::move(preprocessed_inputs[0]);
+      if (preprocessed_inputs[first_input]) {
+        result = std::move(preprocessed_inputs[first_input]);
       }
     }
 
@@ -384,7 +503,7 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     if (num_inputs == 1) {
       // Finalize the output by applying any transpose required to get
       // it to the required output ordering and move it to the op's output
-      FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
+      FinalizeOutput(result ? *result : *raw_inputs[first_input], preserved_dims);
 
       return Status::OK();
     }
@@ -394,21 +513,22 @@ Status EinsumTypedComputeProcessor<T>::Run() {
   {
     bool is_final_pair = false;
     // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
+    for (int step = 1; step < num_inputs; ++step) {
+      const size_t input = order[step];
       TensorShapeVector reduced_dims;
       reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
       for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[dim] == input) {
+        if (mapped_indices_to_last_step[dim] == step) {
           // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
           reduced_dims.push_back(dim);
         }
       }
-      if (input == num_inputs - 1) {
+      if (step == num_inputs - 1) {
         is_final_pair = true;
       }
       // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
+      result = PairwiseOperandProcess(result ? *result : *raw_inputs[first_input],
+                                      result ? result->Shape() : homogenized_input_dims[first_input],
                                       preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
                                       homogenized_input_dims[input],
                                       reduced_dims, is_final_pair);
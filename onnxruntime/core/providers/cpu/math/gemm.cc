@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/math/gemm.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
+#include "core/common/safeint.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
@@ -70,6 +71,44 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
 
+// MLFloat16 kernels are only registered when MlasFp16AccelerationSupported() reports native half precision
+// arithmetic. Otherwise fp16 nodes keep running in float via the cast insertion done at partitioning time.
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    7,
+    8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    9,
+    10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
+// opset 13 added bfloat16, only registered when MlasBf16AccelerationSupported() reports bfloat16 instructions.
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    Gemm<BFloat16>);
+
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
                    bool trans_b,
@@ -108,6 +147,171 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+bool GemmPackBFp16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  packed_b_size = MlasHalfGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+
+  // See GemmPackBFp32 for why the padding is cleared.
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasHalfGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                    N,
+                    K,
+                    reinterpret_cast<const MLAS_FP16*>(tensor_b.Data<MLFloat16>()),
+                    trans_b ? K : N,
+                    packed_b_data);
+  return true;
+}
+
+bool GemmPackBBf16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  packed_b_size = MlasSBGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+
+  // See GemmPackBFp32 for why the padding is cleared.
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasSBGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                  N,
+                  K,
+                  reinterpret_cast<const MLAS_BF16*>(tensor_b.Data<BFloat16>()),
+                  trans_b ? K : N,
+                  packed_b_data);
+  return true;
+}
+
+namespace {
+
+template <typename T>
+struct ReducedPrecisionGemm;
+
+template <>
+struct ReducedPrecisionGemm<MLFloat16> {
+  static size_t PackBSize(size_t N, size_t K) { return MlasHalfGemmPackBSize(N, K); }
+
+  static void PackTransposedB(size_t N, size_t K, const MLFloat16* b, size_t ldb, void* packed_b) {
+    MlasHalfGemmPackB(CblasTrans, N, K, reinterpret_cast<const MLAS_FP16*>(b), ldb, packed_b);
+  }
+};
+
+template <>
+struct ReducedPrecisionGemm<BFloat16> {
+  static size_t PackBSize(size_t N, size_t K) { return MlasSBGemmPackBSize(N, K); }
+
+  static void PackTransposedB(size_t N, size_t K, const BFloat16* b, size_t ldb, void* packed_b) {
+    MlasSBGemmPackB(CblasTrans, N, K, reinterpret_cast<const MLAS_BF16*>(b), ldb, packed_b);
+  }
+};
+
+inline float AccumulatorToFloat(float value) { return value; }
+inline float AccumulatorToFloat(MLFloat16 value) { return value.ToFloat(); }
+
+}  // namespace
+
+template <typename T>
+IAllocatorUniquePtr<T> GemmTransposeA(const AllocatorPtr& alloc, const T* a_data, const std::vector<size_t>& a_offsets,
+                                      size_t M, size_t K, size_t lda) {
+  auto a_transposed = IAllocator::MakeUniquePtr<T>(alloc, SafeInt<size_t>(a_offsets.size()) * M * K);
+  for (size_t i = 0; i < a_offsets.size(); i++) {
+    const T* src = a_data + a_offsets[i];
+    T* dst = a_transposed.get() + i * M * K;
+    for (size_t k = 0; k < K; k++) {
+      for (size_t m = 0; m < M; m++) {
+        dst[m * K + k] = src[k * lda + m];
+      }
+    }
+  }
+  return a_transposed;
+}
+
+template <typename T>
+IAllocatorUniquePtr<uint8_t> GemmPackTransposedB(const AllocatorPtr& alloc, const T* b_data,
+                                                 const std::vector<size_t>& b_offsets, size_t N, size_t K, size_t ldb,
+                                                 size_t& packed_b_size) {
+  packed_b_size = ReducedPrecisionGemm<T>::PackBSize(N, K);
+  if (packed_b_size == 0) {
+    return nullptr;
+  }
+
+  auto b_packed = IAllocator::MakeUniquePtr<uint8_t>(alloc, SafeInt<size_t>(b_offsets.size()) * packed_b_size);
+  for (size_t i = 0; i < b_offsets.size(); i++) {
+    ReducedPrecisionGemm<T>::PackTransposedB(N, K, b_data + b_offsets[i], ldb, b_packed.get() + i * packed_b_size);
+  }
+  return b_packed;
+}
+
+template <typename TAcc, typename T>
+void GemmScaleAndAddBias(const TAcc* acc, T* y, size_t rows, size_t N, float alpha, const Tensor* C, float beta,
+                         concurrency::ThreadPool* thread_pool) {
+  const bool apply_bias = C != nullptr && beta != 0.0f;
+  const T* c_data = apply_bias ? C->Data<T>() : nullptr;
+  const size_t c_dims = apply_bias ? C->Shape().NumDimensions() : 0;
+  const size_t c_rows = c_dims == 2 ? static_cast<size_t>(C->Shape()[0]) : 1;
+  const size_t c_cols = c_dims != 0 ? static_cast<size_t>(C->Shape()[c_dims - 1]) : 1;
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(rows),
+      {static_cast<double>(N * sizeof(TAcc)), static_cast<double>(N * sizeof(T)), static_cast<double>(N * 2)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (size_t m = static_cast<size_t>(first); m < static_cast<size_t>(last); m++) {
+          for (size_t n = 0; n < N; n++) {
+            float value = alpha * AccumulatorToFloat(acc[m * N + n]);
+            if (apply_bias) {
+              value += beta * c_data[(c_rows == 1 ? 0 : m) * c_cols + (c_cols == 1 ? 0 : n)].ToFloat();
+            }
+            y[m * N + n] = T(value);
+          }
+        }
+      });
+}
+
+template IAllocatorUniquePtr<MLFloat16> GemmTransposeA(const AllocatorPtr&, const MLFloat16*,
+                                                       const std::vector<size_t>&, size_t, size_t, size_t);
+template IAllocatorUniquePtr<BFloat16> GemmTransposeA(const AllocatorPtr&, const BFloat16*,
+                                                      const std::vector<size_t>&, size_t, size_t, size_t);
+template IAllocatorUniquePtr<uint8_t> GemmPackTransposedB(const AllocatorPtr&, const MLFloat16*,
+                                                          const std::vector<size_t>&, size_t, size_t, size_t, size_t&);
+template IAllocatorUniquePtr<uint8_t> GemmPackTransposedB(const AllocatorPtr&, const BFloat16*,
+                                                          const std::vector<size_t>&, size_t, size_t, size_t, size_t&);
+template void GemmScaleAndAddBias(const MLFloat16*, MLFloat16*, size_t, size_t, float, const Tensor*, float,
+                                  concurrency::ThreadPool*);
+template void GemmScaleAndAddBias(const float*, BFloat16*, size_t, size_t, float, const Tensor*, float,
+                                  concurrency::ThreadPool*);
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
@@ -193,6 +397,31 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+template <typename T>
+Status Gemm<T>::UseCachedPrePackedBuffers(const Tensor& /*tensor*/,
+                                          std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                          int /*input_idx*/,
+                                          /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                              std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  // GemmPackBFp32 only packs 2D weights
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(T* y_data, size_t y_size, concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -276,29 +505,284 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
+  MLAS_SGEMM_DATA_PARAMS data;
+  data.A = A->Data<float>();
+  data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
   if (B) {
-    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
-                c_data, c_shape, y_data, thread_pool);
+    data.B = B->Data<float>();
+    data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+  } else {
+    data.B = static_cast<const float*>(packed_b_.get());
+    data.BIsPacked = true;
+  }
+  data.C = y_data;
+  data.ldc = static_cast<size_t>(N);
+  data.alpha = alpha_;
+
+  // A row bias and a MLAS activation are applied by the GEMM kernels as the output
+  // is written, which saves the broadcast pass and the activation pass over Y.
+  MLAS_SGEMM_EPILOGUE epilogue;
+  const bool is_row_bias = c_data != nullptr && beta_ == 1.0f && c_shape->Size() == N &&
+                           (c_shape->NumDimensions() == 1 || (c_shape->NumDimensions() == 2 && (*c_shape)[0] == 1));
+  if (is_row_bias) {
+    epilogue.Bias = c_data;
+    data.beta = 0.0f;
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    MlasGemm(
-        trans_A_,
-        static_cast<size_t>(M),
-        static_cast<size_t>(N),
-        static_cast<size_t>(K),
-        alpha_,
-        A->Data<float>(),
-        static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-        packed_b_.get(),
-        c_data != nullptr ? beta_ : 0.0f,
-        y_data,
-        static_cast<size_t>(N),
-        thread_pool);
+    data.beta = c_data != nullptr ? beta_ : 0.0f;
+  }
+  if (mlas_activation_.has_value()) {
+    epilogue.Activation = &*mlas_activation_;
   }
+  if (is_row_bias || mlas_activation_.has_value()) {
+    data.Epilogue = &epilogue;
+  }
+
+  MlasGemm(trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+           data, thread_pool);
 
   ComputeActivation(y_data, M * N, thread_pool);
 
   return Status::OK();
 }
 
+template <>
+Status Gemm<MLFloat16>::PrePack(const Tensor& tensor, int input_idx,
+                                AllocatorPtr alloc, /*out*/ bool& is_packed,
+                                /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = GemmPackBFp16(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<MLFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                  int input_idx,
+                                                  /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<MLFloat16>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                                  std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                  int input_idx,
+                                                  /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  // GemmPackBFp16 only packs 2D weights
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* A = context->Input<Tensor>(0);
+  const auto* B = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const auto* C = context->Input<Tensor>(2);
+
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(A->Shape(), trans_A_ != CblasNoTrans, B ? B->Shape() : b_shape_, trans_B_ != CblasNoTrans,
+                    C != nullptr ? C->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  auto Y = context->Output(0, {helper.M(), helper.N()});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  MLFloat16* y_data = Y->MutableData<MLFloat16>();
+  const MLFloat16* a_data = A->Data<MLFloat16>();
+  const std::vector<size_t> offsets{0};
+
+  IAllocatorUniquePtr<MLFloat16> a_transposed;
+  if (trans_A_ != CblasNoTrans) {
+    a_transposed = GemmTransposeA(alloc, a_data, offsets, M, K, M);
+    a_data = a_transposed.get();
+  }
+
+  MLAS_HALF_GEMM_DATA_PARAMS data;
+  data.A = reinterpret_cast<const MLAS_FP16*>(a_data);
+  data.lda = K;
+
+  IAllocatorUniquePtr<uint8_t> b_packed;
+  if (B == nullptr) {
+    data.B = packed_b_.get();
+    data.BIsPacked = true;
+  } else if (trans_B_ != CblasNoTrans) {
+    size_t packed_b_size;
+    b_packed = GemmPackTransposedB(alloc, B->Data<MLFloat16>(), offsets, N, K, K, packed_b_size);
+    data.B = b_packed.get();
+    data.BIsPacked = true;
+  } else {
+    data.B = B->Data<MLFloat16>();
+    data.ldb = N;
+  }
+
+  // A row vector bias with unit scales is folded into the kernel, anything else is applied afterwards.
+  const bool c_is_row = C != nullptr &&
+                        (C->Shape().NumDimensions() == 1 ||
+                         (C->Shape().NumDimensions() == 2 && C->Shape()[0] == 1)) &&
+                        static_cast<size_t>(C->Shape().Size()) == N;
+  const bool fuse_bias = c_is_row && alpha_ == 1.0f && beta_ == 1.0f;
+
+  data.C = reinterpret_cast<MLAS_FP16*>(y_data);
+  data.ldc = N;
+  data.Bias = fuse_bias ? reinterpret_cast<const MLAS_FP16*>(C->Data<MLFloat16>()) : nullptr;
+  MlasHalfGemmBatch(M, N, K, 1, &data, thread_pool);
+
+  const Tensor* bias = fuse_bias || beta_ == 0.0f ? nullptr : C;
+  if (alpha_ != 1.0f || bias != nullptr) {
+    GemmScaleAndAddBias(y_data, y_data, M, N, alpha_, bias, beta_, thread_pool);
+  }
+
+  return Status::OK();
+}
+
+template <>
+Status Gemm<BFloat16>::PrePack(const Tensor& tensor, int input_idx,
+                               AllocatorPtr alloc, /*out*/ bool& is_packed,
+                               /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = GemmPackBBf16(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<BFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                 int input_idx,
+                                                 /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<BFloat16>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                                 std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                 int input_idx,
+                                                 /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  // GemmPackBBf16 only packs 2D weights
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<BFloat16>::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* A = context->Input<Tensor>(0);
+  const auto* B = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const auto* C = context->Input<Tensor>(2);
+
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(A->Shape(), trans_A_ != CblasNoTrans, B ? B->Shape() : b_shape_, trans_B_ != CblasNoTrans,
+                    C != nullptr ? C->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  auto Y = context->Output(0, {helper.M(), helper.N()});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  BFloat16* y_data = Y->MutableData<BFloat16>();
+  const BFloat16* a_data = A->Data<BFloat16>();
+  const std::vector<size_t> offsets{0};
+
+  IAllocatorUniquePtr<BFloat16> a_transposed;
+  if (trans_A_ != CblasNoTrans) {
+    a_transposed = GemmTransposeA(alloc, a_data, offsets, M, K, M);
+    a_data = a_transposed.get();
+  }
+
+  MLAS_SBGEMM_DATA_PARAMS data;
+  data.A = reinterpret_cast<const MLAS_BF16*>(a_data);
+  data.lda = K;
+
+  IAllocatorUniquePtr<uint8_t> b_packed;
+  if (B == nullptr) {
+    data.B = packed_b_.get();
+    data.BIsPacked = true;
+  } else if (trans_B_ != CblasNoTrans) {
+    size_t packed_b_size;
+    b_packed = GemmPackTransposedB(alloc, B->Data<BFloat16>(), offsets, N, K, K, packed_b_size);
+    data.B = b_packed.get();
+    data.BIsPacked = true;
+  } else {
+    data.B = B->Data<BFloat16>();
+    data.ldb = N;
+  }
+
+  // The products are accumulated in single precision, scaled and biased, then rounded once.
+  auto c_buffer = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(M) * N);
+  data.C = c_buffer.get();
+  data.ldc = N;
+  MlasSBGemmBatch(M, N, K, 1, &data, thread_pool);
+
+  GemmScaleAndAddBias(c_buffer.get(), y_data, M, N, alpha_, C, beta_, thread_pool);
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -9,6 +9,8 @@
 #include "core/common/common.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/common/optional.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -28,6 +30,9 @@ class Gemm : protected GemmBase, public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx, /*out*/ bool& used_cached_buffers) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
                           float alpha,
@@ -44,6 +49,9 @@ class Gemm : protected GemmBase, public OpKernel {
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
 
+  // For fused gemm + activation applied by the MLAS kernels, set instead of activation_
+  optional<MLAS_ACTIVATION> mlas_activation_;
+
   void ComputeActivation(T* y_data, size_t y_size, concurrency::ThreadPool* thread_pool) const;
 };
 
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -14,4 +16,46 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
 
+bool GemmPackBFp16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape);
+
+bool GemmPackBBf16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape);
+
+// The MLFloat16 and BFloat16 kernels of Gemm and MatMul share these steps around the MLAS half and bfloat16 GEMMs,
+// which only consume a row major A and a transposed B once it is packed.
+
+/**
+ * Materializes the row major [M, K] matrices of a batch of transposed A, each read at its offset with stride lda.
+ * @returns The M * K matrices, one after the other.
+ */
+template <typename T>
+IAllocatorUniquePtr<T> GemmTransposeA(const AllocatorPtr& alloc, const T* a_data, const std::vector<size_t>& a_offsets,
+                                      size_t M, size_t K, size_t lda);
+
+/**
+ * Packs a batch of transposed B that was not prepacked, each read at its offset with stride ldb.
+ * @returns The packed matrices, packed_b_size bytes apart, or nullptr if the GEMM of T doesn't pack B.
+ */
+template <typename T>
+IAllocatorUniquePtr<uint8_t> GemmPackTransposedB(const AllocatorPtr& alloc, const T* b_data,
+                                                 const std::vector<size_t>& b_offsets, size_t N, size_t K, size_t ldb,
+                                                 size_t& packed_b_size);
+
+/**
+ * Computes the rows of y, N values each, as alpha * acc + beta * C. acc holds the products as the GEMM accumulated them
+ * and may be y itself. C, nullptr for no bias, is broadcast to [rows, N].
+ */
+template <typename TAcc, typename T>
+void GemmScaleAndAddBias(const TAcc* acc, T* y, size_t rows, size_t N, float alpha, const Tensor* C, float beta,
+                         concurrency::ThreadPool* thread_pool);
+
 };  // namespace onnxruntime
@@ -7,14 +7,26 @@
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/common/safeint.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "core/framework/copy.h"
+#endif
 
 namespace onnxruntime {
 
+// A and B of the float kernel may be strided views, e.g. the output of a Transpose.
+static KernelDefBuilder& MayStridedInputsIfEnabled(KernelDefBuilder& builder) {
+#ifdef ENABLE_STRIDED_TENSORS
+  builder.MayStridedInput(0).MayStridedInput(1);
+#endif
+  return builder;
+}
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
     1, 8,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MayStridedInputsIfEnabled(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>())),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -30,7 +42,7 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     9,
     12,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MayStridedInputsIfEnabled(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>())),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -63,7 +75,7 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
     13,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MayStridedInputsIfEnabled(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>())),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
@@ -89,6 +101,36 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
         .TypeConstraint("T", BuildKernelDefConstraints<int64_t, uint64_t>()),
     MatMul<int64_t>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+// opset 13 added bfloat16
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    MatMul<BFloat16>);
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -157,6 +199,103 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+Status MatMul<float>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                                std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                int input_idx,
+                                                /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  // GemmPackBFp32 only packs 2D weights
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+namespace {
+
+#ifdef ENABLE_STRIDED_TENSORS
+// Returns true if GEMM can read the matrices in the two innermost dims of a strided tensor in place: row major with
+// leading dimension ld, or column major (trans) with leading dimension ld.
+bool GetStridedGemmLayout(const Tensor& tensor, size_t& ld, bool& trans) {
+  const auto& shape = tensor.Shape();
+  const size_t rank = shape.NumDimensions();
+  if (rank < 2) {
+    return false;
+  }
+
+  const auto strides = tensor.Strides();
+  const int64_t rows = shape[rank - 2];
+  const int64_t cols = shape[rank - 1];
+  const int64_t row_stride = strides[rank - 2];
+  const int64_t col_stride = strides[rank - 1];
+
+  // the stride of a dim of size 1 does not matter
+  if ((cols == 1 || col_stride == 1) && (rows == 1 || row_stride >= cols)) {
+    ld = static_cast<size_t>(rows == 1 ? cols : row_stride);
+    trans = false;
+    return true;
+  }
+  if ((rows == 1 || row_stride == 1) && (cols == 1 || col_stride >= rows)) {
+    ld = static_cast<size_t>(cols == 1 ? rows : col_stride);
+    trans = true;
+    return true;
+  }
+  return false;
+}
+
+IAllocatorUniquePtr<float> CopyToContiguous(const Tensor& tensor, AllocatorPtr alloc,
+                                            concurrency::ThreadPool* thread_pool) {
+  const auto& shape = tensor.Shape();
+  auto buffer = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(shape.Size()));
+
+  TensorShapeVector contiguous_strides(shape.NumDimensions());
+  int64_t running_size = 1;
+  for (size_t i = shape.NumDimensions(); i > 0; --i) {
+    contiguous_strides[i - 1] = running_size;
+    running_size *= shape[i - 1];
+  }
+
+  const auto strides = tensor.Strides();
+  StridedCopy<float>(thread_pool, buffer.get(), contiguous_strides, shape, tensor.Data<float>(),
+                     TensorShapeVector(strides.begin(), strides.end()));
+  return buffer;
+}
+#endif
+
+// Maps the offset of a matrix computed by MatMulComputeHelper, which assumes contiguous inputs, to the offset of the
+// matrix in the strided tensor read in place, if any.
+std::ptrdiff_t MatrixOffset(const Tensor* strided, size_t offset) {
+#ifdef ENABLE_STRIDED_TENSORS
+  if (strided != nullptr) {
+    const auto& shape = strided->Shape();
+    const auto strides = strided->Strides();
+    const size_t rank = shape.NumDimensions();
+    const size_t matrix_size = static_cast<size_t>(shape[rank - 2] * shape[rank - 1]);
+    if (matrix_size == 0) {
+      return 0;
+    }
+
+    size_t batch = offset / matrix_size;
+    std::ptrdiff_t strided_offset = 0;
+    for (size_t i = rank - 2; i > 0; --i) {
+      const size_t dim = static_cast<size_t>(shape[i - 1]);
+      strided_offset += static_cast<std::ptrdiff_t>(batch % dim) * static_cast<std::ptrdiff_t>(strides[i - 1]);
+      batch /= dim;
+    }
+    return strided_offset;
+  }
+#else
+  ORT_UNUSED_PARAMETER(strided);
+#endif
+  return static_cast<std::ptrdiff_t>(offset);
+}
+
+}  // namespace
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -184,25 +323,275 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t M = static_cast<size_t>(helper.M());
   const size_t N = static_cast<size_t>(helper.N());
   const size_t K = static_cast<size_t>(helper.K());
-  const size_t lda = helper.Lda(trans_a);
-  const size_t ldb = helper.Ldb(trans_b);
+  size_t lda = helper.Lda(trans_a);
+  size_t ldb = helper.Ldb(trans_b);
+  bool gemm_trans_a = trans_a;
+  bool gemm_trans_b = trans_b;
+
+  // the inputs whose matrices are read in place from a strided tensor
+  const Tensor* strided_a = nullptr;
+  const Tensor* strided_b = nullptr;
+#ifdef ENABLE_STRIDED_TENSORS
+  // A strided input is read in place when GEMM supports the layout of its matrices, and copied otherwise.
+  IAllocatorUniquePtr<float> contiguous_a;
+  IAllocatorUniquePtr<float> contiguous_b;
+  const bool a_strided = !a->IsContiguous() && a->Shape().Size() > 0;
+  const bool b_strided = b != nullptr && !b->IsContiguous() && b_shape.Size() > 0;
+  if (a_strided || b_strided) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+    const size_t a_rank = a->Shape().NumDimensions();
+    const bool gemm_in_place = !trans_a && !trans_b && !trans_batch_a_ && !trans_batch_b_ &&
+                               a_rank >= 2 && b_shape.NumDimensions() >= 2;
+    if (a_strided) {
+      // the helper folds the batch dims of A into M when B is a single matrix
+      const bool batch_folded = a_rank > 2 && static_cast<int64_t>(M) != a->Shape()[a_rank - 2];
+      if (gemm_in_place && !batch_folded && GetStridedGemmLayout(*a, lda, gemm_trans_a)) {
+        strided_a = a;
+      } else {
+        contiguous_a = CopyToContiguous(*a, alloc, thread_pool);
+        a_data = contiguous_a.get();
+      }
+    }
+    if (b_strided) {
+      if (gemm_in_place && GetStridedGemmLayout(*b, ldb, gemm_trans_b)) {
+        strided_b = b;
+      } else {
+        contiguous_b = CopyToContiguous(*b, alloc, thread_pool);
+        b_data = contiguous_b.get();
+      }
+    }
+  }
+#endif
 
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
   for (size_t i = 0; i < max_len; i++) {
     data[i].BIsPacked = bool(packed_b_);
-    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].A = a_data + MatrixOffset(strided_a, helper.LeftOffsets()[i]);
     data[i].lda = lda;
-    data[i].B = data[i].BIsPacked ? (float*)packed_b_.get() : b_data + helper.RightOffsets()[i];
+    data[i].B = data[i].BIsPacked ? (float*)packed_b_.get()
+                                  : b_data + MatrixOffset(strided_b, helper.RightOffsets()[i]);
     data[i].ldb = ldb;
     data[i].C = y_data + helper.OutputOffsets()[i];
     data[i].ldc = N;
     data[i].alpha = alpha_attr_;
     data[i].beta = 0.0f;
   }
-  MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
+  MlasGemmBatch(gemm_trans_a ? CblasTrans : CblasNoTrans, gemm_trans_b ? CblasTrans : CblasNoTrans,
                 M, N, K, data.data(), max_len, thread_pool);
 
   return Status::OK();
 }
 
+Status MatMul<MLFloat16>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
+                                  /*out*/ bool& is_packed,
+                                  /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = GemmPackBFp16(alloc, tensor, false, packed_b_, packed_b_size, b_shape_);
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
+Status MatMul<MLFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                    int input_idx,
+                                                    /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMul<MLFloat16>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                                    std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                    int input_idx,
+                                                    /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  // GemmPackBFp16 only packs 2D weights
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  const auto& b_shape = b ? b->Shape() : b_shape_;
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const auto* a_data = reinterpret_cast<const MLAS_FP16*>(a->Data<MLFloat16>());
+  const auto* b_data = b ? reinterpret_cast<const MLAS_FP16*>(b->Data<MLFloat16>()) : nullptr;
+  auto* y_data = reinterpret_cast<MLAS_FP16*>(y->MutableData<MLFloat16>());
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].BIsPacked = bool(packed_b_);
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = data[i].BIsPacked ? packed_b_.get() : static_cast<const void*>(b_data + helper.RightOffsets()[i]);
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+    data[i].Bias = nullptr;
+  }
+  MlasHalfGemmBatch(M, N, K, max_len, data.data(), thread_pool);
+
+  return Status::OK();
+}
+
+Status MatMul<BFloat16>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
+                                 /*out*/ bool& is_packed,
+                                 /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = GemmPackBBf16(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
+Status MatMul<BFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                   int input_idx,
+                                                   /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMul<BFloat16>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                   int input_idx,
+                                                   /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  // GemmPackBBf16 only packs 2D weights
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMul<BFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  const auto& b_shape = b ? b->Shape() : b_shape_;
+
+  // match CUDA kernel implementation, ignore transpose for vectors
+  const bool trans_a = trans_a_attr_ && a->Shape().NumDimensions() != 1;
+  const bool trans_b = trans_b_attr_ && b_shape.NumDimensions() != 1;
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape, trans_a, trans_b, trans_batch_a_, trans_batch_b_));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  const BFloat16* a_data = a->Data<BFloat16>();
+  const BFloat16* b_data = b ? b->Data<BFloat16>() : nullptr;
+  BFloat16* y_data = y->MutableData<BFloat16>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const size_t lda = helper.Lda(trans_a);
+  const size_t ldb = helper.Ldb(trans_b);
+
+  IAllocatorUniquePtr<BFloat16> a_transposed;
+  if (trans_a) {
+    a_transposed = GemmTransposeA(alloc, a_data, helper.LeftOffsets(), M, K, lda);
+  }
+
+  size_t packed_b_size = 0;
+  IAllocatorUniquePtr<uint8_t> b_packed;
+  if (b != nullptr && trans_b) {
+    b_packed = GemmPackTransposedB(alloc, b_data, helper.RightOffsets(), N, K, ldb, packed_b_size);
+  }
+
+  // The products are accumulated in single precision and rounded once when scaled by alpha.
+  auto c_buffer = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(y->Shape().Size()));
+
+  std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    if (a_transposed) {
+      data[i].A = reinterpret_cast<const MLAS_BF16*>(a_transposed.get() + i * M * K);
+      data[i].lda = K;
+    } else {
+      data[i].A = reinterpret_cast<const MLAS_BF16*>(a_data + helper.LeftOffsets()[i]);
+      data[i].lda = lda;
+    }
+    if (packed_b_) {
+      data[i].B = packed_b_.get();
+      data[i].BIsPacked = true;
+    } else if (trans_b) {
+      data[i].B = b_packed.get() + i * packed_b_size;
+      data[i].BIsPacked = true;
+    } else {
+      data[i].B = b_data + helper.RightOffsets()[i];
+      data[i].ldb = ldb;
+    }
+    data[i].C = c_buffer.get() + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  MlasSBGemmBatch(M, N, K, max_len, data.data(), thread_pool);
+
+  GemmScaleAndAddBias(c_buffer.get(), y_data, max_len * M, N, alpha_attr_, nullptr, 0.0f, thread_pool);
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -21,10 +21,12 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include <queue>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 using namespace std;
 namespace onnxruntime {
@@ -32,6 +34,8 @@ namespace onnxruntime {
 template <typename T>
 struct GreaterValueCmp {
   using DataType = T;
+  static constexpr bool kSelectLargest = true;
+
   GreaterValueCmp(const T* data = nullptr) : data_(data) {
   }
 
@@ -53,6 +57,7 @@ struct GreaterValueCmp {
 template <typename T>
 struct LesserValueCmp {
   using DataType = T;
+  static constexpr bool kSelectLargest = false;
 
   LesserValueCmp(const T* data = nullptr) : data_(data) {
   }
@@ -140,6 +145,167 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Radix selection for long contiguous rows, e.g. the logits of a large vocabulary.
+//
+// Values are mapped to unsigned keys that have the same order as the values. A histogram of the top
+// kRadixSelectBits bits of the keys finds the bucket holding the k-th best value: the values in the better buckets
+// are selected, and only the values in that bucket go through nth_element. A row is split in chunks that have their
+// own histogram, so a single long row can be selected by all the threads of the pool.
+constexpr int kRadixSelectBits = 11;
+constexpr int64_t kRadixSelectBuckets = int64_t{1} << kRadixSelectBits;
+constexpr int64_t kRadixSelectMinRowSize = 16384;
+constexpr int64_t kRadixSelectChunkSize = 16384;
+
+template <typename T>
+struct RadixSelectKey;
+
+template <>
+struct RadixSelectKey<float> {
+  using Type = uint32_t;
+  static Type Get(float value) {
+    // -0 and +0 compare equal, so they need the same key. Adding +0 turns -0 into +0.
+    value += 0.0f;
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    // flip all the bits of negative values and the sign bit of positive values, without a branch.
+    return bits ^ (static_cast<uint32_t>(-static_cast<int32_t>(bits >> 31)) | 0x80000000u);
+  }
+};
+
+template <>
+struct RadixSelectKey<double> {
+  using Type = uint64_t;
+  static Type Get(double value) {
+    value += 0.0;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits ^ (static_cast<uint64_t>(-static_cast<int64_t>(bits >> 63)) | 0x8000000000000000ull);
+  }
+};
+
+template <>
+struct RadixSelectKey<int32_t> {
+  using Type = uint32_t;
+  static Type Get(int32_t value) { return static_cast<uint32_t>(value) ^ 0x80000000u; }
+};
+
+template <>
+struct RadixSelectKey<int64_t> {
+  using Type = uint64_t;
+  static Type Get(int64_t value) { return static_cast<uint64_t>(value) ^ 0x8000000000000000ull; }
+};
+
+// Returns the histogram bucket of a value. Better values are in higher buckets.
+template <class Comparator>
+static inline size_t RadixSelectBucket(typename Comparator::DataType value) {
+  using Key = RadixSelectKey<typename Comparator::DataType>;
+  constexpr int shift = static_cast<int>(sizeof(typename Key::Type) * 8) - kRadixSelectBits;
+  auto key = Key::Get(value);
+  if (!Comparator::kSelectLargest) {
+    key = ~key;
+  }
+  return static_cast<size_t>(key >> shift);
+}
+
+// Scratch buffers of RadixSelectTopK, reused across rows.
+struct RadixSelectBuffers {
+  std::vector<uint32_t> histograms;
+  std::vector<int64_t> selected;
+  std::vector<int64_t> candidates;
+  std::vector<int64_t> selected_offsets;
+  std::vector<int64_t> candidate_offsets;
+};
+
+// Selects the top k elements of the contiguous row starting at row_offset, using num_chunks tasks of the thread pool.
+template <class Comparator>
+static void RadixSelectTopK(const Comparator& comparer, const typename Comparator::DataType* input_data,
+                            int64_t row_offset, int64_t num_blocks, const unsigned k, bool sorted,
+                            int64_t num_chunks, concurrency::ThreadPool* threadpool, RadixSelectBuffers& buffers,
+                            typename Comparator::DataType* values, int64_t* indices) {
+  const int64_t chunk_size = (num_blocks + num_chunks - 1) / num_chunks;
+  auto run_chunks = [num_chunks, threadpool](const std::function<void(std::ptrdiff_t)>& fn) {
+    if (num_chunks == 1) {
+      fn(0);
+    } else {
+      concurrency::ThreadPool::TrySimpleParallelFor(threadpool, num_chunks, fn);
+    }
+  };
+
+  // Histogram of each chunk.
+  buffers.histograms.assign(static_cast<size_t>(num_chunks * kRadixSelectBuckets), 0);
+  run_chunks([&](std::ptrdiff_t chunk) {
+    const auto* data = input_data + row_offset;
+    uint32_t* histogram = buffers.histograms.data() + chunk * kRadixSelectBuckets;
+    const int64_t end = std::min(num_blocks, (chunk + 1) * chunk_size);
+    for (int64_t l = chunk * chunk_size; l < end; ++l) {
+      ++histogram[RadixSelectBucket<Comparator>(data[l])];
+    }
+  });
+
+  // Find the bucket holding the k-th best value, starting from the best bucket.
+  int64_t threshold = kRadixSelectBuckets - 1;
+  int64_t num_selected = 0;
+  int64_t num_candidates = 0;
+  for (; threshold >= 0; --threshold) {
+    num_candidates = 0;
+    for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+      num_candidates += buffers.histograms[chunk * kRadixSelectBuckets + threshold];
+    }
+    if (num_selected + num_candidates >= k) {
+      break;
+    }
+    num_selected += num_candidates;
+  }
+
+  // Where each chunk writes its selected values and candidates, so the gather needs no synchronization.
+  buffers.selected_offsets.resize(static_cast<size_t>(num_chunks));
+  buffers.candidate_offsets.resize(static_cast<size_t>(num_chunks));
+  for (int64_t chunk = 0, selected_offset = 0, candidate_offset = 0; chunk < num_chunks; ++chunk) {
+    const uint32_t* histogram = buffers.histograms.data() + chunk * kRadixSelectBuckets;
+    buffers.selected_offsets[chunk] = selected_offset;
+    buffers.candidate_offsets[chunk] = candidate_offset;
+    for (int64_t bucket = threshold + 1; bucket < kRadixSelectBuckets; ++bucket) {
+      selected_offset += histogram[bucket];
+    }
+    candidate_offset += histogram[threshold];
+  }
+
+  buffers.selected.resize(k);
+  buffers.candidates.resize(static_cast<size_t>(num_candidates));
+  run_chunks([&](std::ptrdiff_t chunk) {
+    const size_t threshold_bucket = static_cast<size_t>(threshold);
+    int64_t* selected = buffers.selected.data() + buffers.selected_offsets[chunk];
+    int64_t* candidates = buffers.candidates.data() + buffers.candidate_offsets[chunk];
+    const int64_t end = row_offset + std::min(num_blocks, (chunk + 1) * chunk_size);
+    for (int64_t idx = row_offset + chunk * chunk_size; idx < end; ++idx) {
+      const size_t bucket = RadixSelectBucket<Comparator>(input_data[idx]);
+      if (bucket > threshold_bucket) {
+        *selected++ = idx;
+      } else if (bucket == threshold_bucket) {
+        *candidates++ = idx;
+      }
+    }
+  });
+
+  // The comparer breaks ties by index, so the result is the same as selecting from the whole row.
+  const int64_t remaining = static_cast<int64_t>(k) - num_selected;
+  if (remaining < num_candidates) {
+    nth_element(buffers.candidates.begin(), buffers.candidates.begin() + (remaining - 1), buffers.candidates.end(),
+                comparer);
+  }
+  std::copy_n(buffers.candidates.begin(), remaining, buffers.selected.begin() + num_selected);
+
+  if (sorted) {
+    std::sort(buffers.selected.begin(), buffers.selected.end(), comparer);
+  }
+
+  for (unsigned l = 0; l < k; ++l) {
+    const int64_t idx = buffers.selected[l];
+    values[l] = input_data[idx];
+    indices[l] = idx - row_offset;
+  }
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -179,9 +345,35 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   //            k = [ 1, 2, 4, 6, 8, 16, 24, 32, 48, 64, 128 ]
   bool use_priority_queue = k != 1 && (k < 4 || (std::log2(k) / std::log2(num_blocks)) < 0.725);
 
+  // long contiguous rows use the radix select, which also splits each row across the threads when there are fewer
+  // rows than threads. the heap is faster for a small k if every thread has rows of its own.
+  bool use_radix_select = k != 1 && block_slice == 1 && num_blocks >= kRadixSelectMinRowSize &&
+                          (!use_priority_queue || rows < tp_threads);
+
   std::function<void(std::ptrdiff_t batch)> find_top_k;
 
-  if (k == 1) {
+  if (use_radix_select) {
+    int64_t chunks_per_row = 1;
+    if (rows < tp_threads) {
+      chunks_per_row = std::max(std::min(tp_threads, num_blocks / kRadixSelectChunkSize), static_cast<int64_t>(1));
+      // the chunks of a row are the parallel tasks, so the rows are processed one after another.
+      num_threads = 1;
+    }
+
+    find_top_k =
+        [num_threads, rows, num_blocks, k, sorted, input_data, cols, chunks_per_row, threadpool,
+         &values_map, &indices_map](std::ptrdiff_t batch) {
+          auto work = concurrency::ThreadPool::PartitionWork(batch, num_threads, rows);
+          Comparator comparer(input_data);
+          RadixSelectBuffers buffers;
+
+          for (auto i = work.start; i < work.end; ++i) {
+            RadixSelectTopK<Comparator>(comparer, input_data, i * cols, num_blocks, k, sorted, chunks_per_row,
+                                        chunks_per_row > 1 ? threadpool : nullptr, buffers,
+                                        &values_map(i, 0), &indices_map(i, 0));
+          }
+        };
+  } else if (k == 1) {
     // just need to compare values and not indexes as the first instance of the best value is always selected
     find_top_k =
         [num_threads, rows, block_slice, num_blocks, input_data, cols,
@@ -420,6 +612,85 @@ template Status GetTopK<float>(const Tensor* input, const int axis, const unsign
                                std::unique_ptr<Tensor>& output_values,
                                std::unique_ptr<Tensor>& output_indices);
 
+template <typename T>
+Status GetTopKSoftmax(const Tensor* input, const unsigned k, bool log_softmax,
+                      AllocatorPtr allocator,
+                      onnxruntime::concurrency::ThreadPool* threadpool,
+                      std::unique_ptr<Tensor>& output_values,
+                      std::unique_ptr<Tensor>& output_indices) {
+  ORT_RETURN_IF_ERROR(GetTopK<T>(input, -1, k, true, true, allocator, threadpool, output_values, output_indices));
+  if (k == 0) {
+    return Status::OK();
+  }
+
+  const TensorShape& input_shape = input->Shape();
+  const int64_t cols = input_shape[input_shape.NumDimensions() - 1];
+  const int64_t rows = input_shape.Size() / cols;
+  const T* input_data = input->Data<T>();
+  T* values_data = output_values->MutableData<T>();
+
+  // The top value of a sorted selection is the maximum of the row, so a single pass over the row computes the sum
+  // of the exponentials. It runs in blocks for MlasComputeExp, and a long row is split in chunks over the threads.
+  constexpr int64_t block_size = 256;
+  const int64_t chunks_per_row = std::max((cols + kRadixSelectChunkSize - 1) / kRadixSelectChunkSize,
+                                          static_cast<int64_t>(1));
+  std::vector<float> partial_sums(static_cast<size_t>(rows * chunks_per_row));
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(rows * chunks_per_row),
+      TensorOpCost{static_cast<double>(kRadixSelectChunkSize) * sizeof(float), 0,
+                   static_cast<double>(kRadixSelectChunkSize) * 8},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        float buffer[block_size];
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const int64_t row = task / chunks_per_row;
+          const int64_t begin = (task % chunks_per_row) * kRadixSelectChunkSize;
+          const int64_t end = std::min(cols, begin + kRadixSelectChunkSize);
+          const T* x = input_data + row * cols;
+          const float row_max = static_cast<float>(values_data[row * k]);
+          float sum = 0.0f;
+          for (int64_t b = begin; b < end; b += block_size) {
+            const int64_t n = std::min(block_size, end - b);
+            for (int64_t j = 0; j < n; ++j) {
+              buffer[j] = static_cast<float>(x[b + j]) - row_max;
+            }
+            MlasComputeExp(buffer, buffer, static_cast<size_t>(n));
+            for (int64_t j = 0; j < n; ++j) {
+              sum += buffer[j];
+            }
+          }
+          partial_sums[task] = sum;
+        }
+      });
+
+  for (int64_t row = 0; row < rows; ++row) {
+    float sum = 0.0f;
+    for (int64_t chunk = 0; chunk < chunks_per_row; ++chunk) {
+      sum += partial_sums[row * chunks_per_row + chunk];
+    }
+
+    T* values = values_data + row * k;
+    const T row_max = values[0];
+    if (log_softmax) {
+      const float log_sum = std::log(sum);
+      for (unsigned l = 0; l < k; ++l) {
+        values[l] = values[l] - row_max - static_cast<T>(log_sum);
+      }
+    } else {
+      for (unsigned l = 0; l < k; ++l) {
+        values[l] = static_cast<T>(std::exp(values[l] - row_max) / sum);
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+template Status GetTopKSoftmax<float>(const Tensor* input, const unsigned k, bool log_softmax,
+                                      AllocatorPtr allocator,
+                                      onnxruntime::concurrency::ThreadPool* threadpool,
+                                      std::unique_ptr<Tensor>& output_values,
+                                      std::unique_ptr<Tensor>& output_indices);
+
 // Opset ver - 1 to 9
 
 static void TopkOpset9ConstructorCommon(const OpKernelInfo& op_kernel_info, int& axis, unsigned int& k) {
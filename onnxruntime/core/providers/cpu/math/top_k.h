@@ -26,4 +26,13 @@ Status GetTopK(const Tensor* input, const int axis, const unsigned k, bool large
                onnxruntime::concurrency::ThreadPool* threadpool,
                std::unique_ptr<Tensor>& output_values,
                std::unique_ptr<Tensor>& output_indices);
+
+// Selects the k largest values along the last axis of input, and returns their Softmax (or LogSoftmax when
+// log_softmax is true) over the whole axis in sorted order, without computing the softmax of the other values.
+template <typename T>
+Status GetTopKSoftmax(const Tensor* input, const unsigned k, bool log_softmax,
+                      AllocatorPtr allocator,
+                      onnxruntime::concurrency::ThreadPool* threadpool,
+                      std::unique_ptr<Tensor>& output_values,
+                      std::unique_ptr<Tensor>& output_indices);
 }  // namespace onnxruntime
\ No newline at end of file
@@ -59,13 +59,18 @@ void LinearClassifier::ComputeImpl(const gsl::span<const float> input,
               "Scores output is incorrect size. Expected:", scores_output_size,
               " Found:", scores_output_data.length());
 
-  TensorShape intercepts_shape({num_targets});
-  onnxruntime::Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                                        num_batches, num_targets, num_features,
-                                        1.f, input_data, coefficients.data(), 1.f,
-                                        intercepts.data(), &intercepts_shape,
-                                        scores_output_data.data(),
-                                        threadpool);
+  // one-hot or bag-of-words features are mostly zeros, so skip the GEMM when only a few features are set
+  if (!ml::TryComputeSparseLinear(input_data, num_batches, num_features, num_targets,
+                                  coefficients.data(), intercepts.data(), scores_output_data.data(),
+                                  threadpool)) {
+    TensorShape intercepts_shape({num_targets});
+    onnxruntime::Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                          num_batches, num_targets, num_features,
+                                          1.f, input_data, coefficients.data(), 1.f,
+                                          intercepts.data(), &intercepts_shape,
+                                          scores_output_data.data(),
+                                          threadpool);
+  }
 
   float* score = scores_output_data.data();
   float* end_scores = score + (num_batches * num_targets);  // we haven't added extra targets yet so iterate the original scores
@@ -43,21 +43,26 @@ static Status ComputeImpl(const Tensor& input, int64_t num_batches, int64_t num_
   const T* input_data = input.Data<T>();
   T* output_data = output.MutableData<T>();
 
-  if (intercepts != nullptr) {
-    TensorShape intercepts_shape({num_targets});
-    onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                                      num_batches, num_targets, num_features,
-                                      1.f, input_data, coefficients.data(), 1.f,
-                                      intercepts->data(), &intercepts_shape,
-                                      output_data,
-                                      threadpool);
-  } else {
-    onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                                      num_batches, num_targets, num_features,
-                                      1.f, input_data, coefficients.data(), 1.f,
-                                      nullptr, nullptr,
-                                      output_data,
-                                      threadpool);
+  // one-hot or bag-of-words features are mostly zeros, so skip the GEMM when only a few features are set
+  if (!ml::TryComputeSparseLinear(input_data, num_batches, num_features, num_targets, coefficients.data(),
+                                  intercepts != nullptr ? intercepts->data() : nullptr, output_data,
+                                  threadpool)) {
+    if (intercepts != nullptr) {
+      TensorShape intercepts_shape({num_targets});
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        num_batches, num_targets, num_features,
+                                        1.f, input_data, coefficients.data(), 1.f,
+                                        intercepts->data(), &intercepts_shape,
+                                        output_data,
+                                        threadpool);
+    } else {
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        num_batches, num_targets, num_features,
+                                        1.f, input_data, coefficients.data(), 1.f,
+                                        nullptr, nullptr,
+                                        output_data,
+                                        threadpool);
+    }
   }
 
   if (post_transform != POST_EVAL_TRANSFORM::NONE) {
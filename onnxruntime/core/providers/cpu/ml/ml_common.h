@@ -383,6 +383,81 @@ static void write_scores(InlinedVector<T>& scores, POST_EVAL_TRANSFORM post_tran
   write_scores(scores, post_transform, out_p, add_second_class);
 }
 
+// Maps each element of input to its value in map, or to default_value if it is not a key of map.
+// Large inputs are split across the thread pool.
+template <typename TMap, typename TKey, typename TValue>
+void MapWithDefault(const TMap& map, gsl::span<const TKey> input, gsl::span<TValue> output,
+                    const TValue& default_value, concurrency::ThreadPool* tp) {
+  // a lookup hashes the key, probes the table and compares the key with the matching entry
+  const TensorOpCost cost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)), 64.0};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(input.size()), cost,
+      [&map, &input, &output, &default_value](std::ptrdiff_t first, std::ptrdiff_t last) {
+        const auto map_end = map.end();
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const auto found = map.find(input[i]);
+          output[i] = found == map_end ? default_value : found->second;
+        }
+      });
+}
+
+// Inputs produced by featurizers such as OneHotEncoder, DictVectorizer or TfIdfVectorizer are mostly zeros.
+// When at most one in kSparseLinearInputDensity elements is non-zero, the linear scores are computed
+// from the non-zero elements only instead of running a dense GEMM.
+static constexpr int64_t kSparseLinearInputDensity = 32;
+
+// Computes output = input * coefficients^T + intercepts, where input is [num_batches, num_features],
+// coefficients is [num_targets, num_features] and intercepts is an optional [num_targets],
+// from the non-zero elements of input. Returns false without writing to output if input is not sparse enough.
+template <typename T>
+bool TryComputeSparseLinear(const T* input, int64_t num_batches, int64_t num_features, int64_t num_targets,
+                            const float* coefficients, const float* intercepts, T* output,
+                            concurrency::ThreadPool* threadpool) {
+  if (num_batches <= 0) {
+    return false;
+  }
+
+  const int64_t num_elements = num_batches * num_features;
+  const int64_t max_non_zeros = num_elements / kSparseLinearInputDensity;
+  int64_t non_zeros = 0;
+  for (int64_t i = 0; i < num_elements; ++i) {
+    if (input[i] != T{} && ++non_zeros > max_non_zeros) {
+      return false;
+    }
+  }
+
+  // cost per row assuming non-zeros are evenly spread
+  const double non_zeros_per_row = static_cast<double>(non_zeros) / num_batches + 1;
+  const TensorOpCost cost{static_cast<double>(num_features * sizeof(T)),
+                          static_cast<double>(num_targets * sizeof(T)),
+                          static_cast<double>(num_features) + non_zeros_per_row * num_targets * 2};
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(num_batches), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        InlinedVector<int64_t> row_non_zeros;
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          const T* row = input + b * num_features;
+          row_non_zeros.clear();
+          for (int64_t k = 0; k < num_features; ++k) {
+            if (row[k] != T{}) {
+              row_non_zeros.push_back(k);
+            }
+          }
+
+          T* row_output = output + b * num_targets;
+          for (int64_t t = 0; t < num_targets; ++t) {
+            const float* target_coefficients = coefficients + t * num_features;
+            T score = intercepts != nullptr ? static_cast<T>(intercepts[t]) : T{};
+            for (int64_t k : row_non_zeros) {
+              score += row[k] * static_cast<T>(target_coefficients[k]);
+            }
+            row_output[t] = score;
+          }
+        }
+      });
+  return true;
+}
+
 // TODO: Update TreeEnsemble* ops to use this instead of write_scores if possible.
 //       Attempted to parallelize the calculations if the number of scores to process was large, but no clear benefit
 //       was seen from testing with the arbitrary values of 1000 scores per threads.
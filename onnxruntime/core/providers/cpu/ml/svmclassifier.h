@@ -15,6 +15,9 @@ namespace ml {
 // code shared by SVMClassifier and SVMRegressor
 class SVMCommon {
  protected:
+  // batch size from which the RBF kernel is evaluated through a GEMM
+  static constexpr int64_t kRbfGemmMinBatches = 16;
+
   SVMCommon(const OpKernelInfo& info)
       : kernel_type_(MakeKernel(info.GetAttrOrDefault<std::string>("kernel_type", "LINEAR"))) {
     std::vector<float> kernel_params;
@@ -38,7 +41,43 @@ class SVMCommon {
                           concurrency::ThreadPool* threadpool) const {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
-    if (kernel_type_ == KERNEL::RBF) {
+    if (kernel_type_ == KERNEL::RBF && m >= kRbfGemmMinBatches) {
+      // ||a - b||^2 = ||a||^2 + ||b||^2 - 2 * a.b, so the distances of all the batches to all the
+      // support vectors come from a single GEMM. Smaller batches don't amortize computing the norms.
+      // a and b are centered on the mean support vector first, which keeps the norms small and limits
+      // the cancellation in the sum for points that are close to each other.
+      const ConstEigenMatrixMapRowMajor<T> a_matrix(a.data(), m, k);
+      const ConstEigenMatrixMapRowMajor<T> b_matrix(b.data(), n, k);
+      const Eigen::Matrix<T, 1, Eigen::Dynamic> center = b_matrix.colwise().mean();
+      const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> a_centered = a_matrix.rowwise() - center;
+      const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> b_centered = b_matrix.rowwise() - center;
+
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        -2.f, a_centered.data(), b_centered.data(), 0.f,
+                                        nullptr, nullptr,
+                                        out.data(),
+                                        threadpool);
+
+      const Eigen::Matrix<T, Eigen::Dynamic, 1> a_norms = a_centered.rowwise().squaredNorm();
+      const Eigen::Matrix<T, Eigen::Dynamic, 1> b_norms = b_centered.rowwise().squaredNorm();
+      const T neg_gamma = -gamma_;
+
+      concurrency::ThreadPool::TryParallelFor(
+          threadpool, static_cast<std::ptrdiff_t>(m),
+          TensorOpCost{static_cast<double>(n * sizeof(T)), static_cast<double>(n * sizeof(T)), static_cast<double>(n) * 24},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t batch = first; batch < last; ++batch) {
+              T* cur_out = out.data() + batch * n;
+              for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
+                // rounding can make the distance of nearby points slightly negative
+                T sum = std::max(cur_out[support_vector] + a_norms[batch] + b_norms[support_vector], T{0});
+                cur_out[support_vector] = neg_gamma * sum;
+              }
+              MlasComputeExp(cur_out, cur_out, static_cast<size_t>(n));
+            }
+          });
+    } else if (kernel_type_ == KERNEL::RBF) {
       T* cur_out = out.data();
       const T* cur_batch = a.data();
 
@@ -83,6 +83,26 @@ struct TreeNodeElement {
   bool is_missing_track_true;
 };
 
+// A node of the compiled layout of the trees (see TreeEnsembleCommon::CompileTrees). The nodes of a tree are
+// stored breadth-first in one contiguous array, so a traversal reads one small record per level.
+// A child is the index of a node in the array, or ~i where i is the index of a leaf. The leaves are stored
+// apart from the nodes, since they are only read once a traversal ends.
+template <typename T>
+struct TreeNodeFlat {
+  T value;
+  int32_t feature_id;
+  int32_t children[2];  // the child when the condition is true, then the child when it is false
+};
+
+// Node of the quantized layout (12 bytes). The thresholds of each feature are replaced by their rank among the
+// distinct thresholds of the feature, and the inputs are replaced by bins, so the condition of every node is
+// bin <= the bin of the node (see TreeEnsembleCommon::CompileQuantizedTrees).
+struct TreeNodeQuantized {
+  uint16_t feature_id;
+  uint16_t bin;
+  int32_t children[2];  // same as TreeNodeFlat::children
+};
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 class TreeAggregator {
  protected:
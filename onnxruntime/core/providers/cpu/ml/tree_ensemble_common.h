@@ -3,9 +3,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 #include "tree_ensemble_aggregator.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "tree_ensemble_helper.h"
 
 namespace onnxruntime {
@@ -42,6 +52,32 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   std::vector<TreeNodeElement<ThresholdType>> nodes_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
 
+  // Compiled layout of the trees, used when all nodes have the same mode (see CompileTrees).
+  NODE_MODE flat_mode_;
+  std::vector<TreeNodeFlat<ThresholdType>> flat_nodes_;
+  std::vector<unsigned char> flat_missing_tracks_true_;
+  std::vector<int32_t> flat_roots_;
+  std::vector<const TreeNodeElement<ThresholdType>*> flat_leaves_;  // leaves of each tree from left to right
+  std::vector<size_t> flat_leaf_offsets_;                            // first leaf of each tree in flat_leaves_
+
+  // QuickScorer layout, used for shallow trees with BRANCH_LEQ or BRANCH_LT nodes (see CompileQuickScorer).
+  // For each feature, the nodes testing the feature are sorted by threshold, so the nodes whose condition is
+  // false for a value are a prefix of them. The mask of a node clears the bits of the leaves in its true branch.
+  bool use_quick_scorer_;
+  std::vector<size_t> qs_feature_offsets_;  // nodes of feature f: [qs_feature_offsets_[f], qs_feature_offsets_[f + 1])
+  std::vector<ThresholdType> qs_thresholds_;
+  std::vector<int32_t> qs_trees_;
+  std::vector<uint64_t> qs_masks_;
+
+  // Quantized layout, which replaces flat_nodes_ for large trees (see CompileQuantizedTrees). The distinct
+  // thresholds of feature f are q_thresholds_[q_threshold_offsets_[f], q_threshold_offsets_[f + 1]) in ascending
+  // order, and q_nodes_[i] is flat_nodes_[i] with its threshold replaced by a bin.
+  std::string quantize_mode_;  // value of kOrtSessionOptionsConfigTreeEnsembleQuantizeThresholds
+  bool use_quantized_;
+  std::vector<TreeNodeQuantized> q_nodes_;
+  std::vector<ThresholdType> q_thresholds_;
+  std::vector<size_t> q_threshold_offsets_;
+
  public:
   TreeEnsembleCommon() {}
 
@@ -73,11 +109,51 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
               const std::vector<ThresholdType>& target_class_weights_as_tensor);
 
  protected:
-  TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
-                                                       const InputType* x_data) const;
+  void CompileTrees();
+  void CompileQuickScorer(const std::vector<size_t>& node_offsets);
+  void CompileQuantizedTrees();
+
+  // Bin of a missing value: above the bins of all nodes, so a missing value takes the false branch unless the
+  // node tracks missing values as true.
+  static constexpr uint16_t kMissingBin = std::numeric_limits<uint16_t>::max();
+
+  // Writes the bins of the features of n_rows rows, q_threshold_offsets_.size() - 1 bins per row.
+  void BinFeatures(const InputType* x_data, int64_t stride, int64_t n_rows, uint16_t* bins) const;
+
+  const TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(size_t tree, const InputType* x_data) const;
+  const TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(size_t tree, const uint16_t* bins) const;
+
+  // Calls process_leaf with the leaf of each tree in order. bitvectors is a scratch buffer for QuickScorer.
+  template <typename FCT>
+  void ProcessTreeNodeLeaves(const InputType* x_data, std::vector<uint64_t>& bitvectors, FCT&& process_leaf) const;
+  template <typename FCT>
+  void ProcessTreeNodeLeaves(const uint16_t* bins, std::vector<uint64_t>& bitvectors, FCT&& process_leaf) const;
+
+  // Number of rows that traverse a tree together.
+  static constexpr int64_t kRowBlock = 8;
+
+  // Finds the leaves of one tree for n_rows <= kRowBlock rows. The rows walk the tree in lockstep, so the
+  // loads of the nodes and features of different rows are independent and overlap.
+  void ProcessTreeNodeLeaveBlock(size_t tree, const InputType* x_data, int64_t stride, int64_t n_rows,
+                                 const TreeNodeElement<ThresholdType>** leaves) const;
+  void ProcessTreeNodeLeaveBlock(size_t tree, const uint16_t* bins, int64_t stride, int64_t n_rows,
+                                 const TreeNodeElement<ThresholdType>** leaves) const;
+
+  // Calls process_leaf(r, leaf) with the leaf of each tree in order for each row r of n_rows <= kRowBlock rows.
+  template <typename FCT>
+  void ProcessTreeNodeLeavesBlock(const InputType* x_data, int64_t stride, int64_t n_rows,
+                                  std::vector<uint64_t>& bitvectors, FCT&& process_leaf) const;
+  template <typename FCT>
+  void ProcessTreeNodeLeavesBlock(const uint16_t* bins, int64_t stride, int64_t n_rows,
+                                  std::vector<uint64_t>& bitvectors, FCT&& process_leaf) const;
 
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
+
+  // Computes N rows of features, which are the inputs or their bins with the quantized layout.
+  template <typename AGG, typename FeatureType>
+  void ComputeAggRows(concurrency::ThreadPool* ttp, const FeatureType* x_data, int64_t stride, int64_t N,
+                      OutputType* z_data, int64_t* label_data, const AGG& agg) const;
 };
 
 template <typename InputType, typename ThresholdType, typename OutputType>
@@ -90,6 +166,8 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(const OpKe
   ORT_THROW_IF_ERROR(GetVectorAttrsOrDefault(info, "nodes_values_as_tensor", nodes_values_as_tensor));
   ORT_THROW_IF_ERROR(GetVectorAttrsOrDefault(info, "target_weights_as_tensor", target_weights_as_tensor));
 #endif
+  quantize_mode_ =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigTreeEnsembleQuantizeThresholds, "");
 
   return Init(
       80,
@@ -297,9 +375,181 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(int parall
       break;
     }
   }
+
+  CompileTrees();
   return Status::OK();
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::CompileTrees() {
+  flat_nodes_.clear();
+  flat_missing_tracks_true_.clear();
+  flat_roots_.clear();
+  flat_leaves_.clear();
+  flat_leaf_offsets_.clear();
+  use_quick_scorer_ = false;
+  use_quantized_ = false;
+
+  // Trees with different modes are evaluated on nodes_.
+  if (!same_mode_) {
+    return;
+  }
+
+  flat_mode_ = NODE_MODE::LEAF;
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf) {
+      flat_mode_ = node.mode;
+      break;
+    }
+  }
+
+  flat_nodes_.reserve(nodes_.size());
+  flat_roots_.reserve(roots_.size());
+  flat_leaf_offsets_.reserve(roots_.size() + 1);
+  std::vector<size_t> node_offsets;  // first node of each tree in flat_nodes_
+  node_offsets.reserve(roots_.size() + 1);
+  bool is_tree = true;  // no node is reached twice, so the leaves of a branch are consecutive
+  std::unordered_map<const TreeNodeElement<ThresholdType>*, int32_t> leaf_ids;
+  std::unordered_map<const TreeNodeElement<ThresholdType>*, int32_t> node_ids;
+  std::unordered_set<const TreeNodeElement<ThresholdType>*> visited;
+  std::vector<const TreeNodeElement<ThresholdType>*> stack;
+  std::vector<const TreeNodeElement<ThresholdType>*> queue;
+
+  for (const TreeNodeElement<ThresholdType>* root : roots_) {
+    flat_leaf_offsets_.push_back(flat_leaves_.size());
+    node_offsets.push_back(flat_nodes_.size());
+
+    // Numbers the leaves from left to right (true branch first) with a depth-first walk.
+    stack.assign(1, root);
+    while (!stack.empty()) {
+      const TreeNodeElement<ThresholdType>* node = stack.back();
+      stack.pop_back();
+      if (node->is_not_leaf) {
+        ORT_ENFORCE(node->truenode != nullptr && node->falsenode != nullptr,
+                    "Node ", node->id.node_id, " in tree ", node->id.tree_id, " has no child.");
+        if (visited.insert(node).second) {
+          stack.push_back(node->falsenode);
+          stack.push_back(node->truenode);
+        } else {
+          is_tree = false;
+        }
+      } else if (leaf_ids.emplace(node, static_cast<int32_t>(flat_leaves_.size())).second) {
+        flat_leaves_.push_back(node);
+      } else {
+        is_tree = false;
+      }
+    }
+
+    if (!root->is_not_leaf) {
+      flat_roots_.push_back(~leaf_ids[root]);
+      continue;
+    }
+
+    // Stores the nodes breadth-first. A node reached twice is stored once.
+    const int32_t first = static_cast<int32_t>(flat_nodes_.size());
+    flat_roots_.push_back(first);
+    node_ids[root] = first;
+    queue.assign(1, root);
+    for (size_t q = 0; q < queue.size(); ++q) {
+      const TreeNodeElement<ThresholdType>* node = queue[q];
+      TreeNodeFlat<ThresholdType> flat;
+      flat.value = node->value;
+      flat.feature_id = node->feature_id;
+      for (int c = 0; c < 2; ++c) {
+        const TreeNodeElement<ThresholdType>* child = c == 0 ? node->truenode : node->falsenode;
+        if (!child->is_not_leaf) {
+          flat.children[c] = ~leaf_ids[child];
+          continue;
+        }
+        auto inserted = node_ids.emplace(child, first + static_cast<int32_t>(queue.size()));
+        if (inserted.second) {
+          queue.push_back(child);
+        }
+        flat.children[c] = inserted.first->second;
+      }
+      flat_nodes_.push_back(flat);
+      flat_missing_tracks_true_.push_back(node->is_missing_track_true ? 1 : 0);
+    }
+    node_ids.clear();
+  }
+  flat_leaf_offsets_.push_back(flat_leaves_.size());
+  node_offsets.push_back(flat_nodes_.size());
+
+  if (is_tree) {
+    CompileQuickScorer(node_offsets);
+  }
+  CompileQuantizedTrees();
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::CompileQuickScorer(
+    const std::vector<size_t>& node_offsets) {
+  qs_feature_offsets_.clear();
+  qs_thresholds_.clear();
+  qs_trees_.clear();
+  qs_masks_.clear();
+
+  if ((flat_mode_ != NODE_MODE::BRANCH_LEQ && flat_mode_ != NODE_MODE::BRANCH_LT) || has_missing_tracks_ ||
+      flat_nodes_.empty()) {
+    return;
+  }
+  for (size_t j = 0; j < flat_roots_.size(); ++j) {
+    if (flat_leaf_offsets_[j + 1] - flat_leaf_offsets_[j] > 64) {
+      return;
+    }
+  }
+
+  struct QuickScorerNode {
+    int32_t feature_id;
+    ThresholdType threshold;
+    int32_t tree;
+    uint64_t mask;
+  };
+  std::vector<QuickScorerNode> qs_nodes;
+  qs_nodes.reserve(flat_nodes_.size());
+
+  // The leftmost leaf of a branch, relative to the first leaf of the tree.
+  auto leftmost_leaf = [this](int32_t index, size_t tree) {
+    while (index >= 0) {
+      index = flat_nodes_[index].children[0];
+    }
+    return static_cast<int>(~index - flat_leaf_offsets_[tree]);
+  };
+
+  int32_t max_feature_id = 0;
+  for (size_t j = 0; j < flat_roots_.size(); ++j) {
+    for (size_t index = node_offsets[j]; index < node_offsets[j + 1]; ++index) {
+      const TreeNodeFlat<ThresholdType>& node = flat_nodes_[index];
+      // The leaves of the true branch are [begin, begin + count).
+      const int begin = leftmost_leaf(node.children[0], j);
+      const int count = leftmost_leaf(node.children[1], j) - begin;
+      const uint64_t true_leaves = ((uint64_t(1) << count) - 1) << begin;
+      qs_nodes.push_back({node.feature_id, node.value, static_cast<int32_t>(j), ~true_leaves});
+      max_feature_id = std::max(max_feature_id, node.feature_id);
+    }
+  }
+
+  std::stable_sort(qs_nodes.begin(), qs_nodes.end(), [](const QuickScorerNode& a, const QuickScorerNode& b) {
+    return a.feature_id < b.feature_id || (a.feature_id == b.feature_id && a.threshold < b.threshold);
+  });
+
+  qs_feature_offsets_.assign(static_cast<size_t>(max_feature_id) + 2, 0);
+  qs_thresholds_.reserve(qs_nodes.size());
+  qs_trees_.reserve(qs_nodes.size());
+  qs_masks_.reserve(qs_nodes.size());
+  for (const auto& node : qs_nodes) {
+    qs_feature_offsets_[node.feature_id + 1]++;
+    qs_thresholds_.push_back(node.threshold);
+    qs_trees_.push_back(node.tree);
+    qs_masks_.push_back(node.mask);
+  }
+  for (size_t f = 1; f < qs_feature_offsets_.size(); ++f) {
+    qs_feature_offsets_[f] += qs_feature_offsets_[f - 1];
+  }
+
+  use_quick_scorer_ = true;
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::compute(OpKernelContext* ctx,
                                                                          const Tensor* X,
@@ -350,22 +600,51 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
 
   const InputType* x_data = X->template Data<InputType>();
   int64_t* label_data = label == nullptr ? nullptr : label->template MutableData<int64_t>();
+
+  if (!use_quantized_) {
+    ComputeAggRows(ttp, x_data, stride, N, z_data, label_data, agg);
+    return;
+  }
+
+  // The features are binned once for all the trees.
+  const int64_t n_features = static_cast<int64_t>(q_threshold_offsets_.size()) - 1;
+  std::vector<uint16_t> bins(SafeInt<size_t>(N) * n_features);
+  concurrency::ThreadPool::TryBatchParallelFor(
+      ttp,
+      SafeInt<int32_t>((N + kRowBlock - 1) / kRowBlock),
+      [this, x_data, stride, N, n_features, &bins](ptrdiff_t block) {
+        const int64_t i = block * kRowBlock;
+        BinFeatures(x_data + i * stride, stride, std::min(kRowBlock, N - i), bins.data() + i * n_features);
+      },
+      0);
+  ComputeAggRows(ttp, bins.data(), n_features, N, z_data, label_data, agg);
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename AGG, typename FeatureType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAggRows(concurrency::ThreadPool* ttp,
+                                                                              const FeatureType* x_data,
+                                                                              int64_t stride, int64_t N,
+                                                                              OutputType* z_data,
+                                                                              int64_t* label_data,
+                                                                              const AGG& agg) const {
   auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
 
   if (n_targets_or_classes_ == 1) {
     if (N == 1) {
       ScoreValue<ThresholdType> score = {0, 0};
       if (n_trees_ <= parallel_tree_) { /* section A: 1 output, 1 row and not enough trees to parallelize */
-        for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data));
-        }
+        std::vector<uint64_t> bitvectors;
+        ProcessTreeNodeLeaves(x_data, bitvectors, [&agg, &score](const TreeNodeElement<ThresholdType>& leaf) {
+          agg.ProcessTreeNodePrediction1(score, leaf);
+        });
       } else { /* section B: 1 output, 1 row and enough trees to parallelize */
         std::vector<ScoreValue<ThresholdType>> scores(n_trees_, {0, 0});
         concurrency::ThreadPool::TryBatchParallelFor(
             ttp,
             SafeInt<int32_t>(n_trees_),
             [this, &scores, &agg, x_data](ptrdiff_t j) {
-              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(roots_[j], x_data));
+              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(j, x_data));
             },
             0);
 
@@ -375,17 +654,21 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       }
       agg.FinalizeScores1(z_data, score, label_data);
     } else if (N <= parallel_N_) { /* section C: 1 output, 2+ rows but not enough rows to parallelize */
-      ScoreValue<ThresholdType> score;
-      size_t j;
+      ScoreValue<ThresholdType> scores[kRowBlock];
+      std::vector<uint64_t> bitvectors;
 
-      for (int64_t i = 0; i < N; ++i) {
-        score = {0, 0};
-        for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-        }
+      for (int64_t i = 0; i < N; i += kRowBlock) {
+        const int64_t n_rows = std::min(kRowBlock, N - i);
+        std::fill_n(scores, n_rows, ScoreValue<ThresholdType>({0, 0}));
+        ProcessTreeNodeLeavesBlock(x_data + i * stride, stride, n_rows, bitvectors,
+                                   [&agg, &scores](int64_t r, const TreeNodeElement<ThresholdType>& leaf) {
+                                     agg.ProcessTreeNodePrediction1(scores[r], leaf);
+                                   });
 
-        agg.FinalizeScores1(z_data + i, score,
-                            label_data == nullptr ? nullptr : (label_data + i));
+        for (int64_t r = 0; r < n_rows; ++r) {
+          agg.FinalizeScores1(z_data + i + r, scores[r],
+                              label_data == nullptr ? nullptr : (label_data + i + r));
+        }
       }
     } else if (n_trees_ > max_num_threads) { /* section D: 1 output, 2+ rows and enough trees to parallelize */
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
@@ -398,10 +681,14 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * N + i] = {0, 0};
             }
+            const TreeNodeElement<ThresholdType>* leaves[kRowBlock];
             for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction1(scores[batch_num * N + i],
-                                               *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              for (int64_t i = 0; i < N; i += kRowBlock) {
+                const int64_t n_rows = std::min(kRowBlock, N - i);
+                ProcessTreeNodeLeaveBlock(j, x_data + i * stride, stride, n_rows, leaves);
+                for (int64_t r = 0; r < n_rows; ++r) {
+                  agg.ProcessTreeNodePrediction1(scores[batch_num * N + i + r], *leaves[r]);
+                }
               }
             }
           });
@@ -422,15 +709,22 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
     } else { /* section E: 1 output, 2+ rows, parallelization by rows */
       concurrency::ThreadPool::TryBatchParallelFor(
           ttp,
-          SafeInt<int32_t>(N),
-          [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
-            ScoreValue<ThresholdType> score = {0, 0};
-            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-            }
+          SafeInt<int32_t>((N + kRowBlock - 1) / kRowBlock),
+          [this, &agg, x_data, z_data, stride, label_data, N](ptrdiff_t block) {
+            const int64_t i = block * kRowBlock;
+            const int64_t n_rows = std::min(kRowBlock, N - i);
+            ScoreValue<ThresholdType> scores[kRowBlock];
+            std::fill_n(scores, n_rows, ScoreValue<ThresholdType>({0, 0}));
+            std::vector<uint64_t> bitvectors;
+            ProcessTreeNodeLeavesBlock(x_data + i * stride, stride, n_rows, bitvectors,
+                                       [&agg, &scores](int64_t r, const TreeNodeElement<ThresholdType>& leaf) {
+                                         agg.ProcessTreeNodePrediction1(scores[r], leaf);
+                                       });
 
-            agg.FinalizeScores1(z_data + i, score,
-                                label_data == nullptr ? nullptr : (label_data + i));
+            for (int64_t r = 0; r < n_rows; ++r) {
+              agg.FinalizeScores1(z_data + i + r, scores[r],
+                                  label_data == nullptr ? nullptr : (label_data + i + r));
+            }
           },
           0);
     }
@@ -438,9 +732,10 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
     if (N == 1) {                       /* section A2: 2+ outputs, 1 row, not enough trees to parallelize */
       if (n_trees_ <= parallel_tree_) { /* section A2 */
         InlinedVector<ScoreValue<ThresholdType>> scores(n_targets_or_classes_, {0, 0});
-        for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data));
-        }
+        std::vector<uint64_t> bitvectors;
+        ProcessTreeNodeLeaves(x_data, bitvectors, [&agg, &scores](const TreeNodeElement<ThresholdType>& leaf) {
+          agg.ProcessTreeNodePrediction(scores, leaf);
+        });
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else { /* section B2: 2+ outputs, 1 row, enough trees to parallelize */
         auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
@@ -452,7 +747,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               scores[batch_num].resize(n_targets_or_classes_, {0, 0});
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, n_trees_);
               for (auto j = work.start; j < work.end; ++j) {
-                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(roots_[j], x_data));
+                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(j, x_data));
               }
             });
         for (size_t i = 1, limit = scores.size(); i < limit; ++i) {
@@ -461,17 +756,24 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         agg.FinalizeScores(scores[0], z_data, -1, label_data);
       }
     } else if (N <= parallel_N_) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
-      InlinedVector<ScoreValue<ThresholdType>> scores(n_targets_or_classes_);
-      size_t j, limit;
+      std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(
+          kRowBlock, InlinedVector<ScoreValue<ThresholdType>>(n_targets_or_classes_));
+      std::vector<uint64_t> bitvectors;
 
-      for (int64_t i = 0; i < N; ++i) {
-        std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
-        for (j = 0, limit = roots_.size(); j < limit; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+      for (int64_t i = 0; i < N; i += kRowBlock) {
+        const int64_t n_rows = std::min(kRowBlock, N - i);
+        for (int64_t r = 0; r < n_rows; ++r) {
+          std::fill(scores[r].begin(), scores[r].end(), ScoreValue<ThresholdType>({0, 0}));
         }
+        ProcessTreeNodeLeavesBlock(x_data + i * stride, stride, n_rows, bitvectors,
+                                   [&agg, &scores](int64_t r, const TreeNodeElement<ThresholdType>& leaf) {
+                                     agg.ProcessTreeNodePrediction(scores[r], leaf);
+                                   });
 
-        agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
-                           label_data == nullptr ? nullptr : (label_data + i));
+        for (int64_t r = 0; r < n_rows; ++r) {
+          agg.FinalizeScores(scores[r], z_data + (i + r) * n_targets_or_classes_, -1,
+                             label_data == nullptr ? nullptr : (label_data + i + r));
+        }
       }
     } else if (n_trees_ >= max_num_threads) { /* section: D2: 2+ outputs, 2+ rows, enough trees to parallelize*/
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
@@ -484,10 +786,14 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * N + i].resize(n_targets_or_classes_, {0, 0});
             }
+            const TreeNodeElement<ThresholdType>* leaves[kRowBlock];
             for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction(scores[batch_num * N + i],
-                                              *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              for (int64_t i = 0; i < N; i += kRowBlock) {
+                const int64_t n_rows = std::min(kRowBlock, N - i);
+                ProcessTreeNodeLeaveBlock(j, x_data + i * stride, stride, n_rows, leaves);
+                for (int64_t r = 0; r < n_rows; ++r) {
+                  agg.ProcessTreeNodePrediction(scores[batch_num * N + i + r], *leaves[r]);
+                }
               }
             }
           });
@@ -511,39 +817,48 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           ttp,
           num_threads,
           [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
-            size_t j, limit;
-            InlinedVector<ScoreValue<ThresholdType>> scores(n_targets_or_classes_);
+            std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(
+                kRowBlock, InlinedVector<ScoreValue<ThresholdType>>(n_targets_or_classes_));
+            std::vector<uint64_t> bitvectors;
             auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, N);
 
-            for (auto i = work.start; i < work.end; ++i) {
-              std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
-              for (j = 0, limit = roots_.size(); j < limit; ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            for (auto i = work.start; i < work.end; i += kRowBlock) {
+              const int64_t n_rows = std::min<int64_t>(kRowBlock, work.end - i);
+              for (int64_t r = 0; r < n_rows; ++r) {
+                std::fill(scores[r].begin(), scores[r].end(), ScoreValue<ThresholdType>({0, 0}));
               }
+              ProcessTreeNodeLeavesBlock(x_data + i * stride, stride, n_rows, bitvectors,
+                                         [&agg, &scores](int64_t r, const TreeNodeElement<ThresholdType>& leaf) {
+                                           agg.ProcessTreeNodePrediction(scores[r], leaf);
+                                         });
 
-              agg.FinalizeScores(scores,
-                                 z_data + i * n_targets_or_classes_, -1,
-                                 label_data == nullptr ? nullptr : (label_data + i));
+              for (int64_t r = 0; r < n_rows; ++r) {
+                agg.FinalizeScores(scores[r],
+                                   z_data + (i + r) * n_targets_or_classes_, -1,
+                                   label_data == nullptr ? nullptr : (label_data + i + r));
+              }
             }
           });
     }
   }
 }  // namespace detail
 
-#define TREE_FIND_VALUE(CMP)                                         \
-  if (has_missing_tracks_) {                                         \
-    while (root->is_not_leaf) {                                      \
-      val = x_data[root->feature_id];                                \
-      root = (val CMP root->value ||                                 \
-              (root->is_missing_track_true && _isnan_(val)))         \
-                 ? root->truenode                                    \
-                 : root->falsenode;                                  \
-    }                                                                \
-  } else {                                                           \
-    while (root->is_not_leaf) {                                      \
-      val = x_data[root->feature_id];                                \
-      root = val CMP root->value ? root->truenode : root->falsenode; \
-    }                                                                \
+#define TREE_FIND_VALUE(CMP)                                                     \
+  if (has_missing_tracks_) {                                                     \
+    while (index >= 0) {                                                         \
+      const TreeNodeFlat<ThresholdType>& node = flat_nodes_[index];              \
+      val = x_data[node.feature_id];                                             \
+      index = node.children[(val CMP node.value ||                               \
+                             (flat_missing_tracks_true_[index] && _isnan_(val))) \
+                                ? 0                                              \
+                                : 1];                                            \
+    }                                                                            \
+  } else {                                                                       \
+    while (index >= 0) {                                                         \
+      const TreeNodeFlat<ThresholdType>& node = flat_nodes_[index];              \
+      val = x_data[node.feature_id];                                             \
+      index = node.children[val CMP node.value ? 0 : 1];                         \
+    }                                                                            \
   }
 
 inline bool _isnan_(float x) { return std::isnan(x); }
@@ -551,28 +866,34 @@ inline bool _isnan_(double x) { return std::isnan(x); }
 inline bool _isnan_(int64_t) { return false; }
 inline bool _isnan_(int32_t) { return false; }
 
+// Index of the lowest set bit, x shall not be 0.
+inline int _ctz_(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#elif defined(_M_X64) || defined(_M_ARM64)
+  unsigned long index;
+  _BitScanForward64(&index, x);
+  return static_cast<int>(index);
+#else
+  int index = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
-TreeNodeElement<ThresholdType>*
+const TreeNodeElement<ThresholdType>*
 TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
-    TreeNodeElement<ThresholdType>* root, const InputType* x_data) const {
+    size_t tree, const InputType* x_data) const {
   InputType val;
   if (same_mode_) {
-    switch (root->mode) {
+    int32_t index = flat_roots_[tree];
+    switch (flat_mode_) {
       case NODE_MODE::BRANCH_LEQ:
-        if (has_missing_tracks_) {
-          while (root->is_not_leaf) {
-            val = x_data[root->feature_id];
-            root = (val <= root->value ||
-                    (root->is_missing_track_true && _isnan_(val)))
-                       ? root->truenode
-                       : root->falsenode;
-          }
-        } else {
-          while (root->is_not_leaf) {
-            val = x_data[root->feature_id];
-            root = val <= root->value ? root->truenode : root->falsenode;
-          }
-        }
+        TREE_FIND_VALUE(<=)
         break;
       case NODE_MODE::BRANCH_LT:
         TREE_FIND_VALUE(<)
@@ -592,50 +913,350 @@ TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
       case NODE_MODE::LEAF:
         break;
     }
-  } else {  // Different rules to compare to node thresholds.
-    ThresholdType threshold;
-    while (root->is_not_leaf) {
-      val = x_data[root->feature_id];
-      threshold = root->value;
-      switch (root->mode) {
-        case NODE_MODE::BRANCH_LEQ:
-          root = val <= threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_LT:
-          root = val < threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_GTE:
-          root = val >= threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_GT:
-          root = val > threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_EQ:
-          root = val == threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_NEQ:
-          root = val != threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::LEAF:
-          break;
-      }
+    return flat_leaves_[~index];
+  }
+
+  // Different rules to compare to node thresholds.
+  const TreeNodeElement<ThresholdType>* root = roots_[tree];
+  ThresholdType threshold;
+  while (root->is_not_leaf) {
+    val = x_data[root->feature_id];
+    threshold = root->value;
+    switch (root->mode) {
+      case NODE_MODE::BRANCH_LEQ:
+        root = val <= threshold || (root->is_missing_track_true && _isnan_(val))
+                   ? root->truenode
+                   : root->falsenode;
+        break;
+      case NODE_MODE::BRANCH_LT:
+        root = val < threshold || (root->is_missing_track_true && _isnan_(val))
+                   ? root->truenode
+                   : root->falsenode;
+        break;
+      case NODE_MODE::BRANCH_GTE:
+        root = val >= threshold || (root->is_missing_track_true && _isnan_(val))
+                   ? root->truenode
+                   : root->falsenode;
+        break;
+      case NODE_MODE::BRANCH_GT:
+        root = val > threshold || (root->is_missing_track_true && _isnan_(val))
+                   ? root->truenode
+                   : root->falsenode;
+        break;
+      case NODE_MODE::BRANCH_EQ:
+        root = val == threshold || (root->is_missing_track_true && _isnan_(val))
+                   ? root->truenode
+                   : root->falsenode;
+        break;
+      case NODE_MODE::BRANCH_NEQ:
+        root = val != threshold || (root->is_missing_track_true && _isnan_(val))
+                   ? root->truenode
+                   : root->falsenode;
+        break;
+      case NODE_MODE::LEAF:
+        break;
     }
   }
   return root;
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename FCT>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    const InputType* x_data, std::vector<uint64_t>& bitvectors, FCT&& process_leaf) const {
+  if (!use_quick_scorer_) {
+    for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+      process_leaf(*ProcessTreeNodeLeave(j, x_data));
+    }
+    return;
+  }
+
+  // QuickScorer: every node whose condition is false clears the leaves of its true branch in the bitvector
+  // of its tree. The leaf reached by a tree is its leftmost leaf that is not cleared.
+  bitvectors.assign(static_cast<size_t>(n_trees_), ~uint64_t(0));
+  for (size_t f = 0, n_features = qs_feature_offsets_.size() - 1; f < n_features; ++f) {
+    const InputType val = x_data[f];
+    size_t k = qs_feature_offsets_[f];
+    const size_t end = qs_feature_offsets_[f + 1];
+    if (flat_mode_ == NODE_MODE::BRANCH_LEQ) {
+      for (; k < end && !(val <= qs_thresholds_[k]); ++k) {
+        bitvectors[qs_trees_[k]] &= qs_masks_[k];
+      }
+    } else {
+      for (; k < end && !(val < qs_thresholds_[k]); ++k) {
+        bitvectors[qs_trees_[k]] &= qs_masks_[k];
+      }
+    }
+  }
+
+  for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+    process_leaf(*flat_leaves_[flat_leaf_offsets_[j] + _ctz_(bitvectors[j])]);
+  }
+}
+
+#define TREE_FIND_VALUE_BLOCK(CMP)                                                                        \
+  for (bool active = true; active;) {                                                                     \
+    active = false;                                                                                       \
+    for (int64_t r = 0; r < n_rows; ++r) {                                                                \
+      int32_t index = indices[r];                                                                         \
+      if (index >= 0) {                                                                                   \
+        const TreeNodeFlat<ThresholdType>& node = flat_nodes_[index];                                     \
+        const InputType val = x_data[r * stride + node.feature_id];                                       \
+        index = node.children[(val CMP node.value ||                                                      \
+                               (has_missing_tracks_ && flat_missing_tracks_true_[index] && _isnan_(val))) \
+                                  ? 0                                                                     \
+                                  : 1];                                                                   \
+        indices[r] = index;                                                                               \
+        active |= index >= 0;                                                                             \
+      }                                                                                                   \
+    }                                                                                                     \
+  }
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaveBlock(
+    size_t tree, const InputType* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves) const {
+  if (!same_mode_) {
+    for (int64_t r = 0; r < n_rows; ++r) {
+      leaves[r] = ProcessTreeNodeLeave(tree, x_data + r * stride);
+    }
+    return;
+  }
+
+  int32_t indices[kRowBlock];
+  std::fill_n(indices, n_rows, flat_roots_[tree]);
+  switch (flat_mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+      TREE_FIND_VALUE_BLOCK(<=)
+      break;
+    case NODE_MODE::BRANCH_LT:
+      TREE_FIND_VALUE_BLOCK(<)
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      TREE_FIND_VALUE_BLOCK(>=)
+      break;
+    case NODE_MODE::BRANCH_GT:
+      TREE_FIND_VALUE_BLOCK(>)
+      break;
+    case NODE_MODE::BRANCH_EQ:
+      TREE_FIND_VALUE_BLOCK(==)
+      break;
+    case NODE_MODE::BRANCH_NEQ:
+      TREE_FIND_VALUE_BLOCK(!=)
+      break;
+    case NODE_MODE::LEAF:
+      break;
+  }
+  for (int64_t r = 0; r < n_rows; ++r) {
+    leaves[r] = flat_leaves_[~indices[r]];
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename FCT>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeavesBlock(
+    const InputType* x_data, int64_t stride, int64_t n_rows, std::vector<uint64_t>& bitvectors,
+    FCT&& process_leaf) const {
+  if (use_quick_scorer_) {
+    for (int64_t r = 0; r < n_rows; ++r) {
+      ProcessTreeNodeLeaves(x_data + r * stride, bitvectors,
+                            [&process_leaf, r](const TreeNodeElement<ThresholdType>& leaf) { process_leaf(r, leaf); });
+    }
+    return;
+  }
+
+  const TreeNodeElement<ThresholdType>* leaves[kRowBlock];
+  for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+    ProcessTreeNodeLeaveBlock(j, x_data, stride, n_rows, leaves);
+    for (int64_t r = 0; r < n_rows; ++r) {
+      process_leaf(r, *leaves[r]);
+    }
+  }
+}
+
+// The thresholds of each feature are replaced by their rank k among the m distinct thresholds t_0 < ... < t_{m-1}
+// of the feature, and an input value v by a bin b, so that the condition of a node is b <= bin:
+//   BRANCH_LEQ: v <= t_k iff #{t < v} <= k, b = #{t < v} and bin = k
+//   BRANCH_LT: v < t_k iff #{t <= v} <= k, b = #{t <= v} and bin = k
+//   BRANCH_GTE: v >= t_k iff k < #{t <= v}, b = m - #{t <= v} and bin = m - 1 - k
+//   BRANCH_GT: v > t_k iff k < #{t < v}, b = m - #{t < v} and bin = m - 1 - k
+// Values and thresholds are compared as in the flat layout, so the predictions do not change.
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::CompileQuantizedTrees() {
+  q_nodes_.clear();
+  q_thresholds_.clear();
+  q_threshold_offsets_.clear();
+
+  // QuickScorer already has a compact layout. Bins end below kMissingBin and feature ids fit in 16 bits.
+  if (quantize_mode_ != "1" || use_quick_scorer_ || flat_nodes_.empty()) {
+    return;
+  }
+  if (flat_mode_ != NODE_MODE::BRANCH_LEQ && flat_mode_ != NODE_MODE::BRANCH_LT &&
+      flat_mode_ != NODE_MODE::BRANCH_GTE && flat_mode_ != NODE_MODE::BRANCH_GT) {
+    return;
+  }
+
+  int32_t max_feature_id = 0;
+  for (const auto& node : flat_nodes_) {
+    if (node.feature_id < 0 || node.feature_id > std::numeric_limits<uint16_t>::max() || _isnan_(node.value)) {
+      return;
+    }
+    max_feature_id = std::max(max_feature_id, node.feature_id);
+  }
+
+  std::vector<std::vector<ThresholdType>> thresholds(static_cast<size_t>(max_feature_id) + 1);
+  for (const auto& node : flat_nodes_) {
+    thresholds[node.feature_id].push_back(node.value);
+  }
+
+  q_threshold_offsets_.reserve(thresholds.size() + 1);
+  q_threshold_offsets_.push_back(0);
+  for (auto& feature_thresholds : thresholds) {
+    std::sort(feature_thresholds.begin(), feature_thresholds.end());
+    feature_thresholds.erase(std::unique(feature_thresholds.begin(), feature_thresholds.end()),
+                             feature_thresholds.end());
+    if (feature_thresholds.size() >= kMissingBin) {
+      q_thresholds_.clear();
+      q_threshold_offsets_.clear();
+      return;
+    }
+    q_thresholds_.insert(q_thresholds_.end(), feature_thresholds.begin(), feature_thresholds.end());
+    q_threshold_offsets_.push_back(q_thresholds_.size());
+  }
+
+  const bool reversed = flat_mode_ == NODE_MODE::BRANCH_GTE || flat_mode_ == NODE_MODE::BRANCH_GT;
+  q_nodes_.reserve(flat_nodes_.size());
+  for (const auto& node : flat_nodes_) {
+    const ThresholdType* first = q_thresholds_.data() + q_threshold_offsets_[node.feature_id];
+    const ThresholdType* last = q_thresholds_.data() + q_threshold_offsets_[node.feature_id + 1];
+    const size_t m = static_cast<size_t>(last - first);
+    const size_t k = static_cast<size_t>(std::lower_bound(first, last, node.value) - first);
+    TreeNodeQuantized quantized;
+    quantized.feature_id = static_cast<uint16_t>(node.feature_id);
+    quantized.bin = static_cast<uint16_t>(reversed ? m - 1 - k : k);
+    quantized.children[0] = node.children[0];
+    quantized.children[1] = node.children[1];
+    q_nodes_.push_back(quantized);
+  }
+
+  flat_nodes_.clear();
+  flat_nodes_.shrink_to_fit();
+  use_quantized_ = true;
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BinFeatures(
+    const InputType* x_data, int64_t stride, int64_t n_rows, uint16_t* bins) const {
+  const size_t n_features = q_threshold_offsets_.size() - 1;
+  auto count_less = [](const ThresholdType* first, const ThresholdType* last, InputType val) {
+    return std::lower_bound(first, last, val, [](ThresholdType t, InputType v) { return t < v; }) - first;
+  };
+  auto count_less_equal = [](const ThresholdType* first, const ThresholdType* last, InputType val) {
+    return std::upper_bound(first, last, val, [](InputType v, ThresholdType t) { return v < t; }) - first;
+  };
+
+  for (int64_t i = 0; i < n_rows; ++i) {
+    const InputType* x = x_data + i * stride;
+    uint16_t* row_bins = bins + i * n_features;
+    for (size_t f = 0; f < n_features; ++f) {
+      const ThresholdType* first = q_thresholds_.data() + q_threshold_offsets_[f];
+      const ThresholdType* last = q_thresholds_.data() + q_threshold_offsets_[f + 1];
+      if (first == last) {  // no node reads the feature
+        row_bins[f] = 0;
+        continue;
+      }
+
+      const InputType val = x[f];
+      std::ptrdiff_t bin;
+      if (_isnan_(val)) {
+        bin = kMissingBin;
+      } else {
+        switch (flat_mode_) {
+          case NODE_MODE::BRANCH_LEQ:
+            bin = count_less(first, last, val);
+            break;
+          case NODE_MODE::BRANCH_LT:
+            bin = count_less_equal(first, last, val);
+            break;
+          case NODE_MODE::BRANCH_GTE:
+            bin = (last - first) - count_less_equal(first, last, val);
+            break;
+          default:  // NODE_MODE::BRANCH_GT
+            bin = (last - first) - count_less(first, last, val);
+            break;
+        }
+      }
+      row_bins[f] = static_cast<uint16_t>(bin);
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+const TreeNodeElement<ThresholdType>*
+TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
+    size_t tree, const uint16_t* bins) const {
+  int32_t index = flat_roots_[tree];
+  while (index >= 0) {
+    const TreeNodeQuantized& node = q_nodes_[index];
+    const uint16_t bin = bins[node.feature_id];
+    index = node.children[(bin <= node.bin ||
+                           (has_missing_tracks_ && bin == kMissingBin && flat_missing_tracks_true_[index]))
+                              ? 0
+                              : 1];
+  }
+  return flat_leaves_[~index];
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename FCT>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    const uint16_t* bins, std::vector<uint64_t>& /* bitvectors */, FCT&& process_leaf) const {
+  for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+    process_leaf(*ProcessTreeNodeLeave(j, bins));
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaveBlock(
+    size_t tree, const uint16_t* bins, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves) const {
+  int32_t indices[kRowBlock];
+  std::fill_n(indices, n_rows, flat_roots_[tree]);
+  for (bool active = true; active;) {
+    active = false;
+    for (int64_t r = 0; r < n_rows; ++r) {
+      int32_t index = indices[r];
+      if (index >= 0) {
+        const TreeNodeQuantized& node = q_nodes_[index];
+        const uint16_t bin = bins[r * stride + node.feature_id];
+        index = node.children[(bin <= node.bin ||
+                               (has_missing_tracks_ && bin == kMissingBin && flat_missing_tracks_true_[index]))
+                                  ? 0
+                                  : 1];
+        indices[r] = index;
+        active |= index >= 0;
+      }
+    }
+  }
+  for (int64_t r = 0; r < n_rows; ++r) {
+    leaves[r] = flat_leaves_[~indices[r]];
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename FCT>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeavesBlock(
+    const uint16_t* bins, int64_t stride, int64_t n_rows, std::vector<uint64_t>& /* bitvectors */,
+    FCT&& process_leaf) const {
+  const TreeNodeElement<ThresholdType>* leaves[kRowBlock];
+  for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+    ProcessTreeNodeLeaveBlock(j, bins, stride, n_rows, leaves);
+    for (int64_t r = 0; r < n_rows; ++r) {
+      process_leaf(r, *leaves[r]);
+    }
+  }
+}
+
 // TI: input type
 // TH: threshold type, double if T==double, float otherwise
 // TO: output type
@@ -690,6 +1311,8 @@ Status TreeEnsembleCommonClassifier<InputType, ThresholdType, OutputType>::Init(
   ORT_THROW_IF_ERROR(GetVectorAttrsOrDefault(info, "nodes_values_as_tensor", nodes_values_as_tensor));
   ORT_THROW_IF_ERROR(GetVectorAttrsOrDefault(info, "class_weights_as_tensor", class_weights_as_tensor));
 #endif
+  this->quantize_mode_ =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigTreeEnsembleQuantizeThresholds, "");
 
   return Init(
       80,
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/ml/zipmap.h"
 #include "core/util/math_cpuonly.h"
+#include "core/platform/threadpool.h"
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
 ONNX_OPERATOR_SCHEMA(ZipMap)
@@ -35,6 +36,49 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+// Fills keys with the class labels and key_columns with the input column of each key, in key order.
+// If a label is repeated, the last column with the label is used, as when the row is inserted in order.
+template <typename TKey>
+static void BuildKeys(const std::vector<TKey>& classlabels, std::map<TKey, float>& keys,
+                      std::vector<int64_t>& key_columns) {
+  std::map<TKey, int64_t> columns;
+  for (size_t j = 0; j < classlabels.size(); ++j) {
+    columns[classlabels[j]] = static_cast<int64_t>(j);
+  }
+  key_columns.reserve(columns.size());
+  for (const auto& column : columns) {
+    keys.emplace_hint(keys.end(), column.first, 0.f);
+    key_columns.push_back(column.second);
+  }
+}
+
+// Creates a map per row by copying keys, which doesn't compare any keys, and then writing
+// the values of the row in key order. The rows are independent so they are split across the thread pool.
+template <typename TKey>
+static void ZipRows(const std::map<TKey, float>& keys, const std::vector<int64_t>& key_columns,
+                    const float* x_data, int64_t batch_size, int64_t features_per_batch,
+                    std::vector<std::map<TKey, float>>& y_data, concurrency::ThreadPool* tp) {
+  y_data.resize(batch_size);
+  // each entry is a node allocation and a copy of the key
+  const double entries = static_cast<double>(keys.size());
+  const TensorOpCost cost{static_cast<double>(features_per_batch * sizeof(float)),
+                          entries * (sizeof(TKey) + sizeof(float)),
+                          entries * 64};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t n = first; n < last; ++n) {
+          auto& row_map = y_data[n];
+          row_map = keys;
+          const float* row = x_data + n * features_per_batch;
+          auto column = key_columns.cbegin();
+          for (auto& entry : row_map) {
+            entry.second = row[*column++];
+          }
+        }
+      });
+}
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +86,11 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  if (using_strings_) {
+    BuildKeys(classlabels_strings_, string_keys_, key_columns_);
+  } else {
+    BuildKeys(classlabels_int64s_, int64_keys_, key_columns_);
+  }
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -77,17 +126,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
 
-    //auto* y_data = Y->template MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map1);
-    }
+    ZipRows(string_keys_, key_columns_, x_data, batch_size, features_per_batch, *y_data,
+            context->GetOperatorThreadPool());
   } else {
     if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
       return Status(ONNXRUNTIME,
@@ -97,17 +137,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     }
     auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    //auto* y_data = Y->template MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+    ZipRows(int64_keys_, key_columns_, x_data, batch_size, features_per_batch, *y_data,
+            context->GetOperatorThreadPool());
   }
   return common::Status::OK();
 }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <map>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 namespace onnxruntime {
@@ -16,6 +17,12 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+  // Map with the keys of every output row, in key order. Copying it is much cheaper than
+  // inserting the keys again for every row.
+  std::map<std::string, float> string_keys_;
+  std::map<int64_t, float> int64_keys_;
+  // input column of each entry of the keys map, in key order
+  std::vector<int64_t> key_columns_;
 };
 
 }  // namespace ml
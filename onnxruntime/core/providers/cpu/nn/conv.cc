@@ -152,19 +152,105 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+bool Conv<float>::ShouldPackWinogradFilter(const TensorShape& filter_shape) const {
+  if (winograd_mode_ == "0") {
+    return false;
+  }
+
+  if (filter_shape.NumDimensions() != 4 || filter_shape[2] != 3 || filter_shape[3] != 3 || conv_attrs_.group != 1) {
+    return false;
+  }
+
+  for (int64_t stride : conv_attrs_.strides) {
+    if (stride != 1) {
+      return false;
+    }
+  }
+
+  for (int64_t dilation : conv_attrs_.dilations) {
+    if (dilation != 1) {
+      return false;
+    }
+  }
+
+  if (winograd_mode_ == "1") {
+    return true;
+  }
+
+  // The transforms cost more than the multiplications they save for narrow convolutions.
+  constexpr int64_t winograd_minimum_channels = 32;
+  return filter_shape[0] >= winograd_minimum_channels && filter_shape[1] >= winograd_minimum_channels;
+}
+
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack the filter
+  if (input_idx != 1 || !ShouldPackWinogradFilter(tensor.Shape())) {
+    return Status::OK();
+  }
+
+  const size_t filter_count = static_cast<size_t>(tensor.Shape()[0]);
+  const size_t input_channels = static_cast<size_t>(tensor.Shape()[1]);
+  const size_t packed_filter_size = MlasConvWinogradPackFilterSize(filter_count, input_channels);
+
+  auto* packed_filter_data = alloc->Alloc(packed_filter_size);
+  packed_winograd_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(alloc));
+  MlasConvWinogradPackFilter(filter_count, input_channels, tensor.Data<float>(), packed_filter_data);
+
+  filter_shape_ = tensor.Shape();
+  is_packed = true;
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(packed_winograd_filter_));
+    prepacked_weights->buffer_sizes_.push_back(packed_filter_size);
+  }
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_winograd_filter_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+Status Conv<float>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                              std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  if (input_idx == 1 && ShouldPackWinogradFilter(tensor.Shape())) {
+    used_cached_buffers = true;
+    filter_shape_ = tensor.Shape();
+    packed_winograd_filter_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* W = packed_winograd_filter_ ? nullptr : context->Input<Tensor>(1);
+  const TensorShape& W_shape = W ? W->Shape() : filter_shape_;
   const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
   const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   TensorShapeVector kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   ConvPadVector pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -212,29 +298,60 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
   if (kernel_rank >= 1 && kernel_rank <= 3) {
+    // The convolution only needs to be prepared again if the input or filter shapes change.
+    TensorShapeVector dims(X->Shape().GetDims().begin(), X->Shape().GetDims().end());
+    dims.insert(dims.end(), W_shape.GetDims().begin(), W_shape.GetDims().end());
+
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
-    MlasConvPrepare(&Parameters,
-                    kernel_rank,
-                    static_cast<size_t>(N),
-                    static_cast<size_t>(conv_attrs_.group),
-                    static_cast<size_t>(C / conv_attrs_.group),
-                    input_shape.GetDims().data(),
-                    kernel_shape.data(),
-                    dilations.data(),
-                    pads.data(),
-                    strides.data(),
-                    output_shape.GetDims().data(),
-                    static_cast<size_t>(M / conv_attrs_.group),
-                    &activation_,
-                    &WorkingBufferSize,
-                    Beta,
-                    thread_pool);
+    {
+      std::lock_guard<onnxruntime::OrtMutex> lock(prepare_mutex_);
+      if (dims != prepared_dims_ || Beta != prepared_beta_) {
+        MlasConvPrepare(&prepared_parameters_,
+                        kernel_rank,
+                        static_cast<size_t>(N),
+                        static_cast<size_t>(conv_attrs_.group),
+                        static_cast<size_t>(C / conv_attrs_.group),
+                        input_shape.GetDims().data(),
+                        kernel_shape.data(),
+                        dilations.data(),
+                        pads.data(),
+                        strides.data(),
+                        output_shape.GetDims().data(),
+                        static_cast<size_t>(M / conv_attrs_.group),
+                        &activation_,
+                        &prepared_working_buffer_size_,
+                        Beta,
+                        thread_pool);
+        prepared_dims_ = std::move(dims);
+        prepared_beta_ = Beta;
+      }
+      Parameters = prepared_parameters_;
+      WorkingBufferSize = prepared_working_buffer_size_;
+    }
+
+    if (packed_winograd_filter_) {
+      // The filter is only packed for the convolutions that the Winograd algorithm supports.
+      ORT_RETURN_IF_NOT(MlasConvWinogradIsSupported(&Parameters),
+                        "The Winograd convolution does not support the convolution parameters");
+      WorkingBufferSize = MlasConvWinogradWorkingBufferSize(&Parameters, thread_pool);
+    }
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(SafeInt<size_t>(sizeof(float)) * WorkingBufferSize)
                                                : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
 
+    if (packed_winograd_filter_) {
+      MlasConvWinograd(&Parameters,
+                       Xdata,
+                       packed_winograd_filter_.get(),
+                       Bdata,
+                       static_cast<float*>(working_buffer.get()),
+                       Ydata,
+                       thread_pool);
+      return Status::OK();
+    }
+
     MlasConv(&Parameters,
              Xdata,
              W->template Data<float>(),
@@ -6,6 +6,8 @@
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/ort_mutex.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -26,14 +28,50 @@ class Conv<float> : public OpKernel {
  public:
   Conv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
     activation_.ActivationKind = MlasIdentityActivation;
+    winograd_mode_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigConvWinograd, "");
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status UseCachedPrePackedBuffers(const Tensor& tensor,
+                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_cached_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
-  
+
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // The MLAS convolution parameters prepared for the most recent input and filter shapes. A model
+  // with fixed shapes prepares the convolution, including the selection of its shape specialized
+  // kernels, once per session. use prepare_mutex_ to ensure Compute() can be called concurrently.
+  mutable onnxruntime::OrtMutex prepare_mutex_;
+  mutable TensorShapeVector prepared_dims_;
+  mutable float prepared_beta_{0.0f};
+  mutable MLAS_CONV_PARAMETERS prepared_parameters_;
+  mutable size_t prepared_working_buffer_size_{0};
+
+  // Returns true if the filter should be packed for the Winograd convolution.
+  bool ShouldPackWinogradFilter(const TensorShape& filter_shape) const;
+
+  // The session.conv_winograd configuration: "0" disables the Winograd convolution, "1" uses
+  // it for every supported convolution and an empty string uses it for the larger convolutions.
+  std::string winograd_mode_;
+
+  // The filter transformed by MlasConvWinogradPackFilter. The Winograd convolution is only used
+  // when the filter is a constant initializer that was packed.
+  BufferUniquePtr packed_winograd_filter_;
+  TensorShape filter_shape_;
 };
 
 }  // namespace onnxruntime
@@ -233,86 +233,110 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
     return Status::OK();
   }
 
+  const int64_t group_count = conv_transpose_attrs_.group;
   const int64_t input_image_size = p.input_shape.Size();
-  const int64_t X_offset = p.num_input_channels / conv_transpose_attrs_.group * input_image_size;
-  const int64_t Y_offset = p.Y->Shape().Size() / p.Y->Shape()[0] / conv_transpose_attrs_.group;
-  const int64_t W_offset = (p.F ? p.F->Shape().Size() : filter_shape_.Size()) / conv_transpose_attrs_.group;
+  const int64_t group_input_channels = p.num_input_channels / group_count;
+  const int64_t X_offset = group_input_channels * input_image_size;
+  const int64_t W_offset = (p.F ? p.F->Shape().Size() : filter_shape_.Size()) / group_count;
   const int64_t kernel_size = TensorShape(p.kernel_shape).Size();
-  const int64_t kernel_dim = p.num_output_channels / conv_transpose_attrs_.group * kernel_size;
+  const int64_t kernel_dim = p.num_output_channels / group_count * kernel_size;
   const int64_t output_size = (p.Y->Shape().Slice(2)).Size();
 
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
-  const int64_t col_buffer_size = kernel_dim * p.input_shape.Size();
-  auto col_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * col_buffer_size);
+  // The column buffer holds the GEMM results of all the groups, so that the GEMMs are issued as a single batch
+  // and the col2im of every output channel is independent.
+  const int64_t col_group_size = kernel_dim * input_image_size;
+  auto col_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * col_group_size * group_count);
   BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
   float* col_buffer_data = static_cast<float*>(col_buffer.get());
 
   const float* Xdata = p.X->template Data<float>();
   const float* filter_data = p.F ? p.F->template Data<float>() : static_cast<float*>(transposed_filter_.get());
+  const float* Bdata = p.B != nullptr ? p.B->template Data<float>() : nullptr;
   float* Ydata = p.Y->template MutableData<float>();
   TensorShape output_shape = p.Y->Shape().Slice(2);
 
-  for (auto image_id = 0; image_id < p.N; ++image_id) {
-    for (int group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
-      // Weight term
-      math::Gemm<float>(
-          p.F ? CblasTrans : CblasNoTrans,
-          CblasNoTrans,
-          kernel_dim,
-          input_image_size,
-          p.num_input_channels / conv_transpose_attrs_.group,
-          1,
-          filter_data + group_id * W_offset,
-          Xdata + group_id * X_offset,
-          0,
-          col_buffer_data,
-          thread_pool);
+  // Weight term. The prepacked filter is already transposed to [kernel_dim][group_input_channels].
+  InlinedVector<MLAS_SGEMM_DATA_PARAMS> gemm_params(static_cast<size_t>(group_count));
+  for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+    MLAS_SGEMM_DATA_PARAMS& gemm = gemm_params[group_id];
+    gemm.A = filter_data + group_id * W_offset;
+    gemm.lda = static_cast<size_t>(p.F ? kernel_dim : group_input_channels);
+    gemm.ldb = static_cast<size_t>(input_image_size);
+    gemm.C = col_buffer_data + group_id * col_group_size;
+    gemm.ldc = static_cast<size_t>(input_image_size);
+  }
 
-      if (p.X->Shape().NumDimensions() == 4) {
-        math::Col2im<float, CPUMathUtil, StorageOrder::NCHW>(
-            col_buffer_data,
-            p.num_output_channels / conv_transpose_attrs_.group,
-            p.Y->Shape()[2],
-            p.Y->Shape()[3],
-            p.kernel_shape[0],
-            p.kernel_shape[1],
-            p.dilations[0],
-            p.dilations[1],
-            p.pads[0],
-            p.pads[1],
-            p.pads[2],
-            p.pads[3],
-            p.strides[0],
-            p.strides[1],
-            Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
-      } else {
-        math::Col2imNd<float, CPUMathUtil, StorageOrder::NCHW>(
-            col_buffer_data,
-            output_shape.GetDims().data(),
-            p.input_shape.GetDims().data(),
-            kernel_dim,
-            Y_offset,
-            p.kernel_shape.data(),
-            p.strides.data(),
-            p.dilations.data(),
-            p.pads.data(),
-            static_cast<int>(p.kernel_shape.size()),
-            Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
-      }
-    }
+  const bool is_2d = p.X->Shape().NumDimensions() == 4;
+  const double col2im_cost = static_cast<double>(kernel_size * input_image_size);
 
-    if (p.B != nullptr) {
-      auto Ymatrix = EigenMatrixMap<float>(Ydata, output_size, p.num_output_channels);
-      auto Bvec = ConstEigenVectorMap<float>(p.B->template Data<float>(), p.num_output_channels);
-      Ymatrix.rowwise() += Bvec.transpose();
+  for (auto image_id = 0; image_id < p.N; ++image_id) {
+    for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+      gemm_params[group_id].B = Xdata + group_id * X_offset;
     }
-
-    Xdata += X_offset * conv_transpose_attrs_.group;
-    Ydata += Y_offset * conv_transpose_attrs_.group;
+    MlasGemmBatch(p.F ? CblasTrans : CblasNoTrans,
+                  CblasNoTrans,
+                  static_cast<size_t>(kernel_dim),
+                  static_cast<size_t>(input_image_size),
+                  static_cast<size_t>(group_input_channels),
+                  gemm_params.data(),
+                  gemm_params.size(),
+                  thread_pool);
+
+    // Scatter the columns of each output channel into the output and add the bias. The columns of output channel
+    // m are the kernel_size rows starting at m * kernel_size across the groups.
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(p.num_output_channels),
+        TensorOpCost{col2im_cost * sizeof(float), static_cast<double>(output_size * sizeof(float)), col2im_cost},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t m = first; m < last; m++) {
+            const float* channel_col = col_buffer_data + m * kernel_size * input_image_size;
+            float* channel_Y = Ydata + m * output_size;
+
+            if (is_2d) {
+              math::Col2im<float, CPUMathUtil, StorageOrder::NCHW>(
+                  channel_col,
+                  1,
+                  p.Y->Shape()[2],
+                  p.Y->Shape()[3],
+                  p.kernel_shape[0],
+                  p.kernel_shape[1],
+                  p.dilations[0],
+                  p.dilations[1],
+                  p.pads[0],
+                  p.pads[1],
+                  p.pads[2],
+                  p.pads[3],
+                  p.strides[0],
+                  p.strides[1],
+                  channel_Y,
+                  &CPUMathUtil::Instance());
+            } else {
+              math::Col2imNd<float, CPUMathUtil, StorageOrder::NCHW>(
+                  channel_col,
+                  output_shape.GetDims().data(),
+                  p.input_shape.GetDims().data(),
+                  kernel_size,
+                  output_size,
+                  p.kernel_shape.data(),
+                  p.strides.data(),
+                  p.dilations.data(),
+                  p.pads.data(),
+                  static_cast<int>(p.kernel_shape.size()),
+                  channel_Y,
+                  &CPUMathUtil::Instance());
+            }
+
+            if (Bdata != nullptr) {
+              EigenVectorArrayMap<float>(channel_Y, output_size) += Bdata[m];
+            }
+          }
+        });
+
+    Xdata += X_offset * group_count;
+    Ydata += output_size * p.num_output_channels;
   }
 
   return Status::OK();
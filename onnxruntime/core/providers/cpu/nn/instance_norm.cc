@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/nn/instance_norm.h"
 #include "core/providers/cpu/nn/instance_norm_helper.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 using namespace ::onnxruntime::common;
 
@@ -28,16 +29,28 @@ Status InstanceNorm<float>::Compute(OpKernelContext* p_op_kernel_context) const
   const TensorShape& x_shape = input->Shape();
   Tensor* Y = p_op_kernel_context->Output(0, x_shape);
 
-  for (auto i = 0; i < N * C; ++i) {
-    ConstEigenVectorArrayMap<float> Xi(input->template Data<float>() + W * i, W);
-    const float Xi_mean = Xi.mean();
-    const float squared_norm = (Xi - Xi_mean).matrix().squaredNorm();
-    const float inv_stdev = 1.0f / std::sqrt(squared_norm / W + epsilon_);
-    EigenVectorArrayMap<float> Yi(Y->template MutableData<float>() + W * i, W);
-    const float channel_scale = inv_stdev * scale->template Data<float>()[i % C];
-    const float channel_shift = B->template Data<float>()[i % C] - Xi_mean * channel_scale;
-    Yi = Xi * channel_scale + channel_shift;
-  }
+  const float* X_data = input->Data<float>();
+  const float* scale_data = scale->Data<float>();
+  const float* B_data = B->Data<float>();
+  float* Y_data = Y->MutableData<float>();
+
+  // the channels are normalized independently, each reading its input twice
+  concurrency::ThreadPool::TryParallelFor(
+      p_op_kernel_context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(N * C),
+      TensorOpCost{static_cast<double>(W * sizeof(float) * 2), static_cast<double>(W * sizeof(float)),
+                   static_cast<double>(W * 4)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          ConstEigenVectorArrayMap<float> Xi(X_data + W * i, W);
+          const float Xi_mean = Xi.mean();
+          const float squared_norm = (Xi - Xi_mean).matrix().squaredNorm();
+          const float inv_stdev = 1.0f / std::sqrt(squared_norm / W + epsilon_);
+          EigenVectorArrayMap<float> Yi(Y_data + W * i, W);
+          const float channel_scale = inv_stdev * scale_data[i % C];
+          const float channel_shift = B_data[i % C] - Xi_mean * channel_scale;
+          Yi = Xi * channel_scale + channel_shift;
+        }
+      });
 
   return Status::OK();
 }
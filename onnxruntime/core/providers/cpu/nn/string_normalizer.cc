@@ -4,6 +4,7 @@
 #include "string_normalizer.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #include <codecvt>
@@ -15,6 +16,10 @@
 #include <iconv.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
 #include <locale>
 #include <functional>
 #include <unordered_set>
@@ -192,55 +197,63 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS
 
 #endif  // MS_VER
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
-                      Utf8Converter& converter,
-                      size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
-  std::vector<int64_t> output_dims;
-  if (N == 1) {
-    output_dims.push_back(1);
+// The ASCII helpers below process 8 bytes at a time within a 64-bit word, which is safe as ASCII
+// bytes never carry into the neighbouring byte.
+constexpr uint64_t kByteOnes = 0x0101010101010101ULL;
+constexpr uint64_t kByteHighBits = 0x8080808080808080ULL;
+
+inline bool IsAscii(const std::string& s) {
+  const char* data = s.data();
+  const size_t len = s.size();
+  uint64_t bits = 0;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    bits |= word;
   }
-
-  // Empty output case
-  if (C == 0) {
-    output_dims.push_back(1);
-    TensorShape output_shape(output_dims);
-    // This will create one empty string
-    ctx->Output(0, output_shape);
-    return Status::OK();
+  for (; i < len; ++i) {
+    bits |= static_cast<unsigned char>(data[i]);
   }
+  return (bits & kByteHighBits) == 0;
+}
 
-  output_dims.push_back(C);
-
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-  size_t output_idx = 0;
-  while (first != end) {
-    auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
-        // Please do not include the input text in the error message as it could
-        // be deemed as a compliance violation by teams using this operator
-        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars");
-      }
-      // In place transform
-      loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
-    } else {
-      assert(caseaction == StringNormalizer::NONE);
-      // Simple copy or move if the iterator points to a non-const string
-      *(output_data + output_idx) = std::move(s);
+// Changes the case of the ASCII letters of an ASCII only string in place.
+inline void AsciiChangeCase(StringNormalizer::CaseAction caseaction, std::string& s) {
+  assert(caseaction != StringNormalizer::NONE);
+  const unsigned char first = (caseaction == StringNormalizer::LOWER) ? 'A' : 'a';
+  const unsigned char last = (caseaction == StringNormalizer::LOWER) ? 'Z' : 'z';
+  char* data = &s[0];
+  const size_t len = s.size();
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    // The high bit of each byte is set when the byte is >= first, respectively > last.
+    const uint64_t ge_first = word + kByteOnes * (0x80 - first);
+    const uint64_t gt_last = word + kByteOnes * (0x7F - last);
+    const uint64_t is_letter = ge_first & ~gt_last & kByteHighBits;
+    // 0x20 is the difference between the cases
+    word ^= is_letter >> 2;
+    memcpy(data + i, &word, sizeof(word));
+  }
+  for (; i < len; ++i) {
+    const unsigned char ch = static_cast<unsigned char>(data[i]);
+    if (ch >= first && ch <= last) {
+      data[i] = static_cast<char>(ch ^ 0x20);
     }
-    ++output_idx;
-    ++first;
   }
-  return Status::OK();
+}
+
+bool HasAsciiFastPath(const std::string& locale_name) {
+  // Turkish and Azerbaijani map I/i to the dotless/dotted forms outside of ASCII
+  auto starts_with = [&locale_name](const char* prefix) {
+    return locale_name.size() >= 2 &&
+           std::tolower(static_cast<unsigned char>(locale_name[0])) == prefix[0] &&
+           std::tolower(static_cast<unsigned char>(locale_name[1])) == prefix[1] &&
+           (locale_name.size() == 2 || !std::isalpha(static_cast<unsigned char>(locale_name[2])));
+  };
+  return !starts_with("tr") && !starts_with("az");
 }
 }  // namespace string_normalizer
 
@@ -274,6 +287,7 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
   }
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
+  ascii_fast_path_ = HasAsciiFastPath(locale_name_);
   Locale locale(locale_name_);
   Utf8Converter converter(conv_error, wconv_error);
 
@@ -287,6 +301,9 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
       std::wstring wstr = converter.from_bytes(sw);
       ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
       locale.ChangeCase(compare_caseaction_, wstr);
+      if (std::all_of(wstr.cbegin(), wstr.cend(), [](wchar_t ch) { return static_cast<uint32_t>(ch) < 0x80; })) {
+        ascii_stopwords_.insert(std::string(wstr.cbegin(), wstr.cend()));
+      }
       auto p = wstopwords_.insert(std::move(wstr));
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     }
@@ -320,72 +337,136 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
-  Status status;
   Locale locale(locale_name_);
-  Utf8Converter converter(conv_error, wconv_error);
   auto* const input_data = X->template Data<std::string>();
-  using StrRef = std::reference_wrapper<const std::string>;
-  if (is_case_sensitive_) {
-    if (!stopwords_.empty()) {
-      InlinedVector<StrRef> filtered_strings;
-      filtered_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        if (0 == stopwords_.count(s)) {
-          filtered_strings.push_back(std::cref(s));
-        }
-        ++first;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // The strings are independent, so both the filtering and the case change run over ranges of
+  // strings in parallel. The cost of a string is proportional to its length.
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < C; ++i) {
+    total_bytes += input_data[i].size();
+  }
+  const double average_bytes = static_cast<double>(total_bytes) / static_cast<double>(C) + 1.0;
+  const TensorOpCost cost{average_bytes, average_bytes, average_bytes * 4.0};
+
+  // Please do not include the input text in the error message as it could
+  // be deemed as a compliance violation by teams using this operator
+  std::atomic<bool> invalid_utf8{false};
+  const Status invalid_utf8_status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                                   "Input contains invalid utf8 chars");
+
+  // Indices of the input strings that pass the stopwords filter.
+  bool filtered = false;
+  InlinedVector<size_t> kept;
+  // Case changed strings computed while comparing against case insensitive stopwords.
+  std::vector<std::string> cased;
+
+  if (is_case_sensitive_ && !stopwords_.empty()) {
+    filtered = true;
+    kept.reserve(C);
+    for (size_t i = 0; i < C; ++i) {
+      if (0 == stopwords_.count(input_data[i])) {
+        kept.push_back(i);
       }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), case_change_action_);
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
     }
-  } else {
-    if (!wstopwords_.empty()) {
-      // Filter input. When no case action is required
-      // we simply store original string references.
-      // Otherwise, we store converted strings.
-      InlinedVector<StrRef> filtered_orignal_strings;
-      InlinedVector<std::string> filtered_cased_strings;
-      filtered_orignal_strings.reserve(C);
-      filtered_cased_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
-          // Please do not include the input text in the error message as it could
-          // be deemed as a compliance violation by teams using this operator
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Input contains invalid utf8 chars");
-        }
-        locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
-          if (case_change_action_ == NONE) {
-            filtered_orignal_strings.push_back(std::cref(s));
-          } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
+  } else if (!is_case_sensitive_ && !wstopwords_.empty()) {
+    filtered = true;
+    const bool output_cased = case_change_action_ != NONE;
+    if (output_cased) {
+      cased.resize(C);
+    }
+    InlinedVector<uint8_t> keep(C, 0);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(C), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          Utf8Converter converter(conv_error, wconv_error);
+          std::string folded;
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const std::string& s = input_data[i];
+            if (ascii_fast_path_ && IsAscii(s)) {
+              folded.assign(s);
+              AsciiChangeCase(compare_caseaction_, folded);
+              keep[i] = ascii_stopwords_.count(folded) == 0;
+              if (keep[i] && output_cased) {
+                cased[i].swap(folded);
+              }
+            } else {
+              std::wstring wstr = converter.from_bytes(s);
+              if (wstr == wconv_error) {
+                invalid_utf8 = true;
+                return;
+              }
+              locale.ChangeCase(compare_caseaction_, wstr);
+              keep[i] = wstopwords_.count(wstr) == 0;
+              if (keep[i] && output_cased) {
+                cased[i] = converter.to_bytes(wstr);
+              }
+            }
           }
-        }
-        ++first;
-      }
-      if (case_change_action_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
-      } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
+        });
+    if (invalid_utf8) {
+      return invalid_utf8_status;
+    }
+    kept.reserve(C);
+    for (size_t i = 0; i < C; ++i) {
+      if (keep[i]) {
+        kept.push_back(i);
       }
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
     }
   }
-  return status;
+
+  const size_t output_count = filtered ? kept.size() : C;
+
+  std::vector<int64_t> output_dims;
+  if (N == 1) {
+    output_dims.push_back(1);
+  }
+
+  // Empty output case
+  if (output_count == 0) {
+    output_dims.push_back(1);
+    TensorShape output_shape(output_dims);
+    // This will create one empty string
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  output_dims.push_back(output_count);
+  TensorShape output_shape(output_dims);
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(output_count), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        Utf8Converter converter(conv_error, wconv_error);
+        for (std::ptrdiff_t output_idx = first; output_idx < last; ++output_idx) {
+          const size_t input_idx = filtered ? kept[output_idx] : static_cast<size_t>(output_idx);
+          std::string& output = output_data[output_idx];
+          const std::string& s = input_data[input_idx];
+          if (!cased.empty()) {
+            output = std::move(cased[input_idx]);
+          } else if (case_change_action_ == NONE) {
+            output = s;
+          } else if (ascii_fast_path_ && IsAscii(s)) {
+            // Written in place so the only allocation is the one of the output string
+            output = s;
+            AsciiChangeCase(case_change_action_, output);
+          } else {
+            std::wstring wstr = converter.from_bytes(s);
+            if (wstr == wconv_error) {
+              invalid_utf8 = true;
+              return;
+            }
+            // In place transform
+            locale.ChangeCase(case_change_action_, wstr);
+            output = converter.to_bytes(wstr);
+          }
+        }
+      });
+  if (invalid_utf8) {
+    return invalid_utf8_status;
+  }
+
+  return Status::OK();
 }
 }  // namespace onnxruntime
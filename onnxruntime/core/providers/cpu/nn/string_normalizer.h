@@ -29,9 +29,14 @@ class StringNormalizer : public OpKernel {
   CaseAction case_change_action_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
   std::string locale_name_;
+  // ASCII strings are case changed and compared without the wide conversion unless the locale
+  // maps ASCII letters differently (Turkish and Azerbaijani dotted/dotless i).
+  bool ascii_fast_path_;
   // Either if these are populated but not both
   InlinedHashSet<std::string> stopwords_;
   InlinedHashSet<std::wstring> wstopwords_;
+  // The case changed ASCII members of wstopwords_ as narrow strings
+  InlinedHashSet<std::string> ascii_stopwords_;
 };
 
 }  // namespace onnxruntime
@@ -3,11 +3,13 @@
 
 #include "tfidfvectorizer.h"
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
 
 #include <functional>
-#include <unordered_map>
+#include <limits>
+#include <string_view>
 
 namespace onnxruntime {
 
@@ -23,61 +25,66 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
+// NgramTrie holds the n-grams of the pool in a trie stored in flat tables.
+// Each item of the pool is interned to a dense token id, and the child of a node for a token
+// is found in a single hash table keyed by (node, token) instead of a map per node.
+// Node 0 is the root. For (1,2,3) the node for 2 would be a child of the node for 1 but have id == 0
+// because (1,2) does not exists. The node for 3 would have a valid id.
+struct NgramTrie {
+  // The root is never a child so this also means "no child"
+  static constexpr uint32_t kNoNode = 0;
 
-template <>
-struct NgramPart<int64_t>;
+  // child of each node for each token it is followed by, keyed by Key(node, token)
+  InlinedHashMap<uint64_t, uint32_t> children_;
+  // ngram id of each node. 0 - means no entry, search for a bigger N
+  std::vector<size_t> ids_;
 
-template <>
-struct NgramPart<std::string>;
+  NgramTrie() : ids_(1, 0) {}
 
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
+  bool Empty() const { return children_.empty(); }
 
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = std::unordered_map<int64_t, std::unique_ptr<NgramPartInt>>;
+  uint32_t Child(uint32_t node, uint32_t token) const {
+    auto hit = children_.find(Key(node, token));
+    return hit == children_.end() ? kNoNode : hit->second;
+  }
 
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
+  uint32_t AddChild(uint32_t node, uint32_t token) {
+    auto p = children_.emplace(Key(node, token), static_cast<uint32_t>(ids_.size()));
+    if (p.second) {
+      ids_.push_back(0);
+    }
+    return p.first->second;
+  }
 
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+ private:
+  static uint64_t Key(uint32_t node, uint32_t token) {
+    return (static_cast<uint64_t>(node) << 32) | token;
+  }
 };
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+// Token ids of the pool items. The string entries reference the pool_strings attribute.
+using IntTokens = InlinedHashMap<int64_t, uint32_t>;
+using StrTokens = InlinedHashMap<std::string_view, uint32_t>;
+
+// Token id of row items that are not in the pool
+constexpr uint32_t kNoToken = std::numeric_limits<uint32_t>::max();
+
+inline int64_t TokenKey(int64_t item) { return item; }
+inline std::string_view TokenKey(const std::string& item) { return item; }
 
 // Returns next ngram_id
-template <class K, class ForwardIter, class Map>
+template <class ForwardIter, class Tokens>
 inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
+                            Tokens& tokens, NgramTrie& trie) {
   for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
-      }
-      ++n;
-      m = &p.first->second->leafs_;
+    uint32_t node = 0;
+    for (size_t n = 0; n < ngram_size; ++n, ++first) {
+      const uint32_t token = tokens.emplace(TokenKey(*first), static_cast<uint32_t>(tokens.size())).first->second;
+      node = trie.AddChild(node, token);
     }
+    ORT_ENFORCE(trie.ids_[node] == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+    trie.ids_[node] = ngram_id;
+    ++ngram_id;
   }
   return ngram_id;
 }
@@ -89,10 +96,6 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -127,11 +130,11 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float> weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // Token ids of the pool_strings or pool_int64s entries
+  StrTokens str_tokens_;
+  IntTokens int64_tokens_;
+  // All the n-grams of the pool that are in [min_gram_length, max_gram_length]
+  NgramTrie trie_;
 
   size_t output_size_ = 0;
 
@@ -237,9 +240,11 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = PopulateGrams(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                   impl_->int64_tokens_, impl_->trie_);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = PopulateGrams(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                   impl_->str_tokens_, impl_->trie_);
         }
       } else {
         ngram_id += ngrams;
@@ -313,65 +318,60 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
 void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
                                   std::vector<uint32_t>& frequencies) const {
   auto X = ctx->Input<Tensor>(0);
-  const auto elem_size = X->DataType()->Size();
+  const auto& impl = *impl_;
 
-  const void* const row_begin = AdvanceElementPtr(X->DataRaw(), row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
+  // Look up the token of each item of the row once, so that matching the n-grams
+  // at each start position and skip distance only has to follow the trie
+  std::vector<uint32_t> tokens(row_size);
+  const size_t row_offset = static_cast<size_t>(row_num) * row_size;
+  auto intern = [&tokens, row_offset, row_size](const auto* items, const auto& token_map) {
+    for (size_t i = 0; i < row_size; ++i) {
+      auto hit = token_map.find(TokenKey(items[row_offset + i]));
+      tokens[i] = hit == token_map.end() ? kNoToken : hit->second;
+    }
+  };
+  if (X->IsDataTypeString()) {
+    intern(X->Data<std::string>(), impl.str_tokens_);
+  } else if (X->IsDataType<int32_t>()) {
+    auto hit_end = impl.int64_tokens_.end();
+    const int32_t* items = X->Data<int32_t>() + row_offset;
+    for (size_t i = 0; i < row_size; ++i) {
+      auto hit = impl.int64_tokens_.find(int64_t{items[i]});
+      tokens[i] = hit == hit_end ? kNoToken : hit->second;
+    }
+  } else {
+    intern(X->Data<int64_t>(), impl.int64_tokens_);
+  }
 
-  const auto& impl = *impl_;
+  const auto& trie = impl.trie_;
   const auto max_gram_length = impl.max_gram_length_;
   const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
   auto start_ngram_size = impl.min_gram_length_;
+  const ptrdiff_t row_end = static_cast<ptrdiff_t>(row_size);
 
   for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
-
-    while (ngram_start < ngram_row_end) {
+    for (ptrdiff_t ngram_start = 0; ngram_start < row_end; ++ngram_start) {
       // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, skip_distance * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
+      if (ngram_start + skip_distance * (start_ngram_size - 1) >= row_end) {
         break;
       }
 
-      auto ngram_item = ngram_start;
-      if (X->IsDataTypeString()) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          str_map = &hit->second->leafs_;
+      uint32_t node = 0;
+      ptrdiff_t item = ngram_start;
+      for (auto ngram_size = 1;
+           ngram_size <= max_gram_length && item < row_end;
+           ++ngram_size, item += skip_distance) {
+        if (tokens[item] == kNoToken) {
+          break;
         }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (X->IsDataType<int32_t>()) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          int_map = &hit->second->leafs_;
+        node = trie.Child(node, tokens[item]);
+        if (node == NgramTrie::kNoNode) {
+          break;
+        }
+        if (ngram_size >= start_ngram_size && trie.ids_[node] != 0) {
+          impl.IncrementCount(trie.ids_[node], row_num, frequencies);
         }
       }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
     }
     // We count UniGrams only once since they are not affected
     // by skip distance
@@ -417,8 +417,9 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   frequencies.resize(num_rows * impl_->output_size_, 0);
 
   if (total_items == 0 ||
-      (X->IsDataTypeString() && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+      impl_->trie_.Empty() ||
+      (X->IsDataTypeString() && impl_->str_tokens_.empty()) ||
+      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_tokens_.empty())) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
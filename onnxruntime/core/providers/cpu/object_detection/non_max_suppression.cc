@@ -13,6 +13,7 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
+#include "core/platform/threadpool.h"
 #include <queue>
 #include <utility>
 //TODO:fix the warnings
@@ -39,6 +40,111 @@ ONNX_OPERATOR_KERNEL_EX(
 
 using namespace nms_helpers;
 
+namespace {
+
+// Corners and areas of boxes, in separate arrays so that a candidate box is compared with a tile of selected boxes in
+// a loop the compiler vectorizes. They are computed as SuppressByIOU does, so that the results are the same.
+struct BoxCorners {
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+
+  void reserve(size_t n) {
+    x_min.reserve(n);
+    y_min.reserve(n);
+    x_max.reserve(n);
+    y_max.reserve(n);
+    area.reserve(n);
+  }
+
+  void clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  size_t size() const { return area.size(); }
+
+  void push_back(float box_x_min, float box_y_min, float box_x_max, float box_y_max) {
+    x_min.push_back(box_x_min);
+    y_min.push_back(box_y_min);
+    x_max.push_back(box_x_max);
+    y_max.push_back(box_y_max);
+    area.push_back((box_x_max - box_x_min) * (box_y_max - box_y_min));
+  }
+
+  void push_back(const BoxCorners& other, size_t index) {
+    x_min.push_back(other.x_min[index]);
+    y_min.push_back(other.y_min[index]);
+    x_max.push_back(other.x_max[index]);
+    y_max.push_back(other.y_max[index]);
+    area.push_back(other.area[index]);
+  }
+};
+
+void ComputeBoxCorners(const float* boxes, int64_t num_boxes, int64_t center_point_box, BoxCorners& corners) {
+  corners.clear();
+  corners.reserve(static_cast<size_t>(num_boxes));
+  for (int64_t i = 0; i < num_boxes; ++i, boxes += 4) {
+    float x_min, y_min, x_max, y_max;
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2]
+      MaxMin(boxes[1], boxes[3], x_min, x_max);
+      MaxMin(boxes[0], boxes[2], y_min, y_max);
+    } else {
+      // boxes data format [x_center, y_center, width, height]
+      const float width_half = boxes[2] / 2;
+      const float height_half = boxes[3] / 2;
+      x_min = boxes[0] - width_half;
+      x_max = boxes[0] + width_half;
+      y_min = boxes[1] - height_half;
+      y_max = boxes[1] + height_half;
+    }
+    corners.push_back(x_min, y_min, x_max, y_max);
+  }
+}
+
+// Whether the IOU of box `index` of `boxes` with any of `selected` exceeds iou_threshold.
+bool SuppressBySelected(const BoxCorners& boxes, size_t index, const BoxCorners& selected, float iou_threshold) {
+  constexpr size_t kTileSize = 16;
+
+  const float x_min = boxes.x_min[index];
+  const float y_min = boxes.y_min[index];
+  const float x_max = boxes.x_max[index];
+  const float y_max = boxes.y_max[index];
+  const float area = boxes.area[index];
+  if (!(area > .0f)) {
+    return false;
+  }
+
+  const size_t num_selected = selected.size();
+  for (size_t tile_begin = 0; tile_begin < num_selected; tile_begin += kTileSize) {
+    const size_t tile_end = std::min(tile_begin + kTileSize, num_selected);
+    // no early exit inside a tile, so that its IOUs are computed with SIMD instructions
+    bool suppressed = false;
+    for (size_t i = tile_begin; i < tile_end; ++i) {
+      const float intersection_width =
+          std::max(std::min(x_max, selected.x_max[i]) - std::max(x_min, selected.x_min[i]), .0f);
+      const float intersection_height =
+          std::max(std::min(y_max, selected.y_max[i]) - std::max(y_min, selected.y_min[i]), .0f);
+      const float intersection_area = intersection_width * intersection_height;
+      const float union_area = area + selected.area[i] - intersection_area;
+      suppressed |= (intersection_area > .0f) & (selected.area[i] > .0f) & (union_area > .0f) &
+                    (intersection_area / union_area > iou_threshold);
+    }
+    if (suppressed) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 // This works for both CPU and GPU.
 // CUDA kernel declare OrtMemTypeCPUInput for max_output_boxes_per_class(2), iou_threshold(3) and score_threshold(4)
 Status NonMaxSuppressionBase::PrepareCompute(OpKernelContext* ctx, PrepareContext& pc) {
@@ -145,54 +251,72 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto center_point_box = GetCenterPointBox();
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
+  std::vector<BoxCorners> batch_corners(static_cast<size_t>(pc.num_batches_));
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+    ComputeBoxCorners(boxes_data + (batch_index * pc.num_boxes_ * 4), pc.num_boxes_, center_point_box,
+                      batch_corners[batch_index]);
+  }
+
+  // The batches and classes are independent, each writes its selected indices to its own vector and the vectors are
+  // concatenated in order afterwards, so that the output doesn't depend on the number of threads.
+  const int64_t num_batch_classes = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<SelectedIndex>> selected_indices_per_class(static_cast<size_t>(num_batch_classes));
+  const size_t max_selected = std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_);
+
+  // cost of the score filter and the heap construction, the IOUs are extra
+  const double cost = static_cast<double>(pc.num_boxes_) * 8.0;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_batch_classes), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        BoxCorners selected_boxes_inside_class;
+        selected_boxes_inside_class.reserve(max_selected);
+
+        for (std::ptrdiff_t batch_class = begin; batch_class != end; ++batch_class) {
+          const int64_t batch_index = batch_class / pc.num_classes_;
+          const int64_t class_index = batch_class % pc.num_classes_;
+          const BoxCorners& corners = batch_corners[batch_index];
+          std::vector<SelectedIndex>& selected_indices = selected_indices_per_class[batch_class];
+
+          std::vector<BoxInfoPtr> candidate_boxes;
+          candidate_boxes.reserve(pc.num_boxes_);
+
+          // Filter by score_threshold_
+          const auto* class_scores = scores_data + batch_class * pc.num_boxes_;
+          if (pc.score_threshold_ != nullptr) {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+              if (*class_scores > score_threshold) {
+                candidate_boxes.emplace_back(*class_scores, box_index);
+              }
+            }
+          } else {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+              candidate_boxes.emplace_back(*class_scores, box_index);
+            }
           }
+          std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(),
+                                                                                std::move(candidate_boxes));
+
+          selected_boxes_inside_class.clear();
+          // Get the next box with top score, filter by iou_threshold
+          while (!sorted_boxes.empty() &&
+                 static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
+            const auto box_index = static_cast<size_t>(sorted_boxes.top().index_);
+
+            // Check with existing selected boxes for this class,
+            // suppress if exceed the IOU (Intersection Over Union) threshold
+            if (!SuppressBySelected(corners, box_index, selected_boxes_inside_class, iou_threshold)) {
+              selected_boxes_inside_class.push_back(corners, box_index);
+              selected_indices.emplace_back(batch_index, class_index, static_cast<int64_t>(box_index));
+            }
+            sorted_boxes.pop();
+          }  //while
         }
+      });
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+  std::vector<SelectedIndex> selected_indices;
+  for (const auto& class_selected_indices : selected_indices_per_class) {
+    selected_indices.insert(selected_indices.end(), class_selected_indices.begin(), class_selected_indices.end());
+  }
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
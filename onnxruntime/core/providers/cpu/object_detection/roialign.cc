@@ -153,6 +153,31 @@ static void PreCalcForBilinearInterpolate(const int64_t height, const int64_t wi
   }
 }
 
+// Average pools kChannelBlock channels of a ROI at a time, so that each pre-calculated sample is loaded once for
+// all the channels of the block.
+template <typename T, int64_t kChannelBlock>
+static void RoiAlignAvgPoolChannels(const T* const* offset_bottom_data, T* const* top_data, int64_t pooled_size,
+                                    int64_t samples_per_bin, const std::vector<PreCalc<T>>& pre_calc) {
+  const T count = static_cast<T>(std::max(samples_per_bin, static_cast<int64_t>(1)));
+  int64_t pre_calc_index = 0;
+
+  for (int64_t index = 0; index < pooled_size; index++) {
+    T output_val[kChannelBlock] = {};
+    for (int64_t i = 0; i < samples_per_bin; i++) {
+      const auto& pc = pre_calc[pre_calc_index];
+      for (int64_t c = 0; c < kChannelBlock; c++) {
+        const T* data = offset_bottom_data[c];
+        output_val[c] += pc.w1 * data[pc.pos1] + pc.w2 * data[pc.pos2] +
+                         pc.w3 * data[pc.pos3] + pc.w4 * data[pc.pos4];
+      }
+      pre_calc_index += 1;
+    }
+    for (int64_t c = 0; c < kChannelBlock; c++) {
+      top_data[c][index] = output_val[c] / count;
+    }
+  }
+}
+
 template <typename T>
 void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, float spatial_scale, int64_t height,
                      int64_t width, int64_t sampling_ratio, const T* bottom_rois, int64_t num_roi_cols, T* top_data,
@@ -161,11 +186,20 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
   int64_t channels = output_shape[1];
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
+  const int64_t pooled_size = pooled_height * pooled_width;
 
-  //100 is a random chosed value, need be tuned
-  double cost = static_cast<double>(channels * pooled_width * pooled_height * 100);
+  // Each output reads four input values per sample. The adaptive sampling grid depends on the ROI size, in which
+  // case a 2x2 grid is assumed.
+  const int64_t samples_per_bin_estimate = (sampling_ratio > 0) ? sampling_ratio * sampling_ratio : 4;
+  const double outputs_per_roi = static_cast<double>(channels * pooled_size);
+  const TensorOpCost cost{outputs_per_roi * samples_per_bin_estimate * 4 * sizeof(T),
+                          outputs_per_roi * sizeof(T),
+                          outputs_per_roi * samples_per_bin_estimate * 8};
 
   ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
+    // The pre-calculated samples of the ROIs of this range, which reuse the buffer.
+    std::vector<PreCalc<T>> pre_calc;
+
     for (; n != end; ++n) {
       int64_t index_n = n * channels * pooled_width * pooled_height;
 
@@ -195,56 +229,67 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
       int64_t roi_bin_grid_w =
           (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
 
-      // We do average (integral) pooling inside a bin
-      const int64_t count = std::max(roi_bin_grid_h * roi_bin_grid_w, static_cast<int64_t>(1)); // e.g. = 4
-
       // we want to precalculate indices and weights shared by all channels,
       // this is the key point of optimization
-      std::vector<PreCalc<T>> pre_calc(roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
+      pre_calc.resize(static_cast<size_t>(roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height));
       PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
                                     roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
                                     roi_bin_grid_w, pre_calc);
 
+      const T* roi_bottom_data = bottom_data + static_cast<int64_t>(roi_batch_ind * channels * height * width);
+
+      if (mode == RoiAlignMode::avg) {  // avg pooling
+        // We do average (integral) pooling inside a bin
+        const int64_t samples_per_bin = roi_bin_grid_h * roi_bin_grid_w;
+        constexpr int64_t kChannelBlock = 4;
+
+        int64_t c = 0;
+        for (; c + kChannelBlock <= channels; c += kChannelBlock) {
+          const T* offset_bottom_data[kChannelBlock];
+          T* offset_top_data[kChannelBlock];
+          for (int64_t i = 0; i < kChannelBlock; i++) {
+            offset_bottom_data[i] = roi_bottom_data + (c + i) * height * width;
+            offset_top_data[i] = top_data + index_n + (c + i) * pooled_size;
+          }
+          RoiAlignAvgPoolChannels<T, kChannelBlock>(offset_bottom_data, offset_top_data, pooled_size,
+                                                    samples_per_bin, pre_calc);
+        }
+        for (; c < channels; c++) {
+          const T* offset_bottom_data = roi_bottom_data + c * height * width;
+          T* offset_top_data = top_data + index_n + c * pooled_size;
+          RoiAlignAvgPoolChannels<T, 1>(&offset_bottom_data, &offset_top_data, pooled_size,
+                                        samples_per_bin, pre_calc);
+        }
+        continue;
+      }
+
       for (int64_t c = 0; c < channels; c++) {
         int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-        const T* offset_bottom_data =
-            bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
+        const T* offset_bottom_data = roi_bottom_data + c * height * width;
         int64_t pre_calc_index = 0;
 
         for (int64_t ph = 0; ph < pooled_height; ph++) {
           for (int64_t pw = 0; pw < pooled_width; pw++) {
             int64_t index = index_n_c + ph * pooled_width + pw;
 
+            // max pooling
             T output_val = 0.;
-            if (mode == RoiAlignMode::avg) {  // avg pooling
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[pre_calc_index];
-                  output_val += pc.w1 * offset_bottom_data[pc.pos1] + pc.w2 * offset_bottom_data[pc.pos2] +
-                                pc.w3 * offset_bottom_data[pc.pos3] + pc.w4 * offset_bottom_data[pc.pos4];
-
-                  pre_calc_index += 1;
-                }
-              }
-              output_val /= count;
-            } else {  // max pooling
-              bool max_flag = false;
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[pre_calc_index];
-                  T val = std::max(
-                      std::max(std::max(pc.w1 * offset_bottom_data[pc.pos1], pc.w2 * offset_bottom_data[pc.pos2]),
-                               pc.w3 * offset_bottom_data[pc.pos3]),
-                      pc.w4 * offset_bottom_data[pc.pos4]);
-                  if (!max_flag) {
-                    output_val = val;
-                    max_flag = true;
-                  } else {
-                    output_val = std::max(output_val, val);
-                  }
-
-                  pre_calc_index += 1;
+            bool max_flag = false;
+            for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
+              for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
+                const auto& pc = pre_calc[pre_calc_index];
+                T val = std::max(
+                    std::max(std::max(pc.w1 * offset_bottom_data[pc.pos1], pc.w2 * offset_bottom_data[pc.pos2]),
+                             pc.w3 * offset_bottom_data[pc.pos3]),
+                    pc.w4 * offset_bottom_data[pc.pos4]);
+                if (!max_flag) {
+                  output_val = val;
+                  max_flag = true;
+                } else {
+                  output_val = std::max(output_val, val);
                 }
+
+                pre_calc_index += 1;
               }
             }
 
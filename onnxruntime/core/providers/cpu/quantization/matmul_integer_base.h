@@ -29,6 +29,11 @@ class MatMulIntegerBase : public OpKernel {
       auto a_elem_type = Node().InputDefs()[GetAIdx()]->TypeAsProto()->tensor_type().elem_type();
       bool a_is_signed = ONNX_NAMESPACE::TensorProto_DataType_INT8 == a_elem_type;
 
+      // the weight of int16 activations is multiplied by a GEMM that packs it on the fly
+      if (ONNX_NAMESPACE::TensorProto_DataType_INT16 == a_elem_type) {
+        return Status::OK();
+      }
+
       b_is_signed_ = tensor.IsDataType<int8_t>();
 
       size_t K = static_cast<size_t>(b_shape_[0]);
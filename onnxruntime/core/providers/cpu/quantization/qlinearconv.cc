@@ -1,10 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <memory>
+
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
 #include "core/common/cpuid_info.h"
 #include "core/common/safeint.h"
+#include "core/platform/ort_mutex.h"
 #include "core/providers/common.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
@@ -36,6 +39,8 @@ class QLinearConv : public OpKernel {
  public:
   explicit QLinearConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
     channels_last_ = (info.GetAttrOrDefault<int64_t>("channels_last", static_cast<int64_t>(0)) != 0);
+    const auto& input_defs = info.node().InputDefs();
+    has_sum_ = input_defs.size() > InputTensors::IN_SUM && input_defs[InputTensors::IN_SUM]->Exists();
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -58,7 +63,10 @@ class QLinearConv : public OpKernel {
     IN_W_ZERO_POINT = 5,
     IN_Y_SCALE = 6,
     IN_Y_ZERO_POINT = 7,
-    IN_BIAS = 8
+    IN_BIAS = 8,
+    IN_SUM = 9,
+    IN_SUM_SCALE = 10,
+    IN_SUM_ZERO_POINT = 11
   };
 
   enum OutputTensors : int {
@@ -123,6 +131,22 @@ class QLinearConv : public OpKernel {
     return output_scales;
   }
 
+  // The scale of the fused sum is relative to the output scale, like the scales from ComputeOutputScale.
+  static void ComputeSumParams(OpKernelContext* context,
+                               float& sum_scale_value,
+                               ActType& sum_zero_point_value) {
+    const Tensor* Sum_scale = context->Input<Tensor>(InputTensors::IN_SUM_SCALE);
+    const Tensor* Sum_zero_point = context->Input<Tensor>(InputTensors::IN_SUM_ZERO_POINT);
+    const Tensor* Y_scale = context->Input<Tensor>(InputTensors::IN_Y_SCALE);
+    ORT_ENFORCE(Sum_scale != nullptr && IsScalarOr1ElementVector(Sum_scale),
+                "QLinearConv : sum scale must be a scalar or 1D tensor of size 1");
+    ORT_ENFORCE(Sum_zero_point == nullptr || IsScalarOr1ElementVector(Sum_zero_point),
+                "QLinearConv : sum zero point must be a scalar or 1D tensor of size 1");
+
+    sum_scale_value = *(Sum_scale->template Data<float>()) / *(Y_scale->template Data<float>());
+    sum_zero_point_value = Sum_zero_point != nullptr ? *(Sum_zero_point->template Data<ActType>()) : ActType(0);
+  }
+
   static int32_t ComputeTaskCount(int64_t output_image_size, int64_t group_output_channels, int64_t kernel_dim) {
     // Replicate the logic from MlasGemmU8X8Schedule to control the number of
     // worker threads used for the convolution.
@@ -174,8 +198,9 @@ class QLinearConv : public OpKernel {
       return false;
     }
 
-    // Try indirect conv packing
-    size_t packed_size = MlasConvSymPackWSize(group_count, group_input_channels, group_output_channels, kernel_size, std::is_signed<ActType>::value);
+    // Try indirect conv packing. The indirect conv kernels requantize their own output, so a fused sum
+    // needs the int32 output of the GEMM paths.
+    size_t packed_size = has_sum_ ? 0 : MlasConvSymPackWSize(group_count, group_input_channels, group_output_channels, kernel_size, std::is_signed<ActType>::value);
     if (packed_size != 0) {
       const Tensor* B = nullptr;
       Info().TryGetConstantInput(8, &B);
@@ -282,7 +307,18 @@ class QLinearConv : public OpKernel {
   bool is_symmetric_conv_{false};
   bool is_symmetric_gemm_{false};
   bool channels_last_{false};
+  bool has_sum_{false};
   std::vector<int32_t> column_sums_;
+
+  // The im2col indirection buffer of the most recent input shape, stored as element offsets into a
+  // channels last input image with kIndirectionPaddingOffset marking the padding. The offsets only
+  // depend on the shapes and attributes, so a model with fixed shapes computes them once per session
+  // and rebases them onto the input of each image. use indirection_mutex_ to ensure Compute() can be
+  // called concurrently.
+  static constexpr ptrdiff_t kIndirectionPaddingOffset = -1;
+  mutable onnxruntime::OrtMutex indirection_mutex_;
+  mutable TensorShapeVector indirection_dims_;
+  mutable std::shared_ptr<const std::vector<ptrdiff_t>> indirection_offsets_;
 };
 
 // uint8_t kernel supports weight being either uint8_t or int8_t
@@ -555,6 +591,17 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
     return Status::OK();
   }
 
+  // The optional sum is added before the output is requantized, which fuses a following QLinearAdd
+  // without requantizing the convolution result in between.
+  const Tensor* Sum = has_sum_ ? context->Input<Tensor>(InputTensors::IN_SUM) : nullptr;
+  float sum_scale_value = 0.0f;
+  ActType sum_zero_point_value = 0;
+  if (Sum != nullptr) {
+    ORT_RETURN_IF_NOT(Sum->Shape() == Y->Shape(), "QLinearConv : sum shape ", Sum->Shape(),
+                      " must match the output shape ", Y->Shape());
+    ComputeSumParams(context, sum_scale_value, sum_zero_point_value);
+  }
+
   const int64_t input_image_size = input_shape.Size();
   const int64_t output_image_size = output_shape.Size();
   const int64_t kernel_size = TensorShape(kernel_shape).Size();
@@ -614,10 +661,12 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
 
   const auto* Xdata = X->template Data<ActType>();
   const auto* Bdata = B != nullptr ? B->template Data<int32_t>() : nullptr;
+  const auto* Sumdata = Sum != nullptr ? Sum->template Data<ActType>() : nullptr;
   auto* Ydata = Y->template MutableData<ActType>();
 
   BufferUniquePtr transpose_input_buffer;
   BufferUniquePtr transpose_output_buffer;
+  BufferUniquePtr transpose_sum_buffer;
 
   // Allocate temporary buffers for transposing to channels last format.
   if (!channels_last_) {
@@ -625,10 +674,15 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
     transpose_input_buffer = BufferUniquePtr(transpose_input, BufferDeleter(alloc));
     auto* transpose_output = alloc->Alloc(SafeInt<size_t>(sizeof(ActType)) * Y_offset);
     transpose_output_buffer = BufferUniquePtr(transpose_output, BufferDeleter(alloc));
+    if (Sumdata != nullptr) {
+      auto* transpose_sum = alloc->Alloc(SafeInt<size_t>(sizeof(ActType)) * Y_offset);
+      transpose_sum_buffer = BufferUniquePtr(transpose_sum, BufferDeleter(alloc));
+    }
   }
 
   BufferUniquePtr col_buffer;
   BufferUniquePtr indirection_buffer;
+  std::shared_ptr<const std::vector<ptrdiff_t>> indirection_offsets;
   std::vector<ActType> padding_data;
 
   bool use_indirection_buffer = false;
@@ -640,7 +694,8 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
     } else {
       // Pointwise convolutions can use the original input tensor in place,
       // otherwise a temporary buffer is required for the im2col transform.
-      int64_t group_col_buffer_size = (kernel_rank > 2) ? group_count * col_buffer_size : col_buffer_size;
+      // The groups have separate buffers so that their GEMMs can be batched.
+      int64_t group_col_buffer_size = group_count * col_buffer_size;
       group_col_buffer_size += MLAS_SYMM_QGEMM_BUF_OVERRUN;
       auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(ActType)) * group_col_buffer_size);
       col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
@@ -652,6 +707,40 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
     auto* indirection_data = alloc->Alloc(SafeInt<size_t>(sizeof(const ActType*)) * kernel_size * output_image_size);
     indirection_buffer = BufferUniquePtr(indirection_data, BufferDeleter(alloc));
     padding_data.resize(static_cast<size_t>(C), X_zero_point_value);
+
+    // The offsets only need to be computed again if the input or kernel shapes change.
+    TensorShapeVector dims(input_shape.GetDims().begin(), input_shape.GetDims().end());
+    dims.push_back(C);
+    dims.insert(dims.end(), kernel_shape.begin(), kernel_shape.end());
+
+    std::lock_guard<onnxruntime::OrtMutex> lock(indirection_mutex_);
+    if (dims != indirection_dims_ || !indirection_offsets_) {
+      // Any input image serves as the base of the offsets, so use the first one.
+      std::vector<const ActType*> indirection_pointers(SafeInt<size_t>(kernel_size) * output_image_size);
+      math::Im2col<ActType, StorageOrder::NHWC>()(
+          Xdata,
+          C,
+          input_shape.GetDims().data(),
+          output_shape.GetDims().data(),
+          kernel_shape.data(),
+          strides.data(),
+          dilations.data(),
+          pads.data(),
+          static_cast<ptrdiff_t>(kernel_rank),
+          0,
+          output_image_size,
+          indirection_pointers.data(),
+          padding_data.data());
+
+      auto offsets = std::make_shared<std::vector<ptrdiff_t>>(indirection_pointers.size());
+      for (size_t i = 0; i < indirection_pointers.size(); i++) {
+        (*offsets)[i] = indirection_pointers[i] == padding_data.data() ? kIndirectionPaddingOffset
+                                                                        : indirection_pointers[i] - Xdata;
+      }
+      indirection_offsets_ = std::move(offsets);
+      indirection_dims_ = std::move(dims);
+    }
+    indirection_offsets = indirection_offsets_;
   }
 
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
@@ -664,6 +753,7 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
 
   for (int64_t image_id = 0; image_id < N; ++image_id) {
     const auto* input_data = Xdata;
+    const auto* sum_data = Sumdata;
     auto* output_data = Ydata;
 
     if (!channels_last_) {
@@ -675,6 +765,15 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
           static_cast<size_t>(input_image_size));
       input_data = static_cast<ActType*>(transpose_input_buffer.get());
       output_data = static_cast<ActType*>(transpose_output_buffer.get());
+
+      if (Sumdata != nullptr) {
+        MlasTranspose(
+            Sumdata,
+            static_cast<ActType*>(transpose_sum_buffer.get()),
+            static_cast<size_t>(M),
+            static_cast<size_t>(output_image_size));
+        sum_data = static_cast<ActType*>(transpose_sum_buffer.get());
+      }
     }
 
     // Threaded implementation of ND convolution is not yet supported, so
@@ -710,20 +809,14 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
       ActType const** worker_indirection_buffer = nullptr;
       if (indirection_buffer) {
         worker_indirection_buffer = static_cast<ActType const**>(indirection_buffer.get()) + output_start * kernel_size;
-        math::Im2col<ActType, StorageOrder::NHWC>()(
-            input_data,
-            C,
-            input_shape.GetDims().data(),
-            output_shape.GetDims().data(),
-            kernel_shape.data(),
-            strides.data(),
-            dilations.data(),
-            pads.data(),
-            static_cast<ptrdiff_t>(kernel_rank),
-            output_start,
-            output_count,
-            worker_indirection_buffer,
-            padding_data.data());
+        // Rebase the cached offsets onto the input of this image.
+        const ptrdiff_t* worker_offsets = indirection_offsets->data() + output_start * kernel_size;
+        const int64_t worker_indirection_count = output_count * kernel_size;
+        for (int64_t i = 0; i < worker_indirection_count; i++) {
+          worker_indirection_buffer[i] = worker_offsets[i] == kIndirectionPaddingOffset
+                                             ? padding_data.data()
+                                             : input_data + worker_offsets[i];
+        }
       }
 
       auto* worker_output = output_data + output_start * M;
@@ -770,6 +863,22 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
             static_cast<size_t>(output_count),
             static_cast<size_t>(kernel_size));
       } else {
+        // The GEMMs of the groups have the same shape, so they are issued as a single batch.
+        MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
+        gemm_shape.M = static_cast<size_t>(output_count);
+        gemm_shape.N = static_cast<size_t>(group_output_channels);
+        gemm_shape.K = static_cast<size_t>(kernel_dim);
+        gemm_shape.AIsSigned = std::is_signed<ActType>::value;
+        gemm_shape.BIsSigned = is_W_signed;
+
+        InlinedVector<MLAS_SYMM_QGEMM_DATA_PARAMS> symm_gemm_params;
+        InlinedVector<MLAS_GEMM_QUANT_DATA_PARAMS> gemm_params;
+        if (is_symmetric_gemm_) {
+          symm_gemm_params.resize(static_cast<size_t>(group_count));
+        } else {
+          gemm_params.resize(static_cast<size_t>(group_count));
+        }
+
         for (int64_t group_id = 0; group_id < group_count; ++group_id) {
           // Prepare the im2col transformation or use the input buffer directly for
           // pointwise convolutions.
@@ -777,7 +886,8 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
           const uint8_t* AData;
           size_t lda;
           if (col_buffer) {
-            auto* worker_col_buffer = static_cast<ActType*>(col_buffer.get()) + output_start * kernel_dim;
+            auto* worker_col_buffer = static_cast<ActType*>(col_buffer.get()) + group_id * col_buffer_size +
+                                      output_start * kernel_dim;
             if (kernel_rank == 2) {
               math::Im2col<ActType, StorageOrder::NHWC>()(
                   group_input_data,
@@ -818,10 +928,8 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
                   output_count,
                   worker_col_buffer,
                   X_zero_point_value);
-            } else {
-              // Use the im2col buffer prepared outside the thread, indexed by group.
-              worker_col_buffer += group_id * col_buffer_size;
             }
+            // Otherwise use the im2col buffer prepared outside the thread.
             AData = reinterpret_cast<const uint8_t*>(worker_col_buffer);
             lda = static_cast<size_t>(kernel_dim);
           } else {
@@ -829,40 +937,57 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
             lda = static_cast<size_t>(C);
           }
 
-          MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
-          gemm_shape.M = static_cast<size_t>(output_count);
-          gemm_shape.N = static_cast<size_t>(group_output_channels);
-          gemm_shape.K = static_cast<size_t>(kernel_dim);
-          gemm_shape.AIsSigned = std::is_signed<ActType>::value;
-          gemm_shape.BIsSigned = is_W_signed;
-
           if (is_symmetric_gemm_) {
-            MLAS_SYMM_QGEMM_DATA_PARAMS symm_gemm;
+            MLAS_SYMM_QGEMM_DATA_PARAMS& symm_gemm = symm_gemm_params[group_id];
             symm_gemm.A = AData;
             symm_gemm.lda = lda;
             symm_gemm.C = worker_gemm_output + group_id * group_output_channels;
             symm_gemm.ldc = static_cast<size_t>(M);
-            symm_gemm.B = static_cast<const int8_t*>(packed_W_buffer_.get()) + group_id * packed_W_size_,
-            MlasSymmQgemmBatch(gemm_shape, &symm_gemm, 1, nullptr);
+            symm_gemm.B = static_cast<const int8_t*>(packed_W_buffer_.get()) + group_id * packed_W_size_;
           } else {
-            MLAS_GEMM_QUANT_DATA_PARAMS gemm_params;
-            gemm_params.ZeroPointA = static_cast<uint8_t>(X_zero_point_value);
-            gemm_params.A = AData;
-            gemm_params.lda = lda;
+            MLAS_GEMM_QUANT_DATA_PARAMS& group_gemm = gemm_params[group_id];
+            group_gemm.ZeroPointA = static_cast<uint8_t>(X_zero_point_value);
+            group_gemm.A = AData;
+            group_gemm.lda = lda;
             if (packed_W_buffer_) {
-              gemm_params.B = static_cast<const int8_t*>(packed_W_buffer_.get()) + group_id * packed_W_size_,
-              gemm_params.BIsPacked = true;
+              group_gemm.B = static_cast<const int8_t*>(packed_W_buffer_.get()) + group_id * packed_W_size_;
+              group_gemm.BIsPacked = true;
             } else {
-              gemm_params.B = reordered_W + group_id * group_output_channels,
-              gemm_params.ldb = static_cast<size_t>(M);
+              group_gemm.B = reordered_W + group_id * group_output_channels;
+              group_gemm.ldb = static_cast<size_t>(M);
             }
-            gemm_params.ZeroPointB = &W_zero_point_value;
-            gemm_params.C = worker_gemm_output + group_id * group_output_channels;
-            gemm_params.ldc = static_cast<size_t>(M);
-
-            MlasGemm(gemm_shape, gemm_params, nullptr);
+            group_gemm.ZeroPointB = &W_zero_point_value;
+            group_gemm.C = worker_gemm_output + group_id * group_output_channels;
+            group_gemm.ldc = static_cast<size_t>(M);
           }
         }
+
+        if (is_symmetric_gemm_) {
+          MlasSymmQgemmBatch(gemm_shape, symm_gemm_params.data(), symm_gemm_params.size(), nullptr);
+        } else {
+          MlasGemmBatch(gemm_shape, gemm_params.data(), gemm_params.size(), nullptr);
+        }
+      }
+
+      if (sum_data != nullptr) {
+        MlasRequantizeOutputAdd(
+            worker_gemm_output,
+            static_cast<size_t>(M),
+            sum_data + output_start * M,
+            static_cast<size_t>(M),
+            worker_output,
+            static_cast<size_t>(M),
+            Bdata,
+            output_scales.data(),
+            output_scales.size() > 1,
+            sum_scale_value,
+            sum_zero_point_value,
+            Y_zero_point_value,
+            0,
+            0,
+            static_cast<size_t>(output_count),
+            static_cast<size_t>(M));
+        return;
       }
 
       MlasRequantizeOutput(
@@ -893,6 +1018,9 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
 
     Xdata += X_offset;
     Ydata += Y_offset;
+    if (Sumdata != nullptr) {
+      Sumdata += Y_offset;
+    }
   }
 
   return Status::OK();
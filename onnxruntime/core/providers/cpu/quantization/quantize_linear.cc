@@ -165,4 +165,8 @@ Status QuantizeLinear<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+// int16 is only registered in the com.microsoft domain, which has no opset of its own for these kernels.
+template class DequantizeLinear<int16_t>;
+template class QuantizeLinear<int16_t>;
+
 }  // namespace onnxruntime
@@ -268,6 +268,23 @@ static void ValidateFastReduceRKR(const gsl::span<const int64_t>& fast_shape, co
   ORT_ENFORCE(fast_shape[1] == output.Shape().Size(), "Output size mismatch.");
 }
 
+static void ValidateFastReduceR(const gsl::span<const int64_t>& fast_shape, const Tensor& output) {
+  ORT_ENFORCE(fast_shape.size() == 1, "Only works on vectors.");
+  ORT_ENFORCE(output.Shape().Size() == 1, "Output size mismatch.");
+}
+
+// The KRK fast reductions split the inner dimension into blocks, so they are used when there are enough
+// blocks for the threads. The former implementation is faster otherwise.
+static bool UseFastReduceKRK(const gsl::span<const int64_t>& fast_shape, concurrency::ThreadPool* tp) {
+  return FastReduceKRKTaskCount(fast_shape[0], fast_shape[2]) >=
+         concurrency::ThreadPool::DegreeOfParallelism(tp);
+}
+
+// A single output is worth splitting once there is more than one block of elements.
+static bool UseFastReduceR(const gsl::span<const int64_t>& fast_shape) {
+  return fast_shape[0] > kFastReduceRBlockSize;
+}
+
 void ReduceAggregatorBase::FastReduceKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*) {
   ValidateMustBeOverloaded();
 }
@@ -280,6 +297,9 @@ void ReduceAggregatorBase::FastReduceKRK(const Tensor&, const gsl::span<const in
 void ReduceAggregatorBase::FastReduceRKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*) {
   ValidateMustBeOverloaded();
 }
+void ReduceAggregatorBase::FastReduceR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*) {
+  ValidateMustBeOverloaded();
+}
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  gsl::span<const int64_t> reduced_axes,
@@ -680,7 +700,8 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             fast_reduce_fct* case_kr,
                             fast_reduce_fct* case_rk,
                             fast_reduce_fct* case_krk,
-                            fast_reduce_fct* case_rkr) {
+                            fast_reduce_fct* case_rkr,
+                            fast_reduce_fct* case_r) {
   TensorShapeVector axes;
   const Tensor* input = ctx->Input<Tensor>(0);
   auto reduced_dims = input->Shape().GetDims();
@@ -717,8 +738,7 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
         }
         case FastReduceKind::kKRK:
           ValidateFastReduceKRK(fast_shape, *output);
-          if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()))) {
-            // See benchmarks in PR #7719.
+          if (UseFastReduceKRK(fast_shape, ctx->GetOperatorThreadPool())) {
             case_krk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
             return true;
           } else {
@@ -733,6 +753,13 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
             break;
           }
         case FastReduceKind::kR:
+          ValidateFastReduceR(fast_shape, *output);
+          if (UseFastReduceR(fast_shape)) {
+            case_r(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
+            return true;
+          } else {
+            break;
+          }
         case FastReduceKind::kK:
         case FastReduceKind::kNone:
         default:
@@ -756,7 +783,7 @@ bool CommonFastReduce(OpKernelContext* ctx,
   return CommonFastReduceSwitch(ctx, axes_, keepdims_, noop_with_empty_axes,
                                 fast_kind, fast_shape, output_shape, fast_axes,
                                 AGG::WhichFastReduce(), &AGG::FastReduceKR, &AGG::FastReduceRK,
-                                &AGG::FastReduceKRK, &AGG::FastReduceRKR);
+                                &AGG::FastReduceKRK, &AGG::FastReduceRKR, &AGG::FastReduceR);
 }
 
 static void ValidateKeepDims(const TensorShape& shape, int64_t keepdims) {
@@ -936,8 +963,7 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
         }
       case FastReduceKind::kKRK:
         ValidateFastReduceKRK(fast_shape, *output);
-        if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(tp))) {
-          // See benchmarks in PR #7719.
+        if (UseFastReduceKRK(fast_shape, tp)) {
           ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, *output, tp);
           return output;
         } else {
@@ -952,6 +978,13 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
           break;
         }
       case FastReduceKind::kR:
+        ValidateFastReduceR(fast_shape, *output);
+        if (UseFastReduceR(fast_shape)) {
+          ReduceAggregatorSum<T>::FastReduceR(input, fast_shape, *output, tp);
+          return output;
+        } else {
+          break;
+        }
       case FastReduceKind::kK:
       case FastReduceKind::kNone:
       default:
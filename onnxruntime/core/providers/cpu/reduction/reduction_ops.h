@@ -14,6 +14,7 @@
 #include "core/util/math_cpuonly.h"
 #include "core/platform/threadpool.h"
 #include "core/common/safeint.h"
+#include <algorithm>
 #include <cmath>
 
 namespace onnxruntime {
@@ -45,6 +46,41 @@ constexpr TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int6
                       static_cast<double>(n_row * n_col * element_size * n_ops)};
 }
 
+// Number of contiguous inner columns reduced by one task of the KRK fast reductions.
+constexpr int64_t kFastReduceKRKBlockSize = 256;
+
+// Number of elements reduced by one task when all the elements are reduced into a single value.
+constexpr int64_t kFastReduceRBlockSize = 16384;
+
+// Sums up to this size are computed directly, longer ones pairwise.
+constexpr int64_t kPairwiseSumBlockSize = 256;
+
+/* Number of tasks of the KRK fast reductions: one per outer index and block of inner columns. */
+constexpr int64_t FastReduceKRKTaskCount(int64_t n_outer, int64_t n_inner) {
+  return n_outer * ((n_inner + kFastReduceKRKBlockSize - 1) / kFastReduceKRKBlockSize);
+}
+
+/*
+  Runs fn(outer, begin, end) in parallel over the tasks of a KRK shape (see FastReduceKRKTaskCount).
+  Each task reduces the inner columns [begin, end) of one outer index, so the loop over the reduced
+  dimension reads contiguous rows and every column keeps its own accumulator, which vectorizes.
+*/
+template <typename F>
+void ParallelForFastReduceKRK(const gsl::span<const int64_t>& fast_shape, int64_t element_size,
+                              concurrency::ThreadPool* tp, const F& fn) {
+  const int64_t n_inner = fast_shape[2];
+  const int64_t n_blocks = (n_inner + kFastReduceKRKBlockSize - 1) / kFastReduceKRKBlockSize;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, FastReduceKRKTaskCount(fast_shape[0], n_inner),
+      ParallelReduceFastCost(fast_shape[1], std::min(n_inner, kFastReduceKRKBlockSize), element_size, 6),
+      [&fn, n_inner, n_blocks](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const int64_t begin = (task % n_blocks) * kFastReduceKRKBlockSize;
+          fn(task / n_blocks, begin, std::min(begin + kFastReduceKRKBlockSize, n_inner));
+        }
+      });
+}
+
 /**
   This only improves reduce function when reduced axes are contiguous:
   if len(shape) == 4, any single axis is ok, axes=(0, 1) or (1, 2) or (2, 3) is ok,
@@ -157,6 +193,7 @@ class ReduceAggregatorBase {
   static void FastReduceRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceKRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceRKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
+  static void FastReduceR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
 };
 
 template <typename T, typename TVAL = T>
@@ -203,6 +240,28 @@ class ReduceAggregator : public ReduceAggregatorBase {
           }
         });
   }
+
+  // Reduces all the elements into one value. Blocks of kFastReduceRBlockSize elements are reduced in
+  // parallel by f_block, then f_combine reduces the partial results in block order, so the result does
+  // not depend on the number of threads.
+  static void CommonFastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                Tensor& output, concurrency::ThreadPool* tp,
+                                std::function<TVAL(const T*, int64_t)> f_block,
+                                std::function<TVAL(const TVAL*, int64_t)> f_combine) {
+    const T* data = input.Data<T>();
+    const int64_t size = fast_shape[0];
+    const int64_t n_blocks = (size + kFastReduceRBlockSize - 1) / kFastReduceRBlockSize;
+    std::vector<TVAL> partials(n_blocks);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, n_blocks, ParallelReduceFastCost(1, kFastReduceRBlockSize, sizeof(T), 6),
+        [data, size, &partials, &f_block](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t b = first; b < last; ++b) {
+            const int64_t begin = b * kFastReduceRBlockSize;
+            partials[b] = f_block(data + begin, std::min(kFastReduceRBlockSize, size - begin));
+          }
+        });
+    *output.MutableData<TVAL>() = f_combine(partials.data(), n_blocks);
+  }
 };
 
 template <typename T>
@@ -210,8 +269,13 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
  public:
   inline ReduceAggregatorSum(int64_t N, const T&) : ReduceAggregator<T, T>(N, 0) {}
   inline void update(const T& v) { this->accumulator_ += v; }
+  // Long sums are computed pairwise, so the rounding error grows with the logarithm of the size.
   static T aggall(const T* from_data, int64_t size) {
-    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, size).sum();
+    if (size <= kPairwiseSumBlockSize) {
+      return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, size).sum();
+    }
+    const int64_t half = size / 2;
+    return aggall(from_data, half) + aggall(from_data + half, size - half);
   }
   inline T aggall(const T* from_data) {
     return aggall(from_data, this->N_);
@@ -219,7 +283,8 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR |
+           FastReduceKind::kR;
   }
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -256,17 +321,18 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t N = fast_shape[2];
     const T* data = input.Data<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
+    const int64_t n_rows = fast_shape[1];
+    const int64_t stridei = fast_shape[1] * fast_shape[2];
+    const int64_t strideo = fast_shape[2];
     T* out = output.MutableData<T>();
-    std::vector<T> one(fast_shape[1], 1);
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [one, data, fast_shape, stridei, strideo, out, N](ptrdiff_t begin, ptrdiff_t last) {
-          for (ptrdiff_t d = begin; d < last; ++d) {
-            math::MatMul<T>(1, N, fast_shape[1], one.data(), data + stridei * d, out + strideo * d, nullptr);
+    ParallelForFastReduceKRK(
+        fast_shape, sizeof(T), tp, [data, out, n_rows, stridei, strideo](int64_t d, int64_t begin, int64_t end) {
+          const T* p = data + d * stridei + begin;
+          EigenVectorArrayMap<T> acc(out + d * strideo + begin, end - begin);
+          acc = ConstEigenVectorArrayMap<T>(p, end - begin);
+          for (int64_t row = 1; row < n_rows; ++row) {
+            acc += ConstEigenVectorArrayMap<T>(p + row * strideo, end - begin);
           }
         });
   }
@@ -280,6 +346,14 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
           value += aggall(p, size);
         });
   }
+
+  static void FastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                          Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceR(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T { return aggall(p, size); },
+        [](const T* partials, int64_t size) -> T { return aggall(partials, size); });
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -297,7 +371,7 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
  public:
   inline ReduceAggregatorMean(int64_t N, const T&) : ReduceAggregatorSum<T>(N, 0) {}
   static T aggall(const T* from_data, int64_t size) {
-    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, size).mean();
+    return ReduceAggregatorSum<T>::aggall(from_data, size) / static_cast<T>(size);
   }
   inline T aggall(const T* from_data) {
     return aggall(from_data, this->N_);
@@ -356,6 +430,12 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
       *out /= div;
     }
   }
+
+  static void FastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                          Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorSum<T>::FastReduceR(input, fast_shape, output, tp);
+    *output.MutableData<T>() /= static_cast<T>(fast_shape[0]);
+  }
 };
 
 template <typename T>
@@ -372,7 +452,8 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR |
+           FastReduceKind::kR;
   }
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -416,17 +497,20 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
                             Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
-            EigenVectorMap<T>(out + j * strideo, strideo) =
-                ConstEigenMatrixMap<T>(
-                    data + j * stridei, fast_shape[2], fast_shape[1])
-                    .rowwise()
-                    .maxCoeff();
+    const int64_t n_rows = fast_shape[1];
+    const int64_t stridei = fast_shape[1] * fast_shape[2];
+    const int64_t strideo = fast_shape[2];
+    ParallelForFastReduceKRK(
+        fast_shape, sizeof(T), tp, [data, out, n_rows, stridei, strideo](int64_t d, int64_t begin, int64_t end) {
+          const T* p = data + d * stridei;
+          T* o = out + d * strideo;
+          std::copy(p + begin, p + end, o + begin);
+          for (int64_t row = 1; row < n_rows; ++row) {
+            p += strideo;
+            for (int64_t j = begin; j < end; ++j) {
+              if (o[j] < p[j])
+                o[j] = p[j];
+            }
           }
         });
   }
@@ -442,6 +526,13 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
             value = v;
         });
   }
+  static void FastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                          Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceR(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T { return aggall(p, size); },
+        [](const T* partials, int64_t size) -> T { return aggall(partials, size); });
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -459,6 +550,75 @@ class ReduceAggregatorArgMinMax : public ReduceAggregator<T, TVAL> {
   inline void enforce(const ResultsNoTransposePrepareForReduce& res) {
     ORT_ENFORCE(res.projected_index.size() == 0, "Only one axis is allowed for reduction.");
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK;
+  }
+
+ protected:
+  // Fast reductions shared by ArgMax and ArgMin. replace(v, best) returns true when v replaces the best
+  // value found so far, as update() does.
+  template <typename Replace>
+  static void CommonFastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                 Tensor& output, concurrency::ThreadPool* tp, Replace replace) {
+    const T* data = input.Data<T>();
+    TVAL* out = output.MutableData<TVAL>();
+    int64_t stridei = fast_shape[1];
+    concurrency::ThreadPool::TryParallelFor(
+        tp, fast_shape[0], ParallelReduceFastCost(1, stridei, sizeof(T), 6),
+        [data, stridei, out, replace](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t d = first; d < last; ++d) {
+            const T* p = data + d * stridei;
+            T best = p[0];
+            int64_t arg = 0;
+            for (int64_t i = 1; i < stridei; ++i) {
+              if (replace(p[i], best)) {
+                best = p[i];
+                arg = i;
+              }
+            }
+            out[d] = arg;
+          }
+        });
+  }
+
+  // Every inner column keeps its best value and index while the reduced rows are read contiguously.
+  template <typename Replace>
+  static void CommonFastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                  Tensor& output, concurrency::ThreadPool* tp, Replace replace) {
+    const T* data = input.Data<T>();
+    TVAL* out = output.MutableData<TVAL>();
+    const int64_t n_rows = fast_shape[1];
+    const int64_t stridei = fast_shape[1] * fast_shape[2];
+    const int64_t strideo = fast_shape[2];
+    ParallelForFastReduceKRK(
+        fast_shape, sizeof(T), tp,
+        [data, out, n_rows, stridei, strideo, replace](int64_t d, int64_t begin, int64_t end) {
+          T best[kFastReduceKRKBlockSize];
+          const int64_t n = end - begin;
+          const T* p = data + d * stridei + begin;
+          TVAL* o = out + d * strideo + begin;
+          std::copy(p, p + n, best);
+          std::fill(o, o + n, static_cast<TVAL>(0));
+          for (int64_t row = 1; row < n_rows; ++row) {
+            p += strideo;
+            for (int64_t j = 0; j < n; ++j) {
+              if (replace(p[j], best[j])) {
+                best[j] = p[j];
+                o[j] = row;
+              }
+            }
+          }
+        });
+  }
+
+  template <typename Replace>
+  static void CommonFastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                 Tensor& output, concurrency::ThreadPool* tp, Replace replace) {
+    const int64_t krk_shape[] = {1, fast_shape[0], fast_shape[1]};
+    CommonFastReduceKRK(input, krk_shape, output, tp, replace);
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -476,6 +636,25 @@ class ReduceAggregatorArgMax : public ReduceAggregatorArgMinMax<T, TVAL> {
     }
     ++this->index_;
   }
+
+  // Fast reduction
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceKR(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v > best; });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceRK(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v > best; });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceKRK(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v > best; });
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -495,6 +674,25 @@ class ReduceAggregatorArgMaxLastIndex : public ReduceAggregatorArgMax<T, TVAL> {
     }
     ++this->index_;
   }
+
+  // Fast reduction
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceKR(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v >= best; });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceRK(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v >= best; });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceKRK(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v >= best; });
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -512,6 +710,25 @@ class ReduceAggregatorArgMin : public ReduceAggregatorArgMinMax<T, TVAL> {
     }
     ++this->index_;
   }
+
+  // Fast reduction
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceKR(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v < best; });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceRK(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v < best; });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceKRK(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v < best; });
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -531,6 +748,25 @@ class ReduceAggregatorArgMinLastIndex : public ReduceAggregatorArgMin<T, TVAL> {
     }
     ++this->index_;
   }
+
+  // Fast reduction
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceKR(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v <= best; });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceRK(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v <= best; });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorArgMinMax<T, TVAL>::CommonFastReduceKRK(
+        input, fast_shape, output, tp, [](const T& v, const T& best) { return v <= best; });
+  }
 };
 
 template <typename T>
@@ -547,7 +783,8 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR |
+           FastReduceKind::kR;
   }
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -591,17 +828,20 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
                             Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
-            EigenVectorMap<T>(out + j * strideo, strideo) =
-                ConstEigenMatrixMap<T>(
-                    data + j * stridei, fast_shape[2], fast_shape[1])
-                    .rowwise()
-                    .minCoeff();
+    const int64_t n_rows = fast_shape[1];
+    const int64_t stridei = fast_shape[1] * fast_shape[2];
+    const int64_t strideo = fast_shape[2];
+    ParallelForFastReduceKRK(
+        fast_shape, sizeof(T), tp, [data, out, n_rows, stridei, strideo](int64_t d, int64_t begin, int64_t end) {
+          const T* p = data + d * stridei;
+          T* o = out + d * strideo;
+          std::copy(p + begin, p + end, o + begin);
+          for (int64_t row = 1; row < n_rows; ++row) {
+            p += strideo;
+            for (int64_t j = begin; j < end; ++j) {
+              if (o[j] > p[j])
+                o[j] = p[j];
+            }
           }
         });
   }
@@ -617,6 +857,13 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
             value = v;
         });
   }
+  static void FastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                          Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceR(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T { return aggall(p, size); },
+        [](const T* partials, int64_t size) -> T { return aggall(partials, size); });
+  }
 };
 
 template <typename T>
@@ -174,8 +174,8 @@ class UniDirectionalGru {
                     onnxruntime::concurrency::ThreadPool* ttp);
 
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
-               const gsl::span<const T>& input_weights, const gsl::span<const T>& recurrent_weights,
-               gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
+               const GemmWeights<T>& input_weights, const GemmWeights<T>& recurrent_weights_zr,
+               const GemmWeights<T>& recurrent_weights_h, gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
 
   ~UniDirectionalGru() = default;
 
@@ -249,6 +249,107 @@ class UniDirectionalGru {
 #define DumpMatrix(...) ((void)0)
 #endif
 
+Status DeepCpuGruOp::TryPackWeights(const Tensor& weights, int row_begin, int row_count,
+                                    PackedWeights& packed_weights, bool& is_packed, AllocatorPtr& alloc) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3) {
+    return Status::OK();
+  }
+
+  // weights: [num_directions, 3*hidden_size, input_size]
+  // recurrence weights: [num_directions, 3*hidden_size, hidden_size]
+  const size_t rows_per_direction = static_cast<size_t>(shape[1]);
+  const size_t N = static_cast<size_t>(row_count);
+  const size_t K = static_cast<size_t>(shape[2]);
+
+  if ((shape[0] != num_directions_) || (rows_per_direction != static_cast<size_t>(hidden_size_) * 3)) {
+    return Status::OK();
+  }
+
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K);
+  if (packed_weights_size == 0) {
+    return Status::OK();
+  }
+
+  size_t packed_weights_data_size = SafeInt<size_t>(packed_weights_size) * num_directions_;
+  auto* packed_weights_data = alloc->Alloc(packed_weights_data_size);
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_weights_data, 0, packed_weights_data_size);
+
+  packed_weights.buffer_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
+  packed_weights.buffer_size_ = packed_weights_data_size;
+  packed_weights.weights_size_ = packed_weights_size;
+  packed_weights.shape_ = shape;
+
+  const auto* weights_data = weights.Data<float>() + static_cast<size_t>(row_begin) * K;
+  for (int i = 0; i < num_directions_; i++) {
+    MlasGemmPackB(CblasTrans, N, K, weights_data, K, packed_weights_data);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights_data += rows_per_direction * K;
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status DeepCpuGruOp::PrePack(const Tensor& tensor, int input_idx,
+                             AllocatorPtr alloc, /*out*/ bool& is_packed,
+                             /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  if (tensor.IsDataType<float>()) {
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+
+    if (input_idx == 1) {
+      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, 0, 3 * hidden_size_, packed_W_, is_packed, alloc));
+
+      if (is_packed && share_prepacked_weights) {
+        prepacked_weights->buffers_.push_back(std::move(packed_W_.buffer_));
+        prepacked_weights->buffer_sizes_.push_back(packed_W_.buffer_size_);
+      }
+    } else if (input_idx == 2) {
+      bool is_packed_zr = false;
+      bool is_packed_h = false;
+      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, 0, 2 * hidden_size_, packed_R_zr_, is_packed_zr, alloc));
+      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, 2 * hidden_size_, hidden_size_, packed_R_h_, is_packed_h, alloc));
+
+      // R is only released if both parts of it were packed
+      is_packed = is_packed_zr && is_packed_h;
+      if (!is_packed) {
+        packed_R_zr_.buffer_.reset();
+        packed_R_h_.buffer_.reset();
+      } else if (share_prepacked_weights) {
+        prepacked_weights->buffers_.push_back(std::move(packed_R_zr_.buffer_));
+        prepacked_weights->buffer_sizes_.push_back(packed_R_zr_.buffer_size_);
+        prepacked_weights->buffers_.push_back(std::move(packed_R_h_.buffer_));
+        prepacked_weights->buffer_sizes_.push_back(packed_R_h_.buffer_size_);
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DeepCpuGruOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                               int input_idx,
+                                               /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_.buffer_ = std::move(prepacked_buffers[0]);
+  } else if (input_idx == 2) {
+    used_shared_buffers = true;
+    packed_R_zr_.buffer_ = std::move(prepacked_buffers[0]);
+    packed_R_h_.buffer_ = std::move(prepacked_buffers[1]);
+  }
+
+  return Status::OK();
+}
+
 Status DeepCpuGruOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
 
@@ -271,8 +372,10 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
 
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
-  const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 3*hidden_size, input_size]
-  const Tensor& R = *context.Input<Tensor>(2);  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context.Input<Tensor>(1);
+  // weights. [num_directions, 3*hidden_size, input_size]
+  const Tensor* R = packed_R_zr_.buffer_ ? nullptr : context.Input<Tensor>(2);
+  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
 
   // optional
   const auto* B = context.Input<Tensor>(3);              // bias. [num_directions, 6*hidden_size]
@@ -285,7 +388,10 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   int batch_size = gsl::narrow<int>(X_shape[1]);
   int input_size = gsl::narrow<int>(X_shape[2]);
 
-  auto status = ValidateCommonRnnInputs(X, W.Shape(), R.Shape(), B, 3, sequence_lens, initial_h, num_directions_, hidden_size_);
+  const auto& W_shape = (W != nullptr) ? W->Shape() : packed_W_.shape_;
+  const auto& R_shape = (R != nullptr) ? R->Shape() : packed_R_zr_.shape_;
+
+  auto status = ValidateCommonRnnInputs(X, W_shape, R_shape, B, 3, sequence_lens, initial_h, num_directions_, hidden_size_);
   ORT_RETURN_IF_ERROR(status);
 
   // GRU outputs are optional but must be in the same order
@@ -308,8 +414,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+  const T* input_weights = (W != nullptr) ? W->Data<T>() : nullptr;
+  const T* recurrent_weights = (R != nullptr) ? R->Data<T>() : nullptr;
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
 
   // spans for first direction
@@ -317,8 +423,12 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   const size_t recurrent_weights_size_per_direction = 3 * hidden_size_ * hidden_size_;
   const size_t bias_size_per_direction = 6 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, recurrent_weights_size_per_direction);
+  // R[zr] are the first 2*hidden_size rows of each direction of R and Rh the last hidden_size rows
+  const T* recurrent_weights_h = (R != nullptr) ? recurrent_weights + 2 * hidden_size_ * hidden_size_ : nullptr;
+
+  GemmWeights<T> input_weights_1(0, input_weights, input_weights_size_per_direction, packed_W_);
+  GemmWeights<T> recurrent_weights_zr_1(0, recurrent_weights, recurrent_weights_size_per_direction, packed_R_zr_);
+  GemmWeights<T> recurrent_weights_h_1(0, recurrent_weights_h, recurrent_weights_size_per_direction, packed_R_h_);
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
 
   gsl::span<const T> input = X.DataAsSpan<T>();
@@ -353,10 +463,9 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> recurrent_weights_2 = recurrent_weights.subspan(recurrent_weights_size_per_direction,
-                                                                       recurrent_weights_size_per_direction);
+    GemmWeights<T> input_weights_2(1, input_weights, input_weights_size_per_direction, packed_W_);
+    GemmWeights<T> recurrent_weights_zr_2(1, recurrent_weights, recurrent_weights_size_per_direction, packed_R_zr_);
+    GemmWeights<T> recurrent_weights_h_2(1, recurrent_weights_h, recurrent_weights_size_per_direction, packed_R_h_);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
 
     gsl::span<const T> initial_hidden_2 = initial_hidden.empty()
@@ -370,29 +479,49 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
     gsl::span<T> hidden_output_2 = hidden_output.subspan(hidden_output_size_per_direction,
                                                          hidden_output_size_per_direction);
 
+    // small directions are run concurrently, each single threaded, instead of one after the other
+    // both directions copy initial_h when constructed, before either writes its outputs, so the state
+    // outputs can be bound to the same buffers as the state inputs (see IOBinding::BindState)
+    const bool concurrent_directions = ShouldRunDirectionsConcurrently(thread_pool, batch_size, input_size,
+                                                                       hidden_size_, 3);
+    concurrency::ThreadPool* direction_thread_pool = concurrent_directions ? nullptr : thread_pool;
+
     detail::UniDirectionalGru<T> fw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_ != 0, Direction::kForward, bias_1, initial_hidden_1,
                                     activation_funcs_.Entries()[0],
                                     activation_funcs_.Entries()[1],
-                                    clip_, thread_pool);
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
-               output_1, hidden_output_1);
+                                    clip_, direction_thread_pool);
 
     detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_ != 0, Direction::kReverse, bias_2, initial_hidden_2,
                                     activation_funcs_.Entries()[2],
                                     activation_funcs_.Entries()[3],
-                                    clip_, thread_pool);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2,
-               output_2, hidden_output_2);
+                                    clip_, direction_thread_pool);
+
+    auto compute_direction = [&](std::ptrdiff_t direction) {
+      if (direction == 0) {
+        fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_zr_1,
+                   recurrent_weights_h_1, output_1, hidden_output_1);
+      } else {
+        bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_zr_2,
+                   recurrent_weights_h_2, output_2, hidden_output_2);
+      }
+    };
+
+    if (concurrent_directions) {
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, 2, compute_direction);
+    } else {
+      compute_direction(0);
+      compute_direction(1);
+    }
   } else {
     detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
                                        linear_before_reset_ != 0, direction_, bias_1, initial_hidden_1,
                                        activation_funcs_.Entries()[0],
                                        activation_funcs_.Entries()[1],
                                        clip_, thread_pool);
-    gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
-                  output_1, hidden_output_1);
+    gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_zr_1,
+                  recurrent_weights_h_1, output_1, hidden_output_1);
   }
 
   if (!output.empty())
@@ -491,8 +620,9 @@ template <typename T>
 void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const gsl::span<const int>& sequence_lengths_arg,
                                    const int num_directions,
-                                   const gsl::span<const T>& input_weights,
-                                   const gsl::span<const T>& recurrent_weights,
+                                   const GemmWeights<T>& input_weights,
+                                   const GemmWeights<T>& recurrent_weights_zr,
+                                   const GemmWeights<T>& recurrent_weights_h,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
@@ -509,11 +639,6 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   }
 
   DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
-  DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
-  DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
-
-  gsl::span<const T> recurrent_weightsZR = recurrent_weights.subspan(0, 2 * hidden_size_ * hidden_size_);
-  gsl::span<const T> recurrent_weightsH = recurrent_weights.subspan(2 * hidden_size_ * hidden_size_, hidden_size_ * hidden_size_);
 
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
@@ -543,11 +668,9 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   // apply weights to all the inputs
   ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
               inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),
-              input_size_, 0.f,
+              input_weights, 0.f,
               outputZRH_.begin(), outputZRH_.end(),
-              hidden_size_x3, ttp_);
+              hidden_size_x3, nullptr, nullptr, ttp_);
 
   DumpMatrix("inputs with weights applied", outputZRH_.data(), seq_length_ * batch_size_ * 3, hidden_size_);
 
@@ -593,6 +716,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
     }
   }
 
+  // cost of the gate activations for a row of the batch
+  const TensorOpCost gate_cost{static_cast<double>(3 * hidden_size_ * sizeof(T)),
+                               static_cast<double>(2 * hidden_size_ * sizeof(T)),
+                               static_cast<double>(16 * hidden_size_)};
+
   {
     // Enter a parallel section encompassing the kernels invoked
     // below.  This lets the runtime system amortize loop entry/exit
@@ -613,11 +741,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       // Ht-1 * R[zr] + Xt*(W[zr]^T)
       ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
                   prev_Ht, prev_Ht_end,
-                  hidden_size_,
-                  recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                  hidden_size_, 1.f,  // beta == 1 so we add existing values in outputZRH_
+                  recurrent_weights_zr,
+                  1.f,  // beta == 1 so we add existing values in outputZRH_
                   outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                  hidden_size_x3, ttp_);
+                  hidden_size_x3, nullptr, nullptr, ttp_);
 
       DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                  outputZRH_.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -633,69 +760,60 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         // compute Ht-1 * (Rh^T) + Rbh
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                     prev_Ht, prev_Ht_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_,
+                    recurrent_weights_h,   // Rh^T
                     use_bias_ ? 1.f : 0.f,  // don't add values in linear_output_ if no bias input
                     linear_output_.begin(),
                     linear_output_.end(),  // pre: Rbh if use_bias_, post:output
-                    hidden_size_, ttp_);
+                    hidden_size_, nullptr, nullptr, ttp_);
 
         DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
       }
 
       // 1st Set Of Activations
-      for (int r = 0; r < batch_size_; r++) {
-        const T* p_bias_r = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRr_local + r * hidden_size_,
-                                                               batched_bias_WRr_local_end, hidden_size_)
-                                      : nullptr;
+      // the rows of the batch are independent so are processed in parallel
+      concurrency::ThreadPool::TryParallelFor(ttp_, batch_size_, gate_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int r = static_cast<int>(first), end = static_cast<int>(last); r < end; r++) {
+          const T* p_bias_r = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRr_local + r * hidden_size_,
+                                                                 batched_bias_WRr_local_end, hidden_size_)
+                                        : nullptr;
 
-        // initialize p_rt with input to calculate rt. outputZRH_ has Xt*(Wr^T) + Ht-1*(Rr^T).
-        T* p_rt = SafeRawPointer(outputZRH_, out_added_offset + r * hidden_size_x3 + hidden_size_, hidden_size_);
+          // initialize p_rt with input to calculate rt. outputZRH_ has Xt*(Wr^T) + Ht-1*(Rr^T).
+          T* p_rt = SafeRawPointer(outputZRH_, out_added_offset + r * hidden_size_x3 + hidden_size_, hidden_size_);
 
-        // add the bias and clip. post: p_rt == Xt*(Wr^T) + Ht-1*(Rr^T) + Wbr + Rbr
-        clip_with_bias_ptr_(clip_, p_bias_r, p_rt, hidden_size_);
+          // add the bias and clip. post: p_rt == Xt*(Wr^T) + Ht-1*(Rr^T) + Wbr + Rbr
+          clip_with_bias_ptr_(clip_, p_bias_r, p_rt, hidden_size_);
 
-        if (linear_before_reset_) {
-          // p_linear_output = Ht-1 * (Rh^T) + Rbh
-          T* p_linear_output = SafeRawPointer<T>(linear_output_, r * hidden_size_, hidden_size_);
-          T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
+          if (linear_before_reset_) {
+            // p_linear_output = Ht-1 * (Rh^T) + Rbh
+            T* p_linear_output = SafeRawPointer<T>(linear_output_, r * hidden_size_, hidden_size_);
+            T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
 
-          // calculate rt in-place [p_rt = f(p_rt)]
-          // calculate rt (.) (Ht-1 * (Rh^T) + Rbh) using p_linear_output. write to p_cur_h
-          reset_gate_(p_linear_output, p_rt, p_cur_h, hidden_size_, zr_alpha_, zr_beta_);
+            // calculate rt in-place [p_rt = f(p_rt)]
+            // calculate rt (.) (Ht-1 * (Rh^T) + Rbh) using p_linear_output. write to p_cur_h
+            reset_gate_(p_linear_output, p_rt, p_cur_h, hidden_size_, zr_alpha_, zr_beta_);
 
-        } else {
-          const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
-          T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
+            // p_out_H currently contains Xt*(Wh^T). add rt (.) (Ht-1*(Rh^T) + Rbh) to it while p_cur_h is in cache
+            T* p_out_H = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3 + hidden_size_x2,
+                                           hidden_size_);
+            deepcpu::elementwise_sum1(p_cur_h, p_out_H, hidden_size_);
+
+          } else {
+            const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
+            T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
 
-          // calculate rt in-place [p_rt = f(p_rt)]
-          // calculate rt (.) Ht-1 using p_prev_Ht, and write to p_cur_h
-          reset_gate_(p_prev_Ht, p_rt, p_cur_h, hidden_size_, zr_alpha_, zr_beta_);
+            // calculate rt in-place [p_rt = f(p_rt)]
+            // calculate rt (.) Ht-1 using p_prev_Ht, and write to p_cur_h
+            reset_gate_(p_prev_Ht, p_rt, p_cur_h, hidden_size_, zr_alpha_, zr_beta_);
+          }
         }
-      }
+      });
 
 #if defined(DUMP_MATRIXES)
       std::string label = linear_before_reset_ ? "rt (.) (Ht-1 * (Rh^T) + Rbh)" : "rt (.) Ht-1";
 #endif
       DumpMatrix(label + seqno_str, &*cur_h_local, batch_size_, hidden_size_);
 
-      if (linear_before_reset_) {
-        // input contains rt (.) (Ht-1*(Rh^T) + Rbh)
-        auto input = cur_h_local;
-        // out_H currently contains Xt*(W[zrh]^T).
-        auto out_H = outputZRH_.begin() + out_added_offset;
-
-        for (int r = 0; r < batch_size_; r++) {
-          // skip over the inputs with Z and R weights
-          out_H += hidden_size_x2;
-          for (int h = 0; h < hidden_size_; ++h) {
-            *out_H += *input;
-            ++out_H;
-            ++input;
-          }
-        }
-      } else {
+      if (!linear_before_reset_) {
 #if defined(DUMP_MATRIXES)
         label += " * Rh^T";
 #endif
@@ -706,11 +824,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                     cur_h_local, cur_h_local_end,  // rt (.) Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_, 1.f,                                       // beta == 1 to add Xt*(Wh^T) from out_H
+                    recurrent_weights_h,           // Rh^T
+                    1.f,                           // beta == 1 to add Xt*(Wh^T) from out_H
                     out_H, outputZRH_.end(),
-                    hidden_size_x3, ttp_);
+                    hidden_size_x3, nullptr, nullptr, ttp_);
       }
 
       DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, outputZRH_.data() + out_added_offset,
@@ -728,64 +845,66 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         output_end = final_hidden_state.end();
       }
 
-      for (int r = 0; r < batch_size_; r++) {
-        if (step >= min_sequence_length && step >= sequence_lengths[r]) {
-          // if we need output for every step,
-          // or we need to set prev_Ht for an empty sequence to avoid warnings about using uninitialized values
-          if (output_sequence || (step == 0 && sequence_lengths[r] == 0)) {
-            auto fill_output = output + r * hidden_size_;
-            std::fill_n(&*fill_output, hidden_size_, T{});
+      concurrency::ThreadPool::TryParallelFor(ttp_, batch_size_, gate_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int r = static_cast<int>(first), end = static_cast<int>(last); r < end; r++) {
+          if (step >= min_sequence_length && step >= sequence_lengths[r]) {
+            // if we need output for every step,
+            // or we need to set prev_Ht for an empty sequence to avoid warnings about using uninitialized values
+            if (output_sequence || (step == 0 && sequence_lengths[r] == 0)) {
+              auto fill_output = output + r * hidden_size_;
+              std::fill_n(&*fill_output, hidden_size_, T{});
+            }
+
+            continue;
           }
 
-          continue;
-        }
+          const T* p_bias_z = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRz_local,
+                                                                 batched_bias_WRz_local_end, hidden_size_)
+                                        : nullptr;
 
-        const T* p_bias_z = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRz_local,
-                                                               batched_bias_WRz_local_end, hidden_size_)
-                                      : nullptr;
+          // initialize p_zt with Xt*(Wz^T) + Ht-1*(Rz^T), which is most of the input to calculate zt:
+          T* p_zt = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3, hidden_size_);
 
-        // initialize p_zt with Xt*(Wz^T) + Ht-1*(Rz^T), which is most of the input to calculate zt:
-        T* p_zt = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3, hidden_size_);
+          // using p_zt, add bias and clip in-place
+          clip_with_bias_ptr_(clip_, p_bias_z, p_zt, hidden_size_);
 
-        // using p_zt, add bias and clip in-place
-        clip_with_bias_ptr_(clip_, p_bias_z, p_zt, hidden_size_);
+          // calculate zt in-place. p_zt = f(p_zt)
+          update_gate_(p_zt, hidden_size_, zr_alpha_, zr_beta_);
 
-        // calculate zt in-place. p_zt = f(p_zt)
-        update_gate_(p_zt, hidden_size_, zr_alpha_, zr_beta_);
+          DumpMatrix("zt[" + std::to_string(r) + "]" + seqno_str, p_zt, 1, hidden_size_);
 
-        DumpMatrix("zt[" + std::to_string(r) + "]" + seqno_str, p_zt, 1, hidden_size_);
+          const T* p_bias_h = nullptr;
+          if (use_bias_) {
+            if (linear_before_reset_) {
+              // Wbh
+              p_bias_h = SafeRawConstPointer<T>(batched_bias_Wh_local + r * hidden_size_,
+                                                batched_bias_Wh_local_end, hidden_size_);
 
-        const T* p_bias_h = nullptr;
-        if (use_bias_) {
-          if (linear_before_reset_) {
-            // Wbh
-            p_bias_h = SafeRawConstPointer<T>(batched_bias_Wh_local + r * hidden_size_,
-                                              batched_bias_Wh_local_end, hidden_size_);
-
-          } else {
-            // Wbh + Wrh
-            p_bias_h = SafeRawConstPointer<T>(batched_bias_WRh_local + r * hidden_size_,
-                                              batched_bias_WRh_local_end, hidden_size_);
+            } else {
+              // Wbh + Wrh
+              p_bias_h = SafeRawConstPointer<T>(batched_bias_WRh_local + r * hidden_size_,
+                                                batched_bias_WRh_local_end, hidden_size_);
+            }
           }
-        }
 
-        // setup p_ht with input to calculate ht
-        // p_ht = Xt*(Wh^T) + (rt (.) Ht-1 * Rh^T)          #  linear_before_reset_ == false
-        //      = Xt*(Wh^T) + (rt (.) (Ht-1*(Rh^T) + Rbh))  #  linear_before_reset_ == true
-        T* p_ht = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3 + hidden_size_x2, hidden_size_);
+          // setup p_ht with input to calculate ht
+          // p_ht = Xt*(Wh^T) + (rt (.) Ht-1 * Rh^T)          #  linear_before_reset_ == false
+          //      = Xt*(Wh^T) + (rt (.) (Ht-1*(Rh^T) + Rbh))  #  linear_before_reset_ == true
+          T* p_ht = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3 + hidden_size_x2, hidden_size_);
 
-        // add Wbh [and Wrh] and clip
-        clip_with_bias_ptr_(clip_, p_bias_h, p_ht, hidden_size_);  // post: p_ht == input to g() for calculating ht
+          // add Wbh [and Wrh] and clip
+          clip_with_bias_ptr_(clip_, p_bias_h, p_ht, hidden_size_);  // post: p_ht == input to g() for calculating ht
 
-        DumpMatrix("ht input [" + std::to_string(r) + "]" + seqno_str, p_ht, 1, hidden_size_);
+          DumpMatrix("ht input [" + std::to_string(r) + "]" + seqno_str, p_ht, 1, hidden_size_);
 
-        const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
-        T* p_Ht = SafeRawPointer<T>(output + r * hidden_size_, output_end, hidden_size_);
+          const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
+          T* p_Ht = SafeRawPointer<T>(output + r * hidden_size_, output_end, hidden_size_);
 
-        // calculate ht = g(p_ht) and write in-place to p_ht
-        // calculate Ht = (1 - zt) (.) ht + zt (.) Ht-1 and write to p_Ht
-        output_gate_(p_ht, p_zt, p_prev_Ht, p_Ht, hidden_size_, h_alpha_, h_beta_);  // calculate ht and Ht
-      }
+          // calculate ht = g(p_ht) and write in-place to p_ht
+          // calculate Ht = (1 - zt) (.) ht + zt (.) Ht-1 and write to p_Ht
+          output_gate_(p_ht, p_zt, p_prev_Ht, p_Ht, hidden_size_, h_alpha_, h_beta_);  // calculate ht and Ht
+        }
+      });
 
       DumpMatrix("output" + seqno_str, &*output, batch_size_, hidden_size_);
 
@@ -55,11 +55,23 @@ class DeepCpuGruOp final : public OpKernel {
         "Batchwise recurrent operations (layout == 1) are not supported. If you need support create a github issue with justification.");
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
   ~DeepCpuGruOp() override = default;
 
  private:
+  // Packs rows [row_begin, row_begin + row_count) of each direction of the weights
+  Status TryPackWeights(const Tensor& weights, int row_begin, int row_count,
+                        rnn::detail::PackedWeights& packed_weights, bool& is_packed, AllocatorPtr& alloc);
+
   rnn::detail::Direction direction_;
   int num_directions_;
 
@@ -70,6 +82,12 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W[zrh] is packed as a whole. R[zr] and Rh are packed separately as Rh is applied to
+  // rt (.) Ht-1 rather than Ht-1 when linear_before_reset_ is false.
+  rnn::detail::PackedWeights packed_W_;
+  rnn::detail::PackedWeights packed_R_zr_;
+  rnn::detail::PackedWeights packed_R_h_;
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 };
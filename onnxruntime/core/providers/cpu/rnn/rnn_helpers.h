@@ -247,6 +247,26 @@ void ComputeGemm(const int M,
                  int32_t* quantize_agg_C_buffer,
                  concurrency::ThreadPool* thread_pool);
 
+// Upper bound on the GEMM work (M * N * K) of a single time step of one direction of a bidirectional RNN for
+// the two directions to be run concurrently.
+constexpr double kConcurrentDirectionsMaxStepComplexity = 256.0 * 1024;
+
+// Returns true if the forward and reverse directions of a bidirectional RNN should be run as two concurrent
+// single threaded tasks on the thread pool instead of one after the other with each using the whole pool.
+// Below kConcurrentDirectionsMaxStepComplexity MLAS splits the GEMMs of a time step across only a couple of
+// threads and the per step parallel loop overhead dominates, so this keeps two threads busy instead.
+// The directions can't both use the pool while running concurrently as parallel sections can't be nested.
+inline bool ShouldRunDirectionsConcurrently(concurrency::ThreadPool* thread_pool,
+                                            int batch_size, int input_size, int hidden_size, int num_gates) {
+  if (concurrency::ThreadPool::DegreeOfParallelism(thread_pool) < 2) {
+    return false;
+  }
+
+  const double step_complexity = static_cast<double>(batch_size) * num_gates * hidden_size *
+                                 std::max(input_size, hidden_size);
+  return step_complexity <= kConcurrentDirectionsMaxStepComplexity;
+}
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -15,8 +15,9 @@ using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
-// TODO: The current implementation of sequence ops relies on tensor copies. Ideally we should try to avoid
-// these copies. This has been postponed due to lack of time.
+// The tensors of an input sequence that own their buffer are shared with the output sequence instead of being copied.
+// Input tensors (e.g. X of SequenceInsert) are still copied as their buffer belongs to the execution frame and may be
+// reused once the node has run.
 
 // SequenceLength
 ONNX_CPU_OPERATOR_KERNEL(
@@ -181,15 +182,29 @@ ONNX_CPU_OPERATOR_KERNEL(
                                  DataTypeImpl::GetTensorType<int64_t>()}),
     SequenceInsert);
 
-Status CreateCopyAndAppendCpuTensor(const Tensor& in_tensor, OpKernelContext* context, std::vector<Tensor>& tensors) {
+Status CreateCopyAndAppendCpuTensor(const Tensor& in_tensor, OpKernelContext* context,
+                                    std::vector<OrtValue>& tensors) {
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-  Tensor tmp(in_tensor.DataType(), onnxruntime::TensorShape(in_tensor.Shape()), alloc);
-  CopyCpuTensor(&in_tensor, &tmp);
+  OrtValue tmp;
+  Tensor::InitOrtValue(in_tensor.DataType(), in_tensor.Shape(), std::move(alloc), tmp);
+  CopyCpuTensor(&in_tensor, tmp.GetMutable<Tensor>());
   tensors.push_back(std::move(tmp));
   return Status::OK();
 }
 
+// Append the tensor at index i of a sequence, sharing it if it owns its buffer.
+static Status AppendSequenceTensor(const TensorSeq& seq, size_t i, OpKernelContext* context,
+                                   std::vector<OrtValue>& tensors) {
+  const OrtValue& value = seq.GetAt(i);
+  if (value.Get<Tensor>().OwnsBuffer()) {
+    tensors.push_back(value);
+    return Status::OK();
+  }
+
+  return CreateCopyAndAppendCpuTensor(value.Get<Tensor>(), context, tensors);
+}
+
 Status SequenceInsert::Compute(OpKernelContext* context) const {
   const auto* S = context->Input<TensorSeq>(0);
   const auto* X = context->Input<Tensor>(1);
@@ -218,15 +233,13 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
 
   auto* Y = context->Output<TensorSeq>(0);
 
-  std::vector<Tensor> tensors;
+  std::vector<OrtValue> tensors;
   tensors.reserve(num_tensors_input_seq + 1);
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
       ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, tensors));
-      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors));
-    } else {
-      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors));
     }
+    ORT_RETURN_IF_ERROR(AppendSequenceTensor(*S, i, context, tensors));
   }
   if (input_seq_idx == num_tensors_input_seq) {
     ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, tensors));
@@ -270,13 +283,13 @@ Status SequenceErase::Compute(OpKernelContext* context) const {
   auto* Y = context->Output<TensorSeq>(0);
   Y->SetType(S->DataType());
 
-  std::vector<Tensor> tensors;
+  std::vector<OrtValue> tensors;
   tensors.reserve(num_tensors_input_seq - 1);
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
       continue;
     }
-    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors));
+    ORT_RETURN_IF_ERROR(AppendSequenceTensor(*S, i, context, tensors));
   }
   Y->SetElements(std::move(tensors));
   return Status::OK();
@@ -309,7 +322,7 @@ Status SequenceConstruct::Compute(OpKernelContext* context) const {
 
   // now copy the tensors to the output sequence
   Y->SetType(first_dtype);
-  std::vector<Tensor> tensors;
+  std::vector<OrtValue> tensors;
   tensors.reserve(num_inputs);
   for (int input_idx = 0; input_idx < num_inputs; ++input_idx) {
     const auto* X = context->Input<Tensor>(input_idx);
@@ -15,6 +15,8 @@
 #include "core/framework/data_types.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
@@ -22,10 +24,6 @@
 #include "Eigen/src/Core/arch/Default/BFloat16.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-#include "core/mlas/inc/mlas.h"
-#endif
-
 namespace onnxruntime {
 
 namespace op_kernel_type_control {
@@ -171,19 +169,30 @@ struct EigenCastType<BFloat16> {
   using type = Eigen::bfloat16;
 };
 
+// casts the elements of a tensor in blocks on the intra-op thread pool, as fn(first, last) on each block
+template <typename SrcType, typename DstType, typename Fn>
+void ParallelCast(const OpKernelContext& context, const TensorShape& shape, Fn&& fn) {
+  const std::ptrdiff_t shape_size = gsl::narrow<std::ptrdiff_t>(shape.Size());
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), shape_size,
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)), 1.0},
+      std::forward<Fn>(fn));
+}
+
 // generic tensor X -> Y
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCaster {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     using SrcEigenCastType = typename EigenCastType<SrcType>::type;
     using DstEigenCastType = typename EigenCastType<DstType>::type;
 
-    const std::ptrdiff_t shape_size = gsl::narrow<std::ptrdiff_t>(shape.Size());
-    const auto in_vector =
-        ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>()), shape_size);
-    auto out_vector =
-        EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>()), shape_size);
-    out_vector = in_vector.template cast<DstEigenCastType>();
+    const auto* in_data = reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>());
+    auto* out_data = reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>());
+    ParallelCast<SrcType, DstType>(context, shape, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      const auto in_vector = ConstEigenVectorMap<SrcEigenCastType>(in_data + first, last - first);
+      auto out_vector = EigenVectorMap<DstEigenCastType>(out_data + first, last - first);
+      out_vector = in_vector.template cast<DstEigenCastType>();
+    });
   }
 };
 
@@ -213,18 +222,53 @@ struct TensorCaster<std::string, DstType> {
   }
 };
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
+// specializations to use the vectorized MLAS routines for float <-> MLFloat16 and float <-> BFloat16 conversions
 
 // tensor MLFloat16 -> float
 template <>
 struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     auto out_data = out.MutableData<float>();
     auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = gsl::narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
+    ParallelCast<MLFloat16, float>(context, shape, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertHalfToFloatBuffer(&in_data[first].val, out_data + first, static_cast<size_t>(last - first));
+    });
+  }
+};
+
+// tensor float -> MLFloat16
+template <>
+struct TensorCaster<float, MLFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    auto out_data = out.MutableData<MLFloat16>();
+    auto in_data = in.Data<float>();
+    ParallelCast<float, MLFloat16>(context, shape, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertFloatToHalfBuffer(in_data + first, &out_data[first].val, static_cast<size_t>(last - first));
+    });
+  }
+};
+
+// tensor BFloat16 -> float
+template <>
+struct TensorCaster<BFloat16, float> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    auto out_data = out.MutableData<float>();
+    auto in_data = in.Data<BFloat16>();
+    ParallelCast<BFloat16, float>(context, shape, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertBFloat16ToFloatBuffer(&in_data[first].val, out_data + first, static_cast<size_t>(last - first));
+    });
+  }
+};
+
+// tensor float -> BFloat16
+template <>
+struct TensorCaster<float, BFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    auto out_data = out.MutableData<BFloat16>();
+    auto in_data = in.Data<float>();
+    ParallelCast<float, BFloat16>(context, shape, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasConvertFloatToBFloat16Buffer(in_data + first, &out_data[first].val, static_cast<size_t>(last - first));
+    });
   }
 };
 
@@ -260,7 +304,6 @@ struct TensorCaster<MLFloat16, std::string> {
     CastMLFloat16ThroughFloatTensor<std::string>(context, shape, in, out);
   }
 };
-#endif
 
 class Cast final : public OpKernel {
  public:
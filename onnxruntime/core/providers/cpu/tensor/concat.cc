@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/tensor/concat.h"
 
+#include <algorithm>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/copy.h"
@@ -250,7 +252,62 @@ TensorShapeVector StridesForStack(const TensorShapeVector& full_strides, uint64_
 }  // namespace
 
 // This method computes the output tensor for Concat/ConcatFromSequence ops
+// Concatenates fixed size types with one parallel loop over the bytes of the output. The output is a sequence of
+// rows of output_axis_pitch elements, and each row is the concatenation of one row of axis_pitch elements
+// of each input, so any range of output bytes is made of contiguous pieces of the inputs.
+static void ConcatFixedSizeTypes(concurrency::ThreadPool* tp, const Prepare& p) {
+  const size_t element_size = p.output_tensor->DataType()->Size();
+  const size_t input_count = p.inputs.size();
+
+  // piece_offsets[i] is the offset in a row of the output of the bytes of input i.
+  InlinedVector<size_t, Prepare::kExpectedNumberOfInputs + 1> piece_offsets(input_count + 1, 0);
+  for (size_t i = 0; i < input_count; ++i) {
+    piece_offsets[i + 1] = piece_offsets[i] + static_cast<size_t>(p.inputs[i].axis_pitch) * element_size;
+  }
+
+  const size_t row_bytes = piece_offsets[input_count];
+  auto* output = reinterpret_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
+
+  // The allocation planner may have the producers of the inputs write them in place (see AllocKind::kSlice).
+  // The pieces in place are not copied, and there is nothing to do when all of them are.
+  bool in_place = p.output_num_elements == p.output_axis_pitch;
+  for (size_t i = 0; in_place && i < input_count; ++i) {
+    in_place = p.inputs[i].num_elements == 0 || p.inputs[i].tensor->DataRaw() == output + piece_offsets[i];
+  }
+  if (in_place) {
+    return;
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(p.output_num_elements * element_size), TensorOpCost{1.0, 1.0, 0.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        size_t position = static_cast<size_t>(first);
+        while (position < static_cast<size_t>(last)) {
+          const size_t row = position / row_bytes;
+          const size_t offset = position % row_bytes;
+
+          // the input with the byte at offset, skipping the empty inputs
+          const size_t i = static_cast<size_t>(
+              std::upper_bound(piece_offsets.begin(), piece_offsets.end(), offset) - piece_offsets.begin() - 1);
+          const size_t piece_bytes = piece_offsets[i + 1] - piece_offsets[i];
+          const size_t bytes = std::min(piece_offsets[i + 1] - offset, static_cast<size_t>(last) - position);
+
+          const auto* input = reinterpret_cast<const uint8_t*>(p.inputs[i].tensor->DataRaw());
+          const uint8_t* source = input + row * piece_bytes + (offset - piece_offsets[i]);
+          if (source != output + position) {
+            memcpy(output + position, source, bytes);
+          }
+          position += bytes;
+        }
+      });
+}
+
 Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
+  if (!p.is_string_type) {
+    ConcatFixedSizeTypes(ctx->GetOperatorThreadPool(), p);
+    return Status::OK();
+  }
+
   int input_count = static_cast<int>(p.inputs.size());
   int64_t initial_output_offset = 0;  // initial offset for each input
 
@@ -6,19 +6,27 @@
 
 namespace onnxruntime {
 
-#define REG_EXPAND_KERNEL(TYPE)                                                    \
-  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                        \
-      Expand,                                                                      \
-      8,                                                                           \
-      12,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
-      Expand<TYPE>);                                                               \
-  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
-      Expand,                                                                      \
-      13,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+// The output is a strided view of the input when all the consumers of the output accept strided inputs.
+static KernelDefBuilder& MayStridedOutputIfEnabled(KernelDefBuilder& builder) {
+#ifdef ENABLE_STRIDED_TENSORS
+  builder.MayStridedOutput(0, 0);
+#endif
+  return builder;
+}
+
+#define REG_EXPAND_KERNEL(TYPE)                                                                               \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                   \
+      Expand,                                                                                                 \
+      8,                                                                                                      \
+      12,                                                                                                     \
+      TYPE,                                                                                                   \
+      MayStridedOutputIfEnabled(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())), \
+      Expand<TYPE>);                                                                                          \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                                             \
+      Expand,                                                                                                 \
+      13,                                                                                                     \
+      TYPE,                                                                                                   \
+      MayStridedOutputIfEnabled(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())), \
       Expand<TYPE>);
 
 REG_EXPAND_KERNEL(float)
@@ -69,6 +77,25 @@ Status Expand<T>::Compute(OpKernelContext* context) const {
   TensorShape output_tensor_shape(output_shape);
   auto* output_tensor = context->Output(0, output_tensor_shape);
   auto* output_data = output_tensor->template MutableData<T>();
+
+#ifdef ENABLE_STRIDED_TENSORS
+  // The allocation planner gives the output the buffer of the input when all the consumers of the output accept
+  // strided inputs. The broadcast dims of the view have stride 0.
+  if (output_data == input_data) {
+    const auto input_strides = input_tensor->Strides();
+    const size_t rank = output_shape.size();
+    const size_t num_new_dims = rank - input_shape.size();
+    TensorShapeVector output_strides(rank, 0);
+    for (size_t i = num_new_dims; i < rank; ++i) {
+      if (input_shape[i - num_new_dims] == output_shape[i]) {
+        output_strides[i] = input_strides[i - num_new_dims];
+      }
+    }
+    output_tensor->SetShapeAndStrides(output_tensor_shape, output_strides);
+    return Status::OK();
+  }
+#endif
+
   auto* output_dims = output_shape.data();
   auto output_dims_size = static_cast<int64_t>(output_shape.size());
   auto max_dims_size = std::max(input_dims_size, output_dims_size);
@@ -98,22 +98,55 @@ T GsBicubicInterpolate(T p[4][4], float x, float y) {
 }
 
 template <typename T>
-T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const {
-  T pixel = {};  // default 0
+bool GridSample<T>::PixelOffsetAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, const float border[/* 4 */],
+                                      int64_t& offset) const {
   if (padding_mode_ == Zeros) {
-    if (c >= 0 && c < W && r >= 0 && r < H) {
-      pixel = image[r * W + c];
+    if (c < 0 || c >= W || r < 0 || r >= H) {
+      return false;
     }
   } else if (padding_mode_ == Border) {
     c = std::clamp<int64_t>(c, 0, W - 1);
     r = std::clamp<int64_t>(r, 0, H - 1);
-    pixel = image[r * W + c];
   } else {  // (padding_mode_ == Reflection)
     c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
     r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
-    pixel = image[r * W + c];
   }
-  return pixel;
+  offset = r * W + c;
+  return true;
+}
+
+template <typename T>
+T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const {
+  int64_t offset = 0;
+  return PixelOffsetAtGrid(r, c, H, W, border, offset) ? image[offset] : T{};  // default 0
+}
+
+template <typename T>
+void GridSample<T>::GridPointLocation(T nx, T ny, int64_t H_in, int64_t W_in, const float border[/* 4 */],
+                                      T& x, T& y) const {
+  const float x_min = border[0];
+  const float y_min = border[1];
+  const float x_max = border[2];
+  const float y_max = border[3];
+
+  x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
+  y = GsDenormalize<T>(ny, H_in, align_corners_);
+
+  if (mode_ == Nearest) {
+    x = static_cast<T>(std::nearbyintf(static_cast<float>(x)));
+    y = static_cast<T>(std::nearbyintf(static_cast<float>(y)));
+  }
+
+  if (x < x_min || x > x_max || y < y_min || y > y_max) {  // out of bound
+    if (padding_mode_ == Border) {
+      // use original border in both align_corner cases
+      x = std::clamp(x, static_cast<T>(0), static_cast<T>(W_in - 1));
+      y = std::clamp(y, static_cast<T>(0), static_cast<T>(H_in - 1));
+    } else if (padding_mode_ == Reflection) {
+      x = GsReflect(x, x_min, x_max);
+      y = GsReflect(y, y_min, y_max);
+    }
+  }  // out of bound
 }
 
 // When grid sampling, padding is applied before interpolation.
@@ -168,76 +201,121 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
   }
   float border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
 
-  concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
+  // the taps below read the image, which must hold a pixel even if they are all zero padding
+  if (H_in * W_in == 0) {
+    std::fill_n(Y.MutableData<T>(), Y.Shape().Size(), T{});
+    return Status::OK();
+  }
+
+  const int64_t grid_size = H_out * W_out;
+  concurrency::ThreadPool* tp = grid_size > 64 ? context->GetOperatorThreadPool() : nullptr;
+
+  if (mode_ == Bilinear || mode_ == Nearest) {
+    // The location of a grid point in the image and its interpolation weights are the same for all the channels,
+    // so they are computed once per batch as the offsets of the 1 or 4 pixels blended into each output pixel.
+    // The channels then only gather and blend, in a loop without branches. Zero padding pixels get a weight of 0.
+    const int64_t taps = mode_ == Bilinear ? 4 : 1;
+    std::vector<int64_t> tap_offsets(static_cast<size_t>(grid_size * taps));
+    std::vector<T> tap_weights(static_cast<size_t>(grid_size * taps));
+
+    for (int64_t n = 0; n < N; n++) {
+      const T* grid_data = grid->Data<T>() + n * grid_size * 2;
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(grid_size),
+          TensorOpCost{2.0 * sizeof(T), static_cast<double>(taps * (sizeof(int64_t) + sizeof(T))), 32.0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; i++) {
+              T x{};
+              T y{};
+              GridPointLocation(grid_data[i * 2], grid_data[i * 2 + 1], H_in, W_in, border, x, y);
+              int64_t* offsets = tap_offsets.data() + i * taps;
+              T* weights = tap_weights.data() + i * taps;
+
+              if (mode_ == Nearest) {
+                // x, y are integers in all padding modes
+                offsets[0] = 0;
+                weights[0] = PixelOffsetAtGrid(static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in,
+                                               border, offsets[0])
+                                 ? static_cast<T>(1)
+                                 : static_cast<T>(0);
+                continue;
+              }
+
+              int64_t x1 = static_cast<int64_t>(std::floor(x));
+              int64_t y1 = static_cast<int64_t>(std::floor(y));
+              int64_t x2 = x1 + 1;
+              int64_t y2 = y1 + 1;
+
+              T dx2 = static_cast<T>(x2) - x;
+              T dx1 = x - static_cast<T>(x1);
+              T dy2 = static_cast<T>(y2) - y;
+              T dy1 = y - static_cast<T>(y1);
+
+              const int64_t rows[4] = {y1, y1, y2, y2};
+              const int64_t cols[4] = {x1, x2, x1, x2};
+              const T tap_weight[4] = {dy2 * dx2, dy2 * dx1, dy1 * dx2, dy1 * dx1};
+              for (int64_t t = 0; t < 4; t++) {
+                offsets[t] = 0;
+                weights[t] = PixelOffsetAtGrid(rows[t], cols[t], H_in, W_in, border, offsets[t])
+                                 ? tap_weight[t]
+                                 : static_cast<T>(0);
+              }
+            }
+          });
+
+      const int64_t* offsets = tap_offsets.data();
+      const T* weights = tap_weights.data();
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          tp, C,
+          [&](std::ptrdiff_t c) {
+            const T* X_data = input->Data<T>() + (n * C + c) * (H_in * W_in);
+            T* Y_data = Y.MutableData<T>() + (n * C + c) * grid_size;
+
+            if (taps == 1) {
+              for (int64_t i = 0; i < grid_size; i++) {
+                Y_data[i] = weights[i] * X_data[offsets[i]];
+              }
+            } else {
+              for (int64_t i = 0; i < grid_size; i++) {
+                const int64_t* o = offsets + i * 4;
+                const T* w = weights + i * 4;
+                Y_data[i] = w[0] * X_data[o[0]] + w[1] * X_data[o[1]] + w[2] * X_data[o[2]] + w[3] * X_data[o[3]];
+              }
+            }
+          });
+    }
+
+    return Status::OK();
+  }
+
   for (int64_t n = 0; n < N; n++) {
-    const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
+    const T* grid_data = grid->Data<T>() + n * grid_size * 2;
     concurrency::ThreadPool::TrySimpleParallelFor(
         tp, C,
         [&](std::ptrdiff_t c) {
           const T* X_data = input->Data<T>() + (n * C + c) * (H_in * W_in);
-          T* Y_data = Y.MutableData<T>() + (n * C + c) * (H_out * W_out);
+          T* Y_data = Y.MutableData<T>() + (n * C + c) * grid_size;
 
           for (int64_t oy = 0; oy < H_out; oy++) {
             for (int64_t ox = 0; ox < W_out; ox++) {
               const T* gridpoint = grid_data + (oy * W_out + ox) * 2;
               T* Y_gridpoint = Y_data + oy * W_out + ox;
-              auto nx = gridpoint[0];  // normalized location
-              auto ny = gridpoint[1];
-              auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-              auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-
-              if (mode_ == Nearest) {
-                x = static_cast<T>(std::nearbyintf(static_cast<float>(x)));
-                y = static_cast<T>(std::nearbyintf(static_cast<float>(y)));
-              }
-
-              if (x < x_min || x > x_max || y < y_min || y > y_max) {  // out of bound
-                if (padding_mode_ == Border) {
-                  // use original border in both align_corner cases
-                  x = std::clamp(x, static_cast<T>(0), static_cast<T>(W_in - 1));
-                  y = std::clamp(y, static_cast<T>(0), static_cast<T>(H_in - 1));
-                } else if (padding_mode_ == Reflection) {
-                  x = GsReflect(x, x_min, x_max);
-                  y = GsReflect(y, y_min, y_max);
-                }
-              }  // out of bound
+              T x{};
+              T y{};
+              GridPointLocation(gridpoint[0], gridpoint[1], H_in, W_in, border, x, y);
 
-              if (mode_ == Nearest) {
-                // x, y are integers in all padding modes
-                *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                continue;
-              }
-
-              if (mode_ == Bilinear) {
-                int64_t x1 = static_cast<int64_t>(std::floor(x));
-                int64_t y1 = static_cast<int64_t>(std::floor(y));
-                int64_t x2 = x1 + 1;
-                int64_t y2 = y1 + 1;
-
-                T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                T dx2 = static_cast<T>(x2) - x;
-                T dx1 = x - static_cast<T>(x1);
-                T dy2 = static_cast<T>(y2) - y;
-                T dy1 = y - static_cast<T>(y1);
-                *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
-              }
-              if (mode_ == Bicubic) {
-                int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
-                int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
-                T p[4][4] = {};  // [H][W]
-                for (int64_t h = 0; h < 4; h++) {
-                  for (int64_t w = 0; w < 4; w++) {
-                    p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
-                  }
+              // (mode_ == Bicubic)
+              int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
+              int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
+              T p[4][4] = {};  // [H][W]
+              for (int64_t h = 0; h < 4; h++) {
+                for (int64_t w = 0; w < 4; w++) {
+                  p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
                 }
-                T dx = static_cast<T>(x - x0 - 1);
-                T dy = static_cast<T>(y - y0 - 1);
-                *Y_gridpoint = GsBicubicInterpolate(p, static_cast<float>(dx), static_cast<float>(dy));
               }
+              T dx = static_cast<T>(x - x0 - 1);
+              T dy = static_cast<T>(y - y0 - 1);
+              *Y_gridpoint = GsBicubicInterpolate(p, static_cast<float>(dx), static_cast<float>(dy));
             }
           }
         });
@@ -55,6 +55,14 @@ class GridSample final : public OpKernel {
 
   T PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const;
 
+  // Sets offset to the position in the image of the pixel at (r, c) after padding, and returns false if the pixel
+  // is a zero padding one.
+  bool PixelOffsetAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, const float border[/* 4 */],
+                         int64_t& offset) const;
+
+  // Returns the actual location in the input image of a normalized grid point, after padding.
+  void GridPointLocation(T nx, T ny, int64_t H_in, int64_t W_in, const float border[/* 4 */], T& x, T& y) const;
+
   GridSampleInterpolationMode mode_{Bilinear};
   GridSamplePaddingMode padding_mode_{Zeros};
   bool align_corners_{0};
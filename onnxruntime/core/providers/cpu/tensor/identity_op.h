@@ -94,11 +94,20 @@ class IdentityOp final : public OpKernel {
         if (!status.IsOK()) {
           ORT_THROW("Unable to get an allocator");
         }
-        std::vector<Tensor> tensors;
-        for (auto it = X->begin(), end = X->end(); it != end; ++it) {
-          Tensor tmp(it->DataType(), onnxruntime::TensorShape(it->Shape()), alloc);
-          size_t bytes = it->SizeInBytes();
-          memcpy(tmp.MutableDataRaw(), it->DataRaw(), bytes);
+        std::vector<OrtValue> tensors;
+        tensors.reserve(X->Size());
+        for (size_t i = 0, end = X->Size(); i < end; ++i) {
+          // the tensors owning their buffer are shared with the output, the others are copied
+          const OrtValue& value = X->GetAt(i);
+          const Tensor& tensor = value.Get<Tensor>();
+          if (tensor.OwnsBuffer()) {
+            tensors.push_back(value);
+            continue;
+          }
+
+          OrtValue tmp;
+          Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), alloc, tmp);
+          memcpy(tmp.GetMutable<Tensor>()->MutableDataRaw(), tensor.DataRaw(), tensor.SizeInBytes());
           tensors.push_back(std::move(tmp));
         }
 
@@ -3,10 +3,12 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <vector>
 
-#include "core/util/math_cpuonly.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -51,6 +53,12 @@ NONZERO_TYPED_KERNEL(float)
 #undef NONZERO_9_TYPED_KERNEL
 #undef NONZERO_TYPED_KERNEL
 
+namespace {
+// number of elements of each task. the elements are counted in a first pass and the coordinates are written in a
+// second pass, so the tasks can write their part of the output without synchronization.
+constexpr int64_t kNonZeroChunkSize = 16384;
+}  // namespace
+
 template <typename T>
 Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto X = context->Input<Tensor>(0);
@@ -59,25 +67,77 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : X_shape.NumDimensions();
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(X_shape.Size() * coordinate_size);
-
+  const int64_t coordinate_size = X_shape.IsScalar() ? 1 : static_cast<int64_t>(X_shape.NumDimensions());
+  const int64_t size = X_shape.Size();
   const T* data = X->Data<T>();
 
+  const int64_t num_chunks = std::max<int64_t>((size + kNonZeroChunkSize - 1) / kNonZeroChunkSize, 1);
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+
+  auto* tp = context->GetOperatorThreadPool();
+  auto run_chunks = [num_chunks, tp](const std::function<void(std::ptrdiff_t)>& fn) {
+    if (num_chunks == 1) {
+      fn(0);
+    } else {
+      concurrency::ThreadPool::TrySimpleParallelFor(tp, num_chunks, fn);
+    }
+  };
+
+  run_chunks([&](std::ptrdiff_t chunk) {
+    const T* begin = data + chunk * kNonZeroChunkSize;
+    const T* end = data + std::min(size, (chunk + 1) * kNonZeroChunkSize);
+    int64_t count = 0;
+    for (const T* cur = begin; cur != end; ++cur) {
+      count += *cur != T{} ? 1 : 0;
+    }
+    chunk_offsets[chunk + 1] = count;
+  });
+
+  for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+    chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+  }
+  const int64_t num_non_zero_values = chunk_offsets[num_chunks];
+
+  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+
+  int64_t* y_data = Y->MutableData<int64_t>();
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
+
   if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
+    y_data[0] = 0;
+    return Status::OK();
+  }
+
+  // the output is (coordinate_size, num_non_zero_values), so each dimension of the coordinates is a row.
+  run_chunks([&](std::ptrdiff_t chunk) {
+    int64_t out = chunk_offsets[chunk];
+    if (out == chunk_offsets[chunk + 1]) {
+      return;
     }
-  } else {
+
+    // coordinate of the first element of the chunk.
+    const int64_t chunk_begin = chunk * kNonZeroChunkSize;
     std::vector<int64_t> coordinate(coordinate_size, 0);
+    for (int64_t idx = coordinate_size - 1, remaining = chunk_begin; idx >= 0 && remaining > 0; --idx) {
+      coordinate[idx] = remaining % X_shape[idx];
+      remaining /= X_shape[idx];
+    }
 
     // as we iterate the entries, increment the coordinate for the current entry
     // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
+    const int64_t chunk_end = std::min(size, chunk_begin + kNonZeroChunkSize);
+    for (int64_t i = chunk_begin; i < chunk_end; ++i) {
+      if (data[i] != T{}) {
+        for (int64_t idx = 0; idx < coordinate_size; ++idx) {
+          y_data[idx * num_non_zero_values + out] = coordinate[idx];
+        }
+        ++out;
+      }
+
+      for (int64_t idx = coordinate_size - 1; idx >= 0; --idx) {
         int64_t& cur_coord = coordinate[idx];
         if (cur_coord != X_shape[idx] - 1) {
           ++cur_coord;
@@ -85,33 +145,8 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
         }
         cur_coord = 0;
       }
-    };
-
-    for (size_t i = 0, end = X_shape.Size(); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
-
-      increment_coordinate();
     }
-  }
-
-  const Eigen::Index num_non_zero_values = non_zero_indices_buffer.size() / coordinate_size;
-
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
-
-  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
-
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  });
 
   return Status::OK();
 }
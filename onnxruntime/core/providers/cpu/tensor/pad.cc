@@ -266,6 +266,131 @@ static void ReshapePads(const PadsVector& src_pad, size_t src_dim_count, size_t
   reshaped_pad[inner_axis + new_dim_count] = src_pad[inner_axis + src_dim_count] * inner_no_pad_size;
 }
 
+// Pads the rows of the innermost axis of the output in parallel. The rows inside the input along every outer axis
+// are copied from the input and padded along the innermost axis. The other rows are filled with the constant, or
+// copy the row they replicate for edge and reflect modes, which is one of the former, so they are written after.
+// pads, input_starts and input_extents are along the flattened dims, and the innermost axis is padded with
+// inner_pre_blocks and inner_post_blocks blocks of inner_no_pad_size elements.
+template <typename T>
+static void PadRows(concurrency::ThreadPool* tp, const Mode& mode, T value,
+                    const T* input, const TensorShapeVector& input_dims,
+                    const TensorShapeVector& input_starts, const TensorShapeVector& input_extents,
+                    T* output, const TensorShapeVector& output_dims, const PadsVector& pads,
+                    size_t inner_no_pad_size, int64_t inner_pre_blocks, int64_t inner_post_blocks) {
+  const size_t dims_count = output_dims.size();
+  const size_t inner_axis = dims_count - 1;
+  const TensorPitches input_pitches(input_dims);
+  const TensorPitches output_pitches(output_dims);
+
+  const int64_t row_size = output_dims[inner_axis];
+  const int64_t pre_pad = pads[inner_axis];
+  const int64_t post_pad = pads[inner_axis + dims_count];
+  const int64_t extent = input_extents[inner_axis];
+  const double row_cost = static_cast<double>(row_size * sizeof(T));
+
+  // Coordinate in the copied part of the input of an output coordinate along an outer axis, -1 for a constant.
+  auto input_coordinate = [&](size_t axis, int64_t coordinate) -> int64_t {
+    const int64_t i = coordinate - pads[axis];
+    const int64_t axis_extent = input_extents[axis];
+    if (i >= 0 && i < axis_extent) {
+      return i;
+    }
+    switch (mode) {
+      case Mode::Edge:
+        return i < 0 ? 0 : axis_extent - 1;
+      case Mode::Reflect:
+        // Pads larger than the extent minus 1 cannot be reflected once, they replicate the edge.
+        return std::min(std::max(i < 0 ? -i : 2 * (axis_extent - 1) - i, int64_t{0}), axis_extent - 1);
+      default:
+        return -1;
+    }
+  };
+
+  // Rows inside the input.
+  int64_t input_rows = 1;
+  for (size_t axis = 0; axis < inner_axis; ++axis) {
+    input_rows *= input_extents[axis];
+  }
+  concurrency::ThreadPool::TryParallelFor(
+      tp, input_rows, row_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t r = first; r < last; ++r) {
+          const T* input_row = input + input_starts[inner_axis];
+          T* row = output;
+          for (int64_t axis = static_cast<int64_t>(inner_axis) - 1, index = r; axis >= 0; --axis) {
+            const int64_t coordinate = index % input_extents[axis];
+            index /= input_extents[axis];
+            input_row += (input_starts[axis] + coordinate) * input_pitches[axis];
+            row += (coordinate + pads[axis]) * output_pitches[axis];
+          }
+
+          T* axis_start = row + pre_pad;
+          T* axis_end = std::copy_n(input_row, extent, axis_start);
+          switch (mode) {
+            case Mode::Constant:
+              PadAxisConstant(row, value, pre_pad);
+              PadAxisConstant(axis_end, value, post_pad);
+              break;
+            case Mode::Edge:
+              if (inner_no_pad_size == 1) {
+                PadAxisConstant(row, *axis_start, pre_pad);
+                PadAxisConstant(axis_end, *(axis_end - 1), post_pad);
+              } else {
+                // When inner_most axis(es) do not need pad, above PadAxisConstant() do not fit for Edge mode.
+                PadAxis(row, axis_start, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, inner_pre_blocks);
+                PadAxis(axis_end, axis_end - inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size,
+                        inner_post_blocks);
+              }
+              break;
+            case Mode::Reflect:
+              if (inner_no_pad_size == 1) {
+                PadInnermostAxis(row, axis_start + pre_pad, -1 /* inputDelta */, pre_pad);
+                PadInnermostAxis(axis_end, axis_end - 2, -1 /* inputDelta */, post_pad);
+              } else {
+                // When inner_most axis(es) do not need pad, Above PadInnermostAxis() do not fit for Reflect mode.
+                PadAxis(row, axis_start + pre_pad, 1, -ptrdiff_t(inner_no_pad_size * 2), inner_no_pad_size,
+                        inner_pre_blocks);
+                PadAxis(axis_end, axis_end - 2 * inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size * 2),
+                        inner_no_pad_size, inner_post_blocks);
+              }
+              break;
+          }
+        }
+      });
+
+  if (inner_axis == 0) {
+    return;
+  }
+
+  // Rows of padding along an outer axis.
+  const int64_t output_rows = output_pitches[0] * output_dims[0] / row_size;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, output_rows, row_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t r = first; r < last; ++r) {
+          bool is_padding = false;
+          bool is_constant = false;
+          int64_t source_offset = 0;
+          for (int64_t axis = static_cast<int64_t>(inner_axis) - 1, index = r; axis >= 0; --axis) {
+            const int64_t coordinate = index % output_dims[axis];
+            index /= output_dims[axis];
+            const int64_t i = input_coordinate(axis, coordinate);
+            is_padding |= coordinate < pads[axis] || coordinate >= pads[axis] + input_extents[axis];
+            is_constant |= i < 0;
+            source_offset += (i + pads[axis]) * output_pitches[axis];
+          }
+
+          if (!is_padding) {
+            continue;
+          }
+          T* row = output + r * row_size;
+          if (is_constant) {
+            PadAxisConstant(row, value, row_size);
+          } else {
+            std::copy_n(output + source_offset, row_size, row);
+          }
+        }
+      });
+}
+
 template <typename T>
 static Status PadImpl(OpKernelContext* ctx,
                       const PadsVector& pads,
@@ -323,132 +448,17 @@ static Status PadImpl(OpKernelContext* ctx,
     return PadInputWithDimValueOfZero(ctx, mode, orig_input_shape, output_dims, value);
   }
 
-  TensorShape input_shape(reshaped_input_dims);
-  SliceIterator<T> input(input_tensor, input_shape, input_starts, input_extents, {});
-
-  // output_shape need to keep original.
   TensorShape output_shape(output_dims);
   auto& output_tensor = *ctx->Output(0, output_shape);
-  auto* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
-
-  TensorPitches output_pitches(reshaped_output_dims);
-  size_t alignSkip = 0;  // Amount to skip to align to where the next input tensor data needs to be written
-
-  // Initial skip, sum up the begin padding on each axis
-  for (size_t i = 0; i < new_dims_count; i++)
-    alignSkip += reshaped_pad[i] * output_pitches[i];
-
-  ExtentAxisCounters input_counters(input_extents);
-
-  switch (mode) {
-    case Mode::Constant:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          PadAxisConstant(axisStart - prePad, value, prePad);
-          PadAxisConstant(output, value, postPad);
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxisConstant(axisStart - prePad * inner_pitch, value, prePad * inner_pitch);
-          PadAxisConstant(output, value, postPad * inner_pitch);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
-      }
-      break;
-
-    case Mode::Edge:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadAxisConstant(axisStart - prePad, *axisStart, prePad);
-            PadAxisConstant(output, *(output - 1), postPad);
-          } else {
-            // When inner_most axis(es) do not need pad, above PadAxisConstant() do not fit for Edge mode.
-            // Also general loop below after handling first pad axis with non-pad axis works fine.
-            PadAxis(axisStart - prePad, axisStart, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, pads[inner_axis]);
-            PadAxis(output, output - inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, pads[inner_axis + data_rank]);
-          }
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxis(axisStart - prePad * inner_pitch, axisStart, 1, -inner_pitch, inner_pitch, prePad);
-          PadAxis(output, output - inner_pitch, 1, -inner_pitch, inner_pitch, postPad);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
-      }
-      break;
-
-    case Mode::Reflect:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadInnermostAxis(axisStart - prePad, axisStart + prePad, -1 /* inputDelta */, prePad);
-            PadInnermostAxis(output, output - 2, -1 /* inputDelta */, postPad);
-          } else {
-            // When inner_most axis(es) do not need pad, Above PadInnermostAxis() do not fit for Reflect mode.
-            PadAxis(axisStart - prePad, axisStart + prePad, 1, -ptrdiff_t(inner_no_pad_size * 2), inner_no_pad_size, pads[inner_axis]);
-            PadAxis(output, output - 2 * inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size * 2), inner_no_pad_size, pads[inner_axis + data_rank]);
-          }
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxis(axisStart - prePad * inner_pitch, axisStart + prePad * inner_pitch, 1, -inner_pitch * 2,
-                  inner_pitch, prePad);
-          PadAxis(output, output - 2 * inner_pitch, 1, -inner_pitch * 2, inner_pitch, postPad);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
-      }
-      break;
+  if (output_shape.Size() == 0) {
+    return Status::OK();
   }
 
+  PadRows(ctx->GetOperatorThreadPool(), mode, value,
+          reinterpret_cast<const T*>(input_tensor.DataRaw()), reshaped_input_dims, input_starts, input_extents,
+          reinterpret_cast<T*>(output_tensor.MutableDataRaw()), reshaped_output_dims, reshaped_pad,
+          inner_no_pad_size, pads[inner_axis], pads[inner_axis + data_rank]);
+
   return Status::OK();
 }
 
@@ -42,35 +42,43 @@ using EnabledIndicesTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuE
                                                                            Slice, Input, 1);
 }  // namespace
 
+// The output is a strided view of the input when all the consumers of the output accept strided inputs.
+static KernelDefBuilder& MayStridedOutputIfEnabled(KernelDefBuilder& builder) {
+#ifdef ENABLE_STRIDED_TENSORS
+  builder.MayStridedOutput(0, 0);
+#endif
+  return builder;
+}
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    MayStridedOutputIfEnabled(KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     10, 10,
-    KernelDefBuilder()
-        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+    MayStridedOutputIfEnabled(KernelDefBuilder()
+                                  .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
+                                  .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())),
     Slice10);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     11,
     12,
-    KernelDefBuilder()
-        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+    MayStridedOutputIfEnabled(KernelDefBuilder()
+                                  .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
+                                  .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())),
     Slice10);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Slice,
     13,
-    KernelDefBuilder()
-        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+    MayStridedOutputIfEnabled(KernelDefBuilder()
+                                  .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
+                                  .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())),
     Slice10);
 
 // Check if it's possible to combine innermost dimensions so we copy larger blocks.
@@ -222,6 +230,23 @@ static Status SliceImpl(OpKernelContext* ctx,
   if (output_shape.Size() == 0)
     return Status::OK();
 
+#ifdef ENABLE_STRIDED_TENSORS
+  // The allocation planner gives the output the buffer of the input when all the consumers of the output accept
+  // strided inputs. The flattened dims, if any, have start 0 and step 1, so they keep the strides of the input.
+  if (output_tensor.DataRaw() == input_tensor.DataRaw()) {
+    const auto input_strides = input_tensor.Strides();
+    TensorShapeVector output_strides(input_strides.begin(), input_strides.end());
+    int64_t offset = 0;
+    for (size_t i = 0; i < compute_metadata.starts_.size(); ++i) {
+      offset += compute_metadata.starts_[i] * input_strides[i];
+      output_strides[i] *= compute_metadata.steps_[i];
+    }
+    output_tensor.SetShapeAndStrides(output_shape, output_strides);
+    output_tensor.SetByteOffset(output_tensor.ByteOffset() + offset * static_cast<int64_t>(sizeof(T)));
+    return Status::OK();
+  }
+#endif
+
   // use MutableDataRaw as actual data type in tensor may not match as we templatize on data size
   T* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
   const auto* output_end = output + output_tensor.Shape().Size();
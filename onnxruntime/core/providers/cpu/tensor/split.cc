@@ -186,16 +186,19 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
     T* output_data = output->template MutableData<T>();
 
-    ::onnxruntime::math::CopyMatrix<T>(
-        before_dims,                                       // M
-        split_size * after_dims_excluding_split,           // N
-        static_cast<const T*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                   // lda
-        static_cast<T*>(output_data),                      // B
-        split_size * after_dims_excluding_split,           // ldb
-        [](const T* src, T* dst, size_t count) {
-          copy_data<T>(src, dst, count);
-        });
+    // the allocation planner may have planned the output as a view of the input (see AllocKind::kSlice)
+    if (output_data != input_data + input_offset) {
+      ::onnxruntime::math::CopyMatrix<T>(
+          before_dims,                                       // M
+          split_size * after_dims_excluding_split,           // N
+          static_cast<const T*>(input_data + input_offset),  // A
+          after_dims_including_split_axis,                   // lda
+          static_cast<T*>(output_data),                      // B
+          split_size * after_dims_excluding_split,           // ldb
+          [](const T* src, T* dst, size_t count) {
+            copy_data<T>(src, dst, count);
+          });
+    }
 
     input_offset += static_cast<int64_t>(split_size) * after_dims_excluding_split;  // offset by the N data we used in this iteration
   }
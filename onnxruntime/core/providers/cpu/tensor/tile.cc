@@ -56,47 +56,49 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
     Tile);
 
-Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches, size_t element_size) {
-  const auto& input_shape = input_tensor.Shape().GetDims();
-  const size_t dimension_count = input_shape.size();
-
-  const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
-  auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
+// Tiles the input with one parallel loop. For the last axis with a repeat other than 1, the output is a sequence of
+// rows, one per output index along the axes before it, and each row is repeats[axis] copies of the input slab at the
+// corresponding input index, which is contiguous. The copies of the slabs are independent.
+static void TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats,
+                                      size_t element_size, concurrency::ThreadPool* tp) {
+  const auto& input_shape = input_tensor.Shape();
+  const auto input_dims = input_shape.GetDims();
+  const TensorPitches input_pitches(input_tensor);
 
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const uint8_t* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
+  size_t axis = input_dims.size() - 1;
+  while (axis > 0 && repeats[axis] == 1) {
+    --axis;
+  }
 
-  while (input_counters) {
-    // Copy the input data over
-    block_size = innermost_dim * element_size;
-    memcpy(output, input, block_size);
-    output += block_size;
-    input += block_size;
+  const size_t slab_bytes = static_cast<size_t>(input_shape.SizeFromDimension(axis)) * element_size;
+  const int64_t slab_repeats = repeats[axis];
+  int64_t num_rows = 1;
+  for (size_t i = 0; i < axis; ++i) {
+    num_rows *= input_dims[i] * repeats[i];
+  }
 
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      memcpy(output, copy, block_size);
-      output += block_size;
-    }
+  const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
+  auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
 
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()];
-      block_size = pitch * element_size;
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        memcpy(output, copy, block_size);
-        output += block_size;
-      }
-    }
-  }
-  return Status::OK();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows * slab_repeats, static_cast<double>(slab_bytes),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        int64_t row = -1;
+        const uint8_t* slab = nullptr;
+        for (std::ptrdiff_t copy = first; copy < last; ++copy) {
+          if (copy / slab_repeats != row) {
+            row = copy / slab_repeats;
+            int64_t offset = 0;
+            for (int64_t i = static_cast<int64_t>(axis) - 1, index = row; i >= 0; --i) {
+              const int64_t output_dim = input_dims[i] * repeats[i];
+              offset += (index % output_dim) % input_dims[i] * input_pitches[i];
+              index /= output_dim;
+            }
+            slab = input + offset * element_size;
+          }
+          memcpy(output + copy * slab_bytes, slab, slab_bytes);
+        }
+      });
 }
 
 namespace TileOp {
@@ -169,98 +171,18 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
+  // TODO: Handle string copies when the kernel eventually supports string type.
+  // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
+  ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
+
   // Repeat tensor has all 1s in it
   if (output_shape == input_shape) {
-    // TODO: Handle string copies when the kernel eventually supports string type.
-    // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
-    ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
     memcpy(output_tensor.MutableDataRaw(), input_tensor.DataRaw(), input_tensor.SizeInBytes());
     return Status::OK();
   }
 
-  bool is_batched_memcpy = false;
-  size_t num_of_elements_per_batch = 1;
-  size_t num_of_copies_per_batch = 1;
-  size_t num_of_batch_copies = 1;
-  if (TileOp::IsTileMemcpy(input_shape,
-                           repeats,
-                           input_rank,
-                           is_batched_memcpy,
-                           num_of_elements_per_batch,
-                           num_of_copies_per_batch,
-                           num_of_batch_copies)) {
-    // TODO: Handle string copies when the kernel eventually supports string type.
-    // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
-    ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
-
-    int8_t* output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-    const int8_t* input_data_casted = reinterpret_cast<const int8_t*>(input_tensor.DataRaw());
-    const void* input_data_raw = input_tensor.DataRaw();
-
-    if (!is_batched_memcpy) {
-      size_t copy_bytes = input_tensor.SizeInBytes();
-      // TODO: Add multi-threading logic if num_of_copies_per_batch is large enough
-      for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-        memcpy(static_cast<void*>(output_data_casted), input_data_raw, copy_bytes);
-        output_data_casted += copy_bytes;
-      }
-    } else {
-      size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
-      size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
-
-      // TODO: Multi-thread if needed
-      for (size_t batch = 0; batch < batch_count; ++batch) {
-        for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-          memcpy(static_cast<void*>(output_data_casted), static_cast<const void*>(input_data_casted), copy_bytes);
-          output_data_casted += copy_bytes;
-        }
-        input_data_casted += copy_bytes;
-      }
-
-      // Now account for batch dim repeat
-      if (num_of_batch_copies > 1) {
-        // reset some values
-        output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-        copy_bytes *= num_of_copies_per_batch * batch_count;
-        int8_t* copy_ptr = output_data_casted + copy_bytes;
-
-        for (size_t i = 1; i < num_of_batch_copies; ++i) {
-          memcpy(static_cast<void*>(copy_ptr), static_cast<const void*>(output_data_casted), copy_bytes);
-          copy_ptr += copy_bytes;
-        }
-      }
-    }
-
-    return Status::OK();
-  }
-
-  TensorAxisCounters input_counters(input_tensor);
-  TensorPitches output_pitches(output_tensor);
-
-  static_assert(sizeof(float) == sizeof(int32_t), "Float and Int32 are of different sizes");
-  static_assert(sizeof(double) == sizeof(int64_t), "Double and Int64 are of different sizes");
-
-  if (input_tensor.IsDataType<float>() ||
-      input_tensor.IsDataType<int32_t>() ||
-      input_tensor.IsDataType<uint32_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(float));
-
-  if (input_tensor.IsDataType<double>() || input_tensor.IsDataType<int64_t>() ||
-      input_tensor.IsDataType<uint64_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(double));
-
-  else if (input_tensor.IsDataType<int8_t>() ||
-           input_tensor.IsDataType<uint8_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int8_t));
-
-  if (input_tensor.IsDataType<int16_t>() || input_tensor.IsDataType<uint16_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int16_t));
-
-  else if (input_tensor.IsDataType<bool>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(bool));
-
-  // TODO: Support 'string' and 'float16' types for completeness
-  else
-    ORT_THROW("Tile doesn't have an implementation yet for the type: ", input_tensor.DataType());
+  TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_tensor.DataType()->Size(),
+                            ctx->GetOperatorThreadPool());
+  return Status::OK();
 }
 }  // namespace onnxruntime
@@ -3,11 +3,15 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
 #include "core/framework/transpose_helper.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "utils.h"
 
@@ -249,6 +253,273 @@ static void DoTransposeEltWise(int64_t num_axes, gsl::span<const int64_t> target
   }
 }
 
+/* The N-D transpose of the non-string types is reduced to its essential axes before it is run: the axes of size 1
+ * are dropped, and the runs of input axes that stay adjacent and in the same order in the output are merged.
+ * E.g. the attention reshape [B,S,N,H] -> [B,N,S,H] becomes [B,S,N] -> [B,N,S] with blocks of H elements.
+ *
+ * If the innermost axis stays in place, the output is a sequence of blocks copied with memcpy. Otherwise the
+ * innermost axis of the input and the input axis that becomes the innermost axis of the output form a 2-D
+ * transpose, which is run in tiles of rows with the MLAS SIMD kernels, strided over the other axes.
+ * The blocks or tiles are split across the threads of the thread pool.
+ */
+struct TransposePlan {
+  InlinedVector<size_t> input_dims;  // reduced dims in input order
+  InlinedVector<size_t> perm;        // reduced permutation
+};
+
+static TransposePlan ReduceTranspose(const gsl::span<const size_t>& permutations,
+                                     gsl::span<const int64_t> input_dims) {
+  const size_t rank = input_dims.size();
+
+  // drop the axes of size 1
+  InlinedVector<size_t> compact_axis(rank);
+  size_t compact_rank = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    compact_axis[i] = compact_rank;
+    if (input_dims[i] != 1) {
+      ++compact_rank;
+    }
+  }
+  InlinedVector<size_t> perm;
+  InlinedVector<size_t> dims(compact_rank);
+  for (size_t i = 0; i < rank; ++i) {
+    const size_t axis = permutations[i];
+    if (input_dims[axis] != 1) {
+      perm.push_back(compact_axis[axis]);
+      dims[compact_axis[axis]] = static_cast<size_t>(input_dims[axis]);
+    }
+  }
+
+  // merge the runs of consecutive input axes in the output order
+  InlinedVector<size_t> group_first_axis;
+  InlinedVector<size_t> group_dim;
+  for (size_t i = 0; i < perm.size();) {
+    size_t dim = dims[perm[i]];
+    size_t j = i + 1;
+    while (j < perm.size() && perm[j] == perm[j - 1] + 1) {
+      dim *= dims[perm[j]];
+      ++j;
+    }
+    group_first_axis.push_back(perm[i]);
+    group_dim.push_back(dim);
+    i = j;
+  }
+
+  // the reduced input axes are the runs sorted by their first input axis
+  const size_t reduced_rank = group_first_axis.size();
+  InlinedVector<size_t> input_order(reduced_rank);
+  std::iota(input_order.begin(), input_order.end(), size_t{0});
+  std::sort(input_order.begin(), input_order.end(), [&group_first_axis](size_t a, size_t b) {
+    return group_first_axis[a] < group_first_axis[b];
+  });
+
+  TransposePlan plan;
+  plan.input_dims.resize(reduced_rank);
+  plan.perm.resize(reduced_rank);
+  for (size_t input_axis = 0; input_axis < reduced_rank; ++input_axis) {
+    const size_t output_axis = input_order[input_axis];
+    plan.input_dims[input_axis] = group_dim[output_axis];
+    plan.perm[output_axis] = input_axis;
+  }
+  return plan;
+}
+
+// Walks the multi-index of the outer axes of a transpose, keeping the offsets of the input and of the output.
+class OuterAxesIterator {
+ public:
+  OuterAxesIterator(InlinedVector<size_t> dims, InlinedVector<size_t> input_strides,
+                    InlinedVector<size_t> output_strides)
+      : dims_(std::move(dims)),
+        input_strides_(std::move(input_strides)),
+        output_strides_(std::move(output_strides)),
+        index_(dims_.size()) {}
+
+  void Seek(size_t position) {
+    input_offset_ = 0;
+    output_offset_ = 0;
+    for (size_t i = dims_.size(); i-- > 0;) {
+      index_[i] = position % dims_[i];
+      position /= dims_[i];
+      input_offset_ += index_[i] * input_strides_[i];
+      output_offset_ += index_[i] * output_strides_[i];
+    }
+  }
+
+  void Next() {
+    for (size_t i = dims_.size(); i-- > 0;) {
+      input_offset_ += input_strides_[i];
+      output_offset_ += output_strides_[i];
+      if (++index_[i] < dims_[i]) {
+        return;
+      }
+      input_offset_ -= index_[i] * input_strides_[i];
+      output_offset_ -= index_[i] * output_strides_[i];
+      index_[i] = 0;
+    }
+  }
+
+  size_t InputOffset() const { return input_offset_; }
+  size_t OutputOffset() const { return output_offset_; }
+
+ private:
+  InlinedVector<size_t> dims_;
+  InlinedVector<size_t> input_strides_;
+  InlinedVector<size_t> output_strides_;
+  InlinedVector<size_t> index_;
+  size_t input_offset_ = 0;
+  size_t output_offset_ = 0;
+};
+
+template <typename T>
+static void TransposeTile(const T* input, size_t ld_input, T* output, size_t ld_output, size_t M, size_t N) {
+  for (size_t n = 0; n < N; ++n) {
+    const T* s = input + n;
+    T* d = output + n * ld_output;
+    for (size_t m = 0; m < M; ++m) {
+      d[m] = s[m * ld_input];
+    }
+  }
+}
+
+static void TransposeTile(const uint8_t* input, size_t ld_input, uint8_t* output, size_t ld_output,
+                          size_t M, size_t N) {
+  MlasTranspose(input, ld_input, output, ld_output, M, N);
+}
+
+static void TransposeTile(const uint32_t* input, size_t ld_input, uint32_t* output, size_t ld_output,
+                          size_t M, size_t N) {
+  MlasTranspose(input, ld_input, output, ld_output, M, N);
+}
+
+// Runs the 2-D transpose of input axis `row_axis` and of the innermost input axis for each position of the other
+// axes. The rows are split in tiles, which bounds the cache lines of the input in use while the tile is transposed.
+template <typename T>
+static bool TypedTransposeTiles(const TransposePlan& plan, const InlinedVector<size_t>& input_strides,
+                                const InlinedVector<size_t>& output_strides, const uint8_t* source, uint8_t* target,
+                                concurrency::ThreadPool* tp) {
+  constexpr bool enabled = utils::HasTypeWithSameSize<EnabledDataTypes, T>();
+  if (!enabled) {
+    return false;
+  }
+
+  constexpr size_t tile_rows = 64;
+
+  const size_t rank = plan.perm.size();
+  const size_t row_axis = plan.perm[rank - 1];
+  const size_t column_output_axis = static_cast<size_t>(
+      std::find(plan.perm.begin(), plan.perm.end(), rank - 1) - plan.perm.begin());
+  const size_t rows = plan.input_dims[row_axis];
+  const size_t columns = plan.input_dims[rank - 1];
+
+  InlinedVector<size_t> outer_dims;
+  InlinedVector<size_t> outer_input_strides;
+  InlinedVector<size_t> outer_output_strides;
+  for (size_t i = 0; i < rank - 1; ++i) {
+    if (i != column_output_axis) {
+      outer_dims.push_back(plan.input_dims[plan.perm[i]]);
+      outer_input_strides.push_back(input_strides[plan.perm[i]]);
+      outer_output_strides.push_back(output_strides[i]);
+    }
+  }
+  const size_t outer_count = std::accumulate(outer_dims.begin(), outer_dims.end(), size_t{1},
+                                             std::multiplies<size_t>());
+  const size_t tiles_per_outer = (rows + tile_rows - 1) / tile_rows;
+
+  const auto* input_data = reinterpret_cast<const T*>(source);
+  auto* output_data = reinterpret_cast<T*>(target);
+  const size_t ld_input = input_strides[row_axis];
+  const size_t ld_output = output_strides[column_output_axis];
+
+  const double tile_bytes = static_cast<double>(std::min(rows, tile_rows) * columns * sizeof(T));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(outer_count * tiles_per_outer),
+      TensorOpCost{tile_bytes, tile_bytes, tile_bytes / sizeof(T)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        OuterAxesIterator outer(outer_dims, outer_input_strides, outer_output_strides);
+        outer.Seek(static_cast<size_t>(first) / tiles_per_outer);
+        for (auto tile = static_cast<size_t>(first); tile < static_cast<size_t>(last); ++tile) {
+          const size_t row = (tile % tiles_per_outer) * tile_rows;
+          if (row == 0 && tile != static_cast<size_t>(first)) {
+            outer.Next();
+          }
+          TransposeTile(input_data + outer.InputOffset() + row * ld_input, ld_input,
+                        output_data + outer.OutputOffset() + row, ld_output,
+                        std::min(tile_rows, rows - row), columns);
+        }
+      });
+
+  return true;
+}
+
+// Transposes the non-string types with the plan of the transpose. Returns false if the element size is not
+// supported, the caller then falls back to the other implementations.
+static bool TransposeWithPlan(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
+                              const TensorShape& input_shape, concurrency::ThreadPool* tp) {
+  const size_t element_size = input.DataType()->Size();
+  const TransposePlan plan = ReduceTranspose(permutations, input_shape.GetDims());
+  const size_t rank = plan.perm.size();
+
+  const auto* source = reinterpret_cast<const uint8_t*>(input.DataRaw());
+  auto* target = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+
+  if (rank <= 1) {
+    memcpy(target, source, static_cast<size_t>(input_shape.Size()) * element_size);
+    return true;
+  }
+
+  InlinedVector<size_t> input_strides(rank);
+  InlinedVector<size_t> output_strides(rank);
+  size_t input_stride = 1;
+  size_t output_stride = 1;
+  for (size_t i = rank; i-- > 0;) {
+    input_strides[i] = input_stride;
+    input_stride *= plan.input_dims[i];
+    output_strides[i] = output_stride;
+    output_stride *= plan.input_dims[plan.perm[i]];
+  }
+
+  if (plan.perm[rank - 1] == rank - 1) {
+    // the innermost axis stays in place, so copy blocks of it
+    const size_t block_size = plan.input_dims[rank - 1] * element_size;
+    InlinedVector<size_t> outer_dims;
+    InlinedVector<size_t> outer_input_strides;
+    InlinedVector<size_t> outer_output_strides;
+    for (size_t i = 0; i < rank - 1; ++i) {
+      outer_dims.push_back(plan.input_dims[plan.perm[i]]);
+      outer_input_strides.push_back(input_strides[plan.perm[i]] * element_size);
+      outer_output_strides.push_back(output_strides[i] * element_size);
+    }
+    const size_t outer_count = std::accumulate(outer_dims.begin(), outer_dims.end(), size_t{1},
+                                               std::multiplies<size_t>());
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(outer_count),
+        TensorOpCost{static_cast<double>(block_size), static_cast<double>(block_size), 1.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          OuterAxesIterator outer(outer_dims, outer_input_strides, outer_output_strides);
+          outer.Seek(static_cast<size_t>(first));
+          for (auto block = first; block < last; ++block) {
+            memcpy(target + outer.OutputOffset(), source + outer.InputOffset(), block_size);
+            outer.Next();
+          }
+        });
+    return true;
+  }
+
+  switch (element_size) {
+    case sizeof(uint64_t):
+      return TypedTransposeTiles<uint64_t>(plan, input_strides, output_strides, source, target, tp);
+    case sizeof(uint32_t):
+      return TypedTransposeTiles<uint32_t>(plan, input_strides, output_strides, source, target, tp);
+    case sizeof(uint16_t):
+      return TypedTransposeTiles<uint16_t>(plan, input_strides, output_strides, source, target, tp);
+    case sizeof(uint8_t):
+      return TypedTransposeTiles<uint8_t>(plan, input_strides, output_strides, source, target, tp);
+    default:
+      return false;
+  }
+}
+
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
                                  const TensorShape* input_shape_override = nullptr) {
@@ -341,7 +612,7 @@ bool IsTransposeReshape(const gsl::span<const size_t>& perm, gsl::span<const int
 
 //`input_shape_override` overrides the shape of `input` for compute purposes.
 Status TransposeBase::DoTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                  const TensorShape* input_shape_override) {
+                                  const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -359,6 +630,10 @@ Status TransposeBase::DoTranspose(const gsl::span<const size_t>& permutations, c
       return Status::OK();
     }
 
+    if (!input.IsDataTypeString() && TransposeWithPlan(permutations, input, output, shape, tp)) {
+      return Status::OK();
+    }
+
     size_t from = 0, to = 0;
     bool moving_single_axis = IsTransposeMovingSingleAxis(permutations, from, to);
 
@@ -394,6 +669,19 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   if (output_shape.Size() == 0)
     return Status::OK();
 
+#ifdef ENABLE_STRIDED_TENSORS
+  // The allocation planner gives Y the buffer of X when all the consumers of Y accept strided inputs.
+  if (Y.DataRaw() == X.DataRaw()) {
+    const auto input_strides = X.Strides();
+    TensorShapeVector output_strides(rank);
+    for (size_t i = 0; i < rank; ++i) {
+      output_strides[i] = input_strides[(*p_perm)[i]];
+    }
+    Y.SetShapeAndStrides(output_shape, output_strides);
+    return Status::OK();
+  }
+#endif
+
   if (IsTransposeReshape(*p_perm, input_dims)) {
     // As long as the dims with values > 1 stay in the same order, it's a reshape.
     // Example: Shape=(1,1,1024,4096) -> perm=(2,0,3,1).
@@ -401,6 +689,10 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
+  if (!X.IsDataTypeString() && TransposeWithPlan(*p_perm, X, Y, input_shape, ctx->GetOperatorThreadPool())) {
+    return Status::OK();
+  }
+
   size_t from = 0, to = 0;
   bool moving_single_axis = IsTransposeMovingSingleAxis(*p_perm, from, to);
 
@@ -414,17 +706,25 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   return status;
 }
 
+// Y is a strided view of X when all the consumers of Y accept strided inputs.
+static KernelDefBuilder& MayStridedOutputIfEnabled(KernelDefBuilder& builder) {
+#ifdef ENABLE_STRIDED_TENSORS
+  builder.MayStridedOutput(0, 0);
+#endif
+  return builder;
+}
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Transpose,
     1,
     12,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    MayStridedOutputIfEnabled(KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())),
     Transpose);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Transpose,
     13,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    MayStridedOutputIfEnabled(KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())),
     Transpose);
 
 }  // namespace onnxruntime
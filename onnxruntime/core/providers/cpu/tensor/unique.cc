@@ -3,9 +3,13 @@
 
 #include "core/providers/cpu/tensor/unique.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <type_traits>
 #include "gsl/gsl"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -299,6 +303,194 @@ static void CreateOutput(OpKernelContext& context,
   }
 }
 
+// Hash of a value for the open addressing table. -0 and +0 are equal so they need the same hash.
+template <typename T>
+static inline uint64_t UniqueValueBits(T value) {
+  if constexpr (std::is_floating_point<T>::value) {
+    value += T{0};
+    typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  } else {
+    return static_cast<uint64_t>(value);
+  }
+}
+
+// NaN values are all treated as one unique value, so they don't make an ever growing probe sequence.
+template <typename T>
+static inline bool UniqueValuesEqual(T lhs, T rhs) {
+  if constexpr (std::is_floating_point<T>::value) {
+    return lhs == rhs || (lhs != lhs && rhs != rhs);
+  } else {
+    return lhs == rhs;
+  }
+}
+
+// Finds the unique values of a flattened input in the order of their first occurrence, with an open addressing
+// hash table using linear probing. Each slot of the table holds the index of a unique value, or -1 when empty.
+template <typename T>
+static void FindUniqueValues(gsl::span<const T> data,
+                             std::vector<T>& values,
+                             std::vector<int64_t>& first_indices,
+                             std::vector<int64_t>& counts,
+                             std::vector<int64_t>& inverse_index) {
+  int capacity_bits = 10;
+  std::vector<int64_t> slots;
+  auto slot_of = [&capacity_bits](T value) {
+    // Fibonacci hashing spreads consecutive ids over the table.
+    return static_cast<size_t>((UniqueValueBits(value) * 0x9E3779B97F4A7C15ull) >> (64 - capacity_bits));
+  };
+
+  auto rehash = [&]() {
+    slots.assign(size_t{1} << capacity_bits, -1);
+    const size_t mask = slots.size() - 1;
+    for (size_t u = 0; u < values.size(); ++u) {
+      size_t slot = slot_of(values[u]);
+      while (slots[slot] >= 0) {
+        slot = (slot + 1) & mask;
+      }
+      slots[slot] = static_cast<int64_t>(u);
+    }
+  };
+  rehash();
+
+  inverse_index.resize(data.size());
+  for (size_t i = 0, end = data.size(); i < end; ++i) {
+    const T value = data[i];
+    const size_t mask = slots.size() - 1;
+    size_t slot = slot_of(value);
+    int64_t unique_idx;
+    while (true) {
+      unique_idx = slots[slot];
+      if (unique_idx < 0) {
+        unique_idx = static_cast<int64_t>(values.size());
+        slots[slot] = unique_idx;
+        values.push_back(value);
+        first_indices.push_back(static_cast<int64_t>(i));
+        counts.push_back(0);
+        break;
+      }
+
+      if (UniqueValuesEqual(values[unique_idx], value)) {
+        break;
+      }
+
+      slot = (slot + 1) & mask;
+    }
+
+    ++counts[unique_idx];
+    inverse_index[i] = unique_idx;
+
+    // keep the load factor under 0.5
+    if (values.size() * 2 > slots.size()) {
+      ++capacity_bits;
+      rehash();
+    }
+  }
+}
+
+// Sorts in parallel: chunks are sorted by the threads of the pool, and merged pairwise.
+template <typename Iter, typename Compare>
+static void ParallelSort(Iter begin, Iter end, Compare comp, concurrency::ThreadPool* tp) {
+  constexpr std::ptrdiff_t min_chunk_size = 16384;
+  const std::ptrdiff_t n = end - begin;
+  const std::ptrdiff_t num_chunks = std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp),
+                                                             n / min_chunk_size);
+  if (num_chunks <= 1) {
+    std::sort(begin, end, comp);
+    return;
+  }
+
+  std::vector<std::ptrdiff_t> bounds(num_chunks + 1);
+  for (std::ptrdiff_t i = 0; i <= num_chunks; ++i) {
+    bounds[i] = n * i / num_chunks;
+  }
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_chunks, [&](std::ptrdiff_t chunk) {
+    std::sort(begin + bounds[chunk], begin + bounds[chunk + 1], comp);
+  });
+
+  for (std::ptrdiff_t width = 1; width < num_chunks; width *= 2) {
+    const std::ptrdiff_t num_merges = (num_chunks + 2 * width - 1) / (2 * width);
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_merges, [&](std::ptrdiff_t merge) {
+      const std::ptrdiff_t lo = 2 * width * merge;
+      const std::ptrdiff_t mid = std::min(lo + width, num_chunks);
+      const std::ptrdiff_t hi = std::min(lo + 2 * width, num_chunks);
+      if (mid < hi) {
+        std::inplace_merge(begin + bounds[lo], begin + bounds[mid], begin + bounds[hi], comp);
+      }
+    });
+  }
+}
+
+template <typename T>
+static void ComputeFlattenedWithHashTable(OpKernelContext& context, gsl::span<const T> data, bool sorted) {
+  std::vector<T> values;
+  std::vector<int64_t> first_indices;
+  std::vector<int64_t> counts;
+  std::vector<int64_t> inverse_index;
+  FindUniqueValues(data, values, first_indices, counts, inverse_index);
+
+  const int64_t num_unique = static_cast<int64_t>(values.size());
+  auto* tp = context.GetOperatorThreadPool();
+
+  // order of the unique values in the output. the hash table gives them in the order of their first occurrence.
+  std::vector<int64_t> order(num_unique);
+  for (int64_t i = 0; i < num_unique; ++i) {
+    order[i] = i;
+  }
+
+  if (sorted) {
+    ParallelSort(order.begin(), order.end(),
+                 [&values](int64_t lhs, int64_t rhs) { return values[lhs] < values[rhs]; }, tp);
+  }
+
+  Tensor& Y = *context.Output(0, {num_unique});
+  Tensor* indices_out = context.Output(1, {num_unique});
+  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
+  Tensor* counts_out = context.Output(3, {num_unique});
+
+  T* Y_data = Y.MutableData<T>();
+  for (int64_t i = 0; i < num_unique; ++i) {
+    Y_data[i] = values[order[i]];
+  }
+
+  if (indices_out) {
+    int64_t* indices_data = indices_out->MutableData<int64_t>();
+    for (int64_t i = 0; i < num_unique; ++i) {
+      indices_data[i] = first_indices[order[i]];
+    }
+  }
+
+  if (counts_out) {
+    int64_t* counts_data = counts_out->MutableData<int64_t>();
+    for (int64_t i = 0; i < num_unique; ++i) {
+      counts_data[i] = counts[order[i]];
+    }
+  }
+
+  if (inverse_indices) {
+    int64_t* inverse_indices_data = inverse_indices->MutableData<int64_t>();
+    if (sorted) {
+      // need to convert unsorted entries in the inverse index to their sorted values
+      std::vector<int64_t> unsorted_to_sorted(num_unique);
+      for (int64_t i = 0; i < num_unique; ++i) {
+        unsorted_to_sorted[order[i]] = i;
+      }
+
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(inverse_index.size()), TensorOpCost{8.0, 8.0, 2.0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              inverse_indices_data[i] = unsorted_to_sorted[inverse_index[i]];
+            }
+          });
+    } else {
+      std::copy(inverse_index.begin(), inverse_index.end(), inverse_indices_data);
+    }
+  }
+}
+
 template <typename T>
 Status Unique::ComputeImpl(OpKernelContext& context) const {
   if (!utils::HasType<EnabledUniqueDataTypes, T>()) {
@@ -308,6 +500,13 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   const Tensor& input = *context.Input<Tensor>(0);
   auto data = input.DataAsSpan<T>();
 
+  if constexpr (std::is_arithmetic<T>::value) {
+    if (flatten_) {
+      ComputeFlattenedWithHashTable<T>(context, data, sort_);
+      return Status::OK();
+    }
+  }
+
   if (flatten_) {
     std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
     std::vector<std::vector<int64_t>> indices;
@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <unordered_map>
 #include "core/common/safeint.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample.h"
@@ -763,49 +767,90 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// Computes the input indices and the cubic coefficients of each output index along one axis.
+static void SetupBicubicAxis(int64_t input_length,
+                             int64_t output_length,
+                             float scale,
+                             float roi_start,
+                             float roi_end,
+                             float cubic_coeff_a,
+                             bool exclude_outside,
+                             const GetOriginalCoordinateFunc& get_original_coordinate,
+                             std::vector<float>& original,
+                             std::vector<int64_t>& in_index,
+                             std::vector<float>& coeffs) {
+  original.resize(output_length);
+  in_index.resize(output_length * CubicModeGridLength);
+  coeffs.resize(output_length * CubicModeGridLength);
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
+  for (int64_t i = 0; i < output_length; ++i) {
+    float in = scale == 1 ? static_cast<float>(i)
+                          : get_original_coordinate(static_cast<float>(i), scale,
+                                                    static_cast<float>(output_length),
+                                                    static_cast<float>(input_length),
+                                                    roi_start, roi_end);
+    original[i] = in;
+
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    const float s = in - in_int;
+    auto coeff_it = cubic_coeffs.find(s);
+    if (coeff_it == cubic_coeffs.end()) {
+      coeff_it = cubic_coeffs.emplace(s, GetCubicCoeffs(s, cubic_coeff_a)).first;
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[i] / coeff_sum * orig_data;
+    // When exclude_outside is set, the weight of sampling locations outside the grid is set to 0
+    // and the weights are renormalized so that their sum is 1.0
+    float coeff_sum = 1;
+    int64_t* index = in_index.data() + i * CubicModeGridLength;
+    float* coeff = coeffs.data() + i * CubicModeGridLength;
+    for (int64_t k = 0, val = in_int - 1; k < static_cast<int64_t>(CubicModeGridLength); ++k, ++val) {
+      index[k] = std::max(static_cast<int64_t>(0), std::min(val, input_length - 1));
+      coeff[k] = exclude_outside && (val < 0 || val >= input_length) ? 0.0f : coeff_it->second[k];
+    }
+    if (exclude_outside) {
+      coeff_sum = 0;
+      for (size_t k = 0; k < CubicModeGridLength; ++k) {
+        coeff_sum += coeff[k];
+      }
+    }
+    for (size_t k = 0; k < CubicModeGridLength; ++k) {
+      coeff[k] /= coeff_sum;
+    }
   }
-  cache[grid_start_pos] = result;
+}
 
-  return result;
+static BicubicParams SetupUpsampleBicubic(int64_t input_height,
+                                          int64_t input_width,
+                                          int64_t output_height,
+                                          int64_t output_width,
+                                          float height_scale,
+                                          float width_scale,
+                                          float cubic_coeff_a,
+                                          bool exclude_outside,
+                                          const std::vector<float>& roi,
+                                          const GetOriginalCoordinateFunc& get_original_coordinate) {
+  BicubicParams p;
+  SetupBicubicAxis(input_height, output_height, height_scale, roi[roi.size() / 2 - 2], roi[roi.size() - 2],
+                   cubic_coeff_a, exclude_outside, get_original_coordinate, p.y_original, p.in_y, p.coeff_y);
+  SetupBicubicAxis(input_width, output_width, width_scale, roi[roi.size() / 2 - 1], roi[roi.size() - 1],
+                   cubic_coeff_a, exclude_outside, get_original_coordinate, p.x_original, p.in_x, p.coeff_x);
+  return p;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
+
+// Cubic interpolation overshoots, so integer outputs are saturated.
+template <typename T>
+T SaturateCubicResult(float result) {
+  if constexpr (std::is_integral<T>::value) {
+    result = std::max(result, static_cast<float>(std::numeric_limits<T>::lowest()));
+    result = std::min(result, static_cast<float>(std::numeric_limits<T>::max()));
+  }
+  return static_cast<T>(result);
+}
+
+// Bicubic interpolation of NCHW data. The CubicModeGridLength input rows of an output row are interpolated
+// along the width first, then blended along the height. An interpolated input row is kept while the next
+// output rows read the same input row.
 template <typename T>
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
@@ -813,147 +858,83 @@ void ResizeBiCubic(int64_t batch_size,
                    int64_t input_width,
                    int64_t output_height,
                    int64_t output_width,
-                   float height_scale,
-                   float width_scale,
-                   float cubic_coeff_a,
+                   const BicubicParams& p,
                    bool use_extrapolation,
                    float extrapolation_value,
-                   bool exclude_outside,
-                   const std::vector<float>& roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(output_height);
-
-  std::vector<float> x_original;
-  x_original.reserve(output_width);
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[y] - std::floor(y_original[y]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[x] - std::floor(x_original[x]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[y];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[i] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[i];
-            y_coeff_sum += y_coeff_holder[i];
-          }
-        }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[x];
+                   const T* XdataBase,
+                   T* YdataBase,
+                   concurrency::ThreadPool* tp) {
+  const std::ptrdiff_t num_rows = static_cast<std::ptrdiff_t>(batch_size * num_channels * output_height);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows,
+      static_cast<double>(output_width * CubicModeGridLength * 2),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> rows(CubicModeGridLength * static_cast<size_t>(output_width));
+        // offsets of the input rows interpolated in each of the rows
+        std::array<int64_t, CubicModeGridLength> row_offsets;
+        row_offsets.fill(-1);
+
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t nc = i / output_height;
+          const int64_t y = i % output_height;
+          T* Ydata = YdataBase + i * output_width;
 
           // when use_extrapolation is set and original index is out of the dim range
           // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
+          const float in_y = p.y_original[y];
+          if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
             continue;
           }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[i] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[i];
-              x_coeff_sum += x_coeff_holder[i];
+          std::array<int64_t, CubicModeGridLength> offsets;
+          for (size_t k = 0; k < CubicModeGridLength; ++k) {
+            offsets[k] = (nc * input_height + p.in_y[y * CubicModeGridLength + k]) * input_width;
+          }
+
+          std::array<const float*, CubicModeGridLength> grid_rows;
+          for (size_t k = 0; k < CubicModeGridLength; ++k) {
+            auto slot = std::find(row_offsets.begin(), row_offsets.end(), offsets[k]);
+            if (slot == row_offsets.end()) {
+              // reuse a row that this output row does not read
+              slot = std::find_if(row_offsets.begin(), row_offsets.end(), [&offsets](int64_t offset) {
+                return std::find(offsets.begin(), offsets.end(), offset) == offsets.end();
+              });
+              *slot = offsets[k];
+              float* row = rows.data() + (slot - row_offsets.begin()) * output_width;
+              const T* Xrow = XdataBase + offsets[k];
+              for (int64_t x = 0; x < output_width; ++x) {
+                const int64_t* in_x = p.in_x.data() + x * CubicModeGridLength;
+                const float* coeff_x = p.coeff_x.data() + x * CubicModeGridLength;
+                float result = 0;
+                for (size_t j = 0; j < CubicModeGridLength; ++j) {
+                  result += coeff_x[j] * Xrow[in_x[j]];
+                }
+                row[x] = result;
+              }
             }
+            grid_rows[k] = rows.data() + (slot - row_offsets.begin()) * output_width;
           }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[i] / y_coeff_sum;
+          const float* coeff_y = p.coeff_y.data() + y * CubicModeGridLength;
+          for (int64_t x = 0; x < output_width; ++x) {
+            float result = 0;
+            for (size_t k = 0; k < CubicModeGridLength; ++k) {
+              result += grid_rows[k][x] * coeff_y[k];
+            }
+            Ydata[x] = SaturateCubicResult<T>(result);
           }
 
-          Ydata[y * output_width + x] = static_cast<T>(result);
+          if (use_extrapolation) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              if (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)) {
+                Ydata[x] = static_cast<T>(extrapolation_value);
+              }
+            }
+          }
         }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+      });
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1058,18 +1039,20 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
 
         AllocatorPtr alloc;
         ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+        auto p = GetInterpolationTables(&bilinear_params_, dims, output_dims, scales, roi, [&]() {
+          return std::make_shared<const BilinearParams>(
+              SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                    height_scale, width_scale, roi, alloc, get_original_coordinate_, is_nchw));
+        });
         if (is_nchw) {
-          UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                           height_scale, width_scale, roi,
-                           use_extrapolation_, extrapolation_value_, X->Data<T>(),
-                           Y->MutableData<T>(), alloc, get_original_coordinate_,
+          UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width, *p,
+                           use_extrapolation_, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                            output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
         } else {
-          NhwcUpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                               height_scale, width_scale, roi,
-                               use_extrapolation_, extrapolation_value_, X->Data<T>(),
-                               Y->MutableData<T>(), alloc, get_original_coordinate_,
-                               output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
+          NhwcUpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width, *p,
+                               use_extrapolation_, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
+                               output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool()
+                                                                                : nullptr);
         }
         return Status::OK();
       } else if (dims.size() == 3 || dims.size() == 5) {
@@ -1121,10 +1104,16 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
       const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
 
-      ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], cubic_coeff_a_, use_extrapolation_,
-                    extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                    Y->MutableData<float>(), get_original_coordinate_);
+      const float height_scale = is_2D ? scales[0] : scales[2];
+      const float width_scale = is_2D ? scales[1] : scales[3];
+      auto p = GetInterpolationTables(&bicubic_params_, dims, output_dims, scales, roi, [&]() {
+        return std::make_shared<const BicubicParams>(
+            SetupUpsampleBicubic(input_height, input_width, output_height, output_width, height_scale, width_scale,
+                                 cubic_coeff_a_, exclude_outside_, roi, get_original_coordinate_));
+      });
+      ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width, *p,
+                    use_extrapolation_, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
+                    output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
       return Status::OK();
     }
     default:
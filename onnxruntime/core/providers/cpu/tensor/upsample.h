@@ -6,7 +6,11 @@
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
 #endif
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <vector>
+#include "core/platform/ort_mutex.h"
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // Chance of arithmetic overflow could be reduced
@@ -69,6 +73,19 @@ struct BilinearParams {
   float* dy2;
 };
 
+struct BicubicParams {
+  std::vector<float> x_original;
+  std::vector<float> y_original;
+
+  // CubicModeGridLength input indices per output index, clamped to the input dims.
+  std::vector<int64_t> in_x;
+  std::vector<int64_t> in_y;
+
+  // The cubic coefficients of in_x and in_y, divided by their sum when exclude_outside is set.
+  std::vector<float> coeff_x;
+  std::vector<float> coeff_y;
+};
+
 class UpsampleBase {
  protected:
   UpsampleBase(const OpKernelInfo& info) : scales_cached_(false), roi_cached_(false), use_extrapolation_(false) {
@@ -395,6 +412,42 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& roi, const std::vector<float>& scales,
                      const gsl::span<const int64_t>& output_dims) const;
+
+ private:
+  // Returns the interpolation tables of the given dims, scales and roi. The tables of the most recent
+  // values are kept, so a model with fixed shapes computes them once per session. setup is only called
+  // when they changed. use tables_mutex_ to ensure Compute() can be called concurrently.
+  template <typename Params, typename SetupFunc>
+  std::shared_ptr<const Params> GetInterpolationTables(std::shared_ptr<const Params>* cached,
+                                                       gsl::span<const int64_t> input_dims,
+                                                       gsl::span<const int64_t> output_dims,
+                                                       const std::vector<float>& scales,
+                                                       const std::vector<float>& roi,
+                                                       SetupFunc setup) const {
+    std::lock_guard<onnxruntime::OrtMutex> lock(tables_mutex_);
+    if (*cached == nullptr || !std::equal(input_dims.begin(), input_dims.end(), tables_input_dims_.begin(),
+                                          tables_input_dims_.end()) ||
+        !std::equal(output_dims.begin(), output_dims.end(), tables_output_dims_.begin(),
+                    tables_output_dims_.end()) ||
+        scales != tables_scales_ || roi != tables_roi_) {
+      tables_input_dims_.assign(input_dims.begin(), input_dims.end());
+      tables_output_dims_.assign(output_dims.begin(), output_dims.end());
+      tables_scales_ = scales;
+      tables_roi_ = roi;
+      bilinear_params_.reset();
+      bicubic_params_.reset();
+      *cached = setup();
+    }
+    return *cached;
+  }
+
+  mutable onnxruntime::OrtMutex tables_mutex_;
+  mutable TensorShapeVector tables_input_dims_;
+  mutable TensorShapeVector tables_output_dims_;
+  mutable std::vector<float> tables_scales_;
+  mutable std::vector<float> tables_roi_;
+  mutable std::shared_ptr<const BilinearParams> bilinear_params_;
+  mutable std::shared_ptr<const BicubicParams> bicubic_params_;
 };
 
 BilinearParams SetupUpsampleBilinear(const int64_t input_height,
@@ -408,6 +461,89 @@ BilinearParams SetupUpsampleBilinear(const int64_t input_height,
                                      const GetOriginalCoordinateFunc& get_original_coordinate,
                                      bool is_nchw);
 
+// Interpolates an input row along the width into a float row of output_width values.
+template <typename T>
+void BilinearInterpolateRow(const T* Xrow, const BilinearParams& p, int64_t output_width, float* row) {
+  for (int64_t x = 0; x < output_width; ++x) {
+    row[x] = p.dx2[x] * Xrow[p.in_x1[x]] + p.dx1[x] * Xrow[p.in_x2[x]];
+  }
+}
+
+// The two input rows of an output row are interpolated along the width first, then blended along the height,
+// so the inner loops are contiguous, and an interpolated input row is reused by the next output rows while
+// they read the same input row.
+template <typename T>
+void UpsampleBilinear(const int64_t batch_size,
+                      const int64_t num_channels,
+                      const int64_t input_height,
+                      const int64_t input_width,
+                      const int64_t output_height,
+                      const int64_t output_width,
+                      const BilinearParams& p,
+                      const bool use_extrapolation,
+                      const float extrapolation_value,
+                      const T* const XdataBase,
+                      T* const YdataBase,
+                      concurrency::ThreadPool* tp) {
+  const std::ptrdiff_t num_rows = static_cast<std::ptrdiff_t>(batch_size * num_channels * output_height);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows,
+      static_cast<double>(output_width * 4),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> rows(2 * static_cast<size_t>(output_width));
+        float* row1 = rows.data();
+        float* row2 = row1 + output_width;
+        // offsets of the input rows in row1 and row2
+        int64_t row1_offset = -1;
+        int64_t row2_offset = -1;
+
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t nc = i / output_height;
+          const int64_t y = i % output_height;
+          T* Ydata = YdataBase + i * output_width;
+
+          // when use_extrapolation is set and original index of y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation &&
+              (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
+            continue;
+          }
+
+          const int64_t y1_offset = nc * input_height * input_width + p.input_width_mul_y1[y];
+          const int64_t y2_offset = nc * input_height * input_width + p.input_width_mul_y2[y];
+          if (y1_offset != row1_offset && y1_offset == row2_offset) {
+            std::swap(row1, row2);
+            std::swap(row1_offset, row2_offset);
+          }
+          if (y1_offset != row1_offset) {
+            BilinearInterpolateRow(XdataBase + y1_offset, p, output_width, row1);
+            row1_offset = y1_offset;
+          }
+          if (y2_offset != row2_offset) {
+            BilinearInterpolateRow(XdataBase + y2_offset, p, output_width, row2);
+            row2_offset = y2_offset;
+          }
+
+          const float dy1 = p.dy1[y];
+          const float dy2 = p.dy2[y];
+          for (int64_t x = 0; x < output_width; ++x) {
+            Ydata[x] = static_cast<T>(dy2 * row1[x] + dy1 * row2[x]);
+          }
+
+          // when use_extrapolation is set and original index of x is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              if (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)) {
+                Ydata[x] = static_cast<T>(extrapolation_value);
+              }
+            }
+          }
+        }
+      });
+}
+
 template <typename T>
 void UpsampleBilinear(const int64_t batch_size,
                       const int64_t num_channels,
@@ -428,36 +564,60 @@ void UpsampleBilinear(const int64_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
-  for (int64_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, num_channels,
-        [&](std::ptrdiff_t c) {
-          const T* Xdata = XdataBase + (n * num_channels + c) * (input_height * input_width);
-          T* Ydata = YdataBase + (n * num_channels + c) * (output_height * output_width);
-          for (int64_t y = 0; y < output_height; ++y) {
-            for (int64_t x = 0; x < output_width; ++x) {
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_width * y + x] = static_cast<T>(extrapolation_value);
-                continue;
-              }
+  UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width, p,
+                   use_extrapolation, extrapolation_value, XdataBase, YdataBase, tp);
+}
 
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
+// Each output pixel blends the channels of 4 input pixels with the same weights, so the inner loop over the
+// channels is contiguous.
+template <typename T>
+void NhwcUpsampleBilinear(const int64_t batch_size,
+                          const int64_t num_channels,
+                          const int64_t input_height,
+                          const int64_t input_width,
+                          const int64_t output_height,
+                          const int64_t output_width,
+                          const BilinearParams& p,
+                          const bool use_extrapolation,
+                          const float extrapolation_value,
+                          const T* const XdataBase,
+                          T* const YdataBase,
+                          concurrency::ThreadPool* tp) {
+  const int64_t output_size = output_height * output_width;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * output_size),
+      static_cast<double>(num_channels * 2),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t n = i / output_size;
+          const int64_t x = (i % output_size) % output_width;
+          const int64_t y = (i % output_size) / output_width;
+          T* Ydata = YdataBase + i * num_channels;
+
+          // when use_extrapolation is set and original index of x or y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation &&
+              ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
+               (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
+            std::fill_n(Ydata, num_channels, static_cast<T>(extrapolation_value));
+            continue;
+          }
 
-              Ydata[output_width * y + x] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                           p.dx1[x] * p.dy2[y] * X21 +
-                                                           p.dx2[x] * p.dy1[y] * X12 +
-                                                           p.dx1[x] * p.dy1[y] * X22);
-            }
+          const T* Xdata = XdataBase + n * (input_height * input_width) * num_channels;
+          const T* X11 = Xdata + (p.input_width_mul_y1[y] + p.in_x1[x]) * num_channels;
+          const T* X21 = Xdata + (p.input_width_mul_y1[y] + p.in_x2[x]) * num_channels;
+          const T* X12 = Xdata + (p.input_width_mul_y2[y] + p.in_x1[x]) * num_channels;
+          const T* X22 = Xdata + (p.input_width_mul_y2[y] + p.in_x2[x]) * num_channels;
+
+          const float w11 = p.dx2[x] * p.dy2[y];
+          const float w21 = p.dx1[x] * p.dy2[y];
+          const float w12 = p.dx2[x] * p.dy1[y];
+          const float w22 = p.dx1[x] * p.dy1[y];
+          for (int64_t c = 0; c < num_channels; ++c) {
+            Ydata[c] = static_cast<T>(w11 * X11[c] + w21 * X21[c] + w12 * X12[c] + w22 * X22[c]);
           }
-        });
-  }
+        }
+      });
 }
 
 template <typename T>
@@ -480,39 +640,8 @@ void NhwcUpsampleBilinear(const int64_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, false);
-  for (int64_t n = 0; n < batch_size; ++n) {
-    const T* Xdata = XdataBase + n * (input_height * input_width) * num_channels;
-    T* Ydata = YdataBase + n * (output_height * output_width) * num_channels;
-    concurrency::ThreadPool::TryParallelFor(
-        tp, output_height * output_width,
-        static_cast<double>(num_channels * 2),
-        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
-          for (std::ptrdiff_t i = first; i < last; ++i) {
-            const int64_t x = i % output_width;
-            const int64_t y = i / output_width;
-            for (int64_t c = 0; c < num_channels; ++c) {
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[(output_width * y + x) * num_channels + c] = static_cast<T>(extrapolation_value);
-                continue;
-              }
-
-              T X11 = Xdata[(p.input_width_mul_y1[y] + p.in_x1[x]) * num_channels + c];
-              T X21 = Xdata[(p.input_width_mul_y1[y] + p.in_x2[x]) * num_channels + c];
-              T X12 = Xdata[(p.input_width_mul_y2[y] + p.in_x1[x]) * num_channels + c];
-              T X22 = Xdata[(p.input_width_mul_y2[y] + p.in_x2[x]) * num_channels + c];
-
-              Ydata[(output_width * y + x) * num_channels + c] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                                                p.dx1[x] * p.dy2[y] * X21 +
-                                                                                p.dx2[x] * p.dy1[y] * X12 +
-                                                                                p.dx1[x] * p.dy1[y] * X22);
-            }
-          }
-        });
-  }
+  NhwcUpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width, p,
+                       use_extrapolation, extrapolation_value, XdataBase, YdataBase, tp);
 }
 
 }  // namespace onnxruntime
@@ -63,6 +63,52 @@ void CUDAAllocator::Free(void* p) {
   cudaFree(p);         // do not throw error since it's OK for cudaFree to fail during shutdown
 }
 
+CUDAMemPoolAllocator::CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, cudaStream_t stream,
+                                           size_t release_threshold)
+    : CUDAAllocator(device_id, name), stream_(stream) {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+  int supports_mempool = 0;
+  CUDA_CALL_THROW(cudaDeviceGetAttribute(&supports_mempool, cudaDevAttrMemoryPoolsSupported, device_id));
+  ORT_ENFORCE(supports_mempool != 0, "CUDA device ", device_id, " does not support memory pools.");
+  CUDA_CALL_THROW(cudaDeviceGetDefaultMemPool(&pool_, device_id));
+
+  // the pool is shared by the sessions, it keeps the largest threshold they asked for
+  static OrtMutex threshold_mutex;
+  std::lock_guard<OrtMutex> lock(threshold_mutex);
+  uint64_t threshold = 0;
+  CUDA_CALL_THROW(cudaMemPoolGetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+  if (release_threshold > threshold) {
+    threshold = release_threshold;
+    CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+  }
+#else
+  ORT_UNUSED_PARAMETER(release_threshold);
+  ORT_THROW("CUDA memory pools can only be used in Onnxruntime built with CUDA >= 11.2");
+#endif
+}
+
+void* CUDAMemPoolAllocator::Alloc(size_t size) {
+  SetDevice(true);
+  CheckDevice(true);
+  void* p = nullptr;
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+  if (size > 0) {
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, stream_));
+  }
+#endif
+  return p;
+}
+
+void CUDAMemPoolAllocator::Free(void* p) {
+  SetDevice(false);
+  CheckDevice(false);  // ignore CUDA failure when free
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+  if (p != nullptr) {
+    cudaFreeAsync(p, stream_);  // do not throw error since it's OK for cudaFreeAsync to fail during shutdown
+  }
+#endif
+}
+
 void* CUDAExternalAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
@@ -114,4 +160,136 @@ FencePtr CUDAPinnedAllocator::CreateFence(const SessionState* session_state) {
   return std::make_shared<CUDAFence>(GetGPUDataTransfer(session_state));
 }
 
+CUDAStreamOrderedAllocator::CUDAStreamOrderedAllocator(AllocatorPtr allocator, std::vector<cudaStream_t> streams)
+    : IAllocator(allocator->Info()), allocator_(std::move(allocator)), streams_(std::move(streams)) {
+}
+
+CUDAStreamOrderedAllocator::~CUDAStreamOrderedAllocator() {
+  // dtor shouldn't throw, the buffers are left to the wrapped allocator if the GPU failed.
+  ORT_TRY {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    ReleaseDeferredFrees(true);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      LOGS_DEFAULT(ERROR) << "Releasing the deferred frees of the CUDA allocator threw:" << ex.what();
+    });
+  }
+
+  for (cudaEvent_t event : free_events_) {
+    CUDA_CALL(cudaEventDestroy(event));
+  }
+}
+
+void CUDAStreamOrderedAllocator::ReleaseDeferredFrees(bool wait) {
+  if (!pending_frees_.empty()) {
+    DeferredFrees frees;
+    frees.buffers.swap(pending_frees_);
+    for (cudaStream_t stream : streams_) {
+      cudaEvent_t event;
+      if (free_events_.empty()) {
+        CUDA_CALL_THROW(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+      } else {
+        event = free_events_.back();
+        free_events_.pop_back();
+      }
+      CUDA_CALL_THROW(cudaEventRecord(event, stream));
+      frees.events.push_back(event);
+    }
+    deferred_frees_.push_back(std::move(frees));
+  }
+
+  while (!deferred_frees_.empty()) {
+    DeferredFrees& frees = deferred_frees_.front();
+    for (cudaEvent_t event : frees.events) {
+      if (wait) {
+        CUDA_CALL_THROW(cudaEventSynchronize(event));
+      } else if (cudaEventQuery(event) != cudaSuccess) {
+        return;
+      }
+    }
+
+    for (void* p : frees.buffers) {
+      allocator_->Free(p);
+    }
+    free_events_.insert(free_events_.end(), frees.events.begin(), frees.events.end());
+    deferred_frees_.pop_front();
+  }
+}
+
+template <typename AllocFunc>
+void* CUDAStreamOrderedAllocator::AllocOrRetry(size_t size, AllocFunc alloc) {
+  bool has_deferred_frees = false;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    ReleaseDeferredFrees(false);
+    has_deferred_frees = !deferred_frees_.empty();
+  }
+  if (!has_deferred_frees) {
+    return alloc(size);
+  }
+
+  void* p = nullptr;
+  ORT_TRY {
+    p = alloc(size);
+  }
+  ORT_CATCH(const std::exception&) {
+    // out of memory while buffers are still deferred, retried below
+  }
+  if (p == nullptr && size > 0) {
+    {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      ReleaseDeferredFrees(true);
+    }
+    p = alloc(size);
+  }
+  return p;
+}
+
+void* CUDAStreamOrderedAllocator::Alloc(size_t size) {
+  return AllocOrRetry(size, [this](size_t bytes) { return allocator_->Alloc(bytes); });
+}
+
+void* CUDAStreamOrderedAllocator::Reserve(size_t size) {
+  return AllocOrRetry(size, [this](size_t bytes) { return allocator_->Reserve(bytes); });
+}
+
+void CUDAStreamOrderedAllocator::Free(void* p) {
+  if (p == nullptr) return;
+  std::lock_guard<OrtMutex> lock(mutex_);
+  pending_frees_.push_back(p);
+}
+
+void* CUDAGraphAllocator::Alloc(size_t size) {
+  AllocatorPtr thread_allocator = thread_allocator_();
+  if (!thread_allocator) {
+    return allocator_->Alloc(size);
+  }
+
+  void* p = thread_allocator->Alloc(size);
+  if (p != nullptr) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    thread_buffers_.emplace(p, std::move(thread_allocator));
+  }
+  return p;
+}
+
+void CUDAGraphAllocator::Free(void* p) {
+  if (p == nullptr) return;
+  AllocatorPtr thread_allocator;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = thread_buffers_.find(p);
+    if (it != thread_buffers_.end()) {
+      thread_allocator = std::move(it->second);
+      thread_buffers_.erase(it);
+    }
+  }
+  if (thread_allocator) {
+    thread_allocator->Free(p);
+  } else {
+    allocator_->Free(p);
+  }
+}
+
 }  // namespace onnxruntime
@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <deque>
+#include <functional>
+#include <vector>
 
+#include "cuda_pch.h"
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
 #include "core/platform/ort_mutex.h"
@@ -21,11 +25,28 @@ class CUDAAllocator : public IAllocator {
   void Free(void* p) override;
   FencePtr CreateFence(const SessionState* session_state) override;
 
- private:
+ protected:
   void CheckDevice(bool throw_when_fail) const;
   void SetDevice(bool throw_when_fail) const;
 };
 
+// Allocates with cudaMallocFromPoolAsync from the default memory pool of the device, which all the sessions of the
+// process share instead of holding an arena each, and frees with cudaFreeAsync on the same stream. A buffer freed
+// once the last kernel using it is queued is reused by the kernels queued after it, without synchronizing.
+class CUDAMemPoolAllocator : public CUDAAllocator {
+ public:
+  CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, cudaStream_t stream, size_t release_threshold);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+ private:
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+  cudaMemPool_t pool_ = nullptr;
+#endif
+  cudaStream_t stream_;  // Does not own the stream
+};
+
 class CUDAExternalAllocator : public CUDAAllocator {
   typedef void* (*ExternalAlloc)(size_t size);
   typedef void (*ExternalFree)(void* p);
@@ -64,4 +85,65 @@ class CUDAPinnedAllocator : public IAllocator {
   void Free(void* p) override;
   FencePtr CreateFence(const SessionState* session_state) override;
 };
+
+// Wraps the device memory allocator of an execution provider with several compute streams. A buffer freed by the
+// host once the last kernel using it is queued may still be in use on the GPU, which is fine with one stream as
+// its next user is queued after that kernel, but not with several. The frees are deferred until the events
+// recorded on all the streams after them have completed.
+class CUDAStreamOrderedAllocator final : public IAllocator {
+ public:
+  CUDAStreamOrderedAllocator(AllocatorPtr allocator, std::vector<cudaStream_t> streams);
+  ~CUDAStreamOrderedAllocator();
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void* Reserve(size_t size) override;
+  void GetStats(AllocatorStats* stats) override { allocator_->GetStats(stats); }
+  FencePtr CreateFence(const SessionState* session_state) override { return allocator_->CreateFence(session_state); }
+
+ private:
+  struct DeferredFrees {
+    std::vector<cudaEvent_t> events;  // one per stream
+    std::vector<void*> buffers;
+  };
+
+  // Records the events of the buffers freed since the last call on the streams, then frees the buffers whose
+  // events have completed, or all of them after waiting for their events when wait is true.
+  // The caller holds mutex_.
+  void ReleaseDeferredFrees(bool wait);
+
+  // Allocates with the wrapped allocator, releases the deferred frees and retries once if it runs out of memory.
+  template <typename AllocFunc>
+  void* AllocOrRetry(size_t size, AllocFunc alloc);
+
+  AllocatorPtr allocator_;
+  const std::vector<cudaStream_t> streams_;
+  std::vector<void*> pending_frees_;
+  std::deque<DeferredFrees> deferred_frees_;
+  std::vector<cudaEvent_t> free_events_;
+  OrtMutex mutex_;
+};
+
+// Wraps the device memory allocator of an execution provider capturing CUDA graphs. A captured graph keeps the
+// addresses of the buffers of the run it was captured in, which must not be handed to the runs of other threads
+// while it replays. The buffers allocated in the runs of a thread capturing graphs come from the allocator of
+// that thread instead, given by thread_allocator, or from the wrapped allocator when it returns nullptr.
+class CUDAGraphAllocator final : public IAllocator {
+ public:
+  CUDAGraphAllocator(AllocatorPtr allocator, std::function<AllocatorPtr()> thread_allocator)
+      : IAllocator(allocator->Info()), allocator_(std::move(allocator)), thread_allocator_(std::move(thread_allocator)) {}
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void* Reserve(size_t size) override { return allocator_->Reserve(size); }
+  void GetStats(AllocatorStats* stats) override { allocator_->GetStats(stats); }
+  FencePtr CreateFence(const SessionState* session_state) override { return allocator_->CreateFence(session_state); }
+
+ private:
+  AllocatorPtr allocator_;
+  const std::function<AllocatorPtr()> thread_allocator_;
+  // the thread allocators of the buffers they allocated, as the buffers may be freed by another thread
+  InlinedHashMap<void*, AllocatorPtr> thread_buffers_;
+  OrtMutex mutex_;
+};
 }  // namespace onnxruntime
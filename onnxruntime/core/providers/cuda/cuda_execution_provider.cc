@@ -9,6 +9,7 @@
 #include "core/providers/cuda/cuda_fence.h"
 #include "core/providers/cuda/cuda_fwd.h"
 #include "core/providers/cuda/gpu_data_transfer.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
 #include "core/providers/cuda/cuda_profiler.h"
 
 #ifndef DISABLE_CONTRIB_OPS
@@ -111,8 +112,20 @@ ONNX_OPERATOR_KERNEL_EX(
 }  // namespace cuda
 
 AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId device_id, size_t gpu_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                                                        CUDAExecutionProviderExternalAllocatorInfo external_allocator_info, OrtArenaCfg* default_memory_arena_cfg) {
-  if (external_allocator_info.UseExternalAllocator()) {
+                                                        CUDAExecutionProviderExternalAllocatorInfo external_allocator_info, OrtArenaCfg* default_memory_arena_cfg,
+                                                        CUDAExecutionProviderMemPoolInfo mempool_info, cudaStream_t stream) {
+  if (mempool_info.use_mempool) {
+    // the memory pool caches the freed memory itself, no arena on top of it
+    AllocatorCreationInfo default_memory_info(
+        [mempool_info, stream](OrtDevice::DeviceId id) {
+          return std::make_unique<CUDAMemPoolAllocator>(id, CUDA, stream, mempool_info.release_threshold);
+        },
+        device_id,
+        false);
+
+    return CreateAllocator(default_memory_info);
+
+  } else if (external_allocator_info.UseExternalAllocator()) {
     AllocatorCreationInfo default_memory_info(
         [external_allocator_info](OrtDevice::DeviceId id) {
           return std::make_unique<CUDAExternalAllocator>(id, CUDA, external_allocator_info.alloc, external_allocator_info.free, external_allocator_info.empty_cache);
@@ -137,11 +150,19 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
   }
 }
 
-CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t gpu_mem_limit,
+CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, std::vector<cudaStream_t> compute_streams, size_t gpu_mem_limit,
                                                           ArenaExtendStrategy arena_extend_strategy, CUDAExecutionProviderExternalAllocatorInfo external_allocator_info,
-                                                          OrtArenaCfg* default_memory_arena_cfg) {
+                                                          OrtArenaCfg* default_memory_arena_cfg, CUDAExecutionProviderMemPoolInfo mempool_info)
+    : compute_streams_(std::move(compute_streams)) {
   CUDA_CALL_THROW(cudaSetDevice(device_id));
-  stream_ = stream;
+  if (compute_streams_.empty()) {
+    cudaStream_t own_stream = nullptr;
+    CUDA_CALL_THROW(cudaStreamCreateWithFlags(&own_stream, cudaStreamNonBlocking));
+    compute_streams_.push_back(own_stream);
+    owns_stream_ = true;
+  }
+  stream_forked_.assign(compute_streams_.size(), false);
+  cudaStream_t stream = compute_streams_[0];
 
   CUBLAS_CALL_THROW(cublasCreate(&cublas_handle_));
   CUBLAS_CALL_THROW(cublasSetStream(cublas_handle_, stream));
@@ -150,11 +171,13 @@ CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId de
   CUDNN_CALL_THROW(cudnnSetStream(cudnn_handle_, stream));
 
   // CUDA malloc/free is expensive so always use an arena
-  allocator_ = CreateCudaAllocator(device_id, gpu_mem_limit, arena_extend_strategy, external_allocator_info, default_memory_arena_cfg);
+  allocator_ = CreateCudaAllocator(device_id, gpu_mem_limit, arena_extend_strategy, external_allocator_info, default_memory_arena_cfg,
+                                   mempool_info, stream);
 
-#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-  cuda_graph_.SetStream(stream_);
-#endif
+  if (compute_streams_.size() > 1) {
+    allocator_ = std::make_shared<CUDAStreamOrderedAllocator>(std::move(allocator_), compute_streams_);
+    CUDA_CALL_THROW(cudaEventCreateWithFlags(&stream_sync_event_, cudaEventDisableTiming));
+  }
 }
 
 CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -172,34 +195,111 @@ CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
   } catch (const std::exception& ex) {
     LOGS_DEFAULT(ERROR) << "cudnnDestroy threw:" << ex.what();
   }
+
+  if (stream_sync_event_) {
+    try {
+      CUDA_CALL(cudaEventDestroy(stream_sync_event_));
+    } catch (const std::exception& ex) {
+      LOGS_DEFAULT(ERROR) << "cudaEventDestroy threw:" << ex.what();
+    }
+  }
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  // the graphs are captured on the stream, release them first
+  cuda_graphs_.clear();
+#endif
+  if (owns_stream_) {
+    try {
+      CUDA_CALL(cudaStreamDestroy(compute_streams_[0]));
+    } catch (const std::exception& ex) {
+      LOGS_DEFAULT(ERROR) << "cudaStreamDestroy threw:" << ex.what();
+    }
+  }
+}
+
+Status CUDAExecutionProvider::PerThreadContext::SetStream(size_t index) {
+  if (index == current_stream_index_) {
+    return Status::OK();
+  }
+
+  cudaStream_t stream = compute_streams_[index];
+  if (index != 0 && !stream_forked_[index]) {
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(stream_sync_event_, compute_streams_[0]));
+    CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(stream, stream_sync_event_, 0));
+    stream_forked_[index] = true;
+  }
+
+  CUBLAS_RETURN_IF_ERROR(cublasSetStream(cublas_handle_, stream));
+  CUDNN_RETURN_IF_ERROR(cudnnSetStream(cudnn_handle_, stream));
+  current_stream_index_ = index;
+  return Status::OK();
+}
+
+Status CUDAExecutionProvider::PerThreadContext::JoinStreams() {
+  for (size_t index = 1; index < compute_streams_.size(); ++index) {
+    if (stream_forked_[index]) {
+      CUDA_RETURN_IF_ERROR(cudaEventRecord(stream_sync_event_, compute_streams_[index]));
+      CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(compute_streams_[0], stream_sync_event_, 0));
+      stream_forked_[index] = false;
+    }
+  }
+  return SetStream(0);
 }
 
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+void CUDAExecutionProvider::PerThreadContext::SelectGraph(size_t graph_key, size_t max_graphs) {
+  auto it = std::find_if(cuda_graphs_.begin(), cuda_graphs_.end(),
+                         [graph_key](const CapturedGraph& graph) { return graph.key == graph_key; });
+  if (it != cuda_graphs_.end()) {
+    cuda_graphs_.splice(cuda_graphs_.begin(), cuda_graphs_, it);
+    return;
+  }
+
+  cuda_graphs_.emplace_front();
+  cuda_graphs_.front().key = graph_key;
+  cuda_graphs_.front().cuda_graph.SetStream(compute_streams_[0]);
+  while (cuda_graphs_.size() > max_graphs) {
+    LOGS_DEFAULT(INFO) << "Releasing the least recently used cuda graph, over " << max_graphs << " graphs";
+    cuda_graphs_.pop_back();
+  }
+}
+
+CUDAExecutionProvider::PerThreadContext::CapturedGraph& CUDAExecutionProvider::PerThreadContext::CurrentGraph() {
+  if (cuda_graphs_.empty()) {
+    SelectGraph(0, 1);
+  }
+  return cuda_graphs_.front();
+}
+
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptureAllowed() const {
-  return regular_run_count_before_graph_capture_ >= min_num_runs_before_cuda_graph_capture_;
+  const int regular_run_count =
+      cuda_graphs_.empty() ? 0 : cuda_graphs_.front().regular_run_count_before_graph_capture;
+  return regular_run_count >= min_num_runs_before_cuda_graph_capture_;
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureBegin() {
-  cuda_graph_.Reset();
-  cuda_graph_.CaptureBegin();
+  auto& graph = CurrentGraph();
+  graph.cuda_graph.Reset();
+  graph.cuda_graph.CaptureBegin();
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureEnd() {
-  cuda_graph_.CaptureEnd();
-  is_graph_captured_ = true;
+  auto& graph = CurrentGraph();
+  graph.cuda_graph.CaptureEnd();
+  graph.is_graph_captured = true;
 }
 
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptured() const {
-  return is_graph_captured_;
+  return !cuda_graphs_.empty() && cuda_graphs_.front().is_graph_captured;
 }
 
 Status CUDAExecutionProvider::PerThreadContext::ReplayGraph() {
   ORT_ENFORCE(IsGraphCaptured());
-  return cuda_graph_.Replay();
+  return CurrentGraph().cuda_graph.Replay();
 }
 
 void CUDAExecutionProvider::PerThreadContext::IncrementRegularRunCountBeforeGraphCapture() {
-  ++regular_run_count_before_graph_capture_;
+  ++CurrentGraph().regular_run_count_before_graph_capture;
 }
 #endif
 
@@ -212,9 +312,22 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
   CUDA_CALL_THROW(cudaDeviceSynchronize());
   CUDA_CALL_THROW(cudaGetDeviceProperties(&device_prop_, info_.device_id));
 
+  if (!info.cudnn_conv_algo_cache_file.empty()) {
+    cuda::ConvAlgoCache::Instance().Load(info.cudnn_conv_algo_cache_file);
+  }
+
   // This scenario is not supported.
   ORT_ENFORCE(!(info.has_user_compute_stream && info.external_allocator_info.UseExternalAllocator()));
 
+  // The memory pool allocates and frees in the order of the provider stream, which the kernels must run on.
+  ORT_ENFORCE(!(info.mempool_info.use_mempool &&
+                (info.external_allocator_info.UseExternalAllocator() || info.enable_cuda_graph || info.num_compute_streams > 1)),
+              "The CUDA memory pool is not supported with an external allocator, CUDA graph or several compute streams.");
+
+  // The captured graph would need the events between the streams to be captured too.
+  ORT_ENFORCE(!(info.enable_cuda_graph && info.num_compute_streams > 1),
+              "CUDA graph is not supported with several compute streams.");
+
   if (info.has_user_compute_stream) {
     external_stream_ = true;
     stream_ = static_cast<cudaStream_t>(info.user_compute_stream);
@@ -226,6 +339,16 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
     }
   }
 
+  for (int i = 1; i < info.num_compute_streams; ++i) {
+    cudaStream_t stream = nullptr;
+    CUDA_CALL_THROW(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+    extra_compute_streams_.push_back(stream);
+  }
+
+  // Each thread capturing graphs runs its own stream, so its captures and replays don't serialize with, or capture,
+  // the work of the other threads. A user compute stream is shared by all the threads.
+  per_thread_streams_ = !extra_compute_streams_.empty() || (info.enable_cuda_graph && !external_stream_);
+
   size_t free = 0;
   size_t total = 0;
   CUDA_CALL_THROW(cudaMemGetInfo(&free, &total));
@@ -262,6 +385,41 @@ CUDAExecutionProvider::~CUDAExecutionProvider() {
   if (!external_stream_ && stream_) {
     CUDA_CALL(cudaStreamDestroy(stream_));
   }
+  for (cudaStream_t stream : extra_compute_streams_) {
+    CUDA_CALL(cudaStreamDestroy(stream));
+  }
+}
+
+std::vector<cudaStream_t> CUDAExecutionProvider::GetComputeStreams() const {
+  std::vector<cudaStream_t> streams{stream_};
+  streams.insert(streams.end(), extra_compute_streams_.begin(), extra_compute_streams_.end());
+  return streams;
+}
+
+std::vector<int> CUDAExecutionProvider::GetComputeQueueIds() const {
+  std::vector<int> queue_ids{kCudaStreamDefault};
+  for (size_t i = 0; i < extra_compute_streams_.size(); ++i) {
+    queue_ids.push_back(kTotalCudaStreams + static_cast<int>(i));
+  }
+  return queue_ids;
+}
+
+Status CUDAExecutionProvider::SetCurrentComputeQueue(int queue_id) const {
+  if (extra_compute_streams_.empty()) {
+    return Status::OK();
+  }
+
+  // the copy queues run their own streams, their kernels don't use the compute stream
+  const size_t index = queue_id < kTotalCudaStreams ? 0 : static_cast<size_t>(queue_id - kTotalCudaStreams) + 1;
+  ORT_RETURN_IF_NOT(index <= extra_compute_streams_.size(), "Invalid CUDA compute queue id: ", queue_id);
+  return GetPerThreadContext().SetStream(index);
+}
+
+Status CUDAExecutionProvider::JoinComputeQueues() const {
+  if (extra_compute_streams_.empty()) {
+    return Status::OK();
+  }
+  return GetPerThreadContext().JoinStreams();
 }
 
 std::unique_ptr<profiling::EpProfiler> CUDAExecutionProvider::GetProfiler() {
@@ -286,8 +444,12 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
 
     // get or create a context
     if (context_state_.retired_context_pool.empty()) {
-      context = std::make_shared<PerThreadContext>(info_.device_id, static_cast<cudaStream_t>(GetComputeStream()), info_.gpu_mem_limit,
-                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg);
+      const bool owns_stream = per_thread_streams_ && extra_compute_streams_.empty();
+      context = std::make_shared<PerThreadContext>(info_.device_id,
+                                                   owns_stream ? std::vector<cudaStream_t>{} : GetComputeStreams(),
+                                                   info_.gpu_mem_limit,
+                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg,
+                                                   info_.mempool_info);
     } else {
       context = context_state_.retired_context_pool.back();
       context_state_.retired_context_pool.pop_back();
@@ -306,6 +468,16 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
   return *context;
 }
 
+AllocatorPtr CUDAExecutionProvider::GetGraphRunAllocator() const {
+  const auto& per_thread_context_cache = PerThreadContextCache();
+  auto cached_context_it = per_thread_context_cache->find(this);
+  if (cached_context_it == per_thread_context_cache->end()) {
+    return nullptr;
+  }
+  auto cached_context = cached_context_it->second.lock();
+  return cached_context && cached_context->IsInRun() ? cached_context->GetAllocator() : nullptr;
+}
+
 void CUDAExecutionProvider::ReleasePerThreadContext() const {
   const auto& per_thread_context_cache = PerThreadContextCache();
 
@@ -380,9 +552,12 @@ Status CUDAExecutionProvider::OnRunStart() {
   CUDA_RETURN_IF_ERROR(cudaEventCreate(&current_deferred_release_event, cudaEventDisableTiming));
   deferred_release_cpu_ptr_.emplace(current_deferred_release_event, DeferredReleaseCPUPtrs());
 
-  if (IsGraphCaptureEnabled() && GetPerThreadContext().IsGraphCaptureAllowed() && !GetPerThreadContext().IsGraphCaptured()) {
-    LOGS_DEFAULT(INFO) << "Capturing the cuda graph for this model";
-    GetPerThreadContext().CaptureBegin();
+  if (IsGraphCaptureEnabled()) {
+    GetPerThreadContext().SetInRun(true);
+    if (GetPerThreadContext().IsGraphCaptureAllowed() && !GetPerThreadContext().IsGraphCaptured()) {
+      LOGS_DEFAULT(INFO) << "Capturing the cuda graph for this model";
+      GetPerThreadContext().CaptureBegin();
+    }
   }
   return Status::OK();
 }
@@ -398,18 +573,23 @@ Status CUDAExecutionProvider::OnRunEnd(bool sync_stream) {
       GetPerThreadContext().IncrementRegularRunCountBeforeGraphCapture();
     }
   }
+  // the work of all the compute streams is ordered before the event and the sync of the default stream
+  ORT_RETURN_IF_ERROR(JoinComputeQueues());
+
   // record deferred release event on default stream, and release per_thread_context
   auto current_deferred_release_event = GetPerThreadContext().GetCurrentDeferredReleaseEvent();
-  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, static_cast<cudaStream_t>(GetComputeStream())));
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, GetCurrentComputeStream()));
   if (sync_stream) {
-    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(static_cast<cudaStream_t>(GetComputeStream())));
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(GetCurrentComputeStream()));
   }
 
   // If cuda graph is enabled, the per thread context will not be released
-  // because the per thread cuda graph needs to be maintained and replayed for
-  // the next run.
+  // because the per thread cuda graphs need to be maintained and replayed for
+  // the next runs.
   if (!IsGraphCaptureEnabled()) {
     ReleasePerThreadContext();
+  } else {
+    GetPerThreadContext().SetInRun(false);
   }
   std::lock_guard<OrtMutex> lock(deferred_release_cpu_ptr_mutex_);
   deferred_release_cpu_ptr_[current_deferred_release_event].recorded = true;
@@ -441,6 +621,10 @@ bool CUDAExecutionProvider::IsGraphCaptured() const {
 Status CUDAExecutionProvider::ReplayGraph() {
   return GetPerThreadContext().ReplayGraph();
 }
+
+void CUDAExecutionProvider::SelectGraph(size_t graph_key) {
+  GetPerThreadContext().SelectGraph(graph_key, static_cast<size_t>(info_.max_cuda_graphs));
+}
 #endif
 
 namespace cuda {
@@ -473,6 +657,7 @@ class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kO
 class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, double, MatMul);
 class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, MLFloat16, MatMul);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, MatMulInteger);
+class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, QLinearMatMul);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, float, Elu);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, double, Elu);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, MLFloat16, Elu);
@@ -1345,6 +1530,7 @@ static Status RegisterCudaKernels(KernelRegistry& kernel_registry) {
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, double, MatMul)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, MLFloat16, MatMul)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, MatMulInteger)>,
+      BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, QLinearMatMul)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, 10, float, Clip)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, float, Elu)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, double, Elu)>,
@@ -2344,7 +2530,11 @@ static bool CastNeedFallbackToCPU(const onnxruntime::Node& node) {
 }
 
 std::unique_ptr<onnxruntime::IDataTransfer> CUDAExecutionProvider::GetDataTransfer() const {
-  return std::make_unique<onnxruntime::GPUDataTransfer>(static_cast<cudaStream_t>(GetComputeStream()), info_.do_copy_in_default_stream);
+  if (!per_thread_streams_) {
+    return std::make_unique<onnxruntime::GPUDataTransfer>(static_cast<cudaStream_t>(GetComputeStream()), info_.do_copy_in_default_stream);
+  }
+  return std::make_unique<onnxruntime::GPUDataTransfer>(static_cast<cudaStream_t>(GetComputeStream()), info_.do_copy_in_default_stream,
+                                                        extra_compute_streams_, [this]() { return GetCurrentComputeStream(); });
 }
 
 std::vector<std::unique_ptr<ComputeCapability>>
@@ -2437,9 +2627,17 @@ void CUDAExecutionProvider::RegisterAllocator(std::shared_ptr<AllocatorManager>
   auto cuda_alloc = allocator_manager->GetAllocator(info_.device_id, OrtMemTypeDefault);
   if (nullptr == cuda_alloc) {
     cuda_alloc = CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                                     info_.external_allocator_info, info_.default_memory_arena_cfg);
+                                     info_.external_allocator_info, info_.default_memory_arena_cfg,
+                                     info_.mempool_info, stream_);
     allocator_manager->InsertAllocator(cuda_alloc);
   }
+  // the allocator shared with the other sessions is wrapped for this provider only
+  if (!extra_compute_streams_.empty()) {
+    cuda_alloc = std::make_shared<CUDAStreamOrderedAllocator>(std::move(cuda_alloc), GetComputeStreams());
+  }
+  if (info_.enable_cuda_graph) {
+    cuda_alloc = std::make_shared<CUDAGraphAllocator>(std::move(cuda_alloc), [this]() { return GetGraphRunAllocator(); });
+  }
   TryInsertAllocator(std::move(cuda_alloc));
 
   // OrtMemTypeCPUOutput -- allocated by cudaMallocHost, used to copy CUDA device memory to CPU
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <set>
 #include <vector>
 
@@ -41,6 +42,16 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   void* GetComputeStream() const override { return static_cast<void*>(stream_); }
 
+  // The compute stream the kernels of the calling thread run on, which is the one of GetComputeStream()
+  // unless the provider has several compute streams or captures CUDA graphs, each thread running its own stream.
+  cudaStream_t GetCurrentComputeStream() const {
+    return per_thread_streams_ ? GetPerThreadContext().Stream() : stream_;
+  }
+
+  std::vector<int> GetComputeQueueIds() const override;
+  Status SetCurrentComputeQueue(int queue_id) const override;
+  Status JoinComputeQueues() const override;
+
   cublasHandle_t PerThreadCublasHandle() {
     return GetPerThreadContext().CublasHandle();
   }
@@ -85,14 +96,18 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool DoCopyOnDefaultStream() const { return info_.do_copy_in_default_stream; }
   bool GetCudnnConvUseMaxWorkspace() const { return info_.cudnn_conv_use_max_workspace; }
   bool GetCudnnConv1dPadToNc1d() const { return info_.cudnn_conv1d_pad_to_nc1d; }
+  const std::string& GetCudnnConvAlgoCacheFile() const { return info_.cudnn_conv_algo_cache_file; }
+  const std::string& GetFusedElementwiseCacheDir() const { return info_.fused_elementwise_cache_dir; }
 
   ProviderOptions GetProviderOptions() const override {
     return CUDAExecutionProviderInfo::ToProviderOptions(info_);
   }
 
   void RegisterAllocator(std::shared_ptr<AllocatorManager> allocator_manager) override;
+  // With mempool_info.use_mempool, the allocator allocates from the memory pool of the device in the order of stream.
   static AllocatorPtr CreateCudaAllocator(OrtDevice::DeviceId device_id, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                                          CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
+                                          CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg,
+                                          CUDAExecutionProviderMemPoolInfo mempool_info = {}, cudaStream_t stream = nullptr);
 
   std::unique_ptr<profiling::EpProfiler> GetProfiler() override;
 
@@ -100,6 +115,7 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool IsGraphCaptureEnabled() const override;
   bool IsGraphCaptured() const override;
   Status ReplayGraph() override;
+  void SelectGraph(size_t graph_key) override;
 #endif
 
  private:
@@ -107,6 +123,17 @@ class CUDAExecutionProvider : public IExecutionProvider {
   cudaDeviceProp device_prop_;
   bool external_stream_ = false;
   cudaStream_t stream_ = nullptr;
+  // the compute streams after stream_, created when info_.num_compute_streams > 1
+  std::vector<cudaStream_t> extra_compute_streams_;
+
+  // stream_ followed by extra_compute_streams_
+  std::vector<cudaStream_t> GetComputeStreams() const;
+
+  // whether the kernels run on the streams of the per thread contexts rather than stream_ alone
+  bool per_thread_streams_ = false;
+
+  // The allocator of the calling thread while it runs with CUDA graph capture enabled, nullptr otherwise.
+  AllocatorPtr GetGraphRunAllocator() const;
 
   struct DeferredReleaseCPUPtrs {
     bool recorded = false;
@@ -118,8 +145,10 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   class PerThreadContext final {
    public:
-    PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
+    // The context creates and owns its compute stream when compute_streams is empty.
+    PerThreadContext(OrtDevice::DeviceId device_id, std::vector<cudaStream_t> compute_streams, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
+                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg,
+                     CUDAExecutionProviderMemPoolInfo mempool_info);
     ~PerThreadContext();
 
     cublasHandle_t CublasHandle() const {
@@ -130,6 +159,18 @@ class CUDAExecutionProvider : public IExecutionProvider {
       return cudnn_handle_;
     }
 
+    cudaStream_t Stream() const {
+      return compute_streams_[current_stream_index_];
+    }
+
+    // Binds the handles to the index-th compute stream for the kernels of this thread. The first use of a stream
+    // after the last join waits for the work queued on the default stream, like the copies of the feeds.
+    Status SetStream(size_t index);
+
+    // Makes the default stream wait for the work queued on the other streams since their first use, and binds
+    // the handles to the default stream again.
+    Status JoinStreams();
+
     cudaEvent_t& GetCurrentDeferredReleaseEvent() {
       return current_deferred_release_event_;
     }
@@ -140,22 +181,26 @@ class CUDAExecutionProvider : public IExecutionProvider {
         if (!constant_ones_float_) {
           constant_ones_float_ = cuda::CreateConstantOnes<float>();
         }
-        return reinterpret_cast<const T*>(constant_ones_float_->GetBuffer(stream_, count));
+        return WaitForFill(reinterpret_cast<const T*>(constant_ones_float_->GetBuffer(Stream(), count)), count,
+                           constant_ones_float_count_);
       } else if (std::is_same<T, double>::value) {
         if (!constant_ones_double_) {
           constant_ones_double_ = cuda::CreateConstantOnes<double>();
         }
-        return reinterpret_cast<const T*>(constant_ones_double_->GetBuffer(stream_, count));
+        return WaitForFill(reinterpret_cast<const T*>(constant_ones_double_->GetBuffer(Stream(), count)), count,
+                           constant_ones_double_count_);
       } else if (std::is_same<T, half>::value) {
         if (!constant_ones_half_) {
           constant_ones_half_ = cuda::CreateConstantOnes<half>();
         }
-        return reinterpret_cast<const T*>(constant_ones_half_->GetBuffer(stream_, count));
+        return WaitForFill(reinterpret_cast<const T*>(constant_ones_half_->GetBuffer(Stream(), count)), count,
+                           constant_ones_half_count_);
       } else if (std::is_same<T, BFloat16>::value) {
         if (!constant_ones_bfloat16_) {
           constant_ones_bfloat16_ = cuda::CreateConstantOnes<BFloat16>();
         }
-        return reinterpret_cast<const T*>(constant_ones_bfloat16_->GetBuffer(stream_, count));
+        return WaitForFill(reinterpret_cast<const T*>(constant_ones_bfloat16_->GetBuffer(Stream(), count)), count,
+                           constant_ones_bfloat16_count_);
       } else {
         return nullptr;
       }
@@ -165,7 +210,25 @@ class CUDAExecutionProvider : public IExecutionProvider {
       return allocator_;
     }
 
+    // With several compute streams, the kernels of another stream may read a constant buffer next,
+    // so its fill is waited for when it grows.
+    template <typename T>
+    const T* WaitForFill(const T* buffer, size_t count, size_t& filled_count) {
+      if (compute_streams_.size() > 1 && count > filled_count) {
+        CUDA_CALL_THROW(cudaStreamSynchronize(Stream()));
+        filled_count = count;
+      }
+      return buffer;
+    }
+
+    // Whether a run of this thread is between OnRunStart() and OnRunEnd().
+    bool IsInRun() const { return in_run_; }
+    void SetInRun(bool in_run) { in_run_ = in_run; }
+
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  // Makes the graph of graph_key the one the functions below refer to, releasing the least recently selected
+  // graph when there are more than max_graphs.
+  void SelectGraph(size_t graph_key, size_t max_graphs);
   bool IsGraphCaptureAllowed() const;
   void CaptureBegin();
   void CaptureEnd();
@@ -175,7 +238,16 @@ class CUDAExecutionProvider : public IExecutionProvider {
 #endif
 
    private:
-    cudaStream_t stream_ = nullptr;
+    // the default compute stream followed by the extra ones
+    std::vector<cudaStream_t> compute_streams_;
+    bool owns_stream_ = false;
+    bool in_run_ = false;
+    size_t current_stream_index_ = 0;
+    // whether each stream waited for the default one since the last join
+    std::vector<bool> stream_forked_;
+    // recorded on a stream right before another one waits for it
+    cudaEvent_t stream_sync_event_ = nullptr;
+
     cublasHandle_t cublas_handle_ = nullptr;
     cudnnHandle_t cudnn_handle_ = nullptr;
 
@@ -188,15 +260,28 @@ class CUDAExecutionProvider : public IExecutionProvider {
     std::unique_ptr<cuda::IConstantBuffer<double>> constant_ones_double_;
     std::unique_ptr<cuda::IConstantBuffer<half>> constant_ones_half_;
     std::unique_ptr<cuda::IConstantBuffer<BFloat16>> constant_ones_bfloat16_;
+    size_t constant_ones_float_count_ = 0;
+    size_t constant_ones_double_count_ = 0;
+    size_t constant_ones_half_count_ = 0;
+    size_t constant_ones_bfloat16_count_ = 0;
 
     AllocatorPtr allocator_;
 
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-    // Cuda graph with multi threads will be supported in the future, so cuda_graph_
-    // is put under PerThreadContext.
-    CUDAGraph cuda_graph_;
-    bool is_graph_captured_ = false;
-    int regular_run_count_before_graph_capture_ = 0;
+    // The cuda graphs are put under PerThreadContext, so the threads capture and replay them
+    // concurrently on their own streams.
+    struct CapturedGraph {
+      size_t key = 0;
+      CUDAGraph cuda_graph;
+      bool is_graph_captured = false;
+      int regular_run_count_before_graph_capture = 0;
+    };
+
+    // The selected graph, the first one of cuda_graphs_, which selects the graph of key 0 if none was.
+    CapturedGraph& CurrentGraph();
+
+    // the graphs of the thread, the most recently selected first
+    std::list<CapturedGraph> cuda_graphs_;
     const int min_num_runs_before_cuda_graph_capture_ = 1; // required min regular runs before graph capture for the necessary memory allocations.
 
 #endif
@@ -24,6 +24,12 @@ constexpr const char* kGpuExternalEmptyCache = "gpu_external_empty_cache";
 constexpr const char* kCudnnConvUseMaxWorkspace = "cudnn_conv_use_max_workspace";
 constexpr const char* kEnableCudaGraph = "enable_cuda_graph";
 constexpr const char* kCudnnConv1dPadToNc1d = "cudnn_conv1d_pad_to_nc1d";
+constexpr const char* kCudnnConvAlgoCacheFile = "cudnn_conv_algo_cache_file";
+constexpr const char* kFusedElementwiseCacheDir = "fused_elementwise_cache_dir";
+constexpr const char* kNumComputeStreams = "num_compute_streams";
+constexpr const char* kMaxCudaGraphs = "max_cuda_graphs";
+constexpr const char* kUseCudaMemPool = "use_cuda_mempool";
+constexpr const char* kCudaMemPoolReleaseThreshold = "cuda_mempool_release_threshold";
 }  // namespace provider_option_names
 }  // namespace cuda
 
@@ -86,6 +92,9 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
                 return Status::OK();
               })
           .AddAssignmentToReference(cuda::provider_option_names::kMemLimit, info.gpu_mem_limit)
+          .AddAssignmentToReference(cuda::provider_option_names::kUseCudaMemPool, info.mempool_info.use_mempool)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+                                    info.mempool_info.release_threshold)
           .AddAssignmentToEnumReference(
               cuda::provider_option_names::kArenaExtendStrategy,
               *arena_extend_strategy_mapping, info.arena_extend_strategy)
@@ -96,6 +105,24 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConvUseMaxWorkspace, info.cudnn_conv_use_max_workspace)
           .AddAssignmentToReference(cuda::provider_option_names::kEnableCudaGraph, info.enable_cuda_graph)
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConv1dPadToNc1d, info.cudnn_conv1d_pad_to_nc1d)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudnnConvAlgoCacheFile, info.cudnn_conv_algo_cache_file)
+          .AddAssignmentToReference(cuda::provider_option_names::kFusedElementwiseCacheDir, info.fused_elementwise_cache_dir)
+          .AddValueParser(
+              cuda::provider_option_names::kNumComputeStreams,
+              [&info](const std::string& value_str) -> Status {
+                ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.num_compute_streams));
+                ORT_RETURN_IF_NOT(info.num_compute_streams >= 1,
+                                  "Invalid number of compute streams: ", info.num_compute_streams, ", must be at least 1.");
+                return Status::OK();
+              })
+          .AddValueParser(
+              cuda::provider_option_names::kMaxCudaGraphs,
+              [&info](const std::string& value_str) -> Status {
+                ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.max_cuda_graphs));
+                ORT_RETURN_IF_NOT(info.max_cuda_graphs >= 1,
+                                  "Invalid maximum number of CUDA graphs: ", info.max_cuda_graphs, ", must be at least 1.");
+                return Status::OK();
+              })
           .Parse(options));
 
   CUDAExecutionProviderExternalAllocatorInfo alloc_info{alloc, free, empty_cache};
@@ -110,6 +137,8 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kGpuExternalAlloc, MakeStringWithClassicLocale(reinterpret_cast<size_t>(info.external_allocator_info.alloc))},
       {cuda::provider_option_names::kGpuExternalFree, MakeStringWithClassicLocale(reinterpret_cast<size_t>(info.external_allocator_info.free))},
       {cuda::provider_option_names::kGpuExternalEmptyCache, MakeStringWithClassicLocale(reinterpret_cast<size_t>(info.external_allocator_info.empty_cache))},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.mempool_info.use_mempool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold, MakeStringWithClassicLocale(info.mempool_info.release_threshold)},
       {cuda::provider_option_names::kArenaExtendStrategy,
        EnumToName(*arena_extend_strategy_mapping, info.arena_extend_strategy)},
       {cuda::provider_option_names::kCudnnConvAlgoSearch,
@@ -117,7 +146,11 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
       {cuda::provider_option_names::kCudnnConvUseMaxWorkspace, MakeStringWithClassicLocale(info.cudnn_conv_use_max_workspace)},
       {cuda::provider_option_names::kEnableCudaGraph, MakeStringWithClassicLocale(info.enable_cuda_graph)},
-      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)}
+      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)},
+      {cuda::provider_option_names::kCudnnConvAlgoCacheFile, info.cudnn_conv_algo_cache_file},
+      {cuda::provider_option_names::kFusedElementwiseCacheDir, info.fused_elementwise_cache_dir},
+      {cuda::provider_option_names::kNumComputeStreams, MakeStringWithClassicLocale(info.num_compute_streams)},
+      {cuda::provider_option_names::kMaxCudaGraphs, MakeStringWithClassicLocale(info.max_cuda_graphs)}
   };
 
   return options;
@@ -127,11 +160,19 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const OrtCUDAProvid
   const ProviderOptions options{
       {cuda::provider_option_names::kDeviceId, MakeStringWithClassicLocale(info.device_id)},
       {cuda::provider_option_names::kMemLimit, MakeStringWithClassicLocale(info.gpu_mem_limit)},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.use_cuda_mempool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold, MakeStringWithClassicLocale(info.cuda_mempool_release_threshold)},
       {cuda::provider_option_names::kArenaExtendStrategy, EnumToName(*arena_extend_strategy_mapping, info.arena_extend_strategy)},
       {cuda::provider_option_names::kCudnnConvAlgoSearch, EnumToName(*ort_cudnn_conv_algo_search_mapping, info.cudnn_conv_algo_search)},
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
       {cuda::provider_option_names::kCudnnConvUseMaxWorkspace, MakeStringWithClassicLocale(info.cudnn_conv_use_max_workspace)},
-      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)}
+      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)},
+      {cuda::provider_option_names::kCudnnConvAlgoCacheFile,
+       info.cudnn_conv_algo_cache_file == nullptr ? "" : info.cudnn_conv_algo_cache_file},
+      {cuda::provider_option_names::kFusedElementwiseCacheDir,
+       info.fused_elementwise_cache_dir == nullptr ? "" : info.fused_elementwise_cache_dir},
+      {cuda::provider_option_names::kNumComputeStreams, MakeStringWithClassicLocale(info.num_compute_streams)},
+      {cuda::provider_option_names::kMaxCudaGraphs, MakeStringWithClassicLocale(info.max_cuda_graphs)}
   };
 
   return options;
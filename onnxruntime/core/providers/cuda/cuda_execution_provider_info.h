@@ -34,6 +34,16 @@ struct CUDAExecutionProviderExternalAllocatorInfo {
   }
 };
 
+// Information needed to allocate the device memory of CUDA execution providers from a CUDA memory pool.
+struct CUDAExecutionProviderMemPoolInfo {
+  // Allocate with cudaMallocAsync from the default memory pool of the device, shared by all the sessions of the
+  // process, instead of an arena per session. The memory is freed in stream order with cudaFreeAsync.
+  bool use_mempool{false};
+  // Bytes of freed memory the pool holds on to for the next allocations when a stream synchronizes, instead of
+  // releasing them to the system. The pool keeps the largest threshold the sessions asked for.
+  size_t release_threshold{0};
+};
+
 struct CUDAExecutionProviderInfo {
   OrtDevice::DeviceId device_id{0};
   size_t gpu_mem_limit{std::numeric_limits<size_t>::max()};                         // Will be over-ridden by contents of `default_memory_arena_cfg` (if specified)
@@ -48,6 +58,7 @@ struct CUDAExecutionProviderInfo {
   // arena config.
   OrtArenaCfg* default_memory_arena_cfg{nullptr};
   CUDAExecutionProviderExternalAllocatorInfo external_allocator_info{};
+  CUDAExecutionProviderMemPoolInfo mempool_info{};
   // By default use fix workspace size (32M) for Conv algo search, the final algo might not be the best.
   // If set to true, try to use as much as possible memory for algo search.
   bool cudnn_conv_use_max_workspace{false};
@@ -57,6 +68,24 @@ struct CUDAExecutionProviderInfo {
   // By default, for Conv1D, will pad [N,C,D] to [N,C,D,1], if turn on, will pad to [N,C,1,D].
   bool cudnn_conv1d_pad_to_nc1d{false};
 
+  // File the convolution algorithms found by the EXHAUSTIVE algo search are persisted to. The file is loaded when
+  // the provider is created, and the algorithms the sessions find are appended to it, so that the other sessions
+  // and processes using it don't benchmark them again. Empty to only share them between the sessions of the process.
+  std::string cudnn_conv_algo_cache_file;
+
+  // Directory the PTX of the FusedElementwise kernels compiled by NVRTC is persisted to, a file per kernel, so that
+  // the sessions of the other processes load it instead of compiling the kernel again. Empty to only share the
+  // kernels between the sessions of the process.
+  std::string fused_elementwise_cache_dir;
+
+  // Number of compute streams the independent branches of the graph are assigned to. With more than one,
+  // the nodes run concurrently on the streams, synchronized by events on the values crossing them.
+  int num_compute_streams{1};
+
+  // Maximum number of CUDA graphs a thread keeps captured with enable_cuda_graph, one per shape and address
+  // signature of the inputs and outputs. The least recently replayed graph is released beyond it.
+  int max_cuda_graphs{8};
+
   static CUDAExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const CUDAExecutionProviderInfo& info);
   static ProviderOptions ToProviderOptions(const OrtCUDAProviderOptionsV2& info);
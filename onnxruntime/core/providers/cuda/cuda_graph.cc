@@ -27,11 +27,10 @@ void CUDAGraph::CaptureBegin() {
               "Create a new instance to capture a new graph.");
 
   CUDA_CALL_THROW(cudaStreamSynchronize(stream_));
-  // For now cuda graph can only work with a single thread. In the future, we
-  // will support multiple threads. For multiple threads with multiple graphs
-  // and streams, `cudaStreamCaptureModeGlobal` needs to be changed to
-  // `cudaStreamCaptureModeThreadLocal`
-  CUDA_CALL_THROW(cudaStreamBeginCapture(stream_, cudaStreamCaptureModeGlobal));
+  // Each thread captures its graphs on its own stream, so the capture only needs
+  // to guard against the unsafe calls of the capturing thread, the other threads
+  // keep running or capturing their own graphs meanwhile.
+  CUDA_CALL_THROW(cudaStreamBeginCapture(stream_, cudaStreamCaptureModeThreadLocal));
 #else
   ORT_THROW("CUDA graphs can only be used in Onnxruntime built with CUDA >= 10.0");
 #endif
@@ -56,7 +55,7 @@ void CUDAGraph::CaptureEnd() {
 
 Status CUDAGraph::Replay() {
   // Although this function is not thread safe, the lock is not needed here because
-  // CUDA EP maintains a separate cuda graph per thread
+  // CUDA EP maintains separate cuda graphs and streams per thread
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
   LOGS_DEFAULT(INFO) << "Replaying CUDA graph on stream " << stream_;
   CUDA_RETURN_IF_ERROR(cudaGraphLaunch(graph_exec_, stream_));
@@ -223,6 +223,14 @@ struct CUDA_Provider : Provider {
     info.cudnn_conv_use_max_workspace = params->cudnn_conv_use_max_workspace != 0;
     info.enable_cuda_graph = params->enable_cuda_graph != 0;
     info.cudnn_conv1d_pad_to_nc1d = params->cudnn_conv1d_pad_to_nc1d != 0;
+    info.num_compute_streams = params->num_compute_streams;
+    info.max_cuda_graphs = params->max_cuda_graphs;
+    info.mempool_info.use_mempool = params->use_cuda_mempool != 0;
+    info.mempool_info.release_threshold = params->cuda_mempool_release_threshold;
+    info.cudnn_conv_algo_cache_file =
+        params->cudnn_conv_algo_cache_file == nullptr ? "" : params->cudnn_conv_algo_cache_file;
+    info.fused_elementwise_cache_dir =
+        params->fused_elementwise_cache_dir == nullptr ? "" : params->fused_elementwise_cache_dir;
 
     return std::make_shared<CUDAProviderFactory>(info);
   }
@@ -242,6 +250,24 @@ struct CUDA_Provider : Provider {
     cuda_options.cudnn_conv_use_max_workspace = internal_options.cudnn_conv_use_max_workspace;
     cuda_options.enable_cuda_graph = internal_options.enable_cuda_graph;
     cuda_options.cudnn_conv1d_pad_to_nc1d = internal_options.cudnn_conv1d_pad_to_nc1d;
+    cuda_options.num_compute_streams = internal_options.num_compute_streams;
+    cuda_options.max_cuda_graphs = internal_options.max_cuda_graphs;
+    cuda_options.use_cuda_mempool = internal_options.mempool_info.use_mempool;
+    cuda_options.cuda_mempool_release_threshold = internal_options.mempool_info.release_threshold;
+
+    // The strings are owned by the options, and released by ReleaseCUDAProviderOptions.
+    const auto copy_string = [](const std::string& value, const char*& dest) {
+      delete[] dest;
+      dest = nullptr;
+      const size_t str_size = value.size();
+      if (str_size != 0) {
+        char* str = new char[str_size + 1];
+        memcpy(str, value.c_str(), str_size + 1);
+        dest = str;
+      }
+    };
+    copy_string(internal_options.cudnn_conv_algo_cache_file, cuda_options.cudnn_conv_algo_cache_file);
+    copy_string(internal_options.fused_elementwise_cache_dir, cuda_options.fused_elementwise_cache_dir);
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
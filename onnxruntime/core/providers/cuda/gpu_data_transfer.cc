@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cstring>
+
 #include "core/providers/shared_library/provider_api.h"
 #include "core/providers/cuda/gpu_data_transfer.h"
 #include "cuda_common.h"
@@ -10,7 +13,92 @@
 // so we leave it as optional, in case user need the previous behavior
 // a full fix to BFC arena is being looked at, and once it's in, we can revert this change
 namespace onnxruntime {
-GPUDataTransfer::GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream) {
+
+namespace {
+// pinned memory staging the copies from pageable memory, which are larger than it is are not staged
+constexpr size_t kStagingRingCapacity = 32 * 1024 * 1024;
+constexpr size_t kStagingRegionAlignment = 256;
+}  // namespace
+
+PinnedStagingRing::~PinnedStagingRing() {
+  for (auto& region : in_flight_) {
+    cudaEventSynchronize(region.copied);
+    cudaEventDestroy(region.copied);
+  }
+  for (cudaEvent_t event : free_events_) {
+    cudaEventDestroy(event);
+  }
+  if (buffer_ != nullptr) {
+    cudaFreeHost(buffer_);  // do not throw error since it's OK for cudaFreeHost to fail during shutdown
+  }
+}
+
+common::Status PinnedStagingRing::ReleaseOldest(bool wait, bool& released) {
+  released = false;
+  Region& oldest = in_flight_.front();
+  if (wait) {
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(oldest.copied));
+  } else if (cudaEventQuery(oldest.copied) != cudaSuccess) {
+    return Status::OK();
+  }
+  free_events_.push_back(oldest.copied);
+  in_flight_.pop_front();
+  released = true;
+  return Status::OK();
+}
+
+common::Status PinnedStagingRing::CopyToDevice(void* dst, const void* src, size_t bytes, cudaStream_t stream,
+                                               bool& staged) {
+  const size_t size = (bytes + kStagingRegionAlignment - 1) / kStagingRegionAlignment * kStagingRegionAlignment;
+  staged = false;
+  if (size > capacity_) {
+    return Status::OK();
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (buffer_ == nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaMallocHost(reinterpret_cast<void**>(&buffer_), capacity_));
+  }
+
+  // release the regions already copied, without waiting
+  bool released = true;
+  while (!in_flight_.empty() && released) {
+    ORT_RETURN_IF_ERROR(ReleaseOldest(false, released));
+  }
+
+  // the region wraps to the start of the ring when it doesn't fit before its end, and waits for the copies of
+  // the older regions it overlaps, which are the oldest ones in flight
+  const size_t offset = head_ + size <= capacity_ ? head_ : 0;
+  auto overlaps = [offset, size](const Region& region) {
+    return region.offset < offset + size && offset < region.offset + region.size;
+  };
+  while (!in_flight_.empty() && std::any_of(in_flight_.begin(), in_flight_.end(), overlaps)) {
+    ORT_RETURN_IF_ERROR(ReleaseOldest(true, released));
+  }
+
+  cudaEvent_t copied = nullptr;
+  if (free_events_.empty()) {
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&copied, cudaEventDisableTiming));
+  } else {
+    copied = free_events_.back();
+    free_events_.pop_back();
+  }
+
+  memcpy(buffer_ + offset, src, bytes);
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst, buffer_ + offset, bytes, cudaMemcpyHostToDevice, stream));
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(copied, stream));
+  in_flight_.push_back(Region{offset, size, copied});
+  head_ = offset + size;
+  staged = true;
+  return Status::OK();
+}
+
+GPUDataTransfer::GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream,
+                                 std::vector<cudaStream_t> extra_compute_streams,
+                                 std::function<cudaStream_t()> current_compute_stream)
+    : extra_compute_streams_(std::move(extra_compute_streams)),
+      current_compute_stream_(std::move(current_compute_stream)),
+      staging_ring_(std::make_unique<PinnedStagingRing>(kStagingRingCapacity)) {
   // create streams, default is nullptr
   do_copy_in_default_stream_ = do_copy_in_default_stream;
   streams_[kCudaStreamDefault] = stream;
@@ -56,9 +144,15 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
         CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToDevice, GetStream(kCudaStreamDefault)));
       }
     } else {
-      // copy from other CPU memory to GPU, this is blocking
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, GetStream(kCudaStreamDefault)));
-      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(GetStream(kCudaStreamDefault)));
+      // copy from other CPU memory to GPU through the pinned staging ring, this is non-blocking once the memory is
+      // staged. A copy on a copy stream is fenced like the ones from pinned memory.
+      bool staged = false;
+      ORT_RETURN_IF_ERROR(staging_ring_->CopyToDevice(dst_data, src_data, bytes, GetStream(exec_queue_id), staged));
+      if (!staged) {
+        // too large for the ring, this is blocking
+        CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, GetStream(kCudaStreamDefault)));
+        CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(GetStream(kCudaStreamDefault)));
+      }
     }
   } else if (src_device.Type() == OrtDevice::GPU) {
     if (dst_device.Type() == OrtDevice::CPU && dst_device.MemType() == OrtDevice::MemType::CUDA_PINNED) {
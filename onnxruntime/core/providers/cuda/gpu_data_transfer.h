@@ -3,8 +3,14 @@
 
 #pragma once
 
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "cuda_pch.h"
 #include "core/framework/data_transfer.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -15,9 +21,47 @@ enum CUDAStreamType : int {
   kTotalCudaStreams,
 };
 
+// The queue ids of the compute streams after the default one follow the copy streams:
+// kTotalCudaStreams + i is the queue of the (i + 1)-th compute stream.
+// With several compute streams, the default queue is the compute stream the kernels of the thread currently run on,
+// given by current_compute_stream.
+
+// A ring of pinned host memory the pageable memory copied to the GPU is staged in, so that the copy returns once
+// the memory is staged instead of once the stream reaches it. The regions are handed out in order around the ring,
+// a region being reused once the event recorded after its copy has completed.
+class PinnedStagingRing {
+ public:
+  explicit PinnedStagingRing(size_t capacity) : capacity_(capacity) {}
+  ~PinnedStagingRing();
+
+  // Copies bytes from the pageable src to dst on stream through the ring. staged is false, and nothing is copied,
+  // when they don't fit in the ring.
+  common::Status CopyToDevice(void* dst, const void* src, size_t bytes, cudaStream_t stream, bool& staged);
+
+ private:
+  struct Region {
+    size_t offset;
+    size_t size;
+    cudaEvent_t copied;
+  };
+
+  // Waits for the oldest region in flight if wait is true, or releases it if it has completed, and returns
+  // whether it was released. The caller holds mutex_.
+  common::Status ReleaseOldest(bool wait, bool& released);
+
+  const size_t capacity_;
+  char* buffer_ = nullptr;  // allocated on first use
+  size_t head_ = 0;         // where the next region starts
+  std::deque<Region> in_flight_;  // oldest first
+  std::vector<cudaEvent_t> free_events_;
+  OrtMutex mutex_;
+};
+
 class GPUDataTransfer : public IDataTransfer {
  public:
-  GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream = true);
+  GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream = true,
+                  std::vector<cudaStream_t> extra_compute_streams = {},
+                  std::function<cudaStream_t()> current_compute_stream = nullptr);
   ~GPUDataTransfer();
 
   bool CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const override;
@@ -27,13 +71,21 @@ class GPUDataTransfer : public IDataTransfer {
   common::Status CopyTensor(const Tensor& src, Tensor& dst, int exec_queue_id) const override;
 
   cudaStream_t GetStream(int queue_id) const {
-    ORT_ENFORCE(queue_id >= 0 && queue_id < kTotalCudaStreams);
-    return streams_[queue_id];
+    ORT_ENFORCE(queue_id >= 0 && queue_id < kTotalCudaStreams + static_cast<int>(extra_compute_streams_.size()));
+    if (queue_id == kCudaStreamDefault && current_compute_stream_) {
+      return current_compute_stream_();
+    }
+    return queue_id < kTotalCudaStreams ? streams_[queue_id] : extra_compute_streams_[queue_id - kTotalCudaStreams];
   }
 
  private:
   bool do_copy_in_default_stream_;
   cudaStream_t streams_[kTotalCudaStreams];
+  // not owned, the execution provider creates them
+  std::vector<cudaStream_t> extra_compute_streams_;
+  std::function<cudaStream_t()> current_compute_stream_;
+  // stages the copies from pageable memory to the GPU
+  std::unique_ptr<PinnedStagingRing> staging_ring_;
 };
 
 }  // namespace onnxruntime
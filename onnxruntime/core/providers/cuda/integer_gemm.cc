@@ -3,6 +3,8 @@
 
 #include "core/providers/cuda/shared_inc/integer_gemm.h"
 
+#include <cublasLt.h>
+
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/shared_inc/cuda_call.h"
 
@@ -58,5 +60,90 @@ Status GemmInt8(int m, int n, int k,
       CUBLAS_GEMM_DFALT));
   return Status::OK();
 }
+
+Status GemmInt8Requantize(int m, int n, int k,
+                          float alpha,
+                          const int8_t* a, int lda, const int8_t* b_transposed, int ldb, int8_t* c, int ldc,
+                          const CudaKernel* cuda_kernel,
+                          bool& supported) {
+  ORT_ENFORCE(a != nullptr && b_transposed != nullptr && c != nullptr, "input matrix should not be null");
+  ORT_ENFORCE(cuda_kernel != nullptr, "kernel is null");
+  supported = false;
+
+#if CUDA_VERSION >= 11000
+  // IMMA kernels need Turing or later.
+  if (cuda_kernel->GetDeviceProp().major < 7 ||
+      (cuda_kernel->GetDeviceProp().major == 7 && cuda_kernel->GetDeviceProp().minor < 5)) {
+    return Status::OK();
+  }
+
+  // A cuBLAS handle can be used as a cuBLASLt handle.
+  cublasLtHandle_t cublas_lt = reinterpret_cast<cublasLtHandle_t>(cuda_kernel->CublasHandle());
+
+  // Row major c (m x n) = a (m x k) * b (k x n) is computed as column major c^T = b^T * a^T, where b^T is
+  // b_transposed read as a transposed column major k x n matrix, and a^T is a read as a column major k x m matrix.
+  cublasLtMatmulDesc_t op_desc = nullptr;
+  cublasLtMatrixLayout_t b_desc = nullptr;
+  cublasLtMatrixLayout_t a_desc = nullptr;
+  cublasLtMatrixLayout_t c_desc = nullptr;
+  cublasLtMatmulPreference_t preference = nullptr;
+  auto release = [&]() {
+    if (preference) cublasLtMatmulPreferenceDestroy(preference);
+    if (c_desc) cublasLtMatrixLayoutDestroy(c_desc);
+    if (a_desc) cublasLtMatrixLayoutDestroy(a_desc);
+    if (b_desc) cublasLtMatrixLayoutDestroy(b_desc);
+    if (op_desc) cublasLtMatmulDescDestroy(op_desc);
+  };
+
+  Status status = [&]() -> Status {
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescCreate(&op_desc, CUBLAS_COMPUTE_32I, CUDA_R_32F));
+    const cublasOperation_t trans_b = CUBLAS_OP_T;
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_TRANSA,
+                                                          &trans_b, sizeof(trans_b)));
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&b_desc, CUDA_R_8I, k, n, ldb));
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&a_desc, CUDA_R_8I, k, m, lda));
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&c_desc, CUDA_R_8I, n, m, ldc));
+
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceCreate(&preference));
+    const size_t max_workspace_size = 0;
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceSetAttribute(preference, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                                                &max_workspace_size, sizeof(max_workspace_size)));
+
+    cublasLtMatmulHeuristicResult_t heuristic{};
+    int num_results = 0;
+    if (cublasLtMatmulAlgoGetHeuristic(cublas_lt, op_desc, b_desc, a_desc, c_desc, c_desc, preference,
+                                       1, &heuristic, &num_results) != CUBLAS_STATUS_SUCCESS ||
+        num_results == 0) {
+      return Status::OK();
+    }
+
+    const float beta = 0.0f;
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmul(cublas_lt, op_desc,
+                                          &alpha,
+                                          b_transposed, b_desc,
+                                          a, a_desc,
+                                          &beta,
+                                          c, c_desc,
+                                          c, c_desc,
+                                          &heuristic.algo,
+                                          nullptr, 0,
+                                          cuda_kernel->Stream()));
+    supported = true;
+    return Status::OK();
+  }();
+
+  release();
+  return status;
+#else
+  ORT_UNUSED_PARAMETER(m);
+  ORT_UNUSED_PARAMETER(n);
+  ORT_UNUSED_PARAMETER(k);
+  ORT_UNUSED_PARAMETER(alpha);
+  ORT_UNUSED_PARAMETER(lda);
+  ORT_UNUSED_PARAMETER(ldb);
+  ORT_UNUSED_PARAMETER(ldc);
+  return Status::OK();
+#endif
+}
 }  // namespace cuda
 }  // namespace onnxruntime
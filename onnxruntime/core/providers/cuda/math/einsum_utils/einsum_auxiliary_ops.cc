@@ -28,7 +28,7 @@ Status DataCopy(const Tensor& input, Tensor& output, void* einsum_cuda_assets) {
   // *if* the kernel is launched in a different stream
   CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(output.MutableDataRaw(), input.DataRaw(), input.SizeInBytes(),
                                        cudaMemcpyDeviceToDevice,
-                                       static_cast<cudaStream_t>(static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cuda_ep_->GetComputeStream())));
+                                       static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cuda_ep_->GetCurrentComputeStream()));
 
   return Status::OK();
 }
@@ -37,7 +37,7 @@ Status DataCopy(const Tensor& input, Tensor& output, void* einsum_cuda_assets) {
 Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input,
                  Tensor& output, const TensorShape* input_shape_override, void* einsum_cuda_assets) {
   return cuda::Transpose::DoTranspose(static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cuda_ep_->GetDeviceProp(),
-                                      static_cast<cudaStream_t>(static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cuda_ep_->GetComputeStream()),
+                                      static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cuda_ep_->GetCurrentComputeStream(),
                                       static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cublas_handle_,
                                       permutation, input, output, input_shape_override);
 }
@@ -127,7 +127,7 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
   }
 
   DiagonalImpl(
-      static_cast<cudaStream_t>(static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cuda_ep_->GetComputeStream()),
+      static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cuda_ep_->GetCurrentComputeStream(),
       input.DataRaw(),
       input.Shape().GetDims().size(),
       first_dim,
@@ -0,0 +1,192 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/math/qlinear_matmul.h"
+
+#include <algorithm>
+
+#include "core/providers/cuda/math/matmul_integer.cuh"
+#include "core/providers/cuda/math/qlinear_matmul_impl.h"
+#include "core/providers/cuda/shared_inc/integer_gemm.h"
+#include "core/providers/cuda/tensor/transpose.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    QLinearMatMul,
+    kOnnxDomain,
+    10,
+    int8_t,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .InputMemoryType(OrtMemTypeCPUInput, 1)
+        .InputMemoryType(OrtMemTypeCPUInput, 2)
+        .InputMemoryType(OrtMemTypeCPUInput, 4)
+        .InputMemoryType(OrtMemTypeCPUInput, 5)
+        .InputMemoryType(OrtMemTypeCPUInput, 6)
+        .InputMemoryType(OrtMemTypeCPUInput, 7)
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<int8_t>()),
+    QLinearMatMul);
+
+namespace {
+enum InputTensors : int {
+  IN_A = 0,
+  IN_A_SCALE = 1,
+  IN_A_ZERO_POINT = 2,
+  IN_B = 3,
+  IN_B_SCALE = 4,
+  IN_B_ZERO_POINT = 5,
+  IN_Y_SCALE = 6,
+  IN_Y_ZERO_POINT = 7
+};
+
+bool IsScalarOrColumnVector(const Tensor* input, int64_t N) {
+  return IsScalarOr1ElementVector(input) ||
+         (input->Shape().NumDimensions() == 1 && input->Shape()[0] == N);
+}
+}  // namespace
+
+QLinearMatMul::QLinearMatMul(const OpKernelInfo& info) : CudaKernel(info) {
+  const Tensor* b = nullptr;
+  b_is_constant_ = info.TryGetConstantInput(IN_B, &b) && b->Shape().NumDimensions() == 2;
+  allocator_ = info.GetAllocator(0, OrtMemTypeDefault);
+}
+
+Status QLinearMatMul::TransposeB(const Tensor& b) const {
+  std::lock_guard<OrtMutex> lock(b_transposed_mutex_);
+  if (b_transposed_) {
+    return Status::OK();
+  }
+
+  auto b_transposed = Tensor::Create(b.DataType(), TensorShape({b.Shape()[1], b.Shape()[0]}), allocator_);
+  const size_t permutation[] = {1, 0};
+  ORT_RETURN_IF_ERROR(Transpose::DoTranspose(GetDeviceProp(), Stream(), CublasHandle(),
+                                             permutation, b, *b_transposed));
+  b_transposed_ = std::move(b_transposed);
+  return Status::OK();
+}
+
+Status QLinearMatMul::ComputeInternal(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(IN_A);
+  const Tensor* b = ctx->Input<Tensor>(IN_B);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const Tensor* a_scale = ctx->Input<Tensor>(IN_A_SCALE);
+  const Tensor* a_zero_point = ctx->Input<Tensor>(IN_A_ZERO_POINT);
+  const Tensor* b_scale = ctx->Input<Tensor>(IN_B_SCALE);
+  const Tensor* b_zero_point = ctx->Input<Tensor>(IN_B_ZERO_POINT);
+  const Tensor* y_scale = ctx->Input<Tensor>(IN_Y_SCALE);
+  const Tensor* y_zero_point = ctx->Input<Tensor>(IN_Y_ZERO_POINT);
+
+  const int M = static_cast<int>(helper.M());
+  const int N = static_cast<int>(helper.N());
+  const int K = static_cast<int>(helper.K());
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(a_scale),
+                    "QLinearMatmul : input a scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(a_zero_point),
+                    "QLinearMatmul : input a zero point must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(IsScalarOrColumnVector(b_scale, N),
+                    "QLinearMatmul : input b scale must be a scalar or 1D tensor of size N");
+  ORT_RETURN_IF_NOT(IsScalarOrColumnVector(b_zero_point, N),
+                    "QLinearMatmul : input b zero point must be a scalar or 1D tensor of size N");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(y_scale),
+                    "QLinearMatmul : result scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(y_zero_point),
+                    "QLinearMatmul : result zero point must be a scalar or 1D tensor of size 1");
+
+  const float a_scale_value = *a_scale->Data<float>();
+  const int32_t a_zero_point_value = *a_zero_point->Data<int8_t>();
+  const float y_scale_value = *y_scale->Data<float>();
+  const int32_t y_zero_point_value = *y_zero_point->Data<int8_t>();
+  const gsl::span<const float> b_scale_data(b_scale->Data<float>(), gsl::narrow<size_t>(b_scale->Shape().Size()));
+  const gsl::span<const int8_t> b_zero_point_data(b_zero_point->Data<int8_t>(),
+                                                  gsl::narrow<size_t>(b_zero_point->Shape().Size()));
+
+  const bool b_per_tensor_scale = std::all_of(b_scale_data.begin(), b_scale_data.end(),
+                                              [&](float s) { return s == b_scale_data[0]; });
+  const bool b_zero_point_is_zero = std::all_of(b_zero_point_data.begin(), b_zero_point_data.end(),
+                                                [](int8_t zp) { return zp == 0; });
+
+  const int8_t* a_ptr = a->Data<int8_t>();
+  const int8_t* b_ptr = b->Data<int8_t>();
+  int8_t* y_ptr = y->MutableData<int8_t>();
+
+  // Symmetric quantization with per-tensor scales, the requantization is fused into the IMMA kernel.
+  if (b_is_constant_ && a_zero_point_value == 0 && y_zero_point_value == 0 &&
+      b_zero_point_is_zero && b_per_tensor_scale) {
+    ORT_RETURN_IF_ERROR(TransposeB(*b));
+    const float alpha = a_scale_value * b_scale_data[0] / y_scale_value;
+    bool supported = true;
+    for (size_t batch = 0; supported && batch < helper.OutputOffsets().size(); batch++) {
+      ORT_RETURN_IF_ERROR(GemmInt8Requantize(M, N, K,
+                                             alpha,
+                                             a_ptr + helper.LeftOffsets()[batch], K,
+                                             b_transposed_->Data<int8_t>(), K,
+                                             y_ptr + helper.OutputOffsets()[batch], N,
+                                             this, supported));
+    }
+    if (supported) {
+      return Status::OK();
+    }
+  }
+
+  CudaAsyncBuffer<float> multiplier(this, N);
+  CudaAsyncBuffer<int32_t> b_zero_point_buffer(this, N);
+  for (int j = 0; j < N; j++) {
+    multiplier.CpuPtr()[j] = a_scale_value * b_scale_data[b_scale_data.size() == 1 ? 0 : j] / y_scale_value;
+    b_zero_point_buffer.CpuPtr()[j] = b_zero_point_data[b_zero_point_data.size() == 1 ? 0 : j];
+  }
+  ORT_RETURN_IF_ERROR(multiplier.CopyToGpu());
+  ORT_RETURN_IF_ERROR(b_zero_point_buffer.CopyToGpu());
+
+  // The sums are multiplied by the zero points in the requantization, as the zero points of b may be per column.
+  IAllocatorUniquePtr<int32_t> a_row_sum;
+  if (!b_zero_point_is_zero) {
+    a_row_sum = GetScratchBuffer<int32_t>(helper.OutputShape().Size() / N);
+    ORT_RETURN_IF_ERROR(ReduceRowSumOnMatrixA(Stream(), a_ptr, a_row_sum.get(), 1, helper));
+  }
+
+  IAllocatorUniquePtr<int32_t> b_col_sum;
+  if (a_zero_point_value != 0) {
+    b_col_sum = GetScratchBuffer<int32_t>(helper.OutputShape().Size() / M);
+    ORT_RETURN_IF_ERROR(ReduceColSumOnMatrixB(Stream(), b_ptr, b_col_sum.get(), 1, helper));
+  }
+
+  IAllocatorUniquePtr<int32_t> acc = GetScratchBuffer<int32_t>(helper.OutputShape().Size());
+  for (size_t batch = 0; batch < helper.OutputOffsets().size(); batch++) {
+    ORT_RETURN_IF_ERROR(GemmInt8(M, N, K,
+                                 1, 0,
+                                 a_ptr + helper.LeftOffsets()[batch], K,
+                                 b_ptr + helper.RightOffsets()[batch], N,
+                                 acc.get() + helper.OutputOffsets()[batch], N,
+                                 this));
+    QLinearMatMulRequantize(Stream(),
+                            acc.get() + helper.OutputOffsets()[batch],
+                            y_ptr + helper.OutputOffsets()[batch],
+                            a_row_sum ? a_row_sum.get() + batch * M : nullptr,
+                            b_col_sum ? b_col_sum.get() + batch * N : nullptr,
+                            a_zero_point_value,
+                            b_zero_point_buffer.GpuPtr(),
+                            multiplier.GpuPtr(),
+                            y_zero_point_value,
+                            M, N, K);
+  }
+
+  return CUDA_CALL(cudaGetLastError()) ? Status::OK() : Status(common::ONNXRUNTIME, common::FAIL);
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// QLinearMatMul with int8 a, b and y. With zero zero points and per-tensor scales, which is how models are
+// quantized for GPUs, and a constant 2-D b, the GEMM runs on int8 tensor cores with the requantization fused
+// into its epilogue, see GemmInt8Requantize. It runs as an int32 GEMM followed by a requantization kernel otherwise.
+class QLinearMatMul final : public CudaKernel {
+ public:
+  QLinearMatMul(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  Status TransposeB(const Tensor& b) const;
+
+  bool b_is_constant_{false};
+  AllocatorPtr allocator_;
+
+  // A constant b transposed for the IMMA kernels, computed on the compute stream by the first run.
+  mutable OrtMutex b_transposed_mutex_;
+  mutable std::unique_ptr<Tensor> b_transposed_;
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
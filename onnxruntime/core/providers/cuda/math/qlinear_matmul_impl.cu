@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/math/qlinear_matmul_impl.h"
+#include "core/providers/cuda/cu_inc/common.cuh"
+
+namespace onnxruntime {
+namespace cuda {
+
+__global__ void _QLinearMatMulRequantize(const int32_t* acc,
+                                         int8_t* output,
+                                         const int32_t* row_sum,
+                                         const int32_t* col_sum,
+                                         int32_t a_zero_point,
+                                         const int32_t* b_zero_point,
+                                         const float* multiplier,
+                                         int32_t y_zero_point,
+                                         const fast_divmod n_div,
+                                         int32_t k,
+                                         CUDA_LONG N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+  int row, col;
+  n_div.divmod(id, row, col);
+
+  int32_t value = acc[id];
+  if (col_sum) {
+    value -= a_zero_point * col_sum[col];
+  }
+  if (row_sum) {
+    value -= b_zero_point[col] * (row_sum[row] - k * a_zero_point);
+  }
+
+  float y = nearbyintf(static_cast<float>(value) * multiplier[col]) + static_cast<float>(y_zero_point);
+  output[id] = static_cast<int8_t>(fminf(fmaxf(y, -128.0f), 127.0f));
+}
+
+void QLinearMatMulRequantize(cudaStream_t stream,
+                             const int32_t* acc,
+                             int8_t* output,
+                             const int32_t* row_sum,
+                             const int32_t* col_sum,
+                             int32_t a_zero_point,
+                             const int32_t* b_zero_point,
+                             const float* multiplier,
+                             int32_t y_zero_point,
+                             int m, int n, int k) {
+  CUDA_LONG N = static_cast<CUDA_LONG>(m) * n;
+  int blocksPerGrid = static_cast<int>(CeilDiv(N, GridDim::maxThreadsPerBlock));
+  _QLinearMatMulRequantize<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      acc, output, row_sum, col_sum, a_zero_point, b_zero_point, multiplier, y_zero_point, fast_divmod(n), k, N);
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Requantizes the int32 product of a (m x k) and b (k x n) to int8 in place of QLinearMatMul's output:
+// y[i, j] = saturate(round((acc[i, j] - a_zero_point * col_sum[j] - b_zero_point[j] * row_sum[i] +
+//                           k * a_zero_point * b_zero_point[j]) * multiplier[j]) + y_zero_point)
+// row_sum and col_sum are the plain sums of the rows of a and the columns of b, nullptr if b_zero_point, resp.
+// a_zero_point, is zero. b_zero_point and multiplier have n elements, multiplier being a_scale * b_scale / y_scale.
+void QLinearMatMulRequantize(cudaStream_t stream,
+                             const int32_t* acc,
+                             int8_t* output,
+                             const int32_t* row_sum,
+                             const int32_t* col_sum,
+                             int32_t a_zero_point,
+                             const int32_t* b_zero_point,
+                             const float* multiplier,
+                             int32_t y_zero_point,
+                             int m, int n, int k);
+
+}  // namespace cuda
+}  // namespace onnxruntime
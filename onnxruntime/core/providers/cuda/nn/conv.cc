@@ -3,6 +3,7 @@
 
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/nn/conv.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "core/providers/cuda/tensor/slice.h"
 
@@ -266,6 +267,19 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
       ORT_ENFORCE(cudnn_conv_algo > -1 && cudnn_conv_algo < 3, "cudnn_conv_algo should be 0, 1 or 2, but got ", cudnn_conv_algo);
       switch (cudnn_conv_algo) {
         case 0: {
+          // The sessions of the process, and of the processes sharing the cache file, benchmark a convolution once.
+          const std::string& cache_file = cuda_ep->GetCudnnConvAlgoCacheFile();
+          const std::string key = ConvAlgoCache::MakeKey("fwd", GetDeviceProp(), CudnnTensor::GetDataType<CudaT>(),
+                                                         x_dims_cudnn, w_dims, y_dims_cudnn, pads, strides, dilations,
+                                                         conv_attrs_.group, cuda_ep->GetCudnnConvUseMaxWorkspace());
+          ConvAlgoCacheEntry entry;
+          if (ConvAlgoCache::Instance().Find(key, cache_file, entry)) {
+            perf.algo = static_cast<cudnnConvolutionFwdAlgo_t>(entry.algo);
+            perf.memory = entry.memory;
+            perf.mathType = static_cast<cudnnMathType_t>(entry.math_type);
+            break;
+          }
+
           static constexpr int num_algos = CUDNN_CONVOLUTION_FWD_ALGO_COUNT;
           size_t max_ws_size = cuda_ep->GetCudnnConvUseMaxWorkspace() ? GetMaxWorkspaceSize(s_, kAllAlgos, num_algos)
                                                                       : AlgoSearchWorkspaceSize;
@@ -286,6 +300,8 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
               &perf,
               algo_search_workspace.get(),
               max_ws_size));
+          ConvAlgoCache::Instance().Insert(key, cache_file,
+                                           {static_cast<int>(perf.algo), perf.memory, static_cast<int>(perf.mathType)});
           break;
         }
         case 1:
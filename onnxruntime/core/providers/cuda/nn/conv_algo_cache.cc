@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/nn/conv_algo_cache.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace onnxruntime {
+namespace cuda {
+
+// A cache file has a line per entry: the key, a tab, then the algo, the workspace size and the math type.
+// Lines are appended with a single write, so the processes sharing a file don't interleave them.
+namespace {
+void AppendDims(std::ostringstream& out, const char* name, gsl::span<const int64_t> dims) {
+  out << ';' << name << ':';
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (i > 0) out << ',';
+    out << dims[i];
+  }
+}
+}  // namespace
+
+ConvAlgoCache& ConvAlgoCache::Instance() {
+  static ConvAlgoCache cache;
+  return cache;
+}
+
+void ConvAlgoCache::Load(const std::string& path) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!loaded_paths_.insert(path).second) {
+    return;
+  }
+
+  std::ifstream file(path);
+  if (!file) {
+    return;
+  }
+
+  size_t num_loaded = 0;
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto tab = line.find('\t');
+    if (tab == std::string::npos || tab == 0) {
+      continue;
+    }
+    std::istringstream values(line.substr(tab + 1));
+    values.imbue(std::locale::classic());
+    ConvAlgoCacheEntry entry{};
+    if (!(values >> entry.algo >> entry.memory >> entry.math_type)) {
+      continue;
+    }
+    // The first entry of a key wins, the processes sharing the file may have appended it concurrently.
+    auto result = items_.emplace(line.substr(0, tab), Item{entry, {}});
+    result.first->second.paths.insert(path);
+    ++num_loaded;
+  }
+
+  LOGS_DEFAULT(INFO) << "Loaded " << num_loaded << " cuDNN convolution algorithms from " << path;
+}
+
+bool ConvAlgoCache::Find(const std::string& key, const std::string& path, ConvAlgoCacheEntry& entry) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = items_.find(key);
+  if (it == items_.end()) {
+    return false;
+  }
+  Append(key, path, it->second);
+  entry = it->second.entry;
+  return true;
+}
+
+void ConvAlgoCache::Insert(const std::string& key, const std::string& path, const ConvAlgoCacheEntry& entry) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& item = items_[key];
+  item.entry = entry;
+  Append(key, path, item);
+}
+
+void ConvAlgoCache::Append(const std::string& key, const std::string& path, Item& item) {
+  if (path.empty() || !item.paths.insert(path).second) {
+    return;
+  }
+
+  std::ostringstream line;
+  line.imbue(std::locale::classic());
+  line << key << '\t' << item.entry.algo << ' ' << item.entry.memory << ' ' << item.entry.math_type << '\n';
+  std::ofstream file(path, std::ios::app);
+  if (!(file << line.str() << std::flush)) {
+    LOGS_DEFAULT(WARNING) << "Failed to append a cuDNN convolution algorithm to " << path;
+  }
+}
+
+std::string ConvAlgoCache::MakeKey(const char* direction, const cudaDeviceProp& device_prop,
+                                   cudnnDataType_t data_type,
+                                   gsl::span<const int64_t> x_dims, gsl::span<const int64_t> w_dims,
+                                   gsl::span<const int64_t> y_dims, gsl::span<const int64_t> pads,
+                                   gsl::span<const int64_t> strides, gsl::span<const int64_t> dilations,
+                                   int64_t group, bool use_max_workspace) {
+  std::ostringstream key;
+  key.imbue(std::locale::classic());
+  key << direction << ';' << device_prop.name << ";sm" << device_prop.major << device_prop.minor
+      << ";cudnn" << cudnnGetVersion() << ";t" << static_cast<int>(data_type);
+  AppendDims(key, "x", x_dims);
+  AppendDims(key, "w", w_dims);
+  AppendDims(key, "y", y_dims);
+  AppendDims(key, "p", pads);
+  AppendDims(key, "s", strides);
+  AppendDims(key, "d", dilations);
+  key << ";g" << group << ";ws" << (use_max_workspace ? 1 : 0);
+  return key.str();
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
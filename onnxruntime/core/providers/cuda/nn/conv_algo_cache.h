@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// The cuDNN convolution algorithm chosen for a convolution, as found by the EXHAUSTIVE algo search.
+struct ConvAlgoCacheEntry {
+  int algo;
+  size_t memory;
+  int math_type;
+};
+
+// Process-wide cache of the convolution algorithms found by the EXHAUSTIVE algo search, so that the sessions of
+// a process benchmark a convolution once. The cache can be persisted to files, see Load: the entries of a file
+// are loaded once per process and the new entries are appended to it, so that the processes sharing the file
+// don't benchmark the convolutions found by the others.
+// The key identifies the device, the cuDNN version and the convolution descriptor, see MakeKey, so a file can be
+// shared between devices and cuDNN versions, each of them using its own entries.
+class ConvAlgoCache {
+ public:
+  static ConvAlgoCache& Instance();
+
+  // Loads the entries of the cache file at `path`, if not loaded yet. A missing file is created when the first
+  // entry is appended to it. Malformed lines are skipped.
+  void Load(const std::string& path);
+
+  // Looks up the entry of `key`. If found and `path` is not empty, the entry is appended to the cache file at
+  // `path` if it is not in it yet, e.g. it was found by a session persisting to another file.
+  bool Find(const std::string& key, const std::string& path, ConvAlgoCacheEntry& entry);
+
+  // Inserts the entry of `key`. If `path` is not empty, the entry is appended to the cache file at `path`.
+  void Insert(const std::string& key, const std::string& path, const ConvAlgoCacheEntry& entry);
+
+  // Returns the key of a convolution. `direction` tells the cuDNN operation the algorithm is for,
+  // e.g. "fwd" for cudnnConvolutionForward. The dims are the ones of the cuDNN descriptors, after padding 1D to 2D.
+  static std::string MakeKey(const char* direction, const cudaDeviceProp& device_prop, cudnnDataType_t data_type,
+                             gsl::span<const int64_t> x_dims, gsl::span<const int64_t> w_dims,
+                             gsl::span<const int64_t> y_dims, gsl::span<const int64_t> pads,
+                             gsl::span<const int64_t> strides, gsl::span<const int64_t> dilations,
+                             int64_t group, bool use_max_workspace);
+
+ private:
+  struct Item {
+    ConvAlgoCacheEntry entry;
+    // The cache files the entry is in.
+    std::set<std::string> paths;
+  };
+
+  ConvAlgoCache() = default;
+
+  void Append(const std::string& key, const std::string& path, Item& item);
+
+  OrtMutex mutex_;
+  std::unordered_map<std::string, Item> items_;
+  std::set<std::string> loaded_paths_;
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "conv_transpose.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -126,29 +127,43 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
       y_data = reinterpret_cast<CudaT*>(p.Y->template MutableData<T>());
 
       if (!s_.cached_benchmark_results.contains(x_dims)) {
-        IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
-
-        // set math type to tensor core before algorithm search
-        if constexpr (std::is_same<T, MLFloat16>::value)
-          CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
-
-        cudnnConvolutionBwdDataAlgoPerf_t perf;
-        int algo_count = 1;
-        CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
-            CudnnHandle(),
-            s_.w_desc,
-            w_data,
-            s_.x_tensor,
-            x_data,
-            s_.conv_desc,
-            s_.y_tensor,
-            y_data,
-            1,
-            &algo_count,
-            &perf,
-            algo_search_workspace.get(),
-            AlgoSearchWorkspaceSize));
-        s_.cached_benchmark_results.insert(x_dims, {perf.algo, perf.memory, perf.mathType});
+        const CUDAExecutionProvider* cuda_ep =
+            static_cast<const CUDAExecutionProvider*>(this->Info().GetExecutionProvider());
+        const std::string& cache_file = cuda_ep->GetCudnnConvAlgoCacheFile();
+        const std::string key = ConvAlgoCache::MakeKey("bwd_data", GetDeviceProp(), CudnnTensor::GetDataType<CudaT>(),
+                                                       x_dims, w_dims, y_dims, p.pads, p.strides, p.dilations,
+                                                       conv_transpose_attrs_.group, false);
+        ConvAlgoCacheEntry entry;
+        if (ConvAlgoCache::Instance().Find(key, cache_file, entry)) {
+          s_.cached_benchmark_results.insert(x_dims, {static_cast<cudnnConvolutionBwdDataAlgo_t>(entry.algo), entry.memory,
+                                                      static_cast<cudnnMathType_t>(entry.math_type)});
+        } else {
+          IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
+
+          // set math type to tensor core before algorithm search
+          if constexpr (std::is_same<T, MLFloat16>::value)
+            CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
+
+          cudnnConvolutionBwdDataAlgoPerf_t perf;
+          int algo_count = 1;
+          CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
+              CudnnHandle(),
+              s_.w_desc,
+              w_data,
+              s_.x_tensor,
+              x_data,
+              s_.conv_desc,
+              s_.y_tensor,
+              y_data,
+              1,
+              &algo_count,
+              &perf,
+              algo_search_workspace.get(),
+              AlgoSearchWorkspaceSize));
+          s_.cached_benchmark_results.insert(x_dims, {perf.algo, perf.memory, perf.mathType});
+          ConvAlgoCache::Instance().Insert(key, cache_file,
+                                           {static_cast<int>(perf.algo), perf.memory, static_cast<int>(perf.mathType)});
+        }
       }
 
       const auto& perf = s_.cached_benchmark_results.at(x_dims);
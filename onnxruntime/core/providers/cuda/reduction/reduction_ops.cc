@@ -447,7 +447,7 @@ Status ReduceComputeCore(CUDAExecutionProvider& cuda_ep, const Tensor& input, Pr
   auto& output_dims = prepare_reduce_metadata.output_dims;
   auto& input_dims_cudnn = prepare_reduce_metadata.input_dims_cudnn;
   auto& output_dims_cudnn = prepare_reduce_metadata.output_dims_cudnn;
-  cudaStream_t stream = static_cast<cudaStream_t>(cuda_ep.GetComputeStream());
+  cudaStream_t stream = cuda_ep.GetCurrentComputeStream();
   // special case when there is a dim value of 0 in the shape.
   if (input_count == 0) {
     assert(output.Shape().Size() == 0);
@@ -19,5 +19,22 @@ Status GemmInt8(int m,
                 int32_t* c,
                 int ldc,
                 const CudaKernel* cuda_kernel);
-}
-}
\ No newline at end of file
+
+// Computes c = saturate(alpha * a * b) with int8 output, the requantization being fused into the epilogue of a
+// cuBLASLt IMMA kernel. b_transposed is B transposed, i.e. a n x k matrix, as the IMMA kernels require the
+// "TN" layout. `supported` is set to false, without computing anything, if no cuBLASLt kernel supports the
+// shapes and alignments, e.g. leading dimensions that are not multiples of 4. The caller then uses GemmInt8.
+Status GemmInt8Requantize(int m,
+                          int n,
+                          int k,
+                          float alpha,
+                          const int8_t* a,
+                          int lda,
+                          const int8_t* b_transposed,
+                          int ldb,
+                          int8_t* c,
+                          int ldc,
+                          const CudaKernel* cuda_kernel,
+                          bool& supported);
+}  // namespace cuda
+}  // namespace onnxruntime
\ No newline at end of file
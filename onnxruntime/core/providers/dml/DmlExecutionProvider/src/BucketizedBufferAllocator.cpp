@@ -77,6 +77,154 @@ namespace Dml
         return (1ull << (index + c_minResourceSizeExponent));
     }
 
+    bool BucketizedBufferAllocator::IsPlacementSupported(uint64_t size) const
+    {
+        // Upload and readback heaps are not sub-allocated, since their resources can't be aliased by barriers.
+        return m_heapProperties.Type == D3D12_HEAP_TYPE_DEFAULT && size <= c_placedHeapSize;
+    }
+
+    ComPtr<ID3D12Resource> BucketizedBufferAllocator::AllocPlacedResource(
+        uint64_t size,
+        uint64_t resourceSize,
+        _Out_ uint64_t* resourceId)
+    {
+        // Find the smallest free range which fits the allocation, adding a heap if there is none
+        auto bestFit = m_freeRangesBySize.lower_bound(std::make_tuple(size, size_t(0), uint64_t(0)));
+        if (bestFit == m_freeRangesBySize.end())
+        {
+            CD3DX12_HEAP_DESC heapDesc(
+                c_placedHeapSize,
+                m_heapProperties,
+                D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT,
+                m_heapFlags | D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS);
+
+            PlacedHeap placedHeap;
+            ORT_THROW_IF_FAILED(m_device->CreateHeap(&heapDesc, IID_GRAPHICS_PPV_ARGS(placedHeap.heap.ReleaseAndGetAddressOf())));
+            m_placedHeaps.push_back(std::move(placedHeap));
+
+            InsertFreeRange(m_placedHeaps.size() - 1, 0, PlacedRange{c_placedHeapSize, {}});
+            bestFit = m_freeRangesBySize.lower_bound(std::make_tuple(size, size_t(0), uint64_t(0)));
+            assert(bestFit != m_freeRangesBySize.end());
+        }
+
+        const size_t heapIndex = std::get<1>(*bestFit);
+        const uint64_t offset = std::get<2>(*bestFit);
+        PlacedHeap& placedHeap = m_placedHeaps[heapIndex];
+
+        auto freeRange = placedHeap.freeRanges.find(offset);
+        assert(freeRange != placedHeap.freeRanges.end());
+        PlacedRange range = std::move(freeRange->second);
+        RemoveFreeRange(heapIndex, freeRange);
+
+        // Return the rest of the range to the heap
+        if (range.size > size)
+        {
+            InsertFreeRange(heapIndex, offset + size, PlacedRange{range.size - size, {}});
+        }
+
+        ComPtr<ID3D12Resource> resource;
+        if (range.size == size && range.resource.resource && range.resource.resource->GetDesc().Width == resourceSize)
+        {
+            // The placed resource of the range is still valid, since nothing overwrote its memory since it was freed
+            resource = std::move(range.resource.resource);
+            *resourceId = range.resource.resourceId;
+        }
+        else
+        {
+            if (range.resource.resource)
+            {
+                ReleaseResourceWhenCompleted(std::move(range.resource.resource));
+            }
+
+            auto buffer = CD3DX12_RESOURCE_DESC::Buffer(resourceSize, m_resourceFlags);
+            ORT_THROW_IF_FAILED(m_device->CreatePlacedResource(
+                placedHeap.heap.Get(),
+                offset,
+                &buffer,
+                m_initialState,
+                nullptr,
+                IID_GRAPHICS_PPV_ARGS(resource.ReleaseAndGetAddressOf())
+            ));
+
+            *resourceId = ++m_currentResourceId;
+
+            // The memory may have been used by resources freed earlier, whose GPU work is queued before the
+            // work using the new resource.
+            D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Aliasing(nullptr, resource.Get());
+            m_context->ResourceBarrier(gsl::make_span(&barrier, 1));
+        }
+
+        m_placements[*resourceId] = Placement{heapIndex, offset, size};
+        return resource;
+    }
+
+    void BucketizedBufferAllocator::FreePlacedResource(
+        const Placement& placement,
+        ComPtr<ID3D12Resource> resource,
+        uint64_t resourceId)
+    {
+        PlacedHeap& placedHeap = m_placedHeaps[placement.heapIndex];
+        PlacedRange range = {placement.size, {std::move(resource), resourceId}};
+        uint64_t offset = placement.offset;
+
+        // Coalesce the range with the free ranges next to it.  The merged range is larger than the placed
+        // resources, which are released.
+        auto next = placedHeap.freeRanges.find(offset + range.size);
+        if (next != placedHeap.freeRanges.end())
+        {
+            range.size += next->second.size;
+            if (next->second.resource.resource)
+            {
+                ReleaseResourceWhenCompleted(std::move(next->second.resource.resource));
+            }
+            RemoveFreeRange(placement.heapIndex, next);
+        }
+
+        auto following = placedHeap.freeRanges.lower_bound(offset);
+        if (following != placedHeap.freeRanges.begin())
+        {
+            auto previous = std::prev(following);
+            if (previous->first + previous->second.size == offset)
+            {
+                offset = previous->first;
+                range.size += previous->second.size;
+                if (previous->second.resource.resource)
+                {
+                    ReleaseResourceWhenCompleted(std::move(previous->second.resource.resource));
+                }
+                RemoveFreeRange(placement.heapIndex, previous);
+            }
+        }
+
+        if (range.size != placement.size && range.resource.resource)
+        {
+            ReleaseResourceWhenCompleted(std::move(range.resource.resource));
+        }
+
+        InsertFreeRange(placement.heapIndex, offset, std::move(range));
+    }
+
+    void BucketizedBufferAllocator::InsertFreeRange(size_t heapIndex, uint64_t offset, PlacedRange range)
+    {
+        m_freeRangesBySize.emplace(range.size, heapIndex, offset);
+        m_placedHeaps[heapIndex].freeRanges.emplace(offset, std::move(range));
+    }
+
+    void BucketizedBufferAllocator::RemoveFreeRange(size_t heapIndex, std::map<uint64_t, PlacedRange>::iterator range)
+    {
+        m_freeRangesBySize.erase(std::make_tuple(range->second.size, heapIndex, range->first));
+        m_placedHeaps[heapIndex].freeRanges.erase(range);
+    }
+
+    void BucketizedBufferAllocator::ReleaseResourceWhenCompleted(ComPtr<ID3D12Resource> resource)
+    {
+#ifdef _GAMING_XBOX
+        m_context->QueueReference(WRAP_GRAPHICS_UNKNOWN(resource.Get()).Get());
+#else
+        m_context->QueueReference(resource.Get());
+#endif
+    }
+
     void* BucketizedBufferAllocator::Alloc(size_t size)
     {
         return Alloc(size, m_defaultRoundingMode);
@@ -91,8 +239,16 @@ namespace Dml
         uint64_t resourceId = 0;
         uint64_t bucketSize = 0;
 
+        // Sub-allocate a placed resource if the size fits in a placed heap
+        const uint64_t placementAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        const uint64_t placedSize = (size + placementAlignment - 1) & ~(placementAlignment - 1);
+        if (IsPlacementSupported(placedSize))
+        {
+            bucketSize = (roundingMode == AllocatorRoundingMode::Enabled) ? placedSize : ((size + 3) & ~3);
+            resource = AllocPlacedResource(placedSize, bucketSize, &resourceId);
+        }
         // Use a pooled resource if the size (post rounding, if requested) matches a bucket size
-        if (m_defaultRoundingMode == AllocatorRoundingMode::Enabled || size == GetBucketSizeFromIndex(GetBucketIndexFromSize(size)))
+        else if (m_defaultRoundingMode == AllocatorRoundingMode::Enabled || size == GetBucketSizeFromIndex(GetBucketIndexFromSize(size)))
         {
             Bucket* bucket = nullptr;
 
@@ -188,9 +344,17 @@ namespace Dml
             ORT_THROW_HR(E_INVALIDARG);
         }
 
-        // Free the resource to the pool if its size matches a bucket size
+        // Return placed resources to their heap
+        auto placement = m_placements.find(pooledResourceId);
         gsl::index bucketIndex = GetBucketIndexFromSize(allocInfo->GetRequestedSize());
-        if (GetBucketSizeFromIndex(bucketIndex) == allocInfo->GetResource()->GetDesc().Width)
+        if (placement != m_placements.end())
+        {
+            FreePlacedResource(placement->second, allocInfo->GetResource(), pooledResourceId);
+            m_placements.erase(placement);
+            allocInfo->DetachResource();
+        }
+        // Free the resource to the pool if its size matches a bucket size
+        else if (GetBucketSizeFromIndex(bucketIndex) == allocInfo->GetResource()->GetDesc().Width)
         {
             assert(gsl::narrow_cast<gsl::index>(m_pool.size()) > bucketIndex);
 
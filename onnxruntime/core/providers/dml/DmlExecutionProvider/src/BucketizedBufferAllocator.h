@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <set>
+#include <tuple>
+
 #include "core/framework/allocator.h"
 #include "ExecutionContext.h"
 
@@ -83,6 +86,13 @@ namespace Dml
     // maintains a set of fixed-size buckets, with each bucket containing one or more D3D12 buffers of that fixed size.
     // All requested allocation sizes are rounded up to the nearest bucket size, which ensures minimal fragmentation
     // while providing an upper bound on the amount of memory "wasted" with each allocation.
+    //
+    // For DEFAULT heaps, allocations up to the size of a placed heap are instead sub-allocated as placed resources
+    // from large heaps, using a best-fit strategy over ranges aligned to the placement alignment. The memory of a
+    // freed allocation is reused right away by the next allocation fitting in it, so buffers whose lifetimes don't
+    // overlap, as released by the execution frame following the allocation plan, alias each other. An aliasing
+    // barrier is recorded when a new placed resource overwrites the memory of previous ones. The placed resource of
+    // a freed range is kept and handed out again when the range is reused as is, avoiding resource creation.
     class BucketizedBufferAllocator : public onnxruntime::IAllocator
     {
     public:
@@ -110,6 +120,7 @@ namespace Dml
 
     private:
         static const uint32_t c_minResourceSizeExponent = 16; // 2^16 = 64KB
+        static const uint64_t c_placedHeapSize = 64ull * 1024 * 1024;
 
         // The pool consists of a number of buckets, and each bucket contains a number of resources of the same size.
         // The resources in each bucket are always sized as a power of two, and each bucket contains resources twice
@@ -125,9 +136,40 @@ namespace Dml
             std::vector<Resource> resources;
         };
 
+        // A free range of a placed heap, and the placed resource last created over it if it was not overwritten
+        // since.
+        struct PlacedRange
+        {
+            uint64_t size;
+            Resource resource;
+        };
+
+        struct PlacedHeap
+        {
+            ComPtr<ID3D12Heap> heap;
+
+            // Free ranges by offset, which are coalesced with their neighbors when freed.
+            std::map<uint64_t, PlacedRange> freeRanges;
+        };
+
+        // The location of a placed allocation, to return its range when freed.
+        struct Placement
+        {
+            size_t heapIndex;
+            uint64_t offset;
+            uint64_t size;
+        };
+
         static gsl::index GetBucketIndexFromSize(uint64_t size);
         static uint64_t GetBucketSizeFromIndex(gsl::index index);
 
+        bool IsPlacementSupported(uint64_t size) const;
+        ComPtr<ID3D12Resource> AllocPlacedResource(uint64_t size, uint64_t resourceSize, _Out_ uint64_t* resourceId);
+        void FreePlacedResource(const Placement& placement, ComPtr<ID3D12Resource> resource, uint64_t resourceId);
+        void InsertFreeRange(size_t heapIndex, uint64_t offset, PlacedRange range);
+        void RemoveFreeRange(size_t heapIndex, std::map<uint64_t, PlacedRange>::iterator range);
+        void ReleaseResourceWhenCompleted(ComPtr<ID3D12Resource> resource);
+
         AllocationInfo* DecodeDataHandleInternal(void* opaqueHandle)
         {
             // Implement in terms of const version
@@ -144,6 +186,14 @@ namespace Dml
         D3D12_RESOURCE_STATES m_initialState;
 
         std::vector<Bucket> m_pool;
+
+        std::vector<PlacedHeap> m_placedHeaps;
+
+        // Free ranges of all placed heaps ordered by size, then heap index and offset, for best-fit placement.
+        std::set<std::tuple<uint64_t, size_t, uint64_t>> m_freeRangesBySize;
+
+        // Placements of the outstanding placed allocations, by pooled resource id.
+        std::map<uint64_t, Placement> m_placements;
         size_t m_currentAllocationId = 0;
         uint64_t m_currentResourceId = 0;
         AllocatorRoundingMode m_defaultRoundingMode = AllocatorRoundingMode::Enabled;
@@ -169,16 +169,34 @@ namespace Dml
 
             if (graphDesc.reuseCommandList)
             {
-                BuildReusableCommandList();
+                m_reusableCommandLists.push_back(BuildReusableCommandList());
             }
         }
 
         onnxruntime::Status Compute(onnxruntime::OpKernelContext* kernelContext) const override
         {
-            // Only re-use the cached command list if its prior execution is complete on the GPU.
-            // This requirement can be avoided by mantaining ring buffers.
-            if (!m_graphicsCommandList || 
-                (m_fence != nullptr && m_fence->GetCompletedValue() < m_completionValue))
+            // Re-use a cached command list whose prior execution is complete on the GPU.  Command lists are
+            // used in a round-robin order, so the oldest one is the first to complete.  While all of them are
+            // still executing, another one is recorded up to kMaxReusableCommandLists.
+            ReusableCommandList* commandList = nullptr;
+            if (!m_reusableCommandLists.empty())
+            {
+                if (m_reusableCommandLists.front()->IsCompleted())
+                {
+                    std::rotate(m_reusableCommandLists.begin(), m_reusableCommandLists.begin() + 1, m_reusableCommandLists.end());
+                }
+                else if (m_reusableCommandLists.size() < kMaxReusableCommandLists)
+                {
+                    m_reusableCommandLists.push_back(BuildReusableCommandList());
+                }
+
+                if (m_reusableCommandLists.back()->IsCompleted())
+                {
+                    commandList = m_reusableCommandLists.back().get();
+                }
+            }
+
+            if (!commandList)
             {
                 // Wrap tensors as required by Dml::IExecutionProvider::ExecuteOperator
                 OpKernelContextWrapper contextWrapper(
@@ -227,7 +245,7 @@ namespace Dml
             }
             else
             {
-                ExecuteReusableCommandList(kernelContext);
+                ExecuteReusableCommandList(kernelContext, *commandList);
             }
 
             return onnxruntime::Status::OK();
@@ -297,8 +315,40 @@ namespace Dml
             }
 
     private:
-        void BuildReusableCommandList()
+        // A command list recording the execution of the graph, which is replayed while the inputs and outputs are
+        // bound to the same buffers.  Its descriptor heap holds the binding table, so descriptors are only
+        // re-written for the bindings which changed since the previous execution of the command list.
+        struct ReusableCommandList
         {
+            ComPtr<ID3D12CommandAllocator> commandAllocator;
+            ComPtr<ID3D12GraphicsCommandList> graphicsCommandList;
+            ComPtr<ID3D12DescriptorHeap> heap;
+            ComPtr<IDMLBindingTable> bindingTable;
+
+            // Bindings from previous executions of the command list
+            std::vector<uint64_t> inputBindingAllocIds;
+            std::vector<uint64_t> outputBindingAllocIds;
+            uint64_t tempBindingAllocId = 0;
+
+            // Fence tracking the status of the command list's last execution, and whether its descriptor heap 
+            // can safely be updated.
+            ComPtr<ID3D12Fence> fence;
+            uint64_t completionValue = 0;
+
+            bool IsCompleted() const
+            {
+                return fence == nullptr || fence->GetCompletedValue() >= completionValue;
+            }
+        };
+
+        // Number of command lists which may be in flight for the kernel.  The graph partitions have static shapes,
+        // so a command list is valid for any execution and only its bindings need to be updated.
+        static constexpr size_t kMaxReusableCommandLists = 3;
+
+        std::unique_ptr<ReusableCommandList> BuildReusableCommandList() const
+        {
+            auto commandList = std::make_unique<ReusableCommandList>();
+
             ComPtr<IDMLDevice> device;
             ORT_THROW_IF_FAILED(m_provider->GetDmlDevice(device.GetAddressOf()));
 
@@ -312,51 +362,53 @@ namespace Dml
             ComPtr<ID3D12Device> d3dDevice;
             ORT_THROW_IF_FAILED(m_provider->GetD3DDevice(d3dDevice.GetAddressOf()));
 
-            ORT_THROW_IF_FAILED(d3dDevice->CreateDescriptorHeap(&desc, IID_GRAPHICS_PPV_ARGS(m_heap.ReleaseAndGetAddressOf())));
+            ORT_THROW_IF_FAILED(d3dDevice->CreateDescriptorHeap(&desc, IID_GRAPHICS_PPV_ARGS(commandList->heap.ReleaseAndGetAddressOf())));
 
             // Create a binding table for execution.
             DML_BINDING_TABLE_DESC bindingTableDesc = {};
             bindingTableDesc.Dispatchable = m_compiledExecutionPlanOperator.Get();
-            bindingTableDesc.CPUDescriptorHandle = m_heap->GetCPUDescriptorHandleForHeapStart();
-            bindingTableDesc.GPUDescriptorHandle = m_heap->GetGPUDescriptorHandleForHeapStart();
+            bindingTableDesc.CPUDescriptorHandle = commandList->heap->GetCPUDescriptorHandleForHeapStart();
+            bindingTableDesc.GPUDescriptorHandle = commandList->heap->GetGPUDescriptorHandleForHeapStart();
             bindingTableDesc.SizeInDescriptors = execBindingProps.RequiredDescriptorCount;
 
-            ORT_THROW_IF_FAILED(device->CreateBindingTable(&bindingTableDesc, IID_PPV_ARGS(&m_bindingTable)));
+            ORT_THROW_IF_FAILED(device->CreateBindingTable(&bindingTableDesc, IID_PPV_ARGS(&commandList->bindingTable)));
 
-            ComPtr<ID3D12CommandAllocator> allocator;
+            // The allocator backs the recorded commands, so it is kept alive for as long as the command list.
             ORT_THROW_IF_FAILED(d3dDevice->CreateCommandAllocator(
                 m_provider->GetCommandListTypeForQueue(),
-                IID_GRAPHICS_PPV_ARGS(allocator.ReleaseAndGetAddressOf())));
+                IID_GRAPHICS_PPV_ARGS(commandList->commandAllocator.ReleaseAndGetAddressOf())));
 
-            ComPtr<ID3D12CommandList> commandList;
+            ComPtr<ID3D12CommandList> d3dCommandList;
             ORT_THROW_IF_FAILED(d3dDevice->CreateCommandList(
                 0,
                 m_provider->GetCommandListTypeForQueue(),
-                allocator.Get(),
+                commandList->commandAllocator.Get(),
                 nullptr,
-                IID_GRAPHICS_PPV_ARGS(commandList.ReleaseAndGetAddressOf())));
+                IID_GRAPHICS_PPV_ARGS(d3dCommandList.ReleaseAndGetAddressOf())));
             
-            ORT_THROW_IF_FAILED(commandList.As(&m_graphicsCommandList));
+            ORT_THROW_IF_FAILED(d3dCommandList.As(&commandList->graphicsCommandList));
 
             if (m_persistentResource)
             {
                 DML_BINDING_DESC persistentResourceBindingDesc =
                     { DML_BINDING_TYPE_BUFFER, m_persistentResourceBinding ? &*m_persistentResourceBinding : nullptr };
-                m_bindingTable->BindPersistentResource(&persistentResourceBindingDesc);
+                commandList->bindingTable->BindPersistentResource(&persistentResourceBindingDesc);
             }
 
-            ID3D12DescriptorHeap* descriptorHeaps[] = { m_heap.Get() };
-            m_graphicsCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
+            ID3D12DescriptorHeap* descriptorHeaps[] = { commandList->heap.Get() };
+            commandList->graphicsCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
 
             ComPtr<IDMLCommandRecorder> recorder;
             ORT_THROW_IF_FAILED(device->CreateCommandRecorder(IID_PPV_ARGS(recorder.GetAddressOf())));
 
-            recorder->RecordDispatch(commandList.Get(), m_compiledExecutionPlanOperator.Get(), m_bindingTable.Get());
+            recorder->RecordDispatch(d3dCommandList.Get(), m_compiledExecutionPlanOperator.Get(), commandList->bindingTable.Get());
 
-            ORT_THROW_IF_FAILED(m_graphicsCommandList->Close());
+            ORT_THROW_IF_FAILED(commandList->graphicsCommandList->Close());
+
+            return commandList;
         }
 
-        void ExecuteReusableCommandList(onnxruntime::OpKernelContext* kernelContext) const
+        void ExecuteReusableCommandList(onnxruntime::OpKernelContext* kernelContext, ReusableCommandList& commandList) const
         {
             DML_BINDING_PROPERTIES execBindingProps = m_compiledExecutionPlanOperator->GetBindingProperties();
                 
@@ -371,7 +423,7 @@ namespace Dml
 
             // Populate input bindings, excluding those which were specified as owned by DML and provided 
             // at initialization instead.
-            m_inputBindingAllocIds.resize(inputBindings.size());
+            commandList.inputBindingAllocIds.resize(inputBindings.size());
             bool inputBindingsChanged = false;
 
             for (uint32_t i = 0; i < inputBindings.size(); ++i)
@@ -390,25 +442,25 @@ namespace Dml
 
                         uint64_t allocId;
                         GraphKernelHelper::UnwrapTensor(m_winmlProvider.Get(), tensor, &inputBindings[i].Buffer, &allocId);
-                        inputBindingsChanged = inputBindingsChanged || (!allocId || m_inputBindingAllocIds[i] != allocId);
+                        inputBindingsChanged = inputBindingsChanged || (!allocId || commandList.inputBindingAllocIds[i] != allocId);
                         inputBindings[i].Buffer->Release(); // Avoid holding an additional reference
                         inputBindings[i].SizeInBytes = GraphKernelHelper::AlignToPow2<size_t>(tensor->SizeInBytes(), 4);
                         inputBindingDescs[i] = {DML_BINDING_TYPE_BUFFER, &inputBindings[i]};
-                        m_inputBindingAllocIds[i] = allocId;
+                        commandList.inputBindingAllocIds[i] = allocId;
                     }
                 }
             }
                 
             if (inputBindingsChanged)
             {
-                m_bindingTable->BindInputs(gsl::narrow_cast<uint32_t>(inputBindingDescs.size()), inputBindingDescs.data());
+                commandList.bindingTable->BindInputs(gsl::narrow_cast<uint32_t>(inputBindingDescs.size()), inputBindingDescs.data());
             }
 
             // Populate Output bindings
             std::vector<DML_BUFFER_BINDING> outputBindings(kernelContext->OutputCount());
             std::vector<DML_BINDING_DESC> outputBindingDescs(kernelContext->OutputCount());
 
-            m_outputBindingAllocIds.resize(outputBindings.size());
+            commandList.outputBindingAllocIds.resize(outputBindings.size());
             bool outputBindingsChanged = false;
             
             for (uint32_t i = 0; i < outputBindings.size(); ++i)
@@ -427,16 +479,16 @@ namespace Dml
 
                 uint64_t allocId;
                 GraphKernelHelper::UnwrapTensor(m_winmlProvider.Get(), tensor, &outputBindings[i].Buffer, &allocId);
-                outputBindingsChanged = outputBindingsChanged || (!allocId || m_outputBindingAllocIds[i] != allocId);
+                outputBindingsChanged = outputBindingsChanged || (!allocId || commandList.outputBindingAllocIds[i] != allocId);
                 outputBindings[i].Buffer->Release(); // Avoid holding an additional reference
                 outputBindings[i].SizeInBytes = GraphKernelHelper::AlignToPow2<size_t>(tensor->SizeInBytes(), 4);
                 outputBindingDescs[i] = {DML_BINDING_TYPE_BUFFER, &outputBindings[i]};
-                m_outputBindingAllocIds[i] = allocId;
+                commandList.outputBindingAllocIds[i] = allocId;
             }
 
             if (outputBindingsChanged)
             {
-                m_bindingTable->BindOutputs(gsl::narrow_cast<uint32_t>(outputBindingDescs.size()), outputBindingDescs.data());
+                commandList.bindingTable->BindOutputs(gsl::narrow_cast<uint32_t>(outputBindingDescs.size()), outputBindingDescs.data());
             }
 
             if (execBindingProps.TemporaryResourceSize > 0)
@@ -456,26 +508,26 @@ namespace Dml
                 DML_BUFFER_BINDING tempBufferBinding = {tempResource.Get(), 0, execBindingProps.TemporaryResourceSize};
                 DML_BINDING_DESC tempBindingDesc = { DML_BINDING_TYPE_BUFFER, &tempBufferBinding };
 
-                if (!tempAllocId || m_tempBindingAllocId != tempAllocId)
+                if (!tempAllocId || commandList.tempBindingAllocId != tempAllocId)
                 {
-                    m_bindingTable->BindTemporaryResource(&tempBindingDesc);
+                    commandList.bindingTable->BindTemporaryResource(&tempBindingDesc);
                 }
             
-                m_tempBindingAllocId = tempAllocId;
+                commandList.tempBindingAllocId = tempAllocId;
             }
 
             // Execute the command list and if it succeeds, update the fence value at which this command may be
             // re-used.
             ComPtr<ID3D12Fence> fence;
             uint64_t completionValue;
-            ORT_THROW_IF_FAILED(m_provider->ExecuteCommandList(m_graphicsCommandList.Get(), fence.GetAddressOf(), &completionValue));
-            m_fence = fence;
-            m_completionValue = completionValue;
+            ORT_THROW_IF_FAILED(m_provider->ExecuteCommandList(commandList.graphicsCommandList.Get(), fence.GetAddressOf(), &completionValue));
+            commandList.fence = fence;
+            commandList.completionValue = completionValue;
 
             // Queue references to objects which must be kept alive until resulting GPU work completes
-            m_winmlProvider->QueueReference(WRAP_GRAPHICS_UNKNOWN(m_graphicsCommandList).Get());
-            m_winmlProvider->QueueReference(WRAP_GRAPHICS_UNKNOWN(m_heap).Get());
-            m_winmlProvider->QueueReference(m_bindingTable.Get());
+            m_winmlProvider->QueueReference(WRAP_GRAPHICS_UNKNOWN(commandList.graphicsCommandList).Get());
+            m_winmlProvider->QueueReference(WRAP_GRAPHICS_UNKNOWN(commandList.heap).Get());
+            m_winmlProvider->QueueReference(commandList.bindingTable.Get());
             m_winmlProvider->QueueReference(m_persistentResourceAllocatorUnk.Get());
         }
 
@@ -486,23 +538,12 @@ namespace Dml
         ComPtr<Dml::IExecutionProvider> m_provider;
         Windows::AI::MachineLearning::Adapter::EdgeShapes m_outputShapes;
 
-        // Re-usable command list, supporting descriptor heap, and DML binding table to update that heap.
-        ComPtr<ID3D12GraphicsCommandList> m_graphicsCommandList;
-        ComPtr<ID3D12DescriptorHeap> m_heap;
-        ComPtr<IDMLBindingTable> m_bindingTable;
+        // Re-usable command lists, in the order of their last execution.
+        mutable std::vector<std::unique_ptr<ReusableCommandList>> m_reusableCommandLists;
+
         std::optional<DML_BUFFER_BINDING> m_persistentResourceBinding;
         ComPtr<ID3D12Resource> m_persistentResource;
         ComPtr<IUnknown> m_persistentResourceAllocatorUnk; // Controls when the persistent resource is returned to the allocator
-        
-        // Bindings from previous executions of a re-used command list
-        mutable std::vector<uint64_t> m_inputBindingAllocIds;
-        mutable std::vector<uint64_t> m_outputBindingAllocIds;
-        mutable uint64_t m_tempBindingAllocId = 0;
-
-        // Fence tracking the status of the command list's last execution, and whether its descriptor heap 
-        // can safely be updated.
-        mutable ComPtr<ID3D12Fence> m_fence;
-        mutable uint64_t m_completionValue = 0;
 
         std::vector<uint8_t> m_inputsConstant;
         std::vector<ComPtr<ID3D12Resource>> m_nonOwnedGraphInputsFromInitializers;
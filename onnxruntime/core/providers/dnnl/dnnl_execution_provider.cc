@@ -56,6 +56,11 @@ DNNLExecutionProvider::DNNLExecutionProvider(const DNNLExecutionProviderInfo& in
   if (!fusion_env.empty()) {
     enable_fusion_ = (std::stoi(fusion_env) == 0 ? false : true);
   }
+
+  const std::string primitive_cache_capacity_env = onnxruntime::GetEnvironmentVar("ORT_DNNL_PRIMITIVE_CACHE_CAPACITY");
+  if (!primitive_cache_capacity_env.empty()) {
+    primitive_cache_capacity_ = static_cast<size_t>(std::max(0, std::stoi(primitive_cache_capacity_env)));
+  }
 }  // namespace onnxruntime
 
 DNNLExecutionProvider::~DNNLExecutionProvider() {
@@ -279,6 +284,7 @@ Status DNNLExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
 
     //subgraph primitive
     auto dnnl_subgraph_primitive = std::make_unique<ort_dnnl::DnnlSubgraphPrimitive>(*subgraphs_[fused_node.Name()].get());
+    dnnl_subgraph_primitive->SetPrimitiveCacheCapacity(primitive_cache_capacity_);
     {
       const auto& input_defs = fused_node.InputDefs();
       std::vector<std::string> onnx_input_names(input_defs.size());
@@ -48,6 +48,8 @@ class DNNLExecutionProvider : public IExecutionProvider {
   bool debug_log_ = false;
   //enable fusion by default
   bool enable_fusion_ = true;
+  // number of input shapes whose primitives are cached per dynamic subgraph, besides the current ones
+  size_t primitive_cache_capacity_ = 16;
 };
 
 }  // namespace onnxruntime
@@ -271,9 +271,15 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
     key += "|";
   }
   // if key different from shape key, update and recompile
-  if (key != shape_key_) {
-    shape_key_ = key;
-  } else {
+  if (key == shape_key_) {
+    return;
+  }
+  if (!shape_key_.empty()) {
+    StashCompiledPrimitive();
+  }
+  shape_key_ = key;
+  if (RestoreCompiledPrimitive(key)) {
+    LOGS_DEFAULT(INFO) << "Reuse Cached Compile";
     return;
   }
   if (IsDynamic()) {
@@ -292,7 +298,10 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   net_args_.clear();
   reshapes_.clear();
   scalar_outputs_.clear();
-  //initializer should not be cleared upon recompile
+  input_is_scalar_.clear();
+  items_to_print_.clear();
+  //initializer should not be cleared upon recompile, so that the initializers reordered to the formats chosen by
+  //the primitives of an input shape are reused by the primitives of the other shapes
   //initializers_.clear();
 
   for (auto nodearg : subgraph_->GetDnnlInputs()) {
@@ -316,6 +325,63 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   AddOutputs();
 }
 
+void DnnlSubgraphPrimitive::SetPrimitiveCacheCapacity(size_t capacity) {
+  primitive_cache_capacity_ = capacity;
+}
+
+void DnnlSubgraphPrimitive::StashCompiledPrimitive() {
+  if (primitive_cache_capacity_ == 0) {
+    return;
+  }
+
+  CompiledPrimitive compiled;
+  compiled.intermediates = std::move(intermediates_);
+  compiled.inputs = std::move(inputs_);
+  compiled.inputs_md = std::move(inputs_md_);
+  compiled.input_is_scalar = std::move(input_is_scalar_);
+  compiled.outputs = std::move(outputs_);
+  compiled.outputs_md = std::move(outputs_md_);
+  compiled.outputs_are_always_copied = std::move(outputs_are_always_copied_);
+  compiled.net = std::move(net_);
+  compiled.net_args = std::move(net_args_);
+  compiled.reshapes = std::move(reshapes_);
+  compiled.scalar_outputs = std::move(scalar_outputs_);
+  compiled.items_to_print = std::move(items_to_print_);
+
+  primitive_cache_.emplace_front(shape_key_, std::move(compiled));
+  primitive_cache_index_[shape_key_] = primitive_cache_.begin();
+
+  while (primitive_cache_.size() > primitive_cache_capacity_) {
+    primitive_cache_index_.erase(primitive_cache_.back().first);
+    primitive_cache_.pop_back();
+  }
+}
+
+bool DnnlSubgraphPrimitive::RestoreCompiledPrimitive(const std::string& key) {
+  auto it = primitive_cache_index_.find(key);
+  if (it == primitive_cache_index_.end()) {
+    return false;
+  }
+
+  CompiledPrimitive& compiled = it->second->second;
+  intermediates_ = std::move(compiled.intermediates);
+  inputs_ = std::move(compiled.inputs);
+  inputs_md_ = std::move(compiled.inputs_md);
+  input_is_scalar_ = std::move(compiled.input_is_scalar);
+  outputs_ = std::move(compiled.outputs);
+  outputs_md_ = std::move(compiled.outputs_md);
+  outputs_are_always_copied_ = std::move(compiled.outputs_are_always_copied);
+  net_ = std::move(compiled.net);
+  net_args_ = std::move(compiled.net_args);
+  reshapes_ = std::move(compiled.reshapes);
+  scalar_outputs_ = std::move(compiled.scalar_outputs);
+  items_to_print_ = std::move(compiled.items_to_print);
+
+  primitive_cache_.erase(it->second);
+  primitive_cache_index_.erase(it);
+  return true;
+}
+
 dnnl::memory::format_tag DnnlSubgraphPrimitive::GetDnnlFormat(size_t dim_size) {
   dnnl::memory::format_tag source_format = dnnl::memory::format_tag::any;
   switch (dim_size) {
@@ -2,6 +2,7 @@
 // Licensed under the MIT License
 
 #pragma once
+#include <list>
 #include "dnnl_subgraph.h"
 #include "dnnl.hpp"
 #include "core/platform/ort_mutex.h"
@@ -26,7 +27,11 @@ class DnnlSubgraphPrimitive {
   ~DnnlSubgraphPrimitive() = default;
 
   //compile subgraph primitive with runtime input information
+  //for dynamic subgraphs, the primitives compiled for the most recently used input shapes are kept in a LRU cache,
+  //so switching back to one of these shapes doesn't recreate the primitives
   void Compile(const std::unordered_map<std::string, OnnxTensorData>& inputs);
+  //set the number of input shapes whose primitives are kept besides the current ones, 0 disables the cache
+  void SetPrimitiveCacheCapacity(size_t capacity);
   void AddInitializers();
   void AddOutputs();
   void AddKernels();
@@ -77,8 +82,34 @@ class DnnlSubgraphPrimitive {
   bool IsMemoryInExpectedOrtFormat(const dnnl::memory::desc& desc) const;
 
  private:
+  //the primitives and memories compiled for an input shape
+  struct CompiledPrimitive {
+    std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates;
+    std::unordered_map<std::string, dnnl::memory> inputs;
+    std::unordered_map<std::string, dnnl::memory::desc> inputs_md;
+    std::unordered_set<std::string> input_is_scalar;
+    std::unordered_map<std::string, dnnl::memory> outputs;
+    std::unordered_map<std::string, dnnl::memory::desc> outputs_md;
+    std::unordered_set<std::string> outputs_are_always_copied;
+    std::vector<dnnl::primitive> net;
+    std::vector<std::unordered_map<int, dnnl::memory>> net_args;
+    std::vector<std::pair<dnnl::memory, dnnl::memory>> reshapes;
+    std::unordered_set<std::string> scalar_outputs;
+    std::vector<std::pair<int, int>> items_to_print;
+  };
+
+  //move the current primitives to the cache under shape_key_, evicting the least recently used ones
+  void StashCompiledPrimitive();
+  //restore the primitives cached for key, returns false if there are none
+  bool RestoreCompiledPrimitive(const std::string& key);
+
   std::string shape_key_;
 
+  //most recently used first
+  std::list<std::pair<std::string, CompiledPrimitive>> primitive_cache_;
+  std::unordered_map<std::string, std::list<std::pair<std::string, CompiledPrimitive>>::iterator> primitive_cache_index_;
+  size_t primitive_cache_capacity_ = 16;
+
   std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates_;
 
   std::unordered_map<std::string, dnnl::memory> inputs_;
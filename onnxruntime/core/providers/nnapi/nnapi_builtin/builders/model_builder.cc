@@ -6,6 +6,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/safeint.h"
 #include "core/common/status.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/providers/common.h"
@@ -38,6 +39,7 @@ int32_t ModelBuilder::GetNNAPIFeatureLevel() const {
         nnapi_->ANeuralNetworksModel_setOperandValue(                             \
             nnapi_model_->model_, index, &value, sizeof(value)),                  \
         "value: " + std::to_string(value));                                       \
+    AddOperandValueToModelFingerprint(index, &value, sizeof(value));              \
     return Status::OK();                                                          \
   }
 
@@ -411,6 +413,7 @@ Status ModelBuilder::AddNewNNAPIOperand(const OperandType& operand_type, uint32_
   RETURN_STATUS_ON_ERROR(
       nnapi_->ANeuralNetworksModel_addOperand(nnapi_model_->model_, &operand_type.operandType));
   index = next_index_++;
+  AddOperandTypeToModelFingerprint(operand_type);
 
   if (operand_type.channelQuant) {
     if (GetNNAPIFeatureLevel() < ANEURALNETWORKS_FEATURE_LEVEL_3) {
@@ -450,9 +453,47 @@ Status ModelBuilder::SetOperandValue(uint32_t index,
           size));
 #endif
 
+  AddOperandValueToModelFingerprint(index, memory->GetDataPtr() + offset, size);
   return Status::OK();
 }
 
+void ModelBuilder::AddToModelFingerprint(const void* data, size_t size) {
+  model_fingerprint_.append(static_cast<const char*>(data), size);
+}
+
+void ModelBuilder::AddOperandValueToModelFingerprint(uint32_t index, const void* buffer, size_t size) {
+  // The initializers can be large, only their hashes are kept
+  uint32_t hash[4];
+  MurmurHash3::x86_128(buffer, SafeInt<int>(size), index, hash);
+  AddToModelFingerprint(&index, sizeof(index));
+  AddToModelFingerprint(&size, sizeof(size));
+  AddToModelFingerprint(hash, sizeof(hash));
+}
+
+void ModelBuilder::AddOperandTypeToModelFingerprint(const OperandType& operand_type) {
+  const auto& nnapi_type = operand_type.operandType;
+  AddToModelFingerprint(&nnapi_type.type, sizeof(nnapi_type.type));
+  AddToModelFingerprint(&nnapi_type.scale, sizeof(nnapi_type.scale));
+  AddToModelFingerprint(&nnapi_type.zeroPoint, sizeof(nnapi_type.zeroPoint));
+  const uint32_t rank = static_cast<uint32_t>(operand_type.dimensions.size());
+  AddToModelFingerprint(&rank, sizeof(rank));
+  AddToModelFingerprint(operand_type.dimensions.data(), rank * sizeof(uint32_t));
+  if (operand_type.channelQuant) {
+    const auto& channel_quant = *operand_type.channelQuant;
+    AddToModelFingerprint(&channel_quant.params.channelDim, sizeof(channel_quant.params.channelDim));
+    AddToModelFingerprint(channel_quant.scales.data(), channel_quant.scales.size() * sizeof(float));
+  }
+}
+
+std::vector<uint8_t> ModelBuilder::GetCompilationCacheToken() const {
+  // The token is ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN (32) bytes, made of two 128-bit hashes
+  std::vector<uint8_t> token(32);
+  const int size = SafeInt<int>(model_fingerprint_.size());
+  MurmurHash3::x86_128(model_fingerprint_.data(), size, 0, token.data());
+  MurmurHash3::x86_128(model_fingerprint_.data(), size, 1, token.data() + 16);
+  return token;
+}
+
 Status ModelBuilder::AddOperandFromPersistMemoryBuffer(
     const std::string& name, const void* buffer,
     const android::nn::wrapper::OperandType& operand_type) {
@@ -468,6 +509,7 @@ Status ModelBuilder::AddOperandFromPersistMemoryBuffer(
         nnapi_->ANeuralNetworksModel_setOperandValue(
             nnapi_model_->model_, index,
             buffer, size));
+    AddOperandValueToModelFingerprint(index, buffer, size);
   } else {
     const size_t padded_size = GetPaddedByteSize(size);
     auto persist_buffer = std::make_unique<Model::NNMemory>(nnapi_, name.c_str(), padded_size);
@@ -534,6 +576,10 @@ Status ModelBuilder::AddOperation(int op, const std::vector<uint32_t>& input_ind
           static_cast<uint32_t>(output_indices.size()), &output_indices[0]),
       "op = " + std::to_string(op));
 
+  AddToModelFingerprint(&op, sizeof(op));
+  AddToModelFingerprint(input_indices.data(), input_indices.size() * sizeof(uint32_t));
+  AddToModelFingerprint(output_indices.data(), output_indices.size() * sizeof(uint32_t));
+
   num_nnapi_ops_++;
 
   LOGS_DEFAULT(VERBOSE) << "Added NNAPI Operation Type [" << op << "]";
@@ -611,6 +657,23 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model) {
           nnapi_model_->compilation_, static_cast<int32_t>(exe_pref_)),
       "on setPreference");
 
+  // compilation caching is only available on API 29+
+  if (!compilation_cache_dir_.empty() && GetNNAPIFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_3 &&
+      nnapi_->ANeuralNetworksCompilation_setCaching) {
+    // The compiled model depends on the model inputs and outputs, the options and the target devices as well
+    AddToModelFingerprint(input_index_vec_.data(), input_index_vec_.size() * sizeof(uint32_t));
+    AddToModelFingerprint(output_index_vec_.data(), output_index_vec_.size() * sizeof(uint32_t));
+    AddToModelFingerprint(&use_fp16_, sizeof(use_fp16_));
+    AddToModelFingerprint(&exe_pref_, sizeof(exe_pref_));
+    AddToModelFingerprint(&target_device_option_, sizeof(target_device_option_));
+    AddToModelFingerprint(nnapi_target_devices_detail_.data(), nnapi_target_devices_detail_.size());
+    const auto token = GetCompilationCacheToken();
+    RETURN_STATUS_ON_ERROR_WITH_NOTE(
+        nnapi_->ANeuralNetworksCompilation_setCaching(
+            nnapi_model_->compilation_, compilation_cache_dir_.c_str(), token.data()),
+        "on setCaching");
+  }
+
   RETURN_STATUS_ON_ERROR_WITH_NOTE(
       nnapi_->ANeuralNetworksCompilation_finish(nnapi_model_->compilation_),
       "on compilation finish");
@@ -92,6 +92,10 @@ class ModelBuilder {
   void ExecutePreference(
       android::nn::wrapper::ExecutePreference pref) { exe_pref_ = pref; }
 
+  // Set the directory for NNAPI to cache the compiled model in, see ANeuralNetworksCompilation_setCaching
+  // The compilation caching is only available on API 29+, and is disabled if the directory is empty
+  void SetCompilationCacheDir(const std::string& cache_dir) { compilation_cache_dir_ = cache_dir; }
+
   // Accessors for members
   Shaper& GetShaper() { return shaper_; }
 
@@ -155,6 +159,11 @@ class ModelBuilder {
   std::unordered_set<std::string> unique_names_;
 
   TargetDeviceOption target_device_option_{TargetDeviceOption::ALL_DEVICES};
+  std::string compilation_cache_dir_;
+
+  // Everything describing the NNAPI model, the operand types, the hashes of the operand values and the operations,
+  // which is hashed to the token identifying the compiled model in the compilation cache
+  std::string model_fingerprint_;
   std::vector<ANeuralNetworksDevice*> nnapi_target_devices_;
   std::string nnapi_target_devices_detail_;  // Debug info for target devices
 
@@ -189,6 +198,14 @@ class ModelBuilder {
   common::Status SetOperandValue(uint32_t index, Model::NNMemory* memory, size_t size, size_t offset);
 
   common::Status AddNewNNAPIOperand(const android::nn::wrapper::OperandType& type, uint32_t& index);
+
+  // Add the given data to the model fingerprint, an operand value is added as its hash
+  void AddToModelFingerprint(const void* data, size_t size);
+  void AddOperandValueToModelFingerprint(uint32_t index, const void* buffer, size_t size);
+  void AddOperandTypeToModelFingerprint(const android::nn::wrapper::OperandType& operand_type);
+
+  // Get the token of the compiled model for ANeuralNetworksCompilation_setCaching
+  std::vector<uint8_t> GetCompilationCacheToken() const;
   common::Status AddNewOperand(const std::string& name,
                                const android::nn::wrapper::OperandType& operand_type,
                                uint32_t& index);
@@ -154,6 +154,9 @@ Execution::Execution(ANeuralNetworksExecution& execution, const Shaper& shaper)
 
 Execution::~Execution() {
   nnapi_->ANeuralNetworksExecution_free(execution_);
+  for (auto* memory : hardware_buffer_memories_) {
+    nnapi_->ANeuralNetworksMemory_free(memory);
+  }
 }
 
 Status Execution::SetInputBuffers(const std::vector<InputBuffer>& inputs) {
@@ -175,7 +178,30 @@ Status Execution::SetOutputBuffers(const std::vector<OutputBuffer>& outputs) {
   return Status::OK();
 }
 
+Status Execution::GetBoundMemory(ANeuralNetworksMemory* memory, const AHardwareBuffer* hardware_buffer,
+                                 ANeuralNetworksMemory*& bound_memory) {
+  bound_memory = memory;
+  if (hardware_buffer != nullptr) {
+    ORT_RETURN_IF_NOT(nnapi_->ANeuralNetworksMemory_createFromAHardwareBuffer,
+                      "Binding an AHardwareBuffer requires Android API level 29+");
+    RETURN_STATUS_ON_ERROR_WITH_NOTE(
+        nnapi_->ANeuralNetworksMemory_createFromAHardwareBuffer(hardware_buffer, &bound_memory),
+        "on createFromAHardwareBuffer");
+    hardware_buffer_memories_.push_back(bound_memory);
+  }
+
+  return Status::OK();
+}
+
 Status Execution::SetInputBuffer(const int32_t index, const InputBuffer& input) {
+  ANeuralNetworksMemory* memory = nullptr;
+  ORT_RETURN_IF_ERROR(GetBoundMemory(input.memory, input.hardware_buffer, memory));
+  if (memory != nullptr) {
+    RETURN_STATUS_ON_ERROR(nnapi_->ANeuralNetworksExecution_setInputFromMemory(
+        execution_, index, &input.type.operandType, memory, 0, input.type.GetOperandBlobByteSize()));
+    return Status::OK();
+  }
+
   RETURN_STATUS_ON_ERROR(nnapi_->ANeuralNetworksExecution_setInput(
       execution_, index, &input.type.operandType, input.buffer, input.type.GetOperandBlobByteSize()));
 
@@ -186,6 +212,14 @@ Status Execution::SetOutputBuffer(const int32_t index, const OutputBuffer& outpu
   LOGS_DEFAULT(VERBOSE) << "Model::SetOutputBuffer, output shape "
                         << Shape2String(output.type.dimensions);
 
+  ANeuralNetworksMemory* memory = nullptr;
+  ORT_RETURN_IF_ERROR(GetBoundMemory(output.memory, output.hardware_buffer, memory));
+  if (memory != nullptr) {
+    RETURN_STATUS_ON_ERROR(nnapi_->ANeuralNetworksExecution_setOutputFromMemory(
+        execution_, index, &output.type.operandType, memory, 0, output.buffer_byte_size));
+    return Status::OK();
+  }
+
   RETURN_STATUS_ON_ERROR(nnapi_->ANeuralNetworksExecution_setOutput(
       execution_, index, &output.type.operandType, output.buffer, output.buffer_byte_size));
 
@@ -152,16 +152,22 @@ class Model {
 
 class Execution {
  public:
+  // An input or output can be bound to an ANeuralNetworksMemory or an AHardwareBuffer instead of a buffer,
+  // see NNAPI_MEMORY and NNAPI_HARDWARE_BUFFER in core/framework/allocator.h
   struct InputBuffer {
     const std::string& name;
     const void* buffer{nullptr};
     android::nn::wrapper::OperandType type;
+    ANeuralNetworksMemory* memory{nullptr};
+    const AHardwareBuffer* hardware_buffer{nullptr};
   };
 
   struct OutputBuffer {
     void* buffer{nullptr};
     android::nn::wrapper::OperandType type;
     size_t buffer_byte_size;
+    ANeuralNetworksMemory* memory{nullptr};
+    const AHardwareBuffer* hardware_buffer{nullptr};
   };
 
  public:
@@ -185,9 +191,16 @@ class Execution {
   common::Status SetInputBuffer(const int32_t index, const InputBuffer& input);
   common::Status SetOutputBuffer(const int32_t index, const OutputBuffer& output);
 
+  // Get the memory of the bound input or output, the memory of an AHardwareBuffer is created for this execution
+  common::Status GetBoundMemory(ANeuralNetworksMemory* memory, const AHardwareBuffer* hardware_buffer,
+                                ANeuralNetworksMemory*& bound_memory);
+
   const NnApi* nnapi_{nullptr};
   ANeuralNetworksExecution* execution_;
   Shaper shaper_;
+
+  // The memories created from the bound AHardwareBuffer(s), freed with the execution
+  std::vector<ANeuralNetworksMemory*> hardware_buffer_memories_;
 };
 
 }  // namespace nnapi
@@ -47,10 +47,12 @@ std::unordered_set<std::string> GetPartitioningStopOps(const optional<std::strin
 }  // namespace
 
 NnapiExecutionProvider::NnapiExecutionProvider(uint32_t nnapi_flags,
-                                               const optional<std::string>& partitioning_stop_ops_list)
+                                               const optional<std::string>& partitioning_stop_ops_list,
+                                               const optional<std::string>& compilation_cache_dir)
     : IExecutionProvider{onnxruntime::kNnapiExecutionProvider, true},
       nnapi_flags_(nnapi_flags),
-      partitioning_stop_ops_(GetPartitioningStopOps(partitioning_stop_ops_list)) {
+      partitioning_stop_ops_(GetPartitioningStopOps(partitioning_stop_ops_list)),
+      compilation_cache_dir_(compilation_cache_dir.value_or("")) {
   AllocatorCreationInfo device_info(
       [](int) {
         return std::make_unique<CPUAllocator>(OrtMemoryInfo(NNAPI, OrtAllocatorType::OrtDeviceAllocator));
@@ -203,6 +205,18 @@ DataLayout NnapiExecutionProvider::GetPreferredLayout() const {
   return nnapi_flags_ & NNAPI_FLAG_USE_NCHW ? DataLayout::NCHW : DataLayout::NHWC;
 }
 
+// Get the ANeuralNetworksMemory or the AHardwareBuffer the tensor is bound to, if any
+// The data of the tensor is the memory/buffer handle for these, see NNAPI_MEMORY and NNAPI_HARDWARE_BUFFER
+static void GetBoundMemory(Ort::CustomOpApi& ort, const OrtValue* tensor, const void* tensor_data,
+                           ANeuralNetworksMemory*& memory, const AHardwareBuffer*& hardware_buffer) {
+  const auto* memory_info = ort.GetTensorMemoryInfo(tensor);
+  if (strcmp(memory_info->name, NNAPI_MEMORY) == 0) {
+    memory = static_cast<ANeuralNetworksMemory*>(const_cast<void*>(tensor_data));
+  } else if (strcmp(memory_info->name, NNAPI_HARDWARE_BUFFER) == 0) {
+    hardware_buffer = static_cast<const AHardwareBuffer*>(tensor_data);
+  }
+}
+
 #ifdef __ANDROID__
 static Status GetOutputBuffer(Ort::CustomOpApi& ort,
                               OrtKernelContext* context,
@@ -210,7 +224,8 @@ static Status GetOutputBuffer(Ort::CustomOpApi& ort,
                               const std::string& output_name,
                               const std::vector<uint32_t>& output_shape,
                               const android::nn::wrapper::Type output_type,
-                              void** output_buffer) {
+                              void** output_buffer,
+                              OrtValue** output_value = nullptr) {
   using namespace android::nn::wrapper;
   std::vector<int64_t> int64_output_shape(output_shape.begin(),
                                           output_shape.end());
@@ -234,6 +249,10 @@ static Status GetOutputBuffer(Ort::CustomOpApi& ort,
       break;
   }
 
+  if (output_value) {
+    *output_value = output_tensor;
+  }
+
   return Status::OK();
 }
 #endif  // __ANDROID__
@@ -248,6 +267,7 @@ common::Status NnapiExecutionProvider::Compile(const std::vector<FusedNodeAndGra
     nnapi::ModelBuilder builder(graph_viewer);
     builder.SetUseNCHW(nnapi_flags_ & NNAPI_FLAG_USE_NCHW);
     builder.SetUseFp16(nnapi_flags_ & NNAPI_FLAG_USE_FP16);
+    builder.SetCompilationCacheDir(compilation_cache_dir_);
 
     bool cpu_disabled = nnapi_flags_ & NNAPI_FLAG_CPU_DISABLED;
     bool cpu_only = nnapi_flags_ & NNAPI_FLAG_CPU_ONLY;
@@ -348,7 +368,10 @@ common::Status NnapiExecutionProvider::Compile(const std::vector<FusedNodeAndGra
         }
 
         const void* inputBuffer = ort.GetTensorData<void>(input_tensor);
-        inputs.push_back({input_name, inputBuffer, std::move(input_type)});
+        ANeuralNetworksMemory* input_memory = nullptr;
+        const AHardwareBuffer* input_hardware_buffer = nullptr;
+        GetBoundMemory(ort, input_tensor, inputBuffer, input_memory, input_hardware_buffer);
+        inputs.push_back({input_name, inputBuffer, std::move(input_type), input_memory, input_hardware_buffer});
 
         ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
       }
@@ -387,16 +410,20 @@ common::Status NnapiExecutionProvider::Compile(const std::vector<FusedNodeAndGra
 
           void* output_buffer = nullptr;
           size_t output_buffer_byte_size;
+          ANeuralNetworksMemory* output_memory = nullptr;
+          const AHardwareBuffer* output_hardware_buffer = nullptr;
           if (!is_dynamic_shape_output) {
             // Since NNAPI use {1} tensor as scalar, if the model output should have empty shape
             // We are going to replace the {1} shape of the output back to {}
             if (model->IsScalarOutput(output_name))
               output_shape.clear();
 
+            OrtValue* output_value = nullptr;
             ORT_RETURN_IF_ERROR(GetOutputBuffer(ort, context,
                                                 *model,
                                                 output_name, output_shape, model_output_type.type,
-                                                &output_buffer));
+                                                &output_buffer, &output_value));
+            GetBoundMemory(ort, output_value, output_buffer, output_memory, output_hardware_buffer);
             output_buffer_byte_size = model_output_type.GetOperandBlobByteSize();
           } else {
             // This output is dynamic (size unknown), will need allocate a buffer for the result
@@ -409,7 +436,8 @@ common::Status NnapiExecutionProvider::Compile(const std::vector<FusedNodeAndGra
             dynamic_shape_output_buffers.push_back(std::move(buffer_holder));
           }
 
-          outputs.push_back({output_buffer, std::move(model_output_type), output_buffer_byte_size});
+          outputs.push_back({output_buffer, std::move(model_output_type), output_buffer_byte_size,
+                             output_memory, output_hardware_buffer});
         }
 
         ORT_RETURN_IF_ERROR(execution->SetOutputBuffers(outputs));
@@ -429,10 +457,17 @@ common::Status NnapiExecutionProvider::Compile(const std::vector<FusedNodeAndGra
 
           void* model_output_buffer = dynamic_shape_output_buffers[i].get();
           void* onnx_output_buffer = nullptr;
+          OrtValue* onnx_output_value = nullptr;
           ORT_RETURN_IF_ERROR(GetOutputBuffer(ort, context,
                                               *model,
                                               output_name, output_shape, model_output_type.type,
-                                              &onnx_output_buffer));
+                                              &onnx_output_buffer, &onnx_output_value));
+
+          ANeuralNetworksMemory* output_memory = nullptr;
+          const AHardwareBuffer* output_hardware_buffer = nullptr;
+          GetBoundMemory(ort, onnx_output_value, onnx_output_buffer, output_memory, output_hardware_buffer);
+          ORT_RETURN_IF(output_memory || output_hardware_buffer,
+                        "Binding NNAPI memory to an output of dynamic shape is not supported, output: ", output_name);
 
           size_t output_buffer_byte_size = model_output_type.GetOperandBlobByteSize();
           memcpy(onnx_output_buffer, model_output_buffer, output_buffer_byte_size);
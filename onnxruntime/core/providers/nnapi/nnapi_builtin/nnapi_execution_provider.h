@@ -15,7 +15,8 @@ class Model;
 class NnapiExecutionProvider : public IExecutionProvider {
  public:
   explicit NnapiExecutionProvider(uint32_t nnapi_flags,
-                                  const optional<std::string>& partitioning_stop_ops_list = {});
+                                  const optional<std::string>& partitioning_stop_ops_list = {},
+                                  const optional<std::string>& compilation_cache_dir = {});
 
   virtual ~NnapiExecutionProvider();
 
@@ -39,6 +40,9 @@ class NnapiExecutionProvider : public IExecutionProvider {
 
   const std::unordered_set<std::string> partitioning_stop_ops_;
 
+  // The directory to cache the compiled NNAPI models in, empty if the compilation caching is disabled
+  const std::string compilation_cache_dir_;
+
   std::unordered_map<std::string, std::unique_ptr<onnxruntime::nnapi::Model>> nnapi_models_;
 };
 }  // namespace onnxruntime
@@ -131,7 +131,8 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
 #endif  
   //The infer_requests_ pool will be intialized with a default value of 8 infer_request's
   //The nireq value can also be configured to any num_of_threads during runtime
-  size_t nireq = global_context_.num_of_threads;
+  //There are at least as many infer_request's as throughput streams, so that concurrent Run calls keep all the streams busy
+  size_t nireq = std::max(global_context_.num_of_threads, global_context_.num_streams);
   LOGS_DEFAULT(INFO) << log_tag << "The value of nireq being used is: " << nireq;
 #ifndef NDEBUG
   if (openvino_ep::backend_utils::IsDebugEnabled()) {
@@ -219,6 +220,15 @@ void BasicBackend::PopulateConfigValue(OVConfig& config) {
       config["MYRIAD_CHECK_PREPROCESSING_INSIDE_MODEL"] = CONFIG_VALUE(NO);
     #endif  
   }
+  if (global_context_.num_streams > 0) {
+    const std::string num_streams = std::to_string(global_context_.num_streams);
+    if (global_context_.device_type.find("CPU") != std::string::npos) {
+      config[CONFIG_KEY(CPU_THROUGHPUT_STREAMS)] = num_streams;
+    }
+    if (global_context_.device_type.find("GPU") != std::string::npos) {
+      config[CONFIG_KEY(GPU_THROUGHPUT_STREAMS)] = num_streams;
+    }
+  }
 }
 
 void BasicBackend::EnableCaching() {
@@ -511,6 +521,9 @@ void BasicBackend::Infer(Ort::CustomOpApi& ort, OrtKernelContext* context) {
       //Requesting for an idle infer_request from a pool of infer_requests_
       OVInferRequestPtr infer_request;
       infer_request = inferRequestsQueue_->getIdleRequest();
+      //The infer_request is placed back into the pool even if the inference fails, so that the concurrent Run calls
+      //waiting for an idle infer_request are not blocked forever
+      auto put_idle_request = gsl::finally([this, &infer_request] { inferRequestsQueue_->putIdleRequest(infer_request); });
 	   
       #ifdef IO_BUFFER_ENABLED
       if ((global_context_.device_type.find("GPU") != std::string::npos)  && 
@@ -534,7 +547,7 @@ void BasicBackend::Infer(Ort::CustomOpApi& ort, OrtKernelContext* context) {
       }
 
       //Once the inference is completed, the infer_request becomes free and is placed back into pool of infer_requests_
-      inferRequestsQueue_->putIdleRequest(infer_request);
+      //by put_idle_request
 #ifndef NDEBUG
   #ifndef IO_BUFFER_ENABLED // Printing performance counts is disabled when IO_BUFFER_ENABLED
     if (openvino_ep::backend_utils::IsDebugEnabled()) {
@@ -16,6 +16,7 @@ struct GlobalContext {
   bool use_compiled_network = false;
   bool enable_opencl_throttling = false;
   size_t num_of_threads;
+  size_t num_streams = 0;
   std::string device_type;
   std::string precision_str;
   std::string device_id;
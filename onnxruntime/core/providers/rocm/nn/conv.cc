@@ -3,6 +3,7 @@
 
 #include "core/providers/rocm/rocm_common.h"
 #include "core/providers/rocm/nn/conv.h"
+#include "core/providers/rocm/nn/conv_algo_cache.h"
 #include "core/providers/rocm/shared_inc/fpgeneric.h"
 #include "core/providers/rocm/tensor/slice.h"
 
@@ -231,30 +232,41 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
     }
 
     if (!s_.cached_benchmark_fwd_results.contains(x_dims_miopen)) {
-
-      miopenConvAlgoPerf_t perf;
-      int algo_count = 1;
       const ROCMExecutionProvider* rocm_ep = static_cast<const ROCMExecutionProvider*>(this->Info().GetExecutionProvider());
-      static constexpr int num_algos = MIOPEN_CONVOLUTION_FWD_ALGO_COUNT;
-      size_t max_ws_size = rocm_ep->GetMiopenConvUseMaxWorkspace() ? GetMaxWorkspaceSize(s_, kAllAlgos, num_algos)
-                                                                      : AlgoSearchWorkspaceSize;
-      IAllocatorUniquePtr<void> algo_search_workspace = GetTransientScratchBuffer<void>(max_ws_size);
-      MIOPEN_RETURN_IF_ERROR(miopenFindConvolutionForwardAlgorithm(
-	  s_.handle,
-	  s_.x_tensor,
-	  s_.x_data,
-	  s_.w_desc,
-	  s_.w_data,
-	  s_.conv_desc,
-	  s_.y_tensor,
-	  s_.y_data,
-	  1,            // requestedAlgoCount
-	  &algo_count,  // returnedAlgoCount
-	  &perf,
-	  algo_search_workspace.get(),
-	  max_ws_size,
-          false)); // Do not do exhaustive algo search.
-      s_.cached_benchmark_fwd_results.insert(x_dims_miopen, {perf.fwd_algo, perf.memory});
+      // The sessions of the process, and of the processes sharing the cache file, run the Find of a convolution once.
+      const std::string& cache_file = rocm_ep->GetMiopenConvAlgoCacheFile();
+      const std::string key = ConvAlgoCache::MakeKey("fwd", GetDeviceProp(), MiopenTensor::GetDataType<HipT>(),
+                                                     x_dims_miopen, w_dims, y_dims_miopen, pads, strides, dilations,
+                                                     conv_attrs_.group, rocm_ep->GetMiopenConvUseMaxWorkspace());
+      ConvAlgoCacheEntry entry;
+      if (ConvAlgoCache::Instance().Find(key, cache_file, entry)) {
+        s_.cached_benchmark_fwd_results.insert(x_dims_miopen, {static_cast<miopenConvFwdAlgorithm_t>(entry.algo),
+                                                               entry.memory});
+      } else {
+        miopenConvAlgoPerf_t perf;
+        int algo_count = 1;
+        static constexpr int num_algos = MIOPEN_CONVOLUTION_FWD_ALGO_COUNT;
+        size_t max_ws_size = rocm_ep->GetMiopenConvUseMaxWorkspace() ? GetMaxWorkspaceSize(s_, kAllAlgos, num_algos)
+                                                                        : AlgoSearchWorkspaceSize;
+        IAllocatorUniquePtr<void> algo_search_workspace = GetTransientScratchBuffer<void>(max_ws_size);
+        MIOPEN_RETURN_IF_ERROR(miopenFindConvolutionForwardAlgorithm(
+            s_.handle,
+            s_.x_tensor,
+            s_.x_data,
+            s_.w_desc,
+            s_.w_data,
+            s_.conv_desc,
+            s_.y_tensor,
+            s_.y_data,
+            1,            // requestedAlgoCount
+            &algo_count,  // returnedAlgoCount
+            &perf,
+            algo_search_workspace.get(),
+            max_ws_size,
+            false));  // Do not do exhaustive algo search.
+        s_.cached_benchmark_fwd_results.insert(x_dims_miopen, {perf.fwd_algo, perf.memory});
+        ConvAlgoCache::Instance().Insert(key, cache_file, {static_cast<int>(perf.fwd_algo), perf.memory});
+      }
     }
     const auto& perf = s_.cached_benchmark_fwd_results.at(x_dims_miopen);
     s_.fwd_algo = perf.fwd_algo;
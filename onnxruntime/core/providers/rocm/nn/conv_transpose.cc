@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "conv_transpose.h"
+#include "core/providers/rocm/nn/conv_algo_cache.h"
 
 namespace onnxruntime {
 namespace rocm {
@@ -129,26 +130,39 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
       y_data = reinterpret_cast<HipT*>(p.Y->template MutableData<T>());
 
       if (!s_.cached_benchmark_bwd_results.contains(x_dims)) {
-        IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
-
-        miopenConvAlgoPerf_t perf;
-        int algo_count = 1;
-        MIOPEN_RETURN_IF_ERROR(miopenFindConvolutionBackwardDataAlgorithm(
-            MiopenHandle(),
-            s_.x_tensor,
-            x_data,
-            s_.w_desc,
-            w_data,
-            s_.conv_desc,
-            s_.y_tensor,
-            y_data,
-            1,
-            &algo_count,
-            &perf,
-            algo_search_workspace.get(),
-            AlgoSearchWorkspaceSize,
-	    false));
-        s_.cached_benchmark_bwd_results.insert(x_dims, {perf.bwd_data_algo, perf.memory});
+        const ROCMExecutionProvider* rocm_ep =
+            static_cast<const ROCMExecutionProvider*>(this->Info().GetExecutionProvider());
+        const std::string& cache_file = rocm_ep->GetMiopenConvAlgoCacheFile();
+        const std::string key = ConvAlgoCache::MakeKey("bwd_data", GetDeviceProp(), MiopenTensor::GetDataType<HipT>(),
+                                                       x_dims, w_dims, y_dims, p.pads, p.strides, p.dilations,
+                                                       conv_transpose_attrs_.group, false);
+        ConvAlgoCacheEntry entry;
+        if (ConvAlgoCache::Instance().Find(key, cache_file, entry)) {
+          s_.cached_benchmark_bwd_results.insert(x_dims, {static_cast<miopenConvBwdDataAlgorithm_t>(entry.algo),
+                                                          entry.memory});
+        } else {
+          IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
+
+          miopenConvAlgoPerf_t perf;
+          int algo_count = 1;
+          MIOPEN_RETURN_IF_ERROR(miopenFindConvolutionBackwardDataAlgorithm(
+              MiopenHandle(),
+              s_.x_tensor,
+              x_data,
+              s_.w_desc,
+              w_data,
+              s_.conv_desc,
+              s_.y_tensor,
+              y_data,
+              1,
+              &algo_count,
+              &perf,
+              algo_search_workspace.get(),
+              AlgoSearchWorkspaceSize,
+              false));
+          s_.cached_benchmark_bwd_results.insert(x_dims, {perf.bwd_data_algo, perf.memory});
+          ConvAlgoCache::Instance().Insert(key, cache_file, {static_cast<int>(perf.bwd_data_algo), perf.memory});
+        }
       }
 
       const auto& perf = s_.cached_benchmark_bwd_results.at(x_dims);
@@ -8,6 +8,7 @@
 #include "core/providers/rocm/rocm_fence.h"
 #include "core/providers/rocm/rocm_fwd.h"
 #include "core/providers/rocm/gpu_data_transfer.h"
+#include "core/providers/rocm/nn/conv_algo_cache.h"
 
 #ifndef DISABLE_CONTRIB_OPS
 #include "contrib_ops/rocm/rocm_contrib_kernels.h"
@@ -151,6 +152,67 @@ ROCMExecutionProvider::PerThreadContext::~PerThreadContext() {
   } catch (const std::exception& ex) {
     LOGS_DEFAULT(ERROR) << "miopenDestroy threw:" << ex.what();
   }
+
+  try {
+    hip_graphs_.clear();
+  } catch (const std::exception& ex) {
+    LOGS_DEFAULT(ERROR) << "Releasing the hip graphs threw:" << ex.what();
+  }
+}
+
+void ROCMExecutionProvider::PerThreadContext::SelectGraph(size_t graph_key, size_t max_graphs) {
+  auto it = std::find_if(hip_graphs_.begin(), hip_graphs_.end(),
+                         [graph_key](const CapturedGraph& graph) { return graph.key == graph_key; });
+  if (it != hip_graphs_.end()) {
+    hip_graphs_.splice(hip_graphs_.begin(), hip_graphs_, it);
+    return;
+  }
+
+  hip_graphs_.emplace_front();
+  hip_graphs_.front().key = graph_key;
+  hip_graphs_.front().hip_graph.SetStream(stream_);
+  while (hip_graphs_.size() > max_graphs) {
+    LOGS_DEFAULT(INFO) << "Releasing the least recently used hip graph, over " << max_graphs << " graphs";
+    hip_graphs_.pop_back();
+  }
+}
+
+ROCMExecutionProvider::PerThreadContext::CapturedGraph& ROCMExecutionProvider::PerThreadContext::CurrentGraph() {
+  if (hip_graphs_.empty()) {
+    SelectGraph(0, 1);
+  }
+  return hip_graphs_.front();
+}
+
+bool ROCMExecutionProvider::PerThreadContext::IsGraphCaptureAllowed() const {
+  const int regular_run_count =
+      hip_graphs_.empty() ? 0 : hip_graphs_.front().regular_run_count_before_graph_capture;
+  return regular_run_count >= min_num_runs_before_hip_graph_capture_;
+}
+
+void ROCMExecutionProvider::PerThreadContext::CaptureBegin() {
+  auto& graph = CurrentGraph();
+  graph.hip_graph.Reset();
+  graph.hip_graph.CaptureBegin();
+}
+
+void ROCMExecutionProvider::PerThreadContext::CaptureEnd() {
+  auto& graph = CurrentGraph();
+  graph.hip_graph.CaptureEnd();
+  graph.is_graph_captured = true;
+}
+
+bool ROCMExecutionProvider::PerThreadContext::IsGraphCaptured() const {
+  return !hip_graphs_.empty() && hip_graphs_.front().is_graph_captured;
+}
+
+Status ROCMExecutionProvider::PerThreadContext::ReplayGraph() {
+  ORT_ENFORCE(IsGraphCaptured());
+  return CurrentGraph().hip_graph.Replay();
+}
+
+void ROCMExecutionProvider::PerThreadContext::IncrementRegularRunCountBeforeGraphCapture() {
+  ++CurrentGraph().regular_run_count_before_graph_capture;
 }
 
 ROCMExecutionProvider::ROCMExecutionProvider(const ROCMExecutionProviderInfo& info)
@@ -165,6 +227,14 @@ ROCMExecutionProvider::ROCMExecutionProvider(const ROCMExecutionProviderInfo& in
   // This scenario is not supported.
   ORT_ENFORCE(!(info.has_user_compute_stream && info.external_allocator_info.UseExternalAllocator()));
 
+  // The graphs can't be captured on the legacy default stream used with an external allocator.
+  ORT_ENFORCE(!(info.enable_hip_graph && info.external_allocator_info.UseExternalAllocator()),
+              "HIP graph is not supported with an external allocator.");
+
+  if (!info.miopen_conv_algo_cache_file.empty()) {
+    rocm::ConvAlgoCache::Instance().Load(info.miopen_conv_algo_cache_file);
+  }
+
   if (info.has_user_compute_stream) {
     external_stream_ = true;
     stream_ = static_cast<hipStream_t>(info.user_compute_stream);
@@ -333,17 +403,40 @@ Status ROCMExecutionProvider::OnRunStart() {
   auto& current_deferred_release_event = GetPerThreadContext().GetCurrentDeferredReleaseEvent();
   HIP_RETURN_IF_ERROR(hipEventCreateWithFlags(&current_deferred_release_event, hipEventDisableTiming));
   deferred_release_cpu_ptr_.emplace(current_deferred_release_event, DeferredReleaseCPUPtrs());
+
+  if (IsGraphCaptureEnabled() && GetPerThreadContext().IsGraphCaptureAllowed() &&
+      !GetPerThreadContext().IsGraphCaptured()) {
+    LOGS_DEFAULT(INFO) << "Capturing the hip graph for this model";
+    GetPerThreadContext().CaptureBegin();
+  }
   return Status::OK();
 }
 
 Status ROCMExecutionProvider::OnRunEnd(bool sync_stream) {
+  if (IsGraphCaptureEnabled() && !GetPerThreadContext().IsGraphCaptured()) {
+    if (GetPerThreadContext().IsGraphCaptureAllowed()) {
+      GetPerThreadContext().CaptureEnd();
+      // HIP work issued to a capturing stream doesn't actually run on the GPU,
+      // so run the captured graph here to actually execute the work.
+      ORT_RETURN_IF_ERROR(GetPerThreadContext().ReplayGraph());
+    } else {
+      GetPerThreadContext().IncrementRegularRunCountBeforeGraphCapture();
+    }
+  }
+
   // record deferred release event on default stream, and release per_thread_context
   auto current_deferred_release_event = GetPerThreadContext().GetCurrentDeferredReleaseEvent();
   HIP_RETURN_IF_ERROR(hipEventRecord(current_deferred_release_event, static_cast<hipStream_t>(GetComputeStream())));
   if (sync_stream) {
     HIP_RETURN_IF_ERROR(hipStreamSynchronize(static_cast<hipStream_t>(GetComputeStream())));
   }
-  ReleasePerThreadContext();
+
+  // If hip graph is enabled, the per thread context will not be released
+  // because the per thread hip graphs need to be maintained and replayed for
+  // the next runs.
+  if (!IsGraphCaptureEnabled()) {
+    ReleasePerThreadContext();
+  }
   std::lock_guard<OrtMutex> lock(deferred_release_cpu_ptr_mutex_);
   deferred_release_cpu_ptr_[current_deferred_release_event].recorded = true;
 
@@ -362,6 +455,22 @@ Status ROCMExecutionProvider::SetComputeStream(void* stream) {
   return Status::OK();
 }
 
+bool ROCMExecutionProvider::IsGraphCaptureEnabled() const {
+  return info_.enable_hip_graph;
+}
+
+bool ROCMExecutionProvider::IsGraphCaptured() const {
+  return GetPerThreadContext().IsGraphCaptured();
+}
+
+Status ROCMExecutionProvider::ReplayGraph() {
+  return GetPerThreadContext().ReplayGraph();
+}
+
+void ROCMExecutionProvider::SelectGraph(size_t graph_key) {
+  GetPerThreadContext().SelectGraph(graph_key, static_cast<size_t>(info_.max_hip_graphs));
+}
+
 namespace rocm {
 // opset 1 to 9
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kRocmExecutionProvider, kOnnxDomain, 1, MemcpyFromHost);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <set>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #include "core/framework/execution_provider.h"
 #include "core/platform/ort_mutex.h"
 #include "core/providers/rocm/rocm_execution_provider_info.h"
+#include "core/providers/rocm/rocm_graph.h"
 #include "core/providers/rocm/rocm_pch.h"
 #include "core/providers/rocm/shared_inc/rocm_utils.h"
 #include "core/providers/rocm/shared_inc/rocm_call.h"
@@ -76,6 +78,7 @@ class ROCMExecutionProvider : public IExecutionProvider {
   bool DoCopyOnDefaultStream() const { return info_.do_copy_in_default_stream; }
 
   bool GetMiopenConvUseMaxWorkspace() const { return info_.miopen_conv_use_max_workspace; }
+  const std::string& GetMiopenConvAlgoCacheFile() const { return info_.miopen_conv_algo_cache_file; }
 
   ProviderOptions GetProviderOptions() const override {
     return ROCMExecutionProviderInfo::ToProviderOptions(info_);
@@ -93,6 +96,11 @@ class ROCMExecutionProvider : public IExecutionProvider {
   static AllocatorPtr CreateRocmAllocator(OrtDevice::DeviceId device_id, size_t rocm_mem_limit, ArenaExtendStrategy arena_extend_strategy,
                                           ROCMExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
 
+  bool IsGraphCaptureEnabled() const override;
+  bool IsGraphCaptured() const override;
+  Status ReplayGraph() override;
+  void SelectGraph(size_t graph_key) override;
+
  private:
   ROCMExecutionProviderInfo info_;
   hipDeviceProp_t device_prop_;
@@ -151,6 +159,17 @@ class ROCMExecutionProvider : public IExecutionProvider {
       return allocator_;
     }
 
+    // Selects the graph of graph_key, which is captured by the next runs if it is not captured yet.
+    // The least recently selected graphs beyond max_graphs are released.
+    void SelectGraph(size_t graph_key, size_t max_graphs);
+
+    bool IsGraphCaptureAllowed() const;
+    void CaptureBegin();
+    void CaptureEnd();
+    bool IsGraphCaptured() const;
+    Status ReplayGraph();
+    void IncrementRegularRunCountBeforeGraphCapture();
+
    private:
     hipStream_t stream_ = nullptr;
     rocblas_handle rocblas_handle_ = nullptr;
@@ -166,6 +185,22 @@ class ROCMExecutionProvider : public IExecutionProvider {
     std::unique_ptr<rocm::IConstantBuffer<half>> constant_ones_half_;
 
     AllocatorPtr allocator_;
+
+    // The hip graphs are put under PerThreadContext so each thread keeps its own graphs, and
+    // the buffers of its allocator they refer to.
+    struct CapturedGraph {
+      size_t key = 0;
+      ROCMGraph hip_graph;
+      bool is_graph_captured = false;
+      int regular_run_count_before_graph_capture = 0;
+    };
+
+    // The selected graph, the first one of hip_graphs_, which selects the graph of key 0 if none was.
+    CapturedGraph& CurrentGraph();
+
+    // the graphs of the thread, the most recently selected first
+    std::list<CapturedGraph> hip_graphs_;
+    const int min_num_runs_before_hip_graph_capture_ = 1;  // required min regular runs before graph capture for the necessary memory allocations.
   };
 
   using PerThreadContextMap = std::unordered_map<const ROCMExecutionProvider*, std::weak_ptr<PerThreadContext>>;
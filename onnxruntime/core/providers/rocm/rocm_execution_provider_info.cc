@@ -21,6 +21,9 @@ constexpr const char* kGpuExternalAlloc = "gpu_external_alloc";
 constexpr const char* kGpuExternalFree = "gpu_external_free";
 constexpr const char* kGpuExternalEmptyCache = "gpu_external_empty_cache";
 constexpr const char* kMiopenConvUseMaxWorkspace = "miopen_conv_use_max_workspace";
+constexpr const char* kEnableHipGraph = "enable_hip_graph";
+constexpr const char* kMaxHipGraphs = "max_hip_graphs";
+constexpr const char* kMiopenConvAlgoCacheFile = "miopen_conv_algo_cache_file";
 }  // namespace provider_option_names
 }  // namespace rocm
 
@@ -83,6 +86,16 @@ ROCMExecutionProviderInfo ROCMExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToReference(rocm::provider_option_names::kMiopenConvExhaustiveSearch, info.miopen_conv_exhaustive_search)
           .AddAssignmentToReference(rocm::provider_option_names::kDoCopyInDefaultStream, info.do_copy_in_default_stream)
           .AddAssignmentToReference(rocm::provider_option_names::kMiopenConvUseMaxWorkspace, info.miopen_conv_use_max_workspace)
+          .AddAssignmentToReference(rocm::provider_option_names::kEnableHipGraph, info.enable_hip_graph)
+          .AddValueParser(
+              rocm::provider_option_names::kMaxHipGraphs,
+              [&info](const std::string& value_str) -> Status {
+                ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.max_hip_graphs));
+                ORT_RETURN_IF_NOT(info.max_hip_graphs >= 1,
+                                  "Invalid maximum number of HIP graphs: ", info.max_hip_graphs, ", must be at least 1.");
+                return Status::OK();
+              })
+          .AddAssignmentToReference(rocm::provider_option_names::kMiopenConvAlgoCacheFile, info.miopen_conv_algo_cache_file)
           .Parse(options));
 
   ROCMExecutionProviderExternalAllocatorInfo alloc_info{alloc, free, empty_cache};
@@ -102,6 +115,9 @@ ProviderOptions ROCMExecutionProviderInfo::ToProviderOptions(const ROCMExecution
       {rocm::provider_option_names::kMiopenConvExhaustiveSearch, MakeStringWithClassicLocale(info.miopen_conv_exhaustive_search)},
       {rocm::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
       {rocm::provider_option_names::kMiopenConvUseMaxWorkspace, MakeStringWithClassicLocale(info.miopen_conv_use_max_workspace)},
+      {rocm::provider_option_names::kEnableHipGraph, MakeStringWithClassicLocale(info.enable_hip_graph)},
+      {rocm::provider_option_names::kMaxHipGraphs, MakeStringWithClassicLocale(info.max_hip_graphs)},
+      {rocm::provider_option_names::kMiopenConvAlgoCacheFile, info.miopen_conv_algo_cache_file},
   };
 
   return options;
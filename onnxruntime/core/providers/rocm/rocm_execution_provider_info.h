@@ -4,6 +4,7 @@
 #pragma once
 
 #include <limits>
+#include <string>
 
 #include "core/framework/arena_extend_strategy.h"
 #include "core/framework/ortdevice.h"
@@ -50,6 +51,17 @@ struct ROCMExecutionProviderInfo {
   ROCMExecutionProviderExternalAllocatorInfo external_allocator_info{};
   bool miopen_conv_use_max_workspace{false};
 
+  bool enable_hip_graph{false};
+
+  // Maximum number of HIP graphs a thread keeps captured with enable_hip_graph, one per shape and address
+  // signature of the inputs and outputs. The least recently replayed graph is released beyond it.
+  int max_hip_graphs{8};
+
+  // File the convolution algorithms found by the MIOpen Find are persisted to. The file is loaded when the
+  // provider is created, and the algorithms the sessions find are appended to it, so that the other sessions
+  // and processes using it don't run the Find again. Empty to only share them between the sessions of the process.
+  std::string miopen_conv_algo_cache_file;
+
   static ROCMExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const ROCMExecutionProviderInfo& info);
 };
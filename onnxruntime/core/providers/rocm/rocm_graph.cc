@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/rocm/rocm_graph.h"
+
+#include "core/providers/rocm/rocm_common.h"
+
+namespace onnxruntime {
+
+ROCMGraph::ROCMGraph(hipStream_t stream) : stream_(stream) {
+}
+
+void ROCMGraph::SetStream(hipStream_t stream) {
+  stream_ = stream;
+}
+
+void ROCMGraph::CaptureBegin() {
+  ORT_ENFORCE(!has_graph_exec_,
+              "This hip graph has already captured a graph. "
+              "Create a new instance to capture a new graph.");
+
+  HIP_CALL_THROW(hipStreamSynchronize(stream_));
+  // The stream is shared by the threads running the session, so the capture guards against
+  // the unsafe calls of all of them.
+  HIP_CALL_THROW(hipStreamBeginCapture(stream_, hipStreamCaptureModeGlobal));
+}
+
+void ROCMGraph::CaptureEnd() {
+  HIP_CALL_THROW(hipStreamEndCapture(stream_, &graph_));
+  if (graph_ == NULL) {
+    ORT_THROW("ROCMGraph::CaptureEnd: graph_ is NULL");
+  }
+
+  has_graph_ = true;
+  HIP_CALL_THROW(hipGraphInstantiate(&graph_exec_, graph_, NULL, NULL, 0));
+  has_graph_exec_ = true;
+  HIP_CALL_THROW(hipGraphDestroy(graph_));
+  has_graph_ = false;
+}
+
+Status ROCMGraph::Replay() {
+  // Although this function is not thread safe, the lock is not needed here because
+  // ROCM EP maintains separate hip graphs per thread
+  LOGS_DEFAULT(INFO) << "Replaying HIP graph on stream " << stream_;
+  HIP_RETURN_IF_ERROR(hipGraphLaunch(graph_exec_, stream_));
+  HIP_RETURN_IF_ERROR(hipStreamSynchronize(stream_));
+  return Status::OK();
+}
+
+void ROCMGraph::Reset() {
+  if (has_graph_) {
+    HIP_CALL_THROW(hipGraphDestroy(graph_));
+    has_graph_ = false;
+  }
+  if (has_graph_exec_) {
+    HIP_CALL_THROW(hipGraphExecDestroy(graph_exec_));
+    has_graph_exec_ = false;
+  }
+}
+
+ROCMGraph::~ROCMGraph() {
+  Reset();
+}
+
+}  // namespace onnxruntime
@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
+#include <atomic>
 #include <fstream>
 #include <list>
+#include <thread>
 #include <unordered_set>
 #include "core/providers/shared_library/provider_api.h"
 #define ORT_API_MANUAL_INIT
@@ -248,6 +250,287 @@ std::unique_lock<OrtMutex> TensorrtExecutionProvider::GetApiLock() const {
   return std::unique_lock<OrtMutex>(singleton);
 }
 
+struct TensorrtEngineBuild {
+  std::thread thread;
+  // Set by the build thread once engine, context and status are set.
+  std::atomic<bool> done{false};
+  Status status;
+  tensorrt_ptr::unique_pointer<nvinfer1::IBuilderConfig> config;
+  tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine> engine;
+  tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext> context;
+
+  // CUDA EP session of the fused node's subgraph, run while the engine is being built. It is null if it couldn't be
+  // created, e.g. the CUDA EP is not available, in which case the first run waits for the engine.
+  Ort::Env fallback_env{nullptr};
+  Ort::Session fallback_session{nullptr};
+  // Names of the session inputs and the indices of the fused node inputs they are bound to.
+  std::vector<std::pair<std::string, size_t>> fallback_inputs;
+  std::vector<std::string> fallback_outputs;
+};
+
+namespace {
+// Serializes the engine to the engine cache at engine_cache_path. The engine is written to a temporary file
+// first, so that a process loading the cache never reads a partial engine.
+bool SaveEngineCache(nvinfer1::ICudaEngine& engine, const std::string& engine_cache_path,
+                     int (*engine_encryption)(const char*, char*, size_t)) {
+  nvinfer1::IHostMemory* serializedModel = engine.serialize();
+  size_t engine_size = serializedModel->size();
+  bool saved = true;
+  if (engine_encryption != nullptr) {
+    saved = engine_encryption(engine_cache_path.c_str(), reinterpret_cast<char*>(serializedModel->data()), engine_size) != 0;
+  } else {
+    const std::string temp_path = engine_cache_path + ".tmp";
+    {
+      std::ofstream file(temp_path, std::ios::binary | std::ios::out);
+      file.write(reinterpret_cast<char*>(serializedModel->data()), engine_size);
+      saved = static_cast<bool>(file);
+    }
+    std::error_code error;
+    if (saved) {
+      fs::rename(temp_path, engine_cache_path, error);
+      saved = !error;
+    }
+  }
+  serializedModel->destroy();
+  return saved;
+}
+
+size_t GetElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+// Runs the fused node on the fallback session of its engine build. The session runs on the EP's stream and its
+// outputs are kept on the device, then copied to the fused node outputs.
+Status RunFallbackSession(TensorrtEngineBuild& engine_build, int device_id, Ort::CustomOpApi& ort,
+                          OrtKernelContext* context, cudaStream_t stream) {
+  try {
+    Ort::IoBinding binding{engine_build.fallback_session};
+    for (const auto& input : engine_build.fallback_inputs) {
+      const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input.second);
+      binding.BindInput(input.first.c_str(), Ort::Unowned<Ort::Value>{const_cast<OrtValue*>(input_tensor)});
+    }
+    Ort::MemoryInfo memory_info{"Cuda", OrtDeviceAllocator, device_id, OrtMemTypeDefault};
+    for (const auto& output_name : engine_build.fallback_outputs) {
+      binding.BindOutput(output_name.c_str(), memory_info);
+    }
+
+    Ort::RunOptions run_options;
+    engine_build.fallback_session.Run(run_options, binding);
+
+    std::vector<Ort::Value> output_values = binding.GetOutputValues();
+    for (size_t i = 0, end = output_values.size(); i < end; ++i) {
+      auto tensor_info = output_values[i].GetTensorTypeAndShapeInfo();
+      const auto shape = tensor_info.GetShape();
+      const size_t element_size = GetElementSize(tensor_info.GetElementType());
+      if (element_size == 0) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP fallback output type: " +
+                                                         std::to_string(tensor_info.GetElementType()) + " not supported.");
+      }
+      OrtValue* output_tensor = ort.KernelContext_GetOutput(context, i, shape.data(), shape.size());
+      const size_t output_size = tensor_info.GetElementCount() * element_size;
+      if (output_size > 0) {
+        CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(ort.GetTensorMutableData<void>(output_tensor),
+                                             output_values[i].GetTensorMutableData<void>(), output_size,
+                                             cudaMemcpyDeviceToDevice, stream));
+      }
+    }
+  } catch (const Ort::Exception& e) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP fallback session failed: ", e.what());
+  }
+  return Status::OK();
+}
+
+using ProfileShapes = std::unordered_map<std::string, std::vector<std::vector<int64_t>>>;
+
+// Checks that the min, max and opt shapes of the explicit optimization profiles are of the same inputs, profiles
+// and ranks, and that min <= opt <= max.
+bool IsValidProfileShapes(const ProfileShapes& min_shapes, const ProfileShapes& max_shapes, const ProfileShapes& opt_shapes) {
+  if (min_shapes.size() != max_shapes.size() || min_shapes.size() != opt_shapes.size()) {
+    return false;
+  }
+  for (const auto& min_entry : min_shapes) {
+    const auto max_iter = max_shapes.find(min_entry.first);
+    const auto opt_iter = opt_shapes.find(min_entry.first);
+    if (max_iter == max_shapes.end() || opt_iter == opt_shapes.end() ||
+        max_iter->second.size() != min_entry.second.size() || opt_iter->second.size() != min_entry.second.size()) {
+      return false;
+    }
+    for (size_t k = 0, end = min_entry.second.size(); k < end; ++k) {
+      const auto& min_shape = min_entry.second[k];
+      const auto& max_shape = max_iter->second[k];
+      const auto& opt_shape = opt_iter->second[k];
+      if (max_shape.size() != min_shape.size() || opt_shape.size() != min_shape.size()) {
+        return false;
+      }
+      for (size_t j = 0, rank = min_shape.size(); j < rank; ++j) {
+        if (min_shape[j] > opt_shape[j] || opt_shape[j] > max_shape[j]) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Adds an optimization profile to the config per explicit profile. The profiles are only added if all the dynamic
+// shape inputs of the network have explicit shapes, has_explicit_profiles tells if they are.
+Status AddExplicitProfiles(nvinfer1::IBuilder& builder, const nvinfer1::INetworkDefinition& network,
+                           nvinfer1::IBuilderConfig& config, const ProfileShapes& min_shapes,
+                           const ProfileShapes& max_shapes, const ProfileShapes& opt_shapes,
+                           bool& has_explicit_profiles) {
+  has_explicit_profiles = false;
+  std::vector<nvinfer1::ITensor*> dynamic_inputs;
+  size_t num_profiles = 0;
+  for (int i = 0, end = network.getNbInputs(); i < end; ++i) {
+    auto input = network.getInput(i);
+    const nvinfer1::Dims dims = input->getDimensions();
+    bool is_dynamic = input->isShapeTensor();
+    for (int j = 0; j < dims.nbDims && !is_dynamic; ++j) {
+      is_dynamic = dims.d[j] == -1;
+    }
+    if (!is_dynamic) {
+      continue;
+    }
+    const auto iter = min_shapes.find(input->getName());
+    if (iter == min_shapes.end()) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] No explicit profile shapes for dynamic shape input " << input->getName()
+                            << ", the engine is built for the input shapes at runtime";
+      return Status::OK();
+    }
+    if (num_profiles != 0 && iter->second.size() != num_profiles) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "TensorRT EP explicit profiles of input ", input->getName(),
+                             " are ", iter->second.size(), ", the other inputs have ", num_profiles);
+    }
+    num_profiles = iter->second.size();
+    dynamic_inputs.push_back(input);
+  }
+  if (dynamic_inputs.empty()) {
+    return Status::OK();
+  }
+
+  for (size_t k = 0; k < num_profiles; ++k) {
+    nvinfer1::IOptimizationProfile* profile = builder.createOptimizationProfile();
+    for (auto input : dynamic_inputs) {
+      const std::string input_name = input->getName();
+      const auto& min_shape = min_shapes.at(input_name)[k];
+      const auto& max_shape = max_shapes.at(input_name)[k];
+      const auto& opt_shape = opt_shapes.at(input_name)[k];
+      if (input->isShapeTensor()) {
+        std::vector<int32_t> min_values(min_shape.begin(), min_shape.end());
+        std::vector<int32_t> max_values(max_shape.begin(), max_shape.end());
+        std::vector<int32_t> opt_values(opt_shape.begin(), opt_shape.end());
+        const int num_values = static_cast<int>(min_values.size());
+        profile->setShapeValues(input_name.c_str(), nvinfer1::OptProfileSelector::kMIN, min_values.data(), num_values);
+        profile->setShapeValues(input_name.c_str(), nvinfer1::OptProfileSelector::kMAX, max_values.data(), num_values);
+        profile->setShapeValues(input_name.c_str(), nvinfer1::OptProfileSelector::kOPT, opt_values.data(), num_values);
+      } else {
+        nvinfer1::Dims dims_min = input->getDimensions();
+        if (static_cast<size_t>(dims_min.nbDims) != min_shape.size()) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "TensorRT EP explicit profile shapes of input ",
+                                 input_name, " have rank ", min_shape.size(), ", the input has rank ", dims_min.nbDims);
+        }
+        nvinfer1::Dims dims_max(dims_min), dims_opt(dims_min);
+        for (int j = 0; j < dims_min.nbDims; ++j) {
+          dims_min.d[j] = static_cast<int32_t>(min_shape[j]);
+          dims_max.d[j] = static_cast<int32_t>(max_shape[j]);
+          dims_opt.d[j] = static_cast<int32_t>(opt_shape[j]);
+        }
+        profile->setDimensions(input_name.c_str(), nvinfer1::OptProfileSelector::kMIN, dims_min);
+        profile->setDimensions(input_name.c_str(), nvinfer1::OptProfileSelector::kMAX, dims_max);
+        profile->setDimensions(input_name.c_str(), nvinfer1::OptProfileSelector::kOPT, dims_opt);
+      }
+    }
+    if (config.addOptimizationProfile(profile) < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "TensorRT EP explicit profile ", k,
+                             " is not valid for the network");
+    }
+  }
+  has_explicit_profiles = true;
+  return Status::OK();
+}
+
+// Copies the values of a shape tensor input to the host, as the int32 values TensorRT expects.
+Status GetShapeTensorValues(Ort::CustomOpApi& ort, const OrtValue* input_tensor, ONNXTensorElementDataType tensor_type,
+                            int shape_size, cudaStream_t stream, std::vector<int32_t>& values) {
+  values.resize(shape_size);
+  switch (tensor_type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32: {
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(values.data(), ort.GetTensorData<int32_t>(input_tensor), shape_size * sizeof(int32_t), cudaMemcpyDeviceToHost, stream));
+      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+      break;
+    }
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64: {
+      std::vector<int64_t> input(shape_size);
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(input.data(), ort.GetTensorData<int64_t>(input_tensor), shape_size * sizeof(int64_t), cudaMemcpyDeviceToHost, stream));
+      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+      for (int j = 0; j < shape_size; ++j) {
+        values[j] = static_cast<int32_t>(input[j]);
+      }
+      break;
+    }
+    default: {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                             "TensorRT shape tensor data type: " + std::to_string(tensor_type) + " not supported.");
+    }
+  }
+  return Status::OK();
+}
+
+// Returns the first optimization profile of the engine the input shapes are in, -1 if none. input_shapes are the
+// shapes of the execution tensor inputs and the values of the shape tensor inputs, by binding index in profile 0.
+int SelectOptimizationProfile(const nvinfer1::ICudaEngine& engine, int bindings_per_profile,
+                              const std::vector<std::pair<int, std::vector<int64_t>>>& input_shapes) {
+  for (int k = 0, num_profiles = engine.getNbOptimizationProfiles(); k < num_profiles; ++k) {
+    bool is_in_profile = true;
+    for (const auto& input_shape : input_shapes) {
+      const int binding_index = input_shape.first + k * bindings_per_profile;
+      const auto& shape = input_shape.second;
+      if (engine.isShapeBinding(binding_index)) {
+        const int32_t* min_values = engine.getProfileShapeValues(binding_index, k, nvinfer1::OptProfileSelector::kMIN);
+        const int32_t* max_values = engine.getProfileShapeValues(binding_index, k, nvinfer1::OptProfileSelector::kMAX);
+        for (size_t j = 0; j < shape.size() && is_in_profile; ++j) {
+          is_in_profile = min_values[j] <= shape[j] && shape[j] <= max_values[j];
+        }
+      } else {
+        const nvinfer1::Dims min_dims = engine.getProfileDimensions(binding_index, k, nvinfer1::OptProfileSelector::kMIN);
+        const nvinfer1::Dims max_dims = engine.getProfileDimensions(binding_index, k, nvinfer1::OptProfileSelector::kMAX);
+        is_in_profile = static_cast<size_t>(min_dims.nbDims) == shape.size();
+        for (size_t j = 0; j < shape.size() && is_in_profile; ++j) {
+          is_in_profile = min_dims.d[j] <= shape[j] && shape[j] <= max_dims.d[j];
+        }
+      }
+      if (!is_in_profile) {
+        break;
+      }
+    }
+    if (is_in_profile) {
+      return k;
+    }
+  }
+  return -1;
+}
+}  // namespace
+
 TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProviderInfo& info)
     : IExecutionProvider{onnxruntime::kTensorrtExecutionProvider, true}, info_(info), device_id_(info.device_id) {
   CUDA_CALL_THROW(cudaSetDevice(device_id_));
@@ -283,6 +566,10 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       engine_decryption_lib_path_ = info.engine_decryption_lib_path;
     }
     force_sequential_engine_build_ = info.force_sequential_engine_build;
+    engine_build_async_ = info.engine_build_async;
+    profile_min_shapes_ = info.profile_min_shapes;
+    profile_max_shapes_ = info.profile_max_shapes;
+    profile_opt_shapes_ = info.profile_opt_shapes;
   } else {
     const std::string max_partition_iterations_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxPartitionIterations);
     if (!max_partition_iterations_env.empty()) {
@@ -367,6 +654,15 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     if (!force_sequential_engine_build_env.empty()) {
       force_sequential_engine_build_ = (std::stoi(force_sequential_engine_build_env) == 0 ? false : true);
     }
+
+    const std::string engine_build_async_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kEngineBuildAsync);
+    if (!engine_build_async_env.empty()) {
+      engine_build_async_ = (std::stoi(engine_build_async_env) == 0 ? false : true);
+    }
+
+    profile_min_shapes_ = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfilesMinShapes);
+    profile_max_shapes_ = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfilesMaxShapes);
+    profile_opt_shapes_ = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfilesOptShapes);
   }
 
   // Validate setting
@@ -387,6 +683,17 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     dla_core_ = 0;
   }
 
+  if (!profile_min_shapes_.empty() || !profile_max_shapes_.empty() || !profile_opt_shapes_.empty()) {
+    if (!ParseProfileShapes(profile_min_shapes_, profile_min_dims_) ||
+        !ParseProfileShapes(profile_max_shapes_, profile_max_dims_) ||
+        !ParseProfileShapes(profile_opt_shapes_, profile_opt_dims_) ||
+        !IsValidProfileShapes(profile_min_dims_, profile_max_dims_, profile_opt_dims_)) {
+      ORT_THROW("[TensorRT EP] TensorRT options trt_profile_min_shapes, trt_profile_max_shapes and trt_profile_opt_shapes "
+                "must list the shapes of the same inputs and profiles, with min <= opt <= max. min: ",
+                profile_min_shapes_, ", max: ", profile_max_shapes_, ", opt: ", profile_opt_shapes_);
+    }
+  }
+
   if (engine_cache_enable_ || int8_enable_) {
     if (!cache_path_.empty() && !fs::is_directory(cache_path_)) {
       if (!fs::create_directory(cache_path_)) {
@@ -430,10 +737,20 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_cache_path: " << cache_path_
                         << ", trt_engine_decryption_enable: " << engine_decryption_enable_
                         << ", trt_engine_decryption_lib_path: " << engine_decryption_lib_path_
-                        << ", trt_force_sequential_engine_build: " << force_sequential_engine_build_;
+                        << ", trt_force_sequential_engine_build: " << force_sequential_engine_build_
+                        << ", trt_engine_build_async: " << engine_build_async_
+                        << ", trt_profile_min_shapes: " << profile_min_shapes_
+                        << ", trt_profile_max_shapes: " << profile_max_shapes_
+                        << ", trt_profile_opt_shapes: " << profile_opt_shapes_;
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {
+  // Engine builds can't be cancelled, wait for the ones still running as they use the builders and networks.
+  for (auto& engine_build : engine_builds_) {
+    if (engine_build.second->thread.joinable()) {
+      engine_build.second->thread.join();
+    }
+  }
   if (!external_stream_ && stream_) {
     CUDA_CALL(cudaStreamDestroy(stream_));
   }
@@ -1127,6 +1444,20 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       }
     }
 
+    // Add the explicit optimization profiles if they are set. The engine is then built for all of them here,
+    // instead of at runtime for the input shapes.
+    bool has_explicit_profiles = false;
+    if (has_dynamic_shape && !profile_min_dims_.empty()) {
+      ORT_RETURN_IF_ERROR(AddExplicitProfiles(*trt_builder, *trt_network, *trt_config, profile_min_dims_, profile_max_dims_,
+                                              profile_opt_dims_, has_explicit_profiles));
+      if (has_explicit_profiles) {
+        // The engines of different profiles are cached separately
+        trt_node_name_with_precision += "_profiles" + std::to_string(std::hash<std::string>{}(
+                                                          profile_min_shapes_ + ";" + profile_max_shapes_ + ";" + profile_opt_shapes_));
+        input_shape_ranges.clear();
+      }
+    }
+
     // If engine cache enable is set,
     // load and deserialize TRT engine cache regardless of the graph has dynamic shape input or not
     tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine> trt_engine;
@@ -1177,9 +1508,9 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         }
       }
 
-      // If graph has dynamic shape input,
+      // If graph has dynamic shape input and no explicit profiles,
       // load and deserialize TRT engine profile cache
-      if (has_dynamic_shape) {
+      if (has_dynamic_shape && !has_explicit_profiles) {
         const std::string profile_cache_path = cache_path + ".profile";
         std::ifstream profile_file(profile_cache_path, std::ios::binary | std::ios::in);
         if (profile_file) {
@@ -1189,9 +1520,11 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
     }
 
     // If (1) engine cache enable is not set or (2) first time enable engine cache and no engine cache is present,
-    // build TRT engine here if the graph doesn't have dynamic shape input. Otherwise engine will
-    // be built at runtime
-    if (!has_dynamic_shape) {
+    // build TRT engine here if the graph doesn't have dynamic shape input or has explicit profiles. Otherwise engine
+    // will be built at runtime. If trt_engine_build_async is set, the engine is built on a background thread instead,
+    // see below.
+    bool build_engine_async = false;
+    if (!has_dynamic_shape || has_explicit_profiles) {
       if (trt_engine == nullptr) {
         // Set INT8 per tensor dynamic range
         if (int8_enable_ && trt_builder->platformHasFastInt8() && int8_calibration_cache_available_) {
@@ -1202,24 +1535,28 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
           }
         }
 
-        // Build engine
-        {
-          auto lock = GetApiLock();
-          trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
-        }
-        if (trt_engine == nullptr) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                 "TensorRT EP could not build engine for fused node: " + fused_node.Name());
-        }
+        if (engine_build_async_) {
+          build_engine_async = true;
+        } else {
+          // Build engine
+          {
+            auto lock = GetApiLock();
+            trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
+          }
+          if (trt_engine == nullptr) {
+            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                   "TensorRT EP could not build engine for fused node: " + fused_node.Name());
+          }
 
-        if (engine_cache_enable_)
-          update_engine_cache = true;
+          if (engine_cache_enable_)
+            update_engine_cache = true;
 
-        // Build context
-        trt_context = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(trt_engine->createExecutionContext());
-        if (trt_context == nullptr) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                 "TensorRT EP could not build execution context for fused node: " + fused_node.Name());
+          // Build context
+          trt_context = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(trt_engine->createExecutionContext());
+          if (trt_context == nullptr) {
+            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                   "TensorRT EP could not build execution context for fused node: " + fused_node.Name());
+          }
         }
       }
     }
@@ -1246,6 +1583,88 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       output_types[output_name] = tensor_type.elem_type();
     }
 
+    // Build the engine on a background thread and run the subgraph on a CUDA EP session until it is built. The
+    // engine is written to the engine cache as soon as it is built, if engine cache enable is set.
+    TensorrtEngineBuild* engine_build = nullptr;
+    if (build_engine_async) {
+      auto& build = engine_builds_[fused_node.Name()];
+      build = std::make_unique<TensorrtEngineBuild>();
+      engine_build = build.get();
+
+      try {
+        Ort::Global<void>::api_ = g_host->OrtGetApiBase()->GetApi(ORT_API_VERSION);
+        Ort::SessionOptions session_options;
+        session_options.SetIntraOpNumThreads(1);
+        session_options.SetInterOpNumThreads(1);
+        OrtCUDAProviderOptions cuda_options;
+        cuda_options.device_id = device_id_;
+        // The fallback session only runs until the engine is built, don't benchmark the convolutions.
+        cuda_options.cudnn_conv_algo_search = OrtCudnnConvAlgoSearchHeuristic;
+        cuda_options.has_user_compute_stream = 1;
+        cuda_options.user_compute_stream = stream_;
+        session_options.AppendExecutionProvider_CUDA(cuda_options);
+        engine_build->fallback_env = Ort::Env{};
+        engine_build->fallback_session = Ort::Session{engine_build->fallback_env, string_buf.data(), string_buf.size(),
+                                                      session_options};
+
+        Ort::AllocatorWithDefaultOptions allocator;
+        for (size_t i = 0, end = engine_build->fallback_session.GetInputCount(); i < end; ++i) {
+          char* input_name = engine_build->fallback_session.GetInputName(i, allocator);
+          const auto& iter = input_map.find(input_name);
+          if (iter != input_map.end()) {
+            engine_build->fallback_inputs.emplace_back(iter->first, iter->second);
+          }
+          allocator.Free(input_name);
+        }
+        engine_build->fallback_outputs.resize(output_defs.size());
+        for (size_t i = 0, end = output_defs.size(); i < end; ++i) {
+          engine_build->fallback_outputs[i] = output_defs[i]->Name();
+        }
+      } catch (const Ort::Exception& e) {
+        LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not create the CUDA EP fallback session for fused node: "
+                              << fused_node.Name() << ", it will wait for its engine to be built. " << e.what();
+        engine_build->fallback_session = Ort::Session{nullptr};
+        engine_build->fallback_inputs.clear();
+      }
+
+      std::string engine_cache_path;
+      if (engine_cache_enable_) {
+        engine_cache_path = GetCachePath(cache_path_, trt_node_name_with_precision) + ".engine";
+      }
+      engine_build->config = std::move(trt_config);
+      engine_build->thread = std::thread([this, engine_build, builder = trt_builder.get(), network = trt_network.get(),
+                                          engine_cache_path, node_name = fused_node.Name()]() {
+        CUDA_CALL(cudaSetDevice(device_id_));
+        {
+          auto lock = GetApiLock();
+          engine_build->engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(
+              builder->buildEngineWithConfig(*network, *engine_build->config));
+        }
+        if (engine_build->engine == nullptr) {
+          engine_build->status = ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                                 "TensorRT EP could not build engine for fused node: " + node_name);
+        } else {
+          engine_build->context = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(
+              engine_build->engine->createExecutionContext());
+          if (engine_build->context == nullptr) {
+            engine_build->status = ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                                   "TensorRT EP could not build execution context for fused node: " + node_name);
+          } else if (!engine_cache_path.empty()) {
+            if (SaveEngineCache(*engine_build->engine, engine_cache_path,
+                                engine_decryption_enable_ ? engine_encryption_ : nullptr)) {
+              LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
+            } else {
+              LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not save engine cache " + engine_cache_path;
+            }
+          }
+        }
+        if (!engine_build->status.IsOK()) {
+          LOGS_DEFAULT(WARNING) << "[TensorRT EP] " << engine_build->status.ErrorMessage();
+        }
+        engine_build->done.store(true);
+      });
+    }
+
     // Save engine, context and input/output info to map
     parsers_.emplace(fused_node.Name(), std::move(trt_parser));
     engines_.emplace(fused_node.Name(), std::move(trt_engine));
@@ -1268,7 +1687,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
             input_shape_ranges_[context->node_name], &tensorrt_mu_, fp16_enable_, int8_enable_, int8_calibration_cache_available_,
             dla_enable_, dla_core_, &max_workspace_size_, trt_node_name_with_precision, engine_cache_enable_, cache_path_,
             runtime_.get(), nullptr, allocator_, dynamic_range_map, engine_decryption_enable_, engine_decryption_, engine_encryption_,
-            update_engine_cache};
+            update_engine_cache, engine_build, has_explicit_profiles};
       *state = p.release();
       return 0;
     };
@@ -1282,24 +1701,19 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         // or engine file is not previously existed
         TensorrtFuncState* trt_state = reinterpret_cast<TensorrtFuncState*>(state);
         if (trt_state->update_engine_cache) {
-          // Serialize engine
+          // Serialize engine, encrypting it if engine decryption enable is set
           const std::string cache_path = GetCachePath(trt_state->engine_cache_path, trt_state->trt_node_name_with_precision);
           const std::string engine_cache_path = cache_path + ".engine";
-          nvinfer1::IHostMemory* serializedModel = trt_state->engine->get()->serialize();
-          size_t engine_size = serializedModel->size();
-          if (trt_state->engine_decryption_enable) {
-            // Encrypt engine
-            if (!trt_state->engine_encryption(engine_cache_path.c_str(), reinterpret_cast<char*>(serializedModel->data()), engine_size)) {
-              delete static_cast<TensorrtFuncState*>(state);
-              ORT_THROW_IF_ERROR(ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                                 "TensorRT EP could not call engine encryption function encrypt"));
-            }
+          if (SaveEngineCache(*trt_state->engine->get(), engine_cache_path,
+                              trt_state->engine_decryption_enable ? trt_state->engine_encryption : nullptr)) {
+            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
+          } else if (trt_state->engine_decryption_enable) {
+            delete static_cast<TensorrtFuncState*>(state);
+            ORT_THROW_IF_ERROR(ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                               "TensorRT EP could not call engine encryption function encrypt"));
           } else {
-            std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
-            file.write(reinterpret_cast<char*>(serializedModel->data()), engine_size);
+            LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not save engine cache " + engine_cache_path;
           }
-          serializedModel->destroy();
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
 
           // Serialize engine profile if needed
           if (!trt_state->input_shape_ranges.empty()) {
@@ -1318,6 +1732,26 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       Ort::CustomOpApi ort{*api};
       TensorrtFuncState* trt_state = reinterpret_cast<TensorrtFuncState*>(state);
       std::lock_guard<OrtMutex> lock(*(trt_state->tensorrt_mu_ptr));
+
+      // Switch to the engine built in the background once it's built. Until then, or if the build failed, run the
+      // fallback session.
+      if (trt_state->engine_build != nullptr) {
+        auto& engine_build = *trt_state->engine_build;
+        const bool is_built = engine_build.done.load() && engine_build.status.IsOK();
+        if (!is_built && engine_build.fallback_session) {
+          return RunFallbackSession(engine_build, device_id_, ort, context, static_cast<cudaStream_t>(this->GetComputeStream()));
+        }
+        if (engine_build.thread.joinable()) {
+          engine_build.thread.join();
+        }
+        ORT_RETURN_IF_ERROR(engine_build.status);
+        trt_state->engine_build = nullptr;
+        *(trt_state->engine) = std::move(engine_build.engine);
+        *(trt_state->context) = std::move(engine_build.context);
+        engine_build.fallback_session = Ort::Session{nullptr};
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Switched to the engine built for " << trt_state->trt_node_name_with_precision;
+      }
+
       const std::unordered_map<std::string, size_t>& input_indexes = (trt_state->input_info)[0];
       const std::unordered_map<std::string, size_t>& output_indexes = (trt_state->output_info)[0];
       const std::unordered_map<std::string, size_t>& output_types = (trt_state->output_info)[1];
@@ -1359,33 +1793,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
             // Get shape values for shape tensor input
             const auto& tensor_type = ort.GetTensorElementType(tensor_info);
             int shape_size = nb_dims == 0 ? 1 : static_cast<int>(tensor_shapes[0]);
-            tensor_shape_values[input_name].resize(shape_size);
-            switch (tensor_type) {
-              case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32: {
-                int32_t* input = new int32_t[shape_size];
-                CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(input, ort.GetTensorData<int32_t>(input_tensor), shape_size * sizeof(int32_t), cudaMemcpyDeviceToHost, stream));
-                CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
-                for (int j = 0; j < shape_size; ++j) {
-                  tensor_shape_values[input_name][j] = input[j];
-                }
-                delete[] input;
-                break;
-              }
-              case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64: {
-                int64_t* input = new int64_t[shape_size];
-                CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(input, ort.GetTensorData<int64_t>(input_tensor), shape_size * sizeof(int64_t), cudaMemcpyDeviceToHost, stream));
-                CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
-                for (int j = 0; j < shape_size; ++j) {
-                  tensor_shape_values[input_name][j] = static_cast<int32_t>(input[j]);
-                }
-                delete[] input;
-                break;
-              }
-              default: {
-                return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                       "TensorRT shape tensor data type: " + std::to_string(tensor_type) + " not supported.");
-              }
-            }
+            ORT_RETURN_IF_ERROR(GetShapeTensorValues(ort, input_tensor, tensor_type, shape_size, stream, tensor_shape_values[input_name]));
 
             // Update shape ranges
             std::vector<int32_t> shapes_min(shape_size), shapes_opt(shape_size), shapes_max(shape_size);
@@ -1525,11 +1933,60 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         trt_state->input_shape_ranges = shape_ranges;
       }
 
-      // Get input and output binding names
+      // Select the explicit optimization profile of the input shapes. Each profile has its own bindings, the binding
+      // names of the profiles other than 0 are suffixed by the profile. The engine is never rebuilt for explicit
+      // profiles, so the input shapes must be in one of them.
       int total_bindings = trt_engine->getNbBindings();
+      const int bindings_per_profile = total_bindings / trt_engine->getNbOptimizationProfiles();
+      int profile_index = 0;
+      if (trt_state->has_explicit_profiles) {
+        std::vector<std::pair<int, std::vector<int64_t>>> input_shapes;
+        for (int i = 0; i < bindings_per_profile; ++i) {
+          if (!trt_engine->bindingIsInput(i)) {
+            continue;
+          }
+          const std::string input_name = trt_engine->getBindingName(i);
+          size_t input_index = 0;
+          const auto& iter = input_indexes.find(input_name);
+          if (iter != input_indexes.end()) {
+            input_index = iter->second;
+          }
+          const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input_index);
+          auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
+          const auto& tensor_shapes = ort.GetTensorShape(tensor_info);
+          if (trt_engine->isShapeBinding(i)) {
+            int shape_size = tensor_shapes.empty() ? 1 : static_cast<int>(tensor_shapes[0]);
+            ORT_RETURN_IF_ERROR(GetShapeTensorValues(ort, input_tensor, ort.GetTensorElementType(tensor_info), shape_size,
+                                                     stream, tensor_shape_values[input_name]));
+            const auto& shape_values = tensor_shape_values[input_name];
+            input_shapes.emplace_back(i, std::vector<int64_t>(shape_values.begin(), shape_values.end()));
+          } else {
+            input_shapes.emplace_back(i, tensor_shapes);
+          }
+          ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
+        }
+
+        profile_index = SelectOptimizationProfile(*trt_engine, bindings_per_profile, input_shapes);
+        if (profile_index < 0) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP input shapes are not in any of the explicit profiles of ",
+                                 trt_state->trt_node_name_with_precision);
+        }
+        if (trt_context->getOptimizationProfile() != profile_index) {
+#if NV_TENSORRT_MAJOR >= 8
+          if (!trt_context->setOptimizationProfileAsync(profile_index, stream)) {
+#else
+          if (!trt_context->setOptimizationProfile(profile_index)) {
+#endif
+            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP could not select optimization profile ", profile_index);
+          }
+        }
+      }
+      const int binding_offset = profile_index * bindings_per_profile;
+
+      // Get input and output binding names
       std::vector<void*> buffers(total_bindings);
       std::vector<std::string> input_binding_names, output_binding_names;
-      for (int i = 0, end = total_bindings; i < end; ++i) {
+      for (int i = 0, end = bindings_per_profile; i < end; ++i) {
         if (trt_engine->bindingIsInput(i)) {
           input_binding_names.push_back(trt_engine->getBindingName(i));
         } else {
@@ -1545,6 +2002,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         if (binding_index == -1) {
           continue;
         }
+        binding_index += binding_offset;
 
         size_t input_index = 0;
         const auto& iter = input_indexes.find(input_name);
@@ -1683,6 +2141,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         if (binding_index == -1) {
           continue;
         }
+        binding_index += binding_offset;
 
         size_t output_index = 0;
         const auto& index_iter = output_indexes.find(output_name);
@@ -1814,7 +2273,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       // Cast INT64 input to INT32 because TensorRT doesn't fully support INT64
       for (size_t i = 0, end = output_binding_names.size(); i < end; ++i) {
         const std::string& output_name = output_binding_names[i];
-        size_t binding_index = trt_engine->getBindingIndex(output_name.c_str());
+        size_t binding_index = trt_engine->getBindingIndex(output_name.c_str()) + binding_offset;
         size_t output_type = 0;
         const auto& iter = output_types.find(output_name);
         if (iter != output_types.end()) {
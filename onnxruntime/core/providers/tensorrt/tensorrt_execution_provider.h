@@ -26,6 +26,10 @@ static const std::string kCachePath = "ORT_TENSORRT_CACHE_PATH";
 static const std::string kDecryptionEnable = "ORT_TENSORRT_ENGINE_DECRYPTION_ENABLE";
 static const std::string kDecryptionLibPath = "ORT_TENSORRT_ENGINE_DECRYPTION_LIB_PATH";
 static const std::string kForceSequentialEngineBuild= "ORT_TENSORRT_FORCE_SEQUENTIAL_ENGINE_BUILD";
+static const std::string kEngineBuildAsync = "ORT_TENSORRT_ENGINE_BUILD_ASYNC";
+static const std::string kProfilesMinShapes = "ORT_TENSORRT_PROFILE_MIN_SHAPES";
+static const std::string kProfilesMaxShapes = "ORT_TENSORRT_PROFILE_MAX_SHAPES";
+static const std::string kProfilesOptShapes = "ORT_TENSORRT_PROFILE_OPT_SHAPES";
 // Old env variable for backward compatibility
 static const std::string kEngineCachePath = "ORT_TENSORRT_ENGINE_CACHE_PATH";
 }  // namespace tensorrt_env_vars
@@ -77,6 +81,9 @@ template <typename T>
 using unique_pointer = std::unique_ptr<T, TensorrtInferDeleter>;
 };  // namespace tensorrt_ptr
 
+// Engine of a fused node built on a background thread, see trt_engine_build_async.
+struct TensorrtEngineBuild;
+
 // Information to construct kernel function state.
 struct TensorrtFuncState {
   AllocateFunc test_allocate_func = nullptr;
@@ -110,6 +117,12 @@ struct TensorrtFuncState {
   // If sub-graph has dynamic input shape and the shape range changes, or the first time writing out engine cache, this flag is set to true and engine cache will be saved. Otherwise the flag is false.
   // Note: For dynamic input shape, if update_engine_cache flag is true, profile cache will be saved as well.
   bool update_engine_cache;
+  // Engine being built on a background thread, if any. The fused node runs on its fallback session until the engine
+  // is built, then the engine and its context are moved to engine and context above.
+  TensorrtEngineBuild* engine_build = nullptr;
+  // If the engine has the optimization profiles of trt_profile_min_shapes/max_shapes/opt_shapes, the profile is
+  // selected by the input shapes and the engine is never rebuilt.
+  bool has_explicit_profiles = false;
 };
 
 // Logical device representation.
@@ -156,6 +169,10 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   bool dla_enable_ = false;
   int dla_core_ = 0;
   bool force_sequential_engine_build_ = false;
+  bool engine_build_async_ = false;
+  std::string profile_min_shapes_, profile_max_shapes_, profile_opt_shapes_;
+  // Input shapes of the explicit optimization profiles, by input name then profile
+  std::unordered_map<std::string, std::vector<std::vector<int64_t>>> profile_min_dims_, profile_max_dims_, profile_opt_dims_;
   std::string int8_calibration_cache_name_;
   bool int8_calibration_cache_available_ = false;
   bool int8_use_native_tensorrt_calibration_table_ = false;
@@ -179,6 +196,7 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   std::unordered_map<std::string, std::vector<std::unordered_map<std::string, size_t>>> input_info_;
   std::unordered_map<std::string, std::vector<std::unordered_map<std::string, size_t>>> output_info_;
   std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<size_t, std::pair<int64_t, int64_t>>>> input_shape_ranges_;
+  std::unordered_map<std::string, std::unique_ptr<TensorrtEngineBuild>> engine_builds_;
 
   /**Get IndexedSubGraph based on node list of the subgraph*/
   std::unique_ptr<IndexedSubGraph> GetSubGraph(SubGraph_t graph_nodes_index,
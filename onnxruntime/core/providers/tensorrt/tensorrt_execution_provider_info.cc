@@ -27,6 +27,10 @@ constexpr const char* kCachePath = "trt_engine_cache_path";
 constexpr const char* kDecryptionEnable = "trt_engine_decryption_enable";
 constexpr const char* kDecryptionLibPath = "trt_engine_decryption_lib_path";
 constexpr const char* kForceSequentialEngineBuild = "trt_force_sequential_engine_build";
+constexpr const char* kEngineBuildAsync = "trt_engine_build_async";
+constexpr const char* kProfilesMinShapes = "trt_profile_min_shapes";
+constexpr const char* kProfilesMaxShapes = "trt_profile_max_shapes";
+constexpr const char* kProfilesOptShapes = "trt_profile_opt_shapes";
 // add new provider option name here. 
 }  // namespace provider_option_names
 }  // namespace tensorrt 
@@ -64,6 +68,10 @@ TensorrtExecutionProviderInfo TensorrtExecutionProviderInfo::FromProviderOptions
           .AddAssignmentToReference(tensorrt::provider_option_names::kDecryptionEnable, info.engine_decryption_enable)
           .AddAssignmentToReference(tensorrt::provider_option_names::kDecryptionLibPath, info.engine_decryption_lib_path) 
           .AddAssignmentToReference(tensorrt::provider_option_names::kForceSequentialEngineBuild, info.force_sequential_engine_build)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kEngineBuildAsync, info.engine_build_async)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kProfilesMinShapes, info.profile_min_shapes)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kProfilesMaxShapes, info.profile_max_shapes)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kProfilesOptShapes, info.profile_opt_shapes)
           .Parse(options)); // add new provider option here.
 
   return info;
@@ -88,6 +96,10 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const TensorrtE
       {tensorrt::provider_option_names::kDecryptionEnable, MakeStringWithClassicLocale(info.engine_decryption_enable)},
       {tensorrt::provider_option_names::kDecryptionLibPath, MakeStringWithClassicLocale(info.engine_decryption_lib_path)},
       {tensorrt::provider_option_names::kForceSequentialEngineBuild, MakeStringWithClassicLocale(info.force_sequential_engine_build)},
+      {tensorrt::provider_option_names::kEngineBuildAsync, MakeStringWithClassicLocale(info.engine_build_async)},
+      {tensorrt::provider_option_names::kProfilesMinShapes, MakeStringWithClassicLocale(info.profile_min_shapes)},
+      {tensorrt::provider_option_names::kProfilesMaxShapes, MakeStringWithClassicLocale(info.profile_max_shapes)},
+      {tensorrt::provider_option_names::kProfilesOptShapes, MakeStringWithClassicLocale(info.profile_opt_shapes)},
       // add new provider option here.
   };
   return options;
@@ -117,6 +129,11 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const OrtTensor
       {tensorrt::provider_option_names::kDecryptionEnable, MakeStringWithClassicLocale(info.trt_engine_decryption_enable)},
       {tensorrt::provider_option_names::kDecryptionLibPath, kDecryptionLibPath_},
       {tensorrt::provider_option_names::kForceSequentialEngineBuild, MakeStringWithClassicLocale(info.trt_force_sequential_engine_build)},
+      // Not available in the legacy options.
+      {tensorrt::provider_option_names::kEngineBuildAsync, MakeStringWithClassicLocale(false)},
+      {tensorrt::provider_option_names::kProfilesMinShapes, ""},
+      {tensorrt::provider_option_names::kProfilesMaxShapes, ""},
+      {tensorrt::provider_option_names::kProfilesOptShapes, ""},
   };
   return options;
 }
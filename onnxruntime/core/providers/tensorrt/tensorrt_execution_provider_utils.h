@@ -5,6 +5,8 @@
 #include <unordered_map>
 #include <string>
 #include <iostream>
+#include <sstream>
+#include <vector>
 #include <experimental/filesystem>
 #include "flatbuffers/idl.h"
 #include "ort_trt_int8_cal_table.fbs.h"
@@ -150,6 +152,38 @@ std::unordered_map<std::string, std::unordered_map<size_t, std::pair<int64_t, in
   return shape_ranges;
 }
 
+/*
+* Parse the input shapes of explicit optimization profiles
+* Each entry of the comma separated list is an input name and its shape, with the dimensions separated by 'x'.
+* The k-th entry of an input is its shape in the k-th profile. For shape tensor inputs, the shape is the values
+* of the tensor. For example, two profiles of tensor_a and tensor_b,
+*   tensor_a:1x3x224x224,tensor_b:1,tensor_a:8x3x224x224,tensor_b:8
+*/
+bool ParseProfileShapes(const std::string& profile_shapes_string, std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_shapes) {
+  std::istringstream shapes_stream(profile_shapes_string);
+  std::string entry;
+  while (std::getline(shapes_stream, entry, ',')) {
+    // Input names may contain ':', the shape is after the last one
+    const size_t delim = entry.rfind(':');
+    if (delim == std::string::npos || delim == 0 || delim + 1 == entry.size()) {
+      return false;
+    }
+    std::vector<int64_t> shape;
+    std::istringstream dims_stream(entry.substr(delim + 1));
+    std::string dim;
+    while (std::getline(dims_stream, dim, 'x')) {
+      char* end = nullptr;
+      const long long value = std::strtoll(dim.c_str(), &end, 10);
+      if (dim.empty() || *end != '\0' || value < 0) {
+        return false;
+      }
+      shape.push_back(static_cast<int64_t>(value));
+    }
+    profile_shapes[entry.substr(0, delim)].push_back(shape);
+  }
+  return true;
+}
+
 /*
  * Get cache by name
  *
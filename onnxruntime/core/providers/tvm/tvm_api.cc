@@ -28,7 +28,8 @@ TvmModule TVMCompile(const TvmEPOptions& options,
                      const std::string& onnx_txt,
                      const std::string& model_path,
                      int opset,
-                     const TVMTensorShapes& input_shapes)
+                     const TVMTensorShapes& input_shapes,
+                     const std::string& export_dir)
 {
   ::tvm::Array<TvmIntArray> shapes;
   for (size_t i = 0; i < input_shapes.size(); ++i)
@@ -54,7 +55,8 @@ TvmModule TVMCompile(const TvmEPOptions& options,
                              shapes,
                              options.to_nhwc,
                              options.tuning_file_path,
-                             options.tuning_type);
+                             options.tuning_type,
+                             export_dir);
   ORT_ENFORCE(mod.get() != nullptr, "Compiled TVM Module is nullptr!");
   return mod;
 }
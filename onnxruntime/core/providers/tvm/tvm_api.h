@@ -19,7 +19,8 @@ namespace tvm {
                        const std::string& onnx_txt,
                        const std::string& model_path,
                        int opset,
-                       const TVMTensorShapes& input_shapes);
+                       const TVMTensorShapes& input_shapes,
+                       const std::string& export_dir = "");
   TvmModule TVMSoCompile(const TvmEPOptions& options);
 
   void TVMSetInputs(TvmModule& mod, std::vector<size_t>& inds, std::vector<DLTensor>& inputs);
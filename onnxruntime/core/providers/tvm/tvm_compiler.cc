@@ -1,8 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <utility>
 
+#include "core/common/logging/logging.h"
+#include "core/framework/murmurhash3.h"
+#include "core/platform/env.h"
+
 #include "tvm_compiler.h"
 #include "tvm_api.h"
 
@@ -32,15 +39,78 @@ opset_(opset) {
 
 void TVMCompiler::compileTVMModule(const TvmEPOptions& options,
                                    const TVMTensorShapes& input_shapes) {
+  // The compiled module is exported to the cache folder, so that the next sessions load it
+  // instead of compiling the subgraph again. Only the virtual machine executor can be loaded back.
+  std::string export_dir;
+  if (!options.cache_dir.empty()) {
+    if (options.executor == tvm::vm_executor_type) {
+      const std::string entry_dir = options.cache_dir + "/" + getCacheKey(options, input_shapes);
+      if (Env::Default().FolderExists(entry_dir)) {
+        LOGS_DEFAULT(INFO) << "Load compiled TVM module from " << entry_dir;
+        TvmEPOptions cached_options = options;
+        cached_options.so_folder = entry_dir;
+        *mod_ = tvm::TVMSoCompile(cached_options);
+
+        onnx_model_str_.clear();
+        return;
+      }
+      export_dir = entry_dir;
+    } else {
+      LOGS_DEFAULT(WARNING) << "Compiled TVM module cache is only supported by the "
+                            << tvm::vm_executor_type << " executor, ignoring cache_dir";
+    }
+  }
+
   *mod_ = tvm::TVMCompile(options,
                           onnx_model_str_,
                           model_path_,
                           opset_,
-                          input_shapes);
+                          input_shapes,
+                          export_dir);
 
   onnx_model_str_.clear();
 }
 
+std::string TVMCompiler::getCacheKey(const TvmEPOptions& options,
+                                     const TVMTensorShapes& input_shapes) const {
+  std::stringstream key;
+  key << onnx_model_str_ << "\n" <<
+  opset_ << "\n" <<
+  options.executor << "\n" <<
+  options.target << "\n" <<
+  options.target_host << "\n" <<
+  options.opt_level << "\n" <<
+  options.freeze_weights << "\n" <<
+  options.to_nhwc << "\n" <<
+  options.tuning_type << "\n";
+  for (const auto& shape : input_shapes) {
+    for (const auto& dim : shape) {
+      key << dim << " ";
+    }
+    key << "\n";
+  }
+  std::string tuning_file_path = options.tuning_file_path;
+  if (tuning_file_path.empty()) {
+    tuning_file_path = Env::Default().GetEnvironmentVar(env_vars::kAutoTVMTuningLog);
+  }
+  if (!tuning_file_path.empty()) {
+    std::ifstream tuning_file(tuning_file_path, std::ios::binary);
+    if (tuning_file) {
+      key << tuning_file.rdbuf();
+    }
+  }
+
+  const std::string key_str = key.str();
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(key_str.data(), static_cast<int>(key_str.size()), 0, hash);
+
+  std::stringstream hash_str;
+  for (auto part : hash) {
+    hash_str << std::hex << std::setw(8) << std::setfill('0') << part;
+  }
+  return hash_str.str();
+}
+
 void TVMSoCompiler::compileTVMModule(const TvmEPOptions& options,
                                      [[maybe_unused]] const TVMTensorShapes& input_shapes) {
   *mod_ = tvm::TVMSoCompile(options);
@@ -43,6 +43,12 @@ class TVMCompiler : public TVMCompilerBase {
                         const TVMTensorShapes& input_shapes) final;
 
  private:
+  // Returns the name of the entry of the compiled module cache folder for this subgraph. It is a hash of
+  // the subgraph and of everything the compiled module depends on: the compilation options, the input shapes
+  // and the content of the tuning file.
+  std::string getCacheKey(const TvmEPOptions& options,
+                          const TVMTensorShapes& input_shapes) const;
+
   std::string onnx_model_str_;
   std::string model_path_;
   int opset_;
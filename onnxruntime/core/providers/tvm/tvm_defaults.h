@@ -12,6 +12,8 @@ namespace tvm {
 
 namespace env_vars {
 static const std::string kDumpSubgraphs = "ORT_TVM_DUMP_SUBGRAPHS";
+// Tuning file used by the compilation when the tuning_file_path option is not set
+static const std::string kAutoTVMTuningLog = "AUTOTVM_TUNING_LOG";
 }  // namespace env_vars
 
 constexpr const char* default_executor_type = "vm";
@@ -24,11 +24,13 @@ constexpr const char* kFreezeWeights = "freeze_weights";
 constexpr const char* kToNHWC = "to_nhwc";
 constexpr const char* kTuningFilePath = "tuning_file_path";
 constexpr const char* kTuningType = "tuning_type";
+constexpr const char* kCacheDir = "cache_dir";
 constexpr const char* kInputNames = "input_names";
 constexpr const char* kInputShapes = "input_shapes";
 
 static const std::unordered_set<std::string> valid_keys {
   std::string{kExecutor},
+  std::string{kSoFolder},
   std::string{kTarget},
   std::string{kTargetHost},
   std::string{kOptLevel},
@@ -36,6 +38,7 @@ static const std::unordered_set<std::string> valid_keys {
   std::string{kToNHWC},
   std::string{kTuningFilePath},
   std::string{kTuningType},
+  std::string{kCacheDir},
   std::string{kInputNames},
   std::string{kInputShapes}
 };
@@ -120,6 +123,7 @@ TvmEPOptions TvmEPOptionsHelper::FromProviderOptions(const ProviderOptions& pr_o
       .AddAssignmentToReference(tvm::provider_option_names::kToNHWC, options.to_nhwc)
       .AddAssignmentToReference(tvm::provider_option_names::kTuningFilePath, options.tuning_file_path)
       .AddAssignmentToReference(tvm::provider_option_names::kTuningType, options.tuning_type)
+      .AddAssignmentToReference(tvm::provider_option_names::kCacheDir, options.cache_dir)
       .AddAssignmentToReference(tvm::provider_option_names::kInputNames, options.input_names_str)
       .AddAssignmentToReference(tvm::provider_option_names::kInputShapes, options.input_shapes_str)
       .Parse(pr_options));
@@ -253,6 +257,7 @@ std::ostream& operator<<(std::ostream& out, const TvmEPOptions& options) {
   "freeze weights: " << options.freeze_weights << "\n" <<
   "tuning file path: " << options.tuning_file_path << "\n" <<
   "tuning type: " << options.tuning_type << "\n" <<
+  "compiled module cache folder: " << options.cache_dir << "\n" <<
   "convert layout to NHWC: " << options.to_nhwc << "\n" <<
   "input tensor names: " << options.input_names_str << "\n" <<
   "input tensor shapes: " << options.input_shapes_str;
@@ -41,6 +41,7 @@ struct TvmEPOptions {
   bool to_nhwc = false;
   std::string tuning_file_path{""};
   std::string tuning_type{tvm::default_tuning_type};
+  std::string cache_dir{""};
   std::string input_names_str{""};
   std::string input_shapes_str{""};
   TVMInputShapes input_shapes{};
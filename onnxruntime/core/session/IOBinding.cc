@@ -5,9 +5,88 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/utils.h"
 
 namespace onnxruntime {
+
+IOBindingPreparedRun::IOBindingPreparedRun() = default;
+IOBindingPreparedRun::~IOBindingPreparedRun() = default;
+
+bool IOBindingPreparedRun::Matches(const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches,
+                                   const std::vector<OrtDevice>* fetches_device_info) const {
+  if (feeds_fetches_manager == nullptr ||
+      feeds.size() != feeds_info.size() || fetches.size() != fetches_info.size()) {
+    return false;
+  }
+
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    if (!feeds[i].IsTensor()) {
+      return false;
+    }
+    const Tensor& feed = feeds[i].Get<Tensor>();
+    const FeedInfo& info = feeds_info[i];
+    if (feed.DataType() != info.element_type || feed.Location().device != info.device ||
+        feed.Shape() != info.shape) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0, end = fetches.size(); i < end; ++i) {
+    const OrtValue& fetch = fetches[i];
+    const FetchInfo& info = fetches_info[i];
+    if (fetch.IsAllocated() != info.is_allocated) {
+      return false;
+    }
+    if (fetch.IsAllocated()) {
+      if (!fetch.IsTensor() || fetch.Get<Tensor>().Location().device != info.device) {
+        return false;
+      }
+    } else if (fetches_device_info != nullptr && (*fetches_device_info)[i] != info.device) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IOBindingPreparedRun::SetInfo(const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches,
+                                   const std::vector<OrtDevice>* fetches_device_info) {
+  Reset();
+
+  feeds_info.reserve(feeds.size());
+  for (const auto& value : feeds) {
+    if (!value.IsTensor()) {
+      Reset();
+      return false;
+    }
+    const Tensor& feed = value.Get<Tensor>();
+    feeds_info.push_back({feed.DataType(), feed.Shape(), feed.Location().device});
+  }
+
+  fetches_info.reserve(fetches.size());
+  for (size_t i = 0, end = fetches.size(); i < end; ++i) {
+    const OrtValue& fetch = fetches[i];
+    if (fetch.IsAllocated()) {
+      if (!fetch.IsTensor()) {
+        Reset();
+        return false;
+      }
+      fetches_info.push_back({true, fetch.Get<Tensor>().Location().device});
+    } else {
+      fetches_info.push_back({false, fetches_device_info != nullptr ? (*fetches_device_info)[i] : OrtDevice()});
+    }
+  }
+
+  return true;
+}
+
+void IOBindingPreparedRun::Reset() {
+  feeds_fetches_manager.reset();
+  feeds_info.clear();
+  fetches_info.clear();
+}
+
 IOBinding::IOBinding(const SessionState& session_state) : session_state_(session_state) {
 }
 
@@ -16,6 +95,7 @@ common::Status IOBinding::BindInput(const std::string& name, const OrtValue& ml_
 
   auto add_or_replace = [&](const OrtValue& value) {
     if (it.second) {
+      prepared_run_.Reset();
       feed_names_.push_back(name);
       feeds_.push_back(value);
     } else {
@@ -45,6 +125,8 @@ void IOBinding::ClearInputs() {
   mapped_feed_names_.clear();
   feed_names_.clear();
   feeds_.clear();
+  states_.clear();
+  prepared_run_.Reset();
 }
 
 static common::Status SyncProviders(const SessionState::NameNodeInfoMapType& node_info_map,
@@ -91,6 +173,7 @@ common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue
   auto it = mapped_output_names_.emplace(name, output_names_.size());
   size_t index = it.first->second;
   if (it.second) {
+    prepared_run_.Reset();
     output_names_.push_back(name);
     outputs_.push_back(ml_value);
     outputs_device_info_.push_back(device);
@@ -108,6 +191,47 @@ void IOBinding::ClearOutputs() {
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  states_.clear();
+  prepared_run_.Reset();
+}
+
+common::Status IOBinding::BindState(const std::string& input_name, const std::string& output_name,
+                                    const OrtValue& ml_value) {
+  ORT_RETURN_IF_NOT(ml_value.IsAllocated() && ml_value.IsTensor(),
+                    "State bound to input '", input_name, "' must be a pre-allocated tensor.");
+
+  ORT_RETURN_IF_ERROR(BindInput(input_name, ml_value));
+
+  // BindInput copies the value if it isn't where the input is consumed, which would break the aliasing
+  const Tensor& state = ml_value.Get<Tensor>();
+  if (feeds_[mapped_feed_names_[input_name]].Get<Tensor>().DataRaw() != state.DataRaw()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "State bound to input '", input_name,
+                           "' must be allocated on the device the input is consumed on. It is on ",
+                           state.Location().ToString());
+  }
+
+  ORT_RETURN_IF_ERROR(BindOutput(output_name, ml_value));
+
+  states_[input_name] = ml_value;
+  return Status::OK();
+}
+
+common::Status IOBinding::ResetStates() {
+  for (auto& entry : states_) {
+    Tensor& state = *entry.second.GetMutable<Tensor>();
+    if (state.Location().device.Type() == OrtDevice::CPU) {
+      memset(state.MutableDataRaw(), 0, state.SizeInBytes());
+      continue;
+    }
+
+    // zero a tensor on CPU and copy it to the device the state is on
+    auto* cpu_provider = session_state_.GetExecutionProviders().Get(onnxruntime::kCpuExecutionProvider);
+    Tensor zeros(state.DataType(), state.Shape(), cpu_provider->GetAllocator(0, OrtMemTypeDefault));
+    memset(zeros.MutableDataRaw(), 0, zeros.SizeInBytes());
+    ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(zeros, state));
+  }
+
+  return Status::OK();
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
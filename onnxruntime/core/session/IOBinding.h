@@ -15,6 +15,47 @@
 
 namespace onnxruntime {
 class SessionState;
+class FeedsFetchesManager;
+
+/**
+ * The feeds and fetches manager set up by the last Run() of an IOBinding, with the types, shapes and devices
+ * of the feeds and the devices of the fetches it was set up for. The next Run() of the binding with feeds
+ * and fetches that match them reuses it, skipping the validation of the feeds and fetches and the setup of
+ * the manager, which look up the names of the feeds and fetches in the graph.
+ */
+struct IOBindingPreparedRun {
+  struct FeedInfo {
+    MLDataType element_type;
+    TensorShape shape;
+    OrtDevice device;
+  };
+
+  struct FetchInfo {
+    bool is_allocated;
+    OrtDevice device;
+  };
+
+  IOBindingPreparedRun();
+  ~IOBindingPreparedRun();
+
+  // Returns true if the manager was set up for these feeds and fetches.
+  bool Matches(const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches,
+               const std::vector<OrtDevice>* fetches_device_info) const;
+
+  // Records the feeds and fetches of a Run(). Returns false if they can't be matched, e.g. a feed isn't a tensor.
+  bool SetInfo(const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches,
+               const std::vector<OrtDevice>* fetches_device_info);
+
+  void Reset();
+
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager;
+  std::vector<FeedInfo> feeds_info;
+  std::vector<FetchInfo> fetches_info;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBindingPreparedRun);
+};
+
 /**
  * Input/Output binding.
  * Usage is as follows:
@@ -71,6 +112,22 @@ class IOBinding {
    */
   common::Status BindOutput(const std::string& name, OrtDevice device = {});
 
+  /**
+   * Bind a state that is carried over from one Run() to the next, e.g. the hidden state of a streaming RNN.
+   * The pre-allocated tensor @param ml_value is bound as both the input @param input_name and the output
+   * @param output_name, so the output of a Run() is read back in place by the next one without any copies.
+   * The nodes producing the output must support it aliasing the input. The CPU RNN, GRU and LSTM kernels
+   * do for initial_h/Y_h and initial_c/Y_c.
+   * The tensor must already be on the device the input is consumed on as it can't be copied there.
+   * If called again for the same input name will replace the existing state.
+   */
+  common::Status BindState(const std::string& input_name, const std::string& output_name, const OrtValue& ml_value);
+
+  /**
+   * Zero all the states bound with BindState(), e.g. at a stream boundary.
+   */
+  common::Status ResetStates();
+
   /**
    * This simply collects the outputs obtained after calling Run() inside the @param outputs.
    */
@@ -90,6 +147,7 @@ class IOBinding {
 
   /**
    * clear inputs or outputs. IOBinding is stateful. There are cases we need to reset its state.
+   * Either also forgets the states bound with BindState() and the prepared run.
    */
   void ClearOutputs();
   void ClearInputs();
@@ -106,6 +164,10 @@ class IOBinding {
   std::unordered_map<std::string, size_t> mapped_output_names_;
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
+  // the values bound with BindState(), keyed by input name
+  std::unordered_map<std::string, OrtValue> states_;
+  // reused by the Run() calls while the bound names don't change
+  IOBindingPreparedRun prepared_run_;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
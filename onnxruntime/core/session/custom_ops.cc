@@ -70,6 +70,58 @@ ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttribute_string, _In_ const OrtKernel
   return onnxruntime::ToOrtStatus(status);
 }
 
+// ONNXTensorElementDataType has the values of the TensorProto data types
+static void FillTensorView(const onnxruntime::Tensor& tensor, OrtTensorView& view) {
+  const auto dims = tensor.Shape().GetDims();
+  view.data = const_cast<void*>(tensor.DataRaw());
+  view.dims = dims.data();
+  view.num_dims = dims.size();
+  view.element_count = static_cast<size_t>(tensor.Shape().Size());
+  view.type = static_cast<ONNXTensorElementDataType>(tensor.GetElementType());
+}
+
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetInputTensorViews, _In_ const OrtKernelContext* context,
+                    _Out_writes_all_(count) OrtTensorView* views, size_t count) {
+  API_IMPL_BEGIN
+  const auto* ctx = reinterpret_cast<const onnxruntime::OpKernelContextInternal*>(context);
+  if (count > static_cast<size_t>(ctx->InputCount())) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "count is larger than the number of inputs");
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const OrtValue* value = ctx->GetInputMLValue(static_cast<int>(i));
+    if (value == nullptr || !value->IsAllocated()) {
+      views[i] = OrtTensorView{nullptr, nullptr, 0, 0, ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED};
+      continue;
+    }
+    if (!value->IsTensor() || value->Get<onnxruntime::Tensor>().IsDataTypeString()) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Tensor views are only supported for non-string tensors");
+    }
+    FillTensorView(value->Get<onnxruntime::Tensor>(), views[i]);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetOutputTensorViews, _Inout_ OrtKernelContext* context,
+                    _In_reads_(count) const int64_t* const* dims, _In_reads_(count) const size_t* num_dims,
+                    _Out_writes_all_(count) OrtTensorView* views, size_t count) {
+  API_IMPL_BEGIN
+  auto* ctx = reinterpret_cast<onnxruntime::OpKernelContextInternal*>(context);
+  if (count > static_cast<size_t>(ctx->OutputCount())) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "count is larger than the number of outputs");
+  }
+  for (size_t i = 0; i < count; ++i) {
+    onnxruntime::TensorShape shape(dims[i], num_dims[i]);
+    OrtValue* value = ctx->OutputMLValue(static_cast<int>(i), shape);
+    if (value == nullptr || !value->IsTensor() || value->Get<onnxruntime::Tensor>().IsDataTypeString()) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Tensor views are only supported for non-string tensors");
+    }
+    FillTensorView(value->Get<onnxruntime::Tensor>(), views[i]);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetGPUComputeStream, _In_ const OrtKernelContext* context, _Outptr_ void** out) {
   *out = reinterpret_cast<const onnxruntime::OpKernelContext*>(context)->GetComputeStream();
   return nullptr;
@@ -115,6 +167,14 @@ ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttributeArray_int64, _In_ const OrtKe
 #include "core/framework/customregistry.h"
 namespace onnxruntime {
 
+// The optional callbacks at the end of OrtCustomOp only exist from this version on
+static constexpr uint32_t min_ort_version_with_custom_op_prepack_and_shape_inference = 12;
+
+static bool HasPrePackSupport(const OrtCustomOp& op) {
+  return op.version >= min_ort_version_with_custom_op_prepack_and_shape_inference &&
+         op.KernelGetPrePackSize != nullptr && op.KernelPrePack != nullptr && op.KernelUsePrePacked != nullptr;
+}
+
 struct CustomOpKernel : OpKernel {
   CustomOpKernel(const OpKernelInfo& info, const OrtCustomOp& op) : OpKernel(info), op_(op) {
     if (op_.version > ORT_API_VERSION) {
@@ -132,13 +192,116 @@ struct CustomOpKernel : OpKernel {
     return Status::OK();
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
+    is_packed = false;
+    if (!HasPrePackSupport(op_)) {
+      return Status::OK();
+    }
+
+    // The callbacks take the tensor as an OrtValue which must not free it
+    OrtValue input;
+    input.Init(const_cast<Tensor*>(&tensor), DataTypeImpl::GetType<Tensor>(), [](void*) {});
+
+    const size_t packed_size = op_.KernelGetPrePackSize(op_kernel_, &input, static_cast<size_t>(input_idx));
+    if (packed_size == 0) {
+      return Status::OK();
+    }
+
+    auto* packed_data = alloc->Alloc(packed_size);
+    ORT_RETURN_IF(packed_data == nullptr, "Failed to allocate the pre-packed buffer of the custom op ", Info().node().Name());
+    BufferUniquePtr packed_buffer(packed_data, BufferDeleter(std::move(alloc)));
+    op_.KernelPrePack(op_kernel_, &input, static_cast<size_t>(input_idx), packed_buffer.get());
+    is_packed = true;
+
+    if (prepacked_weights != nullptr) {
+      // The container owns the buffer, UseSharedPrePackedBuffers() is called next with it or an identical one
+      prepacked_weights->buffers_.push_back(std::move(packed_buffer));
+      prepacked_weights->buffer_sizes_.push_back(packed_size);
+    } else {
+      op_.KernelUsePrePacked(op_kernel_, static_cast<size_t>(input_idx), packed_buffer.get());
+      packed_buffers_.push_back(std::move(packed_buffer));
+    }
+    return Status::OK();
+  }
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override {
+    used_shared_buffers = false;
+    if (HasPrePackSupport(op_) && prepacked_buffers.size() == 1) {
+      op_.KernelUsePrePacked(op_kernel_, static_cast<size_t>(input_idx), prepacked_buffers[0].get());
+      used_shared_buffers = true;
+    }
+    return Status::OK();
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CustomOpKernel);
 
   const OrtCustomOp& op_;
   void* op_kernel_;
+  // Buffers pre-packed by the kernel that are not shared with other kernels
+  std::vector<BufferUniquePtr> packed_buffers_;
 };
 
+#if !defined(ORT_MINIMAL_BUILD)
+// Shape inference of a custom op through its InferOutputShape callback. The element types of the outputs are set too,
+// as the inferred output type must have one.
+static void InferCustomOpOutputShapes(const OrtCustomOp& op, ONNX_NAMESPACE::InferenceContext& ctx) {
+  const size_t input_count = ctx.getNumInputs();
+  std::vector<std::vector<int64_t>> input_shapes(input_count);
+  std::vector<const int64_t*> input_dims(input_count, nullptr);
+  std::vector<int64_t> input_num_dims(input_count, -1);
+  for (size_t i = 0; i < input_count; ++i) {
+    if (!ONNX_NAMESPACE::hasInputShape(ctx, i)) {
+      continue;
+    }
+    const auto& shape = ONNX_NAMESPACE::getInputShape(ctx, i);
+    for (const auto& dim : shape.dim()) {
+      input_shapes[i].push_back(dim.has_dim_value() ? dim.dim_value() : -1);
+    }
+    input_dims[i] = input_shapes[i].data();
+    input_num_dims[i] = static_cast<int64_t>(input_shapes[i].size());
+  }
+
+  // The dynamic typed outputs take the type of the single dynamic typed input
+  int64_t dynamic_input = -1;
+  for (size_t i = 0; i < input_count && i < op.GetInputTypeCount(&op); ++i) {
+    if (op.GetInputType(&op, i) == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED) {
+      dynamic_input = static_cast<int64_t>(i);
+      break;
+    }
+  }
+
+  constexpr size_t max_num_dims = 16;
+  int64_t output_dims[max_num_dims];
+  for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+    const auto type = op.GetOutputType(&op, i);
+    if (type != ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED) {
+      ONNX_NAMESPACE::updateOutputElemType(ctx, i, static_cast<int32_t>(type));
+    } else if (dynamic_input >= 0 && ctx.getInputType(static_cast<size_t>(dynamic_input)) != nullptr) {
+      ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, static_cast<size_t>(dynamic_input), i);
+    } else {
+      continue;
+    }
+
+    const int64_t rank = op.InferOutputShape(&op, i, input_dims.data(), input_num_dims.data(), input_count,
+                                             output_dims, max_num_dims);
+    if (rank < 0 || static_cast<size_t>(rank) > max_num_dims) {
+      continue;
+    }
+    auto* output_shape = ctx.getOutputType(i)->mutable_tensor_type()->mutable_shape();
+    output_shape->clear_dim();
+    for (int64_t d = 0; d < rank; ++d) {
+      auto* dim = output_shape->add_dim();
+      if (output_dims[d] >= 0) {
+        dim->set_dim_value(output_dims[d]);
+      }
+    }
+  }
+}
+#endif
+
 common::Status CreateCustomRegistry(const std::vector<OrtCustomOpDomain*>& op_domains,
                                     std::shared_ptr<CustomRegistry>& output) {
   output = std::make_shared<CustomRegistry>();
@@ -218,6 +381,12 @@ common::Status CreateCustomRegistry(const std::vector<OrtCustomOpDomain*>& op_do
       schema.SetDomain(domain->domain_);
       schema.SinceVersion(1);
       schema.AllowUncheckedAttributes();
+      if (op->version >= min_ort_version_with_custom_op_prepack_and_shape_inference &&
+          op->InferOutputShape != nullptr) {
+        schema.TypeAndShapeInferenceFunction([op](ONNX_NAMESPACE::InferenceContext& ctx) {
+          InferCustomOpOutputShapes(*op, ctx);
+        });
+      }
       schemas_list.push_back(schema);
     }
 
@@ -0,0 +1,305 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/dynamic_batcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/run_options.h"
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
+
+namespace onnxruntime {
+
+namespace {
+
+size_t NumElements(gsl::span<const int64_t> dims) {
+  return static_cast<size_t>(std::accumulate(dims.begin(), dims.end(), int64_t{1}, std::multiplies<int64_t>()));
+}
+
+// Copy a dense block of shape src_dims into the top-left corner of a dense block of shape dst_dims.
+// The destination is expected to be zero-filled, and every dst_dims[i] >= src_dims[i].
+void CopyPadded(const uint8_t* src, gsl::span<const int64_t> src_dims,
+                uint8_t* dst, gsl::span<const int64_t> dst_dims, size_t element_size) {
+  if (src_dims.size() <= 1) {
+    memcpy(dst, src, NumElements(src_dims) * element_size);
+    return;
+  }
+
+  const size_t src_inner_bytes = NumElements(src_dims.subspan(1)) * element_size;
+  const size_t dst_inner_bytes = NumElements(dst_dims.subspan(1)) * element_size;
+  for (int64_t i = 0; i < src_dims[0]; ++i) {
+    CopyPadded(src + i * src_inner_bytes, src_dims.subspan(1), dst + i * dst_inner_bytes, dst_dims.subspan(1),
+               element_size);
+  }
+}
+
+}  // namespace
+
+DynamicBatcher::DynamicBatcher(InferenceSession& session, const DynamicBatcherOptions& options)
+    : session_(session), options_(options) {
+  ORT_ENFORCE(options_.max_batch_size > 0, "max_batch_size must be greater than 0");
+}
+
+bool DynamicBatcher::IsBatchable(const NameMLValMap& feeds, int64_t& batch_size) const {
+  batch_size = -1;
+  if (feeds.empty()) {
+    return false;
+  }
+
+  for (const auto& feed : feeds) {
+    if (!feed.second.IsTensor()) {
+      return false;
+    }
+
+    const Tensor& tensor = feed.second.Get<Tensor>();
+    if (tensor.Location().device.Type() != OrtDevice::CPU || tensor.IsDataTypeString() ||
+        tensor.Shape().NumDimensions() == 0) {
+      return false;
+    }
+
+    const int64_t dim0 = tensor.Shape()[0];
+    if (dim0 <= 0 || (batch_size != -1 && dim0 != batch_size)) {
+      batch_size = -1;
+      return false;
+    }
+
+    batch_size = dim0;
+  }
+
+  return true;
+}
+
+bool DynamicBatcher::AreCompatible(const Request& a, const Request& b) const {
+  if (*a.output_names != *b.output_names || a.feeds->size() != b.feeds->size()) {
+    return false;
+  }
+
+  for (const auto& feed : *a.feeds) {
+    auto entry = b.feeds->find(feed.first);
+    if (entry == b.feeds->end()) {
+      return false;
+    }
+
+    const Tensor& a_tensor = feed.second.Get<Tensor>();
+    const Tensor& b_tensor = entry->second.Get<Tensor>();
+    if (a_tensor.DataType() != b_tensor.DataType()) {
+      return false;
+    }
+
+    auto a_dims = a_tensor.Shape().GetDims();
+    auto b_dims = b_tensor.Shape().GetDims();
+    if (a_dims.size() != b_dims.size()) {
+      return false;
+    }
+
+    if (options_.padding_policy == BatchPaddingPolicy::kNone &&
+        !std::equal(a_dims.begin() + 1, a_dims.end(), b_dims.begin() + 1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void DynamicBatcher::TakeBatch(std::vector<Request*>& batch) {
+  const Request& first = *queue_.front();
+  size_t num_samples = 0;
+  for (auto it = queue_.begin(); it != queue_.end();) {
+    Request* request = *it;
+    if (num_samples + static_cast<size_t>(request->batch_size) <= options_.max_batch_size &&
+        (request == &first || AreCompatible(first, *request))) {
+      num_samples += static_cast<size_t>(request->batch_size);
+      batch.push_back(request);
+      request->queued = false;
+      it = queue_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  num_queued_samples_ -= num_samples;
+}
+
+common::Status DynamicBatcher::RunBatch(const std::vector<Request*>& batch) {
+  const Request& first = *batch.front();
+  if (batch.size() == 1) {
+    // nothing to coalesce, so avoid the copies
+    return session_.Run(*first.feeds, *first.output_names, first.fetches);
+  }
+
+  AllocatorPtr allocator = session_.GetAllocator(OrtMemoryInfo(CPU, OrtDeviceAllocator));
+  ORT_RETURN_IF_NOT(allocator, "DynamicBatcher requires a CPU allocator in the session");
+
+  std::unique_ptr<IOBinding> io_binding;
+  ORT_RETURN_IF_ERROR(session_.NewIOBinding(&io_binding));
+
+  int64_t total_batch_size = 0;
+  for (const Request* request : batch) {
+    total_batch_size += request->batch_size;
+  }
+
+  for (const auto& feed : *first.feeds) {
+    const std::string& name = feed.first;
+    const Tensor& first_tensor = feed.second.Get<Tensor>();
+
+    // with BatchPaddingPolicy::kPadToMax the non-batch dims are the largest of the batch
+    TensorShapeVector batched_dims = ToShapeVector(first_tensor.Shape().GetDims());
+    bool needs_padding = false;
+    for (const Request* request : batch) {
+      auto dims = request->feeds->at(name).Get<Tensor>().Shape().GetDims();
+      for (size_t i = 1; i < dims.size(); ++i) {
+        if (dims[i] != batched_dims[i]) {
+          needs_padding = true;
+          batched_dims[i] = std::max(batched_dims[i], dims[i]);
+        }
+      }
+    }
+    batched_dims[0] = total_batch_size;
+
+    OrtValue batched_value;
+    Tensor::InitOrtValue(first_tensor.DataType(), TensorShape(batched_dims), allocator, batched_value);
+    Tensor& batched_tensor = *batched_value.GetMutable<Tensor>();
+    auto* dst = static_cast<uint8_t*>(batched_tensor.MutableDataRaw());
+    const size_t element_size = batched_tensor.DataType()->Size();
+
+    if (needs_padding) {
+      memset(dst, 0, batched_tensor.SizeInBytes());
+    }
+
+    const auto dst_sample_dims = gsl::make_span(batched_dims.data(), batched_dims.size()).subspan(1);
+    const size_t dst_sample_bytes = NumElements(dst_sample_dims) * element_size;
+    for (const Request* request : batch) {
+      const Tensor& src_tensor = request->feeds->at(name).Get<Tensor>();
+      const auto* src = static_cast<const uint8_t*>(src_tensor.DataRaw());
+      if (!needs_padding) {
+        memcpy(dst, src, src_tensor.SizeInBytes());
+      } else {
+        const auto src_sample_dims = src_tensor.Shape().GetDims().subspan(1);
+        const size_t src_sample_bytes = NumElements(src_sample_dims) * element_size;
+        for (int64_t i = 0; i < request->batch_size; ++i) {
+          CopyPadded(src + i * src_sample_bytes, src_sample_dims, dst + i * dst_sample_bytes, dst_sample_dims,
+                     element_size);
+        }
+      }
+
+      dst += request->batch_size * dst_sample_bytes;
+    }
+
+    ORT_RETURN_IF_ERROR(io_binding->BindInput(name, batched_value));
+  }
+
+  // bind to CPU so the outputs can be split regardless of the execution provider producing them
+  for (const auto& output_name : *first.output_names) {
+    ORT_RETURN_IF_ERROR(io_binding->BindOutput(output_name, OrtDevice()));
+  }
+
+  RunOptions run_options;
+  run_options.run_tag = "DynamicBatcher";
+  ORT_RETURN_IF_ERROR(session_.Run(run_options, *io_binding));
+
+  const std::vector<OrtValue>& outputs = io_binding->GetOutputs();
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    const auto& output_name = (*first.output_names)[i];
+    ORT_RETURN_IF_NOT(outputs[i].IsTensor(), "DynamicBatcher: output ", output_name, " is not a tensor");
+    const Tensor& tensor = outputs[i].Get<Tensor>();
+    ORT_RETURN_IF_NOT(!tensor.IsDataTypeString() && tensor.Shape().NumDimensions() > 0 &&
+                          tensor.Shape()[0] == total_batch_size,
+                      "DynamicBatcher: output ", output_name, " with shape ", tensor.Shape(),
+                      " cannot be split along a batch dimension of ", total_batch_size);
+  }
+
+  std::vector<size_t> offsets(outputs.size(), 0);
+  for (Request* request : batch) {
+    std::vector<OrtValue>& fetches = *request->fetches;
+    fetches.resize(outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      const Tensor& batched_output = outputs[i].Get<Tensor>();
+      TensorShapeVector dims = ToShapeVector(batched_output.Shape().GetDims());
+      dims[0] = request->batch_size;
+
+      OrtValue value;
+      Tensor::InitOrtValue(batched_output.DataType(), TensorShape(dims), allocator, value);
+      Tensor& tensor = *value.GetMutable<Tensor>();
+      memcpy(tensor.MutableDataRaw(), static_cast<const uint8_t*>(batched_output.DataRaw()) + offsets[i],
+             tensor.SizeInBytes());
+      offsets[i] += tensor.SizeInBytes();
+      fetches[i] = std::move(value);
+    }
+  }
+
+  return Status::OK();
+}
+
+common::Status DynamicBatcher::Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
+                                   std::vector<OrtValue>& fetches) {
+  int64_t batch_size = -1;
+  if (!IsBatchable(feeds, batch_size) || static_cast<size_t>(batch_size) >= options_.max_batch_size) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++stats_.num_requests;
+      ++stats_.num_unbatched_requests;
+    }
+
+    return session_.Run(feeds, output_names, &fetches);
+  }
+
+  Request request{&feeds, &output_names, &fetches, batch_size, std::chrono::steady_clock::now()};
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  queue_.push_back(&request);
+  num_queued_samples_ += static_cast<size_t>(batch_size);
+  ++stats_.num_requests;
+  cv_.notify_all();
+
+  while (!request.done) {
+    // only a caller whose request is still queued leads, so the queue is never empty for the leader.
+    // every queued request has a waiting caller, so the remaining ones get a new leader once this one is done.
+    if (leader_active_ || !request.queued) {
+      cv_.wait(lock);
+      continue;
+    }
+
+    leader_active_ = true;
+    const auto deadline = queue_.front()->enqueue_time + options_.max_queue_delay;
+    cv_.wait_until(lock, deadline, [this]() { return num_queued_samples_ >= options_.max_batch_size; });
+
+    std::vector<Request*> batch;
+    TakeBatch(batch);
+    leader_active_ = false;
+    cv_.notify_all();
+
+    lock.unlock();
+    Status status = RunBatch(batch);
+    lock.lock();
+
+    size_t num_samples = 0;
+    for (Request* batched_request : batch) {
+      num_samples += static_cast<size_t>(batched_request->batch_size);
+      batched_request->status = status;
+      batched_request->done = true;
+    }
+
+    ++stats_.num_batches;
+    stats_.num_samples += num_samples;
+    stats_.last_fill_ratio = static_cast<float>(num_samples) / static_cast<float>(options_.max_batch_size);
+    LOGS(*session_.GetLogger(), VERBOSE) << "DynamicBatcher ran " << batch.size() << " requests with "
+                                         << num_samples << " samples. Fill ratio: " << stats_.last_fill_ratio;
+
+    cv_.notify_all();
+  }
+
+  return request.status;
+}
+
+DynamicBatcherStats DynamicBatcher::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace onnxruntime
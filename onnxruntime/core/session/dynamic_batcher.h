@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+/**
+ * How requests whose inputs differ in a dimension other than the batch dimension are handled.
+ */
+enum class BatchPaddingPolicy {
+  // Only requests whose inputs have identical non-batch dimensions are batched together.
+  kNone,
+  // Ragged non-batch dimensions are padded with zeros to the largest value in the batch. Outputs keep the
+  // padded shape, so this is only useful for models that tolerate zero padding (e.g. masked sequence models).
+  kPadToMax,
+};
+
+struct DynamicBatcherOptions {
+  // Maximum number of samples (sum of dim 0 of the requests) in a batch.
+  size_t max_batch_size = 8;
+  // Maximum time the first request of a batch waits for more requests before the batch is run.
+  std::chrono::microseconds max_queue_delay{1000};
+  BatchPaddingPolicy padding_policy = BatchPaddingPolicy::kNone;
+};
+
+struct DynamicBatcherStats {
+  size_t num_batches = 0;
+  size_t num_requests = 0;
+  // Requests that could not be batched (e.g. non-CPU or string inputs) and were run on their own.
+  size_t num_unbatched_requests = 0;
+  size_t num_samples = 0;
+  // Fill ratio (samples / max_batch_size) of the most recent batch.
+  float last_fill_ratio = 0.f;
+
+  float AverageFillRatio(size_t max_batch_size) const {
+    return num_batches == 0 ? 0.f
+                            : static_cast<float>(num_samples) / static_cast<float>(num_batches * max_batch_size);
+  }
+};
+
+/**
+ * Coalesces concurrent single or small-batch requests to an InferenceSession into one run.
+ *
+ * Requests are concatenated along dim 0 of every input, run once through an IOBinding with the outputs bound to
+ * CPU, and the outputs are split back along dim 0. Every output of the model must therefore have the batch as dim 0.
+ * No extra thread is created: the first waiting caller leads the batch, waits up to max_queue_delay for it to
+ * fill, runs it and hands the results to the other callers.
+ *
+ * Only CPU tensors of non-string types are batched. Other requests are passed to InferenceSession::Run directly.
+ */
+class DynamicBatcher {
+ public:
+  DynamicBatcher(InferenceSession& session, const DynamicBatcherOptions& options);
+
+  /**
+   * Run a request, possibly as part of a larger batch. Blocks until the results are available.
+   * Thread-safe.
+   */
+  common::Status Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
+                     std::vector<OrtValue>& fetches) ORT_MUST_USE_RESULT;
+
+  DynamicBatcherStats GetStats() const;
+
+  const DynamicBatcherOptions& GetOptions() const noexcept { return options_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DynamicBatcher);
+
+  struct Request {
+    const NameMLValMap* feeds;
+    const std::vector<std::string>* output_names;
+    std::vector<OrtValue>* fetches;
+    int64_t batch_size;
+    std::chrono::steady_clock::time_point enqueue_time;
+    common::Status status;
+    bool queued = true;
+    bool done = false;
+  };
+
+  // Returns false and sets batch_size to -1 if the request cannot be batched.
+  bool IsBatchable(const NameMLValMap& feeds, int64_t& batch_size) const;
+  bool AreCompatible(const Request& a, const Request& b) const;
+
+  // Moves the requests forming the next batch from the front of queue_ into batch. Requires mutex_.
+  void TakeBatch(std::vector<Request*>& batch);
+  common::Status RunBatch(const std::vector<Request*>& batch);
+
+  InferenceSession& session_;
+  const DynamicBatcherOptions options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request*> queue_;
+  size_t num_queued_samples_ = 0;
+  bool leader_active_ = false;
+  DynamicBatcherStats stats_;
+};
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/session/environment.h"
 #include "core/session/allocator_adapters.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/huge_page_allocator.h"
 #include "core/graph/constants.h"
 #include "core/graph/op.h"
 
@@ -126,6 +127,12 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
   create_arena = false;
 #endif
 
+  const int use_huge_pages = arena_cfg ? arena_cfg->use_huge_pages : -1;
+  if (!(use_huge_pages == -1 || use_huge_pages == 0 || use_huge_pages == 1)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Received invalid value for use_huge_pages. Valid values can be either 0, 1 or -1.");
+  }
+
   AllocatorPtr allocator_ptr;
   // create appropriate DeviceAllocatorRegistrationInfo and allocator based on create_arena
   if (create_arena) {
@@ -135,6 +142,9 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
     int initial_chunk_size_bytes = -1;
     int max_dead_bytes_per_chunk = -1;
     int initial_growth_chunk_size_bytes = -1;
+    int max_thread_local_cache_bytes = -1;
+    int shrink_idle_time_ms = -1;
+    int shrink_watermark_percent = -1;
 
     // override with values from the user supplied arena_cfg object
     if (arena_cfg) {
@@ -151,19 +161,30 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
       initial_chunk_size_bytes = arena_cfg->initial_chunk_size_bytes;
       max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
       initial_growth_chunk_size_bytes = arena_cfg->initial_growth_chunk_size_bytes;
+      max_thread_local_cache_bytes = arena_cfg->max_thread_local_cache_bytes;
+      shrink_idle_time_ms = arena_cfg->shrink_idle_time_ms;
+      shrink_watermark_percent = arena_cfg->shrink_watermark_percent;
     }
 
     OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
-                            initial_growth_chunk_size_bytes};
+                            initial_growth_chunk_size_bytes, max_thread_local_cache_bytes, shrink_idle_time_ms,
+                            shrink_watermark_percent, use_huge_pages};
+    AllocatorFactory device_alloc_factory = [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); };
+    if (use_huge_pages == 1) {
+      device_alloc_factory = [mem_info](int) { return std::make_unique<HugePageCPUAllocator>(mem_info); };
+    }
     AllocatorCreationInfo alloc_creation_info{
-        [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
+        device_alloc_factory,
         0,
         create_arena,
         l_arena_cfg};
     allocator_ptr = CreateAllocator(alloc_creation_info);
   } else {
-    AllocatorCreationInfo alloc_creation_info{[](int) { return std::make_unique<CPUAllocator>(); },
-                                              0, create_arena};
+    AllocatorFactory device_alloc_factory = [](int) { return std::make_unique<CPUAllocator>(); };
+    if (use_huge_pages == 1) {
+      device_alloc_factory = [](int) { return std::make_unique<HugePageCPUAllocator>(); };
+    }
+    AllocatorCreationInfo alloc_creation_info{device_alloc_factory, 0, create_arena};
     allocator_ptr = CreateAllocator(alloc_creation_info);
   }
 
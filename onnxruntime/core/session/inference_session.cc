@@ -4,6 +4,8 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <sstream>
 #include <unordered_set>
@@ -14,6 +16,7 @@
 #include "core/common/denormal.h"
 #include "core/common/logging/logging.h"
 #include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/ort_format_version.h"
 #include "core/framework/bfc_arena.h"
@@ -27,6 +30,7 @@
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/session_state_flatbuffers_utils.h"
 #include "core/framework/TensorSeq.h"
+#include "core/framework/tensor_compression.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/op_kernel_context_internal.h"
@@ -38,6 +42,7 @@
 #include "core/optimizer/graph_transformer_utils.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/optimizer/mixed_precision_transformer.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/selectors_actions/selector_action_transformer_apply_contexts.h"
 #include "core/optimizer/transformer_memcpy.h"
@@ -55,6 +60,9 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/optimized_model_cache.h"
+#include "core/session/run_result_cache.h"
+#include "core/session/shape_specializer.h"
 #include "core/util/protobuf_parsing_utils.h"
 #include "core/util/thread_utils.h"
 
@@ -158,6 +166,32 @@ Status GetMinimalBuildOptimizationHandling(
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+// Key of the CUDA graph captured for the given feeds and fetches, from their shapes and addresses, which the
+// captured graph reads and writes on replay.
+size_t GetGraphCaptureKey(const std::vector<OrtValue>& feeds, const std::vector<OrtValue>* p_fetches) {
+  size_t key = 0;
+  auto combine = [&key](size_t value) { key ^= value + 0x9e3779b9 + (key << 6) + (key >> 2); };
+  auto add_values = [&combine](const std::vector<OrtValue>& values) {
+    combine(values.size());
+    for (const auto& value : values) {
+      if (!value.IsAllocated() || !value.IsTensor()) {
+        combine(0);
+        continue;
+      }
+      const auto& tensor = value.Get<Tensor>();
+      combine(std::hash<const void*>{}(tensor.DataRaw()));
+      for (int64_t dim : tensor.Shape().GetDims()) {
+        combine(std::hash<int64_t>{}(dim));
+      }
+    }
+  };
+  add_values(feeds);
+  if (p_fetches != nullptr) {
+    add_values(*p_fetches);
+  }
+  return key;
+}
+
 }  // namespace
 
 std::atomic<uint32_t> InferenceSession::global_session_id_{1};
@@ -267,6 +301,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 
   if (use_per_session_threads_) {
     LOGS(*session_logger_, INFO) << "Creating and using per session threadpools since use_per_session_threads_ is true";
+    const int numa_node =
+        std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigNumaNode, "-1"));
     {
       if (!external_intra_op_thread_pool_)
       {
@@ -287,8 +323,11 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                               session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                               to.affinity_vec_len == 0;
         to.allow_spinning = allow_intra_op_spinning;
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpAdaptiveSpinning, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
+        to.numa_node = numa_node;
 
         // Set custom threading functions
         to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
@@ -321,7 +360,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.name = inter_thread_pool_name_.c_str();
         to.set_denormal_as_zero = set_denormal_as_zero;
         to.allow_spinning = allow_inter_op_spinning;
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigInterOpAdaptiveSpinning, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
+        to.numa_node = numa_node;
 
         // Set custom threading functions
         to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
@@ -346,9 +388,22 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
     ORT_ENFORCE(session_env.EnvCreatedWithGlobalThreadPools(),
                 "When the session is not configured to use per session"
                 " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
+
+    const int max_degree_of_parallelism = std::stoi(session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigGlobalIntraOpMaxDegreeOfParallelism, "0"));
+    const int share_weight = std::stoi(session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigGlobalIntraOpShareWeight, "0"));
+    if (intra_op_thread_pool_from_env_ && (max_degree_of_parallelism > 0 || share_weight > 0)) {
+      LOGS(*session_logger_, INFO) << "Limiting the global intra op threadpool to a degree of parallelism of "
+                                   << max_degree_of_parallelism << " with a share weight of " << share_weight;
+      intra_op_thread_pool_view_ = std::make_unique<concurrency::ThreadPool>(
+          intra_op_thread_pool_from_env_, max_degree_of_parallelism, share_weight);
+    }
   }
 
   session_profiler_.Initialize(session_logger_);
+  session_profiler_.EnableHardwareCounters(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingHardwareCounters, "0") == "1");
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
@@ -450,6 +505,24 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  if (parallel_for_tuner_ && parallel_for_tuner_->GetNumberOfTunedLoops() > 0) {
+    auto status = parallel_for_tuner_->Save(parallel_for_tuning_file_);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to save the parallel for tuning file: " << status.ErrorMessage();
+    }
+  }
+
+  if (intra_op_thread_pool_view_) {
+    const auto usage = concurrency::ThreadPool::GetUsageStats(intra_op_thread_pool_view_.get());
+    LOGS(*session_logger_, INFO) << "Usage of the global intra op threadpool: " << usage.num_parallel_loops
+                                 << " parallel loops with an average degree of parallelism of "
+                                 << (usage.num_parallel_loops == 0
+                                         ? 0.0
+                                         : static_cast<double>(usage.total_degree_of_parallelism) /
+                                               static_cast<double>(usage.num_parallel_loops))
+                                 << ", " << usage.thread_microseconds << " thread microseconds";
+  }
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -603,10 +676,16 @@ common::Status InferenceSession::SaveToOrtFormat(const std::basic_string<ORTCHAR
   fbs_buffer_size = ((fbs_buffer_size + m_bytes - 1) / m_bytes) * m_bytes;
   flatbuffers::FlatBufferBuilder builder(fbs_buffer_size);
 
+  TensorCompression initializer_compression;
+  ORT_RETURN_IF_ERROR(utils::ParseTensorCompression(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOrtFormatInitializerCompression,
+                                                         "none"),
+      initializer_compression));
+
   auto ort_model_version = builder.CreateString(kOrtModelVersion);
   flatbuffers::Offset<fbs::Model> model;
   ORT_RETURN_IF_ERROR(
-      model_->SaveToOrtFormat(builder, model));
+      model_->SaveToOrtFormat(builder, model, initializer_compression));
 
   flatbuffers::Offset<fbs::SessionState> session_state;
   ORT_RETURN_IF_ERROR(
@@ -627,6 +706,7 @@ common::Status InferenceSession::SaveToOrtFormat(const std::basic_string<ORTCHAR
     int size = builder.GetSize();
     file.write(reinterpret_cast<const char*>(buf), size);
     file.close();
+    ORT_RETURN_IF(file.fail(), "Failed to write the ORT format model to ", ToUTF8String(filepath));
   }
 
   return Status::OK();
@@ -910,6 +990,42 @@ common::Status InferenceSession::Load() {
   return Load(loader, "model_loading_from_saved_proto");
 }
 
+static Status CreateMixedPrecisionTransformer(const SessionOptions& session_options,
+                                              const KernelRegistryManager& kernel_registry_manager,
+                                              std::unique_ptr<MixedPrecisionTransformer>& transformer) {
+  const auto& config_options = session_options.config_options;
+  const std::string mixed_precision = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMixedPrecision, "");
+  if (mixed_precision.empty()) {
+    return Status::OK();
+  }
+
+  ONNX_NAMESPACE::TensorProto_DataType target_type;
+  if (mixed_precision == "fp16") {
+    target_type = ONNX_NAMESPACE::TensorProto_DataType_FLOAT16;
+  } else if (mixed_precision == "bf16") {
+    target_type = ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16;
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", kOrtSessionOptionsConfigMixedPrecision,
+                           ": ", mixed_precision, ". Supported values are fp16 and bf16.");
+  }
+
+  const auto get_op_types = [&config_options](const char* config_key) {
+    const std::string op_types = config_options.GetConfigOrDefault(config_key, "");
+    InlinedHashSet<std::string> result;
+    for (const auto op_type : utils::SplitString(op_types, ",")) {
+      result.emplace(op_type);
+    }
+
+    return result;
+  };
+
+  transformer = std::make_unique<MixedPrecisionTransformer>(
+      target_type, kernel_registry_manager,
+      get_op_types(kOrtSessionOptionsConfigMixedPrecisionAllowOps),
+      get_op_types(kOrtSessionOptionsConfigMixedPrecisionDenyOps));
+  return Status::OK();
+}
+
 common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
                                                 const onnxruntime::GraphTransformerManager& graph_transformer_mgr,
                                                 const ExecutionProviders& providers,
@@ -953,11 +1069,36 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
                                          : GraphPartitioner::Mode::kNormal;
 
   // Do partitioning based on execution providers' capability.
-  GraphPartitioner partitioner(kernel_registry_manager, providers);
+  TimePoint tp;
+  if (session_profiler_.IsEnabled()) {
+    tp = session_profiler_.Start();
+  }
+
+  // leave the nodes to the CPU where copying their values to and from another device is estimated to cost more than
+  // the faster kernels on it save.
+  std::unique_ptr<PartitioningCostModel> cost_model;
+  const auto& config_options = session_options_.config_options;
+  if (config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCostAwarePartitioning, "0") == "1") {
+    cost_model = std::make_unique<PartitioningCostModel>();
+    const std::string profiles = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPartitioningProfile, "");
+    std::istringstream profile_files(profiles);
+    for (std::string profile_file; std::getline(profile_files, profile_file, ';');) {
+      if (!profile_file.empty()) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(
+            inference_session_utils::LoadKernelTimesFromProfile(ToPathString(profile_file), *cost_model));
+      }
+    }
+  }
+
+  GraphPartitioner partitioner(kernel_registry_manager, providers, cost_model.get());
   ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph,
                                                        session_state.GetMutableFuncMgr(),
                                                        layout_transformer::TransformLayoutForCompilingEP, mode));
 
+  if (session_profiler_.IsEnabled()) {
+    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_partitioning", tp);
+  }
+
   // apply transformers except default transformers
   // Default transformers are required for correctness and they are owned and run by inference session
   for (int i = static_cast<int>(TransformerLevel::Level1); i <= static_cast<int>(TransformerLevel::MaxLevel); i++) {
@@ -966,6 +1107,16 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
   }
 
   bool modified = false;
+
+  // Convert to mixed precision. This runs after partitioning as it requires the execution providers of the nodes,
+  // and before inserting cast nodes so that converted nodes without a lower precision kernel fall back to float.
+  std::unique_ptr<MixedPrecisionTransformer> mixed_precision_transformer;
+  ORT_RETURN_IF_ERROR_SESSIONID_(CreateMixedPrecisionTransformer(session_options_, kernel_registry_manager,
+                                                                mixed_precision_transformer));
+  if (mixed_precision_transformer) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(mixed_precision_transformer->Apply(graph, modified, *session_logger_));
+  }
+
   // Insert cast node/s.
   ORT_RETURN_IF_ERROR_SESSIONID_(insert_cast_transformer.Apply(graph, modified, *session_logger_));
 
@@ -982,15 +1133,25 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+// Reads the bytes of the ORT format model at model_uri into bytes_data_holder, or memory maps them into
+// mapped_bytes_holder if map_file is true. The file is read if it can't be mapped.
 template <typename T>
 static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
                                 std::basic_string<ORTCHAR_T>& model_location,
                                 gsl::span<const uint8_t>& bytes,
-                                std::vector<uint8_t>& bytes_data_holder) {
+                                std::vector<uint8_t>& bytes_data_holder,
+                                bool map_file,
+                                Env::MappedMemoryPtr& mapped_bytes_holder) {
   size_t num_bytes = 0;
   model_location = ToWideString(model_uri);
   ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_location.c_str(), num_bytes));
 
+  if (map_file && num_bytes > 0 &&
+      Env::Default().MapFileIntoMemory(model_location.c_str(), 0, num_bytes, mapped_bytes_holder).IsOK()) {
+    bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_bytes_holder.get()), num_bytes);
+    return Status::OK();
+  }
+
   bytes_data_holder.resize(num_bytes);
 
   std::ifstream bytes_stream(model_uri, std::ifstream::in | std::ifstream::binary);
@@ -1012,7 +1173,8 @@ Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
       [&]() {
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_uri, model_location_,
-                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                              UseOrtModelBytesForInitializers(), ort_format_model_mapped_bytes_));
         return Status::OK();
       });
 }
@@ -1023,7 +1185,8 @@ Status InferenceSession::LoadOrtModel(const std::wstring& model_uri) {
       [&]() {
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_uri, model_location_,
-                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                              UseOrtModelBytesForInitializers(), ort_format_model_mapped_bytes_));
         return Status::OK();
       });
 }
@@ -1066,7 +1229,19 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
   }
 
   ORT_RETURN_IF_ERROR(load_ort_format_model_bytes());
+  ORT_RETURN_IF_ERROR(LoadOrtModelFromBytes());
+
+  is_model_loaded_ = true;
 
+  return Status::OK();
+}
+
+bool InferenceSession::UseOrtModelBytesForInitializers() const {
+  return session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers,
+                                                            "0") == "1";
+}
+
+Status InferenceSession::LoadOrtModelFromBytes() {
   // Verify the ort_format_model_bytes_ is a valid InferenceSessionBuffer before we access the data
   flatbuffers::Verifier verifier(ort_format_model_bytes_.data(), ort_format_model_bytes_.size());
   ORT_RETURN_IF_NOT(fbs::VerifyInferenceSessionBuffer(verifier), "ORT model verification failed.");
@@ -1089,24 +1264,160 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
 #if !defined(ORT_MINIMAL_BUILD)
   ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model,
                                                HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                                               *session_logger_, tmp_model));
+                                               *session_logger_, tmp_model, UseOrtModelBytesForInitializers()));
 
 #else
-  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, *session_logger_, tmp_model));
+  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, *session_logger_, tmp_model,
+                                               UseOrtModelBytesForInitializers()));
 #endif
 
+  const auto* fbs_sess_state = fbs_session->session_state();
+  ORT_RETURN_IF(nullptr == fbs_sess_state, "SessionState is null. Invalid ORT format model.");
+
   ORT_RETURN_IF_ERROR(SaveModelMetadata(*tmp_model));
   model_ = std::move(tmp_model);
 
-  // Initialize takes the session_mutex_ as well so we need to have released it prior to calling this
-  const auto* fbs_sess_state = fbs_session->session_state();
-  ORT_RETURN_IF(nullptr == fbs_sess_state, "SessionState is null. Invalid ORT format model.");
+  return Status::OK();
+}
 
-  is_model_loaded_ = true;
+#if !defined(ORT_MINIMAL_BUILD)
+Status InferenceSession::LoadOptimizedModelFromCache(bool have_cpu_ep) {
+  const std::string cache_dir = session_options_.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsConfigOptimizedModelCacheDir, "");
+  if (cache_dir.empty() || !ort_format_model_bytes_.empty()) {
+    return Status::OK();
+  }
+
+  bool has_external_initializers = false;
+#if !defined(DISABLE_EXTERNAL_INITIALIZERS)
+  has_external_initializers = !session_options_.external_initializers.empty();
+#endif
+  if (!session_options_.optimized_model_filepath.empty() || !session_options_.initializers_to_share_map.empty() ||
+      has_external_initializers) {
+    LOGS(*session_logger_, INFO) << "Not using the optimized model cache as the session saves the optimized model "
+                                    "or has shared or external initializers.";
+    return Status::OK();
+  }
+
+  // the default CPU EP is registered after this point
+  std::vector<std::string> execution_provider_ids = execution_providers_.GetIds();
+  if (!have_cpu_ep) {
+    execution_provider_ids.push_back(kCpuExecutionProvider);
+  }
 
+  const PathString cache_dir_path = ToPathString(cache_dir);
+  PathString cache_file_path;
+  ORT_RETURN_IF_ERROR(optimized_model_cache::GetCacheFilePath(cache_dir_path, *model_, model_location_,
+                                                              session_options_, optimizers_to_disable_,
+                                                              execution_provider_ids, cache_file_path));
+
+  size_t file_size = 0;
+  if (Env::Default().GetFileLength(cache_file_path.c_str(), file_size).IsOK() && file_size > 0) {
+    // keep model_location_ pointing at the original model
+    PathString cache_file_location;
+    Status status = LoadOrtModelBytes(cache_file_path, cache_file_location,
+                                      ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                                      UseOrtModelBytesForInitializers(), ort_format_model_mapped_bytes_);
+    if (status.IsOK()) {
+      status = LoadOrtModelFromBytes();
+    }
+
+    if (status.IsOK()) {
+      LOGS(*session_logger_, INFO) << "Loaded the optimized model from cache file " << ToUTF8String(cache_file_path);
+      return Status::OK();
+    }
+
+    LOGS(*session_logger_, WARNING) << "Ignoring optimized model cache file " << ToUTF8String(cache_file_path) << ": "
+                                    << status.ErrorMessage() << ". It will be replaced.";
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    ort_format_model_mapped_bytes_.reset();
+  }
+
+  optimized_model_cache_path_ = cache_file_path;
   return Status::OK();
 }
 
+Status InferenceSession::CreateShapeSpecializer(bool have_cpu_ep) {
+  const auto& config_options = session_options_.config_options;
+  const std::string max_sessions_config =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShapeSpecializationMaxSessions, "0");
+  size_t max_sessions = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(max_sessions_config, max_sessions),
+                    "Invalid value for ", kOrtSessionOptionsConfigShapeSpecializationMaxSessions, ": ",
+                    max_sessions_config);
+  if (max_sessions == 0) {
+    return Status::OK();
+  }
+
+  const std::string min_runs_config =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShapeSpecializationMinRuns, "10");
+  size_t min_runs = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(min_runs_config, min_runs),
+                    "Invalid value for ", kOrtSessionOptionsConfigShapeSpecializationMinRuns, ": ", min_runs_config);
+
+  // the specialized sessions create their own CPU execution provider, and can't recreate other execution providers
+  // or custom ops
+  const size_t num_user_providers = execution_providers_.NumProviders() - (have_cpu_ep ? 1 : 0);
+  if (!ort_format_model_bytes_.empty() || num_user_providers > 0 || HasLocalSchema()) {
+    LOGS(*session_logger_, INFO) << "Not specializing the session for input shapes as the model is in ORT format, "
+                                    "or the session has execution providers other than CPU or custom ops.";
+    return Status::OK();
+  }
+
+  std::unordered_map<std::string, std::vector<std::string>> input_dim_params;
+  bool has_dim_params = false;
+  for (const NodeArg* input : model_->MainGraph().GetInputs()) {
+    const auto* shape = input->Shape();
+    if (shape == nullptr) {
+      continue;
+    }
+
+    auto& dim_params = input_dim_params[input->Name()];
+    for (const auto& dim : shape->dim()) {
+      dim_params.push_back(utils::HasDimParam(dim) ? dim.dim_param() : std::string());
+      has_dim_params = has_dim_params || !dim_params.back().empty();
+    }
+  }
+
+  if (!has_dim_params) {
+    return Status::OK();
+  }
+
+  // the specialized sessions load the original model, from its file so that external data is found
+  std::shared_ptr<const ONNX_NAMESPACE::ModelProto> model_proto;
+  if (model_location_.empty()) {
+    model_proto = std::make_shared<const ONNX_NAMESPACE::ModelProto>(model_->ToProto());
+  }
+
+  SessionOptions specialized_options = session_options_;
+  specialized_options.session_logid += "_specialized";
+  specialized_options.enable_profiling = false;
+  specialized_options.optimized_model_filepath.clear();
+  specialized_options.config_options.configurations.erase(kOrtSessionOptionsConfigShapeSpecializationMaxSessions);
+  specialized_options.config_options.configurations.erase(kOrtSessionOptionsConfigOptimizedModelCacheDir);
+
+  auto create_session = [this, specialized_options, model_proto](
+                            const std::vector<FreeDimensionOverride>& overrides,
+                            std::unique_ptr<InferenceSession>& session) {
+    SessionOptions options = specialized_options;
+    options.free_dimension_overrides.insert(options.free_dimension_overrides.end(),
+                                            overrides.begin(), overrides.end());
+
+    auto specialized = std::make_unique<InferenceSession>(options, environment_, GetIntraOpThreadPoolToUse(),
+                                                          GetInterOpThreadPoolToUse());
+    ORT_RETURN_IF_ERROR(model_proto ? specialized->Load(*model_proto) : specialized->Load(model_location_));
+    ORT_RETURN_IF_ERROR(specialized->Initialize());
+    session = std::move(specialized);
+    return Status::OK();
+  };
+
+  shape_specializer_ = std::make_unique<ShapeSpecializer>(std::move(input_dim_params), max_sessions, min_runs,
+                                                          std::move(create_session), *session_logger_);
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 bool InferenceSession::IsInitialized() const {
   std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
   return is_inited_;
@@ -1256,6 +1567,11 @@ common::Status InferenceSession::Initialize() {
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    ORT_RETURN_IF_ERROR_SESSIONID_(CreateShapeSpecializer(have_cpu_ep));
+    ORT_RETURN_IF_ERROR_SESSIONID_(LoadOptimizedModelFromCache(have_cpu_ep));
+#endif
+
     // Verify that there are no external initializers in the graph if external data is disabled.
     onnxruntime::Graph& graph = model_->MainGraph();
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
@@ -1272,7 +1588,10 @@ common::Status InferenceSession::Initialize() {
     // RegisterExecutionProvider locks the session_mutex_ so we can't be holding it when we call that
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
-      CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena,
+                                   session_options_.config_options.GetConfigOrDefault(
+                                       kOrtSessionOptionsConfigUseHugePagesForCpuAllocator, "0") == "1"};
+      epi.numa_node = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigNumaNode, "-1"));
       auto p_cpu_exec_provider = std::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
     }
@@ -1325,6 +1644,35 @@ common::Status InferenceSession::Initialize() {
         session_options_.enable_mem_reuse,
         prepacked_weights_container_);
 
+    MemoryPatternCacheOptions mem_pattern_cache_options;
+    const std::string bucket_size_config = session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigMemoryPatternShapeBucketSize, "0");
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(bucket_size_config, mem_pattern_cache_options.shape_bucket_size) &&
+                          mem_pattern_cache_options.shape_bucket_size >= 0,
+                      "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternShapeBucketSize, ": ",
+                      bucket_size_config);
+    const std::string max_entries_config = session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigMemoryPatternCacheMaxEntries, "0");
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(max_entries_config, mem_pattern_cache_options.max_num_entries),
+                      "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternCacheMaxEntries, ": ",
+                      max_entries_config);
+    mem_pattern_cache_options.reuse_buffers = session_options_.config_options.GetConfigOrDefault(
+                                                  kOrtSessionOptionsConfigMemoryPatternReuseBuffers, "0") == "1";
+    session_state_->SetMemoryPatternCacheOptions(mem_pattern_cache_options);
+
+    const std::string parallel_for_tuning_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelForTuningFile, "");
+    if (!parallel_for_tuning_file.empty()) {
+      parallel_for_tuning_file_ = ToPathString(parallel_for_tuning_file);
+      parallel_for_tuner_ = std::make_unique<concurrency::ParallelForTuner>();
+      auto status = parallel_for_tuner_->Load(parallel_for_tuning_file_);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Ignoring parallel for tuning file: " << status.ErrorMessage();
+        parallel_for_tuner_ = std::make_unique<concurrency::ParallelForTuner>();
+      }
+      session_state_->SetParallelForTuner(parallel_for_tuner_.get());
+    }
+
     // Collect the kernel registries from execution provider instances;
     // There are 2 kinds of kernel registries with priority from high to low as below,
     // 1. Custom execution provider type specific kernel registries.
@@ -1336,8 +1684,12 @@ common::Status InferenceSession::Initialize() {
     ORT_RETURN_IF_ERROR_SESSIONID_(kernel_registry_manager_.RegisterKernels(execution_providers_));
 
     const bool loading_ort_format = !ort_format_model_bytes_.empty();
-    const bool saving_model = !session_options_.optimized_model_filepath.empty();
+    const bool caching_model = !optimized_model_cache_path_.empty();
+    const bool saving_model = !session_options_.optimized_model_filepath.empty() || caching_model;
     const bool saving_ort_format = [&]() {
+      if (caching_model) {
+        return true;
+      }
       if (saving_model) {
         const std::string model_type = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSaveModelFormat, "");
         const bool has_explicit_type = !model_type.empty();
@@ -1368,48 +1720,63 @@ common::Status InferenceSession::Initialize() {
                                                                minimal_build_optimization_handling));
 
       // apply any transformations to the main graph and any subgraphs
+      TimePoint transform_tp;
+      if (session_profiler_.IsEnabled()) {
+        transform_tp = session_profiler_.Start();
+      }
+
       ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, graph_transformation_mgr_,
                                                     execution_providers_, kernel_registry_manager_,
                                                     insert_cast_transformer_,
                                                     *session_state_,
                                                     saving_ort_format));
 
+      if (session_profiler_.IsEnabled()) {
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_transformation", transform_tp);
+      }
+
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
 
-      // Currently only the CUDA EP is considered.
-      // If the CUDA EP is part of the providers list for this session AND
-      // The CUDA EP is configured to do a graph capture AND
-      // All the graph nodes have been assigned to the CUDA EP,
-      // Then the CUDA EP is cached for triggering a ReplayGraph() in Run().
-      auto* cuda_ep = execution_providers_.Get(onnxruntime::kCudaExecutionProvider);
-      if (cuda_ep && cuda_ep->IsGraphCaptureEnabled()) {
-        if (cuda_ep->IsGraphCaptureEnabled()) {
-          if (HasControlflowNodes(graph)) {
-            LOGS(*session_logger_, ERROR) << "This session cannot use the CUDA Graph feature as requested by the user "
-                                          << " as the model has control flow nodes which can't be supported by CUDA Graphs.";
-
-            // Return error status as we don't want the session initialization to complete successfully
-            // if the user has requested usage of CUDA Graph feature and we cannot honor that.
-            ORT_RETURN_IF_ERROR_SESSIONID_(
-                ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
-                                "This session cannot use the CUDA Graph feature as requested by the user "
-                                " as the model has control flow nodes which can't be supported by CUDA Graphs."));
-          } else if (!AreAllNodesInMainGraphAssignedToOneEp(graph, onnxruntime::kCudaExecutionProvider)) {
-            LOGS(*session_logger_, ERROR) << "This session cannot use the CUDA Graph feature as requested by the user "
-                                          << " as all the graph nodes have not been partitioned to the CUDA EP.";
-
-            // Return error status as we don't want the session initialization to complete successfully
-            // if the user has requested usage of CUDA Graph feature and we cannot honor that.
-            ORT_RETURN_IF_ERROR_SESSIONID_(
-                ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
-                                "This session cannot use the CUDA Graph feature as requested by the user "
-                                " as all the graph nodes have not been partitioned to the CUDA EP."));
+      // Currently only the CUDA and ROCM EPs are considered.
+      // If the EP is part of the providers list for this session AND
+      // The EP is configured to do a graph capture AND
+      // All the graph nodes have been assigned to the EP,
+      // Then the EP is cached for triggering a ReplayGraph() in Run().
+      for (const auto& graph_ep_type : {onnxruntime::kCudaExecutionProvider, onnxruntime::kRocmExecutionProvider}) {
+        auto* graph_ep = execution_providers_.Get(graph_ep_type);
+        if (!graph_ep || !graph_ep->IsGraphCaptureEnabled()) {
+          continue;
+        }
 
-          } else {
-            LOGS(*session_logger_, INFO) << "This session will use the CUDA Graph feature as requested by the user.";
-            cached_execution_provider_for_graph_replay_.SetExecutionProvider(cuda_ep);
-          }
+        if (HasControlflowNodes(graph)) {
+          LOGS(*session_logger_, ERROR) << "This session cannot use the graph capture feature of " << graph_ep_type
+                                        << " as requested by the user as the model has control flow nodes"
+                                        << " which can't be supported by the captured graphs.";
+
+          // Return error status as we don't want the session initialization to complete successfully
+          // if the user has requested usage of the graph capture feature and we cannot honor that.
+          ORT_RETURN_IF_ERROR_SESSIONID_(
+              ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                              "This session cannot use the graph capture feature of ", graph_ep_type,
+                              " as requested by the user as the model has control flow nodes"
+                              " which can't be supported by the captured graphs."));
+        } else if (!AreAllNodesInMainGraphAssignedToOneEp(graph, graph_ep_type)) {
+          LOGS(*session_logger_, ERROR) << "This session cannot use the graph capture feature of " << graph_ep_type
+                                        << " as requested by the user as all the graph nodes have not been"
+                                        << " partitioned to it.";
+
+          // Return error status as we don't want the session initialization to complete successfully
+          // if the user has requested usage of the graph capture feature and we cannot honor that.
+          ORT_RETURN_IF_ERROR_SESSIONID_(
+              ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                              "This session cannot use the graph capture feature of ", graph_ep_type,
+                              " as requested by the user as all the graph nodes have not been partitioned to it."));
+        } else {
+          LOGS(*session_logger_, INFO) << "This session will use the graph capture feature of " << graph_ep_type
+                                       << " as requested by the user.";
+          cached_execution_provider_for_graph_replay_.SetExecutionProvider(graph_ep);
+          break;
         }
       }
 
@@ -1437,6 +1804,11 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+    TimePoint finalize_tp;
+    if (session_profiler_.IsEnabled()) {
+      finalize_tp = session_profiler_.Start();
+    }
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              session_options_,
@@ -1445,6 +1817,50 @@ common::Status InferenceSession::Initialize() {
                                              !saving_model,
                                              saving_ort_format));
 
+    if (session_profiler_.IsEnabled()) {
+      session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_finalization", finalize_tp);
+    }
+
+    const uint64_t profiling_sample_rate = std::stoull(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingSampleRate, "0"));
+    if (profiling_sample_rate > 0) {
+      std::vector<std::string> op_types;
+      for (const auto& node : session_state_->GetGraphViewer().Nodes()) {
+        op_types.push_back(node.OpType());
+      }
+      op_latency_histograms_ = std::make_unique<profiling::OpLatencyHistograms>(profiling_sample_rate, op_types);
+      session_state_->SetOpLatencyHistograms(op_latency_histograms_.get());
+    }
+
+    const uint64_t shape_statistics_sample_rate = std::stoull(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShapeStatisticsSampleRate, "0"));
+    if (shape_statistics_sample_rate > 0) {
+      shape_statistics_ = std::make_unique<ShapeStatistics>(shape_statistics_sample_rate,
+                                                            session_state_->GetGraphViewer().MaxNodeIndex());
+      session_state_->SetShapeStatistics(shape_statistics_.get());
+    }
+
+    session_state_->SetMemoryTimelineFilePrefix(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryTimelineFilePrefix, ""));
+
+    const uint64_t run_result_cache_bytes = std::stoull(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigRunResultCacheBytes, "0"));
+    if (run_result_cache_bytes > 0) {
+      const Node* nondeterministic_node = RunResultCache::FindNondeterministicNode(model_->MainGraph());
+      if (nondeterministic_node != nullptr) {
+        LOGS(*session_logger_, INFO) << "Not caching the results of the runs as the outputs of node '"
+                                     << nondeterministic_node->Name() << "' (" << nondeterministic_node->OpType()
+                                     << ") are random.";
+      } else {
+        const uint64_t run_result_cache_ttl_ms = std::stoull(
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigRunResultCacheTtlMs, "0"));
+        run_result_cache_ = std::make_unique<RunResultCache>(
+            static_cast<size_t>(run_result_cache_bytes),
+            std::chrono::milliseconds(static_cast<int64_t>(run_result_cache_ttl_ms)),
+            session_state_->GetAllocator(OrtDevice()));
+      }
+    }
+
 #if !defined(ORT_MINIMAL_BUILD)
     if (saving_model) {
       if (session_state_->GetFuncMgr().NumFuncs() > 0) {
@@ -1454,8 +1870,9 @@ common::Status InferenceSession::Initialize() {
                             "Please disable any execution providers which generate compiled nodes."));
       }
 
-      // add a warning if the NchwcTransformer was enabled, as it contains the hardware specific logic
-      if (session_options_.graph_optimization_level >= TransformerLevel::Level3 &&
+      // add a warning if the NchwcTransformer was enabled, as it contains the hardware specific logic.
+      // the key of the optimized model cache includes the CPU features.
+      if (!caching_model && session_options_.graph_optimization_level >= TransformerLevel::Level3 &&
           optimizers_to_disable_.find("NchwcTransformer") == optimizers_to_disable_.cend()) {
         LOGS(*session_logger_, WARNING)
             << "Serializing optimized model with Graph Optimization level greater than ORT_ENABLE_EXTENDED and the "
@@ -1463,7 +1880,14 @@ common::Status InferenceSession::Initialize() {
                "should only be used in the same environment the model was optimized in.";
       }
 
-      if (saving_ort_format) {
+      if (caching_model) {
+        optimized_model_cache::SaveCacheFile(
+            ToPathString(session_options_.config_options.GetConfigOrDefault(
+                kOrtSessionOptionsConfigOptimizedModelCacheDir, "")),
+            optimized_model_cache_path_,
+            [this](const PathString& file_path) { return SaveToOrtFormat(file_path); },
+            *session_logger_);
+      } else if (saving_ort_format) {
         ORT_RETURN_IF_ERROR_SESSIONID_(SaveToOrtFormat(session_options_.optimized_model_filepath));
       } else {
         ORT_RETURN_IF_ERROR_SESSIONID_(Model::Save(*model_, session_options_.optimized_model_filepath));
@@ -1476,10 +1900,13 @@ common::Status InferenceSession::Initialize() {
 
     is_inited_ = true;
 
-    // we don't directly use the ORT format bytes currently, so free those now
-    // TODO, we may need to keep the bytes if we are using the offset directly in the initializers
-    ort_format_model_bytes_ = gsl::span<const uint8_t>();
-    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    // the ORT format bytes are only used after this point by the initializers using them in place, so free those
+    // now unless they are
+    if (!UseOrtModelBytesForInitializers()) {
+      ort_format_model_bytes_ = gsl::span<const uint8_t>();
+      std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+      ort_format_model_mapped_bytes_.reset();
+    }
 
     // and log telemetry
     bool model_has_fp16_inputs = ModelHasFP16Inputs(graph);
@@ -1813,11 +2240,71 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
                              const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info, nullptr);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                 const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 IOBindingPreparedRun* prepared_run) {
+  // a run with the same feeds as a cached one returns its outputs without executing the graph
+  RunResultCache::Key result_cache_key;
+  const bool use_result_cache =
+      run_result_cache_ != nullptr && prepared_run == nullptr && p_fetches != nullptr &&
+      p_fetches_device_info == nullptr && !cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
+      std::none_of(p_fetches->cbegin(), p_fetches->cend(), [](const OrtValue& fetch) { return fetch.IsAllocated(); }) &&
+      run_result_cache_->GetKey(feed_names, feeds, output_names, result_cache_key);
+  if (use_result_cache && run_result_cache_->Lookup(result_cache_key, feeds, *p_fetches)) {
+    return Status::OK();
+  }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  if (shape_specializer_ && is_inited_) {
+    InferenceSession* specialized_session = shape_specializer_->GetSession(feed_names, feeds);
+    if (specialized_session != nullptr) {
+      Status status = specialized_session->Run(run_options, feed_names, feeds, output_names, p_fetches,
+                                               p_fetches_device_info);
+      if (use_result_cache && status.IsOK()) {
+        run_result_cache_->Insert(result_cache_key, feeds, *p_fetches);
+      }
+      return status;
+    }
+  }
+#endif
+
+  // the timeout of the run starts now, it stops with a TIMEOUT status once it has passed
+  RunTermination termination(run_options.terminate);
+  const std::string timeout_ms_str =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigTimeoutMs, "");
+  if (!timeout_ms_str.empty()) {
+    int64_t timeout_ms = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(timeout_ms_str, timeout_ms) && timeout_ms > 0,
+                      "Invalid value for ", kOrtRunOptionsConfigTimeoutMs, ": '", timeout_ms_str,
+                      "'. It must be a positive number of milliseconds.");
+    termination = RunTermination(run_options.terminate,
+                                 RunTermination::Clock::now() + std::chrono::milliseconds(timeout_ms));
+  }
+
+  // low priority runs yield to the high priority ones before each node
+  const std::string priority =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigPriority, "normal");
+  ORT_RETURN_IF_NOT(priority == "low" || priority == "normal" || priority == "high",
+                    "Invalid value for ", kOrtRunOptionsConfigPriority, ": '", priority,
+                    "'. It must be 'low', 'normal' or 'high'.");
+  if (priority == "low") {
+    termination.SetPriorityGate(run_priority_gate_);
+  }
+  RunPriorityGate::HighPriorityScope high_priority_scope(priority == "high" ? &run_priority_gate_ : nullptr);
+
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
 
+  // count this session when the global intra op threadpool is divided between sessions
+  concurrency::ThreadPool::ActiveScope thread_pool_scope(intra_op_thread_pool_view_.get());
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingActivity<telemetry_provider_handle> ortrun_activity;
   ortrun_activity.SetRelatedActivity(session_activity);
@@ -1826,11 +2313,15 @@ Status InferenceSession::Run(const RunOptions& run_options,
   Status retval = Status::OK();
   const Env& env = Env::Default();
 
-  // Check if this Run() is simply going to be a CUDA Graph replay.
+  // Select the captured graph of the shapes and addresses of this Run(), which is captured by the following runs
+  // if it was not, and check if this Run() is simply going to be a graph replay.
+  if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+    cached_execution_provider_for_graph_replay_.SelectGraph(GetGraphCaptureKey(feeds, p_fetches));
+  }
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
     LOGS(*session_logger_, INFO) << "Replaying the captured "
                                  << cached_execution_provider_for_graph_replay_.Type()
-                                 << " CUDA Graph for this model with tag: " << run_options.run_tag;
+                                 << " graph for this model with tag: " << run_options.run_tag;
     ++current_num_runs_;
     ORT_RETURN_IF_ERROR_SESSIONID_(cached_execution_provider_for_graph_replay_.ReplayGraph());
   } else {
@@ -1848,8 +2339,13 @@ Status InferenceSession::Run(const RunOptions& run_options,
       // log evaluation start to trace logging provider
       env.GetTelemetryProvider().LogEvaluationStart();
 
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      // the feeds and fetches of a prepared run were validated by a previous Run()
+      const bool use_prepared_run = prepared_run != nullptr &&
+                                    prepared_run->Matches(feeds, *p_fetches, p_fetches_device_info);
+      if (!use_prepared_run) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      }
 
       // shrink certain default memory arenas if the user has requested for it
       const std::string& shrink_memory_arenas =
@@ -1859,18 +2355,28 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
       }
 
-      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-      FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      std::unique_ptr<FeedsFetchesManager> new_feeds_fetches_manager;
+      if (!use_prepared_run) {
+        FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
+        new_feeds_fetches_manager = std::make_unique<FeedsFetchesManager>(std::move(info));
 
-      if (p_fetches_device_info) {
-        // populate the target device info. ignored if pre-allocated fetches are provided
-        const auto& fetch_device_info = *p_fetches_device_info;
-        auto& fetch_info = feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo();
+        if (p_fetches_device_info) {
+          // populate the target device info. ignored if pre-allocated fetches are provided
+          const auto& fetch_device_info = *p_fetches_device_info;
+          auto& fetch_info = new_feeds_fetches_manager->GetMutableFetchesDeviceCopyInfo();
 
-        for (size_t i = 0, end = output_names.size(); i < end; ++i) {
-          fetch_info[i].target_device = fetch_device_info[i];
+          for (size_t i = 0, end = output_names.size(); i < end; ++i) {
+            fetch_info[i].target_device = fetch_device_info[i];
+          }
+        }
+
+        // the feeds and fetches are recorded before the execution allocates the fetches
+        if (prepared_run != nullptr && !prepared_run->SetInfo(feeds, *p_fetches, p_fetches_device_info)) {
+          prepared_run = nullptr;
         }
       }
+      FeedsFetchesManager& feeds_fetches_manager =
+          use_prepared_run ? *prepared_run->feeds_fetches_manager : *new_feeds_fetches_manager;
 
       if (!run_options.run_tag.empty()) {
         LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
@@ -1908,9 +2414,23 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
       session_state_->IncrementGraphExecutionCounter();
 #endif
-      ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
-                                                   session_options_.execution_mode, run_options.terminate, run_logger,
-                                                   run_options.only_execute_path_to_fetches));
+      if (use_prepared_run) {
+        ORT_CHECK_AND_SET_RETVAL(utils::ExecutePreparedGraph(*session_state_, feeds_fetches_manager, feeds,
+                                                             *p_fetches, session_options_.execution_mode,
+                                                             termination, run_logger,
+                                                             run_options.only_execute_path_to_fetches));
+      } else {
+        ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
+                                                     session_options_.execution_mode, termination,
+                                                     run_logger, run_options.only_execute_path_to_fetches));
+        if (prepared_run != nullptr) {
+          if (retval.IsOK()) {
+            prepared_run->feeds_fetches_manager = std::move(new_feeds_fetches_manager);
+          } else {
+            prepared_run->Reset();
+          }
+        }
+      }
     }
     ORT_CATCH(const std::exception& e) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -1968,7 +2488,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
     LOGS(*session_logger_, INFO) << "Start the second Run() to capture the graph. "
                                     "The first one is for necessary memory allocation;"
                                     "The second one is for capturing the graph.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                prepared_run));
+  }
+
+  if (use_result_cache && retval.IsOK()) {
+    run_result_cache_->Insert(result_cache_key, feeds, *p_fetches);
   }
   return retval;
 }
@@ -2061,8 +2586,8 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  return RunImpl(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
+                 &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo(), &io_binding.prepared_run_);
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -2070,6 +2595,184 @@ common::Status InferenceSession::Run(IOBinding& io_binding) {
   return Run(run_options, io_binding);
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions* run_options, std::vector<std::string> feed_names,
+                                          std::vector<OrtValue> feeds, std::vector<std::string> output_names,
+                                          std::vector<OrtValue> fetches, RunAsyncCallback callback) {
+  concurrency::ThreadPool* tp = GetInterOpThreadPoolToUse();
+  if (concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    tp = GetIntraOpThreadPoolToUse();
+  }
+
+  // without worker threads Schedule() would run the request inline
+  if (concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "RunAsync requires the session to have a thread pool with at least 2 threads.");
+  }
+
+  concurrency::ThreadPool::Schedule(
+      tp, [this, run_options, feed_names = std::move(feed_names), feeds = std::move(feeds),
+           output_names = std::move(output_names), fetches = std::move(fetches),
+           callback = std::move(callback)]() mutable {
+        Status status;
+        ORT_TRY {
+          if (run_options == nullptr) {
+            RunOptions default_run_options;
+            status = Run(default_run_options, feed_names, feeds, output_names, &fetches);
+          } else {
+            status = Run(*run_options, feed_names, feeds, output_names, &fetches);
+          }
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+          });
+        }
+
+        callback(status, fetches);
+      });
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::RunBatch(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                          const std::vector<std::vector<OrtValue>>& feeds,
+                                          const std::vector<std::string>& output_names,
+                                          std::vector<std::vector<OrtValue>>& fetches) {
+  const size_t batch_size = feeds.size();
+  ORT_RETURN_IF_NOT(fetches.empty() || fetches.size() == batch_size,
+                    "RunBatch expects the fetches of ", batch_size, " requests, got ", fetches.size());
+  fetches.resize(batch_size);
+  for (size_t i = 0; i < batch_size; ++i) {
+    ORT_RETURN_IF_NOT(feeds[i].size() == feed_names.size(), "Request ", i, " has ", feeds[i].size(),
+                      " feeds, expected ", feed_names.size());
+    ORT_RETURN_IF_NOT(fetches[i].empty() || fetches[i].size() == output_names.size(), "Request ", i, " has ",
+                      fetches[i].size(), " fetches, expected ", output_names.size());
+  }
+
+  if (batch_size == 0) {
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* tp = GetInterOpThreadPoolToUse();
+  if (concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    tp = GetIntraOpThreadPoolToUse();
+  }
+
+  // each worker takes the next request until there are none left, so requests of different costs balance out
+  const size_t num_workers =
+      std::min(batch_size, static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(tp)));
+  std::atomic<size_t> next_request{0};
+  std::vector<Status> statuses(batch_size);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_workers), [&](std::ptrdiff_t) {
+        IOBindingPreparedRun prepared_run;
+        for (size_t i = next_request++; i < batch_size; i = next_request++) {
+          ORT_TRY {
+            statuses[i] = RunImpl(run_options, feed_names, feeds[i], output_names, &fetches[i], nullptr,
+                                  &prepared_run);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+            });
+          }
+        }
+      });
+
+  for (size_t i = 0; i < batch_size; ++i) {
+    if (!statuses[i].IsOK()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Request ", i, " of the batch failed: ",
+                             statuses[i].ErrorMessage());
+    }
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::Warmup(const RunOptions& run_options,
+                                        const std::vector<std::unordered_map<std::string, TensorShape>>& input_shapes,
+                                        bool freeze_arenas, std::vector<int64_t>& run_durations_us) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session was not initialized");
+    }
+  }
+
+  AllocatorPtr cpu_allocator = session_state_->GetAllocator(OrtDevice());
+  std::vector<std::string> output_names;
+  output_names.reserve(output_def_list_.size());
+  for (const auto* output : output_def_list_) {
+    output_names.push_back(output->Name());
+  }
+
+  run_durations_us.clear();
+  run_durations_us.reserve(input_shapes.size() * 2);
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    for (const auto& name : required_inputs_) {
+      const auto& input_def = input_def_map_.at(name);
+      if (!input_def.ml_data_type->IsTensorType()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Warm-up only supports tensor inputs. Input ", name,
+                               " is not a tensor.");
+      }
+
+      auto shape_entry = input_shapes[i].find(name);
+      const bool has_shape = shape_entry != input_shapes[i].end();
+      const TensorShape& shape = has_shape ? shape_entry->second : input_def.tensor_shape;
+      if (!has_shape && (input_def.node_arg->Shape() == nullptr || shape.Size() < 0)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No warm-up shape ", i, " for input ", name,
+                               " which doesn't have a fixed shape.");
+      }
+
+      OrtValue feed;
+      const auto* element_type = input_def.ml_data_type->AsTensorType()->GetElementType();
+      Tensor::InitOrtValue(element_type, shape, cpu_allocator, feed);
+      auto* tensor = feed.GetMutable<Tensor>();
+      if (!tensor->IsDataTypeString()) {
+        memset(tensor->MutableDataRaw(), 0, tensor->SizeInBytes());
+      }
+
+      feed_names.push_back(name);
+      feeds.push_back(std::move(feed));
+    }
+
+    // the first run fills the caches, the second one runs with them
+    for (int run = 0; run < 2; ++run) {
+      std::vector<OrtValue> fetches;
+      const TimePoint tp = std::chrono::high_resolution_clock::now();
+      ORT_RETURN_IF_ERROR_SESSIONID_(Run(run_options, feed_names, feeds, output_names, &fetches));
+      run_durations_us.push_back(TimeDiffMicroSeconds(tp));
+      LOGS(*session_logger_, INFO) << "Warm-up " << i << (run == 0 ? " first" : " second") << " run took "
+                                   << run_durations_us.back() << "us";
+    }
+  }
+
+  if (freeze_arenas) {
+    for (auto& xp : execution_providers_) {
+      for (const auto& alloc : xp->GetAllocators()) {
+        if (alloc->Info().alloc_type != OrtAllocatorType::OrtArenaAllocator) {
+          continue;
+        }
+
+        AllocatorStats stats;
+        alloc->GetStats(&stats);
+        // an arena the warm-ups didn't use would be unusable
+        if (stats.total_allocated_bytes == 0) {
+          continue;
+        }
+
+        static_cast<BFCArena*>(alloc.get())->Freeze();
+        LOGS(*session_logger_, INFO) << "Froze arena " << alloc->Info().ToString() << " at "
+                                     << stats.total_allocated_bytes << " bytes";
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 template <typename T>
 void InferenceSession::StartProfiling(const std::basic_string<T>& file_prefix) {
   std::basic_ostringstream<T> ss;
@@ -2094,6 +2797,11 @@ void InferenceSession::StartProfiling(const logging::Logger* logger_ptr) {
 std::string InferenceSession::EndProfiling() {
   if (is_model_loaded_) {
     if (session_profiler_.IsEnabled()) {
+      if (shape_statistics_ != nullptr) {
+        auto tp = session_profiler_.Start();
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "shape_statistics", tp,
+                                                {{"statistics", GetShapeStatisticsJson()}});
+      }
       return session_profiler_.EndProfiling();
     } else {
       LOGS(*session_logger_, VERBOSE) << "Profiler is disabled.";
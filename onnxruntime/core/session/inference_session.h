@@ -3,12 +3,14 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
+#include "core/common/op_latency_histograms.h"
 #include "core/common/profiler.h"
 #include "core/common/status.h"
 #include "core/framework/execution_providers.h"
@@ -16,11 +18,14 @@
 #include "core/framework/iexecutor.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/run_termination.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shape_statistics.h"
 #include "core/graph/basic_types.h"
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
 #include "core/framework/session_options.h"
 #include "core/framework/allocatormgr.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
@@ -37,6 +42,8 @@
 namespace onnxruntime {  // forward declarations
 class GraphTransformer;
 class Environment;
+class ShapeSpecializer;
+class RunResultCache;
 }  // namespace onnxruntime
 
 namespace ONNX_NAMESPACE {
@@ -51,6 +58,7 @@ struct OrtCustomOpDomain {
 namespace onnxruntime {
 class IExecutionProvider;  // forward decl
 class IOBinding;
+struct IOBindingPreparedRun;
 class CustomRegistry;
 struct Notification;
 
@@ -338,6 +346,50 @@ class InferenceSession {
   virtual common::Status Run(const RunOptions& run_options, IOBinding& io_binding) ORT_MUST_USE_RESULT;
   common::Status Run(IOBinding& io_binding) ORT_MUST_USE_RESULT;
 
+  using RunAsyncCallback = std::function<void(const common::Status& status, std::vector<OrtValue>& fetches)>;
+
+  /**
+   * Schedules a Run() on a thread pool of the session and returns without waiting for it to complete.
+   * The inter-op thread pool is used if the session has one, the intra-op thread pool otherwise.
+   * @param run_options nullptr to use the default options. Otherwise it must stay valid until callback is invoked.
+   * @param callback invoked on a thread of the pool with the status of the run and the fetches.
+   *        The session must not be destroyed before all the callbacks have been invoked.
+   * @return OK if the run was scheduled. An error if the session has no thread pool with worker threads.
+   */
+  common::Status RunAsync(const RunOptions* run_options, std::vector<std::string> feed_names,
+                          std::vector<OrtValue> feeds, std::vector<std::string> output_names,
+                          std::vector<OrtValue> fetches, RunAsyncCallback callback) ORT_MUST_USE_RESULT;
+
+  /**
+   * Runs independent requests with the same feed and output names, e.g. requests of different shapes that can't be
+   * concatenated into a single batch (see DynamicBatcher for that). The requests are spread over the thread pool
+   * RunAsync() uses, or run one after the other if it has no worker threads. Each worker reuses the setup of the
+   * feeds and fetches of its previous request when the types, shapes and devices of the feeds match.
+   * @param feeds the feeds of each request, in the order of feed_names.
+   * @param fetches the fetches of each request, in the order of output_names. Each element must be empty or have
+   *        the size of output_names. Pre-allocated fetches are written to.
+   * @return OK if all the requests succeeded, otherwise the error of the first failed request.
+   */
+  common::Status RunBatch(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                          const std::vector<std::vector<OrtValue>>& feeds,
+                          const std::vector<std::string>& output_names,
+                          std::vector<std::vector<OrtValue>>& fetches) ORT_MUST_USE_RESULT;
+
+  /**
+   * Runs the model with synthetic inputs for each set of representative input shapes, so that the state created by
+   * the first run of a shape (arena growth, memory patterns, algorithm searches, pre-packing, captured graphs) exists
+   * before the first request. Each set of shapes is run twice: the second run uses what the first one created,
+   * e.g. the memory pattern, which allocates its buffers.
+   * @param input_shapes the shapes of the inputs for each warm-up. The inputs with a fixed shape may be omitted.
+   *        The inputs are zero-filled tensors allocated on CPU.
+   * @param freeze_arenas if true, the arenas of the execution providers are limited to the memory they have
+   *        allocated once all the warm-ups have run, see BFCArena::Freeze.
+   * @param run_durations_us filled with the durations of the two runs of each warm-up, in microseconds.
+   */
+  common::Status Warmup(const RunOptions& run_options,
+                        const std::vector<std::unordered_map<std::string, TensorShape>>& input_shapes,
+                        bool freeze_arenas, std::vector<int64_t>& run_durations_us) ORT_MUST_USE_RESULT;
+
 #ifdef ENABLE_TRAINING
   /**
    * Partially run a pre-loaded and pre-intialized model.
@@ -442,6 +494,37 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+    * Return the sampled op latency histograms, enabled with session.profiling_sample_rate
+    @return the histograms, or nullptr if they are disabled or the session is not initialized
+    */
+  const profiling::OpLatencyHistograms* GetOpLatencyHistograms() const noexcept {
+    return op_latency_histograms_.get();
+  }
+
+  /**
+    * Return the sampled shape statistics as JSON, enabled with session.shape_statistics_sample_rate
+    @return the statistics, or an empty string if they are disabled or the session is not initialized
+    */
+  std::string GetShapeStatisticsJson() const {
+    return shape_statistics_ ? shape_statistics_->ToJson(session_state_->GetGraphViewer()) : std::string();
+  }
+
+  /**
+    * Return the cache of the outputs of the runs, enabled with session.run_result_cache_bytes
+    @return the cache, or nullptr if it is disabled, the model has random ops or the session is not initialized
+    */
+  const RunResultCache* GetRunResultCache() const noexcept {
+    return run_result_cache_.get();
+  }
+
+  /**
+    * Read the live counters of the intra-op thread pool the session uses. They are all 0 without one.
+    */
+  void GetIntraOpThreadPoolStats(concurrency::ThreadPoolStats& stats) const {
+    concurrency::ThreadPool::GetStats(GetIntraOpThreadPoolToUse(), stats);
+  }
+
   /**
    * Search registered execution providers for an allocator that has characteristics
    * specified within mem_info
@@ -507,6 +590,8 @@ class InferenceSession {
       } else {
         return thread_pool_.get();
       }
+    } else if (intra_op_thread_pool_view_) {
+      return intra_op_thread_pool_view_.get();
     } else {
       return intra_op_thread_pool_from_env_;
     }
@@ -585,6 +670,23 @@ class InferenceSession {
 
   common::Status LoadOrtModel(std::function<Status()> load_ort_format_model_bytes) ORT_MUST_USE_RESULT;
 
+  // Creates model_ from the ORT format model in ort_format_model_bytes_. model_ is unchanged on failure.
+  common::Status LoadOrtModelFromBytes() ORT_MUST_USE_RESULT;
+
+  // Returns true if session.use_ort_model_bytes_for_initializers is set, in which case the initializers of an ORT
+  // format model use the model bytes in place and the bytes are kept until the session is destroyed.
+  bool UseOrtModelBytesForInitializers() const;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Replaces the loaded ONNX model with the optimized model cached in the session.optimized_model_cache_dir directory
+  // if there is one. Otherwise sets optimized_model_cache_path_ so that Initialize saves the optimized model there.
+  common::Status LoadOptimizedModelFromCache(bool have_cpu_ep) ORT_MUST_USE_RESULT;
+
+  // Creates shape_specializer_ if session.shape_specialization_max_sessions is set and the model supports it.
+  // Must be called before the graph is optimized, as the specialized sessions load the original model.
+  common::Status CreateShapeSpecializer(bool have_cpu_ep) ORT_MUST_USE_RESULT;
+#endif
+
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
   // If a new logger is created, it will also be stored in new_run_logger,
   // which must remain valid for the duration of the execution.
@@ -601,6 +703,14 @@ class InferenceSession {
   common::Status ValidateInputs(const std::vector<std::string>& feed_names,
                                 const std::vector<OrtValue>& feeds) const ORT_MUST_USE_RESULT;
 
+  // The implementation of the Run() overloads. If prepared_run is not nullptr and matches the feeds and fetches,
+  // the feeds and fetches aren't validated and its feeds and fetches manager is used. Otherwise it's updated for
+  // the next Run().
+  common::Status RunImpl(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                         const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                         std::vector<OrtValue>* p_fetches, const std::vector<OrtDevice>* p_fetches_device_info,
+                         IOBindingPreparedRun* prepared_run) ORT_MUST_USE_RESULT;
+
   common::Status ValidateOutputs(const std::vector<std::string>& output_names,
                                  const std::vector<OrtValue>* p_fetches) const ORT_MUST_USE_RESULT;
 
@@ -660,6 +770,16 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Sampled per op type latency histograms of the main graph. nullptr unless session.profiling_sample_rate is set.
+  std::unique_ptr<profiling::OpLatencyHistograms> op_latency_histograms_;
+
+  // Sampled input and node output shapes of the main graph. nullptr unless session.shape_statistics_sample_rate is set.
+  std::unique_ptr<ShapeStatistics> shape_statistics_;
+
+  // Outputs of recent runs by the values of their feeds. nullptr unless session.run_result_cache_bytes is set and the
+  // model has no random ops.
+  std::unique_ptr<RunResultCache> run_result_cache_;
+
   // Immutable state for each op in the model. Shared by all executors.
   // It has a dependency on execution_providers_.
   std::unique_ptr<SessionState> session_state_;
@@ -677,6 +797,13 @@ class InferenceSession {
   onnxruntime::concurrency::ThreadPool* intra_op_thread_pool_from_env_{};
   onnxruntime::concurrency::ThreadPool* inter_op_thread_pool_from_env_{};
 
+  // View of the global intra op threadpool that applies the quota of this session, if it has one.
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> intra_op_thread_pool_view_;
+
+  // Tunes the parallel loops of the kernels if kOrtSessionOptionsConfigParallelForTuningFile is set.
+  std::unique_ptr<concurrency::ParallelForTuner> parallel_for_tuner_;
+  PathString parallel_for_tuning_file_;
+
   // External threadpools.
   onnxruntime::concurrency::ThreadPool* external_intra_op_thread_pool_{};
   onnxruntime::concurrency::ThreadPool* external_inter_op_thread_pool_{};
@@ -720,6 +847,9 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
 
+  // Makes the low priority runs yield to the high priority ones (see kOrtRunOptionsConfigPriority)
+  RunPriorityGate run_priority_gate_;
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
@@ -769,9 +899,9 @@ class InferenceSession {
   //   We store them currently in the ort_format_model_bytes_data_holder_ to make the Load + Initialize
   //   behave the same way as for an ONNX model, as we need some of the bytes for the Load (create the Model)
   //   and some for the Initialize (create SessionState).
-  // Short term we free them after Initialize.
-  // Longer term we may want to directly refer to offsets in this buffer for initializers so we don't need to copy
-  // those into new OrtValue instances, at which point we won't free them until the InferenceSession goes away.
+  // We free them after Initialize, unless "session.use_ort_model_bytes_for_initializers" is "1" in which case the
+  // initializers refer to offsets in this buffer so we don't need to copy those into new OrtValue instances,
+  // and we won't free them until the InferenceSession goes away.
   gsl::span<const uint8_t> ort_format_model_bytes_;
 
   // This holds the actual model data
@@ -780,6 +910,13 @@ class InferenceSession {
   // "session.use_ort_model_bytes_directly" to "1", this will be empty
   std::vector<uint8_t> ort_format_model_bytes_data_holder_;
 
+  // This holds the memory mapped model data instead of ort_format_model_bytes_data_holder_ if the session is started
+  // with a model_uri and "session.use_ort_model_bytes_for_initializers" is "1"
+  Env::MappedMemoryPtr ort_format_model_mapped_bytes_;
+
+  // Path in the optimized model cache to save the model to once it is optimized. Empty if it is not saved.
+  std::basic_string<ORTCHAR_T> optimized_model_cache_path_;
+
   std::shared_ptr<onnxruntime::AllocatorManager> allocator_manager_;
 
   // Container to store pre-packed weights to share between sessions.
@@ -808,6 +945,10 @@ class InferenceSession {
       return cached_execution_provider_for_graph_replay_ != nullptr && cached_execution_provider_for_graph_replay_->IsGraphCaptured();
     }
 
+    void SelectGraph(size_t graph_key) {
+      cached_execution_provider_for_graph_replay_->SelectGraph(graph_key);
+    }
+
     Status ReplayGraph() {
       ORT_ENFORCE(IsGraphCaptured());
       if (cached_execution_provider_for_graph_replay_) {
@@ -824,6 +965,12 @@ class InferenceSession {
   };
 
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Sessions specialized for recurring values of the symbolic dimensions of the inputs. Declared last so that the
+  // specialized sessions, which use the thread pools of this session, are destroyed first.
+  std::unique_ptr<ShapeSpecializer> shape_specializer_;
+#endif
 };
 
 struct SessionIOBinding {
@@ -5,6 +5,8 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <fstream>
+
 namespace onnxruntime {
 
 //---------------------
@@ -103,6 +105,32 @@ static Status SetEnableProfiling(SessionOptions& session_options,
   return Status::OK();
 }
 
+static Status SetEnableMemPattern(SessionOptions& session_options,
+                                  int value,
+                                  const logging::Logger& logger) {
+  if (value != 0 && value != 1) {
+    LOGS(logger, ERROR) << "Unsupported value for enable_mem_pattern option: " << value;
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported value for enable_mem_pattern option: ", value);
+  }
+
+  LOGS(logger, INFO) << "Setting enable_mem_pattern to " << (value == 0 ? "false" : "true");
+  session_options.enable_mem_pattern = (value == 0 ? false : true);
+  return Status::OK();
+}
+
+static Status SetEnableCpuMemArena(SessionOptions& session_options,
+                                   int value,
+                                   const logging::Logger& logger) {
+  if (value != 0 && value != 1) {
+    LOGS(logger, ERROR) << "Unsupported value for enable_cpu_mem_arena option: " << value;
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported value for enable_cpu_mem_arena option: ", value);
+  }
+
+  LOGS(logger, INFO) << "Setting enable_cpu_mem_arena to " << (value == 0 ? "false" : "true");
+  session_options.enable_cpu_mem_arena = (value == 0 ? false : true);
+  return Status::OK();
+}
+
 //---------------------------------------------------
 //--- end of session options related helpers ---
 //---------------------------------------------------
@@ -214,6 +242,40 @@ Status JsonConfigParser::ParseSessionOptionsFromModelProto(SessionOptions& sessi
 
       ORT_RETURN_IF_ERROR(SetEnableProfiling(session_options, it.value().get<int>(), logger_));
 
+    } else if (key == "enable_mem_pattern") {
+      if (!value.is_number_integer()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "enable_mem_pattern option in the model file must be an integer");
+      }
+
+      ORT_RETURN_IF_ERROR(SetEnableMemPattern(session_options, it.value().get<int>(), logger_));
+
+    } else if (key == "enable_cpu_mem_arena") {
+      if (!value.is_number_integer()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "enable_cpu_mem_arena option in the model file must be an integer");
+      }
+
+      ORT_RETURN_IF_ERROR(SetEnableCpuMemArena(session_options, it.value().get<int>(), logger_));
+
+    } else if (key == "config_entries") {
+      // the session config entries, see onnxruntime_session_options_config_keys.h
+      if (!value.is_object()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "config_entries option in the model file must be an object");
+      }
+
+      for (const auto& entry : value.items()) {
+        if (!entry.value().is_string()) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The value of the config entry ", entry.key(),
+                                 " in the model file must be a string");
+        }
+
+        LOGS(logger_, INFO) << "Setting config entry " << entry.key() << " to " << entry.value().get<std::string>();
+        ORT_RETURN_IF_ERROR(session_options.config_options.AddConfigEntry(entry.key().c_str(),
+                                                                          entry.value().get<std::string>().c_str()));
+      }
+
     } else {
       LOGS(logger_, INFO) << "Ignoring unsupported session option in ORT config: " << key;
     }
@@ -227,6 +289,48 @@ Status JsonConfigParser::ParseRunOptionsFromModelProto(RunOptions& /*run_options
                          "Parsing RunOptions from ModelProto is not supported yet");
 }
 
+Status LoadKernelTimesFromProfile(const PathString& profile_file_path, PartitioningCostModel& cost_model) {
+  std::ifstream profile_file(profile_file_path);
+  if (!profile_file) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to open the profile ",
+                           ToUTF8String(profile_file_path));
+  }
+
+  // the total time and number of kernel runs by provider and op type
+  std::unordered_map<std::string, std::unordered_map<std::string, std::pair<double, size_t>>> kernel_times;
+  auto status = Status::OK();
+  ORT_TRY {
+    const json events = json::parse(profile_file);
+    for (const auto& event : events) {
+      const auto args = event.find("args");
+      if (event.value("cat", "") != "Node" || event.find("dur") == event.end() || args == event.end() ||
+          args->find("op_name") == args->end() || args->find("provider") == args->end()) {
+        continue;
+      }
+
+      auto& entry = kernel_times[args->at("provider").get<std::string>()][args->at("op_name").get<std::string>()];
+      entry.first += event.at("dur").get<double>();
+      ++entry.second;
+    }
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The profile ", ToUTF8String(profile_file_path),
+                               " cannot be parsed. Error message: ", e.what());
+    });
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  for (const auto& provider_entry : kernel_times) {
+    for (const auto& op_entry : provider_entry.second) {
+      cost_model.kernel_time_us[provider_entry.first][op_entry.first] =
+          op_entry.second.first / static_cast<double>(op_entry.second.second);
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
@@ -13,6 +13,7 @@
 #include "core/session/inference_session.h"
 #include "core/framework/session_options.h"
 #include "core/common/common.h"
+#include "core/framework/graph_partitioner.h"
 #include "nlohmann/json.hpp"
 using json = nlohmann::json;
 #endif
@@ -56,6 +57,10 @@ class JsonConfigParser {
   bool is_ort_config_json_available_ = false;
 };
 
+// Sets the kernel times of the cost model to the mean times of the kernels by provider and op type in a profile
+// written by a session with profiling enabled.
+Status LoadKernelTimesFromProfile(const PathString& profile_file_path, PartitioningCostModel& cost_model);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
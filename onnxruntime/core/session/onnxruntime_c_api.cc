@@ -742,17 +742,18 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromArray, _In_ const OrtEnv* env, _In
   API_IMPL_END
 }
 
-ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
-                    _In_reads_(input_len) const char* const* input_names,
-                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
-                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
-                    _Inout_updates_all_(output_names_len) OrtValue** output) {
-  API_IMPL_BEGIN
-  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+namespace {
+// Validates the names and collects the feeds and the pre-allocated fetches of a Run call.
+OrtStatus* CollectRunArgs(_In_reads_(input_len) const char* const* input_names,
+                          _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                          _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                          _In_reads_(output_names_len) OrtValue* const* output,
+                          std::vector<std::string>& feed_names, std::vector<OrtValue>& feeds,
+                          std::vector<std::string>& output_names, std::vector<OrtValue>& fetches) {
   constexpr int queue_id = 0;
 
-  std::vector<std::string> feed_names(input_len);
-  std::vector<OrtValue> feeds(input_len);
+  feed_names.resize(input_len);
+  feeds.resize(input_len);
 
   for (size_t i = 0; i != input_len; ++i) {
     if (input_names[i] == nullptr || input_names[i][0] == '\0') {
@@ -766,7 +767,7 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
   }
 
   // Create output feed
-  std::vector<std::string> output_names(output_names_len);
+  output_names.resize(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
     if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
       return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
@@ -774,7 +775,7 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
     output_names[i] = output_names1[i];
   }
 
-  std::vector<OrtValue> fetches(output_names_len);
+  fetches.resize(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
     if (output[i] != nullptr) {
       ::OrtValue& value = *(output[i]);
@@ -783,6 +784,41 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
       fetches[i] = value;
     }
   }
+
+  return nullptr;
+}
+
+// Hands the fetches of a completed Run call back to the caller.
+void ReturnRunFetches(std::vector<OrtValue>& fetches, OrtValue** output) {
+  constexpr int queue_id = 0;
+  for (size_t i = 0, end = fetches.size(); i != end; ++i) {
+    ::OrtValue& value = fetches[i];
+    if (value.Fence())
+      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+    if (output[i] == nullptr) {
+      output[i] = new OrtValue(value);
+    }
+  }
+}
+}  // namespace
+
+ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  std::vector<std::string> output_names;
+  std::vector<OrtValue> fetches;
+  if (OrtStatus* status = CollectRunArgs(input_names, input, input_len, output_names1, output_names_len, output,
+                                         feed_names, feeds, output_names, fetches)) {
+    return status;
+  }
+
   Status status;
   if (run_options == nullptr) {
     OrtRunOptions op;
@@ -793,14 +829,211 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
 
   if (!status.IsOK())
     return ToOrtStatus(status);
-  for (size_t i = 0; i != output_names_len; ++i) {
-    ::OrtValue& value = fetches[i];
-    if (value.Fence())
-      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
-    if (output[i] == nullptr) {
-      output[i] = new OrtValue(value);
+  ReturnRunFetches(fetches, output);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (run_async_callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "run_async_callback cannot be null");
+  }
+
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  std::vector<std::string> output_names;
+  std::vector<OrtValue> fetches;
+  if (OrtStatus* status = CollectRunArgs(input_names, input, input_len, output_names1, output_names_len, output,
+                                         feed_names, feeds, output_names, fetches)) {
+    return status;
+  }
+
+  auto status = session->RunAsync(
+      run_options, std::move(feed_names), std::move(feeds), std::move(output_names), std::move(fetches),
+      [output, output_names_len, run_async_callback, user_data](const Status& run_status,
+                                                                std::vector<OrtValue>& run_fetches) {
+        if (run_status.IsOK()) {
+          ReturnRunFetches(run_fetches, output);
+        }
+
+        run_async_callback(user_data, output, output_names_len, ToOrtStatus(run_status));
+      });
+
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::WarmupSession, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(num_warmups* input_len) const int64_t* const* input_shapes,
+                    _In_reads_(num_warmups* input_len) const size_t* input_shape_lens, size_t num_warmups,
+                    int freeze_arenas, _Out_opt_ int64_t* run_durations_us) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::unordered_map<std::string, TensorShape>> warmup_shapes(num_warmups);
+  for (size_t i = 0; i < num_warmups; ++i) {
+    for (size_t j = 0; j < input_len; ++j) {
+      if (input_names[j] == nullptr || input_names[j][0] == '\0') {
+        return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+      }
+
+      const size_t index = i * input_len + j;
+      if (input_shapes[index] == nullptr && input_shape_lens[index] != 0) {
+        return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input shape cannot be null");
+      }
+
+      warmup_shapes[i][input_names[j]] = TensorShape(input_shapes[index], input_shape_lens[index]);
+    }
+  }
+
+  std::vector<int64_t> durations;
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->Warmup(op, warmup_shapes, freeze_arenas != 0, durations);
+  } else {
+    status = session->Warmup(*run_options, warmup_shapes, freeze_arenas != 0, durations);
+  }
+
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+
+  if (run_durations_us != nullptr) {
+    std::copy(durations.begin(), durations.end(), run_durations_us);
+  }
+
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunBatch, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(batch_size* input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    size_t batch_size, _Inout_updates_all_(batch_size* output_names_len) OrtValue** outputs) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<std::string> output_names;
+  std::vector<std::vector<OrtValue>> feeds(batch_size);
+  std::vector<std::vector<OrtValue>> fetches(batch_size);
+  for (size_t i = 0; i < batch_size; ++i) {
+    if (OrtStatus* status = CollectRunArgs(input_names, inputs + i * input_len, input_len, output_names1,
+                                           output_names_len, outputs + i * output_names_len,
+                                           feed_names, feeds[i], output_names, fetches[i])) {
+      return status;
     }
   }
+
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->RunBatch(op, feed_names, feeds, output_names, fetches);
+  } else {
+    status = session->RunBatch(*run_options, feed_names, feeds, output_names, fetches);
+  }
+
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+
+  for (size_t i = 0; i < batch_size; ++i) {
+    ReturnRunFetches(fetches[i], outputs + i * output_names_len);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetOpLatencyHistograms, _In_ const OrtSession* sess,
+                    _Inout_ OrtAllocator* allocator, _Outptr_result_maybenull_ char** op_types,
+                    _Outptr_result_maybenull_ size_t** op_type_lengths,
+                    _Outptr_result_maybenull_ uint64_t** bucket_counts, _Out_ size_t* num_op_types,
+                    _Out_ size_t* num_buckets) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  const auto* histograms = session->GetOpLatencyHistograms();
+  if (histograms == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "The session does not collect op latency histograms. "
+                                 "Set session.profiling_sample_rate to enable them.");
+  }
+
+  *num_buckets = ::onnxruntime::profiling::OpLatencyHistograms::kNumBuckets;
+  const auto& types = histograms->OpTypes();
+  if (types.empty()) {
+    *op_types = nullptr;
+    *op_type_lengths = nullptr;
+    *bucket_counts = nullptr;
+    *num_op_types = 0U;
+    return nullptr;
+  }
+
+  IAllocatorUniquePtr<size_t> lengths_alloc(reinterpret_cast<size_t*>(allocator->Alloc(allocator, types.size() * sizeof(size_t))),
+                                            [allocator](size_t* p) { if(p) allocator->Free(allocator, p); });
+  if (!lengths_alloc) {
+    return OrtApis::CreateStatus(ORT_FAIL, "lengths allocation failed");
+  }
+
+  size_t total_len = 0;
+  auto* len_ptr = lengths_alloc.get();
+  for (const auto& t : types) {
+    total_len += t.size();
+    *len_ptr++ = t.size();
+  }
+
+  IAllocatorUniquePtr<char> buffer_alloc(reinterpret_cast<char*>(allocator->Alloc(allocator, total_len * sizeof(char))),
+                                         [allocator](char* p) { if(p) allocator->Free(allocator, p); });
+  if (!buffer_alloc) {
+    return OrtApis::CreateStatus(ORT_FAIL, "string buffer allocation failed");
+  }
+
+  char* buf_ptr = buffer_alloc.get();
+  for (const auto& t : types) {
+    memcpy(buf_ptr, t.data(), t.size());
+    buf_ptr += t.size();
+  }
+
+  IAllocatorUniquePtr<uint64_t> counts_alloc(
+      reinterpret_cast<uint64_t*>(allocator->Alloc(allocator, types.size() * *num_buckets * sizeof(uint64_t))),
+      [allocator](uint64_t* p) { if(p) allocator->Free(allocator, p); });
+  if (!counts_alloc) {
+    return OrtApis::CreateStatus(ORT_FAIL, "bucket counts allocation failed");
+  }
+  histograms->GetBucketCounts(counts_alloc.get());
+
+  *op_types = buffer_alloc.release();
+  *op_type_lengths = lengths_alloc.release();
+  *bucket_counts = counts_alloc.release();
+  *num_op_types = types.size();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetIntraOpThreadPoolStats, _In_ const OrtSession* sess,
+                    _Out_ OrtThreadPoolStats* stats) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  ::onnxruntime::concurrency::ThreadPoolStats pool_stats;
+  session->GetIntraOpThreadPoolStats(pool_stats);
+  stats->num_threads = pool_stats.num_threads;
+  stats->uptime_ns = pool_stats.uptime_ns;
+  stats->queue_depth = pool_stats.queue_depth;
+  stats->active_workers = pool_stats.active_workers;
+  stats->tasks_local = pool_stats.tasks_local;
+  stats->tasks_stolen = pool_stats.tasks_stolen;
+  stats->parallel_sections = pool_stats.parallel_sections;
+  stats->tasks_revoked = pool_stats.tasks_revoked;
+  stats->spin_ns = pool_stats.spin_ns;
+  stats->busy_ns = pool_stats.busy_ns;
   return nullptr;
   API_IMPL_END
 }
@@ -1286,6 +1519,22 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetShapeStatistics, _In_ const OrtSession* sess,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  const auto statistics = session->GetShapeStatisticsJson();
+  if (statistics.empty()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "The session does not collect shape statistics. "
+                                 "Set session.shape_statistics_sample_rate to enable them.");
+  }
+
+  *out = StrDup(statistics, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -2118,6 +2367,14 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->max_dead_bytes_per_chunk = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "initial_growth_chunk_size_bytes") == 0) {
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "max_thread_local_cache_bytes") == 0) {
+      cfg->max_thread_local_cache_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "shrink_idle_time_ms") == 0) {
+      cfg->shrink_idle_time_ms = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "shrink_watermark_percent") == 0) {
+      cfg->shrink_watermark_percent = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "use_huge_pages") == 0) {
+      cfg->use_huge_pages = static_cast<int>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2527,6 +2784,14 @@ static constexpr OrtApi ort_api_1_to_12 = {
     &OrtApis::CreateOp,
     &OrtApis::InvokeOp,
     &OrtApis::ReleaseOp,
+    &OrtApis::RunAsync,
+    &OrtApis::WarmupSession,
+    &OrtApis::RunBatch,
+    &OrtApis::SessionGetOpLatencyHistograms,
+    &OrtApis::SessionGetIntraOpThreadPoolStats,
+    &OrtApis::SessionGetShapeStatistics,
+    &OrtApis::KernelContext_GetInputTensorViews,
+    &OrtApis::KernelContext_GetOutputTensorViews,
 };
 
 // Asserts to do a some checks to ensure older Versions of the OrtApi never change (will detect an addition or deletion but not if they cancel out each other)
@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/optimized_model_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/murmurhash3.h"
+#include "core/graph/model.h"
+#include "core/platform/env.h"
+#include "core/platform/path_lib.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+namespace optimized_model_cache {
+
+namespace {
+
+// Bumped when the information hashed into the key changes, so older cache files are not picked up.
+constexpr uint32_t kKeyVersion = 1;
+
+class Hasher {
+ public:
+  void Add(const void* data, size_t len) {
+    // MurmurHash3 takes an int length
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    constexpr size_t kMaxChunk = static_cast<size_t>(std::numeric_limits<int>::max());
+    do {
+      const size_t chunk = std::min(len, kMaxChunk);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk), hash_[0], &hash_);
+      bytes += chunk;
+      len -= chunk;
+    } while (len > 0);
+  }
+
+  // strings are length prefixed so that consecutive strings cannot alias each other
+  void Add(const std::string& value) {
+    const uint64_t length = value.size();
+    Add(&length, sizeof(length));
+    Add(value.data(), value.size());
+  }
+
+  template <typename T>
+  void AddValue(const T& value) {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "AddValue requires a scalar");
+    Add(&value, sizeof(value));
+  }
+
+  std::string ToHexString() const {
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (uint32_t h : hash_) {
+      ss << std::setw(8) << h;
+    }
+    return ss.str();
+  }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+Status HashModelContent(Model& model, const PathString& model_location, Hasher& hasher) {
+  const Env& env = Env::Default();
+  size_t file_size = 0;
+  if (!model_location.empty() && env.GetFileLength(model_location.c_str(), file_size).IsOK()) {
+    if (file_size > 0) {
+      Env::MappedMemoryPtr mapped_file;
+      ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(model_location.c_str(), 0, file_size, mapped_file));
+      hasher.Add(mapped_file.get(), file_size);
+    }
+
+    return Status::OK();
+  }
+
+  const std::string serialized = model.ToProto().SerializeAsString();
+  hasher.Add(serialized.data(), serialized.size());
+  return Status::OK();
+}
+
+// graph transformers such as the NchwcTransformer generate CPU specific graphs
+void HashCpuFeatures(Hasher& hasher) {
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  const bool features[] = {cpu_info.HasAVX(), cpu_info.HasAVX2(), cpu_info.HasAVX512f(),
+                           cpu_info.HasAVX512Skylake(), cpu_info.HasF16C(), cpu_info.HasSSE3(),
+                           cpu_info.HasSSE4_1(), cpu_info.HasArmNeonDot()};
+  for (bool feature : features) {
+    hasher.AddValue(feature);
+  }
+}
+
+void HashSessionOptions(const SessionOptions& session_options,
+                        const InlinedHashSet<std::string>& optimizers_to_disable,
+                        Hasher& hasher) {
+  hasher.AddValue(session_options.graph_optimization_level);
+
+  std::vector<std::string> disabled(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  std::sort(disabled.begin(), disabled.end());
+  hasher.AddValue(disabled.size());
+  for (const auto& name : disabled) {
+    hasher.Add(name);
+  }
+
+  hasher.AddValue(session_options.free_dimension_overrides.size());
+  for (const auto& dim_override : session_options.free_dimension_overrides) {
+    hasher.Add(dim_override.dim_identifier);
+    hasher.AddValue(dim_override.dim_identifer_type);
+    hasher.AddValue(dim_override.dim_value);
+  }
+
+  // config entries select transformers and their behavior. sort them as the map is unordered.
+  std::vector<std::pair<std::string, std::string>> configs;
+  for (const auto& entry : session_options.config_options.configurations) {
+    if (entry.first != kOrtSessionOptionsConfigOptimizedModelCacheDir) {
+      configs.emplace_back(entry.first, entry.second);
+    }
+  }
+  std::sort(configs.begin(), configs.end());
+  hasher.AddValue(configs.size());
+  for (const auto& entry : configs) {
+    hasher.Add(entry.first);
+    hasher.Add(entry.second);
+  }
+}
+
+int RenameFile(const PathString& from, const PathString& to) {
+#ifdef _WIN32
+  return _wrename(from.c_str(), to.c_str());
+#else
+  return std::rename(from.c_str(), to.c_str());
+#endif
+}
+
+void RemoveFile(const PathString& path) {
+#ifdef _WIN32
+  _wremove(path.c_str());
+#else
+  std::remove(path.c_str());
+#endif
+}
+
+}  // namespace
+
+Status GetCacheFilePath(const PathString& cache_dir, Model& model, const PathString& model_location,
+                        const SessionOptions& session_options,
+                        const InlinedHashSet<std::string>& optimizers_to_disable,
+                        const std::vector<std::string>& execution_provider_ids,
+                        PathString& cache_file_path) {
+  Hasher hasher;
+  hasher.AddValue(kKeyVersion);
+  hasher.Add(ORT_VERSION);
+  HashCpuFeatures(hasher);
+
+  hasher.AddValue(execution_provider_ids.size());
+  for (const auto& id : execution_provider_ids) {
+    hasher.Add(id);
+  }
+
+  HashSessionOptions(session_options, optimizers_to_disable, hasher);
+  ORT_RETURN_IF_ERROR(HashModelContent(model, model_location, hasher));
+
+  cache_file_path = ConcatPathComponent<ORTCHAR_T>(cache_dir, ToPathString(hasher.ToHexString() + ".ort"));
+  return Status::OK();
+}
+
+void SaveCacheFile(const PathString& cache_dir, const PathString& cache_file_path,
+                   const std::function<Status(const PathString&)>& save_to_file,
+                   const logging::Logger& logger) {
+  const Env& env = Env::Default();
+  // another process may create the directory concurrently
+  if (!env.FolderExists(cache_dir) && !env.CreateFolder(cache_dir).IsOK() && !env.FolderExists(cache_dir)) {
+    LOGS(logger, WARNING) << "Failed to create optimized model cache directory " << ToUTF8String(cache_dir);
+    return;
+  }
+
+  const PathString temp_file_path = cache_file_path + ToPathString("." + std::to_string(env.GetSelfPid()) + ".tmp");
+  Status status = save_to_file(temp_file_path);
+  if (status.IsOK() && RenameFile(temp_file_path, cache_file_path) != 0) {
+    // e.g. another process has the file open on Windows. That process saved the same model.
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename ", ToUTF8String(temp_file_path));
+  }
+
+  if (!status.IsOK()) {
+    RemoveFile(temp_file_path);
+    LOGS(logger, WARNING) << "Failed to save the optimized model to cache file " << ToUTF8String(cache_file_path)
+                          << ": " << status.ErrorMessage();
+    return;
+  }
+
+  LOGS(logger, INFO) << "Saved the optimized model to cache file " << ToUTF8String(cache_file_path);
+}
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/common/path_string.h"
+#include "core/framework/session_options.h"
+
+namespace onnxruntime {
+
+class Model;
+
+/**
+ * Directory of ORT format models saved after graph optimization, so that later sessions (typically in other
+ * processes) loading the same model with the same configuration skip the graph transformers.
+ *
+ * A cached model is keyed by a hash of the model content, the ids of the execution providers, the onnxruntime
+ * version, the CPU features, and the session options that affect graph optimization. A change to any of them
+ * selects a different file, so stale entries are never loaded.
+ */
+namespace optimized_model_cache {
+
+/**
+ * Returns the path of the cached model in cache_dir for the given session configuration.
+ * The content of model is hashed from model_location if it is a file, and from the serialized model otherwise.
+ */
+Status GetCacheFilePath(const PathString& cache_dir, Model& model, const PathString& model_location,
+                        const SessionOptions& session_options,
+                        const InlinedHashSet<std::string>& optimizers_to_disable,
+                        const std::vector<std::string>& execution_provider_ids,
+                        PathString& cache_file_path);
+
+/**
+ * Writes the cache file with save_to_file, creating the cache directory if needed.
+ * The file is written to a temporary file that is renamed into place, so concurrent readers never see a
+ * partial file. Failures are logged rather than returned as the session can run without the cache.
+ */
+void SaveCacheFile(const PathString& cache_dir, const PathString& cache_file_path,
+                   const std::function<Status(const PathString&)>& save_to_file,
+                   const logging::Logger& logger);
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
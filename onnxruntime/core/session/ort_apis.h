@@ -375,4 +375,39 @@ ORT_API_STATUS_IMPL(InvokeOp,
 
 ORT_API(void, ReleaseOp, _Frees_ptr_opt_ OrtOp* op);
 
+ORT_API_STATUS_IMPL(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+ORT_API_STATUS_IMPL(WarmupSession, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(num_warmups* input_len) const int64_t* const* input_shapes,
+                    _In_reads_(num_warmups* input_len) const size_t* input_shape_lens, size_t num_warmups,
+                    int freeze_arenas, _Out_opt_ int64_t* run_durations_us);
+
+ORT_API_STATUS_IMPL(RunBatch, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(batch_size* input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    size_t batch_size, _Inout_updates_all_(batch_size* output_names_len) OrtValue** outputs);
+
+ORT_API_STATUS_IMPL(SessionGetOpLatencyHistograms, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_result_maybenull_ char** op_types, _Outptr_result_maybenull_ size_t** op_type_lengths,
+                    _Outptr_result_maybenull_ uint64_t** bucket_counts, _Out_ size_t* num_op_types,
+                    _Out_ size_t* num_buckets);
+
+ORT_API_STATUS_IMPL(SessionGetIntraOpThreadPoolStats, _In_ const OrtSession* sess, _Out_ OrtThreadPoolStats* stats);
+
+ORT_API_STATUS_IMPL(SessionGetShapeStatistics, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(KernelContext_GetInputTensorViews, _In_ const OrtKernelContext* context,
+                    _Out_writes_all_(count) OrtTensorView* views, size_t count);
+ORT_API_STATUS_IMPL(KernelContext_GetOutputTensorViews, _Inout_ OrtKernelContext* context,
+                    _In_reads_(count) const int64_t* const* dims, _In_reads_(count) const size_t* num_dims,
+                    _Out_writes_all_(count) OrtTensorView* views, size_t count);
+
 }  // namespace OrtApis
@@ -557,7 +557,7 @@ struct ProviderHostImpl : ProviderHost {
   void KernelDefBuilder__VariadicAlias(KernelDefBuilder* p, int input_offset, int output_offset) override { p->VariadicAlias(input_offset, output_offset); }
   void KernelDefBuilder__ExternalOutputs(KernelDefBuilder* p) override { p->ExternalOutputs(); }
   void KernelDefBuilder__AllocateInputsContiguously(KernelDefBuilder* p) override { p->AllocateInputsContiguously(); }
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
   void KernelDefBuilder__MayStridedInput(KernelDefBuilder* p, int input_index) override { p->MayStridedInput(input_index); }
   void KernelDefBuilder__MayStridedOutput(KernelDefBuilder* p, int input_index, int output_index) override { p->MayStridedOutput(input_index, output_index); }
 #endif
@@ -894,7 +894,7 @@ struct ProviderHostImpl : ProviderHost {
   const OrtMemoryInfo& Tensor__Location(const Tensor* p) override { return p->Location(); }
   int32_t Tensor__GetElementType(const Tensor* p) override { return p->GetElementType(); }
   MLDataType Tensor__DataType(const Tensor* p) override { return p->DataType(); }
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
   gsl::span<const int64_t> Tensor__Strides(const Tensor* p) override { return p->Strides(); }
   bool Tensor__IsContiguous(const Tensor* p) override { return p->IsContiguous(); }
   void Tensor__SetShapeAndStrides(Tensor* p, const TensorShape& new_shape,
@@ -1118,6 +1118,12 @@ OrtCUDAProviderOptionsV2 OrtCUDAProviderOptionsToOrtCUDAProviderOptionsV2(const
   cuda_options_converted.cudnn_conv_use_max_workspace = 0;
   cuda_options_converted.enable_cuda_graph = 0;
   cuda_options_converted.cudnn_conv1d_pad_to_nc1d = 0;
+  cuda_options_converted.num_compute_streams = 1;
+  cuda_options_converted.max_cuda_graphs = 8;
+  cuda_options_converted.use_cuda_mempool = 0;
+  cuda_options_converted.cuda_mempool_release_threshold = 0;
+  cuda_options_converted.cudnn_conv_algo_cache_file = nullptr;
+  cuda_options_converted.fused_elementwise_cache_dir = nullptr;
 
   return cuda_options_converted;
 }
@@ -1171,6 +1177,10 @@ OrtTensorRTProviderOptionsV2 OrtTensorRTProviderOptionsToOrtTensorRTProviderOpti
   trt_options_converted.trt_force_sequential_engine_build = legacy_trt_options->trt_force_sequential_engine_build;
   // Add new provider option below
   // Use default value as this field is not available in OrtTensorRTProviderOptionsV
+  trt_options_converted.trt_engine_build_async = 0;
+  trt_options_converted.trt_profile_min_shapes = nullptr;
+  trt_options_converted.trt_profile_max_shapes = nullptr;
+  trt_options_converted.trt_profile_opt_shapes = nullptr;
 
   return trt_options_converted;
 }
@@ -1462,6 +1472,10 @@ ORT_API_STATUS_IMPL(OrtApis::CreateTensorRTProviderOptions, _Outptr_ OrtTensorRT
   (*out)->trt_engine_decryption_enable = false;
   (*out)->trt_engine_decryption_lib_path = nullptr;
   (*out)->trt_force_sequential_engine_build = false;
+  (*out)->trt_engine_build_async = false;
+  (*out)->trt_profile_min_shapes = nullptr;
+  (*out)->trt_profile_max_shapes = nullptr;
+  (*out)->trt_profile_opt_shapes = nullptr;
   return nullptr;
 #else
   ORT_UNUSED_PARAMETER(out);
@@ -1582,6 +1596,12 @@ ORT_API_STATUS_IMPL(OrtApis::CreateCUDAProviderOptions, _Outptr_ OrtCUDAProvider
   (*out)->cudnn_conv_use_max_workspace = 0;
   (*out)->enable_cuda_graph = 0;
   (*out)->cudnn_conv1d_pad_to_nc1d = 0;
+  (*out)->num_compute_streams = 1;
+  (*out)->max_cuda_graphs = 8;
+  (*out)->use_cuda_mempool = 0;
+  (*out)->cuda_mempool_release_threshold = 0;
+  (*out)->cudnn_conv_algo_cache_file = nullptr;
+  (*out)->fused_elementwise_cache_dir = nullptr;
   return nullptr;
 #else
   ORT_UNUSED_PARAMETER(out);
@@ -1655,6 +1675,10 @@ ORT_API_STATUS_IMPL(OrtApis::GetCUDAProviderOptionsAsString, _In_ const OrtCUDAP
 
 ORT_API(void, OrtApis::ReleaseCUDAProviderOptions, _Frees_ptr_opt_ OrtCUDAProviderOptionsV2* ptr) {
 #ifdef USE_CUDA
+  if (ptr != nullptr) {
+    delete[] ptr->cudnn_conv_algo_cache_file;
+    delete[] ptr->fused_elementwise_cache_dir;
+  }
   delete ptr;
 #else
   ORT_UNUSED_PARAMETER(ptr);
@@ -0,0 +1,246 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_result_cache.h"
+
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr uint32_t kHashSeed = 0x5eed;
+
+template <typename T>
+void AppendBytes(std::string& signature, T value) {
+  signature.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// a run can only be cached if its feeds can be hashed and copied on the CPU
+bool IsCacheableTensor(const OrtValue& value) {
+  if (!value.IsTensor()) {
+    return false;
+  }
+
+  const auto& tensor = value.Get<Tensor>();
+  return !tensor.IsDataTypeString() && tensor.Location().device.Type() == OrtDevice::CPU &&
+         tensor.SizeInBytes() <= static_cast<size_t>(std::numeric_limits<int>::max());
+}
+
+// whether the training_mode input of a dropout node is not a constant false
+bool IsTrainingMode(const Graph& graph, const Node& node, size_t training_mode_index) {
+  const auto& inputs = node.InputDefs();
+  if (training_mode_index >= inputs.size() || !inputs[training_mode_index]->Exists()) {
+    return false;
+  }
+
+  const auto* initializer = graph.GetConstantInitializer(inputs[training_mode_index]->Name(), true);
+  bool training_mode = true;
+  if (initializer == nullptr || !utils::UnpackTensor(*initializer, graph.ModelPath(), &training_mode, 1).IsOK()) {
+    return true;
+  }
+  return training_mode;
+}
+
+// a copy of a tensor on the CPU in a new buffer of the allocator
+OrtValue CopyTensor(const Tensor& tensor, const AllocatorPtr& allocator) {
+  OrtValue copy;
+  Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), allocator, copy);
+  if (tensor.SizeInBytes() > 0) {
+    std::memcpy(copy.GetMutable<Tensor>()->MutableDataRaw(), tensor.DataRaw(), tensor.SizeInBytes());
+  }
+  return copy;
+}
+
+}  // namespace
+
+RunResultCache::RunResultCache(size_t max_bytes, std::chrono::milliseconds ttl, AllocatorPtr allocator)
+    : max_bytes_(max_bytes), ttl_(ttl), allocator_(std::move(allocator)) {
+}
+
+bool RunResultCache::GetKey(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                            const std::vector<std::string>& output_names, Key& key) const {
+  if (feed_names.size() != feeds.size()) {
+    return false;
+  }
+
+  key.signature.clear();
+  std::string data_hashes;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!IsCacheableTensor(feeds[i])) {
+      return false;
+    }
+
+    const auto& tensor = feeds[i].Get<Tensor>();
+    key.signature.append(feed_names[i]).push_back('\0');
+    AppendBytes(key.signature, tensor.GetElementType());
+    const auto dims = tensor.Shape().GetDims();
+    AppendBytes(key.signature, dims.size());
+    for (int64_t dim : dims) {
+      AppendBytes(key.signature, dim);
+    }
+
+    std::array<uint64_t, 2> data_hash;
+    MurmurHash3::x86_128(tensor.DataRaw(), static_cast<int>(tensor.SizeInBytes()), kHashSeed, data_hash.data());
+    AppendBytes(data_hashes, data_hash);
+  }
+
+  AppendBytes(key.signature, output_names.size());
+  for (const auto& output_name : output_names) {
+    key.signature.append(output_name).push_back('\0');
+  }
+
+  const std::string hashed = key.signature + data_hashes;
+  if (hashed.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return false;
+  }
+  MurmurHash3::x86_128(hashed.data(), static_cast<int>(hashed.size()), kHashSeed, key.hash.data());
+  return true;
+}
+
+bool RunResultCache::Lookup(const Key& key, const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches) {
+  std::vector<OrtValue> cached_fetches;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto found = index_.find(key.hash);
+    if (found == index_.end()) {
+      ++num_misses_;
+      return false;
+    }
+
+    auto entry = found->second;
+    if (ttl_.count() > 0 && Clock::now() - entry->inserted >= ttl_) {
+      Erase(entry);
+      ++num_misses_;
+      return false;
+    }
+
+    bool equal = entry->key.signature == key.signature && entry->feed_data.size() == feeds.size();
+    for (size_t i = 0; equal && i < feeds.size(); ++i) {
+      const auto& tensor = feeds[i].Get<Tensor>();
+      equal = entry->feed_data[i].size() == tensor.SizeInBytes() &&
+              (tensor.SizeInBytes() == 0 ||
+               std::memcmp(entry->feed_data[i].data(), tensor.DataRaw(), tensor.SizeInBytes()) == 0);
+    }
+    if (!equal) {
+      ++num_misses_;
+      return false;
+    }
+
+    entries_.splice(entries_.begin(), entries_, entry);
+    // the cached outputs are only read, so they are copied once the entry is held and the lock released
+    cached_fetches = entry->fetches;
+    ++num_hits_;
+  }
+
+  fetches.clear();
+  fetches.reserve(cached_fetches.size());
+  for (const auto& cached_fetch : cached_fetches) {
+    fetches.push_back(CopyTensor(cached_fetch.Get<Tensor>(), allocator_));
+  }
+  return true;
+}
+
+void RunResultCache::Insert(const Key& key, const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches) {
+  Entry entry{key, {}, {}, key.signature.size(), Clock::now()};
+
+  for (const auto& fetch : fetches) {
+    if (!IsCacheableTensor(fetch)) {
+      return;
+    }
+    entry.size_in_bytes += fetch.Get<Tensor>().SizeInBytes();
+  }
+
+  for (const auto& feed : feeds) {
+    entry.size_in_bytes += feed.Get<Tensor>().SizeInBytes();
+  }
+  if (entry.size_in_bytes > max_bytes_) {
+    return;
+  }
+
+  entry.feed_data.reserve(feeds.size());
+  for (const auto& feed : feeds) {
+    const auto& tensor = feed.Get<Tensor>();
+    const auto* data = static_cast<const uint8_t*>(tensor.DataRaw());
+    entry.feed_data.emplace_back(data, data + tensor.SizeInBytes());
+  }
+
+  // the outputs of the run belong to its caller, which may modify them
+  entry.fetches.reserve(fetches.size());
+  for (const auto& fetch : fetches) {
+    entry.fetches.push_back(CopyTensor(fetch.Get<Tensor>(), allocator_));
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto found = index_.find(key.hash);
+  if (found != index_.end()) {
+    Erase(found->second);
+  }
+
+  size_in_bytes_ += entry.size_in_bytes;
+  entries_.push_front(std::move(entry));
+  index_[key.hash] = entries_.begin();
+  while (size_in_bytes_ > max_bytes_) {
+    Erase(std::prev(entries_.end()));
+  }
+}
+
+void RunResultCache::Erase(std::list<Entry>::iterator entry) {
+  size_in_bytes_ -= entry->size_in_bytes;
+  index_.erase(entry->key.hash);
+  entries_.erase(entry);
+}
+
+const Node* RunResultCache::FindNondeterministicNode(const Graph& graph) {
+  static const std::unordered_set<std::string> random_ops{"Bernoulli", "Multinomial", "RandomNormal",
+                                                          "RandomNormalLike", "RandomUniform", "RandomUniformLike"};
+  // the index of the training_mode input of the dropout ops, which are random in training mode only
+  static const std::unordered_map<std::string, size_t> dropout_ops{
+      {"Dropout", 2}, {"BitmaskDropout", 2}, {"BiasDropout", 4}, {"BitmaskBiasDropout", 4}};
+
+  for (const auto& node : graph.Nodes()) {
+    if (random_ops.count(node.OpType()) > 0) {
+      return &node;
+    }
+
+    auto dropout = dropout_ops.find(node.OpType());
+    if (dropout != dropout_ops.end() && IsTrainingMode(graph, node, dropout->second)) {
+      return &node;
+    }
+
+    for (const auto& subgraph : node.GetSubgraphs()) {
+      const Node* nondeterministic_node = FindNondeterministicNode(*subgraph);
+      if (nondeterministic_node != nullptr) {
+        return nondeterministic_node;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+size_t RunResultCache::NumHits() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return num_hits_;
+}
+
+size_t RunResultCache::NumMisses() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return num_misses_;
+}
+
+size_t RunResultCache::SizeInBytes() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return size_in_bytes_;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class Graph;
+class Node;
+
+/**
+ * Outputs of recent runs of a session, by the values of their feeds.
+ *
+ * The feeds of a run are hashed with MurmurHash3; a later run with equal feeds and the same output names returns the
+ * cached outputs without executing the graph. The cache keeps copies of the outputs and returns new copies on each hit,
+ * so the callers own the outputs they get and may modify them. The entries are evicted in least recently used order to
+ * stay within a byte budget, which counts the copies of the feeds kept to compare them as well as the outputs, and
+ * expire after a time to live.
+ *
+ * Only runs whose feeds and outputs are non-string tensors on CPU are cached.
+ */
+class RunResultCache {
+ public:
+  struct Key {
+    // 128-bit hash of the signature and of the feed data
+    std::array<uint64_t, 2> hash;
+    // names, types and shapes of the feeds, and output names
+    std::string signature;
+  };
+
+  /**
+   * @param max_bytes Budget of the cached feeds and outputs.
+   * @param ttl Time after which an entry expires, 0 for entries that do not expire.
+   * @param allocator CPU allocator of the copies of the outputs.
+   */
+  RunResultCache(size_t max_bytes, std::chrono::milliseconds ttl, AllocatorPtr allocator);
+
+  /**
+   * Computes the key of a run.
+   * @returns false if the run can't be cached, e.g. because a feed is not a tensor on CPU.
+   */
+  bool GetKey(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+              const std::vector<std::string>& output_names, Key& key) const;
+
+  /**
+   * Looks up the outputs of a previous run with the same key and equal feeds.
+   * @returns true and copies of the outputs in fetches on a hit.
+   */
+  bool Lookup(const Key& key, const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches);
+
+  /**
+   * Caches copies of the outputs of a run, evicting the least recently used entries to fit the budget.
+   */
+  void Insert(const Key& key, const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches);
+
+  /**
+   * @returns A node of the graph or of its subgraphs whose outputs are not a function of its inputs, like RandomNormal
+   * or Dropout in training mode, nullptr if there is none.
+   */
+  static const Node* FindNondeterministicNode(const Graph& graph);
+
+  size_t NumHits() const;
+  size_t NumMisses() const;
+  size_t SizeInBytes() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunResultCache);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct KeyHash {
+    size_t operator()(const std::array<uint64_t, 2>& hash) const { return static_cast<size_t>(hash[0] ^ hash[1]); }
+  };
+
+  struct Entry {
+    Key key;
+    // copies of the feed data, compared on a hit so that a hash collision can't return the outputs of other feeds
+    std::vector<std::vector<uint8_t>> feed_data;
+    std::vector<OrtValue> fetches;
+    size_t size_in_bytes;
+    Clock::time_point inserted;
+  };
+
+  void Erase(std::list<Entry>::iterator entry);
+
+  const size_t max_bytes_;
+  const std::chrono::milliseconds ttl_;
+  const AllocatorPtr allocator_;
+
+  mutable OrtMutex mutex_;
+  // most recently used first
+  std::list<Entry> entries_;
+  std::unordered_map<std::array<uint64_t, 2>, std::list<Entry>::iterator, KeyHash> index_;
+  size_t size_in_bytes_ = 0;
+  size_t num_hits_ = 0;
+  size_t num_misses_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,346 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/session_pipeline.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <limits>
+#include <thread>
+
+#include "core/framework/run_options.h"
+#include "core/framework/utils.h"
+#include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
+
+namespace onnxruntime {
+
+namespace {
+// no previous stage produces the input, it is fed from the request
+constexpr size_t kFromFeeds = std::numeric_limits<size_t>::max();
+}  // namespace
+
+struct SessionPipeline::Stage {
+  struct Input {
+    std::string name;
+    size_t source_stage;
+    std::string source_output;
+  };
+
+  explicit Stage(InferenceSession& session_in) : session(session_in) {}
+
+  InferenceSession& session;
+  std::vector<Input> inputs;
+  std::vector<std::string> output_names;
+  // the outputs consumed by later stages, with the device they are produced on
+  std::vector<std::pair<std::string, OrtDevice>> forwarded_outputs;
+  // the index of the last stage consuming each forwarded output
+  std::unordered_map<std::string, size_t> last_consumers;
+
+  // only used by the thread of the stage
+  std::unique_ptr<IOBinding> binding;
+  std::vector<std::pair<std::string, OrtDevice>> bound_outputs;
+
+  std::mutex mutex;
+  std::condition_variable queue_changed;
+  std::deque<std::unique_ptr<Request>> queue;
+  bool closed = false;
+  std::thread thread;
+};
+
+struct SessionPipeline::Request {
+  NameMLValMap feeds;
+  std::vector<std::string> output_names;
+  // the index of the stage each output is fetched from
+  std::vector<size_t> output_stages;
+  // the outputs of each stage that haven't been consumed yet
+  std::vector<std::unordered_map<std::string, OrtValue>> stage_outputs;
+  RunCallback callback;
+  common::Status status;
+
+  bool IsFetched(size_t stage_index, const std::string& name) const {
+    for (size_t i = 0; i < output_names.size(); ++i) {
+      if (output_stages[i] == stage_index && output_names[i] == name) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+SessionPipeline::SessionPipeline(const SessionPipelineOptions& options) : options_(options) {
+  ORT_ENFORCE(options_.max_queued_requests > 0, "max_queued_requests must be greater than 0");
+}
+
+SessionPipeline::~SessionPipeline() {
+  // close the stages in order so each one drains its queue into the next one before it is closed
+  for (auto& stage : stages_) {
+    {
+      std::lock_guard<std::mutex> lock(stage->mutex);
+      stage->closed = true;
+    }
+    stage->queue_changed.notify_all();
+    if (stage->thread.joinable()) {
+      stage->thread.join();
+    }
+  }
+}
+
+common::Status SessionPipeline::AddStage(InferenceSession& session,
+                                         const std::unordered_map<std::string, std::string>& input_sources) {
+  {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    ORT_RETURN_IF(started_, "Stages can't be added to a SessionPipeline once it has run requests.");
+  }
+
+  auto inputs_result = session.GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs_result.first);
+  auto outputs_result = session.GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs_result.first);
+
+  auto stage = std::make_unique<Stage>(session);
+  const size_t stage_index = stages_.size();
+
+  for (const auto& source : input_sources) {
+    const auto& inputs = *inputs_result.second;
+    ORT_RETURN_IF(std::none_of(inputs.cbegin(), inputs.cend(),
+                               [&source](const NodeArg* input) { return input->Name() == source.first; }),
+                  "Stage ", stage_index, " has no input named '", source.first, "'.");
+  }
+
+  for (const NodeArg* input : *inputs_result.second) {
+    Stage::Input stage_input{input->Name(), kFromFeeds, input->Name()};
+    auto source = input_sources.find(input->Name());
+    if (source != input_sources.cend()) {
+      stage_input.source_output = source->second;
+    }
+
+    for (size_t i = stage_index; i > 0; --i) {
+      const auto& producer_outputs = stages_[i - 1]->output_names;
+      if (std::find(producer_outputs.cbegin(), producer_outputs.cend(), stage_input.source_output) !=
+          producer_outputs.cend()) {
+        stage_input.source_stage = i - 1;
+        break;
+      }
+    }
+
+    ORT_RETURN_IF(source != input_sources.cend() && stage_input.source_stage == kFromFeeds,
+                  "No stage before stage ", stage_index, " produces the output '", stage_input.source_output,
+                  "' consumed by its input '", stage_input.name, "'.");
+    stage->inputs.push_back(std::move(stage_input));
+  }
+
+  for (const NodeArg* output : *outputs_result.second) {
+    stage->output_names.push_back(output->Name());
+  }
+
+  // keep the consumed outputs on the device they are produced on, the consuming session copies them if needed
+  for (const auto& input : stage->inputs) {
+    if (input.source_stage == kFromFeeds) {
+      continue;
+    }
+
+    Stage& producer = *stages_[input.source_stage];
+    producer.last_consumers[input.source_output] = stage_index;
+    auto& forwarded = producer.forwarded_outputs;
+    if (std::none_of(forwarded.cbegin(), forwarded.cend(),
+                     [&input](const std::pair<std::string, OrtDevice>& output) {
+                       return output.first == input.source_output;
+                     })) {
+      const OrtMemoryInfo& location =
+          utils::FindMemoryInfoForValue(producer.session.GetSessionState(), input.source_output);
+      forwarded.emplace_back(input.source_output, location.device);
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(session.NewIOBinding(&stage->binding));
+  stages_.push_back(std::move(stage));
+  return Status::OK();
+}
+
+void SessionPipeline::Start() {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+  if (started_) {
+    return;
+  }
+
+  for (size_t i = 0; i < stages_.size(); ++i) {
+    stages_[i]->thread = std::thread([this, i]() { RunStageLoop(i); });
+  }
+  started_ = true;
+}
+
+common::Status SessionPipeline::Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
+                                    std::vector<OrtValue>& fetches) {
+  std::promise<Status> completed;
+  auto result = completed.get_future();
+  ORT_RETURN_IF_ERROR(RunAsync(feeds, output_names,
+                               [&completed, &fetches](const Status& status, std::vector<OrtValue>& outputs) {
+                                 if (status.IsOK()) {
+                                   fetches = std::move(outputs);
+                                 }
+                                 completed.set_value(status);
+                               }));
+  return result.get();
+}
+
+common::Status SessionPipeline::RunAsync(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
+                                         RunCallback callback) {
+  ORT_RETURN_IF(stages_.empty(), "SessionPipeline has no stages.");
+  ORT_RETURN_IF(!callback, "A callback is required.");
+
+  auto request = std::make_unique<Request>();
+  request->feeds = feeds;
+  request->output_names = output_names;
+  request->stage_outputs.resize(stages_.size());
+  request->callback = std::move(callback);
+
+  for (const auto& name : output_names) {
+    size_t output_stage = kFromFeeds;
+    for (size_t i = stages_.size(); i > 0; --i) {
+      const auto& stage_outputs = stages_[i - 1]->output_names;
+      if (std::find(stage_outputs.cbegin(), stage_outputs.cend(), name) != stage_outputs.cend()) {
+        output_stage = i - 1;
+        break;
+      }
+    }
+
+    if (output_stage == kFromFeeds) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No stage of the SessionPipeline produces the output '",
+                             name, "'.");
+    }
+    request->output_stages.push_back(output_stage);
+  }
+
+  Start();
+
+  Stage& first = *stages_.front();
+  std::unique_lock<std::mutex> lock(first.mutex);
+  first.queue_changed.wait(lock, [this, &first]() {
+    return first.closed || first.queue.size() < options_.max_queued_requests;
+  });
+  ORT_RETURN_IF(first.closed, "SessionPipeline is being destroyed.");
+  first.queue.push_back(std::move(request));
+  lock.unlock();
+  first.queue_changed.notify_all();
+  return Status::OK();
+}
+
+void SessionPipeline::RunStageLoop(size_t stage_index) {
+  Stage& stage = *stages_[stage_index];
+  Stage* next = stage_index + 1 < stages_.size() ? stages_[stage_index + 1].get() : nullptr;
+
+  for (;;) {
+    std::unique_ptr<Request> request;
+    {
+      std::unique_lock<std::mutex> lock(stage.mutex);
+      stage.queue_changed.wait(lock, [&stage]() { return stage.closed || !stage.queue.empty(); });
+      if (stage.queue.empty()) {
+        return;
+      }
+      request = std::move(stage.queue.front());
+      stage.queue.pop_front();
+    }
+    // the producer may be waiting for room in the queue
+    stage.queue_changed.notify_all();
+
+    request->status = RunStage(stage_index, *request);
+
+    // a failed request skips the remaining stages
+    if (!request->status.IsOK() || next == nullptr) {
+      CompleteRequest(std::move(request));
+      continue;
+    }
+
+    {
+      // the next stage is only closed after this one has stopped, so it always accepts the request
+      std::unique_lock<std::mutex> lock(next->mutex);
+      next->queue_changed.wait(lock, [this, next]() { return next->queue.size() < options_.max_queued_requests; });
+      next->queue.push_back(std::move(request));
+    }
+    next->queue_changed.notify_all();
+  }
+}
+
+common::Status SessionPipeline::RunStage(size_t stage_index, Request& request) {
+  Stage& stage = *stages_[stage_index];
+  IOBinding& binding = *stage.binding;
+
+  for (const auto& input : stage.inputs) {
+    if (input.source_stage == kFromFeeds) {
+      auto feed = request.feeds.find(input.name);
+      // an input with an initializer or an optional input may not be fed, the session reports the missing ones
+      if (feed != request.feeds.cend()) {
+        ORT_RETURN_IF_ERROR(binding.BindInput(input.name, feed->second));
+      }
+    } else {
+      const auto& produced = request.stage_outputs[input.source_stage];
+      auto value = produced.find(input.source_output);
+      ORT_RETURN_IF(value == produced.cend(), "Output '", input.source_output, "' of stage ", input.source_stage,
+                    " is not available for stage ", stage_index, ".");
+      ORT_RETURN_IF_ERROR(binding.BindInput(input.name, value->second));
+    }
+  }
+
+  // the forwarded outputs stay on their device, the outputs that are only fetched are returned on CPU
+  std::vector<std::pair<std::string, OrtDevice>> outputs = stage.forwarded_outputs;
+  for (size_t i = 0; i < request.output_names.size(); ++i) {
+    const auto& name = request.output_names[i];
+    if (request.output_stages[i] == stage_index &&
+        std::none_of(outputs.cbegin(), outputs.cend(),
+                     [&name](const std::pair<std::string, OrtDevice>& output) { return output.first == name; })) {
+      outputs.emplace_back(name, OrtDevice());
+    }
+  }
+
+  // rebinding the same outputs keeps the prepared run of the binding. it also replaces the values returned by the
+  // previous request, which are still in use, so they aren't written to
+  if (outputs != stage.bound_outputs) {
+    binding.ClearOutputs();
+    stage.bound_outputs = outputs;
+  }
+  for (const auto& output : outputs) {
+    ORT_RETURN_IF_ERROR(binding.BindOutput(output.first, output.second));
+  }
+
+  ORT_RETURN_IF_ERROR(stage.session.Run(RunOptions(), binding));
+
+  const auto& names = binding.GetOutputNames();
+  auto& values = binding.GetOutputs();
+  auto& produced = request.stage_outputs[stage_index];
+  for (size_t i = 0; i < names.size(); ++i) {
+    produced[names[i]] = std::move(values[i]);
+  }
+
+  // release the intermediate values this stage was the last consumer of
+  for (size_t i = 0; i < stage_index; ++i) {
+    auto& stage_outputs = request.stage_outputs[i];
+    for (const auto& consumer : stages_[i]->last_consumers) {
+      if (consumer.second == stage_index && !request.IsFetched(i, consumer.first)) {
+        stage_outputs.erase(consumer.first);
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+void SessionPipeline::CompleteRequest(std::unique_ptr<Request> request) {
+  std::vector<OrtValue> fetches;
+  if (request->status.IsOK()) {
+    fetches.reserve(request->output_names.size());
+    for (size_t i = 0; i < request->output_names.size(); ++i) {
+      fetches.push_back(request->stage_outputs[request->output_stages[i]][request->output_names[i]]);
+    }
+  }
+
+  // release the values of the request before notifying the caller
+  auto callback = std::move(request->callback);
+  const Status status = request->status;
+  request.reset();
+  callback(status, fetches);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+struct SessionPipelineOptions {
+  // Maximum number of requests waiting in front of each stage. When the queue of a stage is full, the previous stage
+  // (or RunAsync() for the first stage) waits, which bounds the intermediate values held by the pipeline.
+  size_t max_queued_requests = 4;
+};
+
+/**
+ * Chains sessions, e.g. tokenizer -> encoder -> decoder -> postprocessing, so the outputs of a stage feed the inputs
+ * of the later stages without going through the caller.
+ *
+ * Each stage has a thread that runs its session through an IOBinding. The outputs of a stage that are consumed by
+ * later stages are bound to the device they are produced on, so an intermediate value only moves if the consuming
+ * session needs it on another device. Stages are connected by bounded queues, so the stages of consecutive requests
+ * run concurrently, e.g. the encoder of a request runs while the decoder runs the previous one.
+ *
+ * The sessions must be initialized, and must outlive the pipeline.
+ */
+class SessionPipeline {
+ public:
+  using RunCallback = std::function<void(const common::Status& status, std::vector<OrtValue>& fetches)>;
+
+  explicit SessionPipeline(const SessionPipelineOptions& options = {});
+
+  // Waits for the requests in flight to complete.
+  ~SessionPipeline();
+
+  /**
+   * Append a stage running a session.
+   * Each input of the session is connected to the output of the same name of the closest previous stage producing
+   * one. @param input_sources maps an input to an output of another name instead. Inputs that are not connected are
+   * fed from the feeds of the requests.
+   * Stages can't be added once a request has been run.
+   */
+  common::Status AddStage(InferenceSession& session,
+                          const std::unordered_map<std::string, std::string>& input_sources = {}) ORT_MUST_USE_RESULT;
+
+  /**
+   * Run a request through all the stages. Blocks until the results are available.
+   * An output name is fetched from the last stage producing it. An output that is also consumed by a later stage
+   * is returned on the device it was produced on, other outputs are returned on CPU.
+   * Thread-safe.
+   */
+  common::Status Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
+                     std::vector<OrtValue>& fetches) ORT_MUST_USE_RESULT;
+
+  /**
+   * Queue a request and return once it is accepted by the first stage. @param callback is called with the results
+   * from a thread of the pipeline, and must not block for long as it stalls that stage.
+   * Thread-safe.
+   */
+  common::Status RunAsync(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
+                          RunCallback callback) ORT_MUST_USE_RESULT;
+
+  size_t NumStages() const noexcept { return stages_.size(); }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionPipeline);
+
+  struct Stage;
+  struct Request;
+
+  // Starts the stage threads if they are not running yet.
+  void Start();
+  void RunStageLoop(size_t stage_index);
+  common::Status RunStage(size_t stage_index, Request& request);
+  void CompleteRequest(std::unique_ptr<Request> request);
+
+  const SessionPipelineOptions options_;
+  std::vector<std::unique_ptr<Stage>> stages_;
+
+  std::mutex start_mutex_;
+  bool started_ = false;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/shape_specializer.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// the run counts of values that were never specialized are dropped once this many are tracked
+constexpr size_t kMaxTrackedKeys = 64;
+
+}  // namespace
+
+ShapeSpecializer::ShapeSpecializer(std::unordered_map<std::string, std::vector<std::string>> input_dim_params,
+                                   size_t max_specializations, size_t min_runs,
+                                   CreateSessionFn create_session, const logging::Logger& logger)
+    : input_dim_params_(std::move(input_dim_params)),
+      max_specializations_(max_specializations),
+      min_runs_(std::max<size_t>(min_runs, 1)),
+      create_session_(std::move(create_session)),
+      logger_(logger) {
+  for (const auto& input : input_dim_params_) {
+    for (const auto& dim_param : input.second) {
+      if (!dim_param.empty()) {
+        dim_params_.push_back(dim_param);
+      }
+    }
+  }
+
+  std::sort(dim_params_.begin(), dim_params_.end());
+  dim_params_.erase(std::unique(dim_params_.begin(), dim_params_.end()), dim_params_.end());
+}
+
+ShapeSpecializer::~ShapeSpecializer() {
+  if (builder_.joinable()) {
+    builder_.join();
+  }
+}
+
+bool ShapeSpecializer::GetKey(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                              Key& key) const {
+  constexpr int64_t kUnset = -1;
+  key.assign(dim_params_.size(), kUnset);
+
+  for (size_t i = 0, end = std::min(feed_names.size(), feeds.size()); i < end; ++i) {
+    auto input = input_dim_params_.find(feed_names[i]);
+    if (input == input_dim_params_.end()) {
+      continue;
+    }
+
+    if (!feeds[i].IsTensor()) {
+      return false;
+    }
+
+    const TensorShape& shape = feeds[i].Get<Tensor>().Shape();
+    const auto& dim_params = input->second;
+    if (shape.NumDimensions() != dim_params.size()) {
+      return false;
+    }
+
+    for (size_t axis = 0; axis < dim_params.size(); ++axis) {
+      if (dim_params[axis].empty()) {
+        continue;
+      }
+
+      const auto position = std::lower_bound(dim_params_.begin(), dim_params_.end(), dim_params[axis]) -
+                            dim_params_.begin();
+      int64_t& value = key[position];
+      if (value != kUnset && value != shape[axis]) {
+        // inconsistent values, which the session reports when validating the inputs
+        return false;
+      }
+
+      value = shape[axis];
+    }
+  }
+
+  // all symbolic dimensions need a value, i.e. no optional input providing one was omitted
+  return std::find(key.begin(), key.end(), kUnset) == key.end();
+}
+
+InferenceSession* ShapeSpecializer::GetSession(const std::vector<std::string>& feed_names,
+                                               const std::vector<OrtValue>& feeds) {
+  Key key;
+  if (dim_params_.empty() || !GetKey(feed_names, feeds, key)) {
+    return nullptr;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto session = sessions_.find(key);
+  if (session != sessions_.end()) {
+    return session->second.get();
+  }
+
+  if (building_ || sessions_.size() >= max_specializations_ || failed_keys_.count(key) > 0) {
+    return nullptr;
+  }
+
+  if (run_counts_.size() >= kMaxTrackedKeys && run_counts_.find(key) == run_counts_.end()) {
+    run_counts_.clear();
+  }
+
+  if (++run_counts_[key] < min_runs_) {
+    return nullptr;
+  }
+
+  run_counts_.erase(key);
+
+  // the previous build has completed as building_ is false
+  if (builder_.joinable()) {
+    builder_.join();
+  }
+
+  building_ = true;
+  builder_ = std::thread([this, key]() { Build(key); });
+  return nullptr;
+}
+
+void ShapeSpecializer::Build(Key key) {
+  std::vector<FreeDimensionOverride> overrides;
+  std::ostringstream description;
+  for (size_t i = 0; i < dim_params_.size(); ++i) {
+    overrides.push_back({dim_params_[i], FreeDimensionOverrideType::Name, key[i]});
+    description << (i == 0 ? "" : ", ") << dim_params_[i] << "=" << key[i];
+  }
+
+  std::unique_ptr<InferenceSession> session;
+  Status status;
+  ORT_TRY {
+    status = create_session_(overrides, session);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+    });
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (status.IsOK()) {
+    LOGS(logger_, INFO) << "Created a session specialized for " << description.str();
+    sessions_.emplace(std::move(key), std::move(session));
+  } else {
+    LOGS(logger_, WARNING) << "Failed to create a session specialized for " << description.str() << ": "
+                           << status.ErrorMessage();
+    failed_keys_.insert(std::move(key));
+  }
+
+  building_ = false;
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
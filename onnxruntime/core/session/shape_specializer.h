@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/session_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+/**
+ * Sessions specialized for the recurring values of the symbolic dimensions of the graph inputs.
+ *
+ * Symbolic dimensions prevent fusions and constant folding that need static shapes. Once a combination of values
+ * of the symbolic dimensions has been seen in enough runs, a session with the dimensions overridden to those values
+ * (see SessionOptions::free_dimension_overrides) is created on a background thread, and later runs with the same
+ * values are dispatched to it. The number of specialized sessions is bounded, and a failure to create one only
+ * stops that combination from being specialized.
+ */
+class ShapeSpecializer {
+ public:
+  using CreateSessionFn = std::function<Status(const std::vector<FreeDimensionOverride>& overrides,
+                                               std::unique_ptr<InferenceSession>& session)>;
+
+  /**
+   * @param input_dim_params Symbolic dimension name of each axis of each graph input, "" for other axes.
+   * @param max_specializations Maximum number of specialized sessions.
+   * @param min_runs Number of runs with the same values after which the specialized session is created.
+   */
+  ShapeSpecializer(std::unordered_map<std::string, std::vector<std::string>> input_dim_params,
+                   size_t max_specializations, size_t min_runs,
+                   CreateSessionFn create_session, const logging::Logger& logger);
+
+  ~ShapeSpecializer();
+
+  /**
+   * Records the values of the symbolic dimensions in the shapes of the feeds.
+   * @returns The session specialized for those values if it has been created, nullptr otherwise.
+   */
+  InferenceSession* GetSession(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ShapeSpecializer);
+
+ private:
+  // values of the symbolic dimensions, in the order of dim_params_
+  using Key = std::vector<int64_t>;
+
+  bool GetKey(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds, Key& key) const;
+
+  void Build(Key key);
+
+  const std::unordered_map<std::string, std::vector<std::string>> input_dim_params_;
+  std::vector<std::string> dim_params_;
+  const size_t max_specializations_;
+  const size_t min_runs_;
+  const CreateSessionFn create_session_;
+  const logging::Logger& logger_;
+
+  OrtMutex mutex_;
+  std::map<Key, std::unique_ptr<InferenceSession>> sessions_;
+  std::map<Key, size_t> run_counts_;
+  std::set<Key> failed_keys_;
+  bool building_ = false;
+  std::thread builder_;
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -9,6 +9,7 @@
 #include <Windows.h>
 #endif
 #include <thread>
+#include "core/common/logging/logging.h"
 #include "core/session/ort_apis.h"
 
 namespace onnxruntime {
@@ -21,6 +22,23 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   ThreadOptions to;
   if (options.affinity_vec_len != 0) {
     to.affinity.assign(options.affinity_vec, options.affinity_vec + options.affinity_vec_len);
+  } else if (options.numa_node >= 0) {
+    cpu_list = env->GetNumaNodeThreadAffinityMasks(options.numa_node);
+    if (cpu_list.empty()) {
+      LOGS_DEFAULT(WARNING) << "NUMA node " << options.numa_node
+                            << " was not found. The threads of the thread pool will not be bound to it.";
+    } else {
+      if (options.thread_pool_size <= 0) {
+        if (cpu_list.size() == 1)
+          return nullptr;
+        options.thread_pool_size = static_cast<int>(cpu_list.size());
+      }
+      // more threads than processors of the node share them
+      to.affinity.resize(static_cast<size_t>(options.thread_pool_size));
+      for (size_t i = 0; i < to.affinity.size(); ++i) {
+        to.affinity[i] = cpu_list[i % cpu_list.size()];
+      }
+    }
   }
   if (options.thread_pool_size <= 0) {  // default
     cpu_list = Env::Default().GetThreadAffinityMasks();
@@ -37,6 +55,7 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   to.custom_thread_creation_options = options.custom_thread_creation_options;
   to.custom_join_thread_fn = options.custom_join_thread_fn;
   to.dynamic_block_base_ = options.dynamic_block_base_;
+  to.adaptive_spinning = options.adaptive_spinning;
   if (to.custom_create_thread_fn) {
     ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
   }
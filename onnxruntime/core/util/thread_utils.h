@@ -18,6 +18,8 @@ struct OrtThreadPoolParams {
   bool auto_set_affinity = false;
   //If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
+  //If it is true and spinning is allowed, the spin window follows the recent wait times of each thread instead.
+  bool adaptive_spinning = false;
   //It it is non-negative, thread pool will split a task by a decreasing block size
   //of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
@@ -27,6 +29,9 @@ struct OrtThreadPoolParams {
   //If the vector is empty, no explict affinity binding
   size_t* affinity_vec = nullptr;
   size_t affinity_vec_len = 0;
+  //If it is non-negative and affinity_vec is empty, bind the threads to the logical processors of this NUMA node.
+  //With thread_pool_size = 0 a thread is created for each of them.
+  int numa_node = -1;
   const ORTCHAR_T* name = nullptr;
 
   // Set or unset denormal as zero
@@ -2,8 +2,10 @@
 # Copyright (c) Microsoft Corporation. All rights reserved.
 # Licensed under the MIT License.
 # --------------------------------------------------------------------------
+import asyncio
 import collections
 import collections.abc
+import functools
 import os
 import warnings
 
@@ -182,6 +184,8 @@ class Session:
         :param output_names: name of the outputs
         :param input_feed: dictionary ``{ input_name: input_value }``
         :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: the outputs. The numpy arrays of the tensors on CPU wrap the buffers of the outputs without copying
+            them and are read-only. Set the run config entry ``python.copy_outputs`` to ``1`` to get writable copies.
 
         ::
 
@@ -207,6 +211,64 @@ class Session:
             else:
                 raise
 
+    def run_batch(self, output_names, input_feeds, run_options=None):
+        """
+        Compute the predictions for several input feeds at once.
+
+        The GIL is released once for the whole batch. The inputs exposing the buffer protocol, such as numpy arrays
+        of numbers, are converted while it is released and the runs happen concurrently.
+
+        :param output_names: name of the outputs
+        :param input_feeds: list of dictionaries ``{ input_name: input_value }``
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: the list of the outputs of each run, in the order of ``input_feeds``.
+
+        ::
+
+            sess.run_batch([output_name], [{input_name: x0}, {input_name: x1}])
+        """
+        num_required_inputs = len(self._inputs_meta)
+        for input_feed in input_feeds:
+            # the graph may have optional inputs used to override initializers. allow for that.
+            if len(input_feed) < num_required_inputs:
+                raise ValueError(
+                    "Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, len(input_feed))
+                )
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        try:
+            return self._sess.run_batch(output_names, input_feeds, run_options)
+        except C.EPFail as err:
+            if self._enable_fallback:
+                print("EP Error: {} using {}".format(str(err), self._providers))
+                print("Falling back to {} and retrying.".format(self._fallback_providers))
+                self.set_providers(self._fallback_providers)
+                # Fallback only once.
+                self.disable_fallback()
+                return self._sess.run_batch(output_names, input_feeds, run_options)
+            else:
+                raise
+
+    def run_async(self, output_names, input_feed, run_options=None, executor=None):
+        """
+        Compute the predictions without blocking the event loop.
+
+        Must be called from the thread running the event loop. :meth:`run` is called on ``executor``
+        and does not hold the GIL while it converts the inputs exposing the buffer protocol and runs the model.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param executor: a :class:`concurrent.futures.Executor`, the default executor of the event loop if None.
+        :return: an :class:`asyncio.Future` completed with the outputs.
+
+        ::
+
+            outputs = await sess.run_async([output_name], {input_name: x})
+        """
+        loop = asyncio.get_event_loop()
+        return loop.run_in_executor(executor, functools.partial(self.run, output_names, input_feed, run_options))
+
     def run_with_ort_values(self, output_names, input_dict_ort_values, run_options=None):
         """
         Compute the predictions.
@@ -440,15 +502,24 @@ class IOBinding:
         self._numpy_obj_references[name] = arr_on_cpu
         self._iobinding.bind_input(name, arr_on_cpu)
 
-    def bind_input(self, name, device_type, device_id, element_type, shape, buffer_ptr):
+    def bind_input(self, name, device_type, device_id=0, element_type=None, shape=None, buffer_ptr=None):
         """
         :param name: input name
-        :param device_type: e.g. cpu, cuda
+        :param device_type: e.g. cpu, cuda, or an object implementing the ``__dlpack__`` protocol
+            (e.g. a torch or cupy tensor) whose buffer is bound without copy, in which case the other
+            arguments are ignored
         :param device_id: device id, e.g. 0
         :param element_type: input element type
         :param shape: input shape
         :param buffer_ptr: memory pointer to input data
         """
+        if hasattr(device_type, "__dlpack__"):
+            # numpy arrays are bound directly to their data buffer, see bind_cpu_input
+            self._numpy_obj_references[name] = device_type
+            self._iobinding.bind_input(name, device_type)
+            return
+        if element_type is None or shape is None or buffer_ptr is None:
+            raise ValueError("`element_type`, `shape` and `buffer_ptr` are to be provided")
         self._iobinding.bind_input(
             name,
             C.OrtDevice(
@@ -482,12 +553,17 @@ class IOBinding:
     ):
         """
         :param name: output name
-        :param device_type: e.g. cpu, cuda, cpu by default
+        :param device_type: e.g. cpu, cuda, cpu by default, or an object implementing the ``__dlpack__``
+            protocol (e.g. a torch or cupy tensor) the output is written into, in which case the other
+            arguments are ignored
         :param device_id: device id, e.g. 0
         :param element_type: output element type
         :param shape: output shape
         :param buffer_ptr: memory pointer to output data
         """
+        if hasattr(device_type, "__dlpack__"):
+            self._iobinding.bind_output(name, device_type)
+            return
 
         # Follow the `if` path when the user has not provided any pre-allocated buffer but still
         # would like to bind an output to a specific device (e.g. cuda).
@@ -529,6 +605,23 @@ class IOBinding:
     def synchronize_outputs(self):
         self._iobinding.synchronize_outputs()
 
+    def bind_ortvalue_state(self, input_name, output_name, ortvalue):
+        """
+        Binds the OrtValue as both an input and an output so the output of a run is read back
+        in place by the next one, e.g. for the hidden state of a streaming RNN.
+
+        :param input_name: input name
+        :param output_name: output name
+        :param ortvalue: OrtValue instance to bind. It must be on the device the input is consumed on.
+        """
+        self._iobinding.bind_ortvalue_state(input_name, output_name, ortvalue._ortvalue)
+
+    def reset_states(self):
+        """
+        Zeros all the states bound with bind_ortvalue_state, e.g. at a stream boundary.
+        """
+        self._iobinding.reset_states()
+
     def get_outputs(self):
         """
         Returns the output OrtValues from the Run() that preceded the call.
@@ -599,6 +692,30 @@ class OrtValue:
             numpy_obj if device_type.lower() == "cpu" else None,
         )
 
+    @staticmethod
+    def from_dlpack(data, is_bool_tensor=False):
+        """
+        Factory method to construct an OrtValue (which holds a Tensor) sharing the buffer of a tensor
+        from another framework, e.g. torch or cupy, on its device
+
+        :param data: an object implementing the ``__dlpack__`` protocol or a DLPack capsule
+        :param is_bool_tensor: DLPack describes booleans as uint8, True creates a boolean tensor
+        """
+        return OrtValue(C.OrtValue.from_dlpack(data, is_bool_tensor))
+
+    def to_dlpack(self):
+        """
+        Returns a DLPack capsule sharing the buffer of the tensor, e.g. for ``torch.utils.dlpack.from_dlpack``.
+        Boolean tensors are exported as uint8 tensors.
+        """
+        return self._ortvalue.to_dlpack()
+
+    def __dlpack__(self, stream=None):
+        return self._ortvalue.__dlpack__(stream)
+
+    def __dlpack_device__(self):
+        return self._ortvalue.__dlpack_device__()
+
     @staticmethod
     def ortvalue_from_shape_and_type(shape=None, element_type=None, device_type="cpu", device_id=0):
         """
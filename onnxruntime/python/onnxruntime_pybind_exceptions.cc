@@ -35,6 +35,7 @@ void RegisterExceptions(pybind11::module& m) {
   pybind11::register_exception<NotImplemented>(m, "NotImplemented");
   pybind11::register_exception<InvalidGraph>(m, "InvalidGraph");
   pybind11::register_exception<EPFail>(m, "EPFail");
+  pybind11::register_exception<Timeout>(m, "Timeout");
 }
 
 void OrtPybindThrowIfError(onnxruntime::common::Status status) {
@@ -61,6 +62,8 @@ void OrtPybindThrowIfError(onnxruntime::common::Status status) {
         throw InvalidGraph(std::move(msg));
       case onnxruntime::common::StatusCode::EP_FAIL:
         throw EPFail(std::move(msg));
+      case onnxruntime::common::StatusCode::TIMEOUT:
+        throw Timeout(std::move(msg));
       default:
         throw std::runtime_error(std::move(msg));
     }
@@ -44,6 +44,9 @@ struct InvalidGraph : std::runtime_error {
 struct EPFail : std::runtime_error {
   explicit EPFail(const std::string& what) : std::runtime_error(what) {}
 };
+struct Timeout : std::runtime_error {
+  explicit Timeout(const std::string& what) : std::runtime_error(what) {}
+};
 
 void RegisterExceptions(pybind11::module& m);
 
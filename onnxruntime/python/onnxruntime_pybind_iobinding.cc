@@ -21,6 +21,20 @@ namespace python {
 
 namespace py = pybind11;
 
+// For now, limit binding support to only non-string Tensors. Returns the element type of the tensor.
+static int32_t GetBindableTensorElemType(const std::vector<const NodeArg*>& def_list, const std::string& name) {
+  onnx::TypeProto type_proto;
+  if (!CheckIfTensor(def_list, name, type_proto)) {
+    throw std::runtime_error("Only binding Tensors is currently supported");
+  }
+
+  ORT_ENFORCE(utils::HasTensorType(type_proto) && utils::HasElemType(type_proto.tensor_type()));
+  if (type_proto.tensor_type().elem_type() == onnx::TensorProto::STRING) {
+    throw std::runtime_error("Only binding non-string Tensors is currently supported");
+  }
+  return type_proto.tensor_type().elem_type();
+}
+
 void addIoBindingMethods(pybind11::module& m) {
   py::class_<SessionIOBinding> session_io_binding(m, "SessionIOBinding");
   session_io_binding
@@ -29,6 +43,7 @@ void addIoBindingMethods(pybind11::module& m) {
         return sess_io_binding;
       }))
       // May create Tensor/Sequence based OrtValues. Use bind_ortvalue_input for universal binding.
+      // Objects implementing the __dlpack__ protocol other than numpy arrays are bound without copy on their device.
       .def("bind_input", [](SessionIOBinding* io_binding, const std::string& name, py::object& arr_on_cpu) -> void {
         InferenceSession* sess = io_binding->GetInferenceSession();
         auto px = sess->GetModelInputs();
@@ -36,22 +51,21 @@ void addIoBindingMethods(pybind11::module& m) {
           throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
         }
 
-        // For now, limit binding support to only non-string Tensors
         // TODO: Support non-tensors
-        const auto& def_list = *px.second;
-        onnx::TypeProto type_proto;
-        if (!CheckIfTensor(def_list, name, type_proto)) {
-          throw std::runtime_error("Only binding Tensors is currently supported");
-        }
-
-        ORT_ENFORCE(utils::HasTensorType(type_proto) && utils::HasElemType(type_proto.tensor_type()));
-        if (type_proto.tensor_type().elem_type() == onnx::TensorProto::STRING) {
-          throw std::runtime_error("Only binding non-string Tensors is currently supported");
-        }
+        const int32_t elem_type = GetBindableTensorElemType(*px.second, name);
 
         OrtValue ml_value;
-        // Set the parameter `accept_only_numpy_array` to `true` (we only support binding Tensors)
-        CreateGenericMLValue(px.second, GetAllocator(), name, arr_on_cpu, &ml_value, true);
+#ifdef ENABLE_DLPACK
+        if (!IsNumpyArray(arr_on_cpu) && IsDlpackObject(arr_on_cpu)) {
+          ml_value = FromDlpackObject(arr_on_cpu, elem_type == onnx::TensorProto::BOOL);
+        } else
+#else
+        ORT_UNUSED_PARAMETER(elem_type);
+#endif
+        {
+          // Set the parameter `accept_only_numpy_array` to `true` (we only support binding Tensors)
+          CreateGenericMLValue(px.second, GetAllocator(), name, arr_on_cpu, &ml_value, true);
+        }
 
         auto status = io_binding->Get()->BindInput(name, ml_value);
         if (!status.IsOK()) {
@@ -104,17 +118,7 @@ void addIoBindingMethods(pybind11::module& m) {
           throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
         }
 
-        // For now, limit binding support to only non-string Tensors
-        const auto& def_list = *px.second;
-        onnx::TypeProto type_proto;
-        if (!CheckIfTensor(def_list, name, type_proto)) {
-          throw std::runtime_error("Only binding Tensors is currently supported");
-        }
-
-        ORT_ENFORCE(utils::HasTensorType(type_proto) && utils::HasElemType(type_proto.tensor_type()));
-        if (type_proto.tensor_type().elem_type() == onnx::TensorProto::STRING) {
-          throw std::runtime_error("Only binding non-string Tensors is currently supported");
-        }
+        GetBindableTensorElemType(*px.second, name);
 
         PyArray_Descr* dtype;
         if (!PyArray_DescrConverter(element_type.ptr(), &dtype)) {
@@ -140,6 +144,27 @@ void addIoBindingMethods(pybind11::module& m) {
           throw std::runtime_error("Error when binding output: " + status.ErrorMessage());
         }
       })
+#ifdef ENABLE_DLPACK
+      // This binds output to the buffer of an object implementing the __dlpack__ protocol, e.g. a torch tensor
+      .def("bind_output", [](SessionIOBinding* io_binding, const std::string& name, py::object& data) -> void {
+        InferenceSession* sess = io_binding->GetInferenceSession();
+        auto px = sess->GetModelOutputs();
+        if (!px.first.IsOK() || !px.second) {
+          throw std::runtime_error("Either failed to get model outputs from the session object or the output def list was null");
+        }
+
+        const int32_t elem_type = GetBindableTensorElemType(*px.second, name);
+        if (!IsDlpackObject(data)) {
+          throw std::runtime_error("The output must be bound to an object implementing the __dlpack__ protocol");
+        }
+        OrtValue ml_value = FromDlpackObject(data, elem_type == onnx::TensorProto::BOOL);
+
+        auto status = io_binding->Get()->BindOutput(name, ml_value);
+        if (!status.IsOK()) {
+          throw std::runtime_error("Error when binding output: " + status.ErrorMessage());
+        }
+      })
+#endif
       // Binds output to a pre-constructed OrtValue which may contain various elements (e.g. Tensor/SparseTensor/TensorSequece)
       .def("bind_ortvalue_output", [](SessionIOBinding* io_binding, const std::string& name, const OrtValue& ml_value) -> void {
         auto status = io_binding->Get()->BindOutput(name, ml_value);
@@ -147,6 +172,19 @@ void addIoBindingMethods(pybind11::module& m) {
           throw std::runtime_error("Error when binding output: " + status.ErrorMessage());
         }
       })
+      // Binds a pre-constructed OrtValue as both an input and an output so it is carried over between runs
+      .def("bind_ortvalue_state", [](SessionIOBinding* io_binding, const std::string& input_name, const std::string& output_name, const OrtValue& ml_value) -> void {
+        auto status = io_binding->Get()->BindState(input_name, output_name, ml_value);
+        if (!status.IsOK()) {
+          throw std::runtime_error("Error when binding state: " + status.ErrorMessage());
+        }
+      })
+      .def("reset_states", [](SessionIOBinding* io_binding) -> void {
+        auto status = io_binding->Get()->ResetStates();
+        if (!status.IsOK()) {
+          throw std::runtime_error("Error when resetting bound states: " + status.ErrorMessage());
+        }
+      })
       .def("synchronize_outputs", [](SessionIOBinding* io_binding) -> void {
         auto status = io_binding->Get()->SynchronizeOutputs();
         if (!status.IsOK()) {
@@ -556,6 +556,130 @@ static void CreateTensorMLValueOwned(const OrtPybindSingleUseAllocatorPtr& pybin
                   ml_tensor->GetDeleteFunc());
 }
 
+bool TryGetBufferFeed(const std::string& name_input, const py::object& value, BufferFeed& feed) {
+  if (!PyObject_CheckBuffer(value.ptr())) {
+    return false;
+  }
+
+  py::buffer_info info;
+  int npy_type;
+  try {
+    info = py::reinterpret_borrow<py::buffer>(value).request();
+    npy_type = py::dtype(info).num();
+  } catch (const py::error_already_set&) {
+    // the exporter rejected the request or the format has no numpy equivalent
+    PyErr_Clear();
+    return false;
+  } catch (const py::buffer_error&) {
+    return false;
+  }
+
+  if (!IsNumericNumpyType(npy_type)) {
+    return false;
+  }
+
+  MLDataType element_type;
+  try {
+    element_type = NumpyTypeToOnnxRuntimeTensorType(npy_type);
+  } catch (const std::runtime_error&) {
+    // e.g. complex numbers
+    return false;
+  }
+
+  if (static_cast<size_t>(info.itemsize) != element_type->Size()) {
+    return false;
+  }
+
+  feed.name = name_input;
+  feed.element_type = element_type;
+  feed.info = std::move(info);
+  return true;
+}
+
+// Copies a strided buffer into the contiguous buffer dst, one innermost row at a time
+// when that row is contiguous.
+static void CopyStridedBuffer(const py::buffer_info& info, char* dst) {
+  const auto ndim = static_cast<size_t>(info.ndim);
+  const size_t item_size = static_cast<size_t>(info.itemsize);
+  if (ndim == 0) {
+    memcpy(dst, info.ptr, item_size);
+    return;
+  }
+
+  for (size_t d = 0; d < ndim; ++d) {
+    if (info.shape[d] == 0) {
+      return;
+    }
+  }
+
+  const py::ssize_t inner_dim = info.shape[ndim - 1];
+  const py::ssize_t inner_stride = info.strides[ndim - 1];
+  const bool inner_contiguous = inner_stride == static_cast<py::ssize_t>(item_size);
+
+  std::vector<py::ssize_t> index(ndim, 0);
+  while (true) {
+    const char* src = static_cast<const char*>(info.ptr);
+    for (size_t d = 0; d + 1 < ndim; ++d) {
+      src += index[d] * info.strides[d];
+    }
+
+    if (inner_contiguous) {
+      memcpy(dst, src, inner_dim * item_size);
+      dst += inner_dim * item_size;
+    } else {
+      for (py::ssize_t i = 0; i < inner_dim; ++i, src += inner_stride, dst += item_size) {
+        memcpy(dst, src, item_size);
+      }
+    }
+
+    // advance the outer dims, last one fastest
+    size_t d = ndim - 1;
+    while (d > 0) {
+      --d;
+      if (++index[d] < info.shape[d]) {
+        break;
+      }
+      index[d] = 0;
+      if (d == 0) {
+        return;
+      }
+    }
+    if (ndim == 1) {
+      return;
+    }
+  }
+}
+
+void CreateTensorMLValueFromBuffer(const AllocatorPtr& alloc, const BufferFeed& feed, OrtValue* p_mlvalue) {
+  const auto& info = feed.info;
+  TensorShape shape(std::vector<int64_t>(info.shape.cbegin(), info.shape.cend()));
+
+  // C order strides of the buffer if it were contiguous
+  bool contiguous = true;
+  py::ssize_t expected_stride = info.itemsize;
+  for (py::ssize_t d = info.ndim - 1; d >= 0; --d) {
+    if (info.shape[d] != 1 && info.strides[d] != expected_stride) {
+      contiguous = false;
+      break;
+    }
+    expected_stride *= info.shape[d];
+  }
+
+  std::unique_ptr<Tensor> p_tensor;
+  if (contiguous) {
+    // the caller keeps the buffer alive until the OrtValue is released, same as for numpy arrays
+    p_tensor = std::make_unique<Tensor>(feed.element_type, shape, info.ptr, alloc->Info());
+  } else {
+    p_tensor = std::make_unique<Tensor>(feed.element_type, shape, alloc);
+    CopyStridedBuffer(info, static_cast<char*>(p_tensor->MutableDataRaw()));
+  }
+
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  p_mlvalue->Init(p_tensor.release(),
+                  ml_tensor,
+                  ml_tensor->GetDeleteFunc());
+}
+
 std::string _get_type_name(int64_t&) {
   return std::string("int64_t");
 }
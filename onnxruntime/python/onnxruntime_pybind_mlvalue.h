@@ -46,6 +46,10 @@ void CopyDataToTensor(const pybind11::array& py_array, int npy_type, Tensor& ten
 pybind11::object AddTensorAsPyObj(const OrtValue& val, const DataTransferManager* data_transfer_manager,
                                   const std::unordered_map<OrtDevice::DeviceType, MemCpyFunc>* mem_cpy_to_host_functions);
 
+// Returns a read-only numpy array wrapping the buffer of a CPU tensor, which holds a reference to the OrtValue.
+// String tensors and tensors on other devices are copied as by AddTensorAsPyObj.
+pybind11::object AddTensorAsPyObjWithoutCopy(const OrtValue& val);
+
 pybind11::object GetPyObjectFromSparseTensor(size_t pos, const OrtValue& ort_value, const DataTransferManager* data_transfer_manager);
 
 pybind11::object AddNonTensorAsPyObj(const OrtValue& val,
@@ -90,6 +94,23 @@ void CreateGenericMLValue(const onnxruntime::InputDefList* input_def_list, const
                           const std::string& name_input, const pybind11::object& value, OrtValue* p_mlvalue,
                           bool accept_only_numpy_array = false, bool use_numpy_data_memory = true, MemCpyFunc mem_cpy_to_device = CpuToCpuMemCpy);
 
+// A numeric input exposing the buffer protocol. It is captured while holding the GIL, after which
+// CreateTensorMLValueFromBuffer creates its tensor without touching any python object.
+// The buffer_info has to be released while holding the GIL.
+struct BufferFeed {
+  std::string name;
+  MLDataType element_type = nullptr;
+  pybind11::buffer_info info;
+};
+
+// Requires the GIL. Returns false if the value does not expose a numeric buffer,
+// in which case it has to be converted with CreateGenericMLValue.
+bool TryGetBufferFeed(const std::string& name_input, const pybind11::object& value, BufferFeed& feed);
+
+// Does not require the GIL. A contiguous buffer is used directly and has to outlive the OrtValue,
+// a strided one is copied into a tensor allocated with alloc.
+void CreateTensorMLValueFromBuffer(const AllocatorPtr& alloc, const BufferFeed& feed, OrtValue* p_mlvalue);
+
 void GetPyObjFromTensor(const Tensor& rtensor, pybind11::object& obj,
                         const DataTransferManager* data_transfer_manager = nullptr,
                         const std::unordered_map<OrtDevice::DeviceType, MemCpyFunc>* mem_cpy_to_host_functions = nullptr);
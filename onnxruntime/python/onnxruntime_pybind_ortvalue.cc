@@ -15,7 +15,7 @@
 #include "core/framework/tensor.h"
 #include "core/framework/sparse_tensor.h"
 #include "core/framework/TensorSeq.h"
-#ifdef ENABLE_TRAINING 
+#ifdef ENABLE_DLPACK
 #include "core/dlpack/dlpack_converter.h"
 #endif
 
@@ -279,16 +279,17 @@ void addOrtValueMethods(pybind11::module& m) {
 #endif
         return obj;
       })
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
       .def("to_dlpack", [](OrtValue* ort_value) -> py::object {
         return py::reinterpret_steal<py::object>(ToDlpack(*ort_value));
       }, "Returns a DLPack representing the tensor. This method does not copy the pointer shape, "
          "instead, it copies the pointer value. The OrtValue must be persist until the dlpack structure "
          "is consumed.")
       .def_static("from_dlpack", [](py::object data, bool is_bool_tensor) {
-        return FromDlpack(data.ptr(), is_bool_tensor);
+        return FromDlpackObject(data, is_bool_tensor);
       }, py::arg("data"), py::arg("is_bool_tensor")=false,
-        "Converts a tensor from a external library into an OrtValue by means of the __dlpack__ protocol.")
+        "Converts a tensor from a external library into an OrtValue by means of the __dlpack__ protocol. "
+        "data is either an object implementing __dlpack__ or a DLPack capsule. The OrtValue shares its buffer.")
       .def("__dlpack__", [](OrtValue* ort_value, py::object /* stream */) -> py::object {
         return py::reinterpret_steal<py::object>(ToDlpack(*ort_value));
        }, py::arg("stream")=py::none(),
@@ -304,7 +305,7 @@ void addOrtValueMethods(pybind11::module& m) {
 #endif
       ;
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
   m.def("is_dlpack_uint8_tensor", [](py::capsule cap) -> bool {
     // case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
     // dtype.code = DLDataTypeCode::kDLUInt;
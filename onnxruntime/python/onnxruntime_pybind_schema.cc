@@ -79,7 +79,7 @@ void addGlobalSchemaFunctions(pybind11::module& m) {
             onnxruntime::CreateExecutionProviderFactory_Rknpu(),
 #endif
 #ifdef USE_COREML
-            onnxruntime::CreateExecutionProviderFactory_CoreML(0),
+            onnxruntime::CreateExecutionProviderFactory_CoreML(0, {}),
 #endif
         };
 
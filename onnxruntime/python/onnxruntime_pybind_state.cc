@@ -23,9 +23,11 @@
 #include "core/framework/TensorSeq.h"
 #include "core/graph/graph_viewer.h"
 #include "core/platform/env.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/get_execution_providers.h"
 #include "core/session/IOBinding.h"
 #include "core/session/abi_session_options_impl.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/provider_bridge_ort.h"
 #include "core/providers/tensorrt/tensorrt_provider_options.h"
@@ -44,7 +46,9 @@ namespace onnxruntime {
 #pragma warning(disable : 4267 4996 4503 4003)
 #endif  // _MSC_VER
 
+#include <atomic>
 #include <iterator>
+#include <thread>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4267 4996 4503 4003)
@@ -302,6 +306,37 @@ py::object AddTensorAsPyObj(const OrtValue& val, const DataTransferManager* data
   return obj;
 }
 
+py::object AddTensorAsPyObjWithoutCopy(const OrtValue& val) {
+  const Tensor& rtensor = val.Get<Tensor>();
+  const int numpy_type = OnnxRuntimeTensorToNumpyType(rtensor.DataType());
+  // strings are converted to python objects, and the other devices need a copy to the host
+  if (numpy_type == NPY_OBJECT || rtensor.Location().device.Type() != OrtDevice::CPU || rtensor.Shape().Size() == 0) {
+    return AddTensorAsPyObj(val, nullptr, nullptr);
+  }
+
+  std::vector<npy_intp> npy_dims;
+  const TensorShape& shape = rtensor.Shape();
+  for (size_t n = 0; n < shape.NumDimensions(); ++n) {
+    npy_dims.push_back(shape[n]);
+  }
+
+  // the array is read-only as the buffer may be shared, e.g. with an initializer returned as an output
+  py::object obj = py::reinterpret_steal<py::object>(PyArray_New(
+      &PyArray_Type, static_cast<int>(shape.NumDimensions()), npy_dims.data(), numpy_type, nullptr,
+      const_cast<void*>(rtensor.DataRaw()), 0, NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_ALIGNED, nullptr));
+  if (!obj) {
+    throw py::error_already_set();
+  }
+
+  // the base of the array holds a reference to the OrtValue which keeps the buffer alive
+  py::capsule base(new OrtValue(val), [](void* p) { delete static_cast<OrtValue*>(p); });
+  if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), base.release().ptr()) != 0) {
+    throw py::error_already_set();
+  }
+
+  return obj;
+}
+
 static std::unique_ptr<onnxruntime::IExecutionProvider> LoadExecutionProvider(
     const std::string& ep_shared_lib_path,
     const ProviderOptions& provider_options = {},
@@ -365,15 +400,17 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
     const std::string& type,
     const ProviderOptionsMap& provider_options_map) {
   if (type == kCpuExecutionProvider) {
-    return onnxruntime::CreateExecutionProviderFactory_CPU(
-               session_options.enable_cpu_mem_arena)
-        ->CreateProvider();
+    CPUExecutionProviderInfo info{session_options.enable_cpu_mem_arena,
+                                  session_options.config_options.GetConfigOrDefault(
+                                      kOrtSessionOptionsConfigUseHugePagesForCpuAllocator, "0") == "1"};
+    info.numa_node = std::stoi(session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigNumaNode, "-1"));
+    return std::make_unique<CPUExecutionProvider>(info);
   } else if (type == kTensorrtExecutionProvider) {
 #ifdef USE_TENSORRT
     // If the environment variable 'ORT_TENSORRT_UNAVAILABLE' exists, then we do not load TensorRT. This is set by _ld_preload for the manylinux case
     // as in that case, trying to load the library itself will result in a crash due to the way that auditwheel strips dependencies.
     if (Env::Default().GetEnvironmentVar("ORT_TENSORRT_UNAVAILABLE").empty()) {
-      std::string calibration_table, cache_path, lib_path;
+      std::string calibration_table, cache_path, lib_path, profile_min_shapes, profile_max_shapes, profile_opt_shapes;
       auto it = provider_options_map.find(type);
       if (it != provider_options_map.end()) {
         OrtTensorRTProviderOptionsV2 params{
@@ -394,7 +431,11 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             nullptr,
             0,
             nullptr,
-            0};
+            0,
+            0,
+            nullptr,
+            nullptr,
+            nullptr};
         for (auto option : it->second) {
           if (option.first == "device_id") {
             if (!option.second.empty()) {
@@ -511,6 +552,35 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_force_sequential_engine_build' should be a boolean i.e. 'True' or 'False'. Default value is False.\n");
             }
+          } else if (option.first == "trt_engine_build_async") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_engine_build_async = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_engine_build_async = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_build_async' should be a boolean i.e. 'True' or 'False'. Default value is False.\n");
+            }
+          } else if (option.first == "trt_profile_min_shapes") {
+            if (!option.second.empty()) {
+              profile_min_shapes = option.second;
+              params.trt_profile_min_shapes = profile_min_shapes.c_str();
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_min_shapes' should be a list of input shapes i.e. 'input_a:1x3x224x224,input_b:1'.\n");
+            }
+          } else if (option.first == "trt_profile_max_shapes") {
+            if (!option.second.empty()) {
+              profile_max_shapes = option.second;
+              params.trt_profile_max_shapes = profile_max_shapes.c_str();
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_max_shapes' should be a list of input shapes i.e. 'input_a:1x3x224x224,input_b:1'.\n");
+            }
+          } else if (option.first == "trt_profile_opt_shapes") {
+            if (!option.second.empty()) {
+              profile_opt_shapes = option.second;
+              params.trt_profile_opt_shapes = profile_opt_shapes.c_str();
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_opt_shapes' should be a list of input shapes i.e. 'input_a:1x3x224x224,input_b:1'.\n");
+            }
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -617,6 +687,8 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
           params.device_id = option.second.c_str();
         } else if (option.first == "num_of_threads") {
           params.num_of_threads = std::stoi(option.second);
+        } else if (option.first == "num_streams") {
+          params.num_streams = std::stoi(option.second);
         } else if (option.first == "blob_dump_path") {
           blob_dump_path = option.second;
           params.blob_dump_path = blob_dump_path.c_str();
@@ -731,7 +803,10 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
 #endif
     const auto partitioning_stop_ops_list = session_options.config_options.GetConfigEntry(
         kOrtSessionOptionsConfigNnapiEpPartitioningStopOps);
-    return onnxruntime::CreateExecutionProviderFactory_Nnapi(0, partitioning_stop_ops_list)->CreateProvider();
+    const auto compilation_cache_dir = session_options.config_options.GetConfigEntry(
+        kOrtSessionOptionsConfigNnapiEpCompilationCacheDir);
+    return onnxruntime::CreateExecutionProviderFactory_Nnapi(0, partitioning_stop_ops_list, compilation_cache_dir)
+        ->CreateProvider();
 #endif
   } else if (type == kRknpuExecutionProvider) {
 #ifdef USE_RKNPU
@@ -742,7 +817,9 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
 #if !defined(__APPLE__)
     LOGS_DEFAULT(WARNING) << "CoreML execution provider can only be used to generate ORT format model in this build.";
 #endif
-    return onnxruntime::CreateExecutionProviderFactory_CoreML(0)->CreateProvider();
+    const auto compilation_cache_dir = session_options.config_options.GetConfigEntry(
+        kOrtSessionOptionsConfigCoreMLEpCompilationCacheDir);
+    return onnxruntime::CreateExecutionProviderFactory_CoreML(0, compilation_cache_dir)->CreateProvider();
 #endif
   } else {
     // check whether it is a dynamic load EP:
@@ -849,6 +926,120 @@ void InitializeSession(InferenceSession* sess,
   OrtPybindThrowIfError(sess->Initialize());
 }
 
+// The feeds and fetches of one Run() call made from python. Numeric inputs exposing the buffer
+// protocol are kept in buffer_feeds and only turned into tensors once the GIL is released.
+struct PyRunRequest {
+  NameMLValMap feeds;
+  std::vector<BufferFeed> buffer_feeds;
+  std::vector<OrtValue> fetches;
+  Status status;
+};
+
+// Requires the GIL.
+static void CollectFeeds(PyInferenceSession* sess, const std::map<std::string, py::object>& pyfeeds,
+                         PyRunRequest& request) {
+  const InputDefList* input_def_list = nullptr;
+  for (const auto& feed : pyfeeds) {
+    // No need to process 'None's sent in by the user
+    // to feed Optional inputs in the graph.
+    // We just won't include anything in the feed and ORT
+    // will handle such implicit 'None's internally.
+    if (feed.second.is(py::none())) {
+      continue;
+    }
+
+    BufferFeed buffer_feed;
+    if (TryGetBufferFeed(feed.first, feed.second, buffer_feed)) {
+      request.buffer_feeds.push_back(std::move(buffer_feed));
+      continue;
+    }
+
+    if (input_def_list == nullptr) {
+      auto px = sess->GetSessionHandle()->GetModelInputs();
+      if (!px.first.IsOK() || !px.second) {
+        throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+      }
+      input_def_list = px.second;
+    }
+
+    OrtValue ml_value;
+    CreateGenericMLValue(input_def_list, GetAllocator(), feed.first, feed.second, &ml_value);
+    ThrowIfPyErrOccured();
+    request.feeds.insert(std::make_pair(feed.first, ml_value));
+  }
+}
+
+// Does not require the GIL. Errors are reported in request.status.
+static void RunRequest(PyInferenceSession* sess, const std::vector<std::string>& output_names,
+                       const RunOptions* run_options, PyRunRequest& request) {
+  try {
+    for (const auto& buffer_feed : request.buffer_feeds) {
+      OrtValue ml_value;
+      CreateTensorMLValueFromBuffer(GetAllocator(), buffer_feed, &ml_value);
+      request.feeds.insert(std::make_pair(buffer_feed.name, ml_value));
+    }
+
+    if (run_options != nullptr) {
+      request.status = sess->GetSessionHandle()->Run(*run_options, request.feeds, output_names, &request.fetches);
+    } else {
+      request.status = sess->GetSessionHandle()->Run(request.feeds, output_names, &request.fetches);
+    }
+  } catch (const std::exception& ex) {
+    request.status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+  }
+}
+
+// Does not require the GIL. The requests run concurrently, on at most one thread per core.
+static void RunRequests(PyInferenceSession* sess, const std::vector<std::string>& output_names,
+                        const RunOptions* run_options, std::vector<PyRunRequest>& requests) {
+  std::atomic<size_t> next_request{0};
+  auto run_requests = [&]() {
+    for (size_t i = next_request++; i < requests.size(); i = next_request++) {
+      RunRequest(sess, output_names, run_options, requests[i]);
+    }
+  };
+
+  const size_t num_threads = std::min<size_t>(requests.size(),
+                                              std::max(1U, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads > 0 ? num_threads - 1 : 0);
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(run_requests);
+  }
+  run_requests();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Requires the GIL.
+static std::vector<py::object> FetchesToPyObjects(const std::vector<OrtValue>& fetches, const RunOptions* run_options) {
+  // the numpy arrays wrap the buffers of the outputs unless the caller asked for copies
+  const bool copy_outputs =
+      run_options != nullptr &&
+      run_options->config_options.GetConfigOrDefault(kOrtRunOptionsConfigPythonCopyOutputs, "0") == "1";
+
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  size_t pos = 0;
+  for (const auto& fet : fetches) {
+    if (fet.IsAllocated()) {
+      if (fet.IsTensor()) {
+        rfetch.push_back(copy_outputs ? AddTensorAsPyObj(fet, nullptr, nullptr)
+                                      : AddTensorAsPyObjWithoutCopy(fet));
+      } else if (fet.IsSparseTensor()) {
+        rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
+      } else {
+        rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+      }
+    } else {  // Send back None because the corresponding OrtValue was empty
+      rfetch.push_back(py::none());
+    }
+    ++pos;
+  }
+  return rfetch;
+}
+
 bool CheckIfTensor(const std::vector<const NodeArg*>& def_list,
                    const std::string& name,
                    /*out*/ onnx::TypeProto& type_proto) {
@@ -1025,7 +1216,8 @@ void addObjectMethods(py::module& m, Environment& env, ExecutionProviderRegistra
 
   py::enum_<ExecutionOrder>(m, "ExecutionOrder")
       .value("DEFAULT", ExecutionOrder::DEFAULT)
-      .value("PRIORITY_BASED", ExecutionOrder::PRIORITY_BASED);
+      .value("PRIORITY_BASED", ExecutionOrder::PRIORITY_BASED)
+      .value("MEMORY_EFFICIENT", ExecutionOrder::MEMORY_EFFICIENT);
 
   py::enum_<OrtAllocatorType>(m, "OrtAllocatorType")
       .value("INVALID", OrtInvalidAllocator)
@@ -1420,55 +1612,42 @@ including arg name, arg type (contains both type and shape).)pbdoc")
            [](PyInferenceSession* sess, std::vector<std::string> output_names,
               std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
                -> std::vector<py::object> {
-             NameMLValMap feeds;
-             for (auto feed : pyfeeds) {
-               // No need to process 'None's sent in by the user
-               // to feed Optional inputs in the graph.
-               // We just won't include anything in the feed and ORT
-               // will handle such implicit 'None's internally.
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 feeds.insert(std::make_pair(feed.first, ml_value));
-               }
+             PyRunRequest request;
+             CollectFeeds(sess, pyfeeds, request);
+
+             {
+               // release GIL to allow multiple python threads to invoke Run() in parallel.
+               // the inputs exposing the buffer protocol are converted here too.
+               py::gil_scoped_release release;
+               RunRequest(sess, output_names, run_options, request);
              }
+             OrtPybindThrowIfError(request.status);
 
-             std::vector<OrtValue> fetches;
-             common::Status status;
+             return FetchesToPyObjects(request.fetches, run_options);
+           })
+      /// This method runs the model once per dictionary of feeds. The GIL is released once for all of them
+      /// and the runs happen concurrently. It returns the outputs of each run, in the order of the feeds.
+      .def("run_batch",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::vector<std::map<std::string, py::object>> pyfeeds_list, RunOptions* run_options = nullptr)
+               -> std::vector<std::vector<py::object>> {
+             std::vector<PyRunRequest> requests(pyfeeds_list.size());
+             for (size_t i = 0; i < pyfeeds_list.size(); ++i) {
+               CollectFeeds(sess, pyfeeds_list[i], requests[i]);
+             }
 
              {
-               // release GIL to allow multiple python threads to invoke Run() in parallel.
                py::gil_scoped_release release;
-               if (run_options != nullptr) {
-                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
-               } else {
-                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
-               }
+               RunRequests(sess, output_names, run_options, requests);
              }
 
-             std::vector<py::object> rfetch;
-             rfetch.reserve(fetches.size());
-             size_t pos = 0;
-             for (auto fet : fetches) {
-               if (fet.IsAllocated()) {
-                 if (fet.IsTensor()) {
-                   rfetch.push_back(AddTensorAsPyObj(fet, nullptr, nullptr));
-                 } else if (fet.IsSparseTensor()) {
-                   rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
-                 } else {
-                   rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
-                 }
-               } else {  // Send back None because the corresponding OrtValue was empty
-                 rfetch.push_back(py::none());
-               }
-               ++pos;
+             std::vector<std::vector<py::object>> results;
+             results.reserve(requests.size());
+             for (const auto& request : requests) {
+               OrtPybindThrowIfError(request.status);
+               results.push_back(FetchesToPyObjects(request.fetches, run_options));
              }
-             return rfetch;
+             return results;
            })
       /// This method accepts a dictionary of feeds (name -> OrtValue) and the list of output_names
       /// and returns a list of python objects representing OrtValues. Each name may represent either
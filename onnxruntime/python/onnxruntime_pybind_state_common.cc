@@ -44,7 +44,7 @@ onnxruntime::ROCMExecutionProviderExternalAllocatorInfo external_allocator_info{
 onnxruntime::ArenaExtendStrategy arena_extend_strategy = onnxruntime::ArenaExtendStrategy::kNextPowerOfTwo;
 #endif
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
 
 void DlpackCapsuleDestructor(PyObject* data) {
   DLManagedTensor* dlmanaged_tensor = reinterpret_cast<DLManagedTensor*>(PyCapsule_GetPointer(data, "dltensor"));
@@ -77,6 +77,20 @@ OrtValue FromDlpack(PyObject* dlpack_tensor, const bool is_bool_tensor) {
   return ort_value;
 }
 
+bool IsDlpackObject(const py::object& data) {
+  return py::hasattr(data, "__dlpack__") ||
+         (PyCapsule_CheckExact(data.ptr()) && PyCapsule_IsValid(data.ptr(), "dltensor"));
+}
+
+OrtValue FromDlpackObject(const py::object& data, const bool is_bool_tensor) {
+  if (py::hasattr(data, "__dlpack__")) {
+    // the producer makes the tensor usable on the default stream of its device
+    py::object capsule = data.attr("__dlpack__")();
+    return FromDlpack(capsule.ptr(), is_bool_tensor);
+  }
+  return FromDlpack(data.ptr(), is_bool_tensor);
+}
+
 #endif
 
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -11,7 +11,7 @@
 #include "core/session/environment.h"
 #include "core/session/inference_session.h"
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
 #include "core/dlpack/dlpack_converter.h"
 #endif
 
@@ -459,7 +459,7 @@ bool CheckIfTensor(const std::vector<const NodeArg*>& def_list,
                    const std::string& name,
                    /*out*/ ONNX_NAMESPACE::TypeProto& type_proto);
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
 
 // Allocate a new Capsule object, which takes the ownership of OrtValue.
 // Caller is responsible for releasing.
@@ -473,6 +473,13 @@ OrtValue FromDlpack(PyObject* dlpack_tensor, const bool is_bool_tensor);
 // Destructor for Capsule object holding a DLPack structure.
 void DlpackCapsuleDestructor(PyObject* data);
 
+// Tells if the object implements the __dlpack__ protocol or is an unconsumed DLPack capsule.
+bool IsDlpackObject(const pybind11::object& data);
+
+// Creates an OrtValue sharing the buffer of an object implementing the __dlpack__ protocol,
+// e.g. a torch or a cupy tensor, or of a DLPack capsule which is consumed.
+OrtValue FromDlpackObject(const pybind11::object& data, const bool is_bool_tensor);
+
 #endif
 
 }  // namespace python
@@ -497,9 +504,11 @@ std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_ACL(in
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_ArmNN(int use_arena);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_DML(int device_id);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Nnapi(
-    uint32_t flags, const optional<std::string>& partitioning_stop_ops_list);
+    uint32_t flags, const optional<std::string>& partitioning_stop_ops_list,
+    const optional<std::string>& compilation_cache_dir);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Rknpu();
-std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CoreML(uint32_t flags);
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CoreML(
+    uint32_t flags, const optional<std::string>& compilation_cache_dir);
 
 constexpr const char* kDefaultExecutionProviderEntry = "GetProvider";
 }  // namespace onnxruntime
@@ -8,6 +8,8 @@ import collections
 import copy
 import logging
 import os
+import shutil
+import tempfile
 
 import onnx
 import tvm
@@ -35,6 +37,7 @@ def onnx_compile(
     nhwc=False,
     tuning_logfile="",
     tuning_type=AUTO_TVM_TYPE,
+    export_dir="",
 ):
     def get_tvm_executor(irmod, executor, target, params):
         if executor == "vm":
@@ -127,6 +130,9 @@ def onnx_compile(
     if lib is None:
         return None
 
+    if export_dir and executor == "vm":
+        export_vm_executable(lib, export_dir)
+
     ctx = tvm.device(target, 0)
     if executor == "vm":
         m = tvm.runtime.vm.VirtualMachine(lib, ctx)
@@ -140,3 +146,29 @@ def onnx_compile(
         return None
 
     return m.module
+
+
+def export_vm_executable(vm_exec, export_dir):
+    """
+    Saves the compiled virtual machine executable in the layout loaded by the so_folder option:
+    the kernel library (.so), the bytecode (.ro) and the constants. The files are written to a
+    temporary folder which is renamed to export_dir, so that a partially written folder is never loaded.
+    """
+    cache_dir = os.path.dirname(os.path.abspath(export_dir))
+    os.makedirs(cache_dir, exist_ok=True)
+    tmp_dir = tempfile.mkdtemp(dir=cache_dir)
+    try:
+        consts_path = os.path.join(tmp_dir, "consts")
+        vm_exec.move_late_bound_consts(consts_path, byte_limit=256)
+        code, lib = vm_exec.save()
+        lib.export_library(os.path.join(tmp_dir, "model.so"))
+        with open(os.path.join(tmp_dir, "code.ro"), "wb") as code_file:
+            code_file.write(code)
+        # The constants were moved out of the executable, they are read back from the file on first use.
+        vm_exec.load_late_bound_consts(consts_path)
+        os.rename(tmp_dir, export_dir)
+        log.info("Exported compiled TVM module to {}".format(export_dir))
+    except OSError as e:
+        # Another session may have exported the same module meanwhile
+        log.warning("Unable to export compiled TVM module to {}: {}".format(export_dir, e))
+        shutil.rmtree(tmp_dir, ignore_errors=True)
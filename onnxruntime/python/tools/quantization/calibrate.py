@@ -169,6 +169,7 @@ class MinMaxCalibrater(CalibraterBase):
         use_external_data_format=False,
         moving_average=False,
         averaging_constant=0.01,
+        max_intermediate_outputs=None,
     ):
         """
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
@@ -178,6 +179,7 @@ class MinMaxCalibrater(CalibraterBase):
         :param use_external_data_format: use external data format to store model which size is >= 2Gb
         :param moving_average: compute the moving average of the minimum and maximum values instead of the global minimum and maximum.
         :param averaging_constant: constant smoothing factor to use when computing the moving average.
+        :param max_intermediate_outputs: maximum number of intermediate outputs before an intermediate range is computed.
         """
         super(MinMaxCalibrater, self).__init__(
             model,
@@ -194,6 +196,7 @@ class MinMaxCalibrater(CalibraterBase):
         if moving_average and (averaging_constant < 0 or averaging_constant > 1):
             raise ValueError("Invalid averaging constant, which should not be < 0 or > 1.")
         self.averaging_constant = averaging_constant
+        self.max_intermediate_outputs = max_intermediate_outputs
 
     def augment_graph(self):
         """
@@ -260,18 +263,36 @@ class MinMaxCalibrater(CalibraterBase):
         self.intermediate_outputs = []
 
     def collect_data(self, data_reader: CalibrationDataReader):
+        # Only the outputs of the added ReduceMin and ReduceMax nodes are fetched, so that the batches
+        # only keep the reduced values.
+        output_names = self.get_calibrate_output_names()
+        num_batches = 0
         while True:
             inputs = data_reader.get_next()
             if not inputs:
                 break
-            self.intermediate_outputs.append(self.infer_session.run(None, inputs))
-
-        if len(self.intermediate_outputs) == 0:
+            self.intermediate_outputs.append(self.infer_session.run(output_names, inputs))
+            num_batches += 1
+            if (
+                self.max_intermediate_outputs is not None
+                and len(self.intermediate_outputs) == self.max_intermediate_outputs
+            ):
+                self.compute_range()
+                self.clear_collected_data()
+
+        if num_batches == 0:
             raise ValueError("No data is collected.")
 
         self.compute_range()
         self.clear_collected_data()
 
+    def get_calibrate_output_names(self):
+        return [
+            output.name
+            for output in self.infer_session.get_outputs()
+            if output.name not in self.model_original_outputs
+        ]
+
     def merge_range(self, old_range, new_range):
         if not old_range:
             return new_range
@@ -296,7 +317,7 @@ class MinMaxCalibrater(CalibraterBase):
         if len(self.intermediate_outputs) == 0:
             return self.calibrate_tensors_range
 
-        output_names = [self.infer_session.get_outputs()[i].name for i in range(len(self.intermediate_outputs[0]))]
+        output_names = self.get_calibrate_output_names()
         output_dicts_list = [
             dict(zip(output_names, intermediate_output)) for intermediate_output in self.intermediate_outputs
         ]
@@ -305,7 +326,7 @@ class MinMaxCalibrater(CalibraterBase):
         for d in output_dicts_list:
             for k, v in d.items():
                 merged_output_dict.setdefault(k, []).append(v)
-        added_output_names = output_names[self.num_model_outputs :]
+        added_output_names = output_names
         calibrate_tensor_names = [
             added_output_names[i].rpartition("_")[0] for i in range(0, len(added_output_names), 2)
         ]  # output names
@@ -356,6 +377,7 @@ class HistogramCalibrater(CalibraterBase):
         num_bins=128,
         num_quantized_bins=2048,
         percentile=99.999,
+        max_intermediate_outputs=None,
     ):
         """
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
@@ -367,6 +389,8 @@ class HistogramCalibrater(CalibraterBase):
         :param num_bins: number of bins to create a new histogram for collecting tensor values.
         :param num_quantized_bins: number of quantized bins. Default 128.
         :param percentile: A float number between [0, 100]. Default 99.99.
+        :param max_intermediate_outputs: maximum number of intermediate outputs kept before they are merged into
+            the histograms. Bounds the memory use of the calibration of large datasets.
         """
         super(HistogramCalibrater, self).__init__(
             model, op_types_to_calibrate, augmented_model_path, use_external_data_format
@@ -381,6 +405,7 @@ class HistogramCalibrater(CalibraterBase):
         self.num_bins = num_bins
         self.num_quantized_bins = num_quantized_bins
         self.percentile = percentile
+        self.max_intermediate_outputs = max_intermediate_outputs
 
     def augment_graph(self):
         """
@@ -412,26 +437,41 @@ class HistogramCalibrater(CalibraterBase):
         """
         Entropy Calibrator collects operators' tensors as well as generates tensor histogram for each operator.
         """
+        # The outputs of the original model are not calibrated, so they are not fetched.
+        output_names = [
+            output.name
+            for output in self.infer_session.get_outputs()
+            if output.name not in self.model_original_outputs
+        ]
+        num_batches = 0
         while True:
             inputs = data_reader.get_next()
             if not inputs:
                 break
-            self.intermediate_outputs.append(self.infer_session.run(None, inputs))
-
-        if len(self.intermediate_outputs) == 0:
+            self.intermediate_outputs.append(self.infer_session.run(output_names, inputs))
+            num_batches += 1
+            if (
+                self.max_intermediate_outputs is not None
+                and len(self.intermediate_outputs) == self.max_intermediate_outputs
+            ):
+                self.collect_intermediate_outputs(output_names)
+
+        if num_batches == 0:
             raise ValueError("No data is collected.")
 
-        output_names = [self.infer_session.get_outputs()[i].name for i in range(len(self.intermediate_outputs[0]))]
-        output_dicts_list = [
-            dict(zip(output_names, intermediate_output)) for intermediate_output in self.intermediate_outputs
-        ]
+        self.collect_intermediate_outputs(output_names)
 
-        merged_dict = {}
-        for d in output_dicts_list:
-            for k, v in d.items():
-                merged_dict.setdefault(k, []).append(v)
+    def collect_intermediate_outputs(self, output_names):
+        """
+        Merge the intermediate outputs collected so far into the histograms and release them.
+        """
+        if len(self.intermediate_outputs) == 0:
+            return
 
-        clean_merged_dict = dict((i, merged_dict[i]) for i in merged_dict if i not in self.model_original_outputs)
+        clean_merged_dict = {}
+        for intermediate_output in self.intermediate_outputs:
+            for k, v in zip(output_names, intermediate_output):
+                clean_merged_dict.setdefault(k, []).append(v)
 
         if not self.collector:
             self.collector = HistogramCollector(
@@ -467,6 +507,7 @@ class EntropyCalibrater(HistogramCalibrater):
         symmetric=False,
         num_bins=128,
         num_quantized_bins=128,
+        max_intermediate_outputs=None,
     ):
         """
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
@@ -477,6 +518,8 @@ class EntropyCalibrater(HistogramCalibrater):
         :param symmetric: make range of tensor symmetric (central point is 0).
         :param num_bins: number of bins to create a new histogram for collecting tensor values.
         :param num_quantized_bins: number of quantized bins. Default 128.
+        :param max_intermediate_outputs: maximum number of intermediate outputs kept before they are merged into
+            the histograms.
         """
         super(EntropyCalibrater, self).__init__(
             model,
@@ -487,6 +530,7 @@ class EntropyCalibrater(HistogramCalibrater):
             symmetric=symmetric,
             num_bins=num_bins,
             num_quantized_bins=num_quantized_bins,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
 
 
@@ -501,6 +545,7 @@ class PercentileCalibrater(HistogramCalibrater):
         symmetric=False,
         num_bins=2048,
         percentile=99.999,
+        max_intermediate_outputs=None,
     ):
         """
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
@@ -511,6 +556,8 @@ class PercentileCalibrater(HistogramCalibrater):
         :param symmetric: make range of tensor symmetric (central point is 0).
         :param num_quantized_bins: number of quantized bins. Default 128.
         :param percentile: A float number between [0, 100]. Default 99.99.
+        :param max_intermediate_outputs: maximum number of intermediate outputs kept before they are merged into
+            the histograms.
         """
         super(PercentileCalibrater, self).__init__(
             model,
@@ -521,6 +568,7 @@ class PercentileCalibrater(HistogramCalibrater):
             symmetric=symmetric,
             num_bins=num_bins,
             percentile=percentile,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
 
 
@@ -581,13 +629,21 @@ class HistogramCollector(CalibrationDataCollector):
         else:
             raise ValueError("Only 'entropy' or 'percentile' method are supported")
 
+    @staticmethod
+    def flatten_data(data_arr):
+        """
+        Flatten a tensor, or the list of the values of a tensor in several batches, which may differ in shape.
+        """
+        if isinstance(data_arr, list):
+            return np.concatenate([np.asarray(arr).ravel() for arr in data_arr])
+        return np.asarray(data_arr).flatten()
+
     def collect_absolute_value(self, name_to_arr):
         """
         Collect histogram on absolute value
         """
         for tensor, data_arr in name_to_arr.items():
-            data_arr = np.asarray(data_arr)
-            data_arr = data_arr.flatten()
+            data_arr = self.flatten_data(data_arr)
             data_arr = np.absolute(data_arr)  # only consider absolute value
 
             if tensor not in self.histogram_dict:
@@ -614,8 +670,7 @@ class HistogramCollector(CalibrationDataCollector):
         Collect histogram on real value
         """
         for tensor, data_arr in name_to_arr.items():
-            data_arr = np.asarray(data_arr)
-            data_arr = data_arr.flatten()
+            data_arr = self.flatten_data(data_arr)
 
             if data_arr.size > 0:
                 min_value = np.min(data_arr)
@@ -848,6 +903,7 @@ def create_calibrator(
     extra_options={},
 ):
 
+    max_intermediate_outputs = extra_options.get("max_intermediate_outputs", None)
     if calibrate_method == CalibrationMethod.MinMax:
         # default settings for min-max algorithm
         symmetric = False if "symmetric" not in extra_options else extra_options["symmetric"]
@@ -861,6 +917,7 @@ def create_calibrator(
             symmetric=symmetric,
             moving_average=moving_average,
             averaging_constant=averaging_constant,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
     elif calibrate_method == CalibrationMethod.Entropy:
         # default settings for entropy algorithm
@@ -875,6 +932,7 @@ def create_calibrator(
             symmetric=symmetric,
             num_bins=num_bins,
             num_quantized_bins=num_quantized_bins,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
     elif calibrate_method == CalibrationMethod.Percentile:
         # default settings for percentile algorithm
@@ -889,6 +947,7 @@ def create_calibrator(
             symmetric=symmetric,
             num_bins=num_bins,
             percentile=percentile,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
 
     raise ValueError("Unsupported calibration method {}".format(calibrate_method))
@@ -125,6 +125,10 @@ def quantize_static(
             CalibMovingAverageConstant = float : Default is 0.01. Constant smoothing factor to use when computing the moving average of
                                                  the minimum and maximum values. Effective only when the calibration method selected is
                                                  MinMax and when CalibMovingAverage is set to True.
+            CalibMaxIntermediateOutputs = int : Default is None. Maximum number of calibration batches whose outputs are
+                                                kept in memory before they are reduced into the ranges or merged into
+                                                the histograms. Setting it bounds the memory use of the calibration of
+                                                large datasets.
     """
 
     mode = QuantizationMode.QLinearOps
@@ -138,6 +142,7 @@ def quantize_static(
         ("CalibTensorRangeSymmetric", "symmetric"),
         ("CalibMovingAverage", "moving_average"),
         ("CalibMovingAverageConstant", "averaging_constant"),
+        ("CalibMaxIntermediateOutputs", "max_intermediate_outputs"),
     ]
     calib_extra_options = {
         key: extra_options.get(name) for (name, key) in calib_extra_options_keys if name in extra_options
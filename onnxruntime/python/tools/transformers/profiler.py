@@ -375,6 +375,11 @@ def group_node_results(sess_time, kernel_time_only, use_gpu):
     op_fence_time = {}
     total_fence_time = 0
 
+    # estimated floating point operations and bytes moved, and hardware counters when recorded
+    op_flops = {}
+    op_bytes = {}
+    op_hardware_counters = {}
+
     provider_counter = {}
     for item in sess_time:
         if item["cat"] == "Node" and "dur" in item and "args" in item and "op_name" in item["args"]:
@@ -421,6 +426,18 @@ def group_node_results(sess_time, kernel_time_only, use_gpu):
 
             total_kernel_time += item["dur"]
 
+            args = item["args"]
+            if "flops" in args:
+                op_flops[op_name] = op_flops.get(op_name, 0) + int(args["flops"])
+            if "activation_size" in args and "parameter_size" in args and "output_size" in args:
+                item_bytes = int(args["activation_size"]) + int(args["parameter_size"]) + int(args["output_size"])
+                op_bytes[op_name] = op_bytes.get(op_name, 0) + item_bytes
+            if "cycles" in args:
+                counters = op_hardware_counters.setdefault(op_name, [0, 0, 0])
+                counters[0] += int(args["cycles"])
+                counters[1] += int(args["instructions"])
+                counters[2] += int(args["llc_miss_bytes"])
+
     lines = ["", "Grouped by operator"]
     lines.append("-" * 64)
     lines.append("Total(μs)\tTime%\tKernel(μs)\tKernel%\tCalls\tAvgKernel(μs)\tFence(μs)\tOperator")
@@ -435,6 +452,25 @@ def group_node_results(sess_time, kernel_time_only, use_gpu):
             f"{total_time:10d}\t{time_ratio * 100.0:5.2f}\t{kernel_time:11d}\t{kernel_time_ratio * 100.0:5.2f}\t{kernel_calls:5d}\t{avg_kernel_time:14.1f}\t{fence_time:10d}\t{op_name}"
         )
 
+    if op_flops:
+        lines += ["", "Achieved throughput by operator"]
+        lines.append("-" * 64)
+        lines.append("Kernel(μs)\tGFLOP/s\tGB/s\tIPC\tLLC miss GB/s\tOperator")
+        for op_name, kernel_time in sorted(op_kernel_time.items(), key=lambda x: x[1], reverse=True):
+            if kernel_time == 0:
+                continue
+            # FLOP/μs is MFLOP/s and B/μs is MB/s
+            gflops = op_flops.get(op_name, 0) / kernel_time / 1000.0
+            gbps = op_bytes.get(op_name, 0) / kernel_time / 1000.0
+            if op_name in op_hardware_counters:
+                cycles, instructions, llc_miss_bytes = op_hardware_counters[op_name]
+                ipc = f"{instructions / cycles:5.2f}" if cycles > 0 else "    -"
+                llc_gbps = f"{llc_miss_bytes / kernel_time / 1000.0:13.2f}"
+            else:
+                ipc = "    -"
+                llc_gbps = f"{'-':>13s}"
+            lines.append(f"{kernel_time:10d}\t{gflops:7.2f}\t{gbps:6.2f}\t{ipc}\t{llc_gbps}\t{op_name}")
+
     lines += ["", "Grouped by provider + operator"]
     lines.append("-" * 64)
     lines.append("Kernel(μs)\tProvider%\tCalls\tAvgKernel(μs)\tProvider\tOperator")
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include "core/common/op_latency_histograms.h"
+
+namespace onnxruntime {
+namespace test {
+
+using profiling::OpLatencyHistograms;
+
+TEST(OpLatencyHistogramsTest, SampleRate) {
+  OpLatencyHistograms histograms(3, {"Add"});
+  std::vector<bool> sampled;
+  for (int i = 0; i < 7; ++i) {
+    sampled.push_back(histograms.ShouldSampleRun());
+  }
+  ASSERT_EQ(sampled, (std::vector<bool>{true, false, false, true, false, false, true}));
+}
+
+TEST(OpLatencyHistogramsTest, Buckets) {
+  OpLatencyHistograms histograms(1, {"Add", "MatMul", "Add"});
+  ASSERT_EQ(histograms.OpTypes(), (std::vector<std::string>{"Add", "MatMul"}));
+
+  histograms.Record("Add", 0);
+  histograms.Record("Add", 1);
+  histograms.Record("Add", 3);
+  histograms.Record("Add", 4);
+  histograms.Record("MatMul", 7);
+  histograms.Record("MatMul", 1LL << 40);
+  // unknown op types are ignored
+  histograms.Record("Conv", 1);
+
+  constexpr size_t num_buckets = OpLatencyHistograms::kNumBuckets;
+  std::vector<uint64_t> counts(2 * num_buckets);
+  histograms.GetBucketCounts(counts.data());
+
+  std::vector<uint64_t> expected(2 * num_buckets, 0);
+  expected[0] = 1;                    // 0us
+  expected[1] = 1;                    // [1, 2)us
+  expected[2] = 1;                    // [2, 4)us
+  expected[3] = 1;                    // [4, 8)us
+  expected[num_buckets + 3] = 1;      // [4, 8)us
+  expected[2 * num_buckets - 1] = 1;  // longer than the last bucket
+  ASSERT_EQ(counts, expected);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
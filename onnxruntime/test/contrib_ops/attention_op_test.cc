@@ -823,6 +823,143 @@ TEST(AttentionTest, AttentionPastStateBatch1) {
                    use_past_state, past_sequence_length, &past_data, &present_data);
 }
 
+// Same as AttentionPastStateBatch1, with past and present sharing a buffer of max sequence length 5.
+TEST(AttentionTest, AttentionPastStateShareBuffer) {
+  int batch_size = 1;
+  int sequence_length = 1;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data = {
+      -0.019333266f, -0.21813886f, 0.16212955f, -0.015626367f};
+
+  std::vector<float> weight_data = {
+      -0.4738484025001526f,
+      -0.2613658607006073f,
+      -0.0978037416934967f,
+      -0.34988933801651f,
+      0.2243240624666214f,
+      -0.0429205559194088f,
+      0.418695330619812f,
+      0.17441125214099884f,
+      -0.18825532495975494f,
+      0.18357256054878235f,
+      -0.5806483626365662f,
+      -0.02251487597823143f,
+
+      0.08742205798625946f,
+      0.14734269678592682f,
+      0.2387014478445053f,
+      0.2884027063846588f,
+      0.6490834355354309f,
+      0.16965825855731964f,
+      -0.06346885114908218f,
+      0.4073973298072815f,
+      -0.03070945478975773f,
+      0.4110257923603058f,
+      0.07896808534860611f,
+      0.16783113777637482f,
+
+      0.0038893644232302904f,
+      0.06946629285812378f,
+      0.36680519580841064f,
+      -0.07261059433221817f,
+      -0.14960581064224243f,
+      0.020944256335496902f,
+      -0.09378612786531448f,
+      -0.1336742341518402f,
+      0.06061394885182381f,
+      0.2205914407968521f,
+      -0.03519909828901291f,
+      -0.18405692279338837f,
+
+      0.22149960696697235f,
+      -0.1884360909461975f,
+      -0.014074507169425488f,
+      0.4252440333366394f,
+      0.24987126886844635f,
+      -0.31396418809890747f,
+      0.14036843180656433f,
+      0.2854192554950714f,
+      0.09709841012954712f,
+      0.09935075044631958f,
+      -0.012154420837759972f,
+      0.2575816512107849f};
+
+  std::vector<float> bias_data = {
+      0.4803391396999359f,
+      -0.5254325866699219f,
+      -0.42926454544067383f,
+      -0.2059524953365326f,
+      -0.12773379683494568f,
+      -0.09542735666036606f,
+      -0.35286077857017517f,
+      -0.07646317780017853f,
+      -0.04590314254164696f,
+      -0.03752850368618965f,
+      -0.013764488510787487f,
+      -0.18478283286094666f};
+
+  // No mask_index
+  std::vector<int32_t> mask_index_data = {};
+
+  std::vector<float> output_data = {
+      0.20141591f, 0.43005896f, 0.35745093f, 0.19957167f};
+
+  std::vector<float> past_data = {
+      0.55445826f, 0.10127074f, 0.71770734f, 0.15915526f, 0.13913247f, 0.77447522f, 0.66044068f, 0.27559045f, 0.35731629f, 0.62033528f, 0.24354559f, 0.22859341f,
+      0.45075402f, 0.85365993f, 0.097346395f, 0.28859729f, 0.26926181f, 0.65922296f, 0.8177433f, 0.4212271f, 0.34352475f, 0.059609573f, 0.46556228f, 0.7226882f};
+
+  std::vector<float> present_data = {
+      0.55445826f, 0.10127074f, 0.71770734f, 0.15915526f, 0.13913247f, 0.77447522f, -0.30182117f, -0.12330482f, 0.66044068f, 0.27559045f, 0.35731629f, 0.62033528f, 0.24354559f, 0.22859341f, -0.36450946f, -0.19483691f,
+      0.45075402f, 0.85365993f, 0.097346395f, 0.28859729f, 0.26926181f, 0.65922296f, -0.027254611f, -0.096526355f, 0.8177433f, 0.4212271f, 0.34352475f, 0.059609573f, 0.46556228f, 0.7226882f, -0.025281552f, -0.25482416f};
+
+  int past_sequence_length = 3;
+  int max_sequence_length = 5;
+  int head_size = hidden_size / number_of_heads;
+
+  // The positions after the valid length of past are not attended, and are passed through to present.
+  std::vector<float> past_buffer_data;
+  std::vector<float> present_buffer_data;
+  const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;
+  const size_t present_chunk_length = past_chunk_length + static_cast<size_t>(sequence_length) * head_size;
+  for (size_t chunk = 0; chunk < 2 * static_cast<size_t>(batch_size) * number_of_heads; chunk++) {
+    auto past_chunk = past_data.begin() + chunk * past_chunk_length;
+    auto present_chunk = present_data.begin() + chunk * present_chunk_length;
+    past_buffer_data.insert(past_buffer_data.end(), past_chunk, past_chunk + past_chunk_length);
+    present_buffer_data.insert(present_buffer_data.end(), present_chunk, present_chunk + present_chunk_length);
+    for (int s = past_sequence_length; s < max_sequence_length; s++) {
+      for (int h = 0; h < head_size; h++) {
+        if (s >= past_sequence_length + sequence_length) {
+          present_buffer_data.push_back(100.0f);
+        }
+        past_buffer_data.push_back(100.0f);
+      }
+    }
+  }
+
+  std::vector<int64_t> input_dims = {batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> weights_dims = {hidden_size, 3 * hidden_size};
+  std::vector<int64_t> bias_dims = {3 * hidden_size};
+  std::vector<int64_t> past_dims = {2, batch_size, number_of_heads, max_sequence_length, head_size};
+  std::vector<int64_t> output_dims = {batch_size, sequence_length, hidden_size};
+
+  OpTester tester("Attention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(1));
+  tester.AddAttribute<int64_t>("past_present_share_buffer", static_cast<int64_t>(1));
+  tester.AddInput<float>("input", input_dims, input_data);
+  tester.AddInput<float>("weight", weights_dims, weight_data);
+  tester.AddInput<float>("bias", bias_dims, bias_data);
+  tester.AddOptionalInputEdge<int32_t>();
+  tester.AddInput<float>("past", past_dims, past_buffer_data);
+  tester.AddOptionalInputEdge<float>();
+  tester.AddInput<int32_t>("past_sequence_length", {1}, {past_sequence_length});
+  tester.AddOutput<float>("output", output_dims, output_data);
+  tester.AddOutput<float>("present", past_dims, present_buffer_data);
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {kRocmExecutionProvider, kTensorrtExecutionProvider});
+}
+
 TEST(AttentionTest, AttentionPastStateBatch2) {
   int batch_size = 2;
   int sequence_length = 1;
@@ -1794,6 +1931,120 @@ TEST(AttentionTest, AttentionPrunedModel) {
                    use_float16, is_unidirectional, use_past_state, past_sequence_length, past_data, present_data, kMaskRaw, input_hidden_size);
 }
 
+// Float16 attention with a head size supported by the fused CUDA kernel, and more keys than one tile of the kernel.
+// The inputs are exactly representable in float16, and the expected outputs are computed by a reference
+// implementation.
+static void RunFusedAttentionTest(int batch_size, int sequence_length, int number_of_heads, int head_size,
+                                  bool is_unidirectional, int past_sequence_length,
+                                  const std::vector<int32_t>& mask_index_data) {
+  const int hidden_size = number_of_heads * head_size;
+  const int all_sequence_length = past_sequence_length + sequence_length;
+  const bool use_past_state = past_sequence_length > 0;
+
+  std::vector<float> input_data(batch_size * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); i++) {
+    input_data[i] = static_cast<float>(static_cast<int>(i * 7 % 17) - 8) / 8.f;
+  }
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = static_cast<float>(static_cast<int>(i * 13 % 23) - 11) / 64.f;
+  }
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); i++) {
+    bias_data[i] = static_cast<float>(static_cast<int>(i * 5 % 11) - 5) / 16.f;
+  }
+  std::vector<float> past_data(2 * batch_size * number_of_heads * past_sequence_length * head_size);
+  for (size_t i = 0; i < past_data.size(); i++) {
+    past_data[i] = static_cast<float>(static_cast<int>(i * 3 % 19) - 9) / 8.f;
+  }
+
+  // present: 2 x batch_size x number_of_heads x all_sequence_length x head_size
+  std::vector<float> present_data(2 * batch_size * number_of_heads * all_sequence_length * head_size);
+  for (int b = 0; b < batch_size; b++) {
+    for (int t = 0; t < all_sequence_length; t++) {
+      for (int c = 0; c < 2 * hidden_size; c++) {
+        const int matrix = c / hidden_size;  // 0 for K and 1 for V
+        const int n = (c % hidden_size) / head_size;
+        const int d = c % head_size;
+        float value;
+        if (t < past_sequence_length) {
+          value = past_data[(((matrix * batch_size + b) * number_of_heads + n) * past_sequence_length + t) * head_size + d];
+        } else {
+          const int s = t - past_sequence_length;
+          double sum = bias_data[hidden_size + c];
+          for (int i = 0; i < hidden_size; i++) {
+            sum += static_cast<double>(input_data[(b * sequence_length + s) * hidden_size + i]) *
+                   weight_data[i * 3 * hidden_size + hidden_size + c];
+          }
+          value = static_cast<float>(sum);
+        }
+        present_data[(((matrix * batch_size + b) * number_of_heads + n) * all_sequence_length + t) * head_size + d] = value;
+      }
+    }
+  }
+
+  std::vector<float> output_data(batch_size * sequence_length * hidden_size);
+  for (int b = 0; b < batch_size; b++) {
+    const int mask_end = mask_index_data.empty() ? all_sequence_length : std::min(all_sequence_length, mask_index_data[b]);
+    for (int n = 0; n < number_of_heads; n++) {
+      const float* k = present_data.data() + ((0 * batch_size + b) * number_of_heads + n) * all_sequence_length * head_size;
+      const float* v = present_data.data() + ((1 * batch_size + b) * number_of_heads + n) * all_sequence_length * head_size;
+      for (int s = 0; s < sequence_length; s++) {
+        std::vector<double> q(head_size);
+        for (int d = 0; d < head_size; d++) {
+          double sum = bias_data[n * head_size + d];
+          for (int i = 0; i < hidden_size; i++) {
+            sum += static_cast<double>(input_data[(b * sequence_length + s) * hidden_size + i]) *
+                   weight_data[i * 3 * hidden_size + n * head_size + d];
+          }
+          q[d] = sum;
+        }
+
+        const int end = is_unidirectional ? std::min(mask_end, past_sequence_length + s + 1) : mask_end;
+        std::vector<double> scores(end);
+        double max_score = -std::numeric_limits<double>::infinity();
+        for (int t = 0; t < end; t++) {
+          double dot = 0.0;
+          for (int d = 0; d < head_size; d++) {
+            dot += q[d] * k[t * head_size + d];
+          }
+          scores[t] = dot / std::sqrt(static_cast<double>(head_size));
+          max_score = std::max(max_score, scores[t]);
+        }
+        double sum_exp = 0.0;
+        for (int t = 0; t < end; t++) {
+          scores[t] = std::exp(scores[t] - max_score);
+          sum_exp += scores[t];
+        }
+        for (int d = 0; d < head_size; d++) {
+          double context = 0.0;
+          for (int t = 0; t < end; t++) {
+            context += scores[t] * v[t * head_size + d];
+          }
+          output_data[(b * sequence_length + s) * hidden_size + n * head_size + d] = static_cast<float>(context / sum_exp);
+        }
+      }
+    }
+  }
+
+  bool use_float16 = true;
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads,
+                   use_float16, is_unidirectional, use_past_state, past_sequence_length, &past_data, &present_data);
+}
+
+TEST(AttentionTest, AttentionFusedKernelUnidirectional) {
+  RunFusedAttentionTest(2, 40, 2, 32, true, 0, {});
+}
+
+TEST(AttentionTest, AttentionFusedKernelMaskIndex) {
+  RunFusedAttentionTest(2, 40, 1, 64, false, 0, {40, 27});
+}
+
+TEST(AttentionTest, AttentionFusedKernelPastState) {
+  RunFusedAttentionTest(1, 5, 1, 128, true, 37, {});
+}
+
 #ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
 TEST(AttentionTest, SharedPrepackedWeights) {
   int batch_size = 2;
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <random>
+#include "gtest/gtest.h"
+#include "contrib_ops/cpu/transformers/beam_search_shared.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::BeamCopyStep;
+using contrib::transformers::GetBeamReorderSteps;
+
+namespace {
+
+// Applies the reorder steps to beams with one value per beam, and checks the result is same as a gather.
+void TestBeamReorder(const std::vector<int32_t>& beam_indices) {
+  std::vector<BeamCopyStep> steps;
+  GetBeamReorderSteps(beam_indices, steps);
+
+  std::vector<int> beams(beam_indices.size());
+  for (size_t i = 0; i < beams.size(); i++) {
+    beams[i] = static_cast<int>(i) * 10;
+  }
+
+  int temp_beam = -1;
+  size_t copies = 0;
+  for (const auto& step : steps) {
+    int value = step.source == BeamCopyStep::kTempBeam ? temp_beam : beams[step.source];
+    if (step.target == BeamCopyStep::kTempBeam) {
+      temp_beam = value;
+    } else {
+      beams[step.target] = value;
+      copies++;
+    }
+  }
+
+  size_t moved = 0;
+  for (size_t i = 0; i < beams.size(); i++) {
+    EXPECT_EQ(beams[i], beam_indices[i] * 10) << "beam " << i;
+    if (beam_indices[i] != static_cast<int32_t>(i)) {
+      moved++;
+    }
+  }
+
+  // Each beam that does not keep its own state is copied once.
+  EXPECT_EQ(copies, moved);
+}
+
+}  // namespace
+
+TEST(BeamSearchTest, ReorderBeamsInPlace) {
+  TestBeamReorder({0, 1, 2, 3});
+  TestBeamReorder({0, 0, 0, 0});
+  TestBeamReorder({3, 3, 1, 1});
+  TestBeamReorder({1, 0, 3, 2});
+  TestBeamReorder({1, 2, 3, 0});
+  TestBeamReorder({2, 0, 1, 1, 4, 4});
+
+  std::default_random_engine generator(11);
+  for (int beams = 1; beams <= 8; beams++) {
+    std::uniform_int_distribution<int32_t> distribution(0, beams - 1);
+    for (int test = 0; test < 50; test++) {
+      std::vector<int32_t> beam_indices(beams);
+      for (auto& index : beam_indices) {
+        index = distribution(generator);
+      }
+      TestBeamReorder(beam_indices);
+
+      // A random permutation only has cycles.
+      for (int i = 0; i < beams; i++) {
+        beam_indices[i] = i;
+      }
+      std::shuffle(beam_indices.begin(), beam_indices.end(), generator);
+      TestBeamReorder(beam_indices);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <map>
+#include "gtest/gtest.h"
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "contrib_ops/cpu/transformers/continuous_batching.h"
+#include "contrib_ops/cpu/transformers/sampling.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::ArgMaxToken;
+using contrib::transformers::ContinuousBatchingScheduler;
+using contrib::transformers::GenerationRequest;
+
+namespace {
+
+constexpr int kNumLayers = 2;
+constexpr int kNumHeads = 2;
+constexpr int kHeadSize = 2;
+constexpr int kVocabSize = 13;
+constexpr int kEosTokenId = 0;
+constexpr int kPadTokenId = 12;
+
+// The next token of the toy model: the sum of token x (position + 1) + 1 over all tokens, modulo the vocabulary size.
+int32_t ReferenceNextToken(const std::vector<int32_t>& sequence) {
+  int64_t sum = 0;
+  for (size_t i = 0; i < sequence.size(); i++) {
+    sum += static_cast<int64_t>(sequence[i]) * static_cast<int64_t>(i + 1) + 1;
+  }
+  return static_cast<int32_t>(sum % kVocabSize);
+}
+
+// A toy GPT subgraph. The value of a token in layer l is token x (position + 1) + l, and the logits are one-hot at
+// the sum of the attended values of layer 0 plus the number of attended tokens, modulo the vocabulary size.
+// Layer 1 is checked to attend to the same tokens, so the test catches states of other sequences, unmasked padding
+// and wrong positions.
+class ToyGptSubgraph {
+ public:
+  explicit ToyGptSubgraph(AllocatorPtr allocator) : allocator_(allocator) {}
+
+  Status Run(const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches) {
+    const Tensor& input_ids = feeds[0].Get<Tensor>();
+    const int batch_size = static_cast<int>(input_ids.Shape()[0]);
+    const int input_length = static_cast<int>(input_ids.Shape()[1]);
+    const int past_length = static_cast<int>(feeds[3].Get<Tensor>().Shape()[3]);
+    const int total_length = past_length + input_length;
+
+    const int32_t* ids = input_ids.Data<int32_t>();
+    const int32_t* positions = feeds[1].Get<Tensor>().Data<int32_t>();
+    const int32_t* mask = feeds[2].Get<Tensor>().Data<int32_t>();
+    EXPECT_EQ(feeds[2].Get<Tensor>().Shape()[1], total_length);
+
+    max_batch_size_ = std::max(max_batch_size_, batch_size);
+
+    int64_t present_dims[] = {2, batch_size, kNumHeads, total_length, kHeadSize};
+    const size_t past_stride = static_cast<size_t>(kNumHeads) * past_length * kHeadSize;
+    const size_t present_stride = static_cast<size_t>(kNumHeads) * total_length * kHeadSize;
+    std::vector<const float*> presents;
+    for (int layer = 0; layer < kNumLayers; layer++) {
+      const float* past = feeds[3 + layer].Get<Tensor>().Data<float>();
+
+      OrtValue present;
+      Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape(&present_dims[0], 5), allocator_, present);
+      float* data = present.GetMutable<Tensor>()->MutableData<float>();
+      for (int kv = 0; kv < 2; kv++) {
+        for (int b = 0; b < batch_size; b++) {
+          for (int n = 0; n < kNumHeads; n++) {
+            const float* past_bn = past + (kv * batch_size + b) * past_stride + n * past_length * kHeadSize;
+            float* present_bn = data + (kv * batch_size + b) * present_stride + n * total_length * kHeadSize;
+            std::copy_n(past_bn, past_length * kHeadSize, present_bn);
+            for (int s = 0; s < input_length; s++) {
+              const int32_t token = ids[b * input_length + s];
+              const int32_t position = positions[b * input_length + s];
+              float* state = present_bn + (past_length + s) * kHeadSize;
+              state[0] = kv == 0 ? static_cast<float>(position) : static_cast<float>(token * (position + 1) + layer);
+              state[1] = static_cast<float>(n);
+            }
+          }
+        }
+      }
+
+      presents.push_back(data);
+      fetches.push_back(present);
+    }
+
+    int64_t logits_dims[] = {batch_size, input_length, kVocabSize};
+    OrtValue logits;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape(&logits_dims[0], 3), allocator_, logits);
+    float* logits_data = logits.GetMutable<Tensor>()->MutableData<float>();
+    for (int b = 0; b < batch_size; b++) {
+      for (int s = 0; s < input_length; s++) {
+        // Causal attention over the unmasked tokens.
+        float sums[kNumLayers] = {};
+        for (int j = 0; j <= past_length + s; j++) {
+          if (mask[b * total_length + j] == 0) {
+            continue;
+          }
+          for (int layer = 0; layer < kNumLayers; layer++) {
+            const float* value = presents[layer] + (batch_size + b) * present_stride + j * kHeadSize;
+            sums[layer] += value[0] - static_cast<float>(layer) + 1.0f;
+          }
+        }
+        EXPECT_EQ(sums[0], sums[1]);
+
+        float* scores = logits_data + (b * input_length + s) * kVocabSize;
+        std::fill_n(scores, kVocabSize, 0.0f);
+        scores[static_cast<int>(sums[0]) % kVocabSize] = 1.0f;
+      }
+    }
+
+    fetches.insert(fetches.begin(), logits);
+    return Status::OK();
+  }
+
+  int MaxBatchSize() const { return max_batch_size_; }
+
+ private:
+  AllocatorPtr allocator_;
+  int max_batch_size_ = 0;
+};
+
+std::vector<int32_t> ReferenceGenerate(std::vector<int32_t> sequence, int max_new_tokens) {
+  std::vector<int32_t> tokens;
+  while (static_cast<int>(tokens.size()) < max_new_tokens) {
+    const int32_t token = ReferenceNextToken(sequence);
+    tokens.push_back(token);
+    sequence.push_back(token);
+    if (token == kEosTokenId) {
+      break;
+    }
+  }
+  return tokens;
+}
+
+}  // namespace
+
+TEST(ContinuousBatchingTest, RequestsJoinAndLeave) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  constexpr int page_size = 4;
+  constexpr int num_pages = 12;
+  constexpr int max_batch_size = 3;
+  ContinuousBatchingScheduler scheduler(allocator, kNumLayers, kNumHeads, kHeadSize, kVocabSize, kEosTokenId,
+                                        kPadTokenId, max_batch_size, page_size, num_pages);
+
+  ToyGptSubgraph subgraph(allocator);
+  auto run_subgraph = [&](const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches) {
+    return subgraph.Run(feeds, fetches);
+  };
+  auto select_token = [](const GenerationRequest&, gsl::span<const float> logits) { return ArgMaxToken(logits); };
+
+  struct Prompt {
+    std::vector<int32_t> tokens;
+    int max_new_tokens;
+  };
+  const std::vector<Prompt> prompts{{{3, 1, 4}, 6},
+                                    {{1, 5, 9, 2, 6, 5}, 3},
+                                    {{5}, 10},
+                                    {{3, 5, 8, 9, 7, 9, 3}, 8},
+                                    {{2, 3}, 1},
+                                    {{8, 4, 6, 2, 6, 4, 3, 3, 8}, 12},
+                                    {{2, 7, 9}, 5}};
+
+  std::map<int, std::vector<int32_t>> expected;
+  for (int i = 0; i < static_cast<int>(prompts.size()); i++) {
+    expected[i] = ReferenceGenerate(prompts[i].tokens, prompts[i].max_new_tokens);
+  }
+
+  // A request that could never fit in the cache is rejected.
+  EXPECT_FALSE(scheduler.AddRequest(100, std::vector<int32_t>(40, 1), 10).IsOK());
+
+  // Requests arrive while others are running.
+  std::map<int, std::vector<int32_t>> generated;
+  size_t next_request = 0;
+  int steps = 0;
+  while (next_request < prompts.size() || scheduler.HasUnfinishedRequests()) {
+    if (next_request < prompts.size() && steps % 2 == 0) {
+      const Prompt& prompt = prompts[next_request];
+      ASSERT_STATUS_OK(scheduler.AddRequest(static_cast<int>(next_request), prompt.tokens, prompt.max_new_tokens));
+      next_request++;
+    }
+
+    ASSERT_STATUS_OK(scheduler.Step(run_subgraph, select_token));
+    EXPECT_LE(scheduler.NumRunningRequests(), static_cast<size_t>(max_batch_size));
+    steps++;
+    ASSERT_LT(steps, 100);
+
+    for (auto& request : scheduler.TakeFinishedRequests()) {
+      EXPECT_EQ(generated.count(request.request_id), 0u);
+      generated[request.request_id] = std::move(request.tokens);
+    }
+  }
+
+  EXPECT_EQ(generated, expected);
+  EXPECT_EQ(subgraph.MaxBatchSize(), max_batch_size);
+  EXPECT_EQ(scheduler.Cache().NumFreePages(), num_pages);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(DequantizeGatherOpTest, Int8PerRow) {
+  OpTester test("DequantizeGather", 1, onnxruntime::kMSDomain);
+  test.AddInput<int8_t>("data", {3, 4}, {-128, -1, 0, 127,
+                                         10, 20, 30, 40,
+                                         -5, 5, -10, 10},
+                        true);
+  test.AddInput<int64_t>("indices", {2, 2}, {2, 0, -2, 2});
+  test.AddInput<float>("scales", {3}, {0.5f, 0.25f, 2.0f}, true);
+  test.AddInput<int8_t>("zero_points", {3}, {-1, 10, 0}, true);
+  test.AddOutput<float>("output", {2, 2, 4}, {-10.0f, 10.0f, -20.0f, 20.0f,
+                                              -63.5f, 0.0f, 0.5f, 64.0f,
+                                              0.0f, 2.5f, 5.0f, 7.5f,
+                                              -10.0f, 10.0f, -20.0f, 20.0f});
+  test.Run();
+}
+
+TEST(DequantizeGatherOpTest, Uint8PerTensorNoZeroPoint) {
+  OpTester test("DequantizeGather", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("data", {2, 3}, {0, 1, 255,
+                                          128, 4, 8},
+                         true);
+  test.AddInput<int32_t>("indices", {3}, {1, 1, 0});
+  test.AddInput<float>("scales", {}, {0.5f}, true);
+  test.AddOutput<float>("output", {3, 3}, {64.0f, 2.0f, 4.0f,
+                                           64.0f, 2.0f, 4.0f,
+                                           0.0f, 0.5f, 127.5f});
+  test.Run();
+}
+
+TEST(DequantizeGatherOpTest, FourBitsPerRow) {
+  OpTester test("DequantizeGather", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("bits", 4);
+  // element 2 * j is in the low 4 bits of byte j
+  test.AddInput<uint8_t>("data", {2, 2}, {0xF0, 0x21,
+                                          0x88, 0x7F},
+                         true);
+  test.AddInput<int64_t>("indices", {2}, {1, 0});
+  test.AddInput<float>("scales", {2}, {1.0f, 0.5f}, true);
+  test.AddInput<uint8_t>("zero_points", {2}, {0, 8}, true);
+  test.AddOutput<float>("output", {2, 4}, {0.0f, 0.0f, 3.5f, -0.5f,
+                                           0.0f, 15.0f, 1.0f, 2.0f});
+  test.Run();
+}
+
+TEST(DequantizeGatherOpTest, FourBitsDefaultZeroPoint) {
+  OpTester test("DequantizeGather", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("bits", 4);
+  test.AddInput<uint8_t>("data", {1, 2}, {0xF0, 0x98}, true);
+  test.AddInput<int64_t>("indices", {1}, {0});
+  test.AddInput<float>("scales", {1}, {2.0f}, true);
+  test.AddOutput<float>("output", {1, 4}, {-16.0f, 14.0f, 0.0f, 2.0f});
+  test.Run();
+}
+
+TEST(DequantizeGatherOpTest, IndicesOutOfBounds) {
+  OpTester test("DequantizeGather", 1, onnxruntime::kMSDomain);
+  test.AddInput<int8_t>("data", {2, 2}, {1, 2, 3, 4}, true);
+  test.AddInput<int64_t>("indices", {1}, {2});
+  test.AddInput<float>("scales", {2}, {1.0f, 1.0f}, true);
+  test.AddOutput<float>("output", {1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "core/framework/tensor.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/framework/test_utils.h"
 #include "test/optimizer/graph_transform_test_builder.h"
@@ -141,6 +142,88 @@ TEST(DynamicQuantizeMatMul, UInt8_test_with_empty_input) {
                                      true /*is_matrix_b_constant*/);
 }
 
+// The rows of A have very different ranges and are multiples of their scale, so that they are quantized exactly
+// with a scale per row.
+void TestDynamicQuantizeMatMulPerRow(bool is_matrix_b_constant, bool per_column, bool has_zp, bool has_bias,
+                                     const char* symmetric) {
+  constexpr int64_t M = 3;
+  constexpr int64_t K = 16;
+  constexpr int64_t N = 8;
+  const float row_scales[M] = {0.001f, 0.1f, 10.f};
+
+  std::vector<float> A_data(M * K);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t k = 0; k < K; k++) {
+      const int64_t value = k == 0 ? 127 : ((m * 37 + k * 29) % 255) - 127;
+      A_data[m * K + k] = value * row_scales[m];
+    }
+  }
+
+  std::vector<int8_t> B_data(K * N);
+  for (int64_t i = 0; i < K * N; i++) {
+    B_data[i] = static_cast<int8_t>(((i * 53) % 255) - 127);
+  }
+
+  const int64_t b_scale_size = per_column ? N : 1;
+  std::vector<float> B_scale(b_scale_size);
+  for (int64_t n = 0; n < b_scale_size; n++) {
+    B_scale[n] = 0.01f + 0.002f * n;
+  }
+
+  std::vector<float> Bias(N);
+  for (int64_t n = 0; n < N; n++) {
+    Bias[n] = 0.5f - 0.1f * n;
+  }
+
+  std::vector<float> Y_data(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += A_data[m * K + k] * B_data[k * N + n];
+      }
+      Y_data[m * N + n] = sum * B_scale[per_column ? n : 0] + (has_bias ? Bias[n] : 0.f);
+    }
+  }
+
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {M, K}, A_data);
+  test.AddInput<int8_t>("B", {K, N}, B_data, is_matrix_b_constant);
+  test.AddInput<float>("b_scale", {b_scale_size}, B_scale);
+
+  if (has_zp) {
+    test.AddInput<int8_t>("b_zero_point", {b_scale_size}, std::vector<int8_t>(b_scale_size, 0));
+  } else {
+    test.AddOptionalInputEdge<int8_t>();
+  }
+
+  if (has_bias) {
+    test.AddInput<float>("bias", {N}, Bias);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+
+  test.AddOutput<float>("Y", {M, N}, Y_data);
+  test.SetOutputRelErr("Y", 1e-4f);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicQuantizeMatMulPerRow, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicQuantizeMatMulSymmetric,
+                                                    symmetric));
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(DynamicQuantizeMatMul, PerRow) {
+  // the symmetric GEMM is used for the constant B where the platform supports it
+  for (const char* symmetric : {"0", "1"}) {
+    TestDynamicQuantizeMatMulPerRow(false, false, false, false, symmetric);
+    TestDynamicQuantizeMatMulPerRow(true, false, false, false, symmetric);
+    TestDynamicQuantizeMatMulPerRow(true, true, true, false, symmetric);
+    TestDynamicQuantizeMatMulPerRow(false, true, false, true, symmetric);
+    TestDynamicQuantizeMatMulPerRow(true, true, false, true, symmetric);
+  }
+}
+
 TEST(DynamicQuantizeMatMul, B_PerColumn_ND) {
   auto test_case = [&](const std::vector<int64_t>& input_shape,
                        const std::vector<int64_t>& weights_shape,
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static const std::vector<float> kEmbeddingBagWeight = {1.0f, 2.0f, 3.0f,
+                                                      -1.0f, 0.0f, 4.0f,
+                                                      5.0f, -2.0f, 1.0f,
+                                                      0.5f, 0.5f, 0.5f};
+
+static void RunEmbeddingBagTest(const std::string& mode, const std::vector<float>& expected_output) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", mode);
+  test.AddInput<float>("weight", {4, 3}, kEmbeddingBagWeight, true);
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 2, 3, -3});
+  test.AddOutput<float>("output", {2, 3}, expected_output);
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, Sum) {
+  RunEmbeddingBagTest("sum", {6.0f, 0.0f, 4.0f,
+                              -0.5f, 0.5f, 4.5f});
+}
+
+TEST(EmbeddingBagOpTest, Mean) {
+  RunEmbeddingBagTest("mean", {3.0f, 0.0f, 2.0f,
+                               -0.25f, 0.25f, 2.25f});
+}
+
+TEST(EmbeddingBagOpTest, Max) {
+  RunEmbeddingBagTest("max", {5.0f, 2.0f, 3.0f,
+                              0.5f, 0.5f, 4.0f});
+}
+
+TEST(EmbeddingBagOpTest, OffsetsWithEmptyBag) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {4, 3}, kEmbeddingBagWeight, true);
+  test.AddInput<int32_t>("indices", {5}, {1, 2, 3, 0, 1});
+  test.AddInput<int32_t>("offsets", {3}, {0, 2, 2});
+  test.AddOutput<float>("output", {3, 3}, {4.0f, -2.0f, 5.0f,
+                                           0.0f, 0.0f, 0.0f,
+                                           0.5f, 2.5f, 7.5f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, ManyBags) {
+  constexpr int64_t rows = 50;
+  constexpr int64_t dim = 37;
+  constexpr int64_t num_bags = 64;
+  constexpr int64_t bag_size = 9;
+
+  std::vector<float> weight(rows * dim);
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight[i] = static_cast<float>(static_cast<int64_t>(i % 23) - 11) * 0.25f;
+  }
+  std::vector<int64_t> indices(num_bags * bag_size);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<int64_t>((i * 17 + 5) % rows);
+  }
+  std::vector<float> output(num_bags * dim, 0.0f);
+  for (int64_t b = 0; b < num_bags; ++b) {
+    for (int64_t i = 0; i < bag_size; ++i) {
+      for (int64_t j = 0; j < dim; ++j) {
+        output[b * dim + j] += weight[indices[b * bag_size + i] * dim + j];
+      }
+    }
+  }
+
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {rows, dim}, weight, true);
+  test.AddInput<int64_t>("indices", {num_bags, bag_size}, indices);
+  test.AddOutput<float>("output", {num_bags, dim}, output);
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, IndexOutOfRange) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {4, 3}, kEmbeddingBagWeight, true);
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 4});
+  test.AddOutput<float>("output", {1, 3}, {0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
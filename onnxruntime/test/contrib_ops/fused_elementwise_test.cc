@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// The output spans several blocks of the kernel, which do not start at a multiple of the bias size.
+TEST(FusedElementwiseTest, BiasScaleSwish) {
+  constexpr int64_t rows = 3;
+  constexpr int64_t cols = 700;
+  const std::vector<int64_t> x_dims{rows, cols};
+  const std::vector<int64_t> bias_dims{cols};
+  RandomValueGenerator random{};
+  const std::vector<float> x = random.Uniform<float>(x_dims, -4.0f, 4.0f);
+  const std::vector<float> bias = random.Uniform<float>(bias_dims, -1.0f, 1.0f);
+  const float scale = 1.5f;
+
+  // y = (x + bias) * scale * Sigmoid((x + bias) * scale)
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    const float value = (x[i] + bias[i % cols]) * scale;
+    y[i] = value / (1.0f + std::exp(-value));
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("operations", std::vector<std::string>{"Add", "Mul", "Sigmoid", "Mul"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, 2, 4, -1, 4, 5});
+  test.AddInput<float>("x", x_dims, x);
+  test.AddInput<float>("bias", bias_dims, bias);
+  test.AddInput<float>("scale", {}, {scale});
+  test.AddOutput<float>("Y", x_dims, y);
+  test.SetOutputAbsErr("Y", 1e-5f);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, ScalarFirstOperand) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  // y = Relu(1 - x) / x
+  test.AddAttribute("operations", std::vector<std::string>{"Sub", "Relu", "Div"});
+  test.AddAttribute("operands", std::vector<int64_t>{1, 0, 2, -1, 3, 0});
+  test.AddInput<float>("x", {2, 3}, {-2.0f, -1.0f, 0.5f, 1.0f, 2.0f, 4.0f});
+  test.AddInput<float>("one", {1, 1}, {1.0f});
+  test.AddOutput<float>("Y", {2, 3}, {-1.5f, -2.0f, 1.0f, 0.0f, 0.0f, 0.0f});
+  test.Run();
+}
+
+// Each unary operation, on an output spanning several thread blocks of the CUDA kernel.
+TEST(FusedElementwiseTest, UnaryOperations) {
+  const std::vector<int64_t> dims{5, 300};
+  RandomValueGenerator random{};
+  const std::vector<float> x = random.Uniform<float>(dims, 0.1f, 2.0f);
+
+  // y = Tanh(Sqrt(Sigmoid(Relu(Reciprocal(Neg(Exp(Erf(Abs(x)))))) - x) + x)
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    const float value = -std::exp(std::erf(std::abs(x[i])));
+    const float relu = std::max(1.0f / value, 0.0f);
+    const float sigmoid = 1.0f / (1.0f + std::exp(-(relu - x[i])));
+    y[i] = std::tanh(std::sqrt(sigmoid) + x[i]);
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("operations", std::vector<std::string>{"Abs", "Erf", "Exp", "Neg", "Reciprocal", "Relu", "Sub",
+                                                           "Sigmoid", "Sqrt", "Add", "Tanh"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, -1, 1, -1, 2, -1, 3, -1, 4, -1, 5, -1, 6, 0, 7, -1, 8, -1,
+                                                     9, 0, 10, -1});
+  test.AddInput<float>("x", dims, x);
+  test.AddOutput<float>("Y", dims, y);
+  test.SetOutputAbsErr("Y", 1e-5f);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, UnsupportedBroadcast) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("operations", std::vector<std::string>{"Add", "Tanh"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 2, -1});
+  test.AddInput<float>("a", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("b", {2, 1}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2, 3}, std::vector<float>(6, 0.0f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "does not support broadcasting input 1");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
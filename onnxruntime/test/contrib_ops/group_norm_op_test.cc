@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(GroupNormOpTest, ThreeGroups) {
+  OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("groups", 3);
+  test.AddInput<float>("X", {1, 6, 2}, {1.0f, 2.0f, 3.0f, 4.0f,
+                                        0.0f, 0.0f, 2.0f, 2.0f,
+                                        -1.0f, 5.0f, 0.5f, 3.5f});
+  test.AddInput<float>("gamma", {6}, {1.0f, 2.0f, 0.5f, 1.0f, -1.0f, 2.0f}, true);
+  test.AddInput<float>("beta", {6}, {0.0f, 1.0f, 0.0f, -1.0f, 0.5f, 0.0f}, true);
+  test.AddOutput<float>("Y", {1, 6, 2}, {-1.341635f, -0.447212f, 1.894424f, 3.683271f,
+                                         -0.499998f, -0.499998f, -0.000005f, -0.000005f,
+                                         1.764910f, -0.764910f, -1.264910f, 1.264910f});
+  test.Run();
+}
+
+TEST(GroupNormOpTest, GroupsMustDivideChannels) {
+  OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("groups", 4);
+  test.AddInput<float>("X", {1, 6, 1}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("gamma", {6}, {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f}, true);
+  test.AddInput<float>("beta", {6}, {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, true);
+  test.AddOutput<float>("Y", {1, 6, 1}, {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "must divide the channel count");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -152,6 +152,26 @@ TEST(MatMulIntegerToFloat, NoZeroPoint_HasBias_test_S8S8) {
   RunMatMulIntegerToFloatTest<int8_t, int8_t, false, true>("testdata/matmul_integer_to_float_int8_int8_bias.onnx");
 }
 
+TEST(MatMulIntegerToFloat, test_S16S8) {
+  // Y = a_scale * b_scale * (A - a_zero_point) * (B - b_zero_point) + bias
+  OpTester test("MatMulIntegerToFloat", 1, onnxruntime::kMSDomain);
+  test.AddInput<int16_t>("A", {2, 3}, {1000, -2000, 30000,
+                                       -1, 0, 12});
+  test.AddInput<int8_t>("B", {3, 2}, {1, -2,
+                                      3, 4,
+                                      -128, 127},
+                        true);
+  test.AddInput<float>("a_scale", {1}, {0.01f});
+  test.AddInput<float>("b_scale", {2}, {0.5f, 0.25f});
+  test.AddInput<int16_t>("a_zero_point", {1}, {-10});
+  test.AddInput<int8_t>("b_zero_point", {2}, {1, -1});
+  test.AddInput<float>("bias", {2}, {1.0f, -1.0f});
+  test.AddOutput<float>("Y", {2, 2},
+                        {-19375.35f, 9574.8f,
+                         -13.09f, 6.1425f});
+  test.Run();
+}
+
 TEST(MatMulIntegerToFloat, MatMulInteger_Nuphar) {
   auto test_case = [&](const std::vector<int64_t>& input_shape,
                        const std::vector<int64_t>& weights_shape,
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+#include "core/common/common.h"
+#include "core/mlas/inc/mlas.h"
+
+#include <functional>
+#include <numeric>
+
+namespace onnxruntime {
+namespace test {
+
+static void RunMatMulNBitsTest(const std::vector<int64_t>& a_dims, int64_t N, int64_t block_size, bool has_zero_point) {
+  const int64_t K = a_dims.back();
+  const int64_t M = std::accumulate(a_dims.begin(), a_dims.end() - 1, int64_t{1}, std::multiplies<int64_t>());
+  const int64_t blocks_per_col = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size / 2;
+
+  RandomValueGenerator random{};
+  std::vector<float> a_data = random.Uniform<float>(a_dims, -1.0f, 1.0f);
+  std::vector<float> b_data = random.Uniform<float>({K, N}, -1.0f, 1.0f);
+
+  std::vector<uint8_t> b_quant(static_cast<size_t>(N * blocks_per_col * blob_size));
+  std::vector<float> scales(static_cast<size_t>(N * blocks_per_col));
+  std::vector<uint8_t> zero_points(static_cast<size_t>(N * ((blocks_per_col + 1) / 2)));
+
+  MlasQ4GemmQuantizeB(static_cast<size_t>(block_size), static_cast<size_t>(N), static_cast<size_t>(K),
+                      b_data.data(), static_cast<size_t>(N), b_quant.data(), scales.data(),
+                      has_zero_point ? zero_points.data() : nullptr);
+
+  // reference output computed from the dequantized weights
+  std::vector<float> expected(static_cast<size_t>(M * N), 0.0f);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t k = 0; k < K; k++) {
+      const int64_t block = k / block_size;
+      const uint8_t packed = b_quant[(n * blocks_per_col + block) * blob_size + (k % block_size) / 2];
+      const int q = (k & 1) ? (packed >> 4) : (packed & 0x0F);
+      int zp = 8;
+      if (has_zero_point) {
+        const uint8_t zp_packed = zero_points[n * ((blocks_per_col + 1) / 2) + block / 2];
+        zp = (block & 1) ? (zp_packed >> 4) : (zp_packed & 0x0F);
+      }
+      const float b = static_cast<float>(q - zp) * scales[n * blocks_per_col + block];
+      for (int64_t m = 0; m < M; m++) {
+        expected[m * N + n] += a_data[m * K + k] * b;
+      }
+    }
+  }
+
+  std::vector<int64_t> y_dims(a_dims);
+  y_dims.back() = N;
+
+  OpTester test("MatMulNBits", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddAttribute<int64_t>("bits", 4);
+  test.AddInput<float>("A", a_dims, a_data);
+  test.AddInput<uint8_t>("B", {N, blocks_per_col, blob_size}, b_quant, true);
+  test.AddInput<float>("scales", {N * blocks_per_col}, scales, true);
+  if (has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {N * ((blocks_per_col + 1) / 2)}, zero_points, true);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+  test.AddOutput<float>("Y", y_dims, expected);
+  test.SetOutputAbsErr("Y", 1e-3f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(MatMulNBits, Float32) {
+  for (int64_t block_size : {32, 64, 128, 256}) {
+    for (bool has_zero_point : {false, true}) {
+      RunMatMulNBitsTest({1, 1, 256}, 64, block_size, has_zero_point);
+      RunMatMulNBitsTest({2, 3, 100}, 17, block_size, has_zero_point);
+      RunMatMulNBitsTest({48, 520}, 40, block_size, has_zero_point);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,328 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "core/util/math.h"
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+class NhwcConvOpTester {
+ private:
+  std::default_random_engine generator_{1234};
+  std::vector<float> X_data_;
+  std::vector<int64_t> X_shape_;
+  std::vector<float> W_data_;
+  std::vector<int64_t> W_shape_;
+  std::vector<float> B_data_;
+  std::vector<int64_t> pads_;
+  std::vector<int64_t> strides_;
+  std::vector<int64_t> dilations_;
+  int64_t groups_{0};
+  std::string activation_;
+
+  static size_t ShapeSize(const std::vector<int64_t>& shape) {
+    return static_cast<size_t>(std::accumulate(shape.cbegin(), shape.cend(), 1LL, std::multiplies<int64_t>()));
+  }
+
+  static bool NextPosition(int64_t N, const int64_t* shape, int64_t* dims) {
+    // Loop over spatial axes in reverse order to choose an index, like counting.
+    bool incremented = false;
+    for (int64_t d_i = N - 1; d_i >= 0; --d_i) {
+      int64_t d_max = shape[d_i];
+      ORT_ENFORCE(dims[d_i] < d_max);
+      if (dims[d_i] == d_max - 1) {
+        dims[d_i] = 0;
+      } else {  // dims[d_i] < d_max - 1
+        ++dims[d_i];
+        incremented = true;
+        break;
+      }
+    }
+    return incremented;
+  }
+
+  void GenerateRandom(std::vector<float>& data, const std::vector<int64_t>& shape) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    data.resize(ShapeSize(shape));
+    for (auto& value : data) {
+      value = distribution(generator_);
+    }
+  }
+
+  void ComputeExpectedOutput(std::vector<float>& Y_data, std::vector<int64_t>& Y_shape) {
+    ORT_ENFORCE(W_shape_.size() > 2);
+    ORT_ENFORCE(X_shape_.size() == W_shape_.size());
+
+    const size_t kernel_rank = W_shape_.size() - 2;
+
+    const int64_t batch_count = X_shape_[0];
+    const int64_t input_channels = X_shape_[kernel_rank + 1];
+    const int64_t output_channels = W_shape_[0];
+    const int64_t group_count = std::max<int64_t>(groups_, 1);
+    const int64_t group_input_channels = W_shape_[1];
+    const int64_t group_output_channels = output_channels / group_count;
+
+    ORT_ENFORCE(input_channels == group_input_channels * group_count);
+    ORT_ENFORCE(output_channels == group_output_channels * group_count);
+
+    const int64_t* input_shape = X_shape_.data() + 1;
+    const int64_t* kernel_shape = W_shape_.data() + 2;
+
+    std::vector<int64_t> pads(pads_);
+    if (pads.empty()) {
+      pads.resize(kernel_rank * 2, 0);
+    }
+    std::vector<int64_t> dilations(dilations_);
+    if (dilations.empty()) {
+      dilations.resize(kernel_rank, 1);
+    }
+    std::vector<int64_t> strides(strides_);
+    if (strides.empty()) {
+      strides.resize(kernel_rank, 1);
+    }
+
+    // Compute the expected shape of the output.
+    Y_shape.reserve(kernel_rank + 2);
+    Y_shape.push_back(batch_count);
+    for (size_t n = 0; n < kernel_rank; n++) {
+      Y_shape.push_back(((input_shape[n] + pads[n] + pads[kernel_rank + n]) -
+                         (dilations[n] * (kernel_shape[n] - 1) + 1)) /
+                            strides[n] +
+                        1);
+    }
+    Y_shape.push_back(output_channels);
+    Y_data.resize(ShapeSize(Y_shape));
+
+    const int64_t* output_shape = Y_shape.data() + 1;
+
+    const int64_t input_image_size = std::accumulate(
+        input_shape, input_shape + kernel_rank, 1LL, std::multiplies<int64_t>());
+    const int64_t kernel_size = std::accumulate(
+        kernel_shape, kernel_shape + kernel_rank, 1LL, std::multiplies<int64_t>());
+
+    const float* Xdata = X_data_.data();
+    float* Ydata = Y_data.data();
+
+    for (int64_t batch = 0; batch < batch_count; batch++) {
+      std::vector<int64_t> d_output(kernel_rank, 0);
+      do {
+        for (int64_t oc = 0; oc < output_channels; oc++) {
+          const int64_t group_id = oc / group_output_channels;
+          const float* weight_data = W_data_.data() + oc * group_input_channels * kernel_size;
+          double sum = B_data_.empty() ? 0.0 : B_data_[oc];
+
+          std::vector<int64_t> d_kernel(kernel_rank, 0);
+          int64_t kernel_offset = 0;
+          do {
+            int64_t input_offset = 0;
+            bool is_padding = false;
+            for (size_t axis = 0; axis < kernel_rank; ++axis) {
+              int64_t input_dim = d_kernel[axis] * dilations[axis] + d_output[axis] * strides[axis] - pads[axis];
+              is_padding |= !math::is_a_ge_zero_and_a_lt_b(input_dim, input_shape[axis]);
+              input_offset *= input_shape[axis];
+              input_offset += input_dim;
+            }
+            if (!is_padding) {
+              const float* data_ptr = Xdata + input_offset * input_channels + group_id * group_input_channels;
+              for (int64_t ic = 0; ic < group_input_channels; ic++) {
+                sum += static_cast<double>(data_ptr[ic]) * weight_data[ic * kernel_size + kernel_offset];
+              }
+            }
+            kernel_offset++;
+          } while (NextPosition(kernel_rank, kernel_shape, d_kernel.data()));
+
+          if (activation_ == "Relu") {
+            sum = std::max(sum, 0.0);
+          }
+          Ydata[oc] = static_cast<float>(sum);
+        }
+        Ydata += output_channels;
+      } while (NextPosition(kernel_rank, output_shape, d_output.data()));
+      Xdata += input_channels * input_image_size;
+    }
+  }
+
+ public:
+  void GenerateRandomInput(const std::vector<int64_t>& shape) {
+    GenerateRandom(X_data_, shape);
+    X_shape_ = shape;
+  }
+
+  void GenerateRandomWeights(const std::vector<int64_t>& shape) {
+    GenerateRandom(W_data_, shape);
+    W_shape_ = shape;
+  }
+
+  void GenerateRandomBias() {
+    GenerateRandom(B_data_, {W_shape_[0]});
+  }
+
+  void SetPads(const std::vector<int64_t>& pads) {
+    pads_ = pads;
+  }
+
+  void SetStrides(const std::vector<int64_t>& strides) {
+    strides_ = strides;
+  }
+
+  void SetDilations(const std::vector<int64_t>& dilations) {
+    dilations_ = dilations;
+  }
+
+  void SetGroups(int64_t groups) {
+    groups_ = groups;
+  }
+
+  void SetActivation(const std::string& activation) {
+    activation_ = activation;
+  }
+
+  void Run(bool weights_are_initializers = true) {
+    std::vector<float> Y_data;
+    std::vector<int64_t> Y_shape;
+    ComputeExpectedOutput(Y_data, Y_shape);
+
+    OpTester test("NhwcConv", 1, onnxruntime::kMSDomain);
+    test.AddInput<float>("X", X_shape_, X_data_);
+    test.AddInput<float>("W", W_shape_, W_data_, weights_are_initializers);
+    if (!B_data_.empty()) {
+      test.AddInput<float>("B", {W_shape_[0]}, B_data_, weights_are_initializers);
+    }
+    test.AddOutput<float>("Y", Y_shape, Y_data, false, 1e-4f, 1e-4f);
+    if (!pads_.empty()) {
+      test.AddAttribute("pads", pads_);
+    }
+    if (!strides_.empty()) {
+      test.AddAttribute("strides", strides_);
+    }
+    if (!dilations_.empty()) {
+      test.AddAttribute("dilations", dilations_);
+    }
+    if (groups_ > 0) {
+      test.AddAttribute("group", groups_);
+    }
+    if (!activation_.empty()) {
+      test.AddAttribute("activation", activation_);
+    }
+
+    // The kernel of the other providers, if any, does not take the fused activation.
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+};
+
+TEST(NhwcConvContribOpTest, Conv1D) {
+  NhwcConvOpTester test;
+  test.GenerateRandomInput({1, 23, 12});
+  test.GenerateRandomWeights({16, 12, 5});
+  test.SetPads({2, 2});
+  test.Run();
+}
+
+TEST(NhwcConvContribOpTest, Conv2D) {
+  for (int64_t channels : {1, 3, 8, 13}) {
+    NhwcConvOpTester test;
+    test.GenerateRandomInput({2, 15, 19, channels});
+    test.GenerateRandomWeights({17, channels, 3, 3});
+    test.GenerateRandomBias();
+    test.SetPads({1, 1, 1, 1});
+    test.Run();
+  }
+}
+
+TEST(NhwcConvContribOpTest, Conv2D_DynamicWeights) {
+  NhwcConvOpTester test;
+  test.GenerateRandomInput({1, 15, 19, 8});
+  test.GenerateRandomWeights({12, 8, 3, 3});
+  test.GenerateRandomBias();
+  test.SetStrides({2, 2});
+  test.Run(false);
+}
+
+TEST(NhwcConvContribOpTest, Conv2D_Pointwise) {
+  NhwcConvOpTester test;
+  test.GenerateRandomInput({3, 13, 11, 24});
+  test.GenerateRandomWeights({40, 24, 1, 1});
+  test.GenerateRandomBias();
+  test.Run();
+}
+
+TEST(NhwcConvContribOpTest, Conv2D_Groups) {
+  NhwcConvOpTester test;
+  test.GenerateRandomInput({1, 11, 13, 24});
+  test.GenerateRandomWeights({12, 8, 3, 3});
+  test.GenerateRandomBias();
+  test.SetGroups(3);
+  test.SetPads({1, 0, 1, 0});
+  test.Run();
+}
+
+TEST(NhwcConvContribOpTest, Conv2D_PointwiseGroups) {
+  NhwcConvOpTester test;
+  test.GenerateRandomInput({1, 11, 13, 16});
+  test.GenerateRandomWeights({32, 4, 1, 1});
+  test.SetGroups(4);
+  test.Run();
+}
+
+TEST(NhwcConvContribOpTest, Conv2D_Depthwise) {
+  for (int64_t channels : {1, 5, 8, 27}) {
+    NhwcConvOpTester test;
+    test.GenerateRandomInput({2, 17, 15, channels});
+    test.GenerateRandomWeights({channels, 1, 3, 3});
+    test.GenerateRandomBias();
+    test.SetGroups(channels);
+    test.SetPads({1, 1, 1, 1});
+    test.SetStrides({2, 2});
+    test.Run();
+  }
+}
+
+TEST(NhwcConvContribOpTest, Conv2D_Dilations) {
+  NhwcConvOpTester test;
+  test.GenerateRandomInput({1, 19, 17, 6});
+  test.GenerateRandomWeights({10, 6, 3, 3});
+  test.SetDilations({2, 2});
+  test.SetPads({2, 2, 2, 2});
+  test.Run();
+}
+
+TEST(NhwcConvContribOpTest, Conv2D_Relu) {
+  NhwcConvOpTester test;
+  test.GenerateRandomInput({1, 15, 19, 16});
+  test.GenerateRandomWeights({24, 16, 3, 3});
+  test.GenerateRandomBias();
+  test.SetPads({1, 1, 1, 1});
+  test.SetActivation("Relu");
+  test.Run();
+}
+
+TEST(NhwcConvContribOpTest, Conv2D_DepthwiseRelu) {
+  NhwcConvOpTester test;
+  test.GenerateRandomInput({1, 15, 19, 16});
+  test.GenerateRandomWeights({16, 1, 5, 5});
+  test.GenerateRandomBias();
+  test.SetGroups(16);
+  test.SetPads({2, 2, 2, 2});
+  test.SetActivation("Relu");
+  test.Run();
+}
+
+TEST(NhwcConvContribOpTest, Conv3D) {
+  NhwcConvOpTester test;
+  test.GenerateRandomInput({1, 9, 13, 15, 6});
+  test.GenerateRandomWeights({10, 6, 2, 4, 3});
+  test.SetPads({0, 1, 1, 1, 1, 1});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
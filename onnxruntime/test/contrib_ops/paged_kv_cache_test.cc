@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <random>
+#include "gtest/gtest.h"
+#include "core/framework/allocator.h"
+#include "contrib_ops/cpu/transformers/paged_kv_cache.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::PagedAttention;
+using contrib::transformers::PagedKVCache;
+
+namespace {
+
+constexpr int kNumLayers = 2;
+constexpr int kNumHeads = 2;
+constexpr int kHeadSize = 4;
+constexpr int kPageSize = 4;
+
+// A value that identifies the tag, layer, key or value, head, token and element.
+float StateValue(int tag, int layer, int kv, int head, int token, int h) {
+  return static_cast<float>(((((tag * kNumLayers + layer) * 2 + kv) * kNumHeads + head) * 64 + token) * kHeadSize + h);
+}
+
+// Writes tokens [position, position + num_tokens) of all layers with values of the tag.
+void WriteStates(PagedKVCache& cache, int sequence_id, int tag, int position, int num_tokens) {
+  std::vector<float> key(static_cast<size_t>(kNumHeads) * num_tokens * kHeadSize);
+  std::vector<float> value(key.size());
+  for (int layer = 0; layer < kNumLayers; layer++) {
+    for (int head = 0; head < kNumHeads; head++) {
+      for (int t = 0; t < num_tokens; t++) {
+        for (int h = 0; h < kHeadSize; h++) {
+          size_t i = (static_cast<size_t>(head) * num_tokens + t) * kHeadSize + h;
+          key[i] = StateValue(tag, layer, 0, head, position + t, h);
+          value[i] = StateValue(tag, layer, 1, head, position + t, h);
+        }
+      }
+    }
+    cache.Write(layer, sequence_id, position, num_tokens, key.data(), value.data());
+  }
+}
+
+// Checks that tokens [position, position + num_tokens) of all layers have values of the tag.
+void CheckStates(const PagedKVCache& cache, int sequence_id, int tag, int position, int num_tokens) {
+  auto page_table = cache.PageTable(sequence_id);
+  for (int layer = 0; layer < kNumLayers; layer++) {
+    for (int head = 0; head < kNumHeads; head++) {
+      for (int t = position; t < position + num_tokens; t++) {
+        const int page = page_table[t / kPageSize];
+        const float* key = cache.Key(page, layer, head) + (t % kPageSize) * kHeadSize;
+        const float* value = cache.Value(page, layer, head) + (t % kPageSize) * kHeadSize;
+        for (int h = 0; h < kHeadSize; h++) {
+          ASSERT_EQ(key[h], StateValue(tag, layer, 0, head, t, h)) << "layer " << layer << " head " << head << " token " << t;
+          ASSERT_EQ(value[h], StateValue(tag, layer, 1, head, t, h)) << "layer " << layer << " head " << head << " token " << t;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(PagedKVCacheTest, ForkAndCopyOnWrite) {
+  constexpr int num_pages = 6;
+  PagedKVCache cache(std::make_shared<CPUAllocator>(), kNumLayers, kNumHeads, kHeadSize, kPageSize, num_pages);
+
+  int a = cache.AddSequence();
+  ASSERT_STATUS_OK(cache.Extend(a, 6));
+  WriteStates(cache, a, 1, 0, 6);
+  EXPECT_EQ(cache.SequenceLength(a), 6);
+  EXPECT_EQ(cache.PageTable(a).size(), 2u);
+  EXPECT_EQ(cache.NumFreePages(), num_pages - 2);
+
+  // The fork shares both pages until it writes to the partially filled last page.
+  int b = cache.ForkSequence(a);
+  EXPECT_EQ(cache.NumFreePages(), num_pages - 2);
+  CheckStates(cache, b, 1, 0, 6);
+
+  ASSERT_STATUS_OK(cache.Extend(b, 3));
+  WriteStates(cache, b, 2, 6, 3);
+  EXPECT_EQ(cache.NumFreePages(), num_pages - 4);
+  EXPECT_EQ(cache.PageTable(a)[0], cache.PageTable(b)[0]);
+  EXPECT_NE(cache.PageTable(a)[1], cache.PageTable(b)[1]);
+  CheckStates(cache, a, 1, 0, 6);
+  CheckStates(cache, b, 1, 0, 6);
+  CheckStates(cache, b, 2, 6, 3);
+
+  // Both beams continue from b. The page only held by a is released.
+  std::vector<int> sequence_ids{a, b};
+  std::vector<int32_t> beam_indices{1, 1};
+  cache.ReorderSequences(sequence_ids, beam_indices);
+  EXPECT_EQ(cache.NumFreePages(), num_pages - 3);
+  EXPECT_EQ(cache.SequenceLength(a), 9);
+  CheckStates(cache, a, 1, 0, 6);
+  CheckStates(cache, a, 2, 6, 3);
+
+  // Out of pages: the sequence is unchanged.
+  EXPECT_FALSE(cache.Extend(a, 5 * kPageSize).IsOK());
+  EXPECT_EQ(cache.SequenceLength(a), 9);
+
+  cache.FreeSequence(a);
+  EXPECT_EQ(cache.NumFreePages(), num_pages - 3);
+  cache.FreeSequence(b);
+  EXPECT_EQ(cache.NumFreePages(), num_pages);
+
+  // Released ids are reused.
+  int c = cache.AddSequence();
+  EXPECT_TRUE(c == a || c == b);
+  EXPECT_EQ(cache.SequenceLength(c), 0);
+}
+
+TEST(PagedKVCacheTest, PagedAttention) {
+  const std::vector<int> lengths{1, 5, 9, 4};
+  const int batch_size = static_cast<int>(lengths.size());
+  const int layer = 1;
+  PagedKVCache cache(std::make_shared<CPUAllocator>(), kNumLayers, kNumHeads, kHeadSize, kPageSize, 16);
+
+  std::default_random_engine generator(17);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+  // Random states of shape (batch_size, num_heads, length, head_size) for each sequence.
+  std::vector<int> sequence_ids;
+  std::vector<std::vector<float>> keys;
+  std::vector<std::vector<float>> values;
+  for (int b = 0; b < batch_size; b++) {
+    std::vector<float> key(static_cast<size_t>(kNumHeads) * lengths[b] * kHeadSize);
+    std::vector<float> value(key.size());
+    for (size_t i = 0; i < key.size(); i++) {
+      key[i] = distribution(generator);
+      value[i] = distribution(generator);
+    }
+
+    int sequence_id = cache.AddSequence();
+    ASSERT_STATUS_OK(cache.Extend(sequence_id, lengths[b]));
+    cache.Write(layer, sequence_id, 0, lengths[b], key.data(), value.data());
+
+    sequence_ids.push_back(sequence_id);
+    keys.push_back(std::move(key));
+    values.push_back(std::move(value));
+  }
+
+  std::vector<float> query(static_cast<size_t>(batch_size) * kNumHeads * kHeadSize);
+  for (auto& q : query) {
+    q = distribution(generator);
+  }
+
+  const float scale = 1.0f / std::sqrt(static_cast<float>(kHeadSize));
+  std::vector<float> output(query.size());
+  PagedAttention(cache, layer, sequence_ids, query.data(), output.data(), scale, nullptr);
+
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < kNumHeads; n++) {
+      const float* q = query.data() + (static_cast<size_t>(b) * kNumHeads + n) * kHeadSize;
+      const float* k = keys[b].data() + static_cast<size_t>(n) * lengths[b] * kHeadSize;
+      const float* v = values[b].data() + static_cast<size_t>(n) * lengths[b] * kHeadSize;
+
+      std::vector<double> probs(lengths[b]);
+      double max_score = -1e30;
+      for (int t = 0; t < lengths[b]; t++) {
+        double score = 0.0;
+        for (int h = 0; h < kHeadSize; h++) {
+          score += q[h] * k[t * kHeadSize + h];
+        }
+        probs[t] = score * scale;
+        max_score = std::max(max_score, probs[t]);
+      }
+      double sum = 0.0;
+      for (auto& p : probs) {
+        p = std::exp(p - max_score);
+        sum += p;
+      }
+
+      for (int h = 0; h < kHeadSize; h++) {
+        double expected = 0.0;
+        for (int t = 0; t < lengths[b]; t++) {
+          expected += probs[t] / sum * v[t * kHeadSize + h];
+        }
+        EXPECT_NEAR(output[(static_cast<size_t>(b) * kNumHeads + n) * kHeadSize + h], expected, 1e-5)
+            << "batch " << b << " head " << n << " h " << h;
+      }
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(QLinearLayerNormalizationTest, UInt8_WithBias) {
+  OpTester test("QLinearLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", -1);
+
+  std::vector<int64_t> dims = {2, 4};
+  test.AddInput<uint8_t>("X", dims, {100, 128, 150, 200, 0, 64, 255, 30});
+  test.AddInput<float>("X_scale", {}, {0.05f});
+  test.AddInput<uint8_t>("X_zero_point", {}, {128});
+  test.AddInput<float>("Scale", {4}, {1.0f, 0.5f, 2.0f, 1.5f}, true);
+  test.AddInput<float>("Y_scale", {}, {0.02f});
+  test.AddInput<uint8_t>("Y_zero_point", {}, {128});
+  test.AddInput<float>("B", {4}, {0.1f, -0.2f, 0.0f, 0.3f}, true);
+  test.AddOutput<uint8_t>("Y", dims, {72, 107, 143, 255, 89, 112, 255, 100});
+  test.Run();
+}
+
+TEST(QLinearLayerNormalizationTest, Int8_NoBias) {
+  OpTester test("QLinearLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", 1);
+
+  std::vector<int64_t> dims = {2, 4};
+  test.AddInput<int8_t>("X", dims, {-20, 0, 22, 72, -128, -64, 127, -98});
+  test.AddInput<float>("X_scale", {}, {0.05f});
+  test.AddOptionalInputEdge<int8_t>();  // optional "X_zero_point" using default value here
+  test.AddInput<float>("Scale", {4}, {1.0f, 0.5f, 2.0f, 1.5f}, true);
+  test.AddInput<float>("Y_scale", {}, {0.02f});
+  test.AddOptionalInputEdge<int8_t>();  // optional "Y_zero_point" using default value here
+  test.AddOutput<int8_t>("Y", dims, {-56, -13, 10, 117, -44, -6, 127, -43});
+  test.Run();
+}
+
+TEST(QLinearLayerNormalizationTest, InvalidScaleSize) {
+  OpTester test("QLinearLayerNormalization", 1, onnxruntime::kMSDomain);
+
+  std::vector<int64_t> dims = {2, 4};
+  test.AddInput<uint8_t>("X", dims, {100, 128, 150, 200, 0, 64, 255, 30});
+  test.AddInput<float>("X_scale", {}, {0.05f});
+  test.AddInput<uint8_t>("X_zero_point", {}, {128});
+  test.AddInput<float>("Scale", {3}, {1.0f, 0.5f, 2.0f});
+  test.AddInput<float>("Y_scale", {}, {0.02f});
+  test.AddInput<uint8_t>("Y_zero_point", {}, {128});
+  test.AddOutput<uint8_t>("Y", dims, {0, 0, 0, 0, 0, 0, 0, 0});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Size of Scale must match the size of the normalized dimensions");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
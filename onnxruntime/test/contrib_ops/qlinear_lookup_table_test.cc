@@ -115,5 +115,108 @@ TEST(QLinearLookupTableBasedOperatorTests, QLinearSigmoid_UInt8_0_Y_ZP) {
   run_test(true);
 }
 
+TEST(QLinearLookupTableBasedOperatorTests, QLinearGelu_Int8) {
+  OpTester test("QLinearGelu", 1, onnxruntime::kMSDomain);
+  float X_scale = 0.025f;
+  //int8_t X_zero_point = 0;
+  float Y_scale = 0.02f;
+  int8_t Y_zero_point = -100;
+
+  std::vector<int64_t> dims = {16};
+  test.AddInput<int8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, -128, -110, -108, -100, -16, -17, -18, -1});
+  test.AddInput<float>("X_scale", {}, {X_scale});
+  test.AddOptionalInputEdge<int8_t>();  // optional "X_zero_point" using default value here
+  test.AddInput<float>("Y_scale", {}, {Y_scale});
+  test.AddInput<int8_t>("Y_zero_point", {}, {Y_zero_point});
+  test.AddOutput<int8_t>("Y", dims, {-100, -87, -86, -85, -84, 11, 12, 59, -100, -100, -100, -101, -107, -107, -107, -101});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
+TEST(QLinearLookupTableBasedOperatorTests, QLinearGelu_UInt8) {
+  OpTester test("QLinearGelu", 1, onnxruntime::kMSDomain);
+  float X_scale = 0.025f;
+  uint8_t X_zero_point = 128;
+  float Y_scale = 0.02f;
+  uint8_t Y_zero_point = 20;
+
+  std::vector<int64_t> dims = {16};
+  test.AddInput<uint8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, 128, 136, 137, 138, 216, 217, 218, 255});
+  test.AddInput<float>("X_scale", {}, {X_scale});
+  test.AddInput<uint8_t>("X_zero_point", {}, {X_zero_point});
+  test.AddInput<float>("Y_scale", {}, {Y_scale});
+  test.AddInput<uint8_t>("Y_zero_point", {}, {Y_zero_point});
+  test.AddOutput<uint8_t>("Y", dims, {20, 20, 20, 20, 20, 12, 12, 19, 20, 26, 27, 27, 128, 130, 131, 179});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
+TEST(QLinearLookupTableBasedOperatorTests, QLinearUnary_Elu_UInt8) {
+  OpTester test("QLinearUnary", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("op_type", "Elu");
+  test.AddAttribute<float>("alpha", 0.5f);
+  float X_scale = 0.025f;
+  uint8_t X_zero_point = 128;
+  float Y_scale = 0.035f;
+  uint8_t Y_zero_point = 100;
+
+  std::vector<int64_t> dims = {16};
+  test.AddInput<uint8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, 128, 136, 137, 138, 216, 217, 218, 255});
+  test.AddInput<float>("X_scale", {}, {X_scale}, true);
+  test.AddInput<uint8_t>("X_zero_point", {}, {X_zero_point}, true);
+  test.AddInput<float>("Y_scale", {}, {Y_scale}, true);
+  test.AddInput<uint8_t>("Y_zero_point", {}, {Y_zero_point}, true);
+  test.AddOutput<uint8_t>("Y", dims, {86, 87, 87, 87, 87, 91, 91, 100, 100, 106, 106, 107, 163, 164, 164, 191});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
+TEST(QLinearLookupTableBasedOperatorTests, QLinearUnary_HardSwish_Int8) {
+  OpTester test("QLinearUnary", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("op_type", "HardSwish");
+  float X_scale = 0.05f;
+  float Y_scale = 0.045f;
+  int8_t Y_zero_point = -20;
+
+  std::vector<int64_t> dims = {16};
+  test.AddInput<int8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, -128, -110, -108, -100, -16, -17, -18, -1});
+  test.AddInput<float>("X_scale", {}, {X_scale});
+  test.AddOptionalInputEdge<int8_t>();  // optional "X_zero_point" using default value here
+  test.AddInput<float>("Y_scale", {}, {Y_scale});
+  test.AddInput<int8_t>("Y_zero_point", {}, {Y_zero_point});
+  test.AddOutput<int8_t>("Y", dims, {-20, -9, -8, -7, -6, 80, 81, 121, -20, -20, -20, -20, -27, -27, -27, -21});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
+TEST(QLinearLookupTableBasedOperatorTests, QLinearUnary_Softsign_UInt8) {
+  OpTester test("QLinearUnary", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("op_type", "Softsign");
+  float X_scale = 0.05f;
+  uint8_t X_zero_point = 128;
+  float Y_scale = 0.008f;
+  uint8_t Y_zero_point = 128;
+
+  std::vector<int64_t> dims = {16};
+  test.AddInput<uint8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, 128, 136, 137, 138, 216, 217, 218, 255});
+  test.AddInput<float>("X_scale", {}, {X_scale});
+  test.AddInput<uint8_t>("X_zero_point", {}, {X_zero_point});
+  test.AddInput<float>("Y_scale", {}, {Y_scale});
+  test.AddInput<uint8_t>("Y_zero_point", {}, {Y_zero_point});
+  test.AddOutput<uint8_t>("Y", dims, {20, 22, 22, 22, 22, 46, 47, 122, 128, 164, 167, 170, 230, 230, 230, 236});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(QLinearSoftmaxTest, UInt8_LastAxis) {
+  auto run_test = [](bool scales_and_zp_are_initializers) {
+    OpTester test("QLinearSoftmax", 1, onnxruntime::kMSDomain);
+    test.AddAttribute<int64_t>("axis", -1);
+    test.AddAttribute<int64_t>("opset", 13);
+
+    std::vector<int64_t> dims = {2, 4};
+    test.AddInput<uint8_t>("X", dims, {128, 138, 148, 118, 0, 255, 200, 100});
+    test.AddInput<float>("X_scale", {}, {0.1f}, scales_and_zp_are_initializers);
+    test.AddInput<uint8_t>("X_zero_point", {}, {128}, scales_and_zp_are_initializers);
+    test.AddInput<float>("Y_scale", {}, {1.0f / 256.0f}, scales_and_zp_are_initializers);
+    test.AddInput<uint8_t>("Y_zero_point", {}, {0}, scales_and_zp_are_initializers);
+    test.AddOutput<uint8_t>("Y", dims, {22, 61, 165, 8, 0, 255, 1, 0});
+    test.Run();
+  };
+
+  run_test(false);
+  run_test(true);
+}
+
+TEST(QLinearSoftmaxTest, Int8_SingleAxis) {
+  // normalized along axis 1 only
+  OpTester test("QLinearSoftmax", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddAttribute<int64_t>("opset", 13);
+
+  std::vector<int64_t> dims = {2, 3, 2};
+  test.AddInput<int8_t>("X", dims, {-10, 20, 5, -128, 127, 0, 30, 30, 30, -30, -60, 90});
+  test.AddInput<float>("X_scale", {}, {0.05f});
+  test.AddOptionalInputEdge<int8_t>();  // optional "X_zero_point" using default value here
+  test.AddInput<float>("Y_scale", {}, {1.0f / 256.0f});
+  test.AddInput<int8_t>("Y_zero_point", {}, {-128});
+  test.AddOutput<int8_t>("Y", dims, {-128, 59, -127, -128, 127, -59, -1, -116, -1, -127, -127, 115});
+  test.Run();
+}
+
+TEST(QLinearSoftmaxTest, Int8_CoercedTo2D) {
+  // before opset 13 the input is coerced into 2D at axis 1
+  OpTester test("QLinearSoftmax", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddAttribute<int64_t>("opset", 12);
+
+  std::vector<int64_t> dims = {2, 3, 2};
+  test.AddInput<int8_t>("X", dims, {-10, 20, 5, -128, 127, 0, 30, 30, 30, -30, -60, 90});
+  test.AddInput<float>("X_scale", {}, {0.05f});
+  test.AddOptionalInputEdge<int8_t>();  // optional "X_zero_point" using default value here
+  test.AddInput<float>("Y_scale", {}, {1.0f / 256.0f});
+  test.AddInput<int8_t>("Y_zero_point", {}, {-128});
+  test.AddOutput<int8_t>("Y", dims, {-128, -127, -127, -128, 126, -128, -117, -117, -117, -127, -128, 94});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
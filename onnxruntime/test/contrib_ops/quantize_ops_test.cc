@@ -40,6 +40,17 @@ TEST(DequantizeLinearOpTest, DequantizeLinear_per_tensor_float_int8) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// scalar zero & scale with int16
+TEST(DequantizeLinearOpTest, DequantizeLinear_per_tensor_float_int16) {
+  OpTester test("DequantizeLinear", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> dims{4};
+  test.AddInput<int16_t>("x", dims, {-30000, -3, 1000, 32767});
+  test.AddInput<float>("x_scale", {}, {0.5f});
+  test.AddInput<int16_t>("x_zero_point", {}, {-10});
+  test.AddOutput<float>("y", dims, {-14995.0f, 3.5f, 505.0f, 16388.5f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #ifdef USE_CUDA
 TEST(DequantizeLinearOpTest, DequantizeLinear_per_tensor_half_uint8) {
   OpTester test("DequantizeLinear", 1, onnxruntime::kMSDomain);
@@ -245,6 +256,29 @@ TEST(QuantizeLinearContribOpTest, QuantizeLinear_per_tensor_float_int8) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+TEST(QuantizeLinearContribOpTest, QuantizeLinear_per_tensor_float_int16) {
+  OpTester test("QuantizeLinear", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> dims{12};
+  test.AddInput<float>("x", dims, {
+                                      0.f, 2.f,            //
+                                      3.f, -3.f,           // rounding half to even
+                                      2.9f, -2.9f,         // low case
+                                      65532.f, -65536.f,   // critical point
+                                      65534.f, -65538.f,   // critical point
+                                      100000.f, -100000.f  // saturate case
+                                  });
+  test.AddInput<float>("y_scale", {}, {2.0f});
+  test.AddInput<int16_t>("y_zero_point", {}, {1});
+  test.AddOutput<int16_t>("y", dims,
+                          {1, 2,
+                           3, -1,
+                           2, 0,
+                           32767, -32767,
+                           32767, -32768,
+                           32767, -32768});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #ifdef USE_CUDA
 TEST(QuantizeLinearContribOpTest, QuantizeLinear_per_tensor_half_uint8) {
   OpTester test("QuantizeLinear", 1, onnxruntime::kMSDomain);
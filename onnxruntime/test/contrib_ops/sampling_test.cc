@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <random>
+#include "gtest/gtest.h"
+#include "contrib_ops/cpu/transformers/sampling.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::ArgMaxToken;
+using contrib::transformers::SampleTopKTopP;
+
+namespace {
+
+// Number of tokens kept by top-p filtering, computed by sorting the whole vocabulary.
+size_t ReferenceTopPCount(const std::vector<float>& scores, float top_p) {
+  std::vector<double> probabilities(scores.size());
+  double sum = 0.0;
+  for (size_t i = 0; i < scores.size(); i++) {
+    probabilities[i] = std::exp(static_cast<double>(scores[i]));
+    sum += probabilities[i];
+  }
+  std::sort(probabilities.begin(), probabilities.end(), std::greater<double>());
+
+  double cumulative = 0.0;
+  for (size_t i = 0; i < probabilities.size(); i++) {
+    if (cumulative >= top_p * sum) {
+      return i;
+    }
+    cumulative += probabilities[i];
+  }
+  return probabilities.size();
+}
+
+}  // namespace
+
+TEST(SamplingTest, ArgMaxToken) {
+  std::vector<float> scores{0.5f, 2.0f, -1.0f, 2.0f, 1.5f};
+  EXPECT_EQ(ArgMaxToken(scores), 1);
+
+  scores[4] = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(ArgMaxToken(scores), 4);
+}
+
+TEST(SamplingTest, TopK) {
+  std::default_random_engine data_generator(3);
+  std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+  std::vector<float> scores(1000);
+  for (auto& score : scores) {
+    score = distribution(data_generator);
+  }
+
+  // Place the top 3 tokens with known probabilities.
+  scores[10] = 10.0f;
+  scores[500] = 10.0f + std::log(2.0f);
+  scores[999] = 10.0f + std::log(3.0f);
+
+  std::vector<std::pair<float, int32_t>> candidates;
+  std::mt19937 generator(7);
+
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(SampleTopKTopP(scores, 1.0f, 1, 1.0f, 1, candidates, generator), 999);
+  }
+
+  constexpr int kSamples = 12000;
+  std::map<int32_t, int> counts;
+  for (int i = 0; i < kSamples; i++) {
+    counts[SampleTopKTopP(scores, 1.0f, 3, 1.0f, 1, candidates, generator)]++;
+  }
+  ASSERT_EQ(counts.size(), 3u);
+  EXPECT_NEAR(counts[10] / static_cast<double>(kSamples), 1.0 / 6.0, 0.02);
+  EXPECT_NEAR(counts[500] / static_cast<double>(kSamples), 2.0 / 6.0, 0.02);
+  EXPECT_NEAR(counts[999] / static_cast<double>(kSamples), 3.0 / 6.0, 0.02);
+
+  // Temperature 0.5 squares the unnormalized probabilities: 1, 4 and 9.
+  counts.clear();
+  for (int i = 0; i < kSamples; i++) {
+    counts[SampleTopKTopP(scores, 0.5f, 3, 1.0f, 1, candidates, generator)]++;
+  }
+  ASSERT_EQ(counts.size(), 3u);
+  EXPECT_NEAR(counts[10] / static_cast<double>(kSamples), 1.0 / 14.0, 0.02);
+  EXPECT_NEAR(counts[999] / static_cast<double>(kSamples), 9.0 / 14.0, 0.02);
+}
+
+TEST(SamplingTest, TopP) {
+  // Probabilities decrease slowly, so top-p filtering keeps more tokens than the first chunk of candidates.
+  std::vector<float> scores(5000);
+  for (size_t i = 0; i < scores.size(); i++) {
+    scores[(i * 7919) % scores.size()] = -0.001f * static_cast<float>(i);
+  }
+
+  std::vector<std::pair<float, int32_t>> candidates;
+  std::mt19937 generator(5);
+
+  for (float top_p : {0.1f, 0.3f, 0.8f}) {
+    const size_t expected = ReferenceTopPCount(scores, top_p);
+    ASSERT_GT(expected, 64u);
+
+    // The kept tokens have scores above the score of the first removed token.
+    const float min_score = -0.001f * static_cast<float>(expected) + 0.0005f;
+    int32_t lowest = -1;
+    for (int i = 0; i < 2000; i++) {
+      int32_t token = SampleTopKTopP(scores, 1.0f, 0, top_p, 1, candidates, generator);
+      ASSERT_GT(scores[token], min_score) << "top_p " << top_p;
+      if (lowest < 0 || scores[token] < scores[lowest]) {
+        lowest = token;
+      }
+    }
+
+    // Tokens close to the boundary are sampled.
+    EXPECT_LT(scores[lowest], min_score + 0.001f * 0.1f * static_cast<float>(expected)) << "top_p " << top_p;
+  }
+
+  // A small top_p keeps the most probable token, or min_tokens_to_keep tokens.
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(SampleTopKTopP(scores, 1.0f, 0, 1e-6f, 1, candidates, generator), 0);
+    int32_t token = SampleTopKTopP(scores, 1.0f, 0, 1e-6f, 2, candidates, generator);
+    EXPECT_TRUE(token == 0 || token == 7919 % 5000);
+  }
+
+  // Top-k filtering is applied before top-p filtering.
+  for (int i = 0; i < 20; i++) {
+    int32_t token = SampleTopKTopP(scores, 1.0f, 100, 0.5f, 1, candidates, generator);
+    EXPECT_GT(scores[token], -0.001f * 50.5f);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
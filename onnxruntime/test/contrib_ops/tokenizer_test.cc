@@ -677,6 +677,42 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }  // namespace test
 
+TEST(ContribOpTest, TokenizerWithSeparators_LiteralAndRegexSeparatorsNC) {
+  // A plain text separator followed by a regular expression one
+  // over several rows, some of which produce no tokens at all.
+  // [N][C] dimensions
+  // Output [N][C][D]
+  std::vector<std::string> separators = {
+      u8" ",
+      u8"[,.]+"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 2);
+
+  std::vector<int64_t> dims{2, 2};
+  std::vector<std::string> input{u8"the quick, brown", u8"fox.. jumps over", u8"a b", u8""};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(3));
+  std::vector<std::string> output{
+      u8"the",
+      u8"quick",
+      u8"brown",
+      u8"fox",
+      u8"jumps",
+      u8"over",
+      padval,
+      padval,
+      padval,
+      padval,
+      padval,
+      padval};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, TokenizerExpression_RegEx) {
   OpTester test("Tokenizer", opset_ver, domain);
   const std::string tokenexp(u8"a.");
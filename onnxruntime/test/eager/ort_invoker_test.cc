@@ -79,6 +79,68 @@ TEST(InvokerTest, Inplace) {
   }
 }
 
+TEST(InvokerTest, KernelCache) {
+  std::unique_ptr<IExecutionProvider> cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  const std::string logger_id{"InvokerTest"};
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<logging::ISink>{new logging::CLogSink{}},
+      logging::Severity::kVERBOSE, false,
+      logging::LoggingManager::InstanceType::Default,
+      &logger_id);
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+  IOnnxRuntimeOpSchemaRegistryList tmp_op_registry = {};
+  ORTInvoker kernel_invoker(std::move(cpu_execution_provider), env->GetLoggingManager()->DefaultLogger(), tmp_op_registry);
+  auto allocator = kernel_invoker.GetCurrentExecutionProvider().GetAllocator(0, OrtMemTypeDefault);
+
+  // the kernel of the first invocation is reused for inputs of other shapes and values
+  for (int64_t rows : {3, 5, 3}) {
+    std::vector<int64_t> dims = {rows, 2};
+    std::vector<float> values(static_cast<size_t>(rows * 2));
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = static_cast<float>(i);
+    }
+    OrtValue A, B;
+    CreateMLValue<float>(allocator, dims, values, &A);
+    CreateMLValue<float>(allocator, dims, values, &B);
+    std::vector<OrtValue> result(1);
+    ASSERT_STATUS_OK(kernel_invoker.Invoke("Mul", {A, B}, result, nullptr));
+    const Tensor& C = result.back().Get<Tensor>();
+    EXPECT_EQ(C.Shape().GetDims(), gsl::make_span(dims));
+    for (size_t i = 0; i < values.size(); ++i) {
+      EXPECT_EQ(C.Data<float>()[i], values[i] * values[i]);
+    }
+  }
+  EXPECT_EQ(kernel_invoker.GetKernelCacheSize(), static_cast<size_t>(1));
+
+  // other attributes need another kernel
+  std::vector<int64_t> dims = {2, 3};
+  std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue X;
+  CreateMLValue<float>(allocator, dims, values, &X);
+  for (int64_t axis : {0, 1, 0}) {
+    NodeAttributes attributes;
+    ONNX_NAMESPACE::AttributeProto axis_attribute;
+    axis_attribute.set_name("axis");
+    axis_attribute.set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+    axis_attribute.set_i(axis);
+    attributes["axis"] = axis_attribute;
+    std::vector<OrtValue> result(1);
+    ASSERT_STATUS_OK(kernel_invoker.Invoke("Flatten", {X}, result, &attributes));
+    const std::vector<int64_t> expected_dims = axis == 0 ? std::vector<int64_t>{1, 6} : std::vector<int64_t>{2, 3};
+    EXPECT_EQ(result.back().Get<Tensor>().Shape().GetDims(), gsl::make_span(expected_dims));
+  }
+  EXPECT_EQ(kernel_invoker.GetKernelCacheSize(), static_cast<size_t>(3));
+
+  // the least recently used kernels are evicted
+  kernel_invoker.SetKernelCacheCapacity(1);
+  EXPECT_EQ(kernel_invoker.GetKernelCacheSize(), static_cast<size_t>(1));
+  kernel_invoker.SetKernelCacheCapacity(0);
+  std::vector<OrtValue> result(1);
+  ASSERT_STATUS_OK(kernel_invoker.Invoke("Relu", {X}, result, nullptr));
+  EXPECT_EQ(kernel_invoker.GetKernelCacheSize(), static_cast<size_t>(0));
+}
+
 class TestKernel final : public OpKernel {
  public:
   TestKernel(const OpKernelInfo& info) : OpKernel(info) {}
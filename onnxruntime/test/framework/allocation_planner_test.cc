@@ -140,15 +140,19 @@ typedef std::unordered_map<const onnxruntime::NodeArg*, TensorShapeProto*> Shape
 
 class SequentialPlannerTestContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerTestContext(ShapeMap* shape_map) : shape_map_(shape_map) {}
+  SequentialPlannerTestContext(ShapeMap* shape_map, ExecutionOrder execution_order = ExecutionOrder::DEFAULT)
+      : shape_map_(shape_map), execution_order_(execution_order) {}
 
   TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     auto iter = shape_map_->find(&arg);
     return (shape_map_->end() != iter) ? iter->second : nullptr;
   }
 
+  ExecutionOrder GetExecutionOrder() const override { return execution_order_; }
+
  private:
   ShapeMap* shape_map_;
+  ExecutionOrder execution_order_;
 };
 
 class PlannerTest : public ::testing::Test {
@@ -166,7 +170,11 @@ class PlannerTest : public ::testing::Test {
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;               // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;          // a unary kernel with in-place
   std::unique_ptr<::onnxruntime::KernelDef> external_outputs_kernel_;  // an unary kernel with external outputs
-#ifdef ENABLE_TRAINING
+  std::unique_ptr<::onnxruntime::KernelDef> unary_elementwise_kernel_;  // an elementwise kernel without in-place
+  std::unique_ptr<::onnxruntime::KernelDef> binary_elementwise_kernel_;
+  std::unique_ptr<::onnxruntime::KernelDef> concat_kernel_;
+  std::unique_ptr<::onnxruntime::KernelDef> split_kernel_;
+#ifdef ENABLE_STRIDED_TENSORS
   std::unique_ptr<::onnxruntime::KernelDef> may_strided_input_kernel_;   // an uinary kernel with may_strided_input
   std::unique_ptr<::onnxruntime::KernelDef> may_strided_output_kernel_;  // an unary kernel with may_strided_output
 #endif
@@ -181,10 +189,12 @@ class PlannerTest : public ::testing::Test {
   profiling::Profiler profiler_;
   std::unique_ptr<SessionState> state_;
   ShapeMap shape_map_;
+  ExecutionOrder execution_order_ = ExecutionOrder::DEFAULT;
   std::unique_ptr<SequentialExecutionPlan> plan_;
 
  public:
-  PlannerTest()
+  explicit PlannerTest(std::unique_ptr<IExecutionProvider> execution_provider =
+                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo()))
       : model_("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 10}}, {}, DefaultLoggingManager().DefaultLogger()),
         graph_(model_.MainGraph()),
         tp_(concurrency::CreateThreadPool(&onnxruntime::Env::Default(), OrtThreadPoolParams(),
@@ -194,7 +204,13 @@ class PlannerTest : public ::testing::Test {
         KernelDefBuilder().SetName("Relu").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayInplace(0, 0).Build();
     external_outputs_kernel_ =
         KernelDefBuilder().SetName("Tanh").Provider(kCpuExecutionProvider).SinceVersion(1, 10).ExternalOutputs().Build();
-#ifdef ENABLE_TRAINING
+    unary_elementwise_kernel_ =
+        KernelDefBuilder().SetName("Sqrt").Provider(kCpuExecutionProvider).SinceVersion(6, 10).Build();
+    binary_elementwise_kernel_ =
+        KernelDefBuilder().SetName("Add").Provider(kCpuExecutionProvider).SinceVersion(7, 10).Build();
+    concat_kernel_ = KernelDefBuilder().SetName("Concat").Provider(kCpuExecutionProvider).SinceVersion(4, 10).Build();
+    split_kernel_ = KernelDefBuilder().SetName("Split").Provider(kCpuExecutionProvider).SinceVersion(2, 10).Build();
+#ifdef ENABLE_STRIDED_TENSORS
     may_strided_input_kernel_ = KernelDefBuilder()
                                     .SetName("Abs")
                                     .Provider(kCpuExecutionProvider)
@@ -208,8 +224,6 @@ class PlannerTest : public ::testing::Test {
                                      .MayStridedOutput(0, 0)
                                      .Build();
 #endif
-    CPUExecutionProviderInfo epi;
-    auto execution_provider = std::make_unique<CPUExecutionProvider>(epi);
     ORT_THROW_IF_ERROR(execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider)));
 
     state_.reset(new SessionState(graph_, execution_providers_, false, tp_.get(), nullptr, dtm_,
@@ -231,6 +245,32 @@ class PlannerTest : public ::testing::Test {
     return p_node;
   }
 
+  onnxruntime::Node* AddNode(::onnxruntime::KernelDef& kernel_def, const std::vector<std::string>& inputs,
+                             const std::vector<std::string>& outputs) {
+    std::vector<onnxruntime::NodeArg*> input_args;
+    std::vector<onnxruntime::NodeArg*> output_args;
+    for (auto& input : inputs) input_args.push_back(Arg(input));
+    for (auto& output : outputs) output_args.push_back(Arg(output));
+
+    auto* p_node = &graph_.AddNode("node" + std::to_string(NodeCounter::Next()), kernel_def.OpName(), "test op",
+                                   input_args, output_args);
+    p_node->SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+    kernel_bindings_.emplace_back(p_node, kernel_def);
+    return p_node;
+  }
+
+  onnxruntime::Node* AddConcatNode(const std::vector<std::string>& inputs, std::string& output, int64_t axis) {
+    auto* p_node = AddNode(*concat_kernel_, inputs, {output});
+    p_node->AddAttribute("axis", axis);
+    return p_node;
+  }
+
+  onnxruntime::Node* AddSplitNode(std::string& input, const std::vector<std::string>& outputs, int64_t axis) {
+    auto* p_node = AddNode(*split_kernel_, {input}, outputs);
+    p_node->AddAttribute("axis", axis);
+    return p_node;
+  }
+
   onnxruntime::Node* AddNormalNode(std::string& input, std::string& output) {
     return AddNode(*std_kernel_, input, output);
   }
@@ -243,7 +283,15 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*external_outputs_kernel_, input, output);
   }
 
-#ifdef ENABLE_TRAINING
+  onnxruntime::Node* AddUnaryElementwiseNode(std::string& input, std::string& output) {
+    return AddNode(*unary_elementwise_kernel_, input, output);
+  }
+
+  onnxruntime::Node* AddBinaryElementwiseNode(const std::vector<std::string>& inputs, std::string& output) {
+    return AddNode(*binary_elementwise_kernel_, inputs, {output});
+  }
+
+#ifdef ENABLE_STRIDED_TENSORS
   onnxruntime::Node* AddMayStridedInputNode(std::string& input, std::string& output) {
     return AddNode(*may_strided_input_kernel_, input, output);
   }
@@ -251,6 +299,12 @@ class PlannerTest : public ::testing::Test {
   onnxruntime::Node* AddMayStridedOutputNode(std::string& input, std::string& output) {
     return AddNode(*may_strided_output_kernel_, input, output);
   }
+
+  void CheckStrided(const std::string& name, bool is_strided_tensor) {
+    int id;
+    index(name, id);
+    EXPECT_EQ(plan_->allocation_plan[id].is_strided_tensor, is_strided_tensor) << "Error in strided flag for " << name;
+  }
 #endif
 
   void BindKernel(onnxruntime::Node* p_node, ::onnxruntime::KernelDef& kernel_def, KernelRegistry* reg,
@@ -276,6 +330,8 @@ class PlannerTest : public ::testing::Test {
 
   void SetShape(std::string& name, TensorShapeProto* shape) { shape_map_[Arg(name)] = shape; }
 
+  void SetExecutionOrder(ExecutionOrder execution_order) { execution_order_ = execution_order; }
+
   void SetShape(std::initializer_list<std::pair<std::string&, TensorShapeProto*>> shapes) {
     for (auto& pair : shapes) {
       SetShape(pair.first, pair.second);
@@ -304,7 +360,7 @@ class PlannerTest : public ::testing::Test {
     status = state_->FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, {}, nullptr, remove_initializers);
 
     EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
-    SequentialPlannerTestContext test_context(&shape_map_);
+    SequentialPlannerTestContext test_context(&shape_map_, execution_order_);
 
     status = SequentialPlanner::CreatePlan(nullptr, GraphViewer(graph_), outer_scope_node_args, execution_providers_,
                                            kernel_create_info_map, {}, {}, state_->GetOrtValueNameIdxMap(), test_context,
@@ -320,6 +376,17 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckSlice(const std::string& name, const std::string& buffer, size_t offset) {
+    int id;
+    int buffer_id;
+    index(name, id);
+    index(buffer, buffer_id);
+    const auto& value_plan = plan_->allocation_plan[id];
+    EXPECT_EQ(value_plan.alloc_kind, AllocKind::kSlice) << "Error in allocation kind for " << name;
+    EXPECT_EQ(value_plan.reused_buffer, buffer_id) << "Error in buffer of slice " << name;
+    EXPECT_EQ(value_plan.slice_offset, offset) << "Error in offset of slice " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // create set and check equality
     std::unordered_set<int> expected;
@@ -447,6 +514,38 @@ TEST_F(PlannerTest, InPlaceTest) {
   CheckFreed(2, {X2});
 }
 
+// InferredInPlaceTest: Check that elementwise kernels without MayInplace write over their inputs.
+TEST_F(PlannerTest, InferredInPlaceTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);                   // no in-place operator; X1: input; X2: temporary
+  AddUnaryElementwiseNode(X2, X3);         // elementwise operator; X3: temporary
+  AddBinaryElementwiseNode({X1, X3}, X4);  // elementwise operator; X4: temporary
+  AddNormalNode(X4, X5);                   // no in-place operator; X5: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+
+  // check each ml-value is freed at appropriate step
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {});
+  CheckFreed(3, {X2});
+}
+
 TEST_F(PlannerTest, ExternalOutputsTest) {
   // tensor variables:
   std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
@@ -476,7 +575,7 @@ TEST_F(PlannerTest, ExternalOutputsTest) {
   CheckFreed(2, {X3});
 }
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_STRIDED_TENSORS
 TEST_F(PlannerTest, MayStridedTest1) {
   // tensor variables:
   std::string X1("X1"), X2("X2"), X3("X3");
@@ -524,6 +623,7 @@ TEST_F(PlannerTest, MayStridedTest2) {
   CheckAllocKind(X2, AllocKind::kReuse);
   CheckAllocKind(X3, AllocKind::kAllocateOutput);
   CheckAllocKind(X4, AllocKind::kAllocateOutput);
+  CheckStrided(X2, true);
 
   // check each ml-value is freed at appropriate step
   // X2 will not be reused and will not be freed. X3 will be allocated and will be freed.
@@ -553,6 +653,7 @@ TEST_F(PlannerTest, MayStridedTest3) {
   CheckAllocKind(X2, AllocKind::kAllocate);
   CheckAllocKind(X3, AllocKind::kAllocateOutput);
   CheckAllocKind(X4, AllocKind::kAllocateOutput);
+  CheckStrided(X2, false);
 
   // check each ml-value is freed at appropriate step
   // X2 will not be reused and will not be freed. X3 will be allocated and will be freed.
@@ -597,6 +698,191 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+TEST_F(PlannerTest, ConcatInputsInPlaceTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);           // X2: written in place into X4
+  AddNormalNode(X1, X3);           // X3: written in place into X4
+  AddConcatNode({X2, X3}, X4, 1);  // X4: temporary, allocated with X2
+  AddNormalNode(X4, X5);           // X5: output
+
+  // simulate shape-inference results:
+  Shape shape1w{1, 2, 3};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{1, 4, 3};
+  auto shape2 = &shape2w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape1}, {X4, shape2}, {X5, shape2}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckSlice(X2, X4, 0);
+  CheckSlice(X3, X4, 2 * 3 * sizeof(float));
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+
+  // X4 lives from the first step, where X2 is written into it
+  int X4_id;
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X4, X4_id));
+  EXPECT_EQ(GetPlan().allocation_plan[X4_id].program_counter.Starts().front(), 0u);
+
+  // check each ml-value is freed at appropriate step
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {});
+  CheckFreed(3, {X4});
+}
+
+TEST_F(PlannerTest, ConcatInputsNotContiguousTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);
+  AddNormalNode(X1, X3);
+  AddConcatNode({X2, X3}, X4, 2);  // the rows of X2 and X3 interleave in X4
+  AddNormalNode(X4, X5);
+
+  // simulate shape-inference results:
+  Shape shape1w{1, 2, 3};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{1, 2, 6};
+  auto shape2 = &shape2w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape1}, {X4, shape2}, {X5, shape2}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+}
+
+// MemoryEfficientOrderTest: Check that a large temporary is consumed before the next one is produced.
+TEST_F(PlannerTest, MemoryEfficientOrderTest) {
+  // tensor variables:
+  std::string X1("X1"), A1("A1"), A2("A2"), B1("B1"), B2("B2"), Y("Y");
+
+  // graph structure:
+  AddNormalNode(X1, A1);          // A1: large temporary
+  AddNormalNode(X1, B1);          // B1: large temporary
+  AddNormalNode(A1, A2);          // A2: small temporary
+  AddNormalNode(B1, B2);          // B2: small temporary
+  AddConcatNode({A2, B2}, Y, 0);  // Y: output
+
+  // simulate shape-inference results:
+  Shape small_shape_w{1};
+  auto small_shape = &small_shape_w.value;
+  Shape large_shape_w{100};
+  auto large_shape = &large_shape_w.value;
+  Shape output_shape_w{2};
+  auto output_shape = &output_shape_w.value;
+  SetShape({{X1, small_shape}, {A1, large_shape}, {B1, large_shape}, {A2, small_shape}, {B2, small_shape},
+            {Y, output_shape}});
+
+  SetExecutionOrder(ExecutionOrder::MEMORY_EFFICIENT);
+  CreatePlan();
+
+  // each large temporary is consumed right after it is produced
+  const auto& execution_plan = GetPlan().execution_plan;
+  ASSERT_EQ(execution_plan.size(), 5u);
+  for (size_t step : {0, 2}) {
+    const Node* producer = GetGraph().GetNode(execution_plan[step].node_index);
+    const Node* consumer = GetGraph().GetNode(execution_plan[step + 1].node_index);
+    EXPECT_EQ(consumer->InputDefs()[0], producer->OutputDefs()[0]) << "Error in execution order at step " << step;
+  }
+
+  // at most one large temporary and the two small ones are live
+  EXPECT_EQ(GetPlan().estimated_peak_activation_bytes, (100 + 1 + 1) * sizeof(float));
+}
+
+// A CPU provider with a second compute queue, for the planner to assign independent branches to
+class MultiStreamCPUExecutionProvider : public CPUExecutionProvider {
+ public:
+  MultiStreamCPUExecutionProvider() : CPUExecutionProvider(CPUExecutionProviderInfo()) {}
+  std::vector<int> GetComputeQueueIds() const override { return {0, 3}; }
+};
+
+class MultiStreamPlannerTest : public PlannerTest {
+ public:
+  MultiStreamPlannerTest() : PlannerTest(std::make_unique<MultiStreamCPUExecutionProvider>()) {}
+};
+
+TEST_F(MultiStreamPlannerTest, StreamAssignmentTest) {
+  // tensor variables:
+  std::string X("X"), Y1("Y1"), Y2("Y2"), Z1("Z1"), Z2("Z2"), Z3("Z3");
+
+  // graph structure:
+  auto* node_a = AddNormalNode(X, Y1);
+  auto* node_b = AddNormalNode(X, Y2);
+  auto* node_add = AddBinaryElementwiseNode({Y1, Y2}, Z1);
+  auto* node_c = AddNormalNode(Z1, Z2);
+  auto* node_d = AddNormalNode(Z2, Z3);
+
+  // simulate shape-inference results:
+  Shape shape_w{1, 2, 3};
+  auto shape = &shape_w.value;
+  SetShape({{X, shape}, {Y1, shape}, {Y2, shape}, {Z1, shape}, {Z2, shape}, {Z3, shape}});
+
+  CreatePlan();
+
+  // the independent branches run on different queues, the chain continues the queue of its producer
+  const auto& plan = GetPlan();
+  ASSERT_TRUE(plan.IsMultiStream());
+  EXPECT_EQ(plan.node_queue_ids[node_a->Index()], 0);
+  EXPECT_EQ(plan.node_queue_ids[node_b->Index()], 3);
+  EXPECT_EQ(plan.node_queue_ids[node_add->Index()], 0);
+  EXPECT_EQ(plan.node_queue_ids[node_c->Index()], 0);
+  EXPECT_EQ(plan.node_queue_ids[node_d->Index()], 0);
+
+  // the values crossing queues are fenced
+  int x_id, y1_id, y2_id;
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X, x_id));
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(Y1, y1_id));
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(Y2, y2_id));
+  EXPECT_TRUE(plan.allocation_plan[x_id].create_fence_if_async);
+  EXPECT_TRUE(plan.allocation_plan[y2_id].create_fence_if_async);
+  EXPECT_FALSE(plan.allocation_plan[y1_id].create_fence_if_async);
+  EXPECT_TRUE(plan.NodeHasFence(node_add->Index()));
+
+  // the buffer of a value used on both queues is not reused
+  for (const auto& value_plan : plan.allocation_plan) {
+    if (value_plan.alloc_kind == AllocKind::kReuse) {
+      EXPECT_NE(value_plan.reused_buffer, y2_id);
+    }
+  }
+}
+
+TEST_F(PlannerTest, SplitOutputsViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6");
+
+  // graph structure:
+  AddNormalNode(X1, X2);          // X2: temporary
+  AddSplitNode(X2, {X3, X4}, 0);  // X3, X4: views of X2
+  AddNormalNode(X3, X5);          // X5: output
+  AddNormalNode(X4, X6);          // X6: output
+
+  // simulate shape-inference results:
+  Shape shape1w{4, 3};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{2, 3};
+  auto shape2 = &shape2w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape2}, {X4, shape2}, {X5, shape2}, {X6, shape2}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckSlice(X3, X2, 0);
+  CheckSlice(X4, X2, 2 * 3 * sizeof(float));
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+  CheckAllocKind(X6, AllocKind::kAllocateOutput);
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -3,6 +3,9 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/allocator.h"
+#include "core/framework/huge_page_allocator.h"
+#include "core/framework/numa_allocator.h"
+#include "core/mlas/inc/mlas.h"
 
 #include "test_utils.h"
 #include "gtest/gtest.h"
@@ -103,5 +106,43 @@ TEST(AllocatorTest, TestOverflowChecks) {
   EXPECT_TRUE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size - (kAllocAlignment / num_elements), &size));
   EXPECT_FALSE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size, &size));
 }
+
+TEST(AllocatorTest, HugePageCPUAllocatorTest) {
+  HugePageCPUAllocator allocator;
+  ASSERT_STREQ(allocator.Info().name, CPU);
+
+  const size_t huge_page_size = HugePageCPUAllocator::GetHugePageSize();
+  // small allocations use the default allocator, large ones are mapped if huge pages are supported
+  for (size_t size : {size_t{1024}, std::max<size_t>(huge_page_size, 1024) * 3 + 17}) {
+    auto* bytes = static_cast<uint8_t*>(allocator.Alloc(size));
+    ASSERT_NE(bytes, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(bytes) % MlasGetPreferredBufferAlignment(), 0u);
+
+    // the whole buffer is writable
+    memset(bytes, 0x5a, size);
+    EXPECT_EQ(bytes[0], 0x5a);
+    EXPECT_EQ(bytes[size - 1], 0x5a);
+    allocator.Free(bytes);
+  }
+
+  allocator.Free(nullptr);
+}
+
+TEST(AllocatorTest, NumaCPUAllocatorTest) {
+  // node 0 exists on any machine, even without NUMA support
+  NumaCPUAllocator allocator(0);
+  EXPECT_EQ(allocator.GetNumaNode(), 0);
+
+  for (size_t size : {size_t{1024}, NumaCPUAllocator::kMinMappedSize * 5 + 3}) {
+    auto* bytes = static_cast<uint8_t*>(allocator.Alloc(size));
+    ASSERT_NE(bytes, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(bytes) % MlasGetPreferredBufferAlignment(), 0u);
+
+    memset(bytes, 0x5a, size);
+    EXPECT_EQ(bytes[size - 1], 0x5a);
+    allocator.Free(bytes);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -4,7 +4,11 @@
 #include "core/framework/bfc_arena.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include "test/util/include/asserts.h"
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -298,5 +302,182 @@ TEST(BFCArenaTest, TestBackoffDoesntHang) {
   BFCArena a(std::unique_ptr<IAllocator>(new BadAllocator()), 10 * 1024 * 1024);
   EXPECT_THROW(a.Alloc(1024), OnnxRuntimeException) << "Arena should be unable to allocate memory";
 }
+
+TEST(BFCArenaTest, ThreadCacheReusesFreedChunks) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY, BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK, BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             1 << 20);
+
+  void* first_ptr = a.Alloc(1000);
+  a.Free(first_ptr);
+
+  // the freed chunk is parked in the thread cache and handed out again
+  void* second_ptr = a.Alloc(1000);
+  EXPECT_EQ(first_ptr, second_ptr);
+
+  // a request from a different bin can't be served by the cache
+  void* third_ptr = a.Alloc(64 * 1024);
+  EXPECT_NE(second_ptr, third_ptr);
+
+  a.Free(second_ptr);
+  a.Free(third_ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_thread_cache_misses, 2);
+  EXPECT_EQ(stats.num_allocs, 2);
+
+  // cached chunks are still in use from the point of view of the arena
+  EXPECT_EQ(stats.bytes_in_use, 1024 + 64 * 1024);
+}
+
+TEST(BFCArenaTest, ThreadCacheFlushesToSharedBins) {
+  const int max_cache_bytes = 16 * 1024;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY, BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK, BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             max_cache_bytes);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 64; i++) {
+    ptrs.push_back(a.Alloc(1024));
+  }
+
+  for (void* ptr : ptrs) {
+    a.Free(ptr);
+  }
+
+  // once the cache overflows half of it is returned to the shared bins
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_LE(stats.bytes_in_use, max_cache_bytes);
+  EXPECT_GT(stats.bytes_in_use, 0);
+
+  // chunks larger than the cache bypass it
+  void* large_ptr = a.Alloc(max_cache_bytes * 2);
+  a.Free(large_ptr);
+  AllocatorStats stats_after_large;
+  a.GetStats(&stats_after_large);
+  EXPECT_EQ(stats_after_large.bytes_in_use, stats.bytes_in_use);
+
+  ASSERT_STATUS_OK(a.Shrink());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheConcurrentAllocAndFree) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY, BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK, BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             64 * 1024);
+
+  // pointers allocated by the main thread and freed by a worker exercise the cross-thread path
+  std::vector<void*> shared_ptrs;
+  for (int i = 0; i < 32; i++) {
+    shared_ptrs.push_back(a.Alloc(512));
+  }
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; t++) {
+    workers.emplace_back([&a, &shared_ptrs, t]() {
+      if (t == 0) {
+        for (void* ptr : shared_ptrs) {
+          a.Free(ptr);
+        }
+      }
+
+      for (int iteration = 0; iteration < 1000; iteration++) {
+        size_t size = 256 + (iteration % 16) * 256;
+        void* ptr = a.Alloc(size);
+        ASSERT_NE(ptr, nullptr);
+        memset(ptr, t, size);
+        a.Free(ptr);
+      }
+    });
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // the caches of the exited threads have been returned to the arena
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.num_thread_cache_hits + stats.num_thread_cache_misses, 32 + 4 * 1000);
+  EXPECT_GT(stats.num_thread_cache_hits, 0);
+}
+
+TEST(BFCArenaTest, IdleShrinkReleasesRegionsAboveHighWaterMark) {
+  constexpr int kIdleTimeMs = 100;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             ArenaExtendStrategy::kSameAsRequested, BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK, BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_THREAD_LOCAL_CACHE_BYTES, kIdleTimeMs);
+
+  // a burst that needs one region per allocation
+  constexpr size_t kRegionSize = 1 << 20;
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 4; i++) {
+    ptrs.push_back(a.Alloc(kRegionSize));
+  }
+
+  for (size_t i = 1; i < ptrs.size(); i++) {
+    a.Free(ptrs[i]);
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  const int64_t peak_total_allocated_bytes = stats.total_allocated_bytes;
+  EXPECT_EQ(stats.num_arena_extensions, 4);
+
+  // the burst is the high-water mark of the window that passed, so nothing is released yet
+  std::this_thread::sleep_for(std::chrono::milliseconds(kIdleTimeMs * 3 / 2));
+  a.Free(a.Alloc(256));
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, peak_total_allocated_bytes);
+  EXPECT_EQ(stats.num_idle_shrinkages, 0);
+
+  // only ptrs[0] was in use during the next window
+  std::this_thread::sleep_for(std::chrono::milliseconds(kIdleTimeMs * 3 / 2));
+  a.Free(a.Alloc(256));
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_idle_shrinkages, 1);
+  EXPECT_GE(stats.total_allocated_bytes, static_cast<int64_t>(kRegionSize));
+  EXPECT_LT(stats.total_allocated_bytes, 2 * static_cast<int64_t>(kRegionSize));
+  EXPECT_EQ(stats.total_idle_shrunk_bytes, peak_total_allocated_bytes - stats.total_allocated_bytes);
+
+  // the region in use is kept
+  memset(ptrs[0], 0, kRegionSize);
+  a.Free(ptrs[0]);
+}
+
+TEST(BFCArenaTest, FreezeLimitsArenaToItsAllocatedMemory) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+
+  // the warm-up
+  constexpr size_t kRegionSize = 1 << 20;
+  a.Free(a.Alloc(kRegionSize));
+
+  a.Freeze();
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_limit, stats.total_allocated_bytes);
+
+  // allocations that fit in the existing regions still work
+  void* p = a.Alloc(kRegionSize / 2);
+  EXPECT_NE(p, nullptr);
+  a.Free(p);
+
+  EXPECT_THROW(a.Alloc(kRegionSize * 2), OnnxRuntimeException) << "A frozen arena should not be extended";
+
+  // a region freed by shrinking can be allocated again
+  ASSERT_STATUS_OK(a.Shrink());
+  p = a.Alloc(kRegionSize);
+  EXPECT_NE(p, nullptr);
+  a.Free(p);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <sstream>
+#include <thread>
+
+#include "core/graph/model.h"
+#include "core/session/dynamic_batcher.h"
+#include "core/session/inference_session.h"
+#include "gtest/gtest.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y = X * X, with no shape on X so any batch size is accepted
+void LoadSquareModel(InferenceSession& session) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 7;
+  Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+              std::vector<FunctionProto>(), DefaultLoggingManager().DefaultLogger(), ModelOptions(true, true));
+  Graph& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("node1", "Mul", "Mul", {&x, &x}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  std::stringstream model_stream(serialized);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+struct BatcherRequest {
+  std::vector<int64_t> dims;
+  std::vector<float> values;
+  std::vector<OrtValue> fetches;
+  Status status;
+};
+
+void RunConcurrently(DynamicBatcher& batcher, std::vector<BatcherRequest>& requests) {
+  std::vector<std::thread> threads;
+  for (auto& request : requests) {
+    threads.emplace_back([&batcher, &request]() {
+      OrtValue x;
+      CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), request.dims,
+                           request.values, &x);
+      NameMLValMap feeds{{"X", x}};
+      request.status = batcher.Run(feeds, {"Y"}, request.fetches);
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void VerifySquared(const BatcherRequest& request, const std::vector<int64_t>& expected_dims,
+                   const std::vector<float>& expected_values) {
+  ASSERT_STATUS_OK(request.status);
+  ASSERT_EQ(request.fetches.size(), 1u);
+  const Tensor& y = request.fetches[0].Get<Tensor>();
+  ASSERT_EQ(y.Shape(), TensorShape(expected_dims));
+  std::vector<float> values(y.Data<float>(), y.Data<float>() + y.Shape().Size());
+  ASSERT_EQ(values, expected_values);
+}
+
+}  // namespace
+
+TEST(DynamicBatcherTest, ConcurrentRequestsAreBatched) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadSquareModel(session);
+
+  DynamicBatcherOptions options;
+  options.max_batch_size = 4;
+  // long enough that the batch only runs once it is full
+  options.max_queue_delay = std::chrono::seconds(60);
+  DynamicBatcher batcher(session, options);
+
+  std::vector<BatcherRequest> requests(4);
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const float v = static_cast<float>(i + 1);
+    requests[i].dims = {1, 2};
+    requests[i].values = {v, -v};
+  }
+
+  RunConcurrently(batcher, requests);
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const float v = static_cast<float>(i + 1);
+    VerifySquared(requests[i], {1, 2}, {v * v, v * v});
+  }
+
+  auto stats = batcher.GetStats();
+  EXPECT_EQ(stats.num_batches, 1u);
+  EXPECT_EQ(stats.num_requests, 4u);
+  EXPECT_EQ(stats.num_unbatched_requests, 0u);
+  EXPECT_EQ(stats.num_samples, 4u);
+  EXPECT_FLOAT_EQ(stats.last_fill_ratio, 1.f);
+  EXPECT_FLOAT_EQ(stats.AverageFillRatio(options.max_batch_size), 1.f);
+}
+
+TEST(DynamicBatcherTest, RaggedDimsArePadded) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadSquareModel(session);
+
+  DynamicBatcherOptions options;
+  options.max_batch_size = 3;
+  options.max_queue_delay = std::chrono::seconds(60);
+  options.padding_policy = BatchPaddingPolicy::kPadToMax;
+  DynamicBatcher batcher(session, options);
+
+  std::vector<BatcherRequest> requests(2);
+  requests[0].dims = {1, 2};
+  requests[0].values = {2.f, 3.f};
+  requests[1].dims = {2, 3};
+  requests[1].values = {1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+
+  RunConcurrently(batcher, requests);
+
+  // outputs keep the padded shape
+  VerifySquared(requests[0], {1, 3}, {4.f, 9.f, 0.f});
+  VerifySquared(requests[1], {2, 3}, {1.f, 4.f, 9.f, 16.f, 25.f, 36.f});
+
+  auto stats = batcher.GetStats();
+  EXPECT_EQ(stats.num_batches, 1u);
+  EXPECT_EQ(stats.num_samples, 3u);
+}
+
+TEST(DynamicBatcherTest, FullRequestsAreNotQueued) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadSquareModel(session);
+
+  DynamicBatcherOptions options;
+  options.max_batch_size = 2;
+  options.max_queue_delay = std::chrono::seconds(60);
+  DynamicBatcher batcher(session, options);
+
+  std::vector<BatcherRequest> requests(1);
+  requests[0].dims = {2, 1};
+  requests[0].values = {3.f, 4.f};
+
+  RunConcurrently(batcher, requests);
+
+  VerifySquared(requests[0], {2, 1}, {9.f, 16.f});
+  auto stats = batcher.GetStats();
+  EXPECT_EQ(stats.num_batches, 0u);
+  EXPECT_EQ(stats.num_unbatched_requests, 1u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
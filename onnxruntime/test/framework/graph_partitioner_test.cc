@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <unordered_set>
+
+#include "asserts.h"
+#include "core/framework/compute_capability.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/graph_partitioner.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/graph/model.h"
+#include "core/optimizer/transpose_optimizer/optimizer_utils.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+namespace test {
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+namespace {
+
+constexpr const char* kCostModelTestExecutionProvider = "CostModelTestExecutionProvider";
+
+// Execution provider that is not CPU based and takes the nodes of the given op types one by one.
+class CostModelTestExecutionProvider : public IExecutionProvider {
+ public:
+  explicit CostModelTestExecutionProvider(std::unordered_set<std::string> op_types)
+      : IExecutionProvider{kCostModelTestExecutionProvider}, op_types_(std::move(op_types)) {
+  }
+
+  std::vector<std::unique_ptr<ComputeCapability>>
+  GetCapability(const GraphViewer& graph_viewer,
+                const std::vector<const KernelRegistry*>& /*kernel_registries*/) const override {
+    std::vector<std::unique_ptr<ComputeCapability>> capabilities;
+    for (const auto& node : graph_viewer.Nodes()) {
+      if (op_types_.count(node.OpType()) > 0) {
+        auto sub_graph = std::make_unique<IndexedSubGraph>();
+        sub_graph->nodes.push_back(node.Index());
+        capabilities.push_back(std::make_unique<ComputeCapability>(std::move(sub_graph)));
+      }
+    }
+
+    return capabilities;
+  }
+
+ private:
+  std::unordered_set<std::string> op_types_;
+};
+
+TypeProto MakeFloatTensorType(const std::vector<int64_t>& dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (int64_t dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+
+  return type;
+}
+
+// y = Neg(Relu(Abs(x))), where the Relu is a small island for the test provider
+void BuildSmallIslandGraph(Graph& graph) {
+  const TypeProto type = MakeFloatTensorType({1, 16});
+  auto& x = graph.GetOrCreateNodeArg("x", &type);
+  auto& abs_output = graph.GetOrCreateNodeArg("abs_output", &type);
+  auto& relu_output = graph.GetOrCreateNodeArg("relu_output", &type);
+  auto& y = graph.GetOrCreateNodeArg("y", &type);
+  graph.AddNode("abs", "Abs", "", {&x}, {&abs_output});
+  graph.AddNode("relu", "Relu", "", {&abs_output}, {&relu_output});
+  graph.AddNode("neg", "Neg", "", {&relu_output}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+// y = MatMul(a, b), with many multiply-adds for the size of the values
+void BuildMatMulGraph(Graph& graph) {
+  const TypeProto a_type = MakeFloatTensorType({256, 1024});
+  const TypeProto b_type = MakeFloatTensorType({1024, 1024});
+  auto& a = graph.GetOrCreateNodeArg("a", &a_type);
+  auto& b = graph.GetOrCreateNodeArg("b", &b_type);
+  auto& y = graph.GetOrCreateNodeArg("y", &a_type);
+  graph.AddNode("matmul", "MatMul", "", {&a, &b}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+// Partitions the graph with the test provider, which takes the nodes of op_types, and the CPU provider.
+// Returns the provider each node is assigned to by name.
+std::unordered_map<std::string, std::string> Partition(Graph& graph, std::unordered_set<std::string> op_types,
+                                                       const PartitioningCostModel* cost_model) {
+  ExecutionProviders execution_providers;
+  ORT_THROW_IF_ERROR(execution_providers.Add(kCostModelTestExecutionProvider,
+                                             std::make_unique<CostModelTestExecutionProvider>(std::move(op_types))));
+  ORT_THROW_IF_ERROR(execution_providers.Add(kCpuExecutionProvider,
+                                             std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo{false})));
+
+  KernelRegistryManager krm;
+  ORT_THROW_IF_ERROR(krm.RegisterKernels(execution_providers));
+
+  FuncManager func_mgr;
+  GraphPartitioner partitioner(krm, execution_providers, cost_model);
+  ORT_THROW_IF_ERROR(partitioner.Partition(graph, func_mgr, layout_transformer::TransformLayoutForCompilingEP));
+
+  std::unordered_map<std::string, std::string> node_providers;
+  for (const auto& node : graph.Nodes()) {
+    node_providers[node.Name()] = node.GetExecutionProviderType();
+  }
+
+  return node_providers;
+}
+
+}  // namespace
+
+TEST(GraphPartitionerTest, GreedyPartitioningTakesSmallIsland) {
+  Model model("GraphPartitionerTest", false, DefaultLoggingManager().DefaultLogger());
+  BuildSmallIslandGraph(model.MainGraph());
+
+  auto node_providers = Partition(model.MainGraph(), {"Relu"}, nullptr);
+  EXPECT_EQ(node_providers["abs"], kCpuExecutionProvider);
+  EXPECT_EQ(node_providers["relu"], kCostModelTestExecutionProvider);
+  EXPECT_EQ(node_providers["neg"], kCpuExecutionProvider);
+}
+
+TEST(GraphPartitionerTest, CostAwarePartitioningLeavesSmallIslandToCpu) {
+  Model model("GraphPartitionerTest", false, DefaultLoggingManager().DefaultLogger());
+  BuildSmallIslandGraph(model.MainGraph());
+
+  // the copies of the input and output of the Relu cost more than it
+  const PartitioningCostModel cost_model;
+  auto node_providers = Partition(model.MainGraph(), {"Relu"}, &cost_model);
+  EXPECT_EQ(node_providers["relu"], kCpuExecutionProvider);
+}
+
+TEST(GraphPartitionerTest, CostAwarePartitioningKeepsComputeBoundNode) {
+  Model model("GraphPartitionerTest", false, DefaultLoggingManager().DefaultLogger());
+  BuildMatMulGraph(model.MainGraph());
+
+  const PartitioningCostModel cost_model;
+  auto node_providers = Partition(model.MainGraph(), {"MatMul"}, &cost_model);
+  EXPECT_EQ(node_providers["matmul"], kCostModelTestExecutionProvider);
+}
+
+TEST(GraphPartitionerTest, CostAwarePartitioningUsesMeasuredKernelTimes) {
+  Model model("GraphPartitionerTest", false, DefaultLoggingManager().DefaultLogger());
+  BuildMatMulGraph(model.MainGraph());
+
+  // a MatMul measured to be as fast on the CPU, so the copies are not worth it
+  PartitioningCostModel cost_model;
+  cost_model.kernel_time_us[kCostModelTestExecutionProvider]["MatMul"] = 1000.0;
+  cost_model.kernel_time_us[kCpuExecutionProvider]["MatMul"] = 1000.0;
+  auto node_providers = Partition(model.MainGraph(), {"MatMul"}, &cost_model);
+  EXPECT_EQ(node_providers["matmul"], kCpuExecutionProvider);
+}
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -21,6 +21,7 @@
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/run_termination.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/bfc_arena.h"
@@ -44,6 +45,8 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/run_result_cache.h"
+#include "core/session/shape_specializer.h"
 #include "dummy_provider.h"
 #include "test_utils.h"
 #include "test/capturing_sink.h"
@@ -396,6 +399,84 @@ TEST(InferenceSessionTests, NoTimeout) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, RunPriority) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunPriority";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  for (const char* priority : {"low", "normal", "high"}) {
+    RunOptions run_options;
+    run_options.run_tag = priority;
+    ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigPriority, priority));
+    RunModel(session_object, run_options);
+  }
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigPriority, "urgent"));
+  NameMLValMap feeds;
+  std::vector<OrtValue> fetches;
+  auto status = session_object.Run(run_options, feeds, {"Y"}, &fetches);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("Invalid value for run.priority"));
+}
+
+TEST(InferenceSessionTests, RunPriorityGate) {
+  RunPriorityGate gate;
+  bool terminate = false;
+  RunTermination low_priority_termination(terminate);
+  low_priority_termination.SetPriorityGate(gate);
+
+  // a low priority run doesn't wait without high priority runs
+  low_priority_termination.YieldToHighPriorityRuns();
+
+  std::atomic<bool> resumed{false};
+  std::thread low_priority_run;
+  {
+    RunPriorityGate::HighPriorityScope high_priority_run(&gate);
+    low_priority_run = std::thread([&]() {
+      low_priority_termination.YieldToHighPriorityRuns();
+      resumed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(resumed);
+  }
+
+  // the low priority run resumes once the high priority run is done
+  low_priority_run.join();
+  EXPECT_TRUE(resumed);
+
+  // a waiting low priority run stops waiting once it is terminated
+  RunPriorityGate::HighPriorityScope high_priority_run(&gate);
+  terminate = true;
+  low_priority_termination.YieldToHighPriorityRuns();
+  EXPECT_FALSE(low_priority_termination.Check().IsOK());
+}
+
+TEST(InferenceSessionTests, FlatExecutionPlan) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.FlatExecutionPlan";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseFlatExecutionPlan, "1"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const auto* flat_execution_plan = session_object.GetSessionState().GetFlatExecutionPlan();
+  ASSERT_NE(flat_execution_plan, nullptr);
+  ASSERT_EQ(flat_execution_plan->size(), session_object.GetSessionState().GetExecutionPlan()->execution_plan.size());
+
+  RunOptions run_options;
+  run_options.run_tag = "one session/one tag";
+  RunModel(session_object, run_options);
+  // the flat plan is shared by all runs
+  RunModel(session_object, run_options);
+}
+
 TEST(InferenceSessionTests, OnlyExecutePathToFetches) {
   SessionOptions so;
 
@@ -489,6 +570,369 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  const string test_model = "testdata/transform/abs-id-max.onnx";
+  const std::string cache_dir = "optimized_model_cache_test";
+  if (Env::Default().FolderExists(cache_dir)) {
+    ASSERT_STATUS_OK(Env::Default().DeleteFolder(ToPathString(cache_dir)));
+  }
+
+  auto capturing_sink = new CapturingSink();
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(capturing_sink), logging::Severity::kINFO, false,
+      LoggingManager::InstanceType::Temporal);
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  auto count_logged = [capturing_sink](const std::string& text) {
+    const auto& msgs = capturing_sink->Messages();
+    return std::count_if(msgs.begin(), msgs.end(),
+                         [&text](const std::string& msg) { return msg.find(text) != string::npos; });
+  };
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.OptimizedModelCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigOptimizedModelCacheDir,
+                                                    cache_dir.c_str()));
+
+  // the first session optimizes the model and saves it to the cache
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+    ASSERT_EQ(count_logged("Saved the optimized model to cache file"), 1);
+    ASSERT_EQ(count_logged("Loaded the optimized model from cache file"), 0);
+  }
+
+  // the second session loads the optimized model from the cache
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+    ASSERT_EQ(count_logged("Saved the optimized model to cache file"), 1);
+    ASSERT_EQ(count_logged("Loaded the optimized model from cache file"), 1);
+  }
+
+  // a different optimization level selects a different cache file
+  so.graph_optimization_level = TransformerLevel::Default;
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_GT(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+    ASSERT_EQ(count_logged("Saved the optimized model to cache file"), 2);
+    ASSERT_EQ(count_logged("Loaded the optimized model from cache file"), 1);
+  }
+
+  ASSERT_STATUS_OK(Env::Default().DeleteFolder(ToPathString(cache_dir)));
+}
+
+static void RunAbsFreeDimensionsModel(InferenceSession& session_object, const std::vector<int64_t>& dims) {
+  std::vector<float> values(static_cast<size_t>(dims[0] * dims[1] * dims[2]));
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = (i % 2 == 0 ? -1.f : 1.f) * static_cast<float>(i);
+  }
+
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, values, &ml_value);
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, {"x"}, {ml_value}, {"y"}, &fetches, nullptr));
+
+  const auto& output = fetches[0].Get<Tensor>();
+  ASSERT_EQ(output.Shape(), TensorShape(dims));
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(output.Data<float>()[i], std::abs(values[i]));
+  }
+}
+
+TEST(InferenceSessionTests, ShapeSpecializer) {
+  const std::string test_model = "testdata/abs_free_dimensions.onnx";
+  std::vector<FreeDimensionOverride> created_overrides;
+  auto create_session = [&](const std::vector<FreeDimensionOverride>& overrides,
+                            std::unique_ptr<InferenceSession>& session) {
+    created_overrides = overrides;
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.ShapeSpecializer.Specialized";
+    so.free_dimension_overrides = overrides;
+    auto specialized = std::make_unique<InferenceSession>(so, GetEnvironment());
+    ORT_RETURN_IF_ERROR(specialized->Load(test_model));
+    ORT_RETURN_IF_ERROR(specialized->Initialize());
+    session = std::move(specialized);
+    return Status::OK();
+  };
+
+  ShapeSpecializer specializer({{"x", {"Dim1", "Dim2", ""}}}, /*max_specializations*/ 1, /*min_runs*/ 2,
+                               create_session, DefaultLoggingManager().DefaultLogger());
+
+  OrtValue feed;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3, 5},
+                       std::vector<float>(30, 1.f), &feed);
+  OrtValue other_feed;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {4, 3, 5},
+                       std::vector<float>(60, 1.f), &other_feed);
+
+  // the second run with the same shape starts creating the specialized session
+  ASSERT_EQ(specializer.GetSession({"x"}, {feed}), nullptr);
+  ASSERT_EQ(specializer.GetSession({"x"}, {feed}), nullptr);
+
+  InferenceSession* session = nullptr;
+  for (int i = 0; i < 500 && session == nullptr; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    session = specializer.GetSession({"x"}, {feed});
+  }
+
+  ASSERT_NE(session, nullptr);
+  ASSERT_EQ(created_overrides.size(), 2u);
+  EXPECT_EQ(created_overrides[0].dim_identifier, "Dim1");
+  EXPECT_EQ(created_overrides[0].dim_value, 2);
+  EXPECT_EQ(created_overrides[1].dim_identifier, "Dim2");
+  EXPECT_EQ(created_overrides[1].dim_value, 3);
+
+  // the inputs of the specialized session are static
+  auto inputs = session->GetModelInputs();
+  ASSERT_STATUS_OK(inputs.first);
+  const auto* input_shape = (*inputs.second)[0]->Shape();
+  ASSERT_TRUE(input_shape->dim(0).has_dim_value());
+  ASSERT_TRUE(input_shape->dim(1).has_dim_value());
+  RunAbsFreeDimensionsModel(*session, {2, 3, 5});
+
+  // no more sessions are created once the maximum is reached
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(specializer.GetSession({"x"}, {other_feed}), nullptr);
+  }
+
+  ASSERT_EQ(specializer.GetSession({"x"}, {feed}), session);
+}
+
+TEST(InferenceSessionTests, ShapeSpecializationRuns) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShapeSpecializationRuns";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShapeSpecializationMaxSessions, "2"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShapeSpecializationMinRuns, "2"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/abs_free_dimensions.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // runs are correct whether or not they are dispatched to a specialized session
+  for (int i = 0; i < 20; ++i) {
+    RunAbsFreeDimensionsModel(session_object, {2, 3, 5});
+    RunAbsFreeDimensionsModel(session_object, {1, 7, 5});
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+}
+
+TEST(InferenceSessionTests, RunResultCache) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunResultCache";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigRunResultCacheBytes, "1024"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/abs_free_dimensions.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  const RunResultCache* cache = session_object.GetRunResultCache();
+  ASSERT_NE(cache, nullptr);
+
+  auto run = [&session_object](float value, std::vector<OrtValue>& fetches) {
+    OrtValue feed;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3, 5},
+                         std::vector<float>(30, value), &feed);
+    fetches.clear();
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, {"x"}, {feed}, {"y"}, &fetches, nullptr));
+    ASSERT_EQ(fetches[0].Get<Tensor>().Data<float>()[29], std::abs(value));
+  };
+
+  // the second run returns a copy of the outputs of the first one
+  std::vector<OrtValue> first;
+  std::vector<OrtValue> second;
+  run(-1.f, first);
+  run(-1.f, second);
+  EXPECT_EQ(cache->NumHits(), 1u);
+  EXPECT_NE(first[0].Get<Tensor>().DataRaw(), second[0].Get<Tensor>().DataRaw());
+  auto first_span = first[0].Get<Tensor>().DataAsSpan<float>();
+  auto second_span = second[0].Get<Tensor>().DataAsSpan<float>();
+  EXPECT_EQ(std::vector<float>(second_span.begin(), second_span.end()),
+            std::vector<float>(first_span.begin(), first_span.end()));
+
+  // an entry holds 240 bytes of feed and output data and a signature of a few dozen bytes, so only three fit and
+  // the fourth one evicts the least recently used
+  std::vector<OrtValue> fetches;
+  run(-2.f, fetches);
+  run(-3.f, fetches);
+  run(-4.f, fetches);
+  EXPECT_LE(cache->SizeInBytes(), 1024u);
+  run(-4.f, fetches);
+  EXPECT_EQ(cache->NumHits(), 2u);
+  run(-1.f, fetches);
+  EXPECT_EQ(cache->NumHits(), 2u);
+  EXPECT_EQ(cache->NumMisses(), 5u);
+}
+
+TEST(InferenceSessionTests, RunResultCacheModifiedOutputs) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunResultCacheModifiedOutputs";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigRunResultCacheBytes, "1024"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/abs_free_dimensions.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  const RunResultCache* cache = session_object.GetRunResultCache();
+  ASSERT_NE(cache, nullptr);
+
+  OrtValue feed;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3, 5},
+                       std::vector<float>(30, -1.f), &feed);
+  auto run = [&session_object, &feed](std::vector<OrtValue>& fetches) {
+    fetches.clear();
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, {"x"}, {feed}, {"y"}, &fetches, nullptr));
+    auto span = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    EXPECT_EQ(std::vector<float>(span.begin(), span.end()), std::vector<float>(30, 1.f));
+  };
+
+  // the outputs of the run that filled the cache and those of a hit are modified by their callers
+  std::vector<OrtValue> fetches;
+  run(fetches);
+  std::fill_n(fetches[0].GetMutable<Tensor>()->MutableData<float>(), 30, 7.f);
+  run(fetches);
+  std::fill_n(fetches[0].GetMutable<Tensor>()->MutableData<float>(), 30, 7.f);
+
+  // a later hit still returns the original outputs
+  run(fetches);
+  EXPECT_EQ(cache->NumHits(), 2u);
+  EXPECT_EQ(cache->NumMisses(), 1u);
+}
+
+TEST(InferenceSessionTests, RunResultCacheTtl) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunResultCacheTtl";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigRunResultCacheBytes, "4096"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigRunResultCacheTtlMs, "1"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/abs_free_dimensions.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  const RunResultCache* cache = session_object.GetRunResultCache();
+  ASSERT_NE(cache, nullptr);
+
+  RunAbsFreeDimensionsModel(session_object, {2, 3, 5});
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  RunAbsFreeDimensionsModel(session_object, {2, 3, 5});
+  EXPECT_EQ(cache->NumHits(), 0u);
+  EXPECT_EQ(cache->NumMisses(), 2u);
+}
+
+TEST(InferenceSessionTests, RunResultCacheNondeterministicNodes) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto tensor_bool;
+  tensor_bool.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+
+  // Dropout is not random when training_mode is a constant false
+  TensorProto training_mode;
+  training_mode.set_name("training_mode");
+  training_mode.set_data_type(TensorProto_DataType_BOOL);
+  training_mode.add_int32_data(0);
+  graph.AddInitializedTensor(training_mode);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& no_ratio = graph.GetOrCreateNodeArg("", nullptr);
+  auto& training_mode_arg = graph.GetOrCreateNodeArg("training_mode", &tensor_bool);
+  auto& dropout_output = graph.GetOrCreateNodeArg("dropout_output", &tensor_float);
+  graph.AddNode("dropout", "Dropout", "Dropout", {&x, &no_ratio, &training_mode_arg}, {&dropout_output});
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(RunResultCache::FindNondeterministicNode(graph), nullptr);
+
+  auto& random_output = graph.GetOrCreateNodeArg("random_output", &tensor_float);
+  graph.AddNode("random", "RandomNormalLike", "RandomNormalLike", {&dropout_output}, {&random_output});
+  ASSERT_STATUS_OK(graph.Resolve());
+  const Node* node = RunResultCache::FindNondeterministicNode(graph);
+  ASSERT_NE(node, nullptr);
+  EXPECT_EQ(node->Name(), "random");
+}
+
+TEST(InferenceSessionTests, LazyLoadExternalInitializers) {
+  const std::string model_file_name = "lazy_load_external_initializers.onnx";
+  const std::string external_file_name = "lazy_load_external_initializers.bin";
+
+  // y = MatMul(x, w), with w in the external data file
+  {
+    onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                             {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    TypeProto tensor_float;
+    tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+    TensorProto w;
+    w.set_name("w");
+    w.set_data_type(TensorProto_DataType_FLOAT);
+    w.add_dims(3);
+    w.add_dims(4);
+    for (int i = 0; i < 12; ++i) {
+      w.add_float_data(static_cast<float>(i));
+    }
+    graph.AddInitializedTensor(w);
+
+    auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+    auto& w_arg = graph.GetOrCreateNodeArg("w", &tensor_float);
+    auto& y = graph.GetOrCreateNodeArg("y", &tensor_float);
+    graph.AddNode("matmul", "MatMul", "MatMul", {&x, &w_arg}, {&y});
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    std::remove(model_file_name.c_str());
+    std::remove(external_file_name.c_str());
+    ASSERT_STATUS_OK(Model::SaveWithExternalInitializers(model, ToPathString(model_file_name), external_file_name, 0));
+  }
+
+  auto run = [&model_file_name](bool lazy_load, std::vector<float>& output) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.LazyLoadExternalInitializers";
+    if (lazy_load) {
+      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigLazyLoadExternalInitializers, "1"));
+      // the initializers left as is have to be views of the mapped file, not copies of it
+      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigRequireMappedExternalInitializers,
+                                                         "1"));
+    }
+
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_file_name));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    // MatMul pre-packs w, which removes it from the constant initializers, unless the external initializers are
+    // lazily loaded
+    const auto& session_state = session_object.GetSessionState();
+    int w_idx;
+    ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("w", w_idx));
+    EXPECT_EQ(session_state.GetConstantInitializedTensors().count(w_idx), lazy_load ? 1u : 0u);
+
+    OrtValue feed;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3},
+                         {1.f, 2.f, 3.f, -1.f, 0.5f, 2.f}, &feed);
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, {"x"}, {feed}, {"y"}, &fetches, nullptr));
+    const auto& y = fetches[0].Get<Tensor>();
+    ASSERT_EQ(y.Shape(), TensorShape({2, 4}));
+    output.assign(y.Data<float>(), y.Data<float>() + y.Shape().Size());
+  };
+
+  std::vector<float> expected_output;
+  std::vector<float> lazy_output;
+  run(false, expected_output);
+  run(true, lazy_output);
+  EXPECT_EQ(expected_output, (std::vector<float>{32.f, 38.f, 44.f, 50.f, 18.f, 19.5f, 21.f, 22.5f}));
+  EXPECT_EQ(lazy_output, expected_output);
+
+  std::remove(model_file_name.c_str());
+  std::remove(external_file_name.c_str());
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -668,6 +1112,78 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
 #if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING)
   ASSERT_TRUE(has_kernel_info);
 #endif
+
+  // the phases of the session initialization are recorded
+  for (const char* phase : {"graph_transformation", "graph_partitioning", "initializers_deserialization",
+                            "kernels_creation", "session_state_finalization", "session_initialization"}) {
+    ASSERT_TRUE(std::any_of(lines.begin(), lines.end(),
+                            [phase](const std::string& l) { return l.find(phase) != string::npos; }))
+        << phase;
+  }
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerWithHardwareCounters) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerWithHardwareCounters";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_hardware_counters_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilingHardwareCounters, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_kernel_time = false;
+  while (std::getline(profile, line)) {
+    if (line.find("_kernel_time") == string::npos) {
+      continue;
+    }
+
+    // the achieved throughput is always reported, the hardware counters only where perf_event is allowed
+    has_kernel_time = true;
+    ASSERT_TRUE(line.find("\"flops\"") != string::npos) << line;
+    ASSERT_TRUE(line.find("\"gflops_per_s\"") != string::npos) << line;
+    ASSERT_TRUE(line.find("\"gb_per_s\"") != string::npos) << line;
+  }
+
+  ASSERT_TRUE(has_kernel_time);
+}
+
+TEST(InferenceSessionTests, MemoryTimeline) {
+  SessionOptions so;
+
+  so.session_logid = "MemoryTimeline";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryTimelineFilePrefix,
+                                                    "memory_timeline_test"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  // one file per run
+  for (const char* file : {"memory_timeline_test_0.json", "memory_timeline_test_1.json"}) {
+    std::ifstream timeline(file);
+    ASSERT_TRUE(timeline) << file;
+    std::string content((std::istreambuf_iterator<char>(timeline)), std::istreambuf_iterator<char>());
+
+    // the output Y of the Mul node is allocated by the frame and lives until the end of the run
+    ASSERT_TRUE(content.find(R"("name" : "Y")") != std::string::npos) << content;
+    ASSERT_TRUE(content.find(R"("op_type" : "Mul")") != std::string::npos) << content;
+    ASSERT_TRUE(content.find(R"("name" : "live_bytes")") != std::string::npos) << content;
+    ASSERT_TRUE(content.find(R"("name" : "peak")") != std::string::npos) << content;
+  }
 }
 
 TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
@@ -953,6 +1469,73 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestIOBindingState) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestIOBindingState";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  // Y = X * W, with the same buffer bound as both X and Y so each run multiplies it by W in place
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue state;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims_mul_x, values_mul_x,
+                       &state);
+  ASSERT_STATUS_OK(io_binding->BindState("X", "Y", state));
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(session_object.Run(run_options, *io_binding));
+  ASSERT_STATUS_OK(session_object.Run(run_options, *io_binding));
+
+  ASSERT_EQ(io_binding->GetOutputs().size(), 1u);
+  ASSERT_EQ(io_binding->GetOutputs()[0].Get<Tensor>().DataRaw(), state.Get<Tensor>().DataRaw());
+  VerifyOutputs(io_binding->GetOutputs(), dims_mul_x, {1.0f, 8.0f, 27.0f, 64.0f, 125.0f, 216.0f});
+
+  ASSERT_STATUS_OK(io_binding->ResetStates());
+  VerifyOutputs(io_binding->GetOutputs(), dims_mul_x, {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+}
+
+TEST(InferenceSessionTests, TestIOBindingPreparedRun) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestIOBindingPreparedRun";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  auto cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  OrtValue x;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &x);
+  ASSERT_STATUS_OK(io_binding->BindInput("X", x));
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y"));
+
+  // the first run allocates Y, the second one is set up for the allocated Y and the next ones reuse its setup
+  RunOptions run_options;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_STATUS_OK(session_object.Run(run_options, *io_binding));
+    VerifyOutputs(io_binding->GetOutputs(), dims_mul_x, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+  }
+
+  // a feed of another type doesn't match the prepared run, so it is validated
+  OrtValue x_int64;
+  CreateMLValue<int64_t>(cpu_allocator, dims_mul_x, {1, 2, 3, 4, 5, 6}, &x_int64);
+  ASSERT_STATUS_OK(io_binding->BindInput("X", x_int64));
+  ASSERT_FALSE(session_object.Run(run_options, *io_binding).IsOK());
+
+  OrtValue x2;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, {2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f}, &x2);
+  ASSERT_STATUS_OK(io_binding->BindInput("X", x2));
+  ASSERT_STATUS_OK(session_object.Run(run_options, *io_binding));
+  VerifyOutputs(io_binding->GetOutputs(), dims_mul_x, {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f});
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -2263,6 +2846,30 @@ TEST(InferenceSessionTests, LoadModelWithInValidOrtConfigJson) {
   ASSERT_TRUE(session_object_2.GetSessionOptions().intra_op_param.thread_pool_size == 2);
 }
 
+TEST(InferenceSessionTests, OrtConfigJsonMemoryOptionsAndConfigEntries) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  auto* ort_config = model_proto.add_metadata_props();
+  ort_config->set_key(inference_session_utils::kOrtConfigKey);
+  ort_config->set_value(
+      R"({"session_options": {"enable_mem_pattern": 0, "enable_cpu_mem_arena": 0,)"
+      R"( "config_entries": {"session.intra_op.allow_spinning": "0"}}})");
+
+  inference_session_utils::JsonConfigParser config_parser(DefaultLoggingManager().DefaultLogger());
+  ASSERT_STATUS_OK(config_parser.ParseOrtConfigJsonInModelProto(model_proto));
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(config_parser.ParseSessionOptionsFromModelProto(so));
+  ASSERT_FALSE(so.enable_mem_pattern);
+  ASSERT_FALSE(so.enable_cpu_mem_arena);
+  ASSERT_EQ(so.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAllowIntraOpSpinning, "1"), "0");
+
+  // the values of the config entries must be strings
+  ort_config->set_value(R"({"session_options": {"config_entries": {"session.intra_op.allow_spinning": 0}}})");
+  inference_session_utils::JsonConfigParser invalid_config_parser(DefaultLoggingManager().DefaultLogger());
+  ASSERT_STATUS_OK(invalid_config_parser.ParseOrtConfigJsonInModelProto(model_proto));
+  ASSERT_FALSE(invalid_config_parser.ParseSessionOptionsFromModelProto(so).IsOK());
+}
+
 TEST(InferenceSessionTests, LoadModelWithNoOrtConfigJson) {
   // Part 1 - Load config from model feature enabled
 #ifdef _WIN32
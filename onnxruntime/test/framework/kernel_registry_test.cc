@@ -7,6 +7,8 @@
 
 #include "asserts.h"
 #include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
+#include "test/test_environment.h"
 
 namespace onnxruntime::test {
 
@@ -133,4 +135,43 @@ TEST(KernelRegistryTests, TryFindKernelByHash) {
   ASSERT_FALSE(r.TryFindKernelByHash(unregistered_kernel_def_hash, &pkci));
 }
 
+// The lookups of nodes of the same kind are served from the lookup cache, which must tell the types apart.
+TEST(KernelRegistryTests, TryFindKernelLookupCache) {
+  std::vector<std::unique_ptr<KernelDef>> function_table;
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider).Build());
+  KernelRegistry r;
+  ASSERT_STATUS_OK(RegKernels(r, function_table, CreateFakeKernel));
+
+  Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 7}},
+              {}, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ONNX_NAMESPACE::TypeProto double_tensor;
+  double_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_DOUBLE);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("y", &float_tensor);
+  auto& z = graph.GetOrCreateNodeArg("z", &float_tensor);
+  auto& dx = graph.GetOrCreateNodeArg("dx", &double_tensor);
+  auto& dy = graph.GetOrCreateNodeArg("dy", &double_tensor);
+  Node& node1 = graph.AddNode("elu1", "Elu", "", {&x}, {&y});
+  Node& node2 = graph.AddNode("elu2", "Elu", "", {&y}, {&z});
+  Node& node3 = graph.AddNode("elu3", "Elu", "", {&dx}, {&dy});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const KernelCreateInfo* kci1 = nullptr;
+  const KernelCreateInfo* kci2 = nullptr;
+  const KernelCreateInfo* kci3 = nullptr;
+  ASSERT_STATUS_OK(r.TryFindKernel(node1, kCpuExecutionProvider, &kci1));
+  ASSERT_STATUS_OK(r.TryFindKernel(node2, kCpuExecutionProvider, &kci2));
+  ASSERT_EQ(kci1, kci2);
+  ASSERT_STATUS_NOT_OK(r.TryFindKernel(node3, kCpuExecutionProvider, &kci3));
+  ASSERT_EQ(kci3, nullptr);
+
+  // the cached lookup gives the same kernel
+  ASSERT_STATUS_OK(r.TryFindKernel(node1, kCpuExecutionProvider, &kci3));
+  ASSERT_EQ(kci1, kci3);
+}
+
 }  // namespace onnxruntime::test
@@ -303,6 +303,172 @@ TEST(OrtModelOnlyTests, ValidateOrtFormatModelDoesNotRunOptimizersInFullBuild) {
   RunOrtModel(test_info);
 }
 
+// Initializers saved in ORT format are aligned, so that they can be used in place in the model bytes.
+TEST(OrtModelOnlyTests, LoadOrtFormatModelUsingModelBytesForInitializers) {
+  const std::basic_string<ORTCHAR_T> ort_file = ORT_TSTR("testdata/mnist.onnx.in_place_initializers.test_output.ort");
+  SaveAndCompareModels("testdata/mnist.onnx", ort_file);
+
+  SessionOptions so;
+  so.session_logid = "LoadOrtFormat";
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ort_file));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the initializers of the model file are memory mapped
+  SessionOptions so2;
+  so2.session_logid = "LoadOrtFormatUsingModelBytesForInitializers";
+  ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "1"));
+  InferenceSessionWrapper session_object2{so2, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object2.Load(ort_file));
+  ASSERT_STATUS_OK(session_object2.Initialize());
+
+  size_t num_in_place_initializers = 0;
+  for (const auto& name_and_initializer : session_object2.GetGraph().GetAllInitializedTensors()) {
+    if (utils::HasExternalDataInMemory(*name_and_initializer.second)) {
+      ++num_in_place_initializers;
+    }
+  }
+  ASSERT_GT(num_in_place_initializers, 0u);
+
+  CompareGraphAndSessionState(session_object, session_object2);
+
+  // the initializers of the model bytes provided by the caller are used in place
+  size_t num_bytes = 0;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(ort_file.c_str(), num_bytes));
+  std::vector<char> model_data(num_bytes);
+  std::ifstream bytes_stream(ort_file, std::ifstream::in | std::ifstream::binary);
+  bytes_stream.read(model_data.data(), num_bytes);
+  bytes_stream.close();
+
+  SessionOptions so3;
+  so3.session_logid = "LoadOrtFormatFromBufferUsingModelBytesForInitializers";
+  ASSERT_STATUS_OK(so3.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseORTModelBytesDirectly, "1"));
+  ASSERT_STATUS_OK(so3.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "1"));
+  InferenceSessionWrapper session_object3{so3, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object3.Load(model_data.data(), static_cast<int>(num_bytes)));
+  ASSERT_STATUS_OK(session_object3.Initialize());
+
+  CompareGraphAndSessionState(session_object, session_object3);
+
+  OrtValue ml_value;
+  vector<float> data(28 * 28, 1.0);
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  const std::vector<std::string> output_names{"Plus214_Output_0"};
+
+  std::vector<OrtValue> expected_fetches;
+  ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &expected_fetches));
+  for (auto* session : {&session_object2, &session_object3}) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session->Run(feeds, output_names, &fetches));
+    CompareTensors(expected_fetches[0], fetches[0]);
+  }
+}
+
+// Initializers saved in ORT format can be compressed. They are decompressed when the model is loaded or, if the model
+// bytes are used for the initializers, when the session is initialized.
+TEST(OrtModelOnlyTests, LoadOrtFormatModelWithCompressedInitializers) {
+  constexpr int64_t num_elements = 4096;
+  const std::string onnx_file = "testdata/compressible_initializer.test_output.onnx";
+  {
+    onnxruntime::Model model("compressible_initializer", false, ModelMetaData(), PathString(),
+                             IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {},
+                             DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(num_elements);
+    auto& input_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+    auto& weight_arg = graph.GetOrCreateNodeArg("W", &float_tensor);
+    auto& output_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+
+    // values with few distinct bytes, like quantized weights
+    TensorProto weight;
+    weight.set_name("W");
+    weight.set_data_type(TensorProto_DataType_FLOAT);
+    weight.add_dims(num_elements);
+    for (int64_t i = 0; i < num_elements; ++i) {
+      weight.add_float_data(static_cast<float>(i % 64) * 0.5f);
+    }
+    graph.AddInitializedTensor(weight);
+    graph.AddNode("add", "Add", "", {&input_arg, &weight_arg}, {&output_arg});
+    ASSERT_STATUS_OK(graph.Resolve());
+    ASSERT_STATUS_OK(onnxruntime::Model::Save(model, onnx_file));
+  }
+
+  SessionOptions so;
+  so.session_logid = "LoadOnnxFormat";
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(onnx_file));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtValue ml_value;
+  vector<float> data(num_elements, 1.0);
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {num_elements}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> expected_fetches;
+  ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &expected_fetches));
+
+  for (const char* compression : {"lz4", "byte_shuffle_lz4"}) {
+    const auto ort_file = ToPathString(onnx_file + "." + compression + ".ort");
+
+    SessionOptions so_save;
+    so_save.session_logid = "SaveOrtFormatWithCompressedInitializers";
+    so_save.optimized_model_filepath = ort_file;
+    ASSERT_STATUS_OK(so_save.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+    ASSERT_STATUS_OK(so_save.config_options.AddConfigEntry(kOrtSessionOptionsConfigOrtFormatInitializerCompression,
+                                                           compression));
+    InferenceSessionWrapper session_object_save{so_save, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object_save.Load(onnx_file));
+    ASSERT_STATUS_OK(session_object_save.Initialize());
+
+    size_t num_bytes = 0;
+    ASSERT_STATUS_OK(Env::Default().GetFileLength(ort_file.c_str(), num_bytes));
+    ASSERT_LT(num_bytes, num_elements * sizeof(float)) << compression;
+
+    for (const char* use_model_bytes_for_initializers : {"0", "1"}) {
+      SessionOptions so_load;
+      so_load.session_logid = "LoadOrtFormatWithCompressedInitializers";
+      ASSERT_STATUS_OK(so_load.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseORTModelBytesForInitializers,
+                                                             use_model_bytes_for_initializers));
+      InferenceSessionWrapper session_object_load{so_load, GetEnvironment()};
+      ASSERT_STATUS_OK(session_object_load.Load(ort_file));
+      ASSERT_STATUS_OK(session_object_load.Initialize());
+
+      // the initializer is only decompressed on load if the model bytes are not used for the initializers
+      const auto& initializers = session_object_load.GetGraph().GetAllInitializedTensors();
+      const auto weight_entry = initializers.find("W");
+      ASSERT_NE(weight_entry, initializers.cend());
+      ASSERT_EQ(utils::HasCompressedExternalData(*weight_entry->second),
+                strcmp(use_model_bytes_for_initializers, "1") == 0)
+          << compression;
+
+      CompareGraphAndSessionState(session_object, session_object_load);
+
+      std::vector<OrtValue> fetches;
+      ASSERT_STATUS_OK(session_object_load.Run(feeds, output_names, &fetches));
+      CompareTensors(expected_fetches[0], fetches[0]);
+    }
+  }
+
+  // an unknown compression fails to save the model
+  SessionOptions so_invalid;
+  so_invalid.session_logid = "SaveOrtFormatWithInvalidCompression";
+  so_invalid.optimized_model_filepath = ToPathString(onnx_file + ".invalid_compression.ort");
+  ASSERT_STATUS_OK(so_invalid.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+  ASSERT_STATUS_OK(so_invalid.config_options.AddConfigEntry(kOrtSessionOptionsConfigOrtFormatInitializerCompression,
+                                                            "zip"));
+  InferenceSessionWrapper session_object_invalid{so_invalid, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object_invalid.Load(onnx_file));
+  const auto status = session_object_invalid.Initialize();
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_NE(status.ErrorMessage().find("Unsupported tensor compression"), std::string::npos);
+}
+
 TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   const std::basic_string<ORTCHAR_T> ort_file = ORT_TSTR("testdata/ort_github_issue_4031.onnx.test_output.ort");
   SaveAndCompareModels("testdata/ort_github_issue_4031.onnx", ort_file);
@@ -5,7 +5,11 @@
 #include "core/framework/op_kernel.h"
 #include "test/providers/provider_test_utils.h"
 #include "test_utils.h"
+#include "core/graph/model.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
 
 #include "gtest/gtest.h"
 
@@ -145,5 +149,112 @@ TEST_P(ParallelExecutorThreadPoolTest, TestNullInterOpThreadPool) {
 
 INSTANTIATE_TEST_SUITE_P(ParallelExecutorThreadPoolTests, ParallelExecutorThreadPoolTest,
                          testing::Values(1, 0));
+
+TEST(WorkStealingExecutor, TestStatusPropagation) {
+  auto registry = std::make_shared<CustomRegistry>();
+  std::vector<OpSchema> schemas{TestOp::OpSchema()};
+  ASSERT_STATUS_OK(registry->RegisterOpSet(schemas, TestOp::OpDomain, 10, 11));
+  KernelCreateFn kernel_create_fn = [](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) { out = std::make_unique<typename TestOp::OpKernelImpl>(info); return Status::OK(); };
+  auto kernel_def = TestOp::KernelDef();
+  ASSERT_STATUS_OK(registry->RegisterCustomKernel(kernel_def, kernel_create_fn));
+
+  onnxruntime::SessionOptions so;
+  so.session_logid = "WorkStealingExecutor";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseWorkStealingExecutor, "1"));
+
+  {  // test success
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+
+    tester.AddInput<int64_t>("action", {1}, {/*success*/ 0});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    tester.Run(so, OpTester::ExpectResult::kExpectSuccess, {}, {kTensorrtExecutionProvider}, nullptr, nullptr);
+  }
+
+  {  // test failure
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+
+    tester.AddInput<int64_t>("action", {1}, {/*failure*/ 1});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    tester.Run(so, OpTester::ExpectResult::kExpectFailure, "Action was 1", {kTensorrtExecutionProvider}, nullptr,
+               nullptr);
+  }
+
+  {  // test exception
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+
+    tester.AddInput<int64_t>("action", {1}, {/*exception*/ 2});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    tester.Run(so, OpTester::ExpectResult::kExpectFailure, "Throwing as action was 2", {kTensorrtExecutionProvider},
+               nullptr, nullptr);
+  }
+}
+
+// a wide graph where one branch is much longer than the others:
+// Y = Sum(X*X, ..., X*X, Abs(Abs(...Abs(X*X))))
+TEST(WorkStealingExecutor, WideGraph) {
+  constexpr int num_branches = 16;
+  constexpr int long_branch_length = 32;
+
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 12;
+  Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+              std::vector<FunctionProto>(), DefaultLoggingManager().DefaultLogger(), ModelOptions(true, true));
+  Graph& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+
+  std::vector<NodeArg*> branch_outputs;
+  for (int i = 0; i < num_branches; ++i) {
+    auto* branch_output = &graph.GetOrCreateNodeArg("branch_" + std::to_string(i), &tensor_float);
+    graph.AddNode("mul_" + std::to_string(i), "Mul", "", {&x, &x}, {branch_output});
+    if (i == 0) {
+      for (int j = 0; j < long_branch_length; ++j) {
+        auto* abs_output = &graph.GetOrCreateNodeArg("abs_" + std::to_string(j), &tensor_float);
+        graph.AddNode("abs_" + std::to_string(j), "Abs", "", {branch_output}, {abs_output});
+        branch_output = abs_output;
+      }
+    }
+
+    branch_outputs.push_back(branch_output);
+  }
+
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("sum", "Sum", "", branch_outputs, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+
+  SessionOptions so;
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 4;
+  // keep the Abs chain from being removed
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseWorkStealingExecutor, "1"));
+  InferenceSession session{so, GetEnvironment()};
+  std::stringstream model_stream(serialized);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2}, {1.f, -2.f}, &x_value);
+  NameMLValMap feeds{{"X", x_value}};
+
+  for (int run = 0; run < 10; ++run) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(feeds, {"Y"}, &fetches));
+    const Tensor& y_tensor = fetches[0].Get<Tensor>();
+    ASSERT_EQ(y_tensor.Shape(), TensorShape({2}));
+    EXPECT_FLOAT_EQ(y_tensor.Data<float>()[0], num_branches * 1.f);
+    EXPECT_FLOAT_EQ(y_tensor.Data<float>()[1], num_branches * 4.f);
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
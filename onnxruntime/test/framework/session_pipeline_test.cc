@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <sstream>
+#include <thread>
+
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/session_pipeline.h"
+#include "gtest/gtest.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// output = op(input_a, input_b)
+void LoadBinaryOpModel(InferenceSession& session, const std::string& op, const std::string& input_a,
+                       const std::string& input_b, const std::string& output) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 7;
+  Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+              std::vector<FunctionProto>(), DefaultLoggingManager().DefaultLogger(), ModelOptions(true, true));
+  Graph& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& a = graph.GetOrCreateNodeArg(input_a, &tensor_float);
+  auto& b = graph.GetOrCreateNodeArg(input_b, &tensor_float);
+  auto& y = graph.GetOrCreateNodeArg(output, &tensor_float);
+  graph.AddNode("node1", op, op, {&a, &b}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  std::stringstream model_stream(serialized);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+OrtValue CreateFloats(const std::vector<float>& values) {
+  OrtValue value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault),
+                       {static_cast<int64_t>(values.size())}, values, &value);
+  return value;
+}
+
+std::vector<float> GetFloats(const OrtValue& value) {
+  const Tensor& tensor = value.Get<Tensor>();
+  return std::vector<float>(tensor.Data<float>(), tensor.Data<float>() + tensor.Shape().Size());
+}
+
+}  // namespace
+
+TEST(SessionPipelineTest, ChainsStages) {
+  SessionOptions so;
+  // Y = X * X
+  InferenceSession square{so, GetEnvironment()};
+  LoadBinaryOpModel(square, "Mul", "X", "X", "Y");
+  // Z = Y + B
+  InferenceSession add{so, GetEnvironment()};
+  LoadBinaryOpModel(add, "Add", "Y", "B", "Z");
+  // V = W * B, with W the output Z
+  InferenceSession scale{so, GetEnvironment()};
+  LoadBinaryOpModel(scale, "Mul", "W", "B", "V");
+
+  SessionPipelineOptions options;
+  options.max_queued_requests = 2;
+  SessionPipeline pipeline(options);
+  ASSERT_STATUS_OK(pipeline.AddStage(square));
+  ASSERT_STATUS_OK(pipeline.AddStage(add));
+  ASSERT_STATUS_OK(pipeline.AddStage(scale, {{"W", "Z"}}));
+  ASSERT_EQ(pipeline.NumStages(), 3u);
+
+  // more requests than the queues hold, so the stages of different requests run concurrently
+  constexpr size_t kNumRequests = 16;
+  std::vector<std::vector<OrtValue>> fetches(kNumRequests);
+  std::vector<Status> statuses(kNumRequests);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    threads.emplace_back([&pipeline, &fetches, &statuses, i]() {
+      const float v = static_cast<float>(i);
+      NameMLValMap feeds{{"X", CreateFloats({v, -v})}, {"B", CreateFloats({1.f, 2.f})}};
+      statuses[i] = pipeline.Run(feeds, {"V", "Y"}, fetches[i]);
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    ASSERT_STATUS_OK(statuses[i]);
+    ASSERT_EQ(fetches[i].size(), 2u);
+    const float v = static_cast<float>(i);
+    EXPECT_EQ(GetFloats(fetches[i][0]), (std::vector<float>{v * v + 1.f, (v * v + 2.f) * 2.f}));
+    EXPECT_EQ(GetFloats(fetches[i][1]), (std::vector<float>{v * v, v * v}));
+  }
+}
+
+TEST(SessionPipelineTest, InvalidUsage) {
+  SessionOptions so;
+  InferenceSession square{so, GetEnvironment()};
+  LoadBinaryOpModel(square, "Mul", "X", "X", "Y");
+  InferenceSession add{so, GetEnvironment()};
+  LoadBinaryOpModel(add, "Add", "Y", "B", "Z");
+
+  SessionPipeline pipeline;
+  std::vector<OrtValue> fetches;
+  EXPECT_FALSE(pipeline.Run({}, {"Y"}, fetches).IsOK());
+
+  ASSERT_STATUS_OK(pipeline.AddStage(square));
+  // the renamed inputs must exist and be produced by a previous stage
+  EXPECT_FALSE(pipeline.AddStage(add, {{"W", "Y"}}).IsOK());
+  EXPECT_FALSE(pipeline.AddStage(add, {{"B", "Q"}}).IsOK());
+  ASSERT_STATUS_OK(pipeline.AddStage(add));
+
+  NameMLValMap feeds{{"X", CreateFloats({2.f})}, {"B", CreateFloats({1.f})}};
+  EXPECT_FALSE(pipeline.Run(feeds, {"Unknown"}, fetches).IsOK());
+
+  // a failing stage fails the request, e.g. a missing feed
+  EXPECT_FALSE(pipeline.Run({{"X", CreateFloats({2.f})}}, {"Z"}, fetches).IsOK());
+
+  ASSERT_STATUS_OK(pipeline.Run(feeds, {"Z"}, fetches));
+  ASSERT_EQ(fetches.size(), 1u);
+  EXPECT_EQ(GetFloats(fetches[0]), std::vector<float>{5.f});
+
+  // the pipeline is running
+  EXPECT_FALSE(pipeline.AddStage(add).IsOK());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
 #include <iostream>
 
 #include "asserts.h"
@@ -18,6 +19,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/thread_utils.h"
 #include "gtest/gtest.h"
+#include "test/framework/test_utils.h"
 #include "test/test_environment.h"
 #include "test/util/include/default_providers.h"
 #include "core/optimizer/transpose_optimizer/optimizer_utils.h"
@@ -181,6 +183,191 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
 // For this test we need to enable the arena-based allocator which is not supported on x86 builds, so
 // enable this test only on x64 builds
 #if (defined(__amd64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)) && !defined(USE_MIMALLOC)
+#ifndef ENABLE_TRAINING
+// training builds generate the pattern on a cache miss, which this test doesn't set up.
+TEST(SessionStateTest, MemoryPatternCacheBucketingAndEviction) {
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(ORT_TSTR("testdata/mul_1.onnx"), model, nullptr,
+                               DefaultLoggingManager().DefaultLogger()));
+  Graph& graph = model->MainGraph();
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo{false})));
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState session_state(graph, execution_providers, true, nullptr, nullptr, dtm,
+                             DefaultLoggingManager().DefaultLogger(), profiler);
+
+  MemoryPatternCacheOptions options;
+  options.shape_bucket_size = 16;
+  options.max_num_entries = 2;
+  session_state.SetMemoryPatternCacheOptions(options);
+
+  auto cpu_allocator = execution_providers.Get(kCpuExecutionProvider)->GetAllocator(0, OrtMemTypeDefault);
+  auto make_feeds = [&cpu_allocator](int64_t batch, int64_t sequence_length) {
+    std::vector<OrtValue> feeds(1);
+    CreateMLValue<float>(cpu_allocator, {batch, sequence_length},
+                         std::vector<float>(static_cast<size_t>(batch * sequence_length)), &feeds[0]);
+    return feeds;
+  };
+
+  std::vector<int> feed_mlvalue_idxs{0};
+  std::unordered_map<int, TensorShape> inferred_shapes;
+
+  auto feeds_3_16 = make_feeds(3, 16);
+  ASSERT_EQ(session_state.GetMemoryPatternGroup(feeds_3_16, feed_mlvalue_idxs, inferred_shapes), nullptr);
+  ASSERT_STATUS_OK(session_state.UpdateMemoryPatternGroupCache(feeds_3_16, std::make_unique<MemoryPatternGroup>()));
+
+  // sequence lengths 10 and 16 share a bucket. the batch dimension is not bucketed.
+  auto feeds_3_10 = make_feeds(3, 10);
+  auto feeds_4_16 = make_feeds(4, 16);
+  ASSERT_NE(session_state.GetMemoryPatternGroup(feeds_3_10, feed_mlvalue_idxs, inferred_shapes), nullptr);
+  ASSERT_EQ(session_state.GetMemoryPatternGroup(feeds_4_16, feed_mlvalue_idxs, inferred_shapes), nullptr);
+  ASSERT_STATUS_OK(session_state.UpdateMemoryPatternGroupCache(feeds_4_16, std::make_unique<MemoryPatternGroup>()));
+  auto pattern_4_16 = session_state.GetMemoryPatternGroup(feeds_4_16, feed_mlvalue_idxs, inferred_shapes);
+  ASSERT_NE(pattern_4_16, nullptr);
+
+  // adding a third pattern evicts the least recently used one
+  auto feeds_3_17 = make_feeds(3, 17);
+  ASSERT_NE(session_state.GetMemoryPatternGroup(feeds_3_10, feed_mlvalue_idxs, inferred_shapes), nullptr);
+  ASSERT_STATUS_OK(session_state.UpdateMemoryPatternGroupCache(feeds_3_17, std::make_unique<MemoryPatternGroup>()));
+  ASSERT_EQ(session_state.GetMemoryPatternGroup(feeds_4_16, feed_mlvalue_idxs, inferred_shapes), nullptr);
+  ASSERT_NE(session_state.GetMemoryPatternGroup(feeds_3_16, feed_mlvalue_idxs, inferred_shapes), nullptr);
+
+  // the evicted pattern stays valid for its holder
+  EXPECT_TRUE(pattern_4_16->patterns.empty());
+
+  auto stats = session_state.GetMemoryPatternCacheStats();
+  EXPECT_EQ(stats.num_hits, 4);
+  EXPECT_EQ(stats.num_misses, 3);
+  EXPECT_EQ(stats.num_evictions, 1);
+  EXPECT_EQ(stats.num_entries, 2u);
+}
+
+TEST(SessionStateTest, MemoryPatternCacheBucketLargerInputs) {
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(ORT_TSTR("testdata/mul_1.onnx"), model, nullptr,
+                               DefaultLoggingManager().DefaultLogger()));
+  Graph& graph = model->MainGraph();
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo{false})));
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState session_state(graph, execution_providers, true, nullptr, nullptr, dtm,
+                             DefaultLoggingManager().DefaultLogger(), profiler);
+
+  MemoryPatternCacheOptions options;
+  options.shape_bucket_size = 16;
+  session_state.SetMemoryPatternCacheOptions(options);
+
+  auto cpu_allocator = execution_providers.Get(kCpuExecutionProvider)->GetAllocator(0, OrtMemTypeDefault);
+  auto make_feeds = [&cpu_allocator](int64_t batch, int64_t sequence_length) {
+    std::vector<OrtValue> feeds(1);
+    CreateMLValue<float>(cpu_allocator, {batch, sequence_length},
+                         std::vector<float>(static_cast<size_t>(batch * sequence_length)), &feeds[0]);
+    return feeds;
+  };
+
+  std::vector<int> feed_mlvalue_idxs{0};
+  std::unordered_map<int, TensorShape> inferred_shapes;
+
+  auto feeds_3_10 = make_feeds(3, 10);
+  ASSERT_EQ(session_state.GetMemoryPatternGroup(feeds_3_10, feed_mlvalue_idxs, inferred_shapes), nullptr);
+  ASSERT_STATUS_OK(session_state.UpdateMemoryPatternGroupCache(feeds_3_10, std::make_unique<MemoryPatternGroup>()));
+
+  // the blocks of the pattern of the smaller inputs may be too small, so the larger inputs of the bucket miss once
+  // and the pattern generated by their run replaces it
+  auto feeds_3_16 = make_feeds(3, 16);
+  ASSERT_EQ(session_state.GetMemoryPatternGroup(feeds_3_16, feed_mlvalue_idxs, inferred_shapes), nullptr);
+  auto larger_patterns = std::make_unique<MemoryPatternGroup>();
+  const MemoryPatternGroup* larger_patterns_ptr = larger_patterns.get();
+  ASSERT_STATUS_OK(session_state.UpdateMemoryPatternGroupCache(feeds_3_16, std::move(larger_patterns)));
+
+  // both sizes of the bucket hit the pattern of the larger inputs from then on
+  EXPECT_EQ(session_state.GetMemoryPatternGroup(feeds_3_16, feed_mlvalue_idxs, inferred_shapes).get(),
+            larger_patterns_ptr);
+  EXPECT_EQ(session_state.GetMemoryPatternGroup(feeds_3_10, feed_mlvalue_idxs, inferred_shapes).get(),
+            larger_patterns_ptr);
+
+  // a smaller run that generated a pattern concurrently doesn't replace the one of the larger inputs
+  ASSERT_STATUS_OK(session_state.UpdateMemoryPatternGroupCache(feeds_3_10, std::make_unique<MemoryPatternGroup>()));
+  EXPECT_EQ(session_state.GetMemoryPatternGroup(feeds_3_16, feed_mlvalue_idxs, inferred_shapes).get(),
+            larger_patterns_ptr);
+
+  auto stats = session_state.GetMemoryPatternCacheStats();
+  EXPECT_EQ(stats.num_hits, 3);
+  EXPECT_EQ(stats.num_misses, 2);
+  EXPECT_EQ(stats.num_entries, 1u);
+}
+#endif
+
+TEST(SessionStateTest, MemoryPatternBufferReuse) {
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(ORT_TSTR("testdata/mul_1.onnx"), model, nullptr,
+                               DefaultLoggingManager().DefaultLogger()));
+  Graph& graph = model->MainGraph();
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo{false})));
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState session_state(graph, execution_providers, true, nullptr, nullptr, dtm,
+                             DefaultLoggingManager().DefaultLogger(), profiler);
+
+  auto cpu_allocator = execution_providers.Get(kCpuExecutionProvider)->GetAllocator(0, OrtMemTypeDefault);
+  const OrtMemoryInfo& location = cpu_allocator->Info();
+
+  size_t buffer_size = 0;
+  ASSERT_EQ(session_state.TakeMemoryPatternBuffer(location, 64, buffer_size), nullptr);
+
+  void* buffer = cpu_allocator->Alloc(128);
+  session_state.ReturnMemoryPatternBuffer(location, BufferUniquePtr(buffer, cpu_allocator), 128);
+
+  // a smaller pattern reuses the buffer
+  auto reused = session_state.TakeMemoryPatternBuffer(location, 64, buffer_size);
+  ASSERT_EQ(reused.get(), buffer);
+  EXPECT_EQ(buffer_size, 128u);
+  ASSERT_EQ(session_state.TakeMemoryPatternBuffer(location, 64, buffer_size), nullptr);
+
+  // a larger pattern doesn't, and the buffer that's too small is dropped
+  session_state.ReturnMemoryPatternBuffer(location, std::move(reused), 128);
+  ASSERT_EQ(session_state.TakeMemoryPatternBuffer(location, 256, buffer_size), nullptr);
+  ASSERT_EQ(session_state.TakeMemoryPatternBuffer(location, 64, buffer_size), nullptr);
+}
+
+TEST(SessionStateTest, ExecutionFrameValuesPool) {
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(ORT_TSTR("testdata/mul_1.onnx"), model, nullptr,
+                               DefaultLoggingManager().DefaultLogger()));
+  Graph& graph = model->MainGraph();
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo{false})));
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState session_state(graph, execution_providers, true, nullptr, nullptr, dtm,
+                             DefaultLoggingManager().DefaultLogger(), profiler);
+
+  EXPECT_TRUE(session_state.TakeExecutionFrameValues().empty());
+
+  std::vector<OrtValue> values(3);
+  const OrtValue* storage = values.data();
+  session_state.ReturnExecutionFrameValues(std::move(values));
+
+  auto reused = session_state.TakeExecutionFrameValues();
+  EXPECT_EQ(reused.data(), storage);
+  EXPECT_TRUE(session_state.TakeExecutionFrameValues().empty());
+
+  auto stats = session_state.GetExecutionFramePoolStats();
+  EXPECT_EQ(stats.num_hits, 1);
+  EXPECT_EQ(stats.num_misses, 2);
+}
+
 TEST(SessionStateTest, TestInitializerMemoryAllocatedUsingNonArenaMemory) {
   // Part 1: Feature turned ON (i.e.) allocate from non-arena memory
   {
@@ -308,6 +495,17 @@ class PrePackingTestOpKernel : public OpKernel {
     return Status::OK();
   }
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx, /*out*/ bool& used_cached_buffers) override {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+
+    weight_packed_ = std::move(prepacked_buffers[0]);
+    used_cached_buffers = true;
+    ++use_cached_pre_packed_weight_calls_count;
+    return Status::OK();
+  }
+
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                  /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
     ORT_UNUSED_PARAMETER(tensor);
@@ -330,6 +528,7 @@ class PrePackingTestOpKernel : public OpKernel {
 
   int prepack_calls_count = 0;
   int store_pre_packed_weight_calls_count = 0;
+  int use_cached_pre_packed_weight_calls_count = 0;
   BufferUniquePtr weight_packed_;
 };
 
@@ -776,6 +975,159 @@ TEST(SessionStateTest, SharedInitalizersWithPrePackingTest) {
   }
 }
 
+TEST(SessionStateTest, PrePackedWeightsCacheFileTest) {
+  OrtThreadPoolParams to;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+  ONNX_OPERATOR_SCHEMA(PrePackingTest)
+      .SetDoc("Faking Node for PrePacking")
+      .Input(0, "Input_0", "input 0", "tensor(float)")
+      .Input(1, "Input_1", "input 1", "tensor(float)")
+      .Output(0, "output_0", "docstr for output_0.", "tensor(float)");
+
+  ExecutionProviders execution_providers;
+  auto cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider, std::move(cpu_execution_provider)));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 11;
+
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+  std::shared_ptr<KernelRegistry> kernel_registry = std::make_shared<KernelRegistry>();
+  auto kernel_def = KernelDefBuilder().SetName("PrePackingTest").Provider(kCpuExecutionProvider).SinceVersion(1).Build();
+  ASSERT_STATUS_OK(kernel_registry->Register(
+      KernelCreateInfo(std::move(kernel_def),
+                       [](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) -> Status { out = std::make_unique<PrePackingTestOpKernel>(info); return Status::OK(); })));
+  kernel_registry_manager.RegisterKernelRegistry(kernel_registry);
+
+  const std::string cache_file = "prepacked_weights_cache_file_test.bin";
+  std::remove(cache_file.c_str());
+
+  SessionOptions sess_options;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigPrepackedWeightsCacheFile] = cache_file;
+
+  // the first session packs the weight and creates the cache file, the second one uses the weight from the file
+  for (int i = 0; i < 2; ++i) {
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+
+    CreateSimpleGraph(model.MainGraph());
+    PlaceAllNodesToCPUEP(model.MainGraph());
+    SessionState session_state(model.MainGraph(),
+                               execution_providers,
+                               true, /*enable_mem_pattern*/
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler);
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager,
+                                                        sess_options));
+
+    const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    if (i == 0) {
+      ASSERT_EQ(kernel->prepack_calls_count, 1);
+      ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1);
+      ASSERT_EQ(kernel->use_cached_pre_packed_weight_calls_count, 0);
+      ASSERT_EQ(session_state.GetUsedCachedPrePackedWeightCounter(), static_cast<size_t>(0));
+    } else {
+      ASSERT_EQ(kernel->prepack_calls_count, 0);
+      ASSERT_EQ(kernel->use_cached_pre_packed_weight_calls_count, 1);
+      ASSERT_EQ(session_state.GetUsedCachedPrePackedWeightCounter(), static_cast<size_t>(1));
+    }
+
+    const auto* data_weights_packed = reinterpret_cast<const float*>(kernel->weight_packed_.get());
+    ASSERT_NE(data_weights_packed, nullptr);
+    EXPECT_EQ(data_weights_packed[0], 1.2345f);
+    EXPECT_EQ(data_weights_packed[1], 1.2345f * 2.f);
+  }
+
+  std::remove(cache_file.c_str());
+}
+
+TEST(SessionStateTest, ShareInitializersByContentTest) {
+  OrtThreadPoolParams to;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+  ONNX_OPERATOR_SCHEMA(PrePackingTest)
+      .SetDoc("Faking Node for PrePacking")
+      .Input(0, "Input_0", "input 0", "tensor(float)")
+      .Input(1, "Input_1", "input 1", "tensor(float)")
+      .Output(0, "output_0", "docstr for output_0.", "tensor(float)");
+
+  ExecutionProviders execution_providers;
+  auto cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider, std::move(cpu_execution_provider)));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 11;
+
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+  std::shared_ptr<KernelRegistry> kernel_registry = std::make_shared<KernelRegistry>();
+  auto kernel_def = KernelDefBuilder().SetName("PrePackingTest").Provider(kCpuExecutionProvider).SinceVersion(1).Build();
+  ASSERT_STATUS_OK(kernel_registry->Register(
+      KernelCreateInfo(std::move(kernel_def),
+                       [](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) -> Status { out = std::make_unique<PrePackingTestOpKernel>(info); return Status::OK(); })));
+  kernel_registry_manager.RegisterKernelRegistry(kernel_registry);
+
+  // the initializer is not added to the session options, the sessions find it in the container by its content
+  SessionOptions sess_options;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigShareInitializersByContent] = "1";
+
+  PrepackedWeightsContainer prepacked_weights_container;
+
+  // the first session writes the initializer and its pre-packed weight into the container, the second one, e.g. a new
+  // version of the model loaded next to the first one, uses them
+  std::vector<std::unique_ptr<Model>> models;
+  std::vector<std::unique_ptr<SessionState>> session_states;
+  for (size_t i = 0; i < 2; ++i) {
+    models.push_back(std::make_unique<Model>("graph_main", false, ModelMetaData(), PathString(),
+                                             IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                             std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                             DefaultLoggingManager().DefaultLogger()));
+
+    CreateSimpleGraph(models.back()->MainGraph());
+    PlaceAllNodesToCPUEP(models.back()->MainGraph());
+    session_states.push_back(std::make_unique<SessionState>(models.back()->MainGraph(),
+                                                            execution_providers,
+                                                            true, /*enable_mem_pattern*/
+                                                            tp.get(),
+                                                            nullptr, /*inter_op_thread_pool*/
+                                                            dtm,
+                                                            DefaultLoggingManager().DefaultLogger(),
+                                                            profiler,
+                                                            false, true,
+                                                            &prepacked_weights_container));
+    auto& session_state = *session_states.back();
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager,
+                                                        sess_options));
+
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(session_state.GetUsedSharedPrePackedWeightCounter(), i);
+    ASSERT_EQ(prepacked_weights_container.GetNumberOfInitializers(), static_cast<size_t>(1));
+    ASSERT_EQ(prepacked_weights_container.GetNumberOfElements(), static_cast<size_t>(1));
+  }
+
+  // the sessions use the same pre-packed buffer
+  const auto* kernel_1 = reinterpret_cast<const PrePackingTestOpKernel*>(session_states[0]->GetKernel(0));
+  const auto* kernel_2 = reinterpret_cast<const PrePackingTestOpKernel*>(session_states[1]->GetKernel(0));
+  ASSERT_EQ(kernel_1->weight_packed_.get(), kernel_2->weight_packed_.get());
+}
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
                          testing::Values(PrepackingTestParam{false, false},
@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tensor_compression.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace utils {
+namespace test {
+
+namespace {
+std::vector<uint8_t> ToBytes(const std::vector<float>& values) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(values.data());
+  return std::vector<uint8_t>(bytes, bytes + values.size() * sizeof(float));
+}
+
+void CompressAndDecompress(TensorCompression compression, const std::vector<uint8_t>& data, size_t element_size,
+                           std::vector<uint8_t>& compressed) {
+  ASSERT_STATUS_OK(CompressTensorData(compression, element_size, data, compressed));
+
+  std::vector<uint8_t> decompressed(data.size());
+  ASSERT_STATUS_OK(DecompressTensorData(compression, element_size, compressed, gsl::make_span(decompressed)));
+  ASSERT_EQ(decompressed, data);
+}
+}  // namespace
+
+TEST(TensorCompressionTest, ParseName) {
+  TensorCompression compression;
+  ASSERT_STATUS_OK(ParseTensorCompression("", compression));
+  EXPECT_EQ(compression, TensorCompression::kNone);
+  for (auto expected : {TensorCompression::kNone, TensorCompression::kLz4, TensorCompression::kByteShuffleLz4}) {
+    ASSERT_STATUS_OK(ParseTensorCompression(TensorCompressionName(expected), compression));
+    EXPECT_EQ(compression, expected);
+  }
+
+  EXPECT_FALSE(ParseTensorCompression("zstd", compression).IsOK());
+}
+
+TEST(TensorCompressionTest, RoundTrip) {
+  std::default_random_engine generator{42};
+  std::uniform_int_distribution<int> distribution{0, 15};
+
+  // sizes around the minimum size of a match and the end of the data which is always literals
+  for (size_t num_elements : {0, 1, 3, 4, 5, 16, 17, 100, 1000, 70000}) {
+    std::vector<float> values(num_elements);
+    for (auto& value : values) {
+      value = static_cast<float>(distribution(generator)) * 0.25f;
+    }
+
+    const auto data = ToBytes(values);
+    for (auto compression : {TensorCompression::kLz4, TensorCompression::kByteShuffleLz4}) {
+      std::vector<uint8_t> compressed;
+      CompressAndDecompress(compression, data, sizeof(float), compressed);
+      if (num_elements >= 1000) {
+        // grouping the bytes of the elements compresses the few distinct values much better
+        EXPECT_LT(compressed.size(),
+                  compression == TensorCompression::kByteShuffleLz4 ? data.size() / 2 : data.size());
+      }
+    }
+  }
+}
+
+TEST(TensorCompressionTest, RoundTripRuns) {
+  // long runs create matches that overlap the data they produce, and lengths that need several extra bytes
+  std::vector<uint8_t> data(100000, 7);
+  for (size_t i = 50000; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i % 3);
+  }
+
+  std::vector<uint8_t> compressed;
+  CompressAndDecompress(TensorCompression::kLz4, data, 1, compressed);
+  EXPECT_LT(compressed.size(), 1000u);
+
+  CompressAndDecompress(TensorCompression::kByteShuffleLz4, data, 1, compressed);
+  CompressAndDecompress(TensorCompression::kByteShuffleLz4, data, 8, compressed);
+}
+
+TEST(TensorCompressionTest, InvalidCompressedData) {
+  std::vector<float> values(1000, 1.5f);
+  const auto data = ToBytes(values);
+  std::vector<uint8_t> compressed;
+  ASSERT_STATUS_OK(CompressTensorData(TensorCompression::kLz4, sizeof(float), data, compressed));
+
+  std::vector<uint8_t> decompressed(data.size());
+
+  // truncated data
+  auto truncated = compressed;
+  truncated.pop_back();
+  EXPECT_FALSE(DecompressTensorData(TensorCompression::kLz4, sizeof(float), truncated,
+                                    gsl::make_span(decompressed))
+                   .IsOK());
+
+  // the destination is not the size of the decompressed data
+  std::vector<uint8_t> too_small(data.size() - 1);
+  EXPECT_FALSE(DecompressTensorData(TensorCompression::kLz4, sizeof(float), compressed, gsl::make_span(too_small))
+                   .IsOK());
+  std::vector<uint8_t> too_large(data.size() + 1);
+  EXPECT_FALSE(DecompressTensorData(TensorCompression::kLz4, sizeof(float), compressed, gsl::make_span(too_large))
+                   .IsOK());
+
+  // a match offset before the start of the data
+  const std::vector<uint8_t> invalid_offset{0x00, 0x10, 0x00};
+  EXPECT_FALSE(DecompressTensorData(TensorCompression::kLz4, 1, invalid_offset, gsl::make_span(decompressed))
+                   .IsOK());
+
+  // the size of the data is not a multiple of the element size
+  EXPECT_FALSE(DecompressTensorData(TensorCompression::kByteShuffleLz4, 3, compressed, gsl::make_span(decompressed))
+                   .IsOK());
+}
+
+}  // namespace test
+}  // namespace utils
+}  // namespace onnxruntime
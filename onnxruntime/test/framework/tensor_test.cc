@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/framework/TensorSeq.h"
 #include "core/framework/allocatormgr.h"
 #include "test_utils.h"
 
@@ -210,7 +211,38 @@ TEST(TensorTest, SizeOverflow) {
   EXPECT_THROW(t.SizeInBytes(), OnnxRuntimeException);
 }
 
-#ifdef ENABLE_TRAINING
+TEST(TensorTest, TensorSeqSharesTensors) {
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  OrtValue value;
+  CreateMLValue<float>(alloc, {2}, {1.f, 2.f}, &value);
+
+  TensorSeq seq(DataTypeImpl::GetType<float>());
+  seq.Add(value);
+  seq.Add(Tensor(DataTypeImpl::GetType<float>(), TensorShape({3}), alloc));
+  ASSERT_EQ(seq.Size(), 2u);
+
+  // the tensor added from an OrtValue is shared, not copied
+  EXPECT_EQ(seq.Get(0).DataRaw(), value.Get<Tensor>().DataRaw());
+
+  TensorSeq other(seq.DataType());
+  for (size_t i = 0; i < seq.Size(); ++i) {
+    other.Add(seq.GetAt(i));
+  }
+
+  size_t i = 0;
+  for (const Tensor& tensor : other) {
+    EXPECT_EQ(tensor.DataRaw(), seq.Get(i).DataRaw());
+    EXPECT_EQ(tensor.Shape(), seq.Get(i).Shape());
+    ++i;
+  }
+  EXPECT_EQ(i, 2u);
+
+  OrtValue int_value;
+  CreateMLValue<int64_t>(alloc, {1}, {1}, &int_value);
+  EXPECT_THROW(seq.Add(int_value), OnnxRuntimeException);
+}
+
+#ifdef ENABLE_STRIDED_TENSORS
 TEST(TensorTest, Strided) {
   TensorShape shape({2, 3, 4});
   auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
@@ -254,6 +286,29 @@ TEST(TensorTest, Strided) {
   ASSERT_THAT(t4.Strides(), testing::ContainerEq(gsl::make_span(zero_strides)));
   ASSERT_EQ(t4.SizeInBytes(), sizeof(float));
 }
+
+TEST(TensorTest, StridedMoveAndNegativeStrides) {
+  TensorShape shape({2, 3});
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  void* data = alloc->Alloc(shape.Size() * sizeof(float));
+
+  // a view of the reversed rows, as output by a Slice with step -1
+  const TensorShapeVector strides{-3, 1};
+  Tensor t(DataTypeImpl::GetType<float>(), shape, data, alloc->Info(), 3 * sizeof(float), gsl::make_span(strides));
+  EXPECT_FALSE(t.IsContiguous());
+  ASSERT_EQ(t.SizeInBytes(), sizeof(float) * 6);
+
+  Tensor moved(std::move(t));
+  EXPECT_FALSE(moved.IsContiguous());
+  ASSERT_THAT(moved.Strides(), testing::ContainerEq(gsl::make_span(strides)));
+  EXPECT_EQ(moved.DataRaw(), static_cast<char*>(data) + 3 * sizeof(float));
+
+  Tensor assigned(DataTypeImpl::GetType<float>(), shape, data, alloc->Info());
+  assigned = std::move(moved);
+  EXPECT_FALSE(assigned.IsContiguous());
+  ASSERT_THAT(assigned.Strides(), testing::ContainerEq(gsl::make_span(strides)));
+  alloc->Free(data);
+}
 #endif
 
 }  // namespace test
@@ -191,6 +191,26 @@ TEST(TensorProtoUtilsTest, UnpackTensorWithExternalData) {
   TestUnpackExternalTensor<bool>(TensorProto_DataType_BOOL, model_path);
 }
 
+TEST(TensorProtoUtilsTest, GetExtDataFromTensorProtoWithRequiredMapping) {
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  TensorProto tensor_proto;
+  auto test_data = CreateValues<float>();
+  CreateTensorWithExternalData<float>(TensorProto_DataType_FLOAT, test_data, filename, tensor_proto);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+
+  void* ext_data_buf = nullptr;
+  size_t ext_data_len = 0;
+  OrtCallback ext_data_deleter{nullptr, nullptr};
+  ASSERT_STATUS_OK(utils::GetExtDataFromTensorProto(Env::Default(), ORT_TSTR("model.onnx"), tensor_proto,
+                                                    ext_data_buf, ext_data_len, ext_data_deleter,
+                                                    /* require_mapping */ true));
+  ASSERT_EQ(ext_data_len, test_data.size() * sizeof(float));
+  EXPECT_EQ(0, memcmp(ext_data_buf, test_data.data(), ext_data_len));
+  ASSERT_NE(ext_data_deleter.f, nullptr);
+  ext_data_deleter.f(ext_data_deleter.param);
+}
+
 template <typename T>
 static NodeProto CreateConstantNode(const std::string& attrib_name, AttributeProto_AttributeType type,
                                     std::function<void(AttributeProto&)> add_data) {
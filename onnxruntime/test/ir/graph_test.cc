@@ -1895,6 +1895,45 @@ TEST_F(GraphTest, AddRemoveInitializerHandling) {
                                  << num_initializers << " remain.";
 }
 
+TEST_F(GraphTest, ReleaseInitializedTensorData) {
+  Model m{"test_model", false, *logger_};
+  Graph& graph = m.MainGraph();
+
+  ONNX_NAMESPACE::TensorProto raw_init{};
+  raw_init.set_name("raw");
+  raw_init.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  raw_init.add_dims(2);
+  const std::vector<float> raw_values{1.f, 2.f};
+  raw_init.set_raw_data(raw_values.data(), raw_values.size() * sizeof(float));
+
+  ONNX_NAMESPACE::TensorProto typed_init{};
+  typed_init.set_name("typed");
+  typed_init.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  typed_init.add_dims(3);
+  typed_init.add_int64_data(1);
+  typed_init.add_int64_data(2);
+  typed_init.add_int64_data(3);
+
+  graph.AddInitializedTensor(raw_init);
+  graph.AddInitializedTensor(typed_init);
+
+  graph.ReleaseInitializedTensorData("raw");
+  graph.ReleaseInitializedTensorData("typed");
+  graph.ReleaseInitializedTensorData("not_an_initializer");
+
+  // the initializers keep their metadata without their data
+  ASSERT_EQ(graph.GetAllInitializedTensors().size(), 2u);
+  const TensorProto* i = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("raw", i));
+  EXPECT_EQ(i->data_type(), ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ASSERT_EQ(i->dims_size(), 1);
+  EXPECT_EQ(i->dims(0), 2);
+  EXPECT_FALSE(i->has_raw_data());
+  ASSERT_TRUE(graph.GetInitializedTensor("typed", i));
+  EXPECT_EQ(i->dims(0), 3);
+  EXPECT_EQ(i->int64_data_size(), 0);
+}
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 TEST_F(GraphTest, SparseInitializerHandling) {
   const char* const input_initializer_name = "x";
@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> activation_bench_arg_names = {"N"};
+
+using ActivationFunction = void(MLASCALL*)(const float* Input, float* Output, size_t N);
+
+void ACTIVATION(benchmark::State& state, ActivationFunction function) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto input = RandomVectorUniform(N, -5.0f, 5.0f);
+  std::vector<float> output(N);
+
+  for (auto _ : state) {
+    function(input.data(), output.data(), N);
+  }
+
+  // no flop count: the cost of the polynomial approximations differs per function and per ISA
+  SetRooflineCounters(state, 0.0, static_cast<double>(2 * N * sizeof(float)));
+}
+
+static void ActivationSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(activation_bench_arg_names);
+  b->Arg(1000);
+  b->Arg(64 * 1024);
+  b->Arg(4 * 1024 * 1024);
+}
+
+BENCHMARK_CAPTURE(ACTIVATION, Erf, MlasComputeErf)->Apply(ActivationSize)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Exp, MlasComputeExp)->Apply(ActivationSize)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Logistic, MlasComputeLogistic)->Apply(ActivationSize)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Tanh, MlasComputeTanh)->Apply(ActivationSize)->UseRealTime();
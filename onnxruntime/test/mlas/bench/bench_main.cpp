@@ -3,4 +3,34 @@
 
 #include <benchmark/benchmark.h>
 
-BENCHMARK_MAIN();
+#include <iostream>
+
+#include "core/common/cpuid_info.h"
+
+// MLAS picks its kernels for the instruction set of the machine at runtime, so print what it can dispatch to
+// before the results. Goes to stderr to keep --benchmark_format=json output parseable.
+static void PrintCpuFeatures() {
+  const auto& cpu_info = onnxruntime::CPUIDInfo::GetCPUIDInfo();
+  std::cerr << "CPU features:"
+            << " SSE3=" << cpu_info.HasSSE3()
+            << " SSE4.1=" << cpu_info.HasSSE4_1()
+            << " AVX=" << cpu_info.HasAVX()
+            << " AVX2=" << cpu_info.HasAVX2()
+            << " AVX512F=" << cpu_info.HasAVX512f()
+            << " AVX512Skylake=" << cpu_info.HasAVX512Skylake()
+            << " AMX-INT8=" << cpu_info.HasAMX_INT8()
+            << " NeonDot=" << cpu_info.HasArmNeonDot()
+            << " FP16=" << cpu_info.HasFp16VectorAcceleration()
+            << " Hybrid=" << cpu_info.IsHybrid()
+            << std::endl;
+}
+
+int main(int argc, char** argv) {
+  PrintCpuFeatures();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
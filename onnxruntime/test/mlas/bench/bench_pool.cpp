@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> pool_bench_arg_names = {"N", "C", "H", "W", "Kernel", "Stride", "Threads"};
+
+void POOL2D(benchmark::State& state, MLAS_POOLING_KIND kind) {
+  for (int i = 0; i < 7; i++) {
+    if (state.range(i) <= 0) throw std::invalid_argument(pool_bench_arg_names[i] + " must greater than 0!");
+  }
+  const int64_t kernel = state.range(4);
+  const int64_t stride = state.range(5);
+  if (state.range(2) < kernel || state.range(3) < kernel) throw std::invalid_argument("Kernel must fit in the input!");
+
+  const int64_t input_shape[] = {state.range(0), state.range(1), state.range(2), state.range(3)};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t padding[] = {0, 0, 0, 0};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {input_shape[0], input_shape[1],
+                                  (input_shape[2] - kernel) / stride + 1, (input_shape[3] - kernel) / stride + 1};
+  const size_t input_size = static_cast<size_t>(input_shape[0] * input_shape[1] * input_shape[2] * input_shape[3]);
+  const size_t output_size = static_cast<size_t>(output_shape[0] * output_shape[1] * output_shape[2] * output_shape[3]);
+
+  auto tp = CreateBenchThreadPool(static_cast<size_t>(state.range(6)));
+  auto input = RandomVectorUniform(input_size, -1.0f, 1.0f);
+  std::vector<float> output(output_size);
+
+  MlasPool(kind, 2, input_shape, kernel_shape, padding, stride_shape, output_shape,
+           input.data(), output.data(), tp.get());
+
+  for (auto _ : state) {
+    MlasPool(kind, 2, input_shape, kernel_shape, padding, stride_shape, output_shape,
+             input.data(), output.data(), tp.get());
+  }
+
+  SetRooflineCounters(state, static_cast<double>(output_size) * static_cast<double>(kernel * kernel),
+                      static_cast<double>((input_size + output_size) * sizeof(float)));
+}
+
+static void Pool2dSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(pool_bench_arg_names);
+  ArgsProduct(b, {{1}, {64}, {112}, {112}, {3}, {2}, {1, 4, 8}});
+  ArgsProduct(b, {{1}, {256}, {56}, {56}, {2}, {2}, {1, 4, 8}});
+  ArgsProduct(b, {{1}, {2048}, {7}, {7}, {7}, {1}, {1, 4, 8}});
+}
+
+BENCHMARK_CAPTURE(POOL2D, MaxPool, MlasMaximumPooling)->Apply(Pool2dSize)->UseRealTime();
+BENCHMARK_CAPTURE(POOL2D, AveragePool, MlasAveragePoolingExcludePad)->Apply(Pool2dSize)->UseRealTime();
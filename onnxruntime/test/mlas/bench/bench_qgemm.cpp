@@ -3,7 +3,6 @@
 
 #include "mlas.h"
 #include "bench_util.h"
-#include "core/util/thread_utils.h"
 
 #include <stdexcept>
 #include <memory>
@@ -29,13 +28,8 @@ void QGEMM(benchmark::State& state, bool pack_b, bool a_is_signed) {
 
   const size_t batch = static_cast<size_t>(state.range(3));
   const size_t threads = static_cast<size_t>(state.range(4));
-  
-  OrtThreadPoolParams tpo;
-  tpo.thread_pool_size = int(threads);
-  tpo.auto_set_affinity = true;
-  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
-      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
-      tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto tp = CreateBenchThreadPool(threads);
 
   auto A_holder = RandomVectorUniform<uint8_t>(static_cast<size_t>(M * K * batch), uint8_t(-100), uint8_t(100));
   auto B_holder = RandomVectorUniform<uint8_t>(static_cast<size_t>(N * K * batch), uint8_t(-110), uint8_t(110));
@@ -77,6 +71,9 @@ void QGEMM(benchmark::State& state, bool pack_b, bool a_is_signed) {
   for (auto _ : state) {
     MlasGemmBatch(gemm_shape, gemm_data_vec.data(), batch, tp.get());
   }
+
+  SetRooflineCounters(state, 2.0 * M * N * K * batch,
+                      static_cast<double>((M * K + N * K + M * N * sizeof(int32_t)) * batch));
 }
 
 static void QGemmSize(benchmark::internal::Benchmark* b) {
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> quantize_bench_arg_names = {"N"};
+
+template <typename OutputType>
+void QUANTIZELINEAR(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto input = RandomVectorUniform(N, -8.0f, 8.0f);
+  std::vector<OutputType> output(N);
+  constexpr float scale = 0.0625f;
+  constexpr OutputType zero_point = 3;
+
+  for (auto _ : state) {
+    MlasQuantizeLinear(input.data(), output.data(), N, scale, zero_point);
+  }
+
+  // divide, round, add the zero point and clamp per element
+  SetRooflineCounters(state, static_cast<double>(4 * N), static_cast<double>(N * (sizeof(float) + sizeof(OutputType))));
+}
+
+static void QuantizeSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(quantize_bench_arg_names);
+  b->Arg(1000);
+  b->Arg(64 * 1024);
+  b->Arg(4 * 1024 * 1024);
+}
+
+BENCHMARK_TEMPLATE(QUANTIZELINEAR, uint8_t)->Apply(QuantizeSize)->UseRealTime();
+BENCHMARK_TEMPLATE(QUANTIZELINEAR, int8_t)->Apply(QuantizeSize)->UseRealTime();
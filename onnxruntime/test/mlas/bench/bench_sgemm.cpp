@@ -92,6 +92,8 @@ void SGEMM(benchmark::State& state, bool pack_b, bool trans_a, bool trans_b, flo
           nullptr);
     }
   }
+
+  SetRooflineCounters(state, 2.0 * M * N * K, static_cast<double>((M * K + N * K + M * N) * sizeof(float)));
 }
 
 static void GemmSizeWithOne(benchmark::internal::Benchmark* b) {
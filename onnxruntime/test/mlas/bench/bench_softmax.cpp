@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> softmax_bench_arg_names = {"N", "D", "Threads"};
+
+void SOFTMAX(benchmark::State& state, bool log_softmax) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("D must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+  const size_t D = static_cast<size_t>(state.range(1));
+
+  auto tp = CreateBenchThreadPool(static_cast<size_t>(state.range(2)));
+  auto input = RandomVectorUniform(N * D, -10.0f, 10.0f);
+  std::vector<float> output(N * D);
+
+  MlasComputeSoftmax(input.data(), output.data(), N, D, log_softmax, tp.get());
+
+  for (auto _ : state) {
+    MlasComputeSoftmax(input.data(), output.data(), N, D, log_softmax, tp.get());
+  }
+
+  // max, subtract and exp, sum, scale: counted as one flop each per element
+  SetRooflineCounters(state, static_cast<double>(4 * N * D), static_cast<double>(2 * N * D * sizeof(float)));
+}
+
+static void SoftmaxSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(softmax_bench_arg_names);
+  // attention scores of a sequence of 128/512 over 12 heads and a classifier over a large vocabulary
+  ArgsProduct(b, {{12 * 128}, {128}, {1, 4, 8}});
+  ArgsProduct(b, {{12 * 512}, {512}, {1, 4, 8}});
+  ArgsProduct(b, {{1, 64}, {32000}, {1, 4, 8}});
+}
+
+BENCHMARK_CAPTURE(SOFTMAX, Softmax, false)->Apply(SoftmaxSize)->UseRealTime();
+BENCHMARK_CAPTURE(SOFTMAX, LogSoftmax, true)->Apply(SoftmaxSize)->UseRealTime();
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <random>
+#include <stdexcept>
+
+static const std::vector<std::string> sparse_gemm_bench_arg_names = {"M", "N", "K", "Sparsity", "Threads"};
+
+// Runs C = A * B with A holding (100 - Sparsity)% non-zero values, either through the CSR kernel or through the
+// dense SGEMM on the densified A, to locate the sparsity where the sparse kernel becomes faster.
+void SPARSEGEMM(benchmark::State& state, bool sparse) {
+  for (int i = 0; i < 5; i++) {
+    if (i != 3 && state.range(i) <= 0) throw std::invalid_argument(sparse_gemm_bench_arg_names[i] + " must greater than 0!");
+  }
+  if (state.range(3) < 0 || state.range(3) >= 100) throw std::invalid_argument("Sparsity must be in [0, 100)!");
+
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const double density = 1.0 - static_cast<double>(state.range(3)) / 100.0;
+
+  auto tp = CreateBenchThreadPool(static_cast<size_t>(state.range(4)));
+  auto B = RandomVectorUniform(K * N, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+
+  std::default_random_engine generator(static_cast<unsigned>(M * N * K));
+  std::bernoulli_distribution nonzero_distribution(density);
+  std::uniform_real_distribution<float> value_distribution(-1.0f, 1.0f);
+
+  std::vector<float> A(M * K, 0.0f);
+  std::vector<float> AValues;
+  std::vector<int64_t> ARowOffsets{0};
+  std::vector<int64_t> AColumnIndices;
+  for (size_t m = 0; m < M; m++) {
+    for (size_t k = 0; k < K; k++) {
+      if (nonzero_distribution(generator)) {
+        A[m * K + k] = value_distribution(generator);
+        AValues.push_back(A[m * K + k]);
+        AColumnIndices.push_back(static_cast<int64_t>(k));
+      }
+    }
+    ARowOffsets.push_back(static_cast<int64_t>(AValues.size()));
+  }
+
+  auto run = [&]() {
+    if (sparse) {
+      MlasSparseGemm(M, N, 1.0f, AValues.data(), ARowOffsets.data(), AColumnIndices.data(), B.data(), N,
+                     C.data(), N, tp.get());
+    } else {
+      MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), K, B.data(), N, 0.0f, C.data(), N, tp.get());
+    }
+  };
+
+  run();
+  for (auto _ : state) {
+    run();
+  }
+
+  const size_t a_bytes = sparse ? AValues.size() * (sizeof(float) + sizeof(int64_t)) + (M + 1) * sizeof(int64_t)
+                                : M * K * sizeof(float);
+  const double multiply_adds = sparse ? static_cast<double>(AValues.size()) * N : static_cast<double>(M) * N * K;
+  SetRooflineCounters(state, 2.0 * multiply_adds, static_cast<double>(a_bytes + (K * N + M * N) * sizeof(float)));
+}
+
+static void SparseGemmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(sparse_gemm_bench_arg_names);
+  ArgsProduct(b, {{256}, {128}, {1024}, {0, 50, 80, 90, 95, 99}, {1, 4}});
+  ArgsProduct(b, {{1024}, {64}, {1024}, {50, 80, 90, 95, 99}, {1, 4, 8}});
+  ArgsProduct(b, {{3072}, {16}, {768}, {50, 80, 90, 95, 99}, {1, 4, 8}});
+}
+
+BENCHMARK_CAPTURE(SPARSEGEMM, Sparse, true)->Apply(SparseGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(SPARSEGEMM, Dense, false)->Apply(SparseGemmSize)->UseRealTime();
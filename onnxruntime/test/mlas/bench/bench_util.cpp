@@ -49,3 +49,20 @@ void ArgsProduct(benchmark::internal::Benchmark* bench,
     } while (indices[arg++] == 0 && arg < arglists.size());
   }
 }
+
+std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateBenchThreadPool(size_t threads) {
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(threads);
+  tpo.auto_set_affinity = true;
+  return onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                    tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP);
+}
+
+void SetRooflineCounters(benchmark::State& state, double flops, double bytes) {
+  state.counters["FLOPS"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["Bytes"] = benchmark::Counter(bytes, benchmark::Counter::kIsIterationInvariantRate,
+                                               benchmark::Counter::OneK::kIs1024);
+  if (bytes > 0) {
+    state.counters["FlopPerByte"] = flops / bytes;
+  }
+}
@@ -5,8 +5,11 @@
 
 #include <benchmark/benchmark.h>
 
+#include <memory>
 #include <random>
 
+#include "core/util/thread_utils.h"
+
 
 void ArgsProduct(benchmark::internal::Benchmark* bench,
                  const std::vector<std::vector<int64_t>>& arglists);
@@ -32,3 +35,11 @@ std::vector<ElementType> RandomVectorUniform(
 std::vector<float> RandomVectorUniform(std::vector<int64_t> shape, float min_value, float max_value);
 
 std::vector<int64_t> BenchArgsVector(benchmark::State& state, size_t& start, size_t count);
+
+// Intra-op thread pool with the given number of threads, or nullptr (MLAS runs on the calling thread) for 1.
+std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateBenchThreadPool(size_t threads);
+
+// Reports the work of one iteration as rates so the kernel can be placed on a roofline: FLOPS is the arithmetic
+// throughput, Bytes the minimal memory traffic (inputs read once, outputs written once) per second and FlopPerByte
+// the arithmetic intensity.
+void SetRooflineCounters(benchmark::State& state, double flops, double bytes);
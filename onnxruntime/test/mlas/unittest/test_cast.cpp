@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <cstring>
+
+class MlasCastTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<unsigned short> BufferBits;
+  MatrixGuardBuffer<unsigned short> BufferBitsOutput;
+  MatrixGuardBuffer<float> BufferFloat;
+  MatrixGuardBuffer<float> BufferFloatOutput;
+
+  static float FromBits(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  static uint32_t ToBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  static float HalfToFloat(unsigned short value) {
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    const uint32_t mantissa = value & 0x3FF;
+    float result;
+    if (exponent == 0) {
+      result = std::ldexp(static_cast<float>(mantissa), -24);
+    } else if (exponent == 0x1F) {
+      result = mantissa == 0 ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    } else {
+      result = std::ldexp(static_cast<float>(mantissa | 0x400), static_cast<int>(exponent) - 25);
+    }
+    return (value & 0x8000) != 0 ? -result : result;
+  }
+
+  static float BFloat16ToFloat(unsigned short value) {
+    return FromBits(static_cast<uint32_t>(value) << 16);
+  }
+
+  // Converts the 16-bit values Offset, Offset + 1, ... to float and back, and the midpoints between them to check
+  // that the rounding is to nearest even.
+  template <typename ToFloatFn, typename FromFloatFn, typename ReferenceFn>
+  void Test(size_t Offset, size_t N, unsigned short InfinityBits,
+            ToFloatFn ToFloat, FromFloatFn FromFloat, ReferenceFn Reference, const char* Format) {
+    unsigned short* Bits = BufferBits.GetBuffer(N);
+    unsigned short* BitsOutput = BufferBitsOutput.GetBuffer(N);
+    float* Float = BufferFloat.GetBuffer(N);
+    float* FloatOutput = BufferFloatOutput.GetBuffer(N);
+
+    for (size_t n = 0; n < N; n++) {
+      Bits[n] = static_cast<unsigned short>(Offset + n);
+    }
+
+    ToFloat(Bits, FloatOutput, N);
+    for (size_t n = 0; n < N; n++) {
+      const float expected = Reference(Bits[n]);
+      if (std::isnan(expected)) {
+        ASSERT_TRUE(std::isnan(FloatOutput[n])) << Format << " " << Bits[n];
+      } else {
+        ASSERT_EQ(ToBits(FloatOutput[n]), ToBits(expected)) << Format << " " << Bits[n];
+      }
+    }
+
+    FromFloat(FloatOutput, BitsOutput, N);
+    for (size_t n = 0; n < N; n++) {
+      if ((Bits[n] & 0x7FFF) > InfinityBits) {
+        ASSERT_GT(BitsOutput[n] & 0x7FFF, InfinityBits) << Format << " NaN " << Bits[n];
+      } else {
+        ASSERT_EQ(BitsOutput[n], Bits[n]) << Format << " " << Bits[n];
+      }
+    }
+
+    // the midpoint between a finite value and the next one of larger magnitude
+    for (size_t n = 0; n < N; n++) {
+      if ((Bits[n] & 0x7FFF) < InfinityBits) {
+        const unsigned short next = static_cast<unsigned short>(Bits[n] + 1);
+        Float[n] = Reference(Bits[n]) + (Reference(next) - Reference(Bits[n])) / 2;
+      } else {
+        Float[n] = 0.0f;
+      }
+    }
+
+    FromFloat(Float, BitsOutput, N);
+    for (size_t n = 0; n < N; n++) {
+      if ((Bits[n] & 0x7FFF) < InfinityBits) {
+        const unsigned short even = (Bits[n] & 1) == 0 ? Bits[n] : static_cast<unsigned short>(Bits[n] + 1);
+        ASSERT_EQ(BitsOutput[n], even) << Format << " midpoint after " << Bits[n];
+      }
+    }
+  }
+
+  void Test(size_t Offset, size_t N) {
+    Test(Offset, N, 0x7C00, MlasConvertHalfToFloatBuffer, MlasConvertFloatToHalfBuffer, HalfToFloat, "fp16");
+    Test(Offset, N, 0x7F80, MlasConvertBFloat16ToFloatBuffer, MlasConvertFloatToBFloat16Buffer, BFloat16ToFloat,
+         "bf16");
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Cast");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n = 1; n <= 40; n++) {
+      Test((n * 997) % 65536, n);
+    }
+    Test(0, 65536);
+  }
+};
+
+template <> MlasCastTest* MlasTestFixture<MlasCastTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasCastTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<uint8_t> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWorking;
+
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t BatchCount, size_t InputChannels, size_t InputHeight, size_t InputWidth, size_t FilterCount,
+            size_t Padding, float Beta) {
+    const size_t OutputHeight = InputHeight + 2 * Padding - 2;
+    const size_t OutputWidth = InputWidth + 2 * Padding - 2;
+    const size_t InputSize = InputHeight * InputWidth;
+    const size_t OutputSize = OutputHeight * OutputWidth;
+    const size_t OutputElements = BatchCount * FilterCount * OutputSize;
+
+    float* Input = BufferInput.GetBuffer(BatchCount * InputChannels * InputSize);
+    float* Filter = BufferFilter.GetBuffer(FilterCount * InputChannels * 9);
+    float* Bias = BufferBias.GetBuffer(FilterCount);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    std::default_random_engine generator(static_cast<unsigned>(InputChannels * 131 + FilterCount));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t i = 0; i < BatchCount * InputChannels * InputSize; i++) {
+      Input[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < FilterCount * InputChannels * 9; i++) {
+      Filter[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < FilterCount; i++) {
+      Bias[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < OutputElements; i++) {
+      Output[i] = OutputReference[i] = distribution(generator);
+    }
+
+    for (size_t b = 0; b < BatchCount; b++) {
+      for (size_t f = 0; f < FilterCount; f++) {
+        for (size_t oh = 0; oh < OutputHeight; oh++) {
+          for (size_t ow = 0; ow < OutputWidth; ow++) {
+            float sum = Bias[f];
+            for (size_t c = 0; c < InputChannels; c++) {
+              const float* input = Input + (b * InputChannels + c) * InputSize;
+              const float* filter = Filter + (f * InputChannels + c) * 9;
+              for (size_t ky = 0; ky < 3; ky++) {
+                size_t ih = oh + ky - Padding;
+                for (size_t kx = 0; kx < 3; kx++) {
+                  size_t iw = ow + kx - Padding;
+                  if (ih < InputHeight && iw < InputWidth) {
+                    sum += input[ih * InputWidth + iw] * filter[ky * 3 + kx];
+                  }
+                }
+              }
+            }
+            float& reference = OutputReference[(b * FilterCount + f) * OutputSize + oh * OutputWidth + ow];
+            reference = sum + Beta * reference;
+          }
+        }
+      }
+    }
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t Pads[] = {int64_t(Padding), int64_t(Padding), int64_t(Padding), int64_t(Padding)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, 1, InputChannels, InputShape, KernelShape, DilationShape, Pads,
+                    StrideShape, OutputShape, FilterCount, &Activation, &WorkingBufferSize, Beta, threadpool_);
+
+    ASSERT_TRUE(MlasConvWinogradIsSupported(&Parameters));
+
+    void* PackedFilter = BufferPackedFilter.GetBuffer(MlasConvWinogradPackFilterSize(FilterCount, InputChannels));
+    MlasConvWinogradPackFilter(FilterCount, InputChannels, Filter, PackedFilter);
+
+    float* WorkingBuffer = BufferWorking.GetBuffer(MlasConvWinogradWorkingBufferSize(&Parameters, threadpool_));
+
+    MlasConvWinograd(&Parameters, Input, PackedFilter, Bias, WorkingBuffer, Output, threadpool_);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_NEAR(Output[i], OutputReference[i], 1e-4f * (1.0f + InputChannels))
+          << "@" << i << ", B" << BatchCount << "/C" << InputChannels << "/H" << InputHeight << "/W" << InputWidth
+          << "/F" << FilterCount << "/Pad" << Padding << "/Beta" << Beta;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Conv2dWinograd_Threaded" : "Conv2dWinograd_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasConv2DWinogradTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t padding : {0, 1}) {
+      Test(1, 1, 3, 3, 1, padding, 0.0f);
+      Test(1, 3, 7, 9, 5, padding, 0.0f);
+      Test(2, 16, 14, 14, 32, padding, 0.0f);
+      Test(1, 17, 23, 11, 9, padding, 1.0f);
+      Test(1, 64, 28, 28, 64, padding, 0.0f);
+    }
+    Test(1, 8, 1, 1, 8, 1, 0.0f);
+  }
+};
+
+template <> MlasConv2DWinogradTest<false>* MlasTestFixture<MlasConv2DWinogradTest<false>>::mlas_tester(nullptr);
+template <> MlasConv2DWinogradTest<true>* MlasTestFixture<MlasConv2DWinogradTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
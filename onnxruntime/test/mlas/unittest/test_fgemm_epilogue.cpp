@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+
+template <bool Threaded>
+class MlasSgemmEpilogueTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferResidual;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  static float Activate(MLAS_ACTIVATION_KIND kind, float x) {
+    switch (kind) {
+      case MlasReluActivation:
+        return std::max(x, 0.0f);
+      case MlasGeluActivation:
+        return 0.5f * x * (1.0f + std::erf(x * 0.7071067811865475f));
+      case MlasFastGeluActivation:
+        return 0.5f * x * (1.0f + std::tanh(0.7978845608028654f * (x + 0.044715f * x * x * x)));
+      case MlasLogisticActivation:
+        return 1.0f / (1.0f + std::exp(-x));
+      default:
+        return x;
+    }
+  }
+
+  void Test(bool trans_a, bool packed, size_t M, size_t N, size_t K, float beta,
+            MLAS_ACTIVATION_KIND kind, bool with_bias, bool with_residual) {
+    const float* A = BufferA.GetBuffer(K * M);
+    const float* B = BufferB.GetBuffer(N * K);
+    const float* Bias = BufferBias.GetBuffer(N);
+    const float* Residual = BufferResidual.GetBuffer(N * M);
+    float* C = BufferC.GetBuffer(N * M);
+    float* CReference = BufferCReference.GetBuffer(N * M);
+
+    std::fill_n(C, M * N, 0.5f);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          sum += (trans_a ? A[k * M + m] : A[m * K + k]) * B[k * N + n];
+        }
+        sum += beta * 0.5f;
+        if (with_bias) {
+          sum += Bias[n];
+        }
+        sum = Activate(kind, sum);
+        if (with_residual) {
+          sum += Residual[m * N + n];
+        }
+        CReference[m * N + n] = sum;
+      }
+    }
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = kind;
+
+    MLAS_SGEMM_EPILOGUE Epilogue;
+    Epilogue.Bias = with_bias ? Bias : nullptr;
+    Epilogue.Activation = &Activation;
+    Epilogue.Residual = with_residual ? Residual : nullptr;
+    Epilogue.ldr = N;
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = trans_a ? M : K;
+    Data.B = B;
+    Data.ldb = N;
+    Data.C = C;
+    Data.ldc = N;
+    Data.beta = beta;
+    Data.Epilogue = &Epilogue;
+
+    if (packed) {
+      void* PackedB = BufferBPacked.GetBuffer(MlasGemmPackBSize(N, K), true);
+      MlasGemmPackB(CblasNoTrans, N, K, B, N, PackedB);
+      Data.B = static_cast<const float*>(PackedB);
+      Data.ldb = 0;
+      Data.BIsPacked = true;
+    }
+
+    MlasGemm(trans_a ? CblasTrans : CblasNoTrans, CblasNoTrans, M, N, K, Data, threadpool_);
+
+    for (size_t f = 0; f < M * N; f++) {
+      ASSERT_NEAR(C[f], CReference[f], 1e-4f * (1.0f + K))
+          << "@[" << f << "], TransA=" << trans_a << ", Packed=" << packed << ", M=" << M << ", N=" << N
+          << ", K=" << K << ", Beta=" << beta << ", Kind=" << int(kind) << ", Bias=" << with_bias
+          << ", Residual=" << with_residual;
+    }
+  }
+
+ public:
+  MlasSgemmEpilogueTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SgemmEpilogue_Threaded" : "SgemmEpilogue_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_ACTIVATION_KIND kind : {MlasIdentityActivation, MlasReluActivation, MlasLogisticActivation,
+                                      MlasGeluActivation, MlasFastGeluActivation}) {
+      for (bool trans_a : {false, true}) {
+        for (bool packed : {false, true}) {
+          Test(trans_a, packed, 1, 37, 19, 0.0f, kind, true, true);
+          Test(trans_a, packed, 17, 1, 33, 1.0f, kind, true, false);
+          Test(trans_a, packed, 25, 150, 3, 0.0f, kind, false, true);
+          Test(trans_a, packed, 40, 300, 260, 2.0f, kind, true, true);
+          Test(trans_a, packed, 7, 9, 0, 1.0f, kind, true, true);
+        }
+      }
+    }
+  }
+};
+
+template <> MlasSgemmEpilogueTest<false>* MlasTestFixture<MlasSgemmEpilogueTest<false>>::mlas_tester(nullptr);
+template <> MlasSgemmEpilogueTest<true>* MlasTestFixture<MlasSgemmEpilogueTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -70,6 +70,10 @@ class FgemmShortExecuteTest : public MlasTestFixture<MlasFgemmTest<T, Packed, Th
     test_registered += RegisterTestTransposeABProduct(128, 3072, 768, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(128, 768, 3072, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(25, 81, 79, 7, 1.0f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(64, 64, 64, 24, 1.0f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(17, 37, 1, 5, 0.5f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(9, 67, 3, 11, 1.5f, 2.0f);
+    test_registered += RegisterTestTransposeABProduct(33, 19, 4, 2, 1.0f, 1.0f);
     return test_registered;
   }
 
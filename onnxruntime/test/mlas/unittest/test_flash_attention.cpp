@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferQuery;
+  MatrixGuardBuffer<float> BufferKey;
+  MatrixGuardBuffer<float> BufferValue;
+  MatrixGuardBuffer<float> BufferMask;
+  MatrixGuardBuffer<float> BufferExtraAdd;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWorking;
+  std::vector<float> Probabilities;
+
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t BatchCount, size_t HeadCount, size_t SequenceLength, size_t KvSequenceLength,
+            size_t QkHeadSize, size_t VHeadSize, bool WithMask, bool BroadcastMask, bool WithExtraAdd, bool Causal) {
+    const size_t QuerySize = BatchCount * HeadCount * SequenceLength * QkHeadSize;
+    const size_t KeySize = BatchCount * HeadCount * KvSequenceLength * QkHeadSize;
+    const size_t ValueSize = BatchCount * HeadCount * KvSequenceLength * VHeadSize;
+    const size_t MaskSize = BatchCount * SequenceLength * KvSequenceLength;
+    const size_t ExtraAddSize = BatchCount * HeadCount * SequenceLength * KvSequenceLength;
+    const size_t OutputSize = BatchCount * SequenceLength * HeadCount * VHeadSize;
+
+    float* Query = BufferQuery.GetBuffer(QuerySize);
+    float* Key = BufferKey.GetBuffer(KeySize);
+    float* Value = BufferValue.GetBuffer(ValueSize);
+    float* Mask = BufferMask.GetBuffer(MaskSize);
+    float* ExtraAdd = BufferExtraAdd.GetBuffer(ExtraAddSize);
+    float* Output = BufferOutput.GetBuffer(OutputSize);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(SequenceLength * 131 + KvSequenceLength));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t i = 0; i < QuerySize; i++) {
+      Query[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < KeySize; i++) {
+      Key[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < ValueSize; i++) {
+      Value[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < MaskSize; i++) {
+      Mask[i] = (i % 5 == 2) ? -10000.0f : 0.0f;
+    }
+    for (size_t i = 0; i < ExtraAddSize; i++) {
+      ExtraAdd[i] = distribution(generator);
+    }
+
+    MLAS_FLASH_ATTENTION_PARAMS Params;
+    Params.BatchCount = BatchCount;
+    Params.HeadCount = HeadCount;
+    Params.SequenceLength = SequenceLength;
+    Params.KvSequenceLength = KvSequenceLength;
+    Params.QkHeadSize = QkHeadSize;
+    Params.VHeadSize = VHeadSize;
+    Params.Scale = 1.0f / std::sqrt(static_cast<float>(QkHeadSize));
+    Params.Query = Query;
+    Params.Key = Key;
+    Params.Value = Value;
+    Params.Mask = WithMask ? Mask : nullptr;
+    Params.MaskBatchStride = BroadcastMask ? KvSequenceLength : SequenceLength * KvSequenceLength;
+    Params.MaskRowStride = BroadcastMask ? 0 : KvSequenceLength;
+    Params.ExtraAdd = WithExtraAdd ? ExtraAdd : nullptr;
+    Params.Causal = Causal;
+    Params.Output = Output;
+
+    // Reference attention with the full matrix of probabilities.
+    Probabilities.resize(KvSequenceLength);
+
+    for (size_t b = 0; b < BatchCount; b++) {
+      for (size_t n = 0; n < HeadCount; n++) {
+        const size_t bn = b * HeadCount + n;
+        for (size_t s = 0; s < SequenceLength; s++) {
+          const float* q = Query + (bn * SequenceLength + s) * QkHeadSize;
+          float Maximum = std::numeric_limits<float>::lowest();
+          for (size_t t = 0; t < KvSequenceLength; t++) {
+            const float* k = Key + (bn * KvSequenceLength + t) * QkHeadSize;
+            float score = 0.0f;
+            for (size_t h = 0; h < QkHeadSize; h++) {
+              score += q[h] * k[h];
+            }
+            score *= Params.Scale;
+            if (Causal && t > KvSequenceLength - SequenceLength + s) {
+              score = Params.CausalMaskValue;
+            }
+            if (WithMask) {
+              score += Mask[b * Params.MaskBatchStride + s * Params.MaskRowStride + t];
+            }
+            if (WithExtraAdd) {
+              score += ExtraAdd[(bn * SequenceLength + s) * KvSequenceLength + t];
+            }
+            Probabilities[t] = score;
+            Maximum = std::max(Maximum, score);
+          }
+          double Sum = 0.0;
+          for (size_t t = 0; t < KvSequenceLength; t++) {
+            Probabilities[t] = std::exp(Probabilities[t] - Maximum);
+            Sum += Probabilities[t];
+          }
+          float* o = OutputReference + ((b * SequenceLength + s) * HeadCount + n) * VHeadSize;
+          for (size_t h = 0; h < VHeadSize; h++) {
+            double value = 0.0;
+            for (size_t t = 0; t < KvSequenceLength; t++) {
+              value += Probabilities[t] * Value[(bn * KvSequenceLength + t) * VHeadSize + h];
+            }
+            o[h] = static_cast<float>(value / Sum);
+          }
+        }
+      }
+    }
+
+    float* WorkingBuffer = BufferWorking.GetBuffer(MlasFlashAttentionWorkingBufferSize(&Params, threadpool_));
+    MlasFlashAttention(&Params, WorkingBuffer, threadpool_);
+
+    for (size_t i = 0; i < OutputSize; i++) {
+      ASSERT_NEAR(Output[i], OutputReference[i], 1e-5f)
+          << "@" << i << ", B" << BatchCount << "/N" << HeadCount << "/S" << SequenceLength << "/T" << KvSequenceLength
+          << "/H" << QkHeadSize << "x" << VHeadSize << "/Mask" << WithMask << "/BroadcastMask" << BroadcastMask
+          << "/ExtraAdd" << WithExtraAdd << "/Causal" << Causal;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "FlashAttention_Threaded" : "FlashAttention_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasFlashAttentionTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (bool Causal : {false, true}) {
+      Test(1, 1, 1, 1, 8, 8, false, false, false, Causal);
+      Test(2, 3, 5, 9, 16, 12, true, true, false, Causal);
+      Test(1, 2, 33, 33, 8, 8, true, false, true, Causal);
+      Test(2, 2, 70, 300, 32, 32, true, true, true, Causal);
+      Test(1, 4, 129, 129, 64, 64, false, false, false, Causal);
+      Test(1, 2, 40, 200, 24, 40, false, false, true, Causal);
+      Test(1, 1, 64, 257, 16, 16, true, false, false, Causal);
+    }
+  }
+};
+
+template <> MlasFlashAttentionTest<false>* MlasTestFixture<MlasFlashAttentionTest<false>>::mlas_tester(nullptr);
+template <> MlasFlashAttentionTest<true>* MlasTestFixture<MlasFlashAttentionTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <cstring>
+
+class MlasHalfGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<MLAS_FP16> BufferA;
+  MatrixGuardBuffer<MLAS_FP16> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<MLAS_FP16> BufferBias;
+  MatrixGuardBuffer<MLAS_FP16> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  static float ToFloat(MLAS_FP16 value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    const uint32_t mantissa = value & 0x3FF;
+    float result;
+    if (exponent == 0) {
+      result = std::ldexp(static_cast<float>(mantissa), -24);
+    } else if (exponent == 0x1F) {
+      result = mantissa == 0 ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    } else {
+      result = std::ldexp(static_cast<float>(mantissa | 0x400), static_cast<int>(exponent) - 25);
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &result, sizeof(bits));
+    bits |= sign;
+    std::memcpy(&result, &bits, sizeof(bits));
+    return result;
+  }
+
+  // only used for values in [-1, 1], so overflow and subnormals need no care
+  static MLAS_FP16 FromFloat(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+    if (exponent <= 0) {
+      return static_cast<MLAS_FP16>(sign);
+    }
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | ((bits >> 13) & 0x3FF);
+    // round to nearest even
+    const uint32_t remainder = bits & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1) != 0)) {
+      half++;
+    }
+    return static_cast<MLAS_FP16>(sign | half);
+  }
+
+  void Test(size_t BatchSize, size_t M, size_t N, size_t K, bool PackB, bool WithBias) {
+    const MLAS_FP16* A = BufferA.GetBuffer(K * M * BatchSize);
+    const MLAS_FP16* B = BufferB.GetBuffer(N * K * BatchSize);
+    const MLAS_FP16* Bias = WithBias ? BufferBias.GetBuffer(N * BatchSize) : nullptr;
+    MLAS_FP16* C = BufferC.GetBuffer(N * M * BatchSize);
+    float* CReference = BufferCReference.GetBuffer(N * M * BatchSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 97 + N * 13 + K));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    auto fill = [&](const MLAS_FP16* buffer, size_t count) {
+      MLAS_FP16* p = const_cast<MLAS_FP16*>(buffer);
+      for (size_t i = 0; i < count; i++) {
+        p[i] = FromFloat(distribution(generator));
+      }
+    };
+
+    fill(A, K * M * BatchSize);
+    fill(B, N * K * BatchSize);
+    if (WithBias) {
+      fill(Bias, N * BatchSize);
+    }
+
+    std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(BatchSize);
+    const size_t PackedBSize = MlasHalfGemmPackBSize(N, K);
+    uint8_t* PackedB = PackB ? BufferPackedB.GetBuffer(PackedBSize * BatchSize) : nullptr;
+
+    for (size_t i = 0; i < BatchSize; i++) {
+      data[i].A = A + K * M * i;
+      data[i].lda = K;
+      data[i].C = C + N * M * i;
+      data[i].ldc = N;
+      data[i].Bias = WithBias ? Bias + N * i : nullptr;
+      if (PackB) {
+        MlasHalfGemmPackB(CblasNoTrans, N, K, B + N * K * i, N, PackedB + PackedBSize * i);
+        data[i].B = PackedB + PackedBSize * i;
+        data[i].BIsPacked = true;
+      } else {
+        data[i].B = B + N * K * i;
+        data[i].ldb = N;
+      }
+    }
+
+    MlasHalfGemmBatch(M, N, K, BatchSize, data.data(), GetMlasThreadPool());
+
+    for (size_t i = 0; i < BatchSize; i++) {
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          float sum = WithBias ? ToFloat(Bias[N * i + n]) : 0.0f;
+          for (size_t k = 0; k < K; k++) {
+            sum += ToFloat(A[K * M * i + m * K + k]) * ToFloat(B[N * K * i + k * N + n]);
+          }
+          CReference[N * M * i + m * N + n] = sum;
+        }
+      }
+    }
+
+    // half precision accumulation loses precision with the length of the dot product
+    const float tolerance = 0.02f + 0.005f * std::sqrt(static_cast<float>(K));
+
+    for (size_t f = 0; f < M * N * BatchSize; f++) {
+      const float expected = CReference[f];
+      ASSERT_NEAR(ToFloat(C[f]), expected, tolerance + std::fabs(expected) * 0.01f)
+          << "@[" << f << "], Batch=" << BatchSize << ", M=" << M << ", N=" << N << ", K=" << K
+          << ", PackB=" << PackB << ", Bias=" << WithBias;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("HalfGemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 3, 8, 9, 17}) {
+      for (size_t N : {1, 15, 32, 33, 130}) {
+        for (size_t K : {0, 1, 7, 128, 129, 300}) {
+          Test(1, M, N, K, false, false);
+          Test(1, M, N, K, true, true);
+        }
+      }
+    }
+    Test(3, 16, 80, 129, false, true);
+    Test(3, 16, 80, 129, true, false);
+  }
+};
+
+template <> MlasHalfGemmTest* MlasTestFixture<MlasHalfGemmTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasHalfGemmTest>::RegisterShortExecute();
+  }
+  return count;
+});
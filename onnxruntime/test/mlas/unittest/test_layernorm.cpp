@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferGamma;
+  MatrixGuardBuffer<float> BufferBeta;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWork;
+  MatrixGuardBuffer<unsigned short> BufferHalf;
+  MatrixGuardBuffer<unsigned short> BufferHalfOutput;
+  std::default_random_engine generator_{42};
+
+  void Fill(float* Buffer, size_t N, float Low, float High) {
+    std::uniform_real_distribution<float> distribution(Low, High);
+    for (size_t n = 0; n < N; n++) {
+      Buffer[n] = distribution(generator_);
+    }
+  }
+
+  // Rounds the values to half precision, so that the half precision variant sees the same inputs as the reference.
+  void RoundToHalf(float* Buffer, size_t N) {
+    unsigned short* Half = BufferHalf.GetBuffer(N);
+    MlasConvertFloatToHalfBuffer(Buffer, Half, N);
+    MlasConvertHalfToFloatBuffer(Half, Buffer, N);
+  }
+
+  static void Reference(const float* Input, const float* Skip, const float* Bias, const float* Gamma,
+                        const float* Beta, float* Output, size_t N, float Epsilon, bool Simplified,
+                        double& Mean, double& InvStdDev) {
+    std::vector<double> values(N);
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    for (size_t n = 0; n < N; n++) {
+      values[n] = double(Input[n]) + (Skip ? Skip[n] : 0.0f) + (Bias ? Bias[n] : 0.0f);
+      sum += values[n];
+      sum_squares += values[n] * values[n];
+    }
+    Mean = Simplified ? 0.0 : sum / N;
+    InvStdDev = 1.0 / std::sqrt(sum_squares / N - Mean * Mean + Epsilon);
+    for (size_t n = 0; n < N; n++) {
+      const double beta = (Beta != nullptr && !Simplified) ? Beta[n] : 0.0;
+      Output[n] = static_cast<float>((values[n] - Mean) * InvStdDev * Gamma[n] + beta);
+    }
+  }
+
+  void Test(size_t N, bool UseSkip, bool UseBias, bool UseBeta, bool Simplified, bool Half) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Skip = BufferSkip.GetBuffer(N);
+    float* Bias = BufferBias.GetBuffer(N);
+    float* Gamma = BufferGamma.GetBuffer(N);
+    float* Beta = BufferBeta.GetBuffer(N);
+    float* Output = BufferOutput.GetBuffer(N);
+    float* OutputReference = BufferOutputReference.GetBuffer(N);
+
+    // an offset mean, which the variance of a single pass has to cope with
+    Fill(Input, N, 1.0f, 3.0f);
+    Fill(Skip, N, -1.0f, 1.0f);
+    Fill(Bias, N, -0.5f, 0.5f);
+    Fill(Gamma, N, 0.5f, 1.5f);
+    Fill(Beta, N, -1.0f, 1.0f);
+
+    if (Half) {
+      RoundToHalf(Input, N);
+      RoundToHalf(Skip, N);
+      RoundToHalf(Bias, N);
+      RoundToHalf(Gamma, N);
+      RoundToHalf(Beta, N);
+    }
+
+    const float Epsilon = 1e-5f;
+    const float* SkipArg = UseSkip ? Skip : nullptr;
+    const float* BiasArg = UseBias ? Bias : nullptr;
+    const float* BetaArg = UseBeta ? Beta : nullptr;
+
+    double MeanReference;
+    double InvStdDevReference;
+    Reference(Input, SkipArg, BiasArg, Gamma, BetaArg, OutputReference, N, Epsilon, Simplified,
+              MeanReference, InvStdDevReference);
+
+    float Mean;
+    float InvStdDev;
+    float Tolerance;
+
+    if (Half) {
+      std::vector<unsigned short> input(N), skip(N), bias(N), gamma(N), beta(N);
+      MlasConvertFloatToHalfBuffer(Input, input.data(), N);
+      MlasConvertFloatToHalfBuffer(Skip, skip.data(), N);
+      MlasConvertFloatToHalfBuffer(Bias, bias.data(), N);
+      MlasConvertFloatToHalfBuffer(Gamma, gamma.data(), N);
+      MlasConvertFloatToHalfBuffer(Beta, beta.data(), N);
+
+      unsigned short* HalfOutput = BufferHalfOutput.GetBuffer(N);
+      MlasLayerNormalizationHalf(input.data(), UseSkip ? skip.data() : nullptr, UseBias ? bias.data() : nullptr,
+                                 gamma.data(), UseBeta ? beta.data() : nullptr, HalfOutput, N, Epsilon, Simplified,
+                                 &Mean, &InvStdDev, BufferWork.GetBuffer(N));
+      MlasConvertHalfToFloatBuffer(HalfOutput, Output, N);
+
+      // the output is rounded to half precision
+      Tolerance = 2e-3f;
+    } else {
+      MlasLayerNormalization(Input, SkipArg, BiasArg, Gamma, BetaArg, Output, N, Epsilon, Simplified,
+                             &Mean, &InvStdDev);
+      Tolerance = 1e-4f;
+    }
+
+    ASSERT_NEAR(Mean, MeanReference, 1e-4 * (1.0 + std::fabs(MeanReference)))
+        << "N=" << N << " Simplified=" << Simplified << " Half=" << Half;
+    ASSERT_NEAR(InvStdDev, InvStdDevReference, 1e-4 * InvStdDevReference)
+        << "N=" << N << " Simplified=" << Simplified << " Half=" << Half;
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_NEAR(Output[n], OutputReference[n], Tolerance * (1.0f + std::fabs(OutputReference[n])))
+          << "n=" << n << " N=" << N << " Skip=" << UseSkip << " Bias=" << UseBias << " Beta=" << UseBeta
+          << " Simplified=" << Simplified << " Half=" << Half;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("LayerNorm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool Half : {false, true}) {
+      for (size_t n = 1; n <= 20; n++) {
+        Test(n, true, true, true, false, Half);
+        Test(n, false, false, false, true, Half);
+      }
+      for (size_t n : {255, 256, 257, 768, 1023}) {
+        for (int flags = 0; flags < 8; flags++) {
+          Test(n, (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0, false, Half);
+        }
+        Test(n, false, false, false, true, Half);
+        Test(n, true, true, false, true, Half);
+      }
+    }
+  }
+};
+
+template <> MlasLayerNormTest* MlasTestFixture<MlasLayerNormTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasLayerNormTest>::RegisterShortExecute() : 0;
+});
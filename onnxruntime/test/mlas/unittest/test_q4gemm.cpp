@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+
+class MlasQ4GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferQuantBData;
+  MatrixGuardBuffer<float> BufferQuantBScale;
+  MatrixGuardBuffer<uint8_t> BufferQuantBZeroPoint;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  void Test(size_t BatchSize, size_t M, size_t N, size_t K, size_t BlkLen, bool WithZeroPoint, bool WithBias) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t DataSize = N * BlockCountK * (BlkLen / 2);
+    const size_t ScaleSize = N * BlockCountK;
+    const size_t ZeroPointSize = N * ((BlockCountK + 1) / 2);
+
+    const float* A = BufferA.GetBuffer(K * M * BatchSize);
+    const float* B = BufferB.GetBuffer(N * K * BatchSize);
+    uint8_t* QuantBData = BufferQuantBData.GetBuffer(DataSize * BatchSize);
+    float* QuantBScale = BufferQuantBScale.GetBuffer(ScaleSize * BatchSize);
+    uint8_t* QuantBZeroPoint = WithZeroPoint ? BufferQuantBZeroPoint.GetBuffer(ZeroPointSize * BatchSize) : nullptr;
+    const float* Bias = WithBias ? BufferBias.GetBuffer(N * BatchSize) : nullptr;
+    float* C = BufferC.GetBuffer(N * M * BatchSize);
+    float* CReference = BufferCReference.GetBuffer(N * M * BatchSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 97 + N * 13 + K * 7 + BlkLen));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    auto fill = [&](const float* buffer, size_t count, float offset) {
+      float* p = const_cast<float*>(buffer);
+      for (size_t i = 0; i < count; i++) {
+        p[i] = distribution(generator) + offset;
+      }
+    };
+
+    fill(A, K * M * BatchSize, 0.0f);
+    // skewed weights exercise the zero points
+    fill(B, N * K * BatchSize, WithZeroPoint ? 0.5f : 0.0f);
+    if (WithBias) {
+      fill(Bias, N * BatchSize, 0.0f);
+    }
+
+    std::vector<MLAS_Q4GEMM_DATA_PARAMS> data(BatchSize);
+
+    for (size_t i = 0; i < BatchSize; i++) {
+      MlasQ4GemmQuantizeB(BlkLen, N, K, B + N * K * i, N, QuantBData + DataSize * i, QuantBScale + ScaleSize * i,
+                          WithZeroPoint ? QuantBZeroPoint + ZeroPointSize * i : nullptr);
+
+      data[i].A = A + K * M * i;
+      data[i].lda = K;
+      data[i].QuantBData = QuantBData + DataSize * i;
+      data[i].QuantBScale = QuantBScale + ScaleSize * i;
+      data[i].QuantBZeroPoint = WithZeroPoint ? QuantBZeroPoint + ZeroPointSize * i : nullptr;
+      data[i].Bias = WithBias ? Bias + N * i : nullptr;
+      data[i].C = C + N * M * i;
+      data[i].ldc = N;
+    }
+
+    MlasQ4GemmBatch(M, N, K, BlkLen, BatchSize, data.data(), GetMlasThreadPool());
+
+    // element (k, n) of dequantized matrix B, decoded from the documented layout
+    auto b_at = [&](size_t batch, size_t k, size_t n) {
+      const size_t block = k / BlkLen;
+      const uint8_t packed = QuantBData[DataSize * batch + (n * BlockCountK + block) * (BlkLen / 2) + (k % BlkLen) / 2];
+      const int q = (k & 1) ? (packed >> 4) : (packed & 0x0F);
+      int zero_point = 8;
+      if (WithZeroPoint) {
+        const uint8_t zp = QuantBZeroPoint[ZeroPointSize * batch + n * ((BlockCountK + 1) / 2) + block / 2];
+        zero_point = (block & 1) ? (zp >> 4) : (zp & 0x0F);
+      }
+      return static_cast<float>(q - zero_point) * QuantBScale[ScaleSize * batch + n * BlockCountK + block];
+    };
+
+    for (size_t i = 0; i < BatchSize; i++) {
+      for (size_t k = 0; k < K; k++) {
+        for (size_t n = 0; n < N; n++) {
+          // a step of the block range bounds the rounding and the clamping of the symmetric maximum
+          const float step = (WithZeroPoint ? 2.0f / 15.0f : 1.0f / 8.0f) * 1.01f;
+          ASSERT_NEAR(b_at(i, k, n), B[N * K * i + k * N + n], step) << "quantize @k=" << k << ", n=" << n;
+        }
+      }
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          float sum = WithBias ? Bias[N * i + n] : 0.0f;
+          for (size_t k = 0; k < K; k++) {
+            sum += A[K * M * i + m * K + k] * b_at(i, k, n);
+          }
+          CReference[N * M * i + m * N + n] = sum;
+        }
+      }
+    }
+
+    const float tolerance = 1e-5f * (1.0f + static_cast<float>(K));
+
+    for (size_t f = 0; f < M * N * BatchSize; f++) {
+      ASSERT_NEAR(C[f], CReference[f], tolerance)
+          << "@[" << f << "], Batch=" << BatchSize << ", M=" << M << ", N=" << N << ", K=" << K
+          << ", BlkLen=" << BlkLen << ", ZeroPoint=" << WithZeroPoint << ", Bias=" << WithBias;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Q4Gemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t BlkLen : {32, 64, 128, 256}) {
+      EXPECT_TRUE(MlasQ4GemmIsBlkLenSupported(BlkLen));
+      for (size_t M : {1, 3, 4, 5, 32, 33}) {
+        for (size_t N : {1, 17, 64, 130}) {
+          for (size_t K : {0, 1, 31, 32, 100, 256, 513}) {
+            Test(1, M, N, K, BlkLen, false, false);
+            Test(1, M, N, K, BlkLen, true, true);
+          }
+        }
+      }
+    }
+    EXPECT_FALSE(MlasQ4GemmIsBlkLenSupported(16));
+    Test(3, 4, 80, 300, 32, true, false);
+    Test(3, 40, 80, 300, 128, false, true);
+  }
+};
+
+template <> MlasQ4GemmTest* MlasTestFixture<MlasQ4GemmTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasGemmS16S8Test : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<int16_t> BufferA;
+  MatrixGuardBuffer<int8_t> BufferB;
+  MatrixGuardBuffer<int8_t> BufferZeroPointB;
+  MatrixGuardBuffer<int32_t> BufferC;
+  MatrixGuardBuffer<int32_t> BufferCReference;
+
+  void Test(size_t BatchSize, size_t M, size_t N, size_t K, int16_t ZeroPointA, bool PerColumnZeroPoints) {
+    int16_t* A = BufferA.GetBuffer(BatchSize * M * K);
+    int8_t* B = BufferB.GetBuffer(BatchSize * K * N);
+    int8_t* ZeroPointB = BufferZeroPointB.GetBuffer(N);
+    int32_t* C = BufferC.GetBuffer(BatchSize * M * N, true);
+    int32_t* CReference = BufferCReference.GetBuffer(BatchSize * M * N, true);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 1000003 + N * 1009 + K));
+    std::uniform_int_distribution<int> a_distribution(-4096, 4095);
+    std::uniform_int_distribution<int> b_distribution(-128, 127);
+
+    for (size_t i = 0; i < BatchSize * M * K; i++) {
+      A[i] = static_cast<int16_t>(a_distribution(generator));
+    }
+    for (size_t i = 0; i < BatchSize * K * N; i++) {
+      B[i] = static_cast<int8_t>(b_distribution(generator));
+    }
+    for (size_t n = 0; n < N; n++) {
+      ZeroPointB[n] = static_cast<int8_t>(b_distribution(generator));
+    }
+
+    std::vector<MLAS_GEMM_S16S8_DATA_PARAMS> DataParams(BatchSize);
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      auto& params = DataParams[batch];
+      params.A = A + batch * M * K;
+      params.lda = K;
+      params.ZeroPointA = ZeroPointA;
+      params.B = B + batch * K * N;
+      params.ldb = N;
+      params.ZeroPointB = ZeroPointB;
+      params.PerColumnZeroPoints = PerColumnZeroPoints;
+      params.C = C + batch * M * N;
+      params.ldc = N;
+
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          const int32_t zero_point_b = ZeroPointB[PerColumnZeroPoints ? n : 0];
+          int32_t sum = 0;
+          for (size_t k = 0; k < K; k++) {
+            sum += (int32_t(params.A[m * K + k]) - ZeroPointA) * (int32_t(params.B[k * N + n]) - zero_point_b);
+          }
+          CReference[batch * M * N + m * N + n] = sum;
+        }
+      }
+    }
+
+    MlasGemmS16S8Batch(M, N, K, DataParams.data(), BatchSize, Threaded ? GetMlasThreadPool() : nullptr);
+
+    for (size_t i = 0; i < BatchSize * M * N; i++) {
+      ASSERT_EQ(C[i], CReference[i]) << "@" << i << ", batch=" << BatchSize << ", M=" << M << ", N=" << N
+                                     << ", K=" << K << ", zero point A=" << ZeroPointA;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "GemmS16S8_Threaded" : "GemmS16S8_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 2, 3, 4, 5, 7, 16}) {
+      for (size_t N : {1, 7, 8, 9, 16, 17, 40}) {
+        for (size_t K : {1, 2, 3, 16, 31, 255, 256, 257, 600}) {
+          Test(1, M, N, K, 0, false);
+          Test(1, M, N, K, -17, true);
+        }
+      }
+    }
+    Test(3, 33, 70, 129, 123, false);
+    Test(2, 64, 24, 1024, -5, true);
+    Test(1, 0, 16, 16, 0, false);
+    Test(1, 16, 16, 0, 3, false);
+  }
+};
+
+template <> MlasGemmS16S8Test<false>* MlasTestFixture<MlasGemmS16S8Test<false>>::mlas_tester(nullptr);
+template <> MlasGemmS16S8Test<true>* MlasTestFixture<MlasGemmS16S8Test<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasGemmS16S8Test<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasGemmS16S8Test<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasQLinearLookupTableTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferInput;
+  MatrixGuardBuffer<uint8_t> BufferOutput;
+
+  void Test(size_t N) {
+    uint8_t* Input = BufferInput.GetBuffer(N);
+    uint8_t* Output = BufferOutput.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_int_distribution<int> distribution(0, 255);
+
+    uint8_t Table[256];
+    for (size_t i = 0; i < 256; i++) {
+      Table[i] = static_cast<uint8_t>(distribution(generator));
+    }
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = static_cast<uint8_t>(distribution(generator));
+    }
+
+    MlasQLinearLookupTable(Input, Table, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_EQ(Output[n], Table[Input[n]]) << " @" << n << " of " << N << ", input " << int(Input[n]);
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("QLinearLookupTable");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n = 1; n < 128; n++) {
+      Test(n);
+    }
+    Test(1000);
+  }
+};
+
+template <> MlasQLinearLookupTableTest* MlasTestFixture<MlasQLinearLookupTableTest>::mlas_tester(nullptr);
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasQLinearLookupTableTest>::RegisterShortExecute() : 0;
+});
@@ -52,7 +52,9 @@ class MlasQuantizeLinearTest : public MlasTestBase {
 
  public:
   static const char* GetTestSuiteName() {
-    static const std::string suite_name(std::is_signed<xint8_t>::value ? "QuantizeLinearS8" : "QuantizeLinearU8");
+    static const std::string suite_name(std::is_same<xint8_t, int16_t>::value ? "QuantizeLinearS16"
+                                        : std::is_signed<xint8_t>::value    ? "QuantizeLinearS8"
+                                                                            : "QuantizeLinearU8");
     return suite_name.c_str();
   }
 
@@ -65,12 +67,14 @@ class MlasQuantizeLinearTest : public MlasTestBase {
 
 template <> MlasQuantizeLinearTest<int8_t>* MlasTestFixture<MlasQuantizeLinearTest<int8_t>>::mlas_tester(nullptr);
 template <> MlasQuantizeLinearTest<uint8_t>* MlasTestFixture<MlasQuantizeLinearTest<uint8_t>>::mlas_tester(nullptr);
+template <> MlasQuantizeLinearTest<int16_t>* MlasTestFixture<MlasQuantizeLinearTest<int16_t>>::mlas_tester(nullptr);
 
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
   size_t count = 0;
   if (is_short_execute) {
       count += MlasDirectShortExecuteTests<MlasQuantizeLinearTest<int8_t>>::RegisterShortExecute();
       count += MlasDirectShortExecuteTests<MlasQuantizeLinearTest<uint8_t>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasQuantizeLinearTest<int16_t>>::RegisterShortExecute();
   }
   return count;
 });
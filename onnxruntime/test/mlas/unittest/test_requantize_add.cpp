@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <typename OutputType>
+class MlasRequantizeOutputAddTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<int32_t> BufferInput;
+  MatrixGuardBuffer<OutputType> BufferAddend;
+  MatrixGuardBuffer<OutputType> BufferOutput;
+  MatrixGuardBuffer<OutputType> BufferOutputReference;
+  MatrixGuardBuffer<int32_t> BufferBias;
+  MatrixGuardBuffer<float> BufferScale;
+
+  void Test(size_t M, size_t N, bool HasBias, bool PerColumnScale) {
+    const size_t ld = N + 3;
+    int32_t* Input = BufferInput.GetBuffer(M * ld);
+    OutputType* Addend = BufferAddend.GetBuffer(M * ld);
+    OutputType* Output = BufferOutput.GetBuffer(M * ld, true);
+    OutputType* OutputReference = BufferOutputReference.GetBuffer(M * ld, true);
+    int32_t* Bias = HasBias ? BufferBias.GetBuffer(N) : nullptr;
+    float* Scale = BufferScale.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 1009 + N));
+    std::uniform_int_distribution<int> input_distribution(-50000, 50000);
+    std::uniform_int_distribution<int> addend_distribution(std::numeric_limits<OutputType>::lowest(),
+                                                           std::numeric_limits<OutputType>::max());
+    std::uniform_real_distribution<float> scale_distribution(0.0005f, 0.005f);
+
+    for (size_t i = 0; i < M * ld; i++) {
+      Input[i] = input_distribution(generator);
+      Addend[i] = static_cast<OutputType>(addend_distribution(generator));
+    }
+    for (size_t n = 0; n < N; n++) {
+      if (Bias != nullptr) {
+        Bias[n] = input_distribution(generator) / 4;
+      }
+      Scale[n] = scale_distribution(generator);
+    }
+
+    const float AddendScale = 0.75f;
+    const OutputType AddendZeroPoint = static_cast<OutputType>(addend_distribution(generator) / 4);
+    const OutputType ZeroPoint = static_cast<OutputType>(addend_distribution(generator) / 2);
+    const float MinimumValue = float(std::numeric_limits<OutputType>::lowest() - ZeroPoint);
+    const float MaximumValue = float(std::numeric_limits<OutputType>::max() - ZeroPoint);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        int32_t IntegerValue = Input[m * ld + n] + (Bias != nullptr ? Bias[n] : 0);
+        float FloatValue = float(IntegerValue) * Scale[PerColumnScale ? n : 0];
+        FloatValue += float(int32_t(Addend[m * ld + n]) - int32_t(AddendZeroPoint)) * AddendScale;
+        FloatValue = std::min(std::max(FloatValue, MinimumValue), MaximumValue);
+        OutputReference[m * ld + n] = static_cast<OutputType>(static_cast<int32_t>(std::nearbyintf(FloatValue)) +
+                                                              ZeroPoint);
+      }
+    }
+
+    MlasRequantizeOutputAdd(Input, ld, Addend, ld, Output, ld, Bias, Scale, PerColumnScale, AddendScale,
+                            AddendZeroPoint, ZeroPoint, 0, 0, M, N);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        ASSERT_EQ(Output[m * ld + n], OutputReference[m * ld + n])
+            << "@[" << m << "," << n << "], M=" << M << ", N=" << N << ", bias=" << HasBias
+            << ", per column scale=" << PerColumnScale;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::is_signed<OutputType>::value ? "RequantizeOutputAddS8"
+                                                                          : "RequantizeOutputAddU8");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 2, 5, 16}) {
+      for (size_t N : {1, 3, 4, 5, 8, 15, 16, 17, 33, 64}) {
+        Test(M, N, false, false);
+        Test(M, N, true, false);
+        Test(M, N, true, true);
+      }
+    }
+  }
+};
+
+template <> MlasRequantizeOutputAddTest<int8_t>* MlasTestFixture<MlasRequantizeOutputAddTest<int8_t>>::mlas_tester(nullptr);
+template <> MlasRequantizeOutputAddTest<uint8_t>* MlasTestFixture<MlasRequantizeOutputAddTest<uint8_t>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasRequantizeOutputAddTest<int8_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasRequantizeOutputAddTest<uint8_t>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <cstring>
+
+class MlasSBGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<MLAS_BF16> BufferA;
+  MatrixGuardBuffer<MLAS_BF16> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  static float ToFloat(MLAS_BF16 value) {
+    const uint32_t bits = static_cast<uint32_t>(value) << 16;
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+  }
+
+  // truncation is fine for test data, only the products are checked
+  static MLAS_BF16 FromFloat(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return static_cast<MLAS_BF16>(bits >> 16);
+  }
+
+  void Test(size_t BatchSize, size_t M, size_t N, size_t K, bool PackB, bool TransB, bool WithBias) {
+    const MLAS_BF16* A = BufferA.GetBuffer(K * M * BatchSize);
+    const MLAS_BF16* B = BufferB.GetBuffer(N * K * BatchSize);
+    const float* Bias = WithBias ? BufferBias.GetBuffer(N * BatchSize) : nullptr;
+    float* C = BufferC.GetBuffer(N * M * BatchSize);
+    float* CReference = BufferCReference.GetBuffer(N * M * BatchSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 97 + N * 13 + K));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    auto fill = [&](const MLAS_BF16* buffer, size_t count) {
+      MLAS_BF16* p = const_cast<MLAS_BF16*>(buffer);
+      for (size_t i = 0; i < count; i++) {
+        p[i] = FromFloat(distribution(generator));
+      }
+    };
+
+    fill(A, K * M * BatchSize);
+    fill(B, N * K * BatchSize);
+    if (WithBias) {
+      float* bias = const_cast<float*>(Bias);
+      for (size_t i = 0; i < N * BatchSize; i++) {
+        bias[i] = distribution(generator);
+      }
+    }
+
+    // element (k, n) of matrix B
+    auto b_at = [&](size_t batch, size_t k, size_t n) {
+      const MLAS_BF16* b = B + N * K * batch;
+      return ToFloat(TransB ? b[n * K + k] : b[k * N + n]);
+    };
+
+    std::vector<MLAS_SBGEMM_DATA_PARAMS> data(BatchSize);
+    const size_t PackedBSize = MlasSBGemmPackBSize(N, K);
+    uint8_t* PackedB = PackB ? BufferPackedB.GetBuffer(PackedBSize * BatchSize) : nullptr;
+
+    for (size_t i = 0; i < BatchSize; i++) {
+      data[i].A = A + K * M * i;
+      data[i].lda = K;
+      data[i].C = C + N * M * i;
+      data[i].ldc = N;
+      data[i].Bias = WithBias ? Bias + N * i : nullptr;
+      if (PackB) {
+        MlasSBGemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B + N * K * i, TransB ? K : N,
+                        PackedB + PackedBSize * i);
+        data[i].B = PackedB + PackedBSize * i;
+        data[i].BIsPacked = true;
+      } else {
+        data[i].B = B + N * K * i;
+        data[i].ldb = N;
+      }
+    }
+
+    MlasSBGemmBatch(M, N, K, BatchSize, data.data(), GetMlasThreadPool());
+
+    for (size_t i = 0; i < BatchSize; i++) {
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          float sum = WithBias ? Bias[N * i + n] : 0.0f;
+          for (size_t k = 0; k < K; k++) {
+            sum += ToFloat(A[K * M * i + m * K + k]) * b_at(i, k, n);
+          }
+          CReference[N * M * i + m * N + n] = sum;
+        }
+      }
+    }
+
+    // products of bfloat16 values are exact in single precision, only the summation order differs
+    const float tolerance = 1e-4f * (1.0f + static_cast<float>(K));
+
+    for (size_t f = 0; f < M * N * BatchSize; f++) {
+      ASSERT_NEAR(C[f], CReference[f], tolerance)
+          << "@[" << f << "], Batch=" << BatchSize << ", M=" << M << ", N=" << N << ", K=" << K
+          << ", PackB=" << PackB << ", TransB=" << TransB << ", Bias=" << WithBias;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SBGemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 3, 8, 9, 16, 17, 33}) {
+      for (size_t N : {1, 15, 16, 17, 130}) {
+        for (size_t K : {0, 1, 7, 32, 33, 128, 129, 300}) {
+          Test(1, M, N, K, false, false, false);
+          Test(1, M, N, K, true, false, true);
+          Test(1, M, N, K, true, true, false);
+        }
+      }
+    }
+    Test(3, 16, 80, 129, false, false, true);
+    Test(3, 16, 80, 129, true, true, false);
+  }
+};
+
+template <> MlasSBGemmTest* MlasTestFixture<MlasSBGemmTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSBGemmTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -97,8 +97,112 @@ class MlasSoftmaxTest : public MlasTestBase {
   }
 };
 
+class MlasAttentionSoftmaxTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferMask;
+  MatrixGuardBuffer<float> BufferExtraAdd;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+
+  void Test(size_t N, size_t D, float Scale, bool WithMask, bool WithExtraAdd, bool Causal, size_t CausalOffset) {
+    float* Input = BufferInput.GetBuffer(N * D);
+    float* Mask = BufferMask.GetBuffer(N * D);
+    float* ExtraAdd = BufferExtraAdd.GetBuffer(N * D);
+    float* Output = BufferOutput.GetBuffer(N * D);
+    float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+
+    std::default_random_engine generator(static_cast<unsigned>(N * D));
+    std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      Input[nd] = distribution(generator);
+      Mask[nd] = (nd % 7 == 3) ? -10000.0f : 0.0f;
+      ExtraAdd[nd] = distribution(generator);
+    }
+
+    MLAS_ATTENTION_SOFTMAX_PARAMS Params;
+    Params.Scale = Scale;
+    Params.Mask = WithMask ? Mask : nullptr;
+    Params.ExtraAdd = WithExtraAdd ? ExtraAdd : nullptr;
+    Params.Causal = Causal;
+    Params.CausalOffset = CausalOffset;
+
+    for (size_t n = 0; n < N; n++) {
+      const size_t Offset = n * D;
+      float MaximumValue = std::numeric_limits<float>::lowest();
+
+      for (size_t d = 0; d < D; d++) {
+        float Value = (Causal && d > CausalOffset + n) ? Params.CausalMaskValue : Input[Offset + d] * Scale;
+        if (WithMask) {
+          Value += Mask[Offset + d];
+        }
+        if (WithExtraAdd) {
+          Value += ExtraAdd[Offset + d];
+        }
+        OutputReference[Offset + d] = Value;
+        MaximumValue = (std::max)(MaximumValue, Value);
+      }
+
+      double Sum = 0.0;
+
+      for (size_t d = 0; d < D; d++) {
+        double e = std::exp(double(OutputReference[Offset + d]) - double(MaximumValue));
+        Sum += e;
+        OutputReference[Offset + d] = float(e);
+      }
+
+      for (size_t d = 0; d < D; d++) {
+        OutputReference[Offset + d] = float(OutputReference[Offset + d] / Sum);
+      }
+    }
+
+    // Check both the out of place and the in place forms.
+    for (bool InPlace : {false, true}) {
+      if (InPlace) {
+        std::copy_n(Input, N * D, Output);
+        MlasComputeAttentionSoftmax(Output, Output, N, D, &Params);
+      } else {
+        MlasComputeAttentionSoftmax(Input, Output, N, D, &Params);
+      }
+
+      constexpr float AbsoluteTolerance = 1e-6f;
+      constexpr float RelativeTolerance = 1e-5f;
+
+      for (size_t nd = 0; nd < N * D; nd++) {
+        float diff = std::fabs(Output[nd] - OutputReference[nd]);
+        ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[nd]) * RelativeTolerance)
+            << "InPlace:" << InPlace << " Mask:" << WithMask << " ExtraAdd:" << WithExtraAdd << " Causal:" << Causal
+            << " difference " << N << "/" << D << "@" << nd << ", got: " << Output[nd]
+            << ", expecting: " << OutputReference[nd];
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("AttentionSoftmax");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool WithMask : {false, true}) {
+      for (bool WithExtraAdd : {false, true}) {
+        for (size_t d = 1; d < 40; d++) {
+          Test(1, d, 0.125f, WithMask, WithExtraAdd, false, 0);
+        }
+        Test(17, 17, 0.25f, WithMask, WithExtraAdd, true, 0);
+        Test(5, 29, 1.0f, WithMask, WithExtraAdd, true, 24);
+        Test(64, 128, 0.125f, WithMask, WithExtraAdd, true, 64);
+        Test(12, 77, 0.5f, WithMask, WithExtraAdd, false, 0);
+      }
+    }
+  }
+};
+
 template <> MlasSoftmaxTest<false>* MlasTestFixture<MlasSoftmaxTest<false>>::mlas_tester(nullptr);
 template <> MlasSoftmaxTest<true>* MlasTestFixture<MlasSoftmaxTest<true>>::mlas_tester(nullptr);
+template <> MlasAttentionSoftmaxTest* MlasTestFixture<MlasAttentionSoftmaxTest>::mlas_tester(nullptr);
 
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
   size_t count = 0;
@@ -107,6 +211,7 @@ static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_exe
     if (GetMlasThreadPool() != nullptr) {
       count += MlasDirectShortExecuteTests<MlasSoftmaxTest<true>>::RegisterShortExecute();
     }
+    count += MlasDirectShortExecuteTests<MlasAttentionSoftmaxTest>::RegisterShortExecute();
   }
   return count;
 });
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <random>
+#include <vector>
+
+template <bool Threaded>
+class MlasSparseGemmTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  std::default_random_engine generator_{42};
+
+  void Test(size_t M, size_t N, size_t K, float Density, float alpha) {
+    std::uniform_real_distribution<float> value_distribution(-1.0f, 1.0f);
+    std::bernoulli_distribution nonzero_distribution(Density);
+
+    // Build A in CSR format, with a few empty rows.
+    std::vector<float> AValues;
+    std::vector<int64_t> ARowOffsets{0};
+    std::vector<int64_t> AColumnIndices;
+    for (size_t m = 0; m < M; m++) {
+      if (m % 7 != 3) {
+        for (size_t k = 0; k < K; k++) {
+          if (nonzero_distribution(generator_)) {
+            AValues.push_back(value_distribution(generator_));
+            AColumnIndices.push_back(static_cast<int64_t>(k));
+          }
+        }
+      }
+      ARowOffsets.push_back(static_cast<int64_t>(AValues.size()));
+    }
+
+    const size_t ldb = N + 3;
+    const size_t ldc = N + 5;
+    float* B = BufferB.GetBuffer(K * ldb);
+    float* C = BufferC.GetBuffer(M * ldc);
+    float* CReference = BufferCReference.GetBuffer(M * ldc);
+
+    for (size_t i = 0; i < K * ldb; i++) {
+      B[i] = value_distribution(generator_);
+    }
+    std::fill_n(C, M * ldc, -1.0f);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        for (int64_t i = ARowOffsets[m]; i < ARowOffsets[m + 1]; i++) {
+          sum += double(AValues[i]) * double(B[AColumnIndices[i] * ldb + n]);
+        }
+        CReference[m * ldc + n] = static_cast<float>(sum * alpha);
+      }
+    }
+
+    MlasSparseGemm(M, N, alpha, AValues.data(), ARowOffsets.data(), AColumnIndices.data(), B, ldb, C, ldc,
+                   threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        ASSERT_NEAR(C[m * ldc + n], CReference[m * ldc + n], 1e-5f * (1.0f + K * Density))
+            << "M=" << M << " N=" << N << " K=" << K << " Density=" << Density << " m=" << m << " n=" << n;
+      }
+      // the padding of the row is not written
+      for (size_t n = N; n < ldc; n++) {
+        ASSERT_EQ(C[m * ldc + n], -1.0f) << "M=" << M << " N=" << N << " K=" << K << " m=" << m << " n=" << n;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SparseGemm_Threaded" : "SparseGemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasSparseGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t n : {1, 3, 4, 15, 16, 17, 33, 64}) {
+      Test(9, n, 13, 0.3f, 1.0f);
+    }
+    Test(64, 48, 96, 0.1f, 0.5f);
+    Test(128, 67, 256, 0.05f, 1.0f);
+    Test(200, 128, 512, 0.2f, 2.0f);
+    Test(31, 40, 50, 0.0f, 1.0f);
+    Test(17, 40, 50, 1.0f, 1.0f);
+  }
+};
+
+template <> MlasSparseGemmTest<false>* MlasTestFixture<MlasSparseGemmTest<false>>::mlas_tester(nullptr);
+template <> MlasSparseGemmTest<true>* MlasTestFixture<MlasSparseGemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparseGemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSparseGemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
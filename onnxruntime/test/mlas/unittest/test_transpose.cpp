@@ -22,6 +22,30 @@ class MlasTransposeTest : public MlasTestBase {
     ASSERT_EQ(memcmp(Output, OutputReference, M * N * sizeof(ElementType)), 0) << " [" << M << "," << N << "]";
   }
 
+  // Transposes a tile of a larger matrix, the padding of the output rows must not be written.
+  void
+  TestStrided(size_t M, size_t N, size_t ldInput, size_t ldOutput) {
+    ElementType* Input = BufferInput.GetBuffer(M * ldInput);
+    ElementType* Output = BufferOutput.GetBuffer(N * ldOutput);
+    ElementType* OutputReference = BufferOutputReference.GetBuffer(N * ldOutput);
+
+    for (size_t i = 0; i < M * ldInput; i++) {
+      Input[i] = static_cast<ElementType>(i * 7 + 3);
+    }
+    std::fill_n(Output, N * ldOutput, static_cast<ElementType>(0x5A));
+    std::fill_n(OutputReference, N * ldOutput, static_cast<ElementType>(0x5A));
+
+    MlasTranspose(Input, ldInput, Output, ldOutput, M, N);
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        OutputReference[n * ldOutput + m] = Input[m * ldInput + n];
+      }
+    }
+
+    ASSERT_EQ(memcmp(Output, OutputReference, N * ldOutput * sizeof(ElementType)), 0)
+        << " [" << M << "," << N << "] ldInput=" << ldInput << " ldOutput=" << ldOutput;
+  }
+
   void ReferenceTranspose(const ElementType* Input, ElementType* Output, size_t M, size_t N) {
     for (size_t m = 0; m < M; m++) {
       for (size_t n = 0; n < N; n++) {
@@ -42,6 +66,12 @@ class MlasTransposeTest : public MlasTestBase {
         Test(m, n);
       }
     }
+    for (size_t m : {1, 7, 8, 17, 33}) {
+      for (size_t n : {1, 4, 9, 16, 31}) {
+        TestStrided(m, n, n + 5, m + 3);
+        TestStrided(m, n, n * 3, m);
+      }
+    }
   }
 };
 
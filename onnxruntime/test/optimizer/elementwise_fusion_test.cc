@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+TEST(ElementwiseFusionTests, BiasScaleSwish) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 8}, -4.f, 4.f);
+    auto* bias_arg = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeScalarInitializer<float>(1.5f);
+    auto* add_output_arg = builder.MakeIntermediate();
+    auto* mul_output_arg = builder.MakeIntermediate();
+    auto* sigmoid_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_output_arg});
+    builder.AddNode("Mul", {add_output_arg, scale_arg}, {mul_output_arg});
+    builder.AddNode("Sigmoid", {mul_output_arg}, {sigmoid_output_arg});
+    builder.AddNode("Mul", {mul_output_arg, sigmoid_output_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level2, TransformerLevel::Level3,
+                    13, 1e-5, 1e-5);
+}
+
+TEST(ElementwiseFusionTests, KeepsValueConsumedOutsideOfGroup) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({4, 16}, -1.f, 1.f);
+    auto* input2_arg = builder.MakeInput<float>({4, 16}, -1.f, 1.f);
+    auto* add_output_arg = builder.MakeIntermediate();
+    auto* tanh_output_arg = builder.MakeIntermediate();
+    auto* output1_arg = builder.MakeOutput();
+    auto* output2_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input1_arg, input2_arg}, {add_output_arg});
+    builder.AddNode("Tanh", {add_output_arg}, {tanh_output_arg});
+    builder.AddNode("Mul", {tanh_output_arg, input1_arg}, {output1_arg});
+    builder.AddNode("Softmax", {add_output_arg}, {output2_arg}).AddAttribute("axis", static_cast<int64_t>(-1));
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level2, TransformerLevel::Level3,
+                    13, 1e-5, 1e-5);
+}
+
+TEST(ElementwiseFusionTests, UnsupportedBroadcast) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({2, 3, 8}, -1.f, 1.f);
+    auto* input2_arg = builder.MakeInput<float>({3, 1}, -1.f, 1.f);
+    auto* add_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input1_arg, input2_arg}, {add_output_arg});
+    builder.AddNode("Relu", {add_output_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 0);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level2, TransformerLevel::Level3, 13);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+static const std::vector<int64_t> kEmbeddingBagIndices = {0, 3, 7, 9, 9, 1, -2, 4, 5, 6, 2, 8};
+
+TEST(EmbeddingBagFusionTests, GatherReduceSum) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* weight_arg = builder.MakeInitializer<float>({10, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({4, 3}, kEmbeddingBagIndices);
+    auto* axes_arg = builder.Make1DInitializer<int64_t>({1});
+    auto* gather_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Gather", {weight_arg, indices_arg}, {gather_output_arg});
+    builder.AddNode("ReduceSum", {gather_output_arg, axes_arg}, {output_arg})
+        .AddAttribute("keepdims", static_cast<int64_t>(0));
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+    EXPECT_EQ(op_to_count["Gather"], 0);
+    EXPECT_EQ(op_to_count["ReduceSum"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2,
+                    13, 1e-5, 1e-5);
+}
+
+TEST(EmbeddingBagFusionTests, GatherReduceMean) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* weight_arg = builder.MakeInitializer<float>({10, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({4, 3}, kEmbeddingBagIndices);
+    auto* gather_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Gather", {weight_arg, indices_arg}, {gather_output_arg});
+    Node& reduce_node = builder.AddNode("ReduceMean", {gather_output_arg}, {output_arg});
+    reduce_node.AddAttribute("axes", std::vector<int64_t>{-2});
+    reduce_node.AddAttribute("keepdims", static_cast<int64_t>(0));
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+    EXPECT_EQ(op_to_count["Gather"], 0);
+    EXPECT_EQ(op_to_count["ReduceMean"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2,
+                    13, 1e-5, 1e-5);
+}
+
+TEST(EmbeddingBagFusionTests, KeepDimsNotFused) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* weight_arg = builder.MakeInitializer<float>({10, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({4, 3}, kEmbeddingBagIndices);
+    auto* gather_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Gather", {weight_arg, indices_arg}, {gather_output_arg});
+    builder.AddNode("ReduceMax", {gather_output_arg}, {output_arg})
+        .AddAttribute("axes", std::vector<int64_t>{1});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 0);
+    EXPECT_EQ(op_to_count["Gather"], 1);
+    EXPECT_EQ(op_to_count["ReduceMax"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -18,6 +18,7 @@
 #include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/optimizer/activation_spill.h"
 #include "core/optimizer/attention_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/bias_softmax_fusion.h"
@@ -27,6 +28,7 @@
 #include "core/optimizer/common_subexpression_elimination.h"
 #include "core/optimizer/concat_slice_elimination.h"
 #include "core/optimizer/constant_folding.h"
+#include "core/optimizer/constant_folding_cache.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/conv_add_act_fusion.h"
 #include "core/optimizer/conv_add_fusion.h"
@@ -375,6 +377,105 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+TEST_F(GraphTransformationTests, ConstantFoldingCache) {
+  constexpr int64_t rows = 128;
+  constexpr int64_t cols = 256;
+  const std::vector<int64_t> weight_dims{rows, cols};
+  RandomValueGenerator random{};
+  const std::vector<float> weight = random.Uniform<float>(weight_dims, -1.f, 1.f);
+
+  TensorProto weight_tensor;
+  weight_tensor.set_name("weight");
+  weight_tensor.set_data_type(TensorProto_DataType_FLOAT);
+  weight_tensor.add_dims(rows);
+  weight_tensor.add_dims(cols);
+  weight_tensor.set_raw_data(weight.data(), weight.size() * sizeof(float));
+
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(cols);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(rows);
+
+  // y = x + Transpose(weight), where the Transpose is folded
+  auto build_graph = [&](Graph& graph) {
+    graph.AddInitializedTensor(weight_tensor);
+    auto& weight_arg = graph.GetOrCreateNodeArg("weight", nullptr);
+    auto& transposed_arg = graph.GetOrCreateNodeArg("transposed", nullptr);
+    auto& x_arg = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+    auto& y_arg = graph.GetOrCreateNodeArg("y", &float_tensor_type);
+    graph.AddNode("transpose", "Transpose", "folded", {&weight_arg}, {&transposed_arg});
+    graph.AddNode("add", "Add", "not folded", {&x_arg, &transposed_arg}, {&y_arg});
+    ASSERT_STATUS_OK(graph.Resolve());
+  };
+
+  auto fold = [&](Graph& graph, const PathString& cache_dir) {
+    auto e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<ConstantFolding>(*e, false /*skip_dequantize_linear*/, InlinedHashSet<std::string_view>{},
+                                          InlinedHashSet<std::string>{}, cache_dir),
+        TransformerLevel::Level1));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+    ASSERT_EQ(CountOpsInGraph(graph)["Transpose"], 0);
+  };
+
+  auto get_folded_values = [](const Graph& graph) {
+    const TensorProto* folded = nullptr;
+    EXPECT_TRUE(graph.GetInitializedTensor("transposed", folded));
+    std::vector<float> values(static_cast<size_t>(rows * cols));
+    if (folded != nullptr) {
+      EXPECT_EQ(folded->raw_data().size(), values.size() * sizeof(float));
+      memcpy(values.data(), folded->raw_data().data(),
+             std::min(folded->raw_data().size(), values.size() * sizeof(float)));
+    }
+    return values;
+  };
+
+  TemporaryDirectory cache_dir(ORT_TSTR("constant_folding_cache_test"));
+  PathString cache_file_path;
+  {
+    Model model("ConstantFoldingCacheTest", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{kOnnxDomain, 12}}, {}, *logger_);
+    build_graph(model.MainGraph());
+    const Node& transpose = *model.MainGraph().GetNode(0);
+    ASSERT_TRUE(ConstantFoldingCache(cache_dir.Path())
+                    .GetCacheFilePath(transpose, {{"weight", &weight_tensor}}, Path(), cache_file_path));
+  }
+
+  // the first fold saves the output of the Transpose
+  {
+    Model model("ConstantFoldingCacheTest", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{kOnnxDomain, 12}}, {}, *logger_);
+    build_graph(model.MainGraph());
+    fold(model.MainGraph(), cache_dir.Path());
+    const std::vector<float> folded = get_folded_values(model.MainGraph());
+    for (int64_t r = 0; r < rows; ++r) {
+      for (int64_t c = 0; c < cols; ++c) {
+        ASSERT_EQ(folded[c * rows + r], weight[r * cols + c]);
+      }
+    }
+
+    size_t file_size = 0;
+    ASSERT_STATUS_OK(Env::Default().GetFileLength(cache_file_path.c_str(), file_size));
+    EXPECT_GT(file_size, folded.size() * sizeof(float));
+  }
+
+  // later folds read the output from the cache rather than evaluating the node
+  {
+    OrtValue cached_value;
+    const std::vector<float> cached(static_cast<size_t>(rows * cols), 2.f);
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {cols, rows}, cached,
+                         &cached_value);
+    ConstantFoldingCache(cache_dir.Path()).Save(cache_file_path, {cached_value}, *logger_);
+
+    Model model("ConstantFoldingCacheTest", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{kOnnxDomain, 12}}, {}, *logger_);
+    build_graph(model.MainGraph());
+    fold(model.MainGraph(), cache_dir.Path());
+    EXPECT_EQ(get_folded_values(model.MainGraph()), cached);
+  }
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingWithShapeToInitializer) {
   auto model_uri = MODEL_FOLDER "fusion/constant_folding_with_shape_to_initializer.onnx";
   std::shared_ptr<Model> model;
@@ -4786,6 +4887,79 @@ TEST_F(GraphTransformationTests, FilterEnabledOptimizers) {
   ASSERT_TRUE(op_to_count["Add"] == 1);
 }
 
+TEST_F(GraphTransformationTests, ActivationSpill) {
+  const auto build_graph = [](Model& model) {
+    auto& graph = model.MainGraph();
+    TypeProto tensor_float;
+    tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1024);
+    auto arg = [&](const std::string& name) { return &graph.GetOrCreateNodeArg(name, &tensor_float); };
+
+    // A = Relu(X) is used right away by Sigmoid, then idle during a chain of 6 nodes until Y = Add(C5, A)
+    graph.AddNode("relu", "Relu", "", {arg("X")}, {arg("A")});
+    graph.AddNode("sigmoid", "Sigmoid", "", {arg("A")}, {arg("B")});
+    std::string chain = "B";
+    for (int i = 0; i < 6; ++i) {
+      graph.AddNode("neg_" + std::to_string(i), "Neg", "", {arg(chain)}, {arg("C" + std::to_string(i))});
+      chain = "C" + std::to_string(i);
+    }
+    graph.AddNode("add", "Add", "", {arg(chain), arg("A")}, {arg("Y")});
+    for (auto& node : graph.Nodes()) {
+      node.SetExecutionProviderType(kCudaExecutionProvider);
+    }
+    ASSERT_STATUS_OK(graph.Resolve());
+  };
+
+  const auto apply = [this](Graph& graph, int64_t budget_bytes) {
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<ActivationSpill>(budget_bytes, 2, InlinedHashSet<std::string_view>{kCudaExecutionProvider}),
+        TransformerLevel::Level3));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger_));
+  };
+
+  // The peak of 3 activations of 4KB, A and two values of the chain, fits the budget.
+  {
+    Model model("ActivationSpill", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{"", 12}}, {}, *logger_);
+    build_graph(model);
+    apply(model.MainGraph(), 3 * 4096);
+    std::map<std::string, int> op_to_count = CountOpsInGraph(model.MainGraph());
+    EXPECT_EQ(op_to_count["MemcpyToHost"], 0);
+    EXPECT_EQ(op_to_count["MemcpyFromHost"], 0);
+  }
+
+  // A is spilled after Relu and prefetched after neg_4, two nodes before Add, which reads the prefetched copy.
+  {
+    Model model("ActivationSpill", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{"", 12}}, {}, *logger_);
+    build_graph(model);
+    Graph& graph = model.MainGraph();
+    apply(graph, 2 * 4096);
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_EQ(op_to_count["MemcpyToHost"], 1);
+    ASSERT_EQ(op_to_count["MemcpyFromHost"], 1);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "MemcpyToHost") {
+        EXPECT_EQ(node.InputDefs()[0]->Name(), "A");
+        EXPECT_EQ(node.GetExecutionProviderType(), kCudaExecutionProvider);
+      } else if (node.OpType() == "MemcpyFromHost") {
+        EXPECT_EQ(node.GetExecutionProviderType(), kCudaExecutionProvider);
+        bool triggered = false;
+        for (auto edge = node.InputEdgesBegin(); edge != node.InputEdgesEnd(); ++edge) {
+          triggered = triggered || edge->GetNode().Name() == "neg_4";
+        }
+        EXPECT_TRUE(triggered);
+      } else if (node.Name() == "add") {
+        EXPECT_EQ(graph.GetProducerNode(node.InputDefs()[1]->Name())->OpType(), "MemcpyFromHost");
+      } else if (node.Name() == "sigmoid") {
+        EXPECT_EQ(node.InputDefs()[0]->Name(), "A");
+      }
+    }
+  }
+}
+
 TEST_F(GraphTransformationTests, PropagateCastOpsTests) {
   using Strategy = GraphTransformerConfiguration::PropagateCastOpsConfiguration::Strategy;
   struct PropagateCastOpsTestSpecs {
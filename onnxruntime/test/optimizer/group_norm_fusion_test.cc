@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+// Builds the subgraph exported for torch.nn.GroupNorm(4, 8) on a (2, 8, 5, 6) input.
+static void BuildGroupNormTestCase(ModelTestBuilder& builder, bool with_affine) {
+  auto* input_arg = builder.MakeInput<float>({2, 8, 5, 6}, -2.f, 2.f);
+  auto* group_shape_arg = builder.Make1DInitializer<int64_t>({0, 4, -1});
+  auto* scale_arg = builder.MakeInitializer<float>({4}, 0.5f, 1.5f);
+  auto* bias_arg = builder.MakeInitializer<float>({4}, -0.5f, 0.5f);
+  auto* shape_output_arg = builder.MakeIntermediate();
+  auto* reshape1_output_arg = builder.MakeIntermediate();
+  auto* instance_norm_output_arg = builder.MakeIntermediate();
+  auto* reshape2_output_arg = with_affine ? builder.MakeIntermediate() : builder.MakeOutput();
+
+  builder.AddNode("Shape", {input_arg}, {shape_output_arg});
+  builder.AddNode("Reshape", {input_arg, group_shape_arg}, {reshape1_output_arg});
+  builder.AddNode("InstanceNormalization", {reshape1_output_arg, scale_arg, bias_arg}, {instance_norm_output_arg})
+      .AddAttribute("epsilon", 1e-3f);
+  builder.AddNode("Reshape", {instance_norm_output_arg, shape_output_arg}, {reshape2_output_arg});
+
+  if (with_affine) {
+    auto* gamma_arg = builder.MakeInitializer<float>({8, 1, 1}, -1.f, 1.f);
+    auto* beta_arg = builder.MakeInitializer<float>({1, 8, 1, 1}, -1.f, 1.f);
+    auto* mul_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Mul", {reshape2_output_arg, gamma_arg}, {mul_output_arg});
+    builder.AddNode("Add", {beta_arg, mul_output_arg}, {output_arg});
+  }
+}
+
+TEST(GroupNormFusionTests, ReshapeInstanceNormReshapeMulAdd) {
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GroupNorm"], 1);
+    EXPECT_EQ(op_to_count["Reshape"], 0);
+    EXPECT_EQ(op_to_count["InstanceNormalization"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Add"], 0);
+  };
+
+  TransformerTester([](ModelTestBuilder& builder) { BuildGroupNormTestCase(builder, true); },
+                    check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13, 1e-5, 1e-5);
+}
+
+TEST(GroupNormFusionTests, ReshapeInstanceNormReshape) {
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GroupNorm"], 1);
+    EXPECT_EQ(op_to_count["Reshape"], 0);
+    EXPECT_EQ(op_to_count["InstanceNormalization"], 0);
+  };
+
+  TransformerTester([](ModelTestBuilder& builder) { BuildGroupNormTestCase(builder, false); },
+                    check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13, 1e-5, 1e-5);
+}
+
+TEST(GroupNormFusionTests, GroupsNotDividingChannels) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 6, 4}, -2.f, 2.f);
+    auto* group_shape_arg = builder.Make1DInitializer<int64_t>({0, 4, -1});
+    auto* output_shape_arg = builder.Make1DInitializer<int64_t>({2, 6, 4});
+    auto* scale_arg = builder.MakeInitializer<float>({4}, 0.5f, 1.5f);
+    auto* bias_arg = builder.MakeInitializer<float>({4}, -0.5f, 0.5f);
+    auto* reshape1_output_arg = builder.MakeIntermediate();
+    auto* instance_norm_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Reshape", {input_arg, group_shape_arg}, {reshape1_output_arg});
+    builder.AddNode("InstanceNormalization", {reshape1_output_arg, scale_arg, bias_arg}, {instance_norm_output_arg});
+    builder.AddNode("Reshape", {instance_norm_output_arg, output_shape_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GroupNorm"], 0);
+    EXPECT_EQ(op_to_count["InstanceNormalization"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
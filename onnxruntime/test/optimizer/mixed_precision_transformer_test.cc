@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+static int32_t GetElemType(const NodeArg& arg) {
+  return arg.TypeAsProto()->tensor_type().elem_type();
+}
+
+// The CPU execution provider has float16 kernels for Expand on every platform.
+static void BuildExpandChain(ModelTestBuilder& builder) {
+  auto* input_arg = builder.MakeInput<float>({2, 1, 3}, -1.f, 1.f);
+  auto* expand1_output_arg = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+  auto* shape1_arg = builder.MakeInitializer<int64_t>({2, 4, 3});
+  auto* shape2_arg = builder.MakeInitializer<int64_t>({5, 2, 4, 3});
+
+  builder.AddNode("Expand", {input_arg, shape1_arg}, {expand1_output_arg});
+  builder.AddNode("Expand", {expand1_output_arg, shape2_arg}, {output_arg});
+}
+
+TEST(MixedPrecisionTransformerTests, ConvertsRegion) {
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    const Graph& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    // a cast on the graph input and on the graph output, none between the Expand nodes
+    EXPECT_EQ(op_to_count["Cast"], 2);
+    EXPECT_EQ(op_to_count["Expand"], 2);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Expand") {
+        EXPECT_EQ(GetElemType(*node.InputDefs()[0]), ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+        EXPECT_EQ(GetElemType(*node.OutputDefs()[0]), ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+      }
+    }
+
+    EXPECT_EQ(GetElemType(*graph.GetOutputs()[0]), ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  };
+
+  TransformerTester(BuildExpandChain,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level1,
+                    12, 0.0, 0.0, nullptr,
+                    [](SessionOptions& session_options) {
+                      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+                          kOrtSessionOptionsConfigMixedPrecision, "fp16"));
+                      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+                          kOrtSessionOptionsConfigMixedPrecisionAllowOps, "Expand"));
+                    });
+}
+
+TEST(MixedPrecisionTransformerTests, DenyOps) {
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Cast"], 0);
+    EXPECT_EQ(op_to_count["Expand"], 2);
+  };
+
+  TransformerTester(BuildExpandChain,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level1,
+                    12, 0.0, 0.0, nullptr,
+                    [](SessionOptions& session_options) {
+                      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+                          kOrtSessionOptionsConfigMixedPrecision, "fp16"));
+                      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+                          kOrtSessionOptionsConfigMixedPrecisionAllowOps, "Expand"));
+                      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+                          kOrtSessionOptionsConfigMixedPrecisionDenyOps, "Expand"));
+                    });
+}
+
+}  // namespace test
+}  // namespace onnxruntime
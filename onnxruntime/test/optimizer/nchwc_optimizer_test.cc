@@ -1360,8 +1360,10 @@ TEST(NchwcOptimizerTests, Activation) {
       EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 2);
       EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], 1);
       EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 1);
-      EXPECT_EQ(op_to_count[activation_op_type], 1);
-      EXPECT_EQ(op_to_count["Add"], 1);
+      // the activation and the Add are then fused by ElementwiseFusion
+      EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+      EXPECT_EQ(op_to_count[activation_op_type], 0);
+      EXPECT_EQ(op_to_count["Add"], 0);
     };
 
     NchwcOptimizerTester(build_test_case, check_nchwc_graph);
@@ -70,6 +70,7 @@ TEST(NhwcTransformerTests, ConvBlockBinary) {
       auto* input_arg = builder.MakeInput<uint8_t>({1, 23, 13, 13}, 0, 31);
       auto* conv1_output_arg = builder.MakeIntermediate();
       auto* conv2_output_arg = builder.MakeIntermediate();
+      auto* binary_output_arg = builder.MakeIntermediate();
       auto* output_arg = builder.MakeOutput();
       auto* conv1_weight_arg = builder.MakeInitializer<uint8_t>({30, 23, 3, 3},
                                                                 NhwcWeightsRange<uint8_t>::min_value,
@@ -89,7 +90,8 @@ TEST(NhwcTransformerTests, ConvBlockBinary) {
       builder.AddQLinearBinaryNode(binary_op_type,
                                    conv1_output_arg, .37f, 131,
                                    conv2_output_arg, .37f, 131,
-                                   output_arg, .43f, 126);
+                                   binary_output_arg, .43f, 126);
+      builder.AddDequantizeLinearNode<uint8_t>(binary_output_arg, .43f, 126, output_arg);
     };
 
     auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
@@ -98,10 +100,14 @@ TEST(NhwcTransformerTests, ConvBlockBinary) {
       EXPECT_EQ(op_to_count["Transpose"], 2);
     };
 
+    // QLinearAdd is fused into the first convolution, which skips the requantization of its output
+    // and may change the result by one quantization step.
     TransformerTester(build_test_case,
                       check_nhwc_graph,
                       TransformerLevel::Level2,
-                      TransformerLevel::Level3);
+                      TransformerLevel::Level3,
+                      12 /*opset_version*/,
+                      .44 /*per_sample_tolerance*/);
   };
 
   std::vector<std::string> activation_op_types{"QLinearAdd", "QLinearMul"};
@@ -110,6 +116,47 @@ TEST(NhwcTransformerTests, ConvBlockBinary) {
   }
 }
 
+TEST(NhwcTransformerTests, ConvAddResidual) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
+                       const std::vector<int64_t>& residual_shape, bool fused) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<uint8_t>(input_shape, 0, 31);
+      auto* residual_arg = builder.MakeInput<uint8_t>(residual_shape, 0, 255);
+      auto* conv_output_arg = builder.MakeIntermediate();
+      auto* add_output_arg = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+      auto* weight_arg = NhwcMakeInitializer<uint8_t>(builder, weights_shape);
+
+      builder.AddQLinearConvNode<uint8_t>(input_arg, .01f, 135,
+                                          weight_arg, .02f, 126,
+                                          conv_output_arg, .37f, 131);
+      builder.AddQLinearBinaryNode("QLinearAdd",
+                                   residual_arg, .05f, 128,
+                                   conv_output_arg, .37f, 131,
+                                   add_output_arg, .43f, 126);
+      builder.AddDequantizeLinearNode<uint8_t>(add_output_arg, .43f, 126, output_arg);
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearConv"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearAdd"], fused ? 0 : 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12 /*opset_version*/,
+                      .44 /*per_sample_tolerance*/);
+  };
+
+  test_case({1, 16, 9, 9}, {16, 16, 1, 1}, {1, 16, 9, 9}, true);
+  test_case({1, 16, 9, 9}, {24, 16, 3, 3}, {1, 24, 7, 7}, true);
+  // The fused sum is not broadcast.
+  test_case({1, 16, 9, 9}, {16, 16, 1, 1}, {1, 16, 1, 1}, false);
+}
+
 TEST(NhwcTransformerTests, ConvMaxPool) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape) {
     auto build_test_case = [&](ModelTestBuilder& builder) {
@@ -176,6 +223,77 @@ TEST(NhwcTransformerTests, ConvMaxPoolIndexTensor) {
                     TransformerLevel::Level3);
 }
 
+TEST(NhwcTransformerTests, MaxPoolWithoutChannelsLastInput) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<uint8_t>({1, 16, 17, 17}, 0, 31);
+    auto* output_arg = builder.MakeOutput();
+
+    Node& pool_node = builder.AddNode("MaxPool", {input_arg}, {output_arg});
+    pool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["MaxPool"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcMaxPool"], 0);
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+  };
+
+  // Test that a MaxPool with a channels first input is not converted, as it would need a transpose on either side.
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3);
+}
+
+TEST(NhwcTransformerTests, FloatConvChannelsLastInput) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.0f, 1.0f);
+      auto* transpose_output_arg = builder.MakeIntermediate();
+      auto* conv_output_arg = builder.MakeIntermediate();
+      auto* relu_output_arg = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+      auto* weight_arg = builder.MakeInitializer<float>(weights_shape, -0.5f, 0.5f);
+      auto* bias_arg = builder.MakeInitializer<float>({weights_shape[0]}, -0.5f, 0.5f);
+
+      // A channels last graph input, as exported from a channels last framework.
+      std::vector<int64_t> perm{0, static_cast<int64_t>(input_shape.size()) - 1};
+      for (int64_t i = 1; i < static_cast<int64_t>(input_shape.size()) - 1; i++) {
+        perm.push_back(i);
+      }
+      Node& transpose_node = builder.AddNode("Transpose", {input_arg}, {transpose_output_arg});
+      transpose_node.AddAttribute("perm", perm);
+
+      Node& conv_node = builder.AddNode("Conv", {transpose_output_arg, weight_arg, bias_arg}, {conv_output_arg});
+      conv_node.AddAttribute("pads", std::vector<int64_t>((weights_shape.size() - 2) * 2, 1));
+      builder.AddNode("Relu", {conv_output_arg}, {relu_output_arg});
+      Node& pool_node = builder.AddNode("MaxPool", {relu_output_arg}, {output_arg});
+      pool_node.AddAttribute("kernel_shape", std::vector<int64_t>(weights_shape.size() - 2, 2));
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcMaxPool"], 1);
+      EXPECT_EQ(op_to_count["Transpose"], 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12,
+                      1e-5,
+                      1e-5);
+  };
+
+  // Test that a float convolution with a channels last input runs channels last, along with its fused activation
+  // and the following pool. The 2D case is left out as the NCHWc transformer claims 2D convolutions first.
+  test_case({1, 37, 12}, {32, 12, 5});
+  test_case({1, 11, 13, 15, 6}, {10, 6, 3, 3, 3});
+}
+
 TEST(NhwcTransformerTests, ConvGlobalAveragePool) {
   auto build_test_case = [&](ModelTestBuilder& builder) {
     auto* input_arg = builder.MakeInput<uint8_t>({1, 23, 13, 13}, 0, 31);
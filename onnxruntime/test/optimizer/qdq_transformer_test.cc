@@ -5,6 +5,7 @@
 #include "core/graph/model.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selector_action_transformer.h"
@@ -530,6 +531,151 @@ TEST(QDQTransformerTests, MatMul_S8S8U8) {
   QDQTransformerMatMulTests<int8_t, int8_t, uint8_t>(true);
 }
 
+// int16 activations only have the com.microsoft Q/DQ, and are replaced by MatMulIntegerToFloat
+TEST(QDQTransformerTests, MatMul_S16S8) {
+  auto test_case = [&](const std::vector<int64_t>& input1_shape, const std::vector<int64_t>& input2_shape,
+                       bool has_output_q) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input1_arg = builder.MakeInput<float>(input1_shape, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+
+      // add QDQ 1
+      auto* q1_output = builder.MakeIntermediate();
+      auto* dq1_output = builder.MakeIntermediate();
+      builder.AddNode("QuantizeLinear",
+                      {input1_arg, builder.MakeScalarInitializer<float>(.0001f),
+                       builder.MakeScalarInitializer<int16_t>(7)},
+                      {q1_output}, kMSDomain);
+      builder.AddNode("DequantizeLinear",
+                      {q1_output, builder.MakeScalarInitializer<float>(.0001f),
+                       builder.MakeScalarInitializer<int16_t>(7)},
+                      {dq1_output}, kMSDomain);
+
+      // add DQ 2
+      auto* weight = builder.MakeInitializer<int8_t>(input2_shape, -64, 64);
+      auto* dq2_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<int8_t>(weight, .01f, 0, dq2_output);
+
+      if (has_output_q) {
+        auto* matmul_op_output = builder.MakeIntermediate();
+        builder.AddNode("MatMul", {dq1_output, dq2_output}, {matmul_op_output});
+
+        // add QDQ output
+        auto* q3_output = builder.MakeIntermediate();
+        builder.AddNode("QuantizeLinear",
+                        {matmul_op_output, builder.MakeScalarInitializer<float>(.001f),
+                         builder.MakeScalarInitializer<int16_t>(0)},
+                        {q3_output}, kMSDomain);
+        builder.AddNode("DequantizeLinear",
+                        {q3_output, builder.MakeScalarInitializer<float>(.001f),
+                         builder.MakeScalarInitializer<int16_t>(0)},
+                        {output_arg}, kMSDomain);
+      } else {
+        builder.AddNode("MatMul", {dq1_output, dq2_output}, {output_arg});
+      }
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.MatMulIntegerToFloat"], 1);
+      EXPECT_EQ(op_to_count["MatMul"], 0);
+      EXPECT_EQ(op_to_count["QLinearMatMul"], 0);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+      EXPECT_EQ(op_to_count["com.microsoft.QuantizeLinear"], has_output_q ? 2 : 1);
+      EXPECT_EQ(op_to_count["com.microsoft.DequantizeLinear"], has_output_q ? 1 : 0);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({1, 2, 16}, {16, 4}, false);
+  test_case({1, 2, 16}, {16, 4}, true);
+  test_case({1, 23, 13, 13}, {13, 13}, false);
+}
+
+// The int8 QDQ MatMul node groups assigned to the CUDA EP are replaced by QLinearMatMul, the uint8 ones and the
+// ones with a scale of B per row are left to run as float ops.
+TEST(QDQTransformerTests, MatMul_S8S8S8_Cuda) {
+  auto test_case = [&](bool is_int8, bool b_scale_per_row) {
+    std::unordered_map<std::string, int> domain_to_version;
+    domain_to_version[kOnnxDomain] = 13;
+    Model model("QDQCudaMatMul", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+    Graph& graph = model.MainGraph();
+    ModelTestBuilder builder(graph);
+
+    auto* input_arg = builder.MakeInput<float>({2, 8}, -1.f, 1.f);
+    auto* output_arg = builder.MakeOutput();
+
+    auto* q1_output = builder.MakeIntermediate();
+    auto* dq1_output = builder.MakeIntermediate();
+    auto* dq2_output = builder.MakeIntermediate();
+    auto* matmul_output = builder.MakeIntermediate();
+    if (is_int8) {
+      builder.AddQuantizeLinearNode<int8_t>(input_arg, .039f, 0, q1_output);
+      builder.AddDequantizeLinearNode<int8_t>(q1_output, .039f, 0, dq1_output);
+      auto* weight = builder.MakeInitializer<int8_t>({8, 4}, -64, 64);
+      if (b_scale_per_row) {
+        Node& dq2 = builder.AddNode("DequantizeLinear",
+                                    {weight, builder.Make1DInitializer<float>(std::vector<float>(8, .04f)),
+                                     builder.Make1DInitializer<int8_t>(std::vector<int8_t>(8, 0))},
+                                    {dq2_output});
+        dq2.AddAttribute("axis", static_cast<int64_t>(0));
+      } else {
+        builder.AddDequantizeLinearNode<int8_t>(weight, .04f, 0, dq2_output);
+      }
+      builder.AddNode("MatMul", {dq1_output, dq2_output}, {matmul_output});
+      builder.AddQuantizeLinearNode<int8_t>(matmul_output, .039f, 0, output_arg);
+    } else {
+      builder.AddQuantizeLinearNode<uint8_t>(input_arg, .039f, 128, q1_output);
+      builder.AddDequantizeLinearNode<uint8_t>(q1_output, .039f, 128, dq1_output);
+      auto* weight = builder.MakeInitializer<uint8_t>({8, 4}, 64, 192);
+      builder.AddDequantizeLinearNode<uint8_t>(weight, .04f, 128, dq2_output);
+      builder.AddNode("MatMul", {dq1_output, dq2_output}, {matmul_output});
+      builder.AddQuantizeLinearNode<uint8_t>(matmul_output, .039f, 128, output_arg);
+    }
+    builder.SetGraphOutputs();
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    for (auto& node : graph.Nodes()) {
+      node.SetExecutionProviderType(kCudaExecutionProvider);
+    }
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<QDQCudaSelectorActionTransformer>(),
+                                                       TransformerLevel::Level2));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                                DefaultLoggingManager().DefaultLogger()));
+
+    auto op_to_count = CountOpsInGraph(graph);
+    if (is_int8 && !b_scale_per_row) {
+      EXPECT_EQ(op_to_count["QLinearMatMul"], 1);
+      EXPECT_EQ(op_to_count["MatMul"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+      for (const auto& node : graph.Nodes()) {
+        EXPECT_EQ(node.GetExecutionProviderType(), kCudaExecutionProvider);
+      }
+    } else {
+      EXPECT_EQ(op_to_count["QLinearMatMul"], 0);
+      EXPECT_EQ(op_to_count["MatMul"], 1);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 2);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 2);
+    }
+  };
+
+  test_case(true, false);
+  test_case(true, true);
+  test_case(false, false);
+}
+
 template <typename Input1Type, typename Input2Type, typename OutputType, typename BiasType = int32_t>
 void QDQTransformerGemmTests(bool has_output_q, bool has_bias, bool beta_not_one = false) {
   auto test_case = [&](const std::vector<int64_t>& input1_shape, const std::vector<int64_t>& input2_shape) {
@@ -726,6 +872,54 @@ TEST(QDQTransformerTests, Gather) {
   test_case({12, 37}, {24, 12});
 }
 
+TEST(QDQTransformerTests, DequantizeGather) {
+  // per_row uses a 1-D scale along axis 0 of the table, column_wise one along axis 1, which is not fused
+  auto test_case = [&](const std::vector<int64_t>& input1_shape, const std::vector<int64_t>& weights_shape,
+                       bool per_row, bool column_wise = false) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input1_arg = builder.MakeInput<int64_t>(input1_shape, 0, weights_shape[0] - 1);
+      auto* output_arg = builder.MakeOutput();
+
+      // add DQ of the table
+      auto* weight = builder.MakeInitializer<uint8_t>(weights_shape, 0, 255);
+      auto* dq_w_output = builder.MakeIntermediate();
+      if (per_row || column_wise) {
+        const int64_t param_count = weights_shape[column_wise ? 1 : 0];
+        auto* scale = builder.MakeInitializer<float>({param_count}, .001f, .01f);
+        auto* zero_point = builder.MakeInitializer<uint8_t>({param_count}, 100, 150);
+        Node& dq_node = builder.AddNode("DequantizeLinear", {weight, scale, zero_point}, {dq_w_output});
+        dq_node.AddAttribute("axis", static_cast<int64_t>(column_wise ? 1 : 0));
+      } else {
+        builder.AddDequantizeLinearNode<uint8_t>(weight, .003f, 128, dq_w_output);
+      }
+
+      // add Gather
+      builder.AddNode("Gather", {dq_w_output, input1_arg}, {output_arg});
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      const int fused = column_wise ? 0 : 1;
+      EXPECT_EQ(op_to_count["com.microsoft.DequantizeGather"], fused);
+      EXPECT_EQ(op_to_count["Gather"], 1 - fused);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1 - fused);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      13 /*opset_version*/,
+                      1e-5 /*per_sample_tolerance*/,
+                      1e-5 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({12, 37}, {24, 12}, false);
+  test_case({2, 5}, {300, 16}, true);
+  test_case({7}, {64, 6}, false, true);
+}
+
 TEST(QDQTransformerTests, Transpose) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perms) {
     auto check_graph = [&](InferenceSessionWrapper& session) {
@@ -1459,6 +1653,285 @@ TEST(QDQTransformerTests, Sigmoid_U8S8) {
   QDQTransformerSigmoidTests<uint8_t, int8_t>();
 }
 
+template <typename InputType, typename OutputType>
+void QDQTransformerGeluTests() {
+  auto test_case = [&](const std::vector<int64_t>& input_shape) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + Gelu
+      auto* dq_output = AddQDQNodePair<InputType>(builder, input_arg, .0035f, 7);
+      auto* gelu_output = builder.MakeIntermediate();
+      builder.AddNode("Gelu", {dq_output}, {gelu_output}, kMSDomain);
+
+      // add QDQ output
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<OutputType>(gelu_output,
+                                                .0038f,
+                                                std::numeric_limits<OutputType>::max() / 2,
+                                                q_output);
+      builder.AddDequantizeLinearNode<OutputType>(q_output,
+                                                  .0039f,
+                                                  std::numeric_limits<OutputType>::max() / 2,
+                                                  output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      if constexpr (std::is_same<InputType, OutputType>::value) {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearGelu"], 1);
+        EXPECT_EQ(op_to_count["com.microsoft.Gelu"], 0);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+      } else {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearGelu"], 0);
+        EXPECT_EQ(op_to_count["com.microsoft.Gelu"], 1);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 2);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 2);
+      }
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({1, 12, 37});
+  test_case({1, 23, 13, 13});
+}
+
+TEST(QDQTransformerTests, Gelu_S8S8) {
+  QDQTransformerGeluTests<int8_t, int8_t>();
+}
+
+TEST(QDQTransformerTests, Gelu_U8U8) {
+  QDQTransformerGeluTests<uint8_t, uint8_t>();
+}
+
+TEST(QDQTransformerTests, Gelu_U8S8) {
+  QDQTransformerGeluTests<uint8_t, int8_t>();
+}
+
+template <typename InputType, typename OutputType>
+void QDQTransformerLookupTableTests(const std::string& op_type, int opset_version,
+                                    const std::optional<float>& alpha = std::nullopt) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + op
+      auto* dq_output = AddQDQNodePair<InputType>(builder, input_arg, .0035f, 7);
+      auto* op_output = builder.MakeIntermediate();
+      Node& node = builder.AddNode(op_type, {dq_output}, {op_output});
+      if (alpha.has_value()) {
+        node.AddAttribute("alpha", *alpha);
+      }
+
+      // add QDQ output
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<OutputType>(op_output,
+                                                .0038f,
+                                                std::numeric_limits<OutputType>::max() / 2,
+                                                q_output);
+      builder.AddDequantizeLinearNode<OutputType>(q_output,
+                                                  .0039f,
+                                                  std::numeric_limits<OutputType>::max() / 2,
+                                                  output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      if constexpr (std::is_same<InputType, OutputType>::value) {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearUnary"], 1);
+        EXPECT_EQ(op_to_count[op_type], 0);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+      } else {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearUnary"], 0);
+        EXPECT_EQ(op_to_count[op_type], 1);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 2);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 2);
+      }
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      opset_version,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({1, 12, 37});
+  test_case({1, 23, 13, 13});
+}
+
+TEST(QDQTransformerTests, LookupTable_S8S8) {
+  QDQTransformerLookupTableTests<int8_t, int8_t>("Tanh", 13);
+  QDQTransformerLookupTableTests<int8_t, int8_t>("Erf", 13);
+  QDQTransformerLookupTableTests<int8_t, int8_t>("HardSwish", 14);
+}
+
+TEST(QDQTransformerTests, LookupTable_U8U8) {
+  QDQTransformerLookupTableTests<uint8_t, uint8_t>("Exp", 13);
+  QDQTransformerLookupTableTests<uint8_t, uint8_t>("Elu", 13, 0.5f);
+  QDQTransformerLookupTableTests<uint8_t, uint8_t>("Softplus", 13);
+}
+
+TEST(QDQTransformerTests, LookupTable_U8S8) {
+  QDQTransformerLookupTableTests<uint8_t, int8_t>("Tanh", 13);
+}
+
+template <typename InputType, typename OutputType>
+void QDQTransformerSoftmaxTests(int opset_version) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, std::optional<int64_t> axis) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -4.f, 4.f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + Softmax
+      auto* dq_output = AddQDQNodePair<InputType>(builder, input_arg, .035f, 7);
+      auto* softmax_output = builder.MakeIntermediate();
+      Node& softmax_node = builder.AddNode("Softmax", {dq_output}, {softmax_output});
+      if (axis.has_value()) {
+        softmax_node.AddAttribute("axis", *axis);
+      }
+
+      // add QDQ output
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<OutputType>(softmax_output,
+                                                1.f / 256,
+                                                std::numeric_limits<OutputType>::lowest(),
+                                                q_output);
+      builder.AddDequantizeLinearNode<OutputType>(q_output,
+                                                  1.f / 256,
+                                                  std::numeric_limits<OutputType>::lowest(),
+                                                  output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      if constexpr (std::is_same<InputType, OutputType>::value) {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearSoftmax"], 1);
+        EXPECT_EQ(op_to_count["Softmax"], 0);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+      } else {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearSoftmax"], 0);
+        EXPECT_EQ(op_to_count["Softmax"], 1);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 2);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 2);
+      }
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      opset_version,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  // the default and explicit axes, which have different semantics before opset 13
+  test_case({2, 12, 37}, std::nullopt);
+  test_case({2, 12, 37}, 1);
+  test_case({2, 4, 8, 6}, -1);
+}
+
+TEST(QDQTransformerTests, Softmax_S8S8) {
+  QDQTransformerSoftmaxTests<int8_t, int8_t>(12);
+  QDQTransformerSoftmaxTests<int8_t, int8_t>(13);
+}
+
+TEST(QDQTransformerTests, Softmax_U8U8) {
+  QDQTransformerSoftmaxTests<uint8_t, uint8_t>(12);
+  QDQTransformerSoftmaxTests<uint8_t, uint8_t>(13);
+}
+
+TEST(QDQTransformerTests, Softmax_U8S8) {
+  QDQTransformerSoftmaxTests<uint8_t, int8_t>(13);
+}
+
+template <typename InputType, typename OutputType>
+void QDQTransformerLayerNormTests(bool has_bias) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+      auto* scale_arg = builder.MakeInitializer<float>({input_shape.back()}, 0.5f, 1.5f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + LayerNormalization
+      auto* dq_output = AddQDQNodePair<InputType>(builder, input_arg, .0035f, 7);
+      std::vector<NodeArg*> layer_norm_inputs{dq_output, scale_arg};
+      if (has_bias) {
+        layer_norm_inputs.push_back(builder.MakeInitializer<float>({input_shape.back()}, -0.5f, 0.5f));
+      }
+      auto* layer_norm_output = builder.MakeIntermediate();
+      Node& layer_norm_node = builder.AddNode("LayerNormalization", layer_norm_inputs, {layer_norm_output});
+      layer_norm_node.AddAttribute("axis", static_cast<int64_t>(-1));
+
+      // add QDQ output
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<OutputType>(layer_norm_output,
+                                                .025f,
+                                                std::numeric_limits<OutputType>::max() / 2,
+                                                q_output);
+      builder.AddDequantizeLinearNode<OutputType>(q_output,
+                                                  .025f,
+                                                  std::numeric_limits<OutputType>::max() / 2,
+                                                  output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      if constexpr (std::is_same<InputType, OutputType>::value) {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearLayerNormalization"], 1);
+        EXPECT_EQ(op_to_count["LayerNormalization"], 0);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+      } else {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearLayerNormalization"], 0);
+        EXPECT_EQ(op_to_count["LayerNormalization"], 1);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 2);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 2);
+      }
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      0.06 /*per_sample_tolerance*/,
+                      0.06 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({2, 12, 64});
+  test_case({1, 7, 768});
+}
+
+TEST(QDQTransformerTests, LayerNorm_S8S8) {
+  QDQTransformerLayerNormTests<int8_t, int8_t>(true);
+  QDQTransformerLayerNormTests<int8_t, int8_t>(false);
+}
+
+TEST(QDQTransformerTests, LayerNorm_U8U8) {
+  QDQTransformerLayerNormTests<uint8_t, uint8_t>(true);
+  QDQTransformerLayerNormTests<uint8_t, uint8_t>(false);
+}
+
+TEST(QDQTransformerTests, LayerNorm_U8S8) {
+  QDQTransformerLayerNormTests<uint8_t, int8_t>(true);
+}
+
 TEST(QDQTransformerTests, ConvTranspose_QBackward) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape, const std::vector<int64_t>& perms) {
     auto build_test_case = [&](ModelTestBuilder& builder) {
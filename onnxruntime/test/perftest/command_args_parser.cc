@@ -31,8 +31,13 @@ namespace perftest {
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
       "\t-M: Disable memory pattern.\n"
       "\t-A: Disable memory arena\n"
-      "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
+      "\t-I: Generate tensor input binding (Free dimensions are treated as 1 unless a range is given with -D.)\n"
+      "\t-D [dimension_name:min:max]: With -I, draws the free dimension with this name uniformly from [min, max] for each "
+      "generated input set, so that the runs see varied shapes. Can be repeated.\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [queries_per_second]: Open-loop load generation: requests arrive at this average rate (Poisson arrivals) "
+      "regardless of completion and are served by -c concurrent runs. Latencies then include the time spent queued.\n"
+      "\t-j [json_file]: Writes the configuration, throughput and latency percentiles (p50, p90, p99, p99.9) as JSON.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|nuphar|dml|acl|rocm|migraphx]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'openvino', 'nuphar', 'dml', 'acl', 'nnapi', 'coreml', 'rocm' or 'migraphx'. "
       "Default:'cpu'.\n"
@@ -63,6 +68,7 @@ namespace perftest {
       "\t    [OpenVINO only] [use_compiled_network]: Can be enabled to directly import pre-compiled blobs(VPU) or cl_cache files(iGPU) if exists else dump one. This feature is supported on MyriadX(VPU) hardware device target. Starting from OpenVINO 2021.4 version, this feature also works with iGPU with cl_cache.\n"
       "\t    [OpenVINO only] [blob_dump_path]: Explicitly specify the path where you would like to dump and load the blobs or cl_cache files for the use_compiled_network(Model caching) feature. This overrides the default path.\n"
       "\t    [OpenVINO only] [enable_opencl_throttling]: Enables OpenCL queue throttling for GPU device(Reduces the CPU Utilization while using GPU) \n"
+      "\t    [OpenVINO only] [num_streams]: Number of CPU or GPU throughput streams, for parallel inference of concurrent runs. The number of infer requests is raised to it if lower.\n"
       "\t [Usage]: -e <provider_name> -i '<key1>|<value1> <key2>|<value2>'\n\n"
       "\t [Example] [For OpenVINO EP] -e openvino -i \"device_type|CPU_FP32 enable_vpu_fast_compile|true num_of_threads|5 enable_opencl_throttling|true use_compiled_network|true blob_dump_path|\"<path>\"\"\n"
       "\t    [TensorRT only] [trt_max_partition_iterations]: Maximum iterations for TensorRT parser to get capability.\n"
@@ -93,6 +99,25 @@ static const ORTCHAR_T* overrideDelimiter = L":";
 #else
 static const ORTCHAR_T* overrideDelimiter = ":";
 #endif
+static bool ParseDimensionRange(std::string& dim_name, std::pair<int64_t, int64_t>& range) {
+  const std::string dim_range_str = ToUTF8String(std::basic_string<ORTCHAR_T>(optarg));
+  const size_t max_delimiter = dim_range_str.rfind(':');
+  const size_t min_delimiter = max_delimiter == std::string::npos || max_delimiter == 0
+                                   ? std::string::npos
+                                   : dim_range_str.rfind(':', max_delimiter - 1);
+  if (min_delimiter == std::string::npos || min_delimiter == 0) {
+    return false;
+  }
+  dim_name = dim_range_str.substr(0, min_delimiter);
+  ORT_TRY {
+    range.first = std::stoll(dim_range_str.substr(min_delimiter + 1, max_delimiter - min_delimiter - 1));
+    range.second = std::stoll(dim_range_str.substr(max_delimiter + 1));
+  } ORT_CATCH (...) {
+    return false;
+  }
+  return range.first > 0 && range.first <= range.second;
+}
+
 static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier, int64_t& override_val) {
   std::basic_string<ORTCHAR_T> free_dim_str(optarg);
   size_t delimiter_location = free_dim_str.find(overrideDelimiter);
@@ -114,7 +139,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:AMPIvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:D:Q:j:AMPIvhsqz"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -134,6 +159,28 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
         test_config.run_config.free_dim_denotation_overrides[dim_denotation] = override_val;
         break;
       }
+      case 'D': {
+        std::string dim_name;
+        std::pair<int64_t, int64_t> range;
+        if (!ParseDimensionRange(dim_name, range)) {
+          return false;
+        }
+        test_config.run_config.generated_input_dim_ranges[dim_name] = range;
+        break;
+      }
+      case 'Q':
+        ORT_TRY {
+          test_config.run_config.target_qps = std::stod(ToUTF8String(std::basic_string<ORTCHAR_T>(optarg)));
+        } ORT_CATCH (...) {
+          return false;
+        }
+        if (test_config.run_config.target_qps <= 0) {
+          return false;
+        }
+        break;
+      case 'j':
+        test_config.run_config.json_result_file = optarg;
+        break;
       case 'm':
         if (!CompareCString(optarg, ORT_TSTR("duration"))) {
           test_config.run_config.test_mode = TestMode::kFixDurationMode;
@@ -15,9 +15,13 @@ namespace onnxruntime {
 namespace perftest {
 
 std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
-  //Randomly pick one OrtValueArray from test_inputs_. (NOT ThreadSafe)
+  //Randomly pick one OrtValueArray from test_inputs_.
   const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(test_inputs_.size() - 1));
-  const size_t id = static_cast<size_t>(dist_(rand_engine_, p));
+  size_t id;
+  {
+    std::lock_guard<OrtMutex> lock(rand_mutex_);
+    id = static_cast<size_t>(dist_(rand_engine_, p));
+  }
   auto& input = test_inputs_.at(id);
   auto start = std::chrono::high_resolution_clock::now();
   auto output_values = session_.Run(Ort::RunOptions{nullptr}, input_names_.data(), input.data(), input_names_.size(),
@@ -30,7 +34,11 @@ std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
 OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device& rd,
                                                const PerformanceTestConfig& performance_test_config,
                                                const TestModelInfo& m)
-    : rand_engine_(rd()), input_names_(m.GetInputCount()), input_names_str_(m.GetInputCount()), input_length_(m.GetInputCount()) {
+    : rand_engine_(rd()),
+      generated_input_dim_ranges_(performance_test_config.run_config.generated_input_dim_ranges),
+      input_names_(m.GetInputCount()),
+      input_names_str_(m.GetInputCount()),
+      input_length_(m.GetInputCount()) {
   Ort::SessionOptions session_options;
   const std::string& provider_name = performance_test_config.machine_config.provider_type_name;
   if (provider_name == onnxruntime::kDnnlExecutionProvider) {
@@ -249,6 +257,7 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     bool use_compiled_network = false;     // [use_compiled_network]: Can be enabled to directly import pre-compiled blobs if exists.
     std::string blob_dump_path = "";       // [blob_dump_path]: Explicitly specify the path where you would like to dump and load the blobs for the use_compiled_network(save/load blob) feature. This overrides the default path.
     bool enable_opencl_throttling = false;    // [enable_opencl_throttling]: Enables OpenCL queue throttling for GPU device (Reduces CPU Utilization when using GPU)
+    size_t num_streams = 0;                // [num_streams]: Number of CPU or GPU throughput streams, 0 uses the device default.
 #ifdef _MSC_VER
     std::string ov_string = ToUTF8String(performance_test_config.run_config.ep_runtime_config_string);
 #else
@@ -313,10 +322,16 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
         if ((int)num_of_threads <= 0) {
           ORT_THROW("[ERROR] [OpenVINO] The value for the key 'num_of_threads' should be greater than 0\n");
         }
+      } else if (key == "num_streams") {
+        std::stringstream sstream(value);
+        sstream >> num_streams;
+        if ((int)num_streams <= 0) {
+          ORT_THROW("[ERROR] [OpenVINO] The value for the key 'num_streams' should be greater than 0\n");
+        }
       } else if (key == "blob_dump_path") {
         blob_dump_path = value;
       } else {
-        ORT_THROW("[ERROR] [OpenVINO] wrong key type entered. Choose from the following runtime key options that are available for OpenVINO. ['device_type', 'device_id', 'enable_vpu_fast_compile', 'num_of_threads', 'use_compiled_network', 'blob_dump_path', 'enable_opencl_throttling|true'] \n");
+        ORT_THROW("[ERROR] [OpenVINO] wrong key type entered. Choose from the following runtime key options that are available for OpenVINO. ['device_type', 'device_id', 'enable_vpu_fast_compile', 'num_of_threads', 'num_streams', 'use_compiled_network', 'blob_dump_path', 'enable_opencl_throttling|true'] \n");
       }
     }
     OrtOpenVINOProviderOptions options;
@@ -327,6 +342,7 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     options.use_compiled_network = use_compiled_network;        // To use_compiled_network, default is false
     options.blob_dump_path = blob_dump_path.c_str();            // sets the blob_dump_path, default is ""
     options.enable_opencl_throttling = enable_opencl_throttling;      // Enables GPU Throttling (Reduces CPU Utilization)
+    options.num_streams = num_streams;                          // To set number of throughput streams, default is the device default
     session_options.AppendExecutionProvider_OpenVINO(options);
 #else
     ORT_THROW("OpenVINO is not supported in this build\n");
@@ -484,25 +500,39 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
 }
 
 bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData() {
-  // iterate over all input nodes
-  for (size_t i = 0; i < static_cast<size_t>(input_length_); i++) {
-    Ort::TypeInfo type_info = session_.GetInputTypeInfo(i);
-    Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-    if (type_info.GetONNXType() == ONNX_TYPE_TENSOR) {
-      auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
-      std::vector<int64_t> input_node_dim = tensor_info.GetShape();
+  // with dimension ranges, several input sets with different shapes are generated and Run() picks one at random
+  const size_t num_input_sets = generated_input_dim_ranges_.empty() ? 1 : kNumGeneratedInputSets;
+
+  for (size_t input_set = 0; input_set < num_input_sets; ++input_set) {
+    // a dimension name used by several inputs gets the same value in all of them
+    std::map<std::string, int64_t> dim_values;
+    for (const auto& dim_range : generated_input_dim_ranges_) {
+      std::uniform_int_distribution<int64_t> dim_dist(dim_range.second.first, dim_range.second.second);
+      dim_values[dim_range.first] = dim_dist(rand_engine_);
+    }
+
+    // iterate over all input nodes
+    for (size_t i = 0; i < static_cast<size_t>(input_length_); i++) {
+      Ort::TypeInfo type_info = session_.GetInputTypeInfo(i);
+      if (type_info.GetONNXType() == ONNX_TYPE_TENSOR) {
+        auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
+        std::vector<int64_t> input_node_dim = tensor_info.GetShape();
+        std::vector<const char*> dim_names(input_node_dim.size());
+        tensor_info.GetSymbolicDimensions(dim_names.data(), dim_names.size());
 
-      // free dimensions are treated as 1 if not overriden
-      for (int64_t& dim : input_node_dim) {
-        if (dim == -1) {
-          dim = 1;
+        // free dimensions are treated as 1 if not overriden
+        for (size_t d = 0; d < input_node_dim.size(); ++d) {
+          if (input_node_dim[d] == -1) {
+            auto dim_value = dim_values.find(dim_names[d]);
+            input_node_dim[d] = dim_value != dim_values.end() ? dim_value->second : 1;
+          }
         }
+        // default allocator doesn't have to be freed by user
+        auto allocator = static_cast<OrtAllocator*>(Ort::AllocatorWithDefaultOptions());
+        Ort::Value input_tensor = Ort::Value::CreateTensor(allocator, (const int64_t*)input_node_dim.data(),
+                                                           input_node_dim.size(), tensor_info.GetElementType());
+        PreLoadTestData(input_set, i, std::move(input_tensor));
       }
-      // default allocator doesn't have to be freed by user
-      auto allocator = static_cast<OrtAllocator*>(Ort::AllocatorWithDefaultOptions());
-      Ort::Value input_tensor = Ort::Value::CreateTensor(allocator, (const int64_t*)input_node_dim.data(),
-                                                         input_node_dim.size(), tensor_info.GetElementType());
-      PreLoadTestData(0, i, std::move(input_tensor));
     }
   }
   return true;
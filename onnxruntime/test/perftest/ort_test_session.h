@@ -3,6 +3,7 @@
 
 #pragma once
 #include <core/session/onnxruntime_cxx_api.h>
+#include <core/platform/ort_mutex.h>
 #include <random>
 #include "test_configuration.h"
 #include "test_session.h"
@@ -25,6 +26,9 @@ class OnnxRuntimeTestSession : public TestSession {
     test_inputs_[test_data_id][input_id] = std::move(value);
   }
 
+  // Number of input sets generated when the free dimensions are drawn from ranges.
+  static constexpr size_t kNumGeneratedInputSets = 16;
+
   bool PopulateGeneratedInputTestData();
 
   ~OnnxRuntimeTestSession() = default;
@@ -37,6 +41,9 @@ class OnnxRuntimeTestSession : public TestSession {
   Ort::Session session_{nullptr};
   std::mt19937 rand_engine_;
   std::uniform_int_distribution<int> dist_;
+  // Run() is called concurrently with -c, the random engine is not thread safe
+  OrtMutex rand_mutex_;
+  std::map<std::string, std::pair<int64_t, int64_t>> generated_input_dim_ranges_;
   std::vector<std::vector<Ort::Value>> test_inputs_;
   std::vector<std::string> output_names_;
   // The same size with output_names_.
@@ -8,6 +8,7 @@
 
 #include "performance_runner.h"
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -108,6 +109,59 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
   }
 }
 
+// value at the quantile q of the sorted values, with the same indexing as the statistics of DumpToFile
+static double Percentile(const std::vector<double>& sorted_values, double q) {
+  const size_t index = static_cast<size_t>(sorted_values.size() * q);
+  return sorted_values[std::min(index, sorted_values.size() - 1)];
+}
+
+static void WriteLatencyStatsJson(std::ostream& out, const std::vector<double>& values_in_seconds) {
+  std::vector<double> sorted_values = values_in_seconds;
+  std::sort(sorted_values.begin(), sorted_values.end());
+  double sum = 0;
+  for (double value : sorted_values) {
+    sum += value;
+  }
+
+  out << "{\"mean\": " << sum / sorted_values.size() * 1000
+      << ", \"min\": " << sorted_values.front() * 1000
+      << ", \"p50\": " << Percentile(sorted_values, 0.5) * 1000
+      << ", \"p90\": " << Percentile(sorted_values, 0.9) * 1000
+      << ", \"p99\": " << Percentile(sorted_values, 0.99) * 1000
+      << ", \"p99.9\": " << Percentile(sorted_values, 0.999) * 1000
+      << ", \"max\": " << sorted_values.back() * 1000 << "}";
+}
+
+void PerformanceResult::DumpToJson(const std::basic_string<ORTCHAR_T>& path, const RunConfig& run_config) const {
+  std::ofstream outfile(path, std::ofstream::out | std::ofstream::trunc);
+  if (!outfile.good()) {
+    std::cerr << "failed to open JSON result file '" << ToUTF8String(path.c_str()) << "'.\n";
+    return;
+  }
+
+  const std::chrono::duration<double> inference_duration = end - start;
+  outfile << "{\n"
+          << "  \"model_name\": \"" << model_name << "\",\n"
+          << "  \"test_mode\": \"" << (run_config.test_mode == TestMode::kFixDurationMode ? "duration" : "times")
+          << "\",\n"
+          << "  \"concurrent_session_runs\": " << run_config.concurrent_session_runs << ",\n"
+          << "  \"target_qps\": " << run_config.target_qps << ",\n"
+          << "  \"requests\": " << time_costs.size() << ",\n"
+          << "  \"duration_s\": " << inference_duration.count() << ",\n"
+          << "  \"achieved_qps\": " << time_costs.size() / inference_duration.count() << ",\n"
+          << "  \"average_cpu_usage\": " << average_CPU_usage << ",\n"
+          << "  \"peak_workingset_size\": " << peak_workingset_size;
+  if (!time_costs.empty()) {
+    // the time spent in Run
+    outfile << ",\n  \"service_time_ms\": ";
+    WriteLatencyStatsJson(outfile, time_costs);
+    // what a client sees: with open-loop load it includes the time the request was queued
+    outfile << ",\n  \"latency_ms\": ";
+    WriteLatencyStatsJson(outfile, latencies.empty() ? time_costs : latencies);
+  }
+  outfile << "\n}\n";
+}
+
 Status PerformanceRunner::Run() {
   if (!Initialize()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
@@ -121,15 +175,19 @@ Status PerformanceRunner::Run() {
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  if (performance_test_config_.run_config.target_qps > 0) {
+    ORT_RETURN_IF_ERROR(RunOpenLoop());
+  } else {
+    switch (performance_test_config_.run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(FixDurationTest());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RepeatedTimesTest());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
   }
   performance_result_.end = std::chrono::high_resolution_clock::now();
 
@@ -152,6 +210,16 @@ Status PerformanceRunner::Run() {
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
 
+  if (!performance_result_.latencies.empty()) {
+    std::vector<double> sorted_latencies = performance_result_.latencies;
+    std::sort(sorted_latencies.begin(), sorted_latencies.end());
+    std::cout << "Target queries per second: " << performance_test_config_.run_config.target_qps << "\n"
+              << "Latency including queueing: P50 " << Percentile(sorted_latencies, 0.5) * 1000
+              << " ms, P90 " << Percentile(sorted_latencies, 0.9) * 1000
+              << " ms, P99 " << Percentile(sorted_latencies, 0.99) * 1000
+              << " ms, P99.9 " << Percentile(sorted_latencies, 0.999) * 1000 << " ms" << std::endl;
+  }
+
   return Status::OK();
 }
 
@@ -242,6 +310,61 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::RunOpenLoop() {
+  // Requests arrive at the target rate whether or not the previous ones completed, as with independent clients.
+  // Unlike the closed loop of the other modes, a slow run doesn't delay the next arrivals, so the queueing it causes
+  // shows in the tail latency instead of being hidden by a lower request rate.
+  const auto& run_config = performance_test_config_.run_config;
+  using Clock = std::chrono::high_resolution_clock;
+
+  auto tpool = std::make_unique<DefaultThreadPoolType>(static_cast<int>(run_config.concurrent_session_runs));
+  std::exponential_distribution<double> inter_arrival_seconds(run_config.target_qps);
+  std::atomic<int> counter{0};
+  std::atomic<bool> failed{false};
+  OrtMutex m;
+  OrtCondVar cv;
+
+  const auto start = Clock::now();
+  auto arrival = start;
+  auto is_done = [&](size_t requests) {
+    if (run_config.test_mode == TestMode::KFixRepeatedTimesMode) {
+      return requests >= run_config.repeated_times;
+    }
+    return std::chrono::duration<double>(arrival - start).count() >= run_config.duration_in_seconds;
+  };
+
+  for (size_t requests = 0; !is_done(requests); ++requests) {
+    std::this_thread::sleep_until(arrival);
+    counter++;
+    tpool->Schedule([this, arrival, &counter, &failed, &m, &cv]() {
+      auto status = RunOneIteration<false>();
+      if (!status.IsOK()) {
+        std::cerr << status.ErrorMessage();
+        failed = true;
+      }
+      const std::chrono::duration<double> latency = Clock::now() - arrival;
+      {
+        std::lock_guard<OrtMutex> guard(results_mutex_);
+        performance_result_.latencies.push_back(latency.count());
+      }
+
+      // Simplified version of Eigen::Barrier
+      std::lock_guard<OrtMutex> lg(m);
+      counter--;
+      cv.notify_all();
+    });
+
+    arrival += std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(inter_arrival_seconds(rand_engine_)));
+  }
+
+  //Join
+  std::unique_lock<OrtMutex> lock(m);
+  cv.wait(lock, [&counter]() { return counter == 0; });
+
+  return failed ? ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "some of the open-loop requests failed") : Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     const auto& file_path = performance_test_config_.model_info.model_file_path;
@@ -281,7 +404,8 @@ static std::unique_ptr<TestSession> CreateSession(Ort::Env& env, std::random_dev
 
 PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
     : performance_test_config_(test_config),
-      test_model_info_(CreateModelInfo(test_config)) {
+      test_model_info_(CreateModelInfo(test_config)),
+      rand_engine_(rd()) {
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = CreateSession(env, rd, test_config, *test_model_info_);
   session_create_end_ = std::chrono::high_resolution_clock::now();
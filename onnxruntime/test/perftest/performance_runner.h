@@ -34,9 +34,13 @@ struct PerformanceResult {
   short average_CPU_usage{0};
   double total_time_cost{0};
   std::vector<double> time_costs;
+  // open-loop load only: time from the arrival of each request to its completion, including the time it was queued
+  std::vector<double> latencies;
   std::string model_name;
 
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
+
+  void DumpToJson(const std::basic_string<ORTCHAR_T>& path, const RunConfig& run_config) const;
 };
 
 class PerformanceRunner {
@@ -51,6 +55,10 @@ class PerformanceRunner {
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
+    if (!performance_test_config_.run_config.json_result_file.empty()) {
+      performance_result_.DumpToJson(performance_test_config_.run_config.json_result_file,
+                                     performance_test_config_.run_config);
+    }
   }
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerformanceRunner);
 
@@ -88,6 +96,7 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status RunOpenLoop();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -112,6 +121,8 @@ class PerformanceRunner {
   std::unique_ptr<TestSession> session_;
   onnxruntime::test::HeapBuffer b_;
   std::unique_ptr<ITestCase> test_case_;
+  // draws the arrival times of the open-loop load
+  std::mt19937 rand_engine_;
 
   OrtMutex results_mutex_;
 };
@@ -57,6 +57,11 @@ struct RunConfig {
   std::basic_string<ORTCHAR_T> ep_runtime_config_string;
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_name_overrides;
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_denotation_overrides;
+  // > 0: open-loop load, requests arrive at this average rate (Poisson) whether or not the previous ones completed
+  double target_qps{0};
+  // ranges [min, max] the free dimensions of the generated inputs are drawn from, by dimension name
+  std::map<std::string, std::pair<int64_t, int64_t>> generated_input_dim_ranges;
+  std::basic_string<ORTCHAR_T> json_result_file;
 };
 
 struct PerformanceTestConfig {
@@ -1,14 +1,20 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/common/cpuid_info.h"
+#include "core/common/logging/logging.h"
+#include "core/common/parallel_for_tuner.h"
 #include "core/platform/threadpool.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -505,6 +511,85 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestSharedThreadPoolView) {
+  auto shared_tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), ThreadOptions{}, nullptr, 8, true);
+  ThreadPool capped_view(shared_tp.get(), 2, 0);
+  ThreadPool weighted_view(shared_tp.get(), 0, 3);
+  ThreadPool other_weighted_view(shared_tp.get(), 0, 1);
+
+  if (!CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
+    EXPECT_EQ(ThreadPool::DegreeOfParallelism(&capped_view), 2);
+
+    // a single active view uses the whole pool
+    EXPECT_EQ(ThreadPool::DegreeOfParallelism(&weighted_view), 8);
+    {
+      ThreadPool::ActiveScope scope(&weighted_view);
+      ThreadPool::ActiveScope nested_scope(&weighted_view);
+      ThreadPool::ActiveScope other_scope(&other_weighted_view);
+      EXPECT_EQ(ThreadPool::DegreeOfParallelism(&weighted_view), 6);
+      EXPECT_EQ(ThreadPool::DegreeOfParallelism(&other_weighted_view), 2);
+    }
+    EXPECT_EQ(ThreadPool::DegreeOfParallelism(&other_weighted_view), 8);
+  }
+
+  constexpr int num_tasks = 100;
+  auto test_data = CreateTestData(num_tasks);
+  ThreadPool::TrySimpleParallelFor(&capped_view, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ValidateTestData(*test_data);
+
+  const auto usage = ThreadPool::GetUsageStats(&capped_view);
+  EXPECT_EQ(usage.num_parallel_loops, 1u);
+  EXPECT_EQ(usage.total_degree_of_parallelism, 2u);
+  EXPECT_EQ(ThreadPool::GetUsageStats(shared_tp.get()).num_parallel_loops, 0u);
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  ThreadOptions to;
+  to.adaptive_spinning = true;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), to, nullptr, 4, true);
+
+  // alternate bursts of back to back loops, which workers should spin through, with gaps long enough to block
+  constexpr int num_tasks = 64;
+  auto test_data = CreateTestData(num_tasks);
+  int expected = 0;
+  for (int burst = 0; burst < 5; burst++) {
+    for (int loop = 0; loop < 20; loop++) {
+      ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+      expected++;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ValidateTestData(*test_data, expected);
+}
+
+TEST(ThreadPoolTest, TestParallelForTuner) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 4, true);
+  ParallelForTuner tuner;
+
+  constexpr int num_tasks = 1000;
+  const TensorOpCost cost{0, 0, 1000};
+  auto test_data = CreateTestData(num_tasks);
+  int expected = 0;
+  for (int run = 0; run < 40; run++) {
+    ParallelForTuner::KernelScope scope(&tuner, "test_kernel");
+    ThreadPool::TryParallelFor(tp.get(), num_tasks, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; i++) {
+        IncrementElement(*test_data, i);
+      }
+    });
+    expected++;
+  }
+  ValidateTestData(*test_data, expected);
+  ASSERT_EQ(tuner.GetNumberOfTunedLoops(), 1u);
+
+  const onnxruntime::PathString file_path = ORT_TSTR("parallel_for_tuner_test.txt");
+  ASSERT_TRUE(tuner.Save(file_path).IsOK());
+  ParallelForTuner loaded_tuner;
+  ASSERT_TRUE(loaded_tuner.Load(file_path).IsOK());
+  EXPECT_EQ(loaded_tuner.GetNumberOfTunedLoops(), 1u);
+  std::remove(onnxruntime::ToUTF8String(file_path).c_str());
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -539,4 +624,48 @@ TEST(ThreadPoolTest, TestStackSize) {
 #endif
 #endif
 
+TEST(ThreadPoolTest, TestStats) {
+  ThreadPoolStats stats;
+  ThreadPool::GetStats(nullptr, stats);
+  ASSERT_EQ(stats.num_threads, 0);
+  ASSERT_EQ(stats.parallel_sections, 0U);
+
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  for (int i = 0; i < 10; ++i) {
+    auto test_data = CreateTestData(100);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t j) { IncrementElement(*test_data, j); });
+    ValidateTestData(*test_data);
+  }
+
+  ThreadPool::GetStats(tp.get(), stats);
+  ASSERT_EQ(stats.num_threads, 3);
+  ASSERT_GT(stats.uptime_ns, 0U);
+  // the loops may be run by the calling thread alone, but each one is a parallel section
+  ASSERT_EQ(stats.parallel_sections, 10U);
+  ASSERT_LE(stats.busy_ns, stats.uptime_ns * stats.num_threads);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(ThreadPoolTest, TestProfilingSpans) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  auto test_data = CreateTestData(100);
+
+  ThreadPool::StartProfiling(tp.get());
+  ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ThreadPool::StopProfiling(tp.get());
+  ValidateTestData(*test_data);
+
+  // the loop itself is always recorded on the calling thread, the tasks only if a worker picked one up
+  auto spans = ThreadPool::TakeProfilingSpans(tp.get());
+  ASSERT_TRUE(std::any_of(spans.begin(), spans.end(), [](const ThreadPoolSpan& span) {
+    return span.is_parallel_loop && span.thread_id == onnxruntime::logging::GetThreadId();
+  }));
+  for (const auto& span : spans) {
+    ASSERT_LE(span.start, span.end);
+  }
+
+  ASSERT_TRUE(ThreadPool::TakeProfilingSpans(tp.get()).empty());
+}
+#endif
+
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/common/logging/logging.h"
+#include "core/platform/env.h"
 #include "core/providers/coreml/coreml_execution_provider.h"
 #include "core/providers/coreml/coreml_provider_factory.h"
 #include "core/session/inference_session.h"
@@ -171,5 +172,36 @@ TEST(CoreMLExecutionProviderTest, TestOrtFormatModel) {
 #endif
 }
 
+#if defined(__APPLE__)
+TEST(CoreMLExecutionProviderTest, TestCompilationCache) {
+  const ORTCHAR_T* model_file_name = ORT_TSTR("testdata/mnist.level1_opt.ort");
+  const PathString cache_dir = ORT_TSTR("coreml_compilation_cache_test");
+  auto& env = Env::Default();
+  if (env.FolderExists(cache_dir)) {
+    ASSERT_STATUS_OK(env.DeleteFolder(cache_dir));
+  }
+
+  RandomValueGenerator random{};
+  const std::vector<int64_t> dims = {1, 1, 28, 28};
+  std::vector<float> data = random.Gaussian<float>(dims, 0.0f, 1.f);
+
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, data, &ml_value);
+
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("Input3", ml_value));
+
+  // the first run compiles the models and saves them in the cache, the second one loads them from the cache
+  for (int i = 0; i < 2; ++i) {
+    RunAndVerifyOutputsWithEP(model_file_name, "CoreMLExecutionProviderTest.TestCompilationCache",
+                              std::make_unique<CoreMLExecutionProvider>(s_coreml_flags, ToUTF8String(cache_dir)),
+                              feeds);
+    ASSERT_TRUE(env.FolderExists(cache_dir));
+  }
+
+  ASSERT_STATUS_OK(env.DeleteFolder(cache_dir));
+}
+#endif  // defined(__APPLE__)
+
 }  // namespace test
 }  // namespace onnxruntime
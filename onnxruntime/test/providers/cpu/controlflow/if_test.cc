@@ -8,7 +8,9 @@
 #include "core/providers/cpu/controlflow/if.h"
 #include "test/providers/provider_test_utils.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
+#include "test/util/include/asserts.h"
 #include "test/util/include/default_providers.h"
 
 using namespace ONNX_NAMESPACE;
@@ -22,6 +24,7 @@ struct RunOptions {
   int symbolic_dim_value_in_main_graph = -1;
   bool include_dim_values_in_subgraph = true;
   bool mixed_execution_providers = false;
+  bool lazy_branches = false;
 };
 }  // namespace
 
@@ -253,6 +256,10 @@ void RunTest(bool condition_value,
     execution_providers.push_back(DefaultCpuExecutionProvider());
 
     test.Run(expect_result, failure_message, excluded_providers, nullptr, &execution_providers);
+  } else if (options.lazy_branches) {
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigLazyIfBranches, "1"));
+    test.Run(so, expect_result, failure_message, excluded_providers);
   } else {
     test.Run(expect_result, failure_message, excluded_providers);
   }
@@ -290,6 +297,14 @@ TEST(If, NoShapeInMainGraph_ShapeInSubgraph_False) {
   RunTest(false, options, false);
 }
 
+TEST(If, LazyBranches) {
+  RunOptions options{};
+  options.lazy_branches = true;
+
+  RunTest(true, options);
+  RunTest(false, options);
+}
+
 #ifdef USE_CUDA
 TEST(If, MixedExecutionProviders) {
   RunOptions options{};
@@ -9,10 +9,13 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/session_state.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
 #include "test/framework/test_utils.h"
+#include "test/util/include/asserts.h"
 
 using namespace ONNX_NAMESPACE;
 
@@ -475,77 +478,77 @@ TEST(Loop, ZeroIterations) {
           {});
 }
 
-TEST(Loop, InfiniteLoopTermination) {
-  auto create_subgraph = [](const RunOptions&) {
-    Model model("Infinite Loop subgraph", false, DefaultLoggingManager().DefaultLogger());
-    auto& graph = model.MainGraph();
+static ONNX_NAMESPACE::GraphProto CreateInfiniteLoopSubgraph(const RunOptions&) {
+  Model model("Infinite Loop subgraph", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
 
-    std::vector<NodeArg*> inputs;
-    std::vector<NodeArg*> outputs;
+  std::vector<NodeArg*> inputs;
+  std::vector<NodeArg*> outputs;
 
-    /* Never change cond_in so loop is infinite
-            Inputs: iter_num, cond_in, loop carried state variables.
+  /* Never change cond_in so loop is infinite
+          Inputs: iter_num, cond_in, loop carried state variables.
 
-         iter_num_in    cond_in     [outer_scope_0]
-           (unused)        |                |
-                       [Identity]      [Identity]
-                           |               |
-                        cond_out     loop_var_0_out
-    */
+       iter_num_in    cond_in     [outer_scope_0]
+         (unused)        |                |
+                     [Identity]      [Identity]
+                         |               |
+                      cond_out     loop_var_0_out
+  */
 
-    // graph inputs types.
-    TypeProto int64_scalar;
-    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
-    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  // graph inputs types.
+  TypeProto int64_scalar;
+  int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
 
-    TypeProto bool_scalar;
-    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
-    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  TypeProto bool_scalar;
+  bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
 
-    TypeProto float_tensor;
-    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
-    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim();
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim();
 
-    // graph inputs
-    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
-    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+  // graph inputs
+  auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+  auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
 
-    // outer scope value. need type but not shape.
-    auto& outer_scope_0 = graph.GetOrCreateNodeArg("outer_scope_0", &float_tensor);
+  // outer scope value. need type but not shape.
+  auto& outer_scope_0 = graph.GetOrCreateNodeArg("outer_scope_0", &float_tensor);
 
-    // add so that we don't end up with it being considered a graph input
-    graph.AddOuterScopeNodeArg("outer_scope_0");
+  // add so that we don't end up with it being considered a graph input
+  graph.AddOuterScopeNodeArg("outer_scope_0");
 
-    // graph outputs
-    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
-    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_tensor);
+  // graph outputs
+  auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+  auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_tensor);
 
-    // cond_in -> cond_out
-    {
-      inputs = {&cond_in};
-      outputs = {&cond_out};
+  // cond_in -> cond_out
+  {
+    inputs = {&cond_in};
+    outputs = {&cond_out};
 
-      graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", inputs, outputs);
-    }
+    graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", inputs, outputs);
+  }
 
-    // outer_scope_0 -> loop_var_0_out
-    {
-      inputs = {&outer_scope_0};
-      outputs = {&loop_var_0_out};
+  // outer_scope_0 -> loop_var_0_out
+  {
+    inputs = {&outer_scope_0};
+    outputs = {&loop_var_0_out};
 
-      graph.AddNode("loop_var_out", "Identity", "Forward outer_scope_0 to loop_var_0_out", inputs, outputs);
-    }
+    graph.AddNode("loop_var_out", "Identity", "Forward outer_scope_0 to loop_var_0_out", inputs, outputs);
+  }
 
-    graph.SetInputs({&iter_num_in, &cond_in, &outer_scope_0});
-    graph.SetOutputs({&cond_out, &loop_var_0_out});
+  graph.SetInputs({&iter_num_in, &cond_in, &outer_scope_0});
+  graph.SetOutputs({&cond_out, &loop_var_0_out});
 
-    auto status = graph.Resolve();
-    EXPECT_EQ(status, Status::OK());
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
 
-    return graph.ToGraphProto();
-  };
+  return graph.ToGraphProto();
+}
 
-  LoopOpTester test{{}, create_subgraph};
+TEST(Loop, InfiniteLoopTermination) {
+  LoopOpTester test{{}, CreateInfiniteLoopSubgraph};
 
   test.AddInput<int64_t>("M", {1}, {INT64_MAX});
   test.AddInput<bool>("cond", {1}, {true});
@@ -579,6 +582,57 @@ TEST(Loop, InfiniteLoopTermination) {
   terminator_thread.join();
 }
 
+TEST(Loop, InfiniteLoopTimeout) {
+  LoopOpTester test{{}, CreateInfiniteLoopSubgraph};
+
+  test.AddInput<int64_t>("M", {1}, {INT64_MAX});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("fake", {1}, {0.f});
+  test.AddInput<float>("outer_scope_0", {1}, {kOuterNodeAddValue});
+
+  test.AddOutput<float>("loop_var_0_final", {1}, {0.f});
+  test.AddOutput<int64_t>("outer_scope_0_out", {1}, {int64_t(kOuterNodeAddValue)});
+
+  // OpTester only checks the error message, so run the model directly to check the status code as well
+  std::string serialized_model;
+  ASSERT_TRUE(test.BuildGraph()->ToProto().SerializeToString(&serialized_model));
+
+  auto cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  NameMLValMap feeds;
+  OrtValue ml_value;
+  CreateMLValue<int64_t>(cpu_allocator, {1}, {INT64_MAX}, &ml_value);
+  feeds.insert(std::make_pair("M", ml_value));
+  CreateMLValue<bool>(cpu_allocator, {1}, {true}, &ml_value);
+  feeds.insert(std::make_pair("cond", ml_value));
+  CreateMLValue<float>(cpu_allocator, {1}, {0.f}, &ml_value);
+  feeds.insert(std::make_pair("fake", ml_value));
+  CreateMLValue<float>(cpu_allocator, {1}, {kOuterNodeAddValue}, &ml_value);
+  feeds.insert(std::make_pair("outer_scope_0", ml_value));
+
+  std::vector<std::string> output_names{"loop_var_0_final", "outer_scope_0_out"};
+
+  // the deadline is checked between the nodes of the iterations of the loop
+  RunOptions run_options;
+  run_options.run_tag = "Loop.InfiniteLoopTimeout";
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigTimeoutMs, "100"));
+
+  for (auto execution_mode : {ExecutionMode::ORT_SEQUENTIAL, ExecutionMode::ORT_PARALLEL}) {
+    SessionOptions so;
+    so.session_logid = "Loop.InfiniteLoopTimeout";
+    so.execution_mode = execution_mode;
+
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(serialized_model.data(), static_cast<int>(serialized_model.size())));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    std::vector<OrtValue> fetches;
+    const auto status = session_object.Run(run_options, feeds, output_names, &fetches);
+    ASSERT_FALSE(status.IsOK());
+    EXPECT_EQ(status.Code(), common::TIMEOUT) << status;
+    EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("Exiting due to the deadline of the run having passed"));
+  }
+}
+
 // Add basic test to trigger types override logic in Graph::InferAndVerifySubgraphTypes as well as
 // type/shape inferencing for subgraph to flow the type/shape info through
 // subgraph.PerformTypeAndShapeInferencing(options).
@@ -1038,6 +1092,143 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// check the scan outputs are correct when the loop runs more iterations than the buffer holding them initially
+// has room for, so it grows while earlier iterations already wrote their values in it.
+TEST(Loop, ScanOutputsGrowOverManyIterations) {
+  auto create_subgraph = []() {
+    Model model("Scan outputs over many iterations", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, loop carried state variables.
+
+         iter_num_in    sum_in    cond_in
+           |   |   \     /          |
+           | [Mul]  [Add]       [Identity]
+           |   |      |   \          |
+           | square  sum_out  \   cond_out
+           |                [Identity]
+           |                    |
+           |                sum_scan
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& sum_in = graph.GetOrCreateNodeArg("sum_in", &int64_scalar);
+
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& sum_out = graph.GetOrCreateNodeArg("sum_out", &int64_scalar);
+    auto& sum_scan = graph.GetOrCreateNodeArg("sum_scan", &int64_scalar);
+    auto& square = graph.GetOrCreateNodeArg("square", &int64_scalar);
+
+    graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+    graph.AddNode("add", "Add", "Add iter_num to sum", {&sum_in, &iter_num_in}, {&sum_out});
+    graph.AddNode("sum_identity", "Identity", "Scan the sums", {&sum_out}, {&sum_scan});
+    graph.AddNode("mul", "Mul", "Square iter_num", {&iter_num_in, &iter_num_in}, {&square});
+
+    graph.SetInputs({&iter_num_in, &cond_in, &sum_in});
+    graph.SetOutputs({&cond_out, &sum_out, &sum_scan, &square});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  constexpr int64_t kIterations = 40;
+  std::vector<int64_t> sums;
+  std::vector<int64_t> squares;
+  int64_t sum = 0;
+  for (int64_t i = 0; i < kIterations; ++i) {
+    sum += i;
+    sums.push_back(sum);
+    squares.push_back(i * i);
+  }
+
+  OpTester test("Loop", 11);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+  test.AddInput<int64_t>("M", {1}, {kIterations});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<int64_t>("sum_init", {1}, {0});
+
+  test.AddOutput<int64_t>("sum_final", {1}, {sum});
+  test.AddOutput<int64_t>("sum_scan_final", {kIterations, 1}, sums);
+  test.AddOutput<int64_t>("square_final", {kIterations, 1}, squares);
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+// a Loop whose iterations only depend on iter_num, which can run them concurrently
+TEST(Loop, IndependentIterations) {
+  auto create_subgraph = []() {
+    Model model("Independent iterations", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in.
+
+         iter_num_in    cond_in
+            |   |          |
+            [Mul]      [Identity]
+              |            |
+           square      cond_out
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& square = graph.GetOrCreateNodeArg("square", &int64_scalar);
+
+    graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+    graph.AddNode("mul", "Mul", "Square iter_num", {&iter_num_in, &iter_num_in}, {&square});
+
+    graph.SetInputs({&iter_num_in, &cond_in});
+    graph.SetOutputs({&cond_out, &square});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  constexpr int64_t kIterations = 100;
+  std::vector<int64_t> squares;
+  for (int64_t i = 0; i < kIterations; ++i) {
+    squares.push_back(i * i);
+  }
+
+  for (const char* parallel_iterations : {"0", "1"}) {
+    OpTester test("Loop", 11);
+    auto body = create_subgraph();
+    test.AddAttribute<GraphProto>("body", body);
+    test.AddInput<int64_t>("M", {1}, {kIterations});
+    test.AddInput<bool>("cond", {1}, {true});
+    test.AddOutput<int64_t>("square_final", {kIterations, 1}, squares);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigParallelLoopIterations,
+                                                      parallel_iterations));
+    // Disable TensorRT on unsupported data type BOOL
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
+}
+
 #ifdef USE_CUDA
 // test that when part of the subgraph run on CUDA it executes successfully
 TEST(Loop, MixedExecutionProviders) {
@@ -209,6 +209,17 @@ TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input) {
   test.Run();
 }
 
+// The last two operands are contracted first as that avoids the [i, k] product of the first two
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_Reordered) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,k->i");
+  test.AddInput<float>("x", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("z", {2}, {1.f, -1.f});
+  test.AddOutput<float>("o", {2}, {-6.f, -15.f});
+  test.Run();
+}
+
 TEST(Einsum, ExplicitEinsumAsBatchedMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
   test.AddAttribute<std::string>("equation", "bij,bjk->bik");
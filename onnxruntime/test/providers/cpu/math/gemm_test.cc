@@ -5,6 +5,7 @@
 #include "test/providers/provider_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/util/include/default_providers.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace test {
@@ -86,6 +87,57 @@ TEST(GemmOpTest, GemmNoTrans_f16) {
 }
 #endif
 
+// The CPU kernel is only registered when MLAS has native half precision arithmetic for the processor.
+TEST(GemmOpTest, GemmTransAB_f16_Cpu) {
+  if (!MlasFp16AccelerationSupported()) {
+    return;
+  }
+  auto run_test = [](float alpha, float beta, const std::vector<int64_t>& c_dims, const std::vector<float>& C,
+                     const std::vector<float>& Y) {
+    OpTester test("Gemm", 13);
+
+    test.AddAttribute("transA", (int64_t)1);
+    test.AddAttribute("transB", (int64_t)1);
+    test.AddAttribute("alpha", alpha);
+    test.AddAttribute("beta", beta);
+
+    // A is 4x2 and B is 3x4, both transposed
+    std::vector<float> A{1.0f, -1.0f,
+                         2.0f, -2.0f,
+                         3.0f, -3.0f,
+                         4.0f, -4.0f};
+    std::vector<float> B{1.0f, 1.0f, 1.0f, 1.0f,
+                         0.5f, 0.5f, 0.5f, 0.5f,
+                         -1.0f, -1.0f, -1.0f, -1.0f};
+
+    std::vector<MLFloat16> f_A(A.size());
+    std::vector<MLFloat16> f_B(B.size());
+    std::vector<MLFloat16> f_C(C.size());
+    std::vector<MLFloat16> f_Y(Y.size());
+    ConvertFloatToMLFloat16(A.data(), f_A.data(), static_cast<int>(A.size()));
+    ConvertFloatToMLFloat16(B.data(), f_B.data(), static_cast<int>(B.size()));
+    ConvertFloatToMLFloat16(C.data(), f_C.data(), static_cast<int>(C.size()));
+    ConvertFloatToMLFloat16(Y.data(), f_Y.data(), static_cast<int>(Y.size()));
+
+    test.AddInput<MLFloat16>("A", {4, 2}, f_A);
+    test.AddInput<MLFloat16>("B", {3, 4}, f_B, true);
+    test.AddInput<MLFloat16>("C", c_dims, f_C);
+    test.AddOutput<MLFloat16>("Y", {2, 3}, f_Y);
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  };
+
+  // bias folded into the kernel
+  run_test(1.0f, 1.0f, {3}, {1.0f, 2.0f, 3.0f},
+           {11.0f, 7.0f, -7.0f,
+            -9.0f, -3.0f, 13.0f});
+  // scaled output with a broadcast column bias
+  run_test(0.5f, 2.0f, {2, 1}, {1.0f, -1.0f},
+           {7.0f, 4.5f, -3.0f,
+            -7.0f, -4.5f, 3.0f});
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(GemmOpTest, GemmNoTrans_bfloat16) {
 #ifdef USE_CUDA
@@ -114,6 +166,28 @@ TEST(GemmOpTest, GemmNoTrans_bfloat16) {
 }
 #endif
 
+// The CPU kernel is only registered when MLAS has bfloat16 instructions for the processor.
+TEST(GemmOpTest, GemmTransAB_bfloat16_Cpu) {
+  if (!MlasBf16AccelerationSupported()) {
+    return;
+  }
+  OpTester test("Gemm", 13);
+  test.AddAttribute("transA", (int64_t)1);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", 0.5f);
+  test.AddAttribute("beta", 2.0f);
+
+  // A is 4x2 and B is 3x4, both transposed
+  test.AddInput<BFloat16>("A", {4, 2}, MakeBFloat16({1.0f, -1.0f, 2.0f, -2.0f, 3.0f, -3.0f, 4.0f, -4.0f}));
+  test.AddInput<BFloat16>("B", {3, 4},
+                          MakeBFloat16({1.f, 1.f, 1.f, 1.f, 0.5f, 0.5f, 0.5f, 0.5f, -1.f, -1.f, -1.f, -1.f}), true);
+  test.AddInput<BFloat16>("C", {2, 1}, MakeBFloat16({1.f, -1.f}));
+  test.AddOutput<BFloat16>("Y", {2, 3}, MakeBFloat16({7.0f, 4.5f, -3.0f, -7.0f, -4.5f, 3.0f}));
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 template <typename T>
 void TestGemmBroadcast() {
   auto run_test = [](bool b_is_initializer, bool c_is_initializer) {
@@ -5,6 +5,7 @@
 #include "test/providers/provider_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "default_providers.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace test {
@@ -194,6 +195,37 @@ TEST(MathOpTest, MatMul_Float16) {
 }
 #endif
 
+// The CPU kernel is only registered when MLAS has native half precision arithmetic for the processor.
+TEST(MathOpTest, MatMul_Float16_Cpu) {
+  if (!MlasFp16AccelerationSupported()) {
+    return;
+  }
+  OpTester test("MatMul", 13);
+
+  std::vector<float> A{1.0f, 2.0f, 3.0f, 4.0f,
+                       -1.0f, -2.0f, -3.0f, -4.0f};
+  std::vector<float> B{0.5f, 1.0f, -1.0f,
+                       0.5f, 1.0f, -1.0f,
+                       0.5f, 1.0f, -1.0f,
+                       0.5f, 1.0f, -1.0f};
+  std::vector<float> Y{5.0f, 10.0f, -10.0f,
+                       -5.0f, -10.0f, 10.0f};
+
+  std::vector<MLFloat16> f_A(8);
+  std::vector<MLFloat16> f_B(12);
+  std::vector<MLFloat16> f_Y(6);
+  ConvertFloatToMLFloat16(A.data(), f_A.data(), 8);
+  ConvertFloatToMLFloat16(B.data(), f_B.data(), 12);
+  ConvertFloatToMLFloat16(Y.data(), f_Y.data(), 6);
+
+  test.AddInput<MLFloat16>("A", {2, 4}, f_A);
+  test.AddInput<MLFloat16>("B", {4, 3}, f_B, true);
+  test.AddOutput<MLFloat16>("Y", {2, 3}, f_Y);
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(MathOpTest, MatMul_BFloat16) {
 #ifdef USE_CUDA
@@ -218,6 +250,28 @@ TEST(MathOpTest, MatMul_BFloat16) {
 }
 #endif
 
+// The CPU kernel is only registered when MLAS has bfloat16 instructions for the processor.
+TEST(MathOpTest, MatMul_BFloat16_Cpu) {
+  if (!MlasBf16AccelerationSupported()) {
+    return;
+  }
+  auto run_test = [](bool b_is_initializer) {
+    OpTester test("MatMul", 13);
+
+    test.AddInput<BFloat16>("A", {2, 4}, MakeBFloat16({1.0f, 2.0f, 3.0f, 4.0f, -1.0f, -2.0f, -3.0f, -4.0f}));
+    test.AddInput<BFloat16>("B", {4, 3},
+                            MakeBFloat16({0.5f, 1.f, -1.f, 0.5f, 1.f, -1.f, 0.5f, 1.f, -1.f, 0.5f, 1.f, -1.f}),
+                            b_is_initializer);
+    test.AddOutput<BFloat16>("Y", {2, 3}, MakeBFloat16({5.0f, 10.0f, -10.0f, -5.0f, -10.0f, 10.0f}));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  };
+
+  run_test(false);
+  run_test(true);
+}
+
 #ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   OpTester test("MatMul");
@@ -229,6 +229,40 @@ TEST(QuantizeLinearMatmulOpTest, QLinearMatMul2D_S8S8) {
   run_test(true);
 }
 
+// Symmetric per-tensor quantization with a constant B, which the CUDA EP runs on the int8 tensor cores with the
+// requantization fused into the GEMM.
+TEST(QuantizeLinearMatmulOpTest, QLinearMatMul2D_S8S8_Symmetric) {
+  OpTester test("QLinearMatMul", 10);
+  test.AddInput<int8_t>("T1", {2, 8},
+                        {80, -2, -128, 110, -125, 86, 127, -99,
+                         -43, 51, -34, 60, 26, -17, 0, 63});
+
+  test.AddInput<float>("a_scale", {}, {0.0066f}, true);
+  test.AddInput<int8_t>("a_zero_point", {}, {0}, true);
+
+  test.AddInput<int8_t>("T2", {8, 4},
+                        {-43, 51, -34, 60,
+                         26, -17, 0, 63,
+                         -55, 47, -29, -31,
+                         -62, 51, -42, 60,
+                         26, -22, 0, -8,
+                         -19, 37, -2, -47,
+                         12, -90, 33, 7,
+                         -5, 18, -71, 40},
+                        true);
+
+  test.AddInput<float>("b_scale", {}, {0.00802f}, true);
+  test.AddInput<int8_t>("b_zero_point", {}, {0}, true);
+
+  test.AddInput<float>("y_scale", {}, {0.0123f}, true);
+  test.AddInput<int8_t>("y_zero_point", {}, {0}, true);
+  test.AddOutput<int8_t>("T3", {2, 4},
+                         {-26, -15, 32, 39,
+                          9, -7, -19, 36});
+
+  test.Run();
+}
+
 static void QLinearMatMul2DTest(bool only_t1_not_initializer) {
   // Test non-empty inputs
   OpTester test_non_empty("QLinearMatMul", 10);
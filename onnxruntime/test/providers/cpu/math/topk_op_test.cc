@@ -5,6 +5,9 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "core/providers/cpu/math/top_k.h"
 
 namespace onnxruntime {
 namespace test {
@@ -861,5 +864,84 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// rows long enough for the radix select, with many ties so the order of equal values is checked.
+template <typename T>
+static void TestRadixSelect(int64_t k, int64_t n, int64_t batch_size, int64_t largest) {
+  std::vector<T> input_vals(n * batch_size);
+  for (int64_t i = 0; i < n * batch_size; ++i) {
+    input_vals[i] = static_cast<T>((i * 7919) % 1000) - static_cast<T>(500);
+  }
+
+  std::vector<int64_t> input_dimensions = {n, batch_size};
+  std::vector<T> expected_vals(n * k);
+  std::vector<int64_t> expected_indices(n * k);
+  std::vector<int64_t> expected_dimensions = {n, k};
+
+  std::vector<int64_t> order(batch_size);
+  for (int64_t i = 0; i < n; ++i) {
+    const T* row = input_vals.data() + i * batch_size;
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [row, largest](int64_t lhs, int64_t rhs) {
+      return largest ? row[lhs] > row[rhs] : row[lhs] < row[rhs];
+    });
+    for (int64_t j = 0; j < k; ++j) {
+      expected_vals[i * k + j] = row[order[j]];
+      expected_indices[i * k + j] = order[j];
+    }
+  }
+
+  RunTest(11, k, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, -1,
+          largest);
+}
+
+TEST(TopKOperator, RadixSelectLongRows) {
+  TestRadixSelect<float>(300, 2, 40000, 1);
+  TestRadixSelect<float>(300, 2, 40000, 0);
+  TestRadixSelect<float>(5, 1, 100000, 1);
+  TestRadixSelect<double>(300, 1, 40000, 1);
+  TestRadixSelect<int32_t>(300, 3, 20000, 0);
+  TestRadixSelect<int64_t>(300, 1, 20000, 1);
+}
+
+TEST(TopKOperator, TopKSoftmax) {
+  constexpr int64_t rows = 2;
+  constexpr int64_t cols = 50000;
+  constexpr unsigned k = 8;
+  std::vector<float> input_vals(rows * cols);
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    input_vals[i] = static_cast<float>((i * 7919) % 997) / 100.0f;
+  }
+
+  auto allocator = std::make_shared<CPUAllocator>();
+  Tensor input(DataTypeImpl::GetType<float>(), TensorShape({rows, cols}), input_vals.data(), allocator->Info());
+
+  for (bool log_softmax : {false, true}) {
+    std::unique_ptr<Tensor> values;
+    std::unique_ptr<Tensor> indices;
+    ASSERT_TRUE(GetTopKSoftmax<float>(&input, k, log_softmax, allocator, nullptr, values, indices).IsOK());
+    ASSERT_EQ(values->Shape(), TensorShape({rows, k}));
+
+    for (int64_t i = 0; i < rows; ++i) {
+      const float* row = input_vals.data() + i * cols;
+      const float max = *std::max_element(row, row + cols);
+      double sum = 0.0;
+      for (int64_t j = 0; j < cols; ++j) {
+        sum += std::exp(static_cast<double>(row[j] - max));
+      }
+
+      for (unsigned j = 0; j < k; ++j) {
+        const int64_t index = indices->Data<int64_t>()[i * k + j];
+        const double x = static_cast<double>(row[index] - max);
+        const double expected = log_softmax ? x - std::log(sum) : std::exp(x) / sum;
+        EXPECT_NEAR(values->Data<float>()[i * k + j], expected, log_softmax ? 1e-4 : 1e-6);
+        if (j > 0) {
+          EXPECT_GE(values->Data<float>()[i * k + j - 1], values->Data<float>()[i * k + j]);
+        }
+      }
+      EXPECT_EQ(row[indices->Data<int64_t>()[i * k]], max);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -42,5 +44,28 @@ TEST(MLOpTest, DictVectorizerInt64Input) {
   test.Run();
 }
 
+TEST(MLOpTest, DictVectorizerLargeVocabulary) {
+  OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
+
+  std::vector<int64_t> vocabulary(100);
+  std::iota(vocabulary.begin(), vocabulary.end(), 100);
+  test.AddAttribute("int64_vocabulary", vocabulary);
+
+  std::map<int64_t, float> map;
+  map[105] = 1.5f;
+  map[150] = 2.f;
+  map[199] = -3.f;
+  map[500] = 4.f;  // not in the vocabulary
+
+  test.AddInput<int64_t, float>("X", map);
+
+  std::vector<float> expected(100, 0.f);
+  expected[5] = 1.5f;
+  expected[50] = 2.f;
+  expected[99] = -3.f;
+  test.AddOutput<float>("Y", {1, 100}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
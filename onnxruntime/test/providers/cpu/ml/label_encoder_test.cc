@@ -63,6 +63,39 @@ TEST(LabelEncoder, StringToIntOpset2) {
   test.Run();
 }
 
+TEST(LabelEncoder, StringToIntOpset2LargeInput) {
+  // enough elements for the lookups to be split across the thread pool
+  constexpr int64_t num_keys = 1000;
+  constexpr int64_t num_elements = 100000;
+
+  std::vector<std::string> keys;
+  std::vector<std::int64_t> values;
+  for (int64_t i = 0; i < num_keys; ++i) {
+    keys.push_back("category_" + std::to_string(i));
+    values.push_back(i * 3);
+  }
+
+  std::vector<std::string> input;
+  std::vector<std::int64_t> output;
+  for (int64_t i = 0; i < num_elements; ++i) {
+    // about one in seven of the elements is not a key
+    const int64_t key = (i * 31) % (num_keys + num_keys / 6);
+    input.push_back("category_" + std::to_string(key));
+    output.push_back(key < num_keys ? key * 3 : -7);
+  }
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_strings", keys);
+  test.AddAttribute("values_int64s", values);
+  test.AddAttribute("default_int64", (std::int64_t)-7);
+
+  test.AddInput<std::string>("X", {num_elements}, input);
+  test.AddOutput<std::int64_t>("Y", {num_elements}, output);
+
+  test.Run();
+}
+
 TEST(LabelEncoder, IntToStringOpset2) {
   std::vector<std::int64_t> dims{1, 5};
 
@@ -166,5 +166,40 @@ TEST(MLOpTest, LinearClassifierMulticlassInt32Input) {
 TEST(MLOpTest, LinearClassifierMulticlassDoubleInput) {
   LinearClassifierMulticlass<double>();
 }
+
+// one-hot input, which is scored from the non-zero features only
+TEST(MLOpTest, LinearClassifierMulticlassOneHotInput) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  constexpr int64_t num_features = 100;
+  std::vector<float> coefficients(3 * num_features);
+  for (int64_t i = 0; i < 3 * num_features; ++i) {
+    coefficients[i] = static_cast<float>(i % 7) - 3.f;
+  }
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<float> intercepts = {0.5f, -0.25f, 0.125f};
+
+  // features 10 and 52 are set
+  std::vector<float> X(2 * num_features, 0.f);
+  X[10] = 1.f;
+  X[num_features + 52] = 2.f;
+
+  std::vector<float> predictions(6);
+  for (int64_t j = 0; j < 3; ++j) {
+    predictions[j] = coefficients[j * num_features + 10] + intercepts[j];
+    predictions[3 + j] = 2.f * coefficients[j * num_features + 52] + intercepts[j];
+  }
+  std::vector<int64_t> predicted_class = {2, 2};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {2, num_features}, X);
+  test.AddOutput<int64_t>("Y", {2}, predicted_class);
+  test.AddOutput<float>("Z", {2, 3}, predictions);
+
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
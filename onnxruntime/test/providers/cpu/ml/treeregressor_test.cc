@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -676,5 +678,99 @@ TEST(MLOpTest, TreeRegressorSingleTargetSum_as_tensor_precision) {
   GenTreeAndRunTest1_as_tensor_precision(3);
 }
 
+// A tree where each branch node has a leaf as true child: leaf i is reached when x <= i (or x < i).
+// Small trees are evaluated with QuickScorer, trees with more than 64 leaves with the flattened layout.
+void GenChainTreeAndRunTest(int64_t n_leaves, const std::string& mode, const char* quantize_thresholds = "") {
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  std::vector<int64_t> lefts, rights, treeids, nodeids, featureids;
+  std::vector<float> thresholds;
+  std::vector<std::string> modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_classids;
+  std::vector<float> target_weights;
+  for (int64_t i = 0; i < n_leaves; ++i) {
+    const bool last = i == n_leaves - 1;
+    if (!last) {
+      nodeids.push_back(2 * i);
+      lefts.push_back(2 * i + 1);
+      rights.push_back(2 * i + 2);
+      featureids.push_back(0);
+      thresholds.push_back(static_cast<float>(i));
+      modes.push_back(mode);
+      treeids.push_back(0);
+    }
+
+    const int64_t leaf = last ? 2 * i : 2 * i + 1;
+    nodeids.push_back(leaf);
+    lefts.push_back(0);
+    rights.push_back(0);
+    featureids.push_back(0);
+    thresholds.push_back(0.f);
+    modes.push_back("LEAF");
+    treeids.push_back(0);
+
+    target_treeids.push_back(0);
+    target_nodeids.push_back(leaf);
+    target_classids.push_back(0);
+    target_weights.push_back(static_cast<float>(i));
+  }
+
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_classids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  std::vector<float> X;
+  std::vector<float> Y;
+  for (float x = -1.5f; x < static_cast<float>(n_leaves) + 1.f; x += 0.5f) {
+    int64_t leaf = 0;
+    auto condition = [&mode, x](float threshold) {
+      return mode == "BRANCH_LEQ" ? x <= threshold
+             : mode == "BRANCH_LT" ? x < threshold
+             : mode == "BRANCH_GTE" ? x >= threshold
+                                    : x > threshold;
+    };
+    while (leaf < n_leaves - 1 && !condition(static_cast<float>(leaf))) {
+      ++leaf;
+    }
+    X.push_back(x);
+    Y.push_back(static_cast<float>(leaf));
+  }
+  X.push_back(std::numeric_limits<float>::quiet_NaN());
+  Y.push_back(static_cast<float>(n_leaves - 1));
+
+  const int64_t n_rows = static_cast<int64_t>(X.size());
+  test.AddInput<float>("X", {n_rows, 1}, X);
+  test.AddOutput<float>("Y", {n_rows, 1}, Y);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigTreeEnsembleQuantizeThresholds,
+                                                    quantize_thresholds));
+  test.Run(so);
+}
+
+TEST(MLOpTest, TreeRegressorChainTree) {
+  GenChainTreeAndRunTest(10, "BRANCH_LEQ");
+  GenChainTreeAndRunTest(10, "BRANCH_LT");
+  GenChainTreeAndRunTest(100, "BRANCH_LEQ");
+  GenChainTreeAndRunTest(100, "BRANCH_LT");
+}
+
+TEST(MLOpTest, TreeRegressorQuantizedThresholds) {
+  for (const char* mode : {"BRANCH_LEQ", "BRANCH_LT", "BRANCH_GTE", "BRANCH_GT"}) {
+    GenChainTreeAndRunTest(10, mode, "1");
+    GenChainTreeAndRunTest(100, mode, "1");
+    GenChainTreeAndRunTest(100, mode, "0");
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
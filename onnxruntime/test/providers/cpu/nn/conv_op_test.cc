@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 using namespace std;
@@ -725,5 +726,56 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// Conv with a 3x3 filter initializer that is packed for the Winograd convolution.
+TEST(ConvTest, Conv2D_Winograd) {
+  constexpr int64_t C = 3, M = 4, H = 7, W = 6;
+  vector<float> X(C * H * W);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>(static_cast<int>(i % 13) - 6) / 4.0f;
+  }
+  vector<float> Wt(M * C * 3 * 3);
+  for (size_t i = 0; i < Wt.size(); i++) {
+    Wt[i] = static_cast<float>(static_cast<int>(i % 7) - 3) / 2.0f;
+  }
+  vector<float> B = {0.5f, -1.0f, 0.0f, 2.0f};
+
+  // Reference convolution with pads of 1.
+  vector<float> Y(M * H * W);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t oh = 0; oh < H; oh++) {
+      for (int64_t ow = 0; ow < W; ow++) {
+        float sum = B[m];
+        for (int64_t c = 0; c < C; c++) {
+          for (int64_t kh = 0; kh < 3; kh++) {
+            for (int64_t kw = 0; kw < 3; kw++) {
+              int64_t ih = oh + kh - 1;
+              int64_t iw = ow + kw - 1;
+              if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                sum += X[(c * H + ih) * W + iw] * Wt[((m * C + c) * 3 + kh) * 3 + kw];
+              }
+            }
+          }
+        }
+        Y[(m * H + oh) * W + ow] = sum;
+      }
+    }
+  }
+
+  for (const char* winograd_mode : {"0", "1", ""}) {
+    OpTester test("Conv", 11);
+    test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+    test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+    test.AddInput<float>("X", {1, C, H, W}, X);
+    test.AddInput<float>("W", {M, C, 3, 3}, Wt, true);
+    test.AddInput<float>("B", {M}, B);
+    test.AddOutput<float>("Y", {1, M, H, W}, Y);
+    test.SetOutputAbsErr("Y", 1e-4f);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigConvWinograd, winograd_mode));
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
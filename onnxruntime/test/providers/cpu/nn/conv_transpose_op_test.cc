@@ -545,6 +545,33 @@ TEST(ConvTransposeTest, ConvTranspose_onnx_group) {
   TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+TEST(ConvTransposeTest, ConvTranspose_2D_Group_Bias_Batch_Upsample) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{2, 2},        // kernel_shape
+      {},                           // output_padding
+      {},                           // output_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{2, 2},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      2,                            // group
+      "NOTSET"                      // auto_pad
+  };
+  vector<float> X = {1.f, 2.f, 2.f, -1.f,
+                     3.f, 0.f, -1.f, 1.f};
+  vector<int64_t> X_shape = {2, 2, 1, 2};
+  vector<float> W = {1.f, 2.f, 3.f, 4.f,
+                     0.5f, -1.f, 2.f, 0.f};
+  vector<int64_t> W_shape = {2, 1, 2, 2};
+  vector<float> B = {1.f, -1.f};
+  vector<int64_t> B_shape = {2};
+  vector<int64_t> Y_shape = {2, 2, 2, 4};
+  auto expected_vals = {2.f, 3.f, 3.f, 5.f, 4.f, 5.f, 7.f, 9.f,
+                        0.f, -3.f, -1.5f, 0.f, 3.f, -1.f, -3.f, -1.f,
+                        4.f, 7.f, 1.f, 1.f, 10.f, 13.f, 1.f, 1.f,
+                        -1.5f, 0.f, -0.5f, -2.f, -3.f, -1.f, 1.f, -1.f};
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 TEST(ConvTransposeTest, ConvTranspose_2D_Dilation_1) {
   ConvTransposeOpAttributes attrs = {
       vector<int64_t>{2, 2},
@@ -779,6 +779,20 @@ TEST(QLinearConvTest, Conv2D_U8S8_Groups) {
   test.Run();
 }
 
+TEST(QLinearConvTest, Conv2D_U8S8_Groups_Batch) {
+  for (int64_t groups : std::initializer_list<int64_t>{3, 4, 8}) {
+    QLinearConvOpTester<uint8_t, int8_t> test;
+    test.GenerateRandomInput({3, 24, 11, 9}, .03f, 7);
+    test.GenerateRandomWeights({48, 24 / groups, 3, 3}, .10f, 0);
+    test.GenerateRandomBias();
+    test.SetPads({1, 1, 1, 1});
+    test.SetStrides({2, 2});
+    test.SetGroups(groups);
+    test.SetOutputScaleAndZeroPoint(.76f, 88);
+    test.Run();
+  }
+}
+
 TEST(QLinearConvTest, Conv3D_U8S8_Groups) {
   QLinearConvOpTester<uint8_t, int8_t> test;
   test.GenerateRandomInput({2, 4, 13, 17, 13}, .03f, 7);
@@ -852,6 +866,20 @@ TEST(QLinearConvTest, Conv2D_U8S8_Depthwise) {
   }
 }
 
+TEST(QLinearConvTest, Conv2D_U8S8_Depthwise_Batch) {
+  for (int64_t channels : std::initializer_list<int64_t>{8, 25}) {
+    QLinearConvOpTester<uint8_t, int8_t> test;
+    test.GenerateRandomInput({3, channels, 15, 12}, .03f, 12);
+    test.GenerateRandomWeights({channels, 1, 3, 3}, .10f, 0);
+    test.GenerateRandomBias();
+    test.SetPads({1, 0, 1, 2});
+    test.SetStrides({2, 1});
+    test.SetGroups(channels);
+    test.SetOutputScaleAndZeroPoint(.76f, 88);
+    test.Run();
+  }
+}
+
 TEST(QLinearConvTest, Conv2D_U8S8_Depthwise_PerChannel) {
   for (int8_t weight_zero_point : std::initializer_list<int8_t>{0, -2}) {
     for (int64_t channels : std::initializer_list<int64_t>{7, 8, 9, 16,
@@ -1019,6 +1047,50 @@ TEST(QLinearConvTest, Conv2D_U8S8_Requantize_Bias_PerChannel) {
   }
 }
 
+void RunConv2DWithSumTest(bool channels_last) {
+  OpTester test("QLinearConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("channels_last", channels_last ? 1 : 0);
+
+  if (channels_last) {
+    test.AddInput<uint8_t>("x", {1, 2, 2, 2}, {1, 5, 2, 6, 3, 7, 4, 8});
+  } else {
+    test.AddInput<uint8_t>("x", {1, 2, 2, 2}, {1, 2, 3, 4, 5, 6, 7, 8});
+  }
+  test.AddInput<float>("x_scale", {}, {1.0f}, true);
+  test.AddInput<uint8_t>("x_zero_point", {}, {0}, true);
+  test.AddInput<int8_t>("w", {2, 2, 1, 1}, {1, 1, 1, -1}, true);
+  test.AddInput<float>("w_scale", {}, {1.0f}, true);
+  test.AddInput<int8_t>("w_zero_point", {}, {0}, true);
+  test.AddInput<float>("y_scale", {}, {2.0f}, true);
+  test.AddInput<uint8_t>("y_zero_point", {}, {100}, true);
+  test.AddOptionalInputEdge<int32_t>();
+
+  // The convolution result is added to the dequantized sum before requantizing to y.
+  if (channels_last) {
+    test.AddInput<uint8_t>("sum", {1, 2, 2, 2}, {10, 20, 12, 20, 14, 0, 16, 10});
+  } else {
+    test.AddInput<uint8_t>("sum", {1, 2, 2, 2}, {10, 12, 14, 16, 20, 20, 0, 10});
+  }
+  test.AddInput<float>("sum_scale", {}, {1.0f}, true);
+  test.AddInput<uint8_t>("sum_zero_point", {}, {10}, true);
+
+  if (channels_last) {
+    test.AddOutput<uint8_t>("y", {1, 2, 2, 2}, {103, 103, 105, 103, 107, 93, 109, 98});
+  } else {
+    test.AddOutput<uint8_t>("y", {1, 2, 2, 2}, {103, 105, 107, 109, 103, 103, 93, 98});
+  }
+
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_U8S8_Sum) {
+  RunConv2DWithSumTest(false);
+}
+
+TEST(QLinearConvTest, Conv2D_U8S8_Sum_ChannelsLast) {
+  RunConv2DWithSumTest(true);
+}
+
 TEST(QLinearConvTest, Conv1D_S8S8) {
   QLinearConvOpTester<int8_t, int8_t> test;
   test.GenerateRandomInput({3, 24, 15}, .05f, 4);
@@ -288,6 +288,49 @@ TEST(NonMaxSuppressionOpTest, SelectFromIdenticalBoxes) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClasses) {
+  // 20 disjoint boxes followed by a copy of each, so that more than a tile of boxes is selected per class
+  constexpr int64_t num_batches = 2;
+  constexpr int64_t num_classes = 3;
+  constexpr int64_t num_distinct_boxes = 20;
+  constexpr int64_t num_boxes = 2 * num_distinct_boxes;
+  std::vector<float> boxes;
+  for (int64_t batch_index = 0; batch_index < num_batches; ++batch_index) {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      const float x = static_cast<float>(2 * (box_index % num_distinct_boxes) + batch_index);
+      boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+    }
+  }
+
+  // class 0 ranks the boxes in order, class 1 in reverse order and class 2 ranks the copies first
+  std::vector<float> scores;
+  std::vector<int64_t> selected_indices;
+  for (int64_t batch_index = 0; batch_index < num_batches; ++batch_index) {
+    for (int64_t class_index = 0; class_index < num_classes; ++class_index) {
+      for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+        const int64_t rank = class_index == 1 ? num_distinct_boxes - 1 - box_index % num_distinct_boxes
+                                              : box_index % num_distinct_boxes;
+        const bool preferred = (box_index < num_distinct_boxes) == (class_index != 2);
+        scores.push_back((preferred ? 0.9f : 0.4f) - 0.01f * rank);
+      }
+      for (int64_t rank = 0; rank < num_distinct_boxes; ++rank) {
+        const int64_t box_index = class_index == 1 ? num_distinct_boxes - 1 - rank : rank;
+        const int64_t selected_box_index = class_index == 2 ? box_index + num_distinct_boxes : box_index;
+        selected_indices.insert(selected_indices.end(), {batch_index, class_index, selected_box_index});
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {30L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {num_batches * num_classes * num_distinct_boxes, 3}, selected_indices);
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, InconsistentBoxAndScoreShapes) {
   OpTester test("NonMaxSuppression", 10, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
@@ -104,6 +104,42 @@ TEST(RoiAlignTest, OnnxTest) {
   BasicTest<float>();
 }
 
+TEST(RoiAlignTest, AvgModeChannelBlocks) {
+  OpTester test("RoiAlign", 10);
+  test.AddAttribute<int64_t>("output_height", 2);
+  test.AddAttribute<int64_t>("output_width", 2);
+  test.AddAttribute<int64_t>("sampling_ratio", 2);
+  test.AddAttribute<float>("spatial_scale", 1.0f);
+
+  constexpr int N = 1;
+  constexpr int C = 5;
+  constexpr int H = 8;
+  constexpr int W = 8;
+
+  // A ramp of h * W + w + 100 * c, which bilinear interpolation reproduces exactly, so the average of a bin is
+  // the ramp at its center. The channels span a block of four channels and a remainder.
+  std::vector<float> X(N * C * H * W);
+  for (int c = 0; c < C; c++) {
+    for (int h = 0; h < H; h++) {
+      for (int w = 0; w < W; w++) {
+        X[(c * H + h) * W + w] = static_cast<float>(h * W + w + 100 * c);
+      }
+    }
+  }
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("rois", {1, 4}, {1., 2., 5., 6.});
+  test.AddInput<int64_t>("batch_indices", {1}, {0});
+
+  std::vector<float> Y;
+  for (int c = 0; c < C; c++) {
+    for (float value : {26.f, 28.f, 42.f, 44.f}) {
+      Y.push_back(value + 100 * c);
+    }
+  }
+  test.AddOutput<float>("Y", {1, C, 2, 2}, Y);
+  test.Run();
+}
+
 TEST(RoiAlignTest, MaxModePositive) {
   OpTester test("RoiAlign", 10);
   test.AddAttribute<std::string>("mode", "max");
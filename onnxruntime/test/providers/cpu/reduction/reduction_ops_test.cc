@@ -1633,6 +1633,18 @@ TEST(ReductionOpTest, ReduceSum_apex_matrix_large) {
   }
 }
 
+TEST(ReductionOpTest, ReduceSum_all_large) {
+  // Large enough to be reduced in several blocks by the single output fast path.
+  const int64_t n = 100000;
+  std::vector<float> X(n, 0.5f);
+  OpTester test("ReduceSum");
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddAttribute("axes", std::vector<int64_t>{0, 1});
+  test.AddInput<float>("data", {n / 4, 4}, X);
+  test.AddOutput<float>("reduced", {}, {static_cast<float>(n) * 0.5f});
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceSum_apex_bert) {
   test_apex_reduce_sum(6 * 128, 128);
   test_apex_reduce_sum(8 * 128, 128);
@@ -2274,6 +2286,46 @@ TEST(ReductionOpTest, ArgMax_int32_neg_axis) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ArgMax_middle_axis_wide_inner) {
+  // The inner dimension spans several column blocks of the KRK fast path.
+  const int64_t d0 = 3, d1 = 7, d2 = 600;
+  std::vector<float> X(d0 * d1 * d2);
+  std::vector<int64_t> Y(d0 * d2);
+  std::vector<int64_t> Y_last(d0 * d2);
+  std::default_random_engine generator(0);
+  std::uniform_int_distribution<int> distribution(0, 4);
+  for (auto& x : X) {
+    x = static_cast<float>(distribution(generator));
+  }
+  for (int64_t i = 0; i < d0; ++i) {
+    for (int64_t k = 0; k < d2; ++k) {
+      int64_t first = 0, last = 0;
+      for (int64_t j = 1; j < d1; ++j) {
+        const float value = X[(i * d1 + j) * d2 + k];
+        if (value > X[(i * d1 + first) * d2 + k]) first = j;
+        if (value >= X[(i * d1 + last) * d2 + k]) last = j;
+      }
+      Y[i * d2 + k] = first;
+      Y_last[i * d2 + k] = last;
+    }
+  }
+
+  OpTester test("ArgMax", 12);
+  test.AddAttribute("axis", static_cast<int64_t>(1));
+  test.AddAttribute("keepdims", static_cast<int64_t>(0));
+  test.AddInput<float>("data", {d0, d1, d2}, X);
+  test.AddOutput<int64_t>("reduced", {d0, d2}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+
+  OpTester test_last("ArgMax", 12);
+  test_last.AddAttribute("axis", static_cast<int64_t>(1));
+  test_last.AddAttribute("keepdims", static_cast<int64_t>(0));
+  test_last.AddAttribute("select_last_index", static_cast<int64_t>(1));
+  test_last.AddInput<float>("data", {d0, d1, d2}, X);
+  test_last.AddOutput<int64_t>("reduced", {d0, d2}, Y_last);
+  test_last.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 TEST(ReductionOpTest, ArgMax_int8) {
   OpTester test("ArgMax");
   test.AddAttribute("axis", static_cast<int64_t>(1));
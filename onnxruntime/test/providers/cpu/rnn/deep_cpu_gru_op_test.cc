@@ -8,6 +8,7 @@
 
 #include "core/providers/cpu/rnn/deep_cpu_gru.h"
 #include "test/providers/provider_test_utils.h"
+#include "default_providers.h"
 using namespace std;
 namespace onnxruntime {
 namespace test {
@@ -1090,5 +1091,118 @@ TEST(GRUTest, ONNXRuntime_TestGRUPositiveActivationAlphaBeta) {
   ctx.RunTest(X, batch_size, seq_length, sequence_length, &initial_h, expected_Y, expected_Y_h);
 }
 
+#ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
+TEST(GRUTest, SharedPrepackedWeights) {
+  int64_t seq_length = 2;
+  int batch_size = 2;
+  int64_t input_size = 1;
+  int64_t hidden_size = 3;
+  int num_directions = 1;
+
+  std::vector<float> X_data{1.f, 2.f, 10.f, 11.f};
+
+  std::vector<float> W_data{0.1f, 0.2f, 0.3f,   // wz
+                            1.f, 2.f, 3.f,      // wr
+                            10.f, 11.f, 12.f};  // wh
+
+  std::vector<float> R_data(num_directions * 3 * hidden_size * hidden_size, 0.1f);
+
+  std::vector<float> Y_data{
+      0.4750208f, 0.450166f, 0.4255575f,
+      0.45016602f, 0.40131235f, 0.35434368f,
+
+      0.6027093f, 0.5083023f, 0.44950223f,
+      0.5754369f, 0.45485455f, 0.3747841f};
+
+  OpTester test("GRU");
+
+  test.AddAttribute<std::vector<string>>("activations", default_activations);
+  test.AddAttribute("direction", "forward");
+  test.AddAttribute("hidden_size", hidden_size);
+  test.AddAttribute<int64_t>("linear_before_reset", 0);
+
+  std::vector<int64_t> X_dims = {seq_length, batch_size, input_size};
+  std::vector<int64_t> W_dims = {num_directions, 3 * hidden_size, input_size};
+  std::vector<int64_t> R_dims = {num_directions, 3 * hidden_size, hidden_size};
+
+  test.AddInput<float>("X", X_dims, X_data);
+  test.AddInput<float>("W", W_dims, W_data, true);  // Trigger pre-packing
+  test.AddInput<float>("R", R_dims, R_data, true);  // Trigger pre-packing
+
+  std::vector<int64_t> Y_dims = {seq_length, num_directions, batch_size, hidden_size};
+  test.AddOutput<float>("Y", Y_dims, Y_data);
+
+  // Y_h
+  test.AddOptionalOutputEdge<float>();
+
+  // W
+  OrtValue W;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape(W_dims),
+                       W_data.data(), OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator), W);
+
+  // R
+  OrtValue R;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape(R_dims),
+                       R_data.data(), OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator), R);
+
+  SessionOptions so;
+
+  // Set up weight(s) as a shared initializer to be shared between sessions
+  ASSERT_EQ(so.AddInitializer("W", &W), Status::OK());
+  ASSERT_EQ(so.AddInitializer("R", &R), Status::OK());
+
+  // We want all sessions running using this OpTester to be able to share pre-packed weights if applicable
+  test.EnableSharingOfPrePackedWeightsAcrossSessions();
+
+  // Pre-packing is limited just to the CPU EP for now and we will only test the CPU EP
+  // and we want to ensure that it is available in this build
+  auto cpu_ep = []() -> std::vector<std::unique_ptr<IExecutionProvider>> {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    return execution_providers;
+  };
+
+  size_t number_of_pre_packed_weights_counter_session_1 = 0;
+  size_t number_of_shared_pre_packed_weights_counter = 0;
+
+  // Session 1
+  {
+    auto ep_vec = cpu_ep();
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr,
+             &ep_vec, {}, &number_of_pre_packed_weights_counter_session_1, &number_of_shared_pre_packed_weights_counter);
+    // Assert that no pre-packed weights have been shared thus far
+    ASSERT_EQ(number_of_shared_pre_packed_weights_counter, static_cast<size_t>(0));
+  }
+
+  auto number_of_elements_in_shared_prepacked_buffers_container =
+      test.GetNumPrePackedWeightsShared();
+  // Assert that the number of elements in the shared container
+  // is the same as the number of weights that have been pre-packed
+  ASSERT_EQ(number_of_pre_packed_weights_counter_session_1, number_of_elements_in_shared_prepacked_buffers_container);
+
+  // On some platforms/architectures MLAS may choose to not do any pre-packing and the number of elements
+  // that have been pre-packed will be zero in which case we do not continue with the testing
+  // of "sharing" of pre-packed weights as there are no pre-packed weights to be shared at all.
+  if (number_of_pre_packed_weights_counter_session_1 == 0)
+    return;
+
+  // Session 2
+  {
+    size_t number_of_pre_packed_weights_counter_session_2 = 0;
+    auto ep_vec = cpu_ep();
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr,
+             &ep_vec, {}, &number_of_pre_packed_weights_counter_session_2, &number_of_shared_pre_packed_weights_counter);
+
+    // Assert that the same number of weights were pre-packed in both sessions
+    ASSERT_EQ(number_of_pre_packed_weights_counter_session_1, number_of_pre_packed_weights_counter_session_2);
+
+    // Assert that the number of pre-packed weights that were shared equals
+    // the number of pre-packed weights in the second session
+    ASSERT_EQ(number_of_pre_packed_weights_counter_session_2,
+              static_cast<size_t>(number_of_shared_pre_packed_weights_counter));
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -130,6 +130,31 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+TEST(CastOpTest, LargeTensors) {
+  // large enough to be split across threads, with a size that isn't a multiple of the vector width
+  const std::vector<int64_t> shape{3, 5, 1027};
+  const size_t size = 3 * 5 * 1027;
+
+  // values exactly representable in all the types
+  std::vector<int32_t> int_values(size);
+  std::vector<float> float_values(size);
+  for (size_t i = 0; i < size; ++i) {
+    int_values[i] = static_cast<int32_t>(i % 512) - 256;
+    float_values[i] = static_cast<float>(int_values[i]) * 0.125f;
+  }
+  const std::vector<MLFloat16> float16_values = CastedValues<float, MLFloat16>(gsl::make_span(float_values));
+  const std::vector<BFloat16> bfloat16_values = CastedValues<float, BFloat16>(gsl::make_span(float_values));
+  std::vector<float> int_as_float_values(size);
+  CastSpan<int32_t, float>(gsl::make_span(int_values), gsl::make_span(int_as_float_values));
+
+  TestCastOp(gsl::make_span(float_values), gsl::make_span(float16_values), shape);
+  TestCastOp(gsl::make_span(float16_values), gsl::make_span(float_values), shape);
+  TestCastOp(gsl::make_span(float_values), gsl::make_span(bfloat16_values), shape);
+  TestCastOp(gsl::make_span(bfloat16_values), gsl::make_span(float_values), shape);
+  TestCastOp(gsl::make_span(float16_values), gsl::make_span(bfloat16_values), shape);
+  TestCastOp(gsl::make_span(int_values), gsl::make_span(int_as_float_values), shape);
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
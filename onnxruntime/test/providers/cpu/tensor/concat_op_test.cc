@@ -150,6 +150,19 @@ TEST(ConcatOpTest, Concat2D_5) {
   test.Run();
 }
 
+TEST(ConcatOpTest, Concat2D_EmptyMiddleInput) {
+  OpTester test("Concat");
+  test.AddAttribute("axis", int64_t{1});
+
+  test.AddInput<int32_t>("input1", {2, 2}, {11, 12, 21, 22});
+  test.AddInput<int32_t>("input2", {2, 0}, {});
+  test.AddInput<int32_t>("input3", {2, 1}, {13, 23});
+  test.AddOutput<int32_t>("concat_result", {2, 3}, {11, 12, 13, 21, 22, 23});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "",
+           {kTensorrtExecutionProvider,  //TensorRT: no support for dynamic shape tensor
+            kNnapiExecutionProvider});   // NNAPI: concat does not support 0 size input
+}
+
 TEST(ConcatOpTest, Concat3D_1) {
   OpTester test("Concat");
   test.AddAttribute("axis", int64_t{0});
@@ -99,5 +99,30 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+TEST(NonZeroOpTest, LargeInput) {
+  // spans several chunks, so the coordinates of each chunk start in the middle of the input.
+  std::vector<int64_t> X_dims{3, 101, 173};
+  std::vector<float> X(3 * 101 * 173);
+  std::vector<int64_t> Y;
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = (i % 7 == 0 || i % 11 == 0) ? 1.0f : 0.0f;
+  }
+
+  for (int64_t d = 0; d < 3; ++d) {
+    for (size_t i = 0; i < X.size(); ++i) {
+      if (X[i] != 0.0f) {
+        const int64_t coordinates[] = {static_cast<int64_t>(i / (101 * 173)), static_cast<int64_t>(i / 173 % 101),
+                                       static_cast<int64_t>(i % 173)};
+        Y.push_back(coordinates[d]);
+      }
+    }
+  }
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<float>("X", X_dims, X);
+  test.AddOutput<int64_t>("Y", {3, static_cast<int64_t>(Y.size() / 3)}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -979,6 +979,35 @@ TEST(ResizeOpTest, ResizeOpCubicUpSampleTest) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_uint8) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  constexpr int64_t N = 1, C = 1, H = 2, W = 4;
+  std::vector<uint8_t> X = {
+      0, 0, 255, 255,
+      255, 255, 0, 0};
+
+  test.AddInput<uint8_t>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  // the overshoot of the cubic interpolation (e.g. -23.9 and 278.9) is saturated
+  std::vector<uint8_t> Y = {0, 0, 0, 127, 255, 255, 255, 255,
+                            127, 127, 127, 127, 127, 127, 127, 127,
+                            255, 255, 255, 127, 0, 0, 0, 0,
+                            255, 255, 255, 127, 0, 0, 0, 0};
+
+  test.AddOutput<uint8_t>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])}, Y);
+  // CUDA: cubic mode is only implemented for float
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider,
+                                                        kRocmExecutionProvider});
+}
+
 TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannel) {
   OpTester test("Resize", 13);
   std::vector<float> scales{};
@@ -118,6 +118,9 @@ void RunTestWrapper() {
   // This will trigger the (Batched) MemCpy optimization path
   RunTest<T>({2, 1, 3}, {2, 2, 1});
 
+  // Tile of a middle axis with enough copies to split them across the thread pool
+  RunTest<T>({16, 3, 64}, {2, 3, 1});
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
   // _TileMemcpyKernelFromInput, vectorized 4
   RunTest<T>({256, 512}, {3, 1});
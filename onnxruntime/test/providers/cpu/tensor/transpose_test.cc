@@ -1,11 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/compare_provider_test_utils.h"
 #include "core/providers/cpu/tensor/transpose.h"
 #include "test/util/include/asserts.h"
+#include "test/util/include/default_providers.h"
 
 namespace onnxruntime {
 namespace test {
@@ -595,6 +598,64 @@ TEST(TransposeOpTest, DoTransposeEltWise) {
   }
 }
 
+// Compares the transpose of the CPU provider with a reference computed element by element. The shapes are large
+// enough for the 2-D transposes to run in several tiles of rows.
+template <typename T>
+static void TransposeReferenceTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  const int64_t size = std::accumulate(input_shape.begin(), input_shape.end(), int64_t{1}, std::multiplies<int64_t>());
+
+  std::vector<T> input_vals(static_cast<size_t>(size));
+  for (size_t i = 0; i < input_vals.size(); ++i) {
+    input_vals[i] = static_cast<T>(i % 251);
+  }
+
+  std::vector<int64_t> input_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * input_shape[i];
+  }
+  std::vector<int64_t> output_shape(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    output_shape[i] = input_shape[perm[i]];
+  }
+
+  std::vector<T> expected_vals;
+  expected_vals.reserve(input_vals.size());
+  std::vector<int64_t> index(rank, 0);
+  for (int64_t i = 0; i < size; ++i) {
+    int64_t offset = 0;
+    for (size_t axis = 0; axis < rank; ++axis) {
+      offset += index[axis] * input_strides[perm[axis]];
+    }
+    expected_vals.push_back(input_vals[offset]);
+    for (size_t axis = rank; axis-- > 0;) {
+      if (++index[axis] < output_shape[axis]) {
+        break;
+      }
+      index[axis] = 0;
+    }
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", output_shape, expected_vals);
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(TransposeOpTest, NDimTiles) {
+  // attention [B,S,N,H] -> [B,N,S,H] and [B,N,H,S]
+  TransposeReferenceTest<float>({2, 70, 3, 8}, {0, 2, 1, 3});
+  TransposeReferenceTest<float>({2, 70, 3, 8}, {0, 2, 3, 1});
+  // layout conversions
+  TransposeReferenceTest<uint8_t>({2, 5, 9, 131}, {0, 2, 3, 1});
+  TransposeReferenceTest<int16_t>({1, 67, 3, 5}, {0, 3, 1, 2});
+  TransposeReferenceTest<double>({3, 130, 2, 7}, {3, 1, 0, 2});
+  TransposeReferenceTest<int64_t>({129, 1, 65}, {2, 1, 0});
+}
+
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
 #elif USE_ROCM
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <map>
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -375,5 +376,78 @@ TEST(Unique, EmptyInput) {
   test.Run();
 }
 
+// enough values to grow the hash table a few times. the expected output is computed with an ordered map.
+static void RunLargeFlattenedUniqueTest(bool sorted) {
+  const int64_t size = 50000;
+  std::vector<int64_t> X(size);
+  for (int64_t i = 0; i < size; ++i) {
+    X[i] = ((i * 7919) % 6007) * 1000003 - 3000000000;
+  }
+
+  std::map<int64_t, std::vector<int64_t>> occurrences;
+  std::vector<int64_t> first_seen;
+  for (int64_t i = 0; i < size; ++i) {
+    auto& entry = occurrences[X[i]];
+    if (entry.empty()) {
+      first_seen.push_back(X[i]);
+    }
+    entry.push_back(i);
+  }
+
+  std::vector<int64_t> Y;
+  if (sorted) {
+    for (const auto& entry : occurrences) {
+      Y.push_back(entry.first);
+    }
+  } else {
+    Y = first_seen;
+  }
+
+  std::map<int64_t, int64_t> output_index;
+  std::vector<int64_t> indices;
+  std::vector<int64_t> counts;
+  for (size_t i = 0; i < Y.size(); ++i) {
+    output_index[Y[i]] = static_cast<int64_t>(i);
+    indices.push_back(occurrences[Y[i]].front());
+    counts.push_back(static_cast<int64_t>(occurrences[Y[i]].size()));
+  }
+
+  std::vector<int64_t> inverse_indices;
+  for (int64_t value : X) {
+    inverse_indices.push_back(output_index[value]);
+  }
+
+  const int64_t num_unique = static_cast<int64_t>(Y.size());
+  RunUniqueTest<int64_t>({size}, X, nullptr, sorted, {num_unique}, Y, {num_unique}, indices,
+                         {size}, inverse_indices, {num_unique}, counts);
+}
+
+TEST(Unique, Flatten_Large_Unsorted) {
+  RunLargeFlattenedUniqueTest(false);
+}
+
+TEST(Unique, Flatten_Large_Sorted) {
+  RunLargeFlattenedUniqueTest(true);
+}
+
+TEST(Unique, Flatten_SignedZero) {
+  const std::vector<int64_t> X_dims{5};
+  const std::vector<float> X{-0.f, 1.f, 0.f, -1.f, -0.f};
+  const int64_t* axis = nullptr;
+  bool sorted = true;
+  const std::vector<int64_t> Y_dims{3};
+  const std::vector<float> Y{-1.f, -0.f, 1.f};
+
+  const std::vector<int64_t> indices_dims{3};
+  const std::vector<int64_t> indices{3, 0, 1};
+  const std::vector<int64_t> inverse_indices_dims{5};
+  const std::vector<int64_t> inverse_indices{1, 2, 1, 0, 1};
+  const std::vector<int64_t> counts_dims{3};
+  const std::vector<int64_t> counts{1, 1, 3};
+
+  RunUniqueTest<float>(X_dims, X, axis, sorted, Y_dims, Y, indices_dims, indices,
+                       inverse_indices_dims, inverse_indices, counts_dims, counts);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
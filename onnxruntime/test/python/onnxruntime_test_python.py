@@ -2,10 +2,12 @@
 # Licensed under the MIT License.
 
 # -*- coding: UTF-8 -*-
+import asyncio
 import gc
 import os
 import platform
 import sys
+import tempfile
 import threading
 import unittest
 
@@ -113,6 +115,10 @@ class TestInferenceSession(unittest.TestCase):
             self.assertIn("trt_engine_cache_enable", option)
             self.assertIn("trt_engine_cache_path", option)
             self.assertIn("trt_force_sequential_engine_build", option)
+            self.assertIn("trt_engine_build_async", option)
+            self.assertIn("trt_profile_min_shapes", option)
+            self.assertIn("trt_profile_max_shapes", option)
+            self.assertIn("trt_profile_opt_shapes", option)
 
             max_partition_iterations = option["trt_max_partition_iterations"]
             new_max_partition_iterations = int(max_partition_iterations) + 1
@@ -133,6 +139,8 @@ class TestInferenceSession(unittest.TestCase):
             option["trt_engine_cache_path"] = engine_cache_path
             force_sequential_engine_build = "true"
             option["trt_force_sequential_engine_build"] = force_sequential_engine_build
+            engine_build_async = "true"
+            option["trt_engine_build_async"] = engine_build_async
             sess.set_providers(["TensorrtExecutionProvider"], [option])
 
             options = sess.get_provider_options()
@@ -147,6 +155,7 @@ class TestInferenceSession(unittest.TestCase):
             self.assertEqual(option["trt_engine_cache_enable"], "1")
             self.assertEqual(option["trt_engine_cache_path"], str(engine_cache_path))
             self.assertEqual(option["trt_force_sequential_engine_build"], "1")
+            self.assertEqual(option["trt_engine_build_async"], "1")
 
             # We currently disable following test code since that not all test machines/GPUs have nvidia int8 capability
 
@@ -341,6 +350,82 @@ class TestInferenceSession(unittest.TestCase):
                 runBaseTest2()
                 # raise OSError("could not load any of: " + ' '.join(libnames))
 
+    def testCudnnConvAlgoCacheFile(self):
+        if "CUDAExecutionProvider" not in onnxrt.get_available_providers():
+            return
+
+        with tempfile.TemporaryDirectory() as temp_dir:
+            cache_file = os.path.join(temp_dir, "conv_algos.txt")
+            option = {"cudnn_conv_algo_search": "EXHAUSTIVE", "cudnn_conv_algo_cache_file": cache_file}
+
+            def run_session():
+                sess = onnxrt.InferenceSession(
+                    get_name("conv_autopad.onnx"), providers=[("CUDAExecutionProvider", option)]
+                )
+                self.assertEqual(
+                    sess.get_provider_options()["CUDAExecutionProvider"]["cudnn_conv_algo_cache_file"], cache_file
+                )
+                feeds = {
+                    i.name: np.random.rand(*[d if isinstance(d, int) else 1 for d in i.shape]).astype(np.float32)
+                    for i in sess.get_inputs()
+                }
+                sess.run(None, feeds)
+
+            # The algorithm found by the first session is appended to the file, the second session reuses it.
+            run_session()
+            with open(cache_file) as f:
+                lines = f.readlines()
+            self.assertGreater(len(lines), 0)
+            self.assertTrue(all(line.startswith("fwd;") for line in lines))
+
+            run_session()
+            with open(cache_file) as f:
+                self.assertEqual(f.readlines(), lines)
+
+    def testFusedElementwiseCacheDir(self):
+        if "CUDAExecutionProvider" not in onnxrt.get_available_providers():
+            return
+
+        from onnx import TensorProto, helper
+
+        # y = (x + b) * Sigmoid(x + b), fused into a FusedElementwise node
+        graph = helper.make_graph(
+            [
+                helper.make_node("Add", ["x", "b"], ["sum"]),
+                helper.make_node("Sigmoid", ["sum"], ["gate"]),
+                helper.make_node("Mul", ["sum", "gate"], ["y"]),
+            ],
+            "swish",
+            [
+                helper.make_tensor_value_info("x", TensorProto.FLOAT, [4, 64]),
+                helper.make_tensor_value_info("b", TensorProto.FLOAT, [64]),
+            ],
+            [helper.make_tensor_value_info("y", TensorProto.FLOAT, [4, 64])],
+        )
+        model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", 13)]).SerializeToString()
+        x = np.random.rand(4, 64).astype(np.float32)
+        b = np.random.rand(64).astype(np.float32)
+        expected = (x + b) / (1.0 + np.exp(-(x + b)))
+
+        with tempfile.TemporaryDirectory() as temp_dir:
+            option = {"fused_elementwise_cache_dir": temp_dir}
+
+            def run_session():
+                sess = onnxrt.InferenceSession(model, providers=[("CUDAExecutionProvider", option)])
+                self.assertEqual(
+                    sess.get_provider_options()["CUDAExecutionProvider"]["fused_elementwise_cache_dir"], temp_dir
+                )
+                np.testing.assert_allclose(sess.run(None, {"x": x, "b": b})[0], expected, rtol=1e-5, atol=1e-6)
+
+            # The kernel compiled by the first session is written to the directory, the second session loads it.
+            run_session()
+            files = sorted(os.listdir(temp_dir))
+            self.assertEqual(len(files), 1)
+            self.assertTrue(files[0].startswith("fused_elementwise_") and files[0].endswith(".cubin"))
+
+            run_session()
+            self.assertEqual(sorted(os.listdir(temp_dir)), files)
+
     def testInvalidSetProviders(self):
         with self.assertRaises(RuntimeError) as context:
             sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
@@ -353,6 +438,57 @@ class TestInferenceSession(unittest.TestCase):
             sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
             self.assertEqual(["CPUExecutionProvider"], sess.get_providers())
 
+    def testRunModelOutputsWithoutCopy(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+
+        # the output wraps the buffer of the OrtValue, which it keeps alive
+        res = sess.run(["Y"], {"X": x})[0]
+        del sess
+        np.testing.assert_allclose(output_expected, res, rtol=1e-05, atol=1e-08)
+        self.assertFalse(res.flags.writeable)
+        with self.assertRaises(ValueError):
+            res[0, 0] = 0.0
+
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        ro = onnxrt.RunOptions()
+        ro.add_run_config_entry("python.copy_outputs", "1")
+        res = sess.run(["Y"], {"X": x}, ro)[0]
+        np.testing.assert_allclose(output_expected, res, rtol=1e-05, atol=1e-08)
+        self.assertTrue(res.flags.writeable)
+        res[0, 0] = 0.0
+
+    def testRunBatch(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        # a strided array and a non numpy buffer are converted without the GIL
+        x_strided = np.array([[1.0, 0.0, 2.0], [3.0, 0.0, 4.0], [5.0, 0.0, 6.0]], dtype=np.float32)[:, ::2]
+        x_buffer = memoryview(x)
+
+        results = sess.run_batch(["Y"], [{"X": x}, {"X": x_strided}, {"X": x_buffer}])
+        self.assertEqual(3, len(results))
+        for res in results:
+            np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+    def testRunAsync(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+
+        async def run_all():
+            return await asyncio.gather(*[sess.run_async(["Y"], {"X": x}) for _ in range(4)])
+
+        loop = asyncio.new_event_loop()
+        try:
+            results = loop.run_until_complete(run_all())
+        finally:
+            loop.close()
+        self.assertEqual(4, len(results))
+        for res in results:
+            np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
     def testRunModel(self):
         sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=available_providers)
         x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
@@ -74,6 +74,82 @@ class TestInferenceSessionWithCudaGraph(unittest.TestCase):
                 atol=1e-05,
             )
 
+    def testRunModelWithCudaGraphPerInputShape(self):
+        if "CUDAExecutionProvider" in onnxrt.get_available_providers():
+            providers = [("CUDAExecutionProvider", {"enable_cuda_graph": True, "max_cuda_graphs": 2})]
+            session = onnxrt.InferenceSession(get_name("matmul_2.onnx"), providers=providers)
+
+            # one binding per input shape, each captures its own graph
+            bindings = []
+            for input_size in [640, 1280]:
+                x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]] * input_size, dtype=np.float32)
+                y = np.zeros((3 * input_size, 1), dtype=np.float32)
+                x_ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(x, "cuda", 0)
+                y_ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(y, "cuda", 0)
+                io_binding = session.io_binding()
+                io_binding.bind_ortvalue_input("X", x_ortvalue)
+                io_binding.bind_ortvalue_output("Y", y_ortvalue)
+                expected_y = np.array([[5.0], [11.0], [17.0]] * input_size, dtype=np.float32)
+                bindings.append((io_binding, y_ortvalue, expected_y))
+
+            # the first run of each binding captures, the next ones replay the graph of its shape
+            for _ in range(3):
+                for io_binding, y_ortvalue, expected_y in bindings:
+                    session.run_with_iobinding(io_binding)
+                    np.testing.assert_allclose(expected_y, y_ortvalue.numpy(), rtol=1e-05, atol=1e-05)
+
+    def testRunModelWithCudaGraphFromThreads(self):
+        if "CUDAExecutionProvider" in onnxrt.get_available_providers():
+            providers = [("CUDAExecutionProvider", {"enable_cuda_graph": True})]
+            session = onnxrt.InferenceSession(get_name("matmul_2.onnx"), providers=providers)
+            errors = []
+
+            def run(scale):
+                try:
+                    x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]] * 1280, dtype=np.float32) * scale
+                    y = np.zeros((3 * 1280, 1), dtype=np.float32)
+                    x_ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(x, "cuda", 0)
+                    y_ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(y, "cuda", 0)
+                    io_binding = session.io_binding()
+                    io_binding.bind_ortvalue_input("X", x_ortvalue)
+                    io_binding.bind_ortvalue_output("Y", y_ortvalue)
+                    expected_y = np.array([[5.0], [11.0], [17.0]] * 1280, dtype=np.float32) * scale
+                    # each thread captures and replays its own graph, concurrently with the other threads
+                    for _ in range(10):
+                        session.run_with_iobinding(io_binding)
+                        np.testing.assert_allclose(expected_y, y_ortvalue.numpy(), rtol=1e-05, atol=1e-05)
+                except Exception as e:
+                    errors.append(e)
+
+            threads = [threading.Thread(target=run, args=(scale,)) for scale in [1.0, 2.0, 3.0, 4.0]]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+            self.assertEqual(errors, [])
+
+    def testRunModelWithHipGraph(self):
+        if "ROCMExecutionProvider" in onnxrt.get_available_providers():
+            providers = [("ROCMExecutionProvider", {"enable_hip_graph": True})]
+            x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]] * 1280, dtype=np.float32)
+            y = np.zeros((3 * 1280, 1), dtype=np.float32)
+            x_ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(x, "cuda", 0)
+            y_ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(y, "cuda", 0)
+
+            session = onnxrt.InferenceSession(get_name("matmul_2.onnx"), providers=providers)
+            io_binding = session.io_binding()
+            io_binding.bind_ortvalue_input("X", x_ortvalue)
+            io_binding.bind_ortvalue_output("Y", y_ortvalue)
+
+            # the first run captures the hip graph, the next ones replay it
+            session.run_with_iobinding(io_binding)
+            expected_y = np.array([[5.0], [11.0], [17.0]] * 1280, dtype=np.float32)
+            np.testing.assert_allclose(expected_y, y_ortvalue.numpy(), rtol=1e-05, atol=1e-05)
+
+            x_ortvalue.update_inplace(x * 10.0)
+            session.run_with_iobinding(io_binding)
+            np.testing.assert_allclose(expected_y * 10.0, y_ortvalue.numpy(), rtol=1e-05, atol=1e-05)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -301,6 +301,26 @@ class TestIOBinding(unittest.TestCase):
         # Inspect contents of output_ortvalue and make sure that it has the right contents
         self.assertTrue(np.array_equal(self.create_expected_output_alternate(), output_ortvalue.numpy()))
 
+    def test_bind_input_and_output_with_dlpack(self):
+        session = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        io_binding = session.io_binding()
+
+        # OrtValue implements __dlpack__ like torch or cupy tensors
+        input_ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(self.create_numpy_input())
+        output_ortvalue = onnxrt.OrtValue.ortvalue_from_shape_and_type([3, 2], np.float32)
+        io_binding.bind_input("X", input_ortvalue)
+        io_binding.bind_output("Y", output_ortvalue)
+
+        session.run_with_iobinding(io_binding)
+
+        # the output is written in place into the bound buffer
+        self.assertTrue(np.array_equal(self.create_expected_output(), output_ortvalue.numpy()))
+
+        # the OrtValue created from a DLPack capsule shares the buffer
+        shared_ortvalue = onnxrt.OrtValue.from_dlpack(output_ortvalue.to_dlpack())
+        self.assertEqual(output_ortvalue.data_ptr(), shared_ortvalue.data_ptr())
+        self.assertTrue(np.array_equal(self.create_expected_output(), shared_ortvalue.numpy()))
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -310,6 +310,24 @@ class TestCalibrate(unittest.TestCase):
         for output_name in output_min_max_dict.keys():
             self.assertEqual(output_min_max_dict[output_name], tensors_range[output_name])
 
+    def test_compute_range_with_max_intermediate_outputs(self):
+        test_model_path = "./test_model_4.onnx"
+        self.construct_test_compute_range_model(test_model_path)
+
+        augmented_model_path = "./augmented_test_model_4.onnx"
+        calibrater = MinMaxCalibrater(test_model_path, augmented_model_path=augmented_model_path)
+        data_reader = TestDataReader()
+        calibrater.collect_data(data_reader)
+        tensors_range = calibrater.compute_range()
+
+        # the ranges are reduced after every batch
+        streaming_calibrater = MinMaxCalibrater(
+            test_model_path, augmented_model_path=augmented_model_path, max_intermediate_outputs=1
+        )
+        data_reader.rewind()
+        streaming_calibrater.collect_data(data_reader)
+        self.assertEqual(streaming_calibrater.compute_range(), tensors_range)
+
     def test_augment_graph_with_zero_value_dimension(self):
         """TEST_CONFIG_5"""
         #   Conv
@@ -4,6 +4,8 @@
 #include "custom_op_utils.h"
 #include "core/common/common.h"
 
+#include <algorithm>
+
 #ifdef USE_CUDA
 #include <cuda_runtime.h>
 template <typename T1, typename T2, typename T3>
@@ -423,3 +425,68 @@ InstantCustomKernel::~InstantCustomKernel() {
   ort_.ReleaseOp(op_topk);
   ort_.ReleaseOp(op_gru);
 }
+
+MyPrePackCustomOp::MyPrePackCustomOp(const char* provider) : provider_(provider) {
+  OrtCustomOp::InferOutputShape = [](const OrtCustomOp* /*this_*/, size_t /*output_index*/,
+                                     const int64_t* const* input_dims, const int64_t* input_num_dims,
+                                     size_t input_count, int64_t* output_dims, size_t max_num_dims) -> int64_t {
+    // Y has the shape of X
+    if (input_count == 0 || input_num_dims[0] < 0 || static_cast<size_t>(input_num_dims[0]) > max_num_dims) {
+      return -1;
+    }
+    std::copy(input_dims[0], input_dims[0] + input_num_dims[0], output_dims);
+    return input_num_dims[0];
+  };
+  OrtCustomOp::KernelGetPrePackSize = [](void* op_kernel, const OrtValue* input, size_t input_index) {
+    return static_cast<MyPrePackCustomKernel*>(op_kernel)->GetPrePackSize(input, input_index);
+  };
+  OrtCustomOp::KernelPrePack = [](void* op_kernel, const OrtValue* input, size_t input_index, void* packed_buffer) {
+    static_cast<MyPrePackCustomKernel*>(op_kernel)->PrePack(input, input_index, packed_buffer);
+  };
+  OrtCustomOp::KernelUsePrePacked = [](void* op_kernel, size_t input_index, const void* packed_buffer) {
+    static_cast<MyPrePackCustomKernel*>(op_kernel)->UsePrePacked(input_index, packed_buffer);
+  };
+}
+
+size_t MyPrePackCustomKernel::GetPrePackSize(const OrtValue* input, size_t input_index) {
+  if (input_index != 1) {
+    return 0;
+  }
+  OrtTensorTypeAndShapeInfo* info = ort_.GetTensorTypeAndShape(input);
+  size_t size = ort_.GetTensorShapeElementCount(info);
+  ort_.ReleaseTensorTypeAndShapeInfo(info);
+  return size * sizeof(float);
+}
+
+void MyPrePackCustomKernel::PrePack(const OrtValue* input, size_t /*input_index*/, void* packed_buffer) {
+  OrtTensorTypeAndShapeInfo* info = ort_.GetTensorTypeAndShape(input);
+  size_t size = ort_.GetTensorShapeElementCount(info);
+  ort_.ReleaseTensorTypeAndShapeInfo(info);
+
+  const float* W = ort_.GetTensorData<float>(input);
+  std::copy(W, W + size, static_cast<float*>(packed_buffer));
+  ++*pre_pack_count_;
+}
+
+void MyPrePackCustomKernel::UsePrePacked(size_t /*input_index*/, const void* packed_buffer) {
+  packed_W_ = static_cast<const float*>(packed_buffer);
+}
+
+void MyPrePackCustomKernel::Compute(OrtKernelContext* context) {
+  OrtTensorView inputs[2];
+  ort_.KernelContext_GetInputTensorViews(context, inputs, 2);
+
+  // W is read from its packed form
+  ORT_ENFORCE(packed_W_ != nullptr);
+
+  const int64_t* output_dims[1] = {inputs[0].dims};
+  const size_t output_num_dims[1] = {inputs[0].num_dims};
+  OrtTensorView output;
+  ort_.KernelContext_GetOutputTensorViews(context, output_dims, output_num_dims, &output, 1);
+
+  const float* X = static_cast<const float*>(inputs[0].data);
+  float* out = static_cast<float*>(output.data);
+  for (size_t i = 0; i < output.element_count; i++) {
+    out[i] = X[i] + packed_W_[i];
+  }
+}
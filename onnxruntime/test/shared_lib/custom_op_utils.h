@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/session/onnxruntime_cxx_api.h"
+#include <atomic>
 #include <vector>
 
 #ifdef USE_CUDA
@@ -246,3 +247,44 @@ struct InstantCustomOp : Ort::CustomOpBase<InstantCustomOp, InstantCustomKernel>
   const char* provider_;
   void* compute_stream_;
 };
+
+// Adds a constant input W to X like MyCustomOp, but reads the inputs and allocates the output through the batched
+// tensor view accessors, packs W once at session initialization, and infers the output shape from X.
+struct MyPrePackCustomKernel {
+  MyPrePackCustomKernel(Ort::CustomOpApi ort, const OrtKernelInfo* /*info*/, std::atomic<int>* pre_pack_count)
+      : ort_(ort), pre_pack_count_(pre_pack_count) {
+  }
+
+  void Compute(OrtKernelContext* context);
+
+  size_t GetPrePackSize(const OrtValue* input, size_t input_index);
+  void PrePack(const OrtValue* input, size_t input_index, void* packed_buffer);
+  void UsePrePacked(size_t input_index, const void* packed_buffer);
+
+ private:
+  Ort::CustomOpApi ort_;
+  std::atomic<int>* pre_pack_count_;
+  const float* packed_W_{};
+};
+
+struct MyPrePackCustomOp : Ort::CustomOpBase<MyPrePackCustomOp, MyPrePackCustomKernel> {
+  explicit MyPrePackCustomOp(const char* provider);
+
+  void* CreateKernel(Ort::CustomOpApi api, const OrtKernelInfo* info) const {
+    return new MyPrePackCustomKernel(api, info, &pre_pack_count_);
+  };
+  const char* GetName() const { return "Foo"; };
+  const char* GetExecutionProviderType() const { return provider_; };
+
+  size_t GetInputTypeCount() const { return 2; };
+  ONNXTensorElementDataType GetInputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  size_t GetOutputTypeCount() const { return 1; };
+  ONNXTensorElementDataType GetOutputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  int PrePackCount() const { return pre_pack_count_; }
+
+ private:
+  const char* provider_;
+  mutable std::atomic<int> pre_pack_count_{0};
+};
@@ -8,6 +8,7 @@
 #include <sstream>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
 #include <algorithm>
 #include <thread>
 
@@ -172,6 +173,7 @@ static constexpr PATH_TYPE SEQUENCE_MODEL_URI = TSTR("testdata/sequence_length.o
 static constexpr PATH_TYPE SEQUENCE_MODEL_URI_2 = TSTR("testdata/optional_sequence_tensor.onnx");
 #endif
 static constexpr PATH_TYPE CUSTOM_OP_MODEL_URI = TSTR("testdata/foo_1.onnx");
+static constexpr PATH_TYPE PREPACK_CUSTOM_OP_MODEL_URI = TSTR("testdata/foo_prepack.onnx");
 static constexpr PATH_TYPE CUSTOM_OP_LIBRARY_TEST_MODEL_URI = TSTR("testdata/custom_op_library/custom_op_test.onnx");
 static constexpr PATH_TYPE OVERRIDABLE_INITIALIZER_MODEL_URI = TSTR("testdata/overridable_initializer.onnx");
 static constexpr PATH_TYPE NAMED_AND_ANON_DIM_PARAM_URI = TSTR("testdata/capi_symbolic_dims.onnx");
@@ -405,6 +407,39 @@ TEST(CApiTest, custom_op_handler) {
 #endif
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+// The custom op infers the shape of its output and packs its constant input W once when the session is created.
+TEST(CApiTest, custom_op_prepack_and_shape_inference) {
+  std::vector<Input> inputs(1);
+  Input& input = inputs[0];
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+  // W holds the same values as X
+  std::vector<int64_t> expected_dims_y = {3, 2};
+  std::vector<float> expected_values_y = {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f};
+
+  MyPrePackCustomOp custom_op{onnxruntime::kCpuExecutionProvider};
+  Ort::CustomOpDomain custom_op_domain("");
+  custom_op_domain.Add(&custom_op);
+
+  Ort::SessionOptions session_options;
+  session_options.Add(custom_op_domain);
+  Ort::Session session(*ort_env, PREPACK_CUSTOM_OP_MODEL_URI, session_options);
+  ASSERT_EQ(custom_op.PrePackCount(), 1);
+
+  // the output of the model has no shape, it comes from the shape inference of the custom op
+  auto output_type_info = session.GetOutputTypeInfo(0);
+  ASSERT_EQ(output_type_info.GetTensorTypeAndShapeInfo().GetShape(), expected_dims_y);
+
+  auto default_allocator = std::make_unique<MockedOrtAllocator>();
+  RunSession<float>(default_allocator.get(), session, inputs, "Y", expected_dims_y, expected_values_y, nullptr);
+  RunSession<float>(default_allocator.get(), session, inputs, "Y", expected_dims_y, expected_values_y, nullptr);
+  ASSERT_EQ(custom_op.PrePackCount(), 1);
+}
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD) && !defined(REDUCED_OPS_BUILD)
 //disable test in reduced-op-build since TOPK and GRU are excluded there
 TEST(CApiTest, instant_op_handler) {
@@ -925,6 +960,218 @@ TEST(ReducedOpsBuildTest, test_excluded_ops) {
 }
 #endif
 
+namespace {
+struct RunAsyncResult {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done = false;
+  std::vector<float> values;
+  std::string error;
+};
+
+void ORT_API_CALL RunAsyncCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status) {
+  auto& result = *static_cast<RunAsyncResult*>(user_data);
+  {
+    std::lock_guard<std::mutex> lock(result.mutex);
+    if (status != nullptr) {
+      result.error = Ort::GetApi().GetErrorMessage(status);
+      Ort::GetApi().ReleaseStatus(status);
+    } else if (num_outputs == 1) {
+      // outputs is the array passed to RunAsync, so the values stay owned by the caller
+      Ort::Unowned<Ort::Value> output_value(outputs[0]);
+      const float* data = output_value.GetTensorData<float>();
+      result.values.assign(data, data + output_value.GetTensorTypeAndShapeInfo().GetElementCount());
+    }
+    result.done = true;
+  }
+  result.cv.notify_one();
+}
+}  // namespace
+
+TEST(CApiTest, run_async) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                 x_dims.data(), x_dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::Value y{nullptr};
+  Ort::RunOptions run_options;
+
+  RunAsyncResult result;
+  session.RunAsync(run_options, input_names, &x, 1, output_names, &y, 1, RunAsyncCallback, &result);
+
+  std::unique_lock<std::mutex> lock(result.mutex);
+  result.cv.wait(lock, [&result]() { return result.done; });
+  ASSERT_TRUE(result.error.empty()) << result.error;
+  ASSERT_EQ(result.values, (std::vector<float>{1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f}));
+}
+
+TEST(CApiTest, run_async_requires_thread_pool) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(1);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<float> x_values(6);
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                 x_dims.data(), x_dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::Value y{nullptr};
+  Ort::RunOptions run_options;
+
+  RunAsyncResult result;
+  EXPECT_THROW(session.RunAsync(run_options, input_names, &x, 1, output_names, &y, 1, RunAsyncCallback, &result),
+               Ort::Exception);
+  EXPECT_FALSE(result.done);
+}
+
+TEST(CApiTest, warmup_session) {
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  const char* input_names[] = {"X"};
+  Ort::RunOptions run_options;
+  auto run_durations_us = session.Warmup(run_options, input_names, 1, {{3, 2}}, true);
+  ASSERT_EQ(run_durations_us.size(), 2u);
+  EXPECT_GE(run_durations_us[0], 0);
+  EXPECT_GE(run_durations_us[1], 0);
+
+  // the warmed up shape still runs once the arenas are frozen
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                 x_dims.data(), x_dims.size());
+  const char* output_names[] = {"Y"};
+  auto y = session.Run(run_options, input_names, &x, 1, output_names, 1);
+  const float* y_data = y[0].GetTensorData<float>();
+  ASSERT_EQ(std::vector<float>(y_data, y_data + 6), (std::vector<float>{1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f}));
+}
+
+TEST(CApiTest, run_batch) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  constexpr size_t batch_size = 3;
+  std::vector<std::vector<float>> x_values(batch_size);
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  std::vector<Ort::Value> x;
+  for (size_t i = 0; i < batch_size; ++i) {
+    const float v = static_cast<float>(i + 1);
+    x_values[i] = {v, v, v, v, v, v};
+    x.push_back(Ort::Value::CreateTensor<float>(memory_info, x_values[i].data(), x_values[i].size(),
+                                                x_dims.data(), x_dims.size()));
+  }
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::RunOptions run_options;
+  auto y = session.RunBatch(run_options, input_names, x.data(), 1, output_names, 1, batch_size);
+  ASSERT_EQ(y.size(), batch_size);
+  for (size_t i = 0; i < batch_size; ++i) {
+    const float v = static_cast<float>(i + 1);
+    const float* y_data = y[i].GetTensorData<float>();
+    ASSERT_EQ(std::vector<float>(y_data, y_data + 6), std::vector<float>(6, v * v));
+  }
+}
+
+TEST(CApiTest, op_latency_histograms) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  {
+    Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions{});
+    ASSERT_THROW(session.GetOpLatencyHistograms(allocator), Ort::Exception);
+  }
+
+  Ort::SessionOptions session_options;
+  session_options.AddConfigEntry("session.profiling_sample_rate", "2");
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  auto x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(), x_dims.data(),
+                                           x_dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::RunOptions run_options;
+  for (int i = 0; i < 5; ++i) {
+    session.Run(run_options, input_names, &x, 1, output_names, 1);
+  }
+
+  // runs 0, 2 and 4 are sampled
+  auto histograms = session.GetOpLatencyHistograms(allocator);
+  ASSERT_EQ(histograms.size(), 1U);
+  ASSERT_EQ(histograms[0].first, "Mul");
+  ASSERT_EQ(histograms[0].second.size(), 32U);
+  uint64_t total = 0;
+  for (auto count : histograms[0].second) {
+    total += count;
+  }
+  ASSERT_EQ(total, 3U);
+}
+
+TEST(CApiTest, intra_op_thread_pool_stats) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  auto x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(), x_dims.data(),
+                                           x_dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  session.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+
+  auto stats = session.GetIntraOpThreadPoolStats();
+  ASSERT_EQ(stats.num_threads, 1);
+  ASSERT_GT(stats.uptime_ns, 0U);
+  ASSERT_LE(stats.busy_ns, stats.uptime_ns);
+}
+
+TEST(CApiTest, shape_statistics) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  {
+    Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions{});
+    ASSERT_THROW(session.GetShapeStatistics(allocator), Ort::Exception);
+  }
+
+  Ort::SessionOptions session_options;
+  session_options.AddConfigEntry("session.shape_statistics_sample_rate", "1");
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  std::vector<float> x_values(8, 1.0f);
+  for (int64_t rows : {3, 3, 4}) {
+    std::vector<int64_t> x_dims = {rows, 2};
+    auto x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), static_cast<size_t>(rows * 2),
+                                             x_dims.data(), x_dims.size());
+    session.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+  }
+
+  // the most frequent shape comes first
+  const std::string statistics = session.GetShapeStatistics(allocator);
+  ASSERT_NE(statistics.find(R"("sampled_runs" : 3)"), std::string::npos) << statistics;
+  ASSERT_NE(statistics.find(R"("inputs" : [{"shape" : "X:{3,2}", "count" : 2)"), std::string::npos) << statistics;
+  ASSERT_NE(statistics.find(R"({"shape" : "X:{4,2}", "count" : 1)"), std::string::npos) << statistics;
+  ASSERT_NE(statistics.find(R"("op_type" : "Mul", "output_shapes" : [{"shape" : "{3,2}", "count" : 2)"),
+            std::string::npos)
+      << statistics;
+}
+
 TEST(CApiTest, get_allocator_cpu) {
   Ort::SessionOptions session_options;
   Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CPU(session_options, 1));
@@ -1326,6 +1573,23 @@ TEST(CApiTest, create_tensor_with_data) {
   ASSERT_EQ(1u, tensor_info.GetDimensionsCount());
 }
 
+// The tensors of the platform buffer memory infos wrap a buffer handle as the data, which are not accessed here
+TEST(CApiTest, create_tensor_with_platform_buffer) {
+  float handle[4] = {};
+  std::vector<int64_t> dims = {4};
+  for (const char* name : {"NnapiMemory", "NnapiHardwareBuffer", "CoreMLPixelBuffer"}) {
+    Ort::MemoryInfo info(name, OrtDeviceAllocator, 0, OrtMemTypeDefault);
+    ASSERT_STREQ(info.GetAllocatorName().c_str(), name);
+    Ort::Value tensor = Ort::Value::CreateTensor<float>(info, handle, 4, dims.data(), dims.size());
+    ASSERT_EQ(tensor.GetTensorData<float>(), handle);
+    const OrtMemoryInfo* tensor_memory_info = nullptr;
+    Ort::ThrowOnError(Ort::GetApi().GetTensorMemoryInfo(tensor, &tensor_memory_info));
+    const char* tensor_memory_info_name = nullptr;
+    Ort::ThrowOnError(Ort::GetApi().MemoryInfoGetName(tensor_memory_info, &tensor_memory_info_name));
+    ASSERT_STREQ(tensor_memory_info_name, name);
+  }
+}
+
 TEST(CApiTest, create_tensor_with_data_float16) {
   // Example with C++. However, what we are feeding underneath is really
   // a continuous buffer of uint16_t
@@ -2009,6 +2273,37 @@ TEST(CApiTest, TestConfigureCUDAProviderOptions) {
   Ort::Session session(*ort_env, model_uri.c_str(), session_options);
 }
 
+// Two sessions allocating from the CUDA memory pool of the device
+TEST(CApiTest, cuda_mempool) {
+  const auto& api = Ort::GetApi();
+
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)> rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+  std::vector<const char*> keys{"use_cuda_mempool", "cuda_mempool_release_threshold"};
+  std::vector<const char*> values{"1", "1048576"};
+  ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), 2) == nullptr);
+
+  Ort::SessionOptions session_options;
+  ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(static_cast<OrtSessionOptions*>(session_options), rel_cuda_options.get()) == nullptr);
+
+  std::vector<Input> inputs(1);
+  Input& input = inputs.back();
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> expected_dims_y = {3, 2};
+  std::vector<float> expected_values_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  auto default_allocator = std::make_unique<MockedOrtAllocator>();
+  Ort::Session session_1(*ort_env, MODEL_URI, session_options);
+  Ort::Session session_2(*ort_env, MODEL_URI, session_options);
+  for (int i = 0; i < 3; ++i) {
+    RunSession<float>(default_allocator.get(), session_1, inputs, "Y", expected_dims_y, expected_values_y, nullptr);
+    RunSession<float>(default_allocator.get(), session_2, inputs, "Y", expected_dims_y, expected_values_y, nullptr);
+  }
+}
+
 #endif
 
 namespace TestPerSessionCustomThreadHooks {
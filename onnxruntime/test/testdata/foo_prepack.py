@@ -0,0 +1,30 @@
+import onnx
+from onnx import TensorProto, helper
+
+
+# Create a model with the custom op Foo adding the constant initializer W to the input X, to test the pre-packing and
+# the shape inference of custom ops. The output Y has no shape, it is inferred from the custom op.
+def GenerateModel(model_name):
+    nodes = [
+        helper.make_node("Foo", ["X", "W"], ["Y"], "foo"),
+    ]
+
+    initializers = [
+        helper.make_tensor("W", TensorProto.FLOAT, [3, 2], [1.0, 2.0, 3.0, 4.0, 5.0, 6.0]),
+    ]
+
+    graph = helper.make_graph(
+        nodes,
+        "CustomOpPrePack",
+        [helper.make_tensor_value_info("X", TensorProto.FLOAT, [3, 2])],
+        [helper.make_tensor_value_info("Y", TensorProto.FLOAT, None)],
+        initializers,
+    )
+
+    model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", 7)])
+    model.ir_version = 4
+    onnx.save(model, model_name)
+
+
+if __name__ == "__main__":
+    GenerateModel("foo_prepack.onnx")
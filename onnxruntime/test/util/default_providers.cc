@@ -136,7 +136,7 @@ std::unique_ptr<IExecutionProvider> DefaultNnapiExecutionProvider() {
 // The NNAPI EP uses a stub implementation on non-Android platforms so cannot be used to execute a model.
 // Manually append an NNAPI EP instance to the session to unit test the GetCapability and Compile implementation.
 #if defined(USE_NNAPI) && defined(__ANDROID__)
-  return CreateExecutionProviderFactory_Nnapi(0, {})->CreateProvider();
+  return CreateExecutionProviderFactory_Nnapi(0, {}, {})->CreateProvider();
 #else
   return nullptr;
 #endif
@@ -185,7 +185,7 @@ std::unique_ptr<IExecutionProvider> DefaultCoreMLExecutionProvider() {
   // We want to run UT on CPU only to get output value without losing precision
   uint32_t coreml_flags = 0;
   coreml_flags |= COREML_FLAG_USE_CPU_ONLY;
-  return CreateExecutionProviderFactory_CoreML(coreml_flags)->CreateProvider();
+  return CreateExecutionProviderFactory_CoreML(coreml_flags, {})->CreateProvider();
 #else
   return nullptr;
 #endif
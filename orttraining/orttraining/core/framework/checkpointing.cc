@@ -11,6 +11,7 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/common/path.h"
+#include "core/framework/data_transfer.h"
 #include "core/framework/data_transfer_utils.h"
 #include "core/framework/endian_utils.h"
 #include "core/framework/ort_value.h"
@@ -229,6 +230,69 @@ Status SaveModelCheckpoint(
   return Status::OK();
 }
 
+Status SnapshotModelCheckpointTensors(
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& runtime_tensors,
+    const AllocatorPtr& host_allocator,
+    NameMLValMap& snapshot) {
+  NameMLValMap host_tensors{};
+  for (const auto& name_and_ort_value : runtime_tensors) {
+    const OrtValue& ort_value = name_and_ort_value.second;
+    ORT_RETURN_IF_NOT(ort_value.IsTensor(), "ort_value.IsTensor() was false");
+    const Tensor& tensor = ort_value.Get<Tensor>();
+
+    auto host_tensor = std::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), host_allocator);
+    ORT_RETURN_IF_ERROR(data_transfer_manager.CopyTensor(tensor, *host_tensor));
+
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    host_tensors.emplace(
+        name_and_ort_value.first, OrtValue{host_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc()});
+  }
+
+  snapshot = std::move(host_tensors);
+  return Status::OK();
+}
+
+AsyncCheckpointWriter::AsyncCheckpointWriter() {
+  ORT_THROW_IF_ERROR(host_data_transfer_manager_.RegisterDataTransfer(std::make_unique<CPUDataTransfer>()));
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() {
+  const auto status = Wait();
+  LOGS_DEFAULT_IF(!status.IsOK(), ERROR) << "Failed to save model checkpoint: " << status.ErrorMessage();
+}
+
+Status AsyncCheckpointWriter::Save(
+    const PathString& checkpoint_path,
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& runtime_tensors,
+    const std::unordered_map<std::string, std::string>& properties,
+    const AllocatorPtr& host_allocator) {
+  // bounds the host memory to a single snapshot
+  ORT_RETURN_IF_ERROR(Wait());
+
+  NameMLValMap snapshot{};
+  ORT_RETURN_IF_ERROR(SnapshotModelCheckpointTensors(
+      data_transfer_manager, runtime_tensors, host_allocator, snapshot));
+
+  writer_thread_ = std::thread(
+      [this, checkpoint_path, snapshot = std::move(snapshot), properties]() {
+        write_status_ = SaveModelCheckpoint(checkpoint_path, host_data_transfer_manager_, snapshot, properties);
+      });
+
+  return Status::OK();
+}
+
+Status AsyncCheckpointWriter::Wait() {
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
+  }
+
+  Status status = write_status_;
+  write_status_ = Status::OK();
+  return status;
+}
+
 namespace {
 Status UpdateTensorsExternalDataLocations(
     const PathString& external_data_path,
@@ -4,11 +4,13 @@
 #pragma once
 
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "core/common/path_string.h"
 #include "core/common/status.h"
+#include "core/framework/allocator.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/data_types.h"
 #include "core/framework/framework_common.h"
@@ -54,5 +56,60 @@ common::Status LoadModelCheckpoint(
     std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos,
     std::unordered_map<std::string, std::string>& properties);
 
+/**
+ * Copies tensors to host memory.
+ *
+ * @param data_transfer_manager The DataTransferManager instance.
+ * @param runtime_tensors The tensors to copy.
+ * @param host_allocator The allocator of the copies, pinned memory makes the device-to-host copies faster.
+ * @param snapshot The copies.
+ * @return The status of the operation.
+ */
+common::Status SnapshotModelCheckpointTensors(
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& runtime_tensors,
+    const AllocatorPtr& host_allocator,
+    NameMLValMap& snapshot);
+
+/**
+ * Saves model checkpoints on a background thread.
+ *
+ * Save() only blocks for the copy of the tensors to host memory, the checkpoint files are written while training
+ * continues. At most one checkpoint is written at a time: Save() first waits for the previous one.
+ */
+class AsyncCheckpointWriter {
+ public:
+  AsyncCheckpointWriter();
+  ~AsyncCheckpointWriter();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AsyncCheckpointWriter);
+
+  /**
+   * Snapshots the tensors and starts writing a model checkpoint in the specified location.
+   * The arguments are the ones of SaveModelCheckpoint(), plus the allocator of the snapshot.
+   *
+   * @return The status of the snapshot, or of the previous write if it failed.
+   */
+  common::Status Save(
+      const PathString& checkpoint_path,
+      const DataTransferManager& data_transfer_manager,
+      const NameMLValMap& runtime_tensors,
+      const std::unordered_map<std::string, std::string>& properties,
+      const AllocatorPtr& host_allocator);
+
+  /**
+   * Waits for the checkpoint being written, if any.
+   *
+   * @return The status of the write.
+   */
+  common::Status Wait();
+
+ private:
+  // copies the host snapshots to the buffers the checkpoint is written from
+  DataTransferManager host_data_transfer_manager_;
+  std::thread writer_thread_;
+  common::Status write_status_;
+};
+
 }  // namespace training
 }  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include "orttraining/core/framework/ortmodule_graph_builder.h"
 #include "orttraining/core/framework/gradient_graph_builder.h"
 #include "orttraining/core/optimizer/graph_transformer_utils.h"
+#include "orttraining/core/optimizer/activation_offload.h"
 
 namespace onnxruntime {
 namespace training {
@@ -208,6 +209,23 @@ Status OrtModuleGraphBuilder::BuildGradientGraph(const std::unordered_set<std::s
 
   ORT_RETURN_IF_ERROR(grad_graph_builder.Build());
 
+  const TrainingGraphTransformerConfiguration& transformer_config = config_.graph_transformer_config;
+  // the budget is met by recomputing first, whatever activations it leaves stashed can then be offloaded
+  if (transformer_config.recompute_memory_budget >= 0) {
+    GraphTransformerManager graph_transformation_mgr{1};
+    ORT_RETURN_IF_ERROR(graph_transformation_mgr.Register(
+        std::make_unique<BudgetedRecompute>(transformer_config.recompute_memory_budget), TransformerLevel::Level1));
+    ORT_RETURN_IF_ERROR(graph_transformation_mgr.ApplyTransformers(gradient_graph, TransformerLevel::Level1, *logger_));
+  }
+  if (transformer_config.activation_offload) {
+    GraphTransformerManager graph_transformation_mgr{1};
+    ORT_RETURN_IF_ERROR(graph_transformation_mgr.Register(
+        std::make_unique<ActivationOffload>(transformer_config.activation_offload_min_bytes,
+                                            transformer_config.activation_offload_prefetch_distance),
+        TransformerLevel::Level1));
+    ORT_RETURN_IF_ERROR(graph_transformation_mgr.ApplyTransformers(gradient_graph, TransformerLevel::Level1, *logger_));
+  }
+
   return Status::OK();
 }
 
@@ -11,6 +11,9 @@
 #include <stdexcept>
 #include <thread>
 #include <iomanip>
+#include <sstream>
+#include <map>
+#include <tuple>
 //TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26451)
@@ -593,6 +596,139 @@ void PipelineWorkerPool::JoinAll() {
   };
 }
 
+InterleavedPipelineScheduler::InterleavedPipelineScheduler(
+    const int num_batches,
+    const int num_devices,
+    const int num_virtual_stages,
+    const int backward_cost) : num_batches_(num_batches),
+                               num_devices_(num_devices),
+                               num_virtual_stages_(num_virtual_stages),
+                               backward_cost_(backward_cost) {
+  if (num_batches <= 0 || num_devices <= 0 || num_virtual_stages <= 0 || backward_cost <= 0) {
+    throw std::invalid_argument("Micro-batch, device and virtual stage counts and backward cost must be positive.");
+  }
+  if (num_virtual_stages > 1 && num_batches % num_devices != 0) {
+    throw std::invalid_argument("The interleaved schedule requires the number of micro-batches to be a multiple of the number of devices.");
+  }
+
+  CreateDeviceOrders();
+  ComputeStartTimes();
+}
+
+void InterleavedPipelineScheduler::CreateDeviceOrders() {
+  // Micro-batches go through the virtual stages of a device in groups of num_devices_: the k-th forward compute
+  // of a device is for the chunk (k / num_devices_) % num_virtual_stages_ and the backward computes visit the chunks
+  // in the reverse order.
+  const int group_size = num_devices_ * num_virtual_stages_;
+  const int num_computes = num_batches_ * num_virtual_stages_;
+  auto batch_of = [&](const int k) { return (k / group_size) * num_devices_ + k % num_devices_; };
+  auto chunk_of = [&](const int k) { return (k % group_size) / num_devices_; };
+
+  device_schedules_.resize(num_devices_);
+  for (int d = 0; d < num_devices_; ++d) {
+    auto forward = [&](const int k) {
+      return VirtualStageTask{batch_of(k), chunk_of(k) * num_devices_ + d, PipelineTask::Pass::Forward};
+    };
+    auto backward = [&](const int k) {
+      return VirtualStageTask{batch_of(k), (num_virtual_stages_ - 1 - chunk_of(k)) * num_devices_ + d,
+                              PipelineTask::Pass::Backward};
+    };
+
+    // The earlier devices run more forward computes before their first backward compute, as its gradient comes from
+    // the last virtual stage.
+    const int num_warmup_computes =
+        std::min((num_devices_ - d - 1) * 2 + (num_virtual_stages_ - 1) * num_devices_, num_computes);
+
+    auto& tasks = device_schedules_.at(d);
+    for (int k = 0; k < num_warmup_computes; ++k) {
+      tasks.push_back(forward(k));
+    }
+    for (int k = 0; k < num_computes - num_warmup_computes; ++k) {
+      tasks.push_back(forward(num_warmup_computes + k));
+      tasks.push_back(backward(k));
+    }
+    for (int k = num_computes - num_warmup_computes; k < num_computes; ++k) {
+      tasks.push_back(backward(k));
+    }
+  }
+}
+
+void InterleavedPipelineScheduler::ComputeStartTimes() {
+  const int num_virtual_stages_total = num_devices_ * num_virtual_stages_;
+  // (pass, batch, virtual stage) -> finish time of the compute.
+  std::map<std::tuple<PipelineTask::Pass, int, int>, int> finish_times;
+  std::vector<size_t> next_task(num_devices_, 0);
+  std::vector<int> device_time(num_devices_, 0);
+
+  // Each device runs its tasks in order, as soon as the compute it depends on has finished.
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (int d = 0; d < num_devices_; ++d) {
+      auto& tasks = device_schedules_.at(d);
+      for (; next_task.at(d) < tasks.size(); ++next_task.at(d)) {
+        auto& task = tasks.at(next_task.at(d));
+        int ready_time = 0;
+        if (task.pass == PipelineTask::Pass::Forward && task.virtual_stage > 0) {
+          auto it = finish_times.find(std::make_tuple(PipelineTask::Pass::Forward, task.batch, task.virtual_stage - 1));
+          if (it == finish_times.end()) break;
+          ready_time = it->second;
+        } else if (task.pass == PipelineTask::Pass::Backward) {
+          // The last virtual stage starts the backward pass right after its forward compute.
+          auto it = task.virtual_stage == num_virtual_stages_total - 1
+                        ? finish_times.find(std::make_tuple(PipelineTask::Pass::Forward, task.batch, task.virtual_stage))
+                        : finish_times.find(std::make_tuple(PipelineTask::Pass::Backward, task.batch, task.virtual_stage + 1));
+          if (it == finish_times.end()) break;
+          ready_time = it->second;
+        }
+
+        task.start_time = std::max(device_time.at(d), ready_time);
+        device_time.at(d) = task.start_time + (task.pass == PipelineTask::Pass::Forward ? 1 : backward_cost_);
+        finish_times[std::make_tuple(task.pass, task.batch, task.virtual_stage)] = device_time.at(d);
+        progress = true;
+      }
+    }
+  }
+
+  for (int d = 0; d < num_devices_; ++d) {
+    if (next_task.at(d) != device_schedules_.at(d).size()) {
+      throw std::logic_error("The interleaved pipeline schedule has a circular dependency.");
+    }
+  }
+  makespan_ = *std::max_element(device_time.begin(), device_time.end());
+}
+
+double InterleavedPipelineScheduler::GetBubbleFraction() const {
+  const double busy_time = static_cast<double>(num_batches_) * num_virtual_stages_ * (1 + backward_cost_);
+  return 1.0 - busy_time / makespan_;
+}
+
+std::ostream& operator<<(std::ostream& stream, InterleavedPipelineScheduler const& schedule) {
+  stream << "-------------View of Interleaved Compute Schedule-------------" << std::endl;
+  for (int d = 0; d < schedule.num_devices_; ++d) {
+    std::vector<std::string> cells(schedule.makespan_, ".....");
+    for (const auto& task : schedule.device_schedules_.at(d)) {
+      std::ostringstream cell;
+      cell << (task.pass == PipelineTask::Pass::Forward ? 'F' : 'B') << std::setw(2) << std::setfill('0')
+           << task.batch << '.' << task.virtual_stage;
+      cells.at(task.start_time) = cell.str();
+      if (task.pass == PipelineTask::Pass::Backward) {
+        for (int t = 1; t < schedule.backward_cost_; ++t) {
+          cells.at(task.start_time + t) = std::string(cell.str().size(), '-');
+        }
+      }
+    }
+
+    stream << "device " << d << ":";
+    for (const auto& cell : cells) {
+      stream << " " << cell;
+    }
+    stream << std::endl;
+  }
+  stream << "bubble: " << schedule.GetBubbleFraction() << std::endl;
+  return stream;
+}
+
 }  // namespace pipeline
 }  // namespace training
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -238,6 +238,53 @@ class PipelineScheduler {
   std::vector<int> stage_id_to_rank_id_map_;
 };
 
+// Compute of one micro-batch on one virtual stage in InterleavedPipelineScheduler.
+struct VirtualStageTask {
+  int batch;
+  // Virtual stage, i.e. model chunk, the compute runs. Virtual stage v runs on device v % num_devices.
+  int virtual_stage;
+  PipelineTask::Pass pass;
+  // Scheduled start time.
+  int start_time{-1};
+};
+
+// Interleaved 1F1B schedule. Each device holds num_virtual_stages model chunks, virtual stage
+// v = chunk * num_devices + device, so that a micro-batch goes through every device num_virtual_stages times.
+// Each compute is then num_virtual_stages times shorter, which divides the (num_devices - 1) idle computes per device
+// of the 1F1B warm-up and cool-down, the pipeline bubble, by num_virtual_stages. The cost is num_virtual_stages times
+// more Send/Recv between devices. With num_virtual_stages = 1 this is the non-interleaved 1F1B schedule.
+//
+// Each device runs its warm-up forward computes, then alternates one forward and one backward compute, then runs the
+// remaining backward computes, as in Megatron-LM. Times are in units of the forward compute of one virtual stage,
+// a backward compute takes backward_cost units and the communication is not modeled.
+class InterleavedPipelineScheduler {
+ public:
+  InterleavedPipelineScheduler(const int num_batches, const int num_devices, const int num_virtual_stages,
+                               const int backward_cost = 2);
+
+  // Compute tasks of a device, in execution order.
+  const std::vector<VirtualStageTask>& GetDeviceSchedule(const int device) const { return device_schedules_.at(device); }
+  // Time at which the last compute finishes.
+  int GetMakespan() const { return makespan_; }
+  // Fraction of the devices' time spent idle.
+  double GetBubbleFraction() const;
+
+  // Visualization of the timeline of each device, one column per time unit, e.g. "F03.1" is the forward compute of
+  // micro-batch 3 on virtual stage 1, "-----" the rest of a backward compute and "....." idle time.
+  friend std::ostream& operator<<(std::ostream& stream, InterleavedPipelineScheduler const& schedule);
+
+ private:
+  void CreateDeviceOrders();
+  void ComputeStartTimes();
+
+  int num_batches_;
+  int num_devices_;
+  int num_virtual_stages_;
+  int backward_cost_;
+  int makespan_{0};
+  std::vector<std::vector<VirtualStageTask>> device_schedules_;
+};
+
 struct PipelineWorkerState {
   std::vector<std::string> feed_names;
   std::vector<OrtValue> feeds;
@@ -3,6 +3,10 @@
 
 #include "orttraining/core/graph/allreduce_optimizer_graph_builder.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "core/graph/graph_viewer.h"
 #include "orttraining/core/framework/distributed_run_context.h"
 
 namespace onnxruntime {
@@ -19,7 +23,9 @@ static bool IsNcclAvailable() {
 static Status AddNcclAllReduceForGradients(
     std::vector<ArgDef>& gradient_argdefs,
     std::vector<ArgDef>& input_gradient_argdef,
-    GraphAugmenter::GraphDefs& graph_defs) {
+    GraphAugmenter::GraphDefs& graph_defs,
+    const std::string& node_name = "NcclAllReduce",
+    bool use_communication_stream = false) {
   std::vector<ArgDef> allreduce_outputs(gradient_argdefs.size());
   for (size_t i = 0; i < gradient_argdefs.size(); i++) {
     TypeProto* allreduced_gradient_type_proto = graph_defs.CopyTypeProto(gradient_argdefs[i]);
@@ -34,13 +40,60 @@ static Status AddNcclAllReduceForGradients(
                                   input_gradient_argdef,
                                   allreduce_outputs,
                                   {ONNX_NAMESPACE::MakeAttribute("group_type",
-                                                                 static_cast<int64_t>(WorkerGroupType::DataParallel))},
-                                  "NcclAllReduce")});
+                                                                 static_cast<int64_t>(WorkerGroupType::DataParallel)),
+                                   ONNX_NAMESPACE::MakeAttribute("use_communication_stream",
+                                                                 static_cast<int64_t>(use_communication_stream))},
+                                  node_name)});
 
   gradient_argdefs = allreduce_outputs;
   return Status::OK();
 }
 
+// Splits the gradients into buckets of about bucket_size bytes, in the order the backward pass produces them, and
+// returns the gradient indices of each bucket. The size of a gradient is taken from the shape of its weight.
+static std::vector<std::vector<size_t>> GetGradientBuckets(
+    const Graph& graph,
+    const std::vector<std::string>& gradient_names,
+    const std::vector<ArgDef>& weight_argdefs,
+    int64_t bucket_size,
+    int64_t element_size) {
+  GraphViewer graph_viewer(graph);
+  const auto& node_order = graph_viewer.GetNodesInTopologicalOrder();
+  std::vector<size_t> position(graph.MaxNodeIndex(), std::numeric_limits<size_t>::max());
+  for (size_t i = 0; i < node_order.size(); ++i) {
+    position[node_order[i]] = i;
+  }
+
+  // gradients without a producer, e.g. graph inputs, are ready first
+  std::vector<std::pair<size_t, size_t>> ready_order;  // (position of the producer, gradient index)
+  for (size_t i = 0; i < gradient_names.size(); ++i) {
+    const Node* producer = graph.GetProducerNode(gradient_names[i]);
+    ready_order.emplace_back(producer != nullptr ? position[producer->Index()] : 0, i);
+  }
+  std::stable_sort(ready_order.begin(), ready_order.end());
+
+  std::vector<std::vector<size_t>> buckets;
+  int64_t current_bucket_size = bucket_size;
+  for (const auto& ready : ready_order) {
+    int64_t num_elements = 1;
+    const auto* type_proto = weight_argdefs[ready.second].type_proto;
+    if (type_proto != nullptr && type_proto->tensor_type().has_shape()) {
+      for (const auto& dim : type_proto->tensor_type().shape().dim()) {
+        num_elements *= dim.has_dim_value() ? dim.dim_value() : 1;
+      }
+    }
+
+    if (current_bucket_size >= bucket_size) {
+      buckets.emplace_back();
+      current_bucket_size = 0;
+    }
+    buckets.back().push_back(ready.second);
+    current_bucket_size += num_elements * element_size;
+  }
+
+  return buckets;
+}
+
 AllreduceOptimizerGraphBuilder::AllreduceOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -80,10 +133,15 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
       opt_graph_config_.gradient_accumulation_steps * opt_graph_config_.data_parallel_group_size;
   ORT_RETURN_IF_NOT(total_num_accumulations > 0, "total_num_accumulations <= 0");
   const float scale = 1.0f / total_num_accumulations;
-  ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
-                                              opt_graph_config_.AllReduceDataType()));
-
-  ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  if (opt_graph_config_.allreduce_bucket_size > 0) {
+    ORT_RETURN_IF_ERROR(AddBucketedNcclAllReduce(nodearg_name_generator, scale, graph, graph_defs, weight_argdefs,
+                                                 gradient_argdefs));
+  } else {
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
+                                                opt_graph_config_.AllReduceDataType()));
+
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  }
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
@@ -112,5 +170,54 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
   return Status::OK();
 }
 
+Status AllreduceOptimizerGraphBuilder::AddBucketedNcclAllReduce(
+    const NodeArgNameGeneratorFn& nodearg_name_generator,
+    const float scale,
+    const Graph& graph,
+    GraphAugmenter::GraphDefs& graph_defs,
+    const std::vector<ArgDef>& weight_argdefs,
+    std::vector<ArgDef>& gradient_argdefs) {
+  const auto allreduce_data_type = opt_graph_config_.AllReduceDataType();
+  const int64_t element_size = allreduce_data_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT ? 4 : 2;
+  const auto buckets = GetGradientBuckets(graph, gradient_names_, weight_argdefs,
+                                          opt_graph_config_.allreduce_bucket_size, element_size);
+
+  // each bucket is scaled and all-reduced on its own, so the all-reduce only depends on the gradients of its bucket
+  std::vector<ArgDef> reduced_argdefs;
+  std::vector<size_t> reduced_gradient_indices;
+  for (const auto& bucket : buckets) {
+    std::vector<ArgDef> bucket_argdefs;
+    for (size_t i : bucket) {
+      bucket_argdefs.push_back(gradient_argdefs[i]);
+    }
+
+    std::vector<ArgDef> scaled_argdefs;
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, bucket_argdefs, scaled_argdefs,
+                                                graph_defs, allreduce_data_type));
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(bucket_argdefs, scaled_argdefs, graph_defs,
+                                                     nodearg_name_generator("NcclAllReduce"), true));
+
+    reduced_argdefs.insert(reduced_argdefs.end(), bucket_argdefs.begin(), bucket_argdefs.end());
+    reduced_gradient_indices.insert(reduced_gradient_indices.end(), bucket.begin(), bucket.end());
+  }
+
+  // the consumers of the reduced gradients wait for the all-reduce of all the buckets
+  std::vector<ArgDef> ready_argdefs;
+  for (const auto& reduced_argdef : reduced_argdefs) {
+    ready_argdefs.emplace_back(nodearg_name_generator(reduced_argdef.name + "_Ready"),
+                               graph_defs.CopyTypeProto(reduced_argdef));
+  }
+  graph_defs.AddNodeDefs({NodeDef(OpDef{"NcclWaitCommunication", kMSDomain, 1},
+                                  reduced_argdefs,
+                                  ready_argdefs,
+                                  NodeAttributes(),
+                                  nodearg_name_generator("NcclWaitCommunication"))});
+
+  for (size_t i = 0; i < ready_argdefs.size(); ++i) {
+    gradient_argdefs[reduced_gradient_indices[i]] = ready_argdefs[i];
+  }
+  return Status::OK();
+}
+
 }  // namespace training
 }  // namespace onnxruntime
@@ -27,6 +27,17 @@ class AllreduceOptimizerGraphBuilder : public OptimizerGraphBuilder {
       std::vector<ArgDef>& gradient_argdefs,
       std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
       OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) override;
+
+ private:
+  // Scales and all-reduces the gradients in buckets of opt_graph_config_.allreduce_bucket_size bytes on the NCCL
+  // communication stream, followed by a wait of the compute stream for all the buckets.
+  Status AddBucketedNcclAllReduce(
+      const NodeArgNameGeneratorFn& nodearg_name_generator,
+      const float scale,
+      const Graph& graph,
+      GraphAugmenter::GraphDefs& graph_defs,
+      const std::vector<ArgDef>& weight_argdefs,
+      std::vector<ArgDef>& gradient_argdefs);
 };
 
 }  // namespace training
@@ -1361,6 +1361,15 @@ IMPLEMENT_GRADIENT_BUILDER(GetMegatronGGradient) {
               {GI(0)})};
 }
 
+IMPLEMENT_GRADIENT_BUILDER(GetNcclAllToAllGradient) {
+  // the exchange is a permutation of the chunks that is its own inverse
+  return std::vector<NodeDef>{
+      NodeDef(OpDef{"NcclAllToAll", kMSDomain, 1},
+              {GO(0)},
+              {GI(0)},
+              SrcNodeAttributes())};
+}
+
 IMPLEMENT_GRADIENT_BUILDER(GetSliceGradient) {
   std::vector<ArgDef> inputs{GO(0), IA("I0_shape")};
   for (int i = 1; i < GetSrcNodeInputSize(); i++) {
@@ -61,6 +61,7 @@ DECLARE_GRADIENT_BUILDER(GetSimplifiedLayerNormalizationGradient)
 DECLARE_GRADIENT_BUILDER(GetBatchNormalizationGradient)
 DECLARE_GRADIENT_BUILDER(GetMegatronFGradient)
 DECLARE_GRADIENT_BUILDER(GetMegatronGGradient)
+DECLARE_GRADIENT_BUILDER(GetNcclAllToAllGradient)
 DECLARE_GRADIENT_BUILDER(GetSliceGradient)
 DECLARE_GRADIENT_BUILDER(GetWhereGradient)
 DECLARE_GRADIENT_BUILDER(GetSendGradient)
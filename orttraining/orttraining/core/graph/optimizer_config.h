@@ -30,8 +30,9 @@ enum MixedPrecisionDataType {
 };
 
 // Configuration for the DeepSpeed ZeRO technique.  Currently only the stage
-// setting is supported, and only with stages 0 (disabled) and 1 (optimizer
-// state partitioning).
+// setting is supported, with stages 0 (disabled), 1 (optimizer state
+// partitioning) and 2 (optimizer state and gradient accumulation buffer
+// partitioning).
 
 struct ZeROConfig {
   // Default configuration
@@ -73,6 +74,10 @@ struct OptimizerGraphConfig {
   std::string loss_scale_input_name{};  // empty string means no loss scaling factor is applied
   AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
   bool enable_grad_norm_clip{true};
+  // If > 0, the NCCL all-reduce of the gradients is split into buckets of about this many bytes, in the order the
+  // backward pass produces the gradients, and each bucket runs on the NCCL communication stream so that it overlaps
+  // with the rest of the backward pass. 0 all-reduces all the gradients at once after the backward pass.
+  int64_t allreduce_bucket_size{0};
 
   NameMLValMap shared_optimizer_states{};  // initial states for shared params, eg. 'Step' for lamb
 
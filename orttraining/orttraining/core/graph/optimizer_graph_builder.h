@@ -30,6 +30,16 @@ ArgDef BuildGradientAccumulationNode(const NodeArgNameGeneratorFn& nodearg_name_
                                      GraphAugmenter::GraphDefs& graph_defs,
                                      bool add_accumulate_buffer_as_initializers = true);
 
+ArgDef AddGradientAccumulationNodes(const NodeArgNameGeneratorFn& nodearg_name_generator,
+                                    std::vector<ArgDef>& gradient_argdefs,               // update argdefs in place
+                                    std::vector<ArgDef>& gradient_accumulation_buffers,  // output
+                                    GraphAugmenter::GraphDefs& graph_defs);
+
+Status AddZeroGradientNodes(const NodeArgNameGeneratorFn& nodearg_name_generator,
+                            const std::vector<ArgDef>& control_signals,
+                            std::vector<ArgDef>& gradient_argdefs,  // update argdefs in place
+                            GraphAugmenter::GraphDefs& graph_defs);
+
 /**
  * Builds the optimizer components on top of an existing training graph.
  * The optimizers used are determined by the weight_names_to_opt_configs parameter
@@ -80,6 +90,11 @@ class OptimizerGraphBuilder {
       std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
       OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs);
 
+  // Whether Build accumulates the gradients before BuildInternal when gradient accumulation is enabled.
+  // Builders that accumulate a transformed gradient, e.g. the shard a rank owns, return false and add the
+  // accumulation and the zeroing of the buffers in BuildInternal.
+  virtual bool AccumulatesGradientsBeforeBuildInternal() const { return true; }
+
   Status AddGradientPassThroughNode(
       const NodeArgNameGeneratorFn& nodearg_name_generator,
       std::vector<ArgDef>& gradient_argdefs,  // update argdefs in place
@@ -1489,6 +1489,11 @@ Example 4:
             "4 - horozontal parallel, 5 - model parallel.",
             AttributeProto::INT,
             static_cast<int64_t>(0))
+      .Attr("use_communication_stream",
+            "If 1, the all-reduce runs on the communication stream and overlaps with the computation that follows it. "
+            "The outputs must then go through NcclWaitCommunication before they are read.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "tensors to be reduced", "T", OpSchema::Variadic)
       .Output(0, "output", "reduced tensors", "T", OpSchema::Variadic)
       .TypeConstraint(
@@ -1500,6 +1505,27 @@ Example 4:
         propagateShapeAndTypeFromFirstInput(ctx);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(NcclWaitCommunication)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc("Makes the computation that reads the outputs wait for the collectives queued on the communication stream.")
+      .Input(0, "input", "tensors produced by collectives on the communication stream", "T", OpSchema::Variadic)
+      .Output(0, "output", "the input tensors", "T", OpSchema::Variadic)
+      .TypeConstraint(
+          "T",
+          {"tensor(float16)", "tensor(float)", "tensor(double)"},
+          "Constrain to float, float16 and double tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        if (ctx.getNumInputs() != ctx.getNumOutputs())
+          fail_shape_inference("NcclWaitCommunication's input count must be equal to output count.");
+        for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+          propagateElemTypeFromInputToOutput(ctx, i, i);
+          if (hasInputShape(ctx, i)) {
+            propagateShapeFromInputToOutput(ctx, i, i);
+          }
+        }
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(NcclAllGather)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1542,6 +1568,30 @@ Example 4:
 #endif
       ;
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(NcclAllToAll)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(
+          "Splits the input into group size equal chunks along its first dimension and sends chunk i to rank i of "
+          "the group. Chunk i of the output is the chunk received from rank i. This is the dispatch and combine "
+          "exchange of expert parallel mixture-of-experts layers, and is its own gradient.")
+      .Attr("group_type",
+            "0 - global parallel group, 1 - data parallel group, "
+            "2 - node local data parallel group, 3 - cross node data parallel group, "
+            "4 - horozontal parallel, 5 - model parallel.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
+      .Input(0, "input", "tensor to be exchanged, its first dimension must be a multiple of the group size", "T")
+      .Output(0, "output", "exchanged tensor", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(float16)", "tensor(float)", "tensor(double)"},
+          "Constrain to float, float16 and double tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        assert(getAttribute(ctx, "group_type", 0) < static_cast<int64_t>(WorkerGroupType::WorkerGroupTypeCount));
+        propagateShapeAndTypeFromFirstInput(ctx);
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(AdasumAllReduce)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -435,6 +435,8 @@ ZeROOptimizerGraphBuilder::ZeROOptimizerGraphBuilder(
   ORT_ENFORCE(opt_graph_config.data_parallel_group_size > 1, "ZeRO optimizer graph builder can only be used for distributed training.");
   ORT_ENFORCE(opt_graph_config.use_nccl, "Distributed training with ZeRO is only supported with NCCL.");
   ORT_ENFORCE(IsNcclAvailable(), "Distributed training with NCCL is not supported, as NCCL is not enabled in this build.");
+  ORT_ENFORCE(opt_graph_config.deepspeed_zero.stage <= 2,
+              "ZeRO stage ", opt_graph_config.deepspeed_zero.stage, " is not supported, the supported stages are 1 and 2.");
 }
 
 Status ZeROOptimizerGraphBuilder::BuildInternal(
@@ -450,6 +452,18 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
     return graph.GenerateNodeArgName(base_name);
   };
 
+  const bool accumulate_gradient_shards =
+      opt_graph_config_.gradient_accumulation_steps > 1 && !AccumulatesGradientsBeforeBuildInternal();
+  if (accumulate_gradient_shards) {
+    // the gradients come straight from the backward pass and may lack a shape, which is the one of their weight
+    for (size_t i = 0; i < gradient_argdefs.size(); i++) {
+      TypeProto* gradient_type_proto = graph_defs.CopyTypeProto(weight_argdefs[i]);
+      gradient_type_proto->mutable_tensor_type()->set_elem_type(
+          gradient_argdefs[i].type_proto->tensor_type().elem_type());
+      gradient_argdefs[i].type_proto = gradient_type_proto;
+    }
+  }
+
   // handle optimizer partitioning
   ORT_RETURN_IF_ERROR(ModifyParametersForOptimizerPartitioning(
       graph, graph_defs, opt_graph_config_, opt_configs_, weight_argdefs, gradient_argdefs, updated_weight_names_map_, weight_partition_info_));
@@ -465,6 +479,22 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
   // add Reducescatter for gradients
   ORT_RETURN_IF_ERROR(AddNcclReduceScatterForGradients(gradient_argdefs, graph_defs));
 
+  // accumulate the reduced shards owned by this rank, so the accumulation buffers hold 1/data_parallel_group_size
+  // of the gradients
+  std::vector<ArgDef> gradient_accumulation_buffers;
+  if (accumulate_gradient_shards) {
+    std::vector<ArgDef> owned_gradient_argdefs = GetGradientNormInputs(gradient_argdefs, opt_configs_);
+    const ArgDef group_accumulate_gradient_output = AddGradientAccumulationNodes(
+        nodearg_name_generator, owned_gradient_argdefs, gradient_accumulation_buffers, graph_defs);
+    optimizer_graph_outputs[OptimizerOutputKey::GradientAccumulation] = group_accumulate_gradient_output.name;
+
+    for (size_t i = 0, owned_index = 0; i < gradient_argdefs.size(); i++) {
+      if (opt_configs_[i].enabled) {
+        gradient_argdefs[i] = owned_gradient_argdefs[owned_index++];
+      }
+    }
+  }
+
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
   ArgDef global_grad_norm_finite_argdef;
@@ -494,6 +524,12 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
   // add Allgather for weights
   ORT_RETURN_IF_ERROR(AddNcclAllGatherForWeights(weight_argdefs, graph_defs));
 
+  // clear the accumulated shards once the weights are updated
+  if (accumulate_gradient_shards) {
+    ORT_RETURN_IF_ERROR(AddZeroGradientNodes(
+        nodearg_name_generator, weight_argdefs, gradient_accumulation_buffers, graph_defs));
+  }
+
   return Status::OK();
 }
 
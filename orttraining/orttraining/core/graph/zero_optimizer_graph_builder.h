@@ -27,6 +27,11 @@ class ZeROOptimizerGraphBuilder : public OptimizerGraphBuilder {
       std::vector<ArgDef>& gradient_argdefs,
       std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& optimizer_state_initializer_names,
       OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) override;
+
+  // In stage 2, the gradients are reduce-scattered at each step and only the shard owned by the rank is accumulated.
+  bool AccumulatesGradientsBeforeBuildInternal() const override {
+    return opt_graph_config_.deepspeed_zero.stage < 2;
+  }
 };
 
  /**
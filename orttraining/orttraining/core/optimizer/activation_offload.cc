@@ -0,0 +1,311 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/core/optimizer/activation_offload.h"
+
+#include <numeric>
+
+#include "core/framework/data_types.h"
+#include "core/graph/graph_utils.h"
+#include "orttraining/core/graph/recompute_graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsBackwardNode(const Node& node) {
+  return node.Description() == "Backward pass";
+}
+
+// Size of a tensor with a static shape, or -1 if it isn't known before running.
+int64_t StaticSizeInBytes(const NodeArg& arg) {
+  const TypeProto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type() || arg.Shape() == nullptr) {
+    return -1;
+  }
+
+  int64_t size = static_cast<int64_t>(
+      DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType()->Size());
+  for (const auto& dim : arg.Shape()->dim()) {
+    if (!dim.has_dim_value()) {
+      return -1;
+    }
+    size *= dim.dim_value();
+  }
+  return size;
+}
+
+// Ops cheap enough to be recomputed in the backward pass rather than copied back from the host.
+bool IsCheapToRecompute(const Node& node) {
+  static const InlinedHashSet<std::string_view> recompute_optypes = {
+      "Relu", "Gelu", "FastGelu", "BiasGelu", "Sigmoid", "Tanh", "Add", "Sub", "Mul", "Div", "Cast"};
+  return node.OutputDefs().size() == 1 && recompute_optypes.find(node.OpType()) != recompute_optypes.end();
+}
+
+}  // namespace
+
+Status ActivationOffload::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_ids = graph_viewer.GetNodesInTopologicalOrder();
+  std::unordered_map<NodeIndex, size_t> positions;
+  for (size_t i = 0; i < node_ids.size(); ++i) {
+    positions[node_ids[i]] = i;
+  }
+
+  const auto& graph_outputs = graph.GetOutputs();
+  // stashed activations that won't be on the device between the forward and the backward pass
+  std::unordered_set<const NodeArg*> moved;
+
+  // Traverse in topological order, so that the inputs of a node are planned before its outputs
+  for (size_t position = 0; position < node_ids.size(); ++position) {
+    Node& node = *graph.GetNode(node_ids[position]);
+    if (IsBackwardNode(node)) {
+      continue;
+    }
+
+    for (size_t output_idx = 0; output_idx < node.OutputDefs().size(); ++output_idx) {
+      NodeArg* output = node.MutableOutputDefs()[output_idx];
+      if (std::find(graph_outputs.begin(), graph_outputs.end(), output) != graph_outputs.end()) {
+        continue;
+      }
+
+      std::vector<graph_utils::GraphEdge> backward_edges;
+      size_t first_consumer = node_ids.size();
+      for (const auto& edge : graph_utils::GraphEdge::GetNodeOutputEdges(node, output_idx)) {
+        if (IsBackwardNode(*graph.GetNode(edge.dst_node))) {
+          backward_edges.push_back(edge);
+          first_consumer = std::min(first_consumer, positions[edge.dst_node]);
+        }
+      }
+      if (backward_edges.empty()) {
+        continue;
+      }
+
+      const int64_t size = StaticSizeInBytes(*output);
+      if (size < 0 || size < min_bytes_) {
+        continue;
+      }
+
+      // the copy back has to start prefetch_distance nodes into the backward pass to be hidden
+      if (first_consumer < static_cast<size_t>(prefetch_distance_) + position) {
+        continue;
+      }
+      Node& trigger = *graph.GetNode(node_ids[first_consumer - prefetch_distance_]);
+      if (!IsBackwardNode(trigger)) {
+        continue;
+      }
+
+      bool recompute = IsCheapToRecompute(node);
+      for (const NodeArg* input : node.InputDefs()) {
+        if (!recompute) {
+          break;
+        }
+        // graph inputs and initializers are always on the device, other inputs only if the backward pass keeps them
+        const Node* producer = graph.GetProducerNode(input->Name());
+        recompute = producer == nullptr ||
+                    (moved.count(input) == 0 &&
+                     std::any_of(producer->OutputEdgesBegin(), producer->OutputEdgesEnd(),
+                                 [&](const Node::EdgeEnd& edge) {
+                                   return IsBackwardNode(edge.GetNode()) &&
+                                          producer->OutputDefs()[edge.GetSrcArgIndex()] == input;
+                                 }));
+      }
+
+      Node* replacement = nullptr;
+      if (recompute) {
+        auto& recomputed_output = graph.GetOrCreateNodeArg(graph_utils::RecomputeName(output->Name()),
+                                                           output->TypeAsProto());
+        Node& recompute_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_recompute"),
+                                             node.OpType(),
+                                             "Recompute of " + node.Name(),
+                                             node.MutableInputDefs(),
+                                             {&recomputed_output},
+                                             &node.GetAttributes(),
+                                             node.Domain());
+        recompute_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+        graph.AddControlEdge(trigger.Index(), recompute_node.Index());
+        replacement = &recompute_node;
+      } else {
+        auto& host_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("offload_" + output->Name()),
+                                                     output->TypeAsProto());
+        Node& offload_node = graph.AddNode(graph.GenerateNodeName("offload_" + output->Name()),
+                                           "MemcpyToHost",
+                                           "Offload of " + output->Name(),
+                                           {output},
+                                           {&host_output});
+        // offloads run eagerly, so that the device memory of the activation is released as soon as possible
+        offload_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_HIGH));
+
+        auto& prefetched_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("prefetch_" + output->Name()),
+                                                           output->TypeAsProto());
+        Node& prefetch_node = graph.AddNode(graph.GenerateNodeName("prefetch_" + output->Name()),
+                                            "MemcpyFromHost",
+                                            "Prefetch of " + output->Name(),
+                                            {&host_output},
+                                            {&prefetched_output});
+        prefetch_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_HIGH));
+        graph.AddControlEdge(trigger.Index(), prefetch_node.Index());
+        replacement = &prefetch_node;
+      }
+
+      for (const auto& edge : backward_edges) {
+        graph.RemoveEdge(edge.src_node, edge.dst_node, edge.src_arg_index, edge.dst_arg_index);
+        graph.AddEdge(replacement->Index(), edge.dst_node, 0, edge.dst_arg_index);
+      }
+
+      moved.insert(output);
+      LOGS(logger, INFO) << (recompute ? "Recompute" : "Offload") << " activation " << output->Name() << " of "
+                         << size << " bytes";
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status BudgetedRecompute::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_ids = graph_viewer.GetNodesInTopologicalOrder();
+  std::unordered_map<NodeIndex, size_t> positions;
+  for (size_t i = 0; i < node_ids.size(); ++i) {
+    positions[node_ids[i]] = i;
+  }
+
+  struct StashedActivation {
+    Node* producer;
+    NodeArg* output;
+    int64_t size;
+    size_t first_consumer;
+    size_t last_consumer;
+    std::vector<graph_utils::GraphEdge> backward_edges;
+  };
+  std::vector<StashedActivation> stashed;
+  std::unordered_map<const NodeArg*, size_t> stashed_indices;
+  int64_t stashed_bytes = 0;
+
+  const auto& graph_outputs = graph.GetOutputs();
+  for (size_t position = 0; position < node_ids.size(); ++position) {
+    Node& node = *graph.GetNode(node_ids[position]);
+    if (IsBackwardNode(node)) {
+      continue;
+    }
+
+    for (size_t output_idx = 0; output_idx < node.OutputDefs().size(); ++output_idx) {
+      NodeArg* output = node.MutableOutputDefs()[output_idx];
+      if (std::find(graph_outputs.begin(), graph_outputs.end(), output) != graph_outputs.end()) {
+        continue;
+      }
+
+      std::vector<graph_utils::GraphEdge> backward_edges;
+      size_t first_consumer = node_ids.size();
+      size_t last_consumer = 0;
+      for (const auto& edge : graph_utils::GraphEdge::GetNodeOutputEdges(node, output_idx)) {
+        if (IsBackwardNode(*graph.GetNode(edge.dst_node))) {
+          backward_edges.push_back(edge);
+          first_consumer = std::min(first_consumer, positions[edge.dst_node]);
+          last_consumer = std::max(last_consumer, positions[edge.dst_node]);
+        }
+      }
+
+      const int64_t size = StaticSizeInBytes(*output);
+      if (backward_edges.empty() || size < 0) {
+        continue;
+      }
+
+      stashed_indices[output] = stashed.size();
+      stashed.push_back({&node, output, size, first_consumer, last_consumer, std::move(backward_edges)});
+      stashed_bytes += size;
+    }
+  }
+
+  if (stashed_bytes <= budget_bytes_) {
+    LOGS(logger, INFO) << "Stashed activations of " << stashed_bytes << " bytes fit the budget of " << budget_bytes_
+                       << " bytes";
+    return Status::OK();
+  }
+
+  // the largest activations first, so that the budget is met with as few recomputes as possible
+  std::vector<size_t> order(stashed.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b) { return stashed[a].size > stashed[b].size; });
+
+  std::vector<bool> recomputed(stashed.size(), false);
+  // activations read by a recompute, which have to stay stashed
+  std::vector<bool> pinned(stashed.size(), false);
+  for (size_t i : order) {
+    if (stashed_bytes <= budget_bytes_) {
+      break;
+    }
+
+    StashedActivation& activation = stashed[i];
+    Node& node = *activation.producer;
+    if (pinned[i] || !IsCheapToRecompute(node)) {
+      continue;
+    }
+
+    // nothing is saved if the activation is consumed right as the backward pass starts
+    Node& trigger = *graph.GetNode(node_ids[activation.first_consumer - 1]);
+    if (!IsBackwardNode(trigger)) {
+      continue;
+    }
+
+    // graph inputs and initializers are always on the device, other inputs must be stashed until the recompute runs
+    std::vector<size_t> input_indices;
+    bool inputs_stashed = true;
+    for (const NodeArg* input : node.InputDefs()) {
+      if (!input->Exists() || graph.GetProducerNode(input->Name()) == nullptr) {
+        continue;
+      }
+      auto it = stashed_indices.find(input);
+      if (it == stashed_indices.end() || recomputed[it->second] ||
+          stashed[it->second].last_consumer < activation.first_consumer) {
+        inputs_stashed = false;
+        break;
+      }
+      input_indices.push_back(it->second);
+    }
+    if (!inputs_stashed) {
+      continue;
+    }
+
+    NodeArg* output = activation.output;
+    auto& recomputed_output = graph.GetOrCreateNodeArg(graph_utils::RecomputeName(output->Name()),
+                                                       output->TypeAsProto());
+    Node& recompute_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_recompute"),
+                                         node.OpType(),
+                                         "Recompute of " + node.Name(),
+                                         node.MutableInputDefs(),
+                                         {&recomputed_output},
+                                         &node.GetAttributes(),
+                                         node.Domain());
+    recompute_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+    graph.AddControlEdge(trigger.Index(), recompute_node.Index());
+
+    for (const auto& edge : activation.backward_edges) {
+      graph.RemoveEdge(edge.src_node, edge.dst_node, edge.src_arg_index, edge.dst_arg_index);
+      graph.AddEdge(recompute_node.Index(), edge.dst_node, 0, edge.dst_arg_index);
+    }
+
+    recomputed[i] = true;
+    for (size_t input_index : input_indices) {
+      pinned[input_index] = true;
+    }
+    stashed_bytes -= activation.size;
+    LOGS(logger, INFO) << "Recompute activation " << output->Name() << " of " << activation.size << " bytes";
+    modified = true;
+  }
+
+  if (stashed_bytes > budget_bytes_) {
+    LOGS(logger, WARNING) << "Stashed activations of " << stashed_bytes << " bytes still exceed the budget of "
+                          << budget_bytes_ << " bytes, no other activation can be recomputed";
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
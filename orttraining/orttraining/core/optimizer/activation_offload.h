@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ActivationOffload
+
+Reduces the device memory held by the activations the backward pass stashes. Applied to a gradient graph, it plans
+for each stashed activation of at least min_bytes whether to:
+- recompute it, when its producer is a cheap elementwise op whose inputs stay on the device for the backward pass
+  anyway, so that recomputing adds no memory and no copy;
+- offload it, otherwise: a MemcpyToHost right after the producer moves it to pinned host memory on the copy-out
+  stream during the forward pass, and a MemcpyFromHost prefetches it on the copy-in stream prefetch_distance nodes
+  before its first backward consumer.
+Activations whose first backward consumer comes too soon after their producer to hide the copies are left as they
+are.
+
+The recompute and prefetch nodes are held back until the backward pass with a control edge from the backward node
+prefetch_distance nodes before the consumer. The copies only overlap the compute when the CUDA EP runs them on its
+own copy streams, i.e. do_copy_in_default_stream is 0.
+*/
+class ActivationOffload : public GraphTransformer {
+ public:
+  ActivationOffload(int64_t min_bytes, int prefetch_distance) noexcept
+      : GraphTransformer("ActivationOffload"), min_bytes_(min_bytes), prefetch_distance_(prefetch_distance) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  const int64_t min_bytes_;
+  const int prefetch_distance_;
+};
+
+/**
+@Class BudgetedRecompute
+
+Fits the activations the backward pass stashes into a memory budget, for training on devices sized for inference.
+Applied to a gradient graph, it sums the sizes of the forward outputs that have backward consumers and, while the
+sum is above budget_bytes, recomputes the largest of them whose producer is a cheap elementwise op and whose inputs
+stay stashed for the backward pass anyway, so that a recompute frees its output without extending the lifetime of
+anything else. An activation whose producer reads a recomputed one is not recomputed itself, and the inputs of a
+recompute are not recomputed later on.
+
+The recompute nodes are held back with a control edge from the backward node right before their first consumer, so
+that their outputs are only allocated when needed. The buffers freed this way are reused by the allocation planner as
+for any other tensor. Activations of unknown size are left stashed and aren't counted, and the budget may still be
+exceeded when no further activation can be recomputed, which is logged.
+*/
+class BudgetedRecompute : public GraphTransformer {
+ public:
+  explicit BudgetedRecompute(int64_t budget_bytes) noexcept
+      : GraphTransformer("BudgetedRecompute"), budget_bytes_(budget_bytes) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  const int64_t budget_bytes_;
+};
+
+}  // namespace onnxruntime
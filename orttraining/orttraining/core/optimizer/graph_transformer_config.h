@@ -22,6 +22,17 @@ struct TrainingGraphTransformerConfiguration : public GraphTransformerConfigurat
   // Number of layers to apply recompute
   int number_recompute_layers{0};
   bool allow_layer_norm_mod_precision{false};
+
+  // Offload the activations stashed for the backward pass to host memory, or recompute the cheap ones, after the
+  // gradient graph is built. See ActivationOffload.
+  bool activation_offload{false};
+  // Smallest activation to offload or recompute, in bytes
+  int64_t activation_offload_min_bytes{1 << 20};
+  // Number of backward nodes before its first consumer at which an offloaded activation is copied back
+  int activation_offload_prefetch_distance{8};
+  // Recompute the cheap stashed activations until they fit this many bytes after the gradient graph is built, or -1
+  // to disable. See BudgetedRecompute.
+  int64_t recompute_memory_budget{-1};
 };
 
 }  // namespace training
@@ -192,6 +192,9 @@ class TrainingSession : public InferenceSession {
       AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
       // Whether to enable gradient clipping.
       bool enable_grad_norm_clip{true};
+      // The size in bytes of the gradient buckets all-reduced with NCCL while the backward pass runs.
+      // 0 all-reduces all the gradients after the backward pass.
+      int64_t allreduce_bucket_size{0};
     };
     // The optimizer configuration.
     // If not provided, no optimizer is added.
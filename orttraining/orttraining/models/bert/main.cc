@@ -150,6 +150,8 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       ("use_fp16_initializer", "FP16 weights will be created. Otherwise, cast nodes will be inserted for converting weights from FP32 to FP16",
         cxxopts::value<bool>()->default_value("true"))
       ("use_nccl", "Whether to use NCCL for distributed training.", cxxopts::value<bool>()->default_value("false"))
+      ("allreduce_bucket_size", "Size in bytes of the gradient buckets all-reduced with NCCL while the backward pass "
+        "runs. 0 all-reduces all the gradients after the backward pass.", cxxopts::value<int64_t>()->default_value("0"))
       ("use_profiler", "Collect runtime profile data during this training run.", cxxopts::value<bool>()->default_value("false"))
       ("use_gist", "Whether to use GIST encoding/decoding.")
       ("gist_op", "Opearator type(s) to which GIST is applied.", cxxopts::value<int>()->default_value("0"))
@@ -289,6 +291,7 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
     params.max_num_checkpoints = flags["max_num_checkpoints"].as<size_t>();
 
     params.use_nccl = flags["use_nccl"].as<bool>();
+    params.allreduce_bucket_size = flags["allreduce_bucket_size"].as<int64_t>();
     params.enable_adasum = flags["enable_adasum"].as<bool>();
     params.use_profiler = flags.count("use_profiler") > 0;
     ort_params.max_num_profiling_events = flags["max_profile_records"].as<size_t>();
@@ -148,6 +148,7 @@ Status TrainingRunner::Initialize() {
     opt.deepspeed_zero = params_.deepspeed_zero;
     opt.adasum_reduction_type = params_.GetAdasumReductionType();
     opt.enable_grad_norm_clip = params_.enable_grad_norm_clip;
+    opt.allreduce_bucket_size = params_.allreduce_bucket_size;
     config.optimizer_config = opt;
   }
 
@@ -902,6 +903,8 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
           }
 
           if (should_remove_old_checkpoint) {
+            // the old checkpoint may be the one still being written
+            ORT_RETURN_IF_ERROR(checkpoint_writer_.Wait());
             const auto status = Env::Default().DeleteFolder(old_checkpoint_path);
             LOGS_DEFAULT_IF(!status.IsOK(), WARNING)
                 << "Failed to delete old checkpoint. "
@@ -923,6 +926,11 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
 
     ++epoch;
   }
+
+  if (enable_checkpoint_saving) {
+    ORT_RETURN_IF_ERROR(checkpoint_writer_.Wait());
+  }
+
   auto all_steps_time_end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<double> all_steps_duration_seconds = all_steps_time_end - all_steps_time_start;
 
@@ -1213,9 +1221,9 @@ Status TrainingRunner::SaveCheckpoint(const PathString& checkpoint_path) {
   std::unordered_map<std::string, std::string> checkpointed_properties{};
   ORT_RETURN_IF_ERROR(SaveCheckpointProperties(checkpointed_properties));
 
-  ORT_RETURN_IF_ERROR(SaveModelCheckpoint(
+  ORT_RETURN_IF_ERROR(checkpoint_writer_.Save(
       checkpoint_path, session_.GetDataTransferManager(),
-      checkpointed_tensors, checkpointed_properties));
+      checkpointed_tensors, checkpointed_properties, input_allocator_));
 
   return Status::OK();
 }
@@ -10,6 +10,7 @@
 #include "core/framework/ort_value.h"
 #include "core/providers/providers.h"
 #include "orttraining/core/framework/checkpoint_registry.h"
+#include "orttraining/core/framework/checkpointing.h"
 #include "orttraining/core/framework/communication/mpi/mpi_context.h"
 #include "orttraining/core/framework/pipeline.h"
 #include "orttraining/core/graph/optimizer_config.h"
@@ -191,6 +192,8 @@ class TrainingRunner {
     VectorString pipeline_stage_paths;
     // Enable gradient clipping.
     bool enable_grad_norm_clip = true;
+    // Size in bytes of the gradient buckets all-reduced during the backward pass, 0 to all-reduce after it.
+    int64_t allreduce_bucket_size = 0;
 
     // Enable GELU approximation
     bool enable_gelu_approximation = false;
@@ -275,6 +278,8 @@ class TrainingRunner {
   AllocatorPtr input_allocator_;
 
   std::unique_ptr<CheckpointRegistry> checkpoint_registry_;
+  // Writes the checkpoints in the background, so that the training loop only waits for the copy to host memory.
+  AsyncCheckpointWriter checkpoint_writer_;
 
   // Pipeline fields are valid only if params_.pipeline_parallel_size > 1.
   // Information for running pipeline.
@@ -19,6 +19,11 @@
 #include "orttraining/core/framework/communication/mpi/mpi_context.h"
 #include "orttraining/core/framework/gradient_graph_builder.h"
 #include "orttraining/core/framework/ortmodule_graph_builder.h"
+#include "orttraining/core/framework/distributed_run_context.h"
+#include "orttraining/core/optimizer/megatron_transformer.h"
+#include "orttraining/core/optimizer/activation_offload.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "orttraining/core/graph/gradient_definition_registry.h"
 #include "python/onnxruntime_pybind_mlvalue.h"
 
@@ -556,8 +561,55 @@ for every transfered tensor.
   m.def("get_mpi_context_local_size", []() -> int { return MPIContext::GetInstance().GetLocalSize(); });
   m.def("get_mpi_context_world_rank", []() -> int { return MPIContext::GetInstance().GetWorldRank(); });
   m.def("get_mpi_context_world_size", []() -> int { return MPIContext::GetInstance().GetWorldSize(); });
+  m.def(
+      "init_tensor_parallel_context",
+      [](int tensor_parallel_size) -> void {
+        auto& mpi_context = MPIContext::GetInstance();
+        ORT_ENFORCE(tensor_parallel_size > 0 && mpi_context.GetWorldSize() % tensor_parallel_size == 0,
+                    "The world size ", mpi_context.GetWorldSize(),
+                    " must be a multiple of the tensor parallel size ", tensor_parallel_size);
+        DistributedRunContext::CreateInstance({mpi_context.GetWorldRank(), mpi_context.GetWorldSize(),
+                                               mpi_context.GetLocalRank(), mpi_context.GetLocalSize(),
+                                               mpi_context.GetWorldSize() / tensor_parallel_size,
+                                               tensor_parallel_size});
+      },
+      "Groups the ranks of the MPI job in tensor parallel groups of consecutive ranks, the NCCL collectives of "
+      "tensor parallel models run within them. Must be called before the sessions of the models are created.");
 #endif
 
+  m.def(
+      "partition_model_for_tensor_parallel",
+      [](const py::bytes& serialized_model, int rank, int size) -> py::bytes {
+        auto logger_ptr = std::make_unique<logging::Logger>(logging::LoggingManager::DefaultLogger());
+        ONNX_NAMESPACE::ModelProto model_proto;
+        std::istringstream model_istream(serialized_model);
+        ORT_THROW_IF_ERROR(Model::Load(model_istream, &model_proto));
+        std::shared_ptr<Model> model;
+        ORT_THROW_IF_ERROR(Model::Load(model_proto, model, nullptr, *logger_ptr));
+
+        // An inference model has no trained weights and no optimizer state to partition along with the weights.
+        std::unordered_map<std::string, std::string> updated_weight_names;
+        std::unordered_set<std::string> weights_to_train;
+        std::unordered_map<std::string, TrainingSession::PartitionInfo> weight_partition_info;
+        TrainingSession::OptimizerState initial_optimizer_states;
+        CPUExecutionProvider cpu_execution_provider{CPUExecutionProviderInfo()};
+
+        GraphTransformerManager graph_transformation_mgr{1};
+        ORT_THROW_IF_ERROR(graph_transformation_mgr.Register(
+            std::make_unique<MegatronTransformer>(rank, size, updated_weight_names, weights_to_train,
+                                                  weight_partition_info, initial_optimizer_states,
+                                                  cpu_execution_provider),
+            TransformerLevel::Level1));
+        ORT_THROW_IF_ERROR(graph_transformation_mgr.ApplyTransformers(model->MainGraph(), TransformerLevel::Level1,
+                                                                      *logger_ptr));
+
+        std::string partitioned_model;
+        ORT_ENFORCE(model->ToProto().SerializeToString(&partitioned_model), "Failed to serialize the model.");
+        return py::bytes(partitioned_model);
+      },
+      "Partitions the MLP and self-attention blocks of a transformer model column- and row-wise across the ranks of "
+      "a tensor parallel group, as Megatron-LM does, and returns the model of the given rank in the group.");
+
   m.def("register_aten_op_executor",
         [](const std::string& is_tensor_argument_address_str, const std::string& aten_op_executor_address_str) -> void {
           size_t is_tensor_argument_address_int, aten_op_executor_address_int;
@@ -788,6 +840,11 @@ for every transfered tensor.
       .def_readwrite("transformer_layer_recompute", &TrainingGraphTransformerConfiguration::transformer_layer_recompute)
       .def_readwrite("number_recompute_layers", &TrainingGraphTransformerConfiguration::number_recompute_layers)
       .def_readwrite("allow_layer_norm_mod_precision", &TrainingGraphTransformerConfiguration::allow_layer_norm_mod_precision)
+      .def_readwrite("activation_offload", &TrainingGraphTransformerConfiguration::activation_offload)
+      .def_readwrite("activation_offload_min_bytes", &TrainingGraphTransformerConfiguration::activation_offload_min_bytes)
+      .def_readwrite("activation_offload_prefetch_distance",
+                     &TrainingGraphTransformerConfiguration::activation_offload_prefetch_distance)
+      .def_readwrite("recompute_memory_budget", &TrainingGraphTransformerConfiguration::recompute_memory_budget)
       .def_readwrite("propagate_cast_ops_config", &TrainingGraphTransformerConfiguration::GraphTransformerConfiguration::propagate_cast_ops_config);
 
   py::class_<OrtModuleGraphBuilderConfiguration> module_graph_builder_config(
@@ -891,6 +948,16 @@ for every transfered tensor.
       .def("build", [](PyGradientGraphBuilder* gradient_graph_builder) {
         ORT_THROW_IF_ERROR(gradient_graph_builder->builder->Build());
       })
+      .def("build", [](PyGradientGraphBuilder* gradient_graph_builder, int64_t memory_budget) {
+        // Recompute the cheap activations the backward pass stashes until they fit memory_budget bytes.
+        ORT_THROW_IF_ERROR(gradient_graph_builder->builder->Build());
+        GraphTransformerManager graph_transformation_mgr{1};
+        ORT_THROW_IF_ERROR(graph_transformation_mgr.Register(std::make_unique<BudgetedRecompute>(memory_budget),
+                                                             TransformerLevel::Level1));
+        ORT_THROW_IF_ERROR(graph_transformation_mgr.ApplyTransformers(gradient_graph_builder->model->MainGraph(),
+                                                                      TransformerLevel::Level1,
+                                                                      *gradient_graph_builder->logger));
+      })
       .def("save", [](PyGradientGraphBuilder* gradient_graph_builder, const std::string& path) {
         ORT_THROW_IF_ERROR(Model::Save(*(gradient_graph_builder->model), path));
       })
@@ -1 +1,2 @@
 from .gradient_graph._gradient_graph_tools import export_gradient_graph
+from .tensor_parallel._tensor_parallel_session import TensorParallelInferenceSession
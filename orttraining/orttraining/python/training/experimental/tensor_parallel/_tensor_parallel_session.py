@@ -0,0 +1,65 @@
+from pathlib import Path
+from typing import Optional, Union
+
+import onnxruntime
+from onnxruntime.capi import _pybind_state as C
+
+
+class TensorParallelInferenceSession:
+    r"""
+    Serves a transformer model too large for one GPU across the GPUs of an MPI job, with its MLP and self-attention
+    blocks partitioned column- and row-wise as Megatron-LM does.
+
+    Every rank of the job creates the session with the same model and calls `run` with the same inputs: each rank
+    computes with its partition of the weights on the GPU of its local rank, and the NCCL all-reduces of the
+    partitioned blocks combine the partial results, so every rank returns the same outputs. With a tensor parallel
+    size smaller than the world size, consecutive ranks form the tensor parallel groups and each group serves its own
+    requests.
+
+    Example, launched with `mpirun -n 4 python serve.py`::
+
+        session = TensorParallelInferenceSession("gpt2.onnx")
+        outputs = session.run(None, {"input_ids": input_ids})
+
+    Args:
+        model (Union[Path, str, bytes]): Path to the model, or the serialized model.
+
+        sess_options (onnxruntime.SessionOptions): Options of the session of each rank.
+
+        tensor_parallel_size (int): Number of ranks a model is partitioned across. Defaults to the world size.
+    """
+
+    def __init__(
+        self,
+        model: Union[Path, str, bytes],
+        sess_options: Optional[onnxruntime.SessionOptions] = None,
+        tensor_parallel_size: Optional[int] = None,
+    ):
+        world_rank = C.get_mpi_context_world_rank()
+        world_size = C.get_mpi_context_world_size()
+        self.tensor_parallel_size = tensor_parallel_size or world_size
+        self.tensor_parallel_rank = world_rank % self.tensor_parallel_size
+        C.init_tensor_parallel_context(self.tensor_parallel_size)
+
+        if not isinstance(model, bytes):
+            with open(model, "rb") as f:
+                model = f.read()
+        partitioned_model = C.partition_model_for_tensor_parallel(
+            model, self.tensor_parallel_rank, self.tensor_parallel_size
+        )
+
+        providers = [
+            ("CUDAExecutionProvider", {"device_id": C.get_mpi_context_local_rank()}),
+            "CPUExecutionProvider",
+        ]
+        self._session = onnxruntime.InferenceSession(partitioned_model, sess_options, providers=providers)
+
+    def get_inputs(self):
+        return self._session.get_inputs()
+
+    def get_outputs(self):
+        return self._session.get_outputs()
+
+    def run(self, output_names, input_feed, run_options=None):
+        """See `onnxruntime.InferenceSession.run`. All the ranks of a tensor parallel group must call it together."""
+        return self._session.run(output_names, input_feed, run_options)
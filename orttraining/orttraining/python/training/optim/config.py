@@ -216,6 +216,11 @@ class LambConfig(_OptimizerConfig):
 
     NOTE: To prevent model parameters to be trained, refer to :py:attr:`.ORTTrainerOptions.utils.frozen_weights`.
 
+    NOTE: With ratio_min = ratio_max = 1.0 the trust ratio is disabled and the update is the one of
+    :py:class:`.AdamConfig` with weight_decay_mode 0. As Lamb updates all the parameters with a single node, on CUDA
+    this runs the whole optimizer step, including the gradient clipping and the mixed precision weight update, in a
+    few multi-tensor kernel launches, which is faster than Adam for models with many parameter tensors.
+
     Example:
 
     .. code-block:: python
@@ -0,0 +1,88 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+# --------------------------------------------------------------------------
+# _exported_model_cache.py
+
+import hashlib
+import inspect
+import os
+import tempfile
+
+import onnx
+import onnxruntime
+import torch
+
+
+def _module_code_hash(module):
+    """Hashes the source code of the classes of a module and its submodules, and the names, types and shapes of its
+    parameters and buffers.
+
+    Only the source of the module classes is hashed: a change in a function called from a forward() that lives
+    outside of them is not detected, in which case the cache directory has to be cleared.
+    """
+
+    h = hashlib.sha256()
+    classes = {type(m) for m in module.modules()}
+    for cls in sorted(classes, key=lambda c: f"{c.__module__}.{c.__qualname__}"):
+        h.update(f"{cls.__module__}.{cls.__qualname__}".encode())
+        try:
+            h.update(inspect.getsource(cls).encode())
+        except (OSError, TypeError):
+            # No source available, e.g. for a class defined in an interactive session, so only its name is hashed.
+            pass
+    for name, param in module.named_parameters():
+        h.update(f"{name}:{param.dtype}:{tuple(param.shape)}:{param.requires_grad}".encode())
+    for name, buffer in module.named_buffers():
+        h.update(f"{name}:{buffer.dtype}:{tuple(buffer.shape)}".encode())
+    return h.hexdigest()
+
+
+class ExportedModelCache(object):
+    """On-disk cache of the models ORTModule exports, so that a restarted job or a new ORTModule instance of the same
+    model skips torch.onnx.export and the symbolic shape inference of the exported model.
+
+    An entry is keyed by the code of the module, the input schema, the export settings and the ORT and PyTorch
+    versions. The exported models have no initializers (export_params=False), so the entries stay small whatever the
+    size of the model.
+    """
+
+    def __init__(self, cache_dir):
+        self._cache_dir = cache_dir
+        os.makedirs(cache_dir, exist_ok=True)
+
+    def key(self, module, input_schema, export_settings):
+        h = hashlib.sha256()
+        h.update(_module_code_hash(module).encode())
+        h.update(repr(input_schema).encode())
+        h.update(repr(sorted(export_settings.items())).encode())
+        h.update(onnxruntime.__version__.encode())
+        h.update(torch.__version__.encode())
+        return h.hexdigest()
+
+    def _path(self, key):
+        return os.path.join(self._cache_dir, f"{key}.onnx")
+
+    def load(self, key):
+        """Returns the cached model of a key, or None if there is none."""
+
+        path = self._path(key)
+        if not os.path.isfile(path):
+            return None
+        try:
+            return onnx.load(path)
+        except Exception:
+            # A corrupted entry is exported again and overwritten.
+            return None
+
+    def save(self, key, model):
+        # Written to a temporary file first, so that concurrent processes never load a partially written entry.
+        fd, tmp_path = tempfile.mkstemp(dir=self._cache_dir, suffix=".tmp")
+        try:
+            with os.fdopen(fd, "wb") as f:
+                f.write(model.SerializeToString())
+            os.replace(tmp_path, self._path(key))
+        except OSError:
+            if os.path.exists(tmp_path):
+                os.remove(tmp_path)
+            raise
@@ -4,7 +4,7 @@
 # --------------------------------------------------------------------------
 
 from .debug_options import DebugOptions, LogLevel
-from . import _utils, _io, _logger, _onnx_models, _are_deterministic_algorithms_enabled
+from . import _utils, _io, _logger, _onnx_models, _exported_model_cache, _are_deterministic_algorithms_enabled
 from .torch_cpp_extensions.cpu.aten_op_executor import load_aten_op_executor_cpp_extension
 from ._custom_autograd_function import custom_autograd_function_enabler
 from ._custom_autograd_function_exporter import _post_process_after_export
@@ -128,6 +128,9 @@ class GraphExecutionManager(GraphExecutionInterface):
         self._propagate_cast_ops_allow = []
         # Whether allow fusion of layer norm subgraph if doing so will cause modified precision.
         self._allow_layer_norm_mod_precision = False
+        # Whether to offload the activations stashed for the backward pass to host memory, or recompute the cheap ones,
+        # to reduce the GPU memory used by training. Only applies to CUDA devices.
+        self._activation_offload = ortmodule._defined_from_envvar("ORTMODULE_ACTIVATION_OFFLOAD", 0, warn=True) == 1
 
         # Value can be either torch.onnx.TrainingMode.TRAINING or torch.onnx.TrainingMode.EVAL
         # To be instantiated in the concrete implementation of GraphExecutionManager
@@ -146,6 +149,11 @@ class GraphExecutionManager(GraphExecutionInterface):
         # flag to enable symbolic shape inference for dynamic shape inputs to improve performance
         self._run_symbolic_shape_infer = True
 
+        # On-disk cache of the exported models, shared by the ORTModule instances and the runs of a job that point
+        # ORTMODULE_CACHE_DIR to the same directory. Disabled by default.
+        cache_dir = os.getenv("ORTMODULE_CACHE_DIR")
+        self._exported_model_cache = _exported_model_cache.ExportedModelCache(cache_dir) if cache_dir else None
+
         # PyTorch custom Autograd function support
         self._enable_custom_autograd_function = custom_autograd_function_enabler.state
 
@@ -295,6 +303,9 @@ class GraphExecutionManager(GraphExecutionInterface):
                 provider_option_map["cudnn_conv_algo_search"] = "HEURISTIC"
                 provider_option_map["cudnn_conv_use_max_workspace"] = "1"
                 provider_option_map["cudnn_conv1d_pad_to_nc1d"] = "1"
+                if self._activation_offload:
+                    # the offload and prefetch copies overlap the compute only on the copy streams
+                    provider_option_map["do_copy_in_default_stream"] = "0"
             if self._use_external_gpu_allocator:
                 provider_option_map["gpu_external_alloc"] = str(self._torch_alloc)
                 provider_option_map["gpu_external_free"] = str(self._torch_free)
@@ -354,7 +365,21 @@ class GraphExecutionManager(GraphExecutionInterface):
             return False
 
         self._set_device_from_module(inputs, kwargs)
-        self._onnx_models.exported_model = self._get_exported_model(schema, *inputs, **kwargs)
+
+        cache_key = None
+        cached_model = None
+        # PythonOp nodes refer to the autograd functions registered while exporting in this process, so models with
+        # custom autograd functions aren't cached.
+        if self._exported_model_cache is not None and not self._enable_custom_autograd_function:
+            cache_key = self._exported_model_cache.key(self._original_module, schema, self._get_export_settings())
+            cached_model = self._exported_model_cache.load(cache_key)
+
+        if cached_model is not None:
+            # The cached model already went through the symbolic shape inference
+            self._parse_inputs_and_outputs_for_export(schema, inputs, kwargs)
+            self._onnx_models.exported_model = cached_model
+        else:
+            self._onnx_models.exported_model = self._get_exported_model(schema, *inputs, **kwargs)
         if self._debug_options.save_onnx_models.save:
             self._onnx_models.save_exported_model(
                 self._debug_options.save_onnx_models.path,
@@ -362,21 +387,31 @@ class GraphExecutionManager(GraphExecutionInterface):
                 self._export_mode,
             )
 
-        if self._run_symbolic_shape_infer:
-            self._onnx_models.exported_model = SymbolicShapeInference.infer_shapes(
-                self._onnx_models.exported_model, auto_merge=True, guess_output_rank=True
-            )
+        if cached_model is None:
+            if self._run_symbolic_shape_infer:
+                self._onnx_models.exported_model = SymbolicShapeInference.infer_shapes(
+                    self._onnx_models.exported_model, auto_merge=True, guess_output_rank=True
+                )
+            if cache_key is not None:
+                self._exported_model_cache.save(cache_key, self._onnx_models.exported_model)
 
         # Restore the recorded random states
         _utils.set_random_states(random_states)
 
         return True
 
-    def _get_exported_model(self, input_schema, *inputs, **kwargs):
-        """Exports PyTorch `self._flattened_module` to ONNX for inferencing or training, using `*inputs` and `**kwargs` as input
+    def _get_export_settings(self):
+        """Settings other than the model and its inputs that the exported model depends on"""
 
-        TODO: How to support dynamic axes? Dimensions are determined by samples
-        """
+        return {
+            "opset_version": ortmodule.ONNX_OPSET_VERSION,
+            "training": str(self._export_mode),
+            "extra_kwargs": repr(sorted(self._export_extra_kwargs.items())),
+            "run_symbolic_shape_infer": self._run_symbolic_shape_infer,
+        }
+
+    def _parse_inputs_and_outputs_for_export(self, input_schema, inputs, kwargs):
+        """Sets up self._input_info and self._module_output_schema and returns the output names of the model"""
 
         # Setup dynamic axes for onnx model
         self._input_info = _io.parse_inputs_for_onnx_export(self._module_parameters, None, input_schema, inputs, kwargs)
@@ -389,6 +424,15 @@ class GraphExecutionManager(GraphExecutionInterface):
 
         # FlattenedModule needs _InputInfo to expand user input from *args to *args + **kwargs
         self._flattened_module._input_info = self._input_info
+        return output_names
+
+    def _get_exported_model(self, input_schema, *inputs, **kwargs):
+        """Exports PyTorch `self._flattened_module` to ONNX for inferencing or training, using `*inputs` and `**kwargs` as input
+
+        TODO: How to support dynamic axes? Dimensions are determined by samples
+        """
+
+        output_names = self._parse_inputs_and_outputs_for_export(input_schema, inputs, kwargs)
 
         # Export torch.nn.Module to ONNX
         f = io.BytesIO()
@@ -464,6 +508,9 @@ class GraphExecutionManager(GraphExecutionInterface):
         graph_transformer_config.propagate_cast_ops_config.allow = self._propagate_cast_ops_allow
         graph_transformer_config.propagate_cast_ops_config.strategy = self._propagate_cast_ops_strategy
         graph_transformer_config.allow_layer_norm_mod_precision = self._allow_layer_norm_mod_precision
+        graph_transformer_config.activation_offload = (
+            self._activation_offload and self._device is not None and self._device.type == "cuda"
+        )
         return graph_transformer_config
 
     def _initialize_graph_builder(self, training):
@@ -137,7 +137,7 @@ class ORTTrainerOptions(object):
                                 'stage': {
                                     'type': 'integer',
                                     'min': 0,
-                                    'max': 1,
+                                    'max': 2,
                                     'default': 0
                                 },
                             }
@@ -352,7 +352,8 @@ class ORTTrainerOptions(object):
         distributed.deepspeed_zero_optimization:
             DeepSpeed ZeRO options.
         distributed.deepspeed_zero_optimization.stage (int, default is 0):
-            select which stage of DeepSpeed ZeRO to use. Stage 0 means disabled.
+            select which stage of DeepSpeed ZeRO to use. Stage 0 means disabled, stage 1 partitions the optimizer
+            states and stage 2 also partitions the gradient accumulation buffers.
         distributed.enable_adasum (bool, default is False):
             enable `Adasum <https://arxiv.org/abs/2006.02924>`_
             algorithm for AllReduce
@@ -112,5 +112,43 @@ TEST(Pipeline, ScheduleB5S3) {
   TestPipelineScheduler(num_batches, num_stages, baseline_events);
 }
 
+TEST(Pipeline, InterleavedScheduleB8D4) {
+  using onnxruntime::training::pipeline::InterleavedPipelineScheduler;
+  using onnxruntime::training::pipeline::PipelineTask;
+  const int num_batches = 8;
+  const int num_devices = 4;
+
+  // Without interleaving this is 1F1B: 8 micro-batches of 3 units plus the 3 idle forward and backward computes.
+  InterleavedPipelineScheduler schedule_v1(num_batches, num_devices, 1);
+  EXPECT_EQ(schedule_v1.GetMakespan(), 33);
+  InterleavedPipelineScheduler schedule_v2(num_batches, num_devices, 2);
+  EXPECT_EQ(schedule_v2.GetMakespan(), 57);
+  InterleavedPipelineScheduler schedule_v4(num_batches, num_devices, 4);
+  EXPECT_EQ(schedule_v4.GetMakespan(), 105);
+
+  EXPECT_NEAR(schedule_v1.GetBubbleFraction(), 9.0 / 33.0, 1e-9);
+  EXPECT_LT(schedule_v2.GetBubbleFraction(), schedule_v1.GetBubbleFraction());
+  EXPECT_LT(schedule_v4.GetBubbleFraction(), schedule_v2.GetBubbleFraction());
+
+  for (int d = 0; d < num_devices; ++d) {
+    const auto& tasks = schedule_v2.GetDeviceSchedule(d);
+    ASSERT_EQ(tasks.size(), static_cast<size_t>(2 * num_batches * 2));
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      EXPECT_EQ(tasks[i].virtual_stage % num_devices, d);
+      EXPECT_GE(tasks[i].start_time, 0);
+      if (i > 0) {
+        const int previous_cost = tasks[i - 1].pass == PipelineTask::Pass::Forward ? 1 : 2;
+        EXPECT_GE(tasks[i].start_time, tasks[i - 1].start_time + previous_cost);
+      }
+    }
+  }
+}
+
+TEST(Pipeline, InterleavedScheduleInvalidBatchCount) {
+  using onnxruntime::training::pipeline::InterleavedPipelineScheduler;
+  EXPECT_THROW(InterleavedPipelineScheduler(6, 4, 2), std::invalid_argument);
+  EXPECT_NO_THROW(InterleavedPipelineScheduler(6, 4, 1));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
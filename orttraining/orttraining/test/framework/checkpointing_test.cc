@@ -9,6 +9,7 @@
 #include "gtest/gtest.h"
 
 #include "core/common/common.h"
+#include "core/framework/allocator.h"
 #include "core/framework/data_transfer.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/tensor.h"
@@ -137,6 +138,48 @@ TEST(CheckpointingTest, SaveAndLoad) {
       model_path, name_to_ort_value, name_to_loaded_tensor_proto);
 }
 
+TEST(CheckpointingTest, AsyncSaveAndLoad) {
+  OrtValueTensorData tensor_data{{2, 2}, {1.0f, 2.0f, 3.0f, 4.0f}};
+  NameMLValMap name_to_ort_value{{"weight", tensor_data.GetOrtValue()}};
+  std::unordered_map<std::string, std::string> properties{{"step", "10"}};
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("checkpointing_test_dir")};
+  PathString first_checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("first_checkpoint"))};
+  PathString second_checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("second_checkpoint"))};
+  PathString model_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("test_model.onnx"))};
+
+  DataTransferManager data_transfer{};
+  ASSERT_STATUS_OK(data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>()));
+  auto host_allocator = std::make_shared<CPUAllocator>();
+
+  {
+    AsyncCheckpointWriter writer{};
+    ASSERT_STATUS_OK(writer.Save(
+        first_checkpoint_path, data_transfer, name_to_ort_value, properties, host_allocator));
+    ASSERT_STATUS_OK(writer.Save(
+        second_checkpoint_path, data_transfer, name_to_ort_value, properties, host_allocator));
+    // the checkpoint holds the tensor values at the time of Save()
+    tensor_data.GetOrtValue().GetMutable<Tensor>()->MutableData<float>()[0] = -1.0f;
+    ASSERT_STATUS_OK(writer.Wait());
+  }
+
+  for (const auto& checkpoint_path : {first_checkpoint_path, second_checkpoint_path}) {
+    std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
+    std::unordered_map<std::string, std::string> loaded_properties{};
+    ASSERT_STATUS_OK(LoadModelCheckpoint(
+        checkpoint_path, model_path, loaded_tensor_protos, loaded_properties));
+    ASSERT_EQ(loaded_properties, properties);
+    ASSERT_EQ(loaded_tensor_protos.size(), 1u);
+
+    OrtValueTensorData expected_data{{2, 2}, {1.0f, 2.0f, 3.0f, 4.0f}};
+    CompareOrtValuesToTensorProtoValues(
+        model_path, {{"weight", expected_data.GetOrtValue()}}, {{"weight", loaded_tensor_protos[0]}});
+  }
+}
+
 }  // namespace test
 }  // namespace training
 }  // namespace onnxruntime
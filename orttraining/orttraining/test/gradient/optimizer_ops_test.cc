@@ -1640,6 +1640,54 @@ TEST(OptimizerTest, LambOptimizerMultiTensorRatio) {
       lambdas, alphas, betas, epsilons, max_norms,
       step, loss_scale, &scaled_g_norm);
 }
+
+// With the trust ratio fixed at 1, the norm reduction is skipped and the update is AdamW's.
+TEST(OptimizerTest, LambOptimizerMultiTensorFixedRatio) {
+  constexpr int group_count = 127;
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<float> dist(0.1f, 1.0f);
+  std::uniform_int_distribution<int64_t> dist_int(1, 1228);
+
+  std::vector<std::vector<int64_t>> shapes(group_count);
+  std::vector<std::vector<float>> ws(group_count);
+  std::vector<std::vector<float>> gs(group_count);
+  std::vector<std::vector<float>> ms(group_count);
+  std::vector<std::vector<float>> vs(group_count);
+  std::vector<float> alphas(group_count);
+  std::vector<float> betas(group_count);
+  std::vector<float> lambdas(group_count);
+  std::vector<float> epsilons(group_count);
+  std::vector<float> max_norms(group_count);
+
+  const float eta = dist(random_engine);
+
+  for (int i = 0; i < group_count; ++i) {
+    const auto size = dist_int(random_engine);
+    shapes[i] = std::vector<int64_t>(1, size);
+    for (int64_t j = 0; j < size; ++j) {
+      ws[i].push_back(dist(random_engine));
+      gs[i].push_back(dist(random_engine));
+      ms[i].push_back(dist(random_engine));
+      vs[i].push_back(dist(random_engine));
+    }
+
+    alphas[i] = dist(random_engine);
+    betas[i] = dist(random_engine);
+    lambdas[i] = dist(random_engine);
+    epsilons[i] = dist(random_engine);
+    max_norms[i] = dist(random_engine);
+  }
+
+  constexpr int64_t step = 0;
+  constexpr float loss_scale = 1.f;
+  constexpr float scaled_g_norm = 2.f;
+
+  run_multi_tensor_lamb_test(
+      shapes, eta,
+      ws, gs, ms, vs,
+      lambdas, alphas, betas, epsilons, max_norms,
+      step, loss_scale, &scaled_g_norm, 1.0f, 1.0f);
+}
 #endif
 }  // namespace
 }  // namespace test
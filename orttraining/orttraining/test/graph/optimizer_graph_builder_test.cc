@@ -477,6 +477,35 @@ TEST_F(OptimizerGraphBuilderTest, Allreduce_WithGradientAccumulation_WithMixedPr
   TestAllreduceOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Allreduce_GradientBuckets) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  // each weight has a single float, so each gradient gets its own bucket
+  config.allreduce_bucket_size = 4;
+
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  AllreduceOptimizerGraphBuilder optimizer_graph_builder(
+      GetOptimizerBuilderRegistry(), config, GetOptInfoMap(), updated_weight_names_map, weight_partition_info);
+
+  OptimizerOutputKeyMap<std::string> opt_graph_outputs;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>> weight_to_opt_mapping;
+  ASSERT_STATUS_OK(optimizer_graph_builder.Build(graph_, weight_to_opt_mapping, opt_graph_outputs));
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_unscale_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_all_reduce_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, "NcclWaitCommunication"), 1);
+  ASSERT_EQ(GetOpCount(op_counts, k_adam_optimizer_op_name), k_weight_names.size());
+
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_all_reduce_op_name) {
+      ASSERT_EQ(node.GetAttributes().at("use_communication_stream").i(), 1);
+    }
+  }
+}
+
 static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
   std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
@@ -554,6 +583,25 @@ TEST_F(OptimizerGraphBuilderTest, ZeRO_WithGradientAccumulation_WithMixedPrecisi
   TestZeROOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, ZeRO_Stage2_WithGradientAccumulation) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.deepspeed_zero = ZeROConfig{2};
+  config.gradient_accumulation_steps = 10;
+  config.use_mixed_precision = false;
+  TestZeROOptimizerGraphBuilder(config, graph_);
+
+  // the reduce-scattered gradients are accumulated, not the full ones
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_inplace_accumulator_op_name) {
+      const Node* gradient_producer = graph_.GetProducerNode(node.InputDefs()[1]->Name());
+      ASSERT_NE(gradient_producer, nullptr);
+      ASSERT_EQ(gradient_producer->OpType(), k_reduce_scatter_op_name);
+    }
+  }
+}
+
 #endif  // ORT_USE_NCCL
 
 }  // namespace test
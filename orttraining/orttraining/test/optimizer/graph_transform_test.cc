@@ -18,6 +18,7 @@
 #include "orttraining/core/optimizer/concat_replacement.h"
 #include "orttraining/core/optimizer/batchnorm_replacement.h"
 #include "orttraining/core/optimizer/localized_recompute.h"
+#include "orttraining/core/optimizer/activation_offload.h"
 #include "test/optimizer/graph_transform_test_fixture.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/asserts.h"
@@ -562,6 +563,105 @@ TEST_F(GraphTransformationTests, BiasGeluRecomputeTest) {
   }
 }
 
+TEST_F(GraphTransformationTests, ActivationOffloadTest) {
+  Model model("ActivationOffload", true, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{"", 12}, {"com.microsoft", 1}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto arg = [&](const std::string& name) { return &graph.GetOrCreateNodeArg(name, &tensor_float); };
+
+  // forward: E = Sigmoid(X), A = MatMul(E, W), B = Relu(A), C = MatMul(B, W)
+  graph.AddNode("sigmoid", "Sigmoid", "", {arg("X")}, {arg("E")});
+  graph.AddNode("matmul_1", "MatMul", "", {arg("E"), arg("W")}, {arg("A")});
+  graph.AddNode("relu", "Relu", "", {arg("A")}, {arg("B")});
+  graph.AddNode("matmul_2", "MatMul", "", {arg("B"), arg("W")}, {arg("C")});
+
+  // backward: a chain of 8 nodes after C, then the consumers of B, A and E
+  std::string grad = "C";
+  for (int i = 0; i < 8; ++i) {
+    graph.AddNode("identity_" + std::to_string(i), "Identity", "Backward pass", {arg(grad)},
+                  {arg("G" + std::to_string(i))});
+    grad = "G" + std::to_string(i);
+  }
+  graph.AddNode("mul_b", "Mul", "Backward pass", {arg(grad), arg("B")}, {arg("dB")});
+  graph.AddNode("mul_a", "Mul", "Backward pass", {arg("dB"), arg("A")}, {arg("dA")});
+  graph.AddNode("mul_e", "Mul", "Backward pass", {arg("dA"), arg("E")}, {arg("dE")});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<ActivationOffload>(1, 4),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  // E is recomputed from the graph input, A is offloaded, and so is B as its input A no longer stays on the device
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Sigmoid"], 2);
+  ASSERT_EQ(op_to_count["MemcpyToHost"], 2);
+  ASSERT_EQ(op_to_count["MemcpyFromHost"], 2);
+  for (auto& node : graph.Nodes()) {
+    if (node.Description() == "Backward pass" && node.OpType() == "Mul") {
+      const Node* producer = graph.GetProducerNode(node.InputDefs()[1]->Name());
+      ASSERT_NE(producer, nullptr);
+      ASSERT_EQ(producer->OpType(), node.Name() == "mul_e" ? "Sigmoid" : "MemcpyFromHost");
+      // the recompute of E reads the graph input, the prefetches are also held back by a backward node
+      ASSERT_EQ(producer->GetInputEdgesCount(), node.Name() == "mul_e" ? 1u : 2u);
+    }
+  }
+}
+
+TEST_F(GraphTransformationTests, BudgetedRecomputeTest) {
+  Model model("BudgetedRecompute", true, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{"", 12}, {"com.microsoft", 1}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto arg = [&](const std::string& name) { return &graph.GetOrCreateNodeArg(name, &tensor_float); };
+
+  // forward: E = Sigmoid(X), A = MatMul(E, W), B = Relu(A), C = MatMul(B, W)
+  graph.AddNode("sigmoid", "Sigmoid", "", {arg("X")}, {arg("E")});
+  graph.AddNode("matmul_1", "MatMul", "", {arg("E"), arg("W")}, {arg("A")});
+  graph.AddNode("relu", "Relu", "", {arg("A")}, {arg("B")});
+  graph.AddNode("matmul_2", "MatMul", "", {arg("B"), arg("W")}, {arg("C")});
+
+  // backward: E, A and B of 64 bytes each are stashed
+  graph.AddNode("identity", "Identity", "Backward pass", {arg("C")}, {arg("G")});
+  graph.AddNode("mul_b", "Mul", "Backward pass", {arg("G"), arg("B")}, {arg("dB")});
+  graph.AddNode("mul_a", "Mul", "Backward pass", {arg("dB"), arg("A")}, {arg("dA")});
+  graph.AddNode("mul_e", "Mul", "Backward pass", {arg("dA"), arg("E")}, {arg("dE")});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<BudgetedRecompute>(64),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  // E is recomputed from the graph input and B from A, which stays stashed as the MatMul isn't recomputed
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Sigmoid"], 2);
+  ASSERT_EQ(op_to_count["Relu"], 2);
+  ASSERT_EQ(op_to_count["MatMul"], 2);
+  for (auto& node : graph.Nodes()) {
+    if (node.Description() == "Backward pass" && node.OpType() == "Mul") {
+      const Node* producer = graph.GetProducerNode(node.InputDefs()[1]->Name());
+      ASSERT_NE(producer, nullptr);
+      if (node.Name() == "mul_a") {
+        ASSERT_EQ(producer->Name(), "matmul_1");
+      } else {
+        const std::string recomputed_node = node.Name() == "mul_b" ? "relu" : "sigmoid";
+        ASSERT_EQ(producer->Description(), "Recompute of " + recomputed_node);
+        ASSERT_EQ(producer->Priority(), static_cast<int>(ExecutionPriority::LOCAL_LOW));
+      }
+    }
+  }
+}
+
 TEST_F(GraphTransformationTests, SoftmaxCrossEntropyLossInternalFusionWithoutCast) {
   Model model("SoftmaxCrossEntropyLossInternalFusion", true, ModelMetaData(), PathString(),
               IOnnxRuntimeOpSchemaRegistryList(), {{"", 12}, {"com.microsoft", 1}}, {}, *logger_);
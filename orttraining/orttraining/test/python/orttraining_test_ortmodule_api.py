@@ -5112,6 +5112,38 @@ def test_opset_version_change(opset_version):
     assert exported_model.opset_import[0].version == opset_version
 
 
+def test_exported_model_cache():
+    device = "cuda"
+    N, D_in, H, D_out = 64, 784, 500, 10
+    x = torch.randn(N, D_in, device=device)
+
+    with tempfile.TemporaryDirectory() as temporary_dir:
+        os.environ["ORTMODULE_CACHE_DIR"] = temporary_dir
+        try:
+            ort_model1 = ORTModule(NeuralNetSinglePositionalArgument(D_in, H, D_out).to(device))
+            ort_model1(x).sum().backward()
+            assert len(os.listdir(temporary_dir)) == 1
+
+            # A new instance of the same model finds the exported model in the cache
+            pt_model2 = NeuralNetSinglePositionalArgument(D_in, H, D_out).to(device)
+            ort_model2 = ORTModule(copy.deepcopy(pt_model2))
+            with patch("torch.onnx.export") as export:
+                ort_prediction = ort_model2(x)
+                export.assert_not_called()
+            ort_prediction.sum().backward()
+            pt_prediction = pt_model2(x)
+            pt_prediction.sum().backward()
+            _test_helpers.assert_values_are_close(pt_prediction, ort_prediction)
+            _test_helpers.assert_gradients_match_and_reset_gradient(ort_model2, pt_model2)
+
+            # The inference model is exported with other settings, so it has its own entry
+            ort_model2.eval()
+            ort_model2(x)
+            assert len(os.listdir(temporary_dir)) == 2
+        finally:
+            del os.environ["ORTMODULE_CACHE_DIR"]
+
+
 def test_serialize_ortmodule():
 
     device = "cuda"
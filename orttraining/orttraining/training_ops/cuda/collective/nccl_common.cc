@@ -100,6 +100,23 @@ NcclContext::NcclContext() {
 #else
   ORT_THROW("ORT must be built with MPI to use NCCL.");
 #endif
+
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&communication_stream_, cudaStreamNonBlocking));
+  CUDA_CALL_THROW(cudaEventCreateWithFlags(&compute_ready_event_, cudaEventDisableTiming));
+  CUDA_CALL_THROW(cudaEventCreateWithFlags(&communication_done_event_, cudaEventDisableTiming));
+}
+
+Status NcclContext::BeginCommunication(cudaStream_t compute_stream, cudaStream_t& communication_stream) {
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(compute_ready_event_, compute_stream));
+  CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(communication_stream_, compute_ready_event_, 0));
+  communication_stream = communication_stream_;
+  return Status::OK();
+}
+
+Status NcclContext::WaitForCommunication(cudaStream_t compute_stream) {
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(communication_done_event_, communication_stream_));
+  CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(compute_stream, communication_done_event_, 0));
+  return Status::OK();
 }
 
 ncclComm_t NcclContext::Comm(training::WorkerGroupType group_type) {
@@ -135,6 +152,18 @@ NcclContext::~NcclContext() {
     ncclCommDestroy(cross_node_comm_);
   }
 
+  if (communication_done_event_ != nullptr) {
+    cudaEventDestroy(communication_done_event_);
+  }
+
+  if (compute_ready_event_ != nullptr) {
+    cudaEventDestroy(compute_ready_event_);
+  }
+
+  if (communication_stream_ != nullptr) {
+    cudaStreamDestroy(communication_stream_);
+  }
+
 #ifdef USE_MPI
   int is_mpi_finalized = 0;
   MPI_Finalized(&is_mpi_finalized);
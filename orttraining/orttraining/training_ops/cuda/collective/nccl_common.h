@@ -31,6 +31,13 @@ class NcclContext final {
     return training::DistributedRunContext::GroupSize(group_type);
   }
 
+  // Makes the communication stream wait for the work queued so far on compute_stream and returns it, so collectives
+  // queued on it run concurrently with the work queued on compute_stream afterwards.
+  Status BeginCommunication(cudaStream_t compute_stream, cudaStream_t& communication_stream);
+
+  // Makes compute_stream wait for the collectives queued so far on the communication stream.
+  Status WaitForCommunication(cudaStream_t compute_stream);
+
  private:
   ncclComm_t global_group_comm_;
   ncclComm_t data_group_comm_;
@@ -38,6 +45,9 @@ class NcclContext final {
   ncclComm_t cross_node_comm_;
   ncclComm_t horizontal_group_comm_;
 
+  cudaStream_t communication_stream_ = nullptr;
+  cudaEvent_t compute_ready_event_ = nullptr;
+  cudaEvent_t communication_done_event_ = nullptr;
 };
 
 // -----------------------------------------------------------------------
@@ -7,6 +7,7 @@ namespace onnxruntime {
 namespace cuda {
 
 NcclAllReduce::NcclAllReduce(const OpKernelInfo& info) : NcclKernel(info) {
+  use_communication_stream_ = info.GetAttrOrDefault<int64_t>("use_communication_stream", 0) != 0;
 }
 
 Status NcclAllReduce::ComputeInternal(OpKernelContext* context) const {
@@ -30,12 +31,28 @@ Status NcclAllReduce::ComputeInternal(OpKernelContext* context) const {
   }
 
   ncclDataType_t dtype = GetNcclDataType(onnx_type);
+  cudaStream_t stream = Stream();
+  if (use_communication_stream_) {
+    ORT_RETURN_IF_ERROR(nccl_->BeginCommunication(Stream(), stream));
+  }
 #ifdef ORT_USE_NCCL
-  NCCL_RETURN_IF_ERROR(ncclAllReduce(input_data, output_data, input_count, dtype, ncclSum, comm, Stream()));
+  NCCL_RETURN_IF_ERROR(ncclAllReduce(input_data, output_data, input_count, dtype, ncclSum, comm, stream));
 #endif
   return Status::OK();
 }
 
+NcclWaitCommunication::NcclWaitCommunication(const OpKernelInfo& info) : NcclKernel(info) {
+}
+
+Status NcclWaitCommunication::ComputeInternal(OpKernelContext* context) const {
+  // the outputs alias the inputs
+  for (int i = 0; i < context->InputCount(); i++) {
+    context->Output(i, context->Input<Tensor>(i)->Shape());
+  }
+
+  return nccl_->WaitForCommunication(Stream());
+}
+
 NcclAllGather::NcclAllGather(const OpKernelInfo& info) : NcclKernel(info) {
 }
 
@@ -212,6 +229,39 @@ Status NcclReduceScatter::ComputeInternal(OpKernelContext* context) const {
   return Status::OK();
 }
 
+NcclAllToAll::NcclAllToAll(const OpKernelInfo& info) : NcclKernel(info) {
+}
+
+Status NcclAllToAll::ComputeInternal(OpKernelContext* context) const {
+  ncclComm_t comm = nccl_->Comm(group_type_);
+  const int size = nccl_->Size(group_type_);
+
+  const Tensor* input_tensor = context->Input<Tensor>(0);
+  const TensorShape& shape = input_tensor->Shape();
+  ORT_RETURN_IF_NOT(shape.NumDimensions() > 0 && shape[0] % size == 0,
+                    "The first dimension of the NcclAllToAll input must be a multiple of the group size ", size,
+                    ", got shape ", shape);
+  Tensor* output_tensor = context->Output(0, shape);
+
+  auto onnx_type = input_tensor->DataType();
+  ncclDataType_t dtype = GetNcclDataType(onnx_type);
+  const size_t chunk_count = static_cast<size_t>(shape.Size() / size);
+  const size_t chunk_bytes = chunk_count * onnx_type->Size();
+  const int8_t* input_data = reinterpret_cast<const int8_t*>(input_tensor->DataRaw());
+  int8_t* output_data = reinterpret_cast<int8_t*>(output_tensor->MutableDataRaw());
+
+#ifdef ORT_USE_NCCL
+  // The sends and receives of a group run concurrently, so the exchange doesn't deadlock whatever the rank order.
+  NCCL_RETURN_IF_ERROR(ncclGroupStart());
+  for (int r = 0; r < size; r++) {
+    NCCL_RETURN_IF_ERROR(ncclSend(input_data + r * chunk_bytes, chunk_count, dtype, r, comm, Stream()));
+    NCCL_RETURN_IF_ERROR(ncclRecv(output_data + r * chunk_bytes, chunk_count, dtype, r, comm, Stream()));
+  }
+  NCCL_RETURN_IF_ERROR(ncclGroupEnd());
+#endif
+  return Status::OK();
+}
+
 ONNX_OPERATOR_KERNEL_EX(
     NcclAllReduce,
     kMSDomain,
@@ -223,6 +273,16 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T", DataTypeImpl::AllIEEEFloatTensorTypes()),
     NcclAllReduce);
 
+ONNX_OPERATOR_KERNEL_EX(
+    NcclWaitCommunication,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .VariadicAlias(0, 0)  // outputs and inputs are mapped one to one
+        .TypeConstraint("T", DataTypeImpl::AllIEEEFloatTensorTypes()),
+    NcclWaitCommunication);
+
 ONNX_OPERATOR_KERNEL_EX(
     NcclAllGather,
     kMSDomain,
@@ -245,5 +305,14 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T", DataTypeImpl::AllIEEEFloatTensorTypes()),
     NcclReduceScatter);
 
+ONNX_OPERATOR_KERNEL_EX(
+    NcclAllToAll,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .TypeConstraint("T", DataTypeImpl::AllIEEEFloatTensorTypes()),
+    NcclAllToAll);
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -12,6 +12,16 @@ class NcclAllReduce final : public NcclKernel {
  public:
   explicit NcclAllReduce(const OpKernelInfo& info);
 
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  bool use_communication_stream_;
+};
+
+class NcclWaitCommunication final : public NcclKernel {
+ public:
+  explicit NcclWaitCommunication(const OpKernelInfo& info);
+
   Status ComputeInternal(OpKernelContext* context) const override;
 };
 
@@ -29,5 +39,12 @@ class NcclReduceScatter final : public NcclKernel {
   Status ComputeInternal(OpKernelContext* context) const override;
 };
 
+class NcclAllToAll final : public NcclKernel {
+ public:
+  explicit NcclAllToAll(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+};
+
 }  // namespace cuda
 }  // namespace onnxruntime
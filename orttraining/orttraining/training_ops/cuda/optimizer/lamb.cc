@@ -676,16 +676,21 @@ Status LambOptimizer<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP>::Compute
       alpha_, beta_, lambda_, epsilon_, max_norm_clip_,
       do_bias_correction_));
 
-  ORT_RETURN_IF_ERROR(launch_lamb_reduction(
-      *this,
-      group_count,
-      tensor_sizes,
-      p_w_norms,
-      p_d_norms,
-      p_ws,
-      p_ds,
-      reduction_buffer.get(),
-      reduction_buffer_size));
+  // With the trust ratio fixed at 1, the norms are not used: the update is the AdamW one (weight decay applied to the
+  // update direction), so the whole step takes the two multi-tensor launches above and below.
+  // launch_lamb_update uses a ratio of 1 when the norms are 0, which they are set to above.
+  if (ratio_min_ != 1.0f || ratio_max_ != 1.0f) {
+    ORT_RETURN_IF_ERROR(launch_lamb_reduction(
+        *this,
+        group_count,
+        tensor_sizes,
+        p_w_norms,
+        p_d_norms,
+        p_ws,
+        p_ds,
+        reduction_buffer.get(),
+        reduction_buffer_size));
+  }
 
   ORT_RETURN_IF_ERROR(launch_lamb_update(
       Stream(),
@@ -406,6 +406,7 @@ if enable_training:
             "onnxruntime.training.amp",
             "onnxruntime.training.experimental",
             "onnxruntime.training.experimental.gradient_graph",
+            "onnxruntime.training.experimental.tensor_parallel",
             "onnxruntime.training.optim",
             "onnxruntime.training.ortmodule",
             "onnxruntime.training.ortmodule.experimental",
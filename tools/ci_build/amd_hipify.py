@@ -76,6 +76,10 @@ contrib_ops_excluded_files = [
     "cuda_contrib_kernels.h",
     "inverse.cc",
     "fused_conv.cc",
+    "fused_elementwise.cc",
+    "fused_elementwise.h",
+    "fused_elementwise_compiler.cc",
+    "fused_elementwise_compiler.h",
 ]
 
 provider_excluded_files = [
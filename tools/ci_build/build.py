@@ -174,6 +174,7 @@ def parse_arguments():
     # Training options
     parser.add_argument("--enable_nvtx_profile", action="store_true", help="Enable NVTX profile in ORT.")
     parser.add_argument("--enable_memory_profile", action="store_true", help="Enable memory profile in ORT.")
+    parser.add_argument("--enable_strided_tensors", action="store_true", help="Enable strided tensor views in ORT.")
     parser.add_argument("--enable_training", action="store_true", help="Enable training in ORT.")
     parser.add_argument("--enable_training_ops", action="store_true", help="Enable training ops in inference graph.")
     parser.add_argument(
@@ -877,6 +878,7 @@ def generate_build_tree(
         "-DOnnxruntime_GCOV_COVERAGE=" + ("ON" if args.code_coverage else "OFF"),
         "-Donnxruntime_USE_MPI=" + ("ON" if args.use_mpi else "OFF"),
         "-Donnxruntime_ENABLE_MEMORY_PROFILE=" + ("ON" if args.enable_memory_profile else "OFF"),
+        "-Donnxruntime_ENABLE_STRIDED_TENSORS=" + ("ON" if args.enable_strided_tensors else "OFF"),
         "-Donnxruntime_ENABLE_CUDA_LINE_NUMBER_INFO=" + ("ON" if args.enable_cuda_line_info else "OFF"),
         "-Donnxruntime_BUILD_WEBASSEMBLY=" + ("ON" if args.build_wasm else "OFF"),
         "-Donnxruntime_BUILD_WEBASSEMBLY_STATIC_LIB=" + ("ON" if args.build_wasm_static_lib else "OFF"),
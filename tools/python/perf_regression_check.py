@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+"""
+Runs a set of models through onnxruntime_perf_test with profiling enabled, aggregates the time spent per op type and
+execution provider from the profiles, and compares it against a baseline from a previous run to flag regressions.
+
+The model set is a JSON file with a list of entries:
+    {"name": "bert_base", "model": "bert_base/model.onnx", "ep": "cpu", "args": ["-I", "-x", "4"]}
+where 'model' is relative to --models_dir, 'ep' is the perf_test -e value (default 'cpu') and 'args' are extra
+perf_test arguments. See perf_regression_models.json for the curated set.
+"""
+
+import argparse
+import glob
+import json
+import os
+import pathlib
+import subprocess
+import sys
+import tempfile
+from collections import defaultdict
+
+
+def run_perf_test(perf_test, model_path, ep, extra_args, repeats, profile_prefix):
+    cmd = [str(perf_test), "-e", ep, "-m", "times", "-r", str(repeats), "-p", profile_prefix, *extra_args, model_path]
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+
+    # the session appends a timestamp to the profile file prefix
+    profiles = sorted(glob.glob(profile_prefix + "*.json"), key=os.path.getmtime)
+    if not profiles:
+        raise RuntimeError(f"perf_test did not write a profile for {model_path}")
+    return profiles[-1]
+
+
+def aggregate_profile(profile_path):
+    """
+    Returns the average time per run in microseconds of each op type and execution provider, keyed by 'ep/op_type'.
+    """
+    with open(profile_path) as f:
+        events = json.load(f)
+
+    num_runs = sum(1 for e in events if e.get("cat") == "Session" and e.get("name") == "model_run")
+    totals = defaultdict(float)
+    for e in events:
+        if e.get("cat") != "Node" or not e.get("name", "").endswith("_kernel_time"):
+            continue
+        args = e.get("args", {})
+        totals[f"{args.get('provider', 'unknown')}/{args.get('op_name', 'unknown')}"] += e.get("dur", 0)
+
+    return {key: total / max(num_runs, 1) for key, total in totals.items()}
+
+
+def compare(results, baseline, threshold, min_time_us):
+    """
+    Returns (model, 'ep/op_type', baseline_us, current_us) for each op type whose time grew by more than threshold
+    (a fraction) over the baseline. Op types below min_time_us in both runs are ignored as timer noise dominates them.
+    Op types that appear in only one of the runs, e.g. after a change in fusion, are reported with 0 for the missing
+    side when they exceed min_time_us.
+    """
+    regressions = []
+    for model, ops in results.items():
+        baseline_ops = baseline.get(model)
+        if baseline_ops is None:
+            continue
+        for key, current_us in ops.items():
+            baseline_us = baseline_ops.get(key, 0.0)
+            if max(current_us, baseline_us) < min_time_us:
+                continue
+            if current_us > baseline_us * (1.0 + threshold):
+                regressions.append((model, key, baseline_us, current_us))
+    return regressions
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        os.path.basename(__file__),
+        description="Per op type performance regression check of a model set against a stored baseline.",
+    )
+    parser.add_argument("--perf_test", type=pathlib.Path, required=True, help="Path to onnxruntime_perf_test.")
+    parser.add_argument("--models_dir", type=pathlib.Path, required=True, help="Directory the models are relative to.")
+    parser.add_argument(
+        "--model_set",
+        type=pathlib.Path,
+        default=pathlib.Path(__file__).parent / "perf_regression_models.json",
+        help="JSON file listing the models to run.",
+    )
+    parser.add_argument("--repeats", type=int, default=100, help="Number of runs of each model.")
+    parser.add_argument("--output", type=pathlib.Path, required=True, help="File to write the per op times to.")
+    parser.add_argument("--baseline", type=pathlib.Path, help="Per op times of a previous run to compare against.")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.1,
+        help="Relative increase of the time of an op type over the baseline reported as a regression.",
+    )
+    parser.add_argument(
+        "--min_time_us",
+        type=float,
+        default=20.0,
+        help="Op types taking less than this per run in both the baseline and the current run are not compared.",
+    )
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    with open(args.model_set) as f:
+        model_set = json.load(f)
+
+    results = {}
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        for entry in model_set:
+            name = entry["name"]
+            model_path = args.models_dir / entry["model"]
+            if not model_path.is_file():
+                print(f"Skipping {name}: {model_path} not found")
+                continue
+
+            ep = entry.get("ep", "cpu")
+            print(f"Running {name} on {ep}")
+            profile = run_perf_test(
+                args.perf_test,
+                str(model_path),
+                ep,
+                entry.get("args", []),
+                args.repeats,
+                os.path.join(tmp_dir, name),
+            )
+            results[name] = aggregate_profile(profile)
+
+    with open(args.output, "w") as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.baseline is None:
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+
+    regressions = compare(results, baseline, args.threshold, args.min_time_us)
+    for model, key, baseline_us, current_us in regressions:
+        change = "new" if baseline_us == 0 else f"+{(current_us / baseline_us - 1.0) * 100:.1f}%"
+        print(f"REGRESSION {model} {key}: {baseline_us:.1f}us -> {current_us:.1f}us ({change})")
+
+    missing = [name for name in results if name not in baseline]
+    if missing:
+        print(f"No baseline for: {', '.join(missing)}")
+
+    print(f"{len(regressions)} regression(s) above {args.threshold * 100:.0f}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
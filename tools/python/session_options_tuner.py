@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+"""
+Searches the session options of a model for the best throughput or p99 latency at a given concurrency, measuring each
+candidate with onnxruntime_perf_test.
+
+The options tuned are the intra/inter-op thread counts, the execution mode, the memory pattern, the CPU memory arena,
+the graph optimization level and, optionally, a set of execution provider option strings. The search is a coordinate
+descent starting from the defaults: each option in turn is set to the best of its values with the others fixed, until
+a pass over all of them no longer improves the metric.
+
+The result is written in the ORT config format:
+    {"session_options": {"intra_op_num_threads": 4, ...}, "tuning": {...}}
+which the session applies when it is stored in the 'ort_config' metadata of the model (see --output_model) and the
+ORT_LOAD_CONFIG_FROM_MODEL environment variable is set to 1. The 'tuning' part records the EP, the EP options and the
+measured metric and is ignored by the session.
+"""
+
+import argparse
+import json
+import os
+import pathlib
+import subprocess
+import sys
+import tempfile
+
+# perf_test -o values, which match the graph_optimization_level of the ORT config
+OPTIMIZATION_LEVELS = [1, 2, 99]
+
+
+def thread_counts(max_threads):
+    counts = [0, 1]
+    n = 2
+    while n <= max_threads:
+        counts.append(n)
+        n *= 2
+    if counts[-1] != max_threads:
+        counts.append(max_threads)
+    return counts
+
+
+def perf_test_args(options):
+    args = ["-x", str(options["intra_op_num_threads"]), "-o", str(options["graph_optimization_level"])]
+    if options["execution_mode"] == 1:
+        args += ["-P", "-y", str(options["inter_op_num_threads"])]
+    if not options["enable_mem_pattern"]:
+        args.append("-M")
+    if not options["enable_cpu_mem_arena"]:
+        args.append("-A")
+    if options.get("ep_options"):
+        args += ["-i", options["ep_options"]]
+    return args
+
+
+class Tuner:
+    def __init__(self, args):
+        self.args = args
+        self.tmp_dir = tempfile.mkdtemp()
+        self.results = {}
+
+    def measure(self, options):
+        """Returns the metric of a candidate, lower is better, or None if perf_test failed with it."""
+        key = json.dumps(options, sort_keys=True)
+        if key in self.results:
+            return self.results[key]
+
+        result_file = os.path.join(self.tmp_dir, f"result_{len(self.results)}.json")
+        cmd = [
+            str(self.args.perf_test),
+            "-e",
+            self.args.ep,
+            "-m",
+            "duration",
+            "-t",
+            str(self.args.seconds),
+            "-c",
+            str(self.args.concurrency),
+            "-j",
+            result_file,
+            *perf_test_args(options),
+            *self.args.perf_test_args,
+            str(self.args.model),
+        ]
+        metric = None
+        try:
+            subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+            with open(result_file) as f:
+                result = json.load(f)
+            if self.args.metric == "throughput":
+                metric = -result["achieved_qps"]
+            else:
+                metric = result["latency_ms"]["p99"]
+        except (subprocess.CalledProcessError, OSError, KeyError, ValueError) as e:
+            print(f"  failed: {e}")
+
+        self.results[key] = metric
+        print(f"  {perf_test_args(options)}: {self.describe(metric)}")
+        return metric
+
+    def describe(self, metric):
+        if metric is None:
+            return "failed"
+        if self.args.metric == "throughput":
+            return f"{-metric:.2f} inferences/s"
+        return f"p99 {metric:.3f} ms"
+
+    def tune(self):
+        max_threads = self.args.max_threads or os.cpu_count() or 1
+        search_space = {
+            "intra_op_num_threads": thread_counts(max_threads),
+            "execution_mode": [0, 1],
+            "inter_op_num_threads": thread_counts(max_threads),
+            "enable_mem_pattern": [1, 0],
+            "enable_cpu_mem_arena": [1, 0],
+            "graph_optimization_level": OPTIMIZATION_LEVELS,
+        }
+        if self.args.ep_option_sets:
+            search_space["ep_options"] = self.args.ep_option_sets
+
+        best = {
+            "intra_op_num_threads": 0,
+            "execution_mode": 0,
+            "inter_op_num_threads": 0,
+            "enable_mem_pattern": 1,
+            "enable_cpu_mem_arena": 1,
+            "graph_optimization_level": 99,
+        }
+        if self.args.ep_option_sets:
+            best["ep_options"] = self.args.ep_option_sets[0]
+
+        best_metric = self.measure(best)
+        if best_metric is None:
+            raise RuntimeError("perf_test failed with the default session options")
+
+        for iteration in range(self.args.max_passes):
+            improved = False
+            for name, values in search_space.items():
+                # the inter-op thread count only matters in parallel mode
+                if name == "inter_op_num_threads" and best["execution_mode"] == 0:
+                    continue
+                print(f"Pass {iteration + 1}, tuning {name}")
+                for value in values:
+                    if value == best[name]:
+                        continue
+                    candidate = dict(best, **{name: value})
+                    metric = self.measure(candidate)
+                    if metric is not None and metric < best_metric:
+                        best, best_metric = candidate, metric
+                        improved = True
+            if not improved:
+                break
+
+        return best, best_metric
+
+
+def write_ort_config(options, metric, args):
+    session_options = {k: v for k, v in options.items() if k != "ep_options"}
+    if session_options["execution_mode"] == 0:
+        del session_options["inter_op_num_threads"]
+
+    config = {
+        "session_options": session_options,
+        "tuning": {
+            "ep": args.ep,
+            "ep_options": options.get("ep_options", ""),
+            "metric": args.metric,
+            "concurrency": args.concurrency,
+            "value": -metric if args.metric == "throughput" else metric,
+        },
+    }
+    with open(args.output, "w") as f:
+        json.dump(config, f, indent=2)
+    return config
+
+
+def embed_ort_config(model_path, output_model_path, config):
+    import onnx
+
+    model = onnx.load(str(model_path))
+    props = {p.key: p.value for p in model.metadata_props}
+    props["ort_config"] = json.dumps(config)
+    # replaces all the metadata of the model
+    onnx.helper.set_model_props(model, props)
+    onnx.save(model, str(output_model_path))
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        os.path.basename(__file__),
+        description="Tunes the session options of a model for throughput or p99 latency with onnxruntime_perf_test.",
+    )
+    parser.add_argument("--perf_test", type=pathlib.Path, required=True, help="Path to onnxruntime_perf_test.")
+    parser.add_argument(
+        "--model",
+        type=pathlib.Path,
+        required=True,
+        help="Model to tune. As for perf_test, its directory needs test data unless -I is passed in --perf_test_args.",
+    )
+    parser.add_argument("--ep", default="cpu", help="Execution provider, as the perf_test -e value.")
+    parser.add_argument(
+        "--ep_option_sets",
+        nargs="+",
+        default=[],
+        help="Alternative EP option strings in the perf_test -i format, e.g. 'trt_fp16_enable|1'. The best is kept.",
+    )
+    parser.add_argument("--metric", choices=["throughput", "p99"], default="throughput", help="Metric to optimize.")
+    parser.add_argument("--concurrency", type=int, default=1, help="Concurrent runs (perf_test -c).")
+    parser.add_argument("--seconds", type=int, default=10, help="Duration of each measurement.")
+    parser.add_argument("--max_threads", type=int, default=0, help="Largest thread count tried. Default: CPU count.")
+    parser.add_argument("--max_passes", type=int, default=3, help="Maximum number of passes over the options.")
+    parser.add_argument(
+        "--perf_test_args", nargs=argparse.REMAINDER, default=[], help="Extra perf_test arguments, must be last."
+    )
+    parser.add_argument("--output", type=pathlib.Path, required=True, help="ORT config JSON file to write.")
+    parser.add_argument(
+        "--output_model",
+        type=pathlib.Path,
+        help="Writes a copy of the model with the config stored in its 'ort_config' metadata. Requires onnx.",
+    )
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    tuner = Tuner(args)
+    best, best_metric = tuner.tune()
+    config = write_ort_config(best, best_metric, args)
+    print(f"Best: {json.dumps(config['session_options'])} ({tuner.describe(best_metric)})")
+
+    if args.output_model:
+        embed_ort_config(args.model, args.output_model, config)
+        print(f"Wrote {args.output_model}. Set ORT_LOAD_CONFIG_FROM_MODEL=1 to use the options it stores.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -32,6 +32,8 @@ inline HRESULT OrtErrorCodeToHRESULT(OrtErrorCode status) noexcept {
       return __HRESULT_FROM_WIN32(ERROR_FILE_CORRUPT);
     case OrtErrorCode::ORT_EP_FAIL:
       return __HRESULT_FROM_WIN32(ERROR_INTERNAL_ERROR);
+    case OrtErrorCode::ORT_TIMEOUT:
+      return __HRESULT_FROM_WIN32(ERROR_TIMEOUT);
     default:
       return E_FAIL;
   }